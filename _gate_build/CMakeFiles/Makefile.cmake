@@ -0,0 +1,251 @@
+# CMAKE generated file: DO NOT EDIT!
+# Generated by "Unix Makefiles" Generator, CMake Version 3.25
+
+# The generator used is:
+set(CMAKE_DEPENDS_GENERATOR "Unix Makefiles")
+
+# The top level Makefile was generated from the following files:
+set(CMAKE_MAKEFILE_DEPENDS
+  "CMakeCache.txt"
+  "/root/repo/CMakeLists.txt"
+  "CMakeFiles/3.25.1/CMakeCCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeCXXCompiler.cmake"
+  "CMakeFiles/3.25.1/CMakeSystem.cmake"
+  "/root/repo/cmake/cmake_uninstall.cmake.in"
+  "/root/repo/cmake/libs/CheckJPEG.cmake"
+  "/root/repo/cmake/libs/CheckOpenGL.cmake"
+  "/root/repo/cmake/libs/CheckPNG.cmake"
+  "/root/repo/cmake/libs/CheckTinyXML2.cmake"
+  "/root/repo/cmake/libs/CheckZLIB.cmake"
+  "/root/repo/cmake/libs/FindLibraryPkgConfig.cmake"
+  "/root/repo/cmake/libs/FindSeccomp.cmake"
+  "/root/repo/cmake/macros/Check64BitTimeSupport.cmake"
+  "/root/repo/cmake/macros/CheckC11C99CompilerFlag.cmake"
+  "/root/repo/cmake/macros/CheckCXX11CompilerFlag.cmake"
+  "/root/repo/cmake/macros/CheckHiddenVisibility.cmake"
+  "/root/repo/cmake/macros/CheckLargeFileSupport.cmake"
+  "/root/repo/cmake/macros/CheckStackProtectorCompilerFlag.cmake"
+  "/root/repo/cmake/macros/CheckSymbolExistsOrInline.cmake"
+  "/root/repo/cmake/macros/DirInstallPaths.cmake"
+  "/root/repo/cmake/macros/SetMSVCDebugPath.cmake"
+  "/root/repo/cmake/macros/SplitDebugInformation.cmake"
+  "/root/repo/cmake/modules/FindIconv.cmake"
+  "/root/repo/cmake/modules/FindNettle.cmake"
+  "/root/repo/cmake/options.cmake"
+  "/root/repo/cmake/platform.cmake"
+  "/root/repo/cmake/platform/gcc.cmake"
+  "/root/repo/doc/CMakeLists.txt"
+  "/root/repo/extlib/CMakeLists.txt"
+  "/root/repo/extlib/PowerVR/CMakeLists.txt"
+  "/root/repo/extlib/googletest/CMakeLists.txt"
+  "/root/repo/extlib/googletest/googlemock/CMakeLists.txt"
+  "/root/repo/extlib/googletest/googletest/CMakeLists.txt"
+  "/root/repo/extlib/googletest/googletest/cmake/internal_utils.cmake"
+  "/root/repo/extlib/inih/CMakeLists.txt"
+  "/root/repo/extlib/libmspack-xenia/CMakeLists.txt"
+  "/root/repo/extlib/libmspack-xenia/config.h.in"
+  "/root/repo/extlib/minizip/CMakeLists.txt"
+  "/root/repo/extlib/minizip/minizip.pc.cmakein"
+  "/root/repo/extlib/tinyxml2/CMakeLists.txt"
+  "/root/repo/extlib/unice68/CMakeLists.txt"
+  "/root/repo/extlib/unice68/cm_config.h.in"
+  "/root/repo/extlib/unice68/unice68.pc.in"
+  "/root/repo/src/CMakeLists.txt"
+  "/root/repo/src/config.libc.h.in"
+  "/root/repo/src/config.version.h.in"
+  "/root/repo/src/libcachecommon/CMakeLists.txt"
+  "/root/repo/src/libcachecommon/tests/CMakeLists.txt"
+  "/root/repo/src/libi18n/CMakeLists.txt"
+  "/root/repo/src/libi18n/config.libi18n.h.in"
+  "/root/repo/src/libromdata/CMakeLists.txt"
+  "/root/repo/src/libromdata/config.libromdata.h.in"
+  "/root/repo/src/libromdata/tests/CMakeLists.txt"
+  "/root/repo/src/librpbase/CMakeLists.txt"
+  "/root/repo/src/librpbase/config.librpbase.h.in"
+  "/root/repo/src/librpbase/tests/CMakeLists.txt"
+  "/root/repo/src/librpcpu/CMakeLists.txt"
+  "/root/repo/src/librpcpu/config.byteswap.h.in"
+  "/root/repo/src/librpcpu/tests/CMakeLists.txt"
+  "/root/repo/src/librpfile/CMakeLists.txt"
+  "/root/repo/src/librpfile/config.librpfile.h.in"
+  "/root/repo/src/librpsecure/CMakeLists.txt"
+  "/root/repo/src/librpsecure/config.librpsecure.h.in"
+  "/root/repo/src/librptexture/CMakeLists.txt"
+  "/root/repo/src/librptexture/config.librptexture.h.in"
+  "/root/repo/src/librptexture/tests/CMakeLists.txt"
+  "/root/repo/src/librpthreads/CMakeLists.txt"
+  "/root/repo/src/librpthreads/config.librpthreads.h.in"
+  "/root/repo/src/libunixcommon/CMakeLists.txt"
+  "/root/repo/src/libunixcommon/config.libunixcommon.h.in"
+  "/root/repo/src/libwin32common/DelayLoadHelper.cmake"
+  "/root/repo/src/rp-download/CMakeLists.txt"
+  "/root/repo/src/rp-download/config.rp-download.h.in"
+  "/root/repo/src/rp-stub/CMakeLists.txt"
+  "/root/repo/src/rpcli/CMakeLists.txt"
+  "/root/repo/src/rpcli/config.rpcli.h.in"
+  "/root/repo/src/stdboolx.h.in"
+  "/root/repo/xdg/CMakeLists.txt"
+  "/usr/share/cmake-3.25/Modules/CMakeCInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCXXInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCheckCompilerFlagCommonPatterns.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeCommonLanguageInclude.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeDependentOption.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeFindBinUtils.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeGenericSystem.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeInitializeConfigs.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeLanguageInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakePushCheckState.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInformation.cmake"
+  "/usr/share/cmake-3.25/Modules/CMakeSystemSpecificInitialize.cmake"
+  "/usr/share/cmake-3.25/Modules/CPack.cmake"
+  "/usr/share/cmake-3.25/Modules/CPackComponent.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckCXXSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckFunctionExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFile.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFileCXX.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckIncludeFiles.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckLibraryExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckStructHasMember.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckSymbolExists.cmake"
+  "/usr/share/cmake-3.25/Modules/CheckTypeSize.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/CMakeCommonCompilerMacros.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Compiler/GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/ExternalProject.cmake"
+  "/usr/share/cmake-3.25/Modules/FindCURL.cmake"
+  "/usr/share/cmake-3.25/Modules/FindJPEG.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPNG.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageHandleStandardArgs.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPackageMessage.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPkgConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/FindPythonInterp.cmake"
+  "/usr/share/cmake-3.25/Modules/FindThreads.cmake"
+  "/usr/share/cmake-3.25/Modules/FindZLIB.cmake"
+  "/usr/share/cmake-3.25/Modules/GNUInstallDirs.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckCompilerFlag.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckFlagCommonConfig.cmake"
+  "/usr/share/cmake-3.25/Modules/Internal/CheckSourceCompiles.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-C.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU-CXX.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux-GNU.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/Linux.cmake"
+  "/usr/share/cmake-3.25/Modules/Platform/UnixPaths.cmake"
+  "/usr/share/cmake-3.25/Modules/SelectLibraryConfigurations.cmake"
+  "/usr/share/cmake-3.25/Templates/CPackConfig.cmake.in"
+  )
+
+# The corresponding makefile is:
+set(CMAKE_MAKEFILE_OUTPUTS
+  "Makefile"
+  "CMakeFiles/cmake.check_cache"
+  )
+
+# Byproducts of CMake generate step:
+set(CMAKE_MAKEFILE_PRODUCTS
+  "cmake/cmake_uninstall.cmake"
+  "CPackConfig.cmake"
+  "CPackSourceConfig.cmake"
+  "CMakeFiles/CMakeDirectoryInformation.cmake"
+  "extlib/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "extlib/minizip/minizip.pc"
+  "extlib/minizip/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "extlib/inih/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "extlib/tinyxml2/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "extlib/unice68/config.unice68.h"
+  "extlib/unice68/unice68.pc"
+  "extlib/unice68/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "extlib/libmspack-xenia/config.h"
+  "extlib/libmspack-xenia/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "extlib/PowerVR/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "extlib/googletest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "extlib/googletest/googlemock/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "extlib/googletest/googlemock/gtest/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/config.libc.h"
+  "src/config.version.h"
+  "src/stdboolx.h"
+  "src/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/librpsecure/config.librpsecure.h"
+  "src/librpsecure/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/libi18n/config.libi18n.h"
+  "src/libi18n/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/librpthreads/config.librpthreads.h"
+  "src/librpthreads/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/libcachecommon/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/libcachecommon/tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/rp-download/config.rp-download.h"
+  "src/rp-download/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/librpcpu/config.byteswap.h"
+  "src/librpcpu/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/librpcpu/tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/librpfile/config.librpfile.h"
+  "src/librpfile/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/librpbase/config.librpbase.h"
+  "src/librpbase/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/librpbase/tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/librptexture/config.librptexture.h"
+  "src/librptexture/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/librptexture/tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/libromdata/config.libromdata.h"
+  "src/libromdata/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/libromdata/tests/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/rpcli/config.rpcli.h"
+  "src/rpcli/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/rp-stub/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "src/libunixcommon/config.libunixcommon.h"
+  "src/libunixcommon/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "doc/CMakeFiles/CMakeDirectoryInformation.cmake"
+  "xdg/CMakeFiles/CMakeDirectoryInformation.cmake"
+  )
+
+# Dependency information for all targets:
+set(CMAKE_DEPEND_INFO_FILES
+  "CMakeFiles/git_version.dir/DependInfo.cmake"
+  "CMakeFiles/uninstall.dir/DependInfo.cmake"
+  "extlib/minizip/CMakeFiles/minizip.dir/DependInfo.cmake"
+  "extlib/inih/CMakeFiles/inih.dir/DependInfo.cmake"
+  "extlib/tinyxml2/CMakeFiles/tinyxml2.dir/DependInfo.cmake"
+  "extlib/unice68/CMakeFiles/unice68_lib.dir/DependInfo.cmake"
+  "extlib/unice68/CMakeFiles/unice68_exe.dir/DependInfo.cmake"
+  "extlib/libmspack-xenia/CMakeFiles/mspack.dir/DependInfo.cmake"
+  "extlib/PowerVR/CMakeFiles/pvrtc.dir/DependInfo.cmake"
+  "extlib/googletest/googlemock/CMakeFiles/gmock.dir/DependInfo.cmake"
+  "extlib/googletest/googlemock/CMakeFiles/gmock_main.dir/DependInfo.cmake"
+  "extlib/googletest/googlemock/gtest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  "extlib/googletest/googlemock/gtest/CMakeFiles/gtest_main.dir/DependInfo.cmake"
+  "src/librpsecure/CMakeFiles/rpsecure.dir/DependInfo.cmake"
+  "src/librpthreads/CMakeFiles/rpthreads.dir/DependInfo.cmake"
+  "src/libcachecommon/CMakeFiles/cachecommon.dir/DependInfo.cmake"
+  "src/libcachecommon/tests/CMakeFiles/FilterCacheKeyTest.dir/DependInfo.cmake"
+  "src/rp-download/CMakeFiles/rp-download.dir/DependInfo.cmake"
+  "src/librpcpu/CMakeFiles/rpcpu.dir/DependInfo.cmake"
+  "src/librpcpu/tests/CMakeFiles/ByteswapTest.dir/DependInfo.cmake"
+  "src/librpcpu/tests/CMakeFiles/ByteswapBenchmarkTest.dir/DependInfo.cmake"
+  "src/librpfile/CMakeFiles/rpfile.dir/DependInfo.cmake"
+  "src/librpbase/CMakeFiles/rpbase.dir/DependInfo.cmake"
+  "src/librpbase/tests/CMakeFiles/rptest.dir/DependInfo.cmake"
+  "src/librpbase/tests/CMakeFiles/RpImageLoaderTest.dir/DependInfo.cmake"
+  "src/librpbase/tests/CMakeFiles/AesCipherTest.dir/DependInfo.cmake"
+  "src/librpbase/tests/CMakeFiles/TextFuncsTest.dir/DependInfo.cmake"
+  "src/librpbase/tests/CMakeFiles/TimegmTest.dir/DependInfo.cmake"
+  "src/librptexture/CMakeFiles/rptexture.dir/DependInfo.cmake"
+  "src/librptexture/tests/CMakeFiles/ImageDecoderLinearTest.dir/DependInfo.cmake"
+  "src/librptexture/tests/CMakeFiles/UnPremultiplyTest.dir/DependInfo.cmake"
+  "src/libromdata/CMakeFiles/romdata.dir/DependInfo.cmake"
+  "src/libromdata/tests/CMakeFiles/CtrKeyScramblerTest.dir/DependInfo.cmake"
+  "src/libromdata/tests/CMakeFiles/GcnFstPrint.dir/DependInfo.cmake"
+  "src/libromdata/tests/CMakeFiles/rp-capgen.dir/DependInfo.cmake"
+  "src/libromdata/tests/CMakeFiles/RomDataCapSnapshotTest.dir/DependInfo.cmake"
+  "src/libromdata/tests/CMakeFiles/GcnFstTest.dir/DependInfo.cmake"
+  "src/libromdata/tests/CMakeFiles/ImageDecoderTest.dir/DependInfo.cmake"
+  "src/libromdata/tests/CMakeFiles/SuperMagicDriveTest.dir/DependInfo.cmake"
+  "src/libromdata/tests/CMakeFiles/SparseDiscReaderTest.dir/DependInfo.cmake"
+  "src/libromdata/tests/CMakeFiles/FileFormatReplayBench.dir/DependInfo.cmake"
+  "src/libromdata/tests/CMakeFiles/rp-bench.dir/DependInfo.cmake"
+  "src/rpcli/CMakeFiles/rpcli.dir/DependInfo.cmake"
+  "src/rp-stub/CMakeFiles/rp-stub.dir/DependInfo.cmake"
+  "src/libunixcommon/CMakeFiles/unixcommon.dir/DependInfo.cmake"
+  )
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "git_version.h"
+  "CMakeFiles/git_version"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/git_version.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,9 @@
+file(REMOVE_RECURSE
+  "git_version.h"
+  "CMakeFiles/uninstall"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang )
+  include(CMakeFiles/uninstall.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/extlib
+# Build directory: /root/repo/_gate_build/extlib
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("minizip")
+subdirs("inih")
+subdirs("tinyxml2")
+subdirs("unice68")
+subdirs("libmspack-xenia")
+subdirs("PowerVR")
+subdirs("googletest")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../lib/libpvrtc.a"
+  "../../lib/libpvrtc.pdb"
+  "CMakeFiles/pvrtc.dir/PVRTDecompress.cpp.o"
+  "CMakeFiles/pvrtc.dir/PVRTDecompress.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/pvrtc.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
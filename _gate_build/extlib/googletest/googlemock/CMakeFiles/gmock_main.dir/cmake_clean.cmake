@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../../lib/libgmock_main.a"
+  "../../../lib/libgmock_main.pdb"
+  "CMakeFiles/gmock_main.dir/src/gmock_main.cc.o"
+  "CMakeFiles/gmock_main.dir/src/gmock_main.cc.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/gmock_main.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../lib/libinih.a"
+  "../../lib/libinih.pdb"
+  "CMakeFiles/inih.dir/ini.c.o"
+  "CMakeFiles/inih.dir/ini.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/inih.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/extlib/libmspack-xenia/lzxd.c" "extlib/libmspack-xenia/CMakeFiles/mspack.dir/lzxd.c.o" "gcc" "extlib/libmspack-xenia/CMakeFiles/mspack.dir/lzxd.c.o.d"
+  "/root/repo/extlib/libmspack-xenia/system.c" "extlib/libmspack-xenia/CMakeFiles/mspack.dir/system.c.o" "gcc" "extlib/libmspack-xenia/CMakeFiles/mspack.dir/system.c.o.d"
+  "/root/repo/extlib/libmspack-xenia/xenia_lzx.c" "extlib/libmspack-xenia/CMakeFiles/mspack.dir/xenia_lzx.c.o" "gcc" "extlib/libmspack-xenia/CMakeFiles/mspack.dir/xenia_lzx.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "../../lib/libmspack.a"
+  "../../lib/libmspack.pdb"
+  "CMakeFiles/mspack.dir/lzxd.c.o"
+  "CMakeFiles/mspack.dir/lzxd.c.o.d"
+  "CMakeFiles/mspack.dir/system.c.o"
+  "CMakeFiles/mspack.dir/system.c.o.d"
+  "CMakeFiles/mspack.dir/xenia_lzx.c.o"
+  "CMakeFiles/mspack.dir/xenia_lzx.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/mspack.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,30 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/extlib/minizip/mz_compat.c" "extlib/minizip/CMakeFiles/minizip.dir/mz_compat.c.o" "gcc" "extlib/minizip/CMakeFiles/minizip.dir/mz_compat.c.o.d"
+  "/root/repo/extlib/minizip/mz_crypt.c" "extlib/minizip/CMakeFiles/minizip.dir/mz_crypt.c.o" "gcc" "extlib/minizip/CMakeFiles/minizip.dir/mz_crypt.c.o.d"
+  "/root/repo/extlib/minizip/mz_os.c" "extlib/minizip/CMakeFiles/minizip.dir/mz_os.c.o" "gcc" "extlib/minizip/CMakeFiles/minizip.dir/mz_os.c.o.d"
+  "/root/repo/extlib/minizip/mz_os_posix.c" "extlib/minizip/CMakeFiles/minizip.dir/mz_os_posix.c.o" "gcc" "extlib/minizip/CMakeFiles/minizip.dir/mz_os_posix.c.o.d"
+  "/root/repo/extlib/minizip/mz_strm.c" "extlib/minizip/CMakeFiles/minizip.dir/mz_strm.c.o" "gcc" "extlib/minizip/CMakeFiles/minizip.dir/mz_strm.c.o.d"
+  "/root/repo/extlib/minizip/mz_strm_buf.c" "extlib/minizip/CMakeFiles/minizip.dir/mz_strm_buf.c.o" "gcc" "extlib/minizip/CMakeFiles/minizip.dir/mz_strm_buf.c.o.d"
+  "/root/repo/extlib/minizip/mz_strm_mem.c" "extlib/minizip/CMakeFiles/minizip.dir/mz_strm_mem.c.o" "gcc" "extlib/minizip/CMakeFiles/minizip.dir/mz_strm_mem.c.o.d"
+  "/root/repo/extlib/minizip/mz_strm_os_posix.c" "extlib/minizip/CMakeFiles/minizip.dir/mz_strm_os_posix.c.o" "gcc" "extlib/minizip/CMakeFiles/minizip.dir/mz_strm_os_posix.c.o.d"
+  "/root/repo/extlib/minizip/mz_strm_split.c" "extlib/minizip/CMakeFiles/minizip.dir/mz_strm_split.c.o" "gcc" "extlib/minizip/CMakeFiles/minizip.dir/mz_strm_split.c.o.d"
+  "/root/repo/extlib/minizip/mz_strm_zlib.c" "extlib/minizip/CMakeFiles/minizip.dir/mz_strm_zlib.c.o" "gcc" "extlib/minizip/CMakeFiles/minizip.dir/mz_strm_zlib.c.o.d"
+  "/root/repo/extlib/minizip/mz_zip.c" "extlib/minizip/CMakeFiles/minizip.dir/mz_zip.c.o" "gcc" "extlib/minizip/CMakeFiles/minizip.dir/mz_zip.c.o.d"
+  "/root/repo/extlib/minizip/mz_zip_rw.c" "extlib/minizip/CMakeFiles/minizip.dir/mz_zip_rw.c.o" "gcc" "extlib/minizip/CMakeFiles/minizip.dir/mz_zip_rw.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
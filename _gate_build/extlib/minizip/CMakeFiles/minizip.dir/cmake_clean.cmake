@@ -0,0 +1,33 @@
+file(REMOVE_RECURSE
+  "../../lib/libminizip.a"
+  "../../lib/libminizip.pdb"
+  "CMakeFiles/minizip.dir/mz_compat.c.o"
+  "CMakeFiles/minizip.dir/mz_compat.c.o.d"
+  "CMakeFiles/minizip.dir/mz_crypt.c.o"
+  "CMakeFiles/minizip.dir/mz_crypt.c.o.d"
+  "CMakeFiles/minizip.dir/mz_os.c.o"
+  "CMakeFiles/minizip.dir/mz_os.c.o.d"
+  "CMakeFiles/minizip.dir/mz_os_posix.c.o"
+  "CMakeFiles/minizip.dir/mz_os_posix.c.o.d"
+  "CMakeFiles/minizip.dir/mz_strm.c.o"
+  "CMakeFiles/minizip.dir/mz_strm.c.o.d"
+  "CMakeFiles/minizip.dir/mz_strm_buf.c.o"
+  "CMakeFiles/minizip.dir/mz_strm_buf.c.o.d"
+  "CMakeFiles/minizip.dir/mz_strm_mem.c.o"
+  "CMakeFiles/minizip.dir/mz_strm_mem.c.o.d"
+  "CMakeFiles/minizip.dir/mz_strm_os_posix.c.o"
+  "CMakeFiles/minizip.dir/mz_strm_os_posix.c.o.d"
+  "CMakeFiles/minizip.dir/mz_strm_split.c.o"
+  "CMakeFiles/minizip.dir/mz_strm_split.c.o.d"
+  "CMakeFiles/minizip.dir/mz_strm_zlib.c.o"
+  "CMakeFiles/minizip.dir/mz_strm_zlib.c.o.d"
+  "CMakeFiles/minizip.dir/mz_zip.c.o"
+  "CMakeFiles/minizip.dir/mz_zip.c.o.d"
+  "CMakeFiles/minizip.dir/mz_zip_rw.c.o"
+  "CMakeFiles/minizip.dir/mz_zip_rw.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/minizip.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
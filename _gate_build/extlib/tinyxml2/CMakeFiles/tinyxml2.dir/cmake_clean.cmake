@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../lib/libtinyxml2.a"
+  "../../lib/libtinyxml2.pdb"
+  "CMakeFiles/tinyxml2.dir/tinyxml2.cpp.o"
+  "CMakeFiles/tinyxml2.dir/tinyxml2.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tinyxml2.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../bin/unice68"
+  "../../bin/unice68.pdb"
+  "CMakeFiles/unice68_exe.dir/unice68.c.o"
+  "CMakeFiles/unice68_exe.dir/unice68.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/unice68_exe.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/extlib/unice68/unice68_pack.c" "extlib/unice68/CMakeFiles/unice68_lib.dir/unice68_pack.c.o" "gcc" "extlib/unice68/CMakeFiles/unice68_lib.dir/unice68_pack.c.o.d"
+  "/root/repo/extlib/unice68/unice68_unpack.c" "extlib/unice68/CMakeFiles/unice68_lib.dir/unice68_unpack.c.o" "gcc" "extlib/unice68/CMakeFiles/unice68_lib.dir/unice68_unpack.c.o.d"
+  "/root/repo/extlib/unice68/unice68_version.c" "extlib/unice68/CMakeFiles/unice68_lib.dir/unice68_version.c.o" "gcc" "extlib/unice68/CMakeFiles/unice68_lib.dir/unice68_version.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
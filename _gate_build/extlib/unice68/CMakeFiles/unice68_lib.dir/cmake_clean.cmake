@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "../../lib/libunice68.a"
+  "../../lib/libunice68.pdb"
+  "CMakeFiles/unice68_lib.dir/unice68_pack.c.o"
+  "CMakeFiles/unice68_lib.dir/unice68_pack.c.o.d"
+  "CMakeFiles/unice68_lib.dir/unice68_unpack.c.o"
+  "CMakeFiles/unice68_lib.dir/unice68_unpack.c.o.d"
+  "CMakeFiles/unice68_lib.dir/unice68_version.c.o"
+  "CMakeFiles/unice68_lib.dir/unice68_version.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/unice68_lib.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,3 @@
+file(REMOVE_RECURSE
+  "../../lib/libunice68.a"
+)
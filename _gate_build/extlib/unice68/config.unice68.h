@@ -0,0 +1,56 @@
+/* cm_config.h.in -- unice68 template for cmake config.h */
+
+/* ----------------------------------------------------------------------
+ *  Package info
+ */
+
+/* Name of package */
+#define PACKAGE ""
+
+/* Version number of package */
+#define VERSION ""
+
+/* Define to the address where bug reports for this package should be sent. */
+#define PACKAGE_BUGREPORT ""
+
+/* Package short description */
+#define PACKAGE_DESC
+
+/* Define to the full name of this package. */
+#define PACKAGE_NAME PACKAGE
+
+/* Define to the full name and version of this package. */
+#define PACKAGE_STRING " "
+
+/* Define to the home page for this package. */
+#define PACKAGE_URL ""
+
+/* Version number */
+#define PACKAGE_VERNUM 
+
+/* Define to the version of this package. */
+#define PACKAGE_VERSION VERSION
+
+/* Define to the one symbol short name of this package. */
+#define PACKAGE_TARNAME PACKAGE
+
+/* ----------------------------------------------------------------------
+ *  Configured headers
+ */
+
+#define HAVE_STDINT_H
+#define HAVE_ASSERT_H
+#define HAVE_LIBGEN_H
+#define HAVE_UNISTD_H
+#define HAVE_FCNTL_H
+/* #undef HAVE_IO_H */
+
+/* ----------------------------------------------------------------------
+ *  Configured functions
+ */
+
+#define HAVE_BASENAME
+/* #undef HAVE_SETMODE */
+/* #undef HAVE__SETMODE */
+#define HAVE_FILENO
+/* #undef HAVE__FILENO */
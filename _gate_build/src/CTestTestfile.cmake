@@ -0,0 +1,19 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src
+# Build directory: /root/repo/_gate_build/src
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("librpsecure")
+subdirs("libi18n")
+subdirs("librpthreads")
+subdirs("libcachecommon")
+subdirs("rp-download")
+subdirs("librpcpu")
+subdirs("librpfile")
+subdirs("librpbase")
+subdirs("librptexture")
+subdirs("libromdata")
+subdirs("rpcli")
+subdirs("rp-stub")
+subdirs("libunixcommon")
@@ -0,0 +1,18 @@
+/***************************************************************************
+ * ROM Properties Page shell extension.                                    *
+ * config.libc.h.in: Common libc function detection. (source file)         *
+ *                                                                         *
+ * Copyright (c) 2016-2017 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_CONFIG_LIBC_H__
+#define __ROMPROPERTIES_CONFIG_LIBC_H__
+
+/* Define to the size of `off_t` if it's available. */
+#define SIZEOF_OFF_T 8
+
+/* Define to the size of `off64_t` if it's available. */
+/* #undef SIZEOF_OFF64_T */
+
+#endif /* __ROMPROPERTIES_CONFIG_LIBC_H__ */
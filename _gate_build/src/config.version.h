@@ -0,0 +1,31 @@
+/***************************************************************************
+ * ROM Properties Page shell extension.                                    *
+ * config.version.h.in: Version information. (source file)                 *
+ *                                                                         *
+ * Copyright (c) 2016-2017 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_CONFIG_VERSION_H__
+#define __ROMPROPERTIES_CONFIG_VERSION_H__
+
+/* Program version. */
+#define RP_VERSION_MAJOR 1
+#define RP_VERSION_MINOR 5
+#define RP_VERSION_PATCH 0
+#define RP_VERSION_DEVEL 1
+#define RP_VERSION_STRING "1.5+"
+
+/* Package dscription. */
+#define RP_DESCRIPTION "ROM Properties Page shell extension"
+
+/* Package name. */
+#define RP_PACKAGE_NAME "rom-properties"
+
+/* Author. */
+#define RP_AUTHOR "David Korth"
+
+/* Installation prefix. */
+#define CMAKE_INSTALL_PREFIX "/usr/local"
+
+#endif /* __ROMPROPERTIES_CONFIG_VERSION_H__ */
@@ -0,0 +1,28 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/libcachecommon/CacheBlobStore.cpp" "src/libcachecommon/CMakeFiles/cachecommon.dir/CacheBlobStore.cpp.o" "gcc" "src/libcachecommon/CMakeFiles/cachecommon.dir/CacheBlobStore.cpp.o.d"
+  "/root/repo/src/libcachecommon/CacheDir.cpp" "src/libcachecommon/CMakeFiles/cachecommon.dir/CacheDir.cpp.o" "gcc" "src/libcachecommon/CMakeFiles/cachecommon.dir/CacheDir.cpp.o.d"
+  "/root/repo/src/libcachecommon/CacheEviction.cpp" "src/libcachecommon/CMakeFiles/cachecommon.dir/CacheEviction.cpp.o" "gcc" "src/libcachecommon/CMakeFiles/cachecommon.dir/CacheEviction.cpp.o.d"
+  "/root/repo/src/libcachecommon/CacheIndex.cpp" "src/libcachecommon/CMakeFiles/cachecommon.dir/CacheIndex.cpp.o" "gcc" "src/libcachecommon/CMakeFiles/cachecommon.dir/CacheIndex.cpp.o.d"
+  "/root/repo/src/libcachecommon/CacheKeys.cpp" "src/libcachecommon/CMakeFiles/cachecommon.dir/CacheKeys.cpp.o" "gcc" "src/libcachecommon/CMakeFiles/cachecommon.dir/CacheKeys.cpp.o.d"
+  "/root/repo/src/libcachecommon/CacheKeys_ssse3.cpp" "src/libcachecommon/CMakeFiles/cachecommon.dir/CacheKeys_ssse3.cpp.o" "gcc" "src/libcachecommon/CMakeFiles/cachecommon.dir/CacheKeys_ssse3.cpp.o.d"
+  "/root/repo/src/libcachecommon/NegativeCache.cpp" "src/libcachecommon/CMakeFiles/cachecommon.dir/NegativeCache.cpp.o" "gcc" "src/libcachecommon/CMakeFiles/cachecommon.dir/NegativeCache.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/src/librpcpu/CMakeFiles/rpcpu.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpthreads/CMakeFiles/rpthreads.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libunixcommon/CMakeFiles/unixcommon.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
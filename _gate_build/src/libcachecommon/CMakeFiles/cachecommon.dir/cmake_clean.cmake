@@ -0,0 +1,23 @@
+file(REMOVE_RECURSE
+  "../../lib/libcachecommon.a"
+  "../../lib/libcachecommon.pdb"
+  "CMakeFiles/cachecommon.dir/CacheBlobStore.cpp.o"
+  "CMakeFiles/cachecommon.dir/CacheBlobStore.cpp.o.d"
+  "CMakeFiles/cachecommon.dir/CacheDir.cpp.o"
+  "CMakeFiles/cachecommon.dir/CacheDir.cpp.o.d"
+  "CMakeFiles/cachecommon.dir/CacheEviction.cpp.o"
+  "CMakeFiles/cachecommon.dir/CacheEviction.cpp.o.d"
+  "CMakeFiles/cachecommon.dir/CacheIndex.cpp.o"
+  "CMakeFiles/cachecommon.dir/CacheIndex.cpp.o.d"
+  "CMakeFiles/cachecommon.dir/CacheKeys.cpp.o"
+  "CMakeFiles/cachecommon.dir/CacheKeys.cpp.o.d"
+  "CMakeFiles/cachecommon.dir/CacheKeys_ssse3.cpp.o"
+  "CMakeFiles/cachecommon.dir/CacheKeys_ssse3.cpp.o.d"
+  "CMakeFiles/cachecommon.dir/NegativeCache.cpp.o"
+  "CMakeFiles/cachecommon.dir/NegativeCache.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cachecommon.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,7 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/libcachecommon
+# Build directory: /root/repo/_gate_build/src/libcachecommon
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+subdirs("tests")
@@ -0,0 +1,12 @@
+file(REMOVE_RECURSE
+  "../../../bin/FilterCacheKeyTest"
+  "../../../bin/FilterCacheKeyTest.pdb"
+  "../../../bin/FilterCacheKeyTest.debug"
+  "CMakeFiles/FilterCacheKeyTest.dir/FilterCacheKeyTest.cpp.o"
+  "CMakeFiles/FilterCacheKeyTest.dir/FilterCacheKeyTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/FilterCacheKeyTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
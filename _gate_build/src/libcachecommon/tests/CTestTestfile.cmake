@@ -0,0 +1,8 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/libcachecommon/tests
+# Build directory: /root/repo/_gate_build/src/libcachecommon/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(FilterCacheKeyTest "/root/repo/_gate_build/bin/FilterCacheKeyTest")
+set_tests_properties(FilterCacheKeyTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/libcachecommon/tests/CMakeLists.txt;14;ADD_TEST;/root/repo/src/libcachecommon/tests/CMakeLists.txt;0;")
@@ -0,0 +1,23 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libi18n)                          *
+ * config.libi18n.h.in: libi18n configuration. (source file)               *
+ *                                                                         *
+ * Copyright (c) 2017 by David Korth.                                      *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBI18N_CONFIG_H__
+#define __ROMPROPERTIES_LIBI18N_CONFIG_H__
+
+/* Define to 1 if NLS should be enabled. */
+/* #undef ENABLE_NLS */
+
+/* Define to 1 if you have gettext. */
+/* #undef HAVE_GETTEXT */
+
+/* Define to the system locale directory on Unix and Unix-like systems. */
+#ifndef _WIN32
+#define DIR_INSTALL_LOCALE "/usr/local/share/locale"
+#endif
+
+#endif /* __ROMPROPERTIES_LIBI18N_CONFIG_H__ */
@@ -0,0 +1,131 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/libromdata/Audio/ADX.cpp" "src/libromdata/CMakeFiles/romdata.dir/Audio/ADX.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Audio/ADX.cpp.o.d"
+  "/root/repo/src/libromdata/Audio/BCSTM.cpp" "src/libromdata/CMakeFiles/romdata.dir/Audio/BCSTM.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Audio/BCSTM.cpp.o.d"
+  "/root/repo/src/libromdata/Audio/BRSTM.cpp" "src/libromdata/CMakeFiles/romdata.dir/Audio/BRSTM.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Audio/BRSTM.cpp.o.d"
+  "/root/repo/src/libromdata/Audio/GBS.cpp" "src/libromdata/CMakeFiles/romdata.dir/Audio/GBS.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Audio/GBS.cpp.o.d"
+  "/root/repo/src/libromdata/Audio/NSF.cpp" "src/libromdata/CMakeFiles/romdata.dir/Audio/NSF.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Audio/NSF.cpp.o.d"
+  "/root/repo/src/libromdata/Audio/PSF.cpp" "src/libromdata/CMakeFiles/romdata.dir/Audio/PSF.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Audio/PSF.cpp.o.d"
+  "/root/repo/src/libromdata/Audio/SAP.cpp" "src/libromdata/CMakeFiles/romdata.dir/Audio/SAP.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Audio/SAP.cpp.o.d"
+  "/root/repo/src/libromdata/Audio/SID.cpp" "src/libromdata/CMakeFiles/romdata.dir/Audio/SID.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Audio/SID.cpp.o.d"
+  "/root/repo/src/libromdata/Audio/SNDH.cpp" "src/libromdata/CMakeFiles/romdata.dir/Audio/SNDH.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Audio/SNDH.cpp.o.d"
+  "/root/repo/src/libromdata/Audio/SPC.cpp" "src/libromdata/CMakeFiles/romdata.dir/Audio/SPC.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Audio/SPC.cpp.o.d"
+  "/root/repo/src/libromdata/Audio/VGM.cpp" "src/libromdata/CMakeFiles/romdata.dir/Audio/VGM.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Audio/VGM.cpp.o.d"
+  "/root/repo/src/libromdata/Console/Dreamcast.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/Dreamcast.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/Dreamcast.cpp.o.d"
+  "/root/repo/src/libromdata/Console/DreamcastSave.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/DreamcastSave.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/DreamcastSave.cpp.o.d"
+  "/root/repo/src/libromdata/Console/GameCube.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/GameCube.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/GameCube.cpp.o.d"
+  "/root/repo/src/libromdata/Console/GameCubeBNR.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/GameCubeBNR.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/GameCubeBNR.cpp.o.d"
+  "/root/repo/src/libromdata/Console/GameCubeRegions.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/GameCubeRegions.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/GameCubeRegions.cpp.o.d"
+  "/root/repo/src/libromdata/Console/GameCubeSave.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/GameCubeSave.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/GameCubeSave.cpp.o.d"
+  "/root/repo/src/libromdata/Console/MegaDrive.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/MegaDrive.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/MegaDrive.cpp.o.d"
+  "/root/repo/src/libromdata/Console/MegaDriveRegions.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/MegaDriveRegions.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/MegaDriveRegions.cpp.o.d"
+  "/root/repo/src/libromdata/Console/N64.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/N64.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/N64.cpp.o.d"
+  "/root/repo/src/libromdata/Console/NES.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/NES.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/NES.cpp.o.d"
+  "/root/repo/src/libromdata/Console/PlayStationSave.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/PlayStationSave.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/PlayStationSave.cpp.o.d"
+  "/root/repo/src/libromdata/Console/SNES.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/SNES.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/SNES.cpp.o.d"
+  "/root/repo/src/libromdata/Console/Sega8Bit.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/Sega8Bit.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/Sega8Bit.cpp.o.d"
+  "/root/repo/src/libromdata/Console/SegaSaturn.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/SegaSaturn.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/SegaSaturn.cpp.o.d"
+  "/root/repo/src/libromdata/Console/WiiCommon.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/WiiCommon.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/WiiCommon.cpp.o.d"
+  "/root/repo/src/libromdata/Console/WiiSave.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/WiiSave.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/WiiSave.cpp.o.d"
+  "/root/repo/src/libromdata/Console/WiiU.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/WiiU.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/WiiU.cpp.o.d"
+  "/root/repo/src/libromdata/Console/WiiWAD.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/WiiWAD.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/WiiWAD.cpp.o.d"
+  "/root/repo/src/libromdata/Console/WiiWIBN.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/WiiWIBN.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/WiiWIBN.cpp.o.d"
+  "/root/repo/src/libromdata/Console/Xbox360_STFS.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/Xbox360_STFS.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/Xbox360_STFS.cpp.o.d"
+  "/root/repo/src/libromdata/Console/Xbox360_XDBF.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/Xbox360_XDBF.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/Xbox360_XDBF.cpp.o.d"
+  "/root/repo/src/libromdata/Console/Xbox360_XEX.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/Xbox360_XEX.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/Xbox360_XEX.cpp.o.d"
+  "/root/repo/src/libromdata/Console/XboxDisc.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/XboxDisc.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/XboxDisc.cpp.o.d"
+  "/root/repo/src/libromdata/Console/Xbox_XBE.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/Xbox_XBE.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/Xbox_XBE.cpp.o.d"
+  "/root/repo/src/libromdata/Console/iQuePlayer.cpp" "src/libromdata/CMakeFiles/romdata.dir/Console/iQuePlayer.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Console/iQuePlayer.cpp.o.d"
+  "/root/repo/src/libromdata/Handheld/DMG.cpp" "src/libromdata/CMakeFiles/romdata.dir/Handheld/DMG.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Handheld/DMG.cpp.o.d"
+  "/root/repo/src/libromdata/Handheld/GameBoyAdvance.cpp" "src/libromdata/CMakeFiles/romdata.dir/Handheld/GameBoyAdvance.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Handheld/GameBoyAdvance.cpp.o.d"
+  "/root/repo/src/libromdata/Handheld/GameCom.cpp" "src/libromdata/CMakeFiles/romdata.dir/Handheld/GameCom.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Handheld/GameCom.cpp.o.d"
+  "/root/repo/src/libromdata/Handheld/Lynx.cpp" "src/libromdata/CMakeFiles/romdata.dir/Handheld/Lynx.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Handheld/Lynx.cpp.o.d"
+  "/root/repo/src/libromdata/Handheld/NGPC.cpp" "src/libromdata/CMakeFiles/romdata.dir/Handheld/NGPC.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Handheld/NGPC.cpp.o.d"
+  "/root/repo/src/libromdata/Handheld/Nintendo3DS.cpp" "src/libromdata/CMakeFiles/romdata.dir/Handheld/Nintendo3DS.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Handheld/Nintendo3DS.cpp.o.d"
+  "/root/repo/src/libromdata/Handheld/Nintendo3DSFirm.cpp" "src/libromdata/CMakeFiles/romdata.dir/Handheld/Nintendo3DSFirm.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Handheld/Nintendo3DSFirm.cpp.o.d"
+  "/root/repo/src/libromdata/Handheld/Nintendo3DS_SMDH.cpp" "src/libromdata/CMakeFiles/romdata.dir/Handheld/Nintendo3DS_SMDH.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Handheld/Nintendo3DS_SMDH.cpp.o.d"
+  "/root/repo/src/libromdata/Handheld/NintendoDS.cpp" "src/libromdata/CMakeFiles/romdata.dir/Handheld/NintendoDS.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Handheld/NintendoDS.cpp.o.d"
+  "/root/repo/src/libromdata/Handheld/PokemonMini.cpp" "src/libromdata/CMakeFiles/romdata.dir/Handheld/PokemonMini.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Handheld/PokemonMini.cpp.o.d"
+  "/root/repo/src/libromdata/Handheld/VirtualBoy.cpp" "src/libromdata/CMakeFiles/romdata.dir/Handheld/VirtualBoy.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Handheld/VirtualBoy.cpp.o.d"
+  "/root/repo/src/libromdata/Other/Amiibo.cpp" "src/libromdata/CMakeFiles/romdata.dir/Other/Amiibo.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Other/Amiibo.cpp.o.d"
+  "/root/repo/src/libromdata/Other/ELF.cpp" "src/libromdata/CMakeFiles/romdata.dir/Other/ELF.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Other/ELF.cpp.o.d"
+  "/root/repo/src/libromdata/Other/EXE.cpp" "src/libromdata/CMakeFiles/romdata.dir/Other/EXE.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Other/EXE.cpp.o.d"
+  "/root/repo/src/libromdata/Other/EXE_NE.cpp" "src/libromdata/CMakeFiles/romdata.dir/Other/EXE_NE.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Other/EXE_NE.cpp.o.d"
+  "/root/repo/src/libromdata/Other/EXE_PE.cpp" "src/libromdata/CMakeFiles/romdata.dir/Other/EXE_PE.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Other/EXE_PE.cpp.o.d"
+  "/root/repo/src/libromdata/Other/EXE_manifest.cpp" "src/libromdata/CMakeFiles/romdata.dir/Other/EXE_manifest.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Other/EXE_manifest.cpp.o.d"
+  "/root/repo/src/libromdata/Other/ISO.cpp" "src/libromdata/CMakeFiles/romdata.dir/Other/ISO.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Other/ISO.cpp.o.d"
+  "/root/repo/src/libromdata/Other/MachO.cpp" "src/libromdata/CMakeFiles/romdata.dir/Other/MachO.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Other/MachO.cpp.o.d"
+  "/root/repo/src/libromdata/Other/NintendoBadge.cpp" "src/libromdata/CMakeFiles/romdata.dir/Other/NintendoBadge.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Other/NintendoBadge.cpp.o.d"
+  "/root/repo/src/libromdata/Other/RpTextureWrapper.cpp" "src/libromdata/CMakeFiles/romdata.dir/Other/RpTextureWrapper.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/Other/RpTextureWrapper.cpp.o.d"
+  "/root/repo/src/libromdata/RomDataFactory.cpp" "src/libromdata/CMakeFiles/romdata.dir/RomDataFactory.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/RomDataFactory.cpp.o.d"
+  "/root/repo/src/libromdata/crypto/CtrKeyScrambler.cpp" "src/libromdata/CMakeFiles/romdata.dir/crypto/CtrKeyScrambler.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/crypto/CtrKeyScrambler.cpp.o.d"
+  "/root/repo/src/libromdata/crypto/KeyStoreUI.cpp" "src/libromdata/CMakeFiles/romdata.dir/crypto/KeyStoreUI.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/crypto/KeyStoreUI.cpp.o.d"
+  "/root/repo/src/libromdata/crypto/N3DSVerifyKeys.cpp" "src/libromdata/CMakeFiles/romdata.dir/crypto/N3DSVerifyKeys.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/crypto/N3DSVerifyKeys.cpp.o.d"
+  "/root/repo/src/libromdata/data/AmiiboData.cpp" "src/libromdata/CMakeFiles/romdata.dir/data/AmiiboData.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/data/AmiiboData.cpp.o.d"
+  "/root/repo/src/libromdata/data/ELFData.cpp" "src/libromdata/CMakeFiles/romdata.dir/data/ELFData.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/data/ELFData.cpp.o.d"
+  "/root/repo/src/libromdata/data/EXEData.cpp" "src/libromdata/CMakeFiles/romdata.dir/data/EXEData.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/data/EXEData.cpp.o.d"
+  "/root/repo/src/libromdata/data/MachOData.cpp" "src/libromdata/CMakeFiles/romdata.dir/data/MachOData.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/data/MachOData.cpp.o.d"
+  "/root/repo/src/libromdata/data/NESMappers.cpp" "src/libromdata/CMakeFiles/romdata.dir/data/NESMappers.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/data/NESMappers.cpp.o.d"
+  "/root/repo/src/libromdata/data/Nintendo3DSFirmData.cpp" "src/libromdata/CMakeFiles/romdata.dir/data/Nintendo3DSFirmData.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/data/Nintendo3DSFirmData.cpp.o.d"
+  "/root/repo/src/libromdata/data/Nintendo3DSSysTitles.cpp" "src/libromdata/CMakeFiles/romdata.dir/data/Nintendo3DSSysTitles.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/data/Nintendo3DSSysTitles.cpp.o.d"
+  "/root/repo/src/libromdata/data/NintendoLanguage.cpp" "src/libromdata/CMakeFiles/romdata.dir/data/NintendoLanguage.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/data/NintendoLanguage.cpp.o.d"
+  "/root/repo/src/libromdata/data/NintendoPublishers.cpp" "src/libromdata/CMakeFiles/romdata.dir/data/NintendoPublishers.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/data/NintendoPublishers.cpp.o.d"
+  "/root/repo/src/libromdata/data/SegaPublishers.cpp" "src/libromdata/CMakeFiles/romdata.dir/data/SegaPublishers.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/data/SegaPublishers.cpp.o.d"
+  "/root/repo/src/libromdata/data/WiiSystemMenuVersion.cpp" "src/libromdata/CMakeFiles/romdata.dir/data/WiiSystemMenuVersion.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/data/WiiSystemMenuVersion.cpp.o.d"
+  "/root/repo/src/libromdata/data/WiiUData.cpp" "src/libromdata/CMakeFiles/romdata.dir/data/WiiUData.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/data/WiiUData.cpp.o.d"
+  "/root/repo/src/libromdata/data/Xbox360_STFS_ContentType.cpp" "src/libromdata/CMakeFiles/romdata.dir/data/Xbox360_STFS_ContentType.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/data/Xbox360_STFS_ContentType.cpp.o.d"
+  "/root/repo/src/libromdata/data/XboxLanguage.cpp" "src/libromdata/CMakeFiles/romdata.dir/data/XboxLanguage.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/data/XboxLanguage.cpp.o.d"
+  "/root/repo/src/libromdata/disc/CIAReader.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/CIAReader.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/CIAReader.cpp.o.d"
+  "/root/repo/src/libromdata/disc/Cdrom2352Reader.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/Cdrom2352Reader.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/Cdrom2352Reader.cpp.o.d"
+  "/root/repo/src/libromdata/disc/ChdReader.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/ChdReader.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/ChdReader.cpp.o.d"
+  "/root/repo/src/libromdata/disc/CisoGcnReader.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/CisoGcnReader.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/CisoGcnReader.cpp.o.d"
+  "/root/repo/src/libromdata/disc/GcnFst.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/GcnFst.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/GcnFst.cpp.o.d"
+  "/root/repo/src/libromdata/disc/GcnPartition.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/GcnPartition.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/GcnPartition.cpp.o.d"
+  "/root/repo/src/libromdata/disc/GcnPartitionPrivate.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/GcnPartitionPrivate.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/GcnPartitionPrivate.cpp.o.d"
+  "/root/repo/src/libromdata/disc/GdiReader.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/GdiReader.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/GdiReader.cpp.o.d"
+  "/root/repo/src/libromdata/disc/IResourceReader.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/IResourceReader.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/IResourceReader.cpp.o.d"
+  "/root/repo/src/libromdata/disc/IsoPartition.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/IsoPartition.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/IsoPartition.cpp.o.d"
+  "/root/repo/src/libromdata/disc/NASOSReader.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/NASOSReader.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/NASOSReader.cpp.o.d"
+  "/root/repo/src/libromdata/disc/NCCHReader.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/NCCHReader.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/NCCHReader.cpp.o.d"
+  "/root/repo/src/libromdata/disc/NEResourceReader.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/NEResourceReader.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/NEResourceReader.cpp.o.d"
+  "/root/repo/src/libromdata/disc/PEResourceReader.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/PEResourceReader.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/PEResourceReader.cpp.o.d"
+  "/root/repo/src/libromdata/disc/StfsReader.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/StfsReader.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/StfsReader.cpp.o.d"
+  "/root/repo/src/libromdata/disc/WbfsReader.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/WbfsReader.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/WbfsReader.cpp.o.d"
+  "/root/repo/src/libromdata/disc/WiaReader.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/WiaReader.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/WiaReader.cpp.o.d"
+  "/root/repo/src/libromdata/disc/WiiPartition.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/WiiPartition.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/WiiPartition.cpp.o.d"
+  "/root/repo/src/libromdata/disc/WuxReader.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/WuxReader.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/WuxReader.cpp.o.d"
+  "/root/repo/src/libromdata/disc/XDVDFSPartition.cpp" "src/libromdata/CMakeFiles/romdata.dir/disc/XDVDFSPartition.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/disc/XDVDFSPartition.cpp.o.d"
+  "/root/repo/src/libromdata/img/CacheManager.cpp" "src/libromdata/CMakeFiles/romdata.dir/img/CacheManager.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/img/CacheManager.cpp.o.d"
+  "/root/repo/src/libromdata/img/ExecRpDownload_posix.cpp" "src/libromdata/CMakeFiles/romdata.dir/img/ExecRpDownload_posix.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/img/ExecRpDownload_posix.cpp.o.d"
+  "/root/repo/src/libromdata/utils/SuperMagicDrive.cpp" "src/libromdata/CMakeFiles/romdata.dir/utils/SuperMagicDrive.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/utils/SuperMagicDrive.cpp.o.d"
+  "/root/repo/src/libromdata/utils/SuperMagicDrive_avx2.cpp" "src/libromdata/CMakeFiles/romdata.dir/utils/SuperMagicDrive_avx2.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/utils/SuperMagicDrive_avx2.cpp.o.d"
+  "/root/repo/src/libromdata/utils/SuperMagicDrive_ifunc.cpp" "src/libromdata/CMakeFiles/romdata.dir/utils/SuperMagicDrive_ifunc.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/utils/SuperMagicDrive_ifunc.cpp.o.d"
+  "/root/repo/src/libromdata/utils/SuperMagicDrive_sse2.cpp" "src/libromdata/CMakeFiles/romdata.dir/utils/SuperMagicDrive_sse2.cpp.o" "gcc" "src/libromdata/CMakeFiles/romdata.dir/utils/SuperMagicDrive_sse2.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/src/librptexture/CMakeFiles/rptexture.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpfile/CMakeFiles/rpfile.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpbase/CMakeFiles/rpbase.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpcpu/CMakeFiles/rpcpu.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpthreads/CMakeFiles/rpthreads.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libcachecommon/CMakeFiles/cachecommon.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/tinyxml2/CMakeFiles/tinyxml2.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/unice68/CMakeFiles/unice68_lib.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/libmspack-xenia/CMakeFiles/mspack.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/PowerVR/CMakeFiles/pvrtc.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/inih/CMakeFiles/inih.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libunixcommon/CMakeFiles/unixcommon.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
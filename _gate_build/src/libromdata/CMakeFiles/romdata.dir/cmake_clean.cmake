@@ -0,0 +1,211 @@
+file(REMOVE_RECURSE
+  "../../lib/libromdata.a"
+  "../../lib/libromdata.pdb"
+  "CMakeFiles/romdata.dir/Audio/ADX.cpp.o"
+  "CMakeFiles/romdata.dir/Audio/ADX.cpp.o.d"
+  "CMakeFiles/romdata.dir/Audio/BCSTM.cpp.o"
+  "CMakeFiles/romdata.dir/Audio/BCSTM.cpp.o.d"
+  "CMakeFiles/romdata.dir/Audio/BRSTM.cpp.o"
+  "CMakeFiles/romdata.dir/Audio/BRSTM.cpp.o.d"
+  "CMakeFiles/romdata.dir/Audio/GBS.cpp.o"
+  "CMakeFiles/romdata.dir/Audio/GBS.cpp.o.d"
+  "CMakeFiles/romdata.dir/Audio/NSF.cpp.o"
+  "CMakeFiles/romdata.dir/Audio/NSF.cpp.o.d"
+  "CMakeFiles/romdata.dir/Audio/PSF.cpp.o"
+  "CMakeFiles/romdata.dir/Audio/PSF.cpp.o.d"
+  "CMakeFiles/romdata.dir/Audio/SAP.cpp.o"
+  "CMakeFiles/romdata.dir/Audio/SAP.cpp.o.d"
+  "CMakeFiles/romdata.dir/Audio/SID.cpp.o"
+  "CMakeFiles/romdata.dir/Audio/SID.cpp.o.d"
+  "CMakeFiles/romdata.dir/Audio/SNDH.cpp.o"
+  "CMakeFiles/romdata.dir/Audio/SNDH.cpp.o.d"
+  "CMakeFiles/romdata.dir/Audio/SPC.cpp.o"
+  "CMakeFiles/romdata.dir/Audio/SPC.cpp.o.d"
+  "CMakeFiles/romdata.dir/Audio/VGM.cpp.o"
+  "CMakeFiles/romdata.dir/Audio/VGM.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/Dreamcast.cpp.o"
+  "CMakeFiles/romdata.dir/Console/Dreamcast.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/DreamcastSave.cpp.o"
+  "CMakeFiles/romdata.dir/Console/DreamcastSave.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/GameCube.cpp.o"
+  "CMakeFiles/romdata.dir/Console/GameCube.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/GameCubeBNR.cpp.o"
+  "CMakeFiles/romdata.dir/Console/GameCubeBNR.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/GameCubeRegions.cpp.o"
+  "CMakeFiles/romdata.dir/Console/GameCubeRegions.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/GameCubeSave.cpp.o"
+  "CMakeFiles/romdata.dir/Console/GameCubeSave.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/MegaDrive.cpp.o"
+  "CMakeFiles/romdata.dir/Console/MegaDrive.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/MegaDriveRegions.cpp.o"
+  "CMakeFiles/romdata.dir/Console/MegaDriveRegions.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/N64.cpp.o"
+  "CMakeFiles/romdata.dir/Console/N64.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/NES.cpp.o"
+  "CMakeFiles/romdata.dir/Console/NES.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/PlayStationSave.cpp.o"
+  "CMakeFiles/romdata.dir/Console/PlayStationSave.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/SNES.cpp.o"
+  "CMakeFiles/romdata.dir/Console/SNES.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/Sega8Bit.cpp.o"
+  "CMakeFiles/romdata.dir/Console/Sega8Bit.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/SegaSaturn.cpp.o"
+  "CMakeFiles/romdata.dir/Console/SegaSaturn.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/WiiCommon.cpp.o"
+  "CMakeFiles/romdata.dir/Console/WiiCommon.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/WiiSave.cpp.o"
+  "CMakeFiles/romdata.dir/Console/WiiSave.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/WiiU.cpp.o"
+  "CMakeFiles/romdata.dir/Console/WiiU.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/WiiWAD.cpp.o"
+  "CMakeFiles/romdata.dir/Console/WiiWAD.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/WiiWIBN.cpp.o"
+  "CMakeFiles/romdata.dir/Console/WiiWIBN.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/Xbox360_STFS.cpp.o"
+  "CMakeFiles/romdata.dir/Console/Xbox360_STFS.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/Xbox360_XDBF.cpp.o"
+  "CMakeFiles/romdata.dir/Console/Xbox360_XDBF.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/Xbox360_XEX.cpp.o"
+  "CMakeFiles/romdata.dir/Console/Xbox360_XEX.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/XboxDisc.cpp.o"
+  "CMakeFiles/romdata.dir/Console/XboxDisc.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/Xbox_XBE.cpp.o"
+  "CMakeFiles/romdata.dir/Console/Xbox_XBE.cpp.o.d"
+  "CMakeFiles/romdata.dir/Console/iQuePlayer.cpp.o"
+  "CMakeFiles/romdata.dir/Console/iQuePlayer.cpp.o.d"
+  "CMakeFiles/romdata.dir/Handheld/DMG.cpp.o"
+  "CMakeFiles/romdata.dir/Handheld/DMG.cpp.o.d"
+  "CMakeFiles/romdata.dir/Handheld/GameBoyAdvance.cpp.o"
+  "CMakeFiles/romdata.dir/Handheld/GameBoyAdvance.cpp.o.d"
+  "CMakeFiles/romdata.dir/Handheld/GameCom.cpp.o"
+  "CMakeFiles/romdata.dir/Handheld/GameCom.cpp.o.d"
+  "CMakeFiles/romdata.dir/Handheld/Lynx.cpp.o"
+  "CMakeFiles/romdata.dir/Handheld/Lynx.cpp.o.d"
+  "CMakeFiles/romdata.dir/Handheld/NGPC.cpp.o"
+  "CMakeFiles/romdata.dir/Handheld/NGPC.cpp.o.d"
+  "CMakeFiles/romdata.dir/Handheld/Nintendo3DS.cpp.o"
+  "CMakeFiles/romdata.dir/Handheld/Nintendo3DS.cpp.o.d"
+  "CMakeFiles/romdata.dir/Handheld/Nintendo3DSFirm.cpp.o"
+  "CMakeFiles/romdata.dir/Handheld/Nintendo3DSFirm.cpp.o.d"
+  "CMakeFiles/romdata.dir/Handheld/Nintendo3DS_SMDH.cpp.o"
+  "CMakeFiles/romdata.dir/Handheld/Nintendo3DS_SMDH.cpp.o.d"
+  "CMakeFiles/romdata.dir/Handheld/NintendoDS.cpp.o"
+  "CMakeFiles/romdata.dir/Handheld/NintendoDS.cpp.o.d"
+  "CMakeFiles/romdata.dir/Handheld/PokemonMini.cpp.o"
+  "CMakeFiles/romdata.dir/Handheld/PokemonMini.cpp.o.d"
+  "CMakeFiles/romdata.dir/Handheld/VirtualBoy.cpp.o"
+  "CMakeFiles/romdata.dir/Handheld/VirtualBoy.cpp.o.d"
+  "CMakeFiles/romdata.dir/Other/Amiibo.cpp.o"
+  "CMakeFiles/romdata.dir/Other/Amiibo.cpp.o.d"
+  "CMakeFiles/romdata.dir/Other/ELF.cpp.o"
+  "CMakeFiles/romdata.dir/Other/ELF.cpp.o.d"
+  "CMakeFiles/romdata.dir/Other/EXE.cpp.o"
+  "CMakeFiles/romdata.dir/Other/EXE.cpp.o.d"
+  "CMakeFiles/romdata.dir/Other/EXE_NE.cpp.o"
+  "CMakeFiles/romdata.dir/Other/EXE_NE.cpp.o.d"
+  "CMakeFiles/romdata.dir/Other/EXE_PE.cpp.o"
+  "CMakeFiles/romdata.dir/Other/EXE_PE.cpp.o.d"
+  "CMakeFiles/romdata.dir/Other/EXE_manifest.cpp.o"
+  "CMakeFiles/romdata.dir/Other/EXE_manifest.cpp.o.d"
+  "CMakeFiles/romdata.dir/Other/ISO.cpp.o"
+  "CMakeFiles/romdata.dir/Other/ISO.cpp.o.d"
+  "CMakeFiles/romdata.dir/Other/MachO.cpp.o"
+  "CMakeFiles/romdata.dir/Other/MachO.cpp.o.d"
+  "CMakeFiles/romdata.dir/Other/NintendoBadge.cpp.o"
+  "CMakeFiles/romdata.dir/Other/NintendoBadge.cpp.o.d"
+  "CMakeFiles/romdata.dir/Other/RpTextureWrapper.cpp.o"
+  "CMakeFiles/romdata.dir/Other/RpTextureWrapper.cpp.o.d"
+  "CMakeFiles/romdata.dir/RomDataFactory.cpp.o"
+  "CMakeFiles/romdata.dir/RomDataFactory.cpp.o.d"
+  "CMakeFiles/romdata.dir/crypto/CtrKeyScrambler.cpp.o"
+  "CMakeFiles/romdata.dir/crypto/CtrKeyScrambler.cpp.o.d"
+  "CMakeFiles/romdata.dir/crypto/KeyStoreUI.cpp.o"
+  "CMakeFiles/romdata.dir/crypto/KeyStoreUI.cpp.o.d"
+  "CMakeFiles/romdata.dir/crypto/N3DSVerifyKeys.cpp.o"
+  "CMakeFiles/romdata.dir/crypto/N3DSVerifyKeys.cpp.o.d"
+  "CMakeFiles/romdata.dir/data/AmiiboData.cpp.o"
+  "CMakeFiles/romdata.dir/data/AmiiboData.cpp.o.d"
+  "CMakeFiles/romdata.dir/data/ELFData.cpp.o"
+  "CMakeFiles/romdata.dir/data/ELFData.cpp.o.d"
+  "CMakeFiles/romdata.dir/data/EXEData.cpp.o"
+  "CMakeFiles/romdata.dir/data/EXEData.cpp.o.d"
+  "CMakeFiles/romdata.dir/data/MachOData.cpp.o"
+  "CMakeFiles/romdata.dir/data/MachOData.cpp.o.d"
+  "CMakeFiles/romdata.dir/data/NESMappers.cpp.o"
+  "CMakeFiles/romdata.dir/data/NESMappers.cpp.o.d"
+  "CMakeFiles/romdata.dir/data/Nintendo3DSFirmData.cpp.o"
+  "CMakeFiles/romdata.dir/data/Nintendo3DSFirmData.cpp.o.d"
+  "CMakeFiles/romdata.dir/data/Nintendo3DSSysTitles.cpp.o"
+  "CMakeFiles/romdata.dir/data/Nintendo3DSSysTitles.cpp.o.d"
+  "CMakeFiles/romdata.dir/data/NintendoLanguage.cpp.o"
+  "CMakeFiles/romdata.dir/data/NintendoLanguage.cpp.o.d"
+  "CMakeFiles/romdata.dir/data/NintendoPublishers.cpp.o"
+  "CMakeFiles/romdata.dir/data/NintendoPublishers.cpp.o.d"
+  "CMakeFiles/romdata.dir/data/SegaPublishers.cpp.o"
+  "CMakeFiles/romdata.dir/data/SegaPublishers.cpp.o.d"
+  "CMakeFiles/romdata.dir/data/WiiSystemMenuVersion.cpp.o"
+  "CMakeFiles/romdata.dir/data/WiiSystemMenuVersion.cpp.o.d"
+  "CMakeFiles/romdata.dir/data/WiiUData.cpp.o"
+  "CMakeFiles/romdata.dir/data/WiiUData.cpp.o.d"
+  "CMakeFiles/romdata.dir/data/Xbox360_STFS_ContentType.cpp.o"
+  "CMakeFiles/romdata.dir/data/Xbox360_STFS_ContentType.cpp.o.d"
+  "CMakeFiles/romdata.dir/data/XboxLanguage.cpp.o"
+  "CMakeFiles/romdata.dir/data/XboxLanguage.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/CIAReader.cpp.o"
+  "CMakeFiles/romdata.dir/disc/CIAReader.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/Cdrom2352Reader.cpp.o"
+  "CMakeFiles/romdata.dir/disc/Cdrom2352Reader.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/ChdReader.cpp.o"
+  "CMakeFiles/romdata.dir/disc/ChdReader.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/CisoGcnReader.cpp.o"
+  "CMakeFiles/romdata.dir/disc/CisoGcnReader.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/GcnFst.cpp.o"
+  "CMakeFiles/romdata.dir/disc/GcnFst.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/GcnPartition.cpp.o"
+  "CMakeFiles/romdata.dir/disc/GcnPartition.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/GcnPartitionPrivate.cpp.o"
+  "CMakeFiles/romdata.dir/disc/GcnPartitionPrivate.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/GdiReader.cpp.o"
+  "CMakeFiles/romdata.dir/disc/GdiReader.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/IResourceReader.cpp.o"
+  "CMakeFiles/romdata.dir/disc/IResourceReader.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/IsoPartition.cpp.o"
+  "CMakeFiles/romdata.dir/disc/IsoPartition.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/NASOSReader.cpp.o"
+  "CMakeFiles/romdata.dir/disc/NASOSReader.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/NCCHReader.cpp.o"
+  "CMakeFiles/romdata.dir/disc/NCCHReader.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/NEResourceReader.cpp.o"
+  "CMakeFiles/romdata.dir/disc/NEResourceReader.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/PEResourceReader.cpp.o"
+  "CMakeFiles/romdata.dir/disc/PEResourceReader.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/StfsReader.cpp.o"
+  "CMakeFiles/romdata.dir/disc/StfsReader.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/WbfsReader.cpp.o"
+  "CMakeFiles/romdata.dir/disc/WbfsReader.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/WiaReader.cpp.o"
+  "CMakeFiles/romdata.dir/disc/WiaReader.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/WiiPartition.cpp.o"
+  "CMakeFiles/romdata.dir/disc/WiiPartition.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/WuxReader.cpp.o"
+  "CMakeFiles/romdata.dir/disc/WuxReader.cpp.o.d"
+  "CMakeFiles/romdata.dir/disc/XDVDFSPartition.cpp.o"
+  "CMakeFiles/romdata.dir/disc/XDVDFSPartition.cpp.o.d"
+  "CMakeFiles/romdata.dir/img/CacheManager.cpp.o"
+  "CMakeFiles/romdata.dir/img/CacheManager.cpp.o.d"
+  "CMakeFiles/romdata.dir/img/ExecRpDownload_posix.cpp.o"
+  "CMakeFiles/romdata.dir/img/ExecRpDownload_posix.cpp.o.d"
+  "CMakeFiles/romdata.dir/utils/SuperMagicDrive.cpp.o"
+  "CMakeFiles/romdata.dir/utils/SuperMagicDrive.cpp.o.d"
+  "CMakeFiles/romdata.dir/utils/SuperMagicDrive_avx2.cpp.o"
+  "CMakeFiles/romdata.dir/utils/SuperMagicDrive_avx2.cpp.o.d"
+  "CMakeFiles/romdata.dir/utils/SuperMagicDrive_ifunc.cpp.o"
+  "CMakeFiles/romdata.dir/utils/SuperMagicDrive_ifunc.cpp.o.d"
+  "CMakeFiles/romdata.dir/utils/SuperMagicDrive_sse2.cpp.o"
+  "CMakeFiles/romdata.dir/utils/SuperMagicDrive_sse2.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/romdata.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
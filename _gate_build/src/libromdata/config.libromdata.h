@@ -0,0 +1,27 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * config.libromdata.h.in: LibRomData configuration. (source file)         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_CONFIG_H__
+#define __ROMPROPERTIES_LIBROMDATA_CONFIG_H__
+
+/* libexec path for rp-download */
+#define DIR_INSTALL_LIBEXEC "/usr/local/libexec"
+
+/* Define to 1 if you have the `posix_spawn` function declared in <spawn.h>. */
+#define HAVE_POSIX_SPAWN 1
+
+/* Define to 1 if UnICE68 is enabled. */
+#define ENABLE_UNICE68 1
+
+/* Define to 1 if libmspack-xenia is enabled. */
+#define ENABLE_LIBMSPACK 1
+
+/* Define to 1 if the in-process downloader is enabled. */
+/* #undef ENABLE_INPROC_DOWNLOAD */
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_CONFIG_H__ */
@@ -0,0 +1,20 @@
+file(REMOVE_RECURSE
+  "../../../bin/CtrKeyScramblerTest"
+  "../../../bin/CtrKeyScramblerTest.pdb"
+  "../../../bin/CtrKeyScramblerTest.debug"
+  "../../../bin/FileFormatReplayBench.debug"
+  "../../../bin/GcnFstPrint.debug"
+  "../../../bin/GcnFstTest.debug"
+  "../../../bin/ImageDecoderTest.debug"
+  "../../../bin/RomDataCapSnapshotTest.debug"
+  "../../../bin/SparseDiscReaderTest.debug"
+  "../../../bin/SuperMagicDriveTest.debug"
+  "../../../bin/rp-capgen.debug"
+  "CMakeFiles/CtrKeyScramblerTest.dir/CtrKeyScramblerTest.cpp.o"
+  "CMakeFiles/CtrKeyScramblerTest.dir/CtrKeyScramblerTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/CtrKeyScramblerTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,20 @@
+file(REMOVE_RECURSE
+  "../../../bin/FileFormatReplayBench"
+  "../../../bin/FileFormatReplayBench.pdb"
+  "../../../bin/CtrKeyScramblerTest.debug"
+  "../../../bin/FileFormatReplayBench.debug"
+  "../../../bin/GcnFstPrint.debug"
+  "../../../bin/GcnFstTest.debug"
+  "../../../bin/ImageDecoderTest.debug"
+  "../../../bin/RomDataCapSnapshotTest.debug"
+  "../../../bin/SparseDiscReaderTest.debug"
+  "../../../bin/SuperMagicDriveTest.debug"
+  "../../../bin/rp-capgen.debug"
+  "CMakeFiles/FileFormatReplayBench.dir/img/FileFormatReplayBench.cpp.o"
+  "CMakeFiles/FileFormatReplayBench.dir/img/FileFormatReplayBench.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/FileFormatReplayBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,34 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/libromdata/tests/disc/FstPrint.cpp" "src/libromdata/tests/CMakeFiles/GcnFstPrint.dir/disc/FstPrint.cpp.o" "gcc" "src/libromdata/tests/CMakeFiles/GcnFstPrint.dir/disc/FstPrint.cpp.o.d"
+  "/root/repo/src/libromdata/tests/disc/GcnFstPrint.cpp" "src/libromdata/tests/CMakeFiles/GcnFstPrint.dir/disc/GcnFstPrint.cpp.o" "gcc" "src/libromdata/tests/CMakeFiles/GcnFstPrint.dir/disc/GcnFstPrint.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/src/librpsecure/CMakeFiles/rpsecure.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libromdata/CMakeFiles/romdata.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpbase/CMakeFiles/rpbase.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librptexture/CMakeFiles/rptexture.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpfile/CMakeFiles/rpfile.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/PowerVR/CMakeFiles/pvrtc.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/inih/CMakeFiles/inih.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libcachecommon/CMakeFiles/cachecommon.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpcpu/CMakeFiles/rpcpu.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpthreads/CMakeFiles/rpthreads.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libunixcommon/CMakeFiles/unixcommon.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/tinyxml2/CMakeFiles/tinyxml2.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/unice68/CMakeFiles/unice68_lib.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/libmspack-xenia/CMakeFiles/mspack.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,22 @@
+file(REMOVE_RECURSE
+  "../../../bin/GcnFstPrint"
+  "../../../bin/GcnFstPrint.pdb"
+  "../../../bin/CtrKeyScramblerTest.debug"
+  "../../../bin/FileFormatReplayBench.debug"
+  "../../../bin/GcnFstPrint.debug"
+  "../../../bin/GcnFstTest.debug"
+  "../../../bin/ImageDecoderTest.debug"
+  "../../../bin/RomDataCapSnapshotTest.debug"
+  "../../../bin/SparseDiscReaderTest.debug"
+  "../../../bin/SuperMagicDriveTest.debug"
+  "../../../bin/rp-capgen.debug"
+  "CMakeFiles/GcnFstPrint.dir/disc/FstPrint.cpp.o"
+  "CMakeFiles/GcnFstPrint.dir/disc/FstPrint.cpp.o.d"
+  "CMakeFiles/GcnFstPrint.dir/disc/GcnFstPrint.cpp.o"
+  "CMakeFiles/GcnFstPrint.dir/disc/GcnFstPrint.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/GcnFstPrint.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
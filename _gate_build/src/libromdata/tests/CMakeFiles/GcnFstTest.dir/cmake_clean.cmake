@@ -0,0 +1,22 @@
+file(REMOVE_RECURSE
+  "../../../bin/GcnFstTest"
+  "../../../bin/GcnFstTest.pdb"
+  "../../../bin/CtrKeyScramblerTest.debug"
+  "../../../bin/FileFormatReplayBench.debug"
+  "../../../bin/GcnFstPrint.debug"
+  "../../../bin/GcnFstTest.debug"
+  "../../../bin/ImageDecoderTest.debug"
+  "../../../bin/RomDataCapSnapshotTest.debug"
+  "../../../bin/SparseDiscReaderTest.debug"
+  "../../../bin/SuperMagicDriveTest.debug"
+  "../../../bin/rp-capgen.debug"
+  "CMakeFiles/GcnFstTest.dir/disc/FstPrint.cpp.o"
+  "CMakeFiles/GcnFstTest.dir/disc/FstPrint.cpp.o.d"
+  "CMakeFiles/GcnFstTest.dir/disc/GcnFstTest.cpp.o"
+  "CMakeFiles/GcnFstTest.dir/disc/GcnFstTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/GcnFstTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,20 @@
+file(REMOVE_RECURSE
+  "../../../bin/ImageDecoderTest"
+  "../../../bin/ImageDecoderTest.pdb"
+  "../../../bin/CtrKeyScramblerTest.debug"
+  "../../../bin/FileFormatReplayBench.debug"
+  "../../../bin/GcnFstPrint.debug"
+  "../../../bin/GcnFstTest.debug"
+  "../../../bin/ImageDecoderTest.debug"
+  "../../../bin/RomDataCapSnapshotTest.debug"
+  "../../../bin/SparseDiscReaderTest.debug"
+  "../../../bin/SuperMagicDriveTest.debug"
+  "../../../bin/rp-capgen.debug"
+  "CMakeFiles/ImageDecoderTest.dir/img/ImageDecoderTest.cpp.o"
+  "CMakeFiles/ImageDecoderTest.dir/img/ImageDecoderTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ImageDecoderTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
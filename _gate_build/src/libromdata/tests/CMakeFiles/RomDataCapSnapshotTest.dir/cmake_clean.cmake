@@ -0,0 +1,20 @@
+file(REMOVE_RECURSE
+  "../../../bin/RomDataCapSnapshotTest"
+  "../../../bin/RomDataCapSnapshotTest.pdb"
+  "../../../bin/CtrKeyScramblerTest.debug"
+  "../../../bin/FileFormatReplayBench.debug"
+  "../../../bin/GcnFstPrint.debug"
+  "../../../bin/GcnFstTest.debug"
+  "../../../bin/ImageDecoderTest.debug"
+  "../../../bin/RomDataCapSnapshotTest.debug"
+  "../../../bin/SparseDiscReaderTest.debug"
+  "../../../bin/SuperMagicDriveTest.debug"
+  "../../../bin/rp-capgen.debug"
+  "CMakeFiles/RomDataCapSnapshotTest.dir/RomDataCapSnapshotTest.cpp.o"
+  "CMakeFiles/RomDataCapSnapshotTest.dir/RomDataCapSnapshotTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/RomDataCapSnapshotTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
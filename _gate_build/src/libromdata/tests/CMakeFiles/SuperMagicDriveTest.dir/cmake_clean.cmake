@@ -0,0 +1,20 @@
+file(REMOVE_RECURSE
+  "../../../bin/SuperMagicDriveTest"
+  "../../../bin/SuperMagicDriveTest.pdb"
+  "../../../bin/CtrKeyScramblerTest.debug"
+  "../../../bin/FileFormatReplayBench.debug"
+  "../../../bin/GcnFstPrint.debug"
+  "../../../bin/GcnFstTest.debug"
+  "../../../bin/ImageDecoderTest.debug"
+  "../../../bin/RomDataCapSnapshotTest.debug"
+  "../../../bin/SparseDiscReaderTest.debug"
+  "../../../bin/SuperMagicDriveTest.debug"
+  "../../../bin/rp-capgen.debug"
+  "CMakeFiles/SuperMagicDriveTest.dir/utils/SuperMagicDriveTest.cpp.o"
+  "CMakeFiles/SuperMagicDriveTest.dir/utils/SuperMagicDriveTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/SuperMagicDriveTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,20 @@
+file(REMOVE_RECURSE
+  "../../../bin/rp-capgen"
+  "../../../bin/rp-capgen.pdb"
+  "../../../bin/CtrKeyScramblerTest.debug"
+  "../../../bin/FileFormatReplayBench.debug"
+  "../../../bin/GcnFstPrint.debug"
+  "../../../bin/GcnFstTest.debug"
+  "../../../bin/ImageDecoderTest.debug"
+  "../../../bin/RomDataCapSnapshotTest.debug"
+  "../../../bin/SparseDiscReaderTest.debug"
+  "../../../bin/SuperMagicDriveTest.debug"
+  "../../../bin/rp-capgen.debug"
+  "CMakeFiles/rp-capgen.dir/RomDataCapGen.cpp.o"
+  "CMakeFiles/rp-capgen.dir/RomDataCapGen.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rp-capgen.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,18 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/libromdata/tests
+# Build directory: /root/repo/_gate_build/src/libromdata/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(CtrKeyScramblerTest "/root/repo/_gate_build/bin/CtrKeyScramblerTest")
+set_tests_properties(CtrKeyScramblerTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/libromdata/tests/CMakeLists.txt;15;ADD_TEST;/root/repo/src/libromdata/tests/CMakeLists.txt;0;")
+add_test(RomDataCapSnapshotTest "/root/repo/_gate_build/bin/RomDataCapSnapshotTest")
+set_tests_properties(RomDataCapSnapshotTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/libromdata/tests/CMakeLists.txt;51;ADD_TEST;/root/repo/src/libromdata/tests/CMakeLists.txt;0;")
+add_test(GcnFstTest "/root/repo/_gate_build/bin/GcnFstTest")
+set_tests_properties(GcnFstTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/libromdata/tests/CMakeLists.txt;70;ADD_TEST;/root/repo/src/libromdata/tests/CMakeLists.txt;0;")
+add_test(ImageDecoderTest "/root/repo/_gate_build/bin/ImageDecoderTest" "--gtest_filter=-*Benchmark*")
+set_tests_properties(ImageDecoderTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/libromdata/tests/CMakeLists.txt;108;ADD_TEST;/root/repo/src/libromdata/tests/CMakeLists.txt;0;")
+add_test(SuperMagicDriveTest "/root/repo/_gate_build/bin/SuperMagicDriveTest" "--gtest_filter=-*benchmark*")
+set_tests_properties(SuperMagicDriveTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/libromdata/tests/CMakeLists.txt;163;ADD_TEST;/root/repo/src/libromdata/tests/CMakeLists.txt;0;")
+add_test(SparseDiscReaderTest "/root/repo/_gate_build/bin/SparseDiscReaderTest" "--gtest_filter=-*benchmark*")
+set_tests_properties(SparseDiscReaderTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/libromdata/tests/CMakeLists.txt;172;ADD_TEST;/root/repo/src/libromdata/tests/CMakeLists.txt;0;")
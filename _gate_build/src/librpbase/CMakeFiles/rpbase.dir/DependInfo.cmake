@@ -0,0 +1,58 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/librpbase/TextFuncs_libc.c" "src/librpbase/CMakeFiles/rpbase.dir/TextFuncs_libc.c.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/TextFuncs_libc.c.o.d"
+  "/root/repo/src/librpbase/img/APNG_dlopen.c" "src/librpbase/CMakeFiles/rpbase.dir/img/APNG_dlopen.c.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/img/APNG_dlopen.c.o.d"
+  "/root/repo/src/librpbase/BufferPool.cpp" "src/librpbase/CMakeFiles/rpbase.dir/BufferPool.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/BufferPool.cpp.o.d"
+  "/root/repo/src/librpbase/RomData.cpp" "src/librpbase/CMakeFiles/rpbase.dir/RomData.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/RomData.cpp.o.d"
+  "/root/repo/src/librpbase/RomFields.cpp" "src/librpbase/CMakeFiles/rpbase.dir/RomFields.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/RomFields.cpp.o.d"
+  "/root/repo/src/librpbase/RomMetaData.cpp" "src/librpbase/CMakeFiles/rpbase.dir/RomMetaData.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/RomMetaData.cpp.o.d"
+  "/root/repo/src/librpbase/StringPool.cpp" "src/librpbase/CMakeFiles/rpbase.dir/StringPool.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/StringPool.cpp.o.d"
+  "/root/repo/src/librpbase/SystemRegion.cpp" "src/librpbase/CMakeFiles/rpbase.dir/SystemRegion.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/SystemRegion.cpp.o.d"
+  "/root/repo/src/librpbase/TextFuncs.cpp" "src/librpbase/CMakeFiles/rpbase.dir/TextFuncs.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/TextFuncs.cpp.o.d"
+  "/root/repo/src/librpbase/TextFuncs_conv.cpp" "src/librpbase/CMakeFiles/rpbase.dir/TextFuncs_conv.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/TextFuncs_conv.cpp.o.d"
+  "/root/repo/src/librpbase/TextFuncs_iconv.cpp" "src/librpbase/CMakeFiles/rpbase.dir/TextFuncs_iconv.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/TextFuncs_iconv.cpp.o.d"
+  "/root/repo/src/librpbase/config/AboutTabText.cpp" "src/librpbase/CMakeFiles/rpbase.dir/config/AboutTabText.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/config/AboutTabText.cpp.o.d"
+  "/root/repo/src/librpbase/config/ConfReader.cpp" "src/librpbase/CMakeFiles/rpbase.dir/config/ConfReader.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/config/ConfReader.cpp.o.d"
+  "/root/repo/src/librpbase/config/Config.cpp" "src/librpbase/CMakeFiles/rpbase.dir/config/Config.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/config/Config.cpp.o.d"
+  "/root/repo/src/librpbase/crypto/AesAesni.cpp" "src/librpbase/CMakeFiles/rpbase.dir/crypto/AesAesni.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/crypto/AesAesni.cpp.o.d"
+  "/root/repo/src/librpbase/crypto/AesCipherFactory.cpp" "src/librpbase/CMakeFiles/rpbase.dir/crypto/AesCipherFactory.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/crypto/AesCipherFactory.cpp.o.d"
+  "/root/repo/src/librpbase/crypto/AesNettle.cpp" "src/librpbase/CMakeFiles/rpbase.dir/crypto/AesNettle.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/crypto/AesNettle.cpp.o.d"
+  "/root/repo/src/librpbase/crypto/KeyManager.cpp" "src/librpbase/CMakeFiles/rpbase.dir/crypto/KeyManager.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/crypto/KeyManager.cpp.o.d"
+  "/root/repo/src/librpbase/disc/CBCReader.cpp" "src/librpbase/CMakeFiles/rpbase.dir/disc/CBCReader.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/disc/CBCReader.cpp.o.d"
+  "/root/repo/src/librpbase/disc/DiscReader.cpp" "src/librpbase/CMakeFiles/rpbase.dir/disc/DiscReader.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/disc/DiscReader.cpp.o.d"
+  "/root/repo/src/librpbase/disc/IDiscReader.cpp" "src/librpbase/CMakeFiles/rpbase.dir/disc/IDiscReader.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/disc/IDiscReader.cpp.o.d"
+  "/root/repo/src/librpbase/disc/PartitionFile.cpp" "src/librpbase/CMakeFiles/rpbase.dir/disc/PartitionFile.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/disc/PartitionFile.cpp.o.d"
+  "/root/repo/src/librpbase/disc/SparseDiscReader.cpp" "src/librpbase/CMakeFiles/rpbase.dir/disc/SparseDiscReader.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/disc/SparseDiscReader.cpp.o.d"
+  "/root/repo/src/librpbase/img/IconAnimHelper.cpp" "src/librpbase/CMakeFiles/rpbase.dir/img/IconAnimHelper.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/img/IconAnimHelper.cpp.o.d"
+  "/root/repo/src/librpbase/img/InternalImageCache.cpp" "src/librpbase/CMakeFiles/rpbase.dir/img/InternalImageCache.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/img/InternalImageCache.cpp.o.d"
+  "/root/repo/src/librpbase/img/RpImageLoader.cpp" "src/librpbase/CMakeFiles/rpbase.dir/img/RpImageLoader.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/img/RpImageLoader.cpp.o.d"
+  "/root/repo/src/librpbase/img/RpJpeg.cpp" "src/librpbase/CMakeFiles/rpbase.dir/img/RpJpeg.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/img/RpJpeg.cpp.o.d"
+  "/root/repo/src/librpbase/img/RpJpeg_avx2.cpp" "src/librpbase/CMakeFiles/rpbase.dir/img/RpJpeg_avx2.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/img/RpJpeg_avx2.cpp.o.d"
+  "/root/repo/src/librpbase/img/RpJpeg_ssse3.cpp" "src/librpbase/CMakeFiles/rpbase.dir/img/RpJpeg_ssse3.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/img/RpJpeg_ssse3.cpp.o.d"
+  "/root/repo/src/librpbase/img/RpPng.cpp" "src/librpbase/CMakeFiles/rpbase.dir/img/RpPng.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/img/RpPng.cpp.o.d"
+  "/root/repo/src/librpbase/img/RpPngWriter.cpp" "src/librpbase/CMakeFiles/rpbase.dir/img/RpPngWriter.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/img/RpPngWriter.cpp.o.d"
+  "/root/repo/src/librpbase/img/pngcheck/pngcheck.cpp" "src/librpbase/CMakeFiles/rpbase.dir/img/pngcheck/pngcheck.cpp.o" "gcc" "src/librpbase/CMakeFiles/rpbase.dir/img/pngcheck/pngcheck.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/src/librpcpu/CMakeFiles/rpcpu.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpfile/CMakeFiles/rpfile.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librptexture/CMakeFiles/rptexture.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/inih/CMakeFiles/inih.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpthreads/CMakeFiles/rpthreads.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libcachecommon/CMakeFiles/cachecommon.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libunixcommon/CMakeFiles/unixcommon.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/PowerVR/CMakeFiles/pvrtc.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
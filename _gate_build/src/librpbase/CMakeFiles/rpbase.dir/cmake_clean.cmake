@@ -0,0 +1,73 @@
+file(REMOVE_RECURSE
+  "../../lib/librpbase.a"
+  "../../lib/librpbase.pdb"
+  "CMakeFiles/rpbase.dir/BufferPool.cpp.o"
+  "CMakeFiles/rpbase.dir/BufferPool.cpp.o.d"
+  "CMakeFiles/rpbase.dir/RomData.cpp.o"
+  "CMakeFiles/rpbase.dir/RomData.cpp.o.d"
+  "CMakeFiles/rpbase.dir/RomFields.cpp.o"
+  "CMakeFiles/rpbase.dir/RomFields.cpp.o.d"
+  "CMakeFiles/rpbase.dir/RomMetaData.cpp.o"
+  "CMakeFiles/rpbase.dir/RomMetaData.cpp.o.d"
+  "CMakeFiles/rpbase.dir/StringPool.cpp.o"
+  "CMakeFiles/rpbase.dir/StringPool.cpp.o.d"
+  "CMakeFiles/rpbase.dir/SystemRegion.cpp.o"
+  "CMakeFiles/rpbase.dir/SystemRegion.cpp.o.d"
+  "CMakeFiles/rpbase.dir/TextFuncs.cpp.o"
+  "CMakeFiles/rpbase.dir/TextFuncs.cpp.o.d"
+  "CMakeFiles/rpbase.dir/TextFuncs_conv.cpp.o"
+  "CMakeFiles/rpbase.dir/TextFuncs_conv.cpp.o.d"
+  "CMakeFiles/rpbase.dir/TextFuncs_iconv.cpp.o"
+  "CMakeFiles/rpbase.dir/TextFuncs_iconv.cpp.o.d"
+  "CMakeFiles/rpbase.dir/TextFuncs_libc.c.o"
+  "CMakeFiles/rpbase.dir/TextFuncs_libc.c.o.d"
+  "CMakeFiles/rpbase.dir/config/AboutTabText.cpp.o"
+  "CMakeFiles/rpbase.dir/config/AboutTabText.cpp.o.d"
+  "CMakeFiles/rpbase.dir/config/ConfReader.cpp.o"
+  "CMakeFiles/rpbase.dir/config/ConfReader.cpp.o.d"
+  "CMakeFiles/rpbase.dir/config/Config.cpp.o"
+  "CMakeFiles/rpbase.dir/config/Config.cpp.o.d"
+  "CMakeFiles/rpbase.dir/crypto/AesAesni.cpp.o"
+  "CMakeFiles/rpbase.dir/crypto/AesAesni.cpp.o.d"
+  "CMakeFiles/rpbase.dir/crypto/AesCipherFactory.cpp.o"
+  "CMakeFiles/rpbase.dir/crypto/AesCipherFactory.cpp.o.d"
+  "CMakeFiles/rpbase.dir/crypto/AesNettle.cpp.o"
+  "CMakeFiles/rpbase.dir/crypto/AesNettle.cpp.o.d"
+  "CMakeFiles/rpbase.dir/crypto/KeyManager.cpp.o"
+  "CMakeFiles/rpbase.dir/crypto/KeyManager.cpp.o.d"
+  "CMakeFiles/rpbase.dir/disc/CBCReader.cpp.o"
+  "CMakeFiles/rpbase.dir/disc/CBCReader.cpp.o.d"
+  "CMakeFiles/rpbase.dir/disc/DiscReader.cpp.o"
+  "CMakeFiles/rpbase.dir/disc/DiscReader.cpp.o.d"
+  "CMakeFiles/rpbase.dir/disc/IDiscReader.cpp.o"
+  "CMakeFiles/rpbase.dir/disc/IDiscReader.cpp.o.d"
+  "CMakeFiles/rpbase.dir/disc/PartitionFile.cpp.o"
+  "CMakeFiles/rpbase.dir/disc/PartitionFile.cpp.o.d"
+  "CMakeFiles/rpbase.dir/disc/SparseDiscReader.cpp.o"
+  "CMakeFiles/rpbase.dir/disc/SparseDiscReader.cpp.o.d"
+  "CMakeFiles/rpbase.dir/img/APNG_dlopen.c.o"
+  "CMakeFiles/rpbase.dir/img/APNG_dlopen.c.o.d"
+  "CMakeFiles/rpbase.dir/img/IconAnimHelper.cpp.o"
+  "CMakeFiles/rpbase.dir/img/IconAnimHelper.cpp.o.d"
+  "CMakeFiles/rpbase.dir/img/InternalImageCache.cpp.o"
+  "CMakeFiles/rpbase.dir/img/InternalImageCache.cpp.o.d"
+  "CMakeFiles/rpbase.dir/img/RpImageLoader.cpp.o"
+  "CMakeFiles/rpbase.dir/img/RpImageLoader.cpp.o.d"
+  "CMakeFiles/rpbase.dir/img/RpJpeg.cpp.o"
+  "CMakeFiles/rpbase.dir/img/RpJpeg.cpp.o.d"
+  "CMakeFiles/rpbase.dir/img/RpJpeg_avx2.cpp.o"
+  "CMakeFiles/rpbase.dir/img/RpJpeg_avx2.cpp.o.d"
+  "CMakeFiles/rpbase.dir/img/RpJpeg_ssse3.cpp.o"
+  "CMakeFiles/rpbase.dir/img/RpJpeg_ssse3.cpp.o.d"
+  "CMakeFiles/rpbase.dir/img/RpPng.cpp.o"
+  "CMakeFiles/rpbase.dir/img/RpPng.cpp.o.d"
+  "CMakeFiles/rpbase.dir/img/RpPngWriter.cpp.o"
+  "CMakeFiles/rpbase.dir/img/RpPngWriter.cpp.o.d"
+  "CMakeFiles/rpbase.dir/img/pngcheck/pngcheck.cpp.o"
+  "CMakeFiles/rpbase.dir/img/pngcheck/pngcheck.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/rpbase.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
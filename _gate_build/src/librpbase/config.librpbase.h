@@ -0,0 +1,140 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * config.librpbase.h.in: LibRpBase configuration. (source file)           *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_CONFIG_H__
+#define __ROMPROPERTIES_LIBRPBASE_CONFIG_H__
+
+/* Define to 1 if you have zlib. */
+#define HAVE_ZLIB 1
+
+/* Define to 1 if we're using the internal copy of zlib. */
+/* #undef USE_INTERNAL_ZLIB */
+
+/* Define to 1 if we're using the internal copy of zlib as a DLL. */
+/* #undef USE_INTERNAL_ZLIB_DLL */
+
+/* Define to 1 if zlib is a DLL. */
+#if !defined(USE_INTERNAL_ZLIB) || defined(USE_INTERNAL_ZLIB_DLL)
+# define ZLIB_IS_DLL 1
+#endif
+
+/* Define to 1 if you have libpng. */
+#define HAVE_PNG 1
+
+/* Define to 1 if we're using the internal copy of libpng. */
+/* #undef USE_INTERNAL_PNG */
+
+/* Define to 1 if we're using the internal copy of libpng as a DLL. */
+/* #undef USE_INTERNAL_PNG_DLL */
+
+/* Define to 1 if libpng is a DLL. */
+#if !defined(USE_INTERNAL_PNG) || defined(USE_INTERNAL_PNG_DLL)
+# define PNG_IS_DLL 1
+#endif
+
+/* Define to 1 if you have libjpeg. */
+#define HAVE_JPEG 1
+
+/* Define to 1 if you have the `strnlen' function. */
+#define HAVE_STRNLEN 1
+
+/* Define to 1 if you have the `memmem' function. */
+/* #undef HAVE_MEMMEM */
+
+/* Define to 1 if you have the `nl_langinfo` function. */
+#define HAVE_NL_LANGINFO 1
+
+/* Define to 1 if `struct lconv` has wchar_t fields. */
+/* #undef HAVE_STRUCT_LCONV_WCHAR_T */
+
+/* Define to 1 if decryption should be enabled. */
+#define ENABLE_DECRYPTION 1
+
+/* Define to 1 if we're using nettle for decryption. */
+#define HAVE_NETTLE 1
+
+/* Define to 1 if we're using nettle and it is v3.0 or later. */
+#define HAVE_NETTLE_3 1
+
+/* Define to 1 if "nettle/version.h" is present. */
+#define HAVE_NETTLE_VERSION_H
+
+/* Define to 1 if nettle version functions are present. */
+#define HAVE_NETTLE_VERSION_FUNCTIONS
+
+/* Define to 1 if XML parsing is enabled. */
+#define ENABLE_XML 1
+
+/* Define to 1 if we're using the internal copy of TinyXML2. */
+#define USE_INTERNAL_XML 1
+
+/* Define to 1 if we're using the internal copy of TinyXML2 as a DLL. */
+/* #undef USE_INTERNAL_XML_DLL */
+
+/* Define to 1 if TinyXML2 is a DLL. */
+#if !defined(USE_INTERNAL_XML) || defined(USE_INTERNAL_XML_DLL)
+# define XML_IS_DLL 1
+#endif
+
+/** Aligned malloc() functions. **/
+
+/* Define to 1 if you have the MSVC-specific `_aligned_malloc` function. */
+/* #undef HAVE_MSVC_ALIGNED_MALLOC */
+
+/* Define to 1 if you have the `aligned_alloc` function. */
+/* #undef HAVE_ALIGNED_ALLOC */
+
+/* Define to 1 if you have the `posix_memalign` function. */
+#define HAVE_POSIX_MEMALIGN 1
+
+/* Define to 1 if you have the `memalign` function. */
+#define HAVE_MEMALIGN 1
+
+/** iconv **/
+
+/* Define to 1 if you have iconv() in either libc or libiconv. */
+#define HAVE_ICONV 1
+
+/* Define to 1 if iconv() is defined in libiconv. */
+/* #undef HAVE_ICONV_LIBICONV */
+
+/** Time functions **/
+
+/* Define to 1 if you have the `gmtime_r` function. */
+#define HAVE_GMTIME_R 1
+
+/* Define to 1 if you have the `gmtime_s` function. */
+/* #undef HAVE_GMTIME_S */
+
+/* Define to 1 if you have the `localtime_r' function. */
+#define HAVE_LOCALTIME_R 1
+
+/* Define to 1 if you have the `localtime_s' function. */
+/* #undef HAVE_LOCALTIME_S */
+
+/* Define to 1 if you have the `timegm' function. */
+#define HAVE_TIMEGM 1
+
+/* Define to 1 if you have the `_mkgmtime' function. */
+/* #undef HAVE__MKGMTIME */
+
+/* Define to 1 if you have the `_mkgmtime32' function. */
+/* #undef HAVE__MKGMTIME32 */
+
+/* Define to 1 if you have the `_mkgmtime64' function. */
+/* #undef HAVE__MKGMTIME64 */
+
+/** C++ standard library **/
+
+/* Define to 1 if you have the `unordered_map::reserve` function. */
+#define HAVE_UNORDERED_MAP_RESERVE 1
+
+/* Define to 1 if you have the `unordered_set::reserve` function. */
+#define HAVE_UNORDERED_SET_RESERVE 1
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_CONFIG_H__ */
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "../../../bin/AesCipherTest"
+  "../../../bin/AesCipherTest.pdb"
+  "../../../bin/AesCipherTest.debug"
+  "../../../bin/RpImageLoaderTest.debug"
+  "../../../bin/TextFuncsTest.debug"
+  "../../../bin/TimegmTest.debug"
+  "CMakeFiles/AesCipherTest.dir/AesCipherTest.cpp.o"
+  "CMakeFiles/AesCipherTest.dir/AesCipherTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/AesCipherTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "../../../bin/RpImageLoaderTest"
+  "../../../bin/RpImageLoaderTest.pdb"
+  "../../../bin/AesCipherTest.debug"
+  "../../../bin/RpImageLoaderTest.debug"
+  "../../../bin/TextFuncsTest.debug"
+  "../../../bin/TimegmTest.debug"
+  "CMakeFiles/RpImageLoaderTest.dir/img/RpImageLoaderTest.cpp.o"
+  "CMakeFiles/RpImageLoaderTest.dir/img/RpImageLoaderTest.cpp.o.d"
+  "CMakeFiles/RpImageLoaderTest.dir/img/RpPngFormatTest.cpp.o"
+  "CMakeFiles/RpImageLoaderTest.dir/img/RpPngFormatTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/RpImageLoaderTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "../../../bin/TextFuncsTest"
+  "../../../bin/TextFuncsTest.pdb"
+  "../../../bin/AesCipherTest.debug"
+  "../../../bin/RpImageLoaderTest.debug"
+  "../../../bin/TextFuncsTest.debug"
+  "../../../bin/TimegmTest.debug"
+  "CMakeFiles/TextFuncsTest.dir/TextFuncsTest.cpp.o"
+  "CMakeFiles/TextFuncsTest.dir/TextFuncsTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TextFuncsTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
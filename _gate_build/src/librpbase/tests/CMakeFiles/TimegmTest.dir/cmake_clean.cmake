@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "../../../bin/TimegmTest"
+  "../../../bin/TimegmTest.pdb"
+  "../../../bin/AesCipherTest.debug"
+  "../../../bin/RpImageLoaderTest.debug"
+  "../../../bin/TextFuncsTest.debug"
+  "../../../bin/TimegmTest.debug"
+  "CMakeFiles/TimegmTest.dir/TimegmTest.cpp.o"
+  "CMakeFiles/TimegmTest.dir/TimegmTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/TimegmTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,15 @@
+file(REMOVE_RECURSE
+  "../../../lib/librptest.a"
+  "../../../lib/librptest.pdb"
+  "../../../bin/AesCipherTest.debug"
+  "../../../bin/RpImageLoaderTest.debug"
+  "../../../bin/TextFuncsTest.debug"
+  "../../../bin/TimegmTest.debug"
+  "CMakeFiles/rptest.dir/gtest_init.cpp.o"
+  "CMakeFiles/rptest.dir/gtest_init.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rptest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
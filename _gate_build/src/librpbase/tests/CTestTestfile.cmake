@@ -0,0 +1,14 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/librpbase/tests
+# Build directory: /root/repo/_gate_build/src/librpbase/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(RpImageLoaderTest "/root/repo/_gate_build/bin/RpImageLoaderTest")
+set_tests_properties(RpImageLoaderTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/librpbase/tests/CMakeLists.txt;42;ADD_TEST;/root/repo/src/librpbase/tests/CMakeLists.txt;0;")
+add_test(AesCipherTest "/root/repo/_gate_build/bin/AesCipherTest")
+set_tests_properties(AesCipherTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/librpbase/tests/CMakeLists.txt;81;ADD_TEST;/root/repo/src/librpbase/tests/CMakeLists.txt;0;")
+add_test(TextFuncsTest "/root/repo/_gate_build/bin/TextFuncsTest")
+set_tests_properties(TextFuncsTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/librpbase/tests/CMakeLists.txt;94;ADD_TEST;/root/repo/src/librpbase/tests/CMakeLists.txt;0;")
+add_test(TimegmTest "/root/repo/_gate_build/bin/TimegmTest")
+set_tests_properties(TimegmTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/librpbase/tests/CMakeLists.txt;103;ADD_TEST;/root/repo/src/librpbase/tests/CMakeLists.txt;0;")
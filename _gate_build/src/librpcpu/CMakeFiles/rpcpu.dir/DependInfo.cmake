@@ -0,0 +1,24 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/librpcpu/byteswap.c" "src/librpcpu/CMakeFiles/rpcpu.dir/byteswap.c.o" "gcc" "src/librpcpu/CMakeFiles/rpcpu.dir/byteswap.c.o.d"
+  "/root/repo/src/librpcpu/byteswap_ifunc.c" "src/librpcpu/CMakeFiles/rpcpu.dir/byteswap_ifunc.c.o" "gcc" "src/librpcpu/CMakeFiles/rpcpu.dir/byteswap_ifunc.c.o.d"
+  "/root/repo/src/librpcpu/byteswap_sse2.c" "src/librpcpu/CMakeFiles/rpcpu.dir/byteswap_sse2.c.o" "gcc" "src/librpcpu/CMakeFiles/rpcpu.dir/byteswap_sse2.c.o.d"
+  "/root/repo/src/librpcpu/byteswap_ssse3.c" "src/librpcpu/CMakeFiles/rpcpu.dir/byteswap_ssse3.c.o" "gcc" "src/librpcpu/CMakeFiles/rpcpu.dir/byteswap_ssse3.c.o.d"
+  "/root/repo/src/librpcpu/cpuflags_x86.c" "src/librpcpu/CMakeFiles/rpcpu.dir/cpuflags_x86.c.o" "gcc" "src/librpcpu/CMakeFiles/rpcpu.dir/cpuflags_x86.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/src/librpthreads/CMakeFiles/rpthreads.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,19 @@
+file(REMOVE_RECURSE
+  "../../lib/librpcpu.a"
+  "../../lib/librpcpu.pdb"
+  "CMakeFiles/rpcpu.dir/byteswap.c.o"
+  "CMakeFiles/rpcpu.dir/byteswap.c.o.d"
+  "CMakeFiles/rpcpu.dir/byteswap_ifunc.c.o"
+  "CMakeFiles/rpcpu.dir/byteswap_ifunc.c.o.d"
+  "CMakeFiles/rpcpu.dir/byteswap_sse2.c.o"
+  "CMakeFiles/rpcpu.dir/byteswap_sse2.c.o.d"
+  "CMakeFiles/rpcpu.dir/byteswap_ssse3.c.o"
+  "CMakeFiles/rpcpu.dir/byteswap_ssse3.c.o.d"
+  "CMakeFiles/rpcpu.dir/cpuflags_x86.c.o"
+  "CMakeFiles/rpcpu.dir/cpuflags_x86.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/rpcpu.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,24 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpcpu)                         *
+ * config.byteswap.h.in: Byteswap intrinsics configuration. (source file)  *
+ *                                                                         *
+ * Copyright (c) 2016-2018 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPCPU_CONFIG_BYTESWAP_H__
+#define __ROMPROPERTIES_LIBRPCPU_CONFIG_BYTESWAP_H__
+
+/* Define to 1 if you have the <features.h> header file. */
+#define HAVE_FEATURES_H 1
+
+/* Define to 1 if you have __builtin_bswap16(). */
+#define HAVE___BUILTIN_BSWAP16 1
+
+/* Define to 1 if you have __builtin_bswap32(). */
+#define HAVE___BUILTIN_BSWAP32 1
+
+/* Define to 1 if you have __builtin_bswap64(). */
+#define HAVE___BUILTIN_BSWAP64 1
+
+#endif /* __ROMPROPERTIES_LIBRPCPU_CONFIG_BYTESWAP_H__ */
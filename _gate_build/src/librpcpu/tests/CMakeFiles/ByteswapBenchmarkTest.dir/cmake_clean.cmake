@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../../../bin/ByteswapBenchmarkTest"
+  "../../../bin/ByteswapBenchmarkTest.pdb"
+  "../../../bin/ByteswapBenchmarkTest.debug"
+  "../../../bin/ByteswapTest.debug"
+  "CMakeFiles/ByteswapBenchmarkTest.dir/ByteswapBenchmarkTest.cpp.o"
+  "CMakeFiles/ByteswapBenchmarkTest.dir/ByteswapBenchmarkTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ByteswapBenchmarkTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../../../bin/ByteswapTest"
+  "../../../bin/ByteswapTest.pdb"
+  "../../../bin/ByteswapBenchmarkTest.debug"
+  "../../../bin/ByteswapTest.debug"
+  "CMakeFiles/ByteswapTest.dir/ByteswapTest.cpp.o"
+  "CMakeFiles/ByteswapTest.dir/ByteswapTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ByteswapTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/librpcpu/tests
+# Build directory: /root/repo/_gate_build/src/librpcpu/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(ByteswapTest "/root/repo/_gate_build/bin/ByteswapTest" "--gtest_filter=-*benchmark*")
+set_tests_properties(ByteswapTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/librpcpu/tests/CMakeLists.txt;17;ADD_TEST;/root/repo/src/librpcpu/tests/CMakeLists.txt;0;")
+add_test(ByteswapBenchmarkTest "/root/repo/_gate_build/bin/ByteswapBenchmarkTest")
+set_tests_properties(ByteswapBenchmarkTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/librpcpu/tests/CMakeLists.txt;33;ADD_TEST;/root/repo/src/librpcpu/tests/CMakeLists.txt;0;")
@@ -0,0 +1,41 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/librpfile/ConcatFile.cpp" "src/librpfile/CMakeFiles/rpfile.dir/ConcatFile.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/ConcatFile.cpp.o.d"
+  "/root/repo/src/librpfile/DirScanner.cpp" "src/librpfile/CMakeFiles/rpfile.dir/DirScanner.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/DirScanner.cpp.o.d"
+  "/root/repo/src/librpfile/FileSystem_common.cpp" "src/librpfile/CMakeFiles/rpfile.dir/FileSystem_common.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/FileSystem_common.cpp.o.d"
+  "/root/repo/src/librpfile/FileSystem_posix.cpp" "src/librpfile/CMakeFiles/rpfile.dir/FileSystem_posix.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/FileSystem_posix.cpp.o.d"
+  "/root/repo/src/librpfile/IRpFile.cpp" "src/librpfile/CMakeFiles/rpfile.dir/IRpFile.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/IRpFile.cpp.o.d"
+  "/root/repo/src/librpfile/RelatedFile.cpp" "src/librpfile/CMakeFiles/rpfile.dir/RelatedFile.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/RelatedFile.cpp.o.d"
+  "/root/repo/src/librpfile/RpBufferedFile.cpp" "src/librpfile/CMakeFiles/rpfile.dir/RpBufferedFile.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/RpBufferedFile.cpp.o.d"
+  "/root/repo/src/librpfile/RpFile_stdio.cpp" "src/librpfile/CMakeFiles/rpfile.dir/RpFile_stdio.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/RpFile_stdio.cpp.o.d"
+  "/root/repo/src/librpfile/RpMemFile.cpp" "src/librpfile/CMakeFiles/rpfile.dir/RpMemFile.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/RpMemFile.cpp.o.d"
+  "/root/repo/src/librpfile/RpMmapFile.cpp" "src/librpfile/CMakeFiles/rpfile.dir/RpMmapFile.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/RpMmapFile.cpp.o.d"
+  "/root/repo/src/librpfile/RpStats.cpp" "src/librpfile/CMakeFiles/rpfile.dir/RpStats.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/RpStats.cpp.o.d"
+  "/root/repo/src/librpfile/RpVectorFile.cpp" "src/librpfile/CMakeFiles/rpfile.dir/RpVectorFile.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/RpVectorFile.cpp.o.d"
+  "/root/repo/src/librpfile/RpZipFile.cpp" "src/librpfile/CMakeFiles/rpfile.dir/RpZipFile.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/RpZipFile.cpp.o.d"
+  "/root/repo/src/librpfile/scsi/RpFile_Kreon.cpp" "src/librpfile/CMakeFiles/rpfile.dir/scsi/RpFile_Kreon.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/scsi/RpFile_Kreon.cpp.o.d"
+  "/root/repo/src/librpfile/scsi/RpFile_scsi.cpp" "src/librpfile/CMakeFiles/rpfile.dir/scsi/RpFile_scsi.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/scsi/RpFile_scsi.cpp.o.d"
+  "/root/repo/src/librpfile/scsi/RpFile_scsi_linux.cpp" "src/librpfile/CMakeFiles/rpfile.dir/scsi/RpFile_scsi_linux.cpp.o" "gcc" "src/librpfile/CMakeFiles/rpfile.dir/scsi/RpFile_scsi_linux.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/src/librpcpu/CMakeFiles/rpcpu.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpthreads/CMakeFiles/rpthreads.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librptexture/CMakeFiles/rptexture.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/inih/CMakeFiles/inih.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libcachecommon/CMakeFiles/cachecommon.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/PowerVR/CMakeFiles/pvrtc.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libunixcommon/CMakeFiles/unixcommon.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,41 @@
+file(REMOVE_RECURSE
+  "../../lib/librpfile.a"
+  "../../lib/librpfile.pdb"
+  "CMakeFiles/rpfile.dir/ConcatFile.cpp.o"
+  "CMakeFiles/rpfile.dir/ConcatFile.cpp.o.d"
+  "CMakeFiles/rpfile.dir/DirScanner.cpp.o"
+  "CMakeFiles/rpfile.dir/DirScanner.cpp.o.d"
+  "CMakeFiles/rpfile.dir/FileSystem_common.cpp.o"
+  "CMakeFiles/rpfile.dir/FileSystem_common.cpp.o.d"
+  "CMakeFiles/rpfile.dir/FileSystem_posix.cpp.o"
+  "CMakeFiles/rpfile.dir/FileSystem_posix.cpp.o.d"
+  "CMakeFiles/rpfile.dir/IRpFile.cpp.o"
+  "CMakeFiles/rpfile.dir/IRpFile.cpp.o.d"
+  "CMakeFiles/rpfile.dir/RelatedFile.cpp.o"
+  "CMakeFiles/rpfile.dir/RelatedFile.cpp.o.d"
+  "CMakeFiles/rpfile.dir/RpBufferedFile.cpp.o"
+  "CMakeFiles/rpfile.dir/RpBufferedFile.cpp.o.d"
+  "CMakeFiles/rpfile.dir/RpFile_stdio.cpp.o"
+  "CMakeFiles/rpfile.dir/RpFile_stdio.cpp.o.d"
+  "CMakeFiles/rpfile.dir/RpMemFile.cpp.o"
+  "CMakeFiles/rpfile.dir/RpMemFile.cpp.o.d"
+  "CMakeFiles/rpfile.dir/RpMmapFile.cpp.o"
+  "CMakeFiles/rpfile.dir/RpMmapFile.cpp.o.d"
+  "CMakeFiles/rpfile.dir/RpStats.cpp.o"
+  "CMakeFiles/rpfile.dir/RpStats.cpp.o.d"
+  "CMakeFiles/rpfile.dir/RpVectorFile.cpp.o"
+  "CMakeFiles/rpfile.dir/RpVectorFile.cpp.o.d"
+  "CMakeFiles/rpfile.dir/RpZipFile.cpp.o"
+  "CMakeFiles/rpfile.dir/RpZipFile.cpp.o.d"
+  "CMakeFiles/rpfile.dir/scsi/RpFile_Kreon.cpp.o"
+  "CMakeFiles/rpfile.dir/scsi/RpFile_Kreon.cpp.o.d"
+  "CMakeFiles/rpfile.dir/scsi/RpFile_scsi.cpp.o"
+  "CMakeFiles/rpfile.dir/scsi/RpFile_scsi.cpp.o.d"
+  "CMakeFiles/rpfile.dir/scsi/RpFile_scsi_linux.cpp.o"
+  "CMakeFiles/rpfile.dir/scsi/RpFile_scsi_linux.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rpfile.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
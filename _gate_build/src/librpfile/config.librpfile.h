@@ -0,0 +1,37 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * config.librpfile.h.in: LibRpFile configuration. (source file)           *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_CONFIG_H__
+#define __ROMPROPERTIES_LIBRPFILE_CONFIG_H__
+
+/* Define to 1 if you have zlib. */
+#define HAVE_ZLIB 1
+
+/* Define to 1 if we're using the internal copy of zlib. */
+/* #undef USE_INTERNAL_ZLIB */
+
+/* Define to 1 if we're using the internal copy of zlib as a DLL. */
+/* #undef USE_INTERNAL_ZLIB_DLL */
+
+/* Define to 1 if zlib is a DLL. */
+#if !defined(USE_INTERNAL_ZLIB) || defined(USE_INTERNAL_ZLIB_DLL)
+# define ZLIB_IS_DLL 1
+#endif
+
+/* Define to 1 if you have the `statx` function. */
+#define HAVE_STATX 1
+
+/** Other miscellaneous functionality **/
+
+/* Define to 1 if support for SCSI commands is implemented for this operating system. */
+#define RP_OS_SCSI_SUPPORTED 1
+
+/* Define to 1 to enable lightweight runtime statistics counters. */
+#define ENABLE_RP_STATS 1
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_CONFIG_H__ */
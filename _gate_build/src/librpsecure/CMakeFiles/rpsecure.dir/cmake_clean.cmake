@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "../../lib/librpsecure.a"
+  "../../lib/librpsecure.pdb"
+  "CMakeFiles/rpsecure.dir/os-secure_dummy.c.o"
+  "CMakeFiles/rpsecure.dir/os-secure_dummy.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/rpsecure.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,27 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpsecure)                      *
+ * config.librpsecure.h.in: librpsecure configuration. (source file)       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPSECURE_CONFIG_H__
+#define __ROMPROPERTIES_LIBRPSECURE_CONFIG_H__
+
+/* Define to 1 if you have the OpenBSD 5.8 `tame` function. */
+/* #undef HAVE_TAME */
+
+/* Define to 1 if you have the OpenBSD 5.9+ `pledge` function. */
+/* #undef HAVE_PLEDGE */
+
+/* Define to 1 if you have the OpenBSD 6.3+ `pledge` function with `execpromises`. */
+/* #undef HAVE_PLEDGE_EXECPROMISES */
+
+/* Define to 1 if you have the Linux `seccomp` library. */
+/* #undef HAVE_SECCOMP */
+
+/* Define to 1 to enable seccomp debugging. */
+/* #undef ENABLE_SECCOMP_DEBUG */
+
+#endif /* __ROMPROPERTIES_LIBRPSECURE_CONFIG_H__ */
@@ -0,0 +1,68 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/librptexture/FileFormatFactory.cpp" "src/librptexture/CMakeFiles/rptexture.dir/FileFormatFactory.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/FileFormatFactory.cpp.o.d"
+  "/root/repo/src/librptexture/data/DX10Formats.cpp" "src/librptexture/CMakeFiles/rptexture.dir/data/DX10Formats.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/data/DX10Formats.cpp.o.d"
+  "/root/repo/src/librptexture/data/GLenumStrings.cpp" "src/librptexture/CMakeFiles/rptexture.dir/data/GLenumStrings.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/data/GLenumStrings.cpp.o.d"
+  "/root/repo/src/librptexture/data/KhronosFormatTables.cpp" "src/librptexture/CMakeFiles/rptexture.dir/data/KhronosFormatTables.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/data/KhronosFormatTables.cpp.o.d"
+  "/root/repo/src/librptexture/data/VkEnumStrings.cpp" "src/librptexture/CMakeFiles/rptexture.dir/data/VkEnumStrings.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/data/VkEnumStrings.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/DecodeContext.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/DecodeContext.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/DecodeContext.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/ImageDecoder_BC7.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_BC7.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_BC7.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/ImageDecoder_DC.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_DC.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_DC.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/ImageDecoder_ETC1.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_ETC1.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_ETC1.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/ImageDecoder_GCN.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_GCN.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_GCN.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/ImageDecoder_Linear.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/ImageDecoder_Linear_avx2.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear_avx2.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear_avx2.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/ImageDecoder_Linear_sse2.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear_sse2.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear_sse2.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/ImageDecoder_Linear_ssse3.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear_ssse3.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear_ssse3.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/ImageDecoder_N3DS.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_N3DS.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_N3DS.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/ImageDecoder_NDS.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_NDS.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_NDS.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/ImageDecoder_PVRTC.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_PVRTC.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_PVRTC.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/ImageDecoder_S3TC.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_S3TC.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_S3TC.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/ImageDecoder_ifunc.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_ifunc.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ImageDecoder_ifunc.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/ParallelDecode.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ParallelDecode.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/ParallelDecode.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/PixelConversion.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/PixelConversion.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/PixelConversion.cpp.o.d"
+  "/root/repo/src/librptexture/decoder/UntileCache.cpp" "src/librptexture/CMakeFiles/rptexture.dir/decoder/UntileCache.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/decoder/UntileCache.cpp.o.d"
+  "/root/repo/src/librptexture/fileformat/DidjTex.cpp" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/DidjTex.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/DidjTex.cpp.o.d"
+  "/root/repo/src/librptexture/fileformat/DirectDrawSurface.cpp" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/DirectDrawSurface.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/DirectDrawSurface.cpp.o.d"
+  "/root/repo/src/librptexture/fileformat/FileFormat.cpp" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/FileFormat.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/FileFormat.cpp.o.d"
+  "/root/repo/src/librptexture/fileformat/KhronosKTX.cpp" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/KhronosKTX.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/KhronosKTX.cpp.o.d"
+  "/root/repo/src/librptexture/fileformat/KhronosKTX2.cpp" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/KhronosKTX2.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/KhronosKTX2.cpp.o.d"
+  "/root/repo/src/librptexture/fileformat/PowerVR3.cpp" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/PowerVR3.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/PowerVR3.cpp.o.d"
+  "/root/repo/src/librptexture/fileformat/SegaPVR.cpp" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/SegaPVR.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/SegaPVR.cpp.o.d"
+  "/root/repo/src/librptexture/fileformat/ValveVTF.cpp" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/ValveVTF.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/ValveVTF.cpp.o.d"
+  "/root/repo/src/librptexture/fileformat/ValveVTF3.cpp" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/ValveVTF3.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/ValveVTF3.cpp.o.d"
+  "/root/repo/src/librptexture/fileformat/XboxXPR.cpp" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/XboxXPR.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/fileformat/XboxXPR.cpp.o.d"
+  "/root/repo/src/librptexture/img/ImageConv.cpp" "src/librptexture/CMakeFiles/rptexture.dir/img/ImageConv.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/img/ImageConv.cpp.o.d"
+  "/root/repo/src/librptexture/img/ImageConv_avx2.cpp" "src/librptexture/CMakeFiles/rptexture.dir/img/ImageConv_avx2.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/img/ImageConv_avx2.cpp.o.d"
+  "/root/repo/src/librptexture/img/ImageConv_ssse3.cpp" "src/librptexture/CMakeFiles/rptexture.dir/img/ImageConv_ssse3.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/img/ImageConv_ssse3.cpp.o.d"
+  "/root/repo/src/librptexture/img/rp_image.cpp" "src/librptexture/CMakeFiles/rptexture.dir/img/rp_image.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/img/rp_image.cpp.o.d"
+  "/root/repo/src/librptexture/img/rp_image_backend.cpp" "src/librptexture/CMakeFiles/rptexture.dir/img/rp_image_backend.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/img/rp_image_backend.cpp.o.d"
+  "/root/repo/src/librptexture/img/rp_image_ops.cpp" "src/librptexture/CMakeFiles/rptexture.dir/img/rp_image_ops.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/img/rp_image_ops.cpp.o.d"
+  "/root/repo/src/librptexture/img/rp_image_ops_sse2.cpp" "src/librptexture/CMakeFiles/rptexture.dir/img/rp_image_ops_sse2.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/img/rp_image_ops_sse2.cpp.o.d"
+  "/root/repo/src/librptexture/img/rp_image_ops_sse41.cpp" "src/librptexture/CMakeFiles/rptexture.dir/img/rp_image_ops_sse41.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/img/rp_image_ops_sse41.cpp.o.d"
+  "/root/repo/src/librptexture/img/un-premultiply.cpp" "src/librptexture/CMakeFiles/rptexture.dir/img/un-premultiply.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/img/un-premultiply.cpp.o.d"
+  "/root/repo/src/librptexture/img/un-premultiply_avx2.cpp" "src/librptexture/CMakeFiles/rptexture.dir/img/un-premultiply_avx2.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/img/un-premultiply_avx2.cpp.o.d"
+  "/root/repo/src/librptexture/img/un-premultiply_sse41.cpp" "src/librptexture/CMakeFiles/rptexture.dir/img/un-premultiply_sse41.cpp.o" "gcc" "src/librptexture/CMakeFiles/rptexture.dir/img/un-premultiply_sse41.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/src/librpcpu/CMakeFiles/rpcpu.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpfile/CMakeFiles/rpfile.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpthreads/CMakeFiles/rpthreads.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/PowerVR/CMakeFiles/pvrtc.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/inih/CMakeFiles/inih.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libcachecommon/CMakeFiles/cachecommon.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libunixcommon/CMakeFiles/unixcommon.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,95 @@
+file(REMOVE_RECURSE
+  "../../lib/librptexture.a"
+  "../../lib/librptexture.pdb"
+  "CMakeFiles/rptexture.dir/FileFormatFactory.cpp.o"
+  "CMakeFiles/rptexture.dir/FileFormatFactory.cpp.o.d"
+  "CMakeFiles/rptexture.dir/data/DX10Formats.cpp.o"
+  "CMakeFiles/rptexture.dir/data/DX10Formats.cpp.o.d"
+  "CMakeFiles/rptexture.dir/data/GLenumStrings.cpp.o"
+  "CMakeFiles/rptexture.dir/data/GLenumStrings.cpp.o.d"
+  "CMakeFiles/rptexture.dir/data/KhronosFormatTables.cpp.o"
+  "CMakeFiles/rptexture.dir/data/KhronosFormatTables.cpp.o.d"
+  "CMakeFiles/rptexture.dir/data/VkEnumStrings.cpp.o"
+  "CMakeFiles/rptexture.dir/data/VkEnumStrings.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/DecodeContext.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/DecodeContext.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_BC7.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_BC7.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_DC.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_DC.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_ETC1.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_ETC1.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_GCN.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_GCN.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear_avx2.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear_avx2.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear_sse2.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear_sse2.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear_ssse3.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_Linear_ssse3.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_N3DS.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_N3DS.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_NDS.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_NDS.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_PVRTC.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_PVRTC.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_S3TC.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_S3TC.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_ifunc.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/ImageDecoder_ifunc.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/ParallelDecode.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/ParallelDecode.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/PixelConversion.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/PixelConversion.cpp.o.d"
+  "CMakeFiles/rptexture.dir/decoder/UntileCache.cpp.o"
+  "CMakeFiles/rptexture.dir/decoder/UntileCache.cpp.o.d"
+  "CMakeFiles/rptexture.dir/fileformat/DidjTex.cpp.o"
+  "CMakeFiles/rptexture.dir/fileformat/DidjTex.cpp.o.d"
+  "CMakeFiles/rptexture.dir/fileformat/DirectDrawSurface.cpp.o"
+  "CMakeFiles/rptexture.dir/fileformat/DirectDrawSurface.cpp.o.d"
+  "CMakeFiles/rptexture.dir/fileformat/FileFormat.cpp.o"
+  "CMakeFiles/rptexture.dir/fileformat/FileFormat.cpp.o.d"
+  "CMakeFiles/rptexture.dir/fileformat/KhronosKTX.cpp.o"
+  "CMakeFiles/rptexture.dir/fileformat/KhronosKTX.cpp.o.d"
+  "CMakeFiles/rptexture.dir/fileformat/KhronosKTX2.cpp.o"
+  "CMakeFiles/rptexture.dir/fileformat/KhronosKTX2.cpp.o.d"
+  "CMakeFiles/rptexture.dir/fileformat/PowerVR3.cpp.o"
+  "CMakeFiles/rptexture.dir/fileformat/PowerVR3.cpp.o.d"
+  "CMakeFiles/rptexture.dir/fileformat/SegaPVR.cpp.o"
+  "CMakeFiles/rptexture.dir/fileformat/SegaPVR.cpp.o.d"
+  "CMakeFiles/rptexture.dir/fileformat/ValveVTF.cpp.o"
+  "CMakeFiles/rptexture.dir/fileformat/ValveVTF.cpp.o.d"
+  "CMakeFiles/rptexture.dir/fileformat/ValveVTF3.cpp.o"
+  "CMakeFiles/rptexture.dir/fileformat/ValveVTF3.cpp.o.d"
+  "CMakeFiles/rptexture.dir/fileformat/XboxXPR.cpp.o"
+  "CMakeFiles/rptexture.dir/fileformat/XboxXPR.cpp.o.d"
+  "CMakeFiles/rptexture.dir/img/ImageConv.cpp.o"
+  "CMakeFiles/rptexture.dir/img/ImageConv.cpp.o.d"
+  "CMakeFiles/rptexture.dir/img/ImageConv_avx2.cpp.o"
+  "CMakeFiles/rptexture.dir/img/ImageConv_avx2.cpp.o.d"
+  "CMakeFiles/rptexture.dir/img/ImageConv_ssse3.cpp.o"
+  "CMakeFiles/rptexture.dir/img/ImageConv_ssse3.cpp.o.d"
+  "CMakeFiles/rptexture.dir/img/rp_image.cpp.o"
+  "CMakeFiles/rptexture.dir/img/rp_image.cpp.o.d"
+  "CMakeFiles/rptexture.dir/img/rp_image_backend.cpp.o"
+  "CMakeFiles/rptexture.dir/img/rp_image_backend.cpp.o.d"
+  "CMakeFiles/rptexture.dir/img/rp_image_ops.cpp.o"
+  "CMakeFiles/rptexture.dir/img/rp_image_ops.cpp.o.d"
+  "CMakeFiles/rptexture.dir/img/rp_image_ops_sse2.cpp.o"
+  "CMakeFiles/rptexture.dir/img/rp_image_ops_sse2.cpp.o.d"
+  "CMakeFiles/rptexture.dir/img/rp_image_ops_sse41.cpp.o"
+  "CMakeFiles/rptexture.dir/img/rp_image_ops_sse41.cpp.o.d"
+  "CMakeFiles/rptexture.dir/img/un-premultiply.cpp.o"
+  "CMakeFiles/rptexture.dir/img/un-premultiply.cpp.o.d"
+  "CMakeFiles/rptexture.dir/img/un-premultiply_avx2.cpp.o"
+  "CMakeFiles/rptexture.dir/img/un-premultiply_avx2.cpp.o.d"
+  "CMakeFiles/rptexture.dir/img/un-premultiply_sse41.cpp.o"
+  "CMakeFiles/rptexture.dir/img/un-premultiply_sse41.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rptexture.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../../../bin/ImageDecoderLinearTest"
+  "../../../bin/ImageDecoderLinearTest.pdb"
+  "../../../bin/ImageDecoderLinearTest.debug"
+  "../../../bin/UnPremultiplyTest.debug"
+  "CMakeFiles/ImageDecoderLinearTest.dir/ImageDecoderLinearTest.cpp.o"
+  "CMakeFiles/ImageDecoderLinearTest.dir/ImageDecoderLinearTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ImageDecoderLinearTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../../../bin/UnPremultiplyTest"
+  "../../../bin/UnPremultiplyTest.pdb"
+  "../../../bin/ImageDecoderLinearTest.debug"
+  "../../../bin/UnPremultiplyTest.debug"
+  "CMakeFiles/UnPremultiplyTest.dir/UnPremultiplyTest.cpp.o"
+  "CMakeFiles/UnPremultiplyTest.dir/UnPremultiplyTest.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/UnPremultiplyTest.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,10 @@
+# CMake generated Testfile for 
+# Source directory: /root/repo/src/librptexture/tests
+# Build directory: /root/repo/_gate_build/src/librptexture/tests
+# 
+# This file includes the relevant testing commands required for 
+# testing this directory and lists subdirectories to be tested as well.
+add_test(ImageDecoderLinearTest "/root/repo/_gate_build/bin/ImageDecoderLinearTest" "--gtest_filter=-*benchmark*")
+set_tests_properties(ImageDecoderLinearTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/librptexture/tests/CMakeLists.txt;22;ADD_TEST;/root/repo/src/librptexture/tests/CMakeLists.txt;0;")
+add_test(UnPremultiplyTest "/root/repo/_gate_build/bin/UnPremultiplyTest" "--gtest_filter=-*benchmark*")
+set_tests_properties(UnPremultiplyTest PROPERTIES  _BACKTRACE_TRIPLES "/root/repo/src/librptexture/tests/CMakeLists.txt;31;ADD_TEST;/root/repo/src/librptexture/tests/CMakeLists.txt;0;")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../../lib/librpthreads.a"
+  "../../lib/librpthreads.pdb"
+  "CMakeFiles/rpthreads.dir/ThreadPool.cpp.o"
+  "CMakeFiles/rpthreads.dir/ThreadPool.cpp.o.d"
+  "CMakeFiles/rpthreads.dir/dummy.cpp.o"
+  "CMakeFiles/rpthreads.dir/dummy.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/rpthreads.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "../../lib/libunixcommon.a"
+  "../../lib/libunixcommon.pdb"
+  "CMakeFiles/unixcommon.dir/dll-search.c.o"
+  "CMakeFiles/unixcommon.dir/dll-search.c.o.d"
+  "CMakeFiles/unixcommon.dir/userdirs.cpp.o"
+  "CMakeFiles/unixcommon.dir/userdirs.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/unixcommon.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,42 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (rp-stub)                          *
+ * config.libunixcommon.h.in: libunixcommon configuration. (source file)   *
+ *                                                                         *
+ * Copyright (c) 2017 by David Korth.                                      *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBUNIXCOMMON_CONFIG_H__
+#define __ROMPROPERTIES_LIBUNIXCOMMON_CONFIG_H__
+
+/* KDE4 plugin path. */
+/* #undef KDE4_PLUGIN_INSTALL_DIR */
+
+/* KF5 plugin path. */
+/* #undef KF5_PLUGIN_INSTALL_DIR */
+
+/* ThunarX2 extensions path. */
+/* #undef ThunarX2_EXTENSIONS_DIR */
+
+/* ThunarX3 extensions path. */
+/* #undef ThunarX3_EXTENSIONS_DIR */
+
+/* libnautilus-extension extensions path. */
+/* #undef LibNautilusExtension_EXTENSION_DIR */
+
+/* libcaja-extension extensions path. */
+/* #undef LibCajaExtension_EXTENSION_DIR */
+
+/* libnemo-extension extensions path. */
+/* #undef LibNemoExtension_EXTENSION_DIR */
+
+/* Define to 1 if you have the `getpwuid_r' function. */
+#define HAVE_GETPWUID_R 1
+
+/* Define to 1 if you have the `getpwuid' function. */
+/* #undef HAVE_GETPWUID */
+
+/* Define to 1 if you have the `statx` function. */
+#define HAVE_STATX 1
+
+#endif /* __ROMPROPERTIES_LIBUNIXCOMMON_CONFIG_H__ */
@@ -0,0 +1,20 @@
+file(REMOVE_RECURSE
+  "../../bin/rp-download"
+  "../../bin/rp-download.pdb"
+  "../../bin/rp-download.debug"
+  "CMakeFiles/rp-download.dir/CurlDownloader.cpp.o"
+  "CMakeFiles/rp-download.dir/CurlDownloader.cpp.o.d"
+  "CMakeFiles/rp-download.dir/IDownloader.cpp.o"
+  "CMakeFiles/rp-download.dir/IDownloader.cpp.o.d"
+  "CMakeFiles/rp-download.dir/SetFileOriginInfo_posix.cpp.o"
+  "CMakeFiles/rp-download.dir/SetFileOriginInfo_posix.cpp.o.d"
+  "CMakeFiles/rp-download.dir/http-status.c.o"
+  "CMakeFiles/rp-download.dir/http-status.c.o.d"
+  "CMakeFiles/rp-download.dir/rp-download.cpp.o"
+  "CMakeFiles/rp-download.dir/rp-download.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/rp-download.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/rp-stub/rp-stub.c" "src/rp-stub/CMakeFiles/rp-stub.dir/rp-stub.c.o" "gcc" "src/rp-stub/CMakeFiles/rp-stub.dir/rp-stub.c.o.d"
+  "/root/repo/src/rp-stub/rp-stub_secure.c" "src/rp-stub/CMakeFiles/rp-stub.dir/rp-stub_secure.c.o" "gcc" "src/rp-stub/CMakeFiles/rp-stub.dir/rp-stub_secure.c.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/src/libunixcommon/CMakeFiles/unixcommon.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpsecure/CMakeFiles/rpsecure.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
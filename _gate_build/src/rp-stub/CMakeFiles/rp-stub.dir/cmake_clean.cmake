@@ -0,0 +1,14 @@
+file(REMOVE_RECURSE
+  "../../bin/rp-stub"
+  "../../bin/rp-stub.pdb"
+  "../../bin/rp-stub.debug"
+  "CMakeFiles/rp-stub.dir/rp-stub.c.o"
+  "CMakeFiles/rp-stub.dir/rp-stub.c.o.d"
+  "CMakeFiles/rp-stub.dir/rp-stub_secure.c.o"
+  "CMakeFiles/rp-stub.dir/rp-stub_secure.c.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C)
+  include(CMakeFiles/rp-stub.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,38 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/src/rpcli/rpcli_secure.c" "src/rpcli/CMakeFiles/rpcli.dir/rpcli_secure.c.o" "gcc" "src/rpcli/CMakeFiles/rpcli.dir/rpcli_secure.c.o.d"
+  "/root/repo/src/rpcli/device.cpp" "src/rpcli/CMakeFiles/rpcli.dir/device.cpp.o" "gcc" "src/rpcli/CMakeFiles/rpcli.dir/device.cpp.o.d"
+  "/root/repo/src/rpcli/hash.cpp" "src/rpcli/CMakeFiles/rpcli.dir/hash.cpp.o" "gcc" "src/rpcli/CMakeFiles/rpcli.dir/hash.cpp.o.d"
+  "/root/repo/src/rpcli/properties.cpp" "src/rpcli/CMakeFiles/rpcli.dir/properties.cpp.o" "gcc" "src/rpcli/CMakeFiles/rpcli.dir/properties.cpp.o.d"
+  "/root/repo/src/rpcli/rpcli.cpp" "src/rpcli/CMakeFiles/rpcli.dir/rpcli.cpp.o" "gcc" "src/rpcli/CMakeFiles/rpcli.dir/rpcli.cpp.o.d"
+  "/root/repo/src/rpcli/verifykeys.cpp" "src/rpcli/CMakeFiles/rpcli.dir/verifykeys.cpp.o" "gcc" "src/rpcli/CMakeFiles/rpcli.dir/verifykeys.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_gate_build/src/librpsecure/CMakeFiles/rpsecure.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libromdata/CMakeFiles/romdata.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpfile/CMakeFiles/rpfile.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpbase/CMakeFiles/rpbase.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librptexture/CMakeFiles/rptexture.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/inih/CMakeFiles/inih.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/PowerVR/CMakeFiles/pvrtc.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libcachecommon/CMakeFiles/cachecommon.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpcpu/CMakeFiles/rpcpu.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/librpthreads/CMakeFiles/rpthreads.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/src/libunixcommon/CMakeFiles/unixcommon.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/tinyxml2/CMakeFiles/tinyxml2.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/unice68/CMakeFiles/unice68_lib.dir/DependInfo.cmake"
+  "/root/repo/_gate_build/extlib/libmspack-xenia/CMakeFiles/mspack.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
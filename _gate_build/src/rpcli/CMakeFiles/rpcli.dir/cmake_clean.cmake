@@ -0,0 +1,22 @@
+file(REMOVE_RECURSE
+  "../../bin/rpcli"
+  "../../bin/rpcli.pdb"
+  "../../bin/rpcli.debug"
+  "CMakeFiles/rpcli.dir/device.cpp.o"
+  "CMakeFiles/rpcli.dir/device.cpp.o.d"
+  "CMakeFiles/rpcli.dir/hash.cpp.o"
+  "CMakeFiles/rpcli.dir/hash.cpp.o.d"
+  "CMakeFiles/rpcli.dir/properties.cpp.o"
+  "CMakeFiles/rpcli.dir/properties.cpp.o.d"
+  "CMakeFiles/rpcli.dir/rpcli.cpp.o"
+  "CMakeFiles/rpcli.dir/rpcli.cpp.o.d"
+  "CMakeFiles/rpcli.dir/rpcli_secure.c.o"
+  "CMakeFiles/rpcli.dir/rpcli_secure.c.o.d"
+  "CMakeFiles/rpcli.dir/verifykeys.cpp.o"
+  "CMakeFiles/rpcli.dir/verifykeys.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/rpcli.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
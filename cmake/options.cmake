@@ -84,6 +84,17 @@ OPTION(ENABLE_LIBMSPACK "Enable libmspack-xenia for Xbox 360 executables." ON)
 # Enable the PowerVR Native SDK subset for PVRTC decompression.
 OPTION(ENABLE_PVRTC "Enable the PowerVR Native SDK subset for PVRTC decompression." ON)
 
+# Enable lightweight runtime statistics counters.
+# Compiled to no-ops when disabled.
+OPTION(ENABLE_RP_STATS "Enable lightweight runtime statistics counters." ON)
+
+# Enable the in-process downloader.
+# Skips the sandboxed rp-download subprocess, which eliminates the
+# process spawn overhead on every cache miss, but runs the network
+# code in the calling process. Still disabled at runtime unless
+# InProcessDownloads is enabled in rom-properties.conf.
+OPTION(ENABLE_INPROC_DOWNLOAD "Enable in-process downloads using libcurl. (no subprocess sandboxing)" OFF)
+
 # Enable precompiled headers.
 # FIXME: Not working properly on older gcc. Use cmake-3.16.0's built-in PCH?
 IF(MSVC)
@@ -537,6 +537,17 @@ static uint32_t pvrtcDecompress(uint8_t* pCompressedData, Pixel32* pDecompressed
 	PVRTCWordIndices indices;
 	std::vector<Pixel32> pPixels(wordWidth * wordHeight * sizeof(Pixel32));
 
+	// Precompute the twiddled offset of every word once, instead of
+	// recomputing the Morton order four times per 2x2 word neighborhood.
+	// (Each word participates in four neighborhoods.)
+	// Offsets are pre-multiplied by two as there are two members per word.
+	std::vector<uint32_t> twiddleMap(static_cast<size_t>(i32NumXWords) * static_cast<size_t>(i32NumYWords));
+	for (int32_t y = 0; y < i32NumYWords; y++)
+	{
+		for (int32_t x = 0; x < i32NumXWords; x++)
+		{ twiddleMap[(y * i32NumXWords) + x] = TwiddleUV<PVRTCII>(i32NumXWords, i32NumYWords, x, y) * 2; }
+	}
+
 	// For each row of words
 	for (int32_t wordY = -1; wordY < i32NumYWords - 1; wordY++)
 	{
@@ -552,12 +563,12 @@ static uint32_t pvrtcDecompress(uint8_t* pCompressedData, Pixel32* pDecompressed
 			indices.S[0] = static_cast<int>(wrapWordIndex(i32NumXWords, wordX + 1));
 			indices.S[1] = static_cast<int>(wrapWordIndex(i32NumYWords, wordY + 1));
 
-			// Work out the offsets into the twiddle structs, multiply by two as there are two members per word.
+			// Look up the offsets into the twiddle structs.
 			uint32_t WordOffsets[4] = {
-				TwiddleUV<PVRTCII>(i32NumXWords, i32NumYWords, indices.P[0], indices.P[1]) * 2,
-				TwiddleUV<PVRTCII>(i32NumXWords, i32NumYWords, indices.Q[0], indices.Q[1]) * 2,
-				TwiddleUV<PVRTCII>(i32NumXWords, i32NumYWords, indices.R[0], indices.R[1]) * 2,
-				TwiddleUV<PVRTCII>(i32NumXWords, i32NumYWords, indices.S[0], indices.S[1]) * 2,
+				twiddleMap[(indices.P[1] * i32NumXWords) + indices.P[0]],
+				twiddleMap[(indices.Q[1] * i32NumXWords) + indices.Q[0]],
+				twiddleMap[(indices.R[1] * i32NumXWords) + indices.R[0]],
+				twiddleMap[(indices.S[1] * i32NumXWords) + indices.S[0]],
 			};
 
 			// Access individual elements to fill out PVRTCWord
@@ -10,17 +10,30 @@
 #include "CairoImageConv.hpp"
 
 // C++ STL classes.
-using std::array;
 using std::unique_ptr;
 
 // librptexture
+#include "librptexture/img/ImageConv.hpp"
 using LibRpTexture::rp_image;
+namespace ImageConv = LibRpTexture::ImageConv;
+
+// cairo_surface_t user data key for the borrowed rp_image.
+static const cairo_user_data_key_t rp_image_user_data_key = {0};
+
+/**
+ * cairo_destroy_func_t callback for a borrowed rp_image.
+ * @param data rp_image.
+ */
+static void rp_cairoSurfaceDestroyNotify(void *data)
+{
+	delete static_cast<rp_image*>(data);
+}
 
 /**
  * Convert an rp_image to cairo_surface_t.
  * @param img		[in] rp_image.
  * @param premultiply	[in] If true, premultiply. Needed for display; NOT needed for PNG.
- * @return GdkPixbuf, or nullptr on error.
+ * @return cairo_surface_t, or nullptr on error.
  */
 cairo_surface_t *CairoImageConv::rp_image_to_cairo_surface_t(const rp_image *img, bool premultiply)
 {
@@ -28,119 +41,78 @@ cairo_surface_t *CairoImageConv::rp_image_to_cairo_surface_t(const rp_image *img
 	if (unlikely(!img || !img->isValid()))
 		return nullptr;
 
-	// NOTE: cairo_image_surface_create_for_data() doesn't do a
-	// deep copy, so we can't use it.
-	// NOTE 2: cairo_image_surface_create() always returns a valid
+	// NOTE: cairo_image_surface_create() always returns a valid
 	// pointer, but the status may be CAIRO_STATUS_NULL_POINTER if
 	// it failed to create a surface. We'll still check for nullptr.
 	const int width = img->width();
 	const int height = img->height();
-	cairo_surface_t *surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
-	assert(surface != nullptr);
-	assert(cairo_surface_status(surface) == CAIRO_STATUS_SUCCESS);
-	if (unlikely(!surface || cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS)) {
-		return nullptr;
-	}
-
-	uint32_t *px_dest = reinterpret_cast<uint32_t*>(cairo_image_surface_get_data(surface));
-	assert(px_dest != nullptr);
+	cairo_surface_t *surface = nullptr;
 
 	switch (img->format()) {
 		case rp_image::FORMAT_ARGB32: {
-			const rp_image *img_prex;
+			// Wrap the rp_image buffer directly instead of copying
+			// it into a new surface. A dup() is taken to keep the
+			// pixel data alive for the lifetime of the surface;
+			// since backends are copy-on-write, the dup() itself
+			// doesn't copy any pixels.
+			rp_image *const img_wrap = img->dup();
+			assert(img_wrap != nullptr);
+			if (unlikely(!img_wrap)) {
+				return nullptr;
+			}
 			if (premultiply) {
 				// Premultiply the image first.
-				// TODO: Combined dup()/premultiply() function?
-				img_prex = img->dup();
-				const_cast<rp_image*>(img_prex)->premultiply();
-			} else {
-				// No premultiplication.
-				img_prex = img;
+				// NOTE: This detaches img_wrap from the shared
+				// backend, so the caller's image isn't modified.
+				img_wrap->premultiply();
 			}
 
-			// Copy the image data.
-			int dest_stride = cairo_image_surface_get_stride(surface);
-			int src_stride = img_prex->stride();
-
-			if (dest_stride == src_stride) {
-				// Stride is identical. Copy the whole image all at once.
-				// NOTE: Partial copy for the last line.
-				size_t sz = dest_stride * (height - 1);
-				sz += width * sizeof(uint32_t);
-				memcpy(px_dest, img_prex->bits(), sz);
-			} else {
-				// Stride is not identical. Copy each scanline.
-				const uint32_t *img_buf = static_cast<const uint32_t*>(img_prex->bits());
-				const int row_bytes = img->row_bytes();
-				// We're adding strides to pointers, so the strides
-				// must be in uint32_t units here.
-				dest_stride /= sizeof(uint32_t);
-				src_stride /= sizeof(uint32_t);
-				for (unsigned int y = (unsigned int)height; y > 0; y--) {
-					memcpy(px_dest, img_buf, row_bytes);
-					px_dest += dest_stride;
-					img_buf += src_stride;
+			// NOTE: The non-const bits() would detach; use the
+			// const accessor, since the surface is only used
+			// as a source.
+			// NOTE 2: rp_image rows are 16-byte aligned, which
+			// satisfies Cairo's stride requirements for ARGB32.
+			const void *bits = const_cast<const rp_image*>(img_wrap)->bits();
+			surface = cairo_image_surface_create_for_data(
+				static_cast<unsigned char*>(const_cast<void*>(bits)),
+				CAIRO_FORMAT_ARGB32, width, height, img_wrap->stride());
+			assert(surface != nullptr);
+			assert(cairo_surface_status(surface) == CAIRO_STATUS_SUCCESS);
+			if (unlikely(!surface || cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS)) {
+				if (surface) {
+					cairo_surface_destroy(surface);
 				}
+				delete img_wrap;
+				return nullptr;
 			}
 
-			// Mark the surface as dirty.
-			cairo_surface_mark_dirty(surface);
-			if (premultiply) {
-				delete img_prex;
-			}
+			// The rp_image is deleted when the surface is destroyed.
+			cairo_surface_set_user_data(surface, &rp_image_user_data_key,
+				img_wrap, rp_cairoSurfaceDestroyNotify);
 			break;
 		}
 
 		case rp_image::FORMAT_CI8: {
-			const uint32_t *const palette = img->palette();
-			const int palette_len = img->palette_len();
-			assert(palette != nullptr);
-			assert(palette_len > 0);
-			assert(palette_len <= 256);
-			if (!palette || palette_len <= 0 || palette_len > 256)
-				break;
-
-			// Premultiply the palette.
-			std::array<uint32_t, 256> pal_prex;
-			const uint32_t *pal_toUse;
-			if (premultiply) {
-				for (int i = 0; i < palette_len; i++) {
-					pal_prex[i] = rp_image::premultiply_pixel(palette[i]);
-				}
-				if (palette_len < (int)pal_prex.size()) {
-					// Clear the rest of the palette.
-					memset(&pal_prex[palette_len], 0, (pal_prex.size() - palette_len) * sizeof(uint32_t));
-				}
-				pal_toUse = pal_prex.data();
-			} else {
-				pal_toUse = palette;
+			surface = cairo_image_surface_create(CAIRO_FORMAT_ARGB32, width, height);
+			assert(surface != nullptr);
+			assert(cairo_surface_status(surface) == CAIRO_STATUS_SUCCESS);
+			if (unlikely(!surface || cairo_surface_status(surface) != CAIRO_STATUS_SUCCESS)) {
+				return nullptr;
 			}
 
-			// Copy the image data.
-			const uint8_t *img_buf = static_cast<const uint8_t*>(img->bits());
-			const int dest_stride_adj = (cairo_image_surface_get_stride(surface) / sizeof(uint32_t)) - width;
-			const int src_stride_adj = img->stride() - width;
-
-			for (unsigned int y = (unsigned int)height; y > 0; y--) {
-				unsigned int x;
-				for (x = (unsigned int)width; x > 3; x -= 4) {
-					px_dest[0] = pal_toUse[img_buf[0]];
-					px_dest[1] = pal_toUse[img_buf[1]];
-					px_dest[2] = pal_toUse[img_buf[2]];
-					px_dest[3] = pal_toUse[img_buf[3]];
-					px_dest += 4;
-					img_buf += 4;
-				}
-				for (; x > 0; x--, px_dest++, img_buf++) {
-					// Last pixels.
-					*px_dest = pal_toUse[*img_buf];
-					px_dest++;
-					img_buf++;
-				}
-
-				// Next line.
-				img_buf += src_stride_adj;
-				px_dest += dest_stride_adj;
+			uint32_t *px_dest = reinterpret_cast<uint32_t*>(cairo_image_surface_get_data(surface));
+			assert(px_dest != nullptr);
+
+			// Expand CI8 through the shared conversion registry.
+			// Cairo uses native ARGB32.
+			const int ret = ImageConv::convert(px_dest,
+				cairo_image_surface_get_stride(surface),
+				ImageConv::LAYOUT_ARGB32, img,
+				(premultiply ? ImageConv::CONV_PREMULTIPLY : ImageConv::CONV_NONE));
+			if (unlikely(ret != 0)) {
+				// Conversion failed.
+				cairo_surface_destroy(surface);
+				return nullptr;
 			}
 
 			// Mark the surface as dirty.
@@ -151,8 +123,6 @@ cairo_surface_t *CairoImageConv::rp_image_to_cairo_surface_t(const rp_image *img
 		default:
 			// Unsupported image format.
 			assert(!"Unsupported rp_image::Format.");
-			cairo_surface_destroy(surface);
-			surface = nullptr;
 			break;
 	}
 
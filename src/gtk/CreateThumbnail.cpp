@@ -21,6 +21,11 @@ using LibRomData::RomDataFactory;
 #include "libromdata/img/TCreateThumbnail.cpp"
 using LibRomData::TCreateThumbnail;
 
+// C includes.
+#include <unistd.h>
+// C includes. (C++ namespace)
+#include <cerrno>
+
 // C++ STL classes.
 using std::string;
 using std::unique_ptr;
@@ -288,14 +293,21 @@ static int openFromFilenameOrURI(const char *source_file, IRpFile **pp_file, str
 }
 
 /**
- * Thumbnail creator function for wrapper programs.
+ * Thumbnail creator function for wrapper programs. (MIME-routed)
+ *
+ * Same as rp_create_thumbnail(), but with the MIME type of the
+ * source file, as supplied by the thumbnailing framework (e.g.
+ * Tumbler). The MIME type selects the candidate parsers via a
+ * hash lookup, skipping extension guessing entirely.
+ *
  * @param source_file Source file or URI. (UTF-8)
  * @param output_file Output file. (UTF-8)
  * @param maximum_size Maximum size.
+ * @param mime_type MIME type of the source file, or NULL if unknown.
  * @return 0 on success; non-zero on error.
  */
 extern "C"
-G_MODULE_EXPORT int rp_create_thumbnail(const char *source_file, const char *output_file, int maximum_size)
+G_MODULE_EXPORT int rp_create_thumbnail2(const char *source_file, const char *output_file, int maximum_size, const char *mime_type)
 {
 	// Some of this is based on the GNOME Thumbnailer skeleton project.
 	// https://github.com/hadess/gnome-thumbnailer-skeleton/blob/master/gnome-thumbnailer-skeleton.c
@@ -327,7 +339,8 @@ G_MODULE_EXPORT int rp_create_thumbnail(const char *source_file, const char *out
 
 	// Get the appropriate RomData class for this ROM.
 	// RomData class *must* support at least one image type.
-	RomData *const romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_THUMBNAIL);
+	RomData *const romData = RomDataFactory::create(file, mime_type,
+		RomDataFactory::RDA_HAS_THUMBNAIL | RomDataFactory::RDA_DEFER_FIELDS);
 	file->unref();	// file is ref()'d by RomData.
 	if (!romData) {
 		// ROM is not supported.
@@ -499,3 +512,145 @@ cleanup:
 	romData->unref();
 	return ret;
 }
+
+/**
+ * Thumbnail creator function for wrapper programs.
+ * @param source_file Source file or URI. (UTF-8)
+ * @param output_file Output file. (UTF-8)
+ * @param maximum_size Maximum size.
+ * @return 0 on success; non-zero on error.
+ */
+extern "C"
+G_MODULE_EXPORT int rp_create_thumbnail(const char *source_file, const char *output_file, int maximum_size)
+{
+	// No MIME type; RomDataFactory runs a full probe.
+	return rp_create_thumbnail2(source_file, output_file, maximum_size, nullptr);
+}
+
+/**
+ * Write a buffer to a file descriptor, retrying on short writes.
+ * @param fd File descriptor.
+ * @param buf Buffer.
+ * @param len Length of buffer.
+ * @return 0 on success; non-zero on error.
+ */
+static int write_all(int fd, const uint8_t *buf, size_t len)
+{
+	while (len > 0) {
+		ssize_t sz_written = write(fd, buf, len);
+		if (sz_written < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			return -1;
+		}
+		buf += sz_written;
+		len -= sz_written;
+	}
+	return 0;
+}
+
+/**
+ * Raw thumbnail creator function for wrapper programs.
+ *
+ * Writes the raw pixel data to a file descriptor (e.g. a memfd)
+ * instead of encoding a PNG file. Used by the D-Bus thumbnailer's
+ * shared-memory result path.
+ *
+ * @param source_file	[in] Source file or URI. (UTF-8)
+ * @param fd		[in] Output file descriptor.
+ * @param maximum_size	[in] Maximum size.
+ * @param pWidth	[out] Image width.
+ * @param pHeight	[out] Image height.
+ * @param pRowstride	[out] Row stride, in bytes.
+ * @param pFormat	[out] Pixel format. (0 == native-endian ARGB32; 1 == ABGR32)
+ * @return 0 on success; non-zero on error.
+ */
+extern "C"
+G_MODULE_EXPORT int rp_create_thumbnail_raw(const char *source_file, int fd, int maximum_size,
+	int *pWidth, int *pHeight, int *pRowstride, int *pFormat)
+{
+	if (getuid() == 0 || geteuid() == 0) {
+		g_critical("*** " G_LOG_DOMAIN " does not support running as root.");
+		return RPCT_RUNNING_AS_ROOT;
+	}
+
+	assert(fd >= 0);
+	assert(pWidth != nullptr);
+	assert(pHeight != nullptr);
+	assert(pRowstride != nullptr);
+	assert(pFormat != nullptr);
+	if (fd < 0 || !pWidth || !pHeight || !pRowstride || !pFormat) {
+		return RPCT_OUTPUT_FILE_FAILED;
+	}
+
+	// Make sure glib is initialized.
+	// NOTE: This is a no-op as of glib-2.36.
+#if !GLIB_CHECK_VERSION(2,36,0)
+	g_type_init();
+#endif
+
+	// Attempt to open the ROM file.
+	IRpFile *file = nullptr;
+	string s_uri;
+	int ret = openFromFilenameOrURI(source_file, &file, s_uri);
+	if (ret != 0) {
+		// Error opening the file.
+		return ret;
+	}
+	assert(file != nullptr);
+
+	// Get the appropriate RomData class for this ROM.
+	// RomData class *must* support at least one image type.
+	RomData *const romData = RomDataFactory::create(file,
+		RomDataFactory::RDA_HAS_THUMBNAIL | RomDataFactory::RDA_DEFER_FIELDS);
+	file->unref();	// file is ref()'d by RomData.
+	if (!romData) {
+		// ROM is not supported.
+		return RPCT_SOURCE_FILE_NOT_SUPPORTED;
+	}
+
+	// Create the thumbnail.
+	unique_ptr<CreateThumbnailPrivate> d(new CreateThumbnailPrivate());
+	CreateThumbnailPrivate::GetThumbnailOutParams_t outParams;
+	ret = d->getThumbnail(romData, maximum_size, &outParams);
+	romData->unref();
+	if (ret != 0 || !d->isImgClassValid(outParams.retImg)) {
+		// No image.
+		if (outParams.retImg) {
+			d->freeImgClass(outParams.retImg);
+		}
+		return RPCT_SOURCE_FILE_NO_IMAGE;
+	}
+
+	// Write the raw pixel data to the file descriptor.
+	const guchar *pixels;
+	int rowstride;
+#ifdef RP_GTK_USE_CAIRO
+	cairo_surface_flush(outParams.retImg);
+	pixels = cairo_image_surface_get_data(outParams.retImg);
+	rowstride = cairo_image_surface_get_stride(outParams.retImg);
+#else /* !RP_GTK_USE_CAIRO */
+	pixels = gdk_pixbuf_get_pixels(outParams.retImg);
+	rowstride = gdk_pixbuf_get_rowstride(outParams.retImg);
+#endif
+	if (write_all(fd, pixels, (size_t)rowstride * (size_t)outParams.thumbSize.height) != 0) {
+		// Error writing the pixel data.
+		d->freeImgClass(outParams.retImg);
+		return RPCT_OUTPUT_FILE_FAILED;
+	}
+
+	*pWidth = outParams.thumbSize.width;
+	*pHeight = outParams.thumbSize.height;
+	*pRowstride = rowstride;
+#ifdef RP_GTK_USE_CAIRO
+	// Cairo uses native-endian ARGB32.
+	*pFormat = 0;
+#else /* !RP_GTK_USE_CAIRO */
+	// GdkPixbuf uses ABGR32.
+	*pFormat = 1;
+#endif
+
+	d->freeImgClass(outParams.retImg);
+	return 0;
+}
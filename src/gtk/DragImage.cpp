@@ -51,8 +51,8 @@ struct _DragImage {
 		int height;
 	} minimumImageSize;
 
-	// rp_image. (NOTE: Not owned by this object.)
-	const rp_image *img;
+	// rp_image. (owned dup(); pixels shared COW)
+	rp_image *img;
 
 	// Animated icon data.
 	struct anim_vars {
@@ -61,13 +61,11 @@ struct _DragImage {
 		int last_delay;		// Last delay value.
 		std::array<PIMGTYPE, IconAnimData::MAX_FRAMES> iconFrames;
 		IconAnimHelper iconAnimHelper;
-		int last_frame_number;	// Last frame number.
 
 		anim_vars()
 			: iconAnimData(nullptr)
 			, tmrIconAnim(0)
 			, last_delay(0)
-			, last_frame_number(0)
 		{
 			iconFrames.fill(nullptr);
 		}
@@ -138,6 +136,10 @@ drag_image_dispose(GObject *object)
 	delete image->anim;
 	image->anim = nullptr;
 
+	// Delete our handle on the rp_image.
+	delete image->img;
+	image->img = nullptr;
+
 	// Call the superclass dispose() function.
 	G_OBJECT_CLASS(drag_image_parent_class)->dispose(object);
 }
@@ -197,13 +199,9 @@ drag_image_update_pixmaps(DragImage *image)
 		}
 
 		// Set up the IconAnimHelper.
+		// NOTE: The animation timer will be set up when
+		// the animation is started.
 		anim->iconAnimHelper.setIconAnimData(iconAnimData);
-		if (anim->iconAnimHelper.isAnimated()) {
-			// Initialize the animation.
-			anim->last_frame_number = anim->iconAnimHelper.frameNumber();
-
-			// Animation timer will be set up when animation is started.
-		}
 
 		// Show the first frame.
 		image->curFrame = PIMGTYPE_ref(anim->iconFrames[anim->iconAnimHelper.frameNumber()]);
@@ -261,9 +259,9 @@ drag_image_set_minimum_image_size(DragImage *image, int width, int height)
 /**
  * Set the rp_image for this image.
  *
- * NOTE: The rp_image pointer is stored and used if necessary.
- * Make sure to call this function with nullptr before deleting
- * the rp_image object.
+ * NOTE: The widget dup()s the image, which shares the pixel
+ * data copy-on-write, so the caller's rp_image (and the
+ * RomData object that owns it) can be deleted afterwards.
  *
  * NOTE 2: If animated icon data is specified, that supercedes
  * the individual rp_image.
@@ -277,6 +275,7 @@ drag_image_set_rp_image(DragImage *image, const LibRpTexture::rp_image *img)
 {
 	g_return_val_if_fail(IS_DRAG_IMAGE(image), false);
 
+	delete image->img;
 	if (!img) {
 		image->img = nullptr;
 		if (!image->anim || !image->anim->iconAnimData) {
@@ -287,10 +286,10 @@ drag_image_set_rp_image(DragImage *image, const LibRpTexture::rp_image *img)
 		return false;
 	}
 
-	// Don't check if the image pointer matches the
-	// previously stored image, since the underlying
-	// image may have changed.
-	image->img = img;
+	// Take our own handle on the image.
+	// NOTE: dup() is cheap; the pixel data is shared
+	// copy-on-write.
+	image->img = img->dup();
 	return drag_image_update_pixmaps(image);
 }
 
@@ -359,6 +358,7 @@ drag_image_clear(DragImage *image)
 		anim->iconAnimData = nullptr;
 	}
 
+	delete image->img;
 	image->img = nullptr;
 	gtk_image_clear(image->imageWidget);
 }
@@ -382,18 +382,17 @@ drag_image_anim_timer_func(DragImage *image)
 
 	// Next frame.
 	int delay = 0;
-	int frame = anim->iconAnimHelper.nextFrame(&delay);
-	if (delay <= 0 || frame < 0) {
-		// Invalid frame...
+	const int frame = anim->iconAnimHelper.tick(&delay);
+	if (delay <= 0) {
+		// Invalid delay value.
 		anim->tmrIconAnim = 0;
 		return false;
 	}
 
-	if (frame != anim->last_frame_number) {
+	if (frame >= 0) {
 		// New frame number.
 		// Update the icon.
 		gtk_image_set_from_PIMGTYPE(image->imageWidget, anim->iconFrames[frame]);
-		anim->last_frame_number = frame;
 	}
 
 	if (anim->last_delay != delay) {
@@ -424,7 +423,6 @@ drag_image_start_anim_timer(DragImage *image)
 	}
 
 	// Get the current frame information.
-	anim->last_frame_number = anim->iconAnimHelper.frameNumber();
 	const int delay = anim->iconAnimHelper.frameDelay();
 	assert(delay > 0);
 	if (delay <= 0) {
@@ -484,7 +482,7 @@ drag_image_reset_anim_frame(DragImage *image)
 
 	auto *const anim = image->anim;
 	if (anim) {
-		anim->last_frame_number = 0;
+		anim->iconAnimHelper.resetDisplayedFrame();
 	}
 }
 
@@ -52,9 +52,9 @@ void drag_image_set_minimum_image_size(DragImage *image, int width, int height);
 /**
  * Set the rp_image for this image.
  *
- * NOTE: The rp_image pointer is stored and used if necessary.
- * Make sure to call this function with nullptr before deleting
- * the rp_image object.
+ * NOTE: The widget dup()s the image, which shares the pixel
+ * data copy-on-write, so the caller's rp_image (and the
+ * RomData object that owns it) can be deleted afterwards.
  *
  * NOTE 2: If animated icon data is specified, that supercedes
  * the individual rp_image.
@@ -0,0 +1,448 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (GTK+ common)                      *
+ * ListDataModel.cpp: RFT_LISTDATA-backed GtkTreeModel.                    *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ListDataModel.hpp"
+#include "PIMGTYPE.hpp"
+
+// librpbase, librptexture
+using LibRpBase::RomFields;
+using LibRpTexture::rp_image;
+
+// C++ includes.
+using std::string;
+using std::vector;
+
+/* Column 0 is the checkbox/icon column if the field has one. */
+
+static void	rp_list_data_model_finalize		(GObject	*object);
+static void	rp_list_data_model_tree_model_init	(GtkTreeModelIface *iface);
+
+/** GtkTreeModelIface **/
+static GtkTreeModelFlags rp_list_data_model_get_flags	(GtkTreeModel	*tree_model);
+static gint	rp_list_data_model_get_n_columns	(GtkTreeModel	*tree_model);
+static GType	rp_list_data_model_get_column_type	(GtkTreeModel	*tree_model,
+							 gint		 index_);
+static gboolean	rp_list_data_model_get_iter		(GtkTreeModel	*tree_model,
+							 GtkTreeIter	*iter,
+							 GtkTreePath	*path);
+static GtkTreePath *rp_list_data_model_get_path		(GtkTreeModel	*tree_model,
+							 GtkTreeIter	*iter);
+static void	rp_list_data_model_get_value		(GtkTreeModel	*tree_model,
+							 GtkTreeIter	*iter,
+							 gint		 column,
+							 GValue		*value);
+static gboolean	rp_list_data_model_iter_next		(GtkTreeModel	*tree_model,
+							 GtkTreeIter	*iter);
+static gboolean	rp_list_data_model_iter_children	(GtkTreeModel	*tree_model,
+							 GtkTreeIter	*iter,
+							 GtkTreeIter	*parent);
+static gboolean	rp_list_data_model_iter_has_child	(GtkTreeModel	*tree_model,
+							 GtkTreeIter	*iter);
+static gint	rp_list_data_model_iter_n_children	(GtkTreeModel	*tree_model,
+							 GtkTreeIter	*iter);
+static gboolean	rp_list_data_model_iter_nth_child	(GtkTreeModel	*tree_model,
+							 GtkTreeIter	*iter,
+							 GtkTreeIter	*parent,
+							 gint		 n);
+static gboolean	rp_list_data_model_iter_parent		(GtkTreeModel	*tree_model,
+							 GtkTreeIter	*iter,
+							 GtkTreeIter	*child);
+
+struct _RpListDataModelClass {
+	GObjectClass __parent__;
+};
+
+struct _RpListDataModel {
+	GObject __parent__;
+
+	// Iterator stamp for validation.
+	gint		stamp;
+
+	// Source data. (owned by the RomFields container)
+	const RomFields::ListData_t *list_data;
+
+	// Column count, including the checkbox/icon column.
+	int		colCount;
+	// First string column. (1 if checkboxes or icons; 0 otherwise)
+	int		col_start;
+
+	// Checkboxes. (RFT_LISTDATA_CHECKBOXES)
+	bool		hasCheckboxes;
+	uint32_t	checkboxes;
+
+	// Icons. (RFT_LISTDATA_ICONS)
+	// Scaled on demand and cached per row.
+	const vector<const rp_image*> *icons;
+	vector<PIMGTYPE> *icon_cache;
+
+	// Visible row -> data row map.
+	// Only allocated if checkbox rows were skipped;
+	// otherwise, the mapping is the identity.
+	vector<uint32_t> *rowMap;
+
+	// Visible row count.
+	int		rowCount;
+};
+
+// NOTE: G_DEFINE_TYPE() doesn't work in C++ mode with gcc-6.2
+// due to an implicit int to GTypeFlags conversion.
+G_DEFINE_TYPE_EXTENDED(RpListDataModel, rp_list_data_model,
+	G_TYPE_OBJECT, static_cast<GTypeFlags>(0),
+	G_IMPLEMENT_INTERFACE(GTK_TYPE_TREE_MODEL,
+		rp_list_data_model_tree_model_init));
+
+static void
+rp_list_data_model_class_init(RpListDataModelClass *klass)
+{
+	GObjectClass *const gobject_class = G_OBJECT_CLASS(klass);
+	gobject_class->finalize = rp_list_data_model_finalize;
+}
+
+static void
+rp_list_data_model_tree_model_init(GtkTreeModelIface *iface)
+{
+	iface->get_flags	= rp_list_data_model_get_flags;
+	iface->get_n_columns	= rp_list_data_model_get_n_columns;
+	iface->get_column_type	= rp_list_data_model_get_column_type;
+	iface->get_iter		= rp_list_data_model_get_iter;
+	iface->get_path		= rp_list_data_model_get_path;
+	iface->get_value	= rp_list_data_model_get_value;
+	iface->iter_next	= rp_list_data_model_iter_next;
+	iface->iter_children	= rp_list_data_model_iter_children;
+	iface->iter_has_child	= rp_list_data_model_iter_has_child;
+	iface->iter_n_children	= rp_list_data_model_iter_n_children;
+	iface->iter_nth_child	= rp_list_data_model_iter_nth_child;
+	iface->iter_parent	= rp_list_data_model_iter_parent;
+}
+
+static void
+rp_list_data_model_init(RpListDataModel *model)
+{
+	model->stamp = g_random_int();
+	model->list_data = nullptr;
+	model->colCount = 0;
+	model->col_start = 0;
+	model->hasCheckboxes = false;
+	model->checkboxes = 0;
+	model->icons = nullptr;
+	model->icon_cache = nullptr;
+	model->rowMap = nullptr;
+	model->rowCount = 0;
+}
+
+static void
+rp_list_data_model_finalize(GObject *object)
+{
+	RpListDataModel *const model = RP_LIST_DATA_MODEL(object);
+
+	// Delete the cached icons.
+	if (model->icon_cache) {
+		for (auto iter = model->icon_cache->begin();
+		     iter != model->icon_cache->end(); ++iter)
+		{
+			if (*iter) {
+				PIMGTYPE_destroy(*iter);
+			}
+		}
+		delete model->icon_cache;
+	}
+	delete model->rowMap;
+
+	// Call the superclass finalize() function.
+	G_OBJECT_CLASS(rp_list_data_model_parent_class)->finalize(object);
+}
+
+/**
+ * Create a new RpListDataModel for an RFT_LISTDATA field.
+ * @param field RFT_LISTDATA field.
+ * @return RpListDataModel, or nullptr on error.
+ */
+RpListDataModel*
+rp_list_data_model_new(const RomFields::Field *field)
+{
+	assert(field != nullptr);
+	assert(field->type == RomFields::RFT_LISTDATA);
+	if (!field || field->type != RomFields::RFT_LISTDATA) {
+		return nullptr;
+	}
+
+	const auto &listDataDesc = field->desc.list_data;
+	assert(!(listDataDesc.flags & RomFields::RFT_LISTDATA_MULTI));
+	if (listDataDesc.flags & RomFields::RFT_LISTDATA_MULTI) {
+		// RFT_LISTDATA_MULTI uses a GtkListStore.
+		return nullptr;
+	}
+
+	const RomFields::ListData_t *const list_data = field->data.list_data.data.single;
+	assert(list_data != nullptr);
+	assert(!list_data->empty());
+	if (!list_data || list_data->empty()) {
+		return nullptr;
+	}
+
+	RpListDataModel *const model = static_cast<RpListDataModel*>(
+		g_object_new(TYPE_RP_LIST_DATA_MODEL, nullptr));
+	model->list_data = list_data;
+
+	int colCount;
+	if (listDataDesc.names) {
+		colCount = static_cast<int>(listDataDesc.names->size());
+	} else {
+		// No column headers. Use the first row.
+		colCount = static_cast<int>(list_data->at(0).size());
+	}
+
+	const bool hasCheckboxes = !!(listDataDesc.flags & RomFields::RFT_LISTDATA_CHECKBOXES);
+	const bool hasIcons = !!(listDataDesc.flags & RomFields::RFT_LISTDATA_ICONS);
+	if (hasCheckboxes) {
+		model->hasCheckboxes = true;
+		model->checkboxes = field->data.list_data.mxd.checkboxes;
+		model->col_start = 1;
+
+		// Rows with no strings are skipped, but still
+		// consume a checkbox bit. Build a row map if any
+		// rows were skipped.
+		uint32_t dataRow = 0;
+		for (auto iter = list_data->cbegin(); iter != list_data->cend(); ++iter, dataRow++) {
+			if (iter->empty()) {
+				// Skipped row. Build the full map.
+				model->rowMap = new vector<uint32_t>();
+				model->rowMap->reserve(list_data->size());
+				dataRow = 0;
+				for (iter = list_data->cbegin(); iter != list_data->cend(); ++iter, dataRow++) {
+					if (!iter->empty()) {
+						model->rowMap->push_back(dataRow);
+					}
+				}
+				break;
+			}
+		}
+	} else if (hasIcons) {
+		assert(field->data.list_data.mxd.icons != nullptr);
+		if (!field->data.list_data.mxd.icons) {
+			g_object_unref(model);
+			return nullptr;
+		}
+		model->icons = field->data.list_data.mxd.icons;
+		model->icon_cache = new vector<PIMGTYPE>(list_data->size(), nullptr);
+		model->col_start = 1;
+	}
+
+	model->colCount = colCount + model->col_start;
+	model->rowCount = static_cast<int>(model->rowMap
+		? model->rowMap->size()
+		: list_data->size());
+	return model;
+}
+
+/**
+ * Get the icon for a data row, scaled and cached.
+ * @param model RpListDataModel
+ * @param dataRow Data row number.
+ * @return PIMGTYPE, or nullptr if no icon. (owned by the model)
+ */
+static PIMGTYPE
+rp_list_data_model_get_icon(RpListDataModel *model, uint32_t dataRow)
+{
+	PIMGTYPE pixbuf = model->icon_cache->at(dataRow);
+	if (pixbuf) {
+		// Icon is already cached.
+		return pixbuf;
+	}
+
+	const rp_image *const icon = model->icons->at(dataRow);
+	assert(icon != nullptr);
+	if (!icon) {
+		return nullptr;
+	}
+
+	pixbuf = rp_image_to_PIMGTYPE(icon);
+	if (!pixbuf) {
+		return nullptr;
+	}
+
+	// TODO: Ideal icon size?
+	// Using 32x32 for now.
+	static const int icon_sz = 32;
+	// NOTE: GtkCellRendererPixbuf can't scale the pixbuf itself...
+	if (!PIMGTYPE_size_check(pixbuf, icon_sz, icon_sz)) {
+		// TODO: Use nearest-neighbor if upscaling.
+		// Also, preserve the aspect ratio.
+		PIMGTYPE scaled = PIMGTYPE_scale(pixbuf, icon_sz, icon_sz, true);
+		if (scaled) {
+			PIMGTYPE_destroy(pixbuf);
+			pixbuf = scaled;
+		}
+	}
+
+	(*model->icon_cache)[dataRow] = pixbuf;
+	return pixbuf;
+}
+
+/** GtkTreeModelIface **/
+
+static GtkTreeModelFlags
+rp_list_data_model_get_flags(G_GNUC_UNUSED GtkTreeModel *tree_model)
+{
+	return static_cast<GtkTreeModelFlags>(
+		GTK_TREE_MODEL_LIST_ONLY | GTK_TREE_MODEL_ITERS_PERSIST);
+}
+
+static gint
+rp_list_data_model_get_n_columns(GtkTreeModel *tree_model)
+{
+	RpListDataModel *const model = RP_LIST_DATA_MODEL(tree_model);
+	return model->colCount;
+}
+
+static GType
+rp_list_data_model_get_column_type(GtkTreeModel *tree_model, gint index_)
+{
+	RpListDataModel *const model = RP_LIST_DATA_MODEL(tree_model);
+	assert(index_ >= 0);
+	assert(index_ < model->colCount);
+	if (index_ < 0 || index_ >= model->colCount) {
+		return G_TYPE_INVALID;
+	}
+
+	if (index_ == 0 && model->col_start == 1) {
+		// Checkbox or icon column.
+		return (model->hasCheckboxes ? G_TYPE_BOOLEAN : PIMGTYPE_GOBJECT_TYPE);
+	}
+	return G_TYPE_STRING;
+}
+
+static gboolean
+rp_list_data_model_get_iter(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreePath *path)
+{
+	RpListDataModel *const model = RP_LIST_DATA_MODEL(tree_model);
+	assert(gtk_tree_path_get_depth(path) == 1);
+
+	const gint row = gtk_tree_path_get_indices(path)[0];
+	if (row < 0 || row >= model->rowCount) {
+		return false;
+	}
+
+	iter->stamp = model->stamp;
+	iter->user_data = GINT_TO_POINTER(row);
+	return true;
+}
+
+static GtkTreePath*
+rp_list_data_model_get_path(GtkTreeModel *tree_model, GtkTreeIter *iter)
+{
+	RpListDataModel *const model = RP_LIST_DATA_MODEL(tree_model);
+	g_return_val_if_fail(iter->stamp == model->stamp, nullptr);
+
+	return gtk_tree_path_new_from_indices(GPOINTER_TO_INT(iter->user_data), -1);
+}
+
+static void
+rp_list_data_model_get_value(GtkTreeModel *tree_model, GtkTreeIter *iter, gint column, GValue *value)
+{
+	RpListDataModel *const model = RP_LIST_DATA_MODEL(tree_model);
+	g_return_if_fail(iter->stamp == model->stamp);
+	g_return_if_fail(column >= 0 && column < model->colCount);
+
+	const gint row = GPOINTER_TO_INT(iter->user_data);
+	g_return_if_fail(row >= 0 && row < model->rowCount);
+
+	// Map the visible row to the data row.
+	const uint32_t dataRow = (model->rowMap
+		? model->rowMap->at(row)
+		: static_cast<uint32_t>(row));
+
+	if (column == 0 && model->col_start == 1) {
+		if (model->hasCheckboxes) {
+			// Checkbox column.
+			g_value_init(value, G_TYPE_BOOLEAN);
+			g_value_set_boolean(value, !!(model->checkboxes & (1U << dataRow)));
+		} else {
+			// Icon column.
+			g_value_init(value, PIMGTYPE_GOBJECT_TYPE);
+			PIMGTYPE pixbuf = rp_list_data_model_get_icon(model, dataRow);
+#ifdef RP_GTK_USE_CAIRO
+			g_value_set_boxed(value, pixbuf);
+#else /* !RP_GTK_USE_CAIRO */
+			g_value_set_object(value, pixbuf);
+#endif /* RP_GTK_USE_CAIRO */
+		}
+		return;
+	}
+
+	// String column.
+	g_value_init(value, G_TYPE_STRING);
+	const vector<string> &data_row = model->list_data->at(dataRow);
+	const size_t str_idx = static_cast<size_t>(column - model->col_start);
+	if (str_idx < data_row.size()) {
+		g_value_set_string(value, data_row[str_idx].c_str());
+	}
+}
+
+static gboolean
+rp_list_data_model_iter_next(GtkTreeModel *tree_model, GtkTreeIter *iter)
+{
+	RpListDataModel *const model = RP_LIST_DATA_MODEL(tree_model);
+	g_return_val_if_fail(iter->stamp == model->stamp, false);
+
+	const gint row = GPOINTER_TO_INT(iter->user_data) + 1;
+	if (row >= model->rowCount) {
+		return false;
+	}
+
+	iter->user_data = GINT_TO_POINTER(row);
+	return true;
+}
+
+static gboolean
+rp_list_data_model_iter_children(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreeIter *parent)
+{
+	RpListDataModel *const model = RP_LIST_DATA_MODEL(tree_model);
+	if (parent || model->rowCount <= 0) {
+		// Flat list; only the root node has children.
+		return false;
+	}
+
+	iter->stamp = model->stamp;
+	iter->user_data = GINT_TO_POINTER(0);
+	return true;
+}
+
+static gboolean
+rp_list_data_model_iter_has_child(G_GNUC_UNUSED GtkTreeModel *tree_model, G_GNUC_UNUSED GtkTreeIter *iter)
+{
+	return false;
+}
+
+static gint
+rp_list_data_model_iter_n_children(GtkTreeModel *tree_model, GtkTreeIter *iter)
+{
+	RpListDataModel *const model = RP_LIST_DATA_MODEL(tree_model);
+	// Only the root node has children.
+	return (iter ? 0 : model->rowCount);
+}
+
+static gboolean
+rp_list_data_model_iter_nth_child(GtkTreeModel *tree_model, GtkTreeIter *iter, GtkTreeIter *parent, gint n)
+{
+	RpListDataModel *const model = RP_LIST_DATA_MODEL(tree_model);
+	if (parent || n < 0 || n >= model->rowCount) {
+		return false;
+	}
+
+	iter->stamp = model->stamp;
+	iter->user_data = GINT_TO_POINTER(n);
+	return true;
+}
+
+static gboolean
+rp_list_data_model_iter_parent(G_GNUC_UNUSED GtkTreeModel *tree_model, G_GNUC_UNUSED GtkTreeIter *iter, G_GNUC_UNUSED GtkTreeIter *child)
+{
+	return false;
+}
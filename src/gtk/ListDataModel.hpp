@@ -0,0 +1,60 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (GTK+ common)                      *
+ * ListDataModel.hpp: RFT_LISTDATA-backed GtkTreeModel.                    *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_GTK_LISTDATAMODEL_HPP__
+#define __ROMPROPERTIES_GTK_LISTDATAMODEL_HPP__
+
+#ifdef __cplusplus
+// librpbase
+#include "librpbase/RomFields.hpp"
+#endif /* __cplusplus */
+
+// GTK+ includes.
+#include <gtk/gtk.h>
+
+G_BEGIN_DECLS
+
+typedef struct _RpListDataModelClass	RpListDataModelClass;
+typedef struct _RpListDataModel		RpListDataModel;
+
+#define TYPE_RP_LIST_DATA_MODEL            (rp_list_data_model_get_type())
+#define RP_LIST_DATA_MODEL(obj)            (G_TYPE_CHECK_INSTANCE_CAST((obj), TYPE_RP_LIST_DATA_MODEL, RpListDataModel))
+#define RP_LIST_DATA_MODEL_CLASS(klass)    (G_TYPE_CHECK_CLASS_CAST((klass),  TYPE_RP_LIST_DATA_MODEL, RpListDataModelClass))
+#define IS_RP_LIST_DATA_MODEL(obj)         (G_TYPE_CHECK_INSTANCE_TYPE((obj), TYPE_RP_LIST_DATA_MODEL))
+#define IS_RP_LIST_DATA_MODEL_CLASS(klass) (G_TYPE_CHECK_CLASS_TYPE((klass),  TYPE_RP_LIST_DATA_MODEL))
+#define RP_LIST_DATA_MODEL_GET_CLASS(obj)  (G_TYPE_INSTANCE_GET_CLASS((obj),  TYPE_RP_LIST_DATA_MODEL, RpListDataModelClass))
+
+/* this function is implemented automatically by the G_DEFINE_TYPE macro */
+GType		rp_list_data_model_get_type	(void) G_GNUC_CONST G_GNUC_INTERNAL;
+
+G_END_DECLS
+
+#ifdef __cplusplus
+/**
+ * Create a new RpListDataModel for an RFT_LISTDATA field.
+ *
+ * The model reads directly from the field's ListData_t and
+ * materializes cell values on demand, so GtkTreeView only ever
+ * requests the rows it's actually rendering. Nothing is copied
+ * into a GtkListStore up front.
+ *
+ * NOTE: The field (and hence the RomFields container) must
+ * outlive the model. RomDataView guarantees this, since the
+ * RomData object is held until the page is disposed.
+ *
+ * NOTE 2: RFT_LISTDATA_MULTI fields are not supported here;
+ * those use a GtkListStore so the strings can be swapped out
+ * when the user changes the language.
+ *
+ * @param field RFT_LISTDATA field.
+ * @return RpListDataModel, or nullptr on error.
+ */
+RpListDataModel	*rp_list_data_model_new		(const LibRpBase::RomFields::Field *field) G_GNUC_INTERNAL G_GNUC_MALLOC;
+#endif /* __cplusplus */
+
+#endif /* __ROMPROPERTIES_GTK_LISTDATAMODEL_HPP__ */
@@ -13,6 +13,9 @@
 // DragImage (GtkImage subclass)
 #include "DragImage.hpp"
 
+// ListDataModel (RFT_LISTDATA-backed GtkTreeModel)
+#include "ListDataModel.hpp"
+
 // librpbase, librpfile, librptexture
 using namespace LibRpBase;
 using LibRpFile::IRpFile;
@@ -82,6 +85,8 @@ static void	rom_data_view_desc_format_type_changed(RpDescFormatType desc_format_
 static void	rom_data_view_init_header_row	(RomDataView	*page);
 static void	rom_data_view_update_display	(RomDataView	*page);
 static gboolean	rom_data_view_load_rom_data	(gpointer	 data);
+static gpointer	rom_data_view_load_rom_data_thread(gpointer	 data);
+static gboolean	rom_data_view_load_rom_data_finished(gpointer	 data);
 static void	rom_data_view_delete_tabs	(RomDataView	*page);
 
 /** Signal handlers. **/
@@ -689,8 +694,8 @@ rom_data_view_init_string(RomDataView *page, const RomFields::Field &field, cons
 	gtk_label_set_use_underline(GTK_LABEL(widget), false);
 	gtk_widget_show(widget);
 
-	if (!str && field.data.str) {
-		str = field.data.str->c_str();
+	if (!str && field.type == RomFields::RFT_STRING) {
+		str = field.str();
 	}
 
 	if (field.type == RomFields::RFT_STRING &&
@@ -905,9 +910,25 @@ rom_data_view_init_listdata(G_GNUC_UNUSED RomDataView *page, const RomFields::Fi
 		colCount = static_cast<int>(list_data->at(0).size());
 	}
 
-	GtkListStore *listStore;
+	GtkTreeModel *treeModel;
+	GtkListStore *listStore = nullptr;
 	int col_start = 0;
-	if (hasCheckboxes) {
+	if (!isMulti) {
+		// Single language: Use a custom model that reads directly
+		// from the ListData_t on demand. GtkTreeView only requests
+		// the rows it's rendering, so huge lists (e.g. Xbox 360
+		// achievements) don't have to be copied into a GtkListStore
+		// before the dialog can open.
+		RpListDataModel *const listModel = rp_list_data_model_new(&field);
+		if (!listModel) {
+			// No data...
+			return nullptr;
+		}
+		treeModel = GTK_TREE_MODEL(listModel);
+		if (hasCheckboxes || hasIcons) {
+			col_start = 1;	// Skip the checkbox/icon column for strings.
+		}
+	} else if (hasCheckboxes) {
 		// Prepend an extra column for checkboxes.
 		GType *types = new GType[colCount+1];
 		types[0] = G_TYPE_BOOLEAN;
@@ -937,63 +958,62 @@ rom_data_view_init_listdata(G_GNUC_UNUSED RomDataView *page, const RomFields::Fi
 		delete[] types;
 	}
 
-	// Add the row data.
-	uint32_t checkboxes = 0;
-	if (hasCheckboxes) {
-		checkboxes = field.data.list_data.mxd.checkboxes;
-	}
-	unsigned int row = 0;	// for icons [TODO: Use iterator?]
-	for (auto iter = list_data->cbegin(); iter != list_data->cend(); ++iter, row++) {
-		const vector<string> &data_row = *iter;
-		// FIXME: Skip even if we don't have checkboxes?
-		// (also check other UI frontends)
-		if (hasCheckboxes && data_row.empty()) {
-			// Skip this row.
-			checkboxes >>= 1;
-			continue;
-		}
+	if (isMulti) {
+		treeModel = GTK_TREE_MODEL(listStore);
 
-		GtkTreeIter treeIter;
-		gtk_list_store_append(listStore, &treeIter);
+		// Add the row data.
+		// NOTE: Only the checkbox/icon column is set here.
+		// Strings are set by rom_data_view_update_multi().
+		uint32_t checkboxes = 0;
 		if (hasCheckboxes) {
-			// Checkbox column.
-			gtk_list_store_set(listStore, &treeIter,
-				0, (checkboxes & 1), -1);
-			checkboxes >>= 1;
-		} else if (hasIcons) {
-			// Icon column.
-			const rp_image *const icon = field.data.list_data.mxd.icons->at(row);
-			assert(icon != nullptr);
-			if (icon) {
-				PIMGTYPE pixbuf = rp_image_to_PIMGTYPE(icon);
-				if (pixbuf) {
-					// TODO: Ideal icon size?
-					// Using 32x32 for now.
-					static const int icon_sz = 32;
-					// NOTE: GtkCellRendererPixbuf can't scale the
-					// pixbuf itself...
-					if (!PIMGTYPE_size_check(pixbuf, icon_sz, icon_sz)) {
-						// TODO: Use nearest-neighbor if upscaling.
-						// Also, preserve the aspect ratio.
-						PIMGTYPE scaled = PIMGTYPE_scale(pixbuf, icon_sz, icon_sz, true);
-						if (scaled) {
-							PIMGTYPE_destroy(pixbuf);
-							pixbuf = scaled;
+			checkboxes = field.data.list_data.mxd.checkboxes;
+		}
+		unsigned int row = 0;	// for icons [TODO: Use iterator?]
+		for (auto iter = list_data->cbegin(); iter != list_data->cend(); ++iter, row++) {
+			const vector<string> &data_row = *iter;
+			// FIXME: Skip even if we don't have checkboxes?
+			// (also check other UI frontends)
+			if (hasCheckboxes && data_row.empty()) {
+				// Skip this row.
+				checkboxes >>= 1;
+				continue;
+			}
+
+			GtkTreeIter treeIter;
+			gtk_list_store_append(listStore, &treeIter);
+			if (hasCheckboxes) {
+				// Checkbox column.
+				gtk_list_store_set(listStore, &treeIter,
+					0, (checkboxes & 1), -1);
+				checkboxes >>= 1;
+			} else if (hasIcons) {
+				// Icon column.
+				const rp_image *const icon = field.data.list_data.mxd.icons->at(row);
+				assert(icon != nullptr);
+				if (icon) {
+					PIMGTYPE pixbuf = rp_image_to_PIMGTYPE(icon);
+					if (pixbuf) {
+						// TODO: Ideal icon size?
+						// Using 32x32 for now.
+						static const int icon_sz = 32;
+						// NOTE: GtkCellRendererPixbuf can't scale the
+						// pixbuf itself...
+						if (!PIMGTYPE_size_check(pixbuf, icon_sz, icon_sz)) {
+							// TODO: Use nearest-neighbor if upscaling.
+							// Also, preserve the aspect ratio.
+							PIMGTYPE scaled = PIMGTYPE_scale(pixbuf, icon_sz, icon_sz, true);
+							if (scaled) {
+								PIMGTYPE_destroy(pixbuf);
+								pixbuf = scaled;
+							}
 						}
+						gtk_list_store_set(listStore, &treeIter,
+							0, pixbuf, -1);
+						PIMGTYPE_destroy(pixbuf);
 					}
-					gtk_list_store_set(listStore, &treeIter,
-						0, pixbuf, -1);
-					PIMGTYPE_destroy(pixbuf);
 				}
 			}
 		}
-
-		if (!isMulti) {
-			int col = col_start;
-			for (auto iter = data_row.cbegin(); iter != data_row.cend(); ++iter, col++) {
-				gtk_list_store_set(listStore, &treeIter, col, iter->c_str(), -1);
-			}
-		}
 	}
 
 	// Scroll area for the GtkTreeView.
@@ -1004,7 +1024,11 @@ rom_data_view_init_listdata(G_GNUC_UNUSED RomDataView *page, const RomFields::Fi
 	gtk_widget_show(widget);
 
 	// Create the GtkTreeView.
-	GtkWidget *treeView = gtk_tree_view_new_with_model(GTK_TREE_MODEL(listStore));
+	GtkWidget *treeView = gtk_tree_view_new_with_model(treeModel);
+	if (!isMulti) {
+		// The GtkTreeView holds the only reference we need.
+		g_object_unref(treeModel);
+	}
 	gtk_tree_view_set_headers_visible(GTK_TREE_VIEW(treeView),
 		(listDataDesc.names != nullptr));
 	gtk_widget_show(treeView);
@@ -1781,6 +1805,30 @@ rom_data_view_update_display(RomDataView *page)
 	}
 }
 
+// Context for the background ROM data loader.
+// Holds a reference to the RomDataView, which keeps it
+// alive until the loader has finished.
+struct RomDataLoadContext {
+	RomDataView *page;	// RomDataView (ref'd)
+	gchar *uri;		// Copy of page->uri when the load was started.
+	RomData *romData;	// Loaded RomData object.
+
+	explicit RomDataLoadContext(RomDataView *page)
+		: page(ROM_DATA_VIEW(g_object_ref(page)))
+		, uri(g_strdup(page->uri))
+		, romData(nullptr) { }
+	~RomDataLoadContext() {
+		if (romData) {
+			romData->unref();
+		}
+		g_free(uri);
+		g_object_unref(page);
+	}
+
+	private:
+		RP_DISABLE_COPY(RomDataLoadContext)
+};
+
 static gboolean
 rom_data_view_load_rom_data(gpointer data)
 {
@@ -1794,22 +1842,92 @@ rom_data_view_load_rom_data(gpointer data)
 		return false;
 	}
 
+	// Load the ROM data on a worker thread so the UI isn't
+	// blocked while the file is scanned and decoded. The display
+	// widgets are created by rom_data_view_load_rom_data_finished()
+	// once the data is ready.
+	RomDataLoadContext *const ctx = new RomDataLoadContext(page);
+	GThread *const thread = g_thread_new("RomDataView",
+		rom_data_view_load_rom_data_thread, ctx);
+	g_thread_unref(thread);
+
+	// Clear the timeout.
+	page->changed_idle = 0;
+	return false;
+}
+
+/**
+ * Load the ROM data. Runs on a worker thread.
+ * Must not touch any GTK+ widgets.
+ * @param data RomDataLoadContext.
+ * @return nullptr.
+ */
+static gpointer
+rom_data_view_load_rom_data_thread(gpointer data)
+{
+	RomDataLoadContext *const ctx = static_cast<RomDataLoadContext*>(data);
+
 	// Check if the URI maps to a local file.
 	IRpFile *file = nullptr;
-	gchar *const filename = g_filename_from_uri(page->uri, nullptr, nullptr);
+	gchar *const filename = g_filename_from_uri(ctx->uri, nullptr, nullptr);
 	if (filename) {
 		// Local file. Use RpFile.
 		file = new RpFile(filename, RpFile::FM_OPEN_READ_GZ);
 		g_free(filename);
 	} else {
 		// Not a local file. Use RpFileGio.
-		file = new RpFileGio(page->uri);
+		file = new RpFileGio(ctx->uri);
 	}
 
 	if (file->isOpen()) {
 		// Create the RomData object.
 		// file is ref()'d by RomData.
-		page->romData = RomDataFactory::create(file);
+		ctx->romData = RomDataFactory::create(file);
+
+		if (ctx->romData) {
+			// Pre-load the fields and the internal banner/icon.
+			// The results are cached in the RomData object, so
+			// rom_data_view_update_display() will get cache hits
+			// on the main thread.
+			ctx->romData->fields();
+			const uint32_t imgbf = ctx->romData->supportedImageTypes();
+			if (imgbf & RomData::IMGBF_INT_BANNER) {
+				ctx->romData->image(RomData::IMG_INT_BANNER);
+			}
+			if (imgbf & RomData::IMGBF_INT_ICON) {
+				ctx->romData->image(RomData::IMG_INT_ICON);
+				ctx->romData->iconAnimData();
+			}
+		}
+	}
+	file->unref();
+
+	// Update the display widgets on the main thread.
+	g_idle_add(rom_data_view_load_rom_data_finished, ctx);
+	return nullptr;
+}
+
+/**
+ * The worker thread has finished loading the ROM data.
+ * Runs on the main thread.
+ * @param data RomDataLoadContext.
+ * @return false to unregister the idle function.
+ */
+static gboolean
+rom_data_view_load_rom_data_finished(gpointer data)
+{
+	RomDataLoadContext *const ctx = static_cast<RomDataLoadContext*>(data);
+	RomDataView *const page = ctx->page;
+
+	// Make sure the URI hasn't changed while the worker was running.
+	if (!g_strcmp0(page->uri, ctx->uri)) {
+		// Take the worker's RomData reference.
+		assert(page->romData == nullptr);
+		if (page->romData) {
+			page->romData->unref();
+		}
+		page->romData = ctx->romData;
+		ctx->romData = nullptr;
 
 		// Update the display widgets.
 		rom_data_view_update_display(page);
@@ -1821,13 +1939,11 @@ rom_data_view_load_rom_data(gpointer data)
 			page->romData->close();
 		}
 	}
-	file->unref();
 
 	// Animation timer will be started when the page
 	// receives the "map" signal.
 
-	// Clear the timeout.
-	page->changed_idle = 0;
+	delete ctx;
 	return false;
 }
 
@@ -0,0 +1,402 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (GTK+ common)                      *
+ * rp-crawler-main.cpp: Thumbnail pre-generation crawler daemon: main()    *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+/**
+ * Thumbnails are normally generated on first view, so the first browse
+ * of any folder full of ROMs is always slow. This daemon watches a set
+ * of library roots via inotify and runs the thumbnailing pipeline at
+ * idle I/O priority, populating the freedesktop.org thumbnail cache
+ * before the user gets there.
+ *
+ * Usage: rp-thumbnail-crawler /path/to/roms [/more/roms ...]
+ */
+
+#include "common.h"
+#include "libunixcommon/userdirs.hpp"
+#include "libunixcommon/dll-search.h"
+
+// GLib
+#include <glib.h>
+
+// C includes.
+#include <dirent.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <sys/inotify.h>
+#include <sys/resource.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <deque>
+#include <string>
+#include <unordered_map>
+using std::deque;
+using std::string;
+using std::unordered_map;
+
+// dlopen()
+#include <dlfcn.h>
+
+// from rp-thumbnailer-dbus.h
+typedef int (*PFN_RP_CREATE_THUMBNAIL)(const char *source_file, const char *output_file, int maximum_size);
+
+// Shutdown request.
+static volatile sig_atomic_t stop_crawler = 0;
+
+// Cache directory.
+static string cache_dir;
+
+// Thumbnailing function from the rom-properties library.
+static PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail = nullptr;
+
+// inotify state.
+static int inotify_fd = -1;
+// Watch descriptor -> directory path.
+static unordered_map<int, string> wd_map;
+
+/**
+ * Signal handler for SIGINT/SIGTERM.
+ * @param signum Signal number.
+ */
+static void sig_handler(int signum)
+{
+	RP_UNUSED(signum);
+	stop_crawler = 1;
+}
+
+/**
+ * Debug print function for rp_dll_search().
+ * @param level Debug level.
+ * @param format Format string.
+ * @param ... Format arguments.
+ * @return vfprintf() return value.
+ */
+static int ATTR_PRINTF(2, 3) fnDebug(int level, const char *format, ...)
+{
+	// g_warning() may be using g_log_structured(),
+	// and there's no variant of g_log_structured()
+	// that takes va_list, so we'll print it to a
+	// buffer first.
+	char buf[512];
+
+	va_list args;
+	va_start(args, format);
+	int ret = vsnprintf(buf, sizeof(buf), format, args);
+	va_end(args);
+
+	if (level < LEVEL_ERROR) {
+		g_debug("%s", buf);
+	} else {
+		g_warning("%s", buf);
+	}
+	return ret;
+}
+
+/**
+ * Initialize the cache directory.
+ * @return 0 on success; non-zero on error.
+ */
+static int init_cache_dir(void)
+{
+	cache_dir = LibUnixCommon::getCacheDirectory();
+	if (cache_dir.empty()) {
+		g_critical("Unable to determine the XDG cache directory.");
+		return -1;
+	}
+	g_debug("Cache directory: %s", cache_dir.c_str());
+	return 0;
+}
+
+/**
+ * Drop to idle CPU and I/O priority.
+ *
+ * The crawler must never compete with the foreground desktop.
+ * CPU priority is set via setpriority(); I/O priority is set to
+ * IOPRIO_CLASS_IDLE via the raw syscall, since glibc doesn't
+ * provide an ioprio_set() wrapper.
+ */
+static void set_idle_priority(void)
+{
+	// Lowest CPU priority.
+	setpriority(PRIO_PROCESS, 0, 19);
+
+#ifdef SYS_ioprio_set
+	// ioprio_set() constants from linux/ioprio.h.
+	// Not available in userspace headers on all systems.
+	static const int IOPRIO_WHO_PROCESS_ = 1;
+	static const int IOPRIO_CLASS_IDLE_ = 3;
+	static const int IOPRIO_CLASS_SHIFT_ = 13;
+	if (syscall(SYS_ioprio_set, IOPRIO_WHO_PROCESS_, 0,
+	    (IOPRIO_CLASS_IDLE_ << IOPRIO_CLASS_SHIFT_)) != 0)
+	{
+		g_debug("ioprio_set() failed: %s", strerror(errno));
+	}
+#endif /* SYS_ioprio_set */
+}
+
+/**
+ * Get the freedesktop.org thumbnail cache filename for a source file.
+ * The flavor directory is created if it doesn't exist.
+ * @param source_file Source filename.
+ * @return Cache filename, or empty string on error.
+ */
+static string thumbnail_cache_filename(const char *source_file)
+{
+	// Thumbnails are keyed on the MD5 of the source file URI.
+	gchar *const uri = g_filename_to_uri(source_file, nullptr, nullptr);
+	if (!uri) {
+		return string();
+	}
+
+	// NOTE: Only generating the "large" (256x256) flavor.
+	// File managers downscale it for "normal" views.
+	string cache_filename = cache_dir;
+	cache_filename += "/thumbnails/large";
+	if (g_mkdir_with_parents(cache_filename.c_str(), 0777) != 0) {
+		g_free(uri);
+		return string();
+	}
+
+	GChecksum *const md5 = g_checksum_new(G_CHECKSUM_MD5);
+	if (!md5) {
+		g_free(uri);
+		return string();
+	}
+	g_checksum_update(md5, (const guchar*)uri, strlen(uri));
+	cache_filename += '/';
+	cache_filename += g_checksum_get_string(md5);
+	cache_filename += ".png";
+
+	g_checksum_free(md5);
+	g_free(uri);
+	return cache_filename;
+}
+
+/**
+ * Thumbnail a single file if its cached thumbnail is missing or stale.
+ * Unsupported files are rejected quickly by the library's header checks.
+ * @param source_file Source filename.
+ */
+static void process_file(const char *source_file)
+{
+	struct stat sb_src;
+	if (lstat(source_file, &sb_src) != 0 || !S_ISREG(sb_src.st_mode)) {
+		// Not a regular file. (Symlinks are not followed.)
+		return;
+	}
+
+	string cache_filename = thumbnail_cache_filename(source_file);
+	if (cache_filename.empty()) {
+		return;
+	}
+
+	// Staleness check: regenerate if the thumbnail is missing or
+	// older than the source file.
+	// TODO: Check the Thumb::MTime PNG tEXt chunk instead?
+	struct stat sb_thumb;
+	if (stat(cache_filename.c_str(), &sb_thumb) == 0 &&
+	    sb_thumb.st_mtime >= sb_src.st_mtime)
+	{
+		// Thumbnail is up to date.
+		return;
+	}
+
+	// NOTE: The return value is ignored; most files in a library
+	// root won't be supported ROM images, and that's fine.
+	pfn_rp_create_thumbnail(source_file, cache_filename.c_str(), 256);
+}
+
+/**
+ * Add an inotify watch for a directory.
+ * @param path Directory path.
+ */
+static void watch_dir(const string &path)
+{
+	const int wd = inotify_add_watch(inotify_fd, path.c_str(),
+		IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE | IN_DELETE_SELF);
+	if (wd >= 0) {
+		wd_map[wd] = path;
+	} else {
+		g_warning("inotify_add_watch(%s) failed: %s",
+			path.c_str(), strerror(errno));
+	}
+}
+
+/**
+ * Recursively crawl a directory: watch it, thumbnail its files,
+ * and descend into subdirectories.
+ *
+ * Iterative with an explicit queue to avoid deep recursion on
+ * pathological trees. Hidden files and directories are skipped.
+ *
+ * @param root Directory path.
+ */
+static void crawl_dir(const string &root)
+{
+	deque<string> queue;
+	queue.push_back(root);
+
+	while (!queue.empty() && !stop_crawler) {
+		const string dir = std::move(queue.front());
+		queue.pop_front();
+
+		DIR *const dirp = opendir(dir.c_str());
+		if (!dirp) {
+			g_warning("opendir(%s) failed: %s", dir.c_str(), strerror(errno));
+			continue;
+		}
+		watch_dir(dir);
+
+		const struct dirent *dirent;
+		while ((dirent = readdir(dirp)) != nullptr && !stop_crawler) {
+			if (dirent->d_name[0] == '.') {
+				// Skip hidden files and "."/"..".
+				continue;
+			}
+
+			string full_path = dir;
+			full_path += '/';
+			full_path += dirent->d_name;
+
+			struct stat sb;
+			if (lstat(full_path.c_str(), &sb) != 0) {
+				continue;
+			}
+			if (S_ISDIR(sb.st_mode)) {
+				queue.push_back(std::move(full_path));
+			} else if (S_ISREG(sb.st_mode)) {
+				process_file(full_path.c_str());
+			}
+		}
+		closedir(dirp);
+	}
+}
+
+/**
+ * Run the inotify event loop until a shutdown signal is received.
+ * @return 0 on clean shutdown; non-zero on error.
+ */
+static int inotify_loop(void)
+{
+	// Large enough for a burst of events with long filenames.
+	uint8_t buf[16384];
+
+	while (!stop_crawler) {
+		const ssize_t len = read(inotify_fd, buf, sizeof(buf));
+		if (len <= 0) {
+			if (errno == EINTR) {
+				// Interrupted by a signal; check stop_crawler.
+				continue;
+			}
+			g_critical("inotify read() failed: %s", strerror(errno));
+			return -1;
+		}
+
+		for (ssize_t pos = 0; pos < len; ) {
+			const struct inotify_event *const event =
+				reinterpret_cast<const struct inotify_event*>(&buf[pos]);
+			pos += sizeof(struct inotify_event) + event->len;
+
+			auto iter = wd_map.find(event->wd);
+			if (iter == wd_map.end()) {
+				continue;
+			}
+
+			if (event->mask & IN_DELETE_SELF) {
+				// Watched directory is gone.
+				wd_map.erase(iter);
+				continue;
+			}
+			if (event->len == 0 || event->name[0] == '.') {
+				continue;
+			}
+
+			string full_path = iter->second;
+			full_path += '/';
+			full_path += event->name;
+
+			if (event->mask & IN_ISDIR) {
+				// New subdirectory: crawl it.
+				// (Files moved in with it won't generate
+				// their own events.)
+				crawl_dir(full_path);
+			} else if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+				// New or modified file.
+				process_file(full_path.c_str());
+			}
+		}
+	}
+	return 0;
+}
+
+int main(int argc, char *argv[])
+{
+	if (getuid() == 0 || geteuid() == 0) {
+		fprintf(stderr, "*** %s does not support running as root.\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	if (argc < 2) {
+		fprintf(stderr, "Usage: %s LIBRARY_ROOT [LIBRARY_ROOT ...]\n"
+			"Pre-generates ROM thumbnails for the specified directories\n"
+			"and keeps them up to date via inotify.\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	// This daemon should never get in the user's way.
+	set_idle_priority();
+
+	// Initialize the cache directory.
+	if (init_cache_dir() != 0) {
+		return EXIT_FAILURE;
+	}
+
+	// Attempt to open a ROM Properties Page library.
+	void *pDll = nullptr;
+	int ret = rp_dll_search("rp_create_thumbnail", &pDll, (void**)&pfn_rp_create_thumbnail, fnDebug);
+	if (ret != 0) {
+		return EXIT_FAILURE;
+	}
+
+	inotify_fd = inotify_init();
+	if (inotify_fd < 0) {
+		g_critical("inotify_init() failed: %s", strerror(errno));
+		dlclose(pDll);
+		return EXIT_FAILURE;
+	}
+
+	// Exit cleanly on SIGINT/SIGTERM.
+	struct sigaction sa;
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = sig_handler;
+	sigaction(SIGINT, &sa, nullptr);
+	sigaction(SIGTERM, &sa, nullptr);
+
+	// Initial crawl of all library roots.
+	// Watches are registered as directories are visited, so
+	// changes made during the crawl are picked up afterwards.
+	for (int i = 1; i < argc && !stop_crawler; i++) {
+		g_debug("Crawling library root: %s", argv[i]);
+		crawl_dir(argv[i]);
+	}
+
+	// Watch for changes until we're told to stop.
+	ret = inotify_loop();
+
+	close(inotify_fd);
+	dlclose(pDll);
+	return (ret == 0 ? EXIT_SUCCESS : EXIT_FAILURE);
+}
@@ -15,12 +15,18 @@
 #include "common.h"
 
 #include <glib-object.h>
+#include <glib/gstdio.h>
+#include <gio/gunixfdlist.h>
 #include "SpecializedThumbnailer1.h"
 
 // C includes.
+#include <errno.h>
+#include <fcntl.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 // from tumbler-utils.h
 #define g_dbus_async_return_val_if_fail(expr, invocation, val) \
@@ -52,6 +58,8 @@ enum RpThumbnailerProperties {
 	PROP_CONNECTION,
 	PROP_CACHE_DIR,
 	PROP_PFN_RP_CREATE_THUMBNAIL,
+	PROP_PFN_RP_CREATE_THUMBNAIL_RAW,
+	PROP_PFN_RP_CREATE_THUMBNAIL2,
 	PROP_EXPORTED,
 
 	PROP_LAST
@@ -72,7 +80,9 @@ static void	rp_thumbnailer_set_property	(GObject	*object,
 						 GParamSpec	*pspec);
 
 static gboolean	rp_thumbnailer_timeout		(RpThumbnailer	*thumbnailer);
-static gboolean	rp_thumbnailer_process		(RpThumbnailer	*thumbnailer);
+static void	rp_thumbnailer_process		(gpointer	 data,
+						 gpointer	 user_data);
+static gboolean	rp_thumbnailer_request_done	(gpointer	 data);
 
 // D-Bus methods.
 static gboolean	rp_thumbnailer_queue		(OrgFreedesktopThumbnailsSpecializedThumbnailer1 *skeleton,
@@ -86,6 +96,12 @@ static gboolean	rp_thumbnailer_dequeue		(OrgFreedesktopThumbnailsSpecializedThum
 						 GDBusMethodInvocation *invocation,
 						 guint		 handle,
 						 RpThumbnailer	*thumbnailer);
+static gboolean	rp_thumbnailer_get_raw_thumbnail(OrgFreedesktopThumbnailsSpecializedThumbnailer1 *skeleton,
+						 GDBusMethodInvocation *invocation,
+						 GUnixFDList	*fd_list,
+						 const gchar	*uri,
+						 const char	*flavor,
+						 RpThumbnailer	*thumbnailer);
 
 struct _RpThumbnailerClass {
 	GObjectClass __parent__;
@@ -97,19 +113,22 @@ struct _RpThumbnailerClass {
 // Thumbnail request information.
 struct request_info {
 	gchar *uri;
+	gchar *mime_type;	// may be NULL
 	guint handle;
 	bool large;	// False for 'normal' (128x128); true for 'large' (256x256)
 	bool urgent;	// 'urgent' value
 };
 
-static void request_info_free(gpointer data, G_GNUC_UNUSED gpointer user_data)
-{
-	if (data) {
-		struct request_info *const req = (struct request_info*)data;
-		g_free(req->uri);
-		g_free(req);
-	}
-}
+// Completed request information.
+// Allocated by a worker thread; passed back to the main loop
+// via g_idle_add() so the D-Bus signals are emitted there.
+struct request_result {
+	RpThumbnailer *thumbnailer;	// owns a reference
+	gchar *uri;
+	guint handle;
+	int ret;		// 0 on success
+	gchar *err_msg;		// error message if ret != 0
+};
 
 struct _RpThumbnailer {
 	GObject __parent__;
@@ -121,14 +140,16 @@ struct _RpThumbnailer {
 	// Shutdown timeout.
 	guint timeout_id;
 
-	// Idle function for processing.
-	guint idle_process;
-
 	// Last handle value.
 	guint last_handle;
 
-	// Request queue.
-	GQueue *request_queue;	// element is struct request_info*
+	// Worker thread pool. Each worker runs its own
+	// RomDataFactory pipeline via pfn_rp_create_thumbnail().
+	GThreadPool *thread_pool;
+
+	// Number of requests that are queued or in progress.
+	// (atomic)
+	gint active_requests;
 
 	/** Properties. **/
 
@@ -141,6 +162,16 @@ struct _RpThumbnailer {
 	// rp_create_thumbnail() function pointer.
 	PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail;
 
+	// rp_create_thumbnail_raw() function pointer.
+	// May be NULL if the library doesn't support the
+	// shared-memory result path.
+	PFN_RP_CREATE_THUMBNAIL_RAW pfn_rp_create_thumbnail_raw;
+
+	// rp_create_thumbnail2() function pointer.
+	// May be NULL if the library doesn't support
+	// MIME-routed dispatch.
+	PFN_RP_CREATE_THUMBNAIL2 pfn_rp_create_thumbnail2;
+
 	// Is the D-Bus object exported?
 	bool exported;
 };
@@ -216,6 +247,14 @@ rp_thumbnailer_class_init(gpointer g_class, gpointer class_data)
 		g_param_spec_pointer("pfn_rp_create_thumbnail", "pfn_rp_create_thumbnail",
 			"rp_create_thumbnail() function pointer.",
 			(GParamFlags)(G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY)));
+	g_object_class_install_property(gobject_class, PROP_PFN_RP_CREATE_THUMBNAIL_RAW,
+		g_param_spec_pointer("pfn_rp_create_thumbnail_raw", "pfn_rp_create_thumbnail_raw",
+			"rp_create_thumbnail_raw() function pointer.",
+			(GParamFlags)(G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY)));
+	g_object_class_install_property(gobject_class, PROP_PFN_RP_CREATE_THUMBNAIL2,
+		g_param_spec_pointer("pfn_rp_create_thumbnail2", "pfn_rp_create_thumbnail2",
+			"rp_create_thumbnail2() function pointer.",
+			(GParamFlags)(G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY)));
 	g_object_class_install_property(gobject_class, PROP_EXPORTED,
 		g_param_spec_boolean("exported", "exported", "Is the D-Bus object exported?",
 			false, G_PARAM_READABLE));
@@ -230,14 +269,29 @@ rp_thumbnailer_init(GTypeInstance *instance, gpointer g_class)
 	thumbnailer->skeleton = NULL;
 	thumbnailer->shutdown_emitted = false;
 	thumbnailer->timeout_id = 0;
-	thumbnailer->idle_process = 0;
 	thumbnailer->last_handle = 0;
-	thumbnailer->request_queue = g_queue_new();
+	thumbnailer->active_requests = 0;
+
+	// Create the worker thread pool.
+	// Using one worker per CPU, up to 4: thumbnailing is mostly
+	// CPU-bound, and more workers just thrash the disk.
+#if GLIB_CHECK_VERSION(2,36,0)
+	gint num_workers = (gint)g_get_num_processors();
+	if (num_workers > 4) {
+		num_workers = 4;
+	}
+#else /* !GLIB_CHECK_VERSION(2,36,0) */
+	gint num_workers = 2;
+#endif /* GLIB_CHECK_VERSION(2,36,0) */
+	thumbnailer->thread_pool = g_thread_pool_new(rp_thumbnailer_process,
+		thumbnailer, num_workers, FALSE, NULL);
 
 	/** Properties. **/
 	thumbnailer->connection = NULL;
 	thumbnailer->cache_dir = NULL;
 	thumbnailer->pfn_rp_create_thumbnail = NULL;
+	thumbnailer->pfn_rp_create_thumbnail_raw = NULL;
+	thumbnailer->pfn_rp_create_thumbnail2 = NULL;
 	thumbnailer->exported = false;
 }
 
@@ -261,6 +315,8 @@ rp_thumbnailer_constructed(GObject *object)
 			G_CALLBACK(rp_thumbnailer_queue), thumbnailer);
 		g_signal_connect(thumbnailer->skeleton, "handle-dequeue",
 			G_CALLBACK(rp_thumbnailer_dequeue), thumbnailer);
+		g_signal_connect(thumbnailer->skeleton, "handle-get-raw-thumbnail",
+			G_CALLBACK(rp_thumbnailer_get_raw_thumbnail), thumbnailer);
 		
 		// Make sure we shut down after inactivity.
 		thumbnailer->timeout_id = g_timeout_add_seconds(SHUTDOWN_TIMEOUT_SECONDS,
@@ -283,10 +339,12 @@ rp_thumbnailer_dispose(GObject *object)
 		thumbnailer->timeout_id = 0;
 	}
 
-	// Unregister idle_process.
-	if (G_UNLIKELY(thumbnailer->idle_process != 0)) {
-		g_source_remove(thumbnailer->idle_process);
-		thumbnailer->idle_process = 0;
+	// Free the worker thread pool.
+	// Queued requests are discarded; running requests are
+	// waited for, since the workers reference this object.
+	if (thumbnailer->thread_pool) {
+		g_thread_pool_free(thumbnailer->thread_pool, TRUE, TRUE);
+		thumbnailer->thread_pool = NULL;
 	}
 
 	// Call the superclass dispose() function.
@@ -302,10 +360,6 @@ rp_thumbnailer_finalize(GObject *object)
 		g_object_unref(thumbnailer->skeleton);
 	}
 
-	// Delete any remaining requests and free the queue.
-	g_queue_foreach(thumbnailer->request_queue, request_info_free, 0);
-	g_queue_free(thumbnailer->request_queue);
-
 	/** Properties. **/
 	g_free(thumbnailer->cache_dir);
 
@@ -337,6 +391,12 @@ rp_thumbnailer_get_property(GObject *object,
 		case PROP_PFN_RP_CREATE_THUMBNAIL:
 			g_value_set_pointer(value, (gpointer)thumbnailer->pfn_rp_create_thumbnail);
 			break;
+		case PROP_PFN_RP_CREATE_THUMBNAIL_RAW:
+			g_value_set_pointer(value, (gpointer)thumbnailer->pfn_rp_create_thumbnail_raw);
+			break;
+		case PROP_PFN_RP_CREATE_THUMBNAIL2:
+			g_value_set_pointer(value, (gpointer)thumbnailer->pfn_rp_create_thumbnail2);
+			break;
 		case PROP_EXPORTED:
 			g_value_set_boolean(value, thumbnailer->exported);
 			break;
@@ -386,6 +446,16 @@ rp_thumbnailer_set_property(GObject *object,
 				(PFN_RP_CREATE_THUMBNAIL)g_value_get_pointer(value);
 			break;
 
+		case PROP_PFN_RP_CREATE_THUMBNAIL_RAW:
+			thumbnailer->pfn_rp_create_thumbnail_raw =
+				(PFN_RP_CREATE_THUMBNAIL_RAW)g_value_get_pointer(value);
+			break;
+
+		case PROP_PFN_RP_CREATE_THUMBNAIL2:
+			thumbnailer->pfn_rp_create_thumbnail2 =
+				(PFN_RP_CREATE_THUMBNAIL2)g_value_get_pointer(value);
+			break;
+
 		case PROP_EXPORTED:
 			// FIXME: Read-only property.
 			// Need to show some error message...
@@ -415,7 +485,6 @@ rp_thumbnailer_queue(OrgFreedesktopThumbnailsSpecializedThumbnailer1 *skeleton,
 	const char *flavor, bool urgent,
 	RpThumbnailer *thumbnailer)
 {
-	RP_UNUSED(mime_type);
 	g_dbus_async_return_val_if_fail(IS_RP_THUMBNAILER(thumbnailer), invocation, false);
 	g_dbus_async_return_val_if_fail(uri != NULL, invocation, false);
 
@@ -441,21 +510,19 @@ rp_thumbnailer_queue(OrgFreedesktopThumbnailsSpecializedThumbnailer1 *skeleton,
 		handle = ++thumbnailer->last_handle;
 	}
 
-	// Add the URI to the queue.
+	// Push the URI to the worker thread pool.
 	// NOTE: Currently handling all flavors that aren't "large" as "normal".
 	struct request_info *req = g_malloc(sizeof(struct request_info));
 	req->uri = g_strdup(uri);
+	// Tumbler always supplies the MIME type; keep it so the
+	// worker can dispatch directly to the candidate parsers.
+	req->mime_type = (mime_type && mime_type[0] != '\0') ? g_strdup(mime_type) : NULL;
 	req->handle = handle;
 	req->large = flavor && (g_ascii_strcasecmp(flavor, "large") == 0);
 	req->urgent = urgent;
-	// TODO Put 'urgent' requests at the front of the queue?
-	g_queue_push_tail(thumbnailer->request_queue, req);
-
-	// Make sure the idle process is started.
-	// TODO: Make it multi-threaded? (needs atomic compare and/or mutex...)
-	if (thumbnailer->idle_process == 0) {
-		thumbnailer->idle_process = g_idle_add((GSourceFunc)rp_thumbnailer_process, thumbnailer);
-	}
+	// TODO: Put 'urgent' requests at the front of the pool's queue?
+	g_atomic_int_inc(&thumbnailer->active_requests);
+	g_thread_pool_push(thumbnailer->thread_pool, req, NULL);
 
 	org_freedesktop_thumbnails_specialized_thumbnailer1_complete_queue(skeleton, invocation, handle);
 	return true;
@@ -483,6 +550,143 @@ rp_thumbnailer_dequeue(OrgFreedesktopThumbnailsSpecializedThumbnailer1 *skeleton
 	return true;
 }
 
+/**
+ * Create an anonymous in-memory file for the raw thumbnail data.
+ * @return File descriptor, or -1 on error.
+ */
+static int
+rp_thumbnailer_create_memfd(void)
+{
+	int fd = -1;
+
+#ifdef MFD_CLOEXEC
+	fd = memfd_create("rp-thumbnail", MFD_CLOEXEC);
+#endif /* MFD_CLOEXEC */
+	if (fd < 0) {
+		// memfd_create() isn't available.
+		// Fall back to an unlinked temporary file.
+		gchar *filename = NULL;
+		fd = g_file_open_tmp("rp-thumbnail.XXXXXX", &filename, NULL);
+		if (filename) {
+			g_unlink(filename);
+			g_free(filename);
+		}
+	}
+
+	return fd;
+}
+
+/**
+ * Create a thumbnail and return the raw pixel data in a memfd.
+ *
+ * Unlike Queue(), this is processed synchronously and skips both
+ * PNG encoding and the thumbnail cache, so the requesting process
+ * gets the pixel data without a disk round trip. This is a
+ * rom-properties extension; Tumbler doesn't use it.
+ *
+ * @param skeleton	[in] GDBusObjectSkeleton
+ * @param invocation	[in/out] GDBusMethodInvocation
+ * @param fd_list	[in] GUnixFDList (unused; no fds are passed in)
+ * @param uri		[in] URI to thumbnail.
+ * @param flavor	[in] The flavor that should be made, e.g. "normal".
+ * @param thumbnailer	[in] RpThumbnailer object.
+ * @return True if the signal was handled; false if not.
+ */
+static gboolean
+rp_thumbnailer_get_raw_thumbnail(OrgFreedesktopThumbnailsSpecializedThumbnailer1 *skeleton,
+	GDBusMethodInvocation *invocation,
+	GUnixFDList *fd_list,
+	const gchar *uri, const char *flavor,
+	RpThumbnailer *thumbnailer)
+{
+	bool large;
+	int fd;
+	int width, height, rowstride, format;
+	int ret;
+	GUnixFDList *out_fd_list;
+	gint fd_idx;
+
+	RP_UNUSED(fd_list);
+	g_dbus_async_return_val_if_fail(IS_RP_THUMBNAILER(thumbnailer), invocation, false);
+	g_dbus_async_return_val_if_fail(uri != NULL, invocation, false);
+
+	if (G_UNLIKELY(thumbnailer->shutdown_emitted)) {
+		// The shutdown signal was emitted.
+		g_dbus_method_invocation_return_error(invocation,
+			G_DBUS_ERROR, G_DBUS_ERROR_NO_SERVER, "Service is shutting down.");
+		return true;
+	}
+	if (!thumbnailer->pfn_rp_create_thumbnail_raw) {
+		// Shared-memory result path isn't available.
+		g_dbus_method_invocation_return_error(invocation,
+			G_DBUS_ERROR, G_DBUS_ERROR_NOT_SUPPORTED,
+			"rp_create_thumbnail_raw() is not available.");
+		return true;
+	}
+
+	// Stop the inactivity timeout while processing.
+	if (G_LIKELY(thumbnailer->timeout_id != 0)) {
+		g_source_remove(thumbnailer->timeout_id);
+		thumbnailer->timeout_id = 0;
+	}
+
+	// NOTE: Currently handling all flavors that aren't "large" as "normal".
+	large = flavor && (g_ascii_strcasecmp(flavor, "large") == 0);
+
+	// Create the memfd for the pixel data.
+	fd = rp_thumbnailer_create_memfd();
+	if (fd < 0) {
+		g_dbus_method_invocation_return_error(invocation,
+			G_DBUS_ERROR, G_DBUS_ERROR_FAILED,
+			"Cannot create an anonymous in-memory file.");
+		goto restart_timeout;
+	}
+
+	// Thumbnail the image.
+	ret = thumbnailer->pfn_rp_create_thumbnail_raw(uri, fd,
+		large ? 256 : 128, &width, &height, &rowstride, &format);
+	if (ret != 0) {
+		// Error thumbnailing the image...
+		g_debug("rom-properties raw thumbnail: %s [ERR=%d]", uri, ret);
+		close(fd);
+		g_dbus_method_invocation_return_error(invocation,
+			G_DBUS_ERROR, G_DBUS_ERROR_FAILED,
+			"Image thumbnailing failed. (error code %d)", ret);
+		goto restart_timeout;
+	}
+
+	// Rewind the fd so the client can read the pixel data.
+	lseek(fd, 0, SEEK_SET);
+
+	// Pass the fd to the client.
+	out_fd_list = g_unix_fd_list_new();
+	fd_idx = g_unix_fd_list_append(out_fd_list, fd, NULL);
+	close(fd);	// the fd list has its own duplicate
+	if (fd_idx < 0) {
+		g_object_unref(out_fd_list);
+		g_dbus_method_invocation_return_error(invocation,
+			G_DBUS_ERROR, G_DBUS_ERROR_FAILED,
+			"Cannot append the memfd to the fd list.");
+		goto restart_timeout;
+	}
+
+	g_debug("rom-properties raw thumbnail: %s [OK, %dx%d]", uri, width, height);
+	org_freedesktop_thumbnails_specialized_thumbnailer1_complete_get_raw_thumbnail(
+		skeleton, invocation, out_fd_list,
+		fd_idx, width, height, rowstride, format);
+	g_object_unref(out_fd_list);
+
+restart_timeout:
+	// Restart the inactivity timeout if nothing else is queued.
+	if (g_atomic_int_get(&thumbnailer->active_requests) == 0 &&
+	    G_LIKELY(thumbnailer->timeout_id == 0))
+	{
+		thumbnailer->timeout_id = g_timeout_add_seconds(SHUTDOWN_TIMEOUT_SECONDS,
+			(GSourceFunc)rp_thumbnailer_timeout, thumbnailer);
+	}
+	return true;
+}
+
 /**
  * Inactivity timeout has elapsed.
  * @param thumbnailer RpThumbnailer object.
@@ -491,7 +695,7 @@ static gboolean
 rp_thumbnailer_timeout(RpThumbnailer *thumbnailer)
 {
 	g_return_val_if_fail(IS_RP_THUMBNAILER(thumbnailer), false);
-	if (!g_queue_is_empty(thumbnailer->request_queue)) {
+	if (g_atomic_int_get(&thumbnailer->active_requests) > 0) {
 		// Still processing stuff.
 		return true;
 	}
@@ -506,43 +710,39 @@ rp_thumbnailer_timeout(RpThumbnailer *thumbnailer)
 }
 
 /**
- * Process a thumbnail.
- * @param thumbnailer RpThumbnailer object.
+ * Process a thumbnail request. (worker thread)
+ *
+ * Each worker runs its own RomDataFactory pipeline via
+ * pfn_rp_create_thumbnail(); the result is passed back to the
+ * main loop via g_idle_add() for D-Bus signal emission.
+ *
+ * @param data		struct request_info*. (takes ownership)
+ * @param user_data	RpThumbnailer object.
  */
-static gboolean
-rp_thumbnailer_process(RpThumbnailer *thumbnailer)
+static void
+rp_thumbnailer_process(gpointer data, gpointer user_data)
 {
-	g_return_val_if_fail(IS_RP_THUMBNAILER(thumbnailer), FALSE);
+	struct request_info *const req = (struct request_info*)data;
+	RpThumbnailer *const thumbnailer = RP_THUMBNAILER(user_data);
 
 	GChecksum *md5 = NULL;
 	const gchar *md5_string;	// owned by md5 object
-	const struct request_info *req;	// request info from the map
-	gchar *cache_filename = NULL;	// cache filename (g_strdup_printf())
+	gchar *cache_filename = NULL;	// cache filename (g_malloc())
 	size_t cache_filename_sz;	// size of cache_filename
 	int pos, pos2;			// snprintf() position
-	int ret;
-
-	// Process one thumbnail.
-	req = (struct request_info*)g_queue_pop_head(thumbnailer->request_queue);
-	if (req == NULL) {
-		// Nothing in the queue.
-		goto cleanup;
-	}
+	int ret = -1;
+	gchar *err_msg = NULL;
 
 	// NOTE: cache_dir and pfn_rp_create_thumbnail should NOT be NULL
 	// at this point, but we're checking it anyway.
 	if (!thumbnailer->cache_dir || thumbnailer->cache_dir[0] == 0) {
 		// No cache directory...
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, "",
-			0, "Thumbnail cache directory is empty.");
+		err_msg = g_strdup("Thumbnail cache directory is empty.");
 		goto finished;
 	}
 	if (!thumbnailer->pfn_rp_create_thumbnail) {
 		// No thumbnailer function.
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, "",
-			0, "No thumbnailer function is available.");
+		err_msg = g_strdup("No thumbnailer function is available.");
 		goto finished;
 	}
 
@@ -563,16 +763,12 @@ rp_thumbnailer_process(RpThumbnailer *thumbnailer)
 	// pos does NOT include the NULL terminator, so check >=.
 	if (pos < 0 || ((size_t)pos + 1 + 32 + 4) > cache_filename_sz) {
 		// Not enough memory.
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			0, "Cannot snprintf() the thumbnail cache directory name.");
+		err_msg = g_strdup("Cannot snprintf() the thumbnail cache directory name.");
 		goto finished;
 	}
 
 	if (g_mkdir_with_parents(cache_filename, 0777) != 0) {
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			0, "Cannot mkdir() the thumbnail cache directory.");
+		err_msg = g_strdup("Cannot mkdir() the thumbnail cache directory.");
 		goto finished;
 	}
 
@@ -582,9 +778,7 @@ rp_thumbnailer_process(RpThumbnailer *thumbnailer)
 	if (!md5) {
 		// Cannot allocate an MD5...
 		// TODO: Test for this early.
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			0, "g_checksum_new() does not support MD5.");
+		err_msg = g_strdup("g_checksum_new() does not support MD5.");
 		goto finished;
 	}
 	g_checksum_update(md5, (const guchar*)req->uri, strlen(req->uri));
@@ -595,51 +789,92 @@ rp_thumbnailer_process(RpThumbnailer *thumbnailer)
 	// pos and pos2 do NOT include the NULL terminator, so check >=.
 	if (pos2 < 0 || ((size_t)pos + (size_t)pos2) >= cache_filename_sz) {
 		// Not enough memory.
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			0, "Cannot snprintf() the thumbnail filename.");
+		err_msg = g_strdup("Cannot snprintf() the thumbnail filename.");
 		goto finished;
 	}
 
 	// Thumbnail the image.
-	ret = thumbnailer->pfn_rp_create_thumbnail(req->uri, cache_filename, req->large ? 256 : 128);
+	// Use the MIME-routed entry point if the library has one;
+	// it skips extension guessing in RomDataFactory entirely.
+	if (thumbnailer->pfn_rp_create_thumbnail2 && req->mime_type) {
+		ret = thumbnailer->pfn_rp_create_thumbnail2(req->uri, cache_filename,
+			req->large ? 256 : 128, req->mime_type);
+	} else {
+		ret = thumbnailer->pfn_rp_create_thumbnail(req->uri, cache_filename, req->large ? 256 : 128);
+	}
 	if (ret == 0) {
 		// Image thumbnailed successfully.
 		g_debug("rom-properties thumbnail: %s -> %s [OK]", req->uri, cache_filename);
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_ready(
-			thumbnailer->skeleton, req->handle, req->uri);
 	} else {
 		// Error thumbnailing the image...
 		g_debug("rom-properties thumbnail: %s -> %s [ERR=%d]", req->uri, cache_filename, ret);
-		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
-			thumbnailer->skeleton, req->handle, req->uri,
-			2, "Image thumbnailing failed... (TODO: return code)");
+		err_msg = g_strdup("Image thumbnailing failed... (TODO: return code)");
 	}
 
 finished:
-	// Request is finished. Emit the finished signal.
-	org_freedesktop_thumbnails_specialized_thumbnailer1_emit_finished(
-		thumbnailer->skeleton, req->handle);
+	// Pass the result back to the main loop for signal emission.
+	{
+		struct request_result *const res = g_malloc(sizeof(struct request_result));
+		res->thumbnailer = g_object_ref(thumbnailer);
+		res->uri = req->uri;	// take ownership
+		res->handle = req->handle;
+		res->ret = (err_msg ? (ret != 0 ? ret : -1) : ret);
+		res->err_msg = err_msg;
+		g_idle_add(rp_thumbnailer_request_done, res);
+	}
 
-cleanup:
 	// Free allocated things.
-	g_checksum_free(md5);
+	// NOTE: req->uri is now owned by the result struct.
+	if (md5) {
+		g_checksum_free(md5);
+	}
 	g_free(cache_filename);
+	g_free(req->mime_type);
+	g_free(req);
+}
 
-	// Return TRUE if we still have more thumbnails queued.
-	const bool isEmpty = g_queue_is_empty(thumbnailer->request_queue);
-	if (isEmpty) {
-		// Clear the idle process.
-		// FIXME: Atomic compare and/or mutex? (assuming multi-threaded...)
-		thumbnailer->idle_process = 0;
+/**
+ * A thumbnail request has completed. (main loop)
+ *
+ * Emits the Ready/Error and Finished signals, and restarts the
+ * inactivity timeout once the last active request has completed.
+ *
+ * @param data struct request_result*. (takes ownership)
+ * @return G_SOURCE_REMOVE
+ */
+static gboolean
+rp_thumbnailer_request_done(gpointer data)
+{
+	struct request_result *const res = (struct request_result*)data;
+	RpThumbnailer *const thumbnailer = res->thumbnailer;
 
+	if (res->ret == 0) {
+		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_ready(
+			thumbnailer->skeleton, res->handle, res->uri);
+	} else {
+		org_freedesktop_thumbnails_specialized_thumbnailer1_emit_error(
+			thumbnailer->skeleton, res->handle, (res->uri ? res->uri : ""),
+			2, (res->err_msg ? res->err_msg : "Image thumbnailing failed."));
+	}
+
+	// Request is finished. Emit the finished signal.
+	org_freedesktop_thumbnails_specialized_thumbnailer1_emit_finished(
+		thumbnailer->skeleton, res->handle);
+
+	if (g_atomic_int_dec_and_test(&thumbnailer->active_requests)) {
+		// Last active request has completed.
 		// Restart the inactivity timeout.
-		if (G_LIKELY(thumbnailer->timeout_id == 0)) {
+		if (G_LIKELY(thumbnailer->timeout_id == 0) && !thumbnailer->shutdown_emitted) {
 			thumbnailer->timeout_id = g_timeout_add_seconds(SHUTDOWN_TIMEOUT_SECONDS,
 				(GSourceFunc)rp_thumbnailer_timeout, thumbnailer);
 		}
 	}
-	return !isEmpty;
+
+	g_object_unref(thumbnailer);
+	g_free(res->uri);
+	g_free(res->err_msg);
+	g_free(res);
+	return FALSE;
 }
 
 /**
@@ -647,17 +882,23 @@ cleanup:
  * @param connection			[in] GDBusConnection
  * @param cache_dir			[in] Cache directory.
  * @param pfn_rp_create_thumbnail	[in] rp_create_thumbnail() function pointer.
+ * @param pfn_rp_create_thumbnail_raw	[in] rp_create_thumbnail_raw() function pointer. (may be NULL)
+ * @param pfn_rp_create_thumbnail2	[in] rp_create_thumbnail2() function pointer. (may be NULL)
  * @return RpThumbnailer object.
  */
 RpThumbnailer*
 rp_thumbnailer_new(GDBusConnection *connection,
 	const gchar *cache_dir,
-	PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail)
+	PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail,
+	PFN_RP_CREATE_THUMBNAIL_RAW pfn_rp_create_thumbnail_raw,
+	PFN_RP_CREATE_THUMBNAIL2 pfn_rp_create_thumbnail2)
 {
 	return g_object_new(TYPE_RP_THUMBNAILER,
 		"connection", connection,
 		"cache_dir", cache_dir,
 		"pfn_rp_create_thumbnail", pfn_rp_create_thumbnail,
+		"pfn_rp_create_thumbnail_raw", pfn_rp_create_thumbnail_raw,
+		"pfn_rp_create_thumbnail2", pfn_rp_create_thumbnail2,
 		NULL);
 }
 
@@ -23,6 +23,37 @@ G_BEGIN_DECLS
  */
 typedef int (*PFN_RP_CREATE_THUMBNAIL)(const char *source_file, const char *output_file, int maximum_size);
 
+/**
+ * rp_create_thumbnail2() function pointer.
+ * Same as rp_create_thumbnail(), but with the MIME type supplied
+ * by the thumbnailing framework, so the library can dispatch
+ * directly to the candidate parsers. Optional; may not be present
+ * in older libraries.
+ * @param source_file Source file. (UTF-8)
+ * @param output_file Output file. (UTF-8)
+ * @param maximum_size Maximum size.
+ * @param mime_type MIME type of the source file, or NULL if unknown.
+ * @return 0 on success; non-zero on error.
+ */
+typedef int (*PFN_RP_CREATE_THUMBNAIL2)(const char *source_file, const char *output_file, int maximum_size, const char *mime_type);
+
+/**
+ * rp_create_thumbnail_raw() function pointer.
+ * Writes the raw pixel data to a file descriptor (e.g. a memfd)
+ * instead of encoding a PNG file. Optional; may not be present
+ * in older libraries.
+ * @param source_file Source file. (UTF-8)
+ * @param fd Output file descriptor.
+ * @param maximum_size Maximum size.
+ * @param pWidth Image width.
+ * @param pHeight Image height.
+ * @param pRowstride Row stride, in bytes.
+ * @param pFormat Pixel format. (0 == native-endian ARGB32; 1 == ABGR32)
+ * @return 0 on success; non-zero on error.
+ */
+typedef int (*PFN_RP_CREATE_THUMBNAIL_RAW)(const char *source_file, int fd, int maximum_size,
+	int *pWidth, int *pHeight, int *pRowstride, int *pFormat);
+
 typedef struct _RpThumbnailerClass	RpThumbnailerClass;
 typedef struct _RpThumbnailer		RpThumbnailer;
 
@@ -37,7 +68,9 @@ GType		rp_thumbnailer_get_type			(void) G_GNUC_CONST G_GNUC_INTERNAL;
 
 RpThumbnailer	*rp_thumbnailer_new			(GDBusConnection *connection,
 							 const gchar *cache_dir,
-							 PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail)
+							 PFN_RP_CREATE_THUMBNAIL pfn_rp_create_thumbnail,
+							 PFN_RP_CREATE_THUMBNAIL_RAW pfn_rp_create_thumbnail_raw,
+							 PFN_RP_CREATE_THUMBNAIL2 pfn_rp_create_thumbnail2)
 							G_GNUC_MALLOC G_GNUC_WARN_UNUSED_RESULT;
 
 gboolean	rp_thumbnailer_is_exported		(RpThumbnailer *thumbnailer);
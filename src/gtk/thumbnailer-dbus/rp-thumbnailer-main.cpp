@@ -152,6 +152,18 @@ int main(int argc, char *argv[])
 		return EXIT_FAILURE;
 	}
 
+	// Check for the optional raw thumbnail function.
+	// Used for the shared-memory result path; may be missing
+	// in older libraries.
+	PFN_RP_CREATE_THUMBNAIL_RAW pfn_rp_create_thumbnail_raw =
+		(PFN_RP_CREATE_THUMBNAIL_RAW)dlsym(pDll, "rp_create_thumbnail_raw");
+
+	// Check for the optional MIME-routed thumbnail function.
+	// Dispatches directly to the candidate parsers for the MIME
+	// type supplied by Tumbler; may be missing in older libraries.
+	PFN_RP_CREATE_THUMBNAIL2 pfn_rp_create_thumbnail2 =
+		(PFN_RP_CREATE_THUMBNAIL2)dlsym(pDll, "rp_create_thumbnail2");
+
 	GError *error = nullptr;
 	GDBusConnection *const connection = g_bus_get_sync(G_BUS_TYPE_SESSION, nullptr, &error);
 	if (error) {
@@ -165,7 +177,8 @@ int main(int argc, char *argv[])
 
 	// Create the RpThumbnail service object.
 	RpThumbnailer *const thumbnailer = rp_thumbnailer_new(
-		connection, cache_dir.c_str(), pfn_rp_create_thumbnail);
+		connection, cache_dir.c_str(), pfn_rp_create_thumbnail,
+		pfn_rp_create_thumbnail_raw, pfn_rp_create_thumbnail2);
 
 	// Register the D-Bus service.
 	g_bus_own_name_on_connection(connection,
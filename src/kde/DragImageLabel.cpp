@@ -9,19 +9,23 @@
 // Reference: https://doc.qt.io/qt-5/dnd.html
 #include "stdafx.h"
 #include "DragImageLabel.hpp"
-#include "RpQByteArrayFile.hpp"
+#include "DragImagePngWorker.hpp"
 
 // librpbase, librptexture
 #include "librpbase/img/IconAnimData.hpp"
 #include "librpbase/img/IconAnimHelper.hpp"
 using LibRpBase::IconAnimData;
 using LibRpBase::IconAnimHelper;
-using LibRpBase::RpPngWriter;
 using LibRpTexture::rp_image;
 
+// Qt includes.
+#include <QtCore/QThreadPool>
+
 DragImageLabel::DragImageLabel(const QString &text, QWidget *parent, Qt::WindowFlags f)
 	: super(text, parent, f)
 	, m_minimumImageSize(DIL_MIN_IMAGE_SIZE, DIL_MIN_IMAGE_SIZE)
+	, m_pngToken(0)
+	, m_pngWorkerScheduled(false)
 	, m_img(nullptr)
 	, m_anim(nullptr)
 { }
@@ -29,6 +33,8 @@ DragImageLabel::DragImageLabel(const QString &text, QWidget *parent, Qt::WindowF
 DragImageLabel::DragImageLabel(QWidget *parent, Qt::WindowFlags f)
 	: super(parent, f)
 	, m_minimumImageSize(DIL_MIN_IMAGE_SIZE, DIL_MIN_IMAGE_SIZE)
+	, m_pngToken(0)
+	, m_pngWorkerScheduled(false)
 	, m_img(nullptr)
 	, m_anim(nullptr)
 { }
@@ -36,14 +42,15 @@ DragImageLabel::DragImageLabel(QWidget *parent, Qt::WindowFlags f)
 DragImageLabel::~DragImageLabel()
 {
 	delete m_anim;
+	delete m_img;
 }
 
 /**
  * Set the rp_image for this label.
  *
- * NOTE: The rp_image pointer is stored and used if necessary.
- * Make sure to call this function with nullptr before deleting
- * the rp_image object.
+ * NOTE: The label dup()s the image, which shares the pixel
+ * data copy-on-write, so the caller's rp_image (and the
+ * RomData object that owns it) can be deleted afterwards.
  *
  * NOTE 2: If animated icon data is specified, that supercedes
  * the individual rp_image.
@@ -53,8 +60,10 @@ DragImageLabel::~DragImageLabel()
  */
 bool DragImageLabel::setRpImage(const rp_image *img)
 {
+	delete m_img;
 	if (!img) {
 		m_img = nullptr;
+		schedulePngCache();
 		if (!m_anim || !m_anim->iconAnimData) {
 			this->clear();
 		} else {
@@ -63,10 +72,11 @@ bool DragImageLabel::setRpImage(const rp_image *img)
 		return false;
 	}
 
-	// Don't check if the image pointer matches the
-	// previously stored image, since the underlying
-	// image may have changed.
-	m_img = img;
+	// Take our own handle on the image.
+	// NOTE: dup() is cheap; the pixel data is shared
+	// copy-on-write.
+	m_img = img->dup();
+	schedulePngCache();
 	return updatePixmaps();
 }
 
@@ -95,6 +105,7 @@ bool DragImageLabel::setIconAnimData(const IconAnimData *iconAnimData)
 		}
 		m_anim->iconAnimData = nullptr;
 		m_anim->anim_running = false;
+		schedulePngCache();
 
 		if (!m_img) {
 			this->clear();
@@ -108,6 +119,7 @@ bool DragImageLabel::setIconAnimData(const IconAnimData *iconAnimData)
 	// previously stored data, since the underlying
 	// data may have changed.
 	m_anim->iconAnimData = iconAnimData;
+	schedulePngCache();
 	return updatePixmaps();
 }
 
@@ -125,10 +137,80 @@ void DragImageLabel::clearRp(void)
 		m_anim->anim_running = false;
 	}
 
+	delete m_img;
 	m_img = nullptr;
+	schedulePngCache();
 	this->clear();
 }
 
+/**
+ * Invalidate the cached PNG data and schedule a
+ * background re-encode of the current image.
+ */
+void DragImageLabel::schedulePngCache(void)
+{
+	// Invalidate the cached PNG data.
+	// Results from in-flight workers will be discarded,
+	// since they were started with an older token.
+	m_pngData.clear();
+	m_pngToken++;
+
+	if (m_pngWorkerScheduled) {
+		// A worker is already scheduled.
+		// It will pick up the current image when it starts.
+		return;
+	}
+
+	// Defer the encode to the next event loop iteration so
+	// multiple image updates only result in one encode.
+	m_pngWorkerScheduled = true;
+	QTimer::singleShot(0, this, SLOT(startPngWorker()));
+}
+
+/**
+ * Start the background PNG encoder.
+ * Deferred via a single-shot timer so multiple image
+ * updates in one event loop iteration only encode once.
+ */
+void DragImageLabel::startPngWorker(void)
+{
+	m_pngWorkerScheduled = false;
+
+	const bool isAnimated = (m_anim && m_anim->iconAnimData && m_anim->iconAnimHelper.isAnimated());
+
+	DragImagePngWorker *worker;
+	if (isAnimated) {
+		// Animated icon.
+		worker = new DragImagePngWorker(m_anim->iconAnimData, m_pngToken);
+	} else if (m_img) {
+		// Standard icon.
+		worker = new DragImagePngWorker(m_img, m_pngToken);
+	} else {
+		// No icon. Nothing to encode.
+		return;
+	}
+
+	QObject::connect(worker, SIGNAL(pngDataReady(quint64,QByteArray)),
+			 this, SLOT(pngDataReady(quint64,QByteArray)),
+			 Qt::QueuedConnection);
+	QThreadPool::globalInstance()->start(worker);
+}
+
+/**
+ * The background PNG encoder has finished.
+ * @param token Cache token.
+ * @param pngData PNG data.
+ */
+void DragImageLabel::pngDataReady(quint64 token, const QByteArray &pngData)
+{
+	if (token != m_pngToken) {
+		// The image changed while the worker was running.
+		return;
+	}
+
+	m_pngData = pngData;
+}
+
 /**
  * Convert a QImage to QPixmap.
  * Automatically resizes the QImage if it's smaller
@@ -180,8 +262,6 @@ bool DragImageLabel::updatePixmaps(void)
 		// Set up the IconAnimHelper.
 		m_anim->iconAnimHelper.setIconAnimData(iconAnimData);
 		if (m_anim->iconAnimHelper.isAnimated()) {
-			// Initialize the animation.
-			m_anim->last_frame_number = m_anim->iconAnimHelper.frameNumber();
 			// Create the animation timer.
 			if (!m_anim->tmrIconAnim) {
 				m_anim->tmrIconAnim = new QTimer(this);
@@ -229,7 +309,6 @@ void DragImageLabel::startAnimTimer(void)
 	assert(m_anim->tmrIconAnim != nullptr);
 
 	// Get the current frame information.
-	m_anim->last_frame_number = m_anim->iconAnimHelper.frameNumber();
 	const int delay = m_anim->iconAnimHelper.frameDelay();
 	assert(delay > 0);
 	if (delay <= 0) {
@@ -266,17 +345,16 @@ void DragImageLabel::tmrIconAnim_timeout(void)
 
 	// Next frame.
 	int delay = 0;
-	int frame = m_anim->iconAnimHelper.nextFrame(&delay);
-	if (delay <= 0 || frame < 0) {
-		// Invalid frame...
+	const int frame = m_anim->iconAnimHelper.tick(&delay);
+	if (delay <= 0) {
+		// Invalid delay value.
 		return;
 	}
 
-	if (frame != m_anim->last_frame_number) {
+	if (frame >= 0) {
 		// New frame number.
 		// Update the icon.
 		this->setPixmap(m_anim->iconFrames[frame]);
-		m_anim->last_frame_number = frame;
 	}
 
 	// Set the single-shot timer.
@@ -302,54 +380,29 @@ void DragImageLabel::mouseMoveEvent(QMouseEvent *event)
 	if ((event->pos() - m_dragStartPos).manhattanLength() < QApplication::startDragDistance())
 		return;
 
-	const bool isAnimated = (m_anim && m_anim->iconAnimData && m_anim->iconAnimHelper.isAnimated());
-
-	RpQByteArrayFile *const pngData = new RpQByteArrayFile();
-	RpPngWriter *pngWriter;
-	if (isAnimated) {
-		// Animated icon.
-		pngWriter = new RpPngWriter(pngData, m_anim->iconAnimData);
-	} else if (m_img) {
-		// Standard icon.
+	// Use the pre-encoded PNG data if it's available.
+	QByteArray pngData = m_pngData;
+	if (pngData.isEmpty()) {
+		// PNG data hasn't been cached yet. Encode it now.
 		// NOTE: Using the source image because we want the original
 		// size, not the resized version.
-		pngWriter = new RpPngWriter(pngData, m_img);
-	} else {
-		// No icon...
-		pngData->unref();
-		return;
-	}
-
-	if (!pngWriter->isOpen()) {
-		// Unable to open the PNG writer.
-		delete pngWriter;
-		pngData->unref();
-		return;
-	}
-
-	// TODO: Add text fields indicating the source game.
+		const bool isAnimated = (m_anim && m_anim->iconAnimData && m_anim->iconAnimHelper.isAnimated());
+		if (isAnimated) {
+			// Animated icon.
+			pngData = rpToPngData(m_anim->iconAnimData);
+		} else if (m_img) {
+			// Standard icon.
+			pngData = rpToPngData(m_img);
+		}
 
-	int pwRet = pngWriter->write_IHDR();
-	if (pwRet != 0) {
-		// Error writing the PNG image...
-		delete pngWriter;
-		pngData->unref();
-		return;
-	}
-	pwRet = pngWriter->write_IDAT();
-	if (pwRet != 0) {
-		// Error writing the PNG image...
-		delete pngWriter;
-		pngData->unref();
-		return;
+		if (pngData.isEmpty()) {
+			// No icon, or unable to encode the PNG image...
+			return;
+		}
 	}
 
-	// RpPngWriter will finalize the PNG on delete.
-	delete pngWriter;
-
 	QMimeData *const mimeData = new QMimeData;
-	QByteArray ba = pngData->qByteArray();
-	mimeData->setData(QLatin1String("image/png"), pngData->qByteArray());
+	mimeData->setData(QLatin1String("image/png"), pngData);
 
 	QDrag *const drag = new QDrag(this);
 	drag->setMimeData(mimeData);
@@ -369,5 +422,4 @@ void DragImageLabel::mouseMoveEvent(QMouseEvent *event)
 	}
 
 	drag->exec(Qt::CopyAction);
-	pngData->unref();
 }
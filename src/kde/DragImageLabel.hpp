@@ -23,6 +23,7 @@ namespace LibRpTexture {
 #include <array>
 
 // Qt includes.
+#include <QtCore/QByteArray>
 #include <QtCore/QTimer>
 #include <QLabel>
 
@@ -61,9 +62,9 @@ class DragImageLabel : public QLabel
 		/**
 		 * Set the rp_image for this label.
 		 *
-		 * NOTE: The rp_image pointer is stored and used if necessary.
-		 * Make sure to call this function with nullptr before deleting
-		 * the rp_image object.
+		 * NOTE: The label dup()s the image, which shares the pixel
+		 * data copy-on-write, so the caller's rp_image (and the
+		 * RomData object that owns it) can be deleted afterwards.
 		 *
 		 * NOTE 2: If animated icon data is specified, that supercedes
 		 * the individual rp_image.
@@ -137,16 +138,37 @@ class DragImageLabel : public QLabel
 		void resetAnimFrame(void)
 		{
 			if (m_anim) {
-				m_anim->last_frame_number = 0;
+				m_anim->iconAnimHelper.resetDisplayedFrame();
 			}
 		}
 
+	private:
+		/**
+		 * Invalidate the cached PNG data and schedule a
+		 * background re-encode of the current image.
+		 */
+		void schedulePngCache(void);
+
 	protected slots:
 		/**
 		 * Animated icon timer.
 		 */
 		void tmrIconAnim_timeout(void);
 
+		/**
+		 * Start the background PNG encoder.
+		 * Deferred via a single-shot timer so multiple image
+		 * updates in one event loop iteration only encode once.
+		 */
+		void startPngWorker(void);
+
+		/**
+		 * The background PNG encoder has finished.
+		 * @param token Cache token.
+		 * @param pngData PNG data.
+		 */
+		void pngDataReady(quint64 token, const QByteArray &pngData);
+
 	protected:
 		/** Overridden QWidget functions **/
 		void mousePressEvent(QMouseEvent *event) override;
@@ -156,8 +178,15 @@ class DragImageLabel : public QLabel
 		QSize m_minimumImageSize;
 		QPoint m_dragStartPos;
 
+		// Pre-encoded PNG data for drag & drop.
+		// Encoded on a thread pool thread when the image changes,
+		// so starting a drag doesn't have to encode anything.
+		QByteArray m_pngData;
+		quint64 m_pngToken;		// Token for the pending encode.
+		bool m_pngWorkerScheduled;	// True if startPngWorker() is queued.
+
 		// rp_image. (NOTE: Not owned by this object.)
-		const LibRpTexture::rp_image *m_img;
+		LibRpTexture::rp_image *m_img;	// owned dup(); pixels shared COW
 
 		// Animated icon data.
 		struct anim_vars {
@@ -165,13 +194,11 @@ class DragImageLabel : public QLabel
 			QTimer *tmrIconAnim;
 			std::array<QPixmap, LibRpBase::IconAnimData::MAX_FRAMES> iconFrames;
 			LibRpBase::IconAnimHelper iconAnimHelper;
-			int last_frame_number;		// Last frame number.
 			bool anim_running;		// Animation is running.
 
 			anim_vars()
 				: iconAnimData(nullptr)
 				, tmrIconAnim(nullptr)
-				, last_frame_number(0)
 				, anim_running(false) { }
 			~anim_vars() { delete tmrIconAnim; }
 		};
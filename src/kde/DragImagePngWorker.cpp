@@ -0,0 +1,100 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (KDE4/KF5)                         *
+ * DragImagePngWorker.cpp: Background PNG encoder for drag images.         *
+ *                                                                         *
+ * Copyright (c) 2019-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "DragImagePngWorker.hpp"
+#include "RpQt.hpp"
+
+// librpbase, librptexture
+#include "librpbase/img/IconAnimData.hpp"
+#include "librptexture/img/rp_image.hpp"
+using LibRpBase::IconAnimData;
+using LibRpTexture::rp_image;
+
+/**
+ * Encode a single image.
+ * @param img rp_image. (copied)
+ * @param token Token to identify the result.
+ */
+DragImagePngWorker::DragImagePngWorker(const rp_image *img, quint64 token)
+	: super()
+	, m_img(nullptr)
+	, m_iconAnimData(nullptr)
+	, m_token(token)
+{
+	if (img) {
+		// NOTE: dup() is cheap due to copy-on-write pixel storage.
+		m_img = img->dup();
+	}
+
+	// The thread pool's auto-delete would delete this QObject on
+	// the worker thread. Use deleteLater() in run() instead.
+	setAutoDelete(false);
+}
+
+/**
+ * Encode an animated icon.
+ * @param iconAnimData IconAnimData. (copied)
+ * @param token Token to identify the result.
+ */
+DragImagePngWorker::DragImagePngWorker(const IconAnimData *iconAnimData, quint64 token)
+	: super()
+	, m_img(nullptr)
+	, m_iconAnimData(nullptr)
+	, m_token(token)
+{
+	if (iconAnimData) {
+		// Copy the IconAnimData, duplicating the frames.
+		IconAnimData *const animData = new IconAnimData();
+		animData->count = iconAnimData->count;
+		animData->seq_count = iconAnimData->seq_count;
+		animData->seq_index = iconAnimData->seq_index;
+		animData->delays = iconAnimData->delays;
+		for (int i = 0; i < iconAnimData->count; i++) {
+			const rp_image *const frame = iconAnimData->frames[i];
+			if (frame) {
+				animData->frames[i] = frame->dup();
+			}
+		}
+		m_iconAnimData = animData;
+	}
+
+	// The thread pool's auto-delete would delete this QObject on
+	// the worker thread. Use deleteLater() in run() instead.
+	setAutoDelete(false);
+}
+
+DragImagePngWorker::~DragImagePngWorker()
+{
+	delete m_img;
+	if (m_iconAnimData) {
+		for (int i = 0; i < m_iconAnimData->count; i++) {
+			delete const_cast<rp_image*>(m_iconAnimData->frames[i]);
+		}
+		delete m_iconAnimData;
+	}
+}
+
+/**
+ * Encode the PNG data and emit pngDataReady().
+ * Called by the thread pool.
+ */
+void DragImagePngWorker::run(void)
+{
+	QByteArray pngData;
+	if (m_iconAnimData) {
+		pngData = rpToPngData(m_iconAnimData);
+	} else if (m_img) {
+		pngData = rpToPngData(m_img);
+	}
+
+	emit pngDataReady(m_token, pngData);
+
+	// Schedule deletion on the GUI thread.
+	deleteLater();
+}
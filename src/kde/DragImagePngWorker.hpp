@@ -0,0 +1,82 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (KDE4/KF5)                         *
+ * DragImagePngWorker.hpp: Background PNG encoder for drag images.         *
+ *                                                                         *
+ * Copyright (c) 2019-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_KDE_DRAGIMAGEPNGWORKER_HPP__
+#define __ROMPROPERTIES_KDE_DRAGIMAGEPNGWORKER_HPP__
+
+namespace LibRpBase {
+	struct IconAnimData;
+}
+namespace LibRpTexture {
+	class rp_image;
+}
+
+// Qt includes.
+#include <QtCore/QByteArray>
+#include <QtCore/QObject>
+#include <QtCore/QRunnable>
+
+/**
+ * Encodes a drag image to PNG on a thread pool thread, so
+ * starting a drag only has to hand over a prebuilt buffer.
+ *
+ * The source image is copied in the constructor (cheap due to
+ * copy-on-write pixel storage), so the caller's rp_image and/or
+ * IconAnimData can be deleted while the worker is running.
+ *
+ * The result is delivered via the pngDataReady() signal.
+ * Connect it using Qt::QueuedConnection; the worker deletes
+ * itself after emitting the signal.
+ */
+class DragImagePngWorker : public QObject, public QRunnable
+{
+	Q_OBJECT
+
+	public:
+		/**
+		 * Encode a single image.
+		 * @param img rp_image. (copied)
+		 * @param token Token to identify the result.
+		 */
+		explicit DragImagePngWorker(const LibRpTexture::rp_image *img, quint64 token);
+
+		/**
+		 * Encode an animated icon.
+		 * @param iconAnimData IconAnimData. (copied)
+		 * @param token Token to identify the result.
+		 */
+		explicit DragImagePngWorker(const LibRpBase::IconAnimData *iconAnimData, quint64 token);
+
+		virtual ~DragImagePngWorker();
+
+	private:
+		typedef QObject super;
+		Q_DISABLE_COPY(DragImagePngWorker)
+
+	public:
+		/**
+		 * Encode the PNG data and emit pngDataReady().
+		 * Called by the thread pool.
+		 */
+		void run(void) final;
+
+	signals:
+		/**
+		 * The PNG data has been encoded.
+		 * @param token Token specified in the constructor.
+		 * @param pngData PNG data. (May be empty on error.)
+		 */
+		void pngDataReady(quint64 token, const QByteArray &pngData);
+
+	private:
+		LibRpTexture::rp_image *m_img;
+		LibRpBase::IconAnimData *m_iconAnimData;
+		quint64 m_token;
+};
+
+#endif /* __ROMPROPERTIES_KDE_DRAGIMAGEPNGWORKER_HPP__ */
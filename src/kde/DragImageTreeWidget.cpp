@@ -11,12 +11,55 @@
 // - https://wiki.qt.io/QList_Drag_and_Drop_Example
 #include "stdafx.h"
 #include "DragImageTreeWidget.hpp"
-#include "RpQByteArrayFile.hpp"
+#include "DragImagePngWorker.hpp"
 
-// librpbase, librptexture
-using LibRpBase::RpPngWriter;
+// librptexture
 using LibRpTexture::rp_image;
 
+// Qt includes.
+#include <QtCore/QThreadPool>
+
+/**
+ * Schedule background PNG encoding for an item's icon.
+ * The encoded PNG data is stored in PngDataRole when
+ * it's ready, so startDrag() only has to hand over a
+ * prebuilt buffer.
+ *
+ * Call this after setting the item's RpImageRole data.
+ *
+ * @param item Tree widget item.
+ */
+void DragImageTreeWidget::schedulePngCache(QTreeWidgetItem *item)
+{
+	const rp_image *const img = static_cast<const rp_image*>(item->data(0, RpImageRole).value<void*>());
+	if (!img) {
+		// No image. Nothing to encode.
+		return;
+	}
+
+	const quint64 token = ++m_pngToken;
+	m_pngItems.insert(token, item);
+
+	DragImagePngWorker *const worker = new DragImagePngWorker(img, token);
+	QObject::connect(worker, SIGNAL(pngDataReady(quint64,QByteArray)),
+			 this, SLOT(pngDataReady(quint64,QByteArray)),
+			 Qt::QueuedConnection);
+	QThreadPool::globalInstance()->start(worker);
+}
+
+/**
+ * The background PNG encoder has finished.
+ * @param token Cache token.
+ * @param pngData PNG data.
+ */
+void DragImageTreeWidget::pngDataReady(quint64 token, const QByteArray &pngData)
+{
+	QTreeWidgetItem *const item = m_pngItems.take(token);
+	if (item && !pngData.isEmpty()) {
+		item->setData(0, PngDataRole, pngData);
+	}
+}
+
 void DragImageTreeWidget::startDrag(Qt::DropActions supportedActions)
 {
 	// TODO: Handle supportedActions?
@@ -45,40 +88,19 @@ void DragImageTreeWidget::startDrag(Qt::DropActions supportedActions)
 		if (!img)
 			continue;
 
-		// Convert the rp_image to PNG.
-		RpQByteArrayFile *const pngData = new RpQByteArrayFile();
-		RpPngWriter *const pngWriter = new RpPngWriter(pngData, img);
-		if (!pngWriter->isOpen()) {
-			// Unable to open the PNG writer.
-			delete pngWriter;
-			pngData->unref();
-			continue;
+		// Use the pre-encoded PNG data if it's available.
+		QByteArray pngData = item->data(0, PngDataRole).toByteArray();
+		if (pngData.isEmpty()) {
+			// PNG data hasn't been cached yet. Encode it now.
+			pngData = rpToPngData(img);
+			if (pngData.isEmpty()) {
+				// Unable to encode the PNG image...
+				continue;
+			}
 		}
 
-		// TODO: Add text fields indicating the source game.
-
-		int pwRet = pngWriter->write_IHDR();
-		if (pwRet != 0) {
-			// Error writing the PNG image...
-			delete pngWriter;
-			pngData->unref();
-			continue;
-		}
-		pwRet = pngWriter->write_IDAT();
-		if (pwRet != 0) {
-			// Error writing the PNG image...
-			delete pngWriter;
-			pngData->unref();
-			continue;
-		}
-
-		// RpPngWriter will finalize the PNG on delete.
-		delete pngWriter;
-
 		// Set the PNG data.
-		QByteArray ba = pngData->qByteArray();
-		mimeData->setData(QLatin1String("image/png"), pngData->qByteArray());
-		pngData->unref();
+		mimeData->setData(QLatin1String("image/png"), pngData);
 
 		// Save the icon.
 		if (!dragIcon.isNull()) {
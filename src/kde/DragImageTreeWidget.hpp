@@ -13,6 +13,7 @@
 #ifndef __ROMPROPERTIES_KDE_DRAGIMAGETREEWIDGET_HPP__
 #define __ROMPROPERTIES_KDE_DRAGIMAGETREEWIDGET_HPP__
 
+#include <QtCore/QHash>
 #include <QTreeWidget>
 
 class DragImageTreeWidget : public QTreeWidget
@@ -21,11 +22,36 @@ class DragImageTreeWidget : public QTreeWidget
 
 	public:
 		explicit DragImageTreeWidget(QWidget *parent = nullptr)
-			: super(parent) { }
+			: super(parent)
+			, m_pngToken(0) { }
 
 		// Role for an rp_image*.
 		static const int RpImageRole = Qt::UserRole + 0x4049;
 
+		// Role for pre-encoded PNG data. (QByteArray)
+		static const int PngDataRole = Qt::UserRole + 0x404A;
+
+	public:
+		/**
+		 * Schedule background PNG encoding for an item's icon.
+		 * The encoded PNG data is stored in PngDataRole when
+		 * it's ready, so startDrag() only has to hand over a
+		 * prebuilt buffer.
+		 *
+		 * Call this after setting the item's RpImageRole data.
+		 *
+		 * @param item Tree widget item.
+		 */
+		void schedulePngCache(QTreeWidgetItem *item);
+
+	protected slots:
+		/**
+		 * The background PNG encoder has finished.
+		 * @param token Cache token.
+		 * @param pngData PNG data.
+		 */
+		void pngDataReady(quint64 token, const QByteArray &pngData);
+
 	private:
 		typedef QTreeWidget super;
 		Q_DISABLE_COPY(DragImageTreeWidget)
@@ -33,6 +59,14 @@ class DragImageTreeWidget : public QTreeWidget
 	protected:
 		/** Overridden QWidget functions **/
 		void startDrag(Qt::DropActions supportedActions) override;
+
+	private:
+		// Items with pending PNG encodes, keyed by cache token.
+		// NOTE: Items are created when the widget is populated and
+		// are only deleted together with the widget, so the item
+		// pointers stay valid for the widget's lifetime.
+		QHash<quint64, QTreeWidgetItem*> m_pngItems;
+		quint64 m_pngToken;
 };
 
 #endif /* __ROMPROPERTIES_KDE_DRAGIMAGETREEWIDGET_HPP__ */
@@ -26,6 +26,9 @@ using std::vector;
 // Custom Qt widgets.
 #include "DragImageTreeWidget.hpp"
 
+// QThread for background RomData loading.
+#include <QtCore/QThread>
+
 // KAcceleratorManager
 #if QT_VERSION >= QT_VERSION_CHECK(5,0,0)
 # include <KAcceleratorManager>
@@ -34,6 +37,52 @@ using std::vector;
 #endif /* QT_VERSION >= QT_VERSION_CHECK(5,0,0) */
 
 #include "ui_RomDataView.h"
+
+/**
+ * Background loader for RomData fields and images.
+ *
+ * Field parsing and image decoding can be slow, e.g. for disc
+ * images, which would block the properties dialog if done on the
+ * GUI thread. The results are cached in the RomData object, so
+ * initDisplayWidgets() gets cache hits once this thread finishes.
+ *
+ * NOTE: Not using Q_OBJECT here, since moc isn't run on this file.
+ * QThread's finished() signal is sufficient for completion handling.
+ */
+class RomDataLoaderThread : public QThread
+{
+	public:
+		RomDataLoaderThread(RomData *romData, QObject *parent = nullptr)
+			: QThread(parent)
+			, m_romData(romData->ref())
+		{ }
+
+		virtual ~RomDataLoaderThread()
+		{
+			m_romData->unref();
+		}
+
+	private:
+		Q_DISABLE_COPY(RomDataLoaderThread)
+		RomData *const m_romData;
+
+	protected:
+		void run(void) final
+		{
+			// Parse the fields.
+			m_romData->fields();
+
+			// Decode the internal banner and icon, if present.
+			const uint32_t imgbf = m_romData->supportedImageTypes();
+			if (imgbf & RomData::IMGBF_INT_BANNER) {
+				m_romData->image(RomData::IMG_INT_BANNER);
+			}
+			if (imgbf & RomData::IMGBF_INT_ICON) {
+				m_romData->image(RomData::IMG_INT_ICON);
+			}
+		}
+};
+
 class RomDataViewPrivate
 {
 	public:
@@ -74,6 +123,22 @@ class RomDataViewPrivate
 		// RomData object.
 		RomData *romData;
 
+		// Background loader thread.
+		// Fields are parsed and images are decoded on this
+		// thread; the display widgets are created once it
+		// finishes, so the dialog shows up immediately.
+		QThread *loaderThread;
+
+		/**
+		 * Start the background loader thread for the current
+		 * RomData object. The display widgets are created from
+		 * loaderThread_finished_slot() once the data is ready.
+		 *
+		 * If no RomData object is set, the display widgets are
+		 * cleared immediately.
+		 */
+		void startLoaderThread(void);
+
 		/**
 		 * Initialize the header row widgets.
 		 * The widgets must have already been created by ui.setupUi().
@@ -175,6 +240,7 @@ RomDataViewPrivate::RomDataViewPrivate(RomDataView *q, RomData *romData)
 	, def_lc(0)
 	, cboLanguage(nullptr)
 	, romData(romData->ref())
+	, loaderThread(nullptr)
 {
 	// Register RpQImageBackend.
 	// TODO: Static initializer somewhere?
@@ -183,6 +249,13 @@ RomDataViewPrivate::RomDataViewPrivate(RomDataView *q, RomData *romData)
 
 RomDataViewPrivate::~RomDataViewPrivate()
 {
+	// Wait for the loader thread to finish.
+	// (It holds its own reference to the RomData object.)
+	if (loaderThread) {
+		loaderThread->wait();
+		delete loaderThread;
+	}
+
 	ui.lblIcon->clearRp();
 	ui.lblBanner->clearRp();
 	if (romData) {
@@ -312,8 +385,8 @@ QLabel *RomDataViewPrivate::initString(QLabel *lblDesc, const RomFields::Field &
 		QString text;
 		if (str) {
 			text = *str;
-		} else if (field.data.str) {
-			text = U82Q(*(field.data.str));
+		} else {
+			text = U82Q(field.str());
 		}
 		text.replace(QChar(L'\n'), QLatin1String("<br/>"));
 		lblString->setText(text);
@@ -325,8 +398,8 @@ QLabel *RomDataViewPrivate::initString(QLabel *lblDesc, const RomFields::Field &
 		lblString->setTextFormat(Qt::PlainText);
 		if (str) {
 			lblString->setText(*str);
-		} else if (field.data.str) {
-			lblString->setText(U82Q(*(field.data.str)));
+		} else {
+			lblString->setText(U82Q(field.str()));
 		}
 	}
 
@@ -608,6 +681,9 @@ void RomDataViewPrivate::initListData(QLabel *lblDesc, const RomFields::Field &f
 					QPixmap::fromImage(rpToQImage(icon))));
 				treeWidgetItem->setData(0, DragImageTreeWidget::RpImageRole,
 					QVariant::fromValue((void*)icon));
+				// Pre-encode the PNG data for drag & drop in the background.
+				// NOTE: hasIcons means treeWidget is a DragImageTreeWidget.
+				static_cast<DragImageTreeWidget*>(treeWidget)->schedulePngCache(treeWidgetItem);
 			}
 		}
 
@@ -1013,6 +1089,48 @@ void RomDataViewPrivate::updateMulti(uint32_t user_lc)
 	}
 }
 
+/**
+ * Start the background loader thread for the current
+ * RomData object. The display widgets are created from
+ * loaderThread_finished_slot() once the data is ready.
+ *
+ * If no RomData object is set, the display widgets are
+ * cleared immediately.
+ */
+void RomDataViewPrivate::startLoaderThread(void)
+{
+	Q_Q(RomDataView);
+
+	// If a loader thread is still running for a previous RomData
+	// object, detach it. It will delete itself when it finishes.
+	if (loaderThread) {
+		QObject::disconnect(loaderThread, SIGNAL(finished()),
+			q, SLOT(loaderThread_finished_slot()));
+		QObject::connect(loaderThread, SIGNAL(finished()),
+			loaderThread, SLOT(deleteLater()));
+		loaderThread = nullptr;
+	}
+
+	if (!romData) {
+		// No ROM data. Clear the display widgets.
+		initDisplayWidgets();
+		return;
+	}
+
+	// Parse the fields and decode the images on a worker thread.
+	// This lets the properties dialog show up immediately instead
+	// of blocking while e.g. disc images are scanned.
+	// NOTE: Intentionally unparented. A detached thread is owned
+	// solely by its deleteLater() connection; if it were a child
+	// of the view, the view's destruction could delete it while
+	// it's still running. The current thread is deleted by
+	// loaderThread_finished_slot() or the d_ptr destructor.
+	loaderThread = new RomDataLoaderThread(romData);
+	QObject::connect(loaderThread, SIGNAL(finished()),
+		q, SLOT(loaderThread_finished_slot()));
+	loaderThread->start();
+}
+
 /**
  * Initialize the display widgets.
  * If the widgets already exist, they will
@@ -1214,8 +1332,9 @@ RomDataView::RomDataView(RomData *romData, QWidget *parent)
 	Q_D(RomDataView);
 	d->ui.setupUi(this);
 
-	// Initialize the display widgets.
-	d->initDisplayWidgets();
+	// Load the fields and images on a background thread.
+	// The display widgets are created once the data is ready.
+	d->startLoaderThread();
 }
 
 RomDataView::~RomDataView()
@@ -1359,6 +1478,32 @@ void RomDataView::cboLanguage_currentIndexChanged_slot(int index)
 	d->updateMulti(lc);
 }
 
+/**
+ * The background RomData loader thread has finished.
+ * Creates the display widgets using the loaded data.
+ */
+void RomDataView::loaderThread_finished_slot(void)
+{
+	Q_D(RomDataView);
+	if (QObject::sender() != d->loaderThread) {
+		// Signal from a stale loader thread.
+		// A newer RomData object has been set; ignore it.
+		return;
+	}
+	d->loaderThread->deleteLater();
+	d->loaderThread = nullptr;
+
+	// Create the display widgets.
+	// The fields and images were cached by the loader thread,
+	// so this should be fast.
+	d->initDisplayWidgets();
+
+	// Make sure the icon animation is running if this tab is visible.
+	if (isVisible()) {
+		d->ui.lblIcon->startAnimTimer();
+	}
+}
+
 /** Properties. **/
 
 /**
@@ -1395,7 +1540,7 @@ void RomDataView::setRomData(RomData *romData)
 		d->romData->unref();
 	}
 	d->romData = (romData ? romData->ref() : nullptr);
-	d->initDisplayWidgets();
+	d->startLoaderThread();
 
 	if (romData != nullptr && prevAnimTimerRunning) {
 		// Restart the animation timer.
@@ -72,6 +72,12 @@ class RomDataView : public QWidget
 		 */
 		void cboLanguage_currentIndexChanged_slot(int index);
 
+		/**
+		 * The background RomData loader thread has finished.
+		 * Creates the display widgets using the loaded data.
+		 */
+		void loaderThread_finished_slot(void);
+
 	public:
 		/** Properties. **/
 
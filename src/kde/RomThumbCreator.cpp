@@ -84,6 +84,18 @@ class RomThumbCreatorPrivate : public TCreateThumbnail<QImage>
 			return rpToQImage(img);
 		}
 
+		/**
+		 * Wrapper function to convert rp_image* to ImgClass,
+		 * transferring ownership of the image.
+		 * @param img rp_image (takes ownership)
+		 * @return ImgClass
+		 */
+		inline QImage rpImageToImgClassMove(rp_image *img) const final
+		{
+			// The QImage adopts the rp_image's pixel buffer.
+			return rpMoveToQImage(img);
+		}
+
 		/**
 		 * Wrapper function to check if an ImgClass is valid.
 		 * @param imgClass ImgClass
@@ -227,14 +239,21 @@ ThumbCreator::Flags RomThumbCreator::flags(void) const
 /** CreateThumbnail **/
 
 /**
- * Thumbnail creator function for wrapper programs.
+ * Thumbnail creator function for wrapper programs. (MIME-routed)
+ *
+ * Same as rp_create_thumbnail(), but with the MIME type of the
+ * source file, as supplied by the thumbnailing framework (e.g.
+ * Tumbler). The MIME type selects the candidate parsers via a
+ * hash lookup, skipping extension guessing entirely.
+ *
  * @param source_file Source file. (UTF-8)
  * @param output_file Output file. (UTF-8)
  * @param maximum_size Maximum size.
+ * @param mime_type MIME type of the source file, or nullptr if unknown.
  * @return 0 on success; non-zero on error.
  */
 extern "C"
-Q_DECL_EXPORT int rp_create_thumbnail(const char *source_file, const char *output_file, int maximum_size)
+Q_DECL_EXPORT int rp_create_thumbnail2(const char *source_file, const char *output_file, int maximum_size, const char *mime_type)
 {
 	// NOTE: TCreateThumbnail() has wrappers for opening the
 	// ROM file and getting RomData*, but we're doing it here
@@ -259,7 +278,8 @@ Q_DECL_EXPORT int rp_create_thumbnail(const char *source_file, const char *outpu
 
 	// Get the appropriate RomData class for this ROM.
 	// RomData class *must* support at least one image type.
-	RomData *const romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_THUMBNAIL);
+	RomData *const romData = RomDataFactory::create(file, mime_type,
+		RomDataFactory::RDA_HAS_THUMBNAIL | RomDataFactory::RDA_DEFER_FIELDS);
 	file->unref();	// file is ref()'d by RomData.
 	if (!romData) {
 		// ROM is not supported.
@@ -391,8 +411,9 @@ Q_DECL_EXPORT int rp_create_thumbnail(const char *source_file, const char *outpu
 	/** IDAT chunk. **/
 
 	// Initialize the row pointers.
+	// NOTE: Using constBits() to avoid a detach.
 	unique_ptr<const uint8_t*[]> row_pointers(new const uint8_t*[height]);
-	const uint8_t *bits = outParams.retImg.bits();
+	const uint8_t *bits = outParams.retImg.constBits();
 	const int bytesPerLine = outParams.retImg.bytesPerLine();
 	for (int y = 0; y < height; y++, bits += bytesPerLine) {
 		row_pointers[y] = bits;
@@ -410,3 +431,17 @@ Q_DECL_EXPORT int rp_create_thumbnail(const char *source_file, const char *outpu
 	romData->unref();
 	return ret;
 }
+
+/**
+ * Thumbnail creator function for wrapper programs.
+ * @param source_file Source file. (UTF-8)
+ * @param output_file Output file. (UTF-8)
+ * @param maximum_size Maximum size.
+ * @return 0 on success; non-zero on error.
+ */
+extern "C"
+Q_DECL_EXPORT int rp_create_thumbnail(const char *source_file, const char *output_file, int maximum_size)
+{
+	// No MIME type; RomDataFactory runs a full probe.
+	return rp_create_thumbnail2(source_file, output_file, maximum_size, nullptr);
+}
@@ -191,3 +191,35 @@ QImage RpQImageBackend::getQImage(void) const
 
 	return m_qImage;
 }
+
+/**
+ * Take the underlying QImage, transferring ownership
+ * of the pixel buffer to the caller.
+ *
+ * The backend is cleared, so the rp_image must not be
+ * used afterwards. If the backend is shared with another
+ * rp_image, a shared copy is returned instead and the
+ * backend is left intact.
+ *
+ * @return QImage.
+ */
+QImage RpQImageBackend::takeQImage(void)
+{
+	if (this->format == rp_image::FORMAT_CI8) {
+		// Copy the local color table to the QImage.
+		m_qImage.setColorTable(m_qPalette);
+	}
+
+	if (isShared()) {
+		// The backend is shared with another rp_image
+		// (copy-on-write), so the pixel buffer can't be
+		// given up. Return a shared copy instead.
+		return m_qImage;
+	}
+
+	QImage ret;
+	qSwap(ret, m_qImage);
+	m_qPalette.clear();
+	clear_properties();
+	return ret;
+}
@@ -68,6 +68,19 @@ class RpQImageBackend : public LibRpTexture::rp_image_backend
 		 */
 		QImage getQImage(void) const;
 
+		/**
+		 * Take the underlying QImage, transferring ownership
+		 * of the pixel buffer to the caller.
+		 *
+		 * The backend is cleared, so the rp_image must not be
+		 * used afterwards. If the backend is shared with another
+		 * rp_image, a shared copy is returned instead and the
+		 * backend is left intact.
+		 *
+		 * @return QImage.
+		 */
+		QImage takeQImage(void);
+
 	protected:
 		QImage m_qImage;
 		QVector<QRgb> m_qPalette;
@@ -9,9 +9,12 @@
 #include "stdafx.h"
 #include "RpQt.hpp"
 #include "RpQImageBackend.hpp"
+#include "RpQByteArrayFile.hpp"
 
 // librpbase, librpfile, librptexture
 #include "librpbase/config/Config.hpp"
+#include "librpbase/img/IconAnimData.hpp"
+#include "librpbase/img/RpPngWriter.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
 using LibRpTexture::rp_image;
@@ -50,6 +53,110 @@ QImage rpToQImage(const rp_image *image)
 	return backend->getQImage();
 }
 
+/**
+ * Convert an rp_image to QImage, transferring ownership
+ * of the pixel buffer where possible.
+ * The rp_image is deleted.
+ * @param image rp_image. (takes ownership)
+ * @return QImage.
+ */
+QImage rpMoveToQImage(rp_image *image)
+{
+	if (!image)
+		return QImage();
+	if (!image->isValid()) {
+		delete image;
+		return QImage();
+	}
+
+	// We should be using the RpQImageBackend.
+	RpQImageBackend *const backend = dynamic_cast<RpQImageBackend*>(
+		const_cast<LibRpTexture::rp_image_backend*>(image->backend()));
+	assert(backend != nullptr);
+	if (!backend) {
+		// Incorrect backend set.
+		delete image;
+		return QImage();
+	}
+
+	// Take the QImage from the backend.
+	// If the backend is shared with another rp_image,
+	// this returns a shared copy instead.
+	QImage img = backend->takeQImage();
+	delete image;
+	return img;
+}
+
+/**
+ * Finish writing a PNG image and return the PNG data.
+ * @param pngWriter RpPngWriter. (An open writer; deleted by this function.)
+ * @param pngData RpQByteArrayFile. (unref()'d by this function.)
+ * @return PNG data, or empty QByteArray on error.
+ */
+static QByteArray finishPngData(RpPngWriter *pngWriter, RpQByteArrayFile *pngData)
+{
+	// TODO: Add text fields indicating the source game.
+
+	int pwRet = pngWriter->write_IHDR();
+	if (pwRet == 0) {
+		pwRet = pngWriter->write_IDAT();
+	}
+
+	// RpPngWriter will finalize the PNG on delete.
+	delete pngWriter;
+
+	QByteArray ba;
+	if (pwRet == 0) {
+		ba = pngData->qByteArray();
+	}
+	pngData->unref();
+	return ba;
+}
+
+/**
+ * Convert an rp_image to PNG data.
+ * @param image rp_image.
+ * @return PNG data, or empty QByteArray on error.
+ */
+QByteArray rpToPngData(const rp_image *image)
+{
+	if (!image || !image->isValid())
+		return QByteArray();
+
+	RpQByteArrayFile *const pngData = new RpQByteArrayFile();
+	RpPngWriter *const pngWriter = new RpPngWriter(pngData, image);
+	if (!pngWriter->isOpen()) {
+		// Unable to open the PNG writer.
+		delete pngWriter;
+		pngData->unref();
+		return QByteArray();
+	}
+
+	return finishPngData(pngWriter, pngData);
+}
+
+/**
+ * Convert an IconAnimData to APNG data.
+ * @param iconAnimData IconAnimData.
+ * @return APNG data, or empty QByteArray on error.
+ */
+QByteArray rpToPngData(const IconAnimData *iconAnimData)
+{
+	if (!iconAnimData || iconAnimData->count <= 0)
+		return QByteArray();
+
+	RpQByteArrayFile *const pngData = new RpQByteArrayFile();
+	RpPngWriter *const pngWriter = new RpPngWriter(pngData, iconAnimData);
+	if (!pngWriter->isOpen()) {
+		// Unable to open the PNG writer.
+		delete pngWriter;
+		pngData->unref();
+		return QByteArray();
+	}
+
+	return finishPngData(pngWriter, pngData);
+}
+
 /**
  * Localize a QUrl.
  * This function automatically converts certain URL schemes, e.g. desktop:/, to local paths.
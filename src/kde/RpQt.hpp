@@ -9,6 +9,9 @@
 #ifndef __ROMPROPERTIES_KDE_RPQT_HPP__
 #define __ROMPROPERTIES_KDE_RPQT_HPP__
 
+namespace LibRpBase {
+	struct IconAnimData;
+}
 namespace LibRpFile {
 	class IRpFile;
 }
@@ -20,6 +23,7 @@ namespace LibRpTexture {
 #include <string>
 
 // Qt includes.
+#include <QtCore/QByteArray>
 #include <QtCore/QString>
 #include <QtCore/QUrl>
 #include <QtGui/QImage>
@@ -80,6 +84,29 @@ static inline QString U82Q(const char *str, int len = -1)
  */
 QImage rpToQImage(const LibRpTexture::rp_image *image);
 
+/**
+ * Convert an rp_image to QImage, transferring ownership
+ * of the pixel buffer where possible.
+ * The rp_image is deleted.
+ * @param image rp_image. (takes ownership)
+ * @return QImage.
+ */
+QImage rpMoveToQImage(LibRpTexture::rp_image *image);
+
+/**
+ * Convert an rp_image to PNG data.
+ * @param image rp_image.
+ * @return PNG data, or empty QByteArray on error.
+ */
+QByteArray rpToPngData(const LibRpTexture::rp_image *image);
+
+/**
+ * Convert an IconAnimData to APNG data.
+ * @param iconAnimData IconAnimData.
+ * @return APNG data, or empty QByteArray on error.
+ */
+QByteArray rpToPngData(const LibRpBase::IconAnimData *iconAnimData);
+
 /**
  * Localize a QUrl.
  * This function automatically converts certain URL schemes, e.g. desktop:/, to local paths.
@@ -64,17 +64,17 @@ RpExtractorPlugin::RpExtractorPlugin(QObject *parent)
 
 QStringList RpExtractorPlugin::mimetypes(void) const
 {
-	// Get the MIME types from RomDataFactory.
-	const vector<const char*> &vec_mimeTypes = RomDataFactory::supportedMimeTypes();
+	// Use the precomputed capability snapshot so plugin load
+	// doesn't assemble the MIME type list dynamically.
+	size_t len = 0;
+	const char *const *cap_mimeTypes = RomDataFactory::mimeCapabilitySnapshot(&len);
 
 	// Convert to QStringList.
 	QStringList mimeTypes;
-	mimeTypes.reserve(static_cast<int>(vec_mimeTypes.size()));
-	std::for_each(vec_mimeTypes.cbegin(), vec_mimeTypes.cend(),
-		[&mimeTypes](const char *mimeType) {
-			mimeTypes += QString::fromUtf8(mimeType);
-		}
-	);
+	mimeTypes.reserve(static_cast<int>(len));
+	for (size_t i = 0; i < len; i++) {
+		mimeTypes += QString::fromUtf8(cap_mimeTypes[i]);
+	}
 	return mimeTypes;
 }
 
@@ -89,7 +89,9 @@ void RpExtractorPlugin::extract(ExtractionResult *result)
 
 	// Get the appropriate RomData class for this ROM.
 	// file is dup()'d by RomData.
-	RomData *const romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_METADATA);
+	// RDA_METADATA_ONLY: Baloo only needs metaData(), so don't
+	// allow image decoding on this object.
+	RomData *const romData = RomDataFactory::create(file, RomDataFactory::RDA_METADATA_ONLY);
 	file->unref();	// file is ref()'d by RomData.
 	if (!romData) {
 		// ROM is not supported.
@@ -0,0 +1,317 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libcachecommon)                   *
+ * CacheBlobStore.cpp: Content-addressed dedup store for the cache.        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "CacheBlobStore.hpp"
+#include "CacheDir.hpp"
+
+// C includes. (C++ namespace)
+#include <cassert>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdint.h>
+
+// C++ STL classes.
+#include <string>
+using std::string;
+#ifdef _WIN32
+using std::wstring;
+#endif /* _WIN32 */
+
+#ifdef _WIN32
+# include "libwin32common/RpWin32_sdk.h"
+# include "libwin32common/MiniU82T.hpp"
+# include <direct.h>
+# define DIR_SEP_CHR '\\'
+# define DIR_SEP_WCHR L'\\'
+#else /* !_WIN32 */
+# include <sys/stat.h>
+# include <sys/types.h>
+# include <unistd.h>
+# define DIR_SEP_CHR '/'
+#endif /* _WIN32 */
+
+namespace LibCacheCommon {
+
+/** Content-addressed blob store. **/
+
+// Layout: <cachedir>/blobs/<hash>-<size>
+// - <hash>: 64-bit FNV-1a hash of the file contents. (16 hex digits)
+// - <size>: File size, in decimal.
+// Each blob is a hard link target shared by every cache key whose
+// downloaded file has identical contents. The hash isn't
+// collision-proof, so contents are byte-compared before linking.
+//
+// TODO: Garbage-collect blobs whose link count drops back to 1
+// when the cache is cleared or files are rewritten.
+
+// Buffer size for hashing and comparing file contents.
+static const size_t BLOB_BUF_SIZE = 64*1024;
+
+/**
+ * Hash an open file using 64-bit FNV-1a.
+ * @param f	[in] File, positioned at the start.
+ * @param pHash	[out] File contents hash.
+ * @param pSize	[out] File size, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int blobHashFile(FILE *f, uint64_t *pHash, int64_t *pSize)
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+	int64_t size = 0;
+
+	uint8_t buf[BLOB_BUF_SIZE];
+	size_t n;
+	while ((n = fread(buf, 1, sizeof(buf), f)) > 0) {
+		for (size_t i = 0; i < n; i++) {
+			hash ^= buf[i];
+			hash *= 0x00000100000001B3ULL;
+		}
+		size += static_cast<int64_t>(n);
+	}
+	if (ferror(f)) {
+		return -EIO;
+	}
+
+	*pHash = hash;
+	*pSize = size;
+	return 0;
+}
+
+/**
+ * Compare two open files byte-for-byte.
+ * Guards against FNV-1a hash collisions.
+ * @param f1 First file, positioned at the start.
+ * @param f2 Second file, positioned at the start.
+ * @return True if the contents are identical; false if not (or on error).
+ */
+static bool blobFilesEqual(FILE *f1, FILE *f2)
+{
+	uint8_t buf1[BLOB_BUF_SIZE];
+	uint8_t buf2[BLOB_BUF_SIZE];
+
+	while (true) {
+		const size_t n1 = fread(buf1, 1, sizeof(buf1), f1);
+		const size_t n2 = fread(buf2, 1, sizeof(buf2), f2);
+		if (n1 != n2 || memcmp(buf1, buf2, n1) != 0) {
+			// Size or contents differ.
+			return false;
+		}
+		if (n1 == 0) {
+			// Both files hit EOF at the same offset.
+			return !(ferror(f1) || ferror(f2));
+		}
+	}
+}
+
+/**
+ * Get the blob filename for the specified contents hash and size.
+ * @param hash File contents hash.
+ * @param size File size, in bytes.
+ * @return Blob filename (UTF-8), or empty string on error.
+ */
+static string getBlobFilename(uint64_t hash, int64_t size)
+{
+	string filename = getCacheDirectory();
+	if (filename.empty())
+		return filename;
+
+	if (filename.at(filename.size()-1) != DIR_SEP_CHR) {
+		filename += DIR_SEP_CHR;
+	}
+	filename += "blobs";
+
+	char buf[48];
+	snprintf(buf, sizeof(buf), "%c%016llx-%lld", DIR_SEP_CHR,
+		static_cast<unsigned long long>(hash),
+		static_cast<long long>(size));
+	filename += buf;
+	return filename;
+}
+
+#ifndef _WIN32
+
+/**
+ * Deduplicate a cache file against the content-addressed blob store.
+ *
+ * The file's contents are hashed, and the file is hard-linked into
+ * <cachedir>/blobs/ under a name derived from the hash and size.
+ * If another cache key previously downloaded byte-identical contents,
+ * e.g. regional variants sharing the same cover art, the duplicate
+ * copy is replaced with a link to the existing blob, so the data is
+ * stored on disk (and paged in) only once.
+ *
+ * Deduplication is best-effort: on filesystems without hard link
+ * support, the cache file is simply left in place as a regular file.
+ *
+ * NOTE: A deduplicated cache file may be shared with other cache
+ * keys, so it must not be rewritten in place. Writers must remove
+ * the file before reopening it for writing, which leaves the old
+ * contents intact for the other links.
+ *
+ * @param cacheFilename Cache filename from getCacheFilename(). (UTF-8)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int dedupCacheFile(const string &cacheFilename)
+{
+	assert(!cacheFilename.empty());
+	if (cacheFilename.empty())
+		return -EINVAL;
+
+	// Hash the cache file.
+	FILE *f_cache = fopen(cacheFilename.c_str(), "rb");
+	if (!f_cache)
+		return -errno;
+	uint64_t hash;
+	int64_t size;
+	int ret = blobHashFile(f_cache, &hash, &size);
+	if (ret != 0 || size == 0) {
+		// Read error, or an empty file.
+		// (0-byte negative cache entries aren't deduplicated.)
+		fclose(f_cache);
+		return ret;
+	}
+
+	const string blobFilename = getBlobFilename(hash, size);
+	if (blobFilename.empty()) {
+		fclose(f_cache);
+		return -ENOENT;
+	}
+
+	FILE *f_blob = fopen(blobFilename.c_str(), "rb");
+	if (!f_blob) {
+		// No blob with these contents yet.
+		// Store this file as the new blob.
+		fclose(f_cache);
+		const size_t slash_pos = blobFilename.rfind(DIR_SEP_CHR);
+		mkdir(blobFilename.substr(0, slash_pos).c_str(), 0777);
+		// NOTE: link() failure isn't an error: the filesystem might
+		// not support hard links, or another process might have
+		// created the blob first. The cache file stays usable.
+		link(cacheFilename.c_str(), blobFilename.c_str());
+		return 0;
+	}
+
+	// A blob with this hash exists.
+	// Byte-compare the contents, since the hash isn't collision-proof.
+	rewind(f_cache);
+	const bool equal = blobFilesEqual(f_cache, f_blob);
+	fclose(f_cache);
+	fclose(f_blob);
+	if (!equal) {
+		// Hash collision. Keep the cache file as a regular file.
+		return 0;
+	}
+
+	// Replace the cache file with a link to the existing blob.
+	// Link to a temporary name first, then rename over the original,
+	// so a failed link() can't lose the cache file.
+	const string tmpFilename = cacheFilename + ".dedup-tmp";
+	unlink(tmpFilename.c_str());
+	if (link(blobFilename.c_str(), tmpFilename.c_str()) != 0) {
+		// Hard links aren't supported. (best-effort; not an error)
+		return 0;
+	}
+	if (rename(tmpFilename.c_str(), cacheFilename.c_str()) != 0) {
+		const int err = errno;
+		unlink(tmpFilename.c_str());
+		return -err;
+	}
+	return 0;
+}
+
+#else /* _WIN32 */
+
+/**
+ * Deduplicate a cache file against the content-addressed blob store.
+ * (See the UTF-8 version for the full description.)
+ * @param cacheFilename Cache filename from getCacheFilename(). (UTF-16)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int dedupCacheFile(const wstring &cacheFilename)
+{
+	assert(!cacheFilename.empty());
+	if (cacheFilename.empty())
+		return -EINVAL;
+
+	// Hash the cache file.
+	FILE *f_cache = _wfopen(cacheFilename.c_str(), L"rb");
+	if (!f_cache)
+		return -errno;
+	uint64_t hash;
+	int64_t size;
+	int ret = blobHashFile(f_cache, &hash, &size);
+	if (ret != 0 || size == 0) {
+		// Read error, or an empty file.
+		// (0-byte negative cache entries aren't deduplicated.)
+		fclose(f_cache);
+		return ret;
+	}
+
+	const wstring blobFilename = LibWin32Common::U82W_s(getBlobFilename(hash, size));
+	if (blobFilename.empty()) {
+		fclose(f_cache);
+		return -ENOENT;
+	}
+
+	FILE *f_blob = _wfopen(blobFilename.c_str(), L"rb");
+	if (!f_blob) {
+		// No blob with these contents yet.
+		// Store this file as the new blob.
+		fclose(f_cache);
+		const size_t slash_pos = blobFilename.rfind(DIR_SEP_WCHR);
+		_wmkdir(blobFilename.substr(0, slash_pos).c_str());
+		// NOTE: CreateHardLink() failure isn't an error: the
+		// filesystem might not support hard links, or another
+		// process might have created the blob first. The cache
+		// file stays usable.
+		CreateHardLink(blobFilename.c_str(), cacheFilename.c_str(), nullptr);
+		return 0;
+	}
+
+	// A blob with this hash exists.
+	// Byte-compare the contents, since the hash isn't collision-proof.
+	rewind(f_cache);
+	const bool equal = blobFilesEqual(f_cache, f_blob);
+	fclose(f_cache);
+	fclose(f_blob);
+	if (!equal) {
+		// Hash collision. Keep the cache file as a regular file.
+		return 0;
+	}
+
+	// Replace the cache file with a link to the existing blob.
+	// Link to a temporary name first, then rename over the original,
+	// so a failed CreateHardLink() can't lose the cache file.
+	const wstring tmpFilename = cacheFilename + L".dedup-tmp";
+	DeleteFile(tmpFilename.c_str());
+	if (!CreateHardLink(tmpFilename.c_str(), blobFilename.c_str(), nullptr)) {
+		// Hard links aren't supported. (best-effort; not an error)
+		return 0;
+	}
+	if (!MoveFileEx(tmpFilename.c_str(), cacheFilename.c_str(), MOVEFILE_REPLACE_EXISTING)) {
+		DeleteFile(tmpFilename.c_str());
+		return -EIO;
+	}
+	return 0;
+}
+
+/**
+ * Deduplicate a cache file against the content-addressed blob store.
+ * (See the UTF-16 version for the full description.)
+ * @param cacheFilename Cache filename from getCacheFilename(). (UTF-8)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int dedupCacheFile(const string &cacheFilename)
+{
+	return dedupCacheFile(LibWin32Common::U82W_s(cacheFilename));
+}
+
+#endif /* _WIN32 */
+
+}
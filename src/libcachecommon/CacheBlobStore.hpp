@@ -0,0 +1,51 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libcachecommon)                   *
+ * CacheBlobStore.hpp: Content-addressed dedup store for the cache.        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBCACHECOMMON_CACHEBLOBSTORE_HPP__
+#define __ROMPROPERTIES_LIBCACHECOMMON_CACHEBLOBSTORE_HPP__
+
+// C++ includes.
+#include <string>
+
+namespace LibCacheCommon {
+
+/**
+ * Deduplicate a cache file against the content-addressed blob store.
+ *
+ * The file's contents are hashed, and the file is hard-linked into
+ * <cachedir>/blobs/ under a name derived from the hash and size.
+ * If another cache key previously downloaded byte-identical contents,
+ * e.g. regional variants sharing the same cover art, the duplicate
+ * copy is replaced with a link to the existing blob, so the data is
+ * stored on disk (and paged in) only once.
+ *
+ * Deduplication is best-effort: on filesystems without hard link
+ * support, the cache file is simply left in place as a regular file.
+ *
+ * NOTE: A deduplicated cache file may be shared with other cache
+ * keys, so it must not be rewritten in place. Writers must remove
+ * the file before reopening it for writing, which leaves the old
+ * contents intact for the other links.
+ *
+ * @param cacheFilename Cache filename from getCacheFilename(). (UTF-8)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int dedupCacheFile(const std::string &cacheFilename);
+
+#ifdef _WIN32
+/**
+ * Deduplicate a cache file against the content-addressed blob store.
+ * @param cacheFilename Cache filename from getCacheFilename(). (UTF-16)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int dedupCacheFile(const std::wstring &cacheFilename);
+#endif /* _WIN32 */
+
+}
+
+#endif /* __ROMPROPERTIES_LIBCACHECOMMON_CACHEBLOBSTORE_HPP__ */
@@ -0,0 +1,517 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libcachecommon)                   *
+ * CacheEviction.cpp: Size/atime ledger and LRU eviction for the cache.    *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "CacheEviction.hpp"
+#include "CacheDir.hpp"
+#include "CacheKeys.hpp"
+#include "CacheIndex.hpp"
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+
+// C++ STL classes.
+#include <algorithm>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+using std::string;
+using std::unordered_map;
+using std::vector;
+
+// librpthreads
+#include "librpthreads/pthread_once.h"
+#include "librpthreads/Mutex.hpp"
+using LibRpBase::Mutex;
+using LibRpBase::MutexLocker;
+
+#ifdef _WIN32
+# include "libwin32common/MiniU82T.hpp"
+# define DIR_SEP_CHR '\\'
+#else /* !_WIN32 */
+# define DIR_SEP_CHR '/'
+#endif /* _WIN32 */
+
+namespace LibCacheCommon {
+
+/** Cache ledger. **/
+
+// On-disk format: 8-byte magic, followed by variable-length records:
+// - 8-byte file size (<0 == key removed)
+// - 8-byte atime
+// - 2-byte key length
+// - cache key (UTF-8, not NULL-terminated)
+// Append-only; a later record for the same key supersedes earlier
+// ones, and the file is compacted to a snapshot of the live entries
+// if it accumulates too many records.
+static const char CACHE_LEDGER_MAGIC[8] = {'R','P','C','L','R','U','\1','\0'};
+
+// Maximum record count before the ledger file is compacted.
+static const size_t CACHE_LEDGER_MAX_RECORDS = 65536;
+
+// Maximum cache key length accepted from the ledger file.
+static const size_t CACHE_LEDGER_MAX_KEY_LEN = 1024;
+
+// Minimum atime advance before a new access record is appended.
+// Coarse LRU granularity keeps repeated thumbnailings of the same
+// file from appending one record per access. (in seconds)
+static const int64_t CACHE_LEDGER_ATIME_GRANULARITY = 3600;
+
+// Time-to-live for cache entries. Files that haven't been accessed
+// for this long are evicted regardless of the size limit.
+// (90 days, in seconds)
+static const int64_t CACHE_LEDGER_TTL = 90*86400;
+
+// In-memory ledger entry.
+struct LedgerEntry {
+	int64_t fileSize;	// File size, in bytes.
+	int64_t atime;		// Last access time.
+};
+
+// pthread_once() control variable.
+static pthread_once_t once_control = PTHREAD_ONCE_INIT;
+// In-memory copy of the ledger.
+static unordered_map<string, LedgerEntry> ledgerMap;
+// Mutex protecting the ledger state and file appends.
+static Mutex ledgerMutex;
+// Running total of the ledgered file sizes.
+static int64_t ledgerTotalSize = 0;
+// Oldest atime in the ledger. (conservative; updated on sweeps)
+static int64_t ledgerOldestAtime = INT64_MAX;
+// Number of records in the ledger file.
+static size_t recordsOnDisk = 0;
+// Cache size limit, in bytes. (0 == unlimited)
+static int64_t cacheSizeLimit = 0;
+// Is an eviction sweep running?
+static bool evictionRunning = false;
+
+// Background eviction thread.
+// Joined when the previous sweep has finished and a new one is
+// started, and at process shutdown.
+class EvictionThread
+{
+	public:
+		EvictionThread()
+			: thread(nullptr)
+		{ }
+
+		~EvictionThread()
+		{
+			if (thread) {
+				thread->join();
+				delete thread;
+			}
+		}
+
+		std::thread *thread;
+};
+static EvictionThread evictionThread;
+
+/**
+ * Get the cache ledger filename.
+ * @return Cache ledger filename, or empty string on error.
+ */
+static string getCacheLedgerFilename(void)
+{
+	string filename = getCacheDirectory();
+	if (filename.empty())
+		return filename;
+
+	filename += DIR_SEP_CHR;
+	filename += "cache-ledger.bin";
+	return filename;
+}
+
+/**
+ * fopen() wrapper for UTF-8 filenames.
+ * @param filename Filename. (UTF-8)
+ * @param mode Mode.
+ * @return FILE*, or nullptr on error.
+ */
+static FILE *ledger_fopen(const string &filename, const char *mode)
+{
+#ifdef _WIN32
+	return _wfopen(LibWin32Common::U82W_s(filename).c_str(),
+		LibWin32Common::U82W_c(mode));
+#else /* !_WIN32 */
+	return fopen(filename.c_str(), mode);
+#endif /* _WIN32 */
+}
+
+/**
+ * remove() wrapper for UTF-8 filenames.
+ * @param filename Filename. (UTF-8)
+ * @return 0 on success; non-zero on error.
+ */
+static int ledger_remove(const string &filename)
+{
+#ifdef _WIN32
+	return _wremove(LibWin32Common::U82W_s(filename).c_str());
+#else /* !_WIN32 */
+	return remove(filename.c_str());
+#endif /* _WIN32 */
+}
+
+/**
+ * Write a ledger record to an open file.
+ * @param f		[in] Ledger file, positioned for the write.
+ * @param cache_key	[in] Cache key.
+ * @param fileSize	[in] File size. (<0 == key removed)
+ * @param atime		[in] Access time.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int writeLedgerRecord(FILE *f, const string &cache_key, int64_t fileSize, int64_t atime)
+{
+	const uint16_t keyLen = static_cast<uint16_t>(cache_key.size());
+	if (fwrite(&fileSize, 1, sizeof(fileSize), f) != sizeof(fileSize) ||
+	    fwrite(&atime, 1, sizeof(atime), f) != sizeof(atime) ||
+	    fwrite(&keyLen, 1, sizeof(keyLen), f) != sizeof(keyLen) ||
+	    fwrite(cache_key.data(), 1, keyLen, f) != keyLen)
+	{
+		return -EIO;
+	}
+	return 0;
+}
+
+/**
+ * Recalculate the ledger totals from the in-memory map.
+ * The caller must hold ledgerMutex.
+ */
+static void recalcLedgerTotals(void)
+{
+	ledgerTotalSize = 0;
+	ledgerOldestAtime = INT64_MAX;
+	for (auto iter = ledgerMap.cbegin(); iter != ledgerMap.cend(); ++iter) {
+		ledgerTotalSize += iter->second.fileSize;
+		if (iter->second.atime < ledgerOldestAtime) {
+			ledgerOldestAtime = iter->second.atime;
+		}
+	}
+}
+
+/**
+ * Load the cache ledger from disk.
+ * Called by pthread_once().
+ */
+static void initCacheLedger(void)
+{
+	const string filename = getCacheLedgerFilename();
+	if (filename.empty())
+		return;
+
+	FILE *f = ledger_fopen(filename, "rb");
+	if (!f) {
+		// No ledger file yet.
+		return;
+	}
+
+	// Verify the magic.
+	char magic[sizeof(CACHE_LEDGER_MAGIC)];
+	if (fread(magic, 1, sizeof(magic), f) != sizeof(magic) ||
+	    memcmp(magic, CACHE_LEDGER_MAGIC, sizeof(magic)) != 0)
+	{
+		// Wrong magic or truncated header.
+		fclose(f);
+		return;
+	}
+
+	// Read the records. Later records supersede earlier ones.
+	char keybuf[CACHE_LEDGER_MAX_KEY_LEN];
+	while (true) {
+		int64_t fileSize, atime;
+		uint16_t keyLen;
+		if (fread(&fileSize, 1, sizeof(fileSize), f) != sizeof(fileSize) ||
+		    fread(&atime, 1, sizeof(atime), f) != sizeof(atime) ||
+		    fread(&keyLen, 1, sizeof(keyLen), f) != sizeof(keyLen))
+		{
+			// End of file. (or truncated record)
+			break;
+		}
+		if (keyLen == 0 || keyLen > sizeof(keybuf) ||
+		    fread(keybuf, 1, keyLen, f) != keyLen)
+		{
+			// Invalid or truncated record. Stop here.
+			break;
+		}
+
+		string cache_key(keybuf, keyLen);
+		if (fileSize < 0) {
+			// Removal record.
+			ledgerMap.erase(cache_key);
+		} else {
+			LedgerEntry &entry = ledgerMap[std::move(cache_key)];
+			entry.fileSize = fileSize;
+			entry.atime = atime;
+		}
+		recordsOnDisk++;
+	}
+	fclose(f);
+
+	recalcLedgerTotals();
+}
+
+/**
+ * Rewrite the ledger file as a snapshot of the live entries.
+ * The caller must hold ledgerMutex.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int compactCacheLedger(void)
+{
+	const string filename = getCacheLedgerFilename();
+	if (filename.empty())
+		return -ENOENT;
+
+	FILE *f = ledger_fopen(filename, "wb");
+	if (!f)
+		return -errno;
+
+	fwrite(CACHE_LEDGER_MAGIC, 1, sizeof(CACHE_LEDGER_MAGIC), f);
+	for (auto iter = ledgerMap.cbegin(); iter != ledgerMap.cend(); ++iter) {
+		writeLedgerRecord(f, iter->first, iter->second.fileSize, iter->second.atime);
+	}
+	fclose(f);
+
+	recordsOnDisk = ledgerMap.size();
+	return 0;
+}
+
+/**
+ * Append a record to the ledger file.
+ * The caller must hold ledgerMutex.
+ * @param cache_key	[in] Cache key.
+ * @param fileSize	[in] File size. (<0 == key removed)
+ * @param atime		[in] Access time.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int appendLedgerRecord(const string &cache_key, int64_t fileSize, int64_t atime)
+{
+	if (recordsOnDisk >= CACHE_LEDGER_MAX_RECORDS) {
+		// Too many stale records. Compact the file.
+		compactCacheLedger();
+	}
+
+	const string filename = getCacheLedgerFilename();
+	if (filename.empty())
+		return -ENOENT;
+
+	// Append the record. Create the file with a header first
+	// if it doesn't exist yet.
+	FILE *f = ledger_fopen(filename, "r+b");
+	if (!f) {
+		f = ledger_fopen(filename, "wb");
+		if (!f)
+			return -errno;
+		fwrite(CACHE_LEDGER_MAGIC, 1, sizeof(CACHE_LEDGER_MAGIC), f);
+	}
+	fseek(f, 0, SEEK_END);
+	int ret = writeLedgerRecord(f, cache_key, fileSize, atime);
+	fclose(f);
+	if (ret == 0) {
+		recordsOnDisk++;
+	}
+	return ret;
+}
+
+/**
+ * Background eviction sweep.
+ *
+ * Evicts expired entries (TTL), then the least recently used
+ * entries until the cache is back under the size limit.
+ */
+static void evictionSweep(void)
+{
+	MutexLocker locker(ledgerMutex);
+	const int64_t now = static_cast<int64_t>(time(nullptr));
+
+	// Evict down to 7/8 of the limit so the next few downloads
+	// don't immediately trigger another sweep.
+	const int64_t target = (cacheSizeLimit > 0)
+		? (cacheSizeLimit - cacheSizeLimit/8)
+		: INT64_MAX;
+
+	// Sort the entries by access time, oldest first.
+	vector<std::pair<int64_t, string> > entries;
+	entries.reserve(ledgerMap.size());
+	for (auto iter = ledgerMap.cbegin(); iter != ledgerMap.cend(); ++iter) {
+		entries.emplace_back(std::make_pair(iter->second.atime, iter->first));
+	}
+	std::sort(entries.begin(), entries.end());
+
+	for (auto iter = entries.cbegin(); iter != entries.cend(); ++iter) {
+		const bool expired = (now - iter->first) > CACHE_LEDGER_TTL;
+		if (!expired && ledgerTotalSize <= target) {
+			// Under the size target, and the remaining
+			// entries are newer. Done.
+			break;
+		}
+
+		auto map_iter = ledgerMap.find(iter->second);
+		if (map_iter == ledgerMap.end())
+			continue;
+
+		// Delete the cached file.
+		// NOTE: The file may be a hard link into the blob store;
+		// only this key's link is removed. (TODO: Garbage-collect
+		// orphaned blobs.)
+		const string cache_filename = getCacheFilename(iter->second);
+		if (!cache_filename.empty()) {
+			ledger_remove(cache_filename);
+		}
+
+		// Remove the entry from the ledger and the cache index.
+		ledgerTotalSize -= map_iter->second.fileSize;
+		ledgerMap.erase(map_iter);
+		appendLedgerRecord(iter->second, -1, now);
+		cacheIndexRemove(iter->second);
+	}
+
+	recalcLedgerTotals();
+	evictionRunning = false;
+}
+
+/**
+ * Start a background eviction sweep if one is needed.
+ * The caller must hold ledgerMutex.
+ */
+static void maybeStartEviction(void)
+{
+	if (evictionRunning)
+		return;
+
+	const int64_t now = static_cast<int64_t>(time(nullptr));
+	const bool overLimit = (cacheSizeLimit > 0 && ledgerTotalSize > cacheSizeLimit);
+	const bool hasExpired = (ledgerOldestAtime != INT64_MAX &&
+				 (now - ledgerOldestAtime) > CACHE_LEDGER_TTL);
+	if (!overLimit && !hasExpired)
+		return;
+
+	// Join the previous sweep's thread, if any.
+	if (evictionThread.thread) {
+		evictionThread.thread->join();
+		delete evictionThread.thread;
+	}
+
+	evictionRunning = true;
+	evictionThread.thread = new std::thread(evictionSweep);
+}
+
+/**
+ * Set the cache size limit for background eviction.
+ *
+ * When the ledger total exceeds the limit, a background sweep
+ * evicts the least recently used files until the cache is back
+ * under the limit.
+ *
+ * @param limit Cache size limit, in bytes. (0 == unlimited)
+ */
+void setCacheSizeLimit(int64_t limit)
+{
+	MutexLocker locker(ledgerMutex);
+	cacheSizeLimit = (limit > 0 ? limit : 0);
+}
+
+/**
+ * Record an access to a cached file in the size/atime ledger.
+ *
+ * Call this whenever a cache key is served from the cache or
+ * (re)downloaded. The ledger maintains a running total of the
+ * cache size, so no directory rescans are ever needed, and the
+ * access times drive LRU eviction.
+ *
+ * If the cache exceeds the configured size limit, or entries
+ * have outlived the TTL, a background eviction sweep is started.
+ *
+ * @param cache_key	[in] Cache key. (UTF-8, unfiltered)
+ * @param fileSize	[in] Current size of the cached file, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int cacheLedgerAccess(const string &cache_key, int64_t fileSize)
+{
+	if (cache_key.empty() || cache_key.size() > CACHE_LEDGER_MAX_KEY_LEN ||
+	    fileSize < 0)
+	{
+		return -EINVAL;
+	}
+
+	pthread_once(&once_control, initCacheLedger);
+	const int64_t now = static_cast<int64_t>(time(nullptr));
+
+	MutexLocker locker(ledgerMutex);
+
+	auto iter = ledgerMap.find(cache_key);
+	if (iter != ledgerMap.end()) {
+		if (iter->second.fileSize == fileSize &&
+		    (now - iter->second.atime) < CACHE_LEDGER_ATIME_GRANULARITY)
+		{
+			// Recorded recently enough. Skip the file append.
+			return 0;
+		}
+		ledgerTotalSize -= iter->second.fileSize;
+		iter->second.fileSize = fileSize;
+		iter->second.atime = now;
+	} else {
+		LedgerEntry entry;
+		entry.fileSize = fileSize;
+		entry.atime = now;
+		ledgerMap.insert(std::make_pair(cache_key, entry));
+	}
+	ledgerTotalSize += fileSize;
+
+	int ret = appendLedgerRecord(cache_key, fileSize, now);
+	maybeStartEviction();
+	return ret;
+}
+
+/**
+ * Remove a cache key from the size/atime ledger.
+ *
+ * Call this when a cached file is deleted outside of the
+ * eviction sweep, e.g. when the cache is cleared.
+ *
+ * @param cache_key	[in] Cache key. (UTF-8, unfiltered)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int cacheLedgerRemove(const string &cache_key)
+{
+	if (cache_key.empty() || cache_key.size() > CACHE_LEDGER_MAX_KEY_LEN)
+		return -EINVAL;
+
+	pthread_once(&once_control, initCacheLedger);
+
+	MutexLocker locker(ledgerMutex);
+
+	auto iter = ledgerMap.find(cache_key);
+	if (iter == ledgerMap.end()) {
+		// Not in the ledger.
+		return 0;
+	}
+
+	ledgerTotalSize -= iter->second.fileSize;
+	ledgerMap.erase(iter);
+	return appendLedgerRecord(cache_key, -1, static_cast<int64_t>(time(nullptr)));
+}
+
+/**
+ * Get the total cache size recorded in the ledger.
+ *
+ * This is an O(1) in-memory read; no directory walk is performed.
+ *
+ * @return Total size of the ledgered cache files, in bytes.
+ */
+int64_t cacheLedgerTotalSize(void)
+{
+	pthread_once(&once_control, initCacheLedger);
+	MutexLocker locker(ledgerMutex);
+	return ledgerTotalSize;
+}
+
+}
@@ -0,0 +1,70 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libcachecommon)                   *
+ * CacheEviction.hpp: Size/atime ledger and LRU eviction for the cache.    *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBCACHECOMMON_CACHEEVICTION_HPP__
+#define __ROMPROPERTIES_LIBCACHECOMMON_CACHEEVICTION_HPP__
+
+// C includes.
+#include <stdint.h>
+
+// C++ includes.
+#include <string>
+
+namespace LibCacheCommon {
+
+/**
+ * Set the cache size limit for background eviction.
+ *
+ * When the ledger total exceeds the limit, a background sweep
+ * evicts the least recently used files until the cache is back
+ * under the limit.
+ *
+ * @param limit Cache size limit, in bytes. (0 == unlimited)
+ */
+void setCacheSizeLimit(int64_t limit);
+
+/**
+ * Record an access to a cached file in the size/atime ledger.
+ *
+ * Call this whenever a cache key is served from the cache or
+ * (re)downloaded. The ledger maintains a running total of the
+ * cache size, so no directory rescans are ever needed, and the
+ * access times drive LRU eviction.
+ *
+ * If the cache exceeds the configured size limit, or entries
+ * have outlived the TTL, a background eviction sweep is started.
+ *
+ * @param cache_key	[in] Cache key. (UTF-8, unfiltered)
+ * @param fileSize	[in] Current size of the cached file, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int cacheLedgerAccess(const std::string &cache_key, int64_t fileSize);
+
+/**
+ * Remove a cache key from the size/atime ledger.
+ *
+ * Call this when a cached file is deleted outside of the
+ * eviction sweep, e.g. when the cache is cleared.
+ *
+ * @param cache_key	[in] Cache key. (UTF-8, unfiltered)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int cacheLedgerRemove(const std::string &cache_key);
+
+/**
+ * Get the total cache size recorded in the ledger.
+ *
+ * This is an O(1) in-memory read; no directory walk is performed.
+ *
+ * @return Total size of the ledgered cache files, in bytes.
+ */
+int64_t cacheLedgerTotalSize(void);
+
+}
+
+#endif /* __ROMPROPERTIES_LIBCACHECOMMON_CACHEEVICTION_HPP__ */
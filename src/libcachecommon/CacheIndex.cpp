@@ -0,0 +1,394 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libcachecommon)                   *
+ * CacheIndex.cpp: Persistent index for the download cache.                *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "CacheIndex.hpp"
+#include "CacheDir.hpp"
+#include "common.h"
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+// C++ STL classes.
+#include <string>
+#include <unordered_map>
+using std::string;
+using std::unordered_map;
+
+// librpthreads
+#include "librpthreads/pthread_once.h"
+#include "librpthreads/Mutex.hpp"
+using LibRpBase::Mutex;
+using LibRpBase::MutexLocker;
+
+#ifdef _WIN32
+# include "libwin32common/MiniU82T.hpp"
+# define DIR_SEP_CHR '\\'
+#else /* !_WIN32 */
+# define DIR_SEP_CHR '/'
+#endif /* _WIN32 */
+
+namespace LibCacheCommon {
+
+/** Cache index. **/
+
+// On-disk format: 8-byte magic, followed by 24-byte records:
+// - 8-byte key hash
+// - 8-byte file size (0 == negative entry; <0 == key removed)
+// - 8-byte mtime
+// Append-only; a later record for the same key hash supersedes
+// earlier ones, and the file is discarded and restarted if it
+// grows too large.
+static const char CACHE_INDEX_MAGIC[8] = {'R','P','C','I','D','X','\1','\0'};
+
+// On-disk record.
+struct CacheIndexRecord {
+	uint64_t hash;		// Key hash.
+	int64_t fileSize;	// File size. (0 == negative entry)
+	int64_t mtime;		// File mtime.
+};
+
+// In-memory entry.
+struct CacheIndexEntry {
+	int64_t fileSize;	// File size. (0 == negative entry)
+	int64_t mtime;		// File mtime.
+};
+
+// Maximum number of entries before the index is restarted.
+// 64K entries == 1.5 MB on disk.
+static const size_t CACHE_INDEX_MAX_ENTRIES = 65536;
+
+// Minimum time between checks for updates made by other
+// processes, e.g. rp-download. (in seconds)
+static const time_t CACHE_INDEX_REFRESH_INTERVAL = 30;
+
+// pthread_once() control variable.
+static pthread_once_t once_control = PTHREAD_ONCE_INIT;
+// In-memory copy of the index.
+static unordered_map<uint64_t, CacheIndexEntry> cacheIndexMap;
+// Mutex protecting cacheIndexMap and file appends.
+static Mutex cacheIndexMutex;
+// Size of the index file when it was last loaded.
+// Used to detect updates made by other processes.
+static long loadedFileSize = 0;
+// Last time the index file was checked for updates.
+static time_t lastRefreshCheck = 0;
+
+/**
+ * Get the cache index filename.
+ * @return Cache index filename, or empty string on error.
+ */
+static string getCacheIndexFilename(void)
+{
+	string filename = getCacheDirectory();
+	if (filename.empty())
+		return filename;
+
+	filename += DIR_SEP_CHR;
+	filename += "cache-index.bin";
+	return filename;
+}
+
+/**
+ * fopen() wrapper for UTF-8 filenames.
+ * @param filename Filename. (UTF-8)
+ * @param mode Mode.
+ * @return FILE*, or nullptr on error.
+ */
+static FILE *cacheIndex_fopen(const string &filename, const char *mode)
+{
+#ifdef _WIN32
+	return _wfopen(LibWin32Common::U82W_s(filename).c_str(),
+		LibWin32Common::U82W_c(mode));
+#else /* !_WIN32 */
+	return fopen(filename.c_str(), mode);
+#endif /* _WIN32 */
+}
+
+/**
+ * Hash a cache key using 64-bit FNV-1a.
+ * @param cache_key Cache key. (UTF-8)
+ * @return 64-bit hash.
+ */
+static uint64_t cacheIndex_hash(const string &cache_key)
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+
+	const char *p = cache_key.c_str();
+	for (; *p != '\0'; p++) {
+		hash ^= static_cast<uint8_t>(*p);
+		hash *= 0x00000100000001B3ULL;
+	}
+
+	return hash;
+}
+
+/**
+ * Load the cache index from an open file.
+ * The caller must hold cacheIndexMutex (except during pthread_once init).
+ * @param f Index file, positioned at the start.
+ */
+static void loadCacheIndexFile(FILE *f)
+{
+	cacheIndexMap.clear();
+	loadedFileSize = 0;
+
+	// Verify the magic.
+	char magic[sizeof(CACHE_INDEX_MAGIC)];
+	if (fread(magic, 1, sizeof(magic), f) != sizeof(magic) ||
+	    memcmp(magic, CACHE_INDEX_MAGIC, sizeof(magic)) != 0)
+	{
+		// Wrong magic or truncated header.
+		return;
+	}
+
+	// Read the records. Later records supersede earlier ones.
+	CacheIndexRecord buf[128];
+	size_t n;
+	while ((n = fread(buf, sizeof(CacheIndexRecord), ARRAY_SIZE(buf), f)) > 0) {
+		for (size_t i = 0; i < n; i++) {
+			if (buf[i].fileSize < 0) {
+				// Removal record.
+				cacheIndexMap.erase(buf[i].hash);
+				continue;
+			}
+			CacheIndexEntry &entry = cacheIndexMap[buf[i].hash];
+			entry.fileSize = buf[i].fileSize;
+			entry.mtime = buf[i].mtime;
+		}
+		if (cacheIndexMap.size() > CACHE_INDEX_MAX_ENTRIES) {
+			// Index is oversized. Discard it; it will be
+			// restarted on the next cacheIndexUpdate().
+			cacheIndexMap.clear();
+			return;
+		}
+	}
+	loadedFileSize = ftell(f);
+}
+
+/**
+ * Load the cache index from disk.
+ * Called by pthread_once().
+ */
+static void initCacheIndex(void)
+{
+	lastRefreshCheck = time(nullptr);
+
+	const string filename = getCacheIndexFilename();
+	if (filename.empty())
+		return;
+
+	FILE *f = cacheIndex_fopen(filename, "rb");
+	if (!f) {
+		// No index file yet.
+		return;
+	}
+
+	loadCacheIndexFile(f);
+	fclose(f);
+}
+
+/**
+ * Reload the cache index if another process has modified it.
+ * The caller must hold cacheIndexMutex.
+ *
+ * rp-download runs as a separate process and appends its own
+ * records, so the file size is re-checked periodically. A full
+ * reload is cheap: the index file is at most 1.5 MB.
+ */
+static void refreshCacheIndex(void)
+{
+	const time_t now = time(nullptr);
+	if ((now - lastRefreshCheck) < CACHE_INDEX_REFRESH_INTERVAL)
+		return;
+	lastRefreshCheck = now;
+
+	const string filename = getCacheIndexFilename();
+	if (filename.empty())
+		return;
+
+	FILE *f = cacheIndex_fopen(filename, "rb");
+	if (!f) {
+		// Index file was deleted, e.g. by clearing the cache.
+		cacheIndexMap.clear();
+		loadedFileSize = 0;
+		return;
+	}
+
+	fseek(f, 0, SEEK_END);
+	const long fileSize = ftell(f);
+	if (fileSize != loadedFileSize) {
+		// File changed. Reload it.
+		rewind(f);
+		loadCacheIndexFile(f);
+	}
+	fclose(f);
+}
+
+/**
+ * Look up a cache key in the persistent cache index.
+ *
+ * The index records the size and mtime of downloaded files, so
+ * cache presence tests are in-memory probes instead of per-key
+ * stat() calls. The index file is reloaded periodically to pick
+ * up updates made by other processes, e.g. rp-download.
+ *
+ * @param cache_key	[in] Cache key. (UTF-8)
+ * @param pFileSize	[out,opt] File size. (0 for negative entries)
+ * @param pMtime	[out,opt] File mtime.
+ * @return CacheIndexStatus.
+ */
+CacheIndexStatus cacheIndexLookup(const string &cache_key, int64_t *pFileSize, time_t *pMtime)
+{
+	if (cache_key.empty())
+		return CIS_UNKNOWN;
+
+	pthread_once(&once_control, initCacheIndex);
+	const uint64_t hash = cacheIndex_hash(cache_key);
+
+	MutexLocker locker(cacheIndexMutex);
+	refreshCacheIndex();
+
+	auto iter = cacheIndexMap.find(hash);
+	if (iter == cacheIndexMap.end())
+		return CIS_UNKNOWN;
+
+	if (pFileSize) {
+		*pFileSize = iter->second.fileSize;
+	}
+	if (pMtime) {
+		*pMtime = static_cast<time_t>(iter->second.mtime);
+	}
+	return (iter->second.fileSize > 0 ? CIS_PRESENT : CIS_NEGATIVE);
+}
+
+/**
+ * Update a cache key in the persistent cache index.
+ *
+ * Call this after downloading a file, or after creating a
+ * 0-byte negative cache file. (fileSize == 0 marks the key
+ * as a negative entry.)
+ *
+ * @param cache_key	[in] Cache key. (UTF-8)
+ * @param fileSize	[in] File size. (0 for negative entries)
+ * @param mtime		[in] File mtime.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int cacheIndexUpdate(const string &cache_key, int64_t fileSize, time_t mtime)
+{
+	if (cache_key.empty())
+		return -EINVAL;
+
+	pthread_once(&once_control, initCacheIndex);
+	const uint64_t hash = cacheIndex_hash(cache_key);
+
+	MutexLocker locker(cacheIndexMutex);
+
+	auto iter = cacheIndexMap.find(hash);
+	if (iter != cacheIndexMap.end() &&
+	    iter->second.fileSize == fileSize &&
+	    iter->second.mtime == static_cast<int64_t>(mtime))
+	{
+		// Already up to date.
+		return 0;
+	}
+
+	const string indexFilename = getCacheIndexFilename();
+	if (indexFilename.empty())
+		return -ENOENT;
+
+	if (cacheIndexMap.size() >= CACHE_INDEX_MAX_ENTRIES) {
+		// Index is full. Restart it. Stale records accumulate
+		// over time since an append-only file can't drop them
+		// individually, so periodic restarts are the cheapest
+		// way to keep the index bounded.
+		cacheIndexMap.clear();
+		FILE *f = cacheIndex_fopen(indexFilename, "wb");
+		if (!f)
+			return -errno;
+		fwrite(CACHE_INDEX_MAGIC, 1, sizeof(CACHE_INDEX_MAGIC), f);
+		fclose(f);
+	}
+
+	// Append the record. Create the file with a header first
+	// if it doesn't exist yet.
+	FILE *f = cacheIndex_fopen(indexFilename, "r+b");
+	if (!f) {
+		f = cacheIndex_fopen(indexFilename, "wb");
+		if (!f)
+			return -errno;
+		fwrite(CACHE_INDEX_MAGIC, 1, sizeof(CACHE_INDEX_MAGIC), f);
+	}
+	fseek(f, 0, SEEK_END);
+
+	CacheIndexRecord record;
+	record.hash = hash;
+	record.fileSize = fileSize;
+	record.mtime = static_cast<int64_t>(mtime);
+	size_t sz = fwrite(&record, 1, sizeof(record), f);
+	loadedFileSize = ftell(f);
+	fclose(f);
+	if (sz != sizeof(record))
+		return -EIO;
+
+	CacheIndexEntry &entry = cacheIndexMap[hash];
+	entry.fileSize = fileSize;
+	entry.mtime = static_cast<int64_t>(mtime);
+	return 0;
+}
+
+/**
+ * Remove a cache key from the persistent cache index.
+ *
+ * Call this after deleting a cached file, e.g. during cache
+ * eviction, so lookups don't report the file as present.
+ *
+ * @param cache_key	[in] Cache key. (UTF-8)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int cacheIndexRemove(const string &cache_key)
+{
+	if (cache_key.empty())
+		return -EINVAL;
+
+	pthread_once(&once_control, initCacheIndex);
+	const uint64_t hash = cacheIndex_hash(cache_key);
+
+	MutexLocker locker(cacheIndexMutex);
+
+	auto iter = cacheIndexMap.find(hash);
+	if (iter == cacheIndexMap.end()) {
+		// Not in the index.
+		return 0;
+	}
+	cacheIndexMap.erase(iter);
+
+	const string indexFilename = getCacheIndexFilename();
+	if (indexFilename.empty())
+		return -ENOENT;
+
+	// Append a removal record.
+	FILE *f = cacheIndex_fopen(indexFilename, "r+b");
+	if (!f) {
+		// No index file. Nothing to remove from.
+		return 0;
+	}
+	fseek(f, 0, SEEK_END);
+
+	CacheIndexRecord record;
+	record.hash = hash;
+	record.fileSize = -1;
+	record.mtime = static_cast<int64_t>(time(nullptr));
+	size_t sz = fwrite(&record, 1, sizeof(record), f);
+	loadedFileSize = ftell(f);
+	fclose(f);
+	return (sz == sizeof(record) ? 0 : -EIO);
+}
+
+}
@@ -0,0 +1,70 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libcachecommon)                   *
+ * CacheIndex.hpp: Persistent index for the download cache.                *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBCACHECOMMON_CACHEINDEX_HPP__
+#define __ROMPROPERTIES_LIBCACHECOMMON_CACHEINDEX_HPP__
+
+// C includes.
+#include <stdint.h>
+#include <time.h>
+
+// C++ includes.
+#include <string>
+
+namespace LibCacheCommon {
+
+// Cache index lookup result.
+enum CacheIndexStatus {
+	CIS_UNKNOWN = 0,	// Key is not in the index.
+	CIS_PRESENT,		// File is present in the cache.
+	CIS_NEGATIVE,		// Negative cache entry. (0-byte file)
+};
+
+/**
+ * Look up a cache key in the persistent cache index.
+ *
+ * The index records the size and mtime of downloaded files, so
+ * cache presence tests are in-memory probes instead of per-key
+ * stat() calls. The index file is reloaded periodically to pick
+ * up updates made by other processes, e.g. rp-download.
+ *
+ * @param cache_key	[in] Cache key. (UTF-8)
+ * @param pFileSize	[out,opt] File size. (0 for negative entries)
+ * @param pMtime	[out,opt] File mtime.
+ * @return CacheIndexStatus.
+ */
+CacheIndexStatus cacheIndexLookup(const std::string &cache_key, int64_t *pFileSize, time_t *pMtime);
+
+/**
+ * Update a cache key in the persistent cache index.
+ *
+ * Call this after downloading a file, or after creating a
+ * 0-byte negative cache file. (fileSize == 0 marks the key
+ * as a negative entry.)
+ *
+ * @param cache_key	[in] Cache key. (UTF-8)
+ * @param fileSize	[in] File size. (0 for negative entries)
+ * @param mtime		[in] File mtime.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int cacheIndexUpdate(const std::string &cache_key, int64_t fileSize, time_t mtime);
+
+/**
+ * Remove a cache key from the persistent cache index.
+ *
+ * Call this after deleting a cached file, e.g. during cache
+ * eviction, so lookups don't report the file as present.
+ *
+ * @param cache_key	[in] Cache key. (UTF-8)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int cacheIndexRemove(const std::string &cache_key);
+
+}
+
+#endif /* __ROMPROPERTIES_LIBCACHECOMMON_CACHEINDEX_HPP__ */
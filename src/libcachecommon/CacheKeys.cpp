@@ -7,8 +7,13 @@
  ***************************************************************************/
 
 #include "CacheKeys.hpp"
+#include "CacheKeys_p.hpp"
 #include "CacheDir.hpp"
 
+#ifdef CACHEKEYS_HAS_SSSE3
+# include "librpcpu/cpuflags_x86.h"
+#endif /* CACHEKEYS_HAS_SSSE3 */
+
 // C includes. (C++ namespace)
 #include <cassert>
 #include <cerrno>
@@ -43,7 +48,7 @@ namespace LibCacheCommon {
 // - 2: Dot
 // - 3: Slash
 // - 4: Backslash or colon (error)
-static const uint8_t valid_ascii_tbl[0x80] = {
+const uint8_t cacheKey_valid_ascii_tbl[0x80] = {
 	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,	// 0x00
 	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0,	// 0x10
 	1, 1, 0, 1, 1, 1, 1, 1, 1, 1, 0, 1, 1, 1, 2, 3, // 0x20 (", *, ., /)
@@ -75,7 +80,31 @@ int filterCacheKey(char *pCacheKey)
 		return -EINVAL;
 	}
 
+#ifdef CACHEKEYS_HAS_SSSE3
+	// The length is needed for the SSSE3 fast path so the 16-byte
+	// loads can never read past the NULL terminator.
+	const bool hasSSSE3 = !!RP_CPU_HasSSSE3();
+	const char *const pCacheKeyEnd = pCacheKey + strlen(pCacheKey);
+#endif /* CACHEKEYS_HAS_SSSE3 */
+
 	for (char *p = pCacheKey; *p != '\0'; p++) {
+#ifdef CACHEKEYS_HAS_SSSE3
+		if (hasSSSE3) {
+			// Skip over runs of plain valid characters,
+			// 16 bytes at a time.
+			const size_t run = filterCacheKey_plainRun_ssse3(p,
+				static_cast<size_t>(pCacheKeyEnd - p));
+			if (run > 0) {
+				// NOTE: Plain characters have the same side
+				// effect as case 1 below: foundSlash is cleared.
+				p += run;
+				foundSlash = false;
+				if (*p == '\0')
+					break;
+			}
+		}
+#endif /* CACHEKEYS_HAS_SSSE3 */
+
 		// See valid_ascii_table for a description of valid characters.
 		uint8_t chr = (uint8_t)*p;
 		if (chr & 0x80) {
@@ -153,7 +182,7 @@ int filterCacheKey(char *pCacheKey)
 			continue;
 		}
 
-		switch (valid_ascii_tbl[chr] & 7) {
+		switch (cacheKey_valid_ascii_tbl[chr] & 7) {
 			case 0:
 			default:
 				// Invalid character.
@@ -199,6 +228,35 @@ int filterCacheKey(char *pCacheKey)
 	return 0;
 }
 
+/**
+ * Filter invalid characters from a vector of cache keys.
+ *
+ * The keys are filtered in place. Invalid keys, e.g. due to
+ * path traversal or forbidden characters, are cleared to empty
+ * strings so batch operations can skip them.
+ *
+ * @param cacheKeys Vector of cache keys. (UTF-8)
+ * @return Number of valid keys.
+ */
+std::size_t filterCacheKeys(std::vector<std::string> &cacheKeys)
+{
+	std::size_t valid = 0;
+	for (auto iter = cacheKeys.begin(); iter != cacheKeys.end(); ++iter) {
+		if (iter->empty())
+			continue;
+
+		// Ensure the key is NULL-terminated by calling c_str().
+		iter->c_str();
+		if (filterCacheKey(&(*iter)[0]) == 0) {
+			valid++;
+		} else {
+			// Invalid cache key.
+			iter->clear();
+		}
+	}
+	return valid;
+}
+
 #ifdef _WIN32
 /**
  * Filter invalid characters from a cache key.
@@ -251,7 +309,7 @@ int filterCacheKey(wchar_t *pCacheKey)
 		// Not a surrogate pair character.
 		// Check for invalid ASCII characters.
 		if (chr < 0x80) {
-			switch (valid_ascii_tbl[chr] & 7) {
+			switch (cacheKey_valid_ascii_tbl[chr] & 7) {
 				case 0:
 				default:
 					// Invalid character.
@@ -11,6 +11,7 @@
 
 // C++ includes.
 #include <string>
+#include <vector>
 
 namespace LibCacheCommon {
 
@@ -35,6 +36,18 @@ static inline int filterCacheKey(std::string &cacheKey)
 	return filterCacheKey(&cacheKey[0]);
 }
 
+/**
+ * Filter invalid characters from a vector of cache keys.
+ *
+ * The keys are filtered in place. Invalid keys, e.g. due to
+ * path traversal or forbidden characters, are cleared to empty
+ * strings so batch operations can skip them.
+ *
+ * @param cacheKeys Vector of cache keys. (UTF-8)
+ * @return Number of valid keys.
+ */
+std::size_t filterCacheKeys(std::vector<std::string> &cacheKeys);
+
 #ifdef _WIN32
 /**
  * Filter invalid characters from a cache key.
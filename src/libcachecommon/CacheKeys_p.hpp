@@ -0,0 +1,47 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libcachecommon)                   *
+ * CacheKeys_p.hpp: Cache key handling functions. (PRIVATE HEADER)         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBCACHECOMMON_CACHEKEYS_P_HPP__
+#define __ROMPROPERTIES_LIBCACHECOMMON_CACHEKEYS_P_HPP__
+
+// C includes.
+#include <stdint.h>
+// C includes. (C++ namespace)
+#include <cstddef>
+
+#if defined(__i386__) || defined(__x86_64__) || \
+    defined(_M_IX86) || defined(_M_X64)
+# define CACHEKEYS_HAS_SSSE3 1
+#endif
+
+namespace LibCacheCommon {
+
+// Cache key character classification table.
+// (See CacheKeys.cpp for a description of the values.)
+extern const uint8_t cacheKey_valid_ascii_tbl[0x80];
+
+#ifdef CACHEKEYS_HAS_SSSE3
+/**
+ * Count the leading run of "plain" cache key characters.
+ *
+ * Plain characters are ASCII characters that are copied through
+ * unchanged: no substitution, dot/slash tracking, or error handling.
+ * The classification is done 16 bytes at a time using nibble LUTs.
+ *
+ * SSSE3-optimized version.
+ *
+ * @param p	[in] Current position in the cache key.
+ * @param len	[in] Number of bytes remaining, not including the NULL terminator.
+ * @return Number of leading plain characters. (range: [0, len])
+ */
+size_t filterCacheKey_plainRun_ssse3(const char *p, size_t len);
+#endif /* CACHEKEYS_HAS_SSSE3 */
+
+}
+
+#endif /* __ROMPROPERTIES_LIBCACHECOMMON_CACHEKEYS_P_HPP__ */
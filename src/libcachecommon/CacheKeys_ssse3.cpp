@@ -0,0 +1,126 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libcachecommon)                   *
+ * CacheKeys_ssse3.cpp: Cache key handling functions.                      *
+ * SSSE3-optimized version.                                                *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "CacheKeys_p.hpp"
+
+// C includes. (C++ namespace)
+#include <cstring>
+
+// SSSE3 intrinsics.
+#include <emmintrin.h>
+#include <tmmintrin.h>
+
+#ifdef _MSC_VER
+# include <intrin.h>
+#endif
+
+namespace LibCacheCommon {
+
+/**
+ * Nibble LUTs for the "plain" character set.
+ *
+ * A byte c (c < 0x80) is plain iff:
+ *   lut_lo[c & 0x0F] & lut_hi[c >> 4] != 0
+ *
+ * lut_lo has one bit per high nibble; lut_hi selects that bit.
+ * High nibbles >= 8 (non-ASCII) always test as not plain, so
+ * UTF-8 sequences fall back to the scalar code.
+ *
+ * Built from cacheKey_valid_ascii_tbl so the two classifications
+ * can't drift apart.
+ */
+struct PlainCharLUT {
+	uint8_t lo[16];
+	uint8_t hi[16];
+
+	PlainCharLUT()
+	{
+		memset(lo, 0, sizeof(lo));
+		memset(hi, 0, sizeof(hi));
+		for (unsigned int c = 0; c < 0x80; c++) {
+			if (cacheKey_valid_ascii_tbl[c] == 1) {
+				lo[c & 0x0F] |= static_cast<uint8_t>(1U << (c >> 4));
+			}
+		}
+		for (unsigned int h = 0; h < 8; h++) {
+			hi[h] = static_cast<uint8_t>(1U << h);
+		}
+	}
+};
+static const PlainCharLUT plainCharLUT;
+
+/**
+ * Get the index of the lowest set bit.
+ * @param mask Bitmask. (must be non-zero)
+ * @return Index of the lowest set bit.
+ */
+static inline unsigned int lowest_bit(unsigned int mask)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return static_cast<unsigned int>(index);
+#else /* !_MSC_VER */
+	return static_cast<unsigned int>(__builtin_ctz(mask));
+#endif /* _MSC_VER */
+}
+
+/**
+ * Count the leading run of "plain" cache key characters.
+ *
+ * Plain characters are ASCII characters that are copied through
+ * unchanged: no substitution, dot/slash tracking, or error handling.
+ * The classification is done 16 bytes at a time using nibble LUTs.
+ *
+ * SSSE3-optimized version.
+ *
+ * @param p	[in] Current position in the cache key.
+ * @param len	[in] Number of bytes remaining, not including the NULL terminator.
+ * @return Number of leading plain characters. (range: [0, len])
+ */
+size_t filterCacheKey_plainRun_ssse3(const char *p, size_t len)
+{
+	const __m128i lut_lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(plainCharLUT.lo));
+	const __m128i lut_hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(plainCharLUT.hi));
+	const __m128i mask0F = _mm_set1_epi8(0x0F);
+	const __m128i zero = _mm_setzero_si128();
+
+	size_t run = 0;
+
+	// Process 16 bytes at a time.
+	// NOTE: Only full chunks within the string are loaded, so the
+	// reads can't go past the NULL terminator.
+	for (; len - run >= 16; run += 16) {
+		const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + run));
+		const __m128i lo_nib = _mm_and_si128(chunk, mask0F);
+		const __m128i hi_nib = _mm_and_si128(_mm_srli_epi16(chunk, 4), mask0F);
+
+		// NOTE: pshufb returns 0 for bytes with the high bit set,
+		// so UTF-8 lead/trail bytes classify as not plain.
+		const __m128i plain = _mm_and_si128(
+			_mm_shuffle_epi8(lut_lo, lo_nib),
+			_mm_shuffle_epi8(lut_hi, hi_nib));
+		const unsigned int not_plain =
+			static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi8(plain, zero)));
+		if (not_plain != 0) {
+			// Chunk contains a special character.
+			return run + lowest_bit(not_plain);
+		}
+	}
+
+	// Remaining bytes. (scalar)
+	for (; run < len; run++) {
+		const uint8_t chr = static_cast<uint8_t>(p[run]);
+		if ((chr & 0x80) || cacheKey_valid_ascii_tbl[chr] != 1)
+			break;
+	}
+	return run;
+}
+
+}
@@ -0,0 +1,285 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libcachecommon)                   *
+ * NegativeCache.cpp: Persistent "unsupported file" negative cache.        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "NegativeCache.hpp"
+#include "CacheDir.hpp"
+#include "common.h"
+#include "config.version.h"
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+// C++ STL classes.
+#include <string>
+#include <unordered_set>
+using std::string;
+using std::unordered_set;
+
+// librpthreads
+#include "librpthreads/pthread_once.h"
+#include "librpthreads/Mutex.hpp"
+using LibRpBase::Mutex;
+using LibRpBase::MutexLocker;
+
+#ifdef _WIN32
+# include "libwin32common/MiniU82T.hpp"
+# define DIR_SEP_CHR '\\'
+#else /* !_WIN32 */
+# define DIR_SEP_CHR '/'
+#endif /* _WIN32 */
+
+namespace LibCacheCommon {
+
+/** Negative cache. **/
+
+// On-disk format: 8-byte magic, 4-byte program version,
+// followed by 8-byte little-endian entry hashes.
+// Append-only; the file is discarded and restarted if it
+// grows too large.
+static const char NEGCACHE_MAGIC[8] = {'R','P','N','E','G','C','\2','\0'};
+
+// Program version. An upgrade may add parsers that support
+// previously-unsupported files, so a version mismatch
+// discards the entire cache.
+static const uint32_t NEGCACHE_VERSION =
+	(static_cast<uint32_t>(RP_VERSION_MAJOR) << 24) |
+	(static_cast<uint32_t>(RP_VERSION_MINOR) << 16) |
+	(static_cast<uint32_t>(RP_VERSION_PATCH) <<  8) |
+	 static_cast<uint32_t>(RP_VERSION_DEVEL);
+
+// Maximum number of entries before the cache is restarted.
+// 64K entries == 512 KB on disk.
+static const size_t NEGCACHE_MAX_ENTRIES = 65536;
+
+// pthread_once() control variable.
+static pthread_once_t once_control = PTHREAD_ONCE_INIT;
+// In-memory copy of the entry hashes.
+static unordered_set<uint64_t> negCacheSet;
+// Set if the on-disk cache has a stale header, e.g. from a
+// previous program version. The file is restarted on the
+// next addUnsupportedFile().
+static bool negCacheFileStale = false;
+// Mutex protecting negCacheSet and file appends.
+static Mutex negCacheMutex;
+
+/**
+ * Get the negative cache filename.
+ * @return Negative cache filename, or empty string on error.
+ */
+static string getNegativeCacheFilename(void)
+{
+	string filename = getCacheDirectory();
+	if (filename.empty())
+		return filename;
+
+	filename += DIR_SEP_CHR;
+	filename += "unsupported.bin";
+	return filename;
+}
+
+/**
+ * fopen() wrapper for UTF-8 filenames.
+ * @param filename Filename. (UTF-8)
+ * @param mode Mode.
+ * @return FILE*, or nullptr on error.
+ */
+static FILE *negCache_fopen(const string &filename, const char *mode)
+{
+#ifdef _WIN32
+	return _wfopen(LibWin32Common::U82W_s(filename).c_str(),
+		LibWin32Common::U82W_c(mode));
+#else /* !_WIN32 */
+	return fopen(filename.c_str(), mode);
+#endif /* _WIN32 */
+}
+
+/**
+ * Write the negative cache file header.
+ * @param f Cache file, positioned at the start.
+ */
+static void negCache_writeHeader(FILE *f)
+{
+	fwrite(NEGCACHE_MAGIC, 1, sizeof(NEGCACHE_MAGIC), f);
+	fwrite(&NEGCACHE_VERSION, 1, sizeof(NEGCACHE_VERSION), f);
+}
+
+/**
+ * Hash a negative cache key using 64-bit FNV-1a.
+ * @param filename	[in] Filename. (UTF-8)
+ * @param szFile	[in] File size.
+ * @param mtime		[in] File mtime.
+ * @param attrs		[in] RomDataFactory attributes used for the probe.
+ * @return 64-bit hash.
+ */
+static uint64_t negCache_hash(const string &filename, int64_t szFile, time_t mtime, unsigned int attrs)
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+
+	const char *p = filename.c_str();
+	for (; *p != '\0'; p++) {
+		hash ^= static_cast<uint8_t>(*p);
+		hash *= 0x00000100000001B3ULL;
+	}
+
+	// Mix in size, mtime, and attributes.
+	uint8_t extra[8+8+4];
+	const int64_t mtime64 = static_cast<int64_t>(mtime);
+	memcpy(&extra[0], &szFile, sizeof(szFile));
+	memcpy(&extra[8], &mtime64, sizeof(mtime64));
+	memcpy(&extra[16], &attrs, sizeof(attrs));
+	for (size_t i = 0; i < sizeof(extra); i++) {
+		hash ^= extra[i];
+		hash *= 0x00000100000001B3ULL;
+	}
+
+	return hash;
+}
+
+/**
+ * Load the negative cache from disk.
+ * Called by pthread_once().
+ */
+static void initNegativeCache(void)
+{
+	const string filename = getNegativeCacheFilename();
+	if (filename.empty())
+		return;
+
+	FILE *f = negCache_fopen(filename, "rb");
+	if (!f) {
+		// No cache file yet.
+		return;
+	}
+
+	// Verify the magic and program version.
+	char magic[sizeof(NEGCACHE_MAGIC)];
+	uint32_t version = 0;
+	if (fread(magic, 1, sizeof(magic), f) != sizeof(magic) ||
+	    memcmp(magic, NEGCACHE_MAGIC, sizeof(magic)) != 0 ||
+	    fread(&version, 1, sizeof(version), f) != sizeof(version) ||
+	    version != NEGCACHE_VERSION)
+	{
+		// Wrong magic, wrong version, or truncated header.
+		negCacheFileStale = true;
+		fclose(f);
+		return;
+	}
+
+	// Read the entry hashes.
+	uint64_t buf[512];
+	size_t n;
+	while ((n = fread(buf, sizeof(uint64_t), ARRAY_SIZE(buf), f)) > 0) {
+		for (size_t i = 0; i < n; i++) {
+			negCacheSet.insert(buf[i]);
+		}
+		if (negCacheSet.size() > NEGCACHE_MAX_ENTRIES) {
+			// Cache is oversized. Discard it; it will be
+			// restarted on the next addUnsupportedFile().
+			negCacheSet.clear();
+			break;
+		}
+	}
+	fclose(f);
+}
+
+/**
+ * Check the persistent negative cache for a file.
+ *
+ * The cache records files that previously probed as unsupported
+ * for a given set of RomDataFactory attributes, so directory scans
+ * don't re-run the full parser probe on every non-ROM file.
+ *
+ * Entries are keyed on a hash of (path, size, mtime, attrs), so a
+ * modified file automatically misses the cache.
+ *
+ * @param filename	[in] Filename. (UTF-8)
+ * @param szFile	[in] File size.
+ * @param mtime		[in] File mtime.
+ * @param attrs		[in] RomDataFactory attributes used for the probe.
+ * @return True if the file is cached as unsupported; false if not.
+ */
+bool isFileUnsupported(const string &filename, int64_t szFile, time_t mtime, unsigned int attrs)
+{
+	if (filename.empty())
+		return false;
+
+	pthread_once(&once_control, initNegativeCache);
+	const uint64_t hash = negCache_hash(filename, szFile, mtime, attrs);
+
+	MutexLocker locker(negCacheMutex);
+	return (negCacheSet.find(hash) != negCacheSet.end());
+}
+
+/**
+ * Add a file to the persistent negative cache.
+ *
+ * Call this after RomDataFactory::create() returns nullptr for
+ * the file with the specified attributes.
+ *
+ * @param filename	[in] Filename. (UTF-8)
+ * @param szFile	[in] File size.
+ * @param mtime		[in] File mtime.
+ * @param attrs		[in] RomDataFactory attributes used for the probe.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int addUnsupportedFile(const string &filename, int64_t szFile, time_t mtime, unsigned int attrs)
+{
+	if (filename.empty())
+		return -EINVAL;
+
+	pthread_once(&once_control, initNegativeCache);
+	const uint64_t hash = negCache_hash(filename, szFile, mtime, attrs);
+
+	MutexLocker locker(negCacheMutex);
+	if (negCacheSet.find(hash) != negCacheSet.end()) {
+		// Already cached.
+		return 0;
+	}
+
+	const string cacheFilename = getNegativeCacheFilename();
+	if (cacheFilename.empty())
+		return -ENOENT;
+
+	if (negCacheFileStale || negCacheSet.size() >= NEGCACHE_MAX_ENTRIES) {
+		// Either the on-disk header is stale (e.g. written by a
+		// previous program version), or the cache is full.
+		// Restart it. Stale entries accumulate over time since
+		// the hashes can't be invalidated individually, so
+		// restarting is the cheapest way to keep the cache
+		// bounded and correct.
+		negCacheSet.clear();
+		FILE *f = negCache_fopen(cacheFilename, "wb");
+		if (!f)
+			return -errno;
+		negCache_writeHeader(f);
+		fclose(f);
+		negCacheFileStale = false;
+	}
+
+	// Append the entry. Create the file with a header first
+	// if it doesn't exist yet.
+	FILE *f = negCache_fopen(cacheFilename, "r+b");
+	if (!f) {
+		f = negCache_fopen(cacheFilename, "wb");
+		if (!f)
+			return -errno;
+		negCache_writeHeader(f);
+	}
+	fseek(f, 0, SEEK_END);
+	size_t sz = fwrite(&hash, 1, sizeof(hash), f);
+	fclose(f);
+	if (sz != sizeof(hash))
+		return -EIO;
+
+	negCacheSet.insert(hash);
+	return 0;
+}
+
+}
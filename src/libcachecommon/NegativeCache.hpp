@@ -0,0 +1,55 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libcachecommon)                   *
+ * NegativeCache.hpp: Persistent "unsupported file" negative cache.        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBCACHECOMMON_NEGATIVECACHE_HPP__
+#define __ROMPROPERTIES_LIBCACHECOMMON_NEGATIVECACHE_HPP__
+
+// C includes.
+#include <stdint.h>
+#include <time.h>
+
+// C++ includes.
+#include <string>
+
+namespace LibCacheCommon {
+
+/**
+ * Check the persistent negative cache for a file.
+ *
+ * The cache records files that previously probed as unsupported
+ * for a given set of RomDataFactory attributes, so directory scans
+ * don't re-run the full parser probe on every non-ROM file.
+ *
+ * Entries are keyed on a hash of (path, size, mtime, attrs), so a
+ * modified file automatically misses the cache.
+ *
+ * @param filename	[in] Filename. (UTF-8)
+ * @param szFile	[in] File size.
+ * @param mtime		[in] File mtime.
+ * @param attrs		[in] RomDataFactory attributes used for the probe.
+ * @return True if the file is cached as unsupported; false if not.
+ */
+bool isFileUnsupported(const std::string &filename, int64_t szFile, time_t mtime, unsigned int attrs);
+
+/**
+ * Add a file to the persistent negative cache.
+ *
+ * Call this after RomDataFactory::create() returns nullptr for
+ * the file with the specified attributes.
+ *
+ * @param filename	[in] Filename. (UTF-8)
+ * @param szFile	[in] File size.
+ * @param mtime		[in] File mtime.
+ * @param attrs		[in] RomDataFactory attributes used for the probe.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int addUnsupportedFile(const std::string &filename, int64_t szFile, time_t mtime, unsigned int attrs);
+
+}
+
+#endif /* __ROMPROPERTIES_LIBCACHECOMMON_NEGATIVECACHE_HPP__ */
@@ -158,7 +158,21 @@ INSTANTIATE_TEST_CASE_P(CacheManagerTest, FilterCacheKeyTest,
 		FilterCacheKeyTest_mode(
 			"\xC2\xA9\x80\xC0\xE0\xF0\xF8\xC0\x80\xE0\x80\xA0\xF0\x82\x82\xAC",
 			"\xC2\xA9______________",
-			"\xC2\xA9______________")
+			"\xC2\xA9______________"),
+
+		// Long runs of plain characters.
+		// Exercises the SIMD fast path, which processes
+		// 16 bytes at a time.
+		FilterCacheKeyTest_mode(
+			"wiiu/coverfullHQ/US/ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789.png",
+			"wiiu/coverfullHQ/US/ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789.png",
+			"wiiu\\coverfullHQ\\US\\ABCDEFGHIJKLMNOPQRSTUVWXYZ0123456789.png"),
+
+		// Long run with a bad character in the middle.
+		FilterCacheKeyTest_mode(
+			"0123456789abcdefghijklmnopqrstuv?0123456789abcdefghijklmnopqrstuv",
+			"0123456789abcdefghijklmnopqrstuv_0123456789abcdefghijklmnopqrstuv",
+			"0123456789abcdefghijklmnopqrstuv_0123456789abcdefghijklmnopqrstuv")
 	));
 } }
 
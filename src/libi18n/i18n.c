@@ -133,6 +133,9 @@ int rp_i18n_init(void)
 		return -1;
 	}
 
+	// Drop any strings translated before the domain was bound.
+	rp_i18n_cache_flush();
+
 	// Initialized.
 	return 0;
 }
@@ -153,6 +156,9 @@ int rp_i18n_init(void)
 		// bindtextdomain() failed.
 		return -1;
 	}
+
+	// Drop any strings translated before the domain was bound.
+	rp_i18n_cache_flush();
 	return 0;
 }
 #endif /* _WIN32 */
@@ -26,8 +26,8 @@
 #ifdef HAVE_GETTEXT
 # include <locale.h>
 # include "gettext.h"
-# define _(msgid)				dgettext(RP_I18N_DOMAIN, msgid)
-# define C_(msgctxt, msgid)			dpgettext(RP_I18N_DOMAIN, msgctxt, msgid)
+# define _(msgid)				rp_dpgettext_cached(NULL, msgid)
+# define C_(msgctxt, msgid)			rp_dpgettext_cached(msgctxt, msgid)
 # define N_(msgid1, msgid2, n)			dngettext(RP_I18N_DOMAIN, msgid1, msgid2, n)
 # define NC_(msgctxt, msgid1, msgid2, n)	dnpgettext(RP_I18N_DOMAIN, msgctxt, msgid1, msgid2, n)
 #else
@@ -54,6 +54,25 @@ extern "C" {
  */
 int rp_i18n_init(void);
 
+/**
+ * Memoized dgettext()/dpgettext() lookup.
+ *
+ * msgctxt and msgid must be compile-time constants;
+ * the cache is keyed on pointer identity.
+ *
+ * @param msgctxt Message context, or NULL for no context.
+ * @param msgid Message ID.
+ * @return Translated string, or msgid if no translation was found.
+ */
+const char *rp_dpgettext_cached(const char *msgctxt, const char *msgid);
+
+/**
+ * Flush the message cache.
+ * Must be called if the text domain is rebound or the
+ * locale is changed after strings have been translated.
+ */
+void rp_i18n_cache_flush(void);
+
 #ifdef __cplusplus
 }
 #endif
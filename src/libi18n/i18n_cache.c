@@ -0,0 +1,238 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libi18n)                          *
+ * i18n_cache.c: Memoized message lookup.                                  *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Since we don't want any code actually compiled here if NLS is disabled,
+// wrap the whole thing in #ifdef ENABLE_NLS.
+
+#include "libi18n/config.libi18n.h"
+#ifdef ENABLE_NLS
+
+#include "i18n.h"
+#ifdef _WIN32
+# include "libwin32common/RpWin32_sdk.h"
+#else /* !_WIN32 */
+# include <pthread.h>
+#endif
+
+// C includes.
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * All msgids (and msgctxts) passed through the i18n macros are
+ * compile-time constants, so their addresses are stable for the
+ * lifetime of the process. That lets us memoize dcgettext()
+ * results in a pointer-keyed hash table: the first lookup of a
+ * given call site goes through libintl's full catalog hash, and
+ * every subsequent lookup is a single open-addressing probe.
+ *
+ * Property sheets re-translate the same ~100 field labels on
+ * every open, so this amortizes libintl overhead across opens
+ * within one process.
+ *
+ * NOTE: The cache memoizes per-process, not per-locale. The
+ * locale is set once at rp_i18n_init(); if it's ever rebound,
+ * rp_i18n_cache_flush() must be called.
+ */
+
+typedef struct _cache_entry_t {
+	const char *msgctxt;	// Key: context, or NULL. (pointer identity)
+	const char *msgid;	// Key: message ID. (pointer identity)
+	const char *msgstr;	// Value: translated string from libintl.
+} cache_entry_t;
+
+// Hash table. (open addressing, linear probing)
+// Capacity is always a power of two.
+static cache_entry_t *g_table = NULL;
+static size_t g_capacity = 0;
+static size_t g_used = 0;
+
+// Initial capacity. Large enough for a typical property
+// sheet's label set without rehashing.
+#define I18N_CACHE_INITIAL_CAPACITY 256
+
+/** Locking **/
+
+#ifdef _WIN32
+// Lazily-initialized CRITICAL_SECTION. (XP-compatible)
+static CRITICAL_SECTION g_cs;
+static volatile LONG g_cs_state = 0;	// 0 == uninit, 1 == initializing, 2 == ready
+
+static void cache_lock(void)
+{
+	if (g_cs_state != 2) {
+		if (InterlockedCompareExchange(&g_cs_state, 1, 0) == 0) {
+			InitializeCriticalSection(&g_cs);
+			InterlockedExchange(&g_cs_state, 2);
+		} else {
+			while (g_cs_state != 2) {
+				Sleep(0);
+			}
+		}
+	}
+	EnterCriticalSection(&g_cs);
+}
+
+static void cache_unlock(void)
+{
+	LeaveCriticalSection(&g_cs);
+}
+#else /* !_WIN32 */
+static pthread_mutex_t g_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static void cache_lock(void)
+{
+	pthread_mutex_lock(&g_mutex);
+}
+
+static void cache_unlock(void)
+{
+	pthread_mutex_unlock(&g_mutex);
+}
+#endif /* _WIN32 */
+
+/**
+ * Hash a (msgctxt, msgid) pointer pair.
+ * @param msgctxt Message context, or NULL.
+ * @param msgid Message ID.
+ * @return Hash value.
+ */
+static uintptr_t cache_hash(const char *msgctxt, const char *msgid)
+{
+	// Fibonacci hashing. Low bits of pointers are mostly zero
+	// due to alignment, so shift them out first.
+	uintptr_t h = ((uintptr_t)msgid >> 2);
+	h ^= ((uintptr_t)msgctxt >> 2) * 31;
+	return h * (uintptr_t)2654435761U;
+}
+
+/**
+ * Insert an entry into a table.
+ * The table must have a free slot.
+ * @param table Hash table.
+ * @param capacity Table capacity. (power of two)
+ * @param entry Entry to insert.
+ */
+static void cache_insert(cache_entry_t *table, size_t capacity, const cache_entry_t *entry)
+{
+	size_t i = (size_t)(cache_hash(entry->msgctxt, entry->msgid) & (capacity - 1));
+	while (table[i].msgid != NULL) {
+		i = (i + 1) & (capacity - 1);
+	}
+	table[i] = *entry;
+}
+
+/**
+ * Grow the hash table to the specified capacity.
+ * Must be called with the lock held.
+ * @param new_capacity New capacity. (power of two)
+ * @return 0 on success; -1 on allocation failure.
+ */
+static int cache_grow(size_t new_capacity)
+{
+	size_t i;
+	cache_entry_t *const new_table = calloc(new_capacity, sizeof(cache_entry_t));
+	if (!new_table) {
+		return -1;
+	}
+
+	// Rehash the existing entries.
+	for (i = 0; i < g_capacity; i++) {
+		if (g_table[i].msgid != NULL) {
+			cache_insert(new_table, new_capacity, &g_table[i]);
+		}
+	}
+
+	free(g_table);
+	g_table = new_table;
+	g_capacity = new_capacity;
+	return 0;
+}
+
+/**
+ * Memoized dgettext()/dpgettext() lookup.
+ *
+ * msgctxt and msgid must be compile-time constants, as required
+ * by the i18n macros; the cache is keyed on pointer identity.
+ *
+ * @param msgctxt Message context, or NULL for no context.
+ * @param msgid Message ID.
+ * @return Translated string, or msgid if no translation was found.
+ */
+const char *rp_dpgettext_cached(const char *msgctxt, const char *msgid)
+{
+	size_t i, mask;
+	const char *msgstr;
+	cache_entry_t entry;
+
+	cache_lock();
+	if (g_capacity != 0) {
+		mask = g_capacity - 1;
+		i = (size_t)(cache_hash(msgctxt, msgid) & mask);
+		for (; g_table[i].msgid != NULL; i = (i + 1) & mask) {
+			if (g_table[i].msgid == msgid && g_table[i].msgctxt == msgctxt) {
+				// Cache hit.
+				msgstr = g_table[i].msgstr;
+				cache_unlock();
+				return msgstr;
+			}
+		}
+	}
+
+	// Cache miss. Do the full libintl lookup.
+	// NOTE: Keeping the lock held; dcgettext() is slow, but misses
+	// only happen once per call site per process.
+	if (msgctxt) {
+		msgstr = dpgettext_expr(RP_I18N_DOMAIN, msgctxt, msgid);
+	} else {
+		msgstr = dgettext(RP_I18N_DOMAIN, msgid);
+	}
+
+	// Insert the result.
+	if (g_capacity == 0) {
+		if (cache_grow(I18N_CACHE_INITIAL_CAPACITY) != 0) {
+			// Allocation failure. Skip caching.
+			cache_unlock();
+			return msgstr;
+		}
+	} else if (g_used >= (g_capacity - (g_capacity / 4))) {
+		// Over 75% load. Grow the table.
+		if (cache_grow(g_capacity * 2) != 0) {
+			// Allocation failure. Skip caching.
+			cache_unlock();
+			return msgstr;
+		}
+	}
+
+	entry.msgctxt = msgctxt;
+	entry.msgid = msgid;
+	entry.msgstr = msgstr;
+	cache_insert(g_table, g_capacity, &entry);
+	g_used++;
+
+	cache_unlock();
+	return msgstr;
+}
+
+/**
+ * Flush the message cache.
+ * Must be called if the text domain is rebound or the
+ * locale is changed after strings have been translated.
+ */
+void rp_i18n_cache_flush(void)
+{
+	cache_lock();
+	free(g_table);
+	g_table = NULL;
+	g_capacity = 0;
+	g_used = 0;
+	cache_unlock();
+}
+
+#endif /* ENABLE_NLS */
@@ -40,6 +40,13 @@ class PSFPrivate : public RomDataPrivate
 		// NOTE: **NOT** byteswapped in memory.
 		PSF_Header psfHeader;
 
+		// Parsed tag section.
+		// The tag section is read from disk at most once per
+		// open file; loadFieldData() and loadMetaData() share
+		// the cached result.
+		bool tagsLoaded;
+		unordered_map<string, string> tags;
+
 		/**
 		 * Parse the tag section.
 		 * @param tag_addr Tag section starting address.
@@ -47,6 +54,15 @@ class PSFPrivate : public RomDataPrivate
 		 */
 		unordered_map<string, string> parseTags(off64_t tag_addr);
 
+		/**
+		 * Get the parsed tag section. (cached)
+		 * The tag section address is computed from psfHeader.
+		 * The tags are parsed on the first call only;
+		 * subsequent calls return the cached result.
+		 * @return Map containing key/value entries.
+		 */
+		const unordered_map<string, string> &psfTags(void);
+
 		/**
 		 * Get the "ripped by" tag name for the specified PSF version.
 		 * @param version PSF version.
@@ -66,6 +82,7 @@ class PSFPrivate : public RomDataPrivate
 
 PSFPrivate::PSFPrivate(PSF *q, IRpFile *file)
 	: super(q, file)
+	, tagsLoaded(false)
 {
 	// Clear the PSF header struct.
 	memset(&psfHeader, 0, sizeof(psfHeader));
@@ -168,6 +185,25 @@ unordered_map<string, string> PSFPrivate::parseTags(off64_t tag_addr)
 	return kv;
 }
 
+/**
+ * Get the parsed tag section. (cached)
+ * The tag section address is computed from psfHeader.
+ * The tags are parsed on the first call only;
+ * subsequent calls return the cached result.
+ * @return Map containing key/value entries.
+ */
+const unordered_map<string, string> &PSFPrivate::psfTags(void)
+{
+	if (!tagsLoaded) {
+		const off64_t tag_addr = (off64_t)sizeof(psfHeader) +
+			le32_to_cpu(psfHeader.reserved_size) +
+			le32_to_cpu(psfHeader.compressed_prg_length);
+		tags = parseTags(tag_addr);
+		tagsLoaded = true;
+	}
+	return tags;
+}
+
 /**
  * Get the "ripped by" tag name for the specified PSF version.
  * @param version PSF version.
@@ -567,10 +603,7 @@ int PSF::loadFieldData(void)
 	}
 
 	// Parse the tags.
-	const off64_t tag_addr = (off64_t)sizeof(*psfHeader) +
-		le32_to_cpu(psfHeader->reserved_size) +
-		le32_to_cpu(psfHeader->compressed_prg_length);
-	unordered_map<string, string> tags = d->parseTags(tag_addr);
+	const unordered_map<string, string> &tags = d->psfTags();
 
 	if (!tags.empty()) {
 		// Title
@@ -682,14 +715,8 @@ int PSF::loadMetaData(void)
 		return -EIO;
 	}
 
-	// PSF header.
-	const PSF_Header *const psfHeader = &d->psfHeader;
-
 	// Attempt to parse the tags before doing anything else.
-	const off64_t tag_addr = (off64_t)sizeof(*psfHeader) +
-		le32_to_cpu(psfHeader->reserved_size) +
-		le32_to_cpu(psfHeader->compressed_prg_length);
-	unordered_map<string, string> tags = d->parseTags(tag_addr);
+	const unordered_map<string, string> &tags = d->psfTags();
 
 	if (tags.empty()) {
 		// No tags.
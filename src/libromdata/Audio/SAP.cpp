@@ -78,17 +78,31 @@ class SAPPrivate : public RomDataPrivate
 		 */
 		static int durationToMsLoop(const char *str, uint32_t *pMs, bool *pLoop);
 
+		// Cached tag data.
+		// The text header is read and tokenized once per open file;
+		// loadFieldData() and loadMetaData() share the result.
+		bool tagsLoaded;
+		TagData tags;
+
 		/**
 		 * Parse the tags from the open SAP file.
 		 * @return TagData object.
 		 */
 		TagData parseTags(void);
+
+		/**
+		 * Get the parsed tags, parsing them if necessary.
+		 * The tags are only parsed once per open file.
+		 * @return TagData object. (check tags_read)
+		 */
+		const TagData &sapTags(void);
 };
 
 /** SAPPrivate **/
 
 SAPPrivate::SAPPrivate(SAP *q, IRpFile *file)
 	: super(q, file)
+	, tagsLoaded(false)
 { }
 
 /**
@@ -415,6 +429,20 @@ SAPPrivate::TagData SAPPrivate::parseTags(void)
 	return tags;
 }
 
+/**
+ * Get the parsed tags, parsing them if necessary.
+ * The tags are only parsed once per open file.
+ * @return TagData object. (check tags_read)
+ */
+const SAPPrivate::TagData &SAPPrivate::sapTags(void)
+{
+	if (!tagsLoaded) {
+		this->tags = parseTags();
+		tagsLoaded = true;
+	}
+	return this->tags;
+}
+
 /** SAP **/
 
 /**
@@ -589,7 +617,7 @@ int SAP::loadFieldData(void)
 	}
 
 	// Get the tags.
-	SAPPrivate::TagData tags = d->parseTags();
+	const SAPPrivate::TagData &tags = d->sapTags();
 	if (!tags.tags_read) {
 		// No tags.
 		return 0;
@@ -748,7 +776,7 @@ int SAP::loadMetaData(void)
 	}
 
 	// Get the tags.
-	SAPPrivate::TagData tags = d->parseTags();
+	const SAPPrivate::TagData &tags = d->sapTags();
 	if (!tags.tags_read) {
 		// No tags.
 		return 0;
@@ -93,17 +93,32 @@ class SNDHPrivate : public RomDataPrivate
 		 */
 		static unsigned int readAsciiNumberFromBuffer(const uint8_t **p, const uint8_t *p_end, bool *p_err);
 
+		// Cached tag data.
+		// ICE-packed files are decompressed when the tags are first
+		// parsed, so loadFieldData() and loadMetaData() must share
+		// the result instead of depacking the file twice.
+		bool tagsLoaded;
+		TagData tags;
+
 		/**
 		 * Parse the tags from the open SNDH file.
 		 * @return TagData object.
 		 */
 		TagData parseTags(void);
+
+		/**
+		 * Get the parsed tags, parsing them if necessary.
+		 * The tags are only parsed once per open file.
+		 * @return TagData object. (check tags_read)
+		 */
+		const TagData &sndhTags(void);
 };
 
 /** SNDHPrivate **/
 
 SNDHPrivate::SNDHPrivate(SNDH *q, IRpFile *file)
 	: super(q, file)
+	, tagsLoaded(false)
 { }
 
 /**
@@ -588,6 +603,20 @@ SNDHPrivate::TagData SNDHPrivate::parseTags(void)
 	return tags;
 }
 
+/**
+ * Get the parsed tags, parsing them if necessary.
+ * The tags are only parsed once per open file.
+ * @return TagData object. (check tags_read)
+ */
+const SNDHPrivate::TagData &SNDHPrivate::sndhTags(void)
+{
+	if (!tagsLoaded) {
+		this->tags = parseTags();
+		tagsLoaded = true;
+	}
+	return this->tags;
+}
+
 /** SNDH **/
 
 /**
@@ -805,7 +834,7 @@ int SNDH::loadFieldData(void)
 	}
 
 	// Get the tags.
-	SNDHPrivate::TagData tags = d->parseTags();
+	const SNDHPrivate::TagData &tags = d->sndhTags();
 	if (!tags.tags_read) {
 		// No tags.
 		return 0;
@@ -995,7 +1024,7 @@ int SNDH::loadMetaData(void)
 	}
 
 	// Get the tags.
-	SNDHPrivate::TagData tags = d->parseTags();
+	const SNDHPrivate::TagData &tags = d->sndhTags();
 	if (!tags.tags_read) {
 		// No tags.
 		return 0;
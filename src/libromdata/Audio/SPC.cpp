@@ -87,6 +87,14 @@ class SPCPrivate : public RomDataPrivate
 			{
 				return map.find(key);
 			}
+			inline map_t::const_iterator find(SPC_xID6_Item_e key) const
+			{
+				return map.find(key);
+			}
+			inline map_t::const_iterator end(void) const
+			{
+				return map.end();
+			}
 			inline map_t::iterator begin(void)
 			{
 				return map.begin();
@@ -162,17 +170,33 @@ class SPCPrivate : public RomDataPrivate
 			}
 		};
 
+		// Parsed ID666 / Extended ID666 tags.
+		// The xID6 block is read from disk at most once per
+		// open file; loadFieldData() and loadMetaData() share
+		// the cached result.
+		bool tagsLoaded;
+		TagData tags;
+
 		/**
 		 * Parse the ID666 tags for the open SPC file.
 		 * @return Map containing key/value entries.
 		 */
 		TagData parseTags(void);
+
+		/**
+		 * Get the parsed ID666 tags. (cached)
+		 * The tags are parsed on the first call only;
+		 * subsequent calls return the cached result.
+		 * @return Parsed tags.
+		 */
+		const TagData &spcTags(void);
 };
 
 /** SPCPrivate **/
 
 SPCPrivate::SPCPrivate(SPC *q, IRpFile *file)
 	: super(q, file)
+	, tagsLoaded(false)
 {
 	// Clear the SPC header struct.
 	memset(&spcHeader, 0, sizeof(spcHeader));
@@ -479,6 +503,21 @@ SPCPrivate::TagData SPCPrivate::parseTags(void)
 	return kv;
 }
 
+/**
+ * Get the parsed ID666 tags. (cached)
+ * The tags are parsed on the first call only;
+ * subsequent calls return the cached result.
+ * @return Parsed tags.
+ */
+const SPCPrivate::TagData &SPCPrivate::spcTags(void)
+{
+	if (!tagsLoaded) {
+		tags = parseTags();
+		tagsLoaded = true;
+	}
+	return tags;
+}
+
 /** SPC **/
 
 /**
@@ -652,7 +691,7 @@ int SPC::loadFieldData(void)
 	}
 
 	// Get the ID666 tags.
-	auto kv = d->parseTags();
+	const auto &kv = d->spcTags();
 	if (kv.empty()) {
 		// No tags.
 		return 0;
@@ -838,7 +877,7 @@ int SPC::loadMetaData(void)
 	}
 
 	// Get the ID666 tags.
-	auto kv = d->parseTags();
+	const auto &kv = d->spcTags();
 	if (kv.empty()) {
 		// No tags.
 		// TODO: Return 0 instead of -ENOENT?
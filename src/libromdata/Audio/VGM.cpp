@@ -45,25 +45,49 @@ class VGMPrivate : public RomDataPrivate
 		 */
 		string formatClockRate(unsigned int clock_rate);
 
-		// GD3 tags.
-		// All strings must be in UTF-8 format.
-		typedef array<string, GD3_TAG_MAX> gd3_tags_t;
+		// Raw GD3 tag block.
+		// Loaded from disk at most once per open file.
+		// Individual tags are converted from UTF-16LE to UTF-8
+		// on demand by gd3_tag(), so tags that are never
+		// displayed are never converted.
+		bool gd3_loaded;	// Has a load been attempted?
+		unique_ptr<char16_t[]> gd3_data;
+
+		// Tag positions within gd3_data, in char16_t units.
+		struct gd3_span_t {
+			uint32_t start;
+			uint32_t len;
+		};
+		array<gd3_span_t, GD3_TAG_MAX> gd3_spans;
+
+		/**
+		 * Load the GD3 tag block.
+		 * The starting address is taken from vgmHeader.gd3_offset.
+		 * The block is read from disk on the first call only;
+		 * subsequent calls return the cached result.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadGD3(void);
 
 		/**
-		 * Load GD3 tags.
-		 * @param addr Starting address of the GD3 tag block.
-		 * @return Allocated GD3 tags, or nullptr on error.
+		 * Get a GD3 tag, converted to UTF-8.
+		 * Loads the GD3 tag block if it hasn't been loaded yet.
+		 * @param idx GD3 tag index.
+		 * @return Tag, or empty string if not present.
 		 */
-		gd3_tags_t *loadGD3(unsigned int addr);
+		string gd3_tag(GD3_TAG_ID idx);
 };
 
 /** VGMPrivate **/
 
 VGMPrivate::VGMPrivate(VGM *q, IRpFile *file)
 	: super(q, file)
+	, gd3_loaded(false)
 {
 	// Clear the VGM header struct.
 	memset(&vgmHeader, 0, sizeof(vgmHeader));
+	// Clear the GD3 tag spans.
+	memset(gd3_spans.data(), 0, sizeof(gd3_span_t) * gd3_spans.size());
 }
 
 /**
@@ -97,23 +121,40 @@ string VGMPrivate::formatClockRate(unsigned int clock_rate)
 }
 
 /**
- * Load GD3 tags.
- * @param addr Starting address of the GD3 tag block.
- * @return Allocated GD3 tags, or nullptr on error.
+ * Load the GD3 tag block.
+ * The starting address is taken from vgmHeader.gd3_offset.
+ * The block is read from disk on the first call only;
+ * subsequent calls return the cached result.
+ * @return 0 on success; negative POSIX error code on error.
  */
-VGMPrivate::gd3_tags_t *VGMPrivate::loadGD3(unsigned int addr)
+int VGMPrivate::loadGD3(void)
 {
+	if (gd3_loaded) {
+		// A load was already attempted.
+		return (gd3_data ? 0 : -ENOENT);
+	}
+	gd3_loaded = true;
+
 	assert(file != nullptr);
 	assert(file->isOpen());
 	if (!file || !file->isOpen()) {
-		return nullptr;
+		return -EBADF;
 	}
 
+	// NOTE: Not byteswapping when checking for 0 because
+	// 0 in big-endian is the same as 0 in little-endian.
+	if (vgmHeader.gd3_offset == 0) {
+		// No GD3 tags.
+		return -ENOENT;
+	}
+	// TODO: Make sure the GD3 offset is stored after the header.
+	const unsigned int addr = le32_to_cpu(vgmHeader.gd3_offset) + offsetof(VGM_Header, gd3_offset);
+
 	GD3_Header gd3Header;
 	size_t size = file->seekAndRead(addr, &gd3Header, sizeof(gd3Header));
 	if (size != sizeof(gd3Header)) {
 		// Seek and/or read error.
-		return nullptr;
+		return -EIO;
 	}
 
 	// Validate the header.
@@ -122,7 +163,7 @@ VGMPrivate::gd3_tags_t *VGMPrivate::loadGD3(unsigned int addr)
 	{
 		// Incorrect header.
 		// TODO: Require exactly v1.00?
-		return nullptr;
+		return -EIO;
 	}
 
 	// Length limitations:
@@ -131,36 +172,39 @@ VGMPrivate::gd3_tags_t *VGMPrivate::loadGD3(unsigned int addr)
 	const unsigned int length = le32_to_cpu(gd3Header.length);
 	if (length % 2 != 0 || length < 11*2 || length > 16*1024) {
 		// Incorrect length value.
-		return nullptr;
+		return -EIO;
 	}
 
 	// Read the GD3 data.
+	// NOTE: This is a sequential read following the header,
+	// so the whole tag block is loaded with a single seek.
 	const unsigned int length16 = length / 2;
 	unique_ptr<char16_t[]> gd3(new char16_t[length16]);
 	size = file->read(gd3.get(), length);
 	if (size != length) {
 		// Read error.
-		return nullptr;
+		return -EIO;
 	}
 
 	// Make sure the end of the GD3 data is NULL-terminated.
 	if (gd3[length16-1] != 0) {
 		// Not NULL-terminated.
-		return nullptr;
+		return -EIO;
 	}
 
-	gd3_tags_t *gd3_tags = new gd3_tags_t;
-
-	// Convert from NULL-terminated strings to gd3_tags_t.
-	// TODO: Optimize on systems where wchar_t functions are 16-bit?
+	// Index the NULL-terminated strings. UTF-8 conversion is
+	// deferred to gd3_tag(), so tags that are never displayed
+	// are never converted.
 	size_t tag_idx = 0;
-	const char16_t *start = gd3.get();
-	const char16_t *const endptr = start + length16;
-	for (const char16_t *p = start; p < endptr && tag_idx < gd3_tags->size(); p++) {
+	const char16_t *const base = gd3.get();
+	const char16_t *start = base;
+	const char16_t *const endptr = base + length16;
+	for (const char16_t *p = start; p < endptr && tag_idx < gd3_spans.size(); p++) {
 		// Check for a NULL.
 		if (*p == 0) {
 			// Found a NULL!
-			(*gd3_tags)[tag_idx] = utf16le_to_utf8(start, (int)(p-start));
+			gd3_spans[tag_idx].start = static_cast<uint32_t>(start - base);
+			gd3_spans[tag_idx].len = static_cast<uint32_t>(p - start);
 			// Next string.
 			start = p + 1;
 			tag_idx++;
@@ -168,7 +212,36 @@ VGMPrivate::gd3_tags_t *VGMPrivate::loadGD3(unsigned int addr)
 	}
 
 	// TODO: Return an error if there's more than GD3_TAG_MAX strings?
-	return gd3_tags;
+	gd3_data = std::move(gd3);
+	return 0;
+}
+
+/**
+ * Get a GD3 tag, converted to UTF-8.
+ * Loads the GD3 tag block if it hasn't been loaded yet.
+ * @param idx GD3 tag index.
+ * @return Tag, or empty string if not present.
+ */
+string VGMPrivate::gd3_tag(GD3_TAG_ID idx)
+{
+	assert(idx < GD3_TAG_MAX);
+	if (idx >= GD3_TAG_MAX) {
+		return string();
+	}
+
+	if (loadGD3() != 0) {
+		// No GD3 tags.
+		return string();
+	}
+
+	const gd3_span_t &span = gd3_spans[idx];
+	if (span.len == 0) {
+		// Empty tag.
+		return string();
+	}
+
+	// TODO: Optimize on systems where wchar_t functions are 16-bit?
+	return utf16le_to_utf8(&gd3_data[span.start], static_cast<int>(span.len));
 }
 
 /** VGM **/
@@ -381,54 +454,48 @@ int VGM::loadFieldData(void)
 	// 0 in big-endian is the same as 0 in little-endian.
 
 	// GD3 tags.
-	if (d->vgmHeader.gd3_offset != 0) {
-		// TODO: Make sure the GD3 offset is stored after the header.
-		const unsigned int addr = le32_to_cpu(d->vgmHeader.gd3_offset) + offsetof(VGM_Header, gd3_offset);
-		VGMPrivate::gd3_tags_t *const gd3_tags = d->loadGD3(addr);
-		if (gd3_tags) {
-			// TODO: Option to show Japanese instead of English.
-
-			// Array of GD3 tag indexes and translatable strings.
+	if (d->loadGD3() == 0) {
+		// TODO: Option to show Japanese instead of English.
+
+		// Array of GD3 tag indexes and translatable strings.
 #ifdef ENABLE_NLS
-			struct gd3_tag_field_tbl_t {
-				const char *ctx;	// Translation context
-				const char *desc;	// Description
-				GD3_TAG_ID idx;	// GD3 tag index
-			};
+		struct gd3_tag_field_tbl_t {
+			const char *ctx;	// Translation context
+			const char *desc;	// Description
+			GD3_TAG_ID idx;	// GD3 tag index
+		};
 #define GD3_TAG_FIELD_TBL_ENTRY(ctx, desc, idx) \
-			{(ctx), (desc), (idx)}
+		{(ctx), (desc), (idx)}
 #else /* !ENABLE_NLS */
-			struct gd3_tag_field_tbl_t {
-				const char *desc;	// Description
-				GD3_TAG_ID idx;	// GD3 tag index
-			};
+		struct gd3_tag_field_tbl_t {
+			const char *desc;	// Description
+			GD3_TAG_ID idx;	// GD3 tag index
+		};
 #define GD3_TAG_FIELD_TBL_ENTRY(ctx, desc, idx) \
-			{(desc), (idx)}
+		{(desc), (idx)}
 #endif /* ENABLE_NLS */
 
-			// TODO: Multiple composer handling.
-			static const gd3_tag_field_tbl_t gd3_tag_field_tbl[] = {
-				GD3_TAG_FIELD_TBL_ENTRY("RomData|Audio",	NOP_C_("RomData|Audio", "Track Name"),	GD3_TAG_TRACK_NAME_EN),
-				GD3_TAG_FIELD_TBL_ENTRY("VGM",			NOP_C_("VGM", "Game Name"),		GD3_TAG_GAME_NAME_EN),
-				GD3_TAG_FIELD_TBL_ENTRY("VGM",			NOP_C_("VGM", "System Name"),		GD3_TAG_SYSTEM_NAME_EN),
-				GD3_TAG_FIELD_TBL_ENTRY("RomData|Audio",	NOP_C_("RomData|Audio", "Composer"),	GD3_TAG_TRACK_AUTHOR_EN),
-				GD3_TAG_FIELD_TBL_ENTRY("RomData",		NOP_C_("RomData", "Release Date"),	GD3_TAG_DATE_GAME_RELEASE),
-				GD3_TAG_FIELD_TBL_ENTRY("VGM",			NOP_C_("VGM", "VGM Ripper"),		GD3_TAG_VGM_RIPPER),
-				GD3_TAG_FIELD_TBL_ENTRY("RomData|Audio",	NOP_C_("RomData|Audio", "Notes"),	GD3_TAG_NOTES),
-
-				GD3_TAG_FIELD_TBL_ENTRY(nullptr, nullptr, GD3_TAG_MAX)
-			};
-
-			for (const gd3_tag_field_tbl_t *pTag = gd3_tag_field_tbl; pTag->desc != nullptr; pTag++) {
-				const string &str = (*gd3_tags)[pTag->idx];
-				if (!str.empty()) {
-					d->fields->addField_string(
-						dpgettext_expr(RP_I18N_DOMAIN, pTag->ctx, pTag->desc), str);
-				}
-			}
+		// TODO: Multiple composer handling.
+		static const gd3_tag_field_tbl_t gd3_tag_field_tbl[] = {
+			GD3_TAG_FIELD_TBL_ENTRY("RomData|Audio",	NOP_C_("RomData|Audio", "Track Name"),	GD3_TAG_TRACK_NAME_EN),
+			GD3_TAG_FIELD_TBL_ENTRY("VGM",			NOP_C_("VGM", "Game Name"),		GD3_TAG_GAME_NAME_EN),
+			GD3_TAG_FIELD_TBL_ENTRY("VGM",			NOP_C_("VGM", "System Name"),		GD3_TAG_SYSTEM_NAME_EN),
+			GD3_TAG_FIELD_TBL_ENTRY("RomData|Audio",	NOP_C_("RomData|Audio", "Composer"),	GD3_TAG_TRACK_AUTHOR_EN),
+			GD3_TAG_FIELD_TBL_ENTRY("RomData",		NOP_C_("RomData", "Release Date"),	GD3_TAG_DATE_GAME_RELEASE),
+			GD3_TAG_FIELD_TBL_ENTRY("VGM",			NOP_C_("VGM", "VGM Ripper"),		GD3_TAG_VGM_RIPPER),
+			GD3_TAG_FIELD_TBL_ENTRY("RomData|Audio",	NOP_C_("RomData|Audio", "Notes"),	GD3_TAG_NOTES),
+
+			GD3_TAG_FIELD_TBL_ENTRY(nullptr, nullptr, GD3_TAG_MAX)
+		};
 
-			delete gd3_tags;
+		for (const gd3_tag_field_tbl_t *pTag = gd3_tag_field_tbl; pTag->desc != nullptr; pTag++) {
+			const string str = d->gd3_tag(pTag->idx);
+			if (!str.empty()) {
+				d->fields->addField_string(
+					dpgettext_expr(RP_I18N_DOMAIN, pTag->ctx, pTag->desc), str);
+			}
 		}
+
 	}
 
 	// Duration [1.00]
@@ -883,65 +950,59 @@ int VGM::loadMetaData(void)
 		convSampleToMs(le32_to_cpu(vgmHeader->sample_count), VGM_SAMPLE_RATE));
 
 	// Attempt to load the GD3 tags.
-	if (d->vgmHeader.gd3_offset != 0) {
-		// TODO: Make sure the GD3 offset is stored after the header.
-		const unsigned int addr = le32_to_cpu(d->vgmHeader.gd3_offset) + offsetof(VGM_Header, gd3_offset);
-		VGMPrivate::gd3_tags_t *const gd3_tags = d->loadGD3(addr);
-		if (gd3_tags) {
-			// TODO: Option to show Japanese instead of English.
-
-			// Array of GD3 tag indexes and properties.
-			struct gd3_tag_prop_tbl_t {
-				Property::Property prop;	// Metadata property index
-				GD3_TAG_ID idx;			// GD3 tag index
-			};
-
-			static const gd3_tag_prop_tbl_t gd3_tag_prop_tbl[] = {
-				{Property::Title,	GD3_TAG_TRACK_NAME_EN},
-				{Property::Album,	GD3_TAG_GAME_NAME_EN},		// NOTE: Not exactly "album"...
-				//{Property::SystemName,	GD3_TAG_SYSTEM_NAME_EN),	// FIXME: No property for this...
-				{Property::Composer,	GD3_TAG_TRACK_AUTHOR_EN},	// TODO: Multiple composer handling.
-				{Property::ReleaseYear,	GD3_TAG_DATE_GAME_RELEASE},
-				//{Property::VGMRipper,	GD3_TAG_VGM_RIPPER},		// FIXME: No property for this...
-
-				// TODO: Property::Comment is assumed to be user-added
-				// on KDE Dolphin 18.08.1. Needs a description property.
-				// Also needs verification on Windows.
-				{Property::Subject,	GD3_TAG_NOTES},
-
-				{Property::Empty,	GD3_TAG_MAX}
-			};
-
-			for (const gd3_tag_prop_tbl_t *pTag = gd3_tag_prop_tbl; pTag->prop != Property::Empty; pTag++) {
-				const string &str = (*gd3_tags)[pTag->idx];
-				if (str.empty())
-					continue;
-
-				if (pTag->prop == Property::ReleaseYear) {
-					// Special handling for ReleaseYear.
-
-					// Parse the release date.
-					// NOTE: Only year is supported.
-					int year;
-					char chr;
-					int s = sscanf((*gd3_tags)[GD3_TAG_DATE_GAME_RELEASE].c_str(), "%04d%c", &year, &chr);
-					if (s == 1 || (s == 2 && (chr == '-' || chr == '/'))) {
-						// Year seems to be valid.
-						// Make sure the number is acceptable:
-						// - No negatives.
-						// - Four-digit only. (lol Y10K)
-						if (year >= 0 && year < 10000) {
-							d->metaData->addMetaData_uint(Property::ReleaseYear, (unsigned int)year);
-						}
+	if (d->loadGD3() == 0) {
+		// TODO: Option to show Japanese instead of English.
+
+		// Array of GD3 tag indexes and properties.
+		struct gd3_tag_prop_tbl_t {
+			Property::Property prop;	// Metadata property index
+			GD3_TAG_ID idx;			// GD3 tag index
+		};
+
+		static const gd3_tag_prop_tbl_t gd3_tag_prop_tbl[] = {
+			{Property::Title,	GD3_TAG_TRACK_NAME_EN},
+			{Property::Album,	GD3_TAG_GAME_NAME_EN},		// NOTE: Not exactly "album"...
+			//{Property::SystemName,	GD3_TAG_SYSTEM_NAME_EN),	// FIXME: No property for this...
+			{Property::Composer,	GD3_TAG_TRACK_AUTHOR_EN},	// TODO: Multiple composer handling.
+			{Property::ReleaseYear,	GD3_TAG_DATE_GAME_RELEASE},
+			//{Property::VGMRipper,	GD3_TAG_VGM_RIPPER},		// FIXME: No property for this...
+
+			// TODO: Property::Comment is assumed to be user-added
+			// on KDE Dolphin 18.08.1. Needs a description property.
+			// Also needs verification on Windows.
+			{Property::Subject,	GD3_TAG_NOTES},
+
+			{Property::Empty,	GD3_TAG_MAX}
+		};
+
+		for (const gd3_tag_prop_tbl_t *pTag = gd3_tag_prop_tbl; pTag->prop != Property::Empty; pTag++) {
+			const string str = d->gd3_tag(pTag->idx);
+			if (str.empty())
+				continue;
+
+			if (pTag->prop == Property::ReleaseYear) {
+				// Special handling for ReleaseYear.
+
+				// Parse the release date.
+				// NOTE: Only year is supported.
+				int year;
+				char chr;
+				int s = sscanf(str.c_str(), "%04d%c", &year, &chr);
+				if (s == 1 || (s == 2 && (chr == '-' || chr == '/'))) {
+					// Year seems to be valid.
+					// Make sure the number is acceptable:
+					// - No negatives.
+					// - Four-digit only. (lol Y10K)
+					if (year >= 0 && year < 10000) {
+						d->metaData->addMetaData_uint(Property::ReleaseYear, (unsigned int)year);
 					}
-				} else {
-					// Standard string property.
-					d->metaData->addMetaData_string(pTag->prop, str);
 				}
+			} else {
+				// Standard string property.
+				d->metaData->addMetaData_string(pTag->prop, str);
 			}
-
-			delete gd3_tags;
 		}
+
 	}
 
 	// Finished reading the metadata.
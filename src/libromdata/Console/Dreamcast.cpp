@@ -24,6 +24,7 @@ using LibRpTexture::SegaPVR;
 
 // DiscReader
 #include "disc/Cdrom2352Reader.hpp"
+#include "disc/ChdReader.hpp"
 #include "disc/IsoPartition.hpp"
 #include "disc/GdiReader.hpp"
 
@@ -56,6 +57,7 @@ class DreamcastPrivate : public RomDataPrivate
 			DISC_ISO_2048		= 0,	// ISO-9660, 2048-byte sectors.
 			DISC_ISO_2352		= 1,	// ISO-9660, 2352-byte sectors.
 			DISC_GDI		= 2,	// GD-ROM cuesheet
+			DISC_CHD		= 3,	// MAME CHD image
 		};
 
 		// Disc type and reader.
@@ -357,6 +359,54 @@ Dreamcast::Dreamcast(IRpFile *file)
 			d->iso_start_offset = static_cast<int>(cdrom_msf_to_lba(&sector.msf));
 			break;
 
+		case DreamcastPrivate::DISC_CHD: {
+			// MAME CHD image.
+			// NOTE: Detection only checked the CHD header, so the
+			// disc contents have to be verified here.
+			ChdReader *const chdReader = new ChdReader(d->file);
+			if (!chdReader->isOpen()) {
+				// Unable to open the CHD image.
+				// (Unsupported codec, parent CHD, etc.)
+				delete chdReader;
+				d->file->unref();
+				d->file = nullptr;
+				return;
+			}
+			d->discReader = chdReader;
+
+			// Check for IP.bin at LBA 0 (CD) and at LBA 45000,
+			// the start of the GD-ROM high-density area.
+			static const int lba_check[2] = {0, 45000};
+			bool found = false;
+			for (unsigned int i = 0; i < ARRAY_SIZE(lba_check); i++) {
+				size = d->discReader->seekAndRead(
+					static_cast<off64_t>(lba_check[i]) * 2048,
+					&d->discHeader, sizeof(d->discHeader));
+				if (size != sizeof(d->discHeader)) {
+					break;
+				}
+				if (!memcmp(d->discHeader.hw_id, DC_IP0000_BIN_HW_ID, sizeof(d->discHeader.hw_id)) &&
+				    !memcmp(d->discHeader.maker_id, DC_IP0000_BIN_MAKER_ID, sizeof(d->discHeader.maker_id)))
+				{
+					// Found IP.bin.
+					d->iso_start_offset = (lba_check[i] > 0 ? lba_check[i] : -1);
+					found = true;
+					break;
+				}
+			}
+			if (!found) {
+				// Not a Dreamcast disc.
+				delete d->discReader;
+				d->discReader = nullptr;
+				d->file->unref();
+				d->file = nullptr;
+				return;
+			}
+
+			d->mimeType = "application/x-mame-chd";	// unofficial, not on fd.o
+			break;
+		}
+
 		case DreamcastPrivate::DISC_GDI: {
 			// GD-ROM cuesheet.
 			// iso_start_offset isn't used for GDI.
@@ -438,6 +488,15 @@ int Dreamcast::isRomSupported_static(const DetectInfo *info)
 		}
 	}
 
+	// Check for a CHD image.
+	// NOTE: Only the CHD header can be checked here. The disc
+	// contents are verified in the constructor, so non-Dreamcast
+	// CHD images will fail to open.
+	if (ChdReader::isDiscSupported_static(info->header.pData, info->header.size) >= 0) {
+		// This is a CHD image.
+		return DreamcastPrivate::DISC_CHD;
+	}
+
 	// For files that aren't cuesheets, check for a minimum file size.
 	if (info->header.size < sizeof(CDROM_2352_Sector_t)) {
 		// Header is too small.
@@ -519,6 +578,7 @@ const char *const *Dreamcast::supportedFileExtensions_static(void)
 		".iso",	// ISO-9660 (2048-byte)
 		".bin",	// Raw (2352-byte)
 		".gdi",	// GD-ROM cuesheet
+		".chd",	// MAME CHD image
 
 		// TODO: Add these formats?
 		//".cdi",	// DiscJuggler
@@ -546,6 +606,7 @@ const char *const *Dreamcast::supportedMimeTypes_static(void)
 		"application/x-dreamcast-rom",
 		"application/x-dreamcast-iso-image",
 		"application/x-dreamcast-cuesheet",
+		"application/x-mame-chd",
 
 		// Unofficial MIME types from FreeDesktop.org.
 		// TODO: Get the above types upstreamed and get rid of this.
@@ -812,7 +873,10 @@ int Dreamcast::loadFieldData(void)
 	// TODO: Get from GdiReader for GDI.
 	if (d->discType == DreamcastPrivate::DISC_GDI) {
 		// Open track 3 as ISO-9660.
-		ISO *const isoData = d->gdiReader->openIsoRomData(3);
+		// If the ISO-9660 partition was opened for the icon,
+		// its cached PVD is reused here.
+		ISO *const isoData = d->gdiReader->openIsoRomData(3,
+			d->isoPartition ? d->isoPartition->pvd() : nullptr);
 		if (isoData) {
 			if (isoData->isOpen()) {
 				// Add the fields.
@@ -827,9 +891,12 @@ int Dreamcast::loadFieldData(void)
 		}
 	} else {
 		// ISO object for ISO-9660 PVD
+		// If the ISO-9660 partition was opened for the icon,
+		// its cached PVD is reused here.
 		PartitionFile *const isoFile = new PartitionFile(d->discReader, 0, d->discReader->size());
 		if (isoFile->isOpen()) {
-			ISO *const isoData = new ISO(isoFile);
+			ISO *const isoData = new ISO(isoFile,
+				d->isoPartition ? d->isoPartition->pvd() : nullptr);
 			if (isoData->isOpen()) {
 				// Add the fields.
 				const RomFields *const isoFields = isoData->fields();
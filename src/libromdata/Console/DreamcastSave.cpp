@@ -323,7 +323,7 @@ unsigned int DreamcastSavePrivate::readAndVerifyVmsHeader(uint32_t address)
 	{
 		// This is probably ICONDATA_VMS.
 		if (this->saveType == SAVE_TYPE_DCI) {
-			__byte_swap_32_array(vms_header.dci_dword, sizeof(vms_header.icondata_vms));
+			rp_byte_swap_32_array<sizeof(vms_header.icondata_vms)>(vms_header.dci_dword);
 		}
 
 		// Byteswap the fields.
@@ -341,7 +341,7 @@ unsigned int DreamcastSavePrivate::readAndVerifyVmsHeader(uint32_t address)
 
 	// If DCI, the entire vms_header must be 32-bit byteswapped first.
 	if (this->saveType == SAVE_TYPE_DCI) {
-		__byte_swap_32_array(vms_header.dci_dword, sizeof(vms_header.dci_dword));
+		rp_byte_swap_32_array<sizeof(vms_header.dci_dword)>(vms_header.dci_dword);
 	}
 
 	// Byteswap the fields.
@@ -375,11 +375,21 @@ int DreamcastSavePrivate::readVmiHeader(IRpFile *vmi_file)
 	}
 
 	// Byteswap the VMI header.
-	vmi_header.ctime.year  = le16_to_cpu(vmi_header.ctime.year);
-	vmi_header.vmi_version = le16_to_cpu(vmi_header.vmi_version);
-	vmi_header.mode        = le16_to_cpu(vmi_header.mode);
-	vmi_header.reserved    = le16_to_cpu(vmi_header.reserved);
-	vmi_header.filesize    = le32_to_cpu(vmi_header.filesize);
+	static const uint8_t vmi_header_layout[] = {
+		RP_STRUCT_SKIP(4),	// checksum
+		RP_STRUCT_SKIP(32),	// description
+		RP_STRUCT_SKIP(32),	// copyright
+		2,			// ctime.year
+		RP_STRUCT_SKIP(6),	// ctime (remainder)
+		2,			// vmi_version
+		2,			// file_number
+		RP_STRUCT_SKIP(8),	// vms_resource_name
+		RP_STRUCT_SKIP(12),	// vms_filename
+		2,			// mode
+		2,			// reserved
+		4,			// filesize
+	};
+	le_struct_to_cpu(&vmi_header, vmi_header_layout);
 	loaded_headers |= DreamcastSavePrivate::DC_HAVE_VMI;
 
 	// Convert the VMI time to Unix time.
@@ -471,7 +481,7 @@ const rp_image *DreamcastSavePrivate::loadIcon(void)
 
 	if (this->saveType == SAVE_TYPE_DCI) {
 		// Apply 32-bit byteswapping to the palette.
-		__byte_swap_32_array(buf.palette.u32, sizeof(buf.palette.u32));
+		rp_byte_swap_32_array<sizeof(buf.palette.u32)>(buf.palette.u32);
 	}
 
 	this->iconAnimData = new IconAnimData();
@@ -494,7 +504,7 @@ const rp_image *DreamcastSavePrivate::loadIcon(void)
 
 		if (this->saveType == SAVE_TYPE_DCI) {
 			// Apply 32-bit byteswapping to the palette.
-			__byte_swap_32_array(buf.icon_color.u32, sizeof(buf.icon_color.u32));
+			rp_byte_swap_32_array<sizeof(buf.icon_color.u32)>(buf.icon_color.u32);
 		}
 
 		iconAnimData->delays[i] = delay;
@@ -574,7 +584,7 @@ const rp_image *DreamcastSavePrivate::loadIcon_ICONDATA_VMS(void)
 
 		if (this->saveType == SAVE_TYPE_DCI) {
 			// Apply 32-bit byteswapping to the palette.
-			__byte_swap_32_array(buf.palette.u32, sizeof(buf.palette.u32));
+			rp_byte_swap_32_array<sizeof(buf.palette.u32)>(buf.palette.u32);
 		}
 
 		// Load the icon data.
@@ -586,7 +596,7 @@ const rp_image *DreamcastSavePrivate::loadIcon_ICONDATA_VMS(void)
 
 		if (this->saveType == SAVE_TYPE_DCI) {
 			// Apply 32-bit byteswapping to the icon data.
-			__byte_swap_32_array(buf.icon_color.u32, sizeof(buf.icon_color.u32));
+			rp_byte_swap_32_array<sizeof(buf.icon_color.u32)>(buf.icon_color.u32);
 		}
 
 		// Convert the icon to rp_image.
@@ -613,7 +623,7 @@ const rp_image *DreamcastSavePrivate::loadIcon_ICONDATA_VMS(void)
 
 	if (this->saveType == SAVE_TYPE_DCI) {
 		// Apply 32-bit byteswapping to the icon data.
-		__byte_swap_32_array(buf.icon_mono.u32, sizeof(buf.icon_mono.u32));
+		rp_byte_swap_32_array<sizeof(buf.icon_mono.u32)>(buf.icon_mono.u32);
 	}
 
 	// Convert the icon to rp_image.
@@ -805,9 +815,15 @@ DreamcastSave::DreamcastSave(IRpFile *file)
 		}
 
 		// Byteswap the directory entry.
-		d->vms_dirent.address     = le16_to_cpu(d->vms_dirent.address);
-		d->vms_dirent.size        = le16_to_cpu(d->vms_dirent.size);
-		d->vms_dirent.header_addr = le16_to_cpu(d->vms_dirent.header_addr);
+		static const uint8_t vms_dirent_layout[] = {
+			RP_STRUCT_SKIP(2),	// filetype, protect
+			2,			// address
+			RP_STRUCT_SKIP(12),	// filename
+			RP_STRUCT_SKIP(8),	// ctime (BCD)
+			2,			// size
+			2,			// header_addr
+		};
+		le_struct_to_cpu(&d->vms_dirent, vms_dirent_layout);
 
 		d->isGameFile = !!(d->vms_dirent.filetype == DC_VMS_DIRENT_FTYPE_GAME);
 		d->loaded_headers |= DreamcastSavePrivate::DC_HAVE_DIR_ENTRY;
@@ -21,7 +21,10 @@
 
 // librpbase, librpfile, librptexture
 #include "librpbase/SystemRegion.hpp"
+#include "librpfile/ConcatFile.hpp"
+#include "librpfile/RelatedFile.hpp"
 using namespace LibRpBase;
+using LibRpFile::ConcatFile;
 using LibRpFile::IRpFile;
 using LibRpTexture::rp_image;
 
@@ -30,6 +33,7 @@ using LibRpTexture::rp_image;
 #include "disc/CisoGcnReader.hpp"
 #include "disc/NASOSReader.hpp"
 #include "disc/nasos_gcn.h"	// for magic numbers
+#include "disc/WiaReader.hpp"
 #include "disc/WiiPartition.hpp"
 
 // For sections delegated to other RomData subclasses.
@@ -79,7 +83,7 @@ class GameCubePrivate : public RomDataPrivate
 			DISC_FORMAT_TGC   = (2U << 8),		// TGC (embedded disc image) (GCN only?)
 			DISC_FORMAT_WBFS  = (3U << 8),		// WBFS image (Wii only)
 			DISC_FORMAT_CISO  = (4U << 8),		// CISO image
-			DISC_FORMAT_WIA   = (5U << 8),		// WIA image (Header only!)
+			DISC_FORMAT_WIA   = (5U << 8),		// WIA/RVZ image (Compressed images are header only!)
 			DISC_FORMAT_NASOS = (6U << 8),		// NASOS image
 			DISC_FORMAT_PARTITION = (7U << 8),	// Standalone Wii partition
 			DISC_FORMAT_UNKNOWN = (0xFFU << 8),
@@ -148,9 +152,11 @@ class GameCubePrivate : public RomDataPrivate
 	public:
 		/**
 		 * Get the disc publisher.
+		 * @param pIsKnown	[out,opt] Set to true if the publisher was found in
+		 *                      the publishers table; false for the fallback string.
 		 * @return Disc publisher.
 		 */
-		string getPublisher(void) const;
+		string getPublisher(bool *pIsKnown = nullptr) const;
 
 		/**
 		 * Load opening.bnr. (GameCube only)
@@ -392,11 +398,16 @@ int GameCubePrivate::loadWiiPartitionTables(void)
 
 /**
  * Get the disc publisher.
+ * @param pIsKnown	[out,opt] Set to true if the publisher was found in
+ *                      the publishers table; false for the fallback string.
  * @return Disc publisher.
  */
-string GameCubePrivate::getPublisher(void) const
+string GameCubePrivate::getPublisher(bool *pIsKnown) const
 {
 	const char *const publisher = NintendoPublishers::lookup(discHeader.company);
+	if (pIsKnown) {
+		*pIsKnown = (publisher != nullptr);
+	}
 	if (publisher) {
 		return publisher;
 	}
@@ -711,10 +722,50 @@ GameCube::GameCube(IRpFile *file)
 				d->discReader = new DiscReader(d->file, gcm_offset, -1);
 				break;
 			}
-			case GameCubePrivate::DISC_FORMAT_WBFS:
+			case GameCubePrivate::DISC_FORMAT_WBFS: {
 				d->mimeType = "application/x-wbfs";
-				d->discReader = new WbfsReader(d->file);
+
+				// Check for split WBFS images. (game.wbfs + game.wbf1, ...)
+				// wit and some USB loaders split images at the FAT32 file size limit.
+				IRpFile *wbfsFile = d->file;
+				const string filename = d->file->filename();
+				if (!filename.empty()) {
+					vector<IRpFile*> segments;
+					segments.push_back(d->file);
+					for (unsigned int i = 1; i <= 9; i++) {
+						char ext[8];
+						snprintf(ext, sizeof(ext), ".wbf%u", i);
+						IRpFile *const segment = LibRpFile::FileSystem::openRelatedFile(filename.c_str(), nullptr, ext);
+						if (!segment) {
+							// No more segments.
+							break;
+						}
+						segments.push_back(segment);
+					}
+
+					if (segments.size() > 1) {
+						// Found a split image.
+						// Present all of the segments as one logical file.
+						ConcatFile *const concatFile = new ConcatFile(segments);
+						// ConcatFile ref()'d the segment files.
+						for (size_t i = 1; i < segments.size(); i++) {
+							segments[i]->unref();
+						}
+						if (concatFile->isOpen()) {
+							wbfsFile = concatFile;
+						} else {
+							concatFile->unref();
+						}
+					}
+				}
+
+				d->discReader = new WbfsReader(wbfsFile);
+				if (wbfsFile != d->file) {
+					// WbfsReader ref()'d the ConcatFile.
+					wbfsFile->unref();
+				}
 				break;
+			}
 			case GameCubePrivate::DISC_FORMAT_CISO:
 				d->discReader = new CisoGcnReader(d->file);
 				break;
@@ -723,10 +774,16 @@ GameCube::GameCube(IRpFile *file)
 				d->discReader = new NASOSReader(d->file);
 				break;
 			case GameCubePrivate::DISC_FORMAT_WIA:
-				// TODO: Implement WiaReader.
-				// For now, only the header will be readable.
+				// NOTE: Only uncompressed WIA/RVZ images are supported.
+				// For compressed images, only the header will be readable.
 				d->mimeType = "application/x-wia";
-				d->discReader = nullptr;
+				d->discReader = new WiaReader(d->file);
+				if (!d->discReader->isOpen()) {
+					// Unable to open the WIA/RVZ image.
+					// Fall back to the header-only path.
+					delete d->discReader;
+					d->discReader = nullptr;
+				}
 				break;
 
 			case GameCubePrivate::DISC_FORMAT_UNKNOWN:
@@ -763,8 +820,8 @@ GameCube::GameCube(IRpFile *file)
 	}
 
 	if (!d->discReader) {
-		// No WiaReader yet. If this is WIA,
-		// retrieve the header from header[].
+		// WiaReader doesn't support compressed images.
+		// If this is WIA, retrieve the header from header[].
 		if ((d->discType & GameCubePrivate::DISC_FORMAT_MASK) == GameCubePrivate::DISC_FORMAT_WIA) {
 			// GCN/Wii header starts at 0x58.
 			memcpy(&d->discHeader, &header[0x58], sizeof(d->discHeader));
@@ -1090,10 +1147,13 @@ int GameCube::isRomSupported_static(const DetectInfo *info)
 		return (GameCubePrivate::DISC_SYSTEM_UNKNOWN | GameCubePrivate::DISC_FORMAT_CISO);
 	}
 
-	// Check for WIA.
+	// Check for WIA or RVZ.
 	static const uint32_t wia_magic = 'WIA\x01';
-	if (pData32[0] == cpu_to_be32(wia_magic)) {
-		// This is a WIA image.
+	static const uint32_t rvz_magic = 'RVZ\x01';
+	if (pData32[0] == cpu_to_be32(wia_magic) ||
+	    pData32[0] == cpu_to_be32(rvz_magic))
+	{
+		// This is a WIA or RVZ image.
 		// NOTE: We're using the WIA system ID if it's valid.
 		// Otherwise, fall back to GCN/Wii magic.
 		switch (info->header.pData[0x48]) {
@@ -1108,7 +1168,7 @@ int GameCube::isRomSupported_static(const DetectInfo *info)
 		}
 
 		// Check the GameCube/Wii magic.
-		// TODO: WIA struct when full WIA support is added.
+		// The disc header is stored at 0x58. (WIA_DiscHeader.dhead)
 		gcn_header = reinterpret_cast<const GCN_DiscHeader*>(&info->header.pData[0x58]);
 		if (gcn_header->magic_wii == cpu_to_be32(WII_MAGIC)) {
 			// Wii disc image. (WIA format)
@@ -1211,8 +1271,9 @@ const char *const *GameCube::supportedFileExtensions_static(void)
 		".ciso", ".cso", ".tgc",
 		".dec",	// .iso.dec
 
-		// Partially supported. (Header only!)
-		".wia",
+		// Uncompressed images are fully supported;
+		// compressed images are header only.
+		".wia", ".rvz",
 
 		// NOTE: May cause conflicts on Windows
 		// if fallback handling isn't working.
@@ -1248,6 +1309,7 @@ const char *const *GameCube::supportedMimeTypes_static(void)
 		// TODO: Get these upstreamed on FreeDesktop.org.
 		"application/x-cso",		// technically a different format...
 		"application/x-nasos-image",
+		"application/x-rvz",
 
 		nullptr
 	};
@@ -1418,7 +1480,13 @@ int GameCube::loadFieldData(void)
 	d->fields->addField_string(C_("GameCube", "Game ID"), latin1_to_utf8(id6, 6));
 
 	// Publisher.
-	d->fields->addField_string(C_("RomData", "Publisher"), d->getPublisher());
+	// NOTE: Only intern the publisher if it came from the
+	// publishers table. The fallback string is formatted from
+	// raw header bytes, so it's an unbounded set.
+	bool isKnownPublisher = false;
+	const string s_publisher = d->getPublisher(&isKnownPublisher);
+	d->fields->addField_string(C_("RomData", "Publisher"), s_publisher,
+		(isKnownPublisher ? static_cast<unsigned int>(RomFields::STRF_INTERN) : 0U));
 
 	// Other fields.
 	d->fields->addField_string_numeric(C_("RomData", "Disc #"),
@@ -1428,7 +1496,7 @@ int GameCube::loadFieldData(void)
 
 	// The remaining fields are not located in the disc header.
 	// If we can't read the disc contents for some reason, e.g.
-	// unimplemented DiscReader (WIA), skip the fields.
+	// compressed WIA/RVZ, skip the fields.
 	if (!d->discReader) {
 		// Cannot read the disc contents.
 		// We're done for now.
@@ -1459,7 +1527,7 @@ int GameCube::loadFieldData(void)
 				s_region = region;
 			}
 
-			d->fields->addField_string(region_code_title, s_region);
+			d->fields->addField_string(region_code_title, std::move(s_region));
 		} else {
 			// Invalid region code.
 			d->fields->addField_string(region_code_title,
@@ -1949,6 +2017,11 @@ int GameCube::extURLs(ImageType imageType, vector<ExtURL> *pExtURLs, int size) c
 	pExtURLs->clear();
 
 	RP_D(const GameCube);
+	// Check for a memoized result.
+	if (d->extURLsCache_lookup(imageType, size, pExtURLs)) {
+		return 0;
+	}
+
 	if (d->discType < 0) {
 		// Unknown disc type.
 		return -EIO;
@@ -2079,6 +2152,7 @@ int GameCube::extURLs(ImageType imageType, vector<ExtURL> *pExtURLs, int size) c
 	}
 
 	// All URLs added.
+	d->extURLsCache_store(imageType, size, *pExtURLs);
 	return 0;
 }
 
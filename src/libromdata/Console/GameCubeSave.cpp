@@ -82,6 +82,24 @@ class GameCubeSavePrivate : public RomDataPrivate
 		 */
 		static bool isCardDirEntry(const uint8_t *buffer, uint32_t data_size, SaveType saveType);
 
+		// Raw banner+icon block. The banner is located at
+		// direntry.iconaddr with the icon frames immediately
+		// after it, so both are loaded with a single read.
+		// (empty if not loaded)
+		ao::uvector<uint8_t> bannerIconData;
+		uint32_t bannerSize;	// Banner size, including the CI8 palette.
+		uint32_t iconSizeTotal;	// Total size of all icon frames.
+		bool iconCI8Shared;	// Icons use a shared CI8 palette.
+
+		/**
+		 * Load the raw banner and icon data.
+		 * The banner and icon frames are adjacent in the save file,
+		 * so a single read covers both; the banner and icon loaders
+		 * decode from the shared block.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadBannerIconData(void);
+
 		/**
 		 * Load the save file's icons.
 		 *
@@ -107,6 +125,9 @@ GameCubeSavePrivate::GameCubeSavePrivate(GameCubeSave *q, IRpFile *file)
 	, iconAnimData(nullptr)
 	, saveType(SAVE_TYPE_UNKNOWN)
 	, dataOffset(-1)
+	, bannerSize(0)
+	, iconSizeTotal(0)
+	, iconCI8Shared(false)
 {
 	// Clear the directory entry.
 	memset(&direntry, 0, sizeof(direntry));
@@ -264,38 +285,36 @@ bool GameCubeSavePrivate::isCardDirEntry(const uint8_t *buffer, uint32_t data_si
 }
 
 /**
- * Load the save file's icons.
- *
- * This will load all of the animated icon frames,
- * though only the first frame will be returned.
- *
- * @return Icon, or nullptr on error.
+ * Load the raw banner and icon data.
+ * The banner and icon frames are adjacent in the save file,
+ * so a single read covers both; the banner and icon loaders
+ * decode from the shared block.
+ * @return 0 on success; negative POSIX error code on error.
  */
-const rp_image *GameCubeSavePrivate::loadIcon(void)
+int GameCubeSavePrivate::loadBannerIconData(void)
 {
-	if (iconAnimData) {
-		// Icon has already been loaded.
-		return iconAnimData->frames[0];
+	if (!bannerIconData.empty()) {
+		// Data has already been loaded.
+		return 0;
 	} else if (!this->file || !this->isValid) {
-		// Can't load the icon.
-		return nullptr;
+		// Can't load the data.
+		return -EBADF;
 	}
 
-	// Calculate the icon start address.
-	// The icon is located directly after the banner.
-	uint32_t iconaddr = direntry.iconaddr;
+	// Calculate the banner size, including the CI8 palette.
 	switch (direntry.bannerfmt & CARD_BANNER_MASK) {
 		case CARD_BANNER_CI:
 			// CI8 banner.
-			iconaddr += (CARD_BANNER_W * CARD_BANNER_H * 1);
-			iconaddr += (256 * 2);	// RGB5A3 palette
+			bannerSize = (CARD_BANNER_W * CARD_BANNER_H * 1);
+			bannerSize += (256 * 2);	// RGB5A3 palette
 			break;
 		case CARD_BANNER_RGB:
 			// RGB5A3 banner.
-			iconaddr += (CARD_BANNER_W * CARD_BANNER_H * 2);
+			bannerSize = (CARD_BANNER_W * CARD_BANNER_H * 2);
 			break;
 		default:
 			// No banner.
+			bannerSize = 0;
 			break;
 	}
 
@@ -341,28 +360,67 @@ const rp_image *GameCubeSavePrivate::loadIcon(void)
 		iconsizetotal += (256*2);
 	}
 
-	// Load the icon data.
+	iconSizeTotal = iconsizetotal;
+	iconCI8Shared = is_CI8_shared;
+
+	// Load the banner and icon data in a single read.
 	// TODO: Only read the first frame unless specifically requested?
-	auto icondata = aligned_uptr<uint8_t>(16, iconsizetotal);
-	size_t size = file->seekAndRead(dataOffset + iconaddr, icondata.get(), iconsizetotal);
-	if (size != iconsizetotal) {
+	const uint32_t total_sz = bannerSize + iconSizeTotal;
+	if (total_sz == 0) {
+		// No banner or icons.
+		return -ENOENT;
+	}
+	bannerIconData.resize(total_sz);
+	size_t size = file->seekAndRead(dataOffset + direntry.iconaddr,
+		bannerIconData.data(), total_sz);
+	if (size != total_sz) {
 		// Seek and/or read error.
+		bannerIconData.clear();
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/**
+ * Load the save file's icons.
+ *
+ * This will load all of the animated icon frames,
+ * though only the first frame will be returned.
+ *
+ * @return Icon, or nullptr on error.
+ */
+const rp_image *GameCubeSavePrivate::loadIcon(void)
+{
+	if (iconAnimData) {
+		// Icon has already been loaded.
+		return iconAnimData->frames[0];
+	} else if (!this->file || !this->isValid) {
+		// Can't load the icon.
+		return nullptr;
+	}
+
+	// Load the raw banner+icon block.
+	// The icon frames are located directly after the banner.
+	if (loadBannerIconData() != 0 || iconSizeTotal == 0) {
+		// Can't load the icon data.
 		return nullptr;
 	}
+	const uint8_t *const icondata = bannerIconData.data() + bannerSize;
 
 	const uint16_t *pal_CI8_shared = nullptr;
-	if (is_CI8_shared) {
+	if (iconCI8Shared) {
 		// Shared CI8 palette is at the end of the data.
 		pal_CI8_shared = reinterpret_cast<const uint16_t*>(
-			icondata.get() + (iconsizetotal - (256*2)));
+			icondata + (iconSizeTotal - (256*2)));
 	}
 
 	this->iconAnimData = new IconAnimData();
 	iconAnimData->count = 0;
 
 	unsigned int iconaddr_cur = 0;
-	iconfmt = direntry.iconfmt;
-	iconspeed = direntry.iconspeed;
+	uint16_t iconfmt = direntry.iconfmt;
+	uint16_t iconspeed = direntry.iconspeed;
 	for (int i = 0; i < CARD_MAXICONS; i++, iconfmt >>= 2, iconspeed >>= 2) {
 		const unsigned int delay = (iconspeed & CARD_SPEED_MASK);
 		if (delay == CARD_SPEED_END) {
@@ -383,7 +441,7 @@ const rp_image *GameCubeSavePrivate::loadIcon(void)
 				static const unsigned int iconsize = CARD_ICON_W * CARD_ICON_H * 2;
 				iconAnimData->frames[i] = ImageDecoder::fromGcn16(ImageDecoder::PXF_RGB5A3,
 					CARD_ICON_W, CARD_ICON_H,
-					reinterpret_cast<const uint16_t*>(icondata.get() + iconaddr_cur),
+					reinterpret_cast<const uint16_t*>(icondata + iconaddr_cur),
 					iconsize);
 				iconaddr_cur += iconsize;
 				break;
@@ -395,8 +453,8 @@ const rp_image *GameCubeSavePrivate::loadIcon(void)
 				static const unsigned int iconsize = CARD_ICON_W * CARD_ICON_H * 1;
 				iconAnimData->frames[i] = ImageDecoder::fromGcnCI8(
 					CARD_ICON_W, CARD_ICON_H,
-					icondata.get() + iconaddr_cur, iconsize,
-					reinterpret_cast<const uint16_t*>(icondata.get() + iconaddr_cur + iconsize), 256*2);
+					icondata + iconaddr_cur, iconsize,
+					reinterpret_cast<const uint16_t*>(icondata + iconaddr_cur + iconsize), 256*2);
 				iconaddr_cur += iconsize + (256*2);
 				break;
 			}
@@ -405,7 +463,7 @@ const rp_image *GameCubeSavePrivate::loadIcon(void)
 				static const unsigned int iconsize = CARD_ICON_W * CARD_ICON_H * 1;
 				iconAnimData->frames[i] = ImageDecoder::fromGcnCI8(
 					CARD_ICON_W, CARD_ICON_H,
-					icondata.get() + iconaddr_cur, iconsize,
+					icondata + iconaddr_cur, iconsize,
 					pal_CI8_shared, 256*2);
 				iconaddr_cur += iconsize;
 				break;
@@ -460,50 +518,30 @@ const rp_image *GameCubeSavePrivate::loadBanner(void)
 		return nullptr;
 	}
 
-	// Banner is located at direntry.iconaddr.
-	// Determine the banner format and size.
-	uint32_t bannersize;
-	switch (direntry.bannerfmt & CARD_BANNER_MASK) {
-		case CARD_BANNER_CI:
-			// CI8 banner.
-			bannersize = (CARD_BANNER_W * CARD_BANNER_H * 1);
-			break;
-		case CARD_BANNER_RGB:
-			bannersize = (CARD_BANNER_W * CARD_BANNER_H * 2);
-			break;
-		default:
-			// No banner.
-			return nullptr;
-	}
-
-	// Read the banner data.
-	static const int MAX_BANNER_SIZE = (CARD_BANNER_W * CARD_BANNER_H * 2);
-	uint8_t bannerbuf[MAX_BANNER_SIZE];
-	size_t size = file->seekAndRead(dataOffset + direntry.iconaddr,
-					bannerbuf, bannersize);
-	if (size != bannersize) {
-		// Seek and/or read error.
+	// Load the banner and icon data if it isn't loaded already.
+	if (loadBannerIconData() != 0 || bannerSize == 0) {
+		// Unable to load the banner data,
+		// or this save file has no banner.
 		return nullptr;
 	}
 
+	// Banner is located at the start of the block.
+	const uint8_t *const bannerbuf = bannerIconData.data();
 	if ((direntry.bannerfmt & CARD_BANNER_MASK) == CARD_BANNER_RGB) {
 		// Convert the banner from GCN RGB5A3 format to ARGB32.
 		img_banner = ImageDecoder::fromGcn16(ImageDecoder::PXF_RGB5A3,
 			CARD_BANNER_W, CARD_BANNER_H,
-			reinterpret_cast<const uint16_t*>(bannerbuf), bannersize);
+			reinterpret_cast<const uint16_t*>(bannerbuf),
+			CARD_BANNER_W * CARD_BANNER_H * 2);
 	} else {
-		// Read the palette data.
-		uint16_t palbuf[256];
-		size = file->seekAndRead(dataOffset + direntry.iconaddr + bannersize,
-					 palbuf, sizeof(palbuf));
-		if (size != sizeof(palbuf)) {
-			// Seek and/or read error.
-			return nullptr;
-		}
+		// CI8 palette is located immediately after the banner image.
+		static const uint32_t ci8size = (CARD_BANNER_W * CARD_BANNER_H * 1);
+		const uint16_t *const palbuf =
+			reinterpret_cast<const uint16_t*>(bannerbuf + ci8size);
 
 		// Convert the banner from GCN CI8 format to CI8.
 		img_banner = ImageDecoder::fromGcnCI8(CARD_BANNER_W, CARD_BANNER_H,
-			bannerbuf, bannersize, palbuf, sizeof(palbuf));
+			bannerbuf, ci8size, palbuf, 256*2);
 	}
 
 	return img_banner;
@@ -880,7 +918,8 @@ int GameCubeSave::loadFieldData(void)
 	// Look up the publisher.
 	const char *publisher = NintendoPublishers::lookup(direntry->company);
 	d->fields->addField_string(C_("RomData", "Publisher"),
-		publisher ? publisher : C_("RomData", "Unknown"));
+		publisher ? publisher : C_("RomData", "Unknown"),
+		RomFields::STRF_INTERN);
 
 	// Filename.
 	// TODO: Remove trailing spaces.
@@ -270,14 +270,17 @@ void MegaDrivePrivate::addFields_romHeader(const MD_RomHeader *pRomHeader, bool
 	const char *const publisher_title = C_("RomData", "Publisher");
 	if (publisher) {
 		// Publisher identified.
-		fields->addField_string(publisher_title, publisher);
+		fields->addField_string(publisher_title, publisher,
+			RomFields::STRF_INTERN);
 	} else if (t_code > 0) {
 		// Unknown publisher, but there is a valid T code.
+		// NOTE: Not interned; the T code comes from the ROM header,
+		// so this isn't a bounded set of values.
 		fields->addField_string(publisher_title, rp_sprintf("T-%u", t_code));
 	} else {
 		// Unknown publisher.
 		fields->addField_string(C_("RomData", "Publisher"),
-			C_("RomData", "Unknown"));
+			C_("RomData", "Unknown"), RomFields::STRF_INTERN);
 	}
 
 	// Titles, serial number, and checksum.
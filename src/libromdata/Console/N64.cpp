@@ -112,7 +112,7 @@ N64::N64(IRpFile *file)
 		case N64Private::ROM_TYPE_V64:
 			// V64 format. (16-bit byteswapped)
 			// Convert the header to Z64 first.
-			__byte_swap_16_array(d->romHeader.u16, sizeof(d->romHeader.u16));
+			rp_byte_swap_16_array<sizeof(d->romHeader.u16)>(d->romHeader.u16);
 			break;
 
 		case N64Private::ROM_TYPE_SWAP2:
@@ -130,7 +130,7 @@ N64::N64(IRpFile *file)
 			// TODO: Optimize by not converting the non-text fields
 			// if the host system is little-endian?
 			// FIXME: Untested - ucon64 doesn't support it.
-			__byte_swap_32_array(d->romHeader.u32, sizeof(d->romHeader.u32));
+			rp_byte_swap_32_array<sizeof(d->romHeader.u32)>(d->romHeader.u32);
 			break;
 
 		default:
@@ -144,11 +144,14 @@ N64::N64(IRpFile *file)
 	d->isValid = true;
 
 	// Byteswap the header from Z64 format.
-	d->romHeader.init_pi	= be32_to_cpu(d->romHeader.init_pi);
-	d->romHeader.clockrate	= be32_to_cpu(d->romHeader.clockrate);
-	d->romHeader.entrypoint	= be32_to_cpu(d->romHeader.entrypoint);
-	d->romHeader.crc[0]     = be32_to_cpu(d->romHeader.crc[0]);
-	d->romHeader.crc[1]     = be32_to_cpu(d->romHeader.crc[1]);
+	static const uint8_t z64_header_layout[] = {
+		4,			// init_pi
+		4,			// clockrate
+		4,			// entrypoint
+		RP_STRUCT_SKIP(4),	// os_version
+		4, 4,			// crc[2]
+	};
+	be_struct_to_cpu(&d->romHeader, z64_header_layout);
 }
 
 /** ROM detection functions. **/
@@ -780,7 +780,7 @@ int NES::loadFieldData(void)
 			// tr: Print only the mapper ID.
 			s_mapper = rp_sprintf("%u", static_cast<unsigned int>(mapper));
 		}
-		d->fields->addField_string(mapper_title, s_mapper);
+		d->fields->addField_string(mapper_title, std::move(s_mapper));
 	} else {
 		// No mapper. If this isn't TNES,
 		// then it's probably an FDS image.
@@ -807,7 +807,7 @@ int NES::loadFieldData(void)
 			// tr: Print only the submapper ID.
 			s_submapper = rp_sprintf("%u", static_cast<unsigned int>(submapper));
 		}
-		d->fields->addField_string(C_("NES", "Submapper"), s_submapper);
+		d->fields->addField_string(C_("NES", "Submapper"), std::move(s_submapper));
 	}
 
 	if (tnes_mapper >= 0) {
@@ -1226,7 +1226,7 @@ int NES::loadFieldData(void)
 			} else {
 				s_prg_size = rp_sprintf(C_("RomData", "Unknown (0x%02X)"), prg_sz_idx);
 			}
-			d->fields->addField_string(C_("NES", "PRG ROM Size"), s_prg_size);
+			d->fields->addField_string(C_("NES", "PRG ROM Size"), std::move(s_prg_size));
 
 			// CHR ROM size
 			string s_chr_size;
@@ -1237,7 +1237,7 @@ int NES::loadFieldData(void)
 			} else {
 				s_chr_size = rp_sprintf(C_("RomData", "Unknown (0x%02X)"), chr_sz_idx);
 			}
-			d->fields->addField_string(C_("NES", "CHR ROM Size"), s_chr_size);
+			d->fields->addField_string(C_("NES", "CHR ROM Size"), std::move(s_chr_size));
 
 			// Mirroring
 			switch (intFooter.board_info >> 4) {
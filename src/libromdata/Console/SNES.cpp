@@ -798,7 +798,8 @@ int SNES::loadFieldData(void)
 	// Publisher
 	// TODO: Print the publisher code if the lookup returns nullptr.
 	d->fields->addField_string(C_("RomData", "Publisher"),
-		publisher ? publisher : C_("RomData", "Unknown"));
+		publisher ? publisher : C_("RomData", "Unknown"),
+		RomFields::STRF_INTERN);
 
 	// ROM mapping
 	// NOTE: Not translatable!
@@ -483,7 +483,11 @@ int WiiU::loadFieldData(void)
 				static_cast<uint8_t>(publisher_code[3]));
 		}
 	}
-	d->fields->addField_string(C_("RomData", "Publisher"), s_publisher);
+	// NOTE: Only intern the publisher if it came from the
+	// publishers table. The fallback string is formatted from
+	// raw header bytes, so it's an unbounded set.
+	d->fields->addField_string(C_("RomData", "Publisher"), s_publisher,
+		(publisher ? static_cast<unsigned int>(RomFields::STRF_INTERN) : 0U));
 
 	// Game version.
 	// TODO: Validate the version characters.
@@ -528,6 +532,11 @@ int WiiU::extURLs(ImageType imageType, vector<ExtURL> *pExtURLs, int size) const
 	pExtURLs->clear();
 
 	RP_D(const WiiU);
+	// Check for a memoized result.
+	if (d->extURLsCache_lookup(imageType, size, pExtURLs)) {
+		return 0;
+	}
+
 	if (!d->isValid) {
 		// Disc image isn't valid.
 		return -EIO;
@@ -650,6 +659,7 @@ int WiiU::extURLs(ImageType imageType, vector<ExtURL> *pExtURLs, int size) const
 	}
 
 	// All URLs added.
+	d->extURLsCache_store(imageType, size, *pExtURLs);
 	return 0;
 }
 
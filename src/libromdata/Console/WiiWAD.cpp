@@ -827,7 +827,7 @@ int WiiWAD::loadFieldData(void)
 			s_region = region;
 		}
 
-		d->fields->addField_string(region_code_title, s_region);
+		d->fields->addField_string(region_code_title, std::move(s_region));
 	} else {
 		d->fields->addField_string(region_code_title,
 			rp_sprintf(C_("RomData", "Unknown (0x%02X)"), gcnRegion));
@@ -12,6 +12,7 @@
 #include "Xbox360_XEX.hpp"
 #include "xbox360_stfs_structs.h"
 #include "data/Xbox360_STFS_ContentType.hpp"
+#include "disc/StfsReader.hpp"
 
 // for language codes
 #include "xbox360_xdbf_structs.h"
@@ -19,7 +20,6 @@
 
 // librpbase, librpfile, librptexture
 #include "librpbase/img/RpPng.hpp"
-#include "librpbase/disc/DiscReader.hpp"
 #include "librpbase/disc/PartitionFile.hpp"
 #include "librpfile/RpMemFile.hpp"
 using namespace LibRpBase;
@@ -103,38 +103,22 @@ class Xbox360_STFS_Private : public RomDataPrivate
 		int loadHeader(unsigned int header);
 
 	public:
+		// STFS data block reader.
+		// Initialized by getStfsReader().
+		StfsReader *stfsReader;
+
 		// XEX executable.
-		DiscReader *xexReader;
 		Xbox360_XEX *xex;
 
 		// File table.
 		ao::uvector<STFS_DirEntry_t> fileTable;
 
 		/**
-		 * Convert a block number to an offset.
-		 * @param blockNumber Block number.
-		 * @return Offset, or -1 on error.
+		 * Get the STFS data block reader.
+		 * The reader is created on first use.
+		 * @return StfsReader on success; nullptr on error.
 		 */
-		inline int32_t blockNumberToOffset(int blockNumber)
-		{
-			// Reference: https://github.com/Free60Project/wiki/blob/master/STFS.md
-			int ret;
-			if (blockNumber > 0xFFFFFF) {
-				ret = -1;
-			} else {
-				ret = (((be32_to_cpu(stfsMetadata.header_size) + 0xFFF) & 0xF000) +
-				        (blockNumber * STFS_BLOCK_SIZE));
-			}
-			return ret;
-		}
-
-		/**
-		 * Convert a data block number to a physical block number.
-		 * Data block numbers don't include hash blocks.
-		 * @param dataBlockNumber Data block number.
-		 * @return physBlockNumber Physical block number.
-		 */
-		int32_t dataBlockNumberToPhys(int dataBlockNumber);
+		StfsReader *getStfsReader(void);
 
 		/**
 		 * Load the file table.
@@ -156,7 +140,7 @@ Xbox360_STFS_Private::Xbox360_STFS_Private(Xbox360_STFS *q, IRpFile *file)
 	, stfsType(STFS_TYPE_UNKNOWN)
 	, img_icon(nullptr)
 	, headers_loaded(0)
-	, xexReader(nullptr)
+	, stfsReader(nullptr)
 	, xex(nullptr)
 {
 	// Clear the headers.
@@ -170,7 +154,7 @@ Xbox360_STFS_Private::~Xbox360_STFS_Private()
 	if (xex) {
 		xex->unref();
 	}
-	delete xexReader;
+	delete stfsReader;
 
 	delete img_icon;
 }
@@ -325,50 +309,42 @@ int Xbox360_STFS_Private::loadHeader(unsigned int header)
 }
 
 /**
- * Convert a data block number to a physical block number.
- * Data block numbers don't include hash blocks.
- * @param dataBlockNumber Data block number.
- * @return physBlockNumber Physical block number.
+ * Get the STFS data block reader.
+ * The reader is created on first use.
+ * @return StfsReader on success; nullptr on error.
  */
-int32_t Xbox360_STFS_Private::dataBlockNumberToPhys(int dataBlockNumber)
+StfsReader *Xbox360_STFS_Private::getStfsReader(void)
 {
-	// Reference: https://github.com/Free60Project/wiki/blob/master/STFS.md
-	int blockShift;
-	if (((be32_to_cpu(stfsMetadata.header_size) + 0xFFF) & 0xF000) == 0xB000) {
-		blockShift = 1;
-	} else {
-		if ((stfsMetadata.stfs_desc.block_separation & 1) == 1) {
-			blockShift = 0;
-		} else {
-			blockShift = 1;
-		}
+	if (stfsReader) {
+		// Reader is already open.
+		return stfsReader;
 	}
 
-	int32_t base = ((dataBlockNumber + 0xAA) / 0xAA);
-	if (stfsType == STFS_TYPE_CON) {
-		base <<= blockShift;
+	if (!this->file) {
+		// File isn't open.
+		return nullptr;
 	}
 
-	int32_t ret = (base + dataBlockNumber);
-	if (dataBlockNumber > 0xAA) {
-		base = ((dataBlockNumber + 0x70E4) / 0x70E4);
-		if (stfsType == STFS_TYPE_CON) {
-			base <<= blockShift;
-		}
-		ret += base;
-
-		if (dataBlockNumber > 0x70E4) {
-			base = ((dataBlockNumber + 0x4AF768) / 0x4AF768);
-			// FIXME: Originally compared magic to blockShift,
-			// which doesn't make sense...
-			if (stfsType == STFS_TYPE_CON) {
-				base <<= blockShift;
-			}
-			ret += base;
-		}
+	// Make sure the STFS metadata is loaded.
+	// The volume descriptor is needed for the block map.
+	int ret = loadHeader(Xbox360_STFS_Private::STFS_PRESENT_METADATA);
+	if (ret != 0) {
+		// Not loaded and unable to load.
+		return nullptr;
 	}
 
-	return ret;
+	StfsReader *const reader = new StfsReader(this->file,
+		be32_to_cpu(stfsMetadata.header_size),
+		&stfsMetadata.stfs_desc,
+		(stfsType == STFS_TYPE_CON));
+	if (!reader->isOpen()) {
+		// Unable to open the reader.
+		delete reader;
+		return nullptr;
+	}
+
+	this->stfsReader = reader;
+	return reader;
 }
 
 /**
@@ -390,11 +366,12 @@ int Xbox360_STFS_Private::loadFileTable(void)
 		return -EIO;
 	}
 
-	// Make sure the STFS metadata is loaded.
-	int ret = loadHeader(Xbox360_STFS_Private::STFS_PRESENT_METADATA);
-	if (ret != 0) {
-		// Not loaded and unable to load.
-		return ret;
+	// Make sure the data block reader is open.
+	// This also loads the STFS metadata.
+	StfsReader *const reader = getStfsReader();
+	if (!reader) {
+		// Unable to open the data block reader.
+		return -EIO;
 	}
 
 	// TODO: Verify that this is STFS and not SVOD.
@@ -408,20 +385,18 @@ int Xbox360_STFS_Private::loadFileTable(void)
 		(stfsMetadata.stfs_desc.file_table_block_number[0] << 16) |
 		(stfsMetadata.stfs_desc.file_table_block_number[1] <<  8) |
 		 stfsMetadata.stfs_desc.file_table_block_number[2];
-	const int32_t offset = blockNumberToOffset(dataBlockNumberToPhys(blockNumber));
-	if (offset < 0) {
-		// Invalid block number.
-		return -EIO;
-	}
 
 	// Load the file table.
+	// NOTE: The reader operates in data block space, so the
+	// interleaved hash blocks are skipped automatically.
 	size_t fileTableSize = ((uint32_t)blockCount * STFS_BLOCK_SIZE);
 	assert(fileTableSize % sizeof(STFS_DirEntry_t) == 0);
 	if (fileTableSize % sizeof(STFS_DirEntry_t) != 0) {
 		fileTableSize += sizeof(STFS_DirEntry_t);
 	}
 	fileTable.resize(fileTableSize / sizeof(STFS_DirEntry_t));
-	size_t size = file->seekAndRead(offset, fileTable.data(), fileTableSize);
+	const off64_t offset = static_cast<off64_t>(blockNumber) * STFS_BLOCK_SIZE;
+	size_t size = reader->seekAndRead(offset, fileTable.data(), fileTableSize);
 	if (size != fileTableSize) {
 		// Seek and/or read error.
 		fileTable.clear();
@@ -504,28 +479,24 @@ Xbox360_XEX *Xbox360_STFS_Private::openDefaultXex(void)
 		(dirEntry->block_number[2] << 16) |
 		(dirEntry->block_number[1] <<  8) |
 		 dirEntry->block_number[0];
-	const int32_t offset = blockNumberToOffset(dataBlockNumberToPhys(blockNumber));
+	const off64_t offset = static_cast<off64_t>(blockNumber) * STFS_BLOCK_SIZE;
 	const uint32_t filesize = be32_to_cpu(dirEntry->filesize);
 
-	// Load default.xexp.
-	// FIXME: Maybe add a reader class to handle the hashes,
-	// though we only need the XEX header right now.
-	DiscReader *discReader = new DiscReader(this->file);
-	if (discReader->isOpen()) {
-		PartitionFile *const xexFile_tmp = new PartitionFile(discReader, offset, filesize);
+	// Load default.xex(p) through the data block reader,
+	// which handles the interleaved hash blocks.
+	StfsReader *const reader = getStfsReader();
+	if (reader) {
+		PartitionFile *const xexFile_tmp = new PartitionFile(reader, offset, filesize);
 		if (xexFile_tmp->isOpen()) {
 			Xbox360_XEX *const xex_tmp = new Xbox360_XEX(xexFile_tmp);
 			if (xex_tmp->isOpen()) {
 				this->xex = xex_tmp;
-				this->xexReader = discReader;
-				discReader = nullptr;
 			} else {
 				xex_tmp->unref();
 			}
 		}
 		xexFile_tmp->unref();
 	}
-	delete discReader;
 
 	return this->xex;
 }
@@ -813,12 +813,14 @@ int Xbox360_XDBF_Private::addFields_achievements(void)
 	vector<string> *const v_xach_col_names = RomFields::strArrayToVector_i18n(
 		"Xbox360_XDBF|Achievements", xach_col_names, ARRAY_SIZE(xach_col_names));
 
-	// Vectors.
-	array<RomFields::ListData_t*, XDBF_LANGUAGE_MAX> pvv_xach;
-	pvv_xach[XDBF_LANGUAGE_UNKNOWN] = nullptr;
+	// Builders.
+	// NOTE: ListDataBuilder preallocates the entire row/column
+	// structure, so the loop below only fills in cell values.
+	array<RomFields::ListDataBuilder*, XDBF_LANGUAGE_MAX> pb_xach;
+	pb_xach[XDBF_LANGUAGE_UNKNOWN] = nullptr;
 	for (int langID = XDBF_LANGUAGE_ENGLISH; langID < XDBF_LANGUAGE_MAX; langID++) {
-		pvv_xach[langID] = (strTblIndexes[langID] >= 0)
-			? new RomFields::ListData_t(xach_count)
+		pb_xach[langID] = (strTblIndexes[langID] >= 0)
+			? new RomFields::ListDataBuilder(xach_count, 3)
 			: nullptr;
 	}
 	auto vv_icons = new RomFields::ListDataIcons_t(xach_count);
@@ -841,15 +843,14 @@ int Xbox360_XDBF_Private::addFields_achievements(void)
 		snprintf(s_gamerscore, sizeof(s_gamerscore), "%u", be16_to_cpu(p->gamerscore));
 
 		for (int langID = XDBF_LANGUAGE_ENGLISH; langID < XDBF_LANGUAGE_MAX; langID++) {
-			if (!pvv_xach[langID]) {
+			RomFields::ListDataBuilder *const builder = pb_xach[langID];
+			if (!builder) {
 				// No strings for this language.
 				continue;
 			}
-			auto &data_row = pvv_xach[langID]->at(i);
-			data_row.reserve(3);
 
 			// Achievement ID
-			data_row.emplace_back(s_achievement_id);
+			builder->setCell(i, 0, s_achievement_id);
 
 			// Title.
 			string desc = loadString((XDBF_Language_e)langID, name_id);
@@ -881,35 +882,34 @@ int Xbox360_XDBF_Private::addFields_achievements(void)
 			}
 
 			// TODO: Formatting value indicating that the first line should be bold.
-			data_row.emplace_back(std::move(desc));
+			builder->setCell(i, 1, std::move(desc));
 
 			// Gamerscore
-			data_row.emplace_back(s_gamerscore);
+			builder->setCell(i, 2, s_gamerscore);
 		}
 	}
 
 	// Add the vectors to a map.
 	RomFields::ListDataMultiMap_t *const mvv_xach = new RomFields::ListDataMultiMap_t();
 	for (int langID = XDBF_LANGUAGE_ENGLISH; langID < XDBF_LANGUAGE_MAX; langID++) {
-		if (!pvv_xach[langID]) {
-			// No vector for this language.
-			continue;
-		} else if (pvv_xach[langID]->empty()) {
-			// No string data.
-			delete pvv_xach[langID];
+		if (!pb_xach[langID]) {
+			// No builder for this language.
 			continue;
 		}
 
+		RomFields::ListData_t *const vv_xach = pb_xach[langID]->release();
+		delete pb_xach[langID];
+
 		const uint32_t lc = XboxLanguage::getXbox360LanguageCode(langID);
 		assert(lc != 0);
-		if (lc == 0) {
-			// Invalid language code.
-			delete pvv_xach[langID];
+		if (vv_xach->empty() || lc == 0) {
+			// No string data, or invalid language code.
+			delete vv_xach;
 			continue;
 		}
 
-		mvv_xach->insert(std::make_pair(lc, std::move(*pvv_xach[langID])));
-		delete pvv_xach[langID];
+		mvv_xach->insert(std::make_pair(lc, std::move(*vv_xach)));
+		delete vv_xach;
 	}
 
 	// Add the list data.
@@ -1021,12 +1021,14 @@ int Xbox360_XDBF_Private::addFields_avatarAwards(void)
 	vector<string> *const v_xgaa_col_names = RomFields::strArrayToVector_i18n(
 		"Xbox360_XDBF|AvatarAwards", xgaa_col_names, ARRAY_SIZE(xgaa_col_names));
 
-	// Vectors.
-	array<RomFields::ListData_t*, XDBF_LANGUAGE_MAX> pvv_xgaa;
-	pvv_xgaa[XDBF_LANGUAGE_UNKNOWN] = nullptr;
+	// Builders.
+	// NOTE: ListDataBuilder preallocates the entire row/column
+	// structure, so the loop below only fills in cell values.
+	array<RomFields::ListDataBuilder*, XDBF_LANGUAGE_MAX> pb_xgaa;
+	pb_xgaa[XDBF_LANGUAGE_UNKNOWN] = nullptr;
 	for (int langID = XDBF_LANGUAGE_ENGLISH; langID < XDBF_LANGUAGE_MAX; langID++) {
-		pvv_xgaa[langID] = (strTblIndexes[langID] >= 0)
-			? new RomFields::ListData_t(xgaa_count)
+		pb_xgaa[langID] = (strTblIndexes[langID] >= 0)
+			? new RomFields::ListDataBuilder(xgaa_count, 2)
 			: nullptr;
 	}
 	auto vv_icons = new RomFields::ListDataIcons_t(xgaa_count);
@@ -1047,15 +1049,14 @@ int Xbox360_XDBF_Private::addFields_avatarAwards(void)
 		snprintf(s_avatar_award_id, sizeof(s_avatar_award_id), "%04X", be16_to_cpu(p->avatar_award_id));
 
 		for (int langID = XDBF_LANGUAGE_ENGLISH; langID < XDBF_LANGUAGE_MAX; langID++) {
-			if (!pvv_xgaa[langID]) {
+			RomFields::ListDataBuilder *const builder = pb_xgaa[langID];
+			if (!builder) {
 				// No strings for this language.
 				continue;
 			}
-			auto &data_row = pvv_xgaa[langID]->at(i);
-			data_row.reserve(2);
 
 			// Avatar award ID
-			data_row.emplace_back(s_avatar_award_id);
+			builder->setCell(i, 0, s_avatar_award_id);
 
 			// Title.
 			string desc = loadString((XDBF_Language_e)langID, name_id);
@@ -1087,32 +1088,31 @@ int Xbox360_XDBF_Private::addFields_avatarAwards(void)
 			}
 
 			// TODO: Formatting value indicating that the first line should be bold.
-			data_row.emplace_back(std::move(desc));
+			builder->setCell(i, 1, std::move(desc));
 		}
 	}
 
 	// Add the vectors to a map.
 	RomFields::ListDataMultiMap_t *const mvv_xgaa = new RomFields::ListDataMultiMap_t();
 	for (int langID = XDBF_LANGUAGE_ENGLISH; langID < XDBF_LANGUAGE_MAX; langID++) {
-		if (!pvv_xgaa[langID]) {
-			// No vector for this language.
-			continue;
-		} else if (pvv_xgaa[langID]->empty()) {
-			// No string data.
-			delete pvv_xgaa[langID];
+		if (!pb_xgaa[langID]) {
+			// No builder for this language.
 			continue;
 		}
 
+		RomFields::ListData_t *const vv_xgaa = pb_xgaa[langID]->release();
+		delete pb_xgaa[langID];
+
 		const uint32_t lc = XboxLanguage::getXbox360LanguageCode(langID);
 		assert(lc != 0);
-		if (lc == 0) {
-			// Invalid language code.
-			delete pvv_xgaa[langID];
+		if (vv_xgaa->empty() || lc == 0) {
+			// No string data, or invalid language code.
+			delete vv_xgaa;
 			continue;
 		}
 
-		mvv_xgaa->insert(std::make_pair(lc, std::move(*pvv_xgaa[langID])));
-		delete pvv_xgaa[langID];
+		mvv_xgaa->insert(std::make_pair(lc, std::move(*vv_xgaa)));
+		delete vv_xgaa;
 	}
 
 	// Add the list data.
@@ -1224,15 +1224,17 @@ void Xbox360_XDBF::init(void)
 		return;
 	}
 
-#if SYS_BYTEORDER == SYS_LIL_ENDIAN
 	// Byteswap the header for little-endian systems.
 	// NOTE: The magic number is *not* byteswapped here.
-	d->xdbfHeader.version			= be32_to_cpu(d->xdbfHeader.version);
-	d->xdbfHeader.entry_table_length	= be32_to_cpu(d->xdbfHeader.entry_table_length);
-	d->xdbfHeader.entry_count		= be32_to_cpu(d->xdbfHeader.entry_count);
-	d->xdbfHeader.free_space_table_length	= be32_to_cpu(d->xdbfHeader.free_space_table_length);
-	d->xdbfHeader.free_space_table_count	= be32_to_cpu(d->xdbfHeader.free_space_table_count);
-#endif /* SYS_BYTEORDER == SYS_LIL_ENDIAN */
+	static const uint8_t xdbf_header_layout[] = {
+		RP_STRUCT_SKIP(4),	// magic
+		4,			// version
+		4,			// entry_table_length
+		4,			// entry_count
+		4,			// free_space_table_length
+		4,			// free_space_table_count
+	};
+	be_struct_to_cpu(&d->xdbfHeader, xdbf_header_layout);
 
 	// Calculate the data start offset.
 	d->data_offset = sizeof(d->xdbfHeader) +
@@ -16,6 +16,7 @@
 #include "xbox360_xex_structs.h"
 
 // librpbase, librpfile, librptexture
+#include "librpbase/BufferPool.hpp"
 #include "librpbase/disc/CBCReader.hpp"
 #include "librpfile/RpMemFile.hpp"
 using namespace LibRpBase;
@@ -202,12 +203,24 @@ class Xbox360_XEX_Private : public RomDataPrivate
 		EXE *pe_exe;
 		Xbox360_XDBF *pe_xdbf;
 
+		// Set if initPeReader() failed.
+		// Prevents every caller from re-running the expensive
+		// LZX de-block and decompression attempt on a bad file.
+		bool peReaderFailed;
+
 		/**
 		 * Initialize the PE executable reader.
 		 * @return peReader on success; nullptr on error.
 		 */
 		CBCReader *initPeReader(void);
 
+		/**
+		 * Initialize the PE executable reader. (internal function)
+		 * Called by initPeReader() on the first attempt.
+		 * @return peReader on success; nullptr on error.
+		 */
+		CBCReader *initPeReader_int(void);
+
 		/**
 		 * Initialize the EXE object.
 		 * @return EXE object on success; nullptr on error.
@@ -261,6 +274,7 @@ Xbox360_XEX_Private::Xbox360_XEX_Private(Xbox360_XEX *q, IRpFile *file)
 	, peReader(nullptr)
 	, pe_exe(nullptr)
 	, pe_xdbf(nullptr)
+	, peReaderFailed(false)
 {
 	// Clear the headers.
 	memset(&xex2Header, 0, sizeof(xex2Header));
@@ -533,7 +547,28 @@ CBCReader *Xbox360_XEX_Private::initPeReader(void)
 		return peReader;
 	}
 #endif /* ENABLE_LIBMSPACK */
+	if (peReaderFailed) {
+		// Initialization failed previously.
+		// Don't redo the decompression attempt.
+		return nullptr;
+	}
 
+	CBCReader *const ret = initPeReader_int();
+	if (!ret) {
+		// Initialization failed. Remember that, so the other
+		// callers don't retry the whole thing.
+		peReaderFailed = true;
+	}
+	return ret;
+}
+
+/**
+ * Initialize the PE executable reader. (internal function)
+ * Called by initPeReader() on the first attempt.
+ * @return peReader on success; nullptr on error.
+ */
+CBCReader *Xbox360_XEX_Private::initPeReader_int(void)
+{
 	if (xexType <= XEX_TYPE_UNKNOWN || xexType >= XEX_TYPE_MAX) {
 		// Invalid XEX type.
 		return nullptr;
@@ -757,7 +792,12 @@ CBCReader *Xbox360_XEX_Private::initPeReader(void)
 			// Compressed EXE buffer.
 			// We have to de-block the compressed data first.
 			const size_t compressed_size = static_cast<size_t>(fileSize) - xex2Header.pe_offset;
-			unique_ptr<uint8_t[]> compressed_deblock(new uint8_t[compressed_size]);
+			PoolBuffer compressed_deblock(compressed_size);
+			if (!compressed_deblock.get()) {
+				delete reader[0];
+				delete reader[1];
+				return nullptr;
+			}
 
 			// Pointer within the deblocked compressed data.
 			uint8_t *p_dblk = compressed_deblock.get();
@@ -880,7 +920,12 @@ CBCReader *Xbox360_XEX_Private::initPeReader(void)
 			}
 
 			// Decompress the data.
-			unique_ptr<uint8_t[]> decompressed_exe(new uint8_t[image_size]);
+			PoolBuffer decompressed_exe(image_size);
+			if (!decompressed_exe.get()) {
+				delete reader[0];
+				delete reader[1];
+				return nullptr;
+			}
 			int res = lzx_decompress(compressed_deblock.get(),
 				static_cast<size_t>(p_dblk - compressed_deblock.get()),
 				decompressed_exe.get(), image_size,
@@ -1320,15 +1365,17 @@ Xbox360_XEX::Xbox360_XEX(IRpFile *file)
 
 	// Copy the XEX2 header.
 	memcpy(&d->xex2Header, header, sizeof(d->xex2Header));
-#if SYS_BYTEORDER == SYS_LIL_ENDIAN
 	// Byteswap the header for little-endian systems.
 	// NOTE: The magic number is *not* byteswapped here.
-	d->xex2Header.module_flags	= be32_to_cpu(d->xex2Header.module_flags);
-	d->xex2Header.pe_offset		= be32_to_cpu(d->xex2Header.pe_offset);
-	d->xex2Header.reserved		= be32_to_cpu(d->xex2Header.reserved);
-	d->xex2Header.sec_info_offset	= be32_to_cpu(d->xex2Header.sec_info_offset);
-	d->xex2Header.opt_header_count	= be32_to_cpu(d->xex2Header.opt_header_count);
-#endif /* SYS_BYTEORDER == SYS_LIL_ENDIAN */
+	static const uint8_t xex2_header_layout[] = {
+		RP_STRUCT_SKIP(4),	// magic
+		4,			// module_flags
+		4,			// pe_offset
+		4,			// reserved
+		4,			// sec_info_offset
+		4,			// opt_header_count
+	};
+	be_struct_to_cpu(&d->xex2Header, xex2_header_layout);
 
 	// Is this a patch?
 	if ((d->xex2Header.module_flags & (XEX2_MODULE_FLAG_MODULE_PATCH |
@@ -1656,7 +1703,7 @@ int Xbox360_XEX::loadFieldData(void)
 		// Indicate that an XEX1 kernel is needed.
 		s_minver += " (XEX1)";
 	}
-	d->fields->addField_string(C_("Xbox360_XEX", "Min. Kernel"), s_minver);
+	d->fields->addField_string(C_("Xbox360_XEX", "Min. Kernel"), std::move(s_minver));
 
 	// Module flags
 	static const char *const module_flags_tbl[] = {
@@ -59,6 +59,11 @@ class XboxDiscPrivate : public LibRpBase::RomDataPrivate
 		int discType;
 		uint8_t wave;
 
+		// ISO-9660 PVD. (from the constructor)
+		// Reused when creating the ISO RomData object
+		// so the PVD isn't read twice.
+		ISO_Primary_Volume_Descriptor pvd;
+
 		// XDVDFS starting address.
 		off64_t xdvdfs_addr;
 
@@ -132,6 +137,8 @@ XboxDiscPrivate::XboxDiscPrivate(XboxDisc *q, IRpFile *file)
 	, exeType(EXE_TYPE_UNKNOWN)
 	, isKreon(false)
 {
+	// Clear the PVD struct.
+	memset(&pvd, 0, sizeof(pvd));
 }
 
 XboxDiscPrivate::~XboxDiscPrivate()
@@ -307,16 +314,17 @@ XboxDisc::XboxDisc(IRpFile *file)
 
 	// Read the ISO-9660 PVD.
 	// NOTE: Only 2048-byte sectors, since this is DVD.
-	ISO_Primary_Volume_Descriptor pvd;
-	size_t size = d->file->seekAndRead(ISO_PVD_ADDRESS_2048, &pvd, sizeof(pvd));
-	if (size != sizeof(pvd)) {
+	// NOTE: The PVD is kept around so loadFieldData() can
+	// create the ISO RomData object without re-reading it.
+	size_t size = d->file->seekAndRead(ISO_PVD_ADDRESS_2048, &d->pvd, sizeof(d->pvd));
+	if (size != sizeof(d->pvd)) {
 		d->file->unref();
 		d->file = nullptr;
 		return;
 	}
 
 	// Check if this disc image is supported.
-	d->discType = isRomSupported_static(&pvd, &d->wave);
+	d->discType = isRomSupported_static(&d->pvd, &d->wave);
 
 	switch (d->discType) {
 		case XboxDiscPrivate::DISC_TYPE_XGD1:
@@ -802,7 +810,7 @@ int XboxDisc::loadFieldData(void)
 
 	// ISO object for ISO-9660 PVD
 	if (d->discType >= XboxDiscPrivate::DISC_TYPE_XGD1) {
-		ISO *const isoData = new ISO(d->file);
+		ISO *const isoData = new ISO(d->file, &d->pvd);
 		if (isoData->isOpen()) {
 			// Add the fields.
 			const RomFields *const isoFields = isoData->fields();
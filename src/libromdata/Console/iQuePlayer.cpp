@@ -65,6 +65,19 @@ class iQuePlayerPrivate : public RomDataPrivate
 		iQuePlayer_BbContentMetaDataHead bbContentMetaDataHead;
 		iQuePlayer_BbTicketHead bbTicketHead;
 
+		// Entire file, read once at open time.
+		// .cmd/.dat files have small fixed sizes, so a single
+		// read covers the header structs, the title strings,
+		// and both compressed images.
+		ao::uvector<uint8_t> fileData;
+
+		// Cached title/ISBN, shared by the field and
+		// metadata loaders. (valid if titleIsbnLoaded)
+		bool titleIsbnLoaded;
+		int titleIsbnRet;
+		string cachedTitle;
+		string cachedIsbn;
+
 		// Internal images.
 		rp_image *img_thumbnail;	// handled as icon
 		rp_image *img_title;		// handled as banner
@@ -113,6 +126,8 @@ class iQuePlayerPrivate : public RomDataPrivate
 iQuePlayerPrivate::iQuePlayerPrivate(iQuePlayer *q, IRpFile *file)
 	: super(q, file)
 	, fileType(FT_IQUE_UNKNOWN)
+	, titleIsbnLoaded(false)
+	, titleIsbnRet(0)
 	, img_thumbnail(nullptr)
 	, img_title(nullptr)
 {
@@ -136,51 +151,62 @@ iQuePlayerPrivate::~iQuePlayerPrivate()
  */
 int iQuePlayerPrivate::getTitleAndISBN(string &title, string &isbn)
 {
+	if (titleIsbnLoaded) {
+		// Already parsed. The fields and metadata loaders
+		// both call this function, so parse once and share.
+		title = cachedTitle;
+		isbn = cachedIsbn;
+		return titleIsbnRet;
+	}
+
+	titleIsbnLoaded = true;
+	cachedTitle.clear();
+	cachedIsbn.clear();
+	title.clear();
+	isbn.clear();
+
 	// Stored immediately after the thumbnail and title images,
 	// and NULL-terminated.
 	static const size_t title_buf_sz = IQUE_PLAYER_BBCONTENTMETADATAHEAD_ADDRESS - sizeof(contentDesc);
-	std::unique_ptr<char[]> title_buf(new char[title_buf_sz]);
 
 	const off64_t title_addr = sizeof(contentDesc) +
 		be16_to_cpu(contentDesc.thumb_image_size) +
 		be16_to_cpu(contentDesc.title_image_size);
 	if (title_addr >= (off64_t)title_buf_sz) {
 		// Out of range.
-		return 1;
+		titleIsbnRet = 1;
+		return titleIsbnRet;
 	}
 
-	const size_t title_sz = title_buf_sz - title_addr;
-	size_t size = file->seekAndRead(title_addr, title_buf.get(), title_sz);
-	if (size != title_sz) {
-		// Seek and/or read error.
-		return 2;
+	// The strings are in the buffered file data.
+	const size_t title_sz = title_buf_sz - static_cast<size_t>(title_addr);
+	if (fileData.size() < static_cast<size_t>(title_addr) + title_sz) {
+		// File data wasn't loaded.
+		titleIsbnRet = 2;
+		return titleIsbnRet;
 	}
 
-	// Data read.
-	title.clear();
-	isbn.clear();
-
 	/// Find the title. (first string)
 
 	// Check for "\xEF\xBB\xBF" (UTF-8 BOM).
 	// Title 00201b2c (Dongwu Senlin) uses this separator instead
 	// of a NULL character for some reason.
 	static const char utf8bom[] = "\xEF\xBB\xBF";
-	const char *p = title_buf.get();
-	const char *p_end = static_cast<const char*>(memmem(p, title_buf_sz, utf8bom, sizeof(utf8bom)-1));
+	const char *p = reinterpret_cast<const char*>(&fileData[static_cast<size_t>(title_addr)]);
+	const char *p_end = static_cast<const char*>(memmem(p, title_sz, utf8bom, sizeof(utf8bom)-1));
 	if (p_end && p_end > p) {
 		// Found the UTF-8 BOM.
 		// Convert from GB2312 to UTF-8.
-		title = cpN_to_utf8(CP_GB2312, p, static_cast<int>(p_end - p));
+		cachedTitle = cpN_to_utf8(CP_GB2312, p, static_cast<int>(p_end - p));
 
 		// Adjust p to point to the next string.
 		p = p_end + 3;
 	} else {
 		// No UTF-8 BOM. Check for NULL instead.
-		p_end = static_cast<const char*>(memchr(p, '\0', title_buf_sz));
+		p_end = static_cast<const char*>(memchr(p, '\0', title_sz));
 		if (p_end && p_end > p) {
 			// Convert from GB2312 to UTF-8.
-			title = cpN_to_utf8(CP_GB2312, p, static_cast<int>(p_end - p));
+			cachedTitle = cpN_to_utf8(CP_GB2312, p, static_cast<int>(p_end - p));
 
 			// Adjust p to point to the next string.
 			p = p_end + 1;
@@ -190,21 +216,25 @@ int iQuePlayerPrivate::getTitleAndISBN(string &title, string &isbn)
 	if (!p_end) {
 		// No NULL found.
 		// The description is invalid.
-		return 3;
+		titleIsbnRet = 3;
+		return titleIsbnRet;
 	}
 
 	// Find the second NULL.
 	// This will give us the ISBN. (ASCII)
-	const size_t isbn_buf_sz = title_buf_sz - (p_end - p) - 1;
+	const size_t isbn_buf_sz = title_sz - (p_end - p) - 1;
 	p_end = static_cast<const char*>(memchr(p, '\0', isbn_buf_sz));
 	if (p_end && p_end > p) {
 		// Convert from ASCII (well, Latin-1) to UTF-8.
-		isbn = latin1_to_utf8(p, static_cast<int>(p_end - p));
+		cachedIsbn = latin1_to_utf8(p, static_cast<int>(p_end - p));
 	}
 
 	// TODO: There might be other fields with NULL or UTF-8 BOM separators.
 	// Check 00201b2c.cmd for more information.
-	return 0;
+	titleIsbnRet = 0;
+	title = cachedTitle;
+	isbn = cachedIsbn;
+	return titleIsbnRet;
 }
 
 /**
@@ -236,13 +266,12 @@ rp_image *iQuePlayerPrivate::loadImage(off64_t address, size_t z_size, size_t un
 	}
 #endif /* defined(_MSC_VER) && defined(ZLIB_IS_DLL) */
 
-	// Read the compressed thumbnail image.
-	std::unique_ptr<uint8_t[]> z_buf(new uint8_t[z_size]);
-	size_t size = file->seekAndRead(address, z_buf.get(), z_size);
-	if (size != z_size) {
-		// Seek and/or read error.
+	// The compressed image is in the buffered file data.
+	if (fileData.size() < static_cast<size_t>(address) + z_size) {
+		// Out of range.
 		return nullptr;
 	}
+	const uint8_t *const z_buf = &fileData[static_cast<size_t>(address)];
 
 	// Decompress the thumbnail image.
 	// Decompressed size must be 0x1880 bytes. (56*56*2)
@@ -264,7 +293,7 @@ rp_image *iQuePlayerPrivate::loadImage(off64_t address, size_t z_size, size_t un
 	}
 
 	strm.avail_in = static_cast<uInt>(z_size);
-	strm.next_in = z_buf.get();
+	strm.next_in = const_cast<Bytef*>(z_buf);
 
 	strm.avail_out = static_cast<uInt>(unz_size);
 	strm.next_out = reinterpret_cast<Bytef*>(img_buf.get());
@@ -392,15 +421,24 @@ iQuePlayer::iQuePlayer(IRpFile *file)
 		return;
 	}
 
-	// Read the content description.
+	// Read the entire file.
+	// .cmd/.dat files are ~10 KB with fixed sizes, so one read
+	// covers the header structs, the title strings, and both
+	// compressed images; everything else is served from the
+	// buffer with no further seeks.
+	d->fileData.resize(static_cast<size_t>(filesize));
 	d->file->rewind();
-	size_t size = d->file->read(&d->contentDesc, sizeof(d->contentDesc));
-	if (size != sizeof(d->contentDesc)) {
+	size_t size = d->file->read(d->fileData.data(), d->fileData.size());
+	if (size != d->fileData.size()) {
+		d->fileData.clear();
 		d->file->unref();
 		d->file = nullptr;
 		return;
 	}
 
+	// Content description.
+	memcpy(&d->contentDesc, d->fileData.data(), sizeof(d->contentDesc));
+
 	// Check if this file is supported.
 	DetectInfo info;
 	info.header.addr = 0;
@@ -417,27 +455,24 @@ iQuePlayer::iQuePlayer(IRpFile *file)
 		return;
 	}
 
-	// Read the BBContentMetaDataHead.
-	size = d->file->seekAndRead(IQUE_PLAYER_BBCONTENTMETADATAHEAD_ADDRESS,
-		&d->bbContentMetaDataHead, sizeof(d->bbContentMetaDataHead));
-	if (size != sizeof(d->bbContentMetaDataHead)) {
-		d->fileType = iQuePlayerPrivate::FT_IQUE_UNKNOWN;
-		d->isValid = false;
-		d->file->unref();
-		d->file = nullptr;
-		return;
-	}
+	// BBContentMetaDataHead.
+	// The filesize check above guarantees it's in the buffer.
+	static_assert(IQUE_PLAYER_BBCONTENTMETADATAHEAD_ADDRESS +
+		sizeof(d->bbContentMetaDataHead) <= IQUE_PLAYER_CMD_FILESIZE,
+		"BBContentMetaDataHead is out of range.");
+	memcpy(&d->bbContentMetaDataHead,
+		&d->fileData[IQUE_PLAYER_BBCONTENTMETADATAHEAD_ADDRESS],
+		sizeof(d->bbContentMetaDataHead));
 
-	// If this is a ticket, read the BBTicketHead.
+	// If this is a ticket, copy the BBTicketHead.
 	if (d->fileType == iQuePlayerPrivate::FT_IQUE_DAT) {
 		d->mimeType = "application/x-ique-dat";		// unofficial, not on fd.o
-		size = d->file->seekAndRead(IQUE_PLAYER_BBTICKETHEAD_ADDRESS,
-			&d->bbTicketHead, sizeof(d->bbTicketHead));
-		if (size != sizeof(d->bbTicketHead)) {
-			// Unable to read the ticket header.
-			// Handle it as a content metadata file.
-			d->fileType = iQuePlayerPrivate::FT_IQUE_CMD;
-		}
+		static_assert(IQUE_PLAYER_BBTICKETHEAD_ADDRESS +
+			sizeof(d->bbTicketHead) <= IQUE_PLAYER_DAT_FILESIZE,
+			"BBTicketHead is out of range.");
+		memcpy(&d->bbTicketHead,
+			&d->fileData[IQUE_PLAYER_BBTICKETHEAD_ADDRESS],
+			sizeof(d->bbTicketHead));
 	} else {
 		d->mimeType = "application/x-ique-cmd";		// unofficial, not on fd.o
 	}
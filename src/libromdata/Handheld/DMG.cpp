@@ -169,9 +169,11 @@ class DMGPrivate : public RomDataPrivate
 
 		/**
 		 * Get the publisher.
+		 * @param pIsKnown	[out,opt] Set to true if the publisher was found in
+		 *                      the publishers table; false for the fallback string.
 		 * @return Publisher, or "Unknown (xxx)" if unknown.
 		 */
-		string getPublisher(void) const;
+		string getPublisher(bool *pIsKnown = nullptr) const;
 };
 
 /** DMGPrivate **/
@@ -482,9 +484,11 @@ trimTitle:
 
 /**
  * Get the publisher.
+ * @param pIsKnown	[out,opt] Set to true if the publisher was found in
+ *                      the publishers table; false for the fallback string.
  * @return Publisher, or "Unknown (xxx)" if unknown.
  */
-string DMGPrivate::getPublisher(void) const
+string DMGPrivate::getPublisher(bool *pIsKnown) const
 {
 	const char* publisher;
 	string s_publisher;
@@ -516,6 +520,9 @@ string DMGPrivate::getPublisher(void) const
 		}
 	}
 
+	if (pIsKnown) {
+		*pIsKnown = (publisher != nullptr);
+	}
 	return s_publisher;
 }
 
@@ -895,7 +902,13 @@ int DMG::loadFieldData(void)
 	}
 
 	// Publisher
-	d->fields->addField_string(C_("RomData", "Publisher"), d->getPublisher());
+	// NOTE: Only intern the publisher if it came from the
+	// publishers table. The fallback string is formatted from
+	// raw header bytes, so it's an unbounded set.
+	bool isKnownPublisher = false;
+	const string s_publisher = d->getPublisher(&isKnownPublisher);
+	d->fields->addField_string(C_("RomData", "Publisher"), s_publisher,
+		(isKnownPublisher ? static_cast<unsigned int>(RomFields::STRF_INTERN) : 0U));
 
 	// Hardware
 	d->fields->addField_string(C_("DMG", "Hardware"),
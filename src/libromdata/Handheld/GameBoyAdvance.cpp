@@ -50,9 +50,11 @@ class GameBoyAdvancePrivate : public RomDataPrivate
 	public:
 		/**
 		 * Get the publisher.
+		 * @param pIsKnown	[out,opt] Set to true if the publisher was found in
+		 *                      the publishers table; false for the fallback string.
 		 * @return Publisher, or "Unknown (xxx)" if unknown.
 		 */
-		string getPublisher(void) const;
+		string getPublisher(bool *pIsKnown = nullptr) const;
 };
 
 /** GameBoyAdvancePrivate **/
@@ -67,11 +69,16 @@ GameBoyAdvancePrivate::GameBoyAdvancePrivate(GameBoyAdvance *q, IRpFile *file)
 
 /**
  * Get the publisher.
+ * @param pIsKnown	[out,opt] Set to true if the publisher was found in
+ *                      the publishers table; false for the fallback string.
  * @return Publisher, or "Unknown (xxx)" if unknown.
  */
-string GameBoyAdvancePrivate::getPublisher(void) const
+string GameBoyAdvancePrivate::getPublisher(bool *pIsKnown) const
 {
 	const char *const publisher = NintendoPublishers::lookup(romHeader.company);
+	if (pIsKnown) {
+		*pIsKnown = (publisher != nullptr);
+	}
 	string s_publisher;
 	if (publisher) {
 		s_publisher = publisher;
@@ -381,7 +388,13 @@ int GameBoyAdvance::loadFieldData(void)
 	d->fields->addField_string(C_("GameBoyAdvance", "Game ID"), latin1_to_utf8(id6, 6));
 
 	// Publisher
-	d->fields->addField_string(C_("RomData", "Publisher"), d->getPublisher());
+	// NOTE: Only intern the publisher if it came from the
+	// publishers table. The fallback string is formatted from
+	// raw header bytes, so it's an unbounded set.
+	bool isKnownPublisher = false;
+	const string s_publisher = d->getPublisher(&isKnownPublisher);
+	d->fields->addField_string(C_("RomData", "Publisher"), s_publisher,
+		(isKnownPublisher ? static_cast<unsigned int>(RomFields::STRF_INTERN) : 0U));
 
 	// ROM version
 	d->fields->addField_string_numeric(C_("RomData", "Revision"),
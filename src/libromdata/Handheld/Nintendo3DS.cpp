@@ -133,6 +133,10 @@ class Nintendo3DSPrivate : public RomDataPrivate
 		unsigned int content_count;
 		unique_ptr<N3DS_Content_Chunk_Record_t[]> content_chunks;
 
+		// Has openSRL() been attempted?
+		// Prevents retrying a failed SRL open.
+		bool srl_tried;
+
 		// TODO: Move the pointers to the union?
 		// That requires careful memory management...
 
@@ -211,6 +215,14 @@ class Nintendo3DSPrivate : public RomDataPrivate
 		 */
 		int loadTicketAndTMD(void);
 
+		/**
+		 * Open the DSiWare SRL if this CIA contains one. (CIA only)
+		 * This loads the ticket and TMD if they haven't been loaded yet.
+		 * On success, sbptr.srl.data is set.
+		 * @return 0 on success; non-zero on error.
+		 */
+		int openSRL(void);
+
 		/**
 		 * Get the SMDH region code.
 		 * @return SMDH region code, or 0 if it could not be obtained.
@@ -281,6 +293,7 @@ Nintendo3DSPrivate::Nintendo3DSPrivate(Nintendo3DS *q, IRpFile *file)
 	, headers_loaded(0)
 	, media_unit_shift(9)	// default is 9 (512 bytes)
 	, content_count(0)
+	, srl_tried(false)
 	, ncch_reader(nullptr)
 {
 	// Clear the various structs.
@@ -784,62 +797,101 @@ int Nintendo3DSPrivate::loadTicketAndTMD(void)
 	// Store the content start address.
 	mxh.content_start_addr = tmd_start + toNext64(tmd_size);
 
+	// Loaded the TMD header.
+	// NOTE: If the CIA contains a DSiWare SRL, it is opened
+	// on demand by openSRL(), not here. Callers that only
+	// need the ticket and TMD headers shouldn't have to pay
+	// for decrypting NCCH/SRL content.
+	headers_loaded |= HEADER_TMD;
+	return 0;
+}
+
+/**
+ * Open the DSiWare SRL if this CIA contains one. (CIA only)
+ * This loads the ticket and TMD if they haven't been loaded yet.
+ * On success, sbptr.srl.data is set.
+ * @return 0 on success; non-zero on error.
+ */
+int Nintendo3DSPrivate::openSRL(void)
+{
+	if (sbptr.srl.data) {
+		// SRL is already open.
+		return 0;
+	} else if (srl_tried) {
+		// A previous attempt to open the SRL failed.
+		return -EIO;
+	}
+
+	// Make sure the ticket and TMD are loaded.
+	if (!(headers_loaded & HEADER_TMD)) {
+		int ret = loadTicketAndTMD();
+		if (ret != 0) {
+			return ret;
+		}
+	}
+	srl_tried = true;
+
 	// Check if the CIA is DSiWare.
 	// NOTE: "WarioWare Touched!" has a manual, but no other
 	// DSiWare titles that I've seen do.
-	if (content_count <= 2 && !(headers_loaded & HEADER_SMDH) && !this->sbptr.srl.data) {
-		const off64_t offset = mxh.content_start_addr;
-		const uint32_t length = static_cast<uint32_t>(be64_to_cpu(content_chunks[0].size));
-		if (length >= 0x8000) {
-			// Attempt to open the SRL as if it's a new file.
-			// TODO: IRpFile implementation with offset/length, so we don't
-			// have to use both DiscReader and PartitionFile.
-
-			// Check if this content is encrypted.
-			// If it is, we'll need to create a CIAReader.
-			IDiscReader *srlReader = nullptr;
-			if (content_chunks[0].type & cpu_to_be16(N3DS_CONTENT_CHUNK_ENCRYPTED)) {
-				// Content is encrypted.
-				srlReader = new CIAReader(this->file, offset, length,
-					&mxh.ticket, be16_to_cpu(content_chunks[0].index));
-			} else {
-				// Content is NOT encrypted.
-				// Use a plain old DiscReader.
-				srlReader = new DiscReader(this->file, offset, length);
-			}
+	if (content_count > 2 || (headers_loaded & HEADER_SMDH)) {
+		// Not DSiWare.
+		return -ENOENT;
+	}
 
-			// TODO: Make IDiscReader derive from IRpFile.
-			// May need to add reference counting to IRpFile...
-			PartitionFile *srlFile = nullptr;
-			NintendoDS *srlData = nullptr;
-			if (srlReader->isOpen()) {
-				srlFile = new PartitionFile(srlReader, 0, length);
-				if (srlFile->isOpen()) {
-					// Create the NintendoDS object.
-					srlData = new NintendoDS(srlFile, true);
-				}
-			}
+	const off64_t offset = mxh.content_start_addr;
+	const uint32_t length = static_cast<uint32_t>(be64_to_cpu(content_chunks[0].size));
+	if (length < 0x8000) {
+		// Content is too small to be an SRL.
+		return -ENOENT;
+	}
 
-			if (srlData && srlData->isOpen() && srlData->isValid()) {
-				// SRL opened successfully.
-				this->sbptr.reader = srlReader;
-				this->sbptr.file = srlFile;
-				this->sbptr.srl.data = srlData;
-			} else {
-				// Failed to open the SRL.
-				if (srlData) {
-					srlData->unref();
-				}
-				if (srlFile) {
-					srlFile->unref();
-				}
-				delete srlReader;
-			}
+	// Attempt to open the SRL as if it's a new file.
+	// TODO: IRpFile implementation with offset/length, so we don't
+	// have to use both DiscReader and PartitionFile.
+
+	// Check if this content is encrypted.
+	// If it is, we'll need to create a CIAReader.
+	IDiscReader *srlReader = nullptr;
+	if (content_chunks[0].type & cpu_to_be16(N3DS_CONTENT_CHUNK_ENCRYPTED)) {
+		// Content is encrypted.
+		srlReader = new CIAReader(this->file, offset, length,
+			&mxh.ticket, be16_to_cpu(content_chunks[0].index));
+	} else {
+		// Content is NOT encrypted.
+		// Use a plain old DiscReader.
+		srlReader = new DiscReader(this->file, offset, length);
+	}
+
+	// TODO: Make IDiscReader derive from IRpFile.
+	// May need to add reference counting to IRpFile...
+	PartitionFile *srlFile = nullptr;
+	NintendoDS *srlData = nullptr;
+	if (srlReader->isOpen()) {
+		srlFile = new PartitionFile(srlReader, 0, length);
+		if (srlFile->isOpen()) {
+			// Create the NintendoDS object.
+			srlData = new NintendoDS(srlFile, true);
 		}
 	}
 
-	// Loaded the TMD header.
-	headers_loaded |= HEADER_TMD;
+	if (srlData && srlData->isOpen() && srlData->isValid()) {
+		// SRL opened successfully.
+		this->sbptr.reader = srlReader;
+		this->sbptr.file = srlFile;
+		this->sbptr.srl.data = srlData;
+	} else {
+		// Failed to open the SRL.
+		if (srlData) {
+			srlData->unref();
+		}
+		if (srlFile) {
+			srlFile->unref();
+		}
+		delete srlReader;
+		return -EIO;
+	}
+
 	return 0;
 }
 
@@ -1771,10 +1823,8 @@ uint32_t Nintendo3DS::supportedImageTypes(void) const
 {
 	RP_D(const Nintendo3DS);
 	if (d->romType == Nintendo3DSPrivate::ROM_TYPE_CIA) {
-		// TMD needs to be loaded so we can check if it's a DSiWare SRL.
-		if (!(d->headers_loaded & Nintendo3DSPrivate::HEADER_TMD)) {
-			const_cast<Nintendo3DSPrivate*>(d)->loadTicketAndTMD();
-		}
+		// The SRL needs to be opened so we can check if it's a DSiWare CIA.
+		const_cast<Nintendo3DSPrivate*>(d)->openSRL();
 		if (d->sbptr.srl.data) {
 			// This is a DSiWare SRL.
 			// Get the image information from the underlying SRL.
@@ -1857,10 +1907,8 @@ uint32_t Nintendo3DS::imgpf(ImageType imageType) const
 
 	RP_D(const Nintendo3DS);
 	if (d->romType == Nintendo3DSPrivate::ROM_TYPE_CIA) {
-		// TMD needs to be loaded so we can check if it's a DSiWare SRL.
-		if (!(d->headers_loaded & Nintendo3DSPrivate::HEADER_TMD)) {
-			const_cast<Nintendo3DSPrivate*>(d)->loadTicketAndTMD();
-		}
+		// The SRL needs to be opened so we can check if it's a DSiWare CIA.
+		const_cast<Nintendo3DSPrivate*>(d)->openSRL();
 		if (d->sbptr.srl.data) {
 			// This is a DSiWare SRL.
 			// Get the image information from the underlying SRL.
@@ -1918,10 +1966,12 @@ int Nintendo3DS::loadFieldData(void)
 	if (!(d->headers_loaded & Nintendo3DSPrivate::HEADER_SMDH)) {
 		d->loadSMDH();
 	}
-	if ((d->romType == Nintendo3DSPrivate::ROM_TYPE_CIA) &&
-	    !(d->headers_loaded & Nintendo3DSPrivate::HEADER_TMD))
-	{
-		d->loadTicketAndTMD();
+	if (d->romType == Nintendo3DSPrivate::ROM_TYPE_CIA) {
+		if (!(d->headers_loaded & Nintendo3DSPrivate::HEADER_TMD)) {
+			d->loadTicketAndTMD();
+		}
+		// Open the SRL if this is a DSiWare CIA.
+		d->openSRL();
 	}
 
 	// Get the primary NCCH.
@@ -2631,8 +2681,7 @@ int Nintendo3DS::loadMetaData(void)
 	}
 
 	// Check for DSiWare.
-	// TODO: Check d->sbptr.srl.data first?
-	int ret = const_cast<Nintendo3DSPrivate*>(d)->loadTicketAndTMD();
+	int ret = const_cast<Nintendo3DSPrivate*>(d)->openSRL();
 	if (ret == 0 && d->sbptr.srl.data) {
 		// Add the NDS metadata.
 		d->metaData = new RomMetaData();
@@ -2665,10 +2714,8 @@ int Nintendo3DS::loadInternalImage(ImageType imageType, const rp_image **pImage)
 
 	RP_D(Nintendo3DS);
 	if (d->romType == Nintendo3DSPrivate::ROM_TYPE_CIA) {
-		// TMD needs to be loaded so we can check if it's a DSiWare SRL.
-		if (!(d->headers_loaded & Nintendo3DSPrivate::HEADER_TMD)) {
-			d->loadTicketAndTMD();
-		}
+		// The SRL needs to be opened so we can check if it's a DSiWare CIA.
+		d->openSRL();
 		if (d->sbptr.srl.data) {
 			// This is a DSiWare SRL.
 			// Get the image from the underlying SRL.
@@ -2696,6 +2743,47 @@ int Nintendo3DS::loadInternalImage(ImageType imageType, const rp_image **pImage)
 	return (image ? 0 : -EIO);
 }
 
+/**
+ * Get an internal image from the ROM, closest to the specified size.
+ *
+ * The size hint is forwarded to the SMDH section, which may
+ * decode the 24x24 icon instead of the 48x48 icon for small
+ * requests.
+ *
+ * NOTE: The rp_image is owned by this object.
+ * Do NOT delete this object until you're done using this rp_image.
+ *
+ * @param imageType	[in] Image type to load.
+ * @param reqSize	[in] Requested image size. (single dimension; assuming square image)
+ * @return Internal image, or nullptr if the ROM doesn't have one.
+ */
+const rp_image *Nintendo3DS::imageForSize(ImageType imageType, int reqSize) const
+{
+	RP_D(const Nintendo3DS);
+	Nintendo3DSPrivate *const d_nc = const_cast<Nintendo3DSPrivate*>(d);
+	if (d->romType == Nintendo3DSPrivate::ROM_TYPE_CIA) {
+		// The SRL needs to be opened so we can check if it's a DSiWare CIA.
+		d_nc->openSRL();
+		if (d->sbptr.srl.data) {
+			// This is a DSiWare SRL.
+			// Get the image from the underlying SRL.
+			return d->sbptr.srl.data->imageForSize(imageType, reqSize);
+		}
+	}
+
+	// Make sure the SMDH section is loaded.
+	if (!(d->headers_loaded & Nintendo3DSPrivate::HEADER_SMDH)) {
+		// Load the SMDH section.
+		if (d_nc->loadSMDH() != 0) {
+			// Error loading the SMDH section.
+			return nullptr;
+		}
+	}
+
+	// Get the icon from the SMDH section.
+	return d->sbptr.smdh.data->imageForSize(imageType, reqSize);
+}
+
 /**
  * Get the animated icon data.
  *
@@ -2742,10 +2830,8 @@ int Nintendo3DS::extURLs(ImageType imageType, vector<ExtURL> *pExtURLs, int size
 		// ROM image isn't valid.
 		return -EIO;
 	} else if (d->romType == Nintendo3DSPrivate::ROM_TYPE_CIA) {
-		// TMD needs to be loaded so we can check if it's a DSiWare SRL.
-		if (!(d->headers_loaded & Nintendo3DSPrivate::HEADER_TMD)) {
-			const_cast<Nintendo3DSPrivate*>(d)->loadTicketAndTMD();
-		}
+		// The SRL needs to be opened so we can check if it's a DSiWare CIA.
+		const_cast<Nintendo3DSPrivate*>(d)->openSRL();
 		if (d->sbptr.srl.data) {
 			// This is a DSiWare SRL.
 			// Get the image URLs from the underlying SRL.
@@ -2937,8 +3023,7 @@ bool Nintendo3DS::hasDangerousPermissions(void) const
 	RP_D(const Nintendo3DS);
 
 	// Check for DSiWare.
-	// TODO: Check d->sbptr.srl.data first?
-	int ret = const_cast<Nintendo3DSPrivate*>(d)->loadTicketAndTMD();
+	int ret = const_cast<Nintendo3DSPrivate*>(d)->openSRL();
 	if (ret == 0 && d->sbptr.srl.data) {
 		// DSiWare: Check DSi permissions.
 		return d->sbptr.srl.data->hasDangerousPermissions();
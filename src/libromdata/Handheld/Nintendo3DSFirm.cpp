@@ -232,33 +232,50 @@ int Nintendo3DSFirm::loadFieldData(void)
 	const N3DS_FIRM_Header_t *const firmHeader = &d->firmHeader;
 	d->fields->reserve(5);	// Maximum of 5 fields.
 
+	// Entry points. If both are non-zero, this may be an
+	// official firmware binary, which we identify by CRC32.
+	const uint32_t arm11_entrypoint = le32_to_cpu(firmHeader->arm11_entrypoint);
+	const uint32_t arm9_entrypoint = le32_to_cpu(firmHeader->arm9_entrypoint);
+	const bool mayBeOfficial = (arm11_entrypoint != 0 && arm9_entrypoint != 0);
+
 	// Read the firmware binary.
+	// The CRC is updated incrementally as each chunk is read,
+	// while the chunk is still cache-warm, instead of making a
+	// second cold pass over the whole buffer afterwards. The
+	// CRC is skipped entirely if the entry points already rule
+	// out an official firmware binary.
 	unique_ptr<uint8_t[]> firmBuf;
 	unsigned int szFile = 0;
+	uint32_t crc = 0;
 	if (d->file->size() <= 4*1024*1024) {
 		// Firmware binary is 4 MB or less.
+		static const unsigned int CHUNK_SIZE = 64*1024;
 		szFile = static_cast<unsigned int>(d->file->size());
 		firmBuf.reset(new uint8_t[szFile]);
 		d->file->rewind();
-		size_t size = d->file->read(firmBuf.get(), szFile);
-		if (size != szFile) {
-			// Error reading the firmware binary.
-			firmBuf.reset();
+		for (unsigned int pos = 0; pos < szFile; pos += CHUNK_SIZE) {
+			const unsigned int chunk = std::min(CHUNK_SIZE, szFile - pos);
+			size_t size = d->file->read(&firmBuf[pos], chunk);
+			if (size != chunk) {
+				// Error reading the firmware binary.
+				firmBuf.reset();
+				break;
+			}
+			if (mayBeOfficial) {
+				crc = crc32(crc, &firmBuf[pos], chunk);
+			}
 		}
 	}
 
 	// If both ARM11 and ARM9 entry points are non-zero,
 	// check if this is an official 3DS firmware binary.
 	const Nintendo3DSFirmData::FirmBin_t *firmBin = nullptr;
-	const uint32_t arm11_entrypoint = le32_to_cpu(firmHeader->arm11_entrypoint);
-	const uint32_t arm9_entrypoint = le32_to_cpu(firmHeader->arm9_entrypoint);
 	const char *firmBinDesc = nullptr;
 	bool checkCustomFIRM = false;	// Check for a custom FIRM, e.g. Boot9Strap.
 	bool checkARM9 = false;		// Check for ARM9 homebrew.
-	if (arm11_entrypoint != 0 && arm9_entrypoint != 0) {
-		// Calculate the CRC32 and look it up.
+	if (mayBeOfficial) {
+		// Look up the CRC32.
 		if (firmBuf) {
-			const uint32_t crc = crc32(0, firmBuf.get(), static_cast<unsigned int>(szFile));
 			firmBin = Nintendo3DSFirmData::lookup_firmBin(crc);
 			if (firmBin != nullptr) {
 				// Official firmware binary.
@@ -369,7 +386,7 @@ int Nintendo3DSFirm::loadFieldData(void)
 
 		// If the version was found, add it.
 		if (!s_verstr.empty()) {
-			d->fields->addField_string(C_("RomData", "Version"), s_verstr);
+			d->fields->addField_string(C_("RomData", "Version"), std::move(s_verstr));
 		}
 	} else {
 		// Add the firmware type field.
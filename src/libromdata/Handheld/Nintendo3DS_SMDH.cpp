@@ -50,11 +50,46 @@ class Nintendo3DS_SMDH_Private : public RomDataPrivate
 	public:
 		// SMDH headers.
 		// NOTE: *NOT* byteswapped!
+		// NOTE: Loaded on demand. The constructor only reads
+		// enough for detection; title entries, settings, and
+		// the icon section are read when they're first needed,
+		// so e.g. metadata extraction only reads and converts
+		// the active system language.
 		struct {
 			N3DS_SMDH_Header_t header;
 			N3DS_SMDH_Icon_t icon;
 		} smdh;
 
+		uint16_t titlesLoaded;		// Bitfield of loaded title entries.
+		bool settingsLoaded;		// True if the settings struct is loaded.
+		bool iconSectionLoaded;		// True if the icon section is loaded.
+
+		/**
+		 * Load the specified title entry, if it isn't loaded already.
+		 * @param langID N3DS language ID.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadTitle(int langID);
+
+		/**
+		 * Load all title entries, if they aren't loaded already.
+		 * Needed for the multi-language field data.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadAllTitles(void);
+
+		/**
+		 * Load the settings struct, if it isn't loaded already.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadSettings(void);
+
+		/**
+		 * Load the icon section, if it isn't loaded already.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadIconSection(void);
+
 		/**
 		 * Load the ROM image's icon.
 		 * @param idx Image index. (0 == 24x24; 1 == 48x48)
@@ -64,21 +99,25 @@ class Nintendo3DS_SMDH_Private : public RomDataPrivate
 
 		/**
 		 * Get the language ID to use for the title fields.
+		 * Loads the required title entries if necessary.
 		 * @return N3DS language ID.
 		 */
-		N3DS_Language_ID getLanguageID(void) const;
+		N3DS_Language_ID getLanguageID(void);
 
 		/**
 		 * Get the default language code for the multi-string fields.
 		 * @return Language code, e.g. 'en' or 'es'.
 		 */
-		inline uint32_t getDefaultLC(void) const;
+		inline uint32_t getDefaultLC(void);
 };
 
 /** Nintendo3DS_SMDH_Private **/
 
 Nintendo3DS_SMDH_Private::Nintendo3DS_SMDH_Private(Nintendo3DS_SMDH *q, IRpFile *file)
 	: super(q, file)
+	, titlesLoaded(0)
+	, settingsLoaded(false)
+	, iconSectionLoaded(false)
 {
 	// Clear img_icon.
 	img_icon.fill(nullptr);
@@ -93,6 +132,116 @@ Nintendo3DS_SMDH_Private::~Nintendo3DS_SMDH_Private()
 	std::for_each(img_icon.begin(), img_icon.end(), [](rp_image *pImg) { delete pImg; });
 }
 
+/**
+ * Load the specified title entry, if it isn't loaded already.
+ * @param langID N3DS language ID.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int Nintendo3DS_SMDH_Private::loadTitle(int langID)
+{
+	assert(langID >= 0);
+	assert(langID < N3DS_LANG_MAX);
+	if (langID < 0 || langID >= N3DS_LANG_MAX) {
+		return -EINVAL;
+	}
+
+	if (titlesLoaded & (1U << langID)) {
+		// Title entry is already loaded.
+		return 0;
+	} else if (!file) {
+		// File isn't open.
+		return -EBADF;
+	}
+
+	size_t size = file->seekAndRead(
+		offsetof(N3DS_SMDH_Header_t, titles) + (langID * sizeof(N3DS_SMDH_Title_t)),
+		&smdh.header.titles[langID], sizeof(N3DS_SMDH_Title_t));
+	if (size != sizeof(N3DS_SMDH_Title_t)) {
+		// Seek and/or read error.
+		return -EIO;
+	}
+
+	titlesLoaded |= (1U << langID);
+	return 0;
+}
+
+/**
+ * Load all title entries, if they aren't loaded already.
+ * Needed for the multi-language field data.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int Nintendo3DS_SMDH_Private::loadAllTitles(void)
+{
+	if (titlesLoaded == 0xFFFF) {
+		// All title entries are already loaded.
+		return 0;
+	} else if (!file) {
+		// File isn't open.
+		return -EBADF;
+	}
+
+	// Read the entire titles array in one go.
+	size_t size = file->seekAndRead(offsetof(N3DS_SMDH_Header_t, titles),
+		smdh.header.titles, sizeof(smdh.header.titles));
+	if (size != sizeof(smdh.header.titles)) {
+		// Seek and/or read error.
+		return -EIO;
+	}
+
+	titlesLoaded = 0xFFFF;
+	return 0;
+}
+
+/**
+ * Load the settings struct, if it isn't loaded already.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int Nintendo3DS_SMDH_Private::loadSettings(void)
+{
+	if (settingsLoaded) {
+		// Settings struct is already loaded.
+		return 0;
+	} else if (!file) {
+		// File isn't open.
+		return -EBADF;
+	}
+
+	size_t size = file->seekAndRead(offsetof(N3DS_SMDH_Header_t, settings),
+		&smdh.header.settings, sizeof(smdh.header.settings));
+	if (size != sizeof(smdh.header.settings)) {
+		// Seek and/or read error.
+		return -EIO;
+	}
+
+	settingsLoaded = true;
+	return 0;
+}
+
+/**
+ * Load the icon section, if it isn't loaded already.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int Nintendo3DS_SMDH_Private::loadIconSection(void)
+{
+	if (iconSectionLoaded) {
+		// Icon section is already loaded.
+		return 0;
+	} else if (!file) {
+		// File isn't open.
+		return -EBADF;
+	}
+
+	size_t size = file->seekAndRead(sizeof(N3DS_SMDH_Header_t),
+		&smdh.icon, sizeof(smdh.icon));
+	if (size != sizeof(smdh.icon)) {
+		// Seek and/or read error.
+		return -EIO;
+	}
+
+	iconSectionLoaded = true;
+	return 0;
+}
+
 /**
  * Load the ROM image's icon.
  * @param idx Image index. (0 == 24x24; 1 == 48x48)
@@ -120,6 +269,12 @@ const rp_image *Nintendo3DS_SMDH_Private::loadIcon(int idx)
 		return nullptr;
 	}
 
+	// Make sure the icon section is loaded.
+	if (loadIconSection() != 0) {
+		// Unable to load the icon section.
+		return nullptr;
+	}
+
 	// Convert the icon to rp_image.
 	// NOTE: Assuming RGB565 format.
 	// 3dbrew.org says it could be any of various formats,
@@ -151,9 +306,10 @@ const rp_image *Nintendo3DS_SMDH_Private::loadIcon(int idx)
 
 /**
  * Get the language ID to use for the title fields.
+ * Loads the required title entries if necessary.
  * @return N3DS language ID.
  */
-N3DS_Language_ID Nintendo3DS_SMDH_Private::getLanguageID(void) const
+N3DS_Language_ID Nintendo3DS_SMDH_Private::getLanguageID(void)
 {
 	// Get the system language.
 	// TODO: Verify against the game's region code?
@@ -167,13 +323,17 @@ N3DS_Language_ID Nintendo3DS_SMDH_Private::getLanguageID(void) const
 	}
 
 	// Check the header fields to determine if the language string is valid.
+	// NOTE: Only the checked title entries are loaded here.
+	loadTitle(langID);
 	if (smdh.header.titles[langID].desc_short[0] == cpu_to_le16('\0')) {
 		// Not valid. Check English.
+		loadTitle(N3DS_LANG_ENGLISH);
 		if (smdh.header.titles[N3DS_LANG_ENGLISH].desc_short[0] != cpu_to_le16('\0')) {
 			// English is valid.
 			langID = N3DS_LANG_ENGLISH;
 		} else {
 			// Not valid. Check Japanese.
+			loadTitle(N3DS_LANG_JAPANESE);
 			if (smdh.header.titles[N3DS_LANG_JAPANESE].desc_short[0] != cpu_to_le16('\0')) {
 				// Japanese is valid.
 				langID = N3DS_LANG_JAPANESE;
@@ -192,7 +352,7 @@ N3DS_Language_ID Nintendo3DS_SMDH_Private::getLanguageID(void) const
  * Get the default language code for the multi-string fields.
  * @return Language code, e.g. 'en' or 'es'.
  */
-inline uint32_t Nintendo3DS_SMDH_Private::getDefaultLC(void) const
+inline uint32_t Nintendo3DS_SMDH_Private::getDefaultLC(void)
 {
 	// Get the system language.
 	// TODO: Verify against the game's region code?
@@ -235,10 +395,12 @@ Nintendo3DS_SMDH::Nintendo3DS_SMDH(IRpFile *file)
 		return;
 	}
 
-	// Read the SMDH section.
+	// Read the beginning of the SMDH section for detection.
+	// The rest of the header, plus the icon section, is
+	// loaded on demand.
 	d->file->rewind();
-	size_t size = d->file->read(&d->smdh, sizeof(d->smdh));
-	if (size != sizeof(d->smdh)) {
+	size_t size = d->file->read(&d->smdh, 512);
+	if (size != 512) {
 		d->smdh.header.magic = 0;
 		d->file->unref();
 		d->file = nullptr;
@@ -248,7 +410,7 @@ Nintendo3DS_SMDH::Nintendo3DS_SMDH(IRpFile *file)
 	// Check if this ROM image is supported.
 	DetectInfo info;
 	info.header.addr = 0;
-	info.header.size = sizeof(d->smdh);
+	info.header.size = 512;
 	info.header.pData = reinterpret_cast<const uint8_t*>(&d->smdh);
 	info.ext = nullptr;	// Not needed for Nintendo3DS_SMDH.
 	info.szFile = 0;	// Not needed for Nintendo3DS_SMDH.
@@ -315,6 +477,7 @@ const char *Nintendo3DS_SMDH::systemName(unsigned int type) const
 	// *and* the ROM's region code is China only.
 	if ((type & SYSNAME_REGION_MASK) == SYSNAME_REGION_ROM_LOCAL) {
 		// SMDH contains a region code bitfield.
+		const_cast<Nintendo3DS_SMDH_Private*>(d)->loadSettings();
 		if (d->smdh.header.settings.region_code == cpu_to_le32(N3DS_REGION_CHINA)) {
 			// Chinese exclusive.
 			idx |= (1U << 2);
@@ -461,6 +624,11 @@ int Nintendo3DS_SMDH::loadFieldData(void)
 		return 0;
 	}
 
+	// The field data shows a language dropdown, so all
+	// title entries are needed here, plus the settings.
+	d->loadAllTitles();
+	d->loadSettings();
+
 	// Maximum of 5 fields, plus 3 for iQue 3DS.
 	const bool is_iQue = (smdhHeader->settings.region_code == cpu_to_le32(N3DS_REGION_CHINA));
 	d->fields->reserve(is_iQue ? 8 : 5);
@@ -742,6 +910,79 @@ int Nintendo3DS_SMDH::loadInternalImage(ImageType imageType, const rp_image **pI
 	return (*pImage != nullptr ? 0 : -EIO);
 }
 
+/**
+ * Get an internal image from the ROM, closest to the specified size.
+ *
+ * For small requests, this decodes the 24x24 icon instead of
+ * the 48x48 icon, which is faster to decode.
+ *
+ * NOTE: The rp_image is owned by this object.
+ * Do NOT delete this object until you're done using this rp_image.
+ *
+ * @param imageType	[in] Image type to load.
+ * @param reqSize	[in] Requested image size. (single dimension; assuming square image)
+ * @return Internal image, or nullptr if the ROM doesn't have one.
+ */
+const rp_image *Nintendo3DS_SMDH::imageForSize(ImageType imageType, int reqSize) const
+{
+	RP_D(const Nintendo3DS_SMDH);
+	if (imageType != IMG_INT_ICON || !d->isValid) {
+		// Only IMG_INT_ICON is supported by 3DS.
+		return nullptr;
+	}
+
+	if (reqSize > 0 && reqSize <= N3DS_SMDH_ICON_SMALL_W) {
+		// Small request. Decode the 24x24 icon.
+		// NOTE: Some older homebrew, including RxTools,
+		// has a broken 24x24 icon. Fall back to the
+		// 48x48 icon if the small icon can't be decoded.
+		const rp_image *const icon = const_cast<Nintendo3DS_SMDH_Private*>(d)->loadIcon(0);
+		if (icon) {
+			return icon;
+		}
+	}
+
+	// Use the large icon. (48x48)
+	return const_cast<Nintendo3DS_SMDH_Private*>(d)->loadIcon(1);
+}
+
+/**
+ * Load the ROM's icon directly from the file, without
+ * constructing a RomData instance. (fast icon extraction)
+ *
+ * Only possible for formats where the icon is located at
+ * an address computable from the header alone. The caller
+ * must have already verified the file's magic number,
+ * e.g. via RomDataFactory.
+ *
+ * @param file	[in] Opened ROM file.
+ * @return Icon, or nullptr on error. (Caller must delete the icon.)
+ */
+rp_image *Nintendo3DS_SMDH::fastIcon_static(IRpFile *file)
+{
+	assert(file != nullptr);
+	if (!file || !file->isOpen()) {
+		return nullptr;
+	}
+
+	// The icon section is located immediately after the SMDH header.
+	// Read only the large (48x48) icon data.
+	uint16_t large[N3DS_SMDH_ICON_LARGE_W * N3DS_SMDH_ICON_LARGE_H];
+	const size_t size = file->seekAndRead(
+		sizeof(N3DS_SMDH_Header_t) + offsetof(N3DS_SMDH_Icon_t, large),
+		large, sizeof(large));
+	if (size != sizeof(large)) {
+		// Seek and/or read error.
+		return nullptr;
+	}
+
+	// Convert the icon to rp_image.
+	// NOTE: Assuming RGB565 format, the same as loadIcon().
+	return ImageDecoder::fromN3DSTiledRGB565(
+		N3DS_SMDH_ICON_LARGE_W, N3DS_SMDH_ICON_LARGE_H,
+		large, sizeof(large));
+}
+
 /** Special SMDH accessor functions. **/
 
 /**
@@ -755,6 +996,7 @@ uint32_t Nintendo3DS_SMDH::getRegionCode(void) const
 		// Invalid magic number.
 		return 0;
 	}
+	const_cast<Nintendo3DS_SMDH_Private*>(d)->loadSettings();
 	return le32_to_cpu(d->smdh.header.settings.region_code);
 }
 
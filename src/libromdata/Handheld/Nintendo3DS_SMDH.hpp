@@ -20,6 +20,8 @@ ROMDATA_DECL_METADATA()
 ROMDATA_DECL_IMGSUPPORT()
 ROMDATA_DECL_IMGPF()
 ROMDATA_DECL_IMGINT()
+ROMDATA_DECL_IMGINTFORSIZE()
+ROMDATA_DECL_FASTICON()
 
 	public:
 		/** Special SMDH accessor functions. **/
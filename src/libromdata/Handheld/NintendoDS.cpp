@@ -1213,10 +1213,14 @@ int NintendoDS::loadFieldData(void)
 		latin1_to_utf8(romHeader->id6, ARRAY_SIZE(romHeader->id6)));
 
 	// Publisher.
+	// NOTE: Only intern the publisher if it came from the
+	// publishers table. The fallback string is formatted from
+	// raw header bytes, so it's an unbounded set.
 	const char *const publisher = NintendoPublishers::lookup(romHeader->company);
 	d->fields->addField_string(C_("RomData", "Publisher"),
 		publisher ? publisher :
-			rp_sprintf(C_("NintendoDS", "Unknown (%.2s)"), romHeader->company));
+			rp_sprintf(C_("NintendoDS", "Unknown (%.2s)"), romHeader->company),
+		(publisher ? static_cast<unsigned int>(RomFields::STRF_INTERN) : 0U));
 
 	// ROM version.
 	d->fields->addField_string_numeric(C_("RomData", "Revision"),
@@ -1540,6 +1544,76 @@ int NintendoDS::loadInternalImage(ImageType imageType, const rp_image **pImage)
 		d->loadIcon);		// func
 }
 
+/**
+ * Load the ROM's icon directly from the file, without
+ * constructing a RomData instance. (fast icon extraction)
+ *
+ * Only possible for formats where the icon is located at
+ * an address computable from the header alone. The caller
+ * must have already verified the file's magic number,
+ * e.g. via RomDataFactory.
+ *
+ * @param file	[in] Opened ROM file.
+ * @return Icon, or nullptr on error. (Caller must delete the icon.)
+ */
+rp_image *NintendoDS::fastIcon_static(IRpFile *file)
+{
+	assert(file != nullptr);
+	if (!file || !file->isOpen()) {
+		return nullptr;
+	}
+
+	// Get the address of the icon/title data from the ROM header.
+	uint32_t icon_offset;
+	size_t size = file->seekAndRead(offsetof(NDS_RomHeader, icon_offset),
+		&icon_offset, sizeof(icon_offset));
+	if (size != sizeof(icon_offset)) {
+		// Seek and/or read error.
+		return nullptr;
+	}
+	icon_offset = le32_to_cpu(icon_offset);
+	// Icon must be located after the "secure area".
+	if (icon_offset <= 0x8000) {
+		// No icon/title information.
+		return nullptr;
+	}
+
+	// Read the static icon portion of the icon/title data.
+	// NOTE: Always using the standard NDS icon here. The animated
+	// DSi icon (v0103) is not needed, since file icons are static.
+	struct {
+		uint16_t version;	// known values: 0x0001, 0x0002, 0x0003, 0x0103
+		uint16_t crc16[4];	// CRC16s for the four known versions.
+		uint8_t reserved1[0x16];
+		uint8_t icon_data[0x200];	// Icon data. (32x32, 4x4 tiles, 4-bit color)
+		uint16_t icon_pal[0x10];	// Icon palette. (16-bit color; color 0 is transparent)
+	} icon_title;
+	static_assert(sizeof(icon_title) == 0x240,
+		"icon_title struct does not match the NDS_IconTitleData prefix.");
+	size = file->seekAndRead(icon_offset, &icon_title, sizeof(icon_title));
+	if (size != sizeof(icon_title)) {
+		// Seek and/or read error.
+		return nullptr;
+	}
+
+	// Verify the version number.
+	switch (le16_to_cpu(icon_title.version)) {
+		case NDS_ICON_VERSION_ORIGINAL:
+		case NDS_ICON_VERSION_HANS:
+		case NDS_ICON_VERSION_HANS_KO:
+		case NDS_ICON_VERSION_DSi:
+			break;
+		default:
+			// Invalid version number.
+			return nullptr;
+	}
+
+	// Convert the NDS icon to rp_image.
+	return ImageDecoder::fromNDS_CI4(32, 32,
+		icon_title.icon_data, sizeof(icon_title.icon_data),
+		icon_title.icon_pal,  sizeof(icon_title.icon_pal));
+}
+
 /**
  * Get the animated icon data.
  *
@@ -1592,8 +1666,13 @@ int NintendoDS::extURLs(ImageType imageType, vector<ExtURL> *pExtURLs, int size)
 	ASSERT_extURLs(imageType, pExtURLs);
 	pExtURLs->clear();
 
-	// Check for DS ROMs that don't have boxart.
 	RP_D(const NintendoDS);
+	// Check for a memoized result.
+	if (d->extURLsCache_lookup(imageType, size, pExtURLs)) {
+		return 0;
+	}
+
+	// Check for DS ROMs that don't have boxart.
 	if (!d->isValid || d->romType < 0) {
 		// ROM image isn't valid.
 		return -EIO;
@@ -1715,6 +1794,7 @@ int NintendoDS::extURLs(ImageType imageType, vector<ExtURL> *pExtURLs, int size)
 	}
 
 	// All URLs added.
+	d->extURLsCache_store(imageType, size, *pExtURLs);
 	return 0;
 }
 
@@ -43,6 +43,7 @@ ROMDATA_DECL_METADATA()
 ROMDATA_DECL_IMGSUPPORT()
 ROMDATA_DECL_IMGPF()
 ROMDATA_DECL_IMGINT()
+ROMDATA_DECL_FASTICON()
 ROMDATA_DECL_ICONANIM()
 ROMDATA_DECL_IMGEXT()
 ROMDATA_DECL_END()
@@ -375,7 +375,11 @@ int VirtualBoy::loadFieldData(void)
 				static_cast<uint8_t>(romHeader->publisher[1]));
 		}
 	}
-	d->fields->addField_string(C_("RomData", "Publisher"), s_publisher);
+	// NOTE: Only intern the publisher if it came from the
+	// publishers table. The fallback string is formatted from
+	// raw header bytes, so it's an unbounded set.
+	d->fields->addField_string(C_("RomData", "Publisher"), s_publisher,
+		(publisher ? static_cast<unsigned int>(RomFields::STRF_INTERN) : 0U));
 
 	// Revision
 	d->fields->addField_string_numeric(C_("RomData", "Revision"),
@@ -442,31 +442,32 @@ int Amiibo::loadFieldData(void)
 			rp_sprintf(C_("RomData", "Unknown (0x%02X)"), (char_id & 0xFF)));
 	}
 
+	// Identification record. Memoized by AmiiboData, so
+	// repeated dumps of the same figure within one scan
+	// resolve in a single cache probe.
+	const AmiiboData::AmiiboRecord_t *const amiibo =
+		AmiiboData::lookup_amiibo(char_id, amiibo_id);
+
 	// Character series
-	const char *const char_series = AmiiboData::lookup_char_series_name(char_id);
 	d->fields->addField_string(C_("Amiibo", "Character Series"),
-		char_series ? char_series : C_("RomData", "Unknown"));
+		amiibo->char_series ? amiibo->char_series : C_("RomData", "Unknown"));
 
 	// Character name
-	const char *const char_name = AmiiboData::lookup_char_name(char_id);
 	d->fields->addField_string(C_("Amiibo", "Character Name"),
-		char_name ? char_name : C_("RomData", "Unknown"));
+		amiibo->char_name ? amiibo->char_name : C_("RomData", "Unknown"));
 
 	// amiibo series
-	const char *const amiibo_series = AmiiboData::lookup_amiibo_series_name(amiibo_id);
 	d->fields->addField_string(C_("Amiibo", "amiibo Series"),
-		amiibo_series ? amiibo_series : C_("RomData", "Unknown"));
+		amiibo->amiibo_series ? amiibo->amiibo_series : C_("RomData", "Unknown"));
 
 	// amiibo name, wave number, and release number.
-	int wave_no, release_no;
-	const char *const amiibo_name = AmiiboData::lookup_amiibo_series_data(amiibo_id, &release_no, &wave_no);
-	if (amiibo_name) {
-		d->fields->addField_string(C_("Amiibo", "amiibo Name"), amiibo_name);
-		if (wave_no != 0) {
-			d->fields->addField_string_numeric(C_("Amiibo", "amiibo Wave #"), wave_no);
+	if (amiibo->amiibo_name) {
+		d->fields->addField_string(C_("Amiibo", "amiibo Name"), amiibo->amiibo_name);
+		if (amiibo->wave_no != 0) {
+			d->fields->addField_string_numeric(C_("Amiibo", "amiibo Wave #"), amiibo->wave_no);
 		}
-		if (release_no != 0) {
-			d->fields->addField_string_numeric(C_("Amiibo", "amiibo Release #"), release_no);
+		if (amiibo->release_no != 0) {
+			d->fields->addField_string_numeric(C_("Amiibo", "amiibo Release #"), amiibo->release_no);
 		}
 	}
 
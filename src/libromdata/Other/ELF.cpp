@@ -231,7 +231,6 @@ int ELFPrivate::checkProgramHeaders(void)
 	off64_t e_phoff;
 	unsigned int e_phnum;
 	unsigned int phsize;
-	uint8_t phbuf[sizeof(Elf64_Phdr)];
 
 	if (Elf_Header.primary.e_class == ELFCLASS64) {
 		e_phoff = static_cast<off64_t>(Elf_Header.elf64.e_phoff);
@@ -248,21 +247,26 @@ int ELFPrivate::checkProgramHeaders(void)
 		return 0;
 	}
 
-	int ret = file->seek(e_phoff);
-	if (ret != 0) {
-		// Seek error.
-		return ret;
+	// Sanity check: More than 64 program headers is unlikely.
+	// Bound the scan so a corrupted header can't cause
+	// an excessive read.
+	if (e_phnum > 64) {
+		e_phnum = 64;
 	}
 
-	// Read all of the program header entries.
-	const bool isHostEndian = (Elf_Header.primary.e_data == ELFDATAHOST);
-	for (; e_phnum > 0; e_phnum--) {
-		size_t size = file->read(phbuf, phsize);
-		if (size != phsize) {
-			// Read error.
-			break;
-		}
+	// Read the entire program header table in one go.
+	ao::uvector<uint8_t> phtbl;
+	phtbl.resize(e_phnum * phsize);
+	size_t size = file->seekAndRead(e_phoff, phtbl.data(), phtbl.size());
+	if (size != phtbl.size()) {
+		// Seek and/or read error.
+		return -EIO;
+	}
 
+	// Process all of the program header entries.
+	const bool isHostEndian = (Elf_Header.primary.e_data == ELFDATAHOST);
+	const uint8_t *phbuf = phtbl.data();
+	for (; e_phnum > 0; e_phnum--, phbuf += phsize) {
 		// Check the type.
 		uint32_t p_type;
 		memcpy(&p_type, phbuf, sizeof(p_type));
@@ -282,17 +286,11 @@ int ELFPrivate::checkProgramHeaders(void)
 				// NOTE: Interpreter should be NULL-terminated.
 				if (info.size <= 256) {
 					char buf[256];
-					const off64_t prevoff = file->tell();
 					size = file->seekAndRead(info.addr, buf, info.size);
 					if (size != info.size) {
 						// Seek and/or read error.
 						return -EIO;
 					}
-					ret = file->seek(prevoff);
-					if (ret != 0) {
-						// Seek error.
-						return ret;
-					}
 
 					// Remove trailing NULLs.
 					while (info.size > 0 && buf[info.size-1] == 0) {
@@ -340,7 +338,6 @@ int ELFPrivate::checkSectionHeaders(void)
 	off64_t e_shoff;
 	unsigned int e_shnum;
 	unsigned int shsize;
-	uint8_t shbuf[sizeof(Elf64_Shdr)];
 
 	if (Elf_Header.primary.e_class == ELFCLASS64) {
 		e_shoff = static_cast<off64_t>(Elf_Header.elf64.e_shoff);
@@ -357,21 +354,27 @@ int ELFPrivate::checkSectionHeaders(void)
 		return 0;
 	}
 
-	int ret = file->seek(e_shoff);
-	if (ret != 0) {
-		// Seek error.
-		return ret;
+	// Sanity check: Only scan the first 1,024 section headers.
+	// We're only looking for SHT_NOTE sections, which the linker
+	// places near the beginning; unstripped binaries can have
+	// a huge section table, and we don't want to scan all of it.
+	if (e_shnum > 1024) {
+		e_shnum = 1024;
 	}
 
-	// Read all of the section header entries.
-	const bool isHostEndian = (Elf_Header.primary.e_data == ELFDATAHOST);
-	for (; e_shnum > 0; e_shnum--) {
-		size_t size = file->read(shbuf, shsize);
-		if (size != shsize) {
-			// Read error.
-			break;
-		}
+	// Read the section header table in one go.
+	ao::uvector<uint8_t> shtbl;
+	shtbl.resize(e_shnum * shsize);
+	size_t size = file->seekAndRead(e_shoff, shtbl.data(), shtbl.size());
+	if (size != shtbl.size()) {
+		// Seek and/or read error.
+		return -EIO;
+	}
 
+	// Process all of the section header entries.
+	const bool isHostEndian = (Elf_Header.primary.e_data == ELFDATAHOST);
+	const uint8_t *shbuf = shtbl.data();
+	for (; e_shnum > 0; e_shnum--, shbuf += shsize) {
 		// Check the type.
 		uint32_t s_type;
 		memcpy(&s_type, &shbuf[4], sizeof(s_type));
@@ -415,17 +418,11 @@ int ELFPrivate::checkSectionHeaders(void)
 		}
 
 		uint8_t buf[256];
-		const off64_t prevoff = file->tell();
 		size = file->seekAndRead(int_addr, buf, int_size);
 		if (size != int_size) {
 			// Seek and/or read error.
 			return -EIO;
 		}
-		ret = file->seek(prevoff);
-		if (ret != 0) {
-			// Seek error.
-			return ret;
-		}
 
 		// Parse the note.
 		Elf32_Nhdr *const nhdr = reinterpret_cast<Elf32_Nhdr*>(buf);
@@ -625,12 +622,29 @@ int ELFPrivate::addPtDynamicFields(void)
 	}
 
 	// Read the header.
+	// If the file is memory-mapped (e.g. PartitionFile),
+	// parse the segment in place instead of copying it.
 	const unsigned int sz_to_read = static_cast<unsigned int>(pt_dynamic.size);
-	unique_ptr<uint8_t[]> pt_dyn_buf(new uint8_t[sz_to_read]);
-	size_t size = file->seekAndRead(pt_dynamic.addr, pt_dyn_buf.get(), sz_to_read);
-	if (size != sz_to_read) {
-		// Read error.
-		return -3;
+	const uint8_t *pt_dyn_data = nullptr;
+	unique_ptr<uint8_t[]> pt_dyn_buf;
+	size_t size = sz_to_read;
+
+	const uint8_t *const pMap = static_cast<const uint8_t*>(file->map());
+	const off64_t fileSize = file->size();
+	if (pMap && fileSize >= static_cast<off64_t>(sz_to_read) &&
+	    pt_dynamic.addr <= fileSize - static_cast<off64_t>(sz_to_read))
+	{
+		// Mapped file. Parse in place.
+		pt_dyn_data = pMap + pt_dynamic.addr;
+	} else {
+		// Not mapped. Read the segment into a buffer.
+		pt_dyn_buf.reset(new uint8_t[sz_to_read]);
+		size = file->seekAndRead(pt_dynamic.addr, pt_dyn_buf.get(), sz_to_read);
+		if (size != sz_to_read) {
+			// Read error.
+			return -3;
+		}
+		pt_dyn_data = pt_dyn_buf.get();
 	}
 
 	// Process headers.
@@ -641,7 +655,7 @@ int ELFPrivate::addPtDynamicFields(void)
 	// TODO: DT_RPATH/DT_RUNPATH
 	// Requires string table parsing too?
 	if (Elf_Header.primary.e_class == ELFCLASS64) {
-		const Elf64_Dyn *phdr = reinterpret_cast<const Elf64_Dyn*>(pt_dyn_buf.get());
+		const Elf64_Dyn *phdr = reinterpret_cast<const Elf64_Dyn*>(pt_dyn_data);
 		const Elf64_Dyn *const phdr_end = phdr + (size / sizeof(*phdr));
 		// TODO: Don't allow duplicates?
 		for (; phdr < phdr_end; phdr++) {
@@ -660,7 +674,7 @@ int ELFPrivate::addPtDynamicFields(void)
 			}
 		}
 	} else {
-		const Elf32_Dyn *phdr = reinterpret_cast<const Elf32_Dyn*>(pt_dyn_buf.get());
+		const Elf32_Dyn *phdr = reinterpret_cast<const Elf32_Dyn*>(pt_dyn_data);
 		const Elf32_Dyn *const phdr_end = phdr + (size / sizeof(*phdr));
 		for (; phdr < phdr_end; phdr++) {
 			Elf32_Sword d_tag = elf32_to_cpu(phdr->d_tag);
@@ -873,9 +887,9 @@ ELF::ELF(IRpFile *file)
 		}
 	} else {
 		// Standard ELF executable.
-		// Check program and section headers.
-		d->checkProgramHeaders();
-		d->checkSectionHeaders();
+		// NOTE: Program and section headers are loaded lazily.
+		// The only field needed here is PIE detection for ET_DYN,
+		// which requires the program headers.
 
 		// Determine the file and MIME types.
 		// NOTE: All of these MIME types are present on FreeDesktop.org,
@@ -896,6 +910,7 @@ ELF::ELF(IRpFile *file)
 			case ET_DYN:
 				// This may either be a shared library or a
 				// position-independent executable.
+				d->checkProgramHeaders();
 				if (d->isPie) {
 					d->fileType = FTYPE_EXECUTABLE;
 					d->mimeType = "application/x-executable";
@@ -1096,6 +1111,13 @@ int ELF::loadFieldData(void)
 		return -EIO;
 	}
 
+	// Program and section headers are loaded lazily.
+	// Several fields below depend on them, so check them now.
+	if (!d->isWiiU) {
+		d->checkProgramHeaders();
+		d->checkSectionHeaders();
+	}
+
 	// Primary ELF header.
 	const Elf_PrimaryEhdr *const primary = &d->Elf_Header.primary;
 	d->fields->reserve(12);	// Maximum of 12 fields. [3 for machine subtype] [TODO verify this]
@@ -1496,7 +1518,7 @@ int ELF::loadFieldData(void)
 			}
 
 			if (!s_cf_isa.empty()) {
-				d->fields->addField_string(C_("ELF", "ColdFire ISA"), s_cf_isa);
+				d->fields->addField_string(C_("ELF", "ColdFire ISA"), std::move(s_cf_isa));
 			}
 			break;
 		}
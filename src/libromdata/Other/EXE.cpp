@@ -45,11 +45,13 @@ EXEPrivate::EXEPrivate(EXE *q, IRpFile *file)
 	: super(q, file)
 	, exeType(EXE_TYPE_UNKNOWN)
 	, rsrcReader(nullptr)
+	, versionInfoRet(1)
 	, pe_subsystem(IMAGE_SUBSYSTEM_UNKNOWN)
 {
 	// Clear the structs.
 	memset(&mz, 0, sizeof(mz));
 	memset(&hdr, 0, sizeof(hdr));
+	memset(&vsffi, 0, sizeof(vsffi));
 }
 
 EXEPrivate::~EXEPrivate()
@@ -57,6 +59,30 @@ EXEPrivate::~EXEPrivate()
 	delete rsrcReader;
 }
 
+/**
+ * Load and cache the VS_VERSION_INFO resource.
+ * The resource reader must be initialized first;
+ * see loadNEResourceTable() and loadPEResourceTypes().
+ *
+ * On success, vsffi and vssfi are valid.
+ *
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int EXEPrivate::loadVersionInfo(void)
+{
+	if (versionInfoRet <= 0) {
+		// Already attempted to load VS_VERSION_INFO.
+		return versionInfoRet;
+	} else if (!rsrcReader) {
+		// No resource reader...
+		return -EBADF;
+	}
+
+	// NOTE: load_VS_VERSION_INFO loads it in host-endian.
+	versionInfoRet = rsrcReader->load_VS_VERSION_INFO(VS_VERSION_INFO, -1, &vsffi, &vssfi);
+	return versionInfoRet;
+}
+
 /**
  * Add VS_VERSION_INFO fields.
  *
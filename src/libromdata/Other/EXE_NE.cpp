@@ -419,10 +419,8 @@ void EXEPrivate::addFields_NE(void)
 	}
 
 	// Load the version resource.
-	// NOTE: load_VS_VERSION_INFO loads it in host-endian.
-	VS_FIXEDFILEINFO vsffi;
-	IResourceReader::StringFileInfo vssfi;
-	ret = rsrcReader->load_VS_VERSION_INFO(VS_VERSION_INFO, -1, &vsffi, &vssfi);
+	// NOTE: loadVersionInfo() caches it in host-endian.
+	ret = loadVersionInfo();
 	if (ret != 0) {
 		// Unable to load the version resource.
 		// We're done here.
@@ -510,7 +510,7 @@ void EXEPrivate::addFields_PE(void)
 		// .NET executable.
 		s_cpu += " (.NET)";
 	}
-	fields->addField_string(C_("EXE", "CPU"), s_cpu);
+	fields->addField_string(C_("EXE", "CPU"), std::move(s_cpu));
 
 	// OS version.
 	fields->addField_string(C_("EXE", "OS Version"),
@@ -626,10 +626,8 @@ void EXEPrivate::addFields_PE(void)
 	}
 
 	// Load the version resource.
-	// NOTE: load_VS_VERSION_INFO loads it in host-endian.
-	VS_FIXEDFILEINFO vsffi;
-	IResourceReader::StringFileInfo vssfi;
-	ret = rsrcReader->load_VS_VERSION_INFO(VS_VERSION_INFO, -1, &vsffi, &vssfi);
+	// NOTE: loadVersionInfo() caches it in host-endian.
+	ret = loadVersionInfo();
 	if (ret != 0) {
 		// Unable to load the version resource.
 		// We're done here.
@@ -75,6 +75,24 @@ class EXEPrivate : public LibRpBase::RomDataPrivate
 		// Resource reader.
 		IResourceReader *rsrcReader;
 
+		// Cached VS_VERSION_INFO resource. (loadVersionInfo)
+		// Parsed once per file; both the property page fields
+		// and any metadata queries use the same copy.
+		int versionInfoRet;	// Cached return value. (>0 == not loaded yet)
+		VS_FIXEDFILEINFO vsffi;
+		IResourceReader::StringFileInfo vssfi;
+
+		/**
+		 * Load and cache the VS_VERSION_INFO resource.
+		 * The resource reader must be initialized first;
+		 * see loadNEResourceTable() and loadPEResourceTypes().
+		 *
+		 * On success, vsffi and vssfi are valid.
+		 *
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadVersionInfo(void);
+
 		/**
 		 * Add VS_VERSION_INFO fields.
 		 *
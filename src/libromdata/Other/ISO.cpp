@@ -60,6 +60,25 @@ class ISOPrivate : public LibRpBase::RomDataPrivate
 		const char *s_udf_version;
 
 	public:
+		/**
+		 * Check if a Primary Volume Descriptor is valid.
+		 * @param pvd PVD to check.
+		 * @return True if valid; false if not.
+		 */
+		static bool isPVDValid(const ISO_Primary_Volume_Descriptor *pvd)
+		{
+			return (pvd->header.type == ISO_VDT_PRIMARY &&
+				pvd->header.version == ISO_VD_VERSION &&
+				!memcmp(pvd->header.identifier, ISO_VD_MAGIC, sizeof(pvd->header.identifier)));
+		}
+
+		/**
+		 * Read the PVD from the file and determine the sector size.
+		 * On success, pvd, sector_size, and sector_offset are valid.
+		 * @return True if a valid PVD was found; false if not.
+		 */
+		bool readPVD(void);
+
 		/**
 		 * Check additional volume descirptors.
 		 */
@@ -90,6 +109,47 @@ ISOPrivate::ISOPrivate(ISO *q, IRpFile *file)
 	memset(&pvd, 0, sizeof(pvd));
 }
 
+/**
+ * Read the PVD from the file and determine the sector size.
+ * On success, pvd, sector_size, and sector_offset are valid.
+ * @return True if a valid PVD was found; false if not.
+ */
+bool ISOPrivate::readPVD(void)
+{
+	// Read the PVD. (2048-byte sector address)
+	size_t size = file->seekAndRead(ISO_PVD_ADDRESS_2048 + ISO_DATA_OFFSET_MODE1_COOKED,
+		&pvd, sizeof(pvd));
+	if (size != sizeof(pvd)) {
+		// Seek and/or read error.
+		return false;
+	}
+
+	if (isPVDValid(&pvd)) {
+		// Found the PVD using 2048-byte sectors.
+		sector_size = ISO_SECTOR_SIZE_MODE1_COOKED;
+		sector_offset = ISO_DATA_OFFSET_MODE1_COOKED;
+		return true;
+	}
+
+	// Try again using 2352-byte sectors.
+	size = file->seekAndRead(ISO_PVD_ADDRESS_2352 + ISO_DATA_OFFSET_MODE1_RAW,
+		&pvd, sizeof(pvd));
+	if (size != sizeof(pvd)) {
+		// Seek and/or read error.
+		return false;
+	}
+
+	if (isPVDValid(&pvd)) {
+		// Found the PVD using 2352-byte sectors.
+		sector_size = ISO_SECTOR_SIZE_MODE1_RAW;
+		sector_offset = ISO_DATA_OFFSET_MODE1_RAW;
+		return true;
+	}
+
+	// Not a PVD.
+	return false;
+}
+
 /**
  * Check additional volume descirptors.
  */
@@ -207,50 +267,63 @@ ISO::ISO(IRpFile *file)
 		return;
 	}
 
-	// Read the PVD. (2048-byte sector address)
-	size_t size = d->file->seekAndRead(ISO_PVD_ADDRESS_2048 + ISO_DATA_OFFSET_MODE1_COOKED,
-		&d->pvd, sizeof(d->pvd));
-	if (size != sizeof(d->pvd)) {
-		// Seek and/or read error.
+	// Read the PVD and determine the sector size.
+	// NOTE: Not using isRomSupported_static(), since this function
+	// only checks the file extension.
+	if (!d->readPVD()) {
+		// Not a PVD.
 		d->file->unref();
 		d->file = nullptr;
 		return;
 	}
 
-	// Check if the PVD is valid.
-	// NOTE: Not using isRomSupported_static(), since this function
-	// only checks the file extension.
-	if (d->pvd.header.type == ISO_VDT_PRIMARY &&
-	    d->pvd.header.version == ISO_VD_VERSION &&
-	    !memcmp(d->pvd.header.identifier, ISO_VD_MAGIC, sizeof(d->pvd.header.identifier)))
-	{
-		// Found the PVD using 2048-byte sectors.
+	// This is a valid PVD.
+	d->isValid = true;
+
+	// Check for additional volume descriptors.
+	d->checkVolumeDescriptors();
+}
+
+/**
+ * Read an ISO-9660 disc image, using a cached
+ * Primary Volume Descriptor if available.
+ *
+ * Same as the regular constructor, except that if the
+ * caller has already read and validated the PVD (e.g.
+ * XboxDisc or IsoPartition), it's used directly instead
+ * of re-reading it from the file.
+ *
+ * NOTE: The cached PVD must have been read using
+ * 2048-byte cooked sectors.
+ *
+ * @param file Open ROM image.
+ * @param pvd Cached PVD, or nullptr to read it from the file.
+ */
+ISO::ISO(IRpFile *file, const ISO_Primary_Volume_Descriptor *pvd)
+	: super(new ISOPrivate(this, file))
+{
+	// This class handles disc images.
+	RP_D(ISO);
+	d->className = "ISO";
+	d->mimeType = "application/x-cd-image";	// unofficial [TODO: Others?]
+	d->fileType = FTYPE_DISC_IMAGE;
+
+	if (!d->file) {
+		// Could not ref() the file handle.
+		return;
+	}
+
+	if (pvd && ISOPrivate::isPVDValid(pvd)) {
+		// Use the cached PVD. (2048-byte cooked sectors)
+		memcpy(&d->pvd, pvd, sizeof(d->pvd));
 		d->sector_size = ISO_SECTOR_SIZE_MODE1_COOKED;
 		d->sector_offset = ISO_DATA_OFFSET_MODE1_COOKED;
-	} else {
-		// Try again using 2352-byte sectors.
-		size = d->file->seekAndRead(ISO_PVD_ADDRESS_2352 + ISO_DATA_OFFSET_MODE1_RAW,
-			&d->pvd, sizeof(d->pvd));
-		if (size != sizeof(d->pvd)) {
-			// Seek and/or read error.
-			d->file->unref();
-			d->file = nullptr;
-			return;
-		}
-
-		if (d->pvd.header.type == ISO_VDT_PRIMARY &&
-		    d->pvd.header.version == ISO_VD_VERSION &&
-		    !memcmp(d->pvd.header.identifier, ISO_VD_MAGIC, sizeof(d->pvd.header.identifier)))
-		{
-			// Found the PVD using 2352-byte sectors.
-			d->sector_size = ISO_SECTOR_SIZE_MODE1_RAW;
-			d->sector_offset = ISO_DATA_OFFSET_MODE1_RAW;
-		} else {
-			// Not a PVD.
-			d->file->unref();
-			d->file = nullptr;
-			return;
-		}
+	} else if (!d->readPVD()) {
+		// No cached PVD, and a valid PVD
+		// couldn't be read from the file.
+		d->file->unref();
+		d->file = nullptr;
+		return;
 	}
 
 	// This is a valid PVD.
@@ -10,10 +10,30 @@
 #define __ROMPROPERTIES_LIBROMDATA_OTHER_ISO_HPP__
 
 #include "librpbase/RomData.hpp"
+#include "../iso_structs.h"
 
 namespace LibRomData {
 
 ROMDATA_DECL_BEGIN(ISO)
+
+	public:
+		/**
+		 * Read an ISO-9660 disc image, using a cached
+		 * Primary Volume Descriptor if available.
+		 *
+		 * Same as the regular constructor, except that if the
+		 * caller has already read and validated the PVD (e.g.
+		 * XboxDisc or IsoPartition), it's used directly instead
+		 * of re-reading it from the file.
+		 *
+		 * NOTE: The cached PVD must have been read using
+		 * 2048-byte cooked sectors.
+		 *
+		 * @param file Open ROM image.
+		 * @param pvd Cached PVD, or nullptr to read it from the file.
+		 */
+		ISO(LibRpFile::IRpFile *file, const ISO_Primary_Volume_Descriptor *pvd);
+
 ROMDATA_DECL_END()
 
 }
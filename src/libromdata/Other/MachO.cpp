@@ -77,12 +77,40 @@ class MachOPrivate : public LibRpBase::RomDataPrivate
 		vector<int8_t> machFormats;
 		ao::uvector<mach_header> machHeaders;
 
+		// Fat binary slice offsets, in file order.
+		// Only the first slice's Mach-O header is loaded in the
+		// constructor; the rest are loaded when they're needed.
+		ao::uvector<uint32_t> fatOffsets;
+		unsigned int fatSlicesLoaded;
+
 		/**
 		 * Check the Mach-O magic number.
 		 * @param magic Magic number as read directly from disk.
 		 * @return Mach_Format value.
 		 */
 		static int checkMachMagicNumber(uint32_t magic);
+
+		/**
+		 * Byteswap a Mach-O header to host-endian, if necessary.
+		 * NOTE: The magic number is not swapped.
+		 * @param machFormat Mach_Format value.
+		 * @param machHeader Mach-O header.
+		 */
+		static void swapMachHeader(int machFormat, mach_header *machHeader);
+
+		/**
+		 * Load a Mach-O header from the file and append it to
+		 * machFormats / machHeaders.
+		 * @param offset File offset of the Mach-O header.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadMachHeader(uint32_t offset);
+
+		/**
+		 * Load the Mach-O headers for the remaining fat binary slices.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadRemainingSlices(void);
 };
 
 /** MachOPrivate **/
@@ -90,6 +118,7 @@ class MachOPrivate : public LibRpBase::RomDataPrivate
 MachOPrivate::MachOPrivate(MachO *q, IRpFile *file)
 	: super(q, file)
 	, execFormat(EXEC_FORMAT_UNKNOWN)
+	, fatSlicesLoaded(0)
 { }
 
 /**
@@ -117,6 +146,89 @@ int MachOPrivate::checkMachMagicNumber(uint32_t magic)
 	return ret;
 }
 
+/**
+ * Byteswap a Mach-O header to host-endian, if necessary.
+ * NOTE: The magic number is not swapped.
+ * @param machFormat Mach_Format value.
+ * @param machHeader Mach-O header.
+ */
+void MachOPrivate::swapMachHeader(int machFormat, mach_header *machHeader)
+{
+	switch (machFormat) {
+		default:
+			// Invalid format. Continue anyway...
+			break;
+
+		case MACH_FORMAT_32HOST:
+		case MACH_FORMAT_64HOST:
+			// Host-endian. Nothing to do.
+			break;
+
+		case MACH_FORMAT_32SWAP:
+		case MACH_FORMAT_64SWAP:
+			// Swapped endian.
+			machHeader->cputype	= __swab32(machHeader->cputype);
+			machHeader->cpusubtype	= __swab32(machHeader->cpusubtype);
+			machHeader->filetype	= __swab32(machHeader->filetype);
+			machHeader->ncmds	= __swab32(machHeader->ncmds);
+			machHeader->sizeofcmds	= __swab32(machHeader->sizeofcmds);
+			machHeader->flags	= __swab32(machHeader->flags);
+			break;
+	}
+}
+
+/**
+ * Load a Mach-O header from the file and append it to
+ * machFormats / machHeaders.
+ * @param offset File offset of the Mach-O header.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MachOPrivate::loadMachHeader(uint32_t offset)
+{
+	assert(file != nullptr);
+	if (!file) {
+		return -EBADF;
+	}
+
+	const size_t idx = machFormats.size();
+	machFormats.resize(idx+1);
+	machHeaders.resize(idx+1);
+	size_t size = file->seekAndRead(offset, &machHeaders[idx], sizeof(mach_header));
+	if (size != sizeof(mach_header)) {
+		// Unable to read this header.
+		machFormats.resize(idx);
+		machHeaders.resize(idx);
+		return -EIO;
+	}
+
+	machFormats[idx] = checkMachMagicNumber(machHeaders[idx].magic);
+	swapMachHeader(machFormats[idx], &machHeaders[idx]);
+	return 0;
+}
+
+/**
+ * Load the Mach-O headers for the remaining fat binary slices.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int MachOPrivate::loadRemainingSlices(void)
+{
+	if (fatSlicesLoaded >= fatOffsets.size()) {
+		// All slices have already been loaded.
+		return 0;
+	} else if (!file || !file->isOpen()) {
+		// File isn't open.
+		return -EBADF;
+	}
+
+	for (; fatSlicesLoaded < fatOffsets.size(); fatSlicesLoaded++) {
+		// Read errors are skipped here, same as in the constructor.
+		// TODO: Show an error?
+		loadMachHeader(fatOffsets[fatSlicesLoaded]);
+	}
+
+	return 0;
+}
+
 /** MachO **/
 
 /**
@@ -176,17 +288,19 @@ MachO::MachO(IRpFile *file)
 			d->machHeaders.resize(1);
 			memcpy(&d->machHeaders[0], header, sizeof(mach_header));
 			d->machFormats[0] = d->checkMachMagicNumber(d->machHeaders[0].magic);
+			d->swapMachHeader(d->machFormats[0], &d->machHeaders[0]);
 			d->isValid = (d->machFormats[0] >= 0);
 			break;
 
 		case MachOPrivate::EXEC_FORMAT_FAT: {
-			// Read up to 16 architectures.
+			// The entire fat_arch table (up to 16 architectures)
+			// is in the initial header read, so no additional
+			// reads are needed to list the slice offsets.
 			const fat_header *const fatHeader =
 				reinterpret_cast<const fat_header*>(info.header.pData);
 			const unsigned int nfat_arch = std::min<uint32_t>(
 				MAX_MACH_HEADERS, be32_to_cpu(fatHeader->nfat_arch));
-			d->machFormats.reserve(nfat_arch);
-			d->machHeaders.reserve(nfat_arch);
+			d->fatOffsets.reserve(nfat_arch);
 
 			const fat_arch *fatArch =
 				reinterpret_cast<const fat_arch*>(info.header.pData + 8);
@@ -195,18 +309,18 @@ MachO::MachO(IRpFile *file)
 				if (offset < sizeof(fat_header)) {
 					continue;
 				}
+				d->fatOffsets.push_back(offset);
+			}
 
-				size_t idx = d->machFormats.size();
-				d->machFormats.resize(idx+1);
-				d->machHeaders.resize(idx+1);
-				size_t size = d->file->seekAndRead(offset, &d->machHeaders[i], sizeof(mach_header));
-				if (size == sizeof(mach_header)) {
-					d->machFormats[idx] = d->checkMachMagicNumber(d->machHeaders[idx].magic);
-				} else {
-					// Unable to read this header.
-					// TODO: Show an error?
-					d->machFormats.resize(idx);
-					d->machHeaders.resize(idx);
+			// Load the first slice's Mach-O header now.
+			// It's needed to validate the file and determine the
+			// file type; the remaining slices are only needed for
+			// the field data, so they're loaded on demand.
+			for (; d->fatSlicesLoaded < d->fatOffsets.size(); ) {
+				const int ret = d->loadMachHeader(d->fatOffsets[d->fatSlicesLoaded]);
+				d->fatSlicesLoaded++;
+				if (ret == 0) {
+					break;
 				}
 			}
 
@@ -229,43 +343,12 @@ MachO::MachO(IRpFile *file)
 		d->execFormat = MachOPrivate::EXEC_FORMAT_UNKNOWN;
 		d->machFormats.clear();
 		d->machHeaders.clear();
+		d->fatOffsets.clear();
 		d->file->unref();
 		d->file = nullptr;
 		return;
 	}
 
-	// Swap endianness if needed.
-	assert(d->machFormats.size() == d->machHeaders.size());
-	auto hdrIter = d->machHeaders.begin();
-	for (auto fmtIter = d->machFormats.cbegin();
-	     fmtIter != d->machFormats.cend(); ++fmtIter, ++hdrIter)
-	{
-		switch (*fmtIter) {
-			default:
-				// Invalid format. Continue anyway...
-				break;
-
-			case MachOPrivate::MACH_FORMAT_32HOST:
-			case MachOPrivate::MACH_FORMAT_64HOST:
-				// Host-endian. Nothing to do.
-				break;
-
-			case MachOPrivate::MACH_FORMAT_32SWAP:
-			case MachOPrivate::MACH_FORMAT_64SWAP: {
-				// Swapped endian.
-				// NOTE: Not swapping the magic number.
-				mach_header *const machHeader = &(*hdrIter);
-				machHeader->cputype	= __swab32(machHeader->cputype);
-				machHeader->cpusubtype	= __swab32(machHeader->cpusubtype);
-				machHeader->filetype	= __swab32(machHeader->filetype);
-				machHeader->ncmds	= __swab32(machHeader->ncmds);
-				machHeader->sizeofcmds	= __swab32(machHeader->sizeofcmds);
-				machHeader->flags	= __swab32(machHeader->flags);
-				break;
-			}
-		}
-	}
-
 	// Determine the file and MIME types.
 	// NOTE: This assumes all architectures have the same file type.
 	static const uint8_t fileTypes_tbl[] = {
@@ -461,6 +544,11 @@ int MachO::loadFieldData(void)
 		return -EIO;
 	}
 
+	// Load any fat binary slices that weren't needed until now.
+	if (d->execFormat == MachOPrivate::EXEC_FORMAT_FAT) {
+		d->loadRemainingSlices();
+	}
+
 	// Mach-O header.
 	// TODO: Show multiple headers.
 	if (d->machHeaders.empty()) {
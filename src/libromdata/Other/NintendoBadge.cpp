@@ -260,13 +260,13 @@ const rp_image *NintendoBadgePrivate::loadImage(int idx)
 			img[idx] = img48;
 		}
 	} else {
-		// Mega badge. Need to convert each 64x64 badge
-		// and concatenate them manually.
+		// Mega badge. Each 64x64 (or 32x32) cell is decoded
+		// directly into the composite image; every cell shares
+		// the same cached untile lookup table.
 
 		// Mega badge dimensions.
-		const unsigned int mb_width     = badgeHeader.prbs.mb_width;
-		const unsigned int mb_height    = badgeHeader.prbs.mb_height;
-		const unsigned int mb_row_bytes = badge_dims * sizeof(uint32_t);
+		const unsigned int mb_width  = badgeHeader.prbs.mb_width;
+		const unsigned int mb_height = badgeHeader.prbs.mb_height;
 
 		// Badges are stored vertically, then horizontally.
 		img[idx] = new rp_image(badge_dims * mb_width, badge_dims * mb_height, rp_image::FORMAT_ARGB32);
@@ -281,21 +281,18 @@ const rp_image *NintendoBadgePrivate::loadImage(int idx)
 					return nullptr;
 				}
 
-				rp_image *mb_img = ImageDecoder::fromN3DSTiledRGB565_A4(
-					badge_dims, badge_dims,
+				// Decode the cell in place.
+				const unsigned int mx = x*badge_dims;
+				int ret = ImageDecoder::fromN3DSTiledRGB565_A4_at(
+					img[idx], mx, my, badge_dims, badge_dims,
 					reinterpret_cast<const uint16_t*>(badgeData.get()), badge_rgb_sz,
 					badgeData.get() + badge_rgb_sz, badge_a4_sz);
-
-				// Copy the image into place.
-				// TODO: Pointer arithmetic instead of rp_image::scanLine().
-				const unsigned int mx = x*badge_dims;
-				for (int py = badge_dims-1; py >= 0; py--) {
-					const uint32_t *src = static_cast<const uint32_t*>(mb_img->scanLine(py));
-					uint32_t *dest = static_cast<uint32_t*>(img[idx]->scanLine(py+my)) + mx;
-					memcpy(dest, src, mb_row_bytes);
+				if (ret != 0) {
+					// Decoding error.
+					delete img[idx];
+					img[idx] = nullptr;
+					return nullptr;
 				}
-
-				delete mb_img;
 			}
 		}
 
@@ -345,4 +345,45 @@ int RpTextureWrapper::loadInternalImage(ImageType imageType, const rp_image **pI
 		d->texture->image);	// func
 }
 
+/**
+ * Get an internal image from the ROM, closest to the specified size.
+ *
+ * For formats with mipmaps, this may return a smaller mipmap
+ * that's still at least as large as the requested size,
+ * which is faster to decode than the full image.
+ *
+ * NOTE: The rp_image is owned by this object.
+ * Do NOT delete this object until you're done using this rp_image.
+ *
+ * @param imageType	[in] Image type to load.
+ * @param reqSize	[in] Requested image size. (single dimension; assuming square image)
+ * @return Internal image, or nullptr if the ROM doesn't have one.
+ */
+const rp_image *RpTextureWrapper::imageForSize(ImageType imageType, int reqSize) const
+{
+	RP_D(const RpTextureWrapper);
+	if (imageType != IMG_INT_IMAGE || !d->isValid) {
+		// Unsupported image type, or texture isn't valid.
+		return nullptr;
+	}
+
+	// Safety cap for thumbnailing: if the texture is very large and
+	// doesn't have a small enough mipmap, decode a subsampled image
+	// instead of the full-size image. This bounds both decode time
+	// and peak memory usage. (Thumbnailers rescale the result anyway.)
+	static const int MAX_DECODE_DIM = 2048;
+	d->texture->setMaxDecodeDimension(MAX_DECODE_DIM);
+
+	// Select the smallest mipmap that's at least as large
+	// as the requested size.
+	const int mip = d->texture->bestMipmapForSize(reqSize);
+	const rp_image *img = d->texture->mipmap(mip);
+	if (!img && mip > 0) {
+		// Couldn't decode the mipmap.
+		// Fall back to the full image.
+		img = d->texture->image();
+	}
+	return img;
+}
+
 }
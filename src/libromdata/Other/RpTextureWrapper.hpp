@@ -18,6 +18,7 @@ ROMDATA_DECL_METADATA()
 ROMDATA_DECL_IMGSUPPORT()
 ROMDATA_DECL_IMGPF()
 ROMDATA_DECL_IMGINT()
+ROMDATA_DECL_IMGINTFORSIZE()
 ROMDATA_DECL_END()
 
 }
@@ -0,0 +1,295 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * RomDataCapabilities_data.h: Capability snapshot. (generated)            *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// This file was generated by rp-capgen. Do not edit.
+// Regenerate from a full Linux build with:
+//   rp-capgen --header > RomDataCapabilities_data.h
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_ROMDATACAPABILITIES_DATA_H__
+#define __ROMPROPERTIES_LIBROMDATA_ROMDATACAPABILITIES_DATA_H__
+
+// Supported file extensions, with RomDataAttr bits. (168 entries)
+static const LibRomData::RomDataFactory::CapabilityExt romdata_cap_exts[] = {
+	{".32x", 0x08},
+	{".386", 0x00},
+	{".3ds", 0x07},
+	{".3dsx", 0x07},
+	{".3dz", 0x07},
+	{".68k", 0x08},
+	{".acm", 0x00},
+	{".adx", 0x04},
+	{".agb", 0x05},
+	{".ahx", 0x04},
+	{".app", 0x07},
+	{".ax", 0x00},
+	{".bcstm", 0x04},
+	{".bcwav", 0x04},
+	{".bfstm", 0x04},
+	{".bin", 0x10D},
+	{".bnr", 0x05},
+	{".brstm", 0x04},
+	{".bs", 0x00},
+	{".bsx", 0x00},
+	{".bundle", 0x00},
+	{".bwf", 0x05},
+	{".cab", 0x01},
+	{".cci", 0x07},
+	{".cfa", 0x07},
+	{".cgb", 0x05},
+	{".chd", 0x0D},
+	{".cia", 0x07},
+	{".ciso", 0x0D},
+	{".cmd", 0x05},
+	{".core", 0x00},
+	{".cpl", 0x00},
+	{".cso", 0x0D},
+	{".csu", 0x07},
+	{".cxi", 0x07},
+	{".dat", 0x05},
+	{".dci", 0x01},
+	{".dds", 0x05},
+	{".debug", 0x00},
+	{".dec", 0x0D},
+	{".dll", 0x00},
+	{".drv", 0x00},
+	{".dsf", 0x04},
+	{".dsi", 0x07},
+	{".dylib", 0x00},
+	{".efi", 0x00},
+	{".elf", 0x00},
+	{".exe", 0x00},
+	{".fds", 0x00},
+	{".fig", 0x00},
+	{".firm", 0x00},
+	{".fon", 0x00},
+	{".gb", 0x05},
+	{".gba", 0x05},
+	{".gbc", 0x05},
+	{".gbs", 0x04},
+	{".gbx", 0x05},
+	{".gci", 0x05},
+	{".gcm", 0x0D},
+	{".gcs", 0x05},
+	{".gdi", 0x0D},
+	{".gen", 0x08},
+	{".gg", 0x04},
+	{".gsf", 0x04},
+	{".gvr", 0x05},
+	{".icl", 0x00},
+	{".ids", 0x07},
+	{".iso", 0x10D},
+	{".iso9660", 0x109},
+	{".lnx", 0x00},
+	{".mb", 0x05},
+	{".mcb", 0x05},
+	{".mcs", 0x05},
+	{".mcx", 0x05},
+	{".md", 0x08},
+	{".mgd", 0x00},
+	{".min", 0x04},
+	{".minidsf", 0x04},
+	{".minigsf", 0x04},
+	{".minipsf", 0x04},
+	{".minipsf1", 0x04},
+	{".minipsf2", 0x04},
+	{".miniqsf", 0x04},
+	{".minisnsf", 0x04},
+	{".minissf", 0x04},
+	{".miniusf", 0x04},
+	{".mui", 0x00},
+	{".n64", 0x04},
+	{".ncch", 0x07},
+	{".nds", 0x07},
+	{".nes", 0x00},
+	{".nez", 0x00},
+	{".nfc", 0x01},
+	{".nfp", 0x01},
+	{".ngc", 0x04},
+	{".ngp", 0x04},
+	{".ngpc", 0x04},
+	{".nsf", 0x04},
+	{".o", 0x00},
+	{".ocx", 0x00},
+	{".pco", 0x08},
+	{".pda", 0x05},
+	{".prb", 0x01},
+	{".ps1", 0x05},
+	{".psf", 0x04},
+	{".psf1", 0x04},
+	{".psf2", 0x04},
+	{".psid", 0x04},
+	{".psv", 0x05},
+	{".psx", 0x05},
+	{".pvr", 0x05},
+	{".qd", 0x00},
+	{".qsf", 0x04},
+	{".rpl", 0x00},
+	{".rpx", 0x00},
+	{".rvm", 0x0D},
+	{".rvz", 0x0D},
+	{".sap", 0x04},
+	{".sav", 0x05},
+	{".scr", 0x00},
+	{".sfc", 0x00},
+	{".sgb", 0x05},
+	{".sgb2", 0x05},
+	{".sgd", 0x08},
+	{".sid", 0x04},
+	{".smc", 0x00},
+	{".smd", 0x08},
+	{".smdh", 0x05},
+	{".sms", 0x04},
+	{".sndh", 0x04},
+	{".snsf", 0x04},
+	{".so", 0x00},
+	{".spa", 0x01},
+	{".spc", 0x04},
+	{".srl", 0x07},
+	{".ssf", 0x04},
+	{".svr", 0x05},
+	{".swc", 0x00},
+	{".sys", 0x00},
+	{".tds", 0x00},
+	{".tex", 0x05},
+	{".texs", 0x05},
+	{".tgc", 0x0D},
+	{".tsp", 0x00},
+	{".ufo", 0x00},
+	{".usf", 0x04},
+	{".v64", 0x04},
+	{".vb", 0x00},
+	{".vgm", 0x04},
+	{".vgz", 0x04},
+	{".vmi", 0x01},
+	{".vms", 0x01},
+	{".vtf", 0x05},
+	{".vxd", 0x00},
+	{".wad", 0x05},
+	{".wbfs", 0x0D},
+	{".wia", 0x0D},
+	{".wibn", 0x01},
+	{".wud", 0x09},
+	{".wux", 0x09},
+	{".xbe", 0x05},
+	{".xbx", 0x05},
+	{".xdbf", 0x01},
+	{".xex", 0x05},
+	{".xexp", 0x05},
+	{".xiso", 0x109},
+	{".xpr", 0x05},
+	{".z64", 0x04},
+};
+
+// Supported MIME types. (103 entries)
+static const char *const romdata_cap_mimeTypes[] = {
+	"application/vnd.nintendo.snes.rom",
+	"application/x-atari-lynx-rom",
+	"application/x-cd-image",
+	"application/x-core",
+	"application/x-cso",
+	"application/x-dc-rom",
+	"application/x-dreamcast-cuesheet",
+	"application/x-dreamcast-dci",
+	"application/x-dreamcast-iso-image",
+	"application/x-dreamcast-rom",
+	"application/x-dreamcast-vms",
+	"application/x-dreamcast-vms-info",
+	"application/x-executable",
+	"application/x-fds-disk",
+	"application/x-game-com-rom",
+	"application/x-gameboy-color-rom",
+	"application/x-gameboy-rom",
+	"application/x-gamecube-bnr",
+	"application/x-gamecube-iso-image",
+	"application/x-gamecube-rom",
+	"application/x-gamecube-save",
+	"application/x-gamegear-rom",
+	"application/x-gba-rom",
+	"application/x-genesis-32x-rom",
+	"application/x-genesis-rom",
+	"application/x-ique-cmd",
+	"application/x-ique-dat",
+	"application/x-iso9660-image",
+	"application/x-mach-bundle",
+	"application/x-mach-core",
+	"application/x-mach-executable",
+	"application/x-mach-object",
+	"application/x-mach-sharedlib",
+	"application/x-mame-chd",
+	"application/x-ms-dos-executable",
+	"application/x-msdownload",
+	"application/x-n64-rom",
+	"application/x-nasos-image",
+	"application/x-neo-geo-pocket-color-rom",
+	"application/x-neo-geo-pocket-rom",
+	"application/x-nes-rom",
+	"application/x-nintendo-3ds-3dsx",
+	"application/x-nintendo-3ds-cia",
+	"application/x-nintendo-3ds-emmc",
+	"application/x-nintendo-3ds-firm",
+	"application/x-nintendo-3ds-ncch",
+	"application/x-nintendo-3ds-rom",
+	"application/x-nintendo-3ds-smdh",
+	"application/x-nintendo-amiibo",
+	"application/x-nintendo-badge",
+	"application/x-nintendo-badge-set",
+	"application/x-nintendo-ds-rom",
+	"application/x-nintendo-dsi-rom",
+	"application/x-object",
+	"application/x-pokemon-mini-rom",
+	"application/x-ps1-save",
+	"application/x-rvz",
+	"application/x-saturn-rom",
+	"application/x-sega-cd-32x-rom",
+	"application/x-sega-cd-rom",
+	"application/x-sega-pico-rom",
+	"application/x-sharedlib",
+	"application/x-sms-rom",
+	"application/x-snes-rom",
+	"application/x-virtual-boy-rom",
+	"application/x-wbfs",
+	"application/x-wia",
+	"application/x-wii-iso-image",
+	"application/x-wii-rom",
+	"application/x-wii-save",
+	"application/x-wii-u-rom",
+	"application/x-wii-wad",
+	"application/x-wii-wibn",
+	"application/x-xbox-executable",
+	"application/x-xbox360-executable",
+	"application/x-xbox360-patch",
+	"application/x-xbox360-stfs",
+	"application/x-xbox360-xdbf",
+	"audio/prs.sid",
+	"audio/x-adx",
+	"audio/x-bcstm",
+	"audio/x-bcwav",
+	"audio/x-bfstm",
+	"audio/x-brstm",
+	"audio/x-gbs",
+	"audio/x-minipsf",
+	"audio/x-nsf",
+	"audio/x-psf",
+	"audio/x-sap",
+	"audio/x-sndh",
+	"audio/x-spc",
+	"audio/x-vgm",
+	"image/vnd.valve.source.texture",
+	"image/x-dds",
+	"image/x-didj-texture",
+	"image/x-pvr",
+	"image/x-sega-gvr",
+	"image/x-sega-pvr",
+	"image/x-sega-pvrx",
+	"image/x-sega-svr",
+	"image/x-vtf",
+	"image/x-vtf3",
+	"image/x-xbox-xpr0",
+};
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_ROMDATACAPABILITIES_DATA_H__ */
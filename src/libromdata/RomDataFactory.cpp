@@ -14,17 +14,23 @@
 
 // librpbase, librpfile
 #include "librpfile/RelatedFile.hpp"
+#include "librpfile/RpBufferedFile.hpp"
+#include "librpfile/RpZipFile.hpp"
+#include "librpfile/RpStats.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
 
 // librpthreads
 #include "librpthreads/pthread_once.h"
+#include "librpthreads/Atomics.h"
+#include "librpthreads/Mutex.hpp"
 
 // librptexture
 #include "librptexture/FileFormatFactory.hpp"
 using LibRpTexture::FileFormatFactory;
 
 // C++ STL classes.
+using std::list;
 using std::string;
 using std::unordered_map;
 using std::unordered_set;
@@ -112,6 +118,7 @@ class RomDataFactoryPrivate
 		typedef const char *const * (*pfnSupportedFileExtensions_t)(void);
 		typedef const char *const * (*pfnSupportedMimeTypes_t)(void);
 		typedef RomData* (*pfnNewRomData_t)(IRpFile *file);
+		typedef LibRpTexture::rp_image* (*pfnFastIcon_t)(IRpFile *file);
 
 		struct RomDataFns {
 			pfnIsRomSupported_t isRomSupported;
@@ -124,6 +131,30 @@ class RomDataFactoryPrivate
 			// appear at specific addresses.
 			uint32_t address;
 			uint32_t size;	// Contains magic number for fast 32-bit magic checking.
+
+			// Number of bytes from the start of the file that
+			// isRomSupported() can make use of. The factory reads
+			// the union of the declared extents instead of a
+			// fixed-size block, which keeps probe I/O small on
+			// high-latency file systems.
+			// NOTE: 0 == the header block isn't used, e.g. for
+			// extension-only checks or non-zero header addresses.
+			uint32_t probeSize;
+
+			// Fast icon extraction function.
+			// Only set for formats where the icon is located at
+			// an address computable from the header alone.
+			pfnFastIcon_t fastIcon;
+
+			// Loose detection flag. Set for parsers whose
+			// isRomSupported() uses a short (16-bit) magic number
+			// or heuristics, so they must only be probed in table
+			// order, after stricter parsers have had a chance.
+			// These parsers are excluded from adaptive front-running.
+			bool looseMatch;
+
+			// Class name, for trace output. (see RpStats::traceEvent())
+			const char *name;
 		};
 
 		/**
@@ -136,19 +167,38 @@ class RomDataFactoryPrivate
 			return new klass(file);
 		}
 
-#define GetRomDataFns(sys, attrs) \
+#define GetRomDataFns(sys, attrs, probeSize) \
+	{sys::isRomSupported_static, \
+	 RomDataFactoryPrivate::RomData_ctor<sys>, \
+	 sys::supportedFileExtensions_static, \
+	 sys::supportedMimeTypes_static, \
+	 attrs, 0, 0, probeSize, nullptr, false, #sys}
+
+// Same as GetRomDataFns(), but for parsers with heuristic
+// or short-magic detection. (See RomDataFns::looseMatch.)
+#define GetRomDataFns_loose(sys, attrs, probeSize) \
 	{sys::isRomSupported_static, \
 	 RomDataFactoryPrivate::RomData_ctor<sys>, \
 	 sys::supportedFileExtensions_static, \
 	 sys::supportedMimeTypes_static, \
-	 attrs, 0, 0}
+	 attrs, 0, 0, probeSize, nullptr, true, #sys}
 
-#define GetRomDataFns_addr(sys, attrs, address, size) \
+#define GetRomDataFns_addr(sys, attrs, address, size, probeSize) \
 	{sys::isRomSupported_static, \
 	 RomDataFactoryPrivate::RomData_ctor<sys>, \
 	 sys::supportedFileExtensions_static, \
 	 sys::supportedMimeTypes_static, \
-	 attrs, address, size}
+	 attrs, address, size, probeSize, nullptr, false, #sys}
+
+// Same as GetRomDataFns_addr(), but with a fast icon
+// extraction function. (sys::fastIcon_static)
+#define GetRomDataFns_addr_fastIcon(sys, attrs, address, size, probeSize) \
+	{sys::isRomSupported_static, \
+	 RomDataFactoryPrivate::RomData_ctor<sys>, \
+	 sys::supportedFileExtensions_static, \
+	 sys::supportedMimeTypes_static, \
+	 attrs, address, size, probeSize, \
+	 sys::fastIcon_static, false, #sys}
 
 		// RomData subclasses that use a header at 0 and
 		// definitely have a 32-bit magic number in the header.
@@ -176,6 +226,28 @@ class RomDataFactoryPrivate
 		 */
 		static RomData *openDreamcastVMSandVMI(IRpFile *file);
 
+		/**
+		 * Internal implementation of RomDataFactory::create().
+		 * The public function handles the statistics counters.
+		 * @param file ROM file.
+		 * @param attrs RomDataAttr bitfield.
+		 * @param mimeFilter Candidate set from map_mimeDispatch, or nullptr for a full probe.
+		 * @return RomData subclass, or nullptr if the ROM isn't supported.
+		 */
+		static RomData *create_int(IRpFile *file, unsigned int attrs,
+			const unordered_set<const RomDataFns*> *mimeFilter = nullptr);
+
+		/**
+		 * Call a parser's isRomSupported() function, recording a
+		 * trace event with the verdict, elapsed time, and bytes
+		 * read if tracing is enabled. (rpcli --trace)
+		 * @param fns Parser function table entry.
+		 * @param info Detection information.
+		 * @return isRomSupported() result.
+		 */
+		static int probeWithTrace(const RomDataFns *fns,
+			const LibRpBase::RomData::DetectInfo *info);
+
 		// Vectors for file extensions and MIME types.
 		// We want to collect them once per session instead of
 		// repeatedly collecting them, since the caller might
@@ -186,6 +258,107 @@ class RomDataFactoryPrivate
 		static pthread_once_t once_exts;
 		static pthread_once_t once_mimeTypes;
 
+		// Magic number dispatch index for romDataFns_magic[].
+		// Maps (address << 32 | magic) to the matching entries,
+		// so create() only probes parsers whose magic number
+		// actually appears in the header instead of walking
+		// the entire table.
+		static unordered_map<uint64_t, vector<const RomDataFns*> > map_magicDispatch;
+		// Distinct magic number addresses present in romDataFns_magic[].
+		static vector<uint32_t> vec_magicAddrs;
+		static pthread_once_t once_magicDispatch;
+
+		/**
+		 * Initialize the magic number dispatch index.
+		 *
+		 * Internal function; must be called using pthread_once().
+		 */
+		static void init_magicDispatch(void);
+
+		// MIME type dispatch index.
+		// Maps a MIME type to the RomData subclasses that declare
+		// it, so MIME-routed callers (e.g. the D-Bus thumbnailer;
+		// Tumbler always supplies the MIME type) only probe the
+		// declared candidates instead of running the full
+		// extension-guessing sequence.
+		// NOTE: Texture MIME types handled by RpTextureWrapper are
+		// present with empty candidate sets; RpTextureWrapper is
+		// probed unconditionally in create_int().
+		static unordered_map<string, unordered_set<const RomDataFns*> > map_mimeDispatch;
+		static pthread_once_t once_mimeDispatch;
+
+		/**
+		 * Initialize the MIME type dispatch index.
+		 *
+		 * Internal function; must be called using pthread_once().
+		 */
+		static void init_mimeDispatch(void);
+
+		/**
+		 * Get the required probe block size for the specified attributes.
+		 *
+		 * This is the union of the probe extents declared by all
+		 * RomData subclasses that match the attributes and use a
+		 * header at address 0, rounded up to a 512-byte boundary.
+		 *
+		 * @param attrs RomDataAttr bitfield.
+		 * @return Probe block size, in bytes.
+		 */
+		static uint32_t getProbeSize(unsigned int attrs);
+
+		// Probe result cache.
+		// Maps file identity (filename, size, mtime) and the
+		// requested attributes to the winning creator function,
+		// or nullptr if the file probed as unsupported. This lets
+		// repeated create() calls on unchanged files skip the
+		// entire probe sequence, which happens constantly when a
+		// file manager re-thumbnails the same directory.
+		struct ProbeCacheEntry {
+			string filename;
+			off64_t szFile;
+			time_t mtime;
+			unsigned int attrs;
+			pfnNewRomData_t newRomData;	// nullptr == unsupported
+		};
+		static list<ProbeCacheEntry> probeCache;	// front == most recent
+		static Mutex probeCacheMutex;
+		static const size_t PROBE_CACHE_MAX = 64;
+
+		/**
+		 * Look up a file in the probe result cache.
+		 * @param filename	[in] Filename.
+		 * @param szFile	[in] File size.
+		 * @param mtime		[in] File mtime.
+		 * @param attrs		[in] Requested attributes.
+		 * @param pNewRomData	[out] Creator function, or nullptr if unsupported.
+		 * @return True if a cache entry was found; false if not.
+		 */
+		static bool probeCache_lookup(const string &filename,
+			off64_t szFile, time_t mtime, unsigned int attrs,
+			pfnNewRomData_t *pNewRomData);
+
+		// Per-parser hit counters for romDataFns_header[],
+		// indexed by table position. Libraries are usually
+		// dominated by one or two formats, so create() uses
+		// these to front-run the parsers that have won the
+		// most probes in this process, which gets the median
+		// probe count close to 1.
+		// NOTE: Per-process only; not persisted.
+		static const size_t HEADER_FNS_MAX = 64;
+		static volatile int probeHits[HEADER_FNS_MAX];
+
+		/**
+		 * Store a probe result in the probe result cache.
+		 * @param filename	[in] Filename.
+		 * @param szFile	[in] File size.
+		 * @param mtime		[in] File mtime.
+		 * @param attrs		[in] Requested attributes.
+		 * @param newRomData	[in] Creator function, or nullptr if unsupported.
+		 */
+		static void probeCache_store(const string &filename,
+			off64_t szFile, time_t mtime, unsigned int attrs,
+			pfnNewRomData_t newRomData);
+
 		/**
 		 * Initialize the vector of supported file extensions.
 		 * Used for Win32 COM registration.
@@ -224,6 +397,19 @@ vector<const char*> RomDataFactoryPrivate::vec_mimeTypes;
 pthread_once_t RomDataFactoryPrivate::once_exts = PTHREAD_ONCE_INIT;
 pthread_once_t RomDataFactoryPrivate::once_mimeTypes = PTHREAD_ONCE_INIT;
 
+unordered_map<uint64_t, vector<const RomDataFactoryPrivate::RomDataFns*> > RomDataFactoryPrivate::map_magicDispatch;
+vector<uint32_t> RomDataFactoryPrivate::vec_magicAddrs;
+pthread_once_t RomDataFactoryPrivate::once_magicDispatch = PTHREAD_ONCE_INIT;
+
+unordered_map<string, unordered_set<const RomDataFactoryPrivate::RomDataFns*> > RomDataFactoryPrivate::map_mimeDispatch;
+pthread_once_t RomDataFactoryPrivate::once_mimeDispatch = PTHREAD_ONCE_INIT;
+
+list<RomDataFactoryPrivate::ProbeCacheEntry> RomDataFactoryPrivate::probeCache;
+Mutex RomDataFactoryPrivate::probeCacheMutex;
+
+// Zero-initialized.
+volatile int RomDataFactoryPrivate::probeHits[RomDataFactoryPrivate::HEADER_FNS_MAX];
+
 #define ATTR_NONE		RomDataFactory::RDA_NONE
 #define ATTR_HAS_THUMBNAIL	RomDataFactory::RDA_HAS_THUMBNAIL
 #define ATTR_HAS_DPOVERLAY	RomDataFactory::RDA_HAS_DPOVERLAY
@@ -235,43 +421,45 @@ pthread_once_t RomDataFactoryPrivate::once_mimeTypes = PTHREAD_ONCE_INIT;
 // definitely have a 32-bit magic number in the header.
 // - address: Address of magic number within the header.
 // - size: 32-bit magic number.
+// - probeSize: Bytes from the start of the file that
+//   isRomSupported() can make use of.
 // TODO: Add support for multiple magic numbers per class.
 const RomDataFactoryPrivate::RomDataFns RomDataFactoryPrivate::romDataFns_magic[] = {
 	// Consoles
-	GetRomDataFns_addr(WiiWIBN, ATTR_HAS_THUMBNAIL, 0, 'WIBN'),
-	GetRomDataFns_addr(Xbox_XBE, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'XBEH'),
-	GetRomDataFns_addr(Xbox360_XDBF, ATTR_HAS_THUMBNAIL, 0, 'XDBF'),
-	GetRomDataFns_addr(Xbox360_XEX, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'XEX1'),
-	GetRomDataFns_addr(Xbox360_XEX, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'XEX2'),
+	GetRomDataFns_addr(WiiWIBN, ATTR_HAS_THUMBNAIL, 0, 'WIBN', 0xA0),
+	GetRomDataFns_addr(Xbox_XBE, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'XBEH', 0x180),
+	GetRomDataFns_addr(Xbox360_XDBF, ATTR_HAS_THUMBNAIL, 0, 'XDBF', 0x40),
+	GetRomDataFns_addr(Xbox360_XEX, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'XEX1', 0x20),
+	GetRomDataFns_addr(Xbox360_XEX, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'XEX2', 0x20),
 
 	// Handhelds
-	GetRomDataFns_addr(DMG, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0x104, 0xCEED6666),
-	GetRomDataFns_addr(GameBoyAdvance, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0x04, 0x24FFAE51),
-	GetRomDataFns_addr(Lynx, ATTR_NONE, 0, 'LYNX'),
-	GetRomDataFns_addr(NGPC, ATTR_HAS_METADATA, 12, ' SNK'),
-	GetRomDataFns_addr(Nintendo3DSFirm, ATTR_NONE, 0, 'FIRM'),
-	GetRomDataFns_addr(Nintendo3DS_SMDH, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'SMDH'),
-	GetRomDataFns_addr(NintendoDS, ATTR_HAS_THUMBNAIL | ATTR_HAS_DPOVERLAY | ATTR_HAS_METADATA, 0xC0, 0x24FFAE51),
-	GetRomDataFns_addr(NintendoDS, ATTR_HAS_THUMBNAIL | ATTR_HAS_DPOVERLAY | ATTR_HAS_METADATA, 0xC0, 0xC8604FE2),
+	GetRomDataFns_addr(DMG, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0x104, 0xCEED6666, 0x150),
+	GetRomDataFns_addr(GameBoyAdvance, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0x04, 0x24FFAE51, 0xC0),
+	GetRomDataFns_addr(Lynx, ATTR_NONE, 0, 'LYNX', 0x40),
+	GetRomDataFns_addr(NGPC, ATTR_HAS_METADATA, 12, ' SNK', 0x40),
+	GetRomDataFns_addr(Nintendo3DSFirm, ATTR_NONE, 0, 'FIRM', 0x200),
+	GetRomDataFns_addr_fastIcon(Nintendo3DS_SMDH, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'SMDH', 0x200),
+	GetRomDataFns_addr_fastIcon(NintendoDS, ATTR_HAS_THUMBNAIL | ATTR_HAS_DPOVERLAY | ATTR_HAS_METADATA, 0xC0, 0x24FFAE51, 0x1000),
+	GetRomDataFns_addr_fastIcon(NintendoDS, ATTR_HAS_THUMBNAIL | ATTR_HAS_DPOVERLAY | ATTR_HAS_METADATA, 0xC0, 0xC8604FE2, 0x1000),
 
 	// Audio
-	GetRomDataFns_addr(BRSTM, ATTR_HAS_METADATA, 0, 'RSTM'),
-	GetRomDataFns_addr(GBS, ATTR_HAS_METADATA, 0, 'GBS\x01'),
-	GetRomDataFns_addr(NSF, ATTR_HAS_METADATA, 0, 'NESM'),
-	GetRomDataFns_addr(SPC, ATTR_HAS_METADATA, 0, 'SNES'),
-	GetRomDataFns_addr(VGM, ATTR_HAS_METADATA, 0, 'Vgm '),
+	GetRomDataFns_addr(BRSTM, ATTR_HAS_METADATA, 0, 'RSTM', 0x40),
+	GetRomDataFns_addr(GBS, ATTR_HAS_METADATA, 0, 'GBS\x01', 0x70),
+	GetRomDataFns_addr(NSF, ATTR_HAS_METADATA, 0, 'NESM', 0x80),
+	GetRomDataFns_addr(SPC, ATTR_HAS_METADATA, 0, 'SNES', 0x100),
+	GetRomDataFns_addr(VGM, ATTR_HAS_METADATA, 0, 'Vgm ', 0x100),
 
 	// Other
-	GetRomDataFns_addr(ELF, ATTR_NONE, 0, '\177ELF'),
+	GetRomDataFns_addr(ELF, ATTR_NONE, 0, '\177ELF', 0x40),
 
 	// Consoles: Xbox 360 STFS
 	// Moved here to prevent conflicts with the Nintendo DS ROM image
 	// "Live On Card Live-R DS".
-	GetRomDataFns_addr(Xbox360_STFS, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'CON '),
-	GetRomDataFns_addr(Xbox360_STFS, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'PIRS'),
-	GetRomDataFns_addr(Xbox360_STFS, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'LIVE'),
+	GetRomDataFns_addr(Xbox360_STFS, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'CON ', 0x230),
+	GetRomDataFns_addr(Xbox360_STFS, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'PIRS', 0x230),
+	GetRomDataFns_addr(Xbox360_STFS, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0, 'LIVE', 0x230),
 
-	{nullptr, nullptr, nullptr, nullptr, ATTR_NONE, 0, 0}
+	{nullptr, nullptr, nullptr, nullptr, ATTR_NONE, 0, 0, 0, nullptr, false, nullptr}
 };
 
 // RomData subclasses that use a header.
@@ -279,67 +467,74 @@ const RomDataFactoryPrivate::RomDataFns RomDataFactoryPrivate::romDataFns_magic[
 // placed at the end of this array.
 const RomDataFactoryPrivate::RomDataFns RomDataFactoryPrivate::romDataFns_header[] = {
 	// Consoles
-	GetRomDataFns(Dreamcast, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA | ATTR_SUPPORTS_DEVICES),
-	GetRomDataFns(DreamcastSave, ATTR_HAS_THUMBNAIL),
-	GetRomDataFns(GameCube, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA | ATTR_SUPPORTS_DEVICES),
-	GetRomDataFns(GameCubeBNR, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA),
-	GetRomDataFns(GameCubeSave, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA),
-	GetRomDataFns(iQuePlayer, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA),
-	GetRomDataFns(MegaDrive, ATTR_SUPPORTS_DEVICES),	// ATTR_SUPPORTS_DEVICES for Sega CD
-	GetRomDataFns(N64, ATTR_NONE | ATTR_HAS_METADATA),
-	GetRomDataFns(NES, ATTR_NONE),
-	GetRomDataFns(SNES, ATTR_NONE),
-	GetRomDataFns(SegaSaturn, ATTR_NONE | ATTR_HAS_METADATA | ATTR_SUPPORTS_DEVICES),
-	GetRomDataFns(WiiSave, ATTR_HAS_THUMBNAIL),
-	GetRomDataFns(WiiU, ATTR_HAS_THUMBNAIL | ATTR_SUPPORTS_DEVICES),
-	GetRomDataFns(WiiWAD, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA),
+	GetRomDataFns(Dreamcast, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA | ATTR_SUPPORTS_DEVICES, 0x940),	// 2352-byte raw CD sectors
+	GetRomDataFns(DreamcastSave, ATTR_HAS_THUMBNAIL, 0x20),
+	// NOTE: GameCube's WBFS check verifies the disc header stored
+	// after the first HDD sector. 0x1200 covers HDD sector sizes
+	// up to 4 KB; larger (nonstandard) sector sizes are detected
+	// as WBFS without system verification.
+	GetRomDataFns(GameCube, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA | ATTR_SUPPORTS_DEVICES, 0x1200),
+	GetRomDataFns(GameCubeBNR, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0x20),
+	GetRomDataFns(GameCubeSave, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0x400),
+	GetRomDataFns(iQuePlayer, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0x48),
+	GetRomDataFns(MegaDrive, ATTR_SUPPORTS_DEVICES, 0x540),	// ATTR_SUPPORTS_DEVICES for Sega CD; 0x540 for the 32X security program check
+	GetRomDataFns(N64, ATTR_NONE | ATTR_HAS_METADATA, 0x40),
+	GetRomDataFns(NES, ATTR_NONE, 0x100),
+	GetRomDataFns_loose(SNES, ATTR_NONE, 0x200),	// copier headers; heuristic detection
+	GetRomDataFns(SegaSaturn, ATTR_NONE | ATTR_HAS_METADATA | ATTR_SUPPORTS_DEVICES, 0x940),	// 2352-byte raw CD sectors
+	GetRomDataFns(WiiSave, ATTR_HAS_THUMBNAIL, 0),	// extension check only
+	GetRomDataFns(WiiU, ATTR_HAS_THUMBNAIL | ATTR_SUPPORTS_DEVICES, 0x100),
+	GetRomDataFns(WiiWAD, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0x40),
 
 	// Handhelds
-	GetRomDataFns(Nintendo3DS, ATTR_HAS_THUMBNAIL | ATTR_HAS_DPOVERLAY | ATTR_HAS_METADATA),
+	GetRomDataFns(Nintendo3DS, ATTR_HAS_THUMBNAIL | ATTR_HAS_DPOVERLAY | ATTR_HAS_METADATA, 0x200),
 
 	// Audio
-	GetRomDataFns(ADX, ATTR_HAS_METADATA),
-	GetRomDataFns(BCSTM, ATTR_HAS_METADATA),
-	GetRomDataFns(PSF, ATTR_HAS_METADATA),
-	GetRomDataFns(SAP, ATTR_HAS_METADATA),	// "SAP\r\n", "SAP\n"; maybe move to _magic[]?
-	GetRomDataFns(SNDH, ATTR_HAS_METADATA),	// "SNDH", or "ICE!" or "Ice!" if packed.
-	GetRomDataFns(SID, ATTR_HAS_METADATA),	// PSID/RSID; maybe move to _magic[]?
+	GetRomDataFns_loose(ADX, ATTR_HAS_METADATA, 0x1000),	// magic number is at a header-specified offset
+	GetRomDataFns(BCSTM, ATTR_HAS_METADATA, 0x40),
+	GetRomDataFns(PSF, ATTR_HAS_METADATA, 0x10),
+	GetRomDataFns(SAP, ATTR_HAS_METADATA, 0x10),	// "SAP\r\n", "SAP\n"; maybe move to _magic[]?
+	GetRomDataFns(SNDH, ATTR_HAS_METADATA, 0x200),	// "SNDH", or "ICE!" or "Ice!" if packed.
+	GetRomDataFns(SID, ATTR_HAS_METADATA, 0x80),	// PSID/RSID; maybe move to _magic[]?
 
 	// Other
-	GetRomDataFns(Amiibo, ATTR_HAS_THUMBNAIL),
-	GetRomDataFns(MachO, ATTR_NONE),
-	GetRomDataFns(NintendoBadge, ATTR_HAS_THUMBNAIL),
+	GetRomDataFns(Amiibo, ATTR_HAS_THUMBNAIL, 0x240),
+	GetRomDataFns(MachO, ATTR_NONE, 0x20),
+	GetRomDataFns(NintendoBadge, ATTR_HAS_THUMBNAIL, 0x1100),
 
 	// The following formats have 16-bit magic numbers,
 	// so they should go at the end of the address=0 section.
-	GetRomDataFns(EXE, ATTR_NONE),	// TODO: Thumbnailing on non-Windows platforms.
-	GetRomDataFns(PlayStationSave, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA),
+	GetRomDataFns_loose(EXE, ATTR_NONE, 0x40),	// TODO: Thumbnailing on non-Windows platforms.
+	GetRomDataFns_loose(PlayStationSave, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0x300),
 
 	// NOTE: game.com may be at either 0 or 0x40000.
 	// The 0x40000 address is checked below.
-	GetRomDataFns(GameCom, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA),
+	GetRomDataFns_loose(GameCom, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0x20),
 
 	// Headers with non-zero addresses.
-	GetRomDataFns_addr(Sega8Bit, ATTR_HAS_METADATA, 0x7FE0, 0x20),
-	GetRomDataFns_addr(PokemonMini, ATTR_HAS_METADATA, 0x2100, 0xD0),
+	// NOTE: probeSize is 0 for these, since they don't use the
+	// probe block; their headers are read separately after the
+	// file extension check.
+	GetRomDataFns_addr(Sega8Bit, ATTR_HAS_METADATA, 0x7FE0, 0x20, 0),
+	GetRomDataFns_addr(PokemonMini, ATTR_HAS_METADATA, 0x2100, 0xD0, 0),
 	// NOTE: game.com may be at either 0 or 0x40000.
 	// The 0 address is checked above.
-	GetRomDataFns_addr(GameCom, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0x40000, 0x20),
+	GetRomDataFns_addr(GameCom, ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA, 0x40000, 0x20, 0),
 
 	// Last chance: ISO-9660 disc images.
 	// NOTE: This might include some console-specific disc images
 	// that don't have an identifying boot sector at 0x0000.
 	// NOTE: Keeping the same address, since ISO only checks the file extension.
 	// NOTE: ATTR_HAS_THUMBNAIL is needed for Xbox 360.
-	GetRomDataFns_addr(ISO, ATTR_HAS_THUMBNAIL | ATTR_SUPPORTS_DEVICES | ATTR_CHECK_ISO, 0x40000, 0x20),
+	GetRomDataFns_addr(ISO, ATTR_HAS_THUMBNAIL | ATTR_SUPPORTS_DEVICES | ATTR_CHECK_ISO, 0x40000, 0x20, 0),
 
-	{nullptr, nullptr, nullptr, nullptr, ATTR_NONE, 0, 0}
+	{nullptr, nullptr, nullptr, nullptr, ATTR_NONE, 0, 0, 0, nullptr, false, nullptr}
 };
 
 // RomData subclasses that use a footer.
 const RomDataFactoryPrivate::RomDataFns RomDataFactoryPrivate::romDataFns_footer[] = {
-	GetRomDataFns(VirtualBoy, ATTR_NONE),
-	{nullptr, nullptr, nullptr, nullptr, ATTR_NONE, 0, 0}
+	GetRomDataFns(VirtualBoy, ATTR_NONE, 0),	// footer is read separately
+	{nullptr, nullptr, nullptr, nullptr, ATTR_NONE, 0, 0, 0, nullptr, false, nullptr}
 };
 
 // Table of pointers to tables.
@@ -352,6 +547,175 @@ const RomDataFactoryPrivate::RomDataFns *const RomDataFactoryPrivate::romDataFns
 	nullptr
 };
 
+/**
+ * Initialize the magic number dispatch index.
+ *
+ * Internal function; must be called using pthread_once().
+ */
+void RomDataFactoryPrivate::init_magicDispatch(void)
+{
+	const RomDataFns *fns = &romDataFns_magic[0];
+	for (; fns->supportedFileExtensions != nullptr; fns++) {
+		// TODO: Verify alignment restrictions.
+		assert(fns->address % 4 == 0);
+
+		const uint64_t key = (static_cast<uint64_t>(fns->address) << 32) | fns->size;
+		map_magicDispatch[key].push_back(fns);
+
+		// Keep track of the distinct magic number addresses.
+		if (std::find(vec_magicAddrs.cbegin(), vec_magicAddrs.cend(), fns->address) == vec_magicAddrs.cend()) {
+			vec_magicAddrs.push_back(fns->address);
+		}
+	}
+}
+
+/**
+ * Initialize the MIME type dispatch index.
+ *
+ * Internal function; must be called using pthread_once().
+ */
+void RomDataFactoryPrivate::init_mimeDispatch(void)
+{
+	for (const RomDataFns *const *tblptr = &romDataFns_tbl[0];
+	     *tblptr != nullptr; tblptr++)
+	{
+		const RomDataFns *fns = *tblptr;
+		for (; fns->supportedFileExtensions != nullptr; fns++) {
+			const char *const *sys_mimeTypes = fns->supportedMimeTypes();
+			if (!sys_mimeTypes)
+				continue;
+
+			for (; *sys_mimeTypes != nullptr; sys_mimeTypes++) {
+				map_mimeDispatch[*sys_mimeTypes].insert(fns);
+			}
+		}
+	}
+
+	// Register the texture MIME types with empty candidate sets.
+	// RpTextureWrapper is probed unconditionally in create_int(),
+	// so a texture MIME type merely needs to be recognized here;
+	// unrecognized MIME types fall back to a full probe instead.
+	const vector<const char*> &vec_mimeTypes_fileFormat = FileFormatFactory::supportedMimeTypes();
+	std::for_each(vec_mimeTypes_fileFormat.cbegin(), vec_mimeTypes_fileFormat.cend(),
+		[](const char *mimeType) {
+			map_mimeDispatch[mimeType];
+		}
+	);
+}
+
+/**
+ * Get the required probe block size for the specified attributes.
+ *
+ * This is the union of the probe extents declared by all
+ * RomData subclasses that match the attributes and use a
+ * header at address 0, rounded up to a 512-byte boundary.
+ *
+ * @param attrs RomDataAttr bitfield.
+ * @return Probe block size, in bytes.
+ */
+uint32_t RomDataFactoryPrivate::getProbeSize(unsigned int attrs)
+{
+	// Minimum probe size. This also covers all of the magic
+	// number addresses in romDataFns_magic[].
+	uint32_t probe_req = 512;
+
+	// Check RomData subclasses with a 32-bit magic number.
+	const RomDataFns *fns = &romDataFns_magic[0];
+	for (; fns->supportedFileExtensions != nullptr; fns++) {
+		if ((fns->attrs & attrs) != attrs)
+			continue;
+		if (fns->probeSize > probe_req) {
+			probe_req = fns->probeSize;
+		}
+	}
+
+	// Check other RomData subclasses that take a header.
+	// Subclasses with non-zero header addresses don't use the
+	// probe block, so they're skipped here.
+	fns = &romDataFns_header[0];
+	for (; fns->supportedFileExtensions != nullptr; fns++) {
+		if ((fns->attrs & attrs) != attrs || fns->address != 0)
+			continue;
+		if (fns->probeSize > probe_req) {
+			probe_req = fns->probeSize;
+		}
+	}
+
+	// Round up to a 512-byte boundary.
+	return (probe_req + 511) & ~511U;
+}
+
+/**
+ * Look up a file in the probe result cache.
+ * @param filename	[in] Filename.
+ * @param szFile	[in] File size.
+ * @param mtime		[in] File mtime.
+ * @param attrs		[in] Requested attributes.
+ * @param pNewRomData	[out] Creator function, or nullptr if unsupported.
+ * @return True if a cache entry was found; false if not.
+ */
+bool RomDataFactoryPrivate::probeCache_lookup(const string &filename,
+	off64_t szFile, time_t mtime, unsigned int attrs,
+	pfnNewRomData_t *pNewRomData)
+{
+	MutexLocker locker(probeCacheMutex);
+	for (auto iter = probeCache.begin(); iter != probeCache.end(); ++iter) {
+		if (iter->szFile != szFile || iter->mtime != mtime ||
+		    iter->attrs != attrs || iter->filename != filename)
+		{
+			continue;
+		}
+
+		// Found a match. Move it to the front of the list.
+		*pNewRomData = iter->newRomData;
+		if (iter != probeCache.begin()) {
+			probeCache.splice(probeCache.begin(), probeCache, iter);
+		}
+		return true;
+	}
+
+	// No match.
+	return false;
+}
+
+/**
+ * Store a probe result in the probe result cache.
+ * @param filename	[in] Filename.
+ * @param szFile	[in] File size.
+ * @param mtime		[in] File mtime.
+ * @param attrs		[in] Requested attributes.
+ * @param newRomData	[in] Creator function, or nullptr if unsupported.
+ */
+void RomDataFactoryPrivate::probeCache_store(const string &filename,
+	off64_t szFile, time_t mtime, unsigned int attrs,
+	pfnNewRomData_t newRomData)
+{
+	MutexLocker locker(probeCacheMutex);
+
+	// Update the existing entry if the file is already present.
+	for (auto iter = probeCache.begin(); iter != probeCache.end(); ++iter) {
+		if (iter->szFile != szFile || iter->attrs != attrs ||
+		    iter->filename != filename)
+		{
+			continue;
+		}
+
+		iter->mtime = mtime;
+		iter->newRomData = newRomData;
+		if (iter != probeCache.begin()) {
+			probeCache.splice(probeCache.begin(), probeCache, iter);
+		}
+		return;
+	}
+
+	// Evict the least-recently-used entry if the cache is full.
+	if (probeCache.size() >= PROBE_CACHE_MAX) {
+		probeCache.pop_back();
+	}
+
+	probeCache.emplace_front(ProbeCacheEntry{filename, szFile, mtime, attrs, newRomData});
+}
+
 /**
  * Attempt to open the other file in a Dreamcast .VMI+.VMS pair.
  * @param file One opened file in the .VMI+.VMS pair.
@@ -470,47 +834,91 @@ RomData *RomDataFactoryPrivate::checkISO(IRpFile *file)
 
 	// Not a game-specific file system.
 	// Use the generic ISO-9660 parser.
-	return new ISO(file);
+	// NOTE: The PVD read above is reused if it was valid.
+	// (It won't be for 2352-byte raw sector images, in which
+	// case ISO re-probes the file itself.)
+	return new ISO(file, &pvd);
 }
 
-/** RomDataFactory **/
-
 /**
- * Create a RomData subclass for the specified ROM file.
- *
- * NOTE: RomData::isValid() is checked before returning a
- * created RomData instance, so returned objects can be
- * assumed to be valid as long as they aren't nullptr.
- *
- * If imgbf is non-zero, at least one of the specified image
- * types must be supported by the RomData subclass in order to
- * be returned.
- *
+ * Internal implementation of RomDataFactory::create().
+ * The public function handles the statistics counters.
  * @param file ROM file.
- * @param attrs RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
+ * @param attrs RomDataAttr bitfield.
  * @return RomData subclass, or nullptr if the ROM isn't supported.
  */
-RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
+/**
+ * Call a parser's isRomSupported() function, recording a
+ * trace event with the verdict, elapsed time, and bytes
+ * read if tracing is enabled. (rpcli --trace)
+ * @param fns Parser function table entry.
+ * @param info Detection information.
+ * @return isRomSupported() result.
+ */
+int RomDataFactoryPrivate::probeWithTrace(const RomDataFns *fns,
+	const RomData::DetectInfo *info)
+{
+#ifdef ENABLE_RP_STATS
+	if (RpStats::isTraceEnabled()) {
+		const uint64_t bytes_start = RpStats::get(RpStats::CTR_FILE_BYTES_READ);
+		const auto t_start = std::chrono::steady_clock::now();
+		const int sysID = fns->isRomSupported(info);
+		const auto elapsed = std::chrono::steady_clock::now() - t_start;
+
+		char detail[80];
+		snprintf(detail, sizeof(detail), "%s %s", fns->name,
+			(sysID >= 0 ? "accepted" : "rejected"));
+		RpStats::traceEvent("probe", detail,
+			static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()),
+			RpStats::get(RpStats::CTR_FILE_BYTES_READ) - bytes_start);
+		return sysID;
+	}
+#endif /* ENABLE_RP_STATS */
+	return fns->isRomSupported(info);
+}
+
+RomData *RomDataFactoryPrivate::create_int(IRpFile *file, unsigned int attrs,
+	const unordered_set<const RomDataFns*> *mimeFilter)
 {
 	RomData::DetectInfo info;
 
+	// Check for caller-intent flags. These describe what the caller
+	// wants from the returned object; they are not subclass attributes,
+	// so they must not take part in subclass matching.
+	const bool deferFields = !!(attrs & RomDataFactory::RDA_DEFER_FIELDS);
+	const bool metadataOnly = !!(attrs & RomDataFactory::RDA_METADATA_ONLY);
+	attrs &= ~(RomDataFactory::RDA_DEFER_FIELDS | RomDataFactory::RDA_METADATA_ONLY);
+	if (metadataOnly) {
+		// Metadata-only open: the subclass must have metadata.
+		attrs |= ATTR_HAS_METADATA;
+	}
+
 	// Get the file size.
 	info.szFile = file->size();
 
-	// Read 4,096+256 bytes from the ROM header.
-	// This should be enough to detect most systems.
+	// Read the probe block from the beginning of the file.
+	// The read size is the union of the probe extents declared
+	// by the matching RomData subclasses, so the entire probe
+	// sequence usually does exactly one small I/O. This matters
+	// a lot on network mounts, where reading 512 bytes versus
+	// 32 KB per file is the difference between usable and not.
+	static const uint32_t PROBE_SIZE = 32768;
 	union {
-		uint8_t u8[4096+256];
-		uint32_t u32[(4096+256)/4];
+		uint8_t u8[PROBE_SIZE];
+		uint32_t u32[PROBE_SIZE/4];
 	} header;
+	const uint32_t probe_req = RomDataFactoryPrivate::getProbeSize(attrs);
+	assert(probe_req <= sizeof(header.u8));
 	file->rewind();
-	info.header.addr = 0;
-	info.header.pData = header.u8;
-	info.header.size = static_cast<uint32_t>(file->read(header.u8, sizeof(header.u8)));
-	if (info.header.size == 0) {
+	const uint32_t probe_size = static_cast<uint32_t>(file->read(header.u8,
+		(probe_req <= sizeof(header.u8) ? probe_req : sizeof(header.u8))));
+	if (probe_size == 0) {
 		// Read error.
 		return nullptr;
 	}
+	info.header.addr = 0;
+	info.header.pData = header.u8;
+	info.header.size = probe_size;
 
 	// File extension.
 	string file_ext;	// temporary storage
@@ -532,6 +940,46 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 		}
 	}
 
+	// Check the probe result cache.
+	// Only regular files with filenames are cached.
+	string cache_filename;
+	time_t cache_mtime = -1;
+	bool cacheUsable = false;
+	if (!file->isDevice()) {
+		cache_filename = file->filename();
+		if (!cache_filename.empty() &&
+		    FileSystem::get_mtime(cache_filename, &cache_mtime) == 0)
+		{
+			cacheUsable = true;
+			RomDataFactoryPrivate::pfnNewRomData_t pfnNewRomData = nullptr;
+			if (RomDataFactoryPrivate::probeCache_lookup(cache_filename,
+			    info.szFile, cache_mtime, attrs, &pfnNewRomData))
+			{
+				if (!pfnNewRomData) {
+					// The file is cached as unsupported.
+					return nullptr;
+				}
+
+				// Re-create the cached winning parser directly.
+				RomData *const romData = pfnNewRomData(file);
+				if (romData) {
+					if (romData->isValid()) {
+						if (deferFields) {
+							romData->setFieldLoadingDeferred(true);
+						}
+						if (metadataOnly) {
+							romData->setMetadataOnly(true);
+						}
+						return romData;
+					}
+					// Cached parser no longer accepts the file.
+					// Fall through to a full probe.
+					romData->unref();
+				}
+			}
+		}
+	}
+
 	// Special handling for Dreamcast .VMI+.VMS pairs.
 	if (info.ext != nullptr &&
 	    (!strcasecmp(info.ext, ".vms") ||
@@ -543,6 +991,17 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 		if (romData) {
 			if (romData->isValid()) {
 				// .VMI+.VMS pair opened.
+				if (cacheUsable) {
+					RomDataFactoryPrivate::probeCache_store(cache_filename,
+						info.szFile, cache_mtime, attrs,
+						RomDataFactoryPrivate::openDreamcastVMSandVMI);
+				}
+				if (deferFields) {
+					romData->setFieldLoadingDeferred(true);
+				}
+				if (metadataOnly) {
+					romData->setMetadataOnly(true);
+				}
 				return romData;
 			}
 			// Not a .VMI+.VMS pair.
@@ -552,34 +1011,111 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 		// Not a .VMI+.VMS pair.
 	}
 
+	// Check for a ZIP archive. Retro ROM collections usually ship
+	// one ROM per .zip, so transparently open the main member and
+	// probe that instead of the archive itself.
+	// NOTE: Archive nesting is capped at one level. A crafted
+	// archive whose member is itself (a "zip quine") would
+	// otherwise recurse unboundedly, and the one-ROM-per-.zip
+	// use case doesn't need nested archives.
+	if (RpZipFile::isZip(header.u8, probe_size) &&
+	    !dynamic_cast<RpZipFile*>(file))
+	{
+		RpZipFile *const zipMember = new RpZipFile(file);
+		if (zipMember->isOpen()) {
+			RomData *const romData = create_int(zipMember, attrs |
+				(deferFields ? RomDataFactory::RDA_DEFER_FIELDS : 0) |
+				(metadataOnly ? RomDataFactory::RDA_METADATA_ONLY : 0));
+			zipMember->unref();
+			if (romData) {
+				// Opened a RomData subclass from the archive member.
+				// NOTE: Not stored in the probe result cache, since
+				// the cache re-creates parsers from the raw file.
+				return romData;
+			}
+		} else {
+			zipMember->unref();
+		}
+		// Not a usable archive, or the member isn't supported.
+	}
+
 	// Check RomData subclasses that take a header at 0
 	// and definitely have a 32-bit magic number in the header.
-	const RomDataFactoryPrivate::RomDataFns *fns =
-		&RomDataFactoryPrivate::romDataFns_magic[0];
-	for (; fns->supportedFileExtensions != nullptr; fns++) {
+	// Use the precomputed dispatch index so we only probe
+	// parsers whose magic number actually matches the header.
+	pthread_once(&RomDataFactoryPrivate::once_magicDispatch, RomDataFactoryPrivate::init_magicDispatch);
+
+	// Collect the candidate parsers. More than one entry can match,
+	// e.g. two classes sharing a magic number, but the count is
+	// always tiny compared to the full table.
+	const RomDataFactoryPrivate::RomDataFns *candidates[8];
+	unsigned int nCandidates = 0;
+	for (const uint32_t address : RomDataFactoryPrivate::vec_magicAddrs) {
+		assert(address + sizeof(uint32_t) <= sizeof(header.u32));
+		if (address + sizeof(uint32_t) > info.header.size) {
+			// Header is too small for this magic number.
+			continue;
+		}
+
+		const uint32_t magic = be32_to_cpu(header.u32[address/4]);
+		const uint64_t key = (static_cast<uint64_t>(address) << 32) | magic;
+		auto iter = RomDataFactoryPrivate::map_magicDispatch.find(key);
+		if (iter == RomDataFactoryPrivate::map_magicDispatch.end())
+			continue;
+
+		for (const RomDataFactoryPrivate::RomDataFns *fns : iter->second) {
+			if (mimeFilter && mimeFilter->find(fns) == mimeFilter->end()) {
+				// Not a candidate for the supplied MIME type.
+				continue;
+			}
+			if (nCandidates < ARRAY_SIZE(candidates)) {
+				candidates[nCandidates++] = fns;
+			}
+		}
+	}
+
+	// Sort the candidates by table position to preserve the
+	// priority ordering of romDataFns_magic[], e.g. NintendoDS
+	// before Xbox360_STFS.
+	// NOTE: Insertion sort over the fixed-size array. The count is
+	// tiny, and std::sort() here triggers a spurious -Warray-bounds
+	// warning with gcc-12.
+	for (unsigned int i = 1; i < nCandidates; i++) {
+		const RomDataFactoryPrivate::RomDataFns *const fns = candidates[i];
+		unsigned int j = i;
+		for (; j > 0 && candidates[j-1] > fns; j--) {
+			candidates[j] = candidates[j-1];
+		}
+		candidates[j] = fns;
+	}
+	for (unsigned int i = 0; i < nCandidates; i++) {
+		const RomDataFactoryPrivate::RomDataFns *const fns = candidates[i];
 		if ((fns->attrs & attrs) != attrs) {
 			// This RomData subclass doesn't have the
 			// required attributes.
 			continue;
 		}
 
-		// Check the magic number.
-		// TODO: Verify alignment restrictions.
-		assert(fns->address % 4 == 0);
-		assert(fns->address + sizeof(uint32_t) <= sizeof(header.u32));
-		uint32_t magic = header.u32[fns->address/4];
-		if (be32_to_cpu(magic) == fns->size) {
-			// Found a matching magic number.
-			if (fns->isRomSupported(&info) >= 0) {
-				RomData *const romData = fns->newRomData(file);
-				if (romData->isValid()) {
-					// RomData subclass obtained.
-					return romData;
+		// Magic number already matched via the dispatch index.
+		if (probeWithTrace(fns, &info) >= 0) {
+			RomData *const romData = fns->newRomData(file);
+			if (romData->isValid()) {
+				// RomData subclass obtained.
+				if (cacheUsable) {
+					RomDataFactoryPrivate::probeCache_store(cache_filename,
+						info.szFile, cache_mtime, attrs, fns->newRomData);
 				}
-
-				// Not actually supported.
-				romData->unref();
+				if (deferFields) {
+					romData->setFieldLoadingDeferred(true);
+				}
+				if (metadataOnly) {
+					romData->setMetadataOnly(true);
+				}
+				return romData;
 			}
+
+			// Not actually supported.
+			romData->unref();
 		}
 	}
 
@@ -589,6 +1125,17 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 		RomData *const romData = new RpTextureWrapper(file);
 		if (romData->isValid()) {
 			// RomData subclass obtained.
+			if (cacheUsable) {
+				RomDataFactoryPrivate::probeCache_store(cache_filename,
+					info.szFile, cache_mtime, attrs,
+					RomDataFactoryPrivate::RomData_ctor<RpTextureWrapper>);
+			}
+			if (deferFields) {
+				romData->setFieldLoadingDeferred(true);
+			}
+			if (metadataOnly) {
+				romData->setMetadataOnly(true);
+			}
 			return romData;
 		}
 
@@ -596,9 +1143,104 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 		romData->unref();
 	}
 
+	// Adaptive front-running: probe the header-table parsers
+	// that have won the most probes in this process before
+	// walking the table in source order. Libraries are usually
+	// dominated by one or two formats, so the hot parser
+	// usually matches on the first attempt.
+	// NOTE: Parsers flagged looseMatch are never front-run;
+	// their detection is only reliable after the stricter
+	// parsers ahead of them in the table have declined.
+	{
+		static const size_t nHeaderFns = ARRAY_SIZE(RomDataFactoryPrivate::romDataFns_header) - 1;
+		static_assert(nHeaderFns <= RomDataFactoryPrivate::HEADER_FNS_MAX,
+			"romDataFns_header[] is larger than the probeHits[] counter array.");
+
+		// Select up to 4 parsers with the highest hit counts.
+		size_t topIdx[4];
+		unsigned int nTop = 0;
+		for (unsigned int sel = 0; sel < ARRAY_SIZE(topIdx); sel++) {
+			int bestHits = 0;
+			size_t bestIdx = 0;
+			for (size_t i = 0; i < nHeaderFns; i++) {
+				const RomDataFactoryPrivate::RomDataFns &entry =
+					RomDataFactoryPrivate::romDataFns_header[i];
+				if (entry.address != 0 || entry.looseMatch) {
+					// Not eligible for front-running.
+					continue;
+				}
+
+				// Skip parsers that were already selected.
+				bool selected = false;
+				for (unsigned int j = 0; j < nTop; j++) {
+					if (topIdx[j] == i) {
+						selected = true;
+						break;
+					}
+				}
+				if (selected)
+					continue;
+
+				const int hits = RomDataFactoryPrivate::probeHits[i];
+				if (hits > bestHits) {
+					bestHits = hits;
+					bestIdx = i;
+				}
+			}
+			if (bestHits == 0) {
+				// No more parsers with hits.
+				break;
+			}
+			topIdx[nTop++] = bestIdx;
+		}
+
+		for (unsigned int i = 0; i < nTop; i++) {
+			const RomDataFactoryPrivate::RomDataFns *const fns =
+				&RomDataFactoryPrivate::romDataFns_header[topIdx[i]];
+			if ((fns->attrs & attrs) != attrs) {
+				// This RomData subclass doesn't have the
+				// required attributes.
+				continue;
+			}
+			if (mimeFilter && mimeFilter->find(fns) == mimeFilter->end()) {
+				// Not a candidate for the supplied MIME type.
+				continue;
+			}
+
+			// NOTE: info.header still points to the full probe
+			// block at address 0, which is what these parsers
+			// expect. (Front-run parsers always have address == 0.)
+			if (probeWithTrace(fns, &info) < 0)
+				continue;
+
+			RomData *const romData = fns->newRomData(file);
+			if (romData->isValid()) {
+				// RomData subclass obtained.
+				ATOMIC_INC_FETCH(&RomDataFactoryPrivate::probeHits[topIdx[i]]);
+				if (cacheUsable) {
+					RomDataFactoryPrivate::probeCache_store(cache_filename,
+						info.szFile, cache_mtime, attrs, fns->newRomData);
+				}
+				if (deferFields) {
+					romData->setFieldLoadingDeferred(true);
+				}
+				if (metadataOnly) {
+					romData->setMetadataOnly(true);
+				}
+				return romData;
+			}
+
+			// Not actually supported.
+			romData->unref();
+		}
+	}
+
 	// Check other RomData subclasses that take a header,
 	// but don't have a simple 32-bit magic number check.
-	fns = &RomDataFactoryPrivate::romDataFns_header[0];
+	// Scratch buffer for headers outside of the probe block.
+	uint8_t scratch[1024];
+	const RomDataFactoryPrivate::RomDataFns *fns =
+		&RomDataFactoryPrivate::romDataFns_header[0];
 	bool checked_exts = false;
 	for (; fns->supportedFileExtensions != nullptr; fns++) {
 		if ((fns->attrs & attrs) != attrs) {
@@ -606,17 +1248,25 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 			// required attributes.
 			continue;
 		}
+		if (mimeFilter && mimeFilter->find(fns) == mimeFilter->end()) {
+			// Not a candidate for the supplied MIME type.
+			continue;
+		}
 
 		if (fns->address != info.header.addr ||
 		    fns->size > info.header.size)
 		{
 			// Header address has changed.
-			if (!checked_exts) {
+			if (!checked_exts && !mimeFilter) {
+				// NOTE: If a MIME filter is active, the MIME type
+				// already selected this parser as a candidate, so
+				// the extension heuristic is skipped entirely.
 				// Check the file extension to reduce overhead
 				// for file types that don't use this.
 				// TODO: Don't hard-code this.
 				// Use a pointer to supportedFileExtensions_static() instead?
-				static const char *const exts[] = {
+				// NOTE: Lowercase extensions; lookup is O(1).
+				static const unordered_set<string> set_exts = {
 					".bin",		/* generic .bin */
 					".sms",		/* Sega Master System */
 					".gg",		/* Game Gear */
@@ -624,7 +1274,6 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 					".iso",		/* ISO-9660 */
 					".xiso",	/* Xbox disc image */
 					".min",		/* Pokémon Mini */
-					nullptr
 				};
 
 				if (info.ext == nullptr) {
@@ -633,14 +1282,12 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 				}
 
 				// Check for a matching extension.
-				bool found = false;
-				for (const char *const *ext = exts; *ext != nullptr; ext++) {
-					if (!strcasecmp(info.ext, *ext)) {
-						// Found a match!
-						found = true;
-					}
-				}
-				if (!found) {
+				// The extension is lowercased so a single
+				// hash lookup replaces the strcasecmp() loop.
+				string ext_lower(info.ext);
+				std::transform(ext_lower.begin(), ext_lower.end(), ext_lower.begin(),
+					[](char c) { return std::tolower(static_cast<unsigned char>(c)); });
+				if (set_exts.find(ext_lower) == set_exts.end()) {
 					// No match.
 					break;
 				}
@@ -649,11 +1296,11 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 				checked_exts = true;
 			}
 
-			// Read the new header data.
+			// Get the new header data.
 
 			// NOTE: fns->size == 0 is only correct
 			// for headers located at 0, since we
-			// read the whole 4096+256 bytes for these.
+			// read the whole probe block for these.
 			assert(fns->size != 0);
 			assert(fns->size <= sizeof(header));
 			if (fns->size == 0 || fns->size > sizeof(header))
@@ -664,19 +1311,32 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 			if ((static_cast<off64_t>(fns->address) + fns->size) > info.szFile)
 				continue;
 
-			// Read the header data.
-			info.header.addr = fns->address;
-			int ret = file->seek(info.header.addr);
-			if (ret != 0)
-				continue;
-			info.header.size = static_cast<uint32_t>(file->read(header.u8, fns->size));
-			if (info.header.size != fns->size)
-				continue;
+			if ((static_cast<off64_t>(fns->address) + fns->size) <= probe_size) {
+				// Header is already in the probe block.
+				// Hand the parser a zero-copy view into it.
+				info.header.addr = fns->address;
+				info.header.pData = &header.u8[fns->address];
+				info.header.size = fns->size;
+			} else {
+				// Header is outside of the probe block.
+				// Read it into the scratch buffer.
+				assert(fns->size <= sizeof(scratch));
+				if (fns->size > sizeof(scratch))
+					continue;
+				info.header.addr = fns->address;
+				info.header.pData = scratch;
+				int ret = file->seek(info.header.addr);
+				if (ret != 0)
+					continue;
+				info.header.size = static_cast<uint32_t>(file->read(scratch, fns->size));
+				if (info.header.size != fns->size)
+					continue;
+			}
 		}
 
-		if (fns->isRomSupported(&info) >= 0) {
+		if (probeWithTrace(fns, &info) >= 0) {
 			RomData *romData;
-			if (fns->attrs & RDA_CHECK_ISO) {
+			if (fns->attrs & RomDataFactory::RDA_CHECK_ISO) {
 				// Check for a game-specific ISO subclass.
 				romData = RomDataFactoryPrivate::checkISO(file);
 			} else {
@@ -687,6 +1347,25 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 			if (romData) {
 				if (romData->isValid()) {
 					// RomData subclass obtained.
+					// Update the adaptive probe hit counter.
+					const size_t idx = static_cast<size_t>(
+						fns - &RomDataFactoryPrivate::romDataFns_header[0]);
+					if (idx < RomDataFactoryPrivate::HEADER_FNS_MAX) {
+						ATOMIC_INC_FETCH(&RomDataFactoryPrivate::probeHits[idx]);
+					}
+					if (cacheUsable) {
+						RomDataFactoryPrivate::probeCache_store(cache_filename,
+							info.szFile, cache_mtime, attrs,
+							(fns->attrs & RomDataFactory::RDA_CHECK_ISO)
+								? RomDataFactoryPrivate::checkISO
+								: fns->newRomData);
+					}
+					if (deferFields) {
+						romData->setFieldLoadingDeferred(true);
+					}
+					if (metadataOnly) {
+						romData->setMetadataOnly(true);
+					}
 					return romData;
 				}
 				// Not actually supported.
@@ -714,7 +1393,14 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 		// Do we have a matching extension?
 		// FIXME: Instead of hard-coded, check supportedFileExtensions.
 		// Currently only supports VirtualBoy.
-		if (!info.ext || strcasecmp(info.ext, ".vb") != 0) {
+		// NOTE: If a MIME filter is active, candidate selection
+		// replaces the extension check.
+		if (mimeFilter) {
+			if (mimeFilter->find(fns) == mimeFilter->end()) {
+				// Not a candidate for the supplied MIME type.
+				continue;
+			}
+		} else if (!info.ext || strcasecmp(info.ext, ".vb") != 0) {
 			// Extension doesn't match.
 			continue;
 		}
@@ -724,19 +1410,37 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 			static const int footer_size = 1024;
 			if (info.szFile > footer_size) {
 				info.header.addr = static_cast<uint32_t>(info.szFile - footer_size);
-				info.header.size = static_cast<uint32_t>(file->seekAndRead(info.header.addr, header.u8, footer_size));
-				if (info.header.size == 0) {
-					// Seek and/or read error.
-					return nullptr;
+				if (info.szFile <= probe_size) {
+					// The entire file is in the probe block.
+					// Use a zero-copy view of the footer.
+					info.header.pData = &header.u8[info.header.addr];
+					info.header.size = footer_size;
+				} else {
+					info.header.pData = header.u8;
+					info.header.size = static_cast<uint32_t>(file->seekAndRead(info.header.addr, header.u8, footer_size));
+					if (info.header.size == 0) {
+						// Seek and/or read error.
+						return nullptr;
+					}
 				}
 			}
 			readFooter = true;
 		}
 
-		if (fns->isRomSupported(&info) >= 0) {
+		if (probeWithTrace(fns, &info) >= 0) {
 			RomData *const romData = fns->newRomData(file);
 			if (romData->isValid()) {
 				// RomData subclass obtained.
+				if (cacheUsable) {
+					RomDataFactoryPrivate::probeCache_store(cache_filename,
+						info.szFile, cache_mtime, attrs, fns->newRomData);
+				}
+				if (deferFields) {
+					romData->setFieldLoadingDeferred(true);
+				}
+				if (metadataOnly) {
+					romData->setMetadataOnly(true);
+				}
 				return romData;
 			}
 
@@ -746,6 +1450,189 @@ RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
 	}
 
 	// Not supported.
+	// NOTE: MIME-filtered probes don't store negative verdicts:
+	// the caller falls back to a full probe, which stores the
+	// authoritative result.
+	if (cacheUsable && !mimeFilter) {
+		RomDataFactoryPrivate::probeCache_store(cache_filename,
+			info.szFile, cache_mtime, attrs, nullptr);
+	}
+	return nullptr;
+}
+
+/** RomDataFactory **/
+
+/**
+ * Create a RomData subclass for the specified ROM file.
+ *
+ * NOTE: RomData::isValid() is checked before returning a
+ * created RomData instance, so returned objects can be
+ * assumed to be valid as long as they aren't nullptr.
+ *
+ * If imgbf is non-zero, at least one of the specified image
+ * types must be supported by the RomData subclass in order to
+ * be returned.
+ *
+ * @param file ROM file.
+ * @param attrs RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
+ * @return RomData subclass, or nullptr if the ROM isn't supported.
+ */
+RomData *RomDataFactory::create(IRpFile *file, unsigned int attrs)
+{
+	return create(file, static_cast<const char*>(nullptr), attrs);
+}
+
+/**
+ * Create a RomData subclass for the specified ROM file,
+ * using a known MIME type to narrow the probe sequence.
+ *
+ * If the MIME type is recognized, only the RomData subclasses
+ * that declare it are probed, skipping extension guessing
+ * entirely. Unrecognized MIME types, and recognized MIME types
+ * whose candidates all decline the file, fall back to a full
+ * probe, so an incorrect MIME type from the caller cannot
+ * cause false negatives.
+ *
+ * Intended for MIME-routed callers, e.g. the D-Bus thumbnailer:
+ * Tumbler always supplies the MIME type with the request.
+ *
+ * @param file ROM file.
+ * @param mimeType MIME type of the ROM file, or nullptr if unknown.
+ * @param attrs RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
+ * @return RomData subclass, or nullptr if the ROM isn't supported.
+ */
+RomData *RomDataFactory::create(IRpFile *file, const char *mimeType, unsigned int attrs)
+{
+	RpStats::increment(RpStats::CTR_ROMDATA_PROBE);
+	RpStats::ScopedTimer timer(RpStats::TMR_ROMDATA_PROBE);
+
+	// Look up the candidate parsers for the MIME type.
+	// The dispatch index makes this a single hash lookup.
+	const unordered_set<const RomDataFactoryPrivate::RomDataFns*> *mimeFilter = nullptr;
+	if (mimeType && mimeType[0] != '\0') {
+		pthread_once(&RomDataFactoryPrivate::once_mimeDispatch, RomDataFactoryPrivate::init_mimeDispatch);
+		auto iter = RomDataFactoryPrivate::map_mimeDispatch.find(mimeType);
+		if (iter != RomDataFactoryPrivate::map_mimeDispatch.end()) {
+			mimeFilter = &iter->second;
+		}
+		// Unrecognized MIME types, e.g. application/octet-stream,
+		// get a full probe.
+	}
+
+	// Wrap the file in a buffered window so the many small
+	// header reads issued while probing and parsing hit
+	// memory instead of the OS.
+	// NOTE: Device files are not wrapped; they have their
+	// own sector cache, and some subclasses need the
+	// concrete RpFile for SCSI commands.
+	RpBufferedFile *bufFile = nullptr;
+	IRpFile *probeFile = file;
+	if (!file->isDevice() && !dynamic_cast<RpBufferedFile*>(file)) {
+		bufFile = new RpBufferedFile(file);
+		if (bufFile->isOpen()) {
+			probeFile = bufFile;
+		}
+		// NOTE: If bufFile couldn't be opened (shouldn't happen),
+		// probing falls back to the unbuffered file.
+	}
+
+	RomData *romData = RomDataFactoryPrivate::create_int(probeFile, attrs, mimeFilter);
+	if (!romData && mimeFilter) {
+		// None of the MIME-selected candidates accepted the file.
+		// The supplied MIME type may be wrong; run a full probe.
+		romData = RomDataFactoryPrivate::create_int(probeFile, attrs);
+	}
+
+	if (bufFile) {
+		// If a RomData subclass was created, it took its own
+		// reference to the buffered file.
+		bufFile->unref();
+	}
+
+	if (romData) {
+		RpStats::increment(RpStats::CTR_ROMDATA_CREATED);
+	}
+	return romData;
+}
+
+/**
+ * Load a file's icon without constructing a RomData instance.
+ *
+ * For common formats where the icon is located at an address
+ * computable from the header alone (e.g. NDS, 3DS SMDH), this
+ * reads only the icon bytes, skipping full constructor parsing.
+ * Intended for icon handlers that are called by the hundreds,
+ * e.g. Explorer list views.
+ *
+ * If nullptr is returned, the caller should fall back to
+ * create() and the regular image extraction interfaces.
+ *
+ * @param file ROM file.
+ * @return Icon, or nullptr if no fast icon path is available. (Caller must delete the icon.)
+ */
+LibRpTexture::rp_image *RomDataFactory::fastIcon(IRpFile *file)
+{
+	assert(file != nullptr);
+	if (!file) {
+		return nullptr;
+	}
+
+	RomData::DetectInfo info;
+	info.szFile = file->size();
+	// NOTE: Not determining the file extension. All fast icon
+	// formats are identified by a 32-bit magic number.
+	info.ext = nullptr;
+
+	// Read a small probe block. Fast icon formats only need
+	// the first part of the header for detection.
+	static const uint32_t FAST_PROBE_SIZE = 4096;
+	union {
+		uint8_t u8[FAST_PROBE_SIZE];
+		uint32_t u32[FAST_PROBE_SIZE/4];
+	} header;
+	file->rewind();
+	const uint32_t probe_size = static_cast<uint32_t>(file->read(header.u8, sizeof(header.u8)));
+	if (probe_size == 0) {
+		// Read error.
+		return nullptr;
+	}
+	info.header.addr = 0;
+	info.header.pData = header.u8;
+	info.header.size = probe_size;
+
+	// Check the magic number dispatch index for parsers
+	// that have a fast icon extraction function.
+	pthread_once(&RomDataFactoryPrivate::once_magicDispatch, RomDataFactoryPrivate::init_magicDispatch);
+	for (const uint32_t address : RomDataFactoryPrivate::vec_magicAddrs) {
+		if (address + sizeof(uint32_t) > probe_size) {
+			// Header is too small for this magic number.
+			continue;
+		}
+
+		const uint32_t magic = be32_to_cpu(header.u32[address/4]);
+		const uint64_t key = (static_cast<uint64_t>(address) << 32) | magic;
+		auto iter = RomDataFactoryPrivate::map_magicDispatch.find(key);
+		if (iter == RomDataFactoryPrivate::map_magicDispatch.end())
+			continue;
+
+		for (const RomDataFactoryPrivate::RomDataFns *fns : iter->second) {
+			if (!fns->fastIcon) {
+				// No fast icon extraction function.
+				continue;
+			}
+
+			// Magic number already matched via the dispatch index.
+			if (fns->isRomSupported(&info) >= 0) {
+				LibRpTexture::rp_image *const img = fns->fastIcon(file);
+				if (img) {
+					// Icon extracted.
+					return img;
+				}
+			}
+		}
+	}
+
+	// No fast icon path is available for this file.
 	return nullptr;
 }
 
@@ -805,7 +1692,7 @@ void RomDataFactoryPrivate::init_supportedFileExtensions(void)
 
 	// Get file extensions from FileFormatFactory.
 	static const unsigned int FFF_ATTRS = ATTR_HAS_THUMBNAIL | ATTR_HAS_METADATA;
-	vector<const char*> vec_exts_fileFormat = FileFormatFactory::supportedFileExtensions();
+	const vector<const char*> &vec_exts_fileFormat = FileFormatFactory::supportedFileExtensions();
 	std::for_each(vec_exts_fileFormat.cbegin(), vec_exts_fileFormat.cend(),
 		[&map_exts](const char *ext) {
 			auto iter = map_exts.find(ext);
@@ -888,7 +1775,7 @@ void RomDataFactoryPrivate::init_supportedMimeTypes(void)
 	}
 
 	// Get MIME types from FileFormatFactory.
-	vector<const char*> vec_mimeTypes_fileFormat = FileFormatFactory::supportedMimeTypes();
+	const vector<const char*> &vec_mimeTypes_fileFormat = FileFormatFactory::supportedMimeTypes();
 	std::for_each(vec_mimeTypes_fileFormat.cbegin(), vec_mimeTypes_fileFormat.cend(),
 		[&set_mimeTypes](const char *mimeType) {
 			auto iter = set_mimeTypes.find(mimeType);
@@ -912,4 +1799,51 @@ const vector<const char*> &RomDataFactory::supportedMimeTypes(void)
 	return RomDataFactoryPrivate::vec_mimeTypes;
 }
 
+/** Capability snapshot **/
+
+// Generated by rp-capgen from the same function tables.
+#include "RomDataCapabilities_data.h"
+
+/**
+ * Get the precomputed file extension capability snapshot.
+ *
+ * Unlike supportedFileExtensions(), this does no dynamic
+ * list assembly at all: the data was generated at build
+ * time by rp-capgen from the same function tables and is
+ * embedded in .rodata, sorted by extension.
+ *
+ * NOTE: The snapshot is generated from a full Linux build.
+ * Reduced builds may compile out some subclasses, in which
+ * case the snapshot is a superset of the live tables; use
+ * supportedFileExtensions() when an exact list is required.
+ *
+ * @param pLen	[out] Number of entries.
+ * @return Capability snapshot array.
+ */
+const RomDataFactory::CapabilityExt *RomDataFactory::extCapabilitySnapshot(size_t *pLen)
+{
+	assert(pLen != nullptr);
+	if (pLen) {
+		*pLen = ARRAY_SIZE(romdata_cap_exts);
+	}
+	return romdata_cap_exts;
+}
+
+/**
+ * Get the precomputed MIME type capability snapshot.
+ *
+ * See extCapabilitySnapshot() for caveats.
+ *
+ * @param pLen	[out] Number of entries.
+ * @return MIME type array, sorted.
+ */
+const char *const *RomDataFactory::mimeCapabilitySnapshot(size_t *pLen)
+{
+	assert(pLen != nullptr);
+	if (pLen) {
+		*pLen = ARRAY_SIZE(romdata_cap_mimeTypes);
+	}
+	return romdata_cap_mimeTypes;
+}
+
 }
@@ -20,6 +20,9 @@ namespace LibRpBase {
 namespace LibRpFile {
 	class IRpFile;
 }
+namespace LibRpTexture {
+	class rp_image;
+}
 
 namespace LibRomData {
 
@@ -56,6 +59,22 @@ class RomDataFactory
 			// Check for game-specific disc file systems.
 			// (For internal RomDataFactory use only.)
 			RDA_CHECK_ISO		= (1U << 8),
+
+			// Caller-intent flag: Defer field and metadata
+			// loading on the returned RomData object.
+			// Use this for thumbnail-only opens so shared
+			// helpers can't accidentally trigger expensive
+			// field parsing. Not a subclass attribute; this
+			// flag is not used for subclass matching.
+			RDA_DEFER_FIELDS	= (1U << 16),
+
+			// Caller-intent flag: Metadata-only open.
+			// Implies RDA_HAS_METADATA for subclass matching,
+			// and marks the returned RomData object so the
+			// image interfaces don't decode anything.
+			// Use this for file indexers (Baloo, Windows
+			// Search), which only need metaData().
+			RDA_METADATA_ONLY	= (1U << 17),
 		};
 
 		/**
@@ -75,6 +94,44 @@ class RomDataFactory
 		 */
 		static LibRpBase::RomData *create(LibRpFile::IRpFile *file, unsigned int attrs = 0);
 
+		/**
+		 * Create a RomData subclass for the specified ROM file,
+		 * using a known MIME type to narrow the probe sequence.
+		 *
+		 * If the MIME type is recognized, only the RomData subclasses
+		 * that declare it are probed, skipping extension guessing
+		 * entirely. Unrecognized MIME types, and recognized MIME types
+		 * whose candidates all decline the file, fall back to a full
+		 * probe, so an incorrect MIME type from the caller cannot
+		 * cause false negatives.
+		 *
+		 * Intended for MIME-routed callers, e.g. the D-Bus thumbnailer:
+		 * Tumbler always supplies the MIME type with the request.
+		 *
+		 * @param file ROM file.
+		 * @param mimeType MIME type of the ROM file, or nullptr if unknown.
+		 * @param attrs RomDataAttr bitfield. If set, RomData subclass must have the specified attributes.
+		 * @return RomData subclass, or nullptr if the ROM isn't supported.
+		 */
+		static LibRpBase::RomData *create(LibRpFile::IRpFile *file, const char *mimeType, unsigned int attrs = 0);
+
+		/**
+		 * Load a file's icon without constructing a RomData instance.
+		 *
+		 * For common formats where the icon is located at an address
+		 * computable from the header alone (e.g. NDS, 3DS SMDH), this
+		 * reads only the icon bytes, skipping full constructor parsing.
+		 * Intended for icon handlers that are called by the hundreds,
+		 * e.g. Explorer list views.
+		 *
+		 * If nullptr is returned, the caller should fall back to
+		 * create() and the regular image extraction interfaces.
+		 *
+		 * @param file ROM file.
+		 * @return Icon, or nullptr if no fast icon path is available. (Caller must delete the icon.)
+		 */
+		static LibRpTexture::rp_image *fastIcon(LibRpFile::IRpFile *file);
+
 		struct ExtInfo {
 			const char *ext;
 			unsigned int attrs;
@@ -104,6 +161,44 @@ class RomDataFactory
 		 * @return All supported MIME types.
 		 */
 		static const std::vector<const char*> &supportedMimeTypes(void);
+
+	public:
+		/** Capability snapshot **/
+
+		// Capability snapshot entry. (POD, so the snapshot
+		// arrays are constant-initialized into .rodata.)
+		struct CapabilityExt {
+			const char *ext;	// File extension, including the leading dot.
+			unsigned int attrs;	// RomDataAttr bitfield.
+		};
+
+		/**
+		 * Get the precomputed file extension capability snapshot.
+		 *
+		 * Unlike supportedFileExtensions(), this does no dynamic
+		 * list assembly at all: the data was generated at build
+		 * time by rp-capgen from the same function tables and is
+		 * embedded in .rodata, sorted by extension.
+		 *
+		 * NOTE: The snapshot is generated from a full Linux build.
+		 * Reduced builds may compile out some subclasses, in which
+		 * case the snapshot is a superset of the live tables; use
+		 * supportedFileExtensions() when an exact list is required.
+		 *
+		 * @param pLen	[out] Number of entries.
+		 * @return Capability snapshot array.
+		 */
+		static const CapabilityExt *extCapabilitySnapshot(size_t *pLen);
+
+		/**
+		 * Get the precomputed MIME type capability snapshot.
+		 *
+		 * See extCapabilitySnapshot() for caveats.
+		 *
+		 * @param pLen	[out] Number of entries.
+		 * @return MIME type array, sorted.
+		 */
+		static const char *const *mimeCapabilitySnapshot(size_t *pLen);
 };
 
 }
@@ -17,6 +17,9 @@
 using namespace LibRpBase;
 using namespace LibRpFile;
 
+// librpthreads
+#include "librpthreads/ThreadPool.hpp"
+
 // libromdata
 #include "../disc/WiiPartition.hpp"
 #include "../crypto/CtrKeyScrambler.hpp"
@@ -115,6 +118,38 @@ class KeyStoreUIPrivate
 		 */
 		int verifyKeyData(const uint8_t *keyData, const uint8_t *verifyData, int len);
 
+		/**
+		 * Verify a key using the specified cipher.
+		 * @param cipher	[in] AES cipher, set to ECB mode.
+		 * @param keyData	[in] Key data. (16 bytes)
+		 * @param verifyData	[in] Key verification data. (16 bytes)
+		 * @param len		[in] Length of keyData and verifyData. (must be 16)
+		 * @return 0 if the key is verified; non-zero if not.
+		 */
+		static int verifyKeyData(IAesCipher *cipher, const uint8_t *keyData,
+			const uint8_t *verifyData, int len);
+
+		// Batch key verification candidate.
+		struct KeyVerifyCandidate {
+			const uint8_t *keyData;		// Key data. (16 bytes)
+			const uint8_t *verifyData;	// Key verification data. (16 bytes)
+			int result;			// 0 if verified; non-zero if not.
+		};
+
+		/**
+		 * Verify a batch of candidate keys.
+		 *
+		 * The candidates are fanned out over the process-wide
+		 * thread pool. Each worker creates a single AES cipher
+		 * context and reuses it for its whole band of candidates
+		 * instead of re-keying the shared cipher one candidate
+		 * at a time.
+		 *
+		 * @param candidates	[in/out] Candidates. (result is set per entry)
+		 * @param count		[in] Number of candidates.
+		 */
+		static void verifyKeyDataBatch(KeyVerifyCandidate *candidates, size_t count);
+
 		/**
 		 * Verify a key and update its status.
 		 * @param sectIdx Section index.
@@ -474,6 +509,11 @@ KeyStoreUI::ImportReturn KeyStoreUIPrivate::importKeysFromBlob(
 	RP_Q(KeyStoreUI);
 	bool wereKeysImported = false;
 	const int keyIdxStart = sections[sectIdx].keyIdxStart;
+
+	// First pass: Handle keys that can't be verified, and collect
+	// the verifiable candidates for batch verification.
+	vector<KeyVerifyCandidate> candidates;
+	vector<int> candidateKeyIdx;	// kba->keyIdx per candidate
 	for (; kba->keyIdx >= 0; kba++) {
 		KeyStoreUI::Key *const pKey = &keys[keyIdxStart + kba->keyIdx];
 		if (pKey->status == KeyStoreUI::Key::Status_OK) {
@@ -511,19 +551,36 @@ KeyStoreUI::ImportReturn KeyStoreUIPrivate::importKeysFromBlob(
 			continue;
 		}
 
-		// Verify the key.
-		int ret = verifyKeyData(keyData, verifyData, 16);
-		if (ret == 0) {
+		// Queue the key for batch verification.
+		KeyVerifyCandidate cand;
+		cand.keyData = keyData;
+		cand.verifyData = verifyData;
+		cand.result = -1;
+		candidates.push_back(cand);
+		candidateKeyIdx.push_back(kba->keyIdx);
+	}
+
+	// Verify the candidates, fanned out over the thread pool.
+	verifyKeyDataBatch(candidates.data(), candidates.size());
+
+	// Second pass: Apply the verification results.
+	// NOTE: The per-key change signals are emitted here, on the
+	// calling thread; KeyStoreUI is toolkit-agnostic and has no
+	// event loop to marshal them through.
+	for (size_t i = 0; i < candidates.size(); i++) {
+		const int keyIdx = candidateKeyIdx[i];
+		KeyStoreUI::Key *const pKey = &keys[keyIdxStart + keyIdx];
+		if (candidates[i].result == 0) {
 			// Found a match!
-			const string new_value = binToHexStr(keyData, 16);
+			const string new_value = binToHexStr(candidates[i].keyData, 16);
 			if (pKey->value != new_value) {
-				pKey->value = binToHexStr(keyData, 16);
+				pKey->value = new_value;
 				pKey->status = KeyStoreUI::Key::Status_OK;
 				pKey->modified = true;
 				iret.keysImportedVerify++;
 				wereKeysImported = true;
-				emit q->keyChanged_int(sectIdx, kba->keyIdx);
-				emit q->keyChanged_int(keyIdxStart + kba->keyIdx);
+				emit q->keyChanged_int(sectIdx, keyIdx);
+				emit q->keyChanged_int(keyIdxStart + keyIdx);
 			} else {
 				// No change.
 				iret.keysExist++;
@@ -647,6 +704,20 @@ string KeyStoreUIPrivate::convertKanjiToHex(const string &str)
  * @return 0 if the key is verified; non-zero if not.
  */
 int KeyStoreUIPrivate::verifyKeyData(const uint8_t *keyData, const uint8_t *verifyData, int len)
+{
+	return verifyKeyData(cipher, keyData, verifyData, len);
+}
+
+/**
+ * Verify a key using the specified cipher.
+ * @param cipher	[in] AES cipher, set to ECB mode.
+ * @param keyData	[in] Key data. (16 bytes)
+ * @param verifyData	[in] Key verification data. (16 bytes)
+ * @param len		[in] Length of keyData and verifyData. (must be 16)
+ * @return 0 if the key is verified; non-zero if not.
+ */
+int KeyStoreUIPrivate::verifyKeyData(IAesCipher *cipher, const uint8_t *keyData,
+	const uint8_t *verifyData, int len)
 {
 	assert(len == 16);
 	if (len != 16) {
@@ -672,6 +743,65 @@ int KeyStoreUIPrivate::verifyKeyData(const uint8_t *keyData, const uint8_t *veri
 	return (memcmp(testData, KeyManager::verifyTestString, sizeof(testData)) != 0);
 }
 
+/**
+ * Verify a batch of candidate keys.
+ *
+ * The candidates are fanned out over the process-wide
+ * thread pool. Each worker creates a single AES cipher
+ * context and reuses it for its whole band of candidates
+ * instead of re-keying the shared cipher one candidate
+ * at a time.
+ *
+ * @param candidates	[in/out] Candidates. (result is set per entry)
+ * @param count		[in] Number of candidates.
+ */
+void KeyStoreUIPrivate::verifyKeyDataBatch(KeyVerifyCandidate *candidates, size_t count)
+{
+	assert(candidates != nullptr);
+	if (!candidates || count == 0)
+		return;
+
+	// Worker function: verify a band of candidates using
+	// a single cipher context.
+	auto verifyBand = [candidates](size_t start, size_t end) {
+		unique_ptr<IAesCipher> cipher(AesCipherFactory::create());
+		const bool isUsable = (cipher && cipher->isInit());
+		if (isUsable) {
+			cipher->setChainingMode(IAesCipher::CM_ECB);
+		}
+		for (size_t i = start; i < end; i++) {
+			candidates[i].result = (isUsable
+				? verifyKeyData(cipher.get(),
+					candidates[i].keyData,
+					candidates[i].verifyData, 16)
+				: -EIO);
+		}
+	};
+
+	ThreadPool *const pool = ThreadPool::instance();
+	unsigned int nThreads = pool->threadCount();
+	if (nThreads > count) {
+		nThreads = static_cast<unsigned int>(count);
+	}
+	if (nThreads <= 1) {
+		// Single-CPU system, or only one candidate.
+		// Verify everything on the calling thread.
+		verifyBand(0, count);
+		return;
+	}
+
+	// Split the candidates into one band per worker.
+	ThreadPool::TaskSet taskSet;
+	const size_t band = (count + nThreads - 1) / nThreads;
+	for (size_t start = 0; start < count; start += band) {
+		const size_t end = (start + band < count ? start + band : count);
+		taskSet.submit([verifyBand, start, end]() {
+			verifyBand(start, end);
+		});
+	}
+	taskSet.wait();
+}
+
 /**
  * Verify a key and update its status.
  * @param sectIdx Section index.
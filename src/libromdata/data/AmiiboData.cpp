@@ -9,6 +9,23 @@
 #include "stdafx.h"
 #include "AmiiboData.hpp"
 
+// librpfile
+#include "librpfile/FileSystem.hpp"
+#include "librpfile/RpFile.hpp"
+using namespace LibRpFile;
+
+// One-time initialization.
+#include "librpthreads/pthread_once.h"
+#include "librpthreads/Mutex.hpp"
+
+// for le16_to_cpu(), le32_to_cpu()
+#include "librpcpu/byteswap.h"
+
+// C++ STL classes.
+using std::string;
+using std::unordered_map;
+using std::vector;
+
 namespace LibRomData {
 
 /**
@@ -156,6 +173,105 @@ class AmiiboDataPrivate {
 			const char *name;	// Character name.
 		};
 		static const amiibo_id_t amiibo_ids[];
+
+	public:
+		/** External data file ("amiibo-data.bin") **/
+
+		// Flat binary format for external amiibo data.
+		// All integers are little-endian, and all "name"
+		// fields are byte offsets into the string table.
+		// Offset 0 is reserved for "no name". (empty string)
+		// The file is loaded once and used in place, so new
+		// amiibo can be added without rebuilding rom-properties.
+#pragma pack(1)
+		#define AMIIBO_BIN_MAGIC "RPAMIIBO"
+		#define AMIIBO_BIN_VERSION 1
+		struct PACKED AmiiboBinHeader {
+			char magic[8];			// [0x000] "RPAMIIBO"
+			uint32_t version;		// [0x008] Format version. (1)
+			uint32_t strtbl_offset;		// [0x00C] String table.
+			uint32_t strtbl_len;		// [0x010]
+			uint32_t cseries_offset;	// [0x014] Character series names.
+			uint32_t cseries_count;		// [0x018] (uint32_t name offsets)
+			uint32_t char_offset;		// [0x01C] Characters, sorted by char_id.
+			uint32_t char_count;		// [0x020] (bin_char_t)
+			uint32_t cvar_offset;		// [0x024] Character variants.
+			uint32_t cvar_count;		// [0x028] (bin_char_variant_t)
+			uint32_t aseries_offset;	// [0x02C] amiibo series names.
+			uint32_t aseries_count;		// [0x030] (uint32_t name offsets)
+			uint32_t amiibo_offset;		// [0x034] amiibo IDs, indexed by ID.
+			uint32_t amiibo_count;		// [0x038] (bin_amiibo_t)
+			uint8_t reserved[4];		// [0x03C]
+		};
+		struct PACKED bin_char_t {
+			uint16_t char_id;	// Character ID. (Includes series ID.)
+			uint8_t variants_size;	// Number of variants.
+			uint8_t reserved;
+			uint32_t name;		// Character name. (same as variant 0)
+			uint32_t variants;	// Index of first variant in the variant table.
+		};
+		struct PACKED bin_char_variant_t {
+			uint8_t variant_id;
+			uint8_t reserved[3];
+			uint32_t name;		// Variant name.
+		};
+		struct PACKED bin_amiibo_t {
+			uint16_t release_no;	// Release number. (0 for no ordering)
+			uint8_t wave_no;	// Wave number.
+			uint8_t reserved;
+			uint32_t name;		// Character name.
+		};
+#pragma pack()
+
+		// Loaded data file. (empty if not loaded)
+		static ao::uvector<uint8_t> binData;
+		// Section pointers into binData. (nullptr if not loaded)
+		static const AmiiboBinHeader *binHeader;
+		static const char *bin_strtbl;		// strtbl_len bytes
+		static const uint32_t *bin_cseries;
+		static const bin_char_t *bin_chars;
+		static const bin_char_variant_t *bin_cvars;
+		static const uint32_t *bin_aseries;
+		static const bin_amiibo_t *bin_amiibos;
+
+		// One-time initialization variable and functions.
+		static pthread_once_t once_control;
+
+		/**
+		 * Load the external amiibo data file, if available.
+		 * Called by pthread_once().
+		 * On success, the bin_* section pointers are set.
+		 */
+		static void loadBinFile(void);
+
+		/**
+		 * Get a string from the loaded string table.
+		 * @param offset String table offset.
+		 * @return String, or nullptr if 0 or out of range.
+		 */
+		static inline const char *bin_string(uint32_t offset)
+		{
+			offset = le32_to_cpu(offset);
+			if (offset == 0 || offset >= le32_to_cpu(binHeader->strtbl_len)) {
+				return nullptr;
+			}
+			return &bin_strtbl[offset];
+		}
+
+		/**
+		 * bin_char_t bsearch() comparison function.
+		 * @param a
+		 * @param b
+		 * @return
+		 */
+		static int RP_C_API bin_char_t_compar(const void *a, const void *b);
+
+		// Memoized composite records, keyed by
+		// (char_id << 32 | amiibo_id).
+		// NOTE: unordered_map values have stable addresses,
+		// so returned pointers stay valid across inserts.
+		static LibRpBase::Mutex amiiboCacheMutex;
+		static std::unordered_map<uint64_t, AmiiboData::AmiiboRecord_t> amiiboCache;
 };
 
 /** Page 21 (raw offset 0x54): Character series **/
@@ -2271,6 +2387,144 @@ const AmiiboDataPrivate::amiibo_id_t AmiiboDataPrivate::amiibo_ids[] = {
 	{  0, 0, "Link"},			// 0x0399
 };
 
+/** External data file **/
+
+// Loaded data file.
+ao::uvector<uint8_t> AmiiboDataPrivate::binData;
+// Section pointers into binData.
+const AmiiboDataPrivate::AmiiboBinHeader *AmiiboDataPrivate::binHeader = nullptr;
+const char *AmiiboDataPrivate::bin_strtbl = nullptr;
+const uint32_t *AmiiboDataPrivate::bin_cseries = nullptr;
+const AmiiboDataPrivate::bin_char_t *AmiiboDataPrivate::bin_chars = nullptr;
+const AmiiboDataPrivate::bin_char_variant_t *AmiiboDataPrivate::bin_cvars = nullptr;
+const uint32_t *AmiiboDataPrivate::bin_aseries = nullptr;
+const AmiiboDataPrivate::bin_amiibo_t *AmiiboDataPrivate::bin_amiibos = nullptr;
+
+// pthread_once() control variable.
+pthread_once_t AmiiboDataPrivate::once_control = PTHREAD_ONCE_INIT;
+
+// Memoized composite records.
+LibRpBase::Mutex AmiiboDataPrivate::amiiboCacheMutex;
+std::unordered_map<uint64_t, AmiiboData::AmiiboRecord_t> AmiiboDataPrivate::amiiboCache;
+
+/**
+ * Load the external amiibo data file, if available.
+ * Called by pthread_once().
+ * On success, the bin_* section pointers are set.
+ */
+void AmiiboDataPrivate::loadBinFile(void)
+{
+	// Data file is "amiibo-data.bin" in the configuration directory.
+	string filename = FileSystem::getConfigDirectory();
+	if (filename.empty()) {
+		// No configuration directory.
+		return;
+	}
+	if (filename.at(filename.size()-1) != DIR_SEP_CHR) {
+		filename += DIR_SEP_CHR;
+	}
+	filename += "amiibo-data.bin";
+
+	RpFile *const file = new RpFile(filename, RpFile::FM_OPEN_READ);
+	if (!file->isOpen()) {
+		// No data file. Use the built-in tables.
+		file->unref();
+		return;
+	}
+
+	// Sanity check: 64 KB should be more than enough.
+	static const int64_t MAX_BIN_FILESIZE = 64*1024;
+	const int64_t fileSize = file->size();
+	if (fileSize < static_cast<int64_t>(sizeof(AmiiboBinHeader)) ||
+	    fileSize > MAX_BIN_FILESIZE)
+	{
+		// File size is out of range.
+		file->unref();
+		return;
+	}
+
+	binData.resize(static_cast<size_t>(fileSize));
+	size_t size = file->read(binData.data(), binData.size());
+	file->unref();
+	if (size != binData.size()) {
+		// Read error.
+		binData.clear();
+		return;
+	}
+
+	// Validate the header.
+	const AmiiboBinHeader *const header =
+		reinterpret_cast<const AmiiboBinHeader*>(binData.data());
+	if (memcmp(header->magic, AMIIBO_BIN_MAGIC, sizeof(header->magic)) != 0 ||
+	    le32_to_cpu(header->version) != AMIIBO_BIN_VERSION)
+	{
+		// Wrong magic or version.
+		binData.clear();
+		return;
+	}
+
+	// Validate the section bounds.
+	struct section_t {
+		uint32_t offset;
+		uint32_t count;
+		uint32_t entry_size;
+	};
+	const section_t sections[] = {
+		{le32_to_cpu(header->strtbl_offset),  le32_to_cpu(header->strtbl_len), 1},
+		{le32_to_cpu(header->cseries_offset), le32_to_cpu(header->cseries_count), (uint32_t)sizeof(uint32_t)},
+		{le32_to_cpu(header->char_offset),    le32_to_cpu(header->char_count), (uint32_t)sizeof(bin_char_t)},
+		{le32_to_cpu(header->cvar_offset),    le32_to_cpu(header->cvar_count), (uint32_t)sizeof(bin_char_variant_t)},
+		{le32_to_cpu(header->aseries_offset), le32_to_cpu(header->aseries_count), (uint32_t)sizeof(uint32_t)},
+		{le32_to_cpu(header->amiibo_offset),  le32_to_cpu(header->amiibo_count), (uint32_t)sizeof(bin_amiibo_t)},
+	};
+	for (unsigned int i = 0; i < ARRAY_SIZE(sections); i++) {
+		const uint64_t end = static_cast<uint64_t>(sections[i].offset) +
+			(static_cast<uint64_t>(sections[i].count) * sections[i].entry_size);
+		if (sections[i].offset < sizeof(AmiiboBinHeader) ||
+		    end > static_cast<uint64_t>(fileSize))
+		{
+			// Section is out of range.
+			binData.clear();
+			return;
+		}
+	}
+
+	// The string table must be non-empty and NULL-terminated,
+	// and offset 0 must be an empty string.
+	const uint32_t strtbl_len = le32_to_cpu(header->strtbl_len);
+	const char *const strtbl = reinterpret_cast<const char*>(
+		&binData[le32_to_cpu(header->strtbl_offset)]);
+	if (strtbl_len == 0 || strtbl[0] != '\0' || strtbl[strtbl_len-1] != '\0') {
+		// Invalid string table.
+		binData.clear();
+		return;
+	}
+
+	// Data file is valid. Set the section pointers.
+	binHeader = header;
+	bin_strtbl = strtbl;
+	bin_cseries = reinterpret_cast<const uint32_t*>(&binData[le32_to_cpu(header->cseries_offset)]);
+	bin_chars = reinterpret_cast<const bin_char_t*>(&binData[le32_to_cpu(header->char_offset)]);
+	bin_cvars = reinterpret_cast<const bin_char_variant_t*>(&binData[le32_to_cpu(header->cvar_offset)]);
+	bin_aseries = reinterpret_cast<const uint32_t*>(&binData[le32_to_cpu(header->aseries_offset)]);
+	bin_amiibos = reinterpret_cast<const bin_amiibo_t*>(&binData[le32_to_cpu(header->amiibo_offset)]);
+}
+
+/**
+ * bin_char_t bsearch() comparison function.
+ * @param a
+ * @param b
+ * @return
+ */
+int RP_C_API AmiiboDataPrivate::bin_char_t_compar(const void *a, const void *b)
+{
+	uint16_t id1 = reinterpret_cast<const bin_char_t*>(a)->char_id;
+	uint16_t id2 = le16_to_cpu(reinterpret_cast<const bin_char_t*>(b)->char_id);
+	if (id1 < id2) return -1;
+	if (id1 > id2) return 1;
+	return 0;
+}
+
 /** AmiiboData **/
 
 /**
@@ -2283,7 +2537,17 @@ const char *AmiiboData::lookup_char_series_name(uint32_t char_id)
 	static_assert(ARRAY_SIZE(AmiiboDataPrivate::char_series_names) == (0x38C/4)+1,
 		"char_series_names[] is out of sync with the amiibo ID list.");
 
+	// Check for an external data file.
+	pthread_once(&AmiiboDataPrivate::once_control, AmiiboDataPrivate::loadBinFile);
+
 	const unsigned int series_id = (char_id >> 22) & 0x3FF;
+	if (AmiiboDataPrivate::binHeader) {
+		// Use the external data file.
+		if (series_id >= le32_to_cpu(AmiiboDataPrivate::binHeader->cseries_count))
+			return nullptr;
+		return AmiiboDataPrivate::bin_string(AmiiboDataPrivate::bin_cseries[series_id]);
+	}
+
 	if (series_id >= ARRAY_SIZE(AmiiboDataPrivate::char_series_names))
 		return nullptr;
 	return AmiiboDataPrivate::char_series_names[series_id];
@@ -2297,7 +2561,50 @@ const char *AmiiboData::lookup_char_series_name(uint32_t char_id)
  */
 const char *AmiiboData::lookup_char_name(uint32_t char_id)
 {
+	// Check for an external data file.
+	pthread_once(&AmiiboDataPrivate::once_control, AmiiboDataPrivate::loadBinFile);
+
 	const uint16_t id = (char_id >> 16) & 0xFFFF;
+	const uint8_t variant_id_bin = (char_id >> 8) & 0xFF;
+
+	if (AmiiboDataPrivate::binHeader) {
+		// Use the external data file.
+		const AmiiboDataPrivate::bin_char_t key = {id, 0, 0, 0, 0};
+		const AmiiboDataPrivate::bin_char_t *const res =
+			static_cast<const AmiiboDataPrivate::bin_char_t*>(bsearch(&key,
+				AmiiboDataPrivate::bin_chars,
+				le32_to_cpu(AmiiboDataPrivate::binHeader->char_count),
+				sizeof(AmiiboDataPrivate::bin_char_t),
+				AmiiboDataPrivate::bin_char_t_compar));
+		if (!res) {
+			// Character ID not found.
+			return nullptr;
+		}
+
+		if (res->variants_size == 0) {
+			// No variants.
+			return (variant_id_bin == 0
+				? AmiiboDataPrivate::bin_string(res->name)
+				: nullptr);
+		}
+
+		// Do a linear search in the variant table.
+		const uint32_t cvar_count = le32_to_cpu(AmiiboDataPrivate::binHeader->cvar_count);
+		uint32_t var_idx = le32_to_cpu(res->variants);
+		for (unsigned int i = res->variants_size; i > 0; i--, var_idx++) {
+			if (var_idx >= cvar_count)
+				break;
+			const AmiiboDataPrivate::bin_char_variant_t *const variant =
+				&AmiiboDataPrivate::bin_cvars[var_idx];
+			if (variant->variant_id == variant_id_bin) {
+				// Found the variant.
+				return AmiiboDataPrivate::bin_string(variant->name);
+			}
+		}
+
+		// Variant not found.
+		return nullptr;
+	}
 
 	// Do a binary search.
 	const AmiiboDataPrivate::char_id_t key = {id, 0, nullptr, nullptr};
@@ -2353,7 +2660,17 @@ const char *AmiiboData::lookup_amiibo_series_name(uint32_t amiibo_id)
 	static_assert(ARRAY_SIZE(AmiiboDataPrivate::amiibo_ids) == ((0x0399)+1),
 		"amiibo_ids[] is out of sync with the amiibo ID list.");
 
+	// Check for an external data file.
+	pthread_once(&AmiiboDataPrivate::once_control, AmiiboDataPrivate::loadBinFile);
+
 	const unsigned int series_id = (amiibo_id >> 8) & 0xFF;
+	if (AmiiboDataPrivate::binHeader) {
+		// Use the external data file.
+		if (series_id >= le32_to_cpu(AmiiboDataPrivate::binHeader->aseries_count))
+			return nullptr;
+		return AmiiboDataPrivate::bin_string(AmiiboDataPrivate::bin_aseries[series_id]);
+	}
+
 	if (series_id >= ARRAY_SIZE(AmiiboDataPrivate::amiibo_series_names))
 		return nullptr;
 	return AmiiboDataPrivate::amiibo_series_names[series_id];
@@ -2368,7 +2685,28 @@ const char *AmiiboData::lookup_amiibo_series_name(uint32_t amiibo_id)
  */
 const char *AmiiboData::lookup_amiibo_series_data(uint32_t amiibo_id, int *pReleaseNo, int *pWaveNo)
 {
+	// Check for an external data file.
+	pthread_once(&AmiiboDataPrivate::once_control, AmiiboDataPrivate::loadBinFile);
+
 	const unsigned int id = (amiibo_id >> 16) & 0xFFFF;
+	if (AmiiboDataPrivate::binHeader) {
+		// Use the external data file.
+		if (id >= le32_to_cpu(AmiiboDataPrivate::binHeader->amiibo_count)) {
+			// ID is out of range.
+			return nullptr;
+		}
+
+		const AmiiboDataPrivate::bin_amiibo_t *const amiibo =
+			&AmiiboDataPrivate::bin_amiibos[id];
+		if (pReleaseNo) {
+			*pReleaseNo = le16_to_cpu(amiibo->release_no);
+		}
+		if (pWaveNo) {
+			*pWaveNo = amiibo->wave_no;
+		}
+		return AmiiboDataPrivate::bin_string(amiibo->name);
+	}
+
 	if (id >= ARRAY_SIZE(AmiiboDataPrivate::amiibo_ids)) {
 		// ID is out of range.
 		return nullptr;
@@ -2385,4 +2723,202 @@ const char *AmiiboData::lookup_amiibo_series_data(uint32_t amiibo_id, int *pRele
 	return amiibo->name;
 }
 
+/**
+ * Look up the complete identification record for an amiibo.
+ *
+ * The result is memoized per (char_id, amiibo_id) pair, so
+ * repeated dumps of the same figure within one process
+ * resolve in a single cache probe instead of the full
+ * lookup cascade.
+ *
+ * @param char_id	[in] Character ID. (Page 21) [must be host-endian]
+ * @param amiibo_id	[in] amiibo ID. (Page 22) [must be host-endian]
+ * @return Amiibo record. (never nullptr; fields are nullptr/0 if not found)
+ */
+const AmiiboData::AmiiboRecord_t *AmiiboData::lookup_amiibo(uint32_t char_id, uint32_t amiibo_id)
+{
+	const uint64_t key = (static_cast<uint64_t>(char_id) << 32) | amiibo_id;
+
+	{
+		// Check the cache first.
+		LibRpBase::MutexLocker locker(AmiiboDataPrivate::amiiboCacheMutex);
+		auto iter = AmiiboDataPrivate::amiiboCache.find(key);
+		if (iter != AmiiboDataPrivate::amiiboCache.end()) {
+			// Cache hit.
+			return &iter->second;
+		}
+	}
+
+	// Cache miss. Run the full lookup cascade.
+	// NOTE: Not holding the mutex here; the individual lookups
+	// do their own one-time initialization, and a duplicate
+	// lookup by another thread merely produces the same record.
+	AmiiboRecord_t record;
+	record.char_series = lookup_char_series_name(char_id);
+	record.char_name = lookup_char_name(char_id);
+	record.amiibo_series = lookup_amiibo_series_name(amiibo_id);
+	record.amiibo_name = lookup_amiibo_series_data(amiibo_id,
+		&record.release_no, &record.wave_no);
+	if (!record.amiibo_name) {
+		record.release_no = 0;
+		record.wave_no = 0;
+	}
+
+	// Store the record. If another thread inserted it first,
+	// its copy is used; the contents are identical.
+	LibRpBase::MutexLocker locker(AmiiboDataPrivate::amiiboCacheMutex);
+	auto ins = AmiiboDataPrivate::amiiboCache.emplace(key, record);
+	return &ins.first->second;
+}
+
+/**
+ * Export the built-in amiibo data tables to an "amiibo-data.bin" file.
+ *
+ * The exported file can be placed in the configuration directory
+ * and edited to add new amiibo without rebuilding rom-properties.
+ *
+ * @param filename Output filename.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AmiiboData::exportBinFile(const char *filename)
+{
+	assert(filename != nullptr);
+	if (!filename) {
+		return -EINVAL;
+	}
+
+	// String table. Offset 0 is reserved for "no name".
+	string strtbl;
+	strtbl.push_back('\0');
+	unordered_map<string, uint32_t> str_offsets;
+	auto addString = [&strtbl, &str_offsets](const char *str) -> uint32_t {
+		if (!str || str[0] == '\0') {
+			// No string.
+			return 0;
+		}
+		auto iter = str_offsets.find(str);
+		if (iter != str_offsets.end()) {
+			// String is already in the table.
+			return iter->second;
+		}
+		const uint32_t offset = static_cast<uint32_t>(strtbl.size());
+		strtbl.append(str);
+		strtbl.push_back('\0');
+		str_offsets.insert(std::make_pair(string(str), offset));
+		return offset;
+	};
+
+	// Character series names.
+	vector<uint32_t> cseries;
+	cseries.reserve(ARRAY_SIZE(AmiiboDataPrivate::char_series_names));
+	for (unsigned int i = 0; i < ARRAY_SIZE(AmiiboDataPrivate::char_series_names); i++) {
+		cseries.push_back(cpu_to_le32(addString(AmiiboDataPrivate::char_series_names[i])));
+	}
+
+	// Characters and variants.
+	vector<AmiiboDataPrivate::bin_char_t> chars;
+	vector<AmiiboDataPrivate::bin_char_variant_t> cvars;
+	chars.reserve(ARRAY_SIZE(AmiiboDataPrivate::char_ids));
+	for (unsigned int i = 0; i < ARRAY_SIZE(AmiiboDataPrivate::char_ids); i++) {
+		const AmiiboDataPrivate::char_id_t *const src = &AmiiboDataPrivate::char_ids[i];
+		AmiiboDataPrivate::bin_char_t bin_char;
+		bin_char.char_id = cpu_to_le16(src->char_id);
+		bin_char.variants_size = src->variants_size;
+		bin_char.reserved = 0;
+		bin_char.name = cpu_to_le32(addString(src->name));
+		bin_char.variants = 0;
+		if (src->variants && src->variants_size > 0) {
+			bin_char.variants = cpu_to_le32(static_cast<uint32_t>(cvars.size()));
+			for (unsigned int v = 0; v < src->variants_size; v++) {
+				AmiiboDataPrivate::bin_char_variant_t bin_var;
+				bin_var.variant_id = src->variants[v].variant_id;
+				bin_var.reserved[0] = 0;
+				bin_var.reserved[1] = 0;
+				bin_var.reserved[2] = 0;
+				bin_var.name = cpu_to_le32(addString(src->variants[v].name));
+				cvars.push_back(bin_var);
+			}
+		}
+		chars.push_back(bin_char);
+	}
+
+	// amiibo series names.
+	vector<uint32_t> aseries;
+	aseries.reserve(ARRAY_SIZE(AmiiboDataPrivate::amiibo_series_names));
+	for (unsigned int i = 0; i < ARRAY_SIZE(AmiiboDataPrivate::amiibo_series_names); i++) {
+		aseries.push_back(cpu_to_le32(addString(AmiiboDataPrivate::amiibo_series_names[i])));
+	}
+
+	// amiibo IDs.
+	vector<AmiiboDataPrivate::bin_amiibo_t> amiibos;
+	amiibos.reserve(ARRAY_SIZE(AmiiboDataPrivate::amiibo_ids));
+	for (unsigned int i = 0; i < ARRAY_SIZE(AmiiboDataPrivate::amiibo_ids); i++) {
+		const AmiiboDataPrivate::amiibo_id_t *const src = &AmiiboDataPrivate::amiibo_ids[i];
+		AmiiboDataPrivate::bin_amiibo_t bin_amiibo;
+		bin_amiibo.release_no = cpu_to_le16(src->release_no);
+		bin_amiibo.wave_no = src->wave_no;
+		bin_amiibo.reserved = 0;
+		bin_amiibo.name = cpu_to_le32(addString(src->name));
+		amiibos.push_back(bin_amiibo);
+	}
+
+	// Build the header. Sections are written in order
+	// immediately after the header.
+	AmiiboDataPrivate::AmiiboBinHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, AMIIBO_BIN_MAGIC, sizeof(header.magic));
+	header.version = cpu_to_le32(AMIIBO_BIN_VERSION);
+	uint32_t offset = static_cast<uint32_t>(sizeof(header));
+	header.cseries_offset = cpu_to_le32(offset);
+	header.cseries_count = cpu_to_le32(static_cast<uint32_t>(cseries.size()));
+	offset += static_cast<uint32_t>(cseries.size() * sizeof(uint32_t));
+	header.char_offset = cpu_to_le32(offset);
+	header.char_count = cpu_to_le32(static_cast<uint32_t>(chars.size()));
+	offset += static_cast<uint32_t>(chars.size() * sizeof(AmiiboDataPrivate::bin_char_t));
+	header.cvar_offset = cpu_to_le32(offset);
+	header.cvar_count = cpu_to_le32(static_cast<uint32_t>(cvars.size()));
+	offset += static_cast<uint32_t>(cvars.size() * sizeof(AmiiboDataPrivate::bin_char_variant_t));
+	header.aseries_offset = cpu_to_le32(offset);
+	header.aseries_count = cpu_to_le32(static_cast<uint32_t>(aseries.size()));
+	offset += static_cast<uint32_t>(aseries.size() * sizeof(uint32_t));
+	header.amiibo_offset = cpu_to_le32(offset);
+	header.amiibo_count = cpu_to_le32(static_cast<uint32_t>(amiibos.size()));
+	offset += static_cast<uint32_t>(amiibos.size() * sizeof(AmiiboDataPrivate::bin_amiibo_t));
+	header.strtbl_offset = cpu_to_le32(offset);
+	header.strtbl_len = cpu_to_le32(static_cast<uint32_t>(strtbl.size()));
+
+	// Write the file.
+	RpFile *const file = new RpFile(filename, RpFile::FM_CREATE_WRITE);
+	if (!file->isOpen()) {
+		const int err = -file->lastError();
+		file->unref();
+		return (err != 0 ? err : -EIO);
+	}
+
+	bool ok = (file->write(&header, sizeof(header)) == sizeof(header));
+	ok = ok && (file->write(cseries.data(), cseries.size() * sizeof(uint32_t)) ==
+		cseries.size() * sizeof(uint32_t));
+	ok = ok && (file->write(chars.data(), chars.size() * sizeof(AmiiboDataPrivate::bin_char_t)) ==
+		chars.size() * sizeof(AmiiboDataPrivate::bin_char_t));
+	if (!cvars.empty()) {
+		ok = ok && (file->write(cvars.data(), cvars.size() * sizeof(AmiiboDataPrivate::bin_char_variant_t)) ==
+			cvars.size() * sizeof(AmiiboDataPrivate::bin_char_variant_t));
+	}
+	ok = ok && (file->write(aseries.data(), aseries.size() * sizeof(uint32_t)) ==
+		aseries.size() * sizeof(uint32_t));
+	ok = ok && (file->write(amiibos.data(), amiibos.size() * sizeof(AmiiboDataPrivate::bin_amiibo_t)) ==
+		amiibos.size() * sizeof(AmiiboDataPrivate::bin_amiibo_t));
+	ok = ok && (file->write(strtbl.data(), strtbl.size()) == strtbl.size());
+
+	int ret = 0;
+	if (!ok) {
+		ret = -file->lastError();
+		if (ret == 0) {
+			ret = -EIO;
+		}
+	}
+	file->unref();
+	return ret;
+}
+
 }
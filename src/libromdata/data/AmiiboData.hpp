@@ -55,6 +55,43 @@ class AmiiboData
 		 * @return amiibo series name, or nullptr if not found.
 		 */
 		static const char *lookup_amiibo_series_data(uint32_t amiibo_id, int *pReleaseNo, int *pWaveNo);
+
+		// Composite amiibo identification record.
+		// All strings point into the data tables and
+		// remain valid for the lifetime of the process.
+		struct AmiiboRecord_t {
+			const char *char_series;	// Character series name, or nullptr.
+			const char *char_name;		// Character (variant) name, or nullptr.
+			const char *amiibo_series;	// amiibo series name, or nullptr.
+			const char *amiibo_name;	// amiibo name, or nullptr.
+			int release_no;			// Release number within series. (0 for no ordering)
+			int wave_no;			// Wave number within series. (0 if unknown)
+		};
+
+		/**
+		 * Look up the complete identification record for an amiibo.
+		 *
+		 * The result is memoized per (char_id, amiibo_id) pair, so
+		 * repeated dumps of the same figure within one process
+		 * resolve in a single cache probe instead of the full
+		 * lookup cascade.
+		 *
+		 * @param char_id	[in] Character ID. (Page 21) [must be host-endian]
+		 * @param amiibo_id	[in] amiibo ID. (Page 22) [must be host-endian]
+		 * @return Amiibo record. (never nullptr; fields are nullptr/0 if not found)
+		 */
+		static const AmiiboRecord_t *lookup_amiibo(uint32_t char_id, uint32_t amiibo_id);
+
+		/**
+		 * Export the built-in amiibo data tables to an "amiibo-data.bin" file.
+		 *
+		 * The exported file can be placed in the configuration directory
+		 * and edited to add new amiibo without rebuilding rom-properties.
+		 *
+		 * @param filename Output filename.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		static int exportBinFile(const char *filename);
 };
 
 }
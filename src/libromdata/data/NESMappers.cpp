@@ -10,6 +10,9 @@
 #include "stdafx.h"
 #include "NESMappers.hpp"
 
+// One-time initialization.
+#include "librpthreads/pthread_once.h"
+
 namespace LibRomData {
 
 /**
@@ -93,6 +96,22 @@ class NESMappersPrivate
 		};
 		static const SubmapperEntry submappers[];
 
+		// Dense index of submappers[] for mappers 0-255.
+		// Value is the index into submappers[], or 0xFF if the
+		// mapper has no submapper table. Built once on first use
+		// so the sorted submappers[] table stays the single
+		// source of truth.
+		static uint8_t submapper_idx_plane0[256];
+
+		// One-time initialization variable and functions.
+		static pthread_once_t once_control;
+
+		/**
+		 * Build the dense submapper index.
+		 * Called by pthread_once().
+		 */
+		static void initSubmapperIndex(void);
+
 		/**
 		 * bsearch() comparison function for SubmapperInfo.
 		 * @param a
@@ -858,6 +877,27 @@ const NESMappersPrivate::SubmapperEntry NESMappersPrivate::submappers[] = {
 	{0, 0, nullptr}
 };
 
+// Dense index of submappers[] for mappers 0-255.
+uint8_t NESMappersPrivate::submapper_idx_plane0[256];
+
+// pthread_once() control variable.
+pthread_once_t NESMappersPrivate::once_control = PTHREAD_ONCE_INIT;
+
+/**
+ * Build the dense submapper index.
+ * Called by pthread_once().
+ */
+void NESMappersPrivate::initSubmapperIndex(void)
+{
+	memset(submapper_idx_plane0, 0xFF, sizeof(submapper_idx_plane0));
+	// NOTE: submappers[] ends with a {0, 0, nullptr} terminator.
+	for (unsigned int i = 0; i < ARRAY_SIZE(submappers)-1; i++) {
+		if (submappers[i].mapper < 256) {
+			submapper_idx_plane0[submappers[i].mapper] = static_cast<uint8_t>(i);
+		}
+	}
+}
+
 /**
  * bsearch() comparison function for SubmapperInfo.
  * @param a
@@ -975,14 +1015,23 @@ const char *NESMappers::lookup_nes2_submapper(int mapper, int submapper)
 		return nullptr;
 	}
 
-	// Do a binary search in submappers[].
-	const NESMappersPrivate::SubmapperEntry key = { static_cast<uint16_t>(mapper), 0, nullptr };
-	const NESMappersPrivate::SubmapperEntry *res =
-		static_cast<const NESMappersPrivate::SubmapperEntry*>(bsearch(&key,
+	const NESMappersPrivate::SubmapperEntry *res;
+	if (mapper < 256) {
+		// NES 2.0 Plane 0 [000-255] (iNES 1.0)
+		// Use the dense submapper index.
+		pthread_once(&NESMappersPrivate::once_control,
+			NESMappersPrivate::initSubmapperIndex);
+		const uint8_t idx = NESMappersPrivate::submapper_idx_plane0[mapper];
+		res = (idx != 0xFF ? &NESMappersPrivate::submappers[idx] : nullptr);
+	} else {
+		// Do a binary search in submappers[].
+		const NESMappersPrivate::SubmapperEntry key = { static_cast<uint16_t>(mapper), 0, nullptr };
+		res = static_cast<const NESMappersPrivate::SubmapperEntry*>(bsearch(&key,
 			NESMappersPrivate::submappers,
 			ARRAY_SIZE(NESMappersPrivate::submappers)-1,
 			sizeof(NESMappersPrivate::SubmapperEntry),
 			NESMappersPrivate::SubmapperEntry_compar));
+	}
 	if (!res || !res->info || res->info_size == 0)
 		return nullptr;
 
@@ -8,6 +8,13 @@
 
 #include "stdafx.h"
 #include "Nintendo3DSSysTitles.hpp"
+#include "SortedTableLookup.hpp"
+
+// One-time initialization.
+#include "librpthreads/pthread_once.h"
+
+// C++ STL classes.
+using std::vector;
 
 namespace LibRomData {
 
@@ -41,6 +48,27 @@ class Nintendo3DSSysTitlesPrivate
 		static const SysTitle sys_title_00040030[];	// System applets.
 
 		//static const SysTitleGroup sys_title_group[];	// All SysTitle[] arrays.
+
+	public:
+		// Flattened lookup index, sorted by key for binary search.
+		// Built once on first use, since the source tables above
+		// are organized by title, not by tid_lo.
+		struct FlatEntry {
+			uint64_t key;		// (group << 32) | tid_lo
+						// group: 0 == 00040010, 1 == 00040030
+			uint8_t region;		// Index into regions[].
+			uint16_t title;		// Index into the group's SysTitle[] array.
+		};
+		static vector<FlatEntry> flatIndex;
+
+		// One-time initialization variable and functions.
+		static pthread_once_t once_control;
+
+		/**
+		 * Build the flattened lookup index.
+		 * Called by pthread_once().
+		 */
+		static void initFlatIndex(void);
 };
 
 /** Nintendo3DSSysTitlesPrivate **/
@@ -106,6 +134,50 @@ const Nintendo3DSSysTitlesPrivate::SysTitle Nintendo3DSSysTitlesPrivate::sys_tit
 	{{0x2000C003, 0x2000C803, 0x2000D003,          0, 0x2000DE03,          0}, NOP_C_("Nintendo3DSSysTitles", "Software Keyboard (SAFE_MODE)")},
 };
 
+// Flattened lookup index.
+vector<Nintendo3DSSysTitlesPrivate::FlatEntry> Nintendo3DSSysTitlesPrivate::flatIndex;
+
+// pthread_once() control variable.
+pthread_once_t Nintendo3DSSysTitlesPrivate::once_control = PTHREAD_ONCE_INIT;
+
+/**
+ * Build the flattened lookup index.
+ * Called by pthread_once().
+ */
+void Nintendo3DSSysTitlesPrivate::initFlatIndex(void)
+{
+	struct GroupInfo {
+		const SysTitle *titles;
+		uint16_t title_count;
+	};
+	static const GroupInfo groups[2] = {
+		{sys_title_00040010, ARRAY_SIZE(sys_title_00040010)},
+		{sys_title_00040030, ARRAY_SIZE(sys_title_00040030)},
+	};
+
+	flatIndex.reserve((ARRAY_SIZE(sys_title_00040010) +
+			   ARRAY_SIZE(sys_title_00040030)) * 6);
+	for (uint8_t group = 0; group < ARRAY_SIZE(groups); group++) {
+		const SysTitle *title = groups[group].titles;
+		for (uint16_t i = 0; i < groups[group].title_count; i++, title++) {
+			for (uint8_t region = 0; region < 6; region++) {
+				if (title->tid_lo[region] == 0)
+					continue;
+				const FlatEntry entry = {
+					(static_cast<uint64_t>(group) << 32) | title->tid_lo[region],
+					region, i};
+				flatIndex.push_back(entry);
+			}
+		}
+	}
+
+	// Sort by key for binary search.
+	std::sort(flatIndex.begin(), flatIndex.end(),
+		[](const FlatEntry &a, const FlatEntry &b) {
+			return (a.key < b.key);
+		});
+}
+
 /** Nintendo3DSSysTitles **/
 
 /**
@@ -118,7 +190,7 @@ const Nintendo3DSSysTitlesPrivate::SysTitle Nintendo3DSSysTitlesPrivate::sys_tit
 const char *Nintendo3DSSysTitles::lookup_sys_title(uint32_t tid_hi, uint32_t tid_lo, const char **pRegion)
 {
 	const Nintendo3DSSysTitlesPrivate::SysTitle *titles;
-	int title_count;
+	uint8_t group;
 
 	if (tid_hi == 0 || tid_lo == 0 ||
 	    tid_hi == 0xFFFFFFFF || tid_lo == 0xFFFFFFFF)
@@ -132,10 +204,10 @@ const char *Nintendo3DSSysTitles::lookup_sys_title(uint32_t tid_hi, uint32_t tid
 
 	if (tid_hi == 0x00040010) {
 		titles = Nintendo3DSSysTitlesPrivate::sys_title_00040010;
-		title_count = ARRAY_SIZE(Nintendo3DSSysTitlesPrivate::sys_title_00040010);
+		group = 0;
 	} else if (tid_hi == 0x00040030) {
 		titles = Nintendo3DSSysTitlesPrivate::sys_title_00040030;
-		title_count = ARRAY_SIZE(Nintendo3DSSysTitlesPrivate::sys_title_00040030);
+		group = 1;
 	} else {
 		// tid_hi not supported.
 		if (pRegion) {
@@ -144,20 +216,29 @@ const char *Nintendo3DSSysTitles::lookup_sys_title(uint32_t tid_hi, uint32_t tid
 		return nullptr;
 	}
 
-	// TODO: bsearch()?
-	for (; title_count > 0; title_count--, titles++) {
-		for (unsigned int region = 0; region < 6; region++) {
-			if (titles->tid_lo[region] != 0 && titles->tid_lo[region] == tid_lo) {
-				// Found a match!
-				if (pRegion) {
-					*pRegion = Nintendo3DSSysTitlesPrivate::regions[region];
-				}
-				return dpgettext_expr(RP_I18N_DOMAIN, "Nintendo3DSSysTitles", titles->desc);
-			}
+	// Make sure the flattened lookup index has been built.
+	pthread_once(&Nintendo3DSSysTitlesPrivate::once_control,
+		Nintendo3DSSysTitlesPrivate::initFlatIndex);
+
+	// Do a binary search.
+	typedef Nintendo3DSSysTitlesPrivate::FlatEntry FlatEntry;
+	const uint64_t key = (static_cast<uint64_t>(group) << 32) | tid_lo;
+	const FlatEntry *res =
+		SortedTableLookup::lookup<FlatEntry, uint64_t, &FlatEntry::key>(
+			Nintendo3DSSysTitlesPrivate::flatIndex.data(),
+			Nintendo3DSSysTitlesPrivate::flatIndex.size(), key);
+	if (res) {
+		// Found a match!
+		if (pRegion) {
+			*pRegion = Nintendo3DSSysTitlesPrivate::regions[res->region];
 		}
+		return dpgettext_expr(RP_I18N_DOMAIN, "Nintendo3DSSysTitles", titles[res->title].desc);
 	}
 
 	// Not found.
+	if (pRegion) {
+		*pRegion = nullptr;
+	}
 	return nullptr;
 }
 
@@ -0,0 +1,57 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * SortedTableLookup.hpp: Binary search helpers for sorted data tables.    *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DATA_SORTEDTABLELOOKUP_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_DATA_SORTEDTABLELOOKUP_HPP__
+
+#include "common.h"
+
+// C includes. (C++ namespace)
+#include <cstddef>
+
+namespace LibRomData { namespace SortedTableLookup {
+
+/**
+ * Binary search over a static data table sorted by a single key field.
+ *
+ * This replaces the per-table bsearch() comparison functions for the
+ * common case of an integer key in the first field of each record.
+ *
+ * @tparam Entry	Table entry type.
+ * @tparam Key		Key type. (integer)
+ * @tparam KeyField	Pointer to the key member of Entry.
+ *
+ * @param table	[in] Table, sorted by KeyField in ascending order.
+ * @param count	[in] Number of entries in table. (Not counting any terminator.)
+ * @param key	[in] Key to search for.
+ * @return Matching entry, or nullptr if not found.
+ */
+template<typename Entry, typename Key, Key Entry::*KeyField>
+const Entry *lookup(const Entry *table, size_t count, Key key)
+{
+	size_t lo = 0, hi = count;
+	while (lo < hi) {
+		const size_t mid = lo + ((hi - lo) / 2);
+		const Key mid_key = table[mid].*KeyField;
+		if (mid_key < key) {
+			lo = mid + 1;
+		} else if (key < mid_key) {
+			hi = mid;
+		} else {
+			// Found the key.
+			return &table[mid];
+		}
+	}
+
+	// Key not found.
+	return nullptr;
+}
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DATA_SORTEDTABLELOOKUP_HPP__ */
@@ -8,6 +8,7 @@
 
 #include "stdafx.h"
 #include "WiiUData.hpp"
+#include "SortedTableLookup.hpp"
 
 namespace LibRomData {
 
@@ -41,14 +42,6 @@ class WiiUDataPrivate {
 		 * Reference: https://www.gametdb.com/WiiU/List
 		 */
 		static const WiiUDiscPublisher disc_publishers_region[];
-
-		/**
-		 * Comparison function for bsearch().
-		 * @param a
-		 * @param b
-		 * @return
-		 */
-		static int RP_C_API compar(const void *a, const void *b);
 };
 
 /** WiiUDataPrivate **/
@@ -313,21 +306,6 @@ const WiiUDataPrivate::WiiUDiscPublisher WiiUDataPrivate::disc_publishers_region
 	{0, 0}
 };
 
-/**
- * Comparison function for bsearch().
- * @param a
- * @param b
- * @return
- */
-int RP_C_API WiiUDataPrivate::compar(const void *a, const void *b)
-{
-	unsigned int id4_1 = static_cast<const WiiUDiscPublisher*>(a)->id4;
-	unsigned int id4_2 = static_cast<const WiiUDiscPublisher*>(b)->id4;
-	if (id4_1 < id4_2) return -1;
-	if (id4_1 > id4_2) return 1;
-	return 0;
-}
-
 /** WiiUData **/
 
 /**
@@ -342,35 +320,31 @@ int RP_C_API WiiUDataPrivate::compar(const void *a, const void *b)
  */
 uint32_t WiiUData::lookup_disc_publisher(const char *id4)
 {
+	typedef WiiUDataPrivate::WiiUDiscPublisher WiiUDiscPublisher;
+
 	// Check the region-independent list first.
-	WiiUDataPrivate::WiiUDiscPublisher key;
-	key.id4 = (static_cast<uint8_t>(id4[0]) << 24) |
-		  (static_cast<uint8_t>(id4[1]) << 16) |
-		  (static_cast<uint8_t>(id4[2]) << 8) | 'x';
-	key.publisher = 0;
+	uint32_t key = (static_cast<uint8_t>(id4[0]) << 24) |
+		       (static_cast<uint8_t>(id4[1]) << 16) |
+		       (static_cast<uint8_t>(id4[2]) << 8) | 'x';
 
 	// Do a binary search.
-	const WiiUDataPrivate::WiiUDiscPublisher *res =
-		static_cast<const WiiUDataPrivate::WiiUDiscPublisher*>(bsearch(&key,
+	const WiiUDiscPublisher *res =
+		SortedTableLookup::lookup<WiiUDiscPublisher, uint32_t, &WiiUDiscPublisher::id4>(
 			WiiUDataPrivate::disc_publishers_noregion,
-			ARRAY_SIZE(WiiUDataPrivate::disc_publishers_noregion)-1,
-			sizeof(WiiUDataPrivate::WiiUDiscPublisher),
-			WiiUDataPrivate::compar));
+			ARRAY_SIZE(WiiUDataPrivate::disc_publishers_noregion)-1, key);
 	if (res) {
 		// Found a publisher in the region-independent list.
 		return res->publisher;
 	}
 
 	// Check the region-specific list.
-	key.id4 &= ~0xFF;
-	key.id4 |= static_cast<uint8_t>(id4[3]);
+	key &= ~0xFF;
+	key |= static_cast<uint8_t>(id4[3]);
 
 	// Do a binary search.
-	res = static_cast<const WiiUDataPrivate::WiiUDiscPublisher*>(bsearch(&key,
+	res = SortedTableLookup::lookup<WiiUDiscPublisher, uint32_t, &WiiUDiscPublisher::id4>(
 			WiiUDataPrivate::disc_publishers_region,
-			ARRAY_SIZE(WiiUDataPrivate::disc_publishers_region)-1,
-			sizeof(WiiUDataPrivate::WiiUDiscPublisher),
-			WiiUDataPrivate::compar));
+			ARRAY_SIZE(WiiUDataPrivate::disc_publishers_region)-1, key);
 
 	return (res ? res->publisher : 0);
 }
@@ -21,6 +21,9 @@
 using namespace LibRpBase;
 using LibRpFile::IRpFile;
 
+// C++ STL classes.
+using std::unique_ptr;
+
 namespace LibRomData {
 
 class Cdrom2352ReaderPrivate : public SparseDiscReaderPrivate {
@@ -145,4 +148,68 @@ off64_t Cdrom2352Reader::getPhysBlockAddr(uint32_t blockIdx) const
 	return (static_cast<off64_t>(blockIdx) * d->physBlockSize) + 16;
 }
 
+/**
+ * Read consecutive full blocks.
+ *
+ * Batches of raw 2352-byte sectors are read and the user
+ * data is extracted afterwards, instead of issuing one
+ * underlying read per 2048-byte block.
+ *
+ * @param blockIdx	[in] Starting block index.
+ * @param blockCount	[in] Number of blocks to read.
+ * @param ptr		[out] Output data buffer. (blockCount * block_size bytes)
+ * @return Number of bytes read, or -1 if the block index is invalid.
+ */
+int Cdrom2352Reader::readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr)
+{
+	// Maximum number of raw sectors to read at once.
+	// (64 sectors == 147 KB raw buffer)
+	static const uint32_t RAW_SECTOR_BATCH = 64;
+
+	// Make sure the block range is valid.
+	RP_D(Cdrom2352Reader);
+	assert(blockIdx < d->blockCount);
+	assert(blockIdx + blockCount <= d->blockCount);
+	if (blockIdx >= d->blockCount || blockIdx + blockCount > d->blockCount) {
+		// Out of range.
+		return -1;
+	}
+
+	if (unlikely(blockCount == 0)) {
+		// Nothing to read.
+		return 0;
+	}
+
+	// Read batches of raw sectors, then extract the user data.
+	// FIXME: Currently only supports Mode 1. (user data at byte 16)
+	unique_ptr<uint8_t[]> rawbuf(new uint8_t[RAW_SECTOR_BATCH * 2352]);
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	off64_t phys_pos = static_cast<off64_t>(blockIdx) * d->physBlockSize;
+	int ret = 0;
+
+	while (blockCount > 0) {
+		const uint32_t batch = (blockCount < RAW_SECTOR_BATCH ? blockCount : RAW_SECTOR_BATCH);
+		const size_t raw_sz = static_cast<size_t>(batch) * 2352;
+		size_t sz_read = m_file->seekAndRead(phys_pos, rawbuf.get(), raw_sz);
+		m_lastError = m_file->lastError();
+
+		// Extract the user data from each complete raw sector.
+		const uint32_t sectors_read = static_cast<uint32_t>(sz_read / 2352);
+		const uint8_t *src = rawbuf.get() + 16;
+		for (uint32_t i = 0; i < sectors_read; i++, src += 2352, ptr8 += 2048) {
+			memcpy(ptr8, src, 2048);
+		}
+		ret += static_cast<int>(sectors_read) * 2048;
+
+		if (sz_read != raw_sz) {
+			// Short read.
+			return (ret > 0 ? ret : -1);
+		}
+		blockCount -= batch;
+		phys_pos += raw_sz;
+	}
+
+	return ret;
+}
+
 }
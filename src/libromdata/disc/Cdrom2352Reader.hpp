@@ -60,6 +60,20 @@ class Cdrom2352Reader : public LibRpBase::SparseDiscReader
 		 * @return Physical address. (0 == empty block; -1 == invalid block index)
 		 */
 		off64_t getPhysBlockAddr(uint32_t blockIdx) const final;
+
+		/**
+		 * Read consecutive full blocks.
+		 *
+		 * Batches of raw 2352-byte sectors are read and the user
+		 * data is extracted afterwards, instead of issuing one
+		 * underlying read per 2048-byte block.
+		 *
+		 * @param blockIdx	[in] Starting block index.
+		 * @param blockCount	[in] Number of blocks to read.
+		 * @param ptr		[out] Output data buffer. (blockCount * block_size bytes)
+		 * @return Number of bytes read, or -1 if the block index is invalid.
+		 */
+		int readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr) final;
 };
 
 }
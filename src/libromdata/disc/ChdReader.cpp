@@ -0,0 +1,876 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * ChdReader.cpp: MAME CHD (Compressed Hunks of Data) disc image reader.   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// References:
+// - https://github.com/mamedev/mame/blob/master/src/lib/util/chd.cpp
+// - https://github.com/rtissera/libchdr/blob/master/src/libchdr_chd.c
+
+#include "stdafx.h"
+#include "ChdReader.hpp"
+#include "librpbase/disc/SparseDiscReader_p.hpp"
+#include "chd_structs.h"
+
+// librpthreads
+#include "librpthreads/ThreadPool.hpp"
+
+// librpbase, librpfile
+using namespace LibRpBase;
+using LibRpFile::IRpFile;
+
+// C++ STL classes.
+using std::unique_ptr;
+using std::vector;
+
+// zlib
+#include <zlib.h>
+#ifdef _MSC_VER
+// MSVC: Exception handling for /DELAYLOAD.
+# include "libwin32common/DelayLoadHelper.h"
+#endif /* _MSC_VER */
+
+namespace LibRomData {
+
+#if defined(_MSC_VER) && defined(ZLIB_IS_DLL)
+// DelayLoad test implementation.
+DELAYLOAD_TEST_FUNCTION_IMPL0(zlibVersion);
+#endif /* defined(_MSC_VER) && defined(ZLIB_IS_DLL) */
+
+class ChdReaderPrivate : public SparseDiscReaderPrivate {
+	public:
+		ChdReaderPrivate(ChdReader *q);
+
+	private:
+		typedef SparseDiscReaderPrivate super;
+		RP_DISABLE_COPY(ChdReaderPrivate)
+
+	public:
+		// CHD version. (3, 4, or 5)
+		unsigned int chdVersion;
+
+		// Hunk parameters.
+		unsigned int hunkBytes;		// Number of bytes per hunk.
+		unsigned int hunkCount;		// Total number of hunks.
+
+		// v3/v4: Is the primary codec zlib?
+		// (If false, hunks are stored uncompressed.)
+		bool isZlib;
+
+		// Parsed v3/v4 hunk map entry.
+		struct V34MapEntry {
+			uint64_t offset;	// File offset, pattern, or hunk index.
+			uint32_t length;	// Stored length.
+			uint8_t type;		// Entry type. (CHD_V34_MapType_e)
+		};
+		vector<V34MapEntry> v34map;
+
+		// v5 uncompressed hunk map.
+		// Values are file offsets divided by the hunk size.
+		// Special value: 0 == unallocated hunk.
+		ao::uvector<uint32_t> v5map;
+
+		// CD-ROM/GD-ROM mode.
+		// If true, blocks are 2048-byte cooked sectors extracted
+		// from the raw 2448-byte CD frames stored in the hunks.
+		bool cdMode;
+		unsigned int framesPerHunk;	// CD frames per hunk.
+
+		// Last materialized hunk. (CD mode)
+		// Cooked sector reads within the same hunk are served
+		// from this buffer without re-reading the hunk.
+		uint32_t curHunk;
+		ao::uvector<uint8_t> hunkBuf;
+
+		/**
+		 * Decompress a zlib (raw deflate) hunk.
+		 * @param z_buf		[in] Compressed data.
+		 * @param z_size	[in] Compressed size.
+		 * @param buf		[out] Output buffer. (hunkBytes)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int inflateHunk(const uint8_t *z_buf, size_t z_size, uint8_t *buf) const;
+
+		/**
+		 * Read and decompress a full hunk.
+		 * @param hunkIdx	[in] Hunk index.
+		 * @param buf		[out] Output buffer. (hunkBytes)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int readHunk(uint32_t hunkIdx, uint8_t *buf);
+
+		/**
+		 * Does the metadata list contain a CD-ROM or GD-ROM track entry?
+		 * @param metaoffset File offset of the first metadata entry.
+		 * @return True if CD-ROM or GD-ROM metadata is present.
+		 */
+		bool hasCdMetadata(uint64_t metaoffset);
+};
+
+/** ChdReaderPrivate **/
+
+ChdReaderPrivate::ChdReaderPrivate(ChdReader *q)
+	: super(q)
+	, chdVersion(0)
+	, hunkBytes(0)
+	, hunkCount(0)
+	, isZlib(false)
+	, cdMode(false)
+	, framesPerHunk(0)
+	, curHunk(~0U)
+{ }
+
+/**
+ * Decompress a zlib (raw deflate) hunk.
+ * @param z_buf		[in] Compressed data.
+ * @param z_size	[in] Compressed size.
+ * @param buf		[out] Output buffer. (hunkBytes)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int ChdReaderPrivate::inflateHunk(const uint8_t *z_buf, size_t z_size, uint8_t *buf) const
+{
+	// Initialize zlib.
+	// NOTE: CHD uses raw deflate, so we need to specify -15.
+	z_stream strm;
+	strm.zalloc = Z_NULL;
+	strm.zfree = Z_NULL;
+	strm.opaque = Z_NULL;
+	strm.avail_in = 0;
+	strm.next_in = Z_NULL;
+	int ret = inflateInit2(&strm, -15);
+	if (ret != Z_OK) {
+		// Error initializing zlib.
+		return -ENOMEM;
+	}
+
+	strm.avail_in = static_cast<uInt>(z_size);
+	strm.next_in = const_cast<Bytef*>(z_buf);
+	strm.avail_out = static_cast<uInt>(hunkBytes);
+	strm.next_out = buf;
+
+	ret = inflate(&strm, Z_FINISH);
+	const uInt avail_out = strm.avail_out;
+	inflateEnd(&strm);
+	if ((ret != Z_OK && ret != Z_STREAM_END) || avail_out != 0) {
+		// Error decompressing.
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/**
+ * Read and decompress a full hunk.
+ * @param hunkIdx	[in] Hunk index.
+ * @param buf		[out] Output buffer. (hunkBytes)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int ChdReaderPrivate::readHunk(uint32_t hunkIdx, uint8_t *buf)
+{
+	assert(hunkIdx < hunkCount);
+	if (hunkIdx >= hunkCount) {
+		// Out of range.
+		return -EINVAL;
+	}
+
+	RP_Q(ChdReader);
+	if (chdVersion == 5) {
+		// v5 uncompressed map.
+		const uint32_t entry = v5map[hunkIdx];
+		if (entry == 0) {
+			// Unallocated hunk.
+			memset(buf, 0, hunkBytes);
+			return 0;
+		}
+
+		const off64_t physAddr = static_cast<off64_t>(entry) * hunkBytes;
+		const size_t sz_read = q->m_file->seekAndRead(physAddr, buf, hunkBytes);
+		return (sz_read == hunkBytes ? 0 : -EIO);
+	}
+
+	// v3/v4 hunk map.
+	const V34MapEntry &entry = v34map[hunkIdx];
+	switch (entry.type) {
+		case CHD_V34_MAP_TYPE_COMPRESSED: {
+			// zlib-compressed hunk.
+			unique_ptr<uint8_t[]> z_buf(new uint8_t[entry.length]);
+			const size_t sz_read = q->m_file->seekAndRead(entry.offset, z_buf.get(), entry.length);
+			if (sz_read != entry.length) {
+				// Error reading the compressed data.
+				return -EIO;
+			}
+			return inflateHunk(z_buf.get(), entry.length, buf);
+		}
+
+		case CHD_V34_MAP_TYPE_UNCOMPRESSED: {
+			// Uncompressed hunk.
+			const size_t sz_read = q->m_file->seekAndRead(entry.offset, buf, hunkBytes);
+			return (sz_read == hunkBytes ? 0 : -EIO);
+		}
+
+		case CHD_V34_MAP_TYPE_MINI: {
+			// The offset field is an 8-byte big-endian repeating pattern.
+			uint64_t pattern = cpu_to_be64(entry.offset);
+			memcpy(buf, &pattern, sizeof(pattern));
+			for (unsigned int i = 8; i < hunkBytes; i <<= 1) {
+				const unsigned int sz_copy =
+					(i <= hunkBytes - i ? i : hunkBytes - i);
+				memcpy(&buf[i], buf, sz_copy);
+			}
+			return 0;
+		}
+
+		case CHD_V34_MAP_TYPE_SELF_HUNK:
+			// The offset field is an earlier hunk index.
+			// It must actually be earlier: a self- or
+			// forward-reference in a crafted image would
+			// cause unbounded recursion.
+			if (entry.offset >= hunkIdx) {
+				return -EIO;
+			}
+			return readHunk(static_cast<uint32_t>(entry.offset), buf);
+
+		default:
+			// Invalid or unsupported entry type.
+			// (Parent CHDs are rejected in the constructor.)
+			return -EIO;
+	}
+}
+
+/**
+ * Does the metadata list contain a CD-ROM or GD-ROM track entry?
+ * @param metaoffset File offset of the first metadata entry.
+ * @return True if CD-ROM or GD-ROM metadata is present.
+ */
+bool ChdReaderPrivate::hasCdMetadata(uint64_t metaoffset)
+{
+	// Walk the metadata linked list.
+	// Limit the number of entries in case the list is corrupted.
+	RP_Q(ChdReader);
+	unsigned int count = 0;
+	for (uint64_t offset = metaoffset; offset != 0 && count < 64; count++) {
+		CHD_MetadataHeader metaHeader;
+		size_t sz_read = q->m_file->seekAndRead(offset, &metaHeader, sizeof(metaHeader));
+		if (sz_read != sizeof(metaHeader)) {
+			// Error reading the metadata header.
+			break;
+		}
+
+		switch (be32_to_cpu(metaHeader.metatag)) {
+			case CHD_METADATA_TAG_CDROM_OLD:
+			case CHD_METADATA_TAG_CDROM_TRACK:
+			case CHD_METADATA_TAG_CDROM_TRACK2:
+			case CHD_METADATA_TAG_GDROM_OLD:
+			case CHD_METADATA_TAG_GDROM_TRACK:
+				// Found CD-ROM or GD-ROM track metadata.
+				return true;
+			default:
+				break;
+		}
+
+		offset = be64_to_cpu(metaHeader.next);
+	}
+
+	// No CD-ROM or GD-ROM metadata found.
+	return false;
+}
+
+/** ChdReader **/
+
+ChdReader::ChdReader(IRpFile *file)
+	: super(new ChdReaderPrivate(this), file)
+{
+	if (!m_file) {
+		// File could not be ref()'d.
+		return;
+	}
+
+#if defined(_MSC_VER) && defined(ZLIB_IS_DLL)
+	// Delay load verification.
+	// TODO: Only if linked with /DELAYLOAD?
+	if (DelayLoad_test_zlibVersion() != 0) {
+		// Delay load failed.
+		// Can't decompress CHD hunks.
+		m_file->unref();
+		m_file = nullptr;
+		m_lastError = EIO;
+		return;
+	}
+#endif /* defined(_MSC_VER) && defined(ZLIB_IS_DLL) */
+
+	// Read the CHD header.
+	// The largest header version is v5. (124 bytes)
+	RP_D(ChdReader);
+	union {
+		CHD_HeaderCommon common;
+		CHD_HeaderV3 v3;
+		CHD_HeaderV4 v4;
+		CHD_HeaderV5 v5;
+	} header;
+	m_file->rewind();
+	size_t sz = m_file->read(&header, sizeof(header));
+	if (sz != sizeof(header) ||
+	    memcmp(header.common.magic, CHD_MAGIC, sizeof(header.common.magic)) != 0)
+	{
+		// Error reading the CHD header, or invalid magic.
+		m_file->unref();
+		m_file = nullptr;
+		m_lastError = EIO;
+		return;
+	}
+
+	// Parse the version-specific header.
+	uint64_t logicalbytes, metaoffset;
+	uint64_t mapoffset = 0;
+	unsigned int unitbytes = 0;
+	d->chdVersion = be32_to_cpu(header.common.version);
+	switch (d->chdVersion) {
+		case 3:
+			if (be32_to_cpu(header.v3.length) != sizeof(header.v3) ||
+			    (be32_to_cpu(header.v3.flags) & CHD_FLAGS_HAS_PARENT))
+			{
+				// Wrong header length, or the image has a
+				// parent CHD. Parents aren't supported.
+				goto notSupported;
+			}
+			switch (be32_to_cpu(header.v3.compression)) {
+				case CHD_V34_COMPRESSION_NONE:
+					d->isZlib = false;
+					break;
+				case CHD_V34_COMPRESSION_ZLIB:
+				case CHD_V34_COMPRESSION_ZLIB_PLUS:
+					d->isZlib = true;
+					break;
+				default:
+					// A/V codec isn't supported.
+					goto notSupported;
+			}
+			d->hunkBytes = be32_to_cpu(header.v3.hunkbytes);
+			d->hunkCount = be32_to_cpu(header.v3.totalhunks);
+			logicalbytes = be64_to_cpu(header.v3.logicalbytes);
+			metaoffset = be64_to_cpu(header.v3.metaoffset);
+			mapoffset = sizeof(header.v3);
+			break;
+
+		case 4:
+			if (be32_to_cpu(header.v4.length) != sizeof(header.v4) ||
+			    (be32_to_cpu(header.v4.flags) & CHD_FLAGS_HAS_PARENT))
+			{
+				// Wrong header length, or the image has a
+				// parent CHD. Parents aren't supported.
+				goto notSupported;
+			}
+			switch (be32_to_cpu(header.v4.compression)) {
+				case CHD_V34_COMPRESSION_NONE:
+					d->isZlib = false;
+					break;
+				case CHD_V34_COMPRESSION_ZLIB:
+				case CHD_V34_COMPRESSION_ZLIB_PLUS:
+					d->isZlib = true;
+					break;
+				default:
+					// A/V codec isn't supported.
+					goto notSupported;
+			}
+			d->hunkBytes = be32_to_cpu(header.v4.hunkbytes);
+			d->hunkCount = be32_to_cpu(header.v4.totalhunks);
+			logicalbytes = be64_to_cpu(header.v4.logicalbytes);
+			metaoffset = be64_to_cpu(header.v4.metaoffset);
+			mapoffset = sizeof(header.v4);
+			break;
+
+		case 5:
+			if (be32_to_cpu(header.v5.length) != sizeof(header.v5)) {
+				// Wrong header length.
+				goto notSupported;
+			}
+			if (header.v5.compressors[0] != 0) {
+				// Compressed v5 image. The hunk map itself is
+				// Huffman-compressed, and the codecs (cdzl,
+				// cdlz, cdfl, zstd, ...) aren't available.
+				goto notSupported;
+			}
+			{
+				// Parent CHDs are indicated by a nonzero parent SHA-1.
+				static const uint8_t zero_sha1[20] = { };
+				if (memcmp(header.v5.parentsha1, zero_sha1, sizeof(zero_sha1)) != 0) {
+					// Parents aren't supported.
+					goto notSupported;
+				}
+			}
+			d->hunkBytes = be32_to_cpu(header.v5.hunkbytes);
+			logicalbytes = be64_to_cpu(header.v5.logicalbytes);
+			metaoffset = be64_to_cpu(header.v5.metaoffset);
+			mapoffset = be64_to_cpu(header.v5.mapoffset);
+			unitbytes = be32_to_cpu(header.v5.unitbytes);
+			d->hunkCount = static_cast<unsigned int>(
+				(logicalbytes + d->hunkBytes - 1) / d->hunkBytes);
+			break;
+
+		default:
+			// v1/v2 images are rare and not supported.
+			goto notSupported;
+	}
+
+	// Verify the hunk parameters.
+	// NOTE: Minimum hunk size of 8 bytes: the MINI map entry
+	// fill writes an 8-byte pattern unconditionally.
+	if (d->hunkBytes < 8 || d->hunkBytes > 16U*1024*1024 ||
+	    d->hunkCount == 0 || d->hunkCount > 16U*1024*1024 ||
+	    logicalbytes == 0 ||
+	    logicalbytes > static_cast<uint64_t>(d->hunkCount) * d->hunkBytes)
+	{
+		// Hunk parameters are out of range.
+		goto notSupported;
+	}
+
+	// Read the hunk map.
+	if (d->chdVersion == 5) {
+		// v5 uncompressed map: one uint32_t per hunk.
+		d->v5map.resize(d->hunkCount);
+		const size_t sz_map = d->v5map.size() * sizeof(uint32_t);
+		sz = m_file->seekAndRead(mapoffset, d->v5map.data(), sz_map);
+		if (sz != sz_map) {
+			// Error reading the hunk map.
+			goto notSupported;
+		}
+
+		// Byteswap the map to host-endian.
+#if SYS_BYTEORDER == SYS_LIL_ENDIAN
+		for (auto iter = d->v5map.begin(); iter != d->v5map.end(); ++iter) {
+			*iter = be32_to_cpu(*iter);
+		}
+#endif /* SYS_BYTEORDER == SYS_LIL_ENDIAN */
+	} else {
+		// v3/v4 map: 16-byte entries.
+		ao::uvector<CHD_V34_MapEntry> rawmap;
+		rawmap.resize(d->hunkCount);
+		const size_t sz_map = rawmap.size() * sizeof(CHD_V34_MapEntry);
+		sz = m_file->seekAndRead(mapoffset, rawmap.data(), sz_map);
+		if (sz != sz_map) {
+			// Error reading the hunk map.
+			goto notSupported;
+		}
+
+		// Parse the map entries.
+		d->v34map.resize(d->hunkCount);
+		for (size_t i = 0; i < rawmap.size(); i++) {
+			ChdReaderPrivate::V34MapEntry &entry = d->v34map[i];
+			entry.offset = be64_to_cpu(rawmap[i].offset);
+			entry.length = be16_to_cpu(rawmap[i].length_lo) |
+				(static_cast<uint32_t>(rawmap[i].length_hi) << 16);
+			entry.type = rawmap[i].flags & CHD_V34_MAP_TYPE_MASK;
+		}
+	}
+
+	// Check for a CD-ROM or GD-ROM image.
+	// CD hunks store raw 2448-byte frames; expose cooked
+	// 2048-byte sectors so ISO-9660 parsing works.
+	if ((d->hunkBytes % CHD_CD_FRAME_SIZE == 0) &&
+	    (unitbytes == CHD_CD_FRAME_SIZE || d->hasCdMetadata(metaoffset)))
+	{
+		d->cdMode = true;
+		d->framesPerHunk = d->hunkBytes / CHD_CD_FRAME_SIZE;
+		d->hunkBuf.resize(d->hunkBytes);
+		d->block_size = 2048;
+		d->disc_size = static_cast<off64_t>(logicalbytes / CHD_CD_FRAME_SIZE) * 2048;
+	} else {
+		// Hard disk or raw image. Blocks are full hunks.
+		d->block_size = d->hunkBytes;
+		d->disc_size = static_cast<off64_t>(logicalbytes);
+	}
+
+	// Reset the disc position.
+	d->pos = 0;
+	return;
+
+notSupported:
+	// This CHD image is not supported.
+	d->v34map.clear();
+	d->v5map.clear();
+	m_file->unref();
+	m_file = nullptr;
+	m_lastError = EIO;
+}
+
+/**
+ * Is a disc image supported by this class?
+ * @param pHeader Disc image header.
+ * @param szHeader Size of header.
+ * @return Class-specific disc format ID (>= 0) if supported; -1 if not.
+ */
+int ChdReader::isDiscSupported_static(const uint8_t *pHeader, size_t szHeader)
+{
+	if (szHeader < sizeof(CHD_HeaderCommon)) {
+		// Not enough data to check.
+		return -1;
+	}
+
+	// Check the CHD magic.
+	const CHD_HeaderCommon *const chdHeader =
+		reinterpret_cast<const CHD_HeaderCommon*>(pHeader);
+	if (memcmp(chdHeader->magic, CHD_MAGIC, sizeof(chdHeader->magic)) != 0) {
+		// Invalid magic.
+		return -1;
+	}
+
+	// This is a CHD image.
+	// NOTE: Version and codec support are checked in the constructor.
+	return 0;
+}
+
+/**
+ * Is a disc image supported by this object?
+ * @param pHeader Disc image header.
+ * @param szHeader Size of header.
+ * @return Class-specific system ID (>= 0) if supported; -1 if not.
+ */
+int ChdReader::isDiscSupported(const uint8_t *pHeader, size_t szHeader) const
+{
+	return isDiscSupported_static(pHeader, szHeader);
+}
+
+/** SparseDiscReader functions. **/
+
+/**
+ * Get the physical address of the specified logical block index.
+ *
+ * NOTE: Compressed hunks and cooked CD sectors don't have a
+ * meaningful physical address. The overridden readBlock() and
+ * readBlocks() handle those cases; this function is only
+ * implemented for the SparseDiscReader contract.
+ *
+ * @param blockIdx	[in] Block index.
+ * @return Physical address. (0 == empty block; -1 == invalid block index)
+ */
+off64_t ChdReader::getPhysBlockAddr(uint32_t blockIdx) const
+{
+	RP_D(ChdReader);
+	if (d->cdMode) {
+		// Cooked CD sectors don't have a physical address.
+		return 0;
+	}
+
+	// Make sure the block index is in range.
+	assert(blockIdx < d->hunkCount);
+	if (blockIdx >= d->hunkCount) {
+		// Out of range.
+		return -1;
+	}
+
+	if (d->chdVersion == 5) {
+		const uint32_t entry = d->v5map[blockIdx];
+		return (entry != 0
+			? static_cast<off64_t>(entry) * d->hunkBytes
+			: 0);
+	}
+
+	// v3/v4: Only plain uncompressed hunks have a physical address.
+	const ChdReaderPrivate::V34MapEntry &entry = d->v34map[blockIdx];
+	return (entry.type == CHD_V34_MAP_TYPE_UNCOMPRESSED
+		? static_cast<off64_t>(entry.offset)
+		: 0);
+}
+
+/**
+ * Read the specified block.
+ *
+ * This can read either a full block or a partial block.
+ * For a full block, set pos = 0 and size = block_size.
+ *
+ * @param blockIdx	[in] Block index.
+ * @param ptr		[out] Output data buffer.
+ * @param pos		[in] Starting position. (Must be >= 0 and <= the block size!)
+ * @param size		[in] Amount of data to read, in bytes. (Must be <= the block size!)
+ * @return Number of bytes read, or -1 if the block index is invalid.
+ */
+int ChdReader::readBlock(uint32_t blockIdx, void *ptr, int pos, size_t size)
+{
+	// Read 'size' bytes of block 'blockIdx', starting at 'pos'.
+	// NOTE: This can only be called by SparseDiscReader,
+	// so the main assertions are already checked there.
+	RP_D(ChdReader);
+	assert(pos >= 0 && pos < (int)d->block_size);
+	assert(size <= d->block_size);
+	if (pos < 0 || static_cast<off64_t>(pos + size) > static_cast<off64_t>(d->block_size)) {
+		// pos+size is out of range.
+		return -1;
+	}
+
+	if (unlikely(size == 0)) {
+		// Nothing to read.
+		return 0;
+	}
+
+	if (d->cdMode) {
+		// Cooked CD sector. Materialize the containing hunk,
+		// then extract the user data from the raw frame.
+		// FIXME: Currently only supports Mode 1. (user data at byte 16)
+		const uint32_t hunkIdx = blockIdx / d->framesPerHunk;
+		if (hunkIdx >= d->hunkCount) {
+			// Out of range.
+			return -1;
+		}
+		if (hunkIdx != d->curHunk) {
+			const int ret = d->readHunk(hunkIdx, d->hunkBuf.data());
+			if (ret != 0) {
+				// Error reading the hunk.
+				m_lastError = -ret;
+				return -1;
+			}
+			d->curHunk = hunkIdx;
+		}
+
+		const unsigned int frameInHunk = blockIdx % d->framesPerHunk;
+		const uint8_t *const frame = &d->hunkBuf[frameInHunk * CHD_CD_FRAME_SIZE];
+		memcpy(ptr, &frame[16 + pos], size);
+		return static_cast<int>(size);
+	}
+
+	// Block == hunk. Check the block cache first.
+	const uint8_t *const pCached = d->findCachedBlock(blockIdx);
+	if (pCached) {
+		// Block is cached.
+		memcpy(ptr, &pCached[pos], size);
+		return static_cast<int>(size);
+	}
+
+	if ((pos != 0 || size != d->block_size) &&
+	    d->block_size <= SparseDiscReaderPrivate::BLOCK_CACHE_SIZE_MAX)
+	{
+		// Partial block read.
+		// Read the full hunk and cache it, then copy out the
+		// requested portion. (See SparseDiscReader::readBlock().)
+		unique_ptr<uint8_t[]> blockData(new uint8_t[d->block_size]);
+		const int ret = d->readHunk(blockIdx, blockData.get());
+		if (ret != 0) {
+			// Error reading the hunk.
+			m_lastError = -ret;
+			return -1;
+		}
+
+		memcpy(ptr, &blockData[pos], size);
+		d->cacheBlock(blockIdx, std::move(blockData));
+		return static_cast<int>(size);
+	}
+
+	// Full block read.
+	const int ret = d->readHunk(blockIdx, static_cast<uint8_t*>(ptr));
+	if (ret != 0) {
+		// Error reading the hunk.
+		m_lastError = -ret;
+		return -1;
+	}
+	return static_cast<int>(size);
+}
+
+/**
+ * Read consecutive full blocks.
+ *
+ * Compressed hunks in the requested range are decompressed
+ * in parallel using the thread pool.
+ *
+ * @param blockIdx	[in] Starting block index.
+ * @param blockCount	[in] Number of blocks to read.
+ * @param ptr		[out] Output data buffer. (blockCount * block_size bytes)
+ * @return Number of bytes read, or -1 if the block index is invalid.
+ */
+int ChdReader::readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr)
+{
+	RP_D(ChdReader);
+	if (unlikely(blockCount == 0)) {
+		// Nothing to read.
+		return 0;
+	}
+
+	if (d->cdMode || d->chdVersion == 5 || !d->isZlib) {
+		// CD sectors share hunks (served from the hunk buffer),
+		// and v5/uncompressed hunks are plain reads, so there's
+		// nothing to decompress in parallel.
+		uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+		int ret = 0;
+		for (; blockCount > 0; blockIdx++, blockCount--) {
+			int rd = this->readBlock(blockIdx, ptr8, 0, d->block_size);
+			if (rd < 0 || rd != static_cast<int>(d->block_size)) {
+				// Error reading the data.
+				return ret + (rd > 0 ? rd : 0);
+			}
+			ret += d->block_size;
+			ptr8 += d->block_size;
+		}
+		return ret;
+	}
+
+	// v3/v4 zlib image: read the compressed data for the entire
+	// range sequentially, then decompress the hunks in parallel.
+	assert(blockIdx < d->hunkCount);
+	assert(blockIdx + blockCount <= d->hunkCount);
+	if (blockIdx >= d->hunkCount || blockIdx + blockCount > d->hunkCount) {
+		// Out of range.
+		return -1;
+	}
+
+	const unsigned int block_size = d->block_size;
+	uint8_t *const ptr8 = static_cast<uint8_t*>(ptr);
+
+	// Compressed hunk awaiting decompression.
+	struct ZlibHunk {
+		size_t z_pos;		// Offset into the compressed buffer.
+		uint32_t z_size;	// Compressed size.
+		uint32_t outIdx;	// Output block index, relative to blockIdx.
+	};
+	vector<ZlibHunk> zlibHunks;
+
+	// Self-referencing hunk to resolve after decompression.
+	struct SelfHunk {
+		uint32_t srcHunk;	// Source hunk index.
+		uint32_t outIdx;	// Output block index, relative to blockIdx.
+	};
+	vector<SelfHunk> selfHunks;
+
+	// Pass 1: Read the stored data for each hunk.
+	size_t z_total = 0;
+	for (uint32_t i = 0; i < blockCount; i++) {
+		const ChdReaderPrivate::V34MapEntry &entry = d->v34map[blockIdx + i];
+		if (entry.type == CHD_V34_MAP_TYPE_COMPRESSED) {
+			z_total += entry.length;
+		}
+	}
+	ao::uvector<uint8_t> z_buf;
+	z_buf.resize(z_total);
+
+	size_t z_pos = 0;
+	for (uint32_t i = 0; i < blockCount; i++) {
+		const ChdReaderPrivate::V34MapEntry &entry = d->v34map[blockIdx + i];
+		uint8_t *const out = &ptr8[static_cast<size_t>(i) * block_size];
+
+		// Check the block cache first.
+		const uint8_t *const pCached = d->findCachedBlock(blockIdx + i);
+		if (pCached) {
+			memcpy(out, pCached, block_size);
+			continue;
+		}
+
+		switch (entry.type) {
+			case CHD_V34_MAP_TYPE_COMPRESSED: {
+				// Queue the hunk for parallel decompression.
+				const size_t sz_read = m_file->seekAndRead(entry.offset, &z_buf[z_pos], entry.length);
+				m_lastError = m_file->lastError();
+				if (sz_read != entry.length) {
+					// Error reading the compressed data.
+					return (i > 0 ? static_cast<int>(i) * static_cast<int>(block_size) : -1);
+				}
+				const ZlibHunk zhunk = {z_pos, entry.length, i};
+				zlibHunks.push_back(zhunk);
+				z_pos += entry.length;
+				break;
+			}
+
+			case CHD_V34_MAP_TYPE_UNCOMPRESSED: {
+				const size_t sz_read = m_file->seekAndRead(entry.offset, out, block_size);
+				m_lastError = m_file->lastError();
+				if (sz_read != block_size) {
+					// Error reading the hunk.
+					return (i > 0 ? static_cast<int>(i) * static_cast<int>(block_size) : -1);
+				}
+				break;
+			}
+
+			case CHD_V34_MAP_TYPE_MINI:
+			case CHD_V34_MAP_TYPE_SELF_HUNK: {
+				if (entry.type == CHD_V34_MAP_TYPE_SELF_HUNK) {
+					// Resolve after decompression, since the
+					// source hunk may be part of this range.
+					const SelfHunk shunk =
+						{static_cast<uint32_t>(entry.offset), i};
+					selfHunks.push_back(shunk);
+					break;
+				}
+				// MINI entry: expand the repeating pattern.
+				const int ret = d->readHunk(blockIdx + i, out);
+				if (ret != 0) {
+					m_lastError = -ret;
+					return (i > 0 ? static_cast<int>(i) * static_cast<int>(block_size) : -1);
+				}
+				break;
+			}
+
+			default:
+				// Invalid or unsupported entry type.
+				m_lastError = EIO;
+				return (i > 0 ? static_cast<int>(i) * static_cast<int>(block_size) : -1);
+		}
+	}
+
+	// Pass 2: Decompress the queued hunks in parallel.
+	if (!zlibHunks.empty()) {
+		// Error flag. Workers only transition it from 0 to 1,
+		// so a plain store per band is sufficient.
+		volatile int inflateFailed = 0;
+
+		auto inflateBand = [this, d, ptr8, block_size, &z_buf, &zlibHunks, &inflateFailed]
+			(size_t start, size_t end)
+		{
+			for (size_t i = start; i < end; i++) {
+				const ZlibHunk &zhunk = zlibHunks[i];
+				uint8_t *const out = &ptr8[static_cast<size_t>(zhunk.outIdx) * block_size];
+				if (d->inflateHunk(&z_buf[zhunk.z_pos], zhunk.z_size, out) != 0) {
+					inflateFailed = 1;
+				}
+			}
+		};
+
+		unsigned int nThreads = ThreadPool::instance()->threadCount();
+		if (nThreads > zlibHunks.size()) {
+			nThreads = static_cast<unsigned int>(zlibHunks.size());
+		}
+		if (nThreads <= 1) {
+			// Run on the calling thread.
+			inflateBand(0, zlibHunks.size());
+		} else {
+			// Split the hunks into bands.
+			const size_t band = (zlibHunks.size() + nThreads - 1) / nThreads;
+			ThreadPool::TaskSet taskSet;
+			for (size_t start = 0; start < zlibHunks.size(); start += band) {
+				size_t end = start + band;
+				if (end > zlibHunks.size()) {
+					end = zlibHunks.size();
+				}
+				taskSet.submit([inflateBand, start, end]() {
+					inflateBand(start, end);
+				});
+			}
+			taskSet.wait();
+		}
+
+		if (inflateFailed) {
+			// Error decompressing.
+			m_lastError = EIO;
+			return -1;
+		}
+	}
+
+	// Pass 3: Resolve self-referencing hunks.
+	for (auto iter = selfHunks.cbegin(); iter != selfHunks.cend(); ++iter) {
+		uint8_t *const out = &ptr8[static_cast<size_t>(iter->outIdx) * block_size];
+		if (iter->srcHunk >= blockIdx && iter->srcHunk < blockIdx + blockCount) {
+			// Source hunk is part of this range.
+			memcpy(out, &ptr8[static_cast<size_t>(iter->srcHunk - blockIdx) * block_size], block_size);
+		} else {
+			// Source hunk is outside of this range.
+			const int ret = d->readHunk(iter->srcHunk, out);
+			if (ret != 0) {
+				// Error reading the source hunk.
+				m_lastError = -ret;
+				return -1;
+			}
+		}
+	}
+
+	return static_cast<int>(blockCount) * static_cast<int>(block_size);
+}
+
+}
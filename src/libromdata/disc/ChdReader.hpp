@@ -0,0 +1,107 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * ChdReader.hpp: MAME CHD (Compressed Hunks of Data) disc image reader.   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DISC_CHDREADER_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_DISC_CHDREADER_HPP__
+
+#include "librpbase/disc/SparseDiscReader.hpp"
+
+namespace LibRomData {
+
+class ChdReaderPrivate;
+class ChdReader : public LibRpBase::SparseDiscReader
+{
+	public:
+		/**
+		 * Construct a ChdReader with the specified file.
+		 * The file is ref()'d, so the original file can be
+		 * unref()'d by the caller afterwards.
+		 *
+		 * NOTE: Supported images are uncompressed v5 CHDs and
+		 * zlib-compressed (or uncompressed) v3/v4 CHDs. Other
+		 * codecs and parent CHDs are not supported.
+		 *
+		 * For CD-ROM and GD-ROM images, 2048-byte cooked sectors
+		 * are exposed instead of the raw 2448-byte CD frames.
+		 *
+		 * @param file File to read from.
+		 */
+		explicit ChdReader(LibRpFile::IRpFile *file);
+
+	private:
+		typedef SparseDiscReader super;
+		RP_DISABLE_COPY(ChdReader)
+	private:
+		friend class ChdReaderPrivate;
+
+	public:
+		/** Disc image detection functions. **/
+
+		/**
+		 * Is a disc image supported by this class?
+		 * @param pHeader Disc image header.
+		 * @param szHeader Size of header.
+		 * @return Class-specific disc format ID (>= 0) if supported; -1 if not.
+		 */
+		static int isDiscSupported_static(const uint8_t *pHeader, size_t szHeader);
+
+		/**
+		 * Is a disc image supported by this object?
+		 * @param pHeader Disc image header.
+		 * @param szHeader Size of header.
+		 * @return Class-specific disc format ID (>= 0) if supported; -1 if not.
+		 */
+		int isDiscSupported(const uint8_t *pHeader, size_t szHeader) const final;
+
+	protected:
+		/** SparseDiscReader functions. **/
+
+		/**
+		 * Get the physical address of the specified logical block index.
+		 *
+		 * NOTE: Compressed hunks and cooked CD sectors don't have a
+		 * meaningful physical address. The overridden readBlock() and
+		 * readBlocks() handle those cases; this function is only
+		 * implemented for the SparseDiscReader contract.
+		 *
+		 * @param blockIdx	[in] Block index.
+		 * @return Physical address. (0 == empty block; -1 == invalid block index)
+		 */
+		off64_t getPhysBlockAddr(uint32_t blockIdx) const final;
+
+		/**
+		 * Read the specified block.
+		 *
+		 * This can read either a full block or a partial block.
+		 * For a full block, set pos = 0 and size = block_size.
+		 *
+		 * @param blockIdx	[in] Block index.
+		 * @param ptr		[out] Output data buffer.
+		 * @param pos		[in] Starting position. (Must be >= 0 and <= the block size!)
+		 * @param size		[in] Amount of data to read, in bytes. (Must be <= the block size!)
+		 * @return Number of bytes read, or -1 if the block index is invalid.
+		 */
+		int readBlock(uint32_t blockIdx, void *ptr, int pos, size_t size) final;
+
+		/**
+		 * Read consecutive full blocks.
+		 *
+		 * Compressed hunks in the requested range are decompressed
+		 * in parallel using the thread pool.
+		 *
+		 * @param blockIdx	[in] Starting block index.
+		 * @param blockCount	[in] Number of blocks to read.
+		 * @param ptr		[out] Output data buffer. (blockCount * block_size bytes)
+		 * @return Number of bytes read, or -1 if the block index is invalid.
+		 */
+		int readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr) final;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DISC_CHDREADER_HPP__ */
@@ -15,9 +15,13 @@
 // librpbase
 using namespace LibRpBase;
 
+// Uninitialized vector class.
+// Reference: http://andreoffringa.org/?q=uvector
+#include "librpbase/uvector.h"
+
 // C++ STL classes.
 using std::string;
-using std::unordered_map;
+using std::vector;
 
 namespace LibRomData {
 
@@ -41,10 +45,20 @@ class GcnFstPrivate
 		const char *string_table_ptr;
 		uint32_t string_table_sz;
 
-		// String table, converted to Unicode.
-		// - Key: String offset in the FST string table.
-		// - Value: string.
-		mutable unordered_map<uint32_t, string> u8_string_table;
+		// Flat directory index, built at open:
+		// - u8_arena: All entry names converted to UTF-8,
+		//   stored NUL-separated in one contiguous buffer.
+		// - u8_name_offset: Per-entry offset into u8_arena.
+		//   (~0U if the entry's name offset is invalid.)
+		// - children: Child entry indices, grouped per directory
+		//   and sorted by name within each group.
+		// - dir_child_offset/dir_child_count: Per-directory span
+		//   into children. (Only valid for directory entries.)
+		string u8_arena;
+		ao::uvector<uint32_t> u8_name_offset;
+		ao::uvector<uint32_t> children;
+		ao::uvector<uint32_t> dir_child_offset;
+		ao::uvector<uint32_t> dir_child_count;
 
 		// Offset shift.
 		uint8_t offsetShift;
@@ -52,6 +66,19 @@ class GcnFstPrivate
 		// IFst::Dir* reference counter.
 		int fstDirCount;
 
+		/**
+		 * Build the flat directory index.
+		 * Called by the constructor after the FST data is loaded.
+		 */
+		void buildIndex(void);
+
+		/**
+		 * Get an FST entry's UTF-8 name by index.
+		 * @param idx FST entry index.
+		 * @return Name, or empty string if the name offset is invalid.
+		 */
+		inline const char *entry_name_by_idx(uint32_t idx) const;
+
 		/**
 		 * Check if an fst_entry is a directory.
 		 * @return True if this is a directory; false if it's a regular file.
@@ -139,11 +166,110 @@ GcnFstPrivate::GcnFstPrivate(const uint8_t *fstData, uint32_t len, uint8_t offse
 	string_table_ptr = reinterpret_cast<char*>(&fst8[string_table_offset]);
 	string_table_sz = fstData_sz - string_table_offset;
 
-#ifdef HAVE_UNORDERED_MAP_RESERVE
-	// Reserve space in the string table.
-	// NOTE: file_count includes the root directory entry.
-	u8_string_table.reserve(file_count - 1);
-#endif
+	// Build the flat directory index.
+	buildIndex();
+}
+
+/**
+ * Build the flat directory index.
+ * Called by the constructor after the FST data is loaded.
+ */
+void GcnFstPrivate::buildIndex(void)
+{
+	const uint32_t file_count = be32_to_cpu(fstData[0].root_dir.file_count);
+
+	// Convert all entry names into a contiguous UTF-8 arena.
+	// This eliminates the per-name allocations of the old lazy
+	// conversion cache, which added up for large homebrew FSTs.
+	u8_name_offset.resize(file_count);
+	u8_arena.reserve(string_table_sz + (string_table_sz / 4));
+	for (uint32_t i = 0; i < file_count; i++) {
+		const uint32_t offset = be32_to_cpu(fstData[i].file_type_name_offset) & 0xFFFFFF;
+		if (offset >= string_table_sz) {
+			// Name offset is out of range.
+			u8_name_offset[i] = ~0U;
+			continue;
+		}
+
+		const char *const str = &string_table_ptr[offset];
+		u8_name_offset[i] = static_cast<uint32_t>(u8_arena.size());
+		u8_arena += cp1252_sjis_to_utf8(str, static_cast<int>(strlen(str)));
+		u8_arena += '\0';
+	}
+
+	// Build the per-directory sorted child spans.
+	// Immediate children of a directory are the entries within its
+	// span that aren't part of a nested subdirectory's span, so
+	// walk the FST once with a stack of open directories.
+	struct OpenDir {
+		uint32_t dir_idx;	// Directory entry index.
+		uint32_t next_offset;	// Entry index after the directory's span.
+		vector<uint32_t> kids;	// Immediate children.
+	};
+	vector<OpenDir> dstack;
+
+	dir_child_offset.resize(file_count);
+	dir_child_count.resize(file_count);
+	children.reserve(file_count - 1);
+
+	// Sort children by UTF-8 name for binary search.
+	auto finalizeDir = [this](OpenDir &od) {
+		std::sort(od.kids.begin(), od.kids.end(),
+			[this](uint32_t a, uint32_t b) {
+				return (strcmp(entry_name_by_idx(a), entry_name_by_idx(b)) < 0);
+			});
+		dir_child_offset[od.dir_idx] = static_cast<uint32_t>(children.size());
+		dir_child_count[od.dir_idx] = static_cast<uint32_t>(od.kids.size());
+		for (auto iter = od.kids.begin(); iter != od.kids.end(); ++iter) {
+			children.push_back(*iter);
+		}
+	};
+
+	dstack.resize(1);
+	dstack[0].dir_idx = 0;
+	dstack[0].next_offset = file_count;
+	for (uint32_t i = 1; i < file_count; i++) {
+		while (i >= dstack.back().next_offset && dstack.size() > 1) {
+			finalizeDir(dstack.back());
+			dstack.pop_back();
+		}
+		dstack.back().kids.push_back(i);
+
+		if (is_dir(&fstData[i])) {
+			uint32_t next = be32_to_cpu(fstData[i].dir.next_offset);
+			if (next > file_count) {
+				// Span extends past the end of the FST.
+				next = file_count;
+			}
+			// Initialize as an empty directory; entering the
+			// span below fills in the actual children.
+			dir_child_offset[i] = 0;
+			dir_child_count[i] = 0;
+			if (next > i + 1) {
+				dstack.resize(dstack.size() + 1);
+				dstack.back().dir_idx = i;
+				dstack.back().next_offset = next;
+			}
+		}
+	}
+	while (!dstack.empty()) {
+		finalizeDir(dstack.back());
+		dstack.pop_back();
+	}
+}
+
+/**
+ * Get an FST entry's UTF-8 name by index.
+ * @param idx FST entry index.
+ * @return Name, or empty string if the name offset is invalid.
+ */
+inline const char *GcnFstPrivate::entry_name_by_idx(uint32_t idx) const
+{
+	if (idx >= u8_name_offset.size() || u8_name_offset[idx] == ~0U) {
+		// Invalid name offset.
+		return "";
+	}
+	return &u8_arena[u8_name_offset[idx]];
 }
 
 GcnFstPrivate::~GcnFstPrivate()
@@ -168,27 +294,13 @@ inline bool GcnFstPrivate::is_dir(const GCN_FST_Entry *fst_entry)
  */
 inline const char *GcnFstPrivate::entry_name(const GCN_FST_Entry *fst_entry) const
 {
-	// Get the name entry from the string table.
-	uint32_t offset = be32_to_cpu(fst_entry->file_type_name_offset) & 0xFFFFFF;
-	if (offset >= string_table_sz) {
+	// All names were converted to UTF-8 when the index was built.
+	const size_t idx = static_cast<size_t>(fst_entry - fstData);
+	if (idx >= u8_name_offset.size() || u8_name_offset[idx] == ~0U) {
 		// Out of range.
 		return nullptr;
 	}
-
-	// Has this name already been converted to UTF-8?
-	unordered_map<uint32_t, string>::const_iterator iter = u8_string_table.find(offset);
-	if (iter != u8_string_table.end()) {
-		// Name has already been converted.
-		return iter->second.c_str();
-	}
-
-	// Name has not been converted.
-	// Do the conversion now.
-	const char *str = &string_table_ptr[offset];
-	int len = static_cast<int>(strlen(str));	// TODO: Bounds checking.
-	string u8str = cp1252_sjis_to_utf8(str, len);
-	iter = u8_string_table.insert(std::make_pair(offset, u8str)).first;
-	return iter->second.c_str();
+	return &u8_arena[u8_name_offset[idx]];
 }
 
 /**
@@ -271,9 +383,7 @@ const GCN_FST_Entry *GcnFstPrivate::find_path(const char *path) const
 	}
 
 	// Skip the initial slash.
-	int idx = 1;	// Ignore the root directory.
-	// NOTE: This is the index *after* the last file.
-	int last_fst_idx = be32_to_cpu(fst_entry->root_dir.file_count);
+	uint32_t dir_idx = 0;	// Current directory. (Start at the root.)
 	size_t slash_pos = 0;
 	do {
 		size_t next_slash_pos = s_path.find('/', slash_pos + 1);
@@ -300,41 +410,23 @@ const GCN_FST_Entry *GcnFstPrivate::find_path(const char *path) const
 			continue;
 		}
 
-		// Search this directory for a matching path component.
-		bool found = false;
-		for (; idx < last_fst_idx; idx++) {
-			const char *pName;
-			fst_entry = this->entry(idx, &pName);
-			if (!fst_entry) {
-				// Invalid path.
-				return nullptr;
-			}
-
-			// TODO: Is GCN/Wii case-sensitive?
-			if (pName && !strcmp(path_component.c_str(), pName)) {
-				// Found a match.
-				found = true;
-				break;
-			}
-
-			// If this is a directory, skip it.
-			if (is_dir(fst_entry)) {
-				// NOTE: next_offset is the index *after* the
-				// last entry in the subdirectory, so we have to
-				// subtract 1 for proper enumeration.
-				idx = be32_to_cpu(fst_entry->dir.next_offset) - 1;
-			}
-		}
-
-		if (!found) {
+		// Binary search the current directory's children.
+		// TODO: Is GCN/Wii case-sensitive?
+		const uint32_t *const base = children.data() + dir_child_offset[dir_idx];
+		const uint32_t *const end = base + dir_child_count[dir_idx];
+		const uint32_t *const p = std::lower_bound(base, end, path_component.c_str(),
+			[this](uint32_t child, const char *component) {
+				return (strcmp(entry_name_by_idx(child), component) < 0);
+			});
+		if (p == end || strcmp(entry_name_by_idx(*p), path_component.c_str()) != 0) {
 			// No match.
 			return nullptr;
 		}
+		fst_entry = &fstData[*p];
 
 		if (is_dir(fst_entry)) {
-			// Directory. Save the last_fst_idx.
-			last_fst_idx = be32_to_cpu(fst_entry->dir.next_offset);
-			idx++;
+			// Directory. Descend into it.
+			dir_idx = *p;
 		} else {
 			// File: Make sure there's no more slashes.
 			if (are_more_slashes) {
@@ -13,7 +13,9 @@
 #include "GcnPartition.hpp"
 
 // librpbase
+#include "librpbase/BufferPool.hpp"
 using LibRpBase::IDiscReader;
+using LibRpBase::PoolBuffer;
 
 namespace LibRomData {
 
@@ -153,23 +155,22 @@ int GcnPartitionPrivate::loadFst(void)
 	// Read the FST.
 	// TODO: Eliminate the extra copy?
 	uint32_t fstData_len = bootBlock.fst_size << offsetShift;
-	uint8_t *fstData = static_cast<uint8_t*>(malloc(fstData_len));
-	if (!fstData) {
-		// malloc() failed.
+	PoolBuffer fstData(fstData_len);
+	if (!fstData.get()) {
+		// Buffer allocation failed.
 		q->m_lastError = ENOMEM;
 		return -ENOMEM;
 	}
-	size_t size = q->read(fstData, fstData_len);
+	size_t size = q->read(fstData.get(), fstData_len);
 	if (size != fstData_len) {
 		// Short read.
-		free(fstData);
 		q->m_lastError = EIO;
 		return -EIO;
 	}
 
 	// Create the GcnFst.
-	GcnFst *const gcnFst = new GcnFst(fstData, fstData_len, offsetShift);
-	free(fstData);	// TODO: Eliminate the extra copy?
+	// TODO: Eliminate the extra copy?
+	GcnFst *const gcnFst = new GcnFst(fstData.get(), fstData_len, offsetShift);
 	if (gcnFst->hasErrors()) {
 		// FST has errors.
 		delete gcnFst;
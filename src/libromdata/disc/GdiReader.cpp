@@ -65,6 +65,19 @@ class GdiReaderPrivate : public SparseDiscReaderPrivate {
 		// Value = pointer to BlockRange in blockRanges.
 		vector<BlockRange*> trackMappings;
 
+		// Last block range found by getBlockRange().
+		// ISO-9660 traversal tends to stay within one track,
+		// so this avoids a linear search on every block.
+		const BlockRange *lastBlockRange;
+
+		/**
+		 * Find the block range containing the specified block.
+		 * The track file is opened if it isn't open already.
+		 * @param blockIdx Block index.
+		 * @return BlockRange, or nullptr if not found in any data track.
+		 */
+		const BlockRange *getBlockRange(uint32_t blockIdx);
+
 		/**
 		 * Close all opened files.
 		 */
@@ -91,6 +104,7 @@ class GdiReaderPrivate : public SparseDiscReaderPrivate {
 GdiReaderPrivate::GdiReaderPrivate(GdiReader *q)
 	: super(q)
 	, blockCount(0)
+	, lastBlockRange(nullptr)
 { }
 
 GdiReaderPrivate::~GdiReaderPrivate()
@@ -112,6 +126,7 @@ void GdiReaderPrivate::close(void)
 	);
 	blockRanges.clear();
 	trackMappings.clear();
+	lastBlockRange = nullptr;
 
 	// GDI file.
 	RP_Q(GdiReader);
@@ -306,6 +321,54 @@ int GdiReaderPrivate::openTrack(int trackNumber)
 	return 0;
 }
 
+/**
+ * Find the block range containing the specified block.
+ * The track file is opened if it isn't open already.
+ * @param blockIdx Block index.
+ * @return BlockRange, or nullptr if not found in any data track.
+ */
+const GdiReaderPrivate::BlockRange *GdiReaderPrivate::getBlockRange(uint32_t blockIdx)
+{
+	// Check the last range first.
+	// Most lookups stay within one track.
+	if (lastBlockRange &&
+	    blockIdx >= lastBlockRange->blockStart &&
+	    blockIdx <= lastBlockRange->blockEnd)
+	{
+		return lastBlockRange;
+	}
+
+	for (auto iter = blockRanges.cbegin(); iter != blockRanges.cend(); ++iter) {
+		// NOTE: Using volatile because it can change in openTrack().
+		const volatile BlockRange *const vbr = &(*iter);
+		if (blockIdx < vbr->blockStart) {
+			// Not in this track.
+			continue;
+		}
+
+		// Is the track loaded?
+		if (vbr->blockEnd == 0) {
+			// Track isn't loaded. Load it.
+			int ret = openTrack(vbr->trackNumber);
+			if (ret != 0) {
+				// Unable to load the track.
+				// Skip for now.
+				continue;
+			}
+		}
+
+		// Check the end block.
+		if (vbr->blockEnd != 0 && blockIdx <= vbr->blockEnd) {
+			// Found the track.
+			lastBlockRange = (const BlockRange*)vbr;
+			return lastBlockRange;
+		}
+	}
+
+	// Not found in any block range.
+	return nullptr;
+}
+
 /** GdiReader **/
 
 GdiReader::GdiReader(IRpFile *file)
@@ -513,35 +576,7 @@ int GdiReader::readBlock(uint32_t blockIdx, void *ptr, int pos, size_t size)
 	}
 
 	// Find the block.
-	// TODO: Cache this lookup somewhere or something.
-	const GdiReaderPrivate::BlockRange *blockRange = nullptr;
-	for (auto iter = d->blockRanges.cbegin(); iter != d->blockRanges.cend(); ++iter) {
-		// NOTE: Using volatile because it can change in d->openTrack().
-		const volatile GdiReaderPrivate::BlockRange *const vbr = &(*iter);
-		if (blockIdx < vbr->blockStart) {
-			// Not in this track.
-			continue;
-		}
-
-		// Is the track loaded?
-		if (vbr->blockEnd == 0) {
-			// Track isn't loaded. Load it.
-			int ret = d->openTrack(vbr->trackNumber);
-			if (ret != 0) {
-				// Unable to load the track.
-				// Skip for now.
-				continue;
-			}
-		}
-
-		// Check the end block.
-		if (vbr->blockEnd != 0 && blockIdx <= vbr->blockEnd) {
-			// Found the track.
-			blockRange = (const GdiReaderPrivate::BlockRange*)vbr;
-			break;
-		}
-	}
-
+	const GdiReaderPrivate::BlockRange *const blockRange = d->getBlockRange(blockIdx);
 	if (!blockRange) {
 		// Not found in any block range.
 		return 0;
@@ -565,6 +600,105 @@ int GdiReader::readBlock(uint32_t blockIdx, void *ptr, int pos, size_t size)
 	return (sz_read > 0 ? (int)sz_read : -1);
 }
 
+/**
+ * Read consecutive full blocks.
+ *
+ * One underlying read is issued per run of sectors instead of
+ * one read per block. For 2352-byte sector tracks, a batch of
+ * raw sectors is read and the user data is extracted afterwards.
+ *
+ * @param blockIdx	[in] Starting block index.
+ * @param blockCount	[in] Number of blocks to read.
+ * @param ptr		[out] Output data buffer. (blockCount * block_size bytes)
+ * @return Number of bytes read, or -1 if the block index is invalid.
+ */
+int GdiReader::readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr)
+{
+	// Maximum number of 2352-byte raw sectors to read at once.
+	// (64 sectors == 147 KB raw buffer)
+	static const uint32_t RAW_SECTOR_BATCH = 64;
+
+	RP_D(GdiReader);
+	assert(blockIdx < d->blockCount);
+	assert(blockIdx + blockCount <= d->blockCount);
+	if (blockIdx >= d->blockCount || blockIdx + blockCount > d->blockCount) {
+		// Out of range.
+		return -1;
+	}
+
+	if (unlikely(blockCount == 0)) {
+		// Nothing to read.
+		return 0;
+	}
+
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	unique_ptr<uint8_t[]> rawbuf;	// allocated when a 2352-byte sector track is hit
+	int ret = 0;
+
+	while (blockCount > 0) {
+		const GdiReaderPrivate::BlockRange *const blockRange = d->getBlockRange(blockIdx);
+		if (!blockRange || !blockRange->file) {
+			// Not found in any block range.
+			return ret;
+		}
+
+		// Number of consecutive blocks in this track.
+		uint32_t run = blockRange->blockEnd - blockIdx + 1;
+		if (run > blockCount) {
+			run = blockCount;
+		}
+
+		off64_t phys_pos = static_cast<off64_t>(blockIdx - blockRange->blockStart) * blockRange->sectorSize;
+		if (blockRange->sectorSize == 2048) {
+			// 2048-byte sectors: read the entire run directly.
+			const size_t run_sz = static_cast<size_t>(run) * 2048;
+			size_t sz_read = blockRange->file->seekAndRead(phys_pos, ptr8, run_sz);
+			m_lastError = blockRange->file->lastError();
+			ret += static_cast<int>(sz_read);
+			if (sz_read != run_sz) {
+				// Short read.
+				return ret;
+			}
+			ptr8 += run_sz;
+		} else {
+			// 2352-byte sectors: read batches of raw sectors,
+			// then extract the user data from each one.
+			// FIXME: Read the whole block so we can determine if this is Mode 1 or Mode 2.
+			// Mode 1 data starts at byte 16; Mode 2 data starts at byte 24.
+			if (!rawbuf) {
+				rawbuf.reset(new uint8_t[RAW_SECTOR_BATCH * 2352]);
+			}
+
+			for (uint32_t rem = run; rem > 0; ) {
+				const uint32_t batch = (rem < RAW_SECTOR_BATCH ? rem : RAW_SECTOR_BATCH);
+				const size_t raw_sz = static_cast<size_t>(batch) * 2352;
+				size_t sz_read = blockRange->file->seekAndRead(phys_pos, rawbuf.get(), raw_sz);
+				m_lastError = blockRange->file->lastError();
+
+				// Extract the user data from each complete raw sector.
+				const uint32_t sectors_read = static_cast<uint32_t>(sz_read / 2352);
+				const uint8_t *src = rawbuf.get() + 16;
+				for (uint32_t i = 0; i < sectors_read; i++, src += 2352, ptr8 += 2048) {
+					memcpy(ptr8, src, 2048);
+				}
+				ret += static_cast<int>(sectors_read) * 2048;
+
+				if (sz_read != raw_sz) {
+					// Short read.
+					return ret;
+				}
+				rem -= batch;
+				phys_pos += raw_sz;
+			}
+		}
+
+		blockIdx += run;
+		blockCount -= run;
+	}
+
+	return ret;
+}
+
 /** GDI-specific functions. **/
 // TODO: "CdromReader" class?
 
@@ -618,9 +752,10 @@ IsoPartition *GdiReader::openIsoPartition(int trackNumber)
 /**
  * Create an ISO RomData object for a given track number.
  * @param trackNumber Track number. (1-based)
+ * @param pvd Cached PVD for this track, or nullptr to read it from the track.
  * @return ISO object, or nullptr on error.
  */
-ISO *GdiReader::openIsoRomData(int trackNumber)
+ISO *GdiReader::openIsoRomData(int trackNumber, const ISO_Primary_Volume_Descriptor *pvd)
 {
 	// Make sure the track is open.
 	RP_D(GdiReader);
@@ -646,7 +781,7 @@ ISO *GdiReader::openIsoRomData(int trackNumber)
 		static_cast<off64_t>(lba_start) * 2048,
 		static_cast<off64_t>(lba_size) * 2048);
 	if (isoFile->isOpen()) {
-		isoData = new ISO(isoFile);
+		isoData = new ISO(isoFile, pvd);
 		if (!isoData->isOpen()) {
 			// Unable to open ISO object.
 			isoData->unref();
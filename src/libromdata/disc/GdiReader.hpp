@@ -10,6 +10,7 @@
 #define __ROMPROPERTIES_LIBROMDATA_DISC_GDIREADER_HPP__
 
 #include "librpbase/disc/SparseDiscReader.hpp"
+#include "../iso_structs.h"
 
 namespace LibRomData {
 
@@ -80,6 +81,20 @@ class GdiReader : public LibRpBase::SparseDiscReader
 		 */
 		int readBlock(uint32_t blockIdx, void *ptr, int pos, size_t size) final;
 
+		/**
+		 * Read consecutive full blocks.
+		 *
+		 * One underlying read is issued per run of sectors instead of
+		 * one read per block. For 2352-byte sector tracks, a batch of
+		 * raw sectors is read and the user data is extracted afterwards.
+		 *
+		 * @param blockIdx	[in] Starting block index.
+		 * @param blockCount	[in] Number of blocks to read.
+		 * @param ptr		[out] Output data buffer. (blockCount * block_size bytes)
+		 * @return Number of bytes read, or -1 if the block index is invalid.
+		 */
+		int readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr) final;
+
 	public:
 		/** GDI-specific functions. **/
 
@@ -106,9 +121,10 @@ class GdiReader : public LibRpBase::SparseDiscReader
 		/**
 		 * Create an ISO RomData object for a given track number.
 		 * @param trackNumber Track number. (1-based)
+		 * @param pvd Cached PVD for this track, or nullptr to read it from the track.
 		 * @return ISO object, or nullptr on error.
 		 */
-		ISO *openIsoRomData(int trackNumber);
+		ISO *openIsoRomData(int trackNumber, const ISO_Primary_Volume_Descriptor *pvd = nullptr);
 };
 
 }
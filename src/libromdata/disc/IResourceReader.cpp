@@ -14,6 +14,49 @@ using LibRpFile::IRpFile;
 
 namespace LibRomData {
 
+/**
+ * Find a resource in a flattened resource table.
+ *
+ * The table must be sorted by key. Wildcard IDs select
+ * the first matching entry in key order.
+ *
+ * @param tbl Sorted flattened resource table.
+ * @param type Resource type ID.
+ * @param id Resource ID. (-1 for "first entry")
+ * @param lang Language ID. (-1 for "first entry")
+ * @return Matching entry, or nullptr if not found.
+ */
+const IResourceReader::FlatResEntry *IResourceReader::findResTblEntry(
+	const res_tbl_t &tbl, uint16_t type, int id, int lang)
+{
+	// Determine the key prefix to search for.
+	// shift indicates how much of the key is significant:
+	// wildcard IDs only compare the high-order fields.
+	uint64_t key;
+	unsigned int shift;
+	if (id < 0) {
+		key = resTblKey(type, 0, 0);
+		shift = 32;
+	} else if (lang < 0) {
+		key = resTblKey(type, static_cast<uint16_t>(id), 0);
+		shift = 16;
+	} else {
+		key = resTblKey(type, static_cast<uint16_t>(id), static_cast<uint16_t>(lang));
+		shift = 0;
+	}
+
+	auto iter = std::lower_bound(tbl.cbegin(), tbl.cend(), key,
+		[](const FlatResEntry &entry, uint64_t key) -> bool {
+			return (entry.key < key);
+		}
+	);
+	if (iter == tbl.cend() || ((iter->key >> shift) != (key >> shift))) {
+		// Not found.
+		return nullptr;
+	}
+	return &(*iter);
+}
+
 /**
  * DWORD alignment function.
  * @param file	[in] File to DWORD align.
@@ -41,6 +41,48 @@ class IResourceReader : public LibRpBase::IPartition
 		 */
 		static int alignFileDWORD(LibRpFile::IRpFile *file);
 
+	public:
+		/** Flattened resource tables. **/
+
+		// Flattened resource directory entry.
+		// Subclasses flatten their directory structures into a
+		// single table at open, sorted by key, so lookups are
+		// binary searches instead of directory tree walks.
+		struct FlatResEntry {
+			uint64_t key;	// see resTblKey()
+			uint32_t addr;	// Reader-specific address of the resource.
+			uint32_t len;	// Resource length, if known. (0 if not)
+		};
+		typedef std::vector<FlatResEntry> res_tbl_t;
+
+		/**
+		 * Build a flattened resource table key.
+		 * @param type Resource type ID.
+		 * @param id Resource ID.
+		 * @param lang Language ID.
+		 * @return Key for the flattened resource table.
+		 */
+		static inline uint64_t resTblKey(uint16_t type, uint16_t id, uint16_t lang)
+		{
+			return (static_cast<uint64_t>(type) << 32) |
+			       (static_cast<uint64_t>(id) << 16) |
+			        static_cast<uint64_t>(lang);
+		}
+
+		/**
+		 * Find a resource in a flattened resource table.
+		 *
+		 * The table must be sorted by key. Wildcard IDs select
+		 * the first matching entry in key order.
+		 *
+		 * @param tbl Sorted flattened resource table.
+		 * @param type Resource type ID.
+		 * @param id Resource ID. (-1 for "first entry")
+		 * @param lang Language ID. (-1 for "first entry")
+		 * @return Matching entry, or nullptr if not found.
+		 */
+		static const FlatResEntry *findResTblEntry(const res_tbl_t &tbl, uint16_t type, int id, int lang);
+
 	public:
 		/** Resource access functions. **/
 
@@ -16,6 +16,7 @@ using LibRpFile::IRpFile;
 
 // C++ STL classes.
 using std::string;
+using std::unordered_map;
 
 namespace LibRomData {
 
@@ -48,11 +49,39 @@ class IsoPartitionPrivate
 		// is a byte array, not an ISO_DirEntry array.
 		ao::uvector<uint8_t> rootDir_data;
 
+		// Directory extent cache.
+		// Maps lowercased directory paths, without leading or
+		// trailing slashes, to the directory data. The root
+		// directory is stored in rootDir_data instead.
+		// Loaded on demand; repeated opens from the same
+		// directory don't re-read the extent.
+		unordered_map<string, ao::uvector<uint8_t> > map_dirData;
+
+		// Path table index.
+		// Maps lowercased directory paths to the starting block
+		// of the directory extent. Parsed from the ISO path table
+		// once, on the first subdirectory lookup.
+		unordered_map<string, uint32_t> map_pathTable;
+		bool pathTableLoaded;
+
 		/**
 		 * Load the root directory.
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
 		int loadRootDirectory(void);
+
+		/**
+		 * Parse the ISO path table into the path table index.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadPathTable(void);
+
+		/**
+		 * Get a directory's data, using the caches if possible.
+		 * @param path Directory path. (lowercased, no leading or trailing slashes; empty for root)
+		 * @return Directory data, or nullptr on error.
+		 */
+		const ao::uvector<uint8_t> *getDirectory(const string &path);
 };
 
 /** IsoPartitionPrivate **/
@@ -63,6 +92,7 @@ IsoPartitionPrivate::IsoPartitionPrivate(IsoPartition *q,
 	, partition_offset(partition_offset)
 	, partition_size(0)
 	, iso_start_offset(iso_start_offset)
+	, pathTableLoaded(false)
 {
 	// Clear the PVD struct.
 	memset(&pvd, 0, sizeof(pvd));
@@ -183,6 +213,201 @@ int IsoPartitionPrivate::loadRootDirectory(void)
 	return 0;
 }
 
+/**
+ * Parse the ISO path table into the path table index.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int IsoPartitionPrivate::loadPathTable(void)
+{
+	RP_Q(IsoPartition);
+	if (unlikely(pathTableLoaded)) {
+		// Path table is already loaded.
+		return 0;
+	}
+
+	// The root directory must be loaded first, since it
+	// determines iso_start_offset.
+	int ret = loadRootDirectory();
+	if (ret != 0) {
+		return ret;
+	}
+
+	// Block size.
+	// Should be 2048, but other values are possible.
+	const unsigned int block_size = pvd.logical_block_size.he;
+
+	// Sanity check: Path tables larger than 1 MB are out of spec.
+	const uint32_t pathTable_size = pvd.path_table_size.he;
+	if (pathTable_size < sizeof(ISO_Path_Table_Entry) ||
+	    pathTable_size > 1024*1024)
+	{
+		q->m_lastError = EIO;
+		return -q->m_lastError;
+	}
+
+	// Read the L path table. (LE values)
+	const uint32_t pathTable_lba = le32_to_cpu(pvd.path_table_lba_L);
+	if (pathTable_lba < static_cast<uint32_t>(iso_start_offset)) {
+		// Starting block is invalid.
+		q->m_lastError = EIO;
+		return -q->m_lastError;
+	}
+	ao::uvector<uint8_t> pathTable_data;
+	pathTable_data.resize(pathTable_size);
+	const off64_t pathTable_addr = partition_offset +
+		static_cast<off64_t>(pathTable_lba - iso_start_offset) * block_size;
+	size_t size = q->m_discReader->seekAndRead(pathTable_addr, pathTable_data.data(), pathTable_data.size());
+	if (size != pathTable_data.size()) {
+		// Seek and/or read error.
+		q->m_lastError = q->m_discReader->lastError();
+		if (q->m_lastError == 0) {
+			q->m_lastError = EIO;
+		}
+		return -q->m_lastError;
+	}
+
+	// Parse the path table entries.
+	// Directory numbers are 1-based; entry 1 is the root.
+	// Parent directories always precede their subdirectories,
+	// so full paths can be built in a single pass.
+	std::vector<string> dirPaths;
+	dirPaths.reserve(16);
+	dirPaths.push_back(string());	// dummy entry 0
+	const uint8_t *p = pathTable_data.data();
+	const uint8_t *const p_end = p + pathTable_data.size();
+	while (p + sizeof(ISO_Path_Table_Entry) <= p_end) {
+		const ISO_Path_Table_Entry *const entry =
+			reinterpret_cast<const ISO_Path_Table_Entry*>(p);
+		if (entry->dir_id_length == 0) {
+			// End of path table.
+			break;
+		}
+
+		const char *const dir_id = reinterpret_cast<const char*>(p) + sizeof(ISO_Path_Table_Entry);
+		if (dir_id + entry->dir_id_length > reinterpret_cast<const char*>(p_end)) {
+			// Directory identifier is out of bounds.
+			break;
+		}
+
+		// Build the full path.
+		// NOTE: The root entry has a single 0x00 or 0x01 byte
+		// as its identifier, which maps to an empty path.
+		string dirPath;
+		const uint16_t parent = le16_to_cpu(entry->parent_dir_number);
+		if (entry->dir_id_length == 1 &&
+		    (dir_id[0] == '\x00' || dir_id[0] == '\x01'))
+		{
+			// Root directory.
+		} else if (parent < dirPaths.size()) {
+			dirPath = dirPaths[parent];
+			if (!dirPath.empty()) {
+				dirPath += '/';
+			}
+			dirPath.append(dir_id, entry->dir_id_length);
+			// Lowercase the path for case-insensitive lookups.
+			std::transform(dirPath.begin(), dirPath.end(), dirPath.begin(),
+				[](char c) { return std::tolower(static_cast<unsigned char>(c)); });
+			map_pathTable.insert(std::make_pair(dirPath, le32_to_cpu(entry->block)));
+		} else {
+			// Parent directory is invalid.
+			// Keep a placeholder so subsequent directory
+			// numbers stay aligned.
+		}
+		dirPaths.push_back(dirPath);
+
+		// Next entry. The directory identifier is padded to an even length.
+		p += sizeof(ISO_Path_Table_Entry) + ((entry->dir_id_length + 1) & ~1U);
+	}
+
+	// Path table loaded.
+	pathTableLoaded = true;
+	return 0;
+}
+
+/**
+ * Get a directory's data, using the caches if possible.
+ * @param path Directory path. (lowercased, no leading or trailing slashes; empty for root)
+ * @return Directory data, or nullptr on error.
+ */
+const ao::uvector<uint8_t> *IsoPartitionPrivate::getDirectory(const string &path)
+{
+	RP_Q(IsoPartition);
+	if (path.empty()) {
+		// Root directory.
+		if (loadRootDirectory() != 0) {
+			return nullptr;
+		}
+		return &rootDir_data;
+	}
+
+	// Check the directory extent cache.
+	auto dirIter = map_dirData.find(path);
+	if (dirIter != map_dirData.end()) {
+		return &dirIter->second;
+	}
+
+	// Look up the directory in the path table index.
+	if (loadPathTable() != 0) {
+		return nullptr;
+	}
+	auto ptIter = map_pathTable.find(path);
+	if (ptIter == map_pathTable.end()) {
+		// Directory not found.
+		q->m_lastError = ENOENT;
+		return nullptr;
+	}
+
+	// Block size.
+	// Should be 2048, but other values are possible.
+	const unsigned int block_size = pvd.logical_block_size.he;
+
+	const uint32_t dir_block = ptIter->second;
+	if (dir_block < static_cast<uint32_t>(iso_start_offset)) {
+		// Starting block is invalid.
+		q->m_lastError = EIO;
+		return nullptr;
+	}
+	const off64_t dir_addr = partition_offset +
+		static_cast<off64_t>(dir_block - iso_start_offset) * block_size;
+
+	// The directory's extent length is stored in its own
+	// "." entry, which is the first record in the extent.
+	ISO_DirEntry dotEntry;
+	size_t size = q->m_discReader->seekAndRead(dir_addr, &dotEntry, sizeof(dotEntry));
+	if (size != sizeof(dotEntry)) {
+		// Seek and/or read error.
+		q->m_lastError = EIO;
+		return nullptr;
+	}
+	if (dotEntry.entry_length < sizeof(dotEntry) ||
+	    !(dotEntry.flags & ISO_FLAG_DIRECTORY) ||
+	    dotEntry.size.he > 16*1024*1024)
+	{
+		// Invalid "." entry, or the directory is too big.
+		q->m_lastError = EIO;
+		return nullptr;
+	}
+
+	// Load the directory.
+	// NOTE: Due to variable-length entries, we need to load
+	// the entire directory all at once.
+	ao::uvector<uint8_t> dirData;
+	dirData.resize(dotEntry.size.he);
+	size = q->m_discReader->seekAndRead(dir_addr, dirData.data(), dirData.size());
+	if (size != dirData.size()) {
+		// Seek and/or read error.
+		q->m_lastError = q->m_discReader->lastError();
+		if (q->m_lastError == 0) {
+			q->m_lastError = EIO;
+		}
+		return nullptr;
+	}
+
+	// Cache the directory data.
+	auto ins = map_dirData.insert(std::make_pair(path, std::move(dirData)));
+	return &ins.first->second;
+}
+
 /** IsoPartition **/
 
 /**
@@ -318,6 +543,22 @@ off64_t IsoPartition::partition_size_used(void) const
 
 /** IsoPartition **/
 
+/**
+ * Get the ISO-9660 Primary Volume Descriptor.
+ * This can be used to create an ISO RomData object
+ * for the same image without re-reading the PVD.
+ * @return PVD, or nullptr if it isn't loaded.
+ */
+const ISO_Primary_Volume_Descriptor *IsoPartition::pvd(void) const
+{
+	RP_D(const IsoPartition);
+	if (d->pvd.header.type != ISO_VDT_PRIMARY) {
+		// PVD isn't loaded.
+		return nullptr;
+	}
+	return &d->pvd;
+}
+
 /** GcnFst wrapper functions. **/
 
 // TODO
@@ -395,8 +636,6 @@ IRpFile *IsoPartition::open(const char *filename)
 	// TODO: File reference counter.
 	// This might be difficult to do because PartitionFile is a separate class.
 
-	// TODO: Support subdirectories.
-
 	if (!filename || filename[0] == 0) {
 		// No filename.
 		m_lastError = EINVAL;
@@ -416,22 +655,38 @@ IRpFile *IsoPartition::open(const char *filename)
 	// Assuming cp1252...
 	string s_filename = utf8_to_cp1252(filename, -1);
 
-	if (d->rootDir_data.empty()) {
-		// Root directory isn't loaded.
-		if (d->loadRootDirectory() != 0) {
-			// Root directory load failed.
-			m_lastError = EIO;
-			return nullptr;
-		}
+	// Split the directory path from the filename.
+	// The directory path is lowercased for the path table index.
+	string s_dirpath;
+	const size_t slash_pos = s_filename.rfind('/');
+	if (slash_pos != string::npos) {
+		s_dirpath = s_filename.substr(0, slash_pos);
+		s_filename.erase(0, slash_pos + 1);
+		std::transform(s_dirpath.begin(), s_dirpath.end(), s_dirpath.begin(),
+			[](char c) { return std::tolower(static_cast<unsigned char>(c)); });
+	}
+	if (s_filename.empty()) {
+		// No filename after the directory path.
+		m_lastError = EINVAL;
+		return nullptr;
+	}
+
+	// Get the directory. Extents are cached, so repeated opens
+	// from the same directory don't re-read it.
+	const ao::uvector<uint8_t> *const dir_data = d->getDirectory(s_dirpath);
+	if (!dir_data) {
+		// Directory not found, or a load error occurred.
+		// m_lastError is set by getDirectory().
+		return nullptr;
 	}
 
-	// Find the file in the root directory.
+	// Find the file in the directory.
 	// NOTE: Filenames are case-insensitive.
 	// NOTE: File might have a ";1" suffix.
 	const unsigned int filename_len = static_cast<unsigned int>(s_filename.size());
 	const ISO_DirEntry *dirEntry_found = nullptr;
-	const uint8_t *p = d->rootDir_data.data();
-	const uint8_t *const p_end = p + d->rootDir_data.size();
+	const uint8_t *p = dir_data->data();
+	const uint8_t *const p_end = p + dir_data->size();
 	while (p < p_end) {
 		const ISO_DirEntry *dirEntry = reinterpret_cast<const ISO_DirEntry*>(p);
 		if (dirEntry->entry_length < sizeof(*dirEntry)) {
@@ -12,6 +12,8 @@
 #include "librpbase/disc/IPartition.hpp"
 //#include "librpbase/disc/IFst.hpp"
 
+#include "../iso_structs.h"
+
 namespace LibRomData {
 
 class IsoPartitionPrivate;
@@ -89,6 +91,17 @@ class IsoPartition : public LibRpBase::IPartition
 		 */
 		off64_t partition_size_used(void) const final;
 
+	public:
+		/** IsoPartition **/
+
+		/**
+		 * Get the ISO-9660 Primary Volume Descriptor.
+		 * This can be used to create an ISO RomData object
+		 * for the same image without re-reading the PVD.
+		 * @return PVD, or nullptr if it isn't loaded.
+		 */
+		const ISO_Primary_Volume_Descriptor *pvd(void) const;
+
 	public:
 		/** IFst wrapper functions. **/
 
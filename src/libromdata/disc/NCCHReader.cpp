@@ -41,6 +41,7 @@ NCCHReaderPrivate::NCCHReaderPrivate(NCCHReader *q,
 #ifdef ENABLE_DECRYPTION
 	, tid_be(0)
 	, cipher(nullptr)
+	, decCacheLRU(0)
 	, tmd_content_index(0)
 	, isDebug(false)
 #endif /* ENABLE_DECRYPTION */
@@ -164,8 +165,7 @@ NCCHReaderPrivate::NCCHReaderPrivate(NCCHReader *q,
 			// ExeFS header uses ncchKey0.
 			cipher->setKey(ncch_keys[0].u8, sizeof(ncch_keys[0].u8));
 			ctr.init_ctr(tid_be, N3DS_NCCH_SECTION_EXEFS, 0);
-			cipher->setIV(ctr.u8, sizeof(ctr.u8));
-			cipher->decrypt(reinterpret_cast<uint8_t*>(&exefs_header), sizeof(exefs_header));
+			cipher->decryptCTR(reinterpret_cast<uint8_t*>(&exefs_header), sizeof(exefs_header), ctr.u8);
 
 			// For CXI: First file should be ".code".
 			// For CFA: First file should be "icon".
@@ -217,8 +217,7 @@ NCCHReaderPrivate::NCCHReaderPrivate(NCCHReader *q,
 				// ExeFS header uses ncchKey0.
 				cipher->setKey(ncch_keys[0].u8, sizeof(ncch_keys[0].u8));
 				ctr.init_ctr(tid_be, N3DS_NCCH_SECTION_EXEFS, 0);
-				cipher->setIV(ctr.u8, sizeof(ctr.u8));
-				cipher->decrypt(reinterpret_cast<uint8_t*>(&exefs_header), sizeof(exefs_header));
+				cipher->decryptCTR(reinterpret_cast<uint8_t*>(&exefs_header), sizeof(exefs_header), ctr.u8);
 
 				// Check the first filename, again.
 				if (strcmp(exefs_header.files[0].name, ".code") != 0 &&
@@ -395,6 +394,59 @@ size_t NCCHReaderPrivate::readFromROM(uint32_t offset, void *ptr, size_t size)
 	return sz_read;
 }
 
+#ifdef ENABLE_DECRYPTION
+/**
+ * Check the decrypted-region cache for a given range.
+ * @param address	[in] Starting address, relative to the beginning of the NCCH.
+ * @param size		[in] Size of the range, in bytes.
+ * @return Pointer to the decrypted data, or nullptr if not cached.
+ */
+const uint8_t *NCCHReaderPrivate::findDecCache(uint32_t address, size_t size)
+{
+	for (auto iter = decCache.begin(); iter != decCache.end(); ++iter) {
+		if (address >= iter->address &&
+		    (address - iter->address) + size <= iter->data.size())
+		{
+			// Requested range is fully contained in this entry.
+			iter->lru = ++decCacheLRU;
+			return iter->data.data() + (address - iter->address);
+		}
+	}
+
+	// Not cached.
+	return nullptr;
+}
+
+/**
+ * Add a decrypted region to the cache.
+ * @param address	[in] Starting address, relative to the beginning of the NCCH.
+ * @param data		[in] Decrypted data.
+ * @param size		[in] Size of the data, in bytes.
+ */
+void NCCHReaderPrivate::addDecCache(uint32_t address, const uint8_t *data, size_t size)
+{
+	DecCacheEntry *entry;
+	if (decCache.size() < DEC_CACHE_ENTRIES_MAX) {
+		// Add a new entry.
+		decCache.resize(decCache.size() + 1);
+		entry = &decCache.back();
+	} else {
+		// Evict the least-recently-used entry.
+		entry = &decCache[0];
+		for (auto iter = decCache.begin() + 1; iter != decCache.end(); ++iter) {
+			if (iter->lru < entry->lru) {
+				entry = &(*iter);
+			}
+		}
+	}
+
+	entry->address = address;
+	entry->lru = ++decCacheLRU;
+	entry->data.resize(size);
+	memcpy(entry->data.data(), data, size);
+}
+#endif /* ENABLE_DECRYPTION */
+
 /**
  * Load the NCCH Extended Header.
  * @return 0 on success; non-zero on error.
@@ -587,6 +639,19 @@ size_t NCCHReader::read(void *ptr, size_t size)
 		return 0;
 	}
 
+	// Check the decrypted-region cache first.
+	// The hot regions (ExeFS header, SMDH icon, ExHeader)
+	// are read in several passes by the 3DS parser.
+	const uint8_t *pCached = d->findDecCache(d->pos, size);
+	if (pCached) {
+		memcpy(ptr, pCached, size);
+		d->pos += static_cast<uint32_t>(size);
+		return size;
+	}
+
+	const uint32_t start_pos = d->pos;
+	const size_t req_size = size;
+
 	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
 	size_t sz_total_read = 0;
 	while (size > 0) {
@@ -626,11 +691,12 @@ size_t NCCHReader::read(void *ptr, size_t size)
 			// Initialize the counter based on section and offset.
 			u128_t ctr;
 			ctr.init_ctr(d->tid_be, section->section, d->pos - section->ctr_base);
-			d->cipher->setIV(ctr.u8, sizeof(ctr.u8));
 
 			// Decrypt the data.
+			// The whole read is decrypted in a single batched
+			// call so the cipher can pipeline across blocks.
 			// FIXME: Round up to 16 if a short read occurred?
-			ret_sz = d->cipher->decrypt(static_cast<uint8_t*>(ptr), ret_sz);
+			ret_sz = d->cipher->decryptCTR(static_cast<uint8_t*>(ptr), ret_sz, ctr.u8);
 		}
 
 		d->pos += static_cast<uint32_t>(ret_sz);
@@ -647,6 +713,13 @@ size_t NCCHReader::read(void *ptr, size_t size)
 		}
 	}
 
+	// Cache small, fully-successful reads for later passes.
+	if (sz_total_read == req_size &&
+	    sz_total_read <= NCCHReaderPrivate::DEC_CACHE_SIZE_MAX)
+	{
+		d->addDecCache(start_pos, static_cast<const uint8_t*>(ptr), sz_total_read);
+	}
+
 	return sz_total_read;
 #else /* !ENABLE_DECRYPTION */
 	// Decryption is not enabled.
@@ -27,6 +27,10 @@
 // C++ includes.
 #include <vector>
 
+// Uninitialized vector class.
+// Reference: http://andreoffringa.org/?q=uvector
+#include "librpbase/uvector.h"
+
 #ifdef ENABLE_DECRYPTION
 namespace LibRpBase {
 	class IAesCipher;
@@ -153,6 +157,37 @@ class NCCHReaderPrivate
 		 */
 		int findEncSection(uint32_t address) const;
 
+		// Decrypted-region cache.
+		// The 3DS parser reads the hot regions (ExeFS header,
+		// SMDH icon, ExHeader) in several passes, so keep
+		// decrypted copies of small reads and turn repeated
+		// reads over the same range into memcpy().
+		static const unsigned int DEC_CACHE_SIZE_MAX = 64U*1024;
+		static const unsigned int DEC_CACHE_ENTRIES_MAX = 8;
+		struct DecCacheEntry {
+			uint32_t address;	// Relative to the start of the NCCH.
+			uint64_t lru;		// Last-use counter for eviction.
+			ao::uvector<uint8_t> data;
+		};
+		std::vector<DecCacheEntry> decCache;
+		uint64_t decCacheLRU;	// Monotonic use counter.
+
+		/**
+		 * Check the decrypted-region cache for a given range.
+		 * @param address	[in] Starting address, relative to the beginning of the NCCH.
+		 * @param size		[in] Size of the range, in bytes.
+		 * @return Pointer to the decrypted data, or nullptr if not cached.
+		 */
+		const uint8_t *findDecCache(uint32_t address, size_t size);
+
+		/**
+		 * Add a decrypted region to the cache.
+		 * @param address	[in] Starting address, relative to the beginning of the NCCH.
+		 * @param data		[in] Decrypted data.
+		 * @param size		[in] Size of the data, in bytes.
+		 */
+		void addDecCache(uint32_t address, const uint8_t *data, size_t size);
+
 		// TMD content index.
 		uint16_t tmd_content_index;
 
@@ -16,7 +16,6 @@ using namespace LibRpFile;
 // C++ STL classes.
 using std::string;
 using std::unique_ptr;
-using std::unordered_map;
 using std::vector;
 
 namespace LibRomData {
@@ -37,16 +36,10 @@ class NEResourceReaderPrivate
 		uint32_t rsrc_tbl_addr;
 		uint32_t rsrc_tbl_size;
 
-		// Resource table entry.
-		struct ResTblEntry {
-			uint16_t id;	// Resource ID.
-			uint32_t addr;	// Address of the resource data. (0 = start of EXE)
-			uint32_t len;	// Length of the resource data.
-		};
-		typedef ao::uvector<ResTblEntry> rsrc_dir_t;
-
-		// Resource types.
-		unordered_map<uint16_t, rsrc_dir_t> res_types;
+		// Flattened resource table, sorted by (type, id).
+		// NOTE: NE resources don't have a language level,
+		// so the language field is always 0.
+		IResourceReader::res_tbl_t res_tbl;
 
 		/**
 		 * Load the resource table.
@@ -184,8 +177,8 @@ int NEResourceReaderPrivate::loadResTbl(void)
 	}
 	unsigned int pos = 2;
 
-	// Initialize the resource types list.
-	res_types.clear();
+	// Initialize the flattened resource table.
+	res_tbl.clear();
 
 	// TODO: Overflow prevention.
 	// TODO: Use pointers for pos and endpos?
@@ -215,26 +208,7 @@ int NEResourceReaderPrivate::loadResTbl(void)
 		}
 		pos += sizeof(NE_TYPEINFO);
 
-		// Check if the resource type already exists.
-		auto iter_find = res_types.find(rtTypeID);
-		assert(iter_find == res_types.end());
-		if (iter_find != res_types.end()) {
-			// Multiple table entries for the same resource type.
-			break;
-		}
-
-		// Create a new vector for the resource type.
-		auto iter_type = res_types.insert(std::make_pair(rtTypeID, rsrc_dir_t()));
-		assert(iter_type.second);
-		if (!iter_type.second) {
-			// Error adding to the map.
-			ret = -ENOMEM;
-			break;
-		}
-		rsrc_dir_t &dir = iter_type.first->second;
 		const unsigned int resCount = le16_to_cpu(typeInfo->rtResourceCount);
-		dir.resize(resCount);
-		unsigned int entriesRead = 0;
 		bool isErr = false;
 		for (unsigned int i = 0; i < resCount; i++) {
 			// Read a NAMEINFO struct.
@@ -253,22 +227,28 @@ int NEResourceReaderPrivate::loadResTbl(void)
 			}
 
 			// Add the resource information.
-			auto &entry = dir[entriesRead];
-			entry.id = rnID;
+			// NOTE: NE resources don't have a language level.
+			IResourceReader::FlatResEntry entry;
+			entry.key = IResourceReader::resTblKey(rtTypeID, rnID, 0);
 			// NOTE: Wine shifts both addr and len; all documentation
 			// I can find says only addr is shifted, but then the len
 			// value is too small...
 			entry.addr = le32_to_cpu(nameInfo->rnOffset) << rscAlignShift;
 			entry.len = le16_to_cpu(nameInfo->rnLength) << rscAlignShift;
-			entriesRead++;
+			res_tbl.push_back(entry);
 		}
 		if (isErr)
 			break;
-
-		// Shrink the vector in case we skipped some entries.
-		dir.resize(entriesRead);
 	}
 
+	if (ret == 0) {
+		// Sort the table by key for binary search.
+		std::sort(res_tbl.begin(), res_tbl.end(),
+			[](const IResourceReader::FlatResEntry &lhs, const IResourceReader::FlatResEntry &rhs) -> bool {
+				return (lhs.key < rhs.key);
+			}
+		);
+	}
 	return ret;
 }
 
@@ -642,35 +622,17 @@ IRpFile *NEResourceReader::open(uint16_t type, int id, int lang)
 
 	// NOTE: Type and resource IDs have the high bit set for integers.
 	// We're only supporting integer IDs, so set the high bits here.
+	// (Wildcard IDs stay -1: all bits are already set.)
 	type |= 0x8000;
 	id |= 0x8000;
 
-	// Get the directory for the specified type.
-	auto iter_dir = d->res_types.find(type);
-	if (iter_dir == d->res_types.end())
-		return nullptr;
-	auto &dir = iter_dir->second;
-	if (dir.empty())
+	// Find the resource in the flattened table.
+	// NOTE: NE resources don't have a language level,
+	// so the language ID is always treated as a wildcard.
+	const FlatResEntry *const entry = findResTblEntry(d->res_tbl, type, id, -1);
+	if (!entry) {
+		// Not found.
 		return nullptr;
-	
-	const NEResourceReaderPrivate::ResTblEntry *entry = nullptr;
-	if (id == -1) {
-		// Get the first ID for this type.
-		entry = &dir[0];
-	} else {
-		// Search for the ID.
-		// TODO: unordered_map?
-		auto iter = std::find_if(dir.cbegin(), dir.cend(),
-			[id](const NEResourceReaderPrivate::ResTblEntry &entry) -> bool {
-				return (entry.id == static_cast<uint16_t>(id));
-			}
-		);
-		if (iter != dir.cend()) {
-			entry = &(*iter);
-		} else {
-			// ID not found.
-			return nullptr;
-		}
 	}
 
 	// Create the PartitionFile.
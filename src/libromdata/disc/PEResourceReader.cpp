@@ -16,7 +16,6 @@ using namespace LibRpFile;
 // C++ STL classes.
 using std::string;
 using std::unique_ptr;
-using std::unordered_map;
 using std::vector;
 
 // Uninitialized vector class.
@@ -54,18 +53,9 @@ class PEResourceReaderPrivate
 		};
 		typedef ao::uvector<ResDirEntry> rsrc_dir_t;
 
-		// Resource types. (Top-level directory.)
-		rsrc_dir_t res_types;
-
-		// Cached top-level directories. (type)
-		// Key: type
-		// Value: Resources contained within the directory.
-		unordered_map<uint16_t, rsrc_dir_t> type_dirs;
-
-		// Cached second-level directories. (type and ID)
-		// Key: LOWORD == type, HIWORD == id
-		// Value: Resources contained within the directory.
-		unordered_map<uint32_t, rsrc_dir_t> type_and_id_dirs;
+		// Flattened resource table, sorted by (type, id, lang).
+		// Built once at open; lookups are binary searches.
+		IResourceReader::res_tbl_t res_tbl;
 
 		/**
 		 * Load a resource directory.
@@ -80,19 +70,14 @@ class PEResourceReaderPrivate
 		int loadResDir(uint32_t addr, rsrc_dir_t &dir);
 
 		/**
-		 * Get the resource directory for the specified type.
-		 * @param type Resource type.
-		 * @return Resource directory, or nullptr if not found.
-		 */
-		const rsrc_dir_t *getTypeDir(uint16_t type);
-
-		/**
-		 * Get the resource directory for the specified type and ID.
-		 * @param type Resource type.
-		 * @param id Resource ID.
-		 * @return Resource directory, or nullptr if not found.
+		 * Build the flattened resource table.
+		 *
+		 * Walks the three directory levels (type, ID, language)
+		 * once and flattens the leaf entries into res_tbl.
+		 *
+		 * @return 0 on success; negative POSIX error code on error.
 		 */
-		const rsrc_dir_t *getTypeIdDir(uint16_t type, uint16_t id);
+		int buildResTbl(void);
 
 		/**
 		 * Read the section header in a PE version resource.
@@ -164,9 +149,9 @@ PEResourceReaderPrivate::PEResourceReaderPrivate(
 		return;
 	}
 
-	// Load the root resource directory.
-	int ret = loadResDir(0, res_types);
-	if (ret <= 0) {
+	// Build the flattened resource table.
+	int ret = buildResTbl();
+	if (ret != 0) {
 		// No resources, or an error occurred.
 		q->m_file->unref();
 		q->m_file = nullptr;
@@ -240,104 +225,71 @@ int PEResourceReaderPrivate::loadResDir(uint32_t addr, rsrc_dir_t &dir)
 }
 
 /**
- * Get the resource directory for the specified type.
- * @param type Resource type.
- * @return Resource directory, or nullptr if not found.
+ * Build the flattened resource table.
+ *
+ * Walks the three directory levels (type, ID, language)
+ * once and flattens the leaf entries into res_tbl.
+ *
+ * @return 0 on success; negative POSIX error code on error.
  */
-const PEResourceReaderPrivate::rsrc_dir_t *PEResourceReaderPrivate::getTypeDir(uint16_t type)
+int PEResourceReaderPrivate::buildResTbl(void)
 {
-	// Check if the type is already cached.
-	auto iter_td = type_dirs.find(type);
-	if (iter_td != type_dirs.end()) {
-		// Type is already cached.
-		return &(iter_td->second);
+	// Load the root resource directory. (resource types)
+	rsrc_dir_t res_types;
+	int ret = loadResDir(0, res_types);
+	if (ret <= 0) {
+		// No resources, or an error occurred.
+		return (ret < 0 ? ret : -ENOENT);
 	}
 
-	// Not cached. Find the type in the root directory.
-	auto iter = std::find_if(res_types.cbegin(), res_types.cend(),
-		[type](const ResDirEntry &entry) -> bool {
-			return (entry.id == type);
+	// Walk the tree: type -> ID -> language.
+	// Leaf entries point to IMAGE_RESOURCE_DATA_ENTRY.
+	rsrc_dir_t id_dir, lang_dir;
+	for (const ResDirEntry &type_entry : res_types) {
+		if (!(type_entry.addr & 0x80000000)) {
+			// Type entry is not a subdirectory.
+			continue;
 		}
-	);
+		if (loadResDir(type_entry.addr & ~0x80000000, id_dir) <= 0)
+			continue;
 
-	uint32_t type_addr = 0;
-	if (iter != res_types.cend()) {
-		// Make sure this type is a subdirectory.
-		if (iter->addr & 0x80000000) {
-			// This is a subdirectory.
-			type_addr = (iter->addr & ~0x80000000);
+		for (const ResDirEntry &id_entry : id_dir) {
+			if (!(id_entry.addr & 0x80000000)) {
+				// ID entry is not a subdirectory.
+				continue;
+			}
+			if (loadResDir(id_entry.addr & ~0x80000000, lang_dir) <= 0)
+				continue;
+
+			for (const ResDirEntry &lang_entry : lang_dir) {
+				if (lang_entry.addr & 0x80000000) {
+					// Language entry should be a file,
+					// not another subdirectory.
+					continue;
+				}
+
+				IResourceReader::FlatResEntry entry;
+				entry.key = IResourceReader::resTblKey(
+					type_entry.id, id_entry.id, lang_entry.id);
+				entry.addr = lang_entry.addr;
+				entry.len = 0;	// Determined by IMAGE_RESOURCE_DATA_ENTRY.
+				res_tbl.push_back(entry);
+			}
 		}
 	}
 
-	if (type_addr == 0) {
-		// Not found.
-		return nullptr;
-	}
-
-	// Load the directory.
-	auto iter_type = type_dirs.insert(std::make_pair(type, rsrc_dir_t()));
-	if (!iter_type.second) {
-		// Error adding to the map.
-		return nullptr;
-	}
-	rsrc_dir_t *type_dir = &(iter_type.first->second);
-	loadResDir(type_addr, *type_dir);
-	return type_dir;
-}
-
-/**
- * Get the resource directory for the specified type and ID.
- * @param type Resource type.
- * @param id Resource ID.
- * @return Resource directory, or nullptr if not found.
- */
-const PEResourceReaderPrivate::rsrc_dir_t *PEResourceReaderPrivate::getTypeIdDir(uint16_t type, uint16_t id)
-{
-	// Check if the type and ID is already cached.
-	uint32_t type_and_id = (type | (static_cast<uint32_t>(id) << 16));
-	auto iter_td = type_and_id_dirs.find(type_and_id);
-	if (iter_td != type_and_id_dirs.end()) {
-		// Type and ID is already cached.
-		return &(iter_td->second);
-	}
-
-	// Not cached. Find the type in the root directory.
-	const rsrc_dir_t *type_dir = getTypeDir(type);
-	if (!type_dir) {
-		// Type not found.
-		return nullptr;
+	if (res_tbl.empty()) {
+		// No usable resources.
+		return -ENOENT;
 	}
 
-	// Find the ID in the type directory.
-	auto iter = std::find_if(type_dir->cbegin(), type_dir->cend(),
-		[id](const ResDirEntry &entry) -> bool {
-			return (entry.id == id);
+	// Sort the table by key for binary search.
+	std::sort(res_tbl.begin(), res_tbl.end(),
+		[](const IResourceReader::FlatResEntry &lhs, const IResourceReader::FlatResEntry &rhs) -> bool {
+			return (lhs.key < rhs.key);
 		}
 	);
-
-	uint32_t id_addr = 0;
-	if (iter != type_dir->cend()) {
-		// Make sure this ID is a subdirectory.
-		if (iter->addr & 0x80000000) {
-			// This is a subdirectory.
-			id_addr = (iter->addr & ~0x80000000);
-		}
-	}
-
-	if (id_addr == 0) {
-		// Not found.
-		return nullptr;
-	}
-
-	// Load the directory.
-	auto iter_type_and_id = type_and_id_dirs.insert(std::make_pair(type_and_id, rsrc_dir_t()));
-	if (!iter_type_and_id.second) {
-		// Error adding to the map.
-		return nullptr;
-	}
-	rsrc_dir_t *id_dir = &(iter_type_and_id.first->second);
-	loadResDir(id_addr, *id_dir);
-	return id_dir;
+	return 0;
 }
 
 /**
@@ -701,54 +653,17 @@ off64_t PEResourceReader::partition_size_used(void) const
  */
 IRpFile *PEResourceReader::open(uint16_t type, int id, int lang)
 {
-	// Check if the directory has been cached.
+	// Find the resource in the flattened table.
 	RP_D(PEResourceReader);
-
-	if (id == -1) {
-		// Get the first ID for this type.
-		const PEResourceReaderPrivate::rsrc_dir_t *type_dir = d->getTypeDir(type);
-		if (!type_dir || type_dir->empty())
-			return nullptr;
-		id = type_dir->at(0).id;
-	}
-
-	// Get the directory for the type and ID.
-	const PEResourceReaderPrivate::rsrc_dir_t *type_id_dir =
-		d->getTypeIdDir(type, static_cast<uint16_t>(id));
-	if (!type_id_dir || type_id_dir->empty())
-		return nullptr;
-
-	const PEResourceReaderPrivate::ResDirEntry *dirEntry = nullptr;
-	if (lang == -1) {
-		// Get the first language for this type.
-		dirEntry = &type_id_dir->at(0);
-	} else {
-		// Find the specified language ID.
-		auto iter = std::find_if(type_id_dir->cbegin(), type_id_dir->cend(),
-			[lang](const PEResourceReaderPrivate::ResDirEntry &entry) -> bool {
-				return (entry.id == static_cast<uint16_t>(lang));
-			}
-		);
-
-		if (iter == type_id_dir->cend()) {
-			// Not found.
-			return nullptr;
-		}
-
-		// Found the language ID.
-		dirEntry = &(*iter);
-	}
-
-	// Make sure this is a file.
-	assert(!(dirEntry->addr & 0x80000000));
-	if (dirEntry->addr & 0x80000000) {
-		// This is a subdirectory.
+	const FlatResEntry *const entry = findResTblEntry(d->res_tbl, type, id, lang);
+	if (!entry) {
+		// Not found.
 		return nullptr;
 	}
 
 	// Get the IMAGE_RESOURCE_DATA_ENTRY.
 	IMAGE_RESOURCE_DATA_ENTRY irdata;
-	size_t size = m_file->seekAndRead(d->rsrc_addr + dirEntry->addr, &irdata, sizeof(irdata));
+	size_t size = m_file->seekAndRead(d->rsrc_addr + entry->addr, &irdata, sizeof(irdata));
 	if (size != sizeof(irdata)) {
 		// Seek and/or read error.
 		m_lastError = m_file->lastError();
@@ -0,0 +1,166 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * StfsReader.cpp: Microsoft Xbox 360 STFS data block reader.              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Reference: https://github.com/Free60Project/wiki/blob/master/STFS.md
+
+#include "stdafx.h"
+#include "StfsReader.hpp"
+#include "librpbase/disc/SparseDiscReader_p.hpp"
+
+// librpbase, librpfile
+using namespace LibRpBase;
+using LibRpFile::IRpFile;
+
+namespace LibRomData {
+
+class StfsReaderPrivate : public SparseDiscReaderPrivate {
+	public:
+		StfsReaderPrivate(StfsReader *q);
+
+	private:
+		typedef SparseDiscReaderPrivate super;
+		RP_DISABLE_COPY(StfsReaderPrivate)
+
+	public:
+		// Flat data-block to physical-block translation map.
+		// Built once at open; indexed by data block number.
+		ao::uvector<uint32_t> blockMap;
+
+		// Start of the block area, in bytes.
+		off64_t dataStart;
+};
+
+/** StfsReaderPrivate **/
+
+StfsReaderPrivate::StfsReaderPrivate(StfsReader *q)
+	: super(q)
+	, dataStart(0)
+{ }
+
+/** StfsReader **/
+
+/**
+ * Construct an StfsReader with the specified file.
+ * The file is ref()'d, so the original file can be
+ * unref()'d by the caller afterwards.
+ *
+ * @param file	[in] File to read from.
+ * @param headerSize	[in] STFS header size, in bytes. (host-endian)
+ * @param desc	[in] STFS volume descriptor. (big-endian, as read from the package)
+ * @param isCON	[in] True if this is a console-signed (CON) package.
+ */
+StfsReader::StfsReader(IRpFile *file, uint32_t headerSize,
+	const STFS_Volume_Descriptor *desc, bool isCON)
+	: super(new StfsReaderPrivate(this), file)
+{
+	if (!m_file) {
+		// File could not be ref()'d.
+		return;
+	}
+
+	RP_D(StfsReader);
+	d->block_size = STFS_BLOCK_SIZE;
+	d->dataStart = (headerSize + 0xFFF) & 0xF000;
+
+	// Block shift for hash table sizing.
+	// Only applies to console-signed packages.
+	int blockShift;
+	if (d->dataStart == 0xB000) {
+		blockShift = 1;
+	} else {
+		blockShift = ((desc->block_separation & 1) == 1 ? 0 : 1);
+	}
+
+	// Number of allocated data blocks.
+	// Sanity check: The BE24 block numbers limit packages
+	// to 0xFFFFFF physical blocks.
+	const uint32_t blockCount = be32_to_cpu(desc->total_alloc_block_count);
+	if (blockCount == 0 || blockCount > 0xFFFFFF) {
+		// Invalid block count.
+		m_file->unref();
+		m_file = nullptr;
+		m_lastError = EIO;
+		return;
+	}
+
+	// Build the translation map.
+	// A hash block is inserted before every 0xAA data blocks,
+	// with additional second- and third-level hash blocks every
+	// 0xAA^2 and 0xAA^3 blocks.
+	d->blockMap.resize(blockCount);
+	for (uint32_t i = 0; i < blockCount; i++) {
+		uint32_t base = ((i + 0xAA) / 0xAA);
+		if (isCON) {
+			base <<= blockShift;
+		}
+
+		uint32_t physBlock = (base + i);
+		if (i > 0xAA) {
+			base = ((i + 0x70E4) / 0x70E4);
+			if (isCON) {
+				base <<= blockShift;
+			}
+			physBlock += base;
+
+			if (i > 0x70E4) {
+				base = ((i + 0x4AF768) / 0x4AF768);
+				if (isCON) {
+					base <<= blockShift;
+				}
+				physBlock += base;
+			}
+		}
+
+		d->blockMap[i] = physBlock;
+	}
+
+	// Image size is the data block count.
+	d->disc_size = static_cast<off64_t>(blockCount) * STFS_BLOCK_SIZE;
+
+	// Reset the disc position.
+	d->pos = 0;
+}
+
+/**
+ * Is a disc image supported by this object?
+ * NOTE: STFS cannot be detected from the data blocks alone,
+ * so this always returns -1. Use Xbox360_STFS for detection.
+ * @param pHeader Disc image header.
+ * @param szHeader Size of header.
+ * @return Class-specific disc format ID (>= 0) if supported; -1 if not.
+ */
+int StfsReader::isDiscSupported(const uint8_t *pHeader, size_t szHeader) const
+{
+	RP_UNUSED(pHeader);
+	RP_UNUSED(szHeader);
+	return -1;
+}
+
+/** SparseDiscReader functions. **/
+
+/**
+ * Get the physical address of the specified logical block index.
+ *
+ * @param blockIdx	[in] Block index.
+ * @return Physical address. (0 == empty block; -1 == invalid block index)
+ */
+off64_t StfsReader::getPhysBlockAddr(uint32_t blockIdx) const
+{
+	// Make sure the block index is in range.
+	RP_D(StfsReader);
+	assert(blockIdx < d->blockMap.size());
+	if (blockIdx >= d->blockMap.size()) {
+		// Out of range.
+		return -1;
+	}
+
+	return d->dataStart +
+		(static_cast<off64_t>(d->blockMap[blockIdx]) * STFS_BLOCK_SIZE);
+}
+
+}
@@ -0,0 +1,78 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * StfsReader.hpp: Microsoft Xbox 360 STFS data block reader.              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DISC_STFSREADER_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_DISC_STFSREADER_HPP__
+
+#include "../Console/xbox360_stfs_structs.h"
+
+#include "librpbase/disc/SparseDiscReader.hpp"
+
+namespace LibRomData {
+
+class StfsReaderPrivate;
+
+/**
+ * Presents the data blocks of an STFS package as a contiguous image.
+ *
+ * STFS interleaves hash blocks with the data blocks, so file contents
+ * are not contiguous in the package. The data-block-to-physical-block
+ * translation is precomputed into a flat array at open, so reads are
+ * direct offset lookups, and the SparseDiscReader block logic handles
+ * reads spanning hash-block boundaries.
+ */
+class StfsReader : public LibRpBase::SparseDiscReader
+{
+	public:
+		/**
+		 * Construct an StfsReader with the specified file.
+		 * The file is ref()'d, so the original file can be
+		 * unref()'d by the caller afterwards.
+		 *
+		 * @param file	[in] File to read from.
+		 * @param headerSize	[in] STFS header size, in bytes. (host-endian)
+		 * @param desc	[in] STFS volume descriptor. (big-endian, as read from the package)
+		 * @param isCON	[in] True if this is a console-signed (CON) package.
+		 */
+		StfsReader(LibRpFile::IRpFile *file, uint32_t headerSize,
+			const STFS_Volume_Descriptor *desc, bool isCON);
+
+	private:
+		typedef SparseDiscReader super;
+		RP_DISABLE_COPY(StfsReader)
+	private:
+		friend class StfsReaderPrivate;
+
+	public:
+		/** Disc image detection functions. **/
+
+		/**
+		 * Is a disc image supported by this object?
+		 * NOTE: STFS cannot be detected from the data blocks alone,
+		 * so this always returns -1. Use Xbox360_STFS for detection.
+		 * @param pHeader Disc image header.
+		 * @param szHeader Size of header.
+		 * @return Class-specific disc format ID (>= 0) if supported; -1 if not.
+		 */
+		int isDiscSupported(const uint8_t *pHeader, size_t szHeader) const final;
+
+	protected:
+		/** SparseDiscReader functions. **/
+
+		/**
+		 * Get the physical address of the specified logical block index.
+		 *
+		 * @param blockIdx	[in] Block index.
+		 * @return Physical address. (0 == empty block; -1 == invalid block index)
+		 */
+		off64_t getPhysBlockAddr(uint32_t blockIdx) const final;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DISC_STFSREADER_HPP__ */
@@ -33,6 +33,12 @@ class WbfsReaderPrivate : public SparseDiscReaderPrivate {
 
 		const be16_t *wlba_table;	// Pointer to m_wbfs_disc->disc->header->wlba_table.
 
+		// Native-endian copy of wlba_table[], converted at open time.
+		// Values are physical block indices. 0 == empty block.
+		// This makes getPhysBlockAddr() a single array load instead
+		// of a byteswap per access.
+		ao::uvector<uint16_t> wlba_native;
+
 		/** WBFS functions. **/
 
 		/**
@@ -368,6 +374,15 @@ WbfsReader::WbfsReader(IRpFile *file)
 	d->block_size = d->m_wbfs->wbfs_sec_sz;
 	d->pos = 0;	// Reset the read position.
 
+	// Convert the LBA table to native-endian.
+	// Deep scans resolve millions of blocks, so doing the
+	// byteswap once at open time keeps it out of the hot path.
+	const unsigned int n_wbfs_sec = d->m_wbfs->n_wbfs_sec_per_disc;
+	d->wlba_native.resize(n_wbfs_sec);
+	for (unsigned int i = 0; i < n_wbfs_sec; i++) {
+		d->wlba_native[i] = be16_to_cpu(d->wlba_table[i]);
+	}
+
 	// Get the size of the WBFS disc.
 	d->disc_size = d->getWbfsDiscSize(d->m_wbfs_disc);
 }
@@ -424,14 +439,14 @@ off64_t WbfsReader::getPhysBlockAddr(uint32_t blockIdx) const
 {
 	// Make sure the block index is in range.
 	RP_D(WbfsReader);
-	assert(blockIdx < d->m_wbfs_disc->p->n_wbfs_sec_per_disc);
-	if (blockIdx >= d->m_wbfs_disc->p->n_wbfs_sec_per_disc) {
+	assert(blockIdx < d->wlba_native.size());
+	if (blockIdx >= d->wlba_native.size()) {
 		// Out of range.
 		return -1;
 	}
 
 	// Get the physical block index.
-	const unsigned int physBlockIdx = be16_to_cpu(d->wlba_table[blockIdx]);
+	const unsigned int physBlockIdx = d->wlba_native[blockIdx];
 	if (physBlockIdx == 0) {
 		// Empty block.
 		return 0;
@@ -0,0 +1,453 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * WiaReader.cpp: GameCube/Wii WIA and RVZ disc image reader.              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// References:
+// - https://wit.wiimm.de/info/wia.html
+// - https://github.com/dolphin-emu/dolphin/blob/master/Source/Core/DiscIO/WIABlob.cpp
+
+#include "stdafx.h"
+#include "WiaReader.hpp"
+#include "librpbase/disc/SparseDiscReader_p.hpp"
+#include "wia_structs.h"
+
+// librpbase, librpfile
+using namespace LibRpBase;
+using LibRpFile::IRpFile;
+
+// C++ STL classes.
+using std::unique_ptr;
+
+namespace LibRomData {
+
+class WiaReaderPrivate : public SparseDiscReaderPrivate {
+	public:
+		WiaReaderPrivate(WiaReader *q);
+
+	private:
+		typedef SparseDiscReaderPrivate super;
+		RP_DISABLE_COPY(WiaReaderPrivate)
+
+	public:
+		// Is this an RVZ image?
+		bool isRVZ;
+
+		// Group table.
+		// Byteswapped to host-endian on load.
+		ao::uvector<WIA_GroupEntry> groupTable;
+
+		// Chunk map: chunk index -> group table index.
+		// Special value: 0xFFFFFFFF == chunk is not covered by any
+		// group. This includes Wii partition data, which is stored
+		// with hashes removed and can't be reconstructed here, so
+		// those chunks read back as zero bytes.
+		ao::uvector<uint32_t> chunkMap;
+		static const uint32_t CHUNK_EMPTY = 0xFFFFFFFF;
+};
+
+/** WiaReaderPrivate **/
+
+WiaReaderPrivate::WiaReaderPrivate(WiaReader *q)
+	: super(q)
+	, isRVZ(false)
+{ }
+
+/** WiaReader **/
+
+WiaReader::WiaReader(IRpFile *file)
+	: super(new WiaReaderPrivate(this), file)
+{
+	if (!m_file) {
+		// File could not be ref()'d.
+		return;
+	}
+
+	// Read the WIA file header.
+	RP_D(WiaReader);
+	WIA_FileHeader fileHeader;
+	m_file->rewind();
+	size_t sz = m_file->read(&fileHeader, sizeof(fileHeader));
+	if (sz != sizeof(fileHeader)) {
+		// Error reading the WIA file header.
+		m_file->unref();
+		m_file = nullptr;
+		m_lastError = EIO;
+		return;
+	}
+
+	// Verify the magic.
+	if (fileHeader.magic == cpu_to_be32(WIA_MAGIC)) {
+		d->isRVZ = false;
+	} else if (fileHeader.magic == cpu_to_be32(RVZ_MAGIC)) {
+		d->isRVZ = true;
+	} else {
+		// Invalid magic.
+		m_file->unref();
+		m_file = nullptr;
+		m_lastError = EIO;
+		return;
+	}
+
+	// Read the WIA disc header.
+	// Located immediately after the file header.
+	WIA_DiscHeader discHeader;
+	if (be32_to_cpu(fileHeader.disc_struct_size) < sizeof(discHeader)) {
+		// Disc header is too small.
+		m_file->unref();
+		m_file = nullptr;
+		m_lastError = EIO;
+		return;
+	}
+	sz = m_file->read(&discHeader, sizeof(discHeader));
+	if (sz != sizeof(discHeader)) {
+		// Error reading the WIA disc header.
+		m_file->unref();
+		m_file = nullptr;
+		m_lastError = EIO;
+		return;
+	}
+
+	// Only uncompressed images are supported.
+	// The data tables are stored in plaintext in this case.
+	// NOTE: bzip2, LZMA, and zstd are not available here,
+	// so compressed images can't be decoded.
+	if (be32_to_cpu(discHeader.compression) != WIA_COMPRESSION_NONE) {
+		// Compressed image.
+		m_file->unref();
+		m_file = nullptr;
+		m_lastError = EIO;
+		return;
+	}
+
+	// Verify the chunk size.
+	// WIA uses multiples of 2 MB; RVZ allows power-of-two
+	// chunk sizes down to 32 KB.
+	const uint32_t chunk_size = be32_to_cpu(discHeader.chunk_size);
+	if (chunk_size < 0x8000 || chunk_size > 64U*1024*1024 ||
+	    (chunk_size & (chunk_size - 1)) != 0)
+	{
+		// Invalid chunk size.
+		m_file->unref();
+		m_file = nullptr;
+		m_lastError = EIO;
+		return;
+	}
+
+	// Verify the table sizes.
+	const uint32_t num_raw_data = be32_to_cpu(discHeader.num_raw_data);
+	const uint32_t num_groups = be32_to_cpu(discHeader.num_groups);
+	if (num_raw_data == 0 || num_raw_data > 4096 ||
+	    num_groups == 0 || num_groups > 4U*1024*1024)
+	{
+		// Table sizes are out of range.
+		m_file->unref();
+		m_file = nullptr;
+		m_lastError = EIO;
+		return;
+	}
+
+	// Read the raw data table.
+	ao::uvector<WIA_RawDataEntry> rawDataTable;
+	rawDataTable.resize(num_raw_data);
+	size_t sz_table = rawDataTable.size() * sizeof(WIA_RawDataEntry);
+	sz = m_file->seekAndRead(be64_to_cpu(discHeader.raw_data_off),
+		rawDataTable.data(), sz_table);
+	if (sz != sz_table) {
+		// Error reading the raw data table.
+		m_file->unref();
+		m_file = nullptr;
+		m_lastError = EIO;
+		return;
+	}
+
+	// Read the group table.
+	d->groupTable.resize(num_groups);
+	sz_table = d->groupTable.size() * sizeof(WIA_GroupEntry);
+	sz = m_file->seekAndRead(be64_to_cpu(discHeader.group_off),
+		d->groupTable.data(), sz_table);
+	if (sz != sz_table) {
+		// Error reading the group table.
+		d->groupTable.clear();
+		m_file->unref();
+		m_file = nullptr;
+		m_lastError = EIO;
+		return;
+	}
+
+	// Byteswap the group table to host-endian.
+#if SYS_BYTEORDER == SYS_LIL_ENDIAN
+	for (auto iter = d->groupTable.begin(); iter != d->groupTable.end(); ++iter) {
+		iter->data_off4 = be32_to_cpu(iter->data_off4);
+		iter->data_size = be32_to_cpu(iter->data_size);
+	}
+#endif /* SYS_BYTEORDER == SYS_LIL_ENDIAN */
+
+	// Disc parameters.
+	d->block_size = chunk_size;
+	d->disc_size = static_cast<off64_t>(be64_to_cpu(fileHeader.iso_file_size));
+	if (d->disc_size <= 0) {
+		// Invalid disc size.
+		d->groupTable.clear();
+		m_file->unref();
+		m_file = nullptr;
+		m_lastError = EIO;
+		return;
+	}
+
+	// Build the chunk map from the raw data entries.
+	// Chunks not covered by any raw data entry (i.e. Wii partition
+	// data) are left empty and will read back as zero bytes.
+	const uint32_t chunkCount = static_cast<uint32_t>(
+		(d->disc_size + chunk_size - 1) / chunk_size);
+	d->chunkMap.resize(chunkCount);
+	memset(d->chunkMap.data(), 0xFF, d->chunkMap.size() * sizeof(uint32_t));
+	for (auto iter = rawDataTable.cbegin(); iter != rawDataTable.cend(); ++iter) {
+		// The first group covers the disc area starting at
+		// raw_data_off rounded down to the chunk size.
+		const uint64_t start_chunk = be64_to_cpu(iter->raw_data_off) / chunk_size;
+		const uint32_t group_index = be32_to_cpu(iter->group_index);
+		const uint32_t entry_groups = be32_to_cpu(iter->num_groups);
+		for (uint32_t i = 0; i < entry_groups; i++) {
+			const uint64_t chunkIdx = start_chunk + i;
+			const uint32_t groupIdx = group_index + i;
+			if (chunkIdx >= chunkCount || groupIdx >= num_groups) {
+				// Out of range.
+				break;
+			}
+			d->chunkMap[static_cast<size_t>(chunkIdx)] = groupIdx;
+		}
+	}
+
+	// Reset the disc position.
+	d->pos = 0;
+}
+
+/**
+ * Is a disc image supported by this class?
+ * @param pHeader Disc image header.
+ * @param szHeader Size of header.
+ * @return Class-specific disc format ID (>= 0) if supported; -1 if not.
+ */
+int WiaReader::isDiscSupported_static(const uint8_t *pHeader, size_t szHeader)
+{
+	if (szHeader < sizeof(WIA_FileHeader)) {
+		// Not enough data to check.
+		return -1;
+	}
+
+	// Check the WIA/RVZ magic.
+	const WIA_FileHeader *const wiaHeader =
+		reinterpret_cast<const WIA_FileHeader*>(pHeader);
+	if (wiaHeader->magic != cpu_to_be32(WIA_MAGIC) &&
+	    wiaHeader->magic != cpu_to_be32(RVZ_MAGIC))
+	{
+		// Invalid magic.
+		return -1;
+	}
+
+	// This is a valid WIA/RVZ image.
+	// NOTE: Compression is checked in the constructor, since the
+	// compression field is past the usual probe header size.
+	return 0;
+}
+
+/**
+ * Is a disc image supported by this object?
+ * @param pHeader Disc image header.
+ * @param szHeader Size of header.
+ * @return Class-specific system ID (>= 0) if supported; -1 if not.
+ */
+int WiaReader::isDiscSupported(const uint8_t *pHeader, size_t szHeader) const
+{
+	return isDiscSupported_static(pHeader, szHeader);
+}
+
+/** SparseDiscReader functions. **/
+
+/**
+ * Get the physical address of the specified logical block index.
+ *
+ * NOTE: WIA/RVZ groups can be stored with fewer bytes than the
+ * chunk size, with the rest zero-filled on read. The overridden
+ * readBlock() and readBlocks() handle this; this function is
+ * only implemented for the SparseDiscReader contract.
+ *
+ * @param blockIdx	[in] Block index.
+ * @return Physical address. (0 == empty block; -1 == invalid block index)
+ */
+off64_t WiaReader::getPhysBlockAddr(uint32_t blockIdx) const
+{
+	// Make sure the block index is in range.
+	RP_D(WiaReader);
+	assert(blockIdx < d->chunkMap.size());
+	if (blockIdx >= d->chunkMap.size()) {
+		// Out of range.
+		return -1;
+	}
+
+	const uint32_t groupIdx = d->chunkMap[blockIdx];
+	if (groupIdx == WiaReaderPrivate::CHUNK_EMPTY) {
+		// Chunk is not covered by any group.
+		return 0;
+	}
+
+	const WIA_GroupEntry &group = d->groupTable[groupIdx];
+	if (group.data_size == 0) {
+		// Empty group.
+		return 0;
+	}
+
+	// Get the physical block address.
+	return static_cast<off64_t>(group.data_off4) << 2;
+}
+
+/**
+ * Read the specified block.
+ *
+ * This can read either a full block or a partial block.
+ * For a full block, set pos = 0 and size = block_size.
+ *
+ * @param blockIdx	[in] Block index.
+ * @param ptr		[out] Output data buffer.
+ * @param pos		[in] Starting position. (Must be >= 0 and <= the block size!)
+ * @param size		[in] Amount of data to read, in bytes. (Must be <= the block size!)
+ * @return Number of bytes read, or -1 if the block index is invalid.
+ */
+int WiaReader::readBlock(uint32_t blockIdx, void *ptr, int pos, size_t size)
+{
+	// Read 'size' bytes of block 'blockIdx', starting at 'pos'.
+	// NOTE: This can only be called by SparseDiscReader,
+	// so the main assertions are already checked there.
+	RP_D(WiaReader);
+	assert(pos >= 0 && pos < (int)d->block_size);
+	assert(size <= d->block_size);
+	if (pos < 0 || static_cast<off64_t>(pos + size) > static_cast<off64_t>(d->block_size)) {
+		// pos+size is out of range.
+		return -1;
+	}
+
+	if (unlikely(size == 0)) {
+		// Nothing to read.
+		return 0;
+	}
+
+	// Check the block cache first.
+	const uint8_t *const pCached = d->findCachedBlock(blockIdx);
+	if (pCached) {
+		// Block is cached.
+		memcpy(ptr, &pCached[pos], size);
+		return static_cast<int>(size);
+	}
+
+	// Make sure the block index is in range.
+	assert(blockIdx < d->chunkMap.size());
+	if (blockIdx >= d->chunkMap.size()) {
+		// Out of range.
+		return -1;
+	}
+
+	const uint32_t groupIdx = d->chunkMap[blockIdx];
+	if (groupIdx == WiaReaderPrivate::CHUNK_EMPTY) {
+		// Chunk is not covered by any group.
+		memset(ptr, 0, size);
+		return static_cast<int>(size);
+	}
+
+	const WIA_GroupEntry &group = d->groupTable[groupIdx];
+	uint32_t data_size = group.data_size;
+	if (d->isRVZ && (data_size & RVZ_GROUP_DATA_SIZE_PACKED)) {
+		// RVZ packed group. Junk data encoding isn't supported.
+		m_lastError = EIO;
+		return -1;
+	}
+	if (data_size == 0) {
+		// Empty group.
+		memset(ptr, 0, size);
+		return static_cast<int>(size);
+	}
+
+	// Groups can store fewer bytes than the chunk size.
+	// The rest of the chunk is zero-filled.
+	const uint32_t stored = (data_size < d->block_size ? data_size : d->block_size);
+	const off64_t physBlockAddr = static_cast<off64_t>(group.data_off4) << 2;
+
+	if ((pos != 0 || size != d->block_size) &&
+	    d->block_size <= SparseDiscReaderPrivate::BLOCK_CACHE_SIZE_MAX)
+	{
+		// Partial block read.
+		// Read the full block and cache it, then copy out the
+		// requested portion. (See SparseDiscReader::readBlock().)
+		unique_ptr<uint8_t[]> blockData(new uint8_t[d->block_size]);
+		const size_t sz_read = m_file->seekAndRead(physBlockAddr, blockData.get(), stored);
+		m_lastError = m_file->lastError();
+		if (sz_read != stored) {
+			// Error reading the group data.
+			return -1;
+		}
+		if (stored < d->block_size) {
+			memset(&blockData[stored], 0, d->block_size - stored);
+		}
+
+		memcpy(ptr, &blockData[pos], size);
+		d->cacheBlock(blockIdx, std::move(blockData));
+		return static_cast<int>(size);
+	}
+
+	// Read the stored portion directly and zero-fill the rest.
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	size_t sz_data = 0;
+	if (static_cast<uint32_t>(pos) < stored) {
+		sz_data = stored - pos;
+		if (sz_data > size) {
+			sz_data = size;
+		}
+		const size_t sz_read = m_file->seekAndRead(physBlockAddr + pos, ptr8, sz_data);
+		m_lastError = m_file->lastError();
+		if (sz_read != sz_data) {
+			// Error reading the group data.
+			return (sz_read > 0 ? (int)sz_read : -1);
+		}
+	}
+	if (sz_data < size) {
+		memset(&ptr8[sz_data], 0, size - sz_data);
+	}
+	return static_cast<int>(size);
+}
+
+/**
+ * Read consecutive full blocks.
+ *
+ * The default implementation's run coalescing assumes blocks are
+ * fully stored at their physical addresses, which doesn't hold
+ * for short groups. Read the blocks one at a time instead.
+ *
+ * @param blockIdx	[in] Starting block index.
+ * @param blockCount	[in] Number of blocks to read.
+ * @param ptr		[out] Output data buffer. (blockCount * block_size bytes)
+ * @return Number of bytes read, or -1 if the block index is invalid.
+ */
+int WiaReader::readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr)
+{
+	RP_D(WiaReader);
+	const uint32_t block_size = d->block_size;
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	int ret = 0;
+
+	for (; blockCount > 0; blockIdx++, blockCount--) {
+		int rd = this->readBlock(blockIdx, ptr8, 0, block_size);
+		if (rd < 0 || rd != static_cast<int>(block_size)) {
+			// Error reading the data.
+			return ret + (rd > 0 ? rd : 0);
+		}
+		ret += block_size;
+		ptr8 += block_size;
+	}
+
+	return ret;
+}
+
+}
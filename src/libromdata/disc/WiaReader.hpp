@@ -0,0 +1,105 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * WiaReader.hpp: GameCube/Wii WIA and RVZ disc image reader.              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DISC_WIAREADER_HPP__
+#define __ROMPROPERTIES_LIBROMDATA_DISC_WIAREADER_HPP__
+
+#include "librpbase/disc/SparseDiscReader.hpp"
+
+namespace LibRomData {
+
+class WiaReaderPrivate;
+class WiaReader : public LibRpBase::SparseDiscReader
+{
+	public:
+		/**
+		 * Construct a WiaReader with the specified file.
+		 * The file is ref()'d, so the original file can be
+		 * unref()'d by the caller afterwards.
+		 *
+		 * NOTE: Only uncompressed WIA/RVZ images are supported.
+		 * Wii partition data is stored with hashes removed, so
+		 * partition contents read back as zero bytes.
+		 *
+		 * @param file File to read from.
+		 */
+		explicit WiaReader(LibRpFile::IRpFile *file);
+
+	private:
+		typedef SparseDiscReader super;
+		RP_DISABLE_COPY(WiaReader)
+	private:
+		friend class WiaReaderPrivate;
+
+	public:
+		/** Disc image detection functions. **/
+
+		/**
+		 * Is a disc image supported by this class?
+		 * @param pHeader Disc image header.
+		 * @param szHeader Size of header.
+		 * @return Class-specific disc format ID (>= 0) if supported; -1 if not.
+		 */
+		static int isDiscSupported_static(const uint8_t *pHeader, size_t szHeader);
+
+		/**
+		 * Is a disc image supported by this object?
+		 * @param pHeader Disc image header.
+		 * @param szHeader Size of header.
+		 * @return Class-specific disc format ID (>= 0) if supported; -1 if not.
+		 */
+		int isDiscSupported(const uint8_t *pHeader, size_t szHeader) const final;
+
+	protected:
+		/** SparseDiscReader functions. **/
+
+		/**
+		 * Get the physical address of the specified logical block index.
+		 *
+		 * NOTE: WIA/RVZ groups can be stored with fewer bytes than the
+		 * chunk size, with the rest zero-filled on read. The overridden
+		 * readBlock() and readBlocks() handle this; this function is
+		 * only implemented for the SparseDiscReader contract.
+		 *
+		 * @param blockIdx	[in] Block index.
+		 * @return Physical address. (0 == empty block; -1 == invalid block index)
+		 */
+		off64_t getPhysBlockAddr(uint32_t blockIdx) const final;
+
+		/**
+		 * Read the specified block.
+		 *
+		 * This can read either a full block or a partial block.
+		 * For a full block, set pos = 0 and size = block_size.
+		 *
+		 * @param blockIdx	[in] Block index.
+		 * @param ptr		[out] Output data buffer.
+		 * @param pos		[in] Starting position. (Must be >= 0 and <= the block size!)
+		 * @param size		[in] Amount of data to read, in bytes. (Must be <= the block size!)
+		 * @return Number of bytes read, or -1 if the block index is invalid.
+		 */
+		int readBlock(uint32_t blockIdx, void *ptr, int pos, size_t size) final;
+
+		/**
+		 * Read consecutive full blocks.
+		 *
+		 * The default implementation's run coalescing assumes blocks are
+		 * fully stored at their physical addresses, which doesn't hold
+		 * for short groups. Read the blocks one at a time instead.
+		 *
+		 * @param blockIdx	[in] Starting block index.
+		 * @param blockCount	[in] Number of blocks to read.
+		 * @param ptr		[out] Output data buffer. (blockCount * block_size bytes)
+		 * @return Number of bytes read, or -1 if the block index is invalid.
+		 */
+		int readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr) final;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DISC_WIAREADER_HPP__ */
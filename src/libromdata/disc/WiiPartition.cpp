@@ -21,7 +21,11 @@
 using namespace LibRpBase;
 using LibRpFile::IRpFile;
 
+// librpthreads
+#include "librpthreads/Semaphore.hpp"
+
 // C++ STL classes.
+#include <thread>
 using std::unique_ptr;
 
 #include "GcnPartitionPrivate.hpp"
@@ -72,17 +76,61 @@ class WiiPartitionPrivate : public GcnPartitionPrivate
 		// Decrypted sector cache.
 		// NOTE: Actual data starts at 0x400.
 		// Hashes and the sector IV are stored first.
-		uint32_t sector_num;				// Sector number.
-		uint8_t sector_buf[SECTOR_SIZE_ENCRYPTED];	// Decrypted sector data.
+		uint32_t sector_num;		// Sector number.
+		uint8_t *sector_buf;		// Current decrypted sector. (points into sector_cache)
+
+		// FST traversal re-reads the same sectors many times,
+		// so keep a small LRU cache of decrypted sectors.
+		static const unsigned int SECTOR_CACHE_ENTRIES = 16;
+		struct SectorCacheEntry {
+			uint32_t sector_num;			// Sector number.
+			uint64_t lru;				// Last-use counter.
+			unique_ptr<uint8_t[]> data;		// Decrypted sector data. (SECTOR_SIZE_ENCRYPTED bytes)
+		};
+		SectorCacheEntry sector_cache[SECTOR_CACHE_ENTRIES];
+		uint64_t sector_cache_lru;	// Monotonic use counter.
+
+		/** Sector read pipeline. **/
+		// A worker thread reads the raw data for sector N+1
+		// while the calling thread decrypts sector N, so
+		// sequential reads don't stall on alternating I/O
+		// and crypto.
+		std::thread *pf_thread;		// Prefetch worker thread.
+		Semaphore pf_req;		// Released when a prefetch is requested.
+		Semaphore pf_done;		// Released when a prefetch has completed.
+		uint32_t pf_sector_num;		// Sector being prefetched.
+		bool pf_pending;		// True if the worker is busy.
+		bool pf_valid;			// True if pf_buf has valid raw data.
+		bool pf_exit;			// Worker exit request.
+		uint8_t pf_buf[SECTOR_SIZE_ENCRYPTED];	// Raw (encrypted) sector data.
+
+		/**
+		 * Prefetch worker thread function.
+		 */
+		void prefetchThread(void);
+
+		/**
+		 * Start a background raw read of the specified sector.
+		 * No-op if a prefetch is already in progress or the
+		 * sector has already been prefetched.
+		 * @param sector_num Sector number. (address / 0x7C00)
+		 */
+		void prefetchSector(uint32_t sector_num);
+
+		/**
+		 * Wait for a pending background read to complete, if any.
+		 */
+		void drainPrefetch(void);
 
 		/**
 		 * Read and decrypt a sector.
 		 * The decrypted sector is stored in sector_buf.
 		 *
 		 * @param sector_num Sector number. (address / 0x7C00)
+		 * @param prefetch_next If true, read the next sector in the background.
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
-		int readSector(uint32_t sector_num);
+		int readSector(uint32_t sector_num, bool prefetch_next = false);
 
 #ifdef ENABLE_DECRYPTION
 	public:
@@ -165,6 +213,15 @@ WiiPartitionPrivate::WiiPartitionPrivate(WiiPartition *q,
 	, cryptoMethod(cryptoMethod)
 	, pos_7C00(-1)
 	, sector_num(~0)
+	, sector_buf(nullptr)
+	, sector_cache_lru(0)
+	, pf_thread(nullptr)
+	, pf_req(0)
+	, pf_done(0)
+	, pf_sector_num(~0)
+	, pf_pending(false)
+	, pf_valid(false)
+	, pf_exit(false)
 	, aes_title(nullptr)
 #else /* !ENABLE_DECRYPTION */
 	, verifyResult(KeyManager::VERIFY_NO_SUPPORT)
@@ -173,6 +230,15 @@ WiiPartitionPrivate::WiiPartitionPrivate(WiiPartition *q,
 	, cryptoMethod(cryptoMethod)
 	, pos_7C00(-1)
 	, sector_num(~0)
+	, sector_buf(nullptr)
+	, sector_cache_lru(0)
+	, pf_thread(nullptr)
+	, pf_req(0)
+	, pf_done(0)
+	, pf_sector_num(~0)
+	, pf_pending(false)
+	, pf_valid(false)
+	, pf_exit(false)
 #endif /* ENABLE_DECRYPTION */
 {
 	// NOTE: The discReader parameter is needed because
@@ -377,25 +443,112 @@ KeyManager::VerifyResult WiiPartitionPrivate::initDecryption(void)
 
 WiiPartitionPrivate::~WiiPartitionPrivate()
 {
+	if (pf_thread) {
+		// Stop the prefetch worker thread.
+		drainPrefetch();
+		pf_exit = true;
+		pf_req.release();
+		pf_thread->join();
+		delete pf_thread;
+	}
+
 #ifdef ENABLE_DECRYPTION
 	delete aes_title;
 #endif /* ENABLE_DECRYPTION */
 }
 
+/**
+ * Prefetch worker thread function.
+ */
+void WiiPartitionPrivate::prefetchThread(void)
+{
+	RP_Q(WiiPartition);
+	while (true) {
+		pf_req.obtain();
+		if (pf_exit)
+			break;
+
+		// Read the raw sector data.
+		// NOTE: The requesting thread doesn't touch m_discReader
+		// until it has drained this request, so the worker has
+		// exclusive access here.
+		pf_valid = false;
+		off64_t sector_addr = partition_offset + data_offset;
+		sector_addr += (static_cast<off64_t>(pf_sector_num) * SECTOR_SIZE_ENCRYPTED);
+		if (q->m_discReader->seek(sector_addr) == 0) {
+			size_t sz = q->m_discReader->read(pf_buf, sizeof(pf_buf));
+			pf_valid = (sz == SECTOR_SIZE_ENCRYPTED);
+		}
+		pf_done.release();
+	}
+}
+
+/**
+ * Start a background raw read of the specified sector.
+ * No-op if a prefetch is already in progress or the
+ * sector has already been prefetched.
+ * @param sector_num Sector number. (address / 0x7C00)
+ */
+void WiiPartitionPrivate::prefetchSector(uint32_t sector_num)
+{
+	if (pf_pending) {
+		// A prefetch is already in progress.
+		return;
+	}
+	if (pf_valid && pf_sector_num == sector_num) {
+		// Sector has already been prefetched.
+		return;
+	}
+
+	if (!pf_thread) {
+		// Start the prefetch worker thread.
+		pf_thread = new std::thread(&WiiPartitionPrivate::prefetchThread, this);
+	}
+
+	pf_sector_num = sector_num;
+	pf_valid = false;
+	pf_pending = true;
+	pf_req.release();
+}
+
+/**
+ * Wait for a pending background read to complete, if any.
+ */
+void WiiPartitionPrivate::drainPrefetch(void)
+{
+	if (pf_pending) {
+		pf_done.obtain();
+		pf_pending = false;
+	}
+}
+
 /**
  * Read and decrypt a sector.
  * The decrypted sector is stored in sector_buf.
  *
  * @param sector_num Sector number. (address / 0x7C00)
+ * @param prefetch_next If true, read the next sector in the background.
  * @return 0 on success; negative POSIX error code on error.
  */
-int WiiPartitionPrivate::readSector(uint32_t sector_num)
+int WiiPartitionPrivate::readSector(uint32_t sector_num, bool prefetch_next)
 {
 	if (this->sector_num == sector_num) {
 		// Sector is already in memory.
 		return 0;
 	}
 
+	// Check the decrypted sector cache.
+	for (unsigned int i = 0; i < SECTOR_CACHE_ENTRIES; i++) {
+		SectorCacheEntry &entry = sector_cache[i];
+		if (entry.data && entry.sector_num == sector_num) {
+			// Sector is cached.
+			entry.lru = ++sector_cache_lru;
+			sector_buf = entry.data.get();
+			this->sector_num = sector_num;
+			return 0;
+		}
+	}
+
 	RP_Q(WiiPartition);
 	const bool isCrypted = ((cryptoMethod & WiiPartition::CM_MASK_ENCRYPTED) == WiiPartition::CM_ENCRYPTED);
 #ifndef ENABLE_DECRYPTION
@@ -406,33 +559,65 @@ int WiiPartitionPrivate::readSector(uint32_t sector_num)
 	}
 #endif /* !ENABLE_DECRYPTION */
 
-	// NOTE: This function doesn't check verifyResult,
-	// since it's called by initDecryption() before
-	// verifyResult is set.
-	off64_t sector_addr = partition_offset + data_offset;
-	sector_addr += (static_cast<off64_t>(sector_num) * SECTOR_SIZE_ENCRYPTED);
+	// Select a cache entry to decrypt into. (LRU eviction)
+	SectorCacheEntry *entry = &sector_cache[0];
+	for (unsigned int i = 0; i < SECTOR_CACHE_ENTRIES; i++) {
+		if (!sector_cache[i].data) {
+			// Unused entry.
+			entry = &sector_cache[i];
+			break;
+		}
+		if (sector_cache[i].lru < entry->lru) {
+			entry = &sector_cache[i];
+		}
+	}
+	if (!entry->data) {
+		entry->data.reset(new uint8_t[SECTOR_SIZE_ENCRYPTED]);
+	}
+	uint8_t *const buf = entry->data.get();
+	// Invalidate the entry until the sector is fully decrypted.
+	entry->sector_num = ~0;
+
+	// Wait for any pending background read.
+	drainPrefetch();
 
-	int ret = q->m_discReader->seek(sector_addr);
-	if (ret != 0) {
-		q->m_lastError = q->m_discReader->lastError();
-		return ret;
+	if (pf_valid && pf_sector_num == sector_num) {
+		// Raw sector data was read in the background.
+		memcpy(buf, pf_buf, SECTOR_SIZE_ENCRYPTED);
+		pf_valid = false;
+	} else {
+		// NOTE: This function doesn't check verifyResult,
+		// since it's called by initDecryption() before
+		// verifyResult is set.
+		off64_t sector_addr = partition_offset + data_offset;
+		sector_addr += (static_cast<off64_t>(sector_num) * SECTOR_SIZE_ENCRYPTED);
+
+		int ret = q->m_discReader->seek(sector_addr);
+		if (ret != 0) {
+			q->m_lastError = q->m_discReader->lastError();
+			return ret;
+		}
+
+		size_t sz = q->m_discReader->read(buf, SECTOR_SIZE_ENCRYPTED);
+		if (sz != SECTOR_SIZE_ENCRYPTED) {
+			this->sector_num = ~0;
+			q->m_lastError = EIO;
+			return -1;
+		}
 	}
 
-	size_t sz = q->m_discReader->read(sector_buf, sizeof(sector_buf));
-	if (sz != SECTOR_SIZE_ENCRYPTED) {
-		// sector_buf may be invalid.
-		this->sector_num = ~0;
-		q->m_lastError = EIO;
-		return -1;
+	if (prefetch_next) {
+		// Read the next sector in the background
+		// while this one is being decrypted.
+		prefetchSector(sector_num + 1);
 	}
 
 #ifdef ENABLE_DECRYPTION
 	if (isCrypted) {
 		// Decrypt the sector.
-		if (aes_title->decrypt(&sector_buf[SECTOR_SIZE_DECRYPTED_OFFSET], SECTOR_SIZE_DECRYPTED,
-		    &sector_buf[0x3D0], 16) != SECTOR_SIZE_DECRYPTED)
+		if (aes_title->decrypt(&buf[SECTOR_SIZE_DECRYPTED_OFFSET], SECTOR_SIZE_DECRYPTED,
+		    &buf[0x3D0], 16) != SECTOR_SIZE_DECRYPTED)
 		{
-			// sector_buf may be invalid.
 			this->sector_num = ~0;
 			q->m_lastError = EIO;
 			return -1;
@@ -441,6 +626,9 @@ int WiiPartitionPrivate::readSector(uint32_t sector_num)
 #endif /* ENABLE_DECRYPTION */
 
 	// Sector read and decrypted.
+	entry->sector_num = sector_num;
+	entry->lru = ++sector_cache_lru;
+	sector_buf = buf;
 	this->sector_num = sector_num;
 	return 0;
 }
@@ -470,14 +658,20 @@ WiiPartition::WiiPartition(IDiscReader *discReader, off64_t partition_offset,
 	}
 
 	// Read the partition header.
+	// The full header is 32 KB, but only the ticket, the section
+	// offsets, and the TMD are actually used, so read the fixed
+	// portion first and then just the TMD. Multi-partition discs
+	// (update + game + channel) used to pay for a full 32 KB read
+	// per partition on open.
 	RP_D(WiiPartition);
+	static const size_t PTHDR_FIXED_SIZE = offsetof(RVL_PartitionHeader, tmd);
 	if (discReader->seek(partition_offset) != 0) {
 		m_lastError = discReader->lastError();
 		this->m_discReader = nullptr;
 		return;
 	}
-	size_t size = discReader->read(&d->partitionHeader, sizeof(d->partitionHeader));
-	if (size != sizeof(d->partitionHeader)) {
+	size_t size = discReader->read(&d->partitionHeader, PTHDR_FIXED_SIZE);
+	if (size != PTHDR_FIXED_SIZE) {
 		m_lastError = EIO;
 		this->m_discReader = nullptr;
 		return;
@@ -491,6 +685,23 @@ WiiPartition::WiiPartition(IDiscReader *discReader, off64_t partition_offset,
 		return;
 	}
 
+	// Read the TMD, if it's located within the partition header.
+	// NOTE: A TMD read failure is not fatal; the TMD area remains
+	// zeroed, and tmdHeader() will return nullptr.
+	const off64_t tmd_addr = static_cast<off64_t>(be32_to_cpu(d->partitionHeader.tmd_offset)) << 2;
+	const uint32_t tmd_size = be32_to_cpu(d->partitionHeader.tmd_size);
+	if (tmd_size != 0 &&
+	    tmd_addr >= static_cast<off64_t>(PTHDR_FIXED_SIZE) &&
+	    tmd_addr + tmd_size <= static_cast<off64_t>(sizeof(d->partitionHeader)))
+	{
+		uint8_t *const tmd_dest = reinterpret_cast<uint8_t*>(&d->partitionHeader) + tmd_addr;
+		size = discReader->seekAndRead(partition_offset + tmd_addr, tmd_dest, tmd_size);
+		if (size != tmd_size) {
+			// Short read. Re-zero the TMD area.
+			memset(tmd_dest, 0, tmd_size);
+		}
+	}
+
 	// Save important data.
 	d->data_offset = static_cast<off64_t>(be32_to_cpu(d->partitionHeader.data_offset)) << 2;
 	d->data_size   = static_cast<off64_t>(be32_to_cpu(d->partitionHeader.data_size)) << 2;
@@ -559,7 +770,7 @@ size_t WiiPartition::read(void *ptr, size_t size)
 
 			// Read and decrypt the sector.
 			const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_ENCRYPTED);
-			d->readSector(blockStart);
+			d->readSector(blockStart, size > read_sz);
 
 			// Copy data from the sector.
 			memcpy(ptr8, &d->sector_buf[blockStartOffset], read_sz);
@@ -580,7 +791,7 @@ size_t WiiPartition::read(void *ptr, size_t size)
 
 			// Read the sector.
 			const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_ENCRYPTED);
-			d->readSector(blockStart);
+			d->readSector(blockStart, size > SECTOR_SIZE_ENCRYPTED);
 
 			// Copy data from the sector.
 			memcpy(ptr8, d->sector_buf, SECTOR_SIZE_ENCRYPTED);
@@ -645,7 +856,7 @@ size_t WiiPartition::read(void *ptr, size_t size)
 
 			// Read and decrypt the sector.
 			const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_DECRYPTED);
-			d->readSector(blockStart);
+			d->readSector(blockStart, size > read_sz);
 
 			// Copy data from the sector.
 			memcpy(ptr8, &d->sector_buf[SECTOR_SIZE_DECRYPTED_OFFSET + blockStartOffset], read_sz);
@@ -666,7 +877,7 @@ size_t WiiPartition::read(void *ptr, size_t size)
 
 			// Read and decrypt the sector.
 			const uint32_t blockStart = static_cast<uint32_t>(d->pos_7C00 / SECTOR_SIZE_DECRYPTED);
-			d->readSector(blockStart);
+			d->readSector(blockStart, size > SECTOR_SIZE_DECRYPTED);
 
 			// Copy data from the sector.
 			memcpy(ptr8, &d->sector_buf[SECTOR_SIZE_DECRYPTED_OFFSET], SECTOR_SIZE_DECRYPTED);
@@ -689,6 +900,11 @@ size_t WiiPartition::read(void *ptr, size_t size)
 		}
 	}
 
+	// Don't leave a background read running when we return;
+	// other objects may share the underlying disc reader.
+	// The prefetched raw data is kept for the next read.
+	d->drainPrefetch();
+
 	// Finished reading the data.
 	return ret;
 }
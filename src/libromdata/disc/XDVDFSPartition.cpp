@@ -41,12 +41,33 @@ class XDVDFSPartitionPrivate
 		// All fields are byteswapped in the constructor.
 		XDVDFS_Header xdvdfsHeader;
 
+		// Cached directory table.
+		// NOTE: Directory entries are variable-length, so the
+		// raw table is a byte array, not an XDVDFS_DirEntry array.
+		struct DirTable {
+			// Raw directory table from the disc.
+			ao::uvector<uint8_t> data;
+
+			// Byte offsets of the directory entries within data,
+			// sorted by filename. The on-disc AVL tree is
+			// flattened into this index once at load time, so
+			// lookups are an in-memory binary search instead of
+			// a tree walk.
+			std::vector<uint32_t> index;
+		};
+
 		// Cached directories.
-		// - Key: Directory. ("/" for root)
-		// - Value: Raw directory table from the disc.
-		// NOTE: Directory entries are variable-length, so this
-		// is a byte array, not an ISO_DirEntry array.
-		unordered_map<std::string, ao::uvector<uint8_t> > dirTables;
+		// - Key: Directory path, lowercased. ("/" for root)
+		// - Value: Directory table and filename index.
+		unordered_map<std::string, DirTable> dirTables;
+
+		/**
+		 * Build the sorted filename index for a directory table.
+		 * The on-disc AVL tree is traversed once; subsequent
+		 * lookups use binary search on the index.
+		 * @param dirTable Directory table.
+		 */
+		static void buildDirIndex(DirTable &dirTable);
 
 		/**
 		 * Get an entry within a specified directory table.
@@ -54,24 +75,27 @@ class XDVDFSPartitionPrivate
 		 * @param filename Filename to find, without subdirectories.
 		 * @return Pointer to XDVDFS_DirEntry within dirTable, or nullptr if not found.
 		 */
-		const XDVDFS_DirEntry *getDirEntry(const ao::uvector<uint8_t> *dirTable, const char *filename);
+		const XDVDFS_DirEntry *getDirEntry(const DirTable *dirTable, const char *filename);
 
 		/**
 		 * Get the specified directory.
 		 * This should *only* be the directory, not a filename.
+		 * Subdirectories are resolved through their cached parents.
 		 * @param path Directory path.
-		 * @return Pointer to directory table (ao::uvector), or nullptr if not found.
+		 * @return Pointer to the directory table, or nullptr if not found.
 		 */
-		const ao::uvector<uint8_t> *getDirectory(const char *path);
+		const DirTable *getDirectory(const char *path);
 
 		/**
-		 * XDVDFS strcasecmp() implementation.
+		 * XDVDFS filename comparison with explicit lengths.
 		 * Uses generic ASCII handling instead of locale-specific case folding.
 		 * @param s1 String 1
+		 * @param len1 Length of string 1
 		 * @param s2 String 2
+		 * @param len2 Length of string 2
 		 * @return 0 (==), negative (<), or positive (>).
 		 */
-		static int xdvdfs_strcasecmp(const char *s1, const char *s2);
+		static int xdvdfs_compare_name(const char *s1, size_t len1, const char *s2, size_t len2);
 };
 
 /** XDVDFSPartitionPrivate **/
@@ -133,31 +157,109 @@ XDVDFSPartitionPrivate::~XDVDFSPartitionPrivate()
 { }
 
 /**
- * XDVDFS strcasecmp() implementation.
+ * XDVDFS filename comparison with explicit lengths.
  * Uses generic ASCII handling instead of locale-specific case folding.
  * @param s1 String 1
+ * @param len1 Length of string 1
  * @param s2 String 2
+ * @param len2 Length of string 2
  * @return 0 (==), negative (<), or positive (>).
  */
-int XDVDFSPartitionPrivate::xdvdfs_strcasecmp(const char *s1, const char *s2)
+int XDVDFSPartitionPrivate::xdvdfs_compare_name(const char *s1, size_t len1, const char *s2, size_t len2)
 {
 	// Reference: https://github.com/XboxDev/extract-xiso/blob/master/extract-xiso.c
 	// av1_compare_key()
-	while (true) {
-		char a = *s1++;
-		char b = *s2++;
+	// NOTE: Lengths are explicit because on-disc filenames
+	// are not NULL-terminated.
+	const size_t len_min = (len1 < len2 ? len1 : len2);
+	for (size_t i = 0; i < len_min; i++) {
+		char a = s1[i];
+		char b = s2[i];
 
 		// Convert to uppercase.
 		if (a >= 'a' && a <= 'z') a &= ~0x20;
 		if (b >= 'a' && b <= 'z') b &= ~0x20;
 
-		if (a) {
-			if (b) {
-				if (a < b) return -1;
-				if (a > b) return 1;
-			} else return 1;
-		} else return (b ? -1 : 0);
+		if (a < b) return -1;
+		if (a > b) return 1;
+	}
+
+	// Shorter string sorts first.
+	if (len1 < len2) return -1;
+	if (len1 > len2) return 1;
+	return 0;
+}
+
+/**
+ * Build the sorted filename index for a directory table.
+ * The on-disc AVL tree is traversed once; subsequent
+ * lookups use binary search on the index.
+ * @param dirTable Directory table.
+ */
+void XDVDFSPartitionPrivate::buildDirIndex(DirTable &dirTable)
+{
+	dirTable.index.clear();
+	if (dirTable.data.size() < sizeof(XDVDFS_DirEntry)) {
+		// Directory table is empty.
+		return;
+	}
+
+	const uint8_t *const p_start = dirTable.data.data();
+	const size_t data_size = dirTable.data.size();
+
+	// Traverse the AVL tree iteratively, collecting entry offsets.
+	// Subtree offsets are in 32-bit dwords. A visited bitmap guards
+	// against cycles in malformed directory tables.
+	std::vector<bool> visited(data_size / sizeof(uint32_t), false);
+	std::vector<uint32_t> stack;
+	stack.push_back(0);
+	while (!stack.empty()) {
+		const uint32_t offset = stack.back();
+		stack.pop_back();
+		if (offset + sizeof(XDVDFS_DirEntry) > data_size) {
+			// Entry is out of bounds.
+			continue;
+		}
+		if (visited[offset / sizeof(uint32_t)]) {
+			// Already visited. (cycle in the tree?)
+			continue;
+		}
+		visited[offset / sizeof(uint32_t)] = true;
+
+		const XDVDFS_DirEntry *const dirEntry =
+			reinterpret_cast<const XDVDFS_DirEntry*>(p_start + offset);
+		if (dirEntry->name_length == 0 ||
+		    offset + sizeof(XDVDFS_DirEntry) + dirEntry->name_length > data_size)
+		{
+			// Empty entry, or the filename is out of bounds.
+			// NOTE: Sector padding is 0xFF-filled, which ends up
+			// here via the out-of-bounds name length.
+			continue;
+		}
+		dirTable.index.push_back(offset);
+
+		// Queue the subtrees.
+		const uint16_t left_offset = le16_to_cpu(dirEntry->left_offset);
+		const uint16_t right_offset = le16_to_cpu(dirEntry->right_offset);
+		if (left_offset != 0 && left_offset != 0xFFFF) {
+			stack.push_back(left_offset * sizeof(uint32_t));
+		}
+		if (right_offset != 0 && right_offset != 0xFFFF) {
+			stack.push_back(right_offset * sizeof(uint32_t));
+		}
 	}
+
+	// Sort the index by filename.
+	std::sort(dirTable.index.begin(), dirTable.index.end(),
+		[p_start](uint32_t lhs, uint32_t rhs) -> bool {
+			const XDVDFS_DirEntry *const entL =
+				reinterpret_cast<const XDVDFS_DirEntry*>(p_start + lhs);
+			const XDVDFS_DirEntry *const entR =
+				reinterpret_cast<const XDVDFS_DirEntry*>(p_start + rhs);
+			return xdvdfs_compare_name(
+				reinterpret_cast<const char*>(p_start + lhs) + sizeof(XDVDFS_DirEntry), entL->name_length,
+				reinterpret_cast<const char*>(p_start + rhs) + sizeof(XDVDFS_DirEntry), entR->name_length) < 0;
+		});
 }
 
 /**
@@ -166,7 +268,7 @@ int XDVDFSPartitionPrivate::xdvdfs_strcasecmp(const char *s1, const char *s2)
  * @param filename Filename to find, without subdirectories.
  * @return Pointer to XDVDFS_DirEntry within dirTable, or nullptr if not found.
  */
-const XDVDFS_DirEntry *XDVDFSPartitionPrivate::getDirEntry(const ao::uvector<uint8_t> *dirTable, const char *filename)
+const XDVDFS_DirEntry *XDVDFSPartitionPrivate::getDirEntry(const DirTable *dirTable, const char *filename)
 {
 	assert(dirTable != nullptr);
 	assert(filename != nullptr);
@@ -179,46 +281,31 @@ const XDVDFS_DirEntry *XDVDFSPartitionPrivate::getDirEntry(const ao::uvector<uin
 	// Convert the filename portion to cp1252 before searching.
 	const string s_filename = utf8_to_cp1252(filename, -1);
 
-	// Find the file in the specified directory.
+	// Find the file using binary search on the filename index.
 	// NOTE: Filenames are case-insensitive.
+	const uint8_t *const p_start = dirTable->data.data();
 	const XDVDFS_DirEntry *dirEntry_found = nullptr;
-	const uint8_t *const p_start = dirTable->data();
-	const uint8_t *const p_end = p_start + dirTable->size();
-	const uint8_t *p = p_start;
-	string s_entry_filename;	// Temporary for NULL termination.
-	while (p < p_end) {
-		const XDVDFS_DirEntry *dirEntry = reinterpret_cast<const XDVDFS_DirEntry*>(p);
-		const char *entry_filename = reinterpret_cast<const char*>(p) + sizeof(*dirEntry);
-		if (entry_filename + dirEntry->name_length > reinterpret_cast<const char*>(p_end)) {
-			// Filename is out of bounds.
-			break;
-		}
-
-		// NOTE: Filename might not be NULL-terminated.
-		// Temporarily cache the filename.
-		s_entry_filename.assign(entry_filename, dirEntry->name_length);
-
-		// Check the filename.
-		// TODO: Use non-locale-specific case-insensitive check? (only letters)
-		uint16_t subtree_offset = 0;
-		int cmp = xdvdfs_strcasecmp(s_filename.c_str(), s_entry_filename.c_str());
+	size_t lo = 0, hi = dirTable->index.size();
+	while (lo < hi) {
+		const size_t mid = lo + ((hi - lo) / 2);
+		const uint32_t offset = dirTable->index[mid];
+		const XDVDFS_DirEntry *const dirEntry =
+			reinterpret_cast<const XDVDFS_DirEntry*>(p_start + offset);
+		const char *const entry_filename =
+			reinterpret_cast<const char*>(p_start + offset) + sizeof(XDVDFS_DirEntry);
+
+		const int cmp = xdvdfs_compare_name(
+			s_filename.data(), s_filename.size(),
+			entry_filename, dirEntry->name_length);
 		if (cmp == 0) {
 			// Found it!
 			dirEntry_found = dirEntry;
 			break;
 		} else if (cmp < 0) {
-			// Left subtree.
-			subtree_offset = le16_to_cpu(dirEntry->left_offset);
-		} else if (cmp > 0) {
-			// Right subtree.
-			subtree_offset = le16_to_cpu(dirEntry->right_offset);
-		}
-
-		if (subtree_offset == 0 || subtree_offset == 0xFFFF) {
-			// End of directory.
-			break;
+			hi = mid;
+		} else {
+			lo = mid + 1;
 		}
-		p = p_start + (subtree_offset * sizeof(uint32_t));
 	}
 
 	if (!dirEntry_found) {
@@ -246,10 +333,11 @@ const XDVDFS_DirEntry *XDVDFSPartitionPrivate::getDirEntry(const ao::uvector<uin
 /**
  * Get the specified directory.
  * This should *only* be the directory, not a filename.
+ * Subdirectories are resolved through their cached parents.
  * @param path Directory path.
- * @return Pointer to directory table (ao::uvector), or nullptr if not found.
+ * @return Pointer to the directory table, or nullptr if not found.
  */
-const ao::uvector<uint8_t> *XDVDFSPartitionPrivate::getDirectory(const char *path)
+const XDVDFSPartitionPrivate::DirTable *XDVDFSPartitionPrivate::getDirectory(const char *path)
 {
 	RP_Q(XDVDFSPartition);
 	if (unlikely(!path || path[0] != '/')) {
@@ -262,10 +350,14 @@ const ao::uvector<uint8_t> *XDVDFSPartitionPrivate::getDirectory(const char *pat
 		return nullptr;
 	}
 
-	// TODO: Remove unnecessary leading and trailing slashes.
+	// Lowercase the path for the cache key, since
+	// lookups are case-insensitive.
+	string s_path(path);
+	std::transform(s_path.begin(), s_path.end(), s_path.begin(),
+		[](char c) { return std::tolower(static_cast<unsigned char>(c)); });
 
 	// Is this directory table already loaded?
-	auto iter = dirTables.find(path);
+	auto iter = dirTables.find(s_path);
 	if (iter != dirTables.end()) {
 		// Directory table is already loaded.
 		return &(iter->second);
@@ -282,7 +374,7 @@ const ao::uvector<uint8_t> *XDVDFSPartitionPrivate::getDirectory(const char *pat
 	off64_t dir_addr = 0;
 	uint32_t dir_size = 0;
 
-	if (!strcmp(path, "/")) {
+	if (s_path == "/") {
 		// Special handling for the root directory.
 
 		// Root directory size should be less than 16 MB.
@@ -297,15 +389,51 @@ const ao::uvector<uint8_t> *XDVDFSPartitionPrivate::getDirectory(const char *pat
 			static_cast<off64_t>(xdvdfsHeader.root_dir_sector) * XDVDFS_BLOCK_SIZE);
 		dir_size = xdvdfsHeader.root_dir_size;
 	} else {
-		// Get the parent directory.
-		// TODO
-		return nullptr;
+		// Find the subdirectory in its parent directory.
+		const size_t slash_pos = s_path.rfind('/');
+		const string s_parent = (slash_pos == 0 ? string("/") : s_path.substr(0, slash_pos));
+		const string s_dirname = s_path.substr(slash_pos + 1);
+		if (s_dirname.empty()) {
+			// Trailing slash...
+			q->m_lastError = EINVAL;
+			return nullptr;
+		}
+
+		const DirTable *const parentTable = getDirectory(s_parent.c_str());
+		if (!parentTable) {
+			// Parent directory not found.
+			// getDirectory() has already set m_lastError.
+			return nullptr;
+		}
+
+		const XDVDFS_DirEntry *const dirEntry = getDirEntry(parentTable, s_dirname.c_str());
+		if (!dirEntry) {
+			// Directory not found.
+			q->m_lastError = ENOENT;
+			return nullptr;
+		}
+		if (!(dirEntry->attributes & XDVDFS_ATTR_DIRECTORY)) {
+			// Not a directory.
+			q->m_lastError = ENOTDIR;
+			return nullptr;
+		}
+
+		// Directory size should be less than 16 MB.
+		dir_size = le32_to_cpu(dirEntry->file_size);
+		if (dir_size > 16*1024*1024) {
+			// Directory is too big.
+			q->m_lastError = EIO;
+			return nullptr;
+		}
+		dir_addr = partition_offset + (
+			static_cast<off64_t>(le32_to_cpu(dirEntry->start_sector)) * XDVDFS_BLOCK_SIZE);
 	}
 
 	// Read the directory.
-	ao::uvector<uint8_t> dirTable(dir_size);
-	size_t size = q->m_discReader->seekAndRead(dir_addr, dirTable.data(), dirTable.size());
-	if (size != dirTable.size()) {
+	DirTable dirTable;
+	dirTable.data.resize(dir_size);
+	size_t size = q->m_discReader->seekAndRead(dir_addr, dirTable.data.data(), dirTable.data.size());
+	if (size != dirTable.data.size()) {
 		// Seek and/or read error.
 		q->m_lastError = q->m_discReader->lastError();
 		if (q->m_lastError == 0) {
@@ -314,10 +442,13 @@ const ao::uvector<uint8_t> *XDVDFSPartitionPrivate::getDirectory(const char *pat
 		return nullptr;
 	}
 
+	// Build the sorted filename index.
+	buildDirIndex(dirTable);
+
 	// Save the directory table for later.
-	auto ins_iter = dirTables.insert(std::make_pair(path, std::move(dirTable)));
+	auto ins_iter = dirTables.insert(std::make_pair(s_path, std::move(dirTable)));
 
-	// Root directory loaded.
+	// Directory loaded.
 	return &(ins_iter.first->second);
 }
 
@@ -523,8 +654,6 @@ IRpFile *XDVDFSPartition::open(const char *filename)
 	// TODO: File reference counter.
 	// This might be difficult to do because PartitionFile is a separate class.
 
-	// TODO: Support subdirectories.
-
 	// Filename must be valid, and must start with a slash.
 	// Only absolute paths are supported.
 	if (!filename || filename[0] != '/') {
@@ -543,18 +672,30 @@ IRpFile *XDVDFSPartition::open(const char *filename)
 		return nullptr;
 	}
 
-	// TODO: Handle subdirectories.
-	// For now, assuming the file is in the root directory.
+	// Split the directory path from the filename.
+	string s_filename(filename);
+	string s_dirpath("/");
+	const size_t slash_pos = s_filename.rfind('/');
+	if (slash_pos != string::npos) {
+		s_dirpath += s_filename.substr(0, slash_pos);
+		s_filename.erase(0, slash_pos + 1);
+		if (s_filename.empty()) {
+			// Trailing slash...
+			m_lastError = EINVAL;
+			return nullptr;
+		}
+	}
+
 	RP_D(XDVDFSPartition);
-	const ao::uvector<uint8_t> *const dirTable = d->getDirectory("/");
+	const XDVDFSPartitionPrivate::DirTable *const dirTable = d->getDirectory(s_dirpath.c_str());
 	if (!dirTable) {
 		// Directory not found.
 		// getDirectory() has already set m_lastError.
 		return nullptr;
 	}
 
-	// Find the file in the root directory.
-	const XDVDFS_DirEntry *const dirEntry = d->getDirEntry(dirTable, filename);
+	// Find the file in the directory.
+	const XDVDFS_DirEntry *const dirEntry = d->getDirEntry(dirTable, s_filename.c_str());
 	if (!dirEntry) {
 		// File not found.
 		// getDirEntry() has already set m_lastError.
@@ -0,0 +1,182 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * chd_structs.h: MAME CHD (Compressed Hunks of Data) structs.             *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// References:
+// - https://github.com/mamedev/mame/blob/master/src/lib/util/chd.h
+// - https://github.com/rtissera/libchdr/blob/master/include/libchdr/chd.h
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DISC_CHD_STRUCTS_H__
+#define __ROMPROPERTIES_LIBROMDATA_DISC_CHD_STRUCTS_H__
+
+#include <stdint.h>
+#include "common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#pragma pack(1)
+
+/**
+ * CHD common header.
+ * All CHD versions start with these fields.
+ *
+ * All fields are in big-endian.
+ */
+#define CHD_MAGIC "MComprHD"
+typedef struct PACKED _CHD_HeaderCommon {
+	char magic[8];			// [0x000] "MComprHD"
+	uint32_t length;		// [0x008] Header length, in bytes.
+	uint32_t version;		// [0x00C] Format version.
+} CHD_HeaderCommon;
+ASSERT_STRUCT(CHD_HeaderCommon, 16);
+
+// CHD header flags. (v1-v4)
+#define CHD_FLAGS_HAS_PARENT	(1U << 0)	// Image has a parent CHD.
+#define CHD_FLAGS_IS_WRITEABLE	(1U << 1)	// Image is writeable.
+
+/**
+ * CHD v1-v4 compression methods.
+ */
+typedef enum {
+	CHD_V34_COMPRESSION_NONE	= 0,
+	CHD_V34_COMPRESSION_ZLIB	= 1,
+	CHD_V34_COMPRESSION_ZLIB_PLUS	= 2,
+	CHD_V34_COMPRESSION_AV		= 3,
+} CHD_V34_Compression_e;
+
+/**
+ * CHD v3 header.
+ * The hunk map immediately follows the header.
+ *
+ * All fields are in big-endian.
+ */
+typedef struct PACKED _CHD_HeaderV3 {
+	char magic[8];			// [0x000] "MComprHD"
+	uint32_t length;		// [0x008] Header length. (120)
+	uint32_t version;		// [0x00C] Format version. (3)
+	uint32_t flags;			// [0x010] Flags. (See CHD_FLAGS_*.)
+	uint32_t compression;		// [0x014] Compression method. (See CHD_V34_Compression_e.)
+	uint32_t totalhunks;		// [0x018] Total number of hunks.
+	uint64_t logicalbytes;		// [0x01C] Logical size of the data.
+	uint64_t metaoffset;		// [0x024] File offset of the first metadata entry.
+	uint8_t md5[16];		// [0x02C] MD5 of the raw data.
+	uint8_t parentmd5[16];		// [0x03C] MD5 of the parent file.
+	uint32_t hunkbytes;		// [0x04C] Number of bytes per hunk.
+	uint8_t sha1[20];		// [0x050] SHA-1 of the raw data.
+	uint8_t parentsha1[20];		// [0x064] SHA-1 of the parent file.
+} CHD_HeaderV3;
+ASSERT_STRUCT(CHD_HeaderV3, 120);
+
+/**
+ * CHD v4 header.
+ * The hunk map immediately follows the header.
+ *
+ * All fields are in big-endian.
+ */
+typedef struct PACKED _CHD_HeaderV4 {
+	char magic[8];			// [0x000] "MComprHD"
+	uint32_t length;		// [0x008] Header length. (108)
+	uint32_t version;		// [0x00C] Format version. (4)
+	uint32_t flags;			// [0x010] Flags. (See CHD_FLAGS_*.)
+	uint32_t compression;		// [0x014] Compression method. (See CHD_V34_Compression_e.)
+	uint32_t totalhunks;		// [0x018] Total number of hunks.
+	uint64_t logicalbytes;		// [0x01C] Logical size of the data.
+	uint64_t metaoffset;		// [0x024] File offset of the first metadata entry.
+	uint32_t hunkbytes;		// [0x02C] Number of bytes per hunk.
+	uint8_t sha1[20];		// [0x030] SHA-1 of the combined raw+meta data.
+	uint8_t parentsha1[20];		// [0x044] SHA-1 of the parent file.
+	uint8_t rawsha1[20];		// [0x058] SHA-1 of the raw data.
+} CHD_HeaderV4;
+ASSERT_STRUCT(CHD_HeaderV4, 108);
+
+/**
+ * CHD v5 header.
+ *
+ * All fields are in big-endian.
+ */
+typedef struct PACKED _CHD_HeaderV5 {
+	char magic[8];			// [0x000] "MComprHD"
+	uint32_t length;		// [0x008] Header length. (124)
+	uint32_t version;		// [0x00C] Format version. (5)
+	uint32_t compressors[4];	// [0x010] Compression codec FourCCs. (0 == uncompressed)
+	uint64_t logicalbytes;		// [0x020] Logical size of the data.
+	uint64_t mapoffset;		// [0x028] File offset of the hunk map.
+	uint64_t metaoffset;		// [0x030] File offset of the first metadata entry.
+	uint32_t hunkbytes;		// [0x038] Number of bytes per hunk.
+	uint32_t unitbytes;		// [0x03C] Number of bytes per unit within each hunk.
+	uint8_t rawsha1[20];		// [0x040] SHA-1 of the raw data.
+	uint8_t sha1[20];		// [0x054] SHA-1 of the combined raw+meta data.
+	uint8_t parentsha1[20];		// [0x068] SHA-1 of the parent file.
+} CHD_HeaderV5;
+ASSERT_STRUCT(CHD_HeaderV5, 124);
+
+/**
+ * CHD v3/v4 hunk map entry.
+ *
+ * For uncompressed v5 images, the map is an array of uint32_t
+ * values instead: file offset of the hunk divided by the hunk
+ * size, with 0 indicating an unallocated hunk.
+ *
+ * All fields are in big-endian.
+ */
+typedef struct PACKED _CHD_V34_MapEntry {
+	uint64_t offset;		// [0x000] File offset (or pattern/hunk index; see type).
+	uint32_t crc32;			// [0x008] CRC32 of the decompressed hunk.
+	uint16_t length_lo;		// [0x00C] Stored length, low 16 bits.
+	uint8_t length_hi;		// [0x00E] Stored length, high 8 bits.
+	uint8_t flags;			// [0x00F] Entry type and flags. (See CHD_V34_MapType_e.)
+} CHD_V34_MapEntry;
+ASSERT_STRUCT(CHD_V34_MapEntry, 16);
+
+/**
+ * CHD v3/v4 hunk map entry types.
+ * Stored in the low 4 bits of the flags field.
+ */
+typedef enum {
+	CHD_V34_MAP_TYPE_INVALID	= 0,	// Invalid entry.
+	CHD_V34_MAP_TYPE_COMPRESSED	= 1,	// Compressed with the primary codec.
+	CHD_V34_MAP_TYPE_UNCOMPRESSED	= 2,	// Stored uncompressed.
+	CHD_V34_MAP_TYPE_MINI		= 3,	// offset field is an 8-byte repeating pattern.
+	CHD_V34_MAP_TYPE_SELF_HUNK	= 4,	// offset field is a hunk index in this file.
+	CHD_V34_MAP_TYPE_PARENT_HUNK	= 5,	// offset field is a hunk index in the parent file.
+	CHD_V34_MAP_TYPE_2ND_COMPRESSED	= 6,	// Compressed with the secondary codec. (A/V only)
+} CHD_V34_MapType_e;
+#define CHD_V34_MAP_TYPE_MASK		0x0F
+#define CHD_V34_MAP_FLAG_NO_CRC		0x10	// Hunk doesn't have a valid CRC.
+
+/**
+ * CHD metadata entry header.
+ * Metadata entries form a linked list starting at metaoffset.
+ *
+ * All fields are in big-endian.
+ */
+typedef struct PACKED _CHD_MetadataHeader {
+	uint32_t metatag;		// [0x000] Metadata tag FourCC.
+	uint32_t flags_length;		// [0x004] Flags (high 8 bits) and data length (low 24 bits).
+	uint64_t next;			// [0x008] File offset of the next entry. (0 == end of list)
+} CHD_MetadataHeader;
+ASSERT_STRUCT(CHD_MetadataHeader, 16);
+
+// CD-ROM and GD-ROM metadata tags.
+#define CHD_METADATA_TAG_CDROM_OLD	'CHCD'
+#define CHD_METADATA_TAG_CDROM_TRACK	'CHTR'
+#define CHD_METADATA_TAG_CDROM_TRACK2	'CHT2'
+#define CHD_METADATA_TAG_GDROM_OLD	'CHGT'
+#define CHD_METADATA_TAG_GDROM_TRACK	'CHGD'
+
+// CD-ROM frame size used by CHD images. (2352 bytes + 96 subchannel bytes)
+#define CHD_CD_FRAME_SIZE 2448
+
+#pragma pack()
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DISC_CHD_STRUCTS_H__ */
@@ -0,0 +1,136 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * wia_structs.h: GameCube/Wii WIA and RVZ disc image structs.             *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// References:
+// - https://wit.wiimm.de/info/wia.html
+// - https://github.com/dolphin-emu/dolphin/blob/master/Source/Core/DiscIO/WIABlob.h
+
+#ifndef __ROMPROPERTIES_LIBROMDATA_DISC_WIA_STRUCTS_H__
+#define __ROMPROPERTIES_LIBROMDATA_DISC_WIA_STRUCTS_H__
+
+#include <stdint.h>
+#include "common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+#pragma pack(1)
+
+/**
+ * WIA/RVZ file header.
+ *
+ * All fields are in big-endian.
+ */
+#define WIA_MAGIC 'WIA\x01'
+#define RVZ_MAGIC 'RVZ\x01'
+typedef struct PACKED _WIA_FileHeader {
+	uint32_t magic;			// [0x000] Magic number. ('WIA\x01' or 'RVZ\x01')
+	uint32_t version;		// [0x004] File format version.
+	uint32_t version_compatible;	// [0x008] Oldest compatible version.
+	uint32_t disc_struct_size;	// [0x00C] Size of the WIA_DiscHeader.
+	uint8_t disc_struct_hash[20];	// [0x010] SHA-1 of the WIA_DiscHeader.
+	uint64_t iso_file_size;		// [0x024] Size of the original disc image.
+	uint64_t wia_file_size;		// [0x02C] Size of this file.
+	uint8_t file_header_hash[20];	// [0x034] SHA-1 of this header, up to this field.
+} WIA_FileHeader;
+ASSERT_STRUCT(WIA_FileHeader, 0x48);
+
+/**
+ * WIA/RVZ compression methods.
+ */
+typedef enum {
+	WIA_COMPRESSION_NONE	= 0,
+	WIA_COMPRESSION_PURGE	= 1,	// WIA only.
+	WIA_COMPRESSION_BZIP2	= 2,
+	WIA_COMPRESSION_LZMA	= 3,
+	WIA_COMPRESSION_LZMA2	= 4,
+	RVZ_COMPRESSION_ZSTD	= 5,	// RVZ only.
+} WIA_Compression_e;
+
+/**
+ * WIA/RVZ disc types.
+ */
+typedef enum {
+	WIA_DISC_TYPE_UNKNOWN	= 0,
+	WIA_DISC_TYPE_GCN	= 1,
+	WIA_DISC_TYPE_WII	= 2,
+} WIA_DiscType_e;
+
+/**
+ * WIA/RVZ disc header.
+ * Located immediately after the file header.
+ *
+ * All fields are in big-endian.
+ */
+typedef struct PACKED _WIA_DiscHeader {
+	uint32_t disc_type;		// [0x000] Disc type. (See WIA_DiscType_e.)
+	uint32_t compression;		// [0x004] Compression method. (See WIA_Compression_e.)
+	uint32_t compression_level;	// [0x008] Compression level. (signed)
+	uint32_t chunk_size;		// [0x00C] Chunk size, in bytes.
+	uint8_t dhead[0x80];		// [0x010] First 0x80 bytes of the disc header.
+	uint32_t num_partitions;	// [0x090] Number of partition entries.
+	uint32_t partition_entry_size;	// [0x094] Size of one partition entry.
+	uint64_t partition_off;		// [0x098] File offset of the partition entries.
+	uint8_t partition_hash[20];	// [0x0A0] SHA-1 of the partition entries.
+	uint32_t num_raw_data;		// [0x0B4] Number of raw data entries.
+	uint64_t raw_data_off;		// [0x0B8] File offset of the raw data entries.
+	uint32_t raw_data_size;		// [0x0C0] Stored size of the raw data entries.
+	uint32_t num_groups;		// [0x0C4] Number of group entries.
+	uint64_t group_off;		// [0x0C8] File offset of the group entries.
+	uint32_t group_size;		// [0x0D0] Stored size of the group entries.
+	uint8_t compr_data_len;		// [0x0D4] Used length of compr_data[].
+	uint8_t compr_data[7];		// [0x0D5] Compressor-specific data.
+} WIA_DiscHeader;
+ASSERT_STRUCT(WIA_DiscHeader, 0xDC);
+
+/**
+ * WIA/RVZ raw data entry.
+ * Describes a disc area that isn't part of a Wii partition.
+ *
+ * The area is stored as a sequence of groups. The first group
+ * covers the disc area starting at raw_data_off rounded *down*
+ * to a multiple of the chunk size.
+ *
+ * All fields are in big-endian.
+ */
+typedef struct PACKED _WIA_RawDataEntry {
+	uint64_t raw_data_off;		// [0x000] Disc offset of the raw data.
+	uint64_t raw_data_size;		// [0x008] Size of the raw data.
+	uint32_t group_index;		// [0x010] Index of the first group.
+	uint32_t num_groups;		// [0x014] Number of groups.
+} WIA_RawDataEntry;
+ASSERT_STRUCT(WIA_RawDataEntry, 24);
+
+/**
+ * WIA/RVZ group entry.
+ * Each group stores up to chunk_size bytes of disc data.
+ *
+ * If data_size is 0, the entire group is zero-filled.
+ * Otherwise, data_size bytes are stored at (data_off4 << 2),
+ * and the rest of the group is zero-filled.
+ *
+ * NOTE: RVZ uses the high bit of data_size to indicate that
+ * the group data is "packed" with junk data encoding.
+ *
+ * All fields are in big-endian.
+ */
+#define RVZ_GROUP_DATA_SIZE_PACKED	(1U << 31)
+typedef struct PACKED _WIA_GroupEntry {
+	uint32_t data_off4;		// [0x000] File offset of the group data, divided by 4.
+	uint32_t data_size;		// [0x004] Stored size of the group data.
+} WIA_GroupEntry;
+ASSERT_STRUCT(WIA_GroupEntry, 8);
+
+#pragma pack()
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+
+#endif /* __ROMPROPERTIES_LIBROMDATA_DISC_WIA_STRUCTS_H__ */
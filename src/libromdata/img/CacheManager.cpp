@@ -12,13 +12,17 @@
 
 // librpbase, librpfile
 #include "librpbase/TextFuncs.hpp"
+#include "librpbase/config/Config.hpp"
 #include "librpfile/RpFile.hpp"
 #include "librpfile/FileSystem.hpp"
+#include "librpfile/RpStats.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
 
 // libcachecommon
 #include "libcachecommon/CacheKeys.hpp"
+#include "libcachecommon/CacheIndex.hpp"
+#include "libcachecommon/CacheEviction.hpp"
 
 // OS-specific includes.
 #ifdef _WIN32
@@ -33,12 +37,21 @@ using namespace LibRpFile;
 # endif /* HAVE_POSIX_SPAWN */
 #endif /* _WIN32 */
 
+// librpthreads
+#include "librpthreads/Mutex.hpp"
+
 // C includes. (C++ namespace)
 #include <ctime>
 
 // C++ includes.
+#include <deque>
 #include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+using std::deque;
 using std::string;
+using std::vector;
 #ifdef _WIN32
 using std::wstring;
 #endif /* _WIN32 */
@@ -115,6 +128,39 @@ string CacheManager::download(const string &cache_key)
 		return string();
 	}
 
+	// Apply the configured size limit for background cache eviction.
+	LibCacheCommon::setCacheSizeLimit(
+		static_cast<int64_t>(Config::instance()->cacheSizeLimitMB()) * 1048576LL);
+
+	// Check the persistent cache index first.
+	// If the key is indexed, the stat() call (and for negative
+	// entries, the rp-download invocation) can be skipped.
+	int64_t idx_size = 0;
+	time_t idx_mtime = 0;
+	switch (LibCacheCommon::cacheIndexLookup(cache_key, &idx_size, &idx_mtime)) {
+		case LibCacheCommon::CIS_PRESENT:
+			// File is present in the cache.
+			// If it's over a week old, fall through to the
+			// download path, which revalidates the file with
+			// a conditional request.
+			if ((time(nullptr) - idx_mtime) < (86400*7)) {
+				RpStats::increment(RpStats::CTR_CACHE_HIT);
+				LibCacheCommon::cacheLedgerAccess(cache_key, idx_size);
+				return cache_filename;
+			}
+			break;
+		case LibCacheCommon::CIS_NEGATIVE:
+			// Negative entry. If it's less than a week old,
+			// don't retry the download.
+			if ((time(nullptr) - idx_mtime) < (86400*7)) {
+				return string();
+			}
+			break;
+		case LibCacheCommon::CIS_UNKNOWN:
+		default:
+			break;
+	}
+
 	// Lock the semaphore to make sure we don't
 	// download too many files at once.
 	SemaphoreLocker locker(m_dlsem);
@@ -134,6 +180,7 @@ string CacheManager::download(const string &cache_key)
 			const time_t systime = time(nullptr);
 			if ((systime - filemtime) < (86400*7)) {
 				// Less than a week old.
+				LibCacheCommon::cacheIndexUpdate(cache_key, 0, filemtime);
 				return string();
 			}
 
@@ -146,7 +193,16 @@ string CacheManager::download(const string &cache_key)
 		} else if (filesize > 0) {
 			// File is larger than 0 bytes, which indicates
 			// it was cached successfully.
-			return cache_filename;
+			// If it's over a week old, fall through to the
+			// download path, which revalidates the file with
+			// a conditional request.
+			const time_t systime = time(nullptr);
+			if ((systime - filemtime) < (86400*7)) {
+				RpStats::increment(RpStats::CTR_CACHE_HIT);
+				LibCacheCommon::cacheIndexUpdate(cache_key, filesize, filemtime);
+				LibCacheCommon::cacheLedgerAccess(cache_key, filesize);
+				return cache_filename;
+			}
 		}
 	} else if (ret != -ENOENT) {
 		// Some error other than "file not found" occurred.
@@ -161,20 +217,259 @@ string CacheManager::download(const string &cache_key)
 	// Subdirectories will be created by rp-download to
 	// ensure they keep the "low integrity" label on Win7.
 
+	// The file needs to be downloaded (or revalidated).
+	RpStats::increment(RpStats::CTR_CACHE_MISS);
+
 	// Execute rp-download.
 	// NOTE: Using the unfiltered cache key, since filtering it
 	// results in slashes being changed to backslashes on Windows.
 	// rp-download will filter the key itself.
-	ret = execRpDownload(cache_key);
+#ifdef ENABLE_INPROC_DOWNLOAD
+	if (Config::instance()->inProcessDownloadsEnabled()) {
+		// Download in-process instead of spawning rp-download.
+		// This skips the subprocess sandboxing, so it's opt-in
+		// for trusted, high-volume configurations only.
+		ret = inProcDownload(cache_key);
+	} else
+#endif /* ENABLE_INPROC_DOWNLOAD */
+	{
+		ret = execRpDownload(cache_key);
+	}
 	if (ret != 0) {
-		// rp-download failed for some reason.
+		// The download failed for some reason.
 		return string();
 	}
 
 	// rp-download has successfully downloaded the file.
+	// Add it to the persistent cache index.
+	// NOTE: rp-download updates the index itself, but it runs
+	// as a separate process, so our in-memory copy may not have
+	// picked up the new record yet.
+	if (FileSystem::get_file_size_and_mtime(cache_filename.c_str(), &filesize, &filemtime) == 0) {
+		LibCacheCommon::cacheIndexUpdate(cache_key, filesize, filemtime);
+		LibCacheCommon::cacheLedgerAccess(cache_key, filesize);
+	}
 	return cache_filename;
 }
 
+/** Asynchronous downloads. **/
+
+/**
+ * Background download queue shared by all CacheManager instances.
+ *
+ * A single worker thread processes the queued requests in order.
+ * Requests for the same cache key are coalesced into one download.
+ */
+class CacheManagerAsyncQueue
+{
+	public:
+		CacheManagerAsyncQueue()
+			: sem_items(0)
+			, thread(nullptr)
+			, next_ticket(1)
+			, exit_flag(false)
+		{
+			current.ticket = 0;
+		}
+
+		~CacheManagerAsyncQueue()
+		{
+			if (thread) {
+				// Tell the worker thread to exit.
+				// Any remaining queued requests are abandoned.
+				{
+					MutexLocker locker(mutex);
+					exit_flag = true;
+				}
+				sem_items.release();
+				thread->join();
+				delete thread;
+			}
+		}
+
+	private:
+		RP_DISABLE_COPY(CacheManagerAsyncQueue)
+
+	public:
+		// Download request.
+		struct Request {
+			int ticket;		// Ticket number. (0 == invalid)
+			string cache_key;
+			string proxyUrl;
+			// Callbacks to invoke on completion.
+			vector<std::pair<CacheManager::DownloadCallback, void*> > callbacks;
+		};
+
+		Mutex mutex;		// Protects all fields below.
+		Semaphore sem_items;	// Released once per queued request.
+		deque<Request> queue;	// Pending requests.
+		Request current;	// In-flight request. (ticket == 0 if none)
+		std::thread *thread;	// Worker thread. (started on first request)
+		int next_ticket;	// Next ticket number.
+		bool exit_flag;		// Worker exit request.
+
+		/**
+		 * Queue a download request.
+		 * @param cache_key	[in] Cache key.
+		 * @param proxyUrl	[in] Proxy server URL. (May be empty.)
+		 * @param callback	[in] Completion callback.
+		 * @param userdata	[in] User data for the callback.
+		 * @param highPriority	[in] If true, put the request at the front of the queue.
+		 * @return Ticket number. (>0)
+		 */
+		int enqueue(const string &cache_key, const string &proxyUrl,
+			CacheManager::DownloadCallback callback, void *userdata,
+			bool highPriority);
+
+		/**
+		 * Worker thread function.
+		 */
+		void workerThread(void);
+};
+
+/**
+ * Queue a download request.
+ * @param cache_key	[in] Cache key.
+ * @param proxyUrl	[in] Proxy server URL. (May be empty.)
+ * @param callback	[in] Completion callback.
+ * @param userdata	[in] User data for the callback.
+ * @param highPriority	[in] If true, put the request at the front of the queue.
+ * @return Ticket number. (>0)
+ */
+int CacheManagerAsyncQueue::enqueue(const string &cache_key, const string &proxyUrl,
+	CacheManager::DownloadCallback callback, void *userdata,
+	bool highPriority)
+{
+	MutexLocker locker(mutex);
+
+	// Coalesce with the in-flight request, if any.
+	if (current.ticket != 0 && current.cache_key == cache_key) {
+		current.callbacks.push_back(std::make_pair(callback, userdata));
+		return current.ticket;
+	}
+
+	// Coalesce with a queued request, if any.
+	for (auto iter = queue.begin(); iter != queue.end(); ++iter) {
+		if (iter->cache_key != cache_key)
+			continue;
+
+		iter->callbacks.push_back(std::make_pair(callback, userdata));
+		const int ticket = iter->ticket;
+		if (highPriority && iter != queue.begin()) {
+			// Bump the request to the front of the queue.
+			Request req = std::move(*iter);
+			queue.erase(iter);
+			queue.push_front(std::move(req));
+		}
+		return ticket;
+	}
+
+	// New request.
+	Request req;
+	req.ticket = next_ticket++;
+	if (next_ticket <= 0) {
+		// Wraparound. (unlikely)
+		next_ticket = 1;
+	}
+	req.cache_key = cache_key;
+	req.proxyUrl = proxyUrl;
+	req.callbacks.push_back(std::make_pair(callback, userdata));
+	const int ticket = req.ticket;
+
+	if (highPriority) {
+		queue.push_front(std::move(req));
+	} else {
+		queue.push_back(std::move(req));
+	}
+	sem_items.release();
+
+	// Start the worker thread if it isn't running yet.
+	if (!thread) {
+		thread = new std::thread(&CacheManagerAsyncQueue::workerThread, this);
+	}
+
+	return ticket;
+}
+
+/**
+ * Worker thread function.
+ */
+void CacheManagerAsyncQueue::workerThread(void)
+{
+	while (true) {
+		// Wait for a request. (or an exit request)
+		sem_items.obtain();
+
+		{
+			MutexLocker locker(mutex);
+			if (exit_flag)
+				break;
+			assert(!queue.empty());
+			if (queue.empty())
+				continue;
+
+			current = std::move(queue.front());
+			queue.pop_front();
+		}
+
+		// Download the file. (blocking)
+		// NOTE: More callbacks may be attached to `current`
+		// while this is running; only the callbacks vector
+		// is modified, and only while holding the mutex.
+		CacheManager cache;
+		cache.setProxyUrl(current.proxyUrl);
+		const string cache_filename = cache.download(current.cache_key);
+
+		// Take the callbacks and mark the request as finished.
+		string cache_key;
+		vector<std::pair<CacheManager::DownloadCallback, void*> > callbacks;
+		{
+			MutexLocker locker(mutex);
+			cache_key = std::move(current.cache_key);
+			callbacks.swap(current.callbacks);
+			current.ticket = 0;
+			current.cache_key.clear();
+		}
+
+		// Invoke the callbacks.
+		for (auto iter = callbacks.cbegin(); iter != callbacks.cend(); ++iter) {
+			iter->first(iter->second, cache_key, cache_filename);
+		}
+	}
+}
+
+/**
+ * Download a file asynchronously.
+ *
+ * The request is queued on a shared worker thread and this
+ * function returns immediately. When the download finishes
+ * (or fails), the callback is invoked with the result.
+ *
+ * Requests for a cache key that is already queued or in
+ * progress are coalesced: the callback is attached to the
+ * existing request and no new download is started.
+ *
+ * @param cache_key	[in] Cache key.
+ * @param callback	[in] Completion callback.
+ * @param userdata	[in,opt] User data for the callback.
+ * @param highPriority	[in,opt] If true, put the request at the front of the queue.
+ * @return Ticket number (>0) on success; negative POSIX error code on error.
+ */
+int CacheManager::downloadAsync(const string &cache_key,
+	DownloadCallback callback, void *userdata, bool highPriority)
+{
+	assert(callback != nullptr);
+	assert(!cache_key.empty());
+	if (!callback || cache_key.empty()) {
+		return -EINVAL;
+	}
+
+	// Shared download queue. Created on first use; the
+	// worker thread is joined at process shutdown.
+	static CacheManagerAsyncQueue async_queue;
+	return async_queue.enqueue(cache_key, m_proxyUrl, callback, userdata, highPriority);
+}
+
 /**
  * Check if a file has already been cached.
  * @param cache_key Cache key.
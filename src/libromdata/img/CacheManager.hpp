@@ -10,6 +10,7 @@
 #define __ROMPROPERTIES_LIBROMDATA_IMG_CACHEMANAGER_HPP__
 
 #include "common.h"
+#include "config.libromdata.h"
 
 // librpthreads
 #include "librpthreads/Semaphore.hpp"
@@ -77,6 +78,45 @@ class CacheManager
 		 */
 		std::string findInCache(const std::string &cache_key);
 
+	public:
+		/** Asynchronous downloads. **/
+
+		/**
+		 * Download completion callback.
+		 *
+		 * NOTE: The callback is invoked on the download worker
+		 * thread. GUI consumers must marshal the result over to
+		 * their UI thread before using it.
+		 *
+		 * @param userdata	[in] User data specified when the download was requested.
+		 * @param cache_key	[in] Cache key.
+		 * @param cache_filename [in] Absolute path to the cached file, or empty string on error.
+		 */
+		typedef void (*DownloadCallback)(void *userdata,
+			const std::string &cache_key,
+			const std::string &cache_filename);
+
+		/**
+		 * Download a file asynchronously.
+		 *
+		 * The request is queued on a shared worker thread and this
+		 * function returns immediately. When the download finishes
+		 * (or fails), the callback is invoked with the result.
+		 *
+		 * Requests for a cache key that is already queued or in
+		 * progress are coalesced: the callback is attached to the
+		 * existing request and no new download is started.
+		 *
+		 * @param cache_key	[in] Cache key.
+		 * @param callback	[in] Completion callback.
+		 * @param userdata	[in,opt] User data for the callback.
+		 * @param highPriority	[in,opt] If true, put the request at the front of the queue.
+		 * @return Ticket number (>0) on success; negative POSIX error code on error.
+		 */
+		int downloadAsync(const std::string &cache_key,
+			DownloadCallback callback, void *userdata = nullptr,
+			bool highPriority = false);
+
 	protected:
 		/**
 		 * Execute rp-download.
@@ -85,6 +125,17 @@ class CacheManager
 		 */
 		int execRpDownload(const std::string &filtered_cache_key);
 
+#ifdef ENABLE_INPROC_DOWNLOAD
+		/**
+		 * Download a file in-process using libcurl.
+		 * Skips the rp-download subprocess spawn; only used if
+		 * InProcessDownloads is enabled in rom-properties.conf.
+		 * @param cache_key Cache key. (unfiltered)
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int inProcDownload(const std::string &cache_key);
+#endif /* ENABLE_INPROC_DOWNLOAD */
+
 	protected:
 		std::string m_proxyUrl;
 
@@ -0,0 +1,282 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * InProcDownload.cpp: Download a file in-process. (libcurl)               *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "config.libromdata.h"
+#include "config.version.h"
+#include "CacheManager.hpp"
+
+// librpfile
+#include "librpfile/FileSystem.hpp"
+using namespace LibRpFile;
+
+// libcachecommon
+#include "libcachecommon/CacheKeys.hpp"
+#include "libcachecommon/CacheIndex.hpp"
+#include "libcachecommon/CacheBlobStore.hpp"
+
+// cURL for network access.
+#include <curl/curl.h>
+
+// C includes. (C++ namespace)
+#include <cerrno>
+#include <cstdio>
+#include <ctime>
+
+// C++ includes.
+#include <string>
+using std::string;
+
+namespace LibRomData {
+
+// Maximum file size.
+// Must match rp-download's setMaxSize() value.
+static const size_t INPROC_DL_MAX_SIZE = 4*1024*1024;
+
+// Download state for the cURL write callback.
+struct InProcDownloadState {
+	const char *filename;	// Output filename.
+	FILE *f_out;		// Output file. (opened on first write)
+	size_t bytesWritten;	// Total bytes written so far.
+};
+
+/**
+ * Determine the full URL for a cache key.
+ *
+ * NOTE: This must match the cache key handling in rp-download.
+ *
+ * @param cache_key Cache key. (unfiltered)
+ * @return Full URL, or empty string if the cache key is invalid.
+ */
+static string urlForCacheKey(const string &cache_key)
+{
+	// Check the cache key prefix. The prefix indicates the system
+	// and identifies the online database used.
+	const size_t slash_pos = cache_key.find('/');
+	if (slash_pos == string::npos || slash_pos == 0 ||
+	    slash_pos == cache_key.size()-1)
+	{
+		// Invalid cache key:
+		// - Does not contain any slashes.
+		// - First slash is either the first or the last character.
+		return string();
+	}
+
+	// Cache key must include a lowercase file extension.
+	const size_t lastdot = cache_key.rfind('.');
+	if (lastdot == string::npos) {
+		// No dot...
+		return string();
+	}
+	const string ext = cache_key.substr(lastdot);
+	if (ext != ".png" && ext != ".jpg") {
+		// Not a supported file extension.
+		return string();
+	}
+
+	const string prefix = cache_key.substr(0, slash_pos);
+	string full_url;
+	if (prefix == "wii" || prefix == "wiiu" ||
+	    prefix == "3ds" || prefix == "ds")
+	{
+		// Wii, Wii U, Nintendo 3DS, Nintendo DS
+		full_url = "https://art.gametdb.com/" + cache_key;
+	} else if (prefix == "amiibo") {
+		// amiibo.
+		// NOTE: We need to remove the file extension.
+		const string filename = cache_key.substr(slash_pos+1);
+		if (filename.size() <= 4) {
+			// Can't remove the extension...
+			return string();
+		}
+		full_url = "https://amiibo.life/nfc/" +
+			filename.substr(0, filename.size()-4) + "/image";
+	} else if (prefix == "gba" || prefix == "gb") {
+		// Game Boy, Game Boy Color, Game Boy Advance
+		full_url = "https://rpdb.gerbilsoft.com/" + cache_key;
+	}
+	// Otherwise: Prefix is not supported.
+
+	return full_url;
+}
+
+/**
+ * Internal cURL data write function.
+ * @param ptr Data to write.
+ * @param size Element size.
+ * @param nmemb Number of elements.
+ * @param userdata InProcDownloadState pointer.
+ * @return Number of bytes written.
+ */
+static size_t inProcDownload_write_data(char *ptr, size_t size, size_t nmemb, void *userdata)
+{
+	InProcDownloadState *const state = static_cast<InProcDownloadState*>(userdata);
+	const size_t len = size * nmemb;
+
+	if (state->bytesWritten + len > INPROC_DL_MAX_SIZE) {
+		// File is too big.
+		return 0;
+	}
+
+	if (!state->f_out) {
+		// First chunk of data. Open the output file.
+		// Opening lazily ensures a 304 Not Modified response
+		// doesn't truncate an existing cached file.
+		// NOTE: Removing the old file first instead of truncating
+		// it: it may be a hard link into the blob store, and other
+		// cache keys sharing the blob need the old contents.
+		remove(state->filename);
+		state->f_out = fopen(state->filename, "wb");
+		if (!state->f_out) {
+			// Error opening the cache file.
+			return 0;
+		}
+	}
+
+	const size_t sz_written = fwrite(ptr, 1, len, state->f_out);
+	state->bytesWritten += sz_written;
+	return sz_written;
+}
+
+/**
+ * Download a file in-process using libcurl.
+ * Skips the rp-download subprocess spawn; only used if
+ * InProcessDownloads is enabled in rom-properties.conf.
+ * @param cache_key Cache key. (unfiltered)
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int CacheManager::inProcDownload(const string &cache_key)
+{
+	// Determine the full URL based on the cache key.
+	const string full_url = urlForCacheKey(cache_key);
+	if (full_url.empty()) {
+		// Invalid or unsupported cache key.
+		return -EINVAL;
+	}
+
+	// Get the cache filename.
+	const string cache_filename = LibCacheCommon::getCacheFilename(cache_key);
+	if (cache_filename.empty()) {
+		// Invalid cache filename.
+		return -EINVAL;
+	}
+
+	// Make sure the path structure exists.
+	int ret = FileSystem::rmkdir(cache_filename);
+	if (ret != 0) {
+		return ret;
+	}
+
+	// Check if we're revalidating an existing cached file.
+	// If so, the download is made conditional, and the cached
+	// copy is only replaced if the server has a newer version.
+	off64_t filesize = 0;
+	time_t filemtime = 0;
+	const bool revalidate =
+		(FileSystem::get_file_size_and_mtime(cache_filename.c_str(), &filesize, &filemtime) == 0 &&
+		 filesize > 0);
+
+	InProcDownloadState state;
+	state.filename = cache_filename.c_str();
+	state.f_out = nullptr;
+	state.bytesWritten = 0;
+
+	// Initialize cURL.
+	CURL *curl = curl_easy_init();
+	if (!curl) {
+		// Could not initialize cURL.
+		return -ENOMEM;	// TODO: Better error?
+	}
+
+	// Set options for curl's "easy" mode.
+	// These match rp-download's CurlDownloader settings.
+	curl_easy_setopt(curl, CURLOPT_URL, full_url.c_str());
+	curl_easy_setopt(curl, CURLOPT_NOPROGRESS, true);
+	curl_easy_setopt(curl, CURLOPT_FAILONERROR, true);
+	curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, true);
+	curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, inProcDownload_write_data);
+	curl_easy_setopt(curl, CURLOPT_WRITEDATA, &state);
+	curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1);
+	curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 2);
+	curl_easy_setopt(curl, CURLOPT_TIMEOUT, 10);
+	curl_easy_setopt(curl, CURLOPT_USERAGENT, "rom-properties/" RP_VERSION_STRING);
+	// Request the Last-Modified time.
+	curl_easy_setopt(curl, CURLOPT_FILETIME, 1L);
+	if (revalidate) {
+		// Conditional request: If-Modified-Since.
+		curl_easy_setopt(curl, CURLOPT_TIMECONDITION, CURL_TIMECOND_IFMODSINCE);
+		curl_easy_setopt(curl, CURLOPT_TIMEVALUE, static_cast<long>(filemtime));
+	}
+	if (!m_proxyUrl.empty()) {
+		// Proxy is set.
+		curl_easy_setopt(curl, CURLOPT_PROXY, m_proxyUrl.c_str());
+	}
+
+	// Download the file.
+	const CURLcode res = curl_easy_perform(curl);
+	long filetime = -1;
+	long cond_unmet = 0;
+	if (res == CURLE_OK) {
+		curl_easy_getinfo(curl, CURLINFO_FILETIME, &filetime);
+		if (revalidate) {
+			curl_easy_getinfo(curl, CURLINFO_CONDITION_UNMET, &cond_unmet);
+		}
+	}
+	curl_easy_cleanup(curl);
+	if (state.f_out) {
+		fclose(state.f_out);
+	}
+
+	if (res == CURLE_OK && cond_unmet) {
+		// 304 Not Modified. The cached file is still valid.
+		// Update the file mtime so the next revalidation
+		// isn't attempted for another week.
+		const time_t now = time(nullptr);
+		FileSystem::set_mtime(cache_filename, now);
+		LibCacheCommon::cacheIndexUpdate(cache_key, filesize, now);
+		return 0;
+	}
+
+	if (res != CURLE_OK || state.bytesWritten == 0) {
+		// Error downloading the file.
+		if (revalidate) {
+			// Keep the cached copy; it's stale but usable.
+			return 0;
+		}
+
+		// Create a 0-byte file to act as a negative cache entry.
+		FILE *f_out = fopen(cache_filename.c_str(), "wb");
+		if (f_out) {
+			fclose(f_out);
+		}
+		LibCacheCommon::cacheIndexUpdate(cache_key, 0, time(nullptr));
+		return -EIO;	// TODO: Better error?
+	}
+
+	// Set the file mtime to the server's Last-Modified time.
+	// NOTE: File origin information (xattrs) is only stored by
+	// rp-download; the in-process path doesn't set it.
+	time_t mtime = time(nullptr);
+	if (filetime > 0) {
+		mtime = static_cast<time_t>(filetime);
+		FileSystem::set_mtime(cache_filename, mtime);
+	}
+
+	// Deduplicate the file against the content-addressed blob store.
+	// Regional variants often share byte-identical cover art.
+	LibCacheCommon::dedupCacheFile(cache_filename);
+
+	// Update the persistent cache index.
+	LibCacheCommon::cacheIndexUpdate(cache_key,
+		static_cast<int64_t>(state.bytesWritten), mtime);
+
+	// File downloaded successfully.
+	return 0;
+}
+
+}
@@ -14,10 +14,14 @@
 // Cache Manager
 #include "CacheManager.hpp"
 
+// libcachecommon
+#include "libcachecommon/NegativeCache.hpp"
+
 // librpbase, librpfile
 #include "librpbase/RomData.hpp"
 #include "librpbase/config/Config.hpp"
 #include "librpbase/img/RpImageLoader.hpp"
+#include "librpfile/FileSystem.hpp"
 #include "librpfile/RpFile.hpp"
 using namespace LibRpBase;
 using namespace LibRpFile;
@@ -29,16 +33,210 @@ using LibRpTexture::rp_image;
 // libromdata
 #include "../RomDataFactory.hpp"
 
+// librpthreads
+#include "librpthreads/Mutex.hpp"
+
 // C includes. (C++ namespace)
 #include <cassert>
 #include <cstring>
 
 // C++ includes.
 #include <memory>
+#include <vector>
 using std::unique_ptr;
 
 namespace LibRomData {
 
+/** Decoded thumbnail image cache. **/
+
+// File browsers often request several thumbnail sizes for the same
+// file in quick succession, e.g. 96px for the icon view followed by
+// 256px for a tooltip. Cache the decoded, pre-rescale rp_image keyed
+// on file identity, so later requests skip the RomData probe and the
+// image decode and only redo the cheap rescale and conversion.
+namespace ThumbImageCache {
+
+struct Entry {
+	uint64_t key;		// Hash of (filename, size, mtime, flags).
+	rp_image *img;		// Decoded image. (owned)
+	uint32_t imgpf;		// Image processing flags.
+	rp_image::sBIT_t sBIT;	// sBIT metadata. (all 0 if none)
+	int decode_size;	// Requested size the image was decoded at.
+};
+
+// Maximum number of cached images.
+// Kept small, since a 256px ARGB32 image is 256 KB.
+static const size_t MAX_ENTRIES = 8;
+
+// Cache entries, in MRU order. (most recent first)
+static std::vector<Entry> cache_entries;
+// Mutex protecting cache_entries.
+static Mutex cache_mutex;
+
+/**
+ * Hash a file identity using 64-bit FNV-1a.
+ * @param filename	[in] Filename.
+ * @param szFile	[in] File size.
+ * @param mtime		[in] File mtime.
+ * @param flags		[in] Selection flags, e.g. small icon preference.
+ * @return 64-bit hash.
+ */
+static uint64_t hashKey(const std::string &filename, off64_t szFile, time_t mtime, unsigned int flags)
+{
+	uint64_t hash = 0xCBF29CE484222325ULL;
+
+	const char *p = filename.c_str();
+	for (; *p != '\0'; p++) {
+		hash ^= static_cast<uint8_t>(*p);
+		hash *= 0x00000100000001B3ULL;
+	}
+
+	// Mix in size, mtime, and flags.
+	uint8_t extra[8+8+4];
+	const int64_t szFile64 = static_cast<int64_t>(szFile);
+	const int64_t mtime64 = static_cast<int64_t>(mtime);
+	memcpy(&extra[0], &szFile64, sizeof(szFile64));
+	memcpy(&extra[8], &mtime64, sizeof(mtime64));
+	memcpy(&extra[16], &flags, sizeof(flags));
+	for (size_t i = 0; i < sizeof(extra); i++) {
+		hash ^= extra[i];
+		hash *= 0x00000100000001B3ULL;
+	}
+
+	return hash;
+}
+
+/**
+ * Look up a decoded image in the cache.
+ *
+ * Entries decoded for a smaller request than reqSize are not
+ * returned, since a larger decode (e.g. a bigger mipmap) may
+ * be available from the source file.
+ *
+ * @param key		[in] File identity hash.
+ * @param reqSize	[in] Requested image size.
+ * @param pImgpf	[out] Image processing flags.
+ * @param pSBIT		[out] sBIT metadata. (all 0 if none)
+ * @return dup() of the cached image (caller must delete it), or nullptr if not cached.
+ */
+static rp_image *lookup(uint64_t key, int reqSize, uint32_t *pImgpf, rp_image::sBIT_t *pSBIT)
+{
+	MutexLocker locker(cache_mutex);
+	for (auto iter = cache_entries.begin(); iter != cache_entries.end(); ++iter) {
+		if (iter->key != key)
+			continue;
+
+		if (iter->decode_size < reqSize &&
+		    iter->img->width() < reqSize &&
+		    iter->img->height() < reqSize)
+		{
+			// Cached image is too small for this request,
+			// and a larger decode may be available.
+			return nullptr;
+		}
+
+		*pImgpf = iter->imgpf;
+		*pSBIT = iter->sBIT;
+		// NOTE: dup() is cheap; the pixel data is shared
+		// copy-on-write.
+		rp_image *const img = iter->img->dup();
+
+		// Move the entry to the front of the MRU list.
+		if (iter != cache_entries.begin()) {
+			Entry entry = *iter;
+			cache_entries.erase(iter);
+			cache_entries.insert(cache_entries.begin(), entry);
+		}
+		return img;
+	}
+
+	// Not cached.
+	return nullptr;
+}
+
+/**
+ * Store a decoded image in the cache.
+ * @param key		[in] File identity hash.
+ * @param img		[in] Decoded image. The cache takes ownership.
+ * @param decode_size	[in] Requested size the image was decoded at.
+ * @param imgpf		[in] Image processing flags.
+ * @param sBIT		[in] sBIT metadata. (all 0 if none)
+ */
+static void store(uint64_t key, rp_image *img, int decode_size, uint32_t imgpf, const rp_image::sBIT_t &sBIT)
+{
+	assert(img != nullptr);
+	if (!img)
+		return;
+
+	MutexLocker locker(cache_mutex);
+
+	// Remove an existing entry with the same key, if any.
+	for (auto iter = cache_entries.begin(); iter != cache_entries.end(); ++iter) {
+		if (iter->key == key) {
+			delete iter->img;
+			cache_entries.erase(iter);
+			break;
+		}
+	}
+
+	// Evict the least-recently-used entry if the cache is full.
+	if (cache_entries.size() >= MAX_ENTRIES) {
+		delete cache_entries.back().img;
+		cache_entries.pop_back();
+	}
+
+	Entry entry;
+	entry.key = key;
+	entry.img = img;
+	entry.imgpf = imgpf;
+	entry.sBIT = sBIT;
+	entry.decode_size = decode_size;
+	cache_entries.insert(cache_entries.begin(), entry);
+}
+
+}
+
+/** Allocation budget **/
+
+// Pixel allocation budget for a single thumbnail request.
+// 4096x4096 ARGB32 is 64 MiB; allow double that for
+// intermediate conversion buffers and mipmap decoding.
+// A malformed header that declares absurd dimensions will
+// fail the decode instead of ballooning the process.
+static const size_t THUMBNAIL_ALLOC_BUDGET = 128U*1024*1024;
+
+/**
+ * Scoped rp_image allocation budget.
+ *
+ * Sets the budget on construction if none is active, and
+ * restores the previous value on destruction, so a frontend
+ * that configured its own budget isn't overridden.
+ */
+class ScopedAllocBudget
+{
+	public:
+		explicit ScopedAllocBudget(size_t max_bytes)
+			: m_prev(rp_image::allocBudget())
+		{
+			if (m_prev == 0) {
+				rp_image::setAllocBudget(max_bytes);
+			}
+		}
+
+		~ScopedAllocBudget()
+		{
+			if (m_prev == 0) {
+				rp_image::setAllocBudget(0);
+			}
+		}
+
+	private:
+		RP_DISABLE_COPY(ScopedAllocBudget)
+
+	private:
+		size_t m_prev;
+};
+
 template<typename ImgClass>
 TCreateThumbnail<ImgClass>::TCreateThumbnail()
 { }
@@ -51,16 +249,21 @@ TCreateThumbnail<ImgClass>::~TCreateThumbnail()
  * Get an internal image.
  * @param romData	[in] RomData object.
  * @param imageType	[in] Image type.
+ * @param req_size	[in] Requested image size.
  * @param pOutSize	[out,opt] Pointer to ImgSize to store the image's size.
  * @param sBIT		[out,opt] sBIT metadata.
+ * @param pRpImgOut	[out,opt] On success, a dup() of the decoded
+ *                      rp_image is stored here. Caller must delete it.
  * @return Internal image, or null ImgClass on error.
  */
 template<typename ImgClass>
 ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
 	const RomData *romData,
 	RomData::ImageType imageType,
+	int req_size,
 	ImgSize *pOutSize,
-	rp_image::sBIT_t *sBIT)
+	rp_image::sBIT_t *sBIT,
+	rp_image **pRpImgOut)
 {
 	assert(imageType >= RomData::IMG_INT_MIN && imageType <= RomData::IMG_INT_MAX);
 	if (imageType < RomData::IMG_INT_MIN || imageType > RomData::IMG_INT_MAX) {
@@ -71,7 +274,9 @@ ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
 		return getNullImgClass();
 	}
 
-	const rp_image *image = romData->image(imageType);
+	// For textures with mipmaps, this may decode a smaller mipmap
+	// that's still at least as large as the requested size.
+	const rp_image *image = romData->imageForSize(imageType, req_size);
 	if (!image) {
 		// No image.
 		if (sBIT) {
@@ -80,8 +285,52 @@ ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
 		return getNullImgClass();
 	}
 
+	// If the image is larger than the requested size, downscale it
+	// here using rp_image's box filter. This gives all frontends
+	// identical results instead of relying on toolkit scaling.
+	unique_ptr<rp_image> scaled_img;
+	if (req_size > 0 && image->format() == rp_image::FORMAT_ARGB32 &&
+	    image->width() > req_size && image->height() > req_size)
+	{
+		ImgSize rs_size = {image->width(), image->height()};
+		const ImgSize tgt_size = {req_size, req_size};
+		rescale_aspect(rs_size, tgt_size);
+		if (rs_size.width > 0 && rs_size.height > 0) {
+			scaled_img.reset(image->downscaled_box(rs_size.width, rs_size.height));
+			if (scaled_img && scaled_img->isValid()) {
+				image = scaled_img.get();
+			} else {
+				// Downscaling failed.
+				scaled_img.reset();
+			}
+		}
+	}
+
+	// Get the sBIT metadata and (optionally) a dup() before converting,
+	// since the conversion may take ownership of a temporary image.
+	if (sBIT) {
+		if (image->get_sBIT(sBIT) != 0) {
+			// No sBIT metadata.
+			// Clear the struct.
+			memset(sBIT, 0, sizeof(*sBIT));
+		}
+	}
+	if (pRpImgOut) {
+		// NOTE: dup() is cheap; the pixel data is shared
+		// copy-on-write.
+		*pRpImgOut = image->dup();
+	}
+
 	// Convert the rp_image to ImgClass.
-	ImgClass ret_img = rpImageToImgClass(image);
+	ImgClass ret_img;
+	if (scaled_img) {
+		// The downscaled image is a temporary, so the frontend
+		// can adopt its pixel buffer instead of copying it.
+		ret_img = rpImageToImgClassMove(scaled_img.release());
+	} else {
+		ret_img = rpImageToImgClass(image);
+	}
+
 	if (isImgClassValid(ret_img)) {
 		// Image converted successfully.
 		if (pOutSize) {
@@ -92,14 +341,10 @@ ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
 			// TODO: Check for errors?
 			getImgClassSize(ret_img, pOutSize);
 		}
-		if (sBIT) {
-			// Get the sBIT metadata.
-			if (image->get_sBIT(sBIT) != 0) {
-				// No sBIT metadata.
-				// Clear the struct.
-				memset(sBIT, 0, sizeof(*sBIT));
-			}
-		}
+	} else if (pRpImgOut) {
+		// Conversion failed; don't return an rp_image.
+		delete *pRpImgOut;
+		*pRpImgOut = nullptr;
 	}
 	return ret_img;
 }
@@ -111,13 +356,16 @@ ImgClass TCreateThumbnail<ImgClass>::getInternalImage(
  * @param req_size	[in] Requested image size.
  * @param pOutSize	[out,opt] Pointer to ImgSize to store the image's size.
  * @param sBIT		[out,opt] sBIT metadata.
+ * @param pRpImgOut	[out,opt] On success, a dup() of the decoded
+ *                      rp_image is stored here. Caller must delete it.
  * @return External image, or null ImgClass on error.
  */
 template<typename ImgClass>
 ImgClass TCreateThumbnail<ImgClass>::getExternalImage(
 	const RomData *romData, RomData::ImageType imageType,
 	int req_size, ImgSize *pOutSize,
-	rp_image::sBIT_t *sBIT)
+	rp_image::sBIT_t *sBIT,
+	rp_image **pRpImgOut)
 {
 	assert(imageType >= RomData::IMG_EXT_MIN && imageType <= RomData::IMG_EXT_MAX);
 	if (imageType < RomData::IMG_EXT_MIN || imageType > RomData::IMG_EXT_MAX) {
@@ -178,29 +426,52 @@ ImgClass TCreateThumbnail<ImgClass>::getExternalImage(
 		// Attempt to load the image.
 		unique_IRpFile<RpFile> file(new RpFile(cache_filename, RpFile::FM_OPEN_READ));
 		if (file->isOpen()) {
-			unique_ptr<rp_image> dl_img(RpImageLoader::load(file.get()));
+			// NOTE: Passing the requested size so JPEG cover scans
+			// can be decoded at a reduced scale via DCT scaling.
+			unique_ptr<rp_image> dl_img(RpImageLoader::load(file.get(), req_size));
 			if (dl_img && dl_img->isValid()) {
 				// Image loaded successfully.
 				file->close();
-				ImgClass ret_img = rpImageToImgClass(dl_img.get());
+
+				// Get the image size, sBIT metadata, and
+				// (optionally) a dup() before converting, since
+				// the conversion takes ownership of the image.
+				const ImgSize dl_size = {dl_img->width(), dl_img->height()};
+				rp_image::sBIT_t dl_sBIT;
+				const bool has_sBIT = (dl_img->get_sBIT(&dl_sBIT) == 0);
+				// NOTE: dup() is cheap; the pixel data is shared
+				// copy-on-write.
+				rp_image *const rp_img_out = (pRpImgOut ? dl_img->dup() : nullptr);
+
+				// The downloaded image is a temporary, so the
+				// frontend can adopt its pixel buffer instead
+				// of copying it.
+				ImgClass ret_img = rpImageToImgClassMove(dl_img.release());
 				if (isImgClassValid(ret_img)) {
 					// Image converted successfully.
 					if (pOutSize) {
 						// Get the image size.
-						pOutSize->width = dl_img->width();
-						pOutSize->height = dl_img->height();
+						*pOutSize = dl_size;
 					}
 					// Get the sBIT metadata.
 					if (sBIT) {
-						if (dl_img->get_sBIT(sBIT) != 0) {
+						if (has_sBIT) {
+							*sBIT = dl_sBIT;
+						} else {
 							// No sBIT metadata.
 							// Clear the struct.
 							memset(sBIT, 0, sizeof(*sBIT));
 						}
 					}
+					if (pRpImgOut) {
+						*pRpImgOut = rp_img_out;
+					}
 					// TODO: Transparency processing?
 					return ret_img;
 				}
+
+				// Conversion failed.
+				delete rp_img_out;
 			}
 		}
 	}
@@ -249,6 +520,27 @@ inline void TCreateThumbnail<ImgClass>::rescale_aspect(ImgSize &rs_size, const I
  */
 template<typename ImgClass>
 int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize, GetThumbnailOutParams_t *pOutParams)
+{
+	return getThumbnail_int(romData, reqSize, pOutParams, nullptr, nullptr);
+}
+
+/**
+ * Create a thumbnail for the specified ROM file.
+ * Internal version with extra output parameters for the
+ * decoded image cache.
+ * @param romData	[in] RomData object.
+ * @param reqSize	[in] Requested image size.
+ * @param pOutParams	[out] Output parameters.
+ * @param pRpImgOut	[out,opt] On success, a dup() of the decoded
+ *                      rp_image is stored here. Caller must delete it.
+ * @param pImgpfOut	[out,opt] Image processing flags.
+ * @return 0 on success; non-zero on error.
+ */
+template<typename ImgClass>
+int TCreateThumbnail<ImgClass>::getThumbnail_int(const RomData *romData, int reqSize,
+	GetThumbnailOutParams_t *pOutParams,
+	rp_image **pRpImgOut,
+	uint32_t *pImgpfOut)
 {
 	assert(romData != nullptr);
 	assert(reqSize > 0);
@@ -258,6 +550,9 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize
 		return RPCT_INVALID_IMAGE_SIZE;
 	}
 
+	// Cap pixel allocations for the duration of this request.
+	ScopedAllocBudget budget(THUMBNAIL_ALLOC_BUDGET);
+
 	// Zero out the output parameters initially.
 	pOutParams->thumbSize.width = 0;
 	pOutParams->thumbSize.height = 0;
@@ -265,6 +560,12 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize
 	pOutParams->fullSize.height = 0;
 	memset(&pOutParams->sBIT, 0, sizeof(pOutParams->sBIT));
 	pOutParams->retImg = getNullImgClass();
+	if (pRpImgOut) {
+		*pRpImgOut = nullptr;
+	}
+	if (pImgpfOut) {
+		*pImgpfOut = 0;
+	}
 
 	uint32_t imgbf = romData->supportedImageTypes();
 	uint32_t imgpf = 0;
@@ -294,7 +595,7 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize
 		// Check for an icon first.
 		// TODO: Define "small sizes" somewhere. (DPI independence?)
 		if (imgbf & RomData::IMGBF_INT_ICON) {
-			pOutParams->retImg = getInternalImage(romData, RomData::IMG_INT_ICON, &pOutParams->fullSize, &pOutParams->sBIT);
+			pOutParams->retImg = getInternalImage(romData, RomData::IMG_INT_ICON, reqSize, &pOutParams->fullSize, &pOutParams->sBIT, pRpImgOut);
 			imgpf = romData->imgpf(RomData::IMG_INT_ICON);
 			imgbf &= ~RomData::IMGBF_INT_ICON;
 
@@ -326,11 +627,11 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize
 		// This image may be present.
 		if (imgType <= RomData::IMG_INT_MAX) {
 			// Internal image.
-			pOutParams->retImg = getInternalImage(romData, imgType, &pOutParams->fullSize, &pOutParams->sBIT);
+			pOutParams->retImg = getInternalImage(romData, imgType, reqSize, &pOutParams->fullSize, &pOutParams->sBIT, pRpImgOut);
 			imgpf = romData->imgpf(imgType);
 		} else {
 			// External image.
-			pOutParams->retImg = getExternalImage(romData, imgType, reqSize, &pOutParams->fullSize, &pOutParams->sBIT);
+			pOutParams->retImg = getExternalImage(romData, imgType, reqSize, &pOutParams->fullSize, &pOutParams->sBIT, pRpImgOut);
 			imgpf = romData->imgpf(imgType);
 		}
 
@@ -351,6 +652,24 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const RomData *romData, int reqSize
 	}
 
 skip_image_check:
+	if (pImgpfOut) {
+		*pImgpfOut = imgpf;
+	}
+	return finishThumbnail(imgpf, reqSize, pOutParams);
+}
+
+/**
+ * Finish a thumbnail: validate the image size and apply the
+ * nearest-neighbor upscaling policy.
+ * @param imgpf		[in] Image processing flags.
+ * @param reqSize	[in] Requested image size.
+ * @param pOutParams	[in,out] Output parameters.
+ *                      (retImg and fullSize must be set)
+ * @return 0 on success; non-zero on error.
+ */
+template<typename ImgClass>
+int TCreateThumbnail<ImgClass>::finishThumbnail(uint32_t imgpf, int reqSize, GetThumbnailOutParams_t *pOutParams)
+{
 	if (pOutParams->fullSize.width <= 0 || pOutParams->fullSize.height <= 0) {
 		// Image size is invalid.
 		freeImgClass(pOutParams->retImg);
@@ -442,17 +761,88 @@ int TCreateThumbnail<ImgClass>::getThumbnail(IRpFile *file, int reqSize, GetThum
 		return RPCT_INVALID_IMAGE_SIZE;
 	}
 
+	// Probe attributes for thumbnail-only opens.
+	static const unsigned int thumb_attrs =
+		RomDataFactory::RDA_HAS_THUMBNAIL | RomDataFactory::RDA_DEFER_FIELDS;
+
+	// Check the persistent negative cache first, so directory
+	// scans don't re-probe files that are known to be unsupported.
+	const std::string ncache_filename = file->filename();
+	const off64_t ncache_size = file->size();
+	time_t ncache_mtime = -1;
+	bool ncache_usable = false;
+	if (!ncache_filename.empty() &&
+	    FileSystem::get_mtime(ncache_filename, &ncache_mtime) == 0)
+	{
+		ncache_usable = true;
+		if (LibCacheCommon::isFileUnsupported(ncache_filename,
+		    ncache_size, ncache_mtime, thumb_attrs))
+		{
+			// File is cached as unsupported.
+			return RPCT_SOURCE_FILE_NOT_SUPPORTED;
+		}
+	}
+
+	// Check the decoded image cache. File browsers often request
+	// several thumbnail sizes for the same file in quick succession;
+	// reuse the decoded image and only redo the rescale.
+	// NOTE: The small icon preference changes which image type is
+	// selected, so it's part of the cache key.
+	const bool smallIcon = (Config::instance()->useIntIconForSmallSizes() && reqSize <= 48);
+	uint64_t cache_hashkey = 0;
+	if (ncache_usable) {
+		cache_hashkey = ThumbImageCache::hashKey(ncache_filename,
+			ncache_size, ncache_mtime, (smallIcon ? 1 : 0));
+		uint32_t imgpf = 0;
+		rp_image::sBIT_t sBIT;
+		rp_image *const cached_img = ThumbImageCache::lookup(cache_hashkey, reqSize, &imgpf, &sBIT);
+		if (cached_img) {
+			// Cache hit. Convert the decoded image and
+			// finish the thumbnail.
+			pOutParams->thumbSize.width = 0;
+			pOutParams->thumbSize.height = 0;
+			pOutParams->fullSize.width = 0;
+			pOutParams->fullSize.height = 0;
+			pOutParams->sBIT = sBIT;
+			pOutParams->retImg = rpImageToImgClass(cached_img);
+			delete cached_img;
+			if (isImgClassValid(pOutParams->retImg)) {
+				getImgClassSize(pOutParams->retImg, &pOutParams->fullSize);
+				return finishThumbnail(imgpf, reqSize, pOutParams);
+			}
+			// Conversion failed. Fall through to the full pipeline.
+			freeImgClass(pOutParams->retImg);
+			pOutParams->retImg = getNullImgClass();
+		}
+	}
+
 	// Get the appropriate RomData class for this ROM.
 	// RomData class *must* support at least one image type.
-	RomData *romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_THUMBNAIL);
+	RomData *romData = RomDataFactory::create(file, thumb_attrs);
 	if (!romData) {
 		// ROM is not supported.
+		if (ncache_usable) {
+			LibCacheCommon::addUnsupportedFile(ncache_filename,
+				ncache_size, ncache_mtime, thumb_attrs);
+		}
 		return RPCT_SOURCE_FILE_NOT_SUPPORTED;
 	}
 
 	// Call the actual function.
-	int ret = getThumbnail(romData, reqSize, pOutParams);
+	rp_image *rp_img = nullptr;
+	uint32_t imgpf = 0;
+	int ret = getThumbnail_int(romData, reqSize, pOutParams,
+		(ncache_usable ? &rp_img : nullptr), &imgpf);
 	romData->unref();
+	if (rp_img) {
+		if (ret == RPCT_SUCCESS) {
+			// Store the decoded image in the cache.
+			// The cache takes ownership.
+			ThumbImageCache::store(cache_hashkey, rp_img, reqSize, imgpf, pOutParams->sBIT);
+		} else {
+			delete rp_img;
+		}
+	}
 	return ret;
 }
 
@@ -484,18 +874,88 @@ int TCreateThumbnail<ImgClass>::getThumbnail(const char *filename, int reqSize,
 		return RPCT_SOURCE_FILE_ERROR;
 	}
 
+	// Probe attributes for thumbnail-only opens.
+	static const unsigned int thumb_attrs =
+		RomDataFactory::RDA_HAS_THUMBNAIL | RomDataFactory::RDA_DEFER_FIELDS;
+
+	// Check the persistent negative cache first, so directory
+	// scans don't re-probe files that are known to be unsupported.
+	const off64_t ncache_size = file->size();
+	time_t ncache_mtime = -1;
+	bool ncache_usable = false;
+	if (FileSystem::get_mtime(filename, &ncache_mtime) == 0) {
+		ncache_usable = true;
+		if (LibCacheCommon::isFileUnsupported(filename,
+		    ncache_size, ncache_mtime, thumb_attrs))
+		{
+			// File is cached as unsupported.
+			file->unref();
+			return RPCT_SOURCE_FILE_NOT_SUPPORTED;
+		}
+	}
+
+	// Check the decoded image cache. File browsers often request
+	// several thumbnail sizes for the same file in quick succession;
+	// reuse the decoded image and only redo the rescale.
+	// NOTE: The small icon preference changes which image type is
+	// selected, so it's part of the cache key.
+	const bool smallIcon = (Config::instance()->useIntIconForSmallSizes() && reqSize <= 48);
+	uint64_t cache_hashkey = 0;
+	if (ncache_usable) {
+		cache_hashkey = ThumbImageCache::hashKey(filename,
+			ncache_size, ncache_mtime, (smallIcon ? 1 : 0));
+		uint32_t imgpf = 0;
+		rp_image::sBIT_t sBIT;
+		rp_image *const cached_img = ThumbImageCache::lookup(cache_hashkey, reqSize, &imgpf, &sBIT);
+		if (cached_img) {
+			// Cache hit. Convert the decoded image and
+			// finish the thumbnail.
+			pOutParams->thumbSize.width = 0;
+			pOutParams->thumbSize.height = 0;
+			pOutParams->fullSize.width = 0;
+			pOutParams->fullSize.height = 0;
+			pOutParams->sBIT = sBIT;
+			pOutParams->retImg = rpImageToImgClass(cached_img);
+			delete cached_img;
+			if (isImgClassValid(pOutParams->retImg)) {
+				file->unref();
+				getImgClassSize(pOutParams->retImg, &pOutParams->fullSize);
+				return finishThumbnail(imgpf, reqSize, pOutParams);
+			}
+			// Conversion failed. Fall through to the full pipeline.
+			freeImgClass(pOutParams->retImg);
+			pOutParams->retImg = getNullImgClass();
+		}
+	}
+
 	// Get the appropriate RomData class for this ROM.
 	// RomData class *must* support at least one image type.
-	RomData *const romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_THUMBNAIL);
+	RomData *const romData = RomDataFactory::create(file, thumb_attrs);
 	file->unref();	// file is ref()'d by RomData.
 	if (!romData) {
 		// ROM is not supported.
+		if (ncache_usable) {
+			LibCacheCommon::addUnsupportedFile(filename,
+				ncache_size, ncache_mtime, thumb_attrs);
+		}
 		return RPCT_SOURCE_FILE_NOT_SUPPORTED;
 	}
 
 	// Call the actual function.
-	int ret = getThumbnail(romData, reqSize, pOutParams);
+	rp_image *rp_img = nullptr;
+	uint32_t imgpf = 0;
+	int ret = getThumbnail_int(romData, reqSize, pOutParams,
+		(ncache_usable ? &rp_img : nullptr), &imgpf);
 	romData->unref();
+	if (rp_img) {
+		if (ret == RPCT_SUCCESS) {
+			// Store the decoded image in the cache.
+			// The cache takes ownership.
+			ThumbImageCache::store(cache_hashkey, rp_img, reqSize, imgpf, pOutParams->sBIT);
+		} else {
+			delete rp_img;
+		}
+	}
 	return ret;
 }
 
@@ -106,14 +106,19 @@ class TCreateThumbnail
 		 * Get an internal image.
 		 * @param romData	[in] RomData object.
 		 * @param imageType	[in] Image type.
+		 * @param req_size	[in] Requested image size.
 		 * @param pOutSize	[out,opt] Pointer to ImgSize to store the image's size.
 		 * @param sBIT		[out,opt] sBIT metadata.
+		 * @param pRpImgOut	[out,opt] On success, a dup() of the decoded
+		 *                      rp_image is stored here. Caller must delete it.
 		 * @return Internal image, or null ImgClass on error.
 		 */
 		ImgClass getInternalImage(const LibRpBase::RomData *romData,
 			LibRpBase::RomData::ImageType imageType,
+			int req_size,
 			ImgSize *pOutSize = nullptr,
-			LibRpTexture::rp_image::sBIT_t *sBIT = nullptr);
+			LibRpTexture::rp_image::sBIT_t *sBIT = nullptr,
+			LibRpTexture::rp_image **pRpImgOut = nullptr);
 
 		/**
 		 * Get an external image.
@@ -122,12 +127,15 @@ class TCreateThumbnail
 		 * @param req_size	[in] Requested image size.
 		 * @param pOutSize	[out,opt] Pointer to ImgSize to store the image's size.
 		 * @param sBIT		[out,opt] sBIT metadata.
+		 * @param pRpImgOut	[out,opt] On success, a dup() of the decoded
+		 *                      rp_image is stored here. Caller must delete it.
 		 * @return External image, or null ImgClass on error.
 		 */
 		ImgClass getExternalImage(
 			const LibRpBase::RomData *romData, LibRpBase::RomData::ImageType imageType,
 			int req_size, ImgSize *pOutSize = nullptr,
-			LibRpTexture::rp_image::sBIT_t *sBIT = nullptr);
+			LibRpTexture::rp_image::sBIT_t *sBIT = nullptr,
+			LibRpTexture::rp_image **pRpImgOut = nullptr);
 
 		/**
 		 * getThumbnail() output parameters.
@@ -175,6 +183,34 @@ class TCreateThumbnail
 		 */
 		static inline void rescale_aspect(ImgSize &rs_size, const ImgSize &tgt_size);
 
+		/**
+		 * Create a thumbnail for the specified ROM file.
+		 * Internal version with extra output parameters for the
+		 * decoded image cache.
+		 * @param romData	[in] RomData object.
+		 * @param reqSize	[in] Requested image size.
+		 * @param pOutParams	[out] Output parameters.
+		 * @param pRpImgOut	[out,opt] On success, a dup() of the decoded
+		 *                      rp_image is stored here. Caller must delete it.
+		 * @param pImgpfOut	[out,opt] Image processing flags.
+		 * @return 0 on success; non-zero on error.
+		 */
+		int getThumbnail_int(const LibRpBase::RomData *romData, int reqSize,
+			GetThumbnailOutParams_t *pOutParams,
+			LibRpTexture::rp_image **pRpImgOut,
+			uint32_t *pImgpfOut);
+
+		/**
+		 * Finish a thumbnail: validate the image size and apply the
+		 * nearest-neighbor upscaling policy.
+		 * @param imgpf		[in] Image processing flags.
+		 * @param reqSize	[in] Requested image size.
+		 * @param pOutParams	[in,out] Output parameters.
+		 *                      (retImg and fullSize must be set)
+		 * @return 0 on success; non-zero on error.
+		 */
+		int finishThumbnail(uint32_t imgpf, int reqSize, GetThumbnailOutParams_t *pOutParams);
+
 	protected:
 		/** Pure virtual functions. **/
 
@@ -185,6 +221,25 @@ class TCreateThumbnail
 		 */
 		virtual ImgClass rpImageToImgClass(const LibRpTexture::rp_image *img) const = 0;
 
+		/**
+		 * Wrapper function to convert rp_image* to ImgClass,
+		 * transferring ownership of the image.
+		 *
+		 * This is called for temporary images that would otherwise be
+		 * deleted immediately after conversion. Frontends whose ImgClass
+		 * can adopt the rp_image's pixel buffer should override this
+		 * to avoid copying the pixel data.
+		 *
+		 * @param img rp_image (takes ownership)
+		 * @return ImgClass
+		 */
+		virtual ImgClass rpImageToImgClassMove(LibRpTexture::rp_image *img) const
+		{
+			ImgClass ret_img = rpImageToImgClass(img);
+			delete img;
+			return ret_img;
+		}
+
 		/**
 		 * Wrapper function to check if an ImgClass is valid.
 		 * @param imgClass ImgClass
@@ -151,6 +151,21 @@ typedef enum {
 						// Could be used for files larger than 4 GB, but generally isn't.
 } ISO_File_Flags_t;
 
+/**
+ * Path table entry, excluding the variable-length directory identifier.
+ * The directory identifier is padded to an even length.
+ *
+ * NOTE: The L path table contains LE values only;
+ * the M path table contains BE values only.
+ */
+typedef struct PACKED _ISO_Path_Table_Entry {
+	uint8_t dir_id_length;			// Directory identifier length.
+	uint8_t xattr_length;			// Extended Attribute Record length.
+	uint32_t block;				// Starting LBA of the directory extent.
+	uint16_t parent_dir_number;		// Parent directory number. (1-based; 1 == root)
+} ISO_Path_Table_Entry;
+ASSERT_STRUCT(ISO_Path_Table_Entry, 8);
+
 /**
  * Volume descriptor header.
  */
@@ -24,6 +24,7 @@
 // C++ includes.
 #include <algorithm>
 #include <array>
+#include <list>
 #include <memory>
 #include <numeric>
 #include <sstream>
@@ -0,0 +1,141 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * RomDataCapGen.cpp: Capability snapshot generator.                       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+/**
+ * Generates the precomputed capability snapshot from the live
+ * RomDataFactory function tables, so frontends can announce the
+ * supported extensions and MIME types without any dynamic list
+ * assembly at process startup.
+ *
+ * Usage: rp-capgen [--header|--json]
+ *   --header: Emit RomDataCapabilities_data.h. (default)
+ *   --json:   Emit a JSON fragment for KDE plugin metadata.
+ *
+ * The generated header is checked in; regenerate it from a full
+ * Linux build when RomData subclasses or their extension/MIME
+ * lists change. RomDataCapSnapshotTest fails if it drifts.
+ */
+
+#include "RomDataFactory.hpp"
+using LibRomData::RomDataFactory;
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <algorithm>
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+/**
+ * Escape a string for a C or JSON string literal.
+ * (The capability strings are plain ASCII; only '"' and '\\'
+ * need escaping, and in practice neither occurs.)
+ * @param str String.
+ * @return Escaped string.
+ */
+static string escape(const char *str)
+{
+	string ret;
+	ret.reserve(strlen(str));
+	for (; *str != 0; str++) {
+		if (*str == '"' || *str == '\\') {
+			ret += '\\';
+		}
+		ret += *str;
+	}
+	return ret;
+}
+
+/**
+ * Emit the generated header. (RomDataCapabilities_data.h)
+ */
+static void print_header(void)
+{
+	// Sort both lists so the output is deterministic.
+	vector<RomDataFactory::ExtInfo> vec_exts = RomDataFactory::supportedFileExtensions();
+	std::sort(vec_exts.begin(), vec_exts.end(),
+		[](const RomDataFactory::ExtInfo &lhs, const RomDataFactory::ExtInfo &rhs) {
+			return (strcmp(lhs.ext, rhs.ext) < 0);
+		});
+	vector<const char*> vec_mimeTypes = RomDataFactory::supportedMimeTypes();
+	std::sort(vec_mimeTypes.begin(), vec_mimeTypes.end(),
+		[](const char *lhs, const char *rhs) {
+			return (strcmp(lhs, rhs) < 0);
+		});
+
+	fputs(
+		"/***************************************************************************\n"
+		" * ROM Properties Page shell extension. (libromdata)                       *\n"
+		" * RomDataCapabilities_data.h: Capability snapshot. (generated)            *\n"
+		" *                                                                         *\n"
+		" * Copyright (c) 2016-2020 by David Korth.                                 *\n"
+		" * SPDX-License-Identifier: GPL-2.0-or-later                               *\n"
+		" ***************************************************************************/\n"
+		"\n"
+		"// This file was generated by rp-capgen. Do not edit.\n"
+		"// Regenerate from a full Linux build with:\n"
+		"//   rp-capgen --header > RomDataCapabilities_data.h\n"
+		"\n"
+		"#ifndef __ROMPROPERTIES_LIBROMDATA_ROMDATACAPABILITIES_DATA_H__\n"
+		"#define __ROMPROPERTIES_LIBROMDATA_ROMDATACAPABILITIES_DATA_H__\n"
+		"\n", stdout);
+
+	printf("// Supported file extensions, with RomDataAttr bits. (%u entries)\n",
+		static_cast<unsigned int>(vec_exts.size()));
+	fputs("static const LibRomData::RomDataFactory::CapabilityExt romdata_cap_exts[] = {\n", stdout);
+	for (auto iter = vec_exts.cbegin(); iter != vec_exts.cend(); ++iter) {
+		printf("\t{\"%s\", 0x%02X},\n", escape(iter->ext).c_str(), iter->attrs);
+	}
+	fputs("};\n\n", stdout);
+
+	printf("// Supported MIME types. (%u entries)\n",
+		static_cast<unsigned int>(vec_mimeTypes.size()));
+	fputs("static const char *const romdata_cap_mimeTypes[] = {\n", stdout);
+	for (auto iter = vec_mimeTypes.cbegin(); iter != vec_mimeTypes.cend(); ++iter) {
+		printf("\t\"%s\",\n", escape(*iter).c_str());
+	}
+	fputs("};\n"
+	      "\n"
+	      "#endif /* __ROMPROPERTIES_LIBROMDATA_ROMDATACAPABILITIES_DATA_H__ */\n", stdout);
+}
+
+/**
+ * Emit a JSON fragment for KDE plugin metadata.
+ */
+static void print_json(void)
+{
+	vector<const char*> vec_mimeTypes = RomDataFactory::supportedMimeTypes();
+	std::sort(vec_mimeTypes.begin(), vec_mimeTypes.end(),
+		[](const char *lhs, const char *rhs) {
+			return (strcmp(lhs, rhs) < 0);
+		});
+
+	fputs("{\n    \"MimeTypes\": [\n", stdout);
+	for (auto iter = vec_mimeTypes.cbegin(); iter != vec_mimeTypes.cend(); ++iter) {
+		printf("        \"%s\"%s\n", escape(*iter).c_str(),
+			(iter + 1 != vec_mimeTypes.cend() ? "," : ""));
+	}
+	fputs("    ]\n}\n", stdout);
+}
+
+int RP_C_API main(int argc, char *argv[])
+{
+	if (argc >= 2 && !strcmp(argv[1], "--json")) {
+		print_json();
+	} else if (argc < 2 || !strcmp(argv[1], "--header")) {
+		print_header();
+	} else {
+		fprintf(stderr, "Usage: %s [--header|--json]\n", argv[0]);
+		return 1;
+	}
+	return 0;
+}
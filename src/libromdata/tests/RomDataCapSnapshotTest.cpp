@@ -0,0 +1,149 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * RomDataCapSnapshotTest.cpp: Capability snapshot drift test.             *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+#include "RomDataFactory.hpp"
+using LibRomData::RomDataFactory;
+
+// C includes. (C++ namespace)
+#include <cstring>
+
+// C++ includes.
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+using std::string;
+using std::unordered_map;
+using std::unordered_set;
+using std::vector;
+
+namespace LibRomData { namespace Tests {
+
+/**
+ * Verifies that the checked-in capability snapshot
+ * (RomDataCapabilities_data.h, generated by rp-capgen) hasn't
+ * drifted from the live function tables. If these tests fail,
+ * regenerate the snapshot:
+ *   rp-capgen --header > RomDataCapabilities_data.h
+ *
+ * NOTE: The live tables must be a subset of the snapshot, not
+ * necessarily equal: reduced builds may compile out subclasses
+ * that were present in the full build that generated the snapshot.
+ */
+class RomDataCapSnapshotTest : public ::testing::Test
+{ };
+
+/**
+ * Verify that the extension snapshot is sorted and unique.
+ */
+TEST_F(RomDataCapSnapshotTest, extSnapshotIsSorted)
+{
+	size_t len = 0;
+	const RomDataFactory::CapabilityExt *const cap_exts =
+		RomDataFactory::extCapabilitySnapshot(&len);
+	ASSERT_NE(nullptr, cap_exts);
+	ASSERT_GT(len, 0U);
+
+	for (size_t i = 1; i < len; i++) {
+		EXPECT_LT(strcmp(cap_exts[i-1].ext, cap_exts[i].ext), 0)
+			<< "Snapshot not sorted/unique at entry " << i
+			<< ": " << cap_exts[i-1].ext << " vs. " << cap_exts[i].ext;
+	}
+}
+
+/**
+ * Verify that every live extension is in the snapshot,
+ * with matching attributes.
+ */
+TEST_F(RomDataCapSnapshotTest, extSnapshotCoversLiveTables)
+{
+	size_t len = 0;
+	const RomDataFactory::CapabilityExt *const cap_exts =
+		RomDataFactory::extCapabilitySnapshot(&len);
+
+	unordered_map<string, unsigned int> map_cap;
+	for (size_t i = 0; i < len; i++) {
+		map_cap[cap_exts[i].ext] = cap_exts[i].attrs;
+	}
+
+	const vector<RomDataFactory::ExtInfo> &vec_exts =
+		RomDataFactory::supportedFileExtensions();
+	EXPECT_GT(vec_exts.size(), 0U);
+	for (auto iter = vec_exts.cbegin(); iter != vec_exts.cend(); ++iter) {
+		auto cap_iter = map_cap.find(iter->ext);
+		if (cap_iter == map_cap.end()) {
+			ADD_FAILURE() << "Extension " << iter->ext
+				<< " is missing from the snapshot. Regenerate it with rp-capgen.";
+			continue;
+		}
+		EXPECT_EQ(cap_iter->second, iter->attrs)
+			<< "Attribute mismatch for " << iter->ext
+			<< ". Regenerate the snapshot with rp-capgen.";
+	}
+}
+
+/**
+ * Verify that the MIME type snapshot is sorted and unique.
+ */
+TEST_F(RomDataCapSnapshotTest, mimeSnapshotIsSorted)
+{
+	size_t len = 0;
+	const char *const *const cap_mimeTypes =
+		RomDataFactory::mimeCapabilitySnapshot(&len);
+	ASSERT_NE(nullptr, cap_mimeTypes);
+	ASSERT_GT(len, 0U);
+
+	for (size_t i = 1; i < len; i++) {
+		EXPECT_LT(strcmp(cap_mimeTypes[i-1], cap_mimeTypes[i]), 0)
+			<< "Snapshot not sorted/unique at entry " << i
+			<< ": " << cap_mimeTypes[i-1] << " vs. " << cap_mimeTypes[i];
+	}
+}
+
+/**
+ * Verify that every live MIME type is in the snapshot.
+ */
+TEST_F(RomDataCapSnapshotTest, mimeSnapshotCoversLiveTables)
+{
+	size_t len = 0;
+	const char *const *const cap_mimeTypes =
+		RomDataFactory::mimeCapabilitySnapshot(&len);
+
+	unordered_set<string> set_cap;
+	for (size_t i = 0; i < len; i++) {
+		set_cap.insert(cap_mimeTypes[i]);
+	}
+
+	const vector<const char*> &vec_mimeTypes =
+		RomDataFactory::supportedMimeTypes();
+	EXPECT_GT(vec_mimeTypes.size(), 0U);
+	for (auto iter = vec_mimeTypes.cbegin(); iter != vec_mimeTypes.cend(); ++iter) {
+		EXPECT_NE(set_cap.find(*iter), set_cap.end())
+			<< "MIME type " << *iter
+			<< " is missing from the snapshot. Regenerate it with rp-capgen.";
+	}
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRomData test suite: Capability snapshot drift tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
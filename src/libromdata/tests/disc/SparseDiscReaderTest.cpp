@@ -0,0 +1,240 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * SparseDiscReaderTest.cpp: SparseDiscReader test.                        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// librpcpu
+#include "librpcpu/byteswap.h"
+
+// librpfile
+#include "librpfile/RpMemFile.hpp"
+using LibRpFile::RpMemFile;
+
+// libromdata
+#include "disc/CisoGcnReader.hpp"
+#include "disc/ciso_gcn.h"
+using LibRomData::CisoGcnReader;
+
+// C includes. (C++ namespace)
+#include <cstring>
+
+// C++ includes.
+#include <memory>
+using std::unique_ptr;
+
+// Uninitialized vector class.
+// Reference: http://andreoffringa.org/?q=uvector
+#include "uvector.h"
+
+namespace LibRomData { namespace Tests {
+
+class SparseDiscReaderTest : public ::testing::Test
+{
+	protected:
+		SparseDiscReaderTest()
+			: m_file(nullptr)
+			, m_cisoReader(nullptr)
+		{ }
+
+		void SetUp(void) final;
+		void TearDown(void) final;
+
+	public:
+		// CISO image parameters.
+		// Alternating used/empty blocks to exercise both the
+		// physical-read and empty-block paths.
+		static const unsigned int BLOCK_SIZE = CISO_BLOCK_SIZE_MIN;	// 32 KB
+		static const unsigned int BLOCK_COUNT = 64;			// 2 MB logical disc
+
+		// Number of full-disc read passes for the benchmark.
+		static const unsigned int BENCHMARK_ITERATIONS = 500;
+
+		/**
+		 * Is the specified logical block a used block?
+		 * @param blockIdx Logical block index.
+		 * @return True if used; false if empty.
+		 */
+		static inline bool is_used_block(unsigned int blockIdx)
+		{
+			// NOTE: Odd blocks are used so the last block is used.
+			// (The disc size is calculated from the last used block.)
+			return (blockIdx & 1);
+		}
+
+		/**
+		 * Get the expected byte at the specified logical disc address.
+		 * Empty blocks read back as zero.
+		 * @param blockIdx Logical block index.
+		 * @param offset Offset within the block.
+		 * @return Expected byte.
+		 */
+		static inline uint8_t expected_byte(unsigned int blockIdx, unsigned int offset)
+		{
+			if (!is_used_block(blockIdx)) {
+				// Empty block.
+				return 0;
+			}
+			return static_cast<uint8_t>(blockIdx ^ (offset & 0xFF));
+		}
+
+	public:
+		// In-memory CISO image.
+		ao::uvector<uint8_t> m_ciso_data;
+
+		RpMemFile *m_file;
+		CisoGcnReader *m_cisoReader;
+};
+
+/**
+ * SetUp() function.
+ * Builds an in-memory CISO image and opens a CisoGcnReader.
+ */
+void SparseDiscReaderTest::SetUp(void)
+{
+	// Determine the number of used blocks.
+	unsigned int used_blocks = 0;
+	for (unsigned int i = 0; i < BLOCK_COUNT; i++) {
+		if (is_used_block(i)) {
+			used_blocks++;
+		}
+	}
+
+	// Build the CISO image.
+	m_ciso_data.resize(CISO_HEADER_SIZE + (used_blocks * BLOCK_SIZE));
+	memset(m_ciso_data.data(), 0, CISO_HEADER_SIZE);
+
+	CISOHeader *const cisoHeader = reinterpret_cast<CISOHeader*>(m_ciso_data.data());
+	cisoHeader->magic = cpu_to_be32(CISO_MAGIC);
+	cisoHeader->block_size = cpu_to_le32(BLOCK_SIZE);
+
+	uint8_t *p = m_ciso_data.data() + CISO_HEADER_SIZE;
+	for (unsigned int i = 0; i < BLOCK_COUNT; i++) {
+		if (!is_used_block(i)) {
+			// Empty block. Not stored in the image.
+			continue;
+		}
+
+		cisoHeader->map[i] = 1;
+		for (unsigned int offset = 0; offset < BLOCK_SIZE; offset++) {
+			p[offset] = expected_byte(i, offset);
+		}
+		p += BLOCK_SIZE;
+	}
+
+	// Open the CISO image.
+	m_file = new RpMemFile(m_ciso_data.data(), m_ciso_data.size());
+	ASSERT_TRUE(m_file->isOpen());
+	m_cisoReader = new CisoGcnReader(m_file);
+	ASSERT_TRUE(m_cisoReader->isOpen());
+}
+
+/**
+ * TearDown() function.
+ */
+void SparseDiscReaderTest::TearDown(void)
+{
+	delete m_cisoReader;
+	m_cisoReader = nullptr;
+	if (m_file) {
+		m_file->unref();
+		m_file = nullptr;
+	}
+}
+
+/**
+ * Read the entire disc sequentially and verify the data.
+ * The chunk size spans two blocks, so reads cross block boundaries.
+ */
+TEST_F(SparseDiscReaderTest, sequentialRead_test)
+{
+	static const unsigned int CHUNK_SIZE = BLOCK_SIZE * 2;
+	const off64_t disc_size = m_cisoReader->size();
+	ASSERT_EQ(static_cast<off64_t>(BLOCK_COUNT) * BLOCK_SIZE, disc_size);
+
+	ao::uvector<uint8_t> buf;
+	buf.resize(CHUNK_SIZE);
+
+	m_cisoReader->rewind();
+	for (off64_t addr = 0; addr < disc_size; addr += CHUNK_SIZE) {
+		ASSERT_EQ(CHUNK_SIZE, m_cisoReader->read(buf.data(), CHUNK_SIZE));
+
+		// Verify the chunk.
+		for (unsigned int offset = 0; offset < CHUNK_SIZE; offset++) {
+			const off64_t disc_addr = addr + offset;
+			const unsigned int blockIdx = static_cast<unsigned int>(disc_addr / BLOCK_SIZE);
+			ASSERT_EQ(expected_byte(blockIdx, static_cast<unsigned int>(disc_addr % BLOCK_SIZE)), buf[offset]) <<
+				"Incorrect data at disc address 0x" << std::hex << disc_addr;
+		}
+	}
+}
+
+/**
+ * Read unaligned ranges crossing block boundaries.
+ */
+TEST_F(SparseDiscReaderTest, unalignedRead_test)
+{
+	static const unsigned int READ_SIZE = 256;
+
+	ao::uvector<uint8_t> buf;
+	buf.resize(READ_SIZE);
+
+	// Read ranges straddling each used/empty block boundary.
+	for (unsigned int i = 1; i < BLOCK_COUNT; i++) {
+		const off64_t addr = (static_cast<off64_t>(i) * BLOCK_SIZE) - (READ_SIZE / 2);
+		ASSERT_EQ(0, m_cisoReader->seek(addr));
+		ASSERT_EQ(READ_SIZE, m_cisoReader->read(buf.data(), READ_SIZE));
+
+		for (unsigned int offset = 0; offset < READ_SIZE; offset++) {
+			const off64_t disc_addr = addr + offset;
+			const unsigned int blockIdx = static_cast<unsigned int>(disc_addr / BLOCK_SIZE);
+			ASSERT_EQ(expected_byte(blockIdx, static_cast<unsigned int>(disc_addr % BLOCK_SIZE)), buf[offset]) <<
+				"Incorrect data at disc address 0x" << std::hex << disc_addr;
+		}
+	}
+}
+
+/**
+ * Benchmark SparseDiscReader read bandwidth.
+ * Reads the entire disc in 64 KB chunks, BENCHMARK_ITERATIONS times.
+ */
+TEST_F(SparseDiscReaderTest, read_benchmark)
+{
+	static const unsigned int CHUNK_SIZE = BLOCK_SIZE * 2;
+	const off64_t disc_size = m_cisoReader->size();
+
+	ao::uvector<uint8_t> buf;
+	buf.resize(CHUNK_SIZE);
+
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		m_cisoReader->rewind();
+		for (off64_t addr = 0; addr < disc_size; addr += CHUNK_SIZE) {
+			ASSERT_EQ(CHUNK_SIZE, m_cisoReader->read(buf.data(), CHUNK_SIZE));
+		}
+	}
+}
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRomData test suite: SparseDiscReader tests.\n\n");
+	fprintf(stderr, "Benchmark iterations: %u (%u MB per pass)\n",
+		LibRomData::Tests::SparseDiscReaderTest::BENCHMARK_ITERATIONS,
+		(LibRomData::Tests::SparseDiscReaderTest::BLOCK_COUNT *
+		 LibRomData::Tests::SparseDiscReaderTest::BLOCK_SIZE) / (1024U*1024U));
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
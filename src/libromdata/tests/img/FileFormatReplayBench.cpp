@@ -0,0 +1,326 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata/tests)                 *
+ * FileFormatReplayBench.cpp: FileFormat corpus replay benchmark.          *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+/**
+ * Replays the ImageDecoderTest corpus through FileFormatFactory::create()
+ * in a loop and prints a per-format throughput table. Run it before and
+ * after a change (or between releases) to catch formats whose open path
+ * quietly got slower.
+ *
+ * On Linux, hardware perf counters (instructions and cache misses) are
+ * read via perf_event_open() when available; the counters degrade to
+ * "n/a" when the syscall is unavailable, e.g. in containers with a
+ * restrictive seccomp profile.
+ *
+ * Usage: FileFormatReplayBench [corpus_dir] [iterations]
+ *   corpus_dir: Corpus directory. (default: ImageDecoder_data)
+ *   iterations: Open iterations per file. (default: 25)
+ *
+ * NOTE: This is a benchmark, not a pass/fail test, so it's wired into
+ * the rp-bench target instead of ctest.
+ */
+
+#include "common.h"
+
+// librpfile, librptexture
+#include "librpfile/DirScanner.hpp"
+#include "librpfile/RpMemFile.hpp"
+#include "librptexture/FileFormatFactory.hpp"
+#include "librptexture/fileformat/FileFormat.hpp"
+using LibRpFile::RpMemFile;
+using LibRpTexture::FileFormat;
+using LibRpTexture::FileFormatFactory;
+
+// zlib for the gzipped corpus files.
+#include <zlib.h>
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+
+// C++ includes.
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+using std::map;
+using std::string;
+using std::vector;
+
+#ifdef __linux__
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#else /* !__linux__ */
+// Placeholder values; PerfCounter is a no-op off-Linux.
+# define PERF_TYPE_HARDWARE		0
+# define PERF_COUNT_HW_INSTRUCTIONS	0
+# define PERF_COUNT_HW_CACHE_MISSES	0
+#endif /* __linux__ */
+
+/**
+ * Hardware perf counter wrapper. (Linux perf_event_open)
+ *
+ * On other platforms, or if perf_event_open() is unavailable,
+ * isAvailable() returns false and readings are reported as "n/a".
+ */
+class PerfCounter
+{
+	public:
+		/**
+		 * @param type perf_event type. (PERF_TYPE_HARDWARE)
+		 * @param config perf_event config. (PERF_COUNT_HW_*)
+		 */
+		PerfCounter(uint32_t type, uint64_t config)
+#ifdef __linux__
+			: m_fd(-1)
+		{
+			struct perf_event_attr attr;
+			memset(&attr, 0, sizeof(attr));
+			attr.type = type;
+			attr.size = sizeof(attr);
+			attr.config = config;
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+
+			// Current process, any CPU.
+			m_fd = static_cast<int>(syscall(__NR_perf_event_open,
+				&attr, 0, -1, -1, 0));
+		}
+#else /* !__linux__ */
+		{
+			RP_UNUSED(type);
+			RP_UNUSED(config);
+		}
+#endif /* __linux__ */
+
+		~PerfCounter()
+		{
+#ifdef __linux__
+			if (m_fd >= 0) {
+				close(m_fd);
+			}
+#endif /* __linux__ */
+		}
+
+	private:
+		RP_DISABLE_COPY(PerfCounter)
+
+	public:
+		bool isAvailable(void) const
+		{
+#ifdef __linux__
+			return (m_fd >= 0);
+#else /* !__linux__ */
+			return false;
+#endif /* __linux__ */
+		}
+
+		void start(void)
+		{
+#ifdef __linux__
+			if (m_fd >= 0) {
+				ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+				ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+			}
+#endif /* __linux__ */
+		}
+
+		/**
+		 * Stop the counter and read its value.
+		 * @return Counter value, or 0 if unavailable.
+		 */
+		uint64_t stop(void)
+		{
+#ifdef __linux__
+			if (m_fd < 0) {
+				return 0;
+			}
+			ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+			uint64_t value = 0;
+			if (read(m_fd, &value, sizeof(value)) != sizeof(value)) {
+				return 0;
+			}
+			return value;
+#else /* !__linux__ */
+			return 0;
+#endif /* __linux__ */
+		}
+
+#ifdef __linux__
+	private:
+		int m_fd;
+#endif /* __linux__ */
+};
+
+// Per-format accumulated results.
+struct FormatStats {
+	unsigned int files;		// Files attributed to this format.
+	uint64_t opens;			// Total create() calls.
+	uint64_t bytes;			// Total bytes opened. (input size x opens)
+	uint64_t time_ns;		// Total time in create().
+	uint64_t instructions;		// Total retired instructions.
+	uint64_t cache_misses;		// Total cache misses.
+
+	FormatStats()
+		: files(0), opens(0), bytes(0)
+		, time_ns(0), instructions(0), cache_misses(0)
+	{ }
+};
+
+/**
+ * Load a corpus file into memory, transparently decompressing
+ * gzipped files. (The corpus stores most textures as .gz.)
+ * @param filename	[in] Filename.
+ * @param buf		[out] Destination buffer.
+ * @return 0 on success; non-zero on error.
+ */
+static int loadCorpusFile(const string &filename, vector<uint8_t> &buf)
+{
+	// NOTE: gzopen() reads uncompressed files as-is, so it
+	// handles both the .gz corpus files and the plain ones.
+	gzFile f = gzopen(filename.c_str(), "rb");
+	if (!f) {
+		return -1;
+	}
+#if ZLIB_VERNUM >= 0x1240
+	gzbuffer(f, 128*1024);
+#endif /* ZLIB_VERNUM >= 0x1240 */
+
+	buf.clear();
+	uint8_t tmp[64*1024];
+	while (true) {
+		const int sz_read = gzread(f, tmp, sizeof(tmp));
+		if (sz_read < 0) {
+			gzclose(f);
+			return -2;
+		} else if (sz_read == 0) {
+			break;
+		}
+		buf.insert(buf.end(), tmp, tmp + sz_read);
+	}
+	gzclose(f);
+	return 0;
+}
+
+int RP_C_API main(int argc, char *argv[])
+{
+	const char *corpus_dir = "ImageDecoder_data";
+	unsigned int iterations = 25;
+	if (argc >= 2) {
+		corpus_dir = argv[1];
+	}
+	if (argc >= 3) {
+		const unsigned long num = strtoul(argv[2], nullptr, 10);
+		if (num >= 1) {
+			iterations = static_cast<unsigned int>(num);
+		}
+	}
+
+	// Enumerate the corpus.
+	vector<string> files;
+	LibRpFile::DirScanner::ScanOptions options;
+	options.recursive = true;
+	int ret = LibRpFile::DirScanner::scan(corpus_dir, options, files);
+	if (ret != 0 || files.empty()) {
+		fprintf(stderr, "*** ERROR: Unable to enumerate corpus directory '%s': %s\n",
+			corpus_dir, strerror(-ret));
+		fprintf(stderr, "Run this from the bin/ directory, or pass the corpus path.\n");
+		return EXIT_FAILURE;
+	}
+
+	printf("Replaying %u corpus files through FileFormatFactory::create(), %u iteration(s) each...\n",
+		static_cast<unsigned int>(files.size()), iterations);
+
+	PerfCounter ctr_instructions(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+	PerfCounter ctr_cache_misses(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+	const bool have_perf = ctr_instructions.isAvailable();
+	if (!have_perf) {
+		printf("NOTE: perf_event_open() is unavailable; instruction and cache miss\n"
+		       "counts will not be reported.\n");
+	}
+
+	// Per-format statistics, keyed on textureFormatName().
+	// NOTE: std::map so the table is sorted by name.
+	map<string, FormatStats> stats;
+
+	vector<uint8_t> buf;
+	for (auto iter = files.cbegin(); iter != files.cend(); ++iter) {
+		if (loadCorpusFile(*iter, buf) != 0 || buf.empty()) {
+			// Not readable, or empty. Skip it.
+			continue;
+		}
+
+		// Classify the file using one untimed open.
+		string format;
+		{
+			RpMemFile *const memFile = new RpMemFile(buf.data(), buf.size());
+			FileFormat *const ff = FileFormatFactory::create(memFile);
+			if (ff) {
+				format = ff->textureFormatName();
+				ff->unref();
+			} else {
+				format = "(unsupported)";
+			}
+			memFile->unref();
+		}
+
+		FormatStats &fs = stats[format];
+		fs.files++;
+
+		// Timed replay loop.
+		ctr_instructions.start();
+		ctr_cache_misses.start();
+		const auto t_start = std::chrono::steady_clock::now();
+		for (unsigned int i = iterations; i > 0; i--) {
+			RpMemFile *const memFile = new RpMemFile(buf.data(), buf.size());
+			FileFormat *const ff = FileFormatFactory::create(memFile);
+			if (ff) {
+				ff->unref();
+			}
+			memFile->unref();
+		}
+		const auto elapsed = std::chrono::steady_clock::now() - t_start;
+		fs.instructions += ctr_instructions.stop();
+		fs.cache_misses += ctr_cache_misses.stop();
+		fs.time_ns += static_cast<uint64_t>(
+			std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+		fs.opens += iterations;
+		fs.bytes += static_cast<uint64_t>(buf.size()) * iterations;
+	}
+
+	// Print the per-format table.
+	printf("\n%-28s %6s %8s %10s %10s %12s %12s\n",
+		"format", "files", "opens", "us/open", "MB/s", "insn/open", "miss/open");
+	for (auto iter = stats.cbegin(); iter != stats.cend(); ++iter) {
+		const FormatStats &fs = iter->second;
+		const double us_per_open = (fs.opens != 0)
+			? (static_cast<double>(fs.time_ns) / 1000.0) / static_cast<double>(fs.opens)
+			: 0.0;
+		const double mb_per_sec = (fs.time_ns != 0)
+			? (static_cast<double>(fs.bytes) * 1000.0) / static_cast<double>(fs.time_ns)
+			: 0.0;
+
+		printf("%-28s %6u %8llu %10.2f %10.2f ",
+			iter->first.c_str(), fs.files,
+			static_cast<unsigned long long>(fs.opens),
+			us_per_open, mb_per_sec);
+		if (have_perf) {
+			printf("%12llu %12llu\n",
+				static_cast<unsigned long long>(fs.instructions / fs.opens),
+				static_cast<unsigned long long>(fs.cache_misses / fs.opens));
+		} else {
+			printf("%12s %12s\n", "n/a", "n/a");
+		}
+	}
+	return EXIT_SUCCESS;
+}
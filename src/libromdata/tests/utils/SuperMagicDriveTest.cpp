@@ -304,6 +304,65 @@ TEST_F(SuperMagicDriveTest, decodeBlock_sse2_benchmark)
 }
 #endif /* SMD_HAS_SSE2 */
 
+#ifdef SMD_HAS_AVX2
+/**
+ * Test the AVX2-optimized batched SMD decoder.
+ */
+TEST_F(SuperMagicDriveTest, decodeAll_avx2_test)
+{
+	if (!RP_CPU_HasAVX2()) {
+		fprintf(stderr, "*** AVX2 is not supported on this CPU. Skipping test.");
+		return;
+	}
+
+	SuperMagicDrive::decodeAll_avx2(align_buf, m_smd_data, SuperMagicDrive::SMD_BLOCK_SIZE);
+	EXPECT_EQ(0, memcmp(m_bin_data, align_buf, SuperMagicDrive::SMD_BLOCK_SIZE));
+}
+
+/**
+ * Benchmark the AVX2-optimized batched SMD decoder.
+ */
+TEST_F(SuperMagicDriveTest, decodeAll_avx2_benchmark)
+{
+	if (!RP_CPU_HasAVX2()) {
+		fprintf(stderr, "*** AVX2 is not supported on this CPU. Skipping test.");
+		return;
+	}
+
+	for (unsigned int i = BENCHMARK_ITERATIONS; i > 0; i--) {
+		SuperMagicDrive::decodeAll_avx2(align_buf, m_smd_data, SuperMagicDrive::SMD_BLOCK_SIZE);
+	}
+}
+#endif /* SMD_HAS_AVX2 */
+
+/**
+ * Test the decodeAll() dispatch function with multiple blocks.
+ */
+TEST_F(SuperMagicDriveTest, decodeAll_dispatch_test)
+{
+	// Build a 4-block source buffer by repeating the test block.
+	// 32-byte alignment so the AVX2 streaming path is exercised.
+	static const unsigned int BLOCK_COUNT = 4;
+	const unsigned int len = BLOCK_COUNT * SuperMagicDrive::SMD_BLOCK_SIZE;
+	uint8_t *const src = static_cast<uint8_t*>(aligned_malloc(32, len));
+	uint8_t *const dest = static_cast<uint8_t*>(aligned_malloc(32, len));
+	ASSERT_TRUE(src != nullptr);
+	ASSERT_TRUE(dest != nullptr);
+	for (unsigned int i = 0; i < BLOCK_COUNT; i++) {
+		memcpy(&src[i * SuperMagicDrive::SMD_BLOCK_SIZE], m_smd_data,
+			SuperMagicDrive::SMD_BLOCK_SIZE);
+	}
+
+	SuperMagicDrive::decodeAll(dest, src, len);
+	for (unsigned int i = 0; i < BLOCK_COUNT; i++) {
+		EXPECT_EQ(0, memcmp(m_bin_data, &dest[i * SuperMagicDrive::SMD_BLOCK_SIZE],
+			SuperMagicDrive::SMD_BLOCK_SIZE)) << "Block " << i << " is incorrect.";
+	}
+
+	aligned_free(src);
+	aligned_free(dest);
+}
+
 // NOTE: Add more instruction sets to the #ifdef if other optimizations are added.
 #if defined(SMD_HAS_MMX) || defined(SMD_HAS_SSE2)
 /**
@@ -47,4 +47,58 @@ void SuperMagicDrive::decodeBlock_cpp(uint8_t *RESTRICT pDest, const uint8_t *RE
 	}
 }
 
+/**
+ * Decode a series of Super Magic Drive interleaved blocks.
+ *
+ * The CPU-specific block decoder is resolved once for the
+ * whole buffer instead of once per block, and the AVX2
+ * version streams the destination with non-temporal stores.
+ *
+ * NOTE: Pointers must be 16-byte aligned if using SSE2.
+ * @param pDest	[out] Destination buffer.
+ * @param pSrc	[in] Source buffer.
+ * @param len	[in] Length, in bytes. (Rounded down to a multiple of SMD_BLOCK_SIZE.)
+ */
+void SuperMagicDrive::decodeAll(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc, size_t len)
+{
+	// Round down to a multiple of the block size.
+	len &= ~(static_cast<size_t>(SMD_BLOCK_SIZE) - 1);
+
+#ifdef SMD_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		// AVX2 version handles the entire buffer.
+		decodeAll_avx2(pDest, pSrc, len);
+		return;
+	}
+#endif /* SMD_HAS_AVX2 */
+
+	// Resolve the block decoder once for the whole buffer.
+	// decodeBlock() would re-dispatch on every block.
+	void (*pfnDecodeBlock)(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc);
+#ifdef SMD_ALWAYS_HAS_SSE2
+	// amd64 always has SSE2.
+	pfnDecodeBlock = decodeBlock_sse2;
+#else /* !SMD_ALWAYS_HAS_SSE2 */
+# ifdef SMD_HAS_SSE2
+	if (RP_CPU_HasSSE2()) {
+		pfnDecodeBlock = decodeBlock_sse2;
+	} else
+# endif /* SMD_HAS_SSE2 */
+# ifdef SMD_HAS_MMX
+	if (RP_CPU_HasMMX()) {
+		pfnDecodeBlock = decodeBlock_mmx;
+	} else
+# endif /* SMD_HAS_MMX */
+	{
+		pfnDecodeBlock = decodeBlock_cpp;
+	}
+#endif /* SMD_ALWAYS_HAS_SSE2 */
+
+	for (; len >= SMD_BLOCK_SIZE; len -= SMD_BLOCK_SIZE) {
+		pfnDecodeBlock(pDest, pSrc);
+		pDest += SMD_BLOCK_SIZE;
+		pSrc += SMD_BLOCK_SIZE;
+	}
+}
+
 }
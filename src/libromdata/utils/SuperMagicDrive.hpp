@@ -13,6 +13,7 @@
 #include "librpcpu/cpu_dispatch.h"
 
 #include <stdint.h>
+#include <stddef.h>
 
 #if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
 # include "librpcpu/cpuflags_x86.h"
@@ -24,6 +25,7 @@
 #  define SMD_HAS_MMX 1
 # endif
 # define SMD_HAS_SSE2 1
+# define SMD_HAS_AVX2 1
 #endif
 #ifdef RP_CPU_AMD64
 # define SMD_ALWAYS_HAS_SSE2 1
@@ -73,6 +75,18 @@ class SuperMagicDrive
 		static void decodeBlock_sse2(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc);
 #endif /* SMD_HAS_SSE2 */
 
+#ifdef SMD_HAS_AVX2
+		/**
+		 * Decode a series of Super Magic Drive interleaved blocks.
+		 * AVX2-optimized version. Uses non-temporal stores if the
+		 * destination is 32-byte aligned.
+		 * @param pDest	[out] Destination buffer.
+		 * @param pSrc	[in] Source buffer.
+		 * @param len	[in] Length, in bytes. (Must be a multiple of SMD_BLOCK_SIZE.)
+		 */
+		static void decodeAll_avx2(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc, size_t len);
+#endif /* SMD_HAS_AVX2 */
+
 	public:
 		// SMD block size.
 		static const unsigned int SMD_BLOCK_SIZE = 16384;
@@ -84,6 +98,20 @@ class SuperMagicDrive
 		 * @param pSrc	[in] Source block. (Must be 16 KB.)
 		 */
 		static IFUNC_SSE2_INLINE void decodeBlock(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc);
+
+		/**
+		 * Decode a series of Super Magic Drive interleaved blocks.
+		 *
+		 * The CPU-specific block decoder is resolved once for the
+		 * whole buffer instead of once per block, and the AVX2
+		 * version streams the destination with non-temporal stores.
+		 *
+		 * NOTE: Pointers must be 16-byte aligned if using SSE2.
+		 * @param pDest	[out] Destination buffer.
+		 * @param pSrc	[in] Source buffer.
+		 * @param len	[in] Length, in bytes. (Rounded down to a multiple of SMD_BLOCK_SIZE.)
+		 */
+		static void decodeAll(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc, size_t len);
 };
 
 // TODO: Use gcc target-specific function attributes if available?
@@ -0,0 +1,85 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (libromdata)                       *
+ * SuperMagicDrive_avx2.cpp: Super Magic Drive deinterleaving function.    *
+ * AVX2-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "SuperMagicDrive.hpp"
+
+#ifdef SMD_HAS_AVX2
+
+// C includes. (C++ namespace)
+#include <cassert>
+
+// AVX2 intrinsics.
+#include <immintrin.h>
+
+namespace LibRomData {
+
+/**
+ * Decode a series of Super Magic Drive interleaved blocks.
+ * AVX2-optimized version. Uses non-temporal stores if the
+ * destination is 32-byte aligned.
+ * @param pDest	[out] Destination buffer.
+ * @param pSrc	[in] Source buffer.
+ * @param len	[in] Length, in bytes. (Must be a multiple of SMD_BLOCK_SIZE.)
+ */
+void SuperMagicDrive::decodeAll_avx2(uint8_t *RESTRICT pDest, const uint8_t *RESTRICT pSrc, size_t len)
+{
+	assert(len % SMD_BLOCK_SIZE == 0);
+
+	// Non-temporal stores require 32-byte alignment.
+	// They also bypass the cache, which matters for multi-megabyte
+	// ROM images: the decoded data would otherwise evict everything
+	// else before the caller reads it sequentially.
+	const bool canStream = (reinterpret_cast<uintptr_t>(pDest) % 32 == 0);
+
+	for (; len >= SMD_BLOCK_SIZE; len -= SMD_BLOCK_SIZE) {
+		// First 8 KB of the source block is ODD bytes.
+		// Second 8 KB of the source block is EVEN bytes.
+		const __m256i *pSrc_odd = reinterpret_cast<const __m256i*>(pSrc);
+		const __m256i *pSrc_even = reinterpret_cast<const __m256i*>(pSrc + (SMD_BLOCK_SIZE / 2));
+		__m256i *p = reinterpret_cast<__m256i*>(pDest);
+		__m256i *const p_end = reinterpret_cast<__m256i*>(pDest + SMD_BLOCK_SIZE);
+
+		// Process 64 bytes (512 bits) at a time.
+		// NOTE: _mm256_unpack*_epi8() interleaves within each
+		// 128-bit lane, so the lanes have to be permuted back
+		// into sequential order afterwards.
+		if (canStream) {
+			for (; p < p_end; p += 2, pSrc_odd++, pSrc_even++) {
+				const __m256i odd  = _mm256_loadu_si256(pSrc_odd);
+				const __m256i even = _mm256_loadu_si256(pSrc_even);
+				const __m256i lo = _mm256_unpacklo_epi8(even, odd);
+				const __m256i hi = _mm256_unpackhi_epi8(even, odd);
+				_mm256_stream_si256(&p[0], _mm256_permute2x128_si256(lo, hi, 0x20));
+				_mm256_stream_si256(&p[1], _mm256_permute2x128_si256(lo, hi, 0x31));
+			}
+		} else {
+			for (; p < p_end; p += 2, pSrc_odd++, pSrc_even++) {
+				const __m256i odd  = _mm256_loadu_si256(pSrc_odd);
+				const __m256i even = _mm256_loadu_si256(pSrc_even);
+				const __m256i lo = _mm256_unpacklo_epi8(even, odd);
+				const __m256i hi = _mm256_unpackhi_epi8(even, odd);
+				_mm256_storeu_si256(&p[0], _mm256_permute2x128_si256(lo, hi, 0x20));
+				_mm256_storeu_si256(&p[1], _mm256_permute2x128_si256(lo, hi, 0x31));
+			}
+		}
+
+		pDest += SMD_BLOCK_SIZE;
+		pSrc += SMD_BLOCK_SIZE;
+	}
+
+	if (canStream) {
+		// Make sure the non-temporal stores are globally visible.
+		_mm_sfence();
+	}
+}
+
+}
+
+#endif /* SMD_HAS_AVX2 */
@@ -0,0 +1,140 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * BufferPool.cpp: Thread-local pool for large temporary buffers.          *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "BufferPool.hpp"
+
+// C includes. (C++ namespace)
+#include <cstdlib>
+
+namespace LibRpBase {
+
+// Pooled size classes: powers of two from POOL_MIN_SIZE to POOL_MAX_SIZE.
+// Sizes outside this range go straight to malloc()/free().
+static const size_t POOL_MIN_SIZE = (64U * 1024);
+static const size_t POOL_MAX_SIZE = (64U * 1024 * 1024);
+static const unsigned int POOL_SIZE_CLASSES = 11;	// 64 KB .. 64 MB
+
+// Maximum buffers cached per size class, and maximum total bytes
+// cached per thread. Keeps idle threads from sitting on too much
+// memory after scanning a large file.
+static const unsigned int POOL_MAX_PER_CLASS = 2;
+static const size_t POOL_MAX_CACHED_BYTES = (96U * 1024 * 1024);
+
+/**
+ * Per-thread buffer cache.
+ * Cached buffers are freed when the thread exits.
+ */
+struct ThreadCache {
+	void *bufs[POOL_SIZE_CLASSES][POOL_MAX_PER_CLASS];
+	unsigned int count[POOL_SIZE_CLASSES];
+	size_t cachedBytes;
+
+	ThreadCache()
+		: cachedBytes(0)
+	{
+		memset(count, 0, sizeof(count));
+	}
+
+	~ThreadCache()
+	{
+		for (unsigned int cls = 0; cls < POOL_SIZE_CLASSES; cls++) {
+			for (unsigned int i = 0; i < count[cls]; i++) {
+				::free(bufs[cls][i]);
+			}
+		}
+	}
+};
+
+static thread_local ThreadCache t_cache;
+
+/**
+ * Get the size class for an allocation size.
+ * @param size		[in] Allocation size, in bytes.
+ * @param pClassSize	[out] Rounded-up size of the class.
+ * @return Size class index, or -1 if the size isn't pooled.
+ */
+static inline int size_class(size_t size, size_t *pClassSize)
+{
+	if (size > POOL_MAX_SIZE || size == 0) {
+		// Too big (or empty) to pool.
+		return -1;
+	}
+
+	size_t classSize = POOL_MIN_SIZE;
+	int cls = 0;
+	while (classSize < size) {
+		classSize <<= 1;
+		cls++;
+	}
+	*pClassSize = classSize;
+	return cls;
+}
+
+/**
+ * Allocate a buffer of at least the specified size.
+ * @param size Size, in bytes.
+ * @return Buffer, or nullptr on allocation failure.
+ */
+void *BufferPool::alloc(size_t size)
+{
+	size_t classSize;
+	const int cls = size_class(size, &classSize);
+	if (cls < 0) {
+		// Not a pooled size.
+		return malloc(size);
+	}
+
+	ThreadCache &tc = t_cache;
+	if (tc.count[cls] > 0) {
+		// Reuse a cached buffer.
+		tc.count[cls]--;
+		tc.cachedBytes -= classSize;
+		return tc.bufs[cls][tc.count[cls]];
+	}
+
+	// No cached buffer available.
+	// Allocate the full class size so the buffer can be
+	// reused for any request in this class.
+	return malloc(classSize);
+}
+
+/**
+ * Return a buffer to the pool.
+ * @param ptr Buffer obtained from alloc(). (If nullptr, does nothing.)
+ * @param size Size originally passed to alloc().
+ */
+void BufferPool::free(void *ptr, size_t size)
+{
+	if (!ptr) {
+		return;
+	}
+
+	size_t classSize;
+	const int cls = size_class(size, &classSize);
+	if (cls < 0) {
+		// Not a pooled size.
+		::free(ptr);
+		return;
+	}
+
+	ThreadCache &tc = t_cache;
+	if (tc.count[cls] >= POOL_MAX_PER_CLASS ||
+	    tc.cachedBytes + classSize > POOL_MAX_CACHED_BYTES)
+	{
+		// Cache is full.
+		::free(ptr);
+		return;
+	}
+
+	tc.bufs[cls][tc.count[cls]] = ptr;
+	tc.count[cls]++;
+	tc.cachedBytes += classSize;
+}
+
+}
@@ -0,0 +1,107 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * BufferPool.hpp: Thread-local pool for large temporary buffers.          *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_BUFFERPOOL_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_BUFFERPOOL_HPP__
+
+#include "common.h"
+
+// C includes.
+#include <stdint.h>
+// C includes. (C++ namespace)
+#include <cstddef>
+
+namespace LibRpBase {
+
+/**
+ * Thread-local pool for large temporary buffers.
+ *
+ * Parser hot paths allocate and free megabyte-scale temporaries per
+ * file (FST reads, executable decompression, etc.), which adds up to
+ * significant malloc()/free() time during batch scans. The pool
+ * caches a few buffers per power-of-two size class and hands them
+ * back out on the next request, so consecutive files reuse the same
+ * memory instead of round-tripping through the heap.
+ *
+ * The cache is thread-local, so no locking is needed. Sizes outside
+ * the pooled range fall through to plain malloc()/free().
+ *
+ * Use PoolBuffer for scoped allocations; it returns the buffer to
+ * the pool automatically.
+ */
+class BufferPool
+{
+	private:
+		// Static class.
+		BufferPool();
+		~BufferPool();
+		RP_DISABLE_COPY(BufferPool)
+
+	public:
+		/**
+		 * Allocate a buffer of at least the specified size.
+		 * @param size Size, in bytes.
+		 * @return Buffer, or nullptr on allocation failure.
+		 */
+		static void *alloc(size_t size);
+
+		/**
+		 * Return a buffer to the pool.
+		 * @param ptr Buffer obtained from alloc(). (If nullptr, does nothing.)
+		 * @param size Size originally passed to alloc().
+		 */
+		static void free(void *ptr, size_t size);
+};
+
+/**
+ * Scoped buffer from the BufferPool.
+ * Returns the buffer to the pool when it goes out of scope.
+ */
+class PoolBuffer
+{
+	public:
+		explicit PoolBuffer(size_t size)
+			: m_buf(static_cast<uint8_t*>(BufferPool::alloc(size)))
+			, m_size(size)
+		{ }
+
+		~PoolBuffer()
+		{
+			BufferPool::free(m_buf, m_size);
+		}
+
+	private:
+		RP_DISABLE_COPY(PoolBuffer)
+
+	public:
+		/**
+		 * Get the buffer.
+		 * @return Buffer, or nullptr if allocation failed.
+		 */
+		uint8_t *get(void) const
+		{
+			return m_buf;
+		}
+
+		/**
+		 * Get the requested buffer size.
+		 * @return Size, in bytes.
+		 */
+		size_t size(void) const
+		{
+			return m_size;
+		}
+
+	private:
+		uint8_t *m_buf;
+		size_t m_size;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_BUFFERPOOL_HPP__ */
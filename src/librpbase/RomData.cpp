@@ -12,8 +12,14 @@
 
 #include "libi18n/i18n.h"
 
+#include "img/InternalImageCache.hpp"
+#include "librptexture/img/rp_image.hpp"
+
+// librpfile
+#include "librpfile/FileSystem.hpp"
+
 // librpthreads
-#include "librpthreads/Atomics.h"
+#include "librpthreads/Mutex.hpp"
 
 // C++ STL classes.
 using std::string;
@@ -35,8 +41,9 @@ namespace LibRpBase {
  */
 RomDataPrivate::RomDataPrivate(RomData *q, IRpFile *file)
 	: q_ptr(q)
-	, ref_cnt(1)
 	, isValid(false)
+	, deferFields(false)
+	, metadataOnly(false)
 	, file(nullptr)
 	, fields(new RomFields())
 	, metaData(nullptr)
@@ -47,6 +54,9 @@ RomDataPrivate::RomDataPrivate(RomData *q, IRpFile *file)
 	// Initialize i18n.
 	rp_i18n_init();
 
+	// No cached internal images initially.
+	memset(cachedInternalImages, 0, sizeof(cachedInternalImages));
+
 	if (file) {
 		// Reference the file.
 		this->file = file->ref();
@@ -58,14 +68,139 @@ RomDataPrivate::~RomDataPrivate()
 	delete fields;
 	delete metaData;
 
+	// Delete any cached internal images.
+	for (rp_image *img : cachedInternalImages) {
+		delete img;
+	}
+
 	// Unreference the file.
 	if (this->file) {
 		this->file->unref();
 	}
 }
 
+/**
+ * Get the InternalImageCache key for the open file.
+ * @return Cache key, or empty string if the file's identity is unknown.
+ */
+string RomDataPrivate::internalImageCacheKey(void) const
+{
+	if (!file) {
+		// No file.
+		return string();
+	}
+
+	const string filename = file->filename();
+	if (filename.empty()) {
+		// No filename, e.g. a memory file or a partition file.
+		// Can't establish the file's identity.
+		return string();
+	}
+
+	// Include the file size and mtime so a replaced file isn't
+	// misidentified as the cached one. This matches the identity
+	// used by RomDataFactory's probe result cache.
+	time_t mtime = -1;
+	if (LibRpFile::FileSystem::get_mtime(filename, &mtime) != 0) {
+		// Can't get the mtime, so we can't establish
+		// the file's identity.
+		return string();
+	}
+
+	return filename + '|' +
+		std::to_string(static_cast<long long>(file->size())) + '|' +
+		std::to_string(static_cast<long long>(mtime));
+}
+
+/**
+ * Look up a memoized extURLs() result.
+ * @param imageType	[in] Image type.
+ * @param size		[in] Requested image size.
+ * @param pExtURLs	[out] Output vector.
+ * @return True if a memoized result was found; false if not.
+ */
+bool RomDataPrivate::extURLsCache_lookup(int imageType, int size,
+	vector<RomData::ExtURL> *pExtURLs) const
+{
+	for (const ExtURLsCacheEntry &entry : extURLsCache) {
+		if (entry.imageType == imageType && entry.size == size) {
+			*pExtURLs = entry.extURLs;
+			return true;
+		}
+	}
+
+	// No memoized result.
+	return false;
+}
+
+/**
+ * Memoize a successful extURLs() result.
+ * @param imageType	[in] Image type.
+ * @param size		[in] Requested image size.
+ * @param extURLs	[in] Constructed URL vector.
+ */
+void RomDataPrivate::extURLsCache_store(int imageType, int size,
+	const vector<RomData::ExtURL> &extURLs) const
+{
+	// NOTE: extURLs() is only called with a handful of distinct
+	// (imageType, size) combinations per instance, so no eviction
+	// is needed.
+	ExtURLsCacheEntry entry;
+	entry.imageType = imageType;
+	entry.size = size;
+	entry.extURLs = extURLs;
+	extURLsCache.push_back(std::move(entry));
+}
+
 /** Convenience functions. **/
 
+/**
+ * Get a cached URL template prefix.
+ *
+ * The (base, system, type, region) portion of a GameTDB URL is
+ * the same for every file in a directory scan, so the formatted
+ * prefix is cached per distinct combination and only the game ID
+ * and file extension are appended per file.
+ *
+ * @param base Base URL, e.g. "https://art.gametdb.com/". (Empty for cache keys.)
+ * @param system System name.
+ * @param type Image type.
+ * @param region Region name.
+ * @return URL prefix, ending with '/'.
+ */
+static string getCachedURLPrefix(const char *base,
+	const char *system, const char *type, const char *region)
+{
+	struct PrefixCacheEntry {
+		string base;
+		string system;
+		string type;
+		string region;
+		string prefix;
+	};
+	static std::vector<PrefixCacheEntry> prefixCache;
+	static Mutex prefixCacheMutex;
+	// Sanity limit so callers with per-file "region" components
+	// can't grow the cache unbounded.
+	static const size_t PREFIX_CACHE_MAX = 64;
+
+	MutexLocker locker(prefixCacheMutex);
+	for (const PrefixCacheEntry &entry : prefixCache) {
+		if (entry.system == system && entry.type == type &&
+		    entry.region == region && entry.base == base)
+		{
+			return entry.prefix;
+		}
+	}
+
+	// Not cached. Format the prefix.
+	string prefix = rp_sprintf("%s%s/%s/%s/", base, system, type, region);
+	if (prefixCache.size() < PREFIX_CACHE_MAX) {
+		prefixCache.push_back(PrefixCacheEntry{base, system, type, region, prefix});
+	}
+	return prefix;
+}
+
 /**
  * Get the GameTDB URL for a given game.
  * @param system System name.
@@ -81,8 +216,10 @@ string RomDataPrivate::getURL_GameTDB(
 	const char *region, const char *gameID,
 	const char *ext)
 {
-	return rp_sprintf("https://art.gametdb.com/%s/%s/%s/%s%s",
-		system, type, region, gameID, ext);
+	string url = getCachedURLPrefix("https://art.gametdb.com/", system, type, region);
+	url += gameID;
+	url += ext;
+	return url;
 }
 
 /**
@@ -100,8 +237,10 @@ string RomDataPrivate::getCacheKey_GameTDB(
 	const char *region, const char *gameID,
 	const char *ext)
 {
-	return rp_sprintf("%s/%s/%s/%s%s",
-		system, type, region, gameID, ext);
+	string cache_key = getCachedURLPrefix("", system, type, region);
+	cache_key += gameID;
+	cache_key += ext;
+	return cache_key;
 }
 
 /**
@@ -455,30 +594,7 @@ RomData::~RomData()
 	delete d_ptr;
 }
 
-/**
- * Take a reference to this RomData* object.
- * @return this
- */
-RomData *RomData::ref(void)
-{
-	RP_D(RomData);
-	ATOMIC_INC_FETCH(&d->ref_cnt);
-	return this;
-}
-
-/**
- * Unreference this RomData* object.
- * If ref_cnt reaches 0, the RomData* object is deleted.
- */
-void RomData::unref(void)
-{
-	RP_D(RomData);
-	assert(d->ref_cnt > 0);
-	if (ATOMIC_DEC_FETCH(&d->ref_cnt) <= 0) {
-		// All references removed.
-		delete this;
-	}
-}
+// NOTE: ref()/unref() are inherited from RefBase.
 
 /**
  * Is this ROM valid?
@@ -722,6 +838,11 @@ const RomFields *RomData::fields(void) const
 	RP_D(const RomData);
 	if (d->fields->empty()) {
 		// Data has not been loaded.
+		if (d->deferFields) {
+			// Field loading is deferred, e.g. for a
+			// thumbnail-only open. Don't load it.
+			return nullptr;
+		}
 		// Load it now.
 		int ret = const_cast<RomData*>(this)->loadFieldData();
 		if (ret < 0)
@@ -739,6 +860,11 @@ const RomMetaData *RomData::metaData(void) const
 	RP_D(const RomData);
 	if (!d->metaData || d->metaData->empty()) {
 		// Data has not been loaded.
+		if (d->deferFields) {
+			// Metadata loading is deferred, e.g. for a
+			// thumbnail-only open. Don't load it.
+			return nullptr;
+		}
 		// Load it now.
 		int ret = const_cast<RomData*>(this)->loadMetaData();
 		if (ret < 0)
@@ -747,6 +873,59 @@ const RomMetaData *RomData::metaData(void) const
 	return d->metaData;
 }
 
+/**
+ * Set whether field and metadata loading is deferred.
+ *
+ * If deferred, fields() and metaData() will return nullptr
+ * instead of parsing field data. Intended for thumbnail-only
+ * opens, which never display fields. Callers that later need
+ * fields can clear the deferral and call fields() again.
+ *
+ * @param defer True to defer field loading; false to allow it.
+ */
+void RomData::setFieldLoadingDeferred(bool defer)
+{
+	RP_D(RomData);
+	d->deferFields = defer;
+}
+
+/**
+ * Is field and metadata loading deferred?
+ * @return True if deferred; false if not.
+ */
+bool RomData::isFieldLoadingDeferred(void) const
+{
+	RP_D(const RomData);
+	return d->deferFields;
+}
+
+/**
+ * Set whether this object is a metadata-only open.
+ *
+ * If set, image() and the other image interfaces return
+ * nullptr without decoding anything, and subclasses may
+ * skip work that only benefits the property page.
+ * Intended for file indexers (Baloo, Windows Search),
+ * which only need metaData().
+ *
+ * @param metadataOnly True for a metadata-only open.
+ */
+void RomData::setMetadataOnly(bool metadataOnly)
+{
+	RP_D(RomData);
+	d->metadataOnly = metadataOnly;
+}
+
+/**
+ * Is this a metadata-only open?
+ * @return True if metadata-only; false if not.
+ */
+bool RomData::isMetadataOnly(void) const
+{
+	RP_D(const RomData);
+	return d->metadataOnly;
+}
+
 /**
  * Get an internal image from the ROM.
  *
@@ -765,6 +944,28 @@ const rp_image *RomData::image(ImageType imageType) const
 	}
 	// TODO: Check supportedImageTypes()?
 
+	// Check for an image obtained from the cache previously.
+	RomDataPrivate *const d = const_cast<RomData*>(this)->d_ptr;
+	if (d->metadataOnly) {
+		// Metadata-only open. Don't decode images.
+		return nullptr;
+	}
+	if (d->cachedInternalImages[imageType]) {
+		return d->cachedInternalImages[imageType];
+	}
+
+	// Check the process-wide internal image cache.
+	const string cacheKey = d->internalImageCacheKey();
+	if (!cacheKey.empty()) {
+		rp_image *const cachedImg = InternalImageCache::lookup(cacheKey, imageType);
+		if (cachedImg) {
+			// Cache hit. No decoding needed.
+			// The duplicate is owned by this object.
+			d->cachedInternalImages[imageType] = cachedImg;
+			return cachedImg;
+		}
+	}
+
 	// Load the internal image.
 	// The subclass maintains ownership of the image.
 #ifdef _DEBUG
@@ -784,9 +985,55 @@ const rp_image *RomData::image(ImageType imageType) const
 	// SANITY CHECK: `img` must not be -1LL.
 	assert(img != INVALID_IMG_PTR);
 
+	if (ret == 0 && img) {
+		// Add the image to the process-wide cache so
+		// subsequent opens of the same file reuse it.
+		InternalImageCache::add(cacheKey, imageType, img);
+	}
+
 	return (ret == 0 ? img : nullptr);
 }
 
+/**
+ * Get an owned handle to an internal image from the ROM.
+ *
+ * Unlike image(), the returned rp_image is owned by the
+ * caller and stays valid after this object is unref()'d.
+ * The pixel data is shared copy-on-write with this object's
+ * cached image, so no pixels are copied. Callers must treat
+ * the image as immutable; writing to it triggers a detach.
+ *
+ * @param imageType Image type to load.
+ * @return Internal image, or nullptr if the ROM doesn't have one. (Caller must delete the image.)
+ */
+rp_image *RomData::imageHandle(ImageType imageType) const
+{
+	const rp_image *const img = this->image(imageType);
+	return (img ? img->dup() : nullptr);
+}
+
+/**
+ * Get an internal image from the ROM, closest to the specified size.
+ *
+ * The default implementation ignores the requested size and
+ * returns the full image. Subclasses wrapping formats with
+ * mipmaps may return a smaller mipmap that's still at least
+ * as large as the requested size, which is faster to decode.
+ *
+ * NOTE: The rp_image is owned by this object.
+ * Do NOT delete this object until you're done using this rp_image.
+ *
+ * @param imageType	[in] Image type to load.
+ * @param reqSize	[in] Requested image size. (single dimension; assuming square image)
+ * @return Internal image, or nullptr if the ROM doesn't have one.
+ */
+const rp_image *RomData::imageForSize(ImageType imageType, int reqSize) const
+{
+	// The default implementation ignores the requested size.
+	RP_UNUSED(reqSize);
+	return this->image(imageType);
+}
+
 /**
  * Get a list of URLs for an external image type.
  *
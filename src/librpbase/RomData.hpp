@@ -10,6 +10,7 @@
 #define __ROMPROPERTIES_LIBRPBASE_ROMDATA_HPP__
 
 #include "common.h"
+#include "refbase.hpp"
 #include "RomData_decl.hpp"
 
 // C includes.
@@ -34,7 +35,7 @@ class RomMetaData;
 struct IconAnimData;
 
 class RomDataPrivate;
-class RomData
+class RomData : public RefBase
 {
 	protected:
 		/**
@@ -83,15 +84,14 @@ class RomData
 	public:
 		/**
 		 * Take a reference to this RomData* object.
+		 * NOTE: Refcounting is inherited from RefBase;
+		 * this override only provides a covariant return type.
 		 * @return this
 		 */
-		RomData *ref(void);
-
-		/**
-		 * Unreference this RomData* object.
-		 * If ref_cnt reaches 0, the RomData* object is deleted.
-		 */
-		void unref(void);
+		inline RomData *ref(void)
+		{
+			return static_cast<RomData*>(RefBase::ref());
+		}
 
 	public:
 		/**
@@ -428,6 +428,43 @@ class RomData
 		 */
 		const RomMetaData *metaData(void) const;
 
+		/**
+		 * Set whether field and metadata loading is deferred.
+		 *
+		 * If deferred, fields() and metaData() will return nullptr
+		 * instead of parsing field data. Intended for thumbnail-only
+		 * opens, which never display fields. Callers that later need
+		 * fields can clear the deferral and call fields() again.
+		 *
+		 * @param defer True to defer field loading; false to allow it.
+		 */
+		void setFieldLoadingDeferred(bool defer);
+
+		/**
+		 * Is field and metadata loading deferred?
+		 * @return True if deferred; false if not.
+		 */
+		bool isFieldLoadingDeferred(void) const;
+
+		/**
+		 * Set whether this object is a metadata-only open.
+		 *
+		 * If set, image() and the other image interfaces return
+		 * nullptr without decoding anything, and subclasses may
+		 * skip work that only benefits the property page.
+		 * Intended for file indexers (Baloo, Windows Search),
+		 * which only need metaData().
+		 *
+		 * @param metadataOnly True for a metadata-only open.
+		 */
+		void setMetadataOnly(bool metadataOnly);
+
+		/**
+		 * Is this a metadata-only open?
+		 * @return True if metadata-only; false if not.
+		 */
+		bool isMetadataOnly(void) const;
+
 	private:
 		/**
 		 * Verify that the specified image type has been loaded.
@@ -448,6 +485,37 @@ class RomData
 		 */
 		const LibRpTexture::rp_image *image(ImageType imageType) const;
 
+		/**
+		 * Get an owned handle to an internal image from the ROM.
+		 *
+		 * Unlike image(), the returned rp_image is owned by the
+		 * caller and stays valid after this object is unref()'d.
+		 * The pixel data is shared copy-on-write with this object's
+		 * cached image, so no pixels are copied. Callers must treat
+		 * the image as immutable; writing to it triggers a detach.
+		 *
+		 * @param imageType Image type to load.
+		 * @return Internal image, or nullptr if the ROM doesn't have one. (Caller must delete the image.)
+		 */
+		LibRpTexture::rp_image *imageHandle(ImageType imageType) const;
+
+		/**
+		 * Get an internal image from the ROM, closest to the specified size.
+		 *
+		 * The default implementation ignores the requested size and
+		 * returns the full image. Subclasses wrapping formats with
+		 * mipmaps may return a smaller mipmap that's still at least
+		 * as large as the requested size, which is faster to decode.
+		 *
+		 * NOTE: The rp_image is owned by this object.
+		 * Do NOT delete this object until you're done using this rp_image.
+		 *
+		 * @param imageType	[in] Image type to load.
+		 * @param reqSize	[in] Requested image size. (single dimension; assuming square image)
+		 * @return Internal image, or nullptr if the ROM doesn't have one.
+		 */
+		virtual const LibRpTexture::rp_image *imageForSize(ImageType imageType, int reqSize) const;
+
 		/**
 		 * External URLs for a media type.
 		 * Includes URL and "cache key" for local caching,
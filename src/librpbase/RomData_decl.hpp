@@ -204,6 +204,47 @@ class klass : public LibRpBase::RomData { \
 		 */ \
 		int loadInternalImage(ImageType imageType, const LibRpTexture::rp_image **pImage) final;
 
+/**
+ * RomData subclass function declaration for loading internal images
+ * closest to a requested size.
+ */
+#define ROMDATA_DECL_IMGINTFORSIZE() \
+	public: \
+		/** \
+		 * Get an internal image from the ROM, closest to the specified size. \
+		 * \
+		 * For formats with mipmaps, this may return a smaller mipmap \
+		 * that's still at least as large as the requested size, \
+		 * which is faster to decode than the full image. \
+		 * \
+		 * NOTE: The rp_image is owned by this object. \
+		 * Do NOT delete this object until you're done using this rp_image. \
+		 * \
+		 * @param imageType	[in] Image type to load. \
+		 * @param reqSize	[in] Requested image size. (single dimension; assuming square image) \
+		 * @return Internal image, or nullptr if the ROM doesn't have one. \
+		 */ \
+		const LibRpTexture::rp_image *imageForSize(ImageType imageType, int reqSize) const final;
+
+/**
+ * RomData subclass function declaration for fast icon extraction.
+ */
+#define ROMDATA_DECL_FASTICON() \
+	public: \
+		/** \
+		 * Load the ROM's icon directly from the file, without \
+		 * constructing a RomData instance. (fast icon extraction) \
+		 * \
+		 * Only possible for formats where the icon is located at \
+		 * an address computable from the header alone. The caller \
+		 * must have already verified the file's magic number, \
+		 * e.g. via RomDataFactory. \
+		 * \
+		 * @param file	[in] Opened ROM file. \
+		 * @return Icon, or nullptr on error. (Caller must delete the icon.) \
+		 */ \
+		static LibRpTexture::rp_image *fastIcon_static(LibRpFile::IRpFile *file);
+
 /**
  * RomData subclass function declaration for obtaining URLs for external images.
  */
@@ -53,12 +53,54 @@ class RomDataPrivate
 		RomData *const q_ptr;
 
 	public:
-		volatile int ref_cnt;		// Reference count.
 		bool isValid;			// Subclass must set this to true if the ROM is valid.
+		bool deferFields;		// If true, fields() and metaData() won't load data.
+		bool metadataOnly;		// If true, image interfaces won't decode anything.
 		LibRpFile::IRpFile *file;	// Open file.
 		RomFields *const fields;	// ROM fields. (NOTE: allocated by the base class)
 		RomMetaData *metaData;		// ROM metadata. (NOTE: nullptr initially.)
 
+		// Internal images obtained from InternalImageCache.
+		// Owned by this object; deleted in the destructor.
+		LibRpTexture::rp_image *cachedInternalImages[RomData::IMG_INT_MAX+1];
+
+		/**
+		 * Get the InternalImageCache key for the open file.
+		 * @return Cache key, or empty string if the file's identity is unknown.
+		 */
+		std::string internalImageCacheKey(void) const;
+
+		// Memoized extURLs() results, keyed by (imageType, size).
+		// The UI calls extURLs() once per external image type, and
+		// the region-fallback URL lists are rebuilt with string
+		// formatting on every call, so subclasses with non-trivial
+		// extURLs() implementations memoize successful results here.
+		struct ExtURLsCacheEntry {
+			int imageType;
+			int size;
+			std::vector<RomData::ExtURL> extURLs;
+		};
+		mutable std::vector<ExtURLsCacheEntry> extURLsCache;
+
+		/**
+		 * Look up a memoized extURLs() result.
+		 * @param imageType	[in] Image type.
+		 * @param size		[in] Requested image size.
+		 * @param pExtURLs	[out] Output vector.
+		 * @return True if a memoized result was found; false if not.
+		 */
+		bool extURLsCache_lookup(int imageType, int size,
+			std::vector<RomData::ExtURL> *pExtURLs) const;
+
+		/**
+		 * Memoize a successful extURLs() result.
+		 * @param imageType	[in] Image type.
+		 * @param size		[in] Requested image size.
+		 * @param extURLs	[in] Constructed URL vector.
+		 */
+		void extURLsCache_store(int imageType, int size,
+			const std::vector<RomData::ExtURL> &extURLs) const;
+
 	public:
 		/** These fields must be set by RomData subclasses in their constructors. **/
 		const char *className;		// Class name for user configuration. (ASCII) (default is nullptr)
@@ -8,12 +8,17 @@
 
 #include "stdafx.h"
 #include "RomFields.hpp"
+#include "StringPool.hpp"
 
 #include "libi18n/i18n.h"
 
 // librpthreads
 #include "librpthreads/Atomics.h"
 
+// C++ includes.
+#include <new>
+#include <utility>
+
 // C++ STL classes.
 using std::map;
 using std::string;
@@ -47,6 +52,101 @@ class RomFieldsPrivate
 		// and/or addField_listData with RFT_LISTDATA_MULTI.
 		uint32_t def_lc;
 
+		// Per-tab field index cache for tabFieldIndexes().
+		// tabFieldIdx[tabIdx] contains the indexes of all fields
+		// on that tab, in field order. Built lazily; considered
+		// stale whenever the field count doesn't match
+		// tabFieldIdxCount, so addField*() doesn't need to
+		// invalidate it explicitly.
+		// (mutable: filled in by const accessors.)
+		mutable vector<vector<int> > tabFieldIdx;
+		mutable size_t tabFieldIdxCount;
+
+		// Monotonic arena for field-owned objects allocated by
+		// RomFields itself, e.g. the std::string behind each
+		// RFT_STRING field. Ordinary parsers add dozens to
+		// thousands of fields, so allocating those objects
+		// individually causes a malloc storm when opening a
+		// property sheet. Objects allocated by parsers and
+		// passed in (bitfield names, list data) are still
+		// regular heap objects; destroy_object() checks
+		// provenance and deletes those normally.
+		vector<std::pair<uint8_t*, size_t> > arenaChunks;
+		uint8_t *arenaCur;	// Current chunk position.
+		size_t arenaRemain;	// Bytes remaining in the current chunk.
+
+		// Arena chunk size. Oversized objects get a
+		// dedicated chunk.
+		static const size_t ARENA_CHUNK_SIZE = 4096;
+
+		/**
+		 * Allocate raw storage from the arena.
+		 * @param size Size, in bytes.
+		 * @param align Required alignment.
+		 * @return Pointer to uninitialized storage.
+		 */
+		void *arena_alloc(size_t size, size_t align);
+
+		/**
+		 * Construct an object in the arena.
+		 * The object is destroyed by destroy_object().
+		 * @param args Constructor arguments.
+		 * @return Constructed object.
+		 */
+		template<typename T, typename... Args>
+		T *arena_new(Args&&... args)
+		{
+			void *const p = arena_alloc(sizeof(T), alignof(T));
+			return new(p) T(std::forward<Args>(args)...);
+		}
+
+		/**
+		 * Check if a pointer was allocated from the arena.
+		 * @param p Pointer.
+		 * @return True if arena-allocated; false if not.
+		 */
+		bool arena_contains(const void *p) const;
+
+		/**
+		 * Destroy a field-owned object.
+		 * Arena-allocated objects have their destructor invoked;
+		 * the storage is released when the arena is freed.
+		 * Other objects are deleted normally.
+		 * @param p Object.
+		 */
+		template<typename T>
+		void destroy_object(const T *p)
+		{
+			if (!p) {
+				return;
+			}
+			if (arena_contains(p)) {
+				p->~T();
+			} else {
+				delete const_cast<T*>(p);
+			}
+		}
+
+		/**
+		 * Store a string value in an RFT_STRING field.
+		 * Short strings are stored inline in the field's data
+		 * union (STRF_INLINE); longer strings are interned
+		 * (STRF_INTERN) or allocated from the arena.
+		 * NOTE: field.desc.flags must be set beforehand.
+		 * @param field Field.
+		 * @param str String. (must not be nullptr)
+		 * @param len String length, in bytes.
+		 */
+		void store_string(RomFields::Field &field, const char *str, size_t len);
+
+		/**
+		 * Store a string value in an RFT_STRING field. (rvalue overload)
+		 * Long strings are moved into the arena instead of copied.
+		 * @param field Field.
+		 * @param str String.
+		 */
+		void store_string(RomFields::Field &field, std::string &&str);
+
 		/**
 		 * Delete allocated objects in this->fields.
 		 * The vector will be cleared afterwards.
@@ -59,6 +159,9 @@ class RomFieldsPrivate
 RomFieldsPrivate::RomFieldsPrivate()
 	: tabIdx(0)
 	, def_lc(0)
+	, tabFieldIdxCount(~(size_t)0)
+	, arenaCur(nullptr)
+	, arenaRemain(0)
 { }
 
 RomFieldsPrivate::~RomFieldsPrivate()
@@ -66,6 +169,102 @@ RomFieldsPrivate::~RomFieldsPrivate()
 	delete_data();
 }
 
+/**
+ * Allocate raw storage from the arena.
+ * @param size Size, in bytes.
+ * @param align Required alignment.
+ * @return Pointer to uninitialized storage.
+ */
+void *RomFieldsPrivate::arena_alloc(size_t size, size_t align)
+{
+	// Align the current position.
+	const size_t misalign = reinterpret_cast<uintptr_t>(arenaCur) & (align - 1);
+	const size_t pad = (misalign != 0 ? align - misalign : 0);
+
+	if (size + pad > arenaRemain) {
+		// Not enough space left. Allocate a new chunk.
+		// NOTE: Not using std::max() to avoid ODR-using ARENA_CHUNK_SIZE.
+		const size_t chunkSize = (size + align > ARENA_CHUNK_SIZE)
+			? (size + align)
+			: static_cast<size_t>(ARENA_CHUNK_SIZE);
+		uint8_t *const chunk = new uint8_t[chunkSize];
+		arenaChunks.emplace_back(std::make_pair(chunk, chunkSize));
+		arenaCur = chunk;
+		arenaRemain = chunkSize;
+		return arena_alloc(size, align);
+	}
+
+	uint8_t *const p = arenaCur + pad;
+	arenaCur = p + size;
+	arenaRemain -= (size + pad);
+	return p;
+}
+
+/**
+ * Check if a pointer was allocated from the arena.
+ * @param p Pointer.
+ * @return True if arena-allocated; false if not.
+ */
+bool RomFieldsPrivate::arena_contains(const void *p) const
+{
+	const uint8_t *const pu8 = static_cast<const uint8_t*>(p);
+	for (auto iter = arenaChunks.cbegin(); iter != arenaChunks.cend(); ++iter) {
+		if (pu8 >= iter->first && pu8 < (iter->first + iter->second)) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/**
+ * Store a string value in an RFT_STRING field.
+ * Short strings are stored inline in the field's data
+ * union (STRF_INLINE); longer strings are interned
+ * (STRF_INTERN) or allocated from the arena.
+ * NOTE: field.desc.flags must be set beforehand.
+ * @param field Field.
+ * @param str String. (must not be nullptr)
+ * @param len String length, in bytes.
+ */
+void RomFieldsPrivate::store_string(RomFields::Field &field, const char *str, size_t len)
+{
+	if (len < sizeof(field.data.inline_str)) {
+		// Short string. Store it inline in the data union.
+		// The field table stays contiguous, so iterating the
+		// fields doesn't chase a pointer per string.
+		memcpy(field.data.inline_str, str, len);
+		field.data.inline_str[len] = '\0';
+		field.desc.flags |= RomFields::STRF_INLINE;
+	} else if (field.desc.flags & RomFields::STRF_INTERN) {
+		// Intern the string in the process-wide pool.
+		field.data.str = StringPool::intern(str);
+	} else {
+		field.data.str = arena_new<string>(str, len);
+	}
+}
+
+/**
+ * Store a string value in an RFT_STRING field. (rvalue overload)
+ * Long strings are moved into the arena instead of copied.
+ * @param field Field.
+ * @param str String.
+ */
+void RomFieldsPrivate::store_string(RomFields::Field &field, string &&str)
+{
+	if (str.size() < sizeof(field.data.inline_str)) {
+		// Short string. Store it inline in the data union.
+		memcpy(field.data.inline_str, str.c_str(), str.size() + 1);
+		field.desc.flags |= RomFields::STRF_INLINE;
+	} else if (field.desc.flags & RomFields::STRF_INTERN) {
+		// Intern the string in the process-wide pool.
+		// NOTE: No benefit from moving here; the pool
+		// copies the string on first insertion only.
+		field.data.str = StringPool::intern(str);
+	} else {
+		field.data.str = arena_new<string>(std::move(str));
+	}
+}
+
 /**
  * Delete allocated objects in this->fields.
  * The vector will be cleared afterwards.
@@ -74,7 +273,7 @@ void RomFieldsPrivate::delete_data(void)
 {
 	// Delete all of the allocated objects in this->fields.
 	std::for_each(fields.begin(), fields.end(),
-		[](RomFields::Field &field) {
+		[this](RomFields::Field &field) {
 			if (!field.isValid) {
 				// No data here.
 				return;
@@ -88,27 +287,34 @@ void RomFieldsPrivate::delete_data(void)
 					break;
 
 				case RomFields::RFT_STRING:
-					delete const_cast<string*>(field.data.str);
+					// NOTE: Inline strings have no allocation,
+					// and interned strings are shared
+					// process-wide; don't free either.
+					if (!(field.desc.flags & RomFields::STRF_INLINE) &&
+					    !StringPool::contains(field.data.str))
+					{
+						destroy_object(field.data.str);
+					}
 					break;
 				case RomFields::RFT_BITFIELD:
-					delete const_cast<vector<string>*>(field.desc.bitfield.names);
+					destroy_object(field.desc.bitfield.names);
 					break;
 				case RomFields::RFT_LISTDATA:
-					delete const_cast<vector<string>*>(field.desc.list_data.names);
+					destroy_object(field.desc.list_data.names);
 					if (field.desc.list_data.flags & RomFields::RFT_LISTDATA_MULTI) {
-						delete const_cast<RomFields::ListDataMultiMap_t*>(field.data.list_data.data.multi);
+						destroy_object(field.data.list_data.data.multi);
 					} else {
-						delete const_cast<RomFields::ListData_t*>(field.data.list_data.data.single);
+						destroy_object(field.data.list_data.data.single);
 					}
 					if (field.desc.list_data.flags & RomFields::RFT_LISTDATA_ICONS) {
-						delete const_cast<RomFields::ListDataIcons_t*>(field.data.list_data.mxd.icons);
+						destroy_object(field.data.list_data.mxd.icons);
 					}
 					break;
 				case RomFields::RFT_AGE_RATINGS:
-					delete const_cast<RomFields::age_ratings_t*>(field.data.age_ratings);
+					destroy_object(field.data.age_ratings);
 					break;
 				case RomFields::RFT_STRING_MULTI:
-					delete const_cast<RomFields::StringMultiMap_t*>(field.data.str_multi);
+					destroy_object(field.data.str_multi);
 					break;
 				default:
 					// ERROR!
@@ -120,6 +326,33 @@ void RomFieldsPrivate::delete_data(void)
 
 	// Clear the fields vector.
 	this->fields.clear();
+
+	// Free the arena chunks.
+	for (auto iter = arenaChunks.begin(); iter != arenaChunks.end(); ++iter) {
+		delete[] iter->first;
+	}
+	arenaChunks.clear();
+	arenaCur = nullptr;
+	arenaRemain = 0;
+}
+
+/** RomFields::Field **/
+
+/**
+ * Get the string value of an RFT_STRING field.
+ * Handles both inline and out-of-line storage.
+ * @return String value, or nullptr if no string is set.
+ */
+const char *RomFields::Field::str(void) const
+{
+	assert(type == RomFields::RFT_STRING);
+	if (type != RomFields::RFT_STRING)
+		return nullptr;
+
+	if (desc.flags & RomFields::STRF_INLINE) {
+		return data.inline_str;
+	}
+	return (data.str ? data.str->c_str() : nullptr);
 }
 
 /** RomFields **/
@@ -483,6 +716,51 @@ RomFields::const_iterator RomFields::cend(void) const
 	return d->fields.cend();
 }
 
+/**
+ * Get the indexes of all fields on the specified tab.
+ *
+ * The index is built once and cached, so UI frontends can
+ * iterate a single tab's fields directly instead of scanning
+ * the entire field list once per tab.
+ *
+ * The returned vector is invalidated if more fields are added.
+ *
+ * @param tabIdx Tab index.
+ * @return Vector of field indexes, or nullptr if the tab index is invalid.
+ */
+const std::vector<int> *RomFields::tabFieldIndexes(int tabIdx) const
+{
+	assert(tabIdx >= 0);
+	if (tabIdx < 0)
+		return nullptr;
+
+	RP_D(const RomFields);
+	if (d->tabFieldIdxCount != d->fields.size()) {
+		// Cache is stale. Rebuild it.
+		d->tabFieldIdx.clear();
+		d->tabFieldIdx.resize(tabCount());
+
+		int idx = 0;
+		const auto iter_end = d->fields.cend();
+		for (auto iter = d->fields.cbegin(); iter != iter_end; ++iter, idx++) {
+			const uint8_t fieldTab = iter->tabIdx;
+			if (fieldTab >= d->tabFieldIdx.size()) {
+				// Field has a tab index higher than tabCount().
+				// Shouldn't happen, but handle it anyway.
+				d->tabFieldIdx.resize(fieldTab+1);
+			}
+			d->tabFieldIdx[fieldTab].push_back(idx);
+		}
+		d->tabFieldIdxCount = d->fields.size();
+	}
+
+	if (tabIdx >= static_cast<int>(d->tabFieldIdx.size())) {
+		// Tab index is out of range.
+		return nullptr;
+	}
+	return &d->tabFieldIdx[tabIdx];
+}
+
 /** Convenience functions for RomData subclasses. **/
 
 /** Tabs **/
@@ -669,6 +947,69 @@ vector<string> *RomFields::strArrayToVector_i18n(const char *msgctxt, const char
 	return pVec;
 }
 
+/** RomFields::ListDataBuilder **/
+
+/**
+ * Initialize a ListData builder.
+ * @param rows Row count.
+ * @param cols Column count.
+ */
+RomFields::ListDataBuilder::ListDataBuilder(size_t rows, size_t cols)
+	: m_listData(new ListData_t(rows, std::vector<string>(cols)))
+{ }
+
+RomFields::ListDataBuilder::~ListDataBuilder()
+{
+	// NOTE: nullptr if release() was called.
+	delete m_listData;
+}
+
+/**
+ * Set a cell's value. (rvalue overload)
+ * @param row Row index.
+ * @param col Column index.
+ * @param str String. (moved)
+ */
+void RomFields::ListDataBuilder::setCell(size_t row, size_t col, string &&str)
+{
+	assert(m_listData != nullptr);
+	assert(row < m_listData->size());
+	if (!m_listData || row >= m_listData->size())
+		return;
+
+	std::vector<string> &data_row = (*m_listData)[row];
+	assert(col < data_row.size());
+	if (col >= data_row.size())
+		return;
+
+	data_row[col] = std::move(str);
+}
+
+/**
+ * Set a cell's value.
+ * @param row Row index.
+ * @param col Column index.
+ * @param str String. (nullptr is handled as an empty string)
+ */
+void RomFields::ListDataBuilder::setCell(size_t row, size_t col, const char *str)
+{
+	if (str) {
+		setCell(row, col, string(str));
+	}
+}
+
+/**
+ * Take ownership of the completed ListData_t.
+ * The builder is empty afterwards.
+ * @return ListData_t. Delete it or pass it to addField_listData().
+ */
+RomFields::ListData_t *RomFields::ListDataBuilder::release(void)
+{
+	ListData_t *const listData = m_listData;
+	m_listData = nullptr;
+	return listData;
+}
+
 /**
  * Add fields from another RomFields object.
  * @param other Source RomFields object.
@@ -738,12 +1079,21 @@ int RomFields::addFields_romFields(const RomFields *other, int tabOffset)
 				break;
 
 			case RFT_STRING:
-				field_dest.data.str = (field_src.data.str ? new string(*field_src.data.str) : nullptr);
+				if (field_src.desc.flags & STRF_INLINE) {
+					// Inline string. Copy the bytes directly.
+					memcpy(field_dest.data.inline_str, field_src.data.inline_str,
+						sizeof(field_src.data.inline_str));
+				} else if (StringPool::contains(field_src.data.str)) {
+					// Interned string. Share the canonical copy.
+					field_dest.data.str = field_src.data.str;
+				} else {
+					field_dest.data.str = (field_src.data.str ? d->arena_new<string>(*field_src.data.str) : nullptr);
+				}
 				break;
 			case RFT_BITFIELD:
 				field_dest.desc.bitfield.elemsPerRow = field_src.desc.bitfield.elemsPerRow;
 				field_dest.desc.bitfield.names = (field_src.desc.bitfield.names
-						? new vector<string>(*(field_src.desc.bitfield.names))
+						? d->arena_new<vector<string> >(*(field_src.desc.bitfield.names))
 						: nullptr);
 				field_dest.data.bitfield = field_src.data.bitfield;
 				break;
@@ -753,7 +1103,7 @@ int RomFields::addFields_romFields(const RomFields *other, int tabOffset)
 				field_dest.desc.list_data.rows_visible =
 					field_src.desc.list_data.rows_visible;
 				field_dest.desc.list_data.names = (field_src.desc.list_data.names
-						? new vector<string>(*(field_src.desc.list_data.names))
+						? d->arena_new<vector<string> >(*(field_src.desc.list_data.names))
 						: nullptr);
 				field_dest.desc.list_data.alignment.headers =
 					field_src.desc.list_data.alignment.headers;
@@ -761,17 +1111,17 @@ int RomFields::addFields_romFields(const RomFields *other, int tabOffset)
 					field_src.desc.list_data.alignment.data;
 				if (field_src.desc.list_data.flags & RFT_LISTDATA_MULTI) {
 					field_dest.data.list_data.data.multi = (field_src.data.list_data.data.multi
-						? new ListDataMultiMap_t(*(field_src.data.list_data.data.multi))
+						? d->arena_new<ListDataMultiMap_t>(*(field_src.data.list_data.data.multi))
 						: nullptr);
 				} else {
 					field_dest.data.list_data.data.single = (field_src.data.list_data.data.single
-						? new ListData_t(*(field_src.data.list_data.data.single))
+						? d->arena_new<ListData_t>(*(field_src.data.list_data.data.single))
 						: nullptr);
 				}
 				if (field_src.desc.list_data.flags & RFT_LISTDATA_ICONS) {
 					// Icons: Copy the icon vector if set.
 					field_dest.data.list_data.mxd.icons = (field_src.data.list_data.mxd.icons
-						? new ListDataIcons_t(*(field_src.data.list_data.mxd.icons))
+						? d->arena_new<ListDataIcons_t>(*(field_src.data.list_data.mxd.icons))
 						: nullptr);
 				} else {
 					// No icons. Copy checkboxes.
@@ -784,7 +1134,7 @@ int RomFields::addFields_romFields(const RomFields *other, int tabOffset)
 				break;
 			case RFT_AGE_RATINGS:
 				field_dest.data.age_ratings = (field_src.data.age_ratings
-						? new age_ratings_t(*field_src.data.age_ratings)
+						? d->arena_new<age_ratings_t>(*field_src.data.age_ratings)
 						: nullptr);
 				break;
 			case RFT_DIMENSIONS:
@@ -792,7 +1142,7 @@ int RomFields::addFields_romFields(const RomFields *other, int tabOffset)
 				break;
 			case RFT_STRING_MULTI:
 				field_dest.data.str_multi = (field_src.data.str_multi
-					? new StringMultiMap_t(*(field_src.data.str_multi))
+					? d->arena_new<StringMultiMap_t>(*(field_src.data.str_multi))
 					: nullptr);
 				break;
 
@@ -825,17 +1175,22 @@ int RomFields::addField_string(const char *name, const char *str, unsigned int f
 	d->fields.resize(idx+1);
 	Field &field = d->fields.at(idx);
 
-	string *const nstr = (str ? new string(str) : nullptr);
 	field.name = name;
 	field.type = RFT_STRING;
 	field.desc.flags = flags;
-	field.data.str = nstr;
+	field.data.str = nullptr;
 	field.tabIdx = d->tabIdx;
 	field.isValid = (name != nullptr);
 
-	// Handle string trimming flags.
-	if (nstr && (flags & STRF_TRIM_END)) {
-		trimEnd(*nstr);
+	if (str) {
+		if (flags & STRF_TRIM_END) {
+			// Handle string trimming flags.
+			string tmp(str);
+			trimEnd(tmp);
+			d->store_string(field, std::move(tmp));
+		} else {
+			d->store_string(field, str, strlen(str));
+		}
 	}
 	return static_cast<int>(idx);
 }
@@ -859,17 +1214,60 @@ int RomFields::addField_string(const char *name, const string &str, unsigned int
 	d->fields.resize(idx+1);
 	Field &field = d->fields.at(idx);
 
-	string *const nstr = (!str.empty() ? new string(str) : nullptr);
 	field.name = name;
 	field.type = RFT_STRING;
 	field.desc.flags = flags;
-	field.data.str = nstr;
+	field.data.str = nullptr;
 	field.tabIdx = d->tabIdx;
 	field.isValid = true;
 
-	// Handle string trimming flags.
-	if (nstr && (flags & STRF_TRIM_END)) {
-		trimEnd(*nstr);
+	if (!str.empty()) {
+		if (flags & STRF_TRIM_END) {
+			// Handle string trimming flags.
+			string tmp(str);
+			trimEnd(tmp);
+			d->store_string(field, std::move(tmp));
+		} else {
+			d->store_string(field, str.c_str(), str.size());
+		}
+	}
+	return static_cast<int>(idx);
+}
+
+/**
+ * Add string field data. (rvalue overload)
+ * The string is moved instead of copied, so parsers that
+ * build a formatted std::string can hand it over directly.
+ * @param name Field name.
+ * @param str String.
+ * @param flags Formatting flags.
+ * @return Field index.
+ */
+int RomFields::addField_string(const char *name, string &&str, unsigned int flags)
+{
+	assert(name != nullptr);
+	if (!name)
+		return -1;
+
+	// RFT_STRING
+	RP_D(RomFields);
+	size_t idx = d->fields.size();
+	d->fields.resize(idx+1);
+	Field &field = d->fields.at(idx);
+
+	field.name = name;
+	field.type = RFT_STRING;
+	field.desc.flags = flags;
+	field.data.str = nullptr;
+	field.tabIdx = d->tabIdx;
+	field.isValid = true;
+
+	if (!str.empty()) {
+		// Handle string trimming flags.
+		if (flags & STRF_TRIM_END) {
+			trimEnd(str);
+		}
+		d->store_string(field, std::move(str));
 	}
 	return static_cast<int>(idx);
 }
@@ -1163,7 +1561,7 @@ int RomFields::addField_ageRatings(const char *name, const age_ratings_t &age_ra
 
 	field.name = name;
 	field.type = RFT_AGE_RATINGS;
-	field.data.age_ratings = new age_ratings_t(age_ratings);
+	field.data.age_ratings = d->arena_new<age_ratings_t>(age_ratings);
 	field.tabIdx = d->tabIdx;
 	field.isValid = true;
 	return static_cast<int>(idx);
@@ -91,6 +91,20 @@ class RomFields
 
 			// Hexdump: No spaces.
 			STRF_HEXDUMP_NO_SPACES	= (1U << 5),
+
+			// Intern the string in the process-wide string pool.
+			// Use this for values drawn from a bounded set that
+			// repeat across many files, e.g. publisher names from
+			// the static data tables. Do NOT use this for
+			// arbitrary data like game titles, since interned
+			// strings are never freed.
+			STRF_INTERN	= (1U << 6),
+
+			// INTERNAL: The string is stored inline in the
+			// field's data union. Set automatically by
+			// addField_string(); do NOT set this manually.
+			// Use Field::str() to read the string.
+			STRF_INLINE	= (1U << 15),
 		};
 
 		// Display flags for RFT_LISTDATA.
@@ -232,6 +246,12 @@ class RomFields
 				// RFT_STRING
 				const std::string *str;
 
+				// RFT_STRING (inline storage)
+				// Used if STRF_INLINE is set.
+				// NUL-terminated; use Field::str() to
+				// read RFT_STRING fields transparently.
+				char inline_str[32];
+
 				// RFT_BITFIELD
 				uint32_t bitfield;
 
@@ -277,6 +297,13 @@ class RomFields
 				// - Value: String
 				const StringMultiMap_t *str_multi;
 			} data;
+
+			/**
+			 * Get the string value of an RFT_STRING field.
+			 * Handles both inline and out-of-line storage.
+			 * @return String value, or nullptr if no string is set.
+			 */
+			const char *str(void) const;
 		};
 
 	public:
@@ -330,6 +357,20 @@ class RomFields
 		 */
 		const_iterator cend(void) const;
 
+		/**
+		 * Get the indexes of all fields on the specified tab.
+		 *
+		 * The index is built once and cached, so UI frontends can
+		 * iterate a single tab's fields directly instead of scanning
+		 * the entire field list once per tab.
+		 *
+		 * The returned vector is invalidated if more fields are added.
+		 *
+		 * @param tabIdx Tab index.
+		 * @return Vector of field indexes, or nullptr if the tab index is invalid.
+		 */
+		const std::vector<int> *tabFieldIndexes(int tabIdx) const;
+
 	public:
 		/**
 		 * Get the abbreviation of an age rating organization.
@@ -457,6 +498,55 @@ class RomFields
 		 */
 		static std::vector<std::string> *strArrayToVector_i18n(const char *msgctxt, const char *const *strArray, size_t count);
 
+		/**
+		 * Helper class for building a ListData_t with known dimensions.
+		 * The entire row/column structure is allocated in a single pass
+		 * up front, so filling in cells doesn't grow or reallocate any
+		 * vectors. Use this instead of building the table cell by cell
+		 * for large tables, e.g. achievement lists.
+		 */
+		class ListDataBuilder
+		{
+			public:
+				/**
+				 * Initialize a ListData builder.
+				 * @param rows Row count.
+				 * @param cols Column count.
+				 */
+				ListDataBuilder(size_t rows, size_t cols);
+				~ListDataBuilder();
+
+			private:
+				RP_DISABLE_COPY(ListDataBuilder)
+
+			public:
+				/**
+				 * Set a cell's value. (rvalue overload)
+				 * @param row Row index.
+				 * @param col Column index.
+				 * @param str String. (moved)
+				 */
+				void setCell(size_t row, size_t col, std::string &&str);
+
+				/**
+				 * Set a cell's value.
+				 * @param row Row index.
+				 * @param col Column index.
+				 * @param str String. (nullptr is handled as an empty string)
+				 */
+				void setCell(size_t row, size_t col, const char *str);
+
+				/**
+				 * Take ownership of the completed ListData_t.
+				 * The builder is empty afterwards.
+				 * @return ListData_t. Delete it or pass it to addField_listData().
+				 */
+				ListData_t *release(void);
+
+			private:
+				ListData_t *m_listData;
+		};
+
 		enum {
 			TabOffset_Ignore = -1,
 			TabOffset_AddTabs = -2,
@@ -493,6 +583,17 @@ class RomFields
 		 */
 		int addField_string(const char *name, const std::string &str, unsigned int flags = 0);
 
+		/**
+		 * Add string field data. (rvalue overload)
+		 * The string is moved instead of copied, so parsers that
+		 * build a formatted std::string can hand it over directly.
+		 * @param name Field name.
+		 * @param str String.
+		 * @param flags Formatting flags.
+		 * @return Field index.
+		 */
+		int addField_string(const char *name, std::string &&str, unsigned int flags = 0);
+
 		enum Base {
 			FB_DEC,
 			FB_HEX,
@@ -452,6 +452,44 @@ int RomMetaData::addMetaData_string(Property::Property name, const string &str,
 	return static_cast<int>(idx);
 }
 
+/**
+ * Add a string metadata property. (rvalue overload)
+ * The string is moved instead of copied, so parsers that
+ * build a formatted std::string can hand it over directly.
+ * @param name Metadata name.
+ * @param str String value.
+ * @param flags Formatting flags.
+ * @return Metadata index.
+ */
+int RomMetaData::addMetaData_string(Property::Property name, string &&str, unsigned int flags)
+{
+	assert(name > Property::FirstProperty);
+	assert(name < Property::PropertyCount);
+	if (name <= Property::FirstProperty || name >= Property::PropertyCount)
+		return -1;
+
+	// Make sure this is an integer property.
+	assert(RomMetaDataPrivate::PropertyTypeMap[name] == PropertyType::String);
+	if (RomMetaDataPrivate::PropertyTypeMap[name] != PropertyType::String)
+		return -1;
+
+	RP_D(RomMetaData);
+	size_t idx = d->metaData.size();
+	d->metaData.resize(idx+1);
+	MetaData &metaData = d->metaData.at(idx);
+
+	string *const nstr = (!str.empty() ? new string(std::move(str)) : nullptr);
+	metaData.name = name;
+	metaData.type = PropertyType::String;
+	metaData.data.str = nstr;
+
+	// Trim the string if requested.
+	if (nstr && (flags & STRF_TRIM_END)) {
+		trimEnd(*nstr);
+	}
+	return static_cast<int>(idx);
+}
+
 /**
  * Add a timestamp metadata property.
  * @param name Metadata name.
@@ -255,6 +255,17 @@ class RomMetaData
 		 */
 		int addMetaData_string(Property::Property name, const std::string &str, unsigned int flags = 0);
 
+		/**
+		 * Add a string metadata property. (rvalue overload)
+		 * The string is moved instead of copied, so parsers that
+		 * build a formatted std::string can hand it over directly.
+		 * @param name Metadata name.
+		 * @param str String value.
+		 * @param flags Formatting flags.
+		 * @return Metadata index.
+		 */
+		int addMetaData_string(Property::Property name, std::string &&str, unsigned int flags = 0);
+
 		/**
 		 * Add a timestamp metadata property.
 		 * @param name Metadata name.
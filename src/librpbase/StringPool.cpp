@@ -0,0 +1,78 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * StringPool.cpp: Process-wide string interning pool.                     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "StringPool.hpp"
+
+// librpthreads
+#include "librpthreads/Mutex.hpp"
+
+// C++ STL classes.
+#include <unordered_set>
+using std::string;
+using std::unordered_set;
+
+namespace LibRpBase {
+
+// Process-wide intern table.
+// NOTE: unordered_set is node-based, so the string addresses are
+// stable across rehashes. The address set is kept separately so
+// contains() doesn't have to hash the string contents.
+// NOTE 2: Guarded by a mutex instead of a lock-free structure;
+// the critical sections are a single hash lookup, and interning
+// only happens while fields are being built.
+static Mutex g_internMutex;
+static unordered_set<string> g_internPool;
+static unordered_set<const string*> g_internAddrs;
+
+/**
+ * Intern a string.
+ * @param str String. (If nullptr, returns nullptr.)
+ * @return Canonical process-wide copy of the string.
+ */
+const string *StringPool::intern(const char *str)
+{
+	if (!str) {
+		return nullptr;
+	}
+	return intern(string(str));
+}
+
+/**
+ * Intern a string.
+ * @param str String.
+ * @return Canonical process-wide copy of the string.
+ */
+const string *StringPool::intern(const string &str)
+{
+	MutexLocker locker(g_internMutex);
+	auto result = g_internPool.insert(str);
+	const string *const pStr = &(*result.first);
+	if (result.second) {
+		// Newly-interned string.
+		g_internAddrs.insert(pStr);
+	}
+	return pStr;
+}
+
+/**
+ * Check if a string pointer is an interned string.
+ * Used to skip freeing interned strings.
+ * @param str String pointer.
+ * @return True if interned; false if not.
+ */
+bool StringPool::contains(const string *str)
+{
+	if (!str) {
+		return false;
+	}
+	MutexLocker locker(g_internMutex);
+	return (g_internAddrs.find(str) != g_internAddrs.end());
+}
+
+}
@@ -0,0 +1,63 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * StringPool.hpp: Process-wide string interning pool.                     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_STRINGPOOL_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_STRINGPOOL_HPP__
+
+#include "common.h"
+
+// C++ includes.
+#include <string>
+
+namespace LibRpBase {
+
+/**
+ * Process-wide string interning pool.
+ *
+ * Values that repeat across many RomData instances, e.g. publisher
+ * names looked up from the static data tables, can be interned here
+ * so batch scans don't duplicate the same few hundred strings once
+ * per file. Interned strings live for the lifetime of the process
+ * and are never freed, so only intern values drawn from a bounded
+ * set - never arbitrary data like game titles.
+ */
+class StringPool
+{
+	private:
+		// Static class.
+		StringPool();
+		~StringPool();
+		RP_DISABLE_COPY(StringPool)
+
+	public:
+		/**
+		 * Intern a string.
+		 * @param str String. (If nullptr, returns nullptr.)
+		 * @return Canonical process-wide copy of the string.
+		 */
+		static const std::string *intern(const char *str);
+
+		/**
+		 * Intern a string.
+		 * @param str String.
+		 * @return Canonical process-wide copy of the string.
+		 */
+		static const std::string *intern(const std::string &str);
+
+		/**
+		 * Check if a string pointer is an interned string.
+		 * Used to skip freeing interned strings.
+		 * @param str String pointer.
+		 * @return True if interned; false if not.
+		 */
+		static bool contains(const std::string *str);
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_STRINGPOOL_HPP__ */
@@ -273,10 +273,7 @@ static inline std::string utf8_to_ansi(const std::string &str)
  * @param len	[in] Length of str, in bytes. (-1 for NULL-terminated string)
  * @return UTF-8 string.
  */
-static inline std::string cp1252_to_utf8(const char *str, int len)
-{
-	return cpN_to_utf8(1252, str, len);
-}
+std::string cp1252_to_utf8(const char *str, int len);
 
 /**
  * Convert cp1252 text to UTF-8.
@@ -286,7 +283,7 @@ static inline std::string cp1252_to_utf8(const char *str, int len)
  */
 static inline std::string cp1252_to_utf8(const std::string &str)
 {
-	return cpN_to_utf8(1252, str.data(), static_cast<int>(str.size()));
+	return cp1252_to_utf8(str.data(), static_cast<int>(str.size()));
 }
 
 /**
@@ -336,10 +333,7 @@ static inline std::string utf16_to_cp1252(const char16_t *wcs, int len)
  * @param len	[in] Length of str, in bytes. (-1 for NULL-terminated string)
  * @return UTF-8 string.
  */
-static inline std::string cp1252_sjis_to_utf8(const char *str, int len)
-{
-	return cpN_to_utf8(932, str, len, TEXTCONV_FLAG_CP1252_FALLBACK);
-}
+std::string cp1252_sjis_to_utf8(const char *str, int len);
 
 /**
  * Convert cp1252 or Shift-JIS (cp932) text to UTF-8.
@@ -349,8 +343,7 @@ static inline std::string cp1252_sjis_to_utf8(const char *str, int len)
  */
 static inline std::string cp1252_sjis_to_utf8(const std::string &str)
 {
-	return cpN_to_utf8(932, str.data(), static_cast<int>(str.size()),
-		TEXTCONV_FLAG_CP1252_FALLBACK);
+	return cp1252_sjis_to_utf8(str.data(), static_cast<int>(str.size()));
 }
 
 /**
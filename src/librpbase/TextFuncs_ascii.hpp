@@ -0,0 +1,277 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * TextFuncs_ascii.hpp: Text encoding functions. (ASCII fast paths)        *
+ *                                                                         *
+ * Copyright (c) 2009-2019 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_TEXTFUNCS_ASCII_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_TEXTFUNCS_ASCII_HPP__
+
+#include "config.librpbase.h"
+#include "common.h"
+#include "librpcpu/cpu_dispatch.h"
+
+// for the CP_* code page macros
+#include "TextFuncs.hpp"
+
+// for SYS_BYTEORDER
+#include "byteorder.h"
+
+// C includes. (C++ namespace)
+#include <cstdint>
+
+// C++ includes.
+#include <string>
+
+// ASCII text is its own UTF-8 encoding, so pure-ASCII input can skip
+// iconv() / MultiByteToWideChar() entirely. Most ROM header strings are
+// pure ASCII, so this is the common case.
+// NOTE: SSE2 is always available on amd64, so the vectorized check
+// doesn't need runtime CPU detection there. i386 builds that don't
+// guarantee SSE2 use the scalar version.
+#if defined(RP_CPU_AMD64) || (defined(RP_CPU_I386) && defined(__SSE2__))
+# define TEXTFUNCS_ALWAYS_HAS_SSE2 1
+# include <emmintrin.h>
+#endif
+
+namespace LibRpBase {
+
+/**
+ * Convert 8-bit text to UTF-8 if it's pure ASCII.
+ * @param str	[in] 8-bit text. (ASCII-compatible code page)
+ * @param len	[in] Length of str, in bytes. (must be NULL-trimmed already)
+ * @param ret	[out] UTF-8 string. (only modified if the text is pure ASCII)
+ * @return True if the text was pure ASCII and has been converted; false if not.
+ */
+static inline bool ascii_to_utf8(const char *str, int len, std::string *ret)
+{
+	const uint8_t *p = reinterpret_cast<const uint8_t*>(str);
+	int i = 0;
+
+#ifdef TEXTFUNCS_ALWAYS_HAS_SSE2
+	// Check 16 bytes at a time.
+	// A set high bit in any byte means non-ASCII.
+	for (; i + 16 <= len; i += 16) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&p[i]));
+		if (_mm_movemask_epi8(chunk) != 0) {
+			// Found a non-ASCII byte.
+			return false;
+		}
+	}
+#endif /* TEXTFUNCS_ALWAYS_HAS_SSE2 */
+
+	for (; i < len; i++) {
+		if (p[i] & 0x80) {
+			// Found a non-ASCII byte.
+			return false;
+		}
+	}
+
+	// Pure ASCII. The text is valid UTF-8 as-is.
+	ret->assign(str, len);
+	return true;
+}
+
+/**
+ * Convert 8-bit text to UTF-16 if it's pure ASCII.
+ * @param str	[in] 8-bit text. (ASCII-compatible code page)
+ * @param len	[in] Length of str, in bytes. (must be NULL-trimmed already)
+ * @param ret	[out] UTF-16 string. (only modified if the text is pure ASCII)
+ * @return True if the text was pure ASCII and has been converted; false if not.
+ */
+static inline bool ascii_to_utf16(const char *str, int len, std::u16string *ret)
+{
+	const uint8_t *p = reinterpret_cast<const uint8_t*>(str);
+	int i = 0;
+
+#ifdef TEXTFUNCS_ALWAYS_HAS_SSE2
+	// Check 16 bytes at a time.
+	// A set high bit in any byte means non-ASCII.
+	for (; i + 16 <= len; i += 16) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&p[i]));
+		if (_mm_movemask_epi8(chunk) != 0) {
+			// Found a non-ASCII byte.
+			return false;
+		}
+	}
+#endif /* TEXTFUNCS_ALWAYS_HAS_SSE2 */
+
+	for (; i < len; i++) {
+		if (p[i] & 0x80) {
+			// Found a non-ASCII byte.
+			return false;
+		}
+	}
+
+	// Pure ASCII. Widen the characters directly.
+	ret->resize(len);
+	i = 0;
+#ifdef TEXTFUNCS_ALWAYS_HAS_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	for (; i + 16 <= len; i += 16) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&p[i]));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&(*ret)[i]),
+			_mm_unpacklo_epi8(chunk, zero));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&(*ret)[i+8]),
+			_mm_unpackhi_epi8(chunk, zero));
+	}
+#endif /* TEXTFUNCS_ALWAYS_HAS_SSE2 */
+	for (; i < len; i++) {
+		(*ret)[i] = static_cast<char16_t>(p[i]);
+	}
+	return true;
+}
+
+/**
+ * Convert UTF-16LE text to UTF-8 if it's pure ASCII.
+ * @param wcs	[in] UTF-16LE text.
+ * @param len	[in] Length of wcs, in characters. (must be NULL-trimmed already)
+ * @param ret	[out] UTF-8 string. (only modified if the text is pure ASCII)
+ * @return True if the text was pure ASCII and has been converted; false if not.
+ */
+static inline bool utf16le_ascii_to_utf8(const char16_t *wcs, int len, std::string *ret)
+{
+	// Work on the raw bytes so this is host-endian independent:
+	// an ASCII UTF-16LE unit is {ch, 0x00}.
+	const uint8_t *p = reinterpret_cast<const uint8_t*>(wcs);
+	int i = 0;
+
+#ifdef TEXTFUNCS_ALWAYS_HAS_SSE2
+	// Validate 8 characters at a time. x86 is little-endian,
+	// so the 16-bit lanes match the UTF-16LE units directly.
+	// A unit with any bit set in 0xFF80 is non-ASCII.
+	const __m128i ascii_mask = _mm_set1_epi16(static_cast<int16_t>(0xFF80));
+	for (; i + 8 <= len; i += 8) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&p[i*2]));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(
+			_mm_and_si128(chunk, ascii_mask), _mm_setzero_si128())) != 0xFFFF)
+		{
+			// Found a non-ASCII character.
+			return false;
+		}
+	}
+#endif /* TEXTFUNCS_ALWAYS_HAS_SSE2 */
+
+	for (; i < len; i++) {
+		if ((p[i*2] & 0x80) || p[i*2+1] != 0) {
+			// Found a non-ASCII character.
+			return false;
+		}
+	}
+
+	// Pure ASCII. Narrow the characters directly.
+	ret->resize(len);
+	p = reinterpret_cast<const uint8_t*>(wcs);
+	i = 0;
+#ifdef TEXTFUNCS_ALWAYS_HAS_SSE2
+	for (; i + 8 <= len; i += 8) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&p[i*2]));
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(&(*ret)[i]),
+			_mm_packus_epi16(chunk, chunk));
+	}
+#endif /* TEXTFUNCS_ALWAYS_HAS_SSE2 */
+	for (; i < len; i++) {
+		(*ret)[i] = static_cast<char>(p[i*2]);
+	}
+	return true;
+}
+
+/**
+ * Convert UTF-16BE text to UTF-8 if it's pure ASCII.
+ * @param wcs	[in] UTF-16BE text.
+ * @param len	[in] Length of wcs, in characters. (must be NULL-trimmed already)
+ * @param ret	[out] UTF-8 string. (only modified if the text is pure ASCII)
+ * @return True if the text was pure ASCII and has been converted; false if not.
+ */
+static inline bool utf16be_ascii_to_utf8(const char16_t *wcs, int len, std::string *ret)
+{
+	// Work on the raw bytes so this is host-endian independent:
+	// an ASCII UTF-16BE unit is {0x00, ch}.
+	const uint8_t *p = reinterpret_cast<const uint8_t*>(wcs);
+	int i = 0;
+
+#ifdef TEXTFUNCS_ALWAYS_HAS_SSE2
+	// Validate 8 characters at a time. x86 is little-endian,
+	// so a UTF-16BE unit loads byteswapped: a unit with any bit
+	// set in 0x80FF is non-ASCII.
+	const __m128i ascii_mask = _mm_set1_epi16(static_cast<int16_t>(0x80FF));
+	for (; i + 8 <= len; i += 8) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&p[i*2]));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi16(
+			_mm_and_si128(chunk, ascii_mask), _mm_setzero_si128())) != 0xFFFF)
+		{
+			// Found a non-ASCII character.
+			return false;
+		}
+	}
+#endif /* TEXTFUNCS_ALWAYS_HAS_SSE2 */
+
+	for (; i < len; i++) {
+		if (p[i*2] != 0 || (p[i*2+1] & 0x80)) {
+			// Found a non-ASCII character.
+			return false;
+		}
+	}
+
+	// Pure ASCII. Narrow the characters directly.
+	ret->resize(len);
+	p = reinterpret_cast<const uint8_t*>(wcs);
+	i = 0;
+#ifdef TEXTFUNCS_ALWAYS_HAS_SSE2
+	for (; i + 8 <= len; i += 8) {
+		__m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&p[i*2]));
+		// Shift the character bytes into the low bytes, then pack.
+		chunk = _mm_srli_epi16(chunk, 8);
+		_mm_storel_epi64(reinterpret_cast<__m128i*>(&(*ret)[i]),
+			_mm_packus_epi16(chunk, chunk));
+	}
+#endif /* TEXTFUNCS_ALWAYS_HAS_SSE2 */
+	for (; i < len; i++) {
+		(*ret)[i] = static_cast<char>(p[i*2+1]);
+	}
+	return true;
+}
+
+/**
+ * Convert host-endian UTF-16 text to UTF-8 if it's pure ASCII.
+ * @param wcs	[in] Host-endian UTF-16 text.
+ * @param len	[in] Length of wcs, in characters. (must be NULL-trimmed already)
+ * @param ret	[out] UTF-8 string. (only modified if the text is pure ASCII)
+ * @return True if the text was pure ASCII and has been converted; false if not.
+ */
+static FORCEINLINE bool utf16_ascii_to_utf8(const char16_t *wcs, int len, std::string *ret)
+{
+#if SYS_BYTEORDER == SYS_LIL_ENDIAN
+	return utf16le_ascii_to_utf8(wcs, len, ret);
+#else /* SYS_BYTEORDER == SYS_BIG_ENDIAN */
+	return utf16be_ascii_to_utf8(wcs, len, ret);
+#endif
+}
+
+/**
+ * Is a code page's low range (0x00-0x7F) plain ASCII?
+ * These are the only code pages where ascii_to_utf8() may be used.
+ * @param cp Code page number.
+ * @return True if the code page is ASCII-compatible; false if not.
+ */
+static FORCEINLINE bool is_ascii_compatible_cp(unsigned int cp)
+{
+	// NOTE: Arbitrary code pages might not be ASCII-compatible,
+	// e.g. EBCDIC, so only allow the ones we actually use.
+	switch (cp) {
+		case CP_ACP:
+		case CP_LATIN1:
+		case CP_UTF8:
+		case CP_SJIS:
+		case 1252:
+			return true;
+		default:
+			return false;
+	}
+}
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_TEXTFUNCS_ASCII_HPP__ */
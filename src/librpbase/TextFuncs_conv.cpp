@@ -9,9 +9,14 @@
 #include "stdafx.h"
 #include "TextFuncs.hpp"
 #include "TextFuncs_NULL.hpp"
+#include "TextFuncs_ascii.hpp"
+
+// Windows-31J (cp932) lookup tables.
+#include "TextFuncs_cp932_tbl.h"
 
 // C++ STL classes.
 using std::string;
+using std::unique_ptr;
 
 // The specialized code page conversions in this file aren't supported by
 // standard system libraries.
@@ -79,6 +84,192 @@ static string str8_to_utf8(const char16_t tbl[256], const char *str, int len)
 	return s_utf8;
 }
 
+/**
+ * Encode a BMP codepoint as UTF-8.
+ * @param p	[out] Output buffer. (Must have room for 3 bytes.)
+ * @param ch16	[in] UTF-16 codepoint. (BMP only)
+ * @return Pointer to the byte after the encoded codepoint.
+ */
+static FORCEINLINE char *utf8_encode_bmp(char *p, char16_t ch16)
+{
+	if (ch16 < 0x0080) {
+		*p++ = (char)(ch16 & 0x7F);
+	} else if (ch16 < 0x0800) {
+		*p++ = (char)(0xC0 | ((ch16 >>  6) & 0x1F));
+		*p++ = (char)(0x80 | ((ch16 >>  0) & 0x3F));
+	} else /*if (ch16 < 0x10000)*/ {
+		*p++ = (char)(0xE0 | ((ch16 >> 12) & 0x0F));
+		*p++ = (char)(0x80 | ((ch16 >>  6) & 0x3F));
+		*p++ = (char)(0x80 | ((ch16 >>  0) & 0x3F));
+	}
+	return p;
+}
+
+// Stack buffer size for the table-driven decoders.
+// Short strings, e.g. ROM titles, are decoded entirely on the
+// stack, so the only allocation is the returned std::string.
+// (BMP codepoints encode to at most 3 UTF-8 bytes.)
+#define TBLCONV_STACK_BUF_SIZE 192
+
+// cp1252 lookup table.
+// Reference: https://en.wikipedia.org/wiki/Windows-1252
+// - Index: 8-bit character.
+// - Value: 16-bit UTF-16 codepoint.
+// NOTE: The five undefined characters (0x81, 0x8D, 0x8F, 0x90, 0x9D)
+// are mapped to the corresponding C1 control codes, which matches
+// the behavior of MultiByteToWideChar().
+static const char16_t cp1252_lkup[256] = {
+	// 0x00
+	0x0000, 0x0001, 0x0002, 0x0003, 0x0004, 0x0005, 0x0006, 0x0007,
+	0x0008, 0x0009, 0x000A, 0x000B, 0x000C, 0x000D, 0x000E, 0x000F,
+	// 0x10
+	0x0010, 0x0011, 0x0012, 0x0013, 0x0014, 0x0015, 0x0016, 0x0017,
+	0x0018, 0x0019, 0x001A, 0x001B, 0x001C, 0x001D, 0x001E, 0x001F,
+	// 0x20
+	' ', '!', '"', '#', '$', '%', '&', '\'', '(', ')', '*', '+', ',', '-', '.', '/',
+	// 0x30
+	'0', '1', '2', '3', '4', '5', '6', '7', '8', '9', ':', ';', '<', '=', '>', '?',
+	// 0x40
+	'@', 'A', 'B', 'C', 'D', 'E', 'F', 'G', 'H', 'I', 'J', 'K', 'L', 'M', 'N', 'O',
+	// 0x50
+	'P', 'Q', 'R', 'S', 'T', 'U', 'V', 'W', 'X', 'Y', 'Z', '[', '\\', ']', '^', '_',
+	// 0x60
+	'`', 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o',
+	// 0x70
+	'p', 'q', 'r', 's', 't', 'u', 'v', 'w', 'x', 'y', 'z', '{', '|', '}', '~', 0x007F,
+	// 0x80
+	0x20AC, 0x0081, 0x201A, 0x0192, 0x201E, 0x2026, 0x2020, 0x2021,
+	0x02C6, 0x2030, 0x0160, 0x2039, 0x0152, 0x008D, 0x017D, 0x008F,
+	// 0x90
+	0x0090, 0x2018, 0x2019, 0x201C, 0x201D, 0x2022, 0x2013, 0x2014,
+	0x02DC, 0x2122, 0x0161, 0x203A, 0x0153, 0x009D, 0x017E, 0x0178,
+	// 0xA0
+	0x00A0, 0x00A1, 0x00A2, 0x00A3, 0x00A4, 0x00A5, 0x00A6, 0x00A7,
+	0x00A8, 0x00A9, 0x00AA, 0x00AB, 0x00AC, 0x00AD, 0x00AE, 0x00AF,
+	// 0xB0
+	0x00B0, 0x00B1, 0x00B2, 0x00B3, 0x00B4, 0x00B5, 0x00B6, 0x00B7,
+	0x00B8, 0x00B9, 0x00BA, 0x00BB, 0x00BC, 0x00BD, 0x00BE, 0x00BF,
+	// 0xC0
+	0x00C0, 0x00C1, 0x00C2, 0x00C3, 0x00C4, 0x00C5, 0x00C6, 0x00C7,
+	0x00C8, 0x00C9, 0x00CA, 0x00CB, 0x00CC, 0x00CD, 0x00CE, 0x00CF,
+	// 0xD0
+	0x00D0, 0x00D1, 0x00D2, 0x00D3, 0x00D4, 0x00D5, 0x00D6, 0x00D7,
+	0x00D8, 0x00D9, 0x00DA, 0x00DB, 0x00DC, 0x00DD, 0x00DE, 0x00DF,
+	// 0xE0
+	0x00E0, 0x00E1, 0x00E2, 0x00E3, 0x00E4, 0x00E5, 0x00E6, 0x00E7,
+	0x00E8, 0x00E9, 0x00EA, 0x00EB, 0x00EC, 0x00ED, 0x00EE, 0x00EF,
+	// 0xF0
+	0x00F0, 0x00F1, 0x00F2, 0x00F3, 0x00F4, 0x00F5, 0x00F6, 0x00F7,
+	0x00F8, 0x00F9, 0x00FA, 0x00FB, 0x00FC, 0x00FD, 0x00FE, 0x00FF,
+};
+
+/**
+ * Convert cp1252 text to UTF-8.
+ * Trailing NULL bytes will be removed.
+ * @param str	[in] cp1252 text.
+ * @param len	[in] Length of str, in bytes. (-1 for NULL-terminated string)
+ * @return UTF-8 string.
+ */
+string cp1252_to_utf8(const char *str, int len)
+{
+	len = check_NULL_terminator(str, len);
+
+	// Fast path: Pure ASCII text can be copied as-is.
+	string ret;
+	if (ascii_to_utf8(str, len, &ret)) {
+		return ret;
+	}
+
+	// Decode into a stack buffer if the string is short enough;
+	// otherwise, use a temporary heap buffer.
+	char stack_buf[TBLCONV_STACK_BUF_SIZE];
+	char *buf = stack_buf;
+	unique_ptr<char[]> heap_buf;
+	if (len * 3 > (int)sizeof(stack_buf)) {
+		heap_buf.reset(new char[len * 3]);
+		buf = heap_buf.get();
+	}
+
+	// cp1252 decoding is branch-free: every byte maps to
+	// exactly one BMP codepoint.
+	char *p = buf;
+	for (int i = 0; i < len; i++) {
+		p = utf8_encode_bmp(p, cp1252_lkup[(uint8_t)str[i]]);
+	}
+
+	ret.assign(buf, p - buf);
+	return ret;
+}
+
+/**
+ * Convert cp1252 or Shift-JIS (cp932) text to UTF-8.
+ * Trailing NULL bytes will be removed.
+ * @param str	[in] cp1252 or Shift-JIS (cp932) text.
+ * @param len	[in] Length of str, in bytes. (-1 for NULL-terminated string)
+ * @return UTF-8 string.
+ */
+string cp1252_sjis_to_utf8(const char *str, int len)
+{
+	len = check_NULL_terminator(str, len);
+
+	// Fast path: Pure ASCII text can be copied as-is.
+	string ret;
+	if (ascii_to_utf8(str, len, &ret)) {
+		return ret;
+	}
+
+	// Decode into a stack buffer if the string is short enough;
+	// otherwise, use a temporary heap buffer.
+	char stack_buf[TBLCONV_STACK_BUF_SIZE];
+	char *buf = stack_buf;
+	unique_ptr<char[]> heap_buf;
+	if (len * 3 > (int)sizeof(stack_buf)) {
+		heap_buf.reset(new char[len * 3]);
+		buf = heap_buf.get();
+	}
+
+	// Attempt to decode the text as cp932.
+	// If any sequence is invalid, the entire string is
+	// reinterpreted as cp1252 instead.
+	char *p = buf;
+	const uint8_t *s = reinterpret_cast<const uint8_t*>(str);
+	const uint8_t *const s_end = s + len;
+	while (s < s_end) {
+		const uint8_t chr = *s++;
+		char16_t ch16;
+		if (chr < 0x80) {
+			// ASCII.
+			*p++ = (char)chr;
+			continue;
+		} else if (chr >= 0xA1 && chr <= 0xDF) {
+			// JIS X 0201 halfwidth katakana.
+			ch16 = 0xFEC0 + chr;	// U+FF61 - U+FF9F
+		} else {
+			// Possible double-byte sequence.
+			const unsigned int page = cp932_lead_lkup[chr];
+			if (page == 0xFF || s == s_end) {
+				// Invalid lead byte, or the string
+				// ends in the middle of a sequence.
+				return cp1252_to_utf8(str, len);
+			}
+			const uint8_t trail = *s++;
+			if (trail < 0x40 || trail == 0x7F || trail > 0xFC) {
+				// Invalid trail byte.
+				return cp1252_to_utf8(str, len);
+			}
+			ch16 = cp932_page_lkup[page][trail - 0x40 - (trail > 0x7F)];
+			if (ch16 == 0) {
+				// Invalid sequence.
+				return cp1252_to_utf8(str, len);
+			}
+		}
+		p = utf8_encode_bmp(p, ch16);
+	}
+
+	ret.assign(buf, p - buf);
+	return ret;
+}
+
 /**
  * Convert Atari ST text to UTF-8.
  * Trailing NULL bytes will be removed.
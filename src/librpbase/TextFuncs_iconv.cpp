@@ -10,6 +10,7 @@
 #include "config.librpbase.h"
 #include "TextFuncs.hpp"
 #include "TextFuncs_NULL.hpp"
+#include "TextFuncs_ascii.hpp"
 
 #if defined(_WIN32)
 # error TextFuncs_iconv.cpp is not supported on Windows.
@@ -203,6 +204,13 @@ string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int flags
 {
 	len = check_NULL_terminator(str, len);
 
+	// Fast path: Pure ASCII text in an ASCII-compatible code page
+	// doesn't need iconv() at all.
+	string ret;
+	if (is_ascii_compatible_cp(cp) && ascii_to_utf8(str, len, &ret)) {
+		return ret;
+	}
+
 	// Get the encoding name for the primary code page.
 	char cp_name[20];
 	codePageToEncName(cp_name, sizeof(cp_name), cp);
@@ -214,7 +222,6 @@ string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int flags
 	// Attempt to convert the text to UTF-8.
 	// NOTE: "//IGNORE" sometimes doesn't work, so we won't
 	// check for TEXTCONV_FLAG_CP1252_FALLBACK here.
-	string ret;
 	char *mbs = reinterpret_cast<char*>(rp_iconv((char*)str, len*sizeof(*str), cp_name, "UTF-8", ignoreErr));
 	if (!mbs /*&& (flags & TEXTCONV_FLAG_CP1252_FALLBACK)*/) {
 		// Try cp1252 fallback.
@@ -269,6 +276,13 @@ u16string cpN_to_utf16(unsigned int cp, const char *str, int len, unsigned int f
 {
 	len = check_NULL_terminator(str, len);
 
+	// Fast path: Pure ASCII text in an ASCII-compatible code page
+	// doesn't need iconv() at all.
+	u16string ret;
+	if (is_ascii_compatible_cp(cp) && ascii_to_utf16(str, len, &ret)) {
+		return ret;
+	}
+
 	// Get the encoding name for the primary code page.
 	char cp_name[20];
 	codePageToEncName(cp_name, sizeof(cp_name), cp);
@@ -280,7 +294,6 @@ u16string cpN_to_utf16(unsigned int cp, const char *str, int len, unsigned int f
 	// Attempt to convert the text to UTF-16.
 	// NOTE: "//IGNORE" sometimes doesn't work, so we won't
 	// check for TEXTCONV_FLAG_CP1252_FALLBACK here.
-	u16string ret;
 	char16_t *wcs = reinterpret_cast<char16_t*>(rp_iconv((char*)str, len*sizeof(*str), cp_name, RP_ICONV_UTF16_ENCODING, ignoreErr));
 	if (!wcs /*&& (flags & TEXTCONV_FLAG_CP1252_FALLBACK)*/) {
 		// Try cp1252 fallback.
@@ -362,6 +375,13 @@ string utf16_to_cpN(unsigned int cp, const char16_t *wcs, int len)
 {
 	len = check_NULL_terminator(wcs, len);
 
+	// Fast path: Pure ASCII text in an ASCII-compatible code page
+	// doesn't need iconv() at all.
+	string ret;
+	if (is_ascii_compatible_cp(cp) && utf16_ascii_to_utf8(wcs, len, &ret)) {
+		return ret;
+	}
+
 	// Get the encoding name for the primary code page.
 	char cp_name[20];
 	codePageToEncName(cp_name, sizeof(cp_name), cp);
@@ -370,7 +390,6 @@ string utf16_to_cpN(unsigned int cp, const char16_t *wcs, int len)
 	const bool ignoreErr = (cp != CP_UTF8);
 
 	// Attempt to convert the text from UTF-8.
-	string ret;
 	char *mbs = reinterpret_cast<char*>(rp_iconv((char*)wcs, len*sizeof(*wcs), RP_ICONV_UTF16_ENCODING, cp_name, ignoreErr));
 	if (mbs) {
 		ret.assign(mbs);
@@ -392,8 +411,13 @@ string utf16le_to_utf8(const char16_t *wcs, int len)
 {
 	len = check_NULL_terminator(wcs, len);
 
-	// Attempt to convert the text from UTF-16LE to UTF-8.
+	// Fast path: Pure ASCII text doesn't need iconv() at all.
 	string ret;
+	if (utf16le_ascii_to_utf8(wcs, len, &ret)) {
+		return ret;
+	}
+
+	// Attempt to convert the text from UTF-16LE to UTF-8.
 	char *mbs = reinterpret_cast<char*>(rp_iconv((char*)wcs, len*sizeof(*wcs), "UTF-16LE", "UTF-8"));
 	if (mbs) {
 		ret.assign(mbs);
@@ -413,8 +437,13 @@ string utf16be_to_utf8(const char16_t *wcs, int len)
 {
 	len = check_NULL_terminator(wcs, len);
 
-	// Attempt to convert the text from UTF-16BE to UTF-8.
+	// Fast path: Pure ASCII text doesn't need iconv() at all.
 	string ret;
+	if (utf16be_ascii_to_utf8(wcs, len, &ret)) {
+		return ret;
+	}
+
+	// Attempt to convert the text from UTF-16BE to UTF-8.
 	char *mbs = reinterpret_cast<char*>(rp_iconv((char*)wcs, len*sizeof(*wcs), "UTF-16BE", "UTF-8"));
 	if (mbs) {
 		ret.assign(mbs);
@@ -10,6 +10,7 @@
 #include "config.librpbase.h"
 #include "TextFuncs.hpp"
 #include "TextFuncs_NULL.hpp"
+#include "TextFuncs_ascii.hpp"
 
 #ifndef _WIN32
 # error TextFuncs_win32.cpp is for Windows only.
@@ -137,6 +138,14 @@ static char *W32U_UTF16_to_mbs(const char16_t *wcs, int cchWcs,
 string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int flags)
 {
 	len = check_NULL_terminator(str, len);
+
+	// Fast path: Pure ASCII text in an ASCII-compatible code page
+	// doesn't need MultiByteToWideChar() at all.
+	string ret_ascii;
+	if (is_ascii_compatible_cp(cp) && ascii_to_utf8(str, len, &ret_ascii)) {
+		return ret_ascii;
+	}
+
 	DWORD dwFlags = 0;
 	if (flags & TEXTCONV_FLAG_CP1252_FALLBACK) {
 		// Fallback is enabled.
@@ -188,6 +197,14 @@ string cpN_to_utf8(unsigned int cp, const char *str, int len, unsigned int flags
 u16string cpN_to_utf16(unsigned int cp, const char *str, int len, unsigned int flags)
 {
 	len = check_NULL_terminator(str, len);
+
+	// Fast path: Pure ASCII text in an ASCII-compatible code page
+	// doesn't need MultiByteToWideChar() at all.
+	u16string ret_ascii;
+	if (is_ascii_compatible_cp(cp) && ascii_to_utf16(str, len, &ret_ascii)) {
+		return ret_ascii;
+	}
+
 	DWORD dwFlags = 0;
 	if (flags & TEXTCONV_FLAG_CP1252_FALLBACK) {
 		// Fallback is enabled.
@@ -271,8 +288,14 @@ string utf16_to_cpN(unsigned int cp, const char16_t *wcs, int len)
 {
 	len = check_NULL_terminator(wcs, len);
 
-	// Convert from UTF-16 to `cp`.
+	// Fast path: Pure ASCII text in an ASCII-compatible code page
+	// doesn't need WideCharToMultiByte() at all.
 	string ret;
+	if (is_ascii_compatible_cp(cp) && utf16_ascii_to_utf8(wcs, len, &ret)) {
+		return ret;
+	}
+
+	// Convert from UTF-16 to `cp`.
 	int cbMbs;
 	char *mbs = W32U_UTF16_to_mbs(wcs, len, cp, &cbMbs);
 	if (mbs && cbMbs > 0) {
@@ -297,6 +320,15 @@ string utf16_to_cpN(unsigned int cp, const char16_t *wcs, int len)
  */
 string utf16le_to_utf8(const char16_t *wcs, int len)
 {
+	len = check_NULL_terminator(wcs, len);
+
+	// Fast path: Pure ASCII text doesn't need
+	// WideCharToMultiByte() at all.
+	string ret;
+	if (utf16le_ascii_to_utf8(wcs, len, &ret)) {
+		return ret;
+	}
+
 	// Wrapper around utf16_to_cpN().
 	return utf16_to_cpN(CP_UTF8, wcs, len);
 }
@@ -315,6 +347,13 @@ string utf16be_to_utf8(const char16_t *wcs, int len)
 		return string();
 	}
 
+	// Fast path: Pure ASCII text doesn't need byteswapping
+	// or WideCharToMultiByte() at all.
+	string ret;
+	if (utf16be_ascii_to_utf8(wcs, check_NULL_terminator(wcs, len), &ret)) {
+		return ret;
+	}
+
 	// NOTE: NULL characters are NOT truncated in the
 	// byteswap function. That's done in the regular
 	// utf16le_to_utf8() function.
@@ -20,6 +20,13 @@
 #include "librpfile/FileSystem.hpp"
 using namespace LibRpFile;
 
+#ifdef __linux__
+// inotify for configuration change detection.
+# include <sys/inotify.h>
+# include <unistd.h>
+# include <climits>
+#endif /* __linux__ */
+
 namespace LibRpBase {
 
 /** ConfReaderPrivate **/
@@ -29,10 +36,91 @@ ConfReaderPrivate::ConfReaderPrivate(const char *filename)
 	, conf_was_found(false)
 	, conf_mtime(0)
 	, conf_last_checked(0)
+#ifdef __linux__
+	, inotify_fd(-1)
+	, inotify_wd(-1)
+#endif /* __linux__ */
 { }
 
 ConfReaderPrivate::~ConfReaderPrivate()
-{ }
+{
+#ifdef __linux__
+	if (inotify_fd >= 0) {
+		::close(inotify_fd);
+	}
+#endif /* __linux__ */
+}
+
+#ifdef __linux__
+/**
+ * Set up the inotify watch on the configuration directory.
+ * Does nothing if the watch is already active.
+ * Must be called with mtxLoad held.
+ */
+void ConfReaderPrivate::setupInotify(void)
+{
+	if (inotify_wd >= 0) {
+		// Watch is already active.
+		return;
+	}
+
+	if (inotify_fd < 0) {
+		inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+		if (inotify_fd < 0) {
+			// Unable to initialize inotify.
+			// load() will fall back to mtime polling.
+			return;
+		}
+	}
+
+	// Watch the configuration directory, not the file itself,
+	// so rename-replace writes (common for editors and the
+	// config UI) are picked up as well.
+	assert(!conf_filename.empty());
+	const size_t slash_pos = conf_filename.rfind(DIR_SEP_CHR);
+	if (slash_pos == std::string::npos) {
+		// No directory separator?
+		return;
+	}
+	const std::string conf_dir = conf_filename.substr(0, slash_pos);
+
+	inotify_wd = inotify_add_watch(inotify_fd, conf_dir.c_str(),
+		IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_CREATE | IN_DELETE);
+	// If this failed, inotify_wd remains -1 and
+	// load() will fall back to mtime polling.
+}
+
+/**
+ * Check the inotify descriptor for changes to the
+ * configuration file. Drains all pending events.
+ * @return True if the configuration file may have changed.
+ */
+bool ConfReaderPrivate::checkInotify(void)
+{
+	bool changed = false;
+
+	uint8_t buf[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+	ssize_t len;
+	while ((len = ::read(inotify_fd, buf, sizeof(buf))) > 0) {
+		for (const uint8_t *p = buf; p < &buf[len]; ) {
+			const struct inotify_event *const event =
+				reinterpret_cast<const struct inotify_event*>(p);
+			if (event->mask & IN_IGNORED) {
+				// Watch was removed. (directory deleted?)
+				// Re-establish it on the next load.
+				inotify_wd = -1;
+				changed = true;
+			} else if (event->len > 0 && !strcmp(event->name, conf_rel_filename)) {
+				// Configuration file was modified.
+				changed = true;
+			}
+			p += sizeof(struct inotify_event) + event->len;
+		}
+	}
+
+	return changed;
+}
+#endif /* __linux__ */
 
 /**
  * Process a configuration line.
@@ -96,14 +184,30 @@ int ConfReader::load(bool force)
 	RP_D(ConfReader);
 
 	if (!force && d->conf_was_found) {
-		// Have we checked the timestamp recently?
-		// TODO: Define the threshold somewhere.
-		const time_t cur_time = time(nullptr);
-		if (llabs(cur_time - d->conf_last_checked) < 2) {
-			// We checked it recently. Assume it's up to date.
-			return 0;
+#ifdef __linux__
+		if (d->inotify_fd >= 0 && d->inotify_wd >= 0) {
+			// Steady state: check the inotify descriptor
+			// instead of polling the mtime. If no events are
+			// pending, the configuration hasn't changed and
+			// no file system access is needed at all.
+			if (!d->checkInotify()) {
+				// No changes reported.
+				return 0;
+			}
+			// A change was reported.
+			// Fall through to the mtime check.
+		} else
+#endif /* __linux__ */
+		{
+			// Have we checked the timestamp recently?
+			// TODO: Define the threshold somewhere.
+			const time_t cur_time = time(nullptr);
+			if (llabs(cur_time - d->conf_last_checked) < 2) {
+				// We checked it recently. Assume it's up to date.
+				return 0;
+			}
+			d->conf_last_checked = cur_time;
 		}
-		d->conf_last_checked = cur_time;
 
 		// Check if the keys.conf timestamp has changed.
 		// Initial check. (fast path)
@@ -203,6 +307,13 @@ int ConfReader::load(bool force)
 
 	// Keys loaded.
 	d->conf_was_found = true;
+
+#ifdef __linux__
+	// Watch the configuration directory so subsequent load()
+	// calls don't have to poll the mtime.
+	d->setupInotify();
+#endif /* __linux__ */
+
 	return 0;
 }
 
@@ -54,7 +54,7 @@ class ConfReader
 		 * @param force If true, force a reload, even if the file hasn't been modified.
 		 * @return 0 on success; negative POSIX error code on error.
 		 */
-		int load(bool force = false);
+		virtual int load(bool force = false);
 
 		/**
 		 * Get the configuration filename.
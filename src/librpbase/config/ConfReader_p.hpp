@@ -50,6 +50,28 @@ class ConfReaderPrivate
 		time_t conf_mtime;
 		time_t conf_last_checked;
 
+#ifdef __linux__
+		// inotify watch on the configuration directory.
+		// Used to skip the mtime polling at steady state:
+		// if no events are pending, the file hasn't changed.
+		int inotify_fd;
+		int inotify_wd;
+
+		/**
+		 * Set up the inotify watch on the configuration directory.
+		 * Does nothing if the watch is already active.
+		 * Must be called with mtxLoad held.
+		 */
+		void setupInotify(void);
+
+		/**
+		 * Check the inotify descriptor for changes to the
+		 * configuration file. Drains all pending events.
+		 * @return True if the configuration file may have changed.
+		 */
+		bool checkInotify(void);
+#endif /* __linux__ */
+
 	public:
 		/**
 		 * Reset the configuration to the default values.
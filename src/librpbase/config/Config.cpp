@@ -82,6 +82,8 @@ class ConfigPrivate : public ConfReaderPrivate
 		bool useIntIconForSmallSizes;
 		bool downloadHighResScans;
 		bool storeFileOriginInfo;
+		bool inProcessDownloadsEnabled;
+		unsigned int cacheSizeLimitMB;
 
 		// DMG title screen mode. [index is ROM type]
 		Config::DMG_TitleScreen_Mode dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_MAX];
@@ -123,6 +125,8 @@ ConfigPrivate::ConfigPrivate()
 	, useIntIconForSmallSizes(true)
 	, downloadHighResScans(true)
 	, storeFileOriginInfo(true)
+	, inProcessDownloadsEnabled(false)
+	, cacheSizeLimitMB(512)
 	/* Overlay icon */
 	, showDangerousPermissionsOverlayIcon(true)
 	/* Enable thumbnailing and metadata on network FS */
@@ -153,6 +157,8 @@ void ConfigPrivate::reset(void)
 	useIntIconForSmallSizes = true;
 	downloadHighResScans = true;
 	storeFileOriginInfo = true;
+	inProcessDownloadsEnabled = false;
+	cacheSizeLimitMB = 512;
 
 	// DMG title screen mode.
 	dmgTSMode[Config::DMG_TitleScreen_Mode::DMG_TS_DMG] = Config::DMG_TitleScreen_Mode::DMG_TS_DMG;
@@ -189,7 +195,18 @@ int ConfigPrivate::processConfigLine(const char *section, const char *name, cons
 
 	// Which section are we in?
 	if (!strcasecmp(section, "Downloads")) {
-		// Downloads. Check for one of the three boolean options.
+		// Downloads.
+		// Check for the cache size limit first. (integer option)
+		if (!strcasecmp(name, "CacheSizeLimitMB")) {
+			char *endptr = nullptr;
+			const unsigned long mb = strtoul(value, &endptr, 10);
+			if (endptr && *endptr == '\0' && mb <= 1048576) {
+				cacheSizeLimitMB = static_cast<unsigned int>(mb);
+			}
+			return 1;
+		}
+
+		// Check for one of the boolean options.
 		bool *param;
 		if (!strcasecmp(name, "ExtImageDownload")) {
 			param = &extImgDownloadEnabled;
@@ -199,6 +216,8 @@ int ConfigPrivate::processConfigLine(const char *section, const char *name, cons
 			param = &downloadHighResScans;
 		} else if (!strcasecmp(name, "StoreFileOriginInfo")) {
 			param = &storeFileOriginInfo;
+		} else if (!strcasecmp(name, "InProcessDownloads")) {
+			param = &inProcessDownloadsEnabled;
 		} else {
 			// Invalid option.
 			return 1;
@@ -555,6 +574,32 @@ bool Config::storeFileOriginInfo(void) const
 	return d->storeFileOriginInfo;
 }
 
+/**
+ * Download images in-process instead of spawning rp-download?
+ * Only effective if built with ENABLE_INPROC_DOWNLOAD;
+ * otherwise, rp-download is always used.
+ * NOTE: Call load() before using this function.
+ * @return True if in-process downloads are enabled; false if not.
+ */
+bool Config::inProcessDownloadsEnabled(void) const
+{
+	RP_D(const Config);
+	return d->inProcessDownloadsEnabled;
+}
+
+/**
+ * Get the download cache size limit, in MiB.
+ * Least recently used files are evicted in the background
+ * when the cache exceeds this limit.
+ * NOTE: Call load() before using this function.
+ * @return Cache size limit, in MiB. (0 == unlimited)
+ */
+unsigned int Config::cacheSizeLimitMB(void) const
+{
+	RP_D(const Config);
+	return d->cacheSizeLimitMB;
+}
+
 /** DMG title screen mode **/
 
 /**
@@ -115,6 +115,24 @@ class Config : public ConfReader
 		 */
 		bool storeFileOriginInfo(void) const;
 
+		/**
+		 * Download images in-process instead of spawning rp-download?
+		 * Only effective if built with ENABLE_INPROC_DOWNLOAD;
+		 * otherwise, rp-download is always used.
+		 * NOTE: Call load() before using this function.
+		 * @return True if in-process downloads are enabled; false if not.
+		 */
+		bool inProcessDownloadsEnabled(void) const;
+
+		/**
+		 * Get the download cache size limit, in MiB.
+		 * Least recently used files are evicted in the background
+		 * when the cache exceeds this limit.
+		 * NOTE: Call load() before using this function.
+		 * @return Cache size limit, in MiB. (0 == unlimited)
+		 */
+		unsigned int cacheSizeLimitMB(void) const;
+
 		/** DMG title screen mode **/
 
 		enum DMG_TitleScreen_Mode : uint8_t {
@@ -0,0 +1,514 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * AesAesni.cpp: AES decryption class using x86 AES-NI instructions.       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "config.librpbase.h"
+
+#include "AesAesni.hpp"
+
+// librpcpu
+#include "librpcpu/cpuflags_x86.h"
+
+// SSE2 and AES-NI intrinsics.
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+// AES block size, in bytes.
+#define AES_BLOCK_SIZE 16
+
+namespace LibRpBase {
+
+/**
+ * SubWord() from FIPS 197, implemented using AESKEYGENASSIST.
+ * With rcon == 0, element 0 of the result is SubWord() of element 1
+ * of the source, so no table lookups are needed for key expansion.
+ * @param w Word to substitute.
+ * @return SubWord(w).
+ */
+static FORCEINLINE uint32_t aesni_subword(uint32_t w)
+{
+	const __m128i tmp = _mm_aeskeygenassist_si128(
+		_mm_set_epi32(0, 0, (int)w, 0), 0);
+	return (uint32_t)_mm_cvtsi128_si32(tmp);
+}
+
+/**
+ * Increment a 16-byte big-endian CTR mode counter.
+ * @param ctr 16-byte counter.
+ */
+static FORCEINLINE void aesni_ctr_increment(uint8_t *RESTRICT ctr)
+{
+	for (int i = AES_BLOCK_SIZE-1; i >= 0; i--) {
+		if (++ctr[i] != 0)
+			break;
+	}
+}
+
+class AesAesniPrivate
+{
+	public:
+		AesAesniPrivate();
+		~AesAesniPrivate() { }
+
+	private:
+		RP_DISABLE_COPY(AesAesniPrivate)
+
+	public:
+		// Expanded round keys. (Nr+1 round keys; Nr == 14 maximum)
+		// NOTE: Stored as byte arrays instead of __m128i because
+		// operator new doesn't guarantee 16-byte alignment for the
+		// private class. The block functions use unaligned loads,
+		// which the compiler hoists out of the inner loops.
+		uint8_t key_enc[15*AES_BLOCK_SIZE];
+		uint8_t key_dec[15*AES_BLOCK_SIZE];
+		int Nr;		// Number of rounds. (10, 12, 14; 0 if no key is set)
+
+		// CBC: Initialization vector.
+		// CTR: Counter.
+		uint8_t iv[AES_BLOCK_SIZE];
+
+		IAesCipher::ChainingMode chainingMode;
+
+	public:
+		/**
+		 * Expand the AES key schedules.
+		 * @param pKey	[in] Key data.
+		 * @param size	[in] Size of pKey, in bytes. (Must be 16, 24, or 32.)
+		 */
+		void expandKey(const uint8_t *RESTRICT pKey, size_t size);
+
+		/**
+		 * Encrypt a single block. (Used for CTR mode.)
+		 * @param block Input block.
+		 * @return Encrypted block.
+		 */
+		FORCEINLINE __m128i encryptBlock(__m128i block) const;
+
+		/**
+		 * Decrypt a single block. (ECB; no chaining.)
+		 * @param block Input block.
+		 * @return Decrypted block.
+		 */
+		FORCEINLINE __m128i decryptBlock(__m128i block) const;
+
+		/**
+		 * Decrypt a buffer in ECB mode.
+		 * @param pData	[in/out] Data block.
+		 * @param size	[in] Length of data block. (Must be a multiple of 16.)
+		 */
+		void decryptECB(uint8_t *RESTRICT pData, size_t size) const;
+
+		/**
+		 * Decrypt a buffer in CBC mode.
+		 * The IV is updated for the next call.
+		 * @param pData	[in/out] Data block.
+		 * @param size	[in] Length of data block. (Must be a multiple of 16.)
+		 */
+		void decryptCBC(uint8_t *RESTRICT pData, size_t size);
+
+		/**
+		 * Encrypt/decrypt a buffer in CTR mode.
+		 * The counter is updated for the next call.
+		 * @param pData	[in/out] Data block.
+		 * @param size	[in] Length of data block. (Must be a multiple of 16.)
+		 */
+		void cryptCTR(uint8_t *RESTRICT pData, size_t size);
+};
+
+/** AesAesniPrivate **/
+
+AesAesniPrivate::AesAesniPrivate()
+	: Nr(0)
+	, chainingMode(IAesCipher::CM_ECB)
+{
+	// Clear the key schedules and IV.
+	memset(key_enc, 0, sizeof(key_enc));
+	memset(key_dec, 0, sizeof(key_dec));
+	memset(iv, 0, sizeof(iv));
+}
+
+/**
+ * Expand the AES key schedules.
+ * @param pKey	[in] Key data.
+ * @param size	[in] Size of pKey, in bytes. (Must be 16, 24, or 32.)
+ */
+void AesAesniPrivate::expandKey(const uint8_t *RESTRICT pKey, size_t size)
+{
+	// Round constants for key expansion.
+	static const uint8_t rcon[10] = {
+		0x01, 0x02, 0x04, 0x08, 0x10,
+		0x20, 0x40, 0x80, 0x1B, 0x36
+	};
+
+	const int Nk = (int)(size / 4);
+	Nr = Nk + 6;
+
+	// Encryption key schedule. (FIPS 197, section 5.2)
+	// Words are kept in memory byte order, so on x86,
+	// RotWord() is a rotate right by 8 and the rcon byte
+	// is XORed into the low byte.
+	uint32_t w[4*15];
+	memcpy(w, pKey, size);
+	for (int i = Nk; i < 4*(Nr+1); i++) {
+		uint32_t temp = w[i-1];
+		if (i % Nk == 0) {
+			temp = aesni_subword((temp >> 8) | (temp << 24)) ^ rcon[(i / Nk) - 1];
+		} else if (Nk > 6 && (i % Nk) == 4) {
+			// AES-256 has an extra SubWord() step.
+			temp = aesni_subword(temp);
+		}
+		w[i] = w[i-Nk] ^ temp;
+	}
+	memcpy(key_enc, w, AES_BLOCK_SIZE * (Nr+1));
+
+	// Decryption key schedule for the AES-NI "Equivalent Inverse
+	// Cipher": first and last round keys are swapped, and the
+	// middle round keys get an InvMixColumns() transformation.
+	_mm_storeu_si128((__m128i*)&key_dec[0],
+		_mm_loadu_si128((const __m128i*)&key_enc[AES_BLOCK_SIZE * Nr]));
+	for (int i = 1; i < Nr; i++) {
+		_mm_storeu_si128((__m128i*)&key_dec[AES_BLOCK_SIZE * i],
+			_mm_aesimc_si128(_mm_loadu_si128((const __m128i*)&key_enc[AES_BLOCK_SIZE * (Nr-i)])));
+	}
+	_mm_storeu_si128((__m128i*)&key_dec[AES_BLOCK_SIZE * Nr],
+		_mm_loadu_si128((const __m128i*)&key_enc[0]));
+}
+
+/**
+ * Encrypt a single block. (Used for CTR mode.)
+ * @param block Input block.
+ * @return Encrypted block.
+ */
+FORCEINLINE __m128i AesAesniPrivate::encryptBlock(__m128i block) const
+{
+	block = _mm_xor_si128(block, _mm_loadu_si128((const __m128i*)&key_enc[0]));
+	for (int i = 1; i < Nr; i++) {
+		block = _mm_aesenc_si128(block, _mm_loadu_si128((const __m128i*)&key_enc[AES_BLOCK_SIZE * i]));
+	}
+	return _mm_aesenclast_si128(block, _mm_loadu_si128((const __m128i*)&key_enc[AES_BLOCK_SIZE * Nr]));
+}
+
+/**
+ * Decrypt a single block. (ECB; no chaining.)
+ * @param block Input block.
+ * @return Decrypted block.
+ */
+FORCEINLINE __m128i AesAesniPrivate::decryptBlock(__m128i block) const
+{
+	block = _mm_xor_si128(block, _mm_loadu_si128((const __m128i*)&key_dec[0]));
+	for (int i = 1; i < Nr; i++) {
+		block = _mm_aesdec_si128(block, _mm_loadu_si128((const __m128i*)&key_dec[AES_BLOCK_SIZE * i]));
+	}
+	return _mm_aesdeclast_si128(block, _mm_loadu_si128((const __m128i*)&key_dec[AES_BLOCK_SIZE * Nr]));
+}
+
+/**
+ * Decrypt a buffer in ECB mode.
+ * @param pData	[in/out] Data block.
+ * @param size	[in] Length of data block. (Must be a multiple of 16.)
+ */
+void AesAesniPrivate::decryptECB(uint8_t *RESTRICT pData, size_t size) const
+{
+	// Process four blocks at a time to keep the AES units busy.
+	// (AESDEC has multi-cycle latency but single-cycle throughput.)
+	for (; size >= 4*AES_BLOCK_SIZE; size -= 4*AES_BLOCK_SIZE, pData += 4*AES_BLOCK_SIZE) {
+		const __m128i rk0 = _mm_loadu_si128((const __m128i*)&key_dec[0]);
+		__m128i b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)&pData[ 0]), rk0);
+		__m128i b1 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)&pData[16]), rk0);
+		__m128i b2 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)&pData[32]), rk0);
+		__m128i b3 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)&pData[48]), rk0);
+		for (int i = 1; i < Nr; i++) {
+			const __m128i rk = _mm_loadu_si128((const __m128i*)&key_dec[AES_BLOCK_SIZE * i]);
+			b0 = _mm_aesdec_si128(b0, rk);
+			b1 = _mm_aesdec_si128(b1, rk);
+			b2 = _mm_aesdec_si128(b2, rk);
+			b3 = _mm_aesdec_si128(b3, rk);
+		}
+		const __m128i rkN = _mm_loadu_si128((const __m128i*)&key_dec[AES_BLOCK_SIZE * Nr]);
+		_mm_storeu_si128((__m128i*)&pData[ 0], _mm_aesdeclast_si128(b0, rkN));
+		_mm_storeu_si128((__m128i*)&pData[16], _mm_aesdeclast_si128(b1, rkN));
+		_mm_storeu_si128((__m128i*)&pData[32], _mm_aesdeclast_si128(b2, rkN));
+		_mm_storeu_si128((__m128i*)&pData[48], _mm_aesdeclast_si128(b3, rkN));
+	}
+
+	// Remaining blocks.
+	for (; size > 0; size -= AES_BLOCK_SIZE, pData += AES_BLOCK_SIZE) {
+		_mm_storeu_si128((__m128i*)pData,
+			decryptBlock(_mm_loadu_si128((const __m128i*)pData)));
+	}
+}
+
+/**
+ * Decrypt a buffer in CBC mode.
+ * The IV is updated for the next call.
+ * @param pData	[in/out] Data block.
+ * @param size	[in] Length of data block. (Must be a multiple of 16.)
+ */
+void AesAesniPrivate::decryptCBC(uint8_t *RESTRICT pData, size_t size)
+{
+	__m128i prev = _mm_loadu_si128((const __m128i*)iv);
+
+	// CBC decryption parallelizes: each block is decrypted
+	// independently, then XORed with the previous ciphertext.
+	for (; size >= 4*AES_BLOCK_SIZE; size -= 4*AES_BLOCK_SIZE, pData += 4*AES_BLOCK_SIZE) {
+		const __m128i c0 = _mm_loadu_si128((const __m128i*)&pData[ 0]);
+		const __m128i c1 = _mm_loadu_si128((const __m128i*)&pData[16]);
+		const __m128i c2 = _mm_loadu_si128((const __m128i*)&pData[32]);
+		const __m128i c3 = _mm_loadu_si128((const __m128i*)&pData[48]);
+
+		const __m128i rk0 = _mm_loadu_si128((const __m128i*)&key_dec[0]);
+		__m128i b0 = _mm_xor_si128(c0, rk0);
+		__m128i b1 = _mm_xor_si128(c1, rk0);
+		__m128i b2 = _mm_xor_si128(c2, rk0);
+		__m128i b3 = _mm_xor_si128(c3, rk0);
+		for (int i = 1; i < Nr; i++) {
+			const __m128i rk = _mm_loadu_si128((const __m128i*)&key_dec[AES_BLOCK_SIZE * i]);
+			b0 = _mm_aesdec_si128(b0, rk);
+			b1 = _mm_aesdec_si128(b1, rk);
+			b2 = _mm_aesdec_si128(b2, rk);
+			b3 = _mm_aesdec_si128(b3, rk);
+		}
+		const __m128i rkN = _mm_loadu_si128((const __m128i*)&key_dec[AES_BLOCK_SIZE * Nr]);
+		_mm_storeu_si128((__m128i*)&pData[ 0], _mm_xor_si128(_mm_aesdeclast_si128(b0, rkN), prev));
+		_mm_storeu_si128((__m128i*)&pData[16], _mm_xor_si128(_mm_aesdeclast_si128(b1, rkN), c0));
+		_mm_storeu_si128((__m128i*)&pData[32], _mm_xor_si128(_mm_aesdeclast_si128(b2, rkN), c1));
+		_mm_storeu_si128((__m128i*)&pData[48], _mm_xor_si128(_mm_aesdeclast_si128(b3, rkN), c2));
+		prev = c3;
+	}
+
+	// Remaining blocks.
+	for (; size > 0; size -= AES_BLOCK_SIZE, pData += AES_BLOCK_SIZE) {
+		const __m128i c = _mm_loadu_si128((const __m128i*)pData);
+		_mm_storeu_si128((__m128i*)pData,
+			_mm_xor_si128(decryptBlock(c), prev));
+		prev = c;
+	}
+
+	// Update the IV for the next call.
+	_mm_storeu_si128((__m128i*)iv, prev);
+}
+
+/**
+ * Encrypt/decrypt a buffer in CTR mode.
+ * The counter is updated for the next call.
+ * @param pData	[in/out] Data block.
+ * @param size	[in] Length of data block. (Must be a multiple of 16.)
+ */
+void AesAesniPrivate::cryptCTR(uint8_t *RESTRICT pData, size_t size)
+{
+	// Counters for the next four blocks.
+	uint8_t ctr[4][AES_BLOCK_SIZE];
+
+	// Process four blocks at a time to keep the AES units busy.
+	for (; size >= 4*AES_BLOCK_SIZE; size -= 4*AES_BLOCK_SIZE, pData += 4*AES_BLOCK_SIZE) {
+		for (unsigned int j = 0; j < 4; j++) {
+			memcpy(ctr[j], iv, AES_BLOCK_SIZE);
+			aesni_ctr_increment(iv);
+		}
+
+		const __m128i rk0 = _mm_loadu_si128((const __m128i*)&key_enc[0]);
+		__m128i b0 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)ctr[0]), rk0);
+		__m128i b1 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)ctr[1]), rk0);
+		__m128i b2 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)ctr[2]), rk0);
+		__m128i b3 = _mm_xor_si128(_mm_loadu_si128((const __m128i*)ctr[3]), rk0);
+		for (int i = 1; i < Nr; i++) {
+			const __m128i rk = _mm_loadu_si128((const __m128i*)&key_enc[AES_BLOCK_SIZE * i]);
+			b0 = _mm_aesenc_si128(b0, rk);
+			b1 = _mm_aesenc_si128(b1, rk);
+			b2 = _mm_aesenc_si128(b2, rk);
+			b3 = _mm_aesenc_si128(b3, rk);
+		}
+		const __m128i rkN = _mm_loadu_si128((const __m128i*)&key_enc[AES_BLOCK_SIZE * Nr]);
+		_mm_storeu_si128((__m128i*)&pData[ 0], _mm_xor_si128(
+			_mm_loadu_si128((const __m128i*)&pData[ 0]), _mm_aesenclast_si128(b0, rkN)));
+		_mm_storeu_si128((__m128i*)&pData[16], _mm_xor_si128(
+			_mm_loadu_si128((const __m128i*)&pData[16]), _mm_aesenclast_si128(b1, rkN)));
+		_mm_storeu_si128((__m128i*)&pData[32], _mm_xor_si128(
+			_mm_loadu_si128((const __m128i*)&pData[32]), _mm_aesenclast_si128(b2, rkN)));
+		_mm_storeu_si128((__m128i*)&pData[48], _mm_xor_si128(
+			_mm_loadu_si128((const __m128i*)&pData[48]), _mm_aesenclast_si128(b3, rkN)));
+	}
+
+	// Remaining blocks.
+	for (; size > 0; size -= AES_BLOCK_SIZE, pData += AES_BLOCK_SIZE) {
+		const __m128i keystream = encryptBlock(_mm_loadu_si128((const __m128i*)iv));
+		aesni_ctr_increment(iv);
+		_mm_storeu_si128((__m128i*)pData, _mm_xor_si128(
+			_mm_loadu_si128((const __m128i*)pData), keystream));
+	}
+}
+
+/** AesAesni **/
+
+AesAesni::AesAesni()
+	: d_ptr(new AesAesniPrivate())
+{ }
+
+AesAesni::~AesAesni()
+{
+	delete d_ptr;
+}
+
+/**
+ * Get the name of the AesCipher implementation.
+ * @return Name.
+ */
+const char *AesAesni::name(void) const
+{
+	return "AES-NI";
+}
+
+/**
+ * Has the cipher been initialized properly?
+ * @return True if initialized; false if not.
+ */
+bool AesAesni::isInit(void) const
+{
+	// Make sure the CPU actually supports AES-NI.
+	// (AesCipherFactory checks this before creating the
+	// object, but verify anyway.)
+	return (RP_CPU_HasAESNI() != 0);
+}
+
+/**
+ * Set the encryption key.
+ * @param pKey	[in] Key data.
+ * @param size	[in] Size of pKey, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AesAesni::setKey(const uint8_t *RESTRICT pKey, size_t size)
+{
+	// Acceptable key lengths:
+	// - 16 (AES-128)
+	// - 24 (AES-192)
+	// - 32 (AES-256)
+	if (!pKey || !(size == 16 || size == 24 || size == 32)) {
+		return -EINVAL;
+	}
+
+	// Expand both key schedules now.
+	// Unlike the library-based implementations, this doesn't
+	// need to be deferred until the chaining mode is known.
+	RP_D(AesAesni);
+	d->expandKey(pKey, size);
+	return 0;
+}
+
+/**
+ * Set the cipher chaining mode.
+ *
+ * Note that the IV/counter must be set *after* setting
+ * the chaining mode; otherwise, setIV() will fail.
+ *
+ * @param mode Cipher chaining mode.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AesAesni::setChainingMode(ChainingMode mode)
+{
+	if (mode < CM_ECB || mode > CM_CTR) {
+		return -EINVAL;
+	}
+
+	RP_D(AesAesni);
+	d->chainingMode = mode;
+	return 0;
+}
+
+/**
+ * Set the IV (CBC mode) or counter (CTR mode).
+ * @param pIV	[in] IV/counter data.
+ * @param size	[in] Size of pIV, in bytes.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int AesAesni::setIV(const uint8_t *RESTRICT pIV, size_t size)
+{
+	RP_D(AesAesni);
+	if (!pIV || size != AES_BLOCK_SIZE ||
+	    d->chainingMode < CM_CBC || d->chainingMode > CM_CTR)
+	{
+		// Invalid parameters and/or chaining mode.
+		return -EINVAL;
+	}
+
+	// Set the IV/counter.
+	memcpy(d->iv, pIV, AES_BLOCK_SIZE);
+	return 0;
+}
+
+/**
+ * Decrypt a block of data.
+ * @param pData	[in/out] Data block.
+ * @param size	[in] Length of data block. (Must be a multiple of 16.)
+ * @return Number of bytes decrypted on success; 0 on error.
+ */
+size_t AesAesni::decrypt(uint8_t *RESTRICT pData, size_t size)
+{
+	if (!pData || size == 0 || (size % AES_BLOCK_SIZE != 0)) {
+		// Invalid parameters.
+		return 0;
+	}
+
+	// Decrypt the data.
+	RP_D(AesAesni);
+	if (d->Nr == 0) {
+		// No key has been set.
+		return 0;
+	}
+
+	switch (d->chainingMode) {
+		case CM_ECB:
+			d->decryptECB(pData, size);
+			break;
+
+		case CM_CBC:
+			// IV is automatically updated for the next block.
+			d->decryptCBC(pData, size);
+			break;
+
+		case CM_CTR:
+			// ctr is automatically updated for the next block.
+			d->cryptCTR(pData, size);
+			break;
+
+		default:
+			return 0;
+	}
+
+	return size;
+}
+
+/**
+ * Decrypt a multi-block buffer using CTR mode with an
+ * explicit counter base.
+ * @param pData	[in/out] Data block.
+ * @param size	[in] Length of data block. (Must be a multiple of 16.)
+ * @param pCtr	[in] 16-byte counter for the first block.
+ * @return Number of bytes decrypted on success; 0 on error.
+ */
+size_t AesAesni::decryptCTR(uint8_t *RESTRICT pData, size_t size,
+	const uint8_t *RESTRICT pCtr)
+{
+	RP_D(AesAesni);
+	if (!pData || !pCtr || size == 0 || (size % AES_BLOCK_SIZE != 0) ||
+	    d->chainingMode != CM_CTR)
+	{
+		// Invalid parameters and/or chaining mode.
+		return 0;
+	}
+	if (d->Nr == 0) {
+		// No key has been set.
+		return 0;
+	}
+
+	// Set the counter and decrypt the entire buffer in one call.
+	memcpy(d->iv, pCtr, AES_BLOCK_SIZE);
+	d->cryptCTR(pData, size);
+	return size;
+}
+
+}
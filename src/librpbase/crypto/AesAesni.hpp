@@ -0,0 +1,95 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * AesAesni.hpp: AES decryption class using x86 AES-NI instructions.       *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_CRYPTO_AESAESNI_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_CRYPTO_AESAESNI_HPP__
+
+#include "IAesCipher.hpp"
+
+namespace LibRpBase {
+
+class AesAesniPrivate;
+class AesAesni : public IAesCipher
+{
+	public:
+		AesAesni();
+		virtual ~AesAesni();
+
+	private:
+		typedef IAesCipher super;
+		RP_DISABLE_COPY(AesAesni)
+	private:
+		friend class AesAesniPrivate;
+		AesAesniPrivate *const d_ptr;
+
+	public:
+		/**
+		 * Get the name of the AesCipher implementation.
+		 * @return Name.
+		 */
+		const char *name(void) const final;
+
+		/**
+		 * Has the cipher been initialized properly?
+		 * @return True if initialized; false if not.
+		 */
+		bool isInit(void) const final;
+
+		/**
+		 * Set the encryption key.
+		 * @param pKey	[in] Key data.
+		 * @param size	[in] Size of pKey, in bytes.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int setKey(const uint8_t *RESTRICT pKey, size_t size) final;
+
+		/**
+		 * Set the cipher chaining mode.
+		 *
+		 * Note that the IV/counter must be set *after* setting
+		 * the chaining mode; otherwise, setIV() will fail.
+		 *
+		 * @param mode Cipher chaining mode.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int setChainingMode(ChainingMode mode) final;
+
+		/**
+		 * Set the IV (CBC mode) or counter (CTR mode).
+		 * @param pIV	[in] IV/counter data.
+		 * @param size	[in] Size of pIV, in bytes.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int setIV(const uint8_t *RESTRICT pIV, size_t size) final;
+
+		/**
+		 * Decrypt a block of data.
+		 * Key and IV/counter must be set before calling this function.
+		 *
+		 * @param pData	[in/out] Data block.
+		 * @param size	[in] Length of data block. (Must be a multiple of 16.)
+		 * @return Number of bytes decrypted on success; 0 on error.
+		 */
+		size_t decrypt(uint8_t *RESTRICT pData, size_t size) final;
+
+		/**
+		 * Decrypt a multi-block buffer using CTR mode with an
+		 * explicit counter base.
+		 *
+		 * @param pData	[in/out] Data block.
+		 * @param size	[in] Length of data block. (Must be a multiple of 16.)
+		 * @param pCtr	[in] 16-byte counter for the first block.
+		 * @return Number of bytes decrypted on success; 0 on error.
+		 */
+		size_t decryptCTR(uint8_t *RESTRICT pData, size_t size,
+			const uint8_t *RESTRICT pCtr) final;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_CRYPTO_AESAESNI_HPP__ */
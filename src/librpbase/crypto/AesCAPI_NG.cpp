@@ -526,7 +526,7 @@ size_t AesCAPI_NG::decrypt(uint8_t *RESTRICT pData, size_t size)
 
 		case CM_CTR: {
 			// CTR isn't supported by CryptoAPI-NG directly.
-			// Need to decrypt each block manually.
+			// Need to encrypt the counters and XOR manually.
 
 			// Using a union to allow 64-bit XORs
 			// for improved performance.
@@ -536,19 +536,41 @@ size_t AesCAPI_NG::decrypt(uint8_t *RESTRICT pData, size_t size)
 				uint64_t u64[2];
 			};
 
+			// Encrypt up to 64 counters (1 KB) per BCryptEncrypt()
+			// call so the cipher can pipeline across blocks instead
+			// of paying the call overhead per 16-byte block.
+			static const unsigned int CTR_BATCH_LEN = 64;
+			ctr_block ctr_crypt[CTR_BATCH_LEN];
+
 			// TODO: Verify data alignment.
-			ctr_block ctr_crypt;
 			ctr_block *ctr_data = reinterpret_cast<ctr_block*>(pData);
 			ULONG cbTmpResult;
 			cbResult = 0;
-			for (; size > 0; size -= 16, ctr_data++) {
-				// Encrypt the current counter.
-				memcpy(ctr_crypt.u8, d->iv, sizeof(ctr_crypt.u8));
+			while (size > 0) {
+				const unsigned int batch_len =
+					(size >= sizeof(ctr_crypt)
+						? CTR_BATCH_LEN
+						: static_cast<unsigned int>(size / 16));
+
+				// Generate the counters for this batch.
+				for (unsigned int i = 0; i < batch_len; i++) {
+					memcpy(ctr_crypt[i].u8, d->iv, sizeof(ctr_crypt[i].u8));
+
+					// Increment the counter.
+					for (int j = 15; j >= 0; j--) {
+						if (++d->iv[j] != 0) {
+							// No carry needed.
+							break;
+						}
+					}
+				}
+
+				// Encrypt the counters in a single call. (ECB mode)
 				status = d->pBCryptEncrypt(d->hKey,
-						ctr_crypt.u8, sizeof(ctr_crypt.u8),
+						ctr_crypt[0].u8, static_cast<ULONG>(batch_len * 16),
 						nullptr,
 						nullptr, 0,
-						ctr_crypt.u8, sizeof(ctr_crypt.u8),
+						ctr_crypt[0].u8, static_cast<ULONG>(batch_len * 16),
 						&cbTmpResult, 0);
 				if (!NT_SUCCESS(status)) {
 					// Encryption failed.
@@ -557,16 +579,12 @@ size_t AesCAPI_NG::decrypt(uint8_t *RESTRICT pData, size_t size)
 				cbResult += cbTmpResult;
 
 				// XOR with the ciphertext.
-				ctr_data->u64[0] ^= ctr_crypt.u64[0];
-				ctr_data->u64[1] ^= ctr_crypt.u64[1];
-
-				// Increment the counter.
-				for (int i = 15; i >= 0; i--) {
-					if (++d->iv[i] != 0) {
-						// No carry needed.
-						break;
-					}
+				for (unsigned int i = 0; i < batch_len; i++, ctr_data++) {
+					ctr_data->u64[0] ^= ctr_crypt[i].u64[0];
+					ctr_data->u64[1] ^= ctr_crypt[i].u64[1];
 				}
+
+				size -= (batch_len * 16);
 			}
 			break;
 		}
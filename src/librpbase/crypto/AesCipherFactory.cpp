@@ -19,45 +19,224 @@
 # include "AesNettle.hpp"
 #endif
 
+// AES-NI implementation. (x86/amd64 only; requires a runtime CPU check)
+#include "librpcpu/cpu_dispatch.h"
+#if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
+# include "librpcpu/cpuflags_x86.h"
+# include "AesAesni.hpp"
+# define AESCIPHERFACTORY_HAS_AESNI 1
+#endif
+
+// One-time initialization.
+#include "librpthreads/pthread_once.h"
+
+// C++ STL classes.
+#include <chrono>
+using std::unique_ptr;
+
 namespace LibRpBase {
 
+class AesCipherFactoryPrivate
+{
+	private:
+		// Static class.
+		AesCipherFactoryPrivate();
+		~AesCipherFactoryPrivate();
+		RP_DISABLE_COPY(AesCipherFactoryPrivate)
+
+	public:
+		// Available implementations.
+		// Multiple implementations may be usable on the same system,
+		// and their relative speed depends on the CPU and the system
+		// crypto libraries, so the fastest one is determined at
+		// runtime by benchmarkCiphers().
+		enum Implementation {
+			IMPL_UNKNOWN = -1,
+
+#ifdef AESCIPHERFACTORY_HAS_AESNI
+			IMPL_AESNI,
+#endif /* AESCIPHERFACTORY_HAS_AESNI */
+#if defined(_WIN32)
+			IMPL_CAPI_NG,
+			IMPL_CAPI,
+#elif defined(HAVE_NETTLE)
+			IMPL_NETTLE,
+#endif
+
+			IMPL_MAX
+		};
+
+		/**
+		 * Create a specific IAesCipher implementation.
+		 * @param impl Implementation.
+		 * @return IAesCipher class, or nullptr if it isn't usable.
+		 */
+		static IAesCipher *createImpl(Implementation impl);
+
+		/**
+		 * Benchmark the available implementations and cache the fastest one.
+		 * Called by pthread_once().
+		 */
+		static void benchmarkCiphers(void);
+
+		// Fastest implementation, as determined by benchmarkCiphers().
+		static Implementation fastest_impl;
+
+		// pthread_once() control variable.
+		static pthread_once_t once_control;
+};
+
+/** AesCipherFactoryPrivate **/
+
+AesCipherFactoryPrivate::Implementation AesCipherFactoryPrivate::fastest_impl = AesCipherFactoryPrivate::IMPL_UNKNOWN;
+
+// pthread_once() control variable.
+pthread_once_t AesCipherFactoryPrivate::once_control = PTHREAD_ONCE_INIT;
+
+/**
+ * Create a specific IAesCipher implementation.
+ * @param impl Implementation.
+ * @return IAesCipher class, or nullptr if it isn't usable.
+ */
+IAesCipher *AesCipherFactoryPrivate::createImpl(Implementation impl)
+{
+	IAesCipher *cipher = nullptr;
+	switch (impl) {
+#ifdef AESCIPHERFACTORY_HAS_AESNI
+		case IMPL_AESNI:
+			if (RP_CPU_HasAESNI()) {
+				cipher = new AesAesni();
+			}
+			break;
+#endif /* AESCIPHERFACTORY_HAS_AESNI */
+
+#if defined(_WIN32)
+		case IMPL_CAPI_NG:
+			// NOTE: Wine (as of 2.5) has CryptoAPI NG, but it
+			// doesn't actually implement any encryption algorithms,
+			// so we can't use it. We'll need to verify that AES
+			// is initialized before returning the AesCAPI_NG object.
+			// Wine's CryptoAPI implementation *does* support AES.
+			if (AesCAPI_NG::isUsable()) {
+				cipher = new AesCAPI_NG();
+			}
+			break;
+
+		case IMPL_CAPI:
+			cipher = new AesCAPI();
+			break;
+#elif defined(HAVE_NETTLE)
+		case IMPL_NETTLE:
+			cipher = new AesNettle();
+			break;
+#endif
+
+		default:
+			break;
+	}
+
+	if (cipher && !cipher->isInit()) {
+		// Cipher failed to initialize.
+		delete cipher;
+		cipher = nullptr;
+	}
+	return cipher;
+}
+
+/**
+ * Benchmark the available implementations and cache the fastest one.
+ * Called by pthread_once().
+ */
+void AesCipherFactoryPrivate::benchmarkCiphers(void)
+{
+	// Benchmark key and IV.
+	// Same values as AesCipherTest; the actual contents don't
+	// matter for timing purposes.
+	static const uint8_t bench_key[16] = {
+		0x01,0x23,0x45,0x67,0x89,0xAB,0xCD,0xEF,
+		0xFE,0xDC,0xBA,0x98,0x76,0x54,0x32,0x10
+	};
+	static const uint8_t bench_iv[16] = {
+		0xD9,0x83,0xC2,0xA0,0x1C,0xFA,0x8B,0x88,
+		0x3A,0xE3,0xA4,0xBD,0x70,0x1F,0xC1,0x0B
+	};
+
+	// Benchmark buffer: 32 KB, which matches the transfer size
+	// used by the encrypted disc readers, e.g. WiiPartition.
+	static const size_t BENCH_SIZE = 32*1024;
+	unique_ptr<uint8_t[]> buf(new uint8_t[BENCH_SIZE]);
+	memset(buf.get(), 0x5A, BENCH_SIZE);
+
+	int64_t best_time = 0;
+	for (int i = 0; i < IMPL_MAX; i++) {
+		const Implementation impl = static_cast<Implementation>(i);
+		IAesCipher *const cipher = createImpl(impl);
+		if (!cipher) {
+			// This implementation isn't usable.
+			continue;
+		}
+
+		// Set up CBC decryption, as used by WiiPartition.
+		int ret = cipher->setKey(bench_key, sizeof(bench_key));
+		if (ret == 0) {
+			ret = cipher->setChainingMode(IAesCipher::CM_CBC);
+		}
+		if (ret != 0) {
+			delete cipher;
+			continue;
+		}
+
+		// Decrypt the buffer a few times and take the total.
+		// A single pass is short enough that timer granularity
+		// could pick the wrong winner.
+		const auto t_start = std::chrono::steady_clock::now();
+		size_t sz = BENCH_SIZE;
+		for (unsigned int pass = 4; pass > 0 && sz == BENCH_SIZE; pass--) {
+			sz = cipher->decrypt(buf.get(), BENCH_SIZE,
+				bench_iv, sizeof(bench_iv));
+		}
+		const auto t_end = std::chrono::steady_clock::now();
+		delete cipher;
+
+		if (sz != BENCH_SIZE) {
+			// Decryption failed.
+			continue;
+		}
+
+		const int64_t t_total = std::chrono::duration_cast<std::chrono::nanoseconds>(t_end - t_start).count();
+		if (fastest_impl == IMPL_UNKNOWN || t_total < best_time) {
+			fastest_impl = impl;
+			best_time = t_total;
+		}
+	}
+}
+
+/** AesCipherFactory **/
+
 /**
  * Create an IAesCipher class.
  *
  * The implementation is chosen depending on the system
- * environment. The caller doesn't need to know what
- * the underlying implementation is.
+ * environment. If multiple implementations are usable,
+ * a one-time benchmark is run and the fastest one is
+ * used for the remainder of the process.
  *
  * @return IAesCipher class, or nullptr if decryption isn't supported
  */
 IAesCipher *AesCipherFactory::create(void)
 {
-#if defined(_WIN32)
-	// Windows: Use CryptoAPI NG if available.
-	// If not, fall back to CryptoAPI.
-	if (AesCAPI_NG::isUsable()) {
-		// CryptoAPI NG is available.
-		// NOTE: Wine (as of 2.5) has CryptoAPI NG, but it
-		// doesn't actually implement any encryption algorithms,
-		// so we can't use it. We'll need to verify that AES
-		// is initialized before returning the AesCAPI_NG object.
-		// Wine's CryptoAPI implementation *does* support AES.
-		IAesCipher *cipher = new AesCAPI_NG();
-		if (cipher->isInit()) {
+	// Benchmark the implementations. (Only done once.)
+	pthread_once(&AesCipherFactoryPrivate::once_control,
+		AesCipherFactoryPrivate::benchmarkCiphers);
+
+	if (AesCipherFactoryPrivate::fastest_impl != AesCipherFactoryPrivate::IMPL_UNKNOWN) {
+		IAesCipher *const cipher = AesCipherFactoryPrivate::createImpl(
+			AesCipherFactoryPrivate::fastest_impl);
+		if (cipher) {
 			return cipher;
 		}
-		// AES isn't working in bcrypt.
-		delete cipher;
 	}
 
-	// CryptoAPI NG is not available.
-	// Fall back to CryptoAPI.
-	return new AesCAPI();
-#elif defined(HAVE_NETTLE)
-	// Other: Use nettle.
-	return new AesNettle();
-#endif
-
 	// Decryption is not supported.
 	return nullptr;
 }
@@ -307,4 +307,52 @@ size_t AesNettle::decrypt(uint8_t *RESTRICT pData, size_t size)
 	return size;
 }
 
+/**
+ * Decrypt a multi-block buffer using CTR mode with an
+ * explicit counter base.
+ * @param pData	[in/out] Data block.
+ * @param size	[in] Length of data block. (Must be a multiple of 16.)
+ * @param pCtr	[in] 16-byte counter for the first block.
+ * @return Number of bytes decrypted on success; 0 on error.
+ */
+size_t AesNettle::decryptCTR(uint8_t *RESTRICT pData, size_t size,
+	const uint8_t *RESTRICT pCtr)
+{
+	RP_D(AesNettle);
+	if (!pData || !pCtr || size == 0 || (size % AES_BLOCK_SIZE != 0) ||
+	    d->chainingMode != CM_CTR)
+	{
+		// Invalid parameters and/or chaining mode.
+		return 0;
+	}
+
+	// Set the counter and decrypt the entire buffer in one call.
+	// ctr_crypt() pipelines the cipher across all of the blocks.
+	// NOTE: ctr uses the *encrypt* function, even for decryption.
+	memcpy(d->iv, pCtr, AES_BLOCK_SIZE);
+
+#ifdef HAVE_NETTLE_3
+	if (!d->encrypt_fn) {
+		// No encryption function set...
+		return 0;
+	}
+
+	if (d->key_changed) {
+		d->setkey_enc_fn(&d->ctx, d->key);
+		d->key_changed = false;
+	}
+	ctr_crypt(&d->ctx, d->encrypt_fn, AES_BLOCK_SIZE,
+		  d->iv, size, pData, pData);
+#else /* !HAVE_NETTLE_3 */
+	if (d->key_changed) {
+		aes_set_encrypt_key(&d->ctx, d->key_len, d->key);
+		d->key_changed = false;
+	}
+	ctr_crypt(&d->ctx, (nettle_crypt_func*)aes_encrypt, AES_BLOCK_SIZE,
+		  d->iv, size, pData, pData);
+#endif /* HAVE_NETTLE_3 */
+
+	return size;
+}
+
 }
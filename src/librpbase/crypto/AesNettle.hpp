@@ -76,6 +76,18 @@ class AesNettle : public IAesCipher
 		 * @return Number of bytes decrypted on success; 0 on error.
 		 */
 		size_t decrypt(uint8_t *RESTRICT pData, size_t size) final;
+
+		/**
+		 * Decrypt a multi-block buffer using CTR mode with an
+		 * explicit counter base.
+		 *
+		 * @param pData	[in/out] Data block.
+		 * @param size	[in] Length of data block. (Must be a multiple of 16.)
+		 * @param pCtr	[in] 16-byte counter for the first block.
+		 * @return Number of bytes decrypted on success; 0 on error.
+		 */
+		size_t decryptCTR(uint8_t *RESTRICT pData, size_t size,
+			const uint8_t *RESTRICT pCtr) final;
 };
 
 }
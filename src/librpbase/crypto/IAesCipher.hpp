@@ -95,6 +95,26 @@ class IAesCipher
 		 */
 		inline size_t decrypt(uint8_t *RESTRICT pData, size_t size,
 			const uint8_t *RESTRICT pIV, size_t size_iv);
+
+		/**
+		 * Decrypt a multi-block buffer using CTR mode with an
+		 * explicit counter base.
+		 *
+		 * The counter for each subsequent 16-byte block is obtained
+		 * by incrementing the previous counter, so a whole read can
+		 * be processed in a single call and backends can pipeline
+		 * the cipher across blocks.
+		 *
+		 * Key must be set and the chaining mode must be CM_CTR
+		 * before calling this function.
+		 *
+		 * @param pData	[in/out] Data block.
+		 * @param size	[in] Length of data block. (Must be a multiple of 16.)
+		 * @param pCtr	[in] 16-byte counter for the first block.
+		 * @return Number of bytes decrypted on success; 0 on error.
+		 */
+		virtual size_t decryptCTR(uint8_t *RESTRICT pData, size_t size,
+			const uint8_t *RESTRICT pCtr);
 };
 
 /**
@@ -124,6 +144,29 @@ inline size_t IAesCipher::decrypt(uint8_t *RESTRICT pData, size_t size,
 	return decrypt(pData, size);
 }
 
+/**
+ * Decrypt a multi-block buffer using CTR mode with an
+ * explicit counter base.
+ *
+ * Default implementation sets the counter and decrypts in
+ * two separate calls. Backends should override this if the
+ * underlying library can do it in one shot.
+ *
+ * @param pData	[in/out] Data block.
+ * @param size	[in] Length of data block. (Must be a multiple of 16.)
+ * @param pCtr	[in] 16-byte counter for the first block.
+ * @return Number of bytes decrypted on success; 0 on error.
+ */
+inline size_t IAesCipher::decryptCTR(uint8_t *RESTRICT pData, size_t size,
+	const uint8_t *RESTRICT pCtr)
+{
+	int ret = setIV(pCtr, 16);
+	if (ret != 0) {
+		return 0;
+	}
+	return decrypt(pData, size);
+}
+
 }
 
 #endif /* __ROMPROPERTIES_LIBRPBASE_CRYPTO_IAESCIPHER_HPP__ */
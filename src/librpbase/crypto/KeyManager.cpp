@@ -13,6 +13,11 @@
 #include "config/ConfReader_p.hpp"
 #include "libi18n/i18n.h"
 
+// librpfile
+#include "librpfile/FileSystem.hpp"
+#include "librpfile/RpFile.hpp"
+using namespace LibRpFile;
+
 // C++ STL classes.
 using std::string;
 using std::unique_ptr;
@@ -82,6 +87,58 @@ class KeyManagerPrivate : public ConfReaderPrivate
 		 * - Value: Verification result.
 		 */
 		unordered_map<string, uint8_t> mapInvalidKeyNames;
+
+	public:
+		/** Binary key store cache. **/
+
+		/**
+		 * Compiled shadow of keys.conf, stored in the cache directory.
+		 * If present and its stored mtime matches keys.conf, the keys
+		 * are loaded from it directly, so short-lived processes don't
+		 * have to parse any INI text at startup.
+		 *
+		 * Layout: BinCacheHeader, then keyCount entries of
+		 * {uint8_t nameLen; char name[nameLen]; uint32_t keyIdx;},
+		 * then the vKeys data blob.
+		 *
+		 * NOTE: Native endianness. The cache is per-machine.
+		 */
+		struct BinCacheHeader {
+			char magic[4];		// "RPKC"
+			uint32_t version;	// Cache format version.
+			int64_t conf_mtime;	// keys.conf mtime when the cache was written.
+			uint32_t keyCount;	// Number of key entries.
+			uint32_t vKeysLen;	// Length of the key data blob, in bytes.
+		};
+
+		static const char BIN_CACHE_MAGIC[4];
+		static const uint32_t BIN_CACHE_VERSION = 1;
+
+		/**
+		 * Get the binary key store cache filename.
+		 * @return Cache filename, or empty string on error.
+		 */
+		static string binCacheFilename(void);
+
+		/**
+		 * Initialize conf_filename if it hasn't been set yet.
+		 * Same construction as ConfReader::load().
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int initConfFilename(void);
+
+		/**
+		 * Load the keys from the binary key store cache.
+		 * The cache is only used if its stored mtime matches keys.conf.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int loadBinCache(void);
+
+		/**
+		 * Save the loaded keys to the binary key store cache.
+		 * Best-effort; errors are ignored.
+		 */
+		void saveBinCache(void) const;
 #endif /* ENABLE_DECRYPTION */
 };
 
@@ -93,6 +150,9 @@ class KeyManagerPrivate : public ConfReaderPrivate
 // handle proper destruction when the DLL is unloaded.
 KeyManager KeyManagerPrivate::instance;
 
+// Binary key store cache magic number.
+const char KeyManagerPrivate::BIN_CACHE_MAGIC[4] = {'R','P','K','C'};
+
 // Verification test string.
 // NOTE: This string is NOT NULL-terminated!
 const char KeyManager::verifyTestString[] = {
@@ -215,6 +275,238 @@ int KeyManagerPrivate::processConfigLine(const char *section, const char *name,
 #endif /* ENABLE_DECRYPTION */
 }
 
+#ifdef ENABLE_DECRYPTION
+/**
+ * Get the binary key store cache filename.
+ * @return Cache filename, or empty string on error.
+ */
+string KeyManagerPrivate::binCacheFilename(void)
+{
+	string filename = FileSystem::getCacheDirectory();
+	if (filename.empty()) {
+		// Unable to get the cache directory.
+		return string();
+	}
+	if (filename.at(filename.size()-1) != DIR_SEP_CHR) {
+		filename += DIR_SEP_CHR;
+	}
+	filename += "keys.conf.bin";
+	return filename;
+}
+
+/**
+ * Initialize conf_filename if it hasn't been set yet.
+ * Same construction as ConfReader::load().
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int KeyManagerPrivate::initConfFilename(void)
+{
+	if (!conf_filename.empty()) {
+		// Filename is already set.
+		return 0;
+	}
+
+	conf_filename = FileSystem::getConfigDirectory();
+	if (conf_filename.empty()) {
+		// Unable to get the configuration directory.
+		return -ENOENT;
+	}
+	if (conf_filename.at(conf_filename.size()-1) != DIR_SEP_CHR) {
+		conf_filename += DIR_SEP_CHR;
+	}
+	conf_filename += conf_rel_filename;
+	return 0;
+}
+
+/**
+ * Load the keys from the binary key store cache.
+ * The cache is only used if its stored mtime matches keys.conf.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int KeyManagerPrivate::loadBinCache(void)
+{
+	MutexLocker mtxLocker(mtxLoad);
+	if (conf_was_found) {
+		// Keys were loaded while we were waiting for the mutex.
+		return 0;
+	}
+
+	int ret = initConfFilename();
+	if (ret != 0) {
+		return ret;
+	}
+
+	// The cache is validated against the keys.conf mtime.
+	time_t mtime;
+	if (FileSystem::get_mtime(conf_filename, &mtime) != 0) {
+		// keys.conf doesn't exist.
+		return -ENOENT;
+	}
+
+	const string cacheFilename = binCacheFilename();
+	if (cacheFilename.empty()) {
+		return -ENOENT;
+	}
+
+	RpFile *const file = new RpFile(cacheFilename, RpFile::FM_OPEN_READ);
+	if (!file->isOpen()) {
+		// No cache file.
+		file->unref();
+		return -ENOENT;
+	}
+
+	// Sanity check: The cache should never be more than 1 MB.
+	const off64_t fileSize = file->size();
+	if (fileSize < static_cast<off64_t>(sizeof(BinCacheHeader)) ||
+	    fileSize > 1024*1024)
+	{
+		// Invalid file size.
+		file->unref();
+		return -EIO;
+	}
+
+	// Read the entire cache file.
+	ao::uvector<uint8_t> buf;
+	buf.resize(static_cast<size_t>(fileSize));
+	const size_t size = file->read(buf.data(), buf.size());
+	file->unref();
+	if (size != buf.size()) {
+		// Short read.
+		return -EIO;
+	}
+
+	// Validate the header.
+	const BinCacheHeader *const hdr = reinterpret_cast<const BinCacheHeader*>(buf.data());
+	if (memcmp(hdr->magic, BIN_CACHE_MAGIC, sizeof(hdr->magic)) != 0 ||
+	    hdr->version != BIN_CACHE_VERSION)
+	{
+		// Wrong magic or version.
+		return -EIO;
+	}
+	if (hdr->conf_mtime != static_cast<int64_t>(mtime)) {
+		// keys.conf has been modified since the cache was written.
+		return -ENOENT;
+	}
+	if (hdr->vKeysLen > buf.size() - sizeof(BinCacheHeader)) {
+		// Key data blob is too big.
+		return -EIO;
+	}
+
+	// Parse the key entries.
+	// The vKeys data blob is at the end of the file.
+	reset();
+	const uint8_t *p = buf.data() + sizeof(BinCacheHeader);
+	const uint8_t *const p_end = buf.data() + buf.size() - hdr->vKeysLen;
+	for (uint32_t i = 0; i < hdr->keyCount; i++) {
+		if (p >= p_end) {
+			// Not enough data for this entry.
+			reset();
+			return -EIO;
+		}
+		const uint8_t nameLen = *p++;
+		if (nameLen == 0 || p + nameLen + sizeof(uint32_t) > p_end) {
+			// Invalid entry.
+			reset();
+			return -EIO;
+		}
+
+		string name(reinterpret_cast<const char*>(p), nameLen);
+		p += nameLen;
+		uint32_t keyIdx;
+		memcpy(&keyIdx, p, sizeof(keyIdx));
+		p += sizeof(keyIdx);
+
+		// Make sure the key index is within the data blob.
+		if ((keyIdx & 0xFFFFFF) + (keyIdx >> 24) > hdr->vKeysLen) {
+			// Out of range.
+			reset();
+			return -EIO;
+		}
+		mapKeyNames.insert(std::make_pair(name, keyIdx));
+	}
+	if (p != p_end) {
+		// Trailing data in the entry area.
+		reset();
+		return -EIO;
+	}
+
+	// Copy the key data blob.
+	vKeys.resize(hdr->vKeysLen);
+	memcpy(vKeys.data(), p_end, hdr->vKeysLen);
+
+	// Keys loaded.
+	conf_mtime = mtime;
+	conf_last_checked = time(nullptr);
+	conf_was_found = true;
+	return 0;
+}
+
+/**
+ * Save the loaded keys to the binary key store cache.
+ * Best-effort; errors are ignored.
+ */
+void KeyManagerPrivate::saveBinCache(void) const
+{
+	if (conf_mtime == 0) {
+		// No valid mtime, so the cache can't be validated later.
+		return;
+	}
+
+	const string cacheFilename = binCacheFilename();
+	if (cacheFilename.empty()) {
+		return;
+	}
+
+	// Make sure the cache directory exists.
+	if (FileSystem::rmkdir(cacheFilename) != 0) {
+		// Unable to create the cache directory.
+		return;
+	}
+
+	// Serialize the key entries.
+	size_t entriesLen = 0;
+	for (auto iter = mapKeyNames.cbegin(); iter != mapKeyNames.cend(); ++iter) {
+		if (iter->first.size() == 0 || iter->first.size() > 255) {
+			// Name length doesn't fit in a uint8_t. Skip it.
+			continue;
+		}
+		entriesLen += 1 + iter->first.size() + sizeof(uint32_t);
+	}
+
+	ao::uvector<uint8_t> buf;
+	buf.resize(sizeof(BinCacheHeader) + entriesLen + vKeys.size());
+
+	BinCacheHeader *const hdr = reinterpret_cast<BinCacheHeader*>(buf.data());
+	memcpy(hdr->magic, BIN_CACHE_MAGIC, sizeof(hdr->magic));
+	hdr->version = BIN_CACHE_VERSION;
+	hdr->conf_mtime = static_cast<int64_t>(conf_mtime);
+	hdr->keyCount = 0;
+	hdr->vKeysLen = static_cast<uint32_t>(vKeys.size());
+
+	uint8_t *p = buf.data() + sizeof(BinCacheHeader);
+	for (auto iter = mapKeyNames.cbegin(); iter != mapKeyNames.cend(); ++iter) {
+		const size_t nameLen = iter->first.size();
+		if (nameLen == 0 || nameLen > 255) {
+			continue;
+		}
+		*p++ = static_cast<uint8_t>(nameLen);
+		memcpy(p, iter->first.data(), nameLen);
+		p += nameLen;
+		memcpy(p, &iter->second, sizeof(uint32_t));
+		p += sizeof(uint32_t);
+		hdr->keyCount++;
+	}
+	memcpy(p, vKeys.data(), vKeys.size());
+
+	// Write the cache file.
+	RpFile *const file = new RpFile(cacheFilename, RpFile::FM_CREATE_WRITE);
+	if (file->isOpen()) {
+		file->write(buf.data(), buf.size());
+	}
+	file->unref();
+}
+#endif /* ENABLE_DECRYPTION */
+
 /** KeyManager **/
 
 KeyManager::KeyManager()
@@ -270,6 +562,40 @@ KeyManager *KeyManager::instance(void)
 	return &KeyManagerPrivate::instance;
 }
 
+/**
+ * Load the keys.
+ *
+ * If a valid binary key store cache is present, the keys
+ * are loaded from it without parsing keys.conf. Otherwise,
+ * keys.conf is parsed and the cache is rewritten.
+ *
+ * @param force If true, force a reload, even if the file hasn't been modified.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int KeyManager::load(bool force)
+{
+	RP_D(KeyManager);
+
+	if (!force && !d->conf_was_found) {
+		// First load in this process.
+		// Try the binary key store cache first in order to
+		// skip the INI text parse.
+		if (d->loadBinCache() == 0) {
+			return 0;
+		}
+	}
+
+	// Parse keys.conf.
+	const bool wasLoaded = d->conf_was_found;
+	const time_t prev_mtime = d->conf_mtime;
+	int ret = super::load(force);
+	if (ret == 0 && (!wasLoaded || d->conf_mtime != prev_mtime)) {
+		// keys.conf was (re)parsed. Update the binary cache.
+		d->saveBinCache();
+	}
+	return ret;
+}
+
 /**
  * Get an encryption key.
  * @param keyName	[in]  Encryption key name.
@@ -329,6 +655,54 @@ KeyManager::VerifyResult KeyManager::get(const char *keyName, KeyData_t *pKeyDat
 	return VERIFY_OK;
 }
 
+/**
+ * Verify a key using a prepared cipher.
+ * The cipher must already be set to ECB chaining mode.
+ * @param cipher	[in] IAesCipher instance.
+ * @param pKeyData	[in] Key data struct.
+ * @param pVerifyData	[in] Verification data block. (16 bytes)
+ * @return VerifyResult.
+ */
+static KeyManager::VerifyResult verifyKeyData_int(IAesCipher *cipher,
+	const KeyManager::KeyData_t *pKeyData, const uint8_t *pVerifyData)
+{
+	if (!pKeyData->key || pKeyData->length == 0) {
+		// Key is invalid.
+		return KeyManager::VERIFY_KEY_INVALID;
+	}
+
+	// Verify the key length.
+	if (pKeyData->length != 16 && pKeyData->length != 24 && pKeyData->length != 32) {
+		// Key length is invalid.
+		return KeyManager::VERIFY_KEY_INVALID;
+	}
+
+	int ret = cipher->setKey(pKeyData->key, pKeyData->length);
+	if (ret != 0) {
+		return KeyManager::VERFIY_IAESCIPHER_INIT_ERR;
+	}
+
+	// Decrypt the test data.
+	// NOTE: IAesCipher decrypts in place, so we need to
+	// make a temporary copy.
+	uint8_t tmpData[16];
+	memcpy(tmpData, pVerifyData, sizeof(tmpData));
+	size_t size = cipher->decrypt(tmpData, sizeof(tmpData));
+	if (size != sizeof(tmpData)) {
+		// Decryption failed.
+		return KeyManager::VERIFY_IAESCIPHER_DECRYPT_ERR;
+	}
+
+	// Verify the test data.
+	if (memcmp(tmpData, KeyManager::verifyTestString, sizeof(tmpData)) != 0) {
+		// Verification failed.
+		return KeyManager::VERIFY_WRONG_KEY;
+	}
+
+	// Test data verified.
+	return KeyManager::VERIFY_OK;
+}
+
 /**
  * Verify and retrieve an encryption key.
  *
@@ -367,19 +741,11 @@ KeyManager::VerifyResult KeyManager::getAndVerify(const char *keyName, KeyData_t
 	if (res != VERIFY_OK) {
 		// Error obtaining the key.
 		return res;
-	} else if (!pKeyData->key || pKeyData->length == 0) {
-		// Key is invalid.
-		return VERIFY_KEY_INVALID;
-	}
-
-	// Verify the key length.
-	if (pKeyData->length != 16 && pKeyData->length != 24 && pKeyData->length != 32) {
-		// Key length is invalid.
-		return VERIFY_KEY_INVALID;
 	}
 
 	// Decrypt the test data.
-	// TODO: Keep this IAesCipher instance around?
+	// NOTE: The cipher is created per call here.
+	// Use getAndVerifyAll() to verify many keys at once.
 	unique_ptr<IAesCipher> cipher(AesCipherFactory::create());
 	if (!cipher) {
 		// Unable to create the IAesCipher.
@@ -391,30 +757,61 @@ KeyManager::VerifyResult KeyManager::getAndVerify(const char *keyName, KeyData_t
 	if (ret != 0) {
 		return VERFIY_IAESCIPHER_INIT_ERR;
 	}
-	ret = cipher->setKey(pKeyData->key, pKeyData->length);
-	if (ret != 0) {
-		return VERFIY_IAESCIPHER_INIT_ERR;
-	}
 
-	// Decrypt the test data.
-	// NOTE: IAesCipher decrypts in place, so we need to
-	// make a temporary copy.
-	unique_ptr<uint8_t[]> tmpData(new uint8_t[verifyLen]);
-	memcpy(tmpData.get(), pVerifyData, verifyLen);
-	size_t size = cipher->decrypt(tmpData.get(), verifyLen);
-	if (size != verifyLen) {
-		// Decryption failed.
-		return VERIFY_IAESCIPHER_DECRYPT_ERR;
+	return verifyKeyData_int(cipher.get(), pKeyData, pVerifyData);
+}
+
+/**
+ * Verify multiple encryption keys in one pass.
+ *
+ * Same verification as getAndVerify(), but a single
+ * IAesCipher instance is shared across all keys instead
+ * of creating one per key. Use this when checking many
+ * keys at once, e.g. when importing a key file.
+ *
+ * @param pRequests	[in,out] Array of verification requests.
+ * @param count		[in] Number of requests.
+ * @return VERIFY_OK if all keys verified; otherwise, the first error result.
+ */
+KeyManager::VerifyResult KeyManager::getAndVerifyAll(VerifyRequest_t *pRequests, unsigned int count) const
+{
+	assert(pRequests != nullptr);
+	if (!pRequests) {
+		// Invalid parameters.
+		return VERIFY_INVALID_PARAMS;
+	} else if (count == 0) {
+		// Nothing to do.
+		return VERIFY_OK;
 	}
 
-	// Verify the test data.
-	if (memcmp(tmpData.get(), verifyTestString, verifyLen) != 0) {
-		// Verification failed.
-		return VERIFY_WRONG_KEY;
+	// Create a single cipher for the entire batch.
+	unique_ptr<IAesCipher> cipher(AesCipherFactory::create());
+	const bool cipherOK = (cipher && cipher->setChainingMode(IAesCipher::CM_ECB) == 0);
+
+	VerifyResult firstErr = VERIFY_OK;
+	VerifyRequest_t *p = pRequests;
+	for (; count > 0; count--, p++) {
+		VerifyResult res;
+		if (!p->keyName || !p->pVerifyData) {
+			// Invalid request.
+			res = VERIFY_INVALID_PARAMS;
+		} else {
+			KeyData_t keyData = {nullptr, 0};
+			res = get(p->keyName, &keyData);
+			if (res == VERIFY_OK) {
+				res = (cipherOK
+					? verifyKeyData_int(cipher.get(), &keyData, p->pVerifyData)
+					: VERFIY_IAESCIPHER_INIT_ERR);
+			}
+		}
+
+		p->res = res;
+		if (res != VERIFY_OK && firstErr == VERIFY_OK) {
+			firstErr = res;
+		}
 	}
 
-	// Test data verified.
-	return VERIFY_OK;
+	return firstErr;
 }
 
 /**
@@ -70,6 +70,19 @@ class KeyManager : public ConfReader
 		 */
 		static KeyManager *instance(void);
 
+	public:
+		/**
+		 * Load the keys.
+		 *
+		 * If a valid binary key store cache is present, the keys
+		 * are loaded from it without parsing keys.conf. Otherwise,
+		 * keys.conf is parsed and the cache is rewritten.
+		 *
+		 * @param force If true, force a reload, even if the file hasn't been modified.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int load(bool force = false) final;
+
 	public:
 		// Encryption key data.
 		struct KeyData_t {
@@ -104,6 +117,27 @@ class KeyManager : public ConfReader
 		VerifyResult getAndVerify(const char *keyName, KeyData_t *pKeyData,
 			const uint8_t *pVerifyData, unsigned int verifyLen) const;
 
+		// Bulk key verification request.
+		struct VerifyRequest_t {
+			const char *keyName;		// [in] Encryption key name.
+			const uint8_t *pVerifyData;	// [in] Verification data block. (16 bytes)
+			VerifyResult res;		// [out] Verification result.
+		};
+
+		/**
+		 * Verify multiple encryption keys in one pass.
+		 *
+		 * Same verification as getAndVerify(), but a single
+		 * IAesCipher instance is shared across all keys instead
+		 * of creating one per key. Use this when checking many
+		 * keys at once, e.g. when importing a key file.
+		 *
+		 * @param pRequests	[in,out] Array of verification requests.
+		 * @param count		[in] Number of requests.
+		 * @return VERIFY_OK if all keys verified; otherwise, the first error result.
+		 */
+		VerifyResult getAndVerifyAll(VerifyRequest_t *pRequests, unsigned int count) const;
+
 		// Verification test string.
 		// NOTE: This string is NOT NULL-terminated!
 		static const char verifyTestString[16];
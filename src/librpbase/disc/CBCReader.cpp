@@ -15,6 +15,7 @@
 # include "crypto/AesCipherFactory.hpp"
 # include "crypto/IAesCipher.hpp"
 # include "crypto/KeyManager.hpp"
+# include "librpthreads/ThreadPool.hpp"
 #endif
 
 // librpfile
@@ -47,6 +48,39 @@ class CBCReaderPrivate
 		uint8_t key[16];
 		uint8_t iv[16];
 		LibRpBase::IAesCipher *cipher;
+		IAesCipher::ChainingMode chainingMode;
+
+		// Sequential read prefetch.
+		// If reads are detected as sequential, the next chunk is
+		// read ahead and decrypted on a worker thread while the
+		// caller processes the current chunk, overlapping the AES
+		// decryption. The read itself stays on the calling thread:
+		// callers may access the underlying file directly between
+		// CBCReader reads, so the worker must not touch the shared
+		// file handle.
+		static const size_t PREFETCH_SIZE = 4096;
+		LibRpBase::IAesCipher *cipherPrefetch;	// Worker thread cipher. (IAesCipher is stateful.)
+		std::unique_ptr<uint8_t[]> prefetchBuf;
+		off64_t prefetchAddr;		// Position of the prefetched data. (-1 if none)
+		size_t prefetchLen;		// Length of the prefetched data.
+		bool prefetchPending;		// True if a prefetch task is in flight.
+		off64_t seqReadEnd;		// End position of the previous read.
+		ThreadPool::TaskSet prefetchTaskSet;
+
+		/**
+		 * Wait for the in-flight prefetch task, if any.
+		 * Must be called before accessing the prefetch
+		 * buffer or the worker thread's cipher.
+		 */
+		void waitForPrefetch(void);
+
+		/**
+		 * Schedule a one-chunk-ahead prefetch if the read
+		 * pattern is sequential.
+		 * Must be called with no prefetch task in flight.
+		 * @param readStart Start position of the read that just completed.
+		 */
+		void schedulePrefetch(off64_t readStart);
 #endif /* ENABLE_DECRYPTION */
 };
 
@@ -61,6 +95,12 @@ CBCReaderPrivate::CBCReaderPrivate(CBCReader *q,
 	, pos(0)
 #ifdef ENABLE_DECRYPTION
 	, cipher(nullptr)
+	, chainingMode(IAesCipher::CM_ECB)
+	, cipherPrefetch(nullptr)
+	, prefetchAddr(-1)
+	, prefetchLen(0)
+	, prefetchPending(false)
+	, seqReadEnd(-1)
 #endif
 {
 	assert(q->m_file != nullptr);
@@ -98,7 +138,8 @@ CBCReaderPrivate::CBCReaderPrivate(CBCReader *q,
 	}
 
 	// Initialize parameters for CBC decryption.
-	cipher->setChainingMode(iv != nullptr ? IAesCipher::CM_CBC : IAesCipher::CM_ECB);
+	chainingMode = (iv != nullptr ? IAesCipher::CM_CBC : IAesCipher::CM_ECB);
+	cipher->setChainingMode(chainingMode);
 	cipher->setKey(this->key, sizeof(this->key));
 	if (iv) {
 		cipher->setIV(this->iv, sizeof(this->iv));
@@ -115,10 +156,126 @@ CBCReaderPrivate::CBCReaderPrivate(CBCReader *q,
 CBCReaderPrivate::~CBCReaderPrivate()
 {
 #ifdef ENABLE_DECRYPTION
+	waitForPrefetch();
+	delete cipherPrefetch;
 	delete cipher;
 #endif /* ENABLE_DECRYPTION */
 }
 
+#ifdef ENABLE_DECRYPTION
+/**
+ * Wait for the in-flight prefetch task, if any.
+ * Must be called before accessing the prefetch
+ * buffer or the worker thread's cipher.
+ */
+void CBCReaderPrivate::waitForPrefetch(void)
+{
+	if (prefetchPending) {
+		prefetchTaskSet.wait();
+		prefetchPending = false;
+	}
+}
+
+/**
+ * Schedule a one-chunk-ahead prefetch if the read
+ * pattern is sequential.
+ * Must be called with no prefetch task in flight.
+ * @param readStart Start position of the read that just completed.
+ */
+void CBCReaderPrivate::schedulePrefetch(off64_t readStart)
+{
+	// Only prefetch if this read continued where the
+	// previous read left off.
+	if (readStart != seqReadEnd)
+		return;
+
+	if (ThreadPool::instance()->threadCount() == 0) {
+		// No worker threads. The prefetch would run on the
+		// calling thread, adding overhead without any overlap.
+		return;
+	}
+
+	// Next chunk starts at the current read position,
+	// rounded down to a full AES block.
+	const off64_t chunk_start = pos & ~15LL;
+	if (chunk_start >= length) {
+		// End of the encrypted data.
+		return;
+	}
+	if (prefetchAddr >= 0 && chunk_start >= prefetchAddr &&
+	    chunk_start < prefetchAddr + static_cast<off64_t>(prefetchLen))
+	{
+		// The next chunk is still in the prefetch buffer.
+		return;
+	}
+
+	size_t chunk_len = PREFETCH_SIZE;
+	if (chunk_start + static_cast<off64_t>(chunk_len) > length) {
+		// Last chunk. Round up to a full AES block;
+		// the encrypted data always has complete blocks.
+		chunk_len = static_cast<size_t>((length - chunk_start + 15) & ~15LL);
+	}
+
+	if (!prefetchBuf) {
+		prefetchBuf.reset(new uint8_t[PREFETCH_SIZE]);
+	}
+	if (!cipherPrefetch) {
+		// The worker thread needs its own cipher, since
+		// IAesCipher instances are stateful. (IV)
+		cipherPrefetch = AesCipherFactory::create();
+		if (!cipherPrefetch) {
+			// Unable to initialize the second cipher.
+			return;
+		}
+		cipherPrefetch->setChainingMode(chainingMode);
+		cipherPrefetch->setKey(key, sizeof(key));
+	}
+
+	// No prefetched data until the task finishes.
+	prefetchAddr = -1;
+	prefetchLen = 0;
+
+	// Read the chunk, and the IV from the previous ciphertext
+	// block, on the calling thread. Callers may access the
+	// underlying file directly between CBCReader reads (e.g.
+	// Xbox360_XEX), so the worker must not seek or read the
+	// shared file handle.
+	RP_Q(CBCReader);
+	uint8_t iv_tmp[16];
+	if (chunk_start == 0) {
+		// Start of data. Use the specified IV.
+		memcpy(iv_tmp, this->iv, sizeof(iv_tmp));
+	} else {
+		size_t sz_read = q->m_file->seekAndRead(
+			offset + chunk_start - 16, iv_tmp, sizeof(iv_tmp));
+		if (sz_read != sizeof(iv_tmp)) {
+			// Read error. read() will fall back
+			// to the non-prefetched path.
+			return;
+		}
+	}
+	size_t sz_read = q->m_file->seekAndRead(
+		offset + chunk_start, prefetchBuf.get(), chunk_len);
+	if (sz_read != chunk_len)
+		return;
+	if (cipherPrefetch->setIV(iv_tmp, sizeof(iv_tmp)) != 0)
+		return;
+
+	// Decrypt the chunk on the worker thread.
+	// NOTE: read() waits for this task before touching the
+	// prefetch buffer, so the worker has exclusive access to
+	// the buffer and its cipher until then.
+	prefetchPending = true;
+	prefetchTaskSet.submit([this, chunk_start, chunk_len]() {
+		if (cipherPrefetch->decrypt(prefetchBuf.get(), chunk_len) != chunk_len)
+			return;
+
+		prefetchAddr = chunk_start;
+		prefetchLen = chunk_len;
+	});
+}
+#endif /* ENABLE_DECRYPTION */
+
 /** CBCReader **/
 
 /**
@@ -208,15 +365,41 @@ size_t CBCReader::read(void *ptr, size_t size)
 		size = d->length - d->pos;
 	}
 
+	// Start position of this read, for sequential pattern detection.
+	const off64_t readStart = d->pos;
+
+	// Wait for any in-flight prefetch before
+	// touching the prefetch buffer.
+	d->waitForPrefetch();
+
+	// Total number of bytes read.
+	size_t total_sz_read = 0;
+
+	// Serve as much as possible from the prefetch buffer.
+	if (d->prefetchAddr >= 0 && d->pos >= d->prefetchAddr &&
+	    d->pos < d->prefetchAddr + static_cast<off64_t>(d->prefetchLen))
+	{
+		const size_t buf_offset = static_cast<size_t>(d->pos - d->prefetchAddr);
+		const size_t sz = std::min(size, d->prefetchLen - buf_offset);
+		memcpy(ptr8, &d->prefetchBuf[buf_offset], sz);
+		ptr8 += sz;
+		size -= sz;
+		total_sz_read += sz;
+		d->pos += sz;
+		if (size == 0) {
+			// Request fully served from the prefetch buffer.
+			d->schedulePrefetch(readStart);
+			d->seqReadEnd = d->pos;
+			return total_sz_read;
+		}
+	}
+
 	uint8_t iv[16];
 
 	// Read the first block.
 	// NOTE: If we're in the middle of a block, round it down.
 	const off64_t pos_block = d->pos & ~15LL;
 
-	// Total number of bytes read.
-	size_t total_sz_read = 0;
-
 	// Get the IV.
 	if (pos_block == 0) {
 		// Start of data.
@@ -336,6 +519,8 @@ size_t CBCReader::read(void *ptr, size_t size)
 	}
 
 	// Data read and decrypted successfully.
+	d->schedulePrefetch(readStart);
+	d->seqReadEnd = d->pos;
 	return total_sz_read;
 #else
 	// Cannot decrypt data if decryption is disabled.
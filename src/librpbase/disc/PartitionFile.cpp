@@ -52,6 +52,7 @@ bool PartitionFile::isOpen(void) const
 void PartitionFile::close(void)
 {
 	m_partition = nullptr;
+	m_mapBuf.reset();
 }
 
 /**
@@ -163,6 +164,68 @@ int PartitionFile::truncate(off64_t size)
 	return -m_lastError;
 }
 
+/** Memory mapping **/
+
+/**
+ * Map the entire file into memory, if supported.
+ *
+ * The file contents are materialized into an internal
+ * buffer with a single bulk read through the partition.
+ * Decryption and sparse layers mean the underlying
+ * storage can't be borrowed directly, but this gives
+ * consumers a stable view for in-place parsing instead
+ * of copying the data out with many small read() calls.
+ *
+ * The mapping remains valid until unmap() is called or
+ * the file is closed.
+ *
+ * @return Pointer to the mapped file data, or nullptr if not supported.
+ */
+const void *PartitionFile::map(void)
+{
+	if (!m_partition) {
+		m_lastError = EBADF;
+		return nullptr;
+	}
+
+	if (m_mapBuf) {
+		// File is already mapped.
+		return m_mapBuf.get();
+	}
+
+	if (m_size <= 0 || m_size > MAP_SIZE_MAX) {
+		// Empty file, or too big to materialize.
+		// The caller must fall back to read().
+		return nullptr;
+	}
+
+	// Read the entire file in one pass.
+	std::unique_ptr<uint8_t[]> buf(new uint8_t[static_cast<size_t>(m_size)]);
+	m_partition->clearError();
+	int iRet = m_partition->seek(m_offset);
+	if (iRet != 0) {
+		m_lastError = m_partition->lastError();
+		return nullptr;
+	}
+	size_t sz_read = m_partition->read(buf.get(), static_cast<size_t>(m_size));
+	if (sz_read != static_cast<size_t>(m_size)) {
+		// Short read. Cannot provide a full view.
+		m_lastError = m_partition->lastError();
+		return nullptr;
+	}
+
+	m_mapBuf = std::move(buf);
+	return m_mapBuf.get();
+}
+
+/**
+ * Unmap previously-mapped file data.
+ */
+void PartitionFile::unmap(void)
+{
+	m_mapBuf.reset();
+}
+
 /** File properties. **/
 
 /**
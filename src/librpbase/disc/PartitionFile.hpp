@@ -11,6 +11,9 @@
 
 #include "librpfile/IRpFile.hpp"
 
+// C++ includes.
+#include <memory>
+
 namespace LibRpBase {
 
 class IDiscReader;
@@ -83,6 +86,31 @@ class PartitionFile : public LibRpFile::IRpFile
 		 */
 		int truncate(off64_t size = 0) final;
 
+	public:
+		/** Memory mapping **/
+
+		/**
+		 * Map the entire file into memory, if supported.
+		 *
+		 * The file contents are materialized into an internal
+		 * buffer with a single bulk read through the partition.
+		 * Decryption and sparse layers mean the underlying
+		 * storage can't be borrowed directly, but this gives
+		 * consumers a stable view for in-place parsing instead
+		 * of copying the data out with many small read() calls.
+		 *
+		 * The mapping remains valid until unmap() is called or
+		 * the file is closed.
+		 *
+		 * @return Pointer to the mapped file data, or nullptr if not supported.
+		 */
+		const void *map(void) final;
+
+		/**
+		 * Unmap previously-mapped file data.
+		 */
+		void unmap(void) final;
+
 	public:
 		/** File properties. **/
 
@@ -103,6 +131,13 @@ class PartitionFile : public LibRpFile::IRpFile
 		off64_t m_offset;	// File starting offset.
 		off64_t m_size;		// File size.
 		off64_t m_pos;		// Current position.
+
+		// Maximum file size for map().
+		// Larger files must be accessed using read().
+		static const off64_t MAP_SIZE_MAX = 64LL*1024*1024;
+
+		// Materialized file contents for map().
+		std::unique_ptr<uint8_t[]> m_mapBuf;
 };
 
 }
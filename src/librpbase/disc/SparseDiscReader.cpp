@@ -14,6 +14,9 @@
 // librpfile
 using LibRpFile::IRpFile;
 
+// C++ STL classes.
+using std::unique_ptr;
+
 namespace LibRpBase {
 
 /** SparseDiscReaderPrivate **/
@@ -23,6 +26,7 @@ SparseDiscReaderPrivate::SparseDiscReaderPrivate(SparseDiscReader *q)
 	, disc_size(0)
 	, pos(-1)
 	, block_size(0)
+	, blockCacheLRU(0)
 {
 	// NOTE: Can't check q->m_file here.
 
@@ -30,6 +34,62 @@ SparseDiscReaderPrivate::SparseDiscReaderPrivate(SparseDiscReader *q)
 	// set by the subclass.
 }
 
+/**
+ * Look up a block in the block cache.
+ * Updates the entry's LRU counter if found.
+ * @param blockIdx Block index.
+ * @return Cached block data, or nullptr if not cached.
+ */
+const uint8_t *SparseDiscReaderPrivate::findCachedBlock(uint32_t blockIdx)
+{
+	for (auto iter = blockCache.begin(); iter != blockCache.end(); ++iter) {
+		if (iter->blockIdx == blockIdx) {
+			// Found the block.
+			iter->lru = ++blockCacheLRU;
+			return iter->data.get();
+		}
+	}
+
+	// Block is not cached.
+	return nullptr;
+}
+
+/**
+ * Add a block to the block cache.
+ * The least-recently-used entry is evicted if the cache is full.
+ * @param blockIdx Block index.
+ * @param data Block data. (block_size bytes; ownership is taken)
+ */
+void SparseDiscReaderPrivate::cacheBlock(uint32_t blockIdx, unique_ptr<uint8_t[]> &&data)
+{
+	// Maximum number of cached blocks for this block size.
+	unsigned int max_entries = BLOCK_CACHE_SIZE_MAX / block_size;
+	if (max_entries == 0) {
+		max_entries = 1;
+	} else if (max_entries > BLOCK_CACHE_ENTRIES_MAX) {
+		max_entries = BLOCK_CACHE_ENTRIES_MAX;
+	}
+
+	BlockCacheEntry *entry;
+	if (blockCache.size() < static_cast<size_t>(max_entries)) {
+		// Cache isn't full yet. Add a new entry.
+		blockCache.resize(blockCache.size() + 1);
+		entry = &blockCache[blockCache.size() - 1];
+	} else {
+		// Cache is full. Evict the least-recently-used entry.
+		entry = &blockCache[0];
+		for (auto iter = blockCache.begin() + 1; iter != blockCache.end(); ++iter) {
+			if (iter->lru < entry->lru) {
+				entry = &(*iter);
+			}
+		}
+	}
+
+	entry->blockIdx = blockIdx;
+	entry->lru = ++blockCacheLRU;
+	entry->data = std::move(data);
+}
+
 /** SparseDiscReader **/
 
 SparseDiscReader::SparseDiscReader(SparseDiscReaderPrivate *d, IRpFile *file)
@@ -104,17 +164,22 @@ size_t SparseDiscReader::read(void *ptr, size_t size)
 	}
 
 	// Read entire blocks.
-	for (; size >= block_size;
-	    size -= block_size, ptr8 += block_size,
-	    ret += block_size, d->pos += block_size)
-	{
+	if (size >= block_size) {
 		assert(d->pos % block_size == 0);
 		const unsigned int blockIdx = static_cast<unsigned int>(d->pos / block_size);
-		int rd = this->readBlock(blockIdx, ptr8, 0, block_size);
-		if (rd < 0 || rd != static_cast<int>(block_size)) {
+		const uint32_t blockCount = static_cast<uint32_t>(size / block_size);
+		const size_t full_sz = static_cast<size_t>(blockCount) * block_size;
+
+		int rd = this->readBlocks(blockIdx, blockCount, ptr8);
+		if (rd < 0 || rd != static_cast<int>(full_sz)) {
 			// Error reading the data.
 			return ret + (rd > 0 ? rd : 0);
 		}
+
+		size -= full_sz;
+		ptr8 += full_sz;
+		ret += full_sz;
+		d->pos += full_sz;
 	}
 
 	// Check if we still have data left. (not a full block)
@@ -243,6 +308,14 @@ int SparseDiscReader::readBlock(uint32_t blockIdx, void *ptr, int pos, size_t si
 		return 0;
 	}
 
+	// Check the block cache first.
+	const uint8_t *const pCached = d->findCachedBlock(blockIdx);
+	if (pCached) {
+		// Block is cached.
+		memcpy(ptr, &pCached[pos], size);
+		return static_cast<int>(size);
+	}
+
 	// Get the physical address first.
 	const off64_t physBlockAddr = getPhysBlockAddr(blockIdx);
 	assert(physBlockAddr >= 0);
@@ -257,10 +330,141 @@ int SparseDiscReader::readBlock(uint32_t blockIdx, void *ptr, int pos, size_t si
 		return static_cast<int>(size);
 	}
 
-	// Read from the block.
+	if ((pos != 0 || size != d->block_size) &&
+	    d->block_size <= SparseDiscReaderPrivate::BLOCK_CACHE_SIZE_MAX)
+	{
+		// Partial block read.
+		// Read the full block and cache it, then copy out
+		// the requested portion. FST traversal and banner
+		// extraction re-read the same blocks many times, so
+		// the full-block read pays for itself quickly.
+		// NOTE: Full-block reads are usually streaming, so
+		// those are read directly without caching.
+		unique_ptr<uint8_t[]> blockData(new uint8_t[d->block_size]);
+		size_t sz_read = m_file->seekAndRead(physBlockAddr, blockData.get(), d->block_size);
+		m_lastError = m_file->lastError();
+		if (sz_read != d->block_size) {
+			// Full block is not available.
+			// Fall back to reading the requested portion only.
+			sz_read = m_file->seekAndRead(physBlockAddr + pos, ptr, size);
+			m_lastError = m_file->lastError();
+			return (sz_read > 0 ? (int)sz_read : -1);
+		}
+
+		memcpy(ptr, &blockData[pos], size);
+		d->cacheBlock(blockIdx, std::move(blockData));
+		return static_cast<int>(size);
+	}
+
+	// Block is too big to cache.
+	// Read from the block directly.
 	size_t sz_read = m_file->seekAndRead(physBlockAddr + pos, ptr, size);
 	m_lastError = m_file->lastError();
 	return (sz_read > 0 ? (int)sz_read : -1);
 }
 
+/**
+ * Read consecutive full blocks.
+ *
+ * The default implementation coalesces runs of blocks that are
+ * physically adjacent in the underlying file into one big read.
+ * Uncompressed sparse formats (CISO, WUX) usually store logically
+ * sequential blocks contiguously, so sequential extraction turns
+ * into a handful of large reads instead of one read per block.
+ * Subclasses with a fully fixed physical layout can still override
+ * this to skip the per-block address lookups.
+ *
+ * @param blockIdx	[in] Starting block index.
+ * @param blockCount	[in] Number of blocks to read.
+ * @param ptr		[out] Output data buffer. (blockCount * block_size bytes)
+ * @return Number of bytes read, or -1 if the block index is invalid.
+ */
+int SparseDiscReader::readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr)
+{
+	RP_D(SparseDiscReader);
+	const uint32_t block_size = d->block_size;
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	int ret = 0;
+
+	while (blockCount > 0) {
+		// Check the block cache first. FST traversal may have
+		// cached blocks that are now being streamed.
+		if (d->findCachedBlock(blockIdx) != nullptr) {
+			int rd = this->readBlock(blockIdx, ptr8, 0, block_size);
+			if (rd < 0 || rd != static_cast<int>(block_size)) {
+				// Error reading the data.
+				return ret + (rd > 0 ? rd : 0);
+			}
+			ret += block_size;
+			ptr8 += block_size;
+			blockIdx++;
+			blockCount--;
+			continue;
+		}
+
+		const off64_t physBlockAddr = this->getPhysBlockAddr(blockIdx);
+		assert(physBlockAddr >= 0);
+		if (physBlockAddr < 0) {
+			// Out of range.
+			return (ret > 0 ? ret : -1);
+		}
+
+		if (physBlockAddr == 0) {
+			// Empty block. Coalesce the entire empty run.
+			uint32_t run = 1;
+			while (run < blockCount &&
+			       this->getPhysBlockAddr(blockIdx + run) == 0)
+			{
+				run++;
+			}
+
+			const size_t run_sz = static_cast<size_t>(run) * block_size;
+			memset(ptr8, 0, run_sz);
+			ret += run_sz;
+			ptr8 += run_sz;
+			blockIdx += run;
+			blockCount -= run;
+			continue;
+		}
+
+		// Extend the run over physically-adjacent blocks.
+		uint32_t run = 1;
+		off64_t expectedAddr = physBlockAddr + block_size;
+		while (run < blockCount &&
+		       this->getPhysBlockAddr(blockIdx + run) == expectedAddr)
+		{
+			expectedAddr += block_size;
+			run++;
+		}
+
+		// Ask the OS to prefetch the extent of the block
+		// following the run while we're reading this one.
+		// Logical sequential reads can be physically scattered
+		// in sparse formats, so the OS readahead can't predict
+		// this on its own.
+		if (run < blockCount) {
+			const off64_t nextAddr = this->getPhysBlockAddr(blockIdx + run);
+			if (nextAddr > 0) {
+				m_file->readAhead(nextAddr, block_size);
+			}
+		}
+
+		// Read the entire run with one underlying read.
+		const size_t run_sz = static_cast<size_t>(run) * block_size;
+		const size_t sz_read = m_file->seekAndRead(physBlockAddr, ptr8, run_sz);
+		m_lastError = m_file->lastError();
+		if (sz_read != run_sz) {
+			// Error reading the data.
+			return ret + (sz_read > 0 ? static_cast<int>(sz_read) : 0);
+		}
+
+		ret += run_sz;
+		ptr8 += run_sz;
+		blockIdx += run;
+		blockCount -= run;
+	}
+
+	return ret;
+}
+
 }
@@ -92,6 +92,21 @@ class SparseDiscReader : public IDiscReader
 		 * @return Number of bytes read, or -1 if the block index is invalid.
 		 */
 		virtual int readBlock(uint32_t blockIdx, void *ptr, int pos, size_t size);
+
+		/**
+		 * Read consecutive full blocks.
+		 *
+		 * The default implementation reads the blocks one at a time
+		 * using readBlock(). Subclasses with a fixed physical layout
+		 * can override this to issue one underlying read for the
+		 * entire run instead of one read per block.
+		 *
+		 * @param blockIdx	[in] Starting block index.
+		 * @param blockCount	[in] Number of blocks to read.
+		 * @param ptr		[out] Output data buffer. (blockCount * block_size bytes)
+		 * @return Number of bytes read, or -1 if the block index is invalid.
+		 */
+		virtual int readBlocks(uint32_t blockIdx, uint32_t blockCount, void *ptr);
 };
 
 }
@@ -14,6 +14,10 @@
 #include <stdint.h>
 #include "common.h"
 
+// C++ includes.
+#include <memory>
+#include <vector>
+
 namespace LibRpBase {
 
 class SparseDiscReader;
@@ -34,6 +38,44 @@ class SparseDiscReaderPrivate
 		off64_t disc_size;		// Virtual disc image size.
 		off64_t pos;			// Read position.
 		unsigned int block_size;	// Block size.
+
+	public:
+		/** Block cache. **/
+
+		// FST traversal and banner extraction tend to re-read the
+		// same physical blocks many times, so cache a few recently
+		// used blocks. Shared by all SparseDiscReader subclasses
+		// that use the default readBlock() implementation.
+
+		// Maximum total size of cached blocks, in bytes.
+		static const unsigned int BLOCK_CACHE_SIZE_MAX = 4U*1024*1024;
+		// Maximum number of cached blocks.
+		// Limits the linear search for small block sizes.
+		static const unsigned int BLOCK_CACHE_ENTRIES_MAX = 64;
+
+		struct BlockCacheEntry {
+			uint32_t blockIdx;			// Logical block index.
+			uint64_t lru;				// Last-use counter.
+			std::unique_ptr<uint8_t[]> data;	// Block data. (block_size bytes)
+		};
+		std::vector<BlockCacheEntry> blockCache;
+		uint64_t blockCacheLRU;		// Monotonic use counter.
+
+		/**
+		 * Look up a block in the block cache.
+		 * Updates the entry's LRU counter if found.
+		 * @param blockIdx Block index.
+		 * @return Cached block data, or nullptr if not cached.
+		 */
+		const uint8_t *findCachedBlock(uint32_t blockIdx);
+
+		/**
+		 * Add a block to the block cache.
+		 * The least-recently-used entry is evicted if the cache is full.
+		 * @param blockIdx Block index.
+		 * @param data Block data. (block_size bytes; ownership is taken)
+		 */
+		void cacheBlock(uint32_t blockIdx, std::unique_ptr<uint8_t[]> &&data);
 };
 
 }
@@ -26,12 +26,36 @@ void IconAnimHelper::reset(void)
 		m_frame = m_iconAnimData->seq_index[0];
 		m_delay = m_iconAnimData->delays[0].ms;
 		m_last_valid_frame = m_frame;
+		m_displayed_frame = m_frame;
+
+		// Precompute the resolved frame for each sequence step.
+		// Steps that reference a missing frame fall back to the
+		// last valid frame, so steady-state animation (e.g.
+		// ping-pong DS icons) becomes a table lookup instead of
+		// re-checking frame validity on every tick.
+		// NOTE: Two passes, so steps that fall back across the
+		// loop boundary resolve to the steady-state frame.
+		uint8_t last_valid = m_iconAnimData->seq_index[0];
+		for (unsigned int pass = 0; pass < 2; pass++) {
+			for (int i = 0; i < m_iconAnimData->seq_count; i++) {
+				const uint8_t frame = m_iconAnimData->seq_index[i];
+				if (m_iconAnimData->frames[frame] != nullptr &&
+				    m_iconAnimData->frames[frame]->isValid())
+				{
+					// Frame is valid.
+					last_valid = frame;
+				}
+				m_resolved[i] = last_valid;
+			}
+		}
 	} else {
 		// No animation.
 		m_seq_idx = 0;
 		m_frame = 0;
 		m_delay = 0;
 		m_last_valid_frame = 0;
+		m_displayed_frame = 0;
+		m_resolved.fill(0);
 	}
 }
 
@@ -67,15 +91,36 @@ int IconAnimHelper::nextFrame(int *pDelay)
 		*pDelay = m_delay;
 	}
 
-	// Check if this frame is valid.
-	if (m_iconAnimData->frames[m_frame] != nullptr &&
-	    m_iconAnimData->frames[m_frame]->isValid())
-	{
-		// Frame is valid.
-		m_last_valid_frame = m_frame;
+	// Get the resolved frame for this sequence step.
+	// Invalid frames were resolved to the last valid
+	// frame by reset().
+	m_last_valid_frame = m_resolved[m_seq_idx];
+	return m_last_valid_frame;
+}
+
+/**
+ * Advance the animation by one frame for a UI timer tick.
+ *
+ * UI frontends pre-convert all frames to the toolkit's image
+ * format once, so the timer callback only needs to swap the
+ * displayed handle when the frame number actually changes.
+ * This function tracks the displayed frame internally and
+ * returns -1 if no swap is necessary.
+ *
+ * @param pDelay	[out] Pointer to int to store the frame delay, in milliseconds.
+ * @return Next frame number, or -1 if the displayed frame hasn't changed.
+ */
+int IconAnimHelper::tick(int *pDelay)
+{
+	const int frame = nextFrame(pDelay);
+	if (frame == m_displayed_frame) {
+		// Same frame as before. No swap necessary.
+		return -1;
 	}
 
-	return m_last_valid_frame;
+	// New frame number.
+	m_displayed_frame = frame;
+	return frame;
 }
 
 }
@@ -23,6 +23,7 @@ class IconAnimHelper
 			, m_frame(0)
 			, m_delay(0)
 			, m_last_valid_frame(0)
+			, m_displayed_frame(0)
 		{ }
 
 		explicit IconAnimHelper(const IconAnimData *iconAnimData)
@@ -31,6 +32,7 @@ class IconAnimHelper
 			, m_frame(0)
 			, m_delay(0)
 			, m_last_valid_frame(0)
+			, m_displayed_frame(0)
 		{
 			reset();
 		}
@@ -108,12 +110,51 @@ class IconAnimHelper
 		 */
 		int nextFrame(int *pDelay);
 
+		/**
+		 * Advance the animation by one frame for a UI timer tick.
+		 *
+		 * UI frontends pre-convert all frames to the toolkit's image
+		 * format once, so the timer callback only needs to swap the
+		 * displayed handle when the frame number actually changes.
+		 * This function tracks the displayed frame internally and
+		 * returns -1 if no swap is necessary.
+		 *
+		 * @param pDelay	[out] Pointer to int to store the frame delay, in milliseconds.
+		 * @return Next frame number, or -1 if the displayed frame hasn't changed.
+		 */
+		int tick(int *pDelay);
+
+		/**
+		 * Get the frame number currently displayed by the UI.
+		 * This is updated by tick() and resetDisplayedFrame().
+		 * @return Frame number.
+		 */
+		int displayedFrame(void) const
+		{
+			return m_displayed_frame;
+		}
+
+		/**
+		 * Reset the displayed frame number.
+		 * This does NOT advance the animation sequence.
+		 */
+		void resetDisplayedFrame(void)
+		{
+			m_displayed_frame = 0;
+		}
+
 	protected:
 		const IconAnimData *m_iconAnimData;
 		int m_seq_idx;		// Current sequence index.
 		int m_frame;		// Current frame.
 		int m_delay;		// Current frame delay. (ms)
 		int m_last_valid_frame;	// Last frame that had a valid image.
+		int m_displayed_frame;	// Frame currently displayed by the UI.
+
+		// Resolved frame for each sequence step.
+		// Precomputed by reset(), so steps that reference a
+		// missing frame don't re-check validity on every tick.
+		std::array<uint8_t, IconAnimData::MAX_SEQUENCE> m_resolved;
 };
 
 }
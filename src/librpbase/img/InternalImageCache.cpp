@@ -0,0 +1,141 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * InternalImageCache.cpp: Process-wide cache for internal images.         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "InternalImageCache.hpp"
+#include "img/rp_image.hpp"
+
+// librpthreads
+#include "librpthreads/Mutex.hpp"
+
+// C++ STL classes.
+#include <list>
+using std::list;
+using std::string;
+
+// librptexture
+using LibRpTexture::rp_image;
+
+namespace LibRpBase {
+
+namespace {
+
+// Maximum number of cached images.
+static const unsigned int CACHE_MAX_ENTRIES = 16U;
+
+struct CacheEntry {
+	string key;	// File identity.
+	int imageType;	// RomData image type.
+	rp_image *img;	// Cached image. (owned by the cache)
+};
+
+struct CacheState {
+	Mutex mutex;
+	// LRU list: front is most recently used.
+	list<CacheEntry> entries;
+
+	~CacheState() {
+		for (CacheEntry &entry : entries) {
+			delete entry.img;
+		}
+	}
+};
+
+/**
+ * Get the cache state singleton.
+ * @return Cache state.
+ */
+CacheState &cacheState(void)
+{
+	// C++11 guarantees thread-safe initialization
+	// of function-local static objects.
+	static CacheState state;
+	return state;
+}
+
+}
+
+/**
+ * Look up a cached internal image.
+ * @param key Cache key. (file identity; if empty, no lookup is done)
+ * @param imageType RomData image type.
+ * @return Duplicate of the cached image (owned by the caller), or nullptr if not cached.
+ */
+rp_image *InternalImageCache::lookup(const string &key, int imageType)
+{
+	if (key.empty()) {
+		// No key. Can't look it up.
+		return nullptr;
+	}
+
+	CacheState &state = cacheState();
+	MutexLocker locker(state.mutex);
+	for (auto iter = state.entries.begin(); iter != state.entries.end(); ++iter) {
+		if (iter->imageType != imageType || iter->key != key)
+			continue;
+
+		// Found it. Move it to the front of the LRU list.
+		state.entries.splice(state.entries.begin(), state.entries, iter);
+
+		// NOTE: dup() shares the reference-counted pixel backend,
+		// so this doesn't copy the pixel data.
+		return iter->img->dup();
+	}
+
+	// Not cached.
+	return nullptr;
+}
+
+/**
+ * Add an internal image to the cache.
+ * A duplicate of the image is cached; the caller retains
+ * ownership of the original.
+ * @param key Cache key. (file identity; if empty, the image is not cached)
+ * @param imageType RomData image type.
+ * @param img Image to cache.
+ */
+void InternalImageCache::add(const string &key, int imageType, const rp_image *img)
+{
+	if (key.empty() || !img || !img->isValid()) {
+		// Nothing to cache.
+		return;
+	}
+
+	rp_image *const dupImg = img->dup();
+	if (!dupImg) {
+		// Unable to duplicate the image.
+		return;
+	}
+
+	CacheState &state = cacheState();
+	MutexLocker locker(state.mutex);
+
+	// Remove any existing entry for this key and image type.
+	for (auto iter = state.entries.begin(); iter != state.entries.end(); ++iter) {
+		if (iter->imageType == imageType && iter->key == key) {
+			delete iter->img;
+			state.entries.erase(iter);
+			break;
+		}
+	}
+
+	// Evict the least recently used entries if the cache is full.
+	while (state.entries.size() >= CACHE_MAX_ENTRIES) {
+		delete state.entries.back().img;
+		state.entries.pop_back();
+	}
+
+	// Add the new entry to the front of the LRU list.
+	CacheEntry entry;
+	entry.key = key;
+	entry.imageType = imageType;
+	entry.img = dupImg;
+	state.entries.push_front(std::move(entry));
+}
+
+}
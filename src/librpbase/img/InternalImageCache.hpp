@@ -0,0 +1,68 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * InternalImageCache.hpp: Process-wide cache for internal images.         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPBASE_IMG_INTERNALIMAGECACHE_HPP__
+#define __ROMPROPERTIES_LIBRPBASE_IMG_INTERNALIMAGECACHE_HPP__
+
+#include "common.h"
+
+// C++ includes.
+#include <string>
+
+namespace LibRpTexture {
+	class rp_image;
+}
+
+namespace LibRpBase {
+
+/**
+ * Process-wide cache for decoded internal images.
+ *
+ * File browsers typically open the same file several times in a row:
+ * once for the thumbnail, again for the property page, and again for
+ * the drag image. Each open is a new RomData instance, so the icon
+ * was decoded from scratch every time. This cache keeps the last few
+ * decoded images, keyed by file identity and image type, so repeated
+ * opens reuse the decoded image.
+ *
+ * Cached images are stored and returned as dup()'d copies. Image
+ * backends are reference-counted, so the duplicates share pixel data
+ * with the cached image, and the cache and callers can delete their
+ * copies independently.
+ */
+class InternalImageCache
+{
+	private:
+		// Static class.
+		InternalImageCache();
+		~InternalImageCache();
+		RP_DISABLE_COPY(InternalImageCache)
+
+	public:
+		/**
+		 * Look up a cached internal image.
+		 * @param key Cache key. (file identity; if empty, no lookup is done)
+		 * @param imageType RomData image type.
+		 * @return Duplicate of the cached image (owned by the caller), or nullptr if not cached.
+		 */
+		static LibRpTexture::rp_image *lookup(const std::string &key, int imageType);
+
+		/**
+		 * Add an internal image to the cache.
+		 * A duplicate of the image is cached; the caller retains
+		 * ownership of the original.
+		 * @param key Cache key. (file identity; if empty, the image is not cached)
+		 * @param imageType RomData image type.
+		 * @param img Image to cache.
+		 */
+		static void add(const std::string &key, int imageType, const LibRpTexture::rp_image *img);
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPBASE_IMG_INTERNALIMAGECACHE_HPP__ */
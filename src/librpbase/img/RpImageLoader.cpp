@@ -63,9 +63,12 @@ const uint8_t RpImageLoaderPrivate::jpeg_magic_2[4] =
  * with untrusted images!
  *
  * @param file IRpFile to load from.
+ * @param req_size Requested minimum size, in pixels. (0 for full size)
+ *                 Formats that support scaled decoding (JPEG) may
+ *                 decode at a reduced scale that still covers it.
  * @return rp_image*, or nullptr on error.
  */
-rp_image *RpImageLoader::loadUnchecked(IRpFile *file)
+rp_image *RpImageLoader::loadUnchecked(IRpFile *file, int req_size)
 {
 	file->rewind();
 
@@ -87,7 +90,7 @@ rp_image *RpImageLoader::loadUnchecked(IRpFile *file)
 			  sizeof(RpImageLoaderPrivate::jpeg_magic_2)))
 		{
 			// Found a JPEG image.
-			return RpJpeg::loadUnchecked(file);
+			return RpJpeg::loadUnchecked(file, req_size);
 		}
 #endif /* HAVE_JPEG */
 	}
@@ -103,9 +106,12 @@ rp_image *RpImageLoader::loadUnchecked(IRpFile *file)
  * it doesn't have any errors.
  *
  * @param file IRpFile to load from.
+ * @param req_size Requested minimum size, in pixels. (0 for full size)
+ *                 Formats that support scaled decoding (JPEG) may
+ *                 decode at a reduced scale that still covers it.
  * @return rp_image*, or nullptr on error.
  */
-rp_image *RpImageLoader::load(IRpFile *file)
+rp_image *RpImageLoader::load(IRpFile *file, int req_size)
 {
 	file->rewind();
 
@@ -127,7 +133,7 @@ rp_image *RpImageLoader::load(IRpFile *file)
 			  sizeof(RpImageLoaderPrivate::jpeg_magic_2)))
 		{
 			// Found a JPEG image.
-			return RpJpeg::load(file);
+			return RpJpeg::load(file, req_size);
 		}
 #endif /* HAVE_JPEG */
 	}
@@ -36,9 +36,12 @@ class RpImageLoader
 		 * with untrusted images!
 		 *
 		 * @param file IRpFile to load from.
+		 * @param req_size Requested minimum size, in pixels. (0 for full size)
+		 *                 Formats that support scaled decoding (JPEG) may
+		 *                 decode at a reduced scale that still covers it.
 		 * @return rp_image*, or nullptr on error.
 		 */
-		static LibRpTexture::rp_image *loadUnchecked(LibRpFile::IRpFile *file);
+		static LibRpTexture::rp_image *loadUnchecked(LibRpFile::IRpFile *file, int req_size = 0);
 
 		/**
 		 * Load an image from an IRpFile.
@@ -47,9 +50,12 @@ class RpImageLoader
 		 * it doesn't have any errors.
 		 *
 		 * @param file IRpFile to load from.
+		 * @param req_size Requested minimum size, in pixels. (0 for full size)
+		 *                 Formats that support scaled decoding (JPEG) may
+		 *                 decode at a reduced scale that still covers it.
 		 * @return rp_image*, or nullptr on error.
 		 */
-		static LibRpTexture::rp_image *load(LibRpFile::IRpFile *file);
+		static LibRpTexture::rp_image *load(LibRpFile::IRpFile *file, int req_size = 0);
 };
 
 }
@@ -21,9 +21,9 @@ using LibRpFile::IRpFile;
 using LibRpTexture::rp_image;
 using LibRpTexture::argb32_t;
 
-#ifdef RPJPEG_HAS_SSSE3
+#if defined(RPJPEG_HAS_SSSE3) || defined(RPJPEG_HAS_AVX2)
 # include "librpcpu/cpuflags_x86.h"
-#endif /* RPJPEG_HAS_SSSE3 */
+#endif /* RPJPEG_HAS_SSSE3 || RPJPEG_HAS_AVX2 */
 
 // C includes. (C++ namespace)
 #include <csetjmp>
@@ -214,10 +214,15 @@ void RpJpegPrivate::jpeg_IRpFile_src(j_decompress_ptr cinfo, IRpFile *infile)
  * This image is NOT checked for issues; do not use
  * with untrusted images!
  *
+ * If a target size is specified, the image is decoded at
+ * 1/2, 1/4, or 1/8 scale using libjpeg's DCT scaling if
+ * doing so still yields at least the target size.
+ *
  * @param file IRpFile to load from.
+ * @param req_size Requested minimum size, in pixels. (0 for full size)
  * @return rp_image*, or nullptr on error.
  */
-rp_image *RpJpeg::loadUnchecked(IRpFile *file)
+rp_image *RpJpeg::loadUnchecked(IRpFile *file, int req_size)
 {
 	if (!file)
 		return nullptr;
@@ -327,6 +332,26 @@ rp_image *RpJpeg::loadUnchecked(IRpFile *file)
 			break;
 	}
 
+	// Check if DCT scaling can be used to decode at a reduced size.
+	// 1/2, 1/4, and 1/8 scale decoding is nearly free in libjpeg,
+	// and thumbnail targets are much smaller than e.g. 1024px
+	// cover scans from GameTDB.
+	if (req_size > 0) {
+		unsigned int scale_denom = 1;
+		while (scale_denom < 8) {
+			const unsigned int next = scale_denom * 2;
+			if (cinfo.image_width / next < static_cast<unsigned int>(req_size) ||
+			    cinfo.image_height / next < static_cast<unsigned int>(req_size))
+			{
+				// Scaling any further would drop below the target size.
+				break;
+			}
+			scale_denom = next;
+		}
+		cinfo.scale_num = 1;
+		cinfo.scale_denom = scale_denom;
+	}
+
 	/** Step 5: Start decompressor. **/
 	// We can ignore the return value since suspension is not possible
 	// with the stdio data source (and IRpFile).
@@ -394,7 +419,7 @@ rp_image *RpJpeg::loadUnchecked(IRpFile *file)
 				return nullptr;
 			}
 
-			img = new rp_image(cinfo.image_width, cinfo.image_height, rp_image::FORMAT_ARGB32);
+			img = new rp_image(cinfo.output_width, cinfo.output_height, rp_image::FORMAT_ARGB32);
 			if (!img->isValid()) {
 				// Could not allocate the image.
 				jpeg_destroy_decompress(&cinfo);
@@ -415,7 +440,7 @@ rp_image *RpJpeg::loadUnchecked(IRpFile *file)
 				return nullptr;
 			}
 
-			img = new rp_image(cinfo.image_width, cinfo.image_height, rp_image::FORMAT_ARGB32);
+			img = new rp_image(cinfo.output_width, cinfo.output_height, rp_image::FORMAT_ARGB32);
 			if (!img->isValid()) {
 				// Could not allocate the image.
 				jpeg_destroy_decompress(&cinfo);
@@ -434,7 +459,7 @@ rp_image *RpJpeg::loadUnchecked(IRpFile *file)
 				return nullptr;
 			}
 
-			img = new rp_image(cinfo.image_width, cinfo.image_height, rp_image::FORMAT_ARGB32);
+			img = new rp_image(cinfo.output_width, cinfo.output_height, rp_image::FORMAT_ARGB32);
 			if (!img->isValid()) {
 				// Could not allocate the image.
 				jpeg_destroy_decompress(&cinfo);
@@ -468,6 +493,12 @@ rp_image *RpJpeg::loadUnchecked(IRpFile *file)
 				// NOTE: libjpeg-turbo has SSE2-optimized * to ARGB conversion,
 				// which is preferred because it usually skips an intermediate
 				// conversion step.
+#ifdef RPJPEG_HAS_AVX2
+				if (RP_CPU_HasAVX2()) {
+					RpJpegPrivate::decodeBGRtoARGB_avx2(img, &cinfo, buffer);
+					break;
+				}
+#endif /* RPJPEG_HAS_AVX2 */
 #ifdef RPJPEG_HAS_SSSE3
 				if (RP_CPU_HasSSSE3()) {
 					RpJpegPrivate::decodeBGRtoARGB(img, &cinfo, buffer);
@@ -598,16 +629,21 @@ rp_image *RpJpeg::loadUnchecked(IRpFile *file)
  * This image is verified with various tools to ensure
  * it doesn't have any errors.
  *
+ * If a target size is specified, the image is decoded at
+ * 1/2, 1/4, or 1/8 scale using libjpeg's DCT scaling if
+ * doing so still yields at least the target size.
+ *
  * @param file IRpFile to load from.
+ * @param req_size Requested minimum size, in pixels. (0 for full size)
  * @return rp_image*, or nullptr on error.
  */
-rp_image *RpJpeg::load(IRpFile *file)
+rp_image *RpJpeg::load(IRpFile *file, int req_size)
 {
 	if (!file)
 		return nullptr;
 
 	// FIXME: Add a JPEG equivalent of pngcheck().
-	return loadUnchecked(file);
+	return loadUnchecked(file, req_size);
 }
 
 }
@@ -35,10 +35,15 @@ class RpJpeg
 		 * This image is NOT checked for issues; do not use
 		 * with untrusted images!
 		 *
+		 * If a target size is specified, the image is decoded at
+		 * 1/2, 1/4, or 1/8 scale using libjpeg's DCT scaling if
+		 * doing so still yields at least the target size.
+		 *
 		 * @param file IRpFile to load from.
+		 * @param req_size Requested minimum size, in pixels. (0 for full size)
 		 * @return rp_image*, or nullptr on error.
 		 */
-		static LibRpTexture::rp_image *loadUnchecked(LibRpFile::IRpFile *file);
+		static LibRpTexture::rp_image *loadUnchecked(LibRpFile::IRpFile *file, int req_size = 0);
 
 		/**
 		 * Load a JPEG image from an IRpFile.
@@ -46,10 +51,15 @@ class RpJpeg
 		 * This image is verified with various tools to ensure
 		 * it doesn't have any errors.
 		 *
+		 * If a target size is specified, the image is decoded at
+		 * 1/2, 1/4, or 1/8 scale using libjpeg's DCT scaling if
+		 * doing so still yields at least the target size.
+		 *
 		 * @param file IRpFile to load from.
+		 * @param req_size Requested minimum size, in pixels. (0 for full size)
 		 * @return rp_image*, or nullptr on error.
 		 */
-		static LibRpTexture::rp_image *load(LibRpFile::IRpFile *file);
+		static LibRpTexture::rp_image *load(LibRpFile::IRpFile *file, int req_size = 0);
 };
 
 }
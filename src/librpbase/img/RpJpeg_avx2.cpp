@@ -0,0 +1,90 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpbase)                        *
+ * RpJpeg.cpp: JPEG image handler.                                         *
+ * AVX2-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RpJpeg_p.hpp"
+
+// librptexture
+using LibRpTexture::rp_image;
+using LibRpTexture::argb32_t;
+
+// AVX2 intrinsics.
+#include <immintrin.h>
+
+namespace LibRpBase {
+
+/**
+ * Decode a 24-bit BGR JPEG to 32-bit ARGB.
+ * AVX2-optimized version.
+ * NOTE: This function should ONLY be called from RpJpeg::loadUnchecked().
+ * @param img		[in/out] rp_image.
+ * @param cinfo		[in/out] JPEG decompression struct.
+ * @param buffer 	[in/out] Line buffer. (Must be 16-byte aligned!)
+ */
+void RpJpegPrivate::decodeBGRtoARGB_avx2(rp_image *RESTRICT img, jpeg_decompress_struct *RESTRICT cinfo, JSAMPARRAY buffer)
+{
+	ASSERT_ALIGNMENT(16, buffer);
+	assert(img->format() == rp_image::FORMAT_ARGB32);
+
+	// Widened version of the SSSE3 kernel:
+	// _mm256_shuffle_epi8() operates per 128-bit lane, so each lane
+	// is loaded with 12 source bytes and expanded to 4 pixels, for
+	// 8 pixels per shuffle instead of 4.
+	// NOTE: The conversion happens in the scanline loop, right after
+	// libjpeg emits each row, so the data is still hot in L1.
+	const __m256i shuf_mask = _mm256_setr_epi8(
+		 2, 1, 0,-1,  5, 4, 3,-1,  8, 7, 6,-1, 11,10, 9,-1,
+		 2, 1, 0,-1,  5, 4, 3,-1,  8, 7, 6,-1, 11,10, 9,-1);
+	const __m256i alpha_mask = _mm256_set1_epi32(0xFF000000);
+	argb32_t *dest = static_cast<argb32_t*>(img->bits());
+	const int dest_stride_adj = (img->stride() / sizeof(argb32_t)) - img->width();
+	while (cinfo->output_scanline < cinfo->output_height) {
+		jpeg_read_scanlines(cinfo, buffer, 1);
+		const uint8_t *src = buffer[0];
+
+		// Process 16 pixels (48 bytes) per iteration using AVX2.
+		unsigned int x = cinfo->output_width;
+		for (; x > 15; x -= 16, dest += 16, src += 16*3) {
+			const __m128i *xmm_src = reinterpret_cast<const __m128i*>(src);
+			__m256i *ymm_dest = reinterpret_cast<__m256i*>(dest);
+
+			__m128i sa = _mm_load_si128(&xmm_src[0]);
+			__m128i sb = _mm_load_si128(&xmm_src[1]);
+			__m128i sc = _mm_load_si128(&xmm_src[2]);
+
+			// Lane 0: bytes 0-11; lane 1: bytes 12-23.
+			__m256i val = _mm256_inserti128_si256(_mm256_castsi128_si256(sa),
+				_mm_alignr_epi8(sb, sa, 12), 1);
+			val = _mm256_shuffle_epi8(val, shuf_mask);
+			val = _mm256_or_si256(val, alpha_mask);
+			_mm256_storeu_si256(&ymm_dest[0], val);
+
+			// Lane 0: bytes 24-35; lane 1: bytes 36-47.
+			val = _mm256_inserti128_si256(
+				_mm256_castsi128_si256(_mm_alignr_epi8(sc, sb, 8)),
+				_mm_alignr_epi8(sc, sc, 4), 1);
+			val = _mm256_shuffle_epi8(val, shuf_mask);
+			val = _mm256_or_si256(val, alpha_mask);
+			_mm256_storeu_si256(&ymm_dest[1], val);
+		}
+
+		// Remaining pixels.
+		for (; x > 0; x--, dest++, src += 3) {
+			dest->b = src[2];
+			dest->g = src[1];
+			dest->r = src[0];
+			dest->a = 0xFF;
+		}
+
+		// Next line.
+		dest += dest_stride_adj;
+	}
+}
+
+}
@@ -42,10 +42,15 @@ namespace LibRpBase {
  * with untrusted images!
  *
  * @param file IRpFile to load from.
+ * @param req_size Requested minimum size, in pixels. (0 for full size)
  * @return rp_image*, or nullptr on error.
  */
-rp_image *RpJpeg::loadUnchecked(IRpFile *file)
+rp_image *RpJpeg::loadUnchecked(IRpFile *file, int req_size)
 {
+	// NOTE: GDI+ doesn't support scaled JPEG decoding,
+	// so the requested size is ignored here.
+	RP_UNUSED(req_size);
+
 	if (!file)
 		return nullptr;
 
@@ -81,15 +86,16 @@ rp_image *RpJpeg::loadUnchecked(IRpFile *file)
  * it doesn't have any errors.
  *
  * @param file IRpFile to load from.
+ * @param req_size Requested minimum size, in pixels. (0 for full size)
  * @return rp_image*, or nullptr on error.
  */
-rp_image *RpJpeg::load(IRpFile *file)
+rp_image *RpJpeg::load(IRpFile *file, int req_size)
 {
 	if (!file)
 		return nullptr;
 
 	// FIXME: Add a JPEG equivalent of pngcheck().
-	return loadUnchecked(file);
+	return loadUnchecked(file, req_size);
 }
 
 }
@@ -35,6 +35,7 @@
 #if defined(__i386__) || defined(__x86_64__) || \
     defined(_M_IX86) || defined(_M_X64)
 # define RPJPEG_HAS_SSSE3 1
+# define RPJPEG_HAS_AVX2 1
 #endif
 
 namespace LibRpFile {
@@ -134,6 +135,18 @@ class RpJpegPrivate
 		 */
 		static void decodeBGRtoARGB(LibRpTexture::rp_image *RESTRICT img, jpeg_decompress_struct *RESTRICT cinfo, JSAMPARRAY buffer);
 #endif /* RPJPEG_HAS_SSSE3 */
+
+#ifdef RPJPEG_HAS_AVX2
+		/**
+		 * Decode a 24-bit BGR JPEG to 32-bit ARGB.
+		 * AVX2-optimized version.
+		 * NOTE: This function should ONLY be called from RpJpeg::loadUnchecked().
+		 * @param img		[in/out] rp_image.
+		 * @param cinfo		[in/out] JPEG decompression struct.
+		 * @param buffer 	[in/out] Line buffer. (Must be 16-byte aligned!)
+		 */
+		static void decodeBGRtoARGB_avx2(LibRpTexture::rp_image *RESTRICT img, jpeg_decompress_struct *RESTRICT cinfo, JSAMPARRAY buffer);
+#endif /* RPJPEG_HAS_AVX2 */
 };
 
 }
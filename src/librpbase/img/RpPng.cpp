@@ -95,8 +95,22 @@ class RpPngPrivate
 	public:
 		/** I/O functions. **/
 
+		// Buffered reader for libpng.
+		// libpng issues many small reads (4-byte chunk lengths, etc.),
+		// which is slow if each one goes to the IRpFile directly,
+		// especially for files on network shares. Buffer the reads
+		// so most of them are satisfied from memory.
+		static const unsigned int PNG_INPUT_BUF_SIZE = 4096;
+		struct PngBufferedReader {
+			LibRpFile::IRpFile *file;	// Source stream.
+			size_t pos;			// Current position in buffer.
+			size_t len;			// Amount of valid data in buffer.
+			uint8_t buffer[PNG_INPUT_BUF_SIZE];
+		};
+
 		/**
 		 * libpng I/O read handler for IRpFile.
+		 * NOTE: io_ptr must be a PngBufferedReader.
 		 * @param png_ptr	[in]  PNG pointer.
 		 * @param data		[out] Buffer for the data to read.
 		 * @param length	[in]  Size of data.
@@ -160,26 +174,56 @@ class RpPngPrivate
 
 /**
  * libpng I/O handler for IRpFile.
+ * NOTE: io_ptr must be a PngBufferedReader.
  * @param png_ptr PNG pointer.
  * @param data		[out] Buffer for the data to read.
  * @param length	[in]  Size of data.
  */
 void PNGCAPI RpPngPrivate::png_io_IRpFile_read(png_structp png_ptr, png_bytep data, png_size_t length)
 {
-	// Assuming io_ptr is an IRpFile*.
-	IRpFile *file = static_cast<IRpFile*>(png_get_io_ptr(png_ptr));
-	if (!file)
+	// Assuming io_ptr is a PngBufferedReader*.
+	PngBufferedReader *const reader = static_cast<PngBufferedReader*>(png_get_io_ptr(png_ptr));
+	if (!reader)
 		return;
 
-	// Read data from the IRpFile.
-	size_t sz = file->read(data, length);
-	if (sz != length) {
+	size_t total = 0;
+	while (total < length) {
+		if (reader->pos < reader->len) {
+			// Copy from the buffer.
+			const size_t copy_len = std::min(
+				static_cast<size_t>(length - total),
+				reader->len - reader->pos);
+			memcpy(&data[total], &reader->buffer[reader->pos], copy_len);
+			reader->pos += copy_len;
+			total += copy_len;
+			continue;
+		}
+
+		// Buffer is empty.
+		const size_t remaining = length - total;
+		if (remaining >= PNG_INPUT_BUF_SIZE) {
+			// Large read, e.g. IDAT data.
+			// Read directly into the destination.
+			total += reader->file->read(&data[total], remaining);
+			break;
+		}
+
+		// Refill the buffer.
+		reader->pos = 0;
+		reader->len = reader->file->read(reader->buffer, PNG_INPUT_BUF_SIZE);
+		if (reader->len == 0) {
+			// EOF or read error.
+			break;
+		}
+	}
+
+	if (total != length) {
 		// Short read.
 		// TODO: longjmp()?
 
-		if (sz < length) {
+		if (total < length) {
 			// Zero out the rest of the buffer.
-			memset(&data[sz], 0, length-sz);
+			memset(&data[total], 0, length-total);
 		}
 	}
 }
@@ -547,7 +591,13 @@ rp_image *RpPng::loadUnchecked(IRpFile *file)
 #endif /* PNG_WARNINGS_SUPPORTED */
 
 	// Initialize the custom I/O handler for IRpFile.
-	png_set_read_fn(png_ptr, file, RpPngPrivate::png_io_IRpFile_read);
+	// NOTE: Reads are buffered, since libpng issues many
+	// small reads for chunk headers and CRCs.
+	RpPngPrivate::PngBufferedReader reader;
+	reader.file = file;
+	reader.pos = 0;
+	reader.len = 0;
+	png_set_read_fn(png_ptr, &reader, RpPngPrivate::png_io_IRpFile_read);
 
 	// Call the actual PNG image reading function.
 	rp_image *img = RpPngPrivate::loadPng(png_ptr, info_ptr);
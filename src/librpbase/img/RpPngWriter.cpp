@@ -118,18 +118,21 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(IRpFile *file, int width, int height, rp_image::Format format)
 			: lastError(0), file(nullptr), imageTag(IMGT_INVALID)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, compressionProfile(RpPngWriter::COMPRESS_DEFAULT)
 		{
 			init(file, width, height, format);
 		}
 		RpPngWriterPrivate(IRpFile *file, const rp_image *img)
 			: lastError(0), file(nullptr), imageTag(IMGT_INVALID)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, compressionProfile(RpPngWriter::COMPRESS_DEFAULT)
 		{
 			init(file, img);
 		}
 		RpPngWriterPrivate(IRpFile *file, const IconAnimData *iconAnimData)
 			: lastError(0), file(nullptr), imageTag(IMGT_INVALID)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, compressionProfile(RpPngWriter::COMPRESS_DEFAULT)
 		{
 			init(file, iconAnimData);
 		}
@@ -137,6 +140,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const char *filename, int width, int height, rp_image::Format format)
 			: lastError(0), file(nullptr), imageTag(IMGT_INVALID)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, compressionProfile(RpPngWriter::COMPRESS_DEFAULT)
 		{
 			RpFile *const file = (filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(file, width, height, format);
@@ -147,6 +151,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const char *filename, const rp_image *img)
 			: lastError(0), file(nullptr), imageTag(IMGT_INVALID)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, compressionProfile(RpPngWriter::COMPRESS_DEFAULT)
 		{
 			RpFile *const file = (filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(file, img);
@@ -157,6 +162,7 @@ class RpPngWriterPrivate
 		RpPngWriterPrivate(const char *filename, const IconAnimData *iconAnimData)
 			: lastError(0), file(nullptr), imageTag(IMGT_INVALID)
 			, png_ptr(nullptr), info_ptr(nullptr), IHDR_written(false)
+			, compressionProfile(RpPngWriter::COMPRESS_DEFAULT)
 		{
 			RpFile *const file = (filename ? new RpFile(filename, RpFile::FM_CREATE_WRITE) : nullptr);
 			init(file, iconAnimData);
@@ -253,6 +259,12 @@ class RpPngWriterPrivate
 				// Get the rp_image's sBIT data.
 				// If alpha == 0, we can write RGB and/or skip tRNS.
 				has_sBIT = (img->get_sBIT(&sBIT) == 0);
+				if (!has_sBIT && this->format == rp_image::FORMAT_ARGB32) {
+					// The decoder didn't provide sBIT metadata.
+					// Analyze the pixel data instead, so fully-opaque
+					// images can still be written without an alpha channel.
+					has_sBIT = (img->analyze_sBIT(&sBIT) == 0);
+				}
 				skip_alpha = (has_sBIT && sBIT.alpha == 0);
 #endif /* PNG_sBIT_SUPPORTED */
 			}
@@ -281,6 +293,34 @@ class RpPngWriterPrivate
 		// Current state.
 		bool IHDR_written;
 
+		// Compression profile.
+		// Must be set before write_IHDR().
+		RpPngWriter::CompressionProfile compressionProfile;
+
+		// Buffered libpng output.
+		// libpng emits each chunk as several small writes:
+		// length, chunk type, data, and CRC. Coalescing them
+		// here cuts the underlying write calls per chunk down
+		// to one, which matters when the sink is a pipe.
+		static const unsigned int PNG_OUTPUT_BUF_SIZE = 4096;
+		struct PngBufferedWriter {
+			IRpFile *file;	// Destination file.
+			size_t len;	// Amount of buffered data.
+			uint8_t buffer[PNG_OUTPUT_BUF_SIZE];
+		};
+		PngBufferedWriter bufWriter;
+
+		/**
+		 * Flush the buffered libpng output to the file.
+		 */
+		inline void flushOutputBuffer(void)
+		{
+			if (bufWriter.file && bufWriter.len > 0) {
+				bufWriter.file->write(bufWriter.buffer, bufWriter.len);
+				bufWriter.len = 0;
+			}
+		}
+
 	public:
 		/**
 		 * Initialize the PNG write structs.
@@ -297,6 +337,7 @@ class RpPngWriterPrivate
 
 		/**
 		 * libpng I/O write handler for IRpFile.
+		 * NOTE: io_ptr must be a PngBufferedWriter.
 		 * @param png_ptr	[in] PNG pointer.
 		 * @param data		[in] Data to write.
 		 * @param length	[in] Size of data.
@@ -305,6 +346,7 @@ class RpPngWriterPrivate
 
 		/**
 		 * libpng I/O flush handler for IRpFile.
+		 * NOTE: io_ptr must be a PngBufferedWriter.
 		 * @param png_ptr	[in] PNG pointer.
 		 */
 		static void PNGCAPI png_io_IRpFile_flush(png_structp png_ptr);
@@ -596,7 +638,9 @@ int RpPngWriterPrivate::init_png_write_structs(void)
 	}
 
 	// Initialize the custom I/O handler for IRpFile.
-	png_set_write_fn(png_ptr, file,
+	bufWriter.file = file;
+	bufWriter.len = 0;
+	png_set_write_fn(png_ptr, &bufWriter,
 		png_io_IRpFile_write,
 		png_io_IRpFile_flush);
 	return 0;
@@ -627,7 +671,9 @@ void RpPngWriterPrivate::close(void)
 		info_ptr = nullptr;
 	}
 
-	// unref() the file.
+	// Flush any buffered output, then unref() the file.
+	flushOutputBuffer();
+	bufWriter.file = nullptr;
 	if (this->file) {
 		this->file->unref();
 		this->file = nullptr;
@@ -636,33 +682,58 @@ void RpPngWriterPrivate::close(void)
 
 /**
  * libpng I/O write handler for IRpFile.
+ * NOTE: io_ptr must be a PngBufferedWriter.
  * @param png_ptr	[in] PNG pointer.
  * @param data		[in] Data to write.
  * @param length	[in] Size of data.
  */
 void PNGCAPI RpPngWriterPrivate::png_io_IRpFile_write(png_structp png_ptr, png_bytep data, png_size_t length)
 {
-	// Assuming io_ptr is an IRpFile*.
-	IRpFile *file = static_cast<IRpFile*>(png_get_io_ptr(png_ptr));
-	if (!file)
+	// Assuming io_ptr is a PngBufferedWriter*.
+	PngBufferedWriter *const writer = static_cast<PngBufferedWriter*>(png_get_io_ptr(png_ptr));
+	if (!writer || !writer->file)
 		return;
 
-	// Write data to the IRpFile.
 	// TODO: Error handling?
-	file->write(data, length);
+	if (length >= PNG_OUTPUT_BUF_SIZE) {
+		// Large write. Flush the buffer,
+		// then write directly to the file.
+		if (writer->len > 0) {
+			writer->file->write(writer->buffer, writer->len);
+			writer->len = 0;
+		}
+		writer->file->write(data, length);
+		return;
+	}
+
+	if (writer->len + length > PNG_OUTPUT_BUF_SIZE) {
+		// Not enough space left. Flush the buffer first.
+		writer->file->write(writer->buffer, writer->len);
+		writer->len = 0;
+	}
+
+	// Append the data to the buffer.
+	memcpy(&writer->buffer[writer->len], data, length);
+	writer->len += length;
 }
 
 /**
  * libpng I/O flush handler for IRpFile.
+ * NOTE: io_ptr must be a PngBufferedWriter.
  * @param png_ptr	[in] PNG pointer.
  */
 void PNGCAPI RpPngWriterPrivate::png_io_IRpFile_flush(png_structp png_ptr)
 {
-	// Assuming io_ptr is an IRpFile*.
-	IRpFile *const file = static_cast<IRpFile*>(png_get_io_ptr(png_ptr));
-	if (!file)
+	// Assuming io_ptr is a PngBufferedWriter*.
+	PngBufferedWriter *const writer = static_cast<PngBufferedWriter*>(png_get_io_ptr(png_ptr));
+	if (!writer || !writer->file)
 		return;
 
+	// Flush the buffered output.
+	if (writer->len > 0) {
+		writer->file->write(writer->buffer, writer->len);
+		writer->len = 0;
+	}
 	// TODO: IRpFile::flush()
 }
 
@@ -837,6 +908,68 @@ int RpPngWriterPrivate::write_IDAT(void)
  *
  * @return 0 on success; negative POSIX error code on error.
  */
+/**
+ * Find the minimal rectangle that differs between two frames.
+ *
+ * Both frames must have the same dimensions and format.
+ * Used by write_IDAT_APNG() to write sub-rectangle fdATs
+ * instead of recompressing the full frame every time.
+ *
+ * @param prev	[in] Previous frame.
+ * @param img	[in] Current frame.
+ * @param bpp	[in] Bytes per pixel.
+ * @param pRect	[out] Dirty rectangle: x, y, width, height.
+ * @return True if the frames differ; false if they're identical.
+ */
+static bool apng_find_dirty_rect(const rp_image *prev, const rp_image *img, int bpp, int pRect[4])
+{
+	const int width = img->width();
+	const int height = img->height();
+	const size_t row_bytes = static_cast<size_t>(width) * bpp;
+
+	// Find the first and last rows that differ.
+	int y0 = 0;
+	for (; y0 < height; y0++) {
+		if (memcmp(prev->scanLine(y0), img->scanLine(y0), row_bytes) != 0)
+			break;
+	}
+	if (y0 == height) {
+		// Frames are identical.
+		return false;
+	}
+	int y1 = height - 1;
+	for (; y1 > y0; y1--) {
+		if (memcmp(prev->scanLine(y1), img->scanLine(y1), row_bytes) != 0)
+			break;
+	}
+
+	// Find the first and last columns that differ
+	// within the dirty rows.
+	int x0 = width, x1 = -1;
+	for (int y = y0; y <= y1; y++) {
+		const uint8_t *pPrev = static_cast<const uint8_t*>(prev->scanLine(y));
+		const uint8_t *pCur = static_cast<const uint8_t*>(img->scanLine(y));
+		for (int x = 0; x < x0; x++) {
+			if (memcmp(&pPrev[x*bpp], &pCur[x*bpp], bpp) != 0) {
+				x0 = x;
+				break;
+			}
+		}
+		for (int x = width-1; x > x1; x--) {
+			if (memcmp(&pPrev[x*bpp], &pCur[x*bpp], bpp) != 0) {
+				x1 = x;
+				break;
+			}
+		}
+	}
+
+	pRect[0] = x0;
+	pRect[1] = y0;
+	pRect[2] = x1 - x0 + 1;
+	pRect[3] = y1 - y0 + 1;
+	return true;
+}
+
 int RpPngWriterPrivate::write_IDAT_APNG(void)
 {
 	assert(file != nullptr);
@@ -884,20 +1017,46 @@ int RpPngWriterPrivate::write_IDAT_APNG(void)
 		return -lastError;
 	}
 
+	// Bytes per pixel. Used for frame diffing.
+	const int bpp = (cache.format == rp_image::FORMAT_ARGB32 ? 4 : 1);
+
 	// Write the images.
+	// Since all frames use DISPOSE_OP_NONE, the canvas keeps the
+	// previous frame's contents, so each subsequent frame only
+	// needs to encode the rectangle that actually changed.
+	const rp_image *prev_img = nullptr;
 	for (int i = 0; i < iconAnimData->seq_count; i++) {
 		const rp_image *const img = iconAnimData->frames[iconAnimData->seq_index[i]];
 		if (!img)
 			break;
 
-		// Initialize the row pointers array.
-		for (int y = cache.height-1; y >= 0; y--) {
-			row_pointers[y] = static_cast<const png_byte*>(img->scanLine(y));
+		// Dirty rectangle. Defaults to the full frame.
+		int rect[4] = {0, 0, cache.width, cache.height};
+		if (prev_img && prev_img != img &&
+		    prev_img->width() == img->width() &&
+		    prev_img->height() == img->height() &&
+		    prev_img->format() == img->format())
+		{
+			if (!apng_find_dirty_rect(prev_img, img, bpp, rect)) {
+				// Frames are identical. APNG requires a
+				// non-empty frame, so write a 1x1 rectangle.
+				// BLEND_OP_SOURCE with unchanged pixel data
+				// makes it a visual no-op.
+				rect[0] = 0;
+				rect[1] = 0;
+				rect[2] = 1;
+				rect[3] = 1;
+			}
+		}
+
+		// Initialize the row pointers array for the dirty rectangle.
+		for (int y = rect[3]-1; y >= 0; y--) {
+			row_pointers[y] = static_cast<const png_byte*>(img->scanLine(rect[1]+y)) + (rect[0] * bpp);
 		}
 
 		// Frame header.
 		png_write_frame_head(png_ptr, info_ptr, (png_bytepp)row_pointers,
-				cache.width, cache.height, 0, 0,	// width, height, x offset, y offset
+				rect[2], rect[3], rect[0], rect[1],	// width, height, x offset, y offset
 				iconAnimData->delays[i].numer,
 				iconAnimData->delays[i].denom,
 				PNG_DISPOSE_OP_NONE,
@@ -905,10 +1064,13 @@ int RpPngWriterPrivate::write_IDAT_APNG(void)
 
 		// Write the image data.
 		// TODO: Individual palette for CI8?
-		png_write_image(png_ptr, (png_bytepp)row_pointers);
+		for (int y = 0; y < rect[3]; y++) {
+			png_write_row(png_ptr, PNG_CONST_CAST(png_bytep)(row_pointers[y]));
+		}
 
 		// Frame tail.
 		png_write_frame_tail(png_ptr, info_ptr);
+		prev_img = img;
 	}
 
 	png_free(png_ptr, row_pointers);
@@ -919,6 +1081,8 @@ int RpPngWriterPrivate::write_IDAT_APNG(void)
 
 	// Free the PNG structs and unref() the file.
 	png_destroy_write_struct(&png_ptr, &info_ptr);
+	flushOutputBuffer();
+	bufWriter.file = nullptr;
 	file->unref();
 	file = nullptr;
 	return 0;
@@ -1091,6 +1255,27 @@ void RpPngWriter::close(void)
 	d->close();
 }
 
+/**
+ * Set the compression profile.
+ * This must be called before write_IHDR().
+ * @param profile Compression profile.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpPngWriter::setCompressionProfile(CompressionProfile profile)
+{
+	RP_D(RpPngWriter);
+	assert(!d->IHDR_written);
+	if (unlikely(d->IHDR_written)) {
+		// IHDR has already been written.
+		// The compression parameters are already locked in.
+		d->lastError = EEXIST;
+		return -d->lastError;
+	}
+
+	d->compressionProfile = profile;
+	return 0;
+}
+
 /**
  * Write the PNG IHDR.
  * This must be called before writing any other image data.
@@ -1126,9 +1311,27 @@ int RpPngWriter::write_IHDR(void)
 #endif /* PNG_SETJMP_SUPPORTED */
 
 	// Initialize compression parameters.
-	// TODO: Customizable?
-	png_set_filter(d->png_ptr, 0, PNG_FILTER_NONE);
-	png_set_compression_level(d->png_ptr, PNG_Z_DEFAULT_COMPRESSION);
+	switch (d->compressionProfile) {
+		case COMPRESS_FAST:
+			// Prioritize write speed over output size.
+			// Used for bulk operations, e.g. batch icon extraction.
+			png_set_filter(d->png_ptr, 0, PNG_FILTER_NONE);
+			png_set_compression_level(d->png_ptr, 1);
+			break;
+
+		case COMPRESS_SMALL:
+			// Prioritize output size over write speed.
+			// Filter selection is left to libpng's heuristics.
+			png_set_filter(d->png_ptr, 0, PNG_ALL_FILTERS);
+			png_set_compression_level(d->png_ptr, 9);
+			break;
+
+		case COMPRESS_DEFAULT:
+		default:
+			png_set_filter(d->png_ptr, 0, PNG_FILTER_NONE);
+			png_set_compression_level(d->png_ptr, PNG_Z_DEFAULT_COMPRESSION);
+			break;
+	}
 
 	// Write the PNG header.
 	switch (d->cache.format) {
@@ -27,6 +27,15 @@ struct IconAnimData;
 class RpPngWriterPrivate;
 class RpPngWriter
 {
+	public:
+		// Compression profiles.
+		// Trade-off between write speed and output size.
+		enum CompressionProfile {
+			COMPRESS_DEFAULT = 0,	// zlib defaults. (no filtering)
+			COMPRESS_FAST,		// Fastest compression. Use for bulk operations.
+			COMPRESS_SMALL,		// Smallest output. Use for cached files.
+		};
+
 	public:
 		/**
 		 * Write a raw image to a PNG file.
@@ -172,6 +181,14 @@ class RpPngWriter
 		 */
 		void close(void);
 
+		/**
+		 * Set the compression profile.
+		 * This must be called before write_IHDR().
+		 * @param profile Compression profile.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int setCompressionProfile(CompressionProfile profile);
+
 		/**
 		 * Write the PNG IHDR.
 		 * This must be called before writing any other image data.
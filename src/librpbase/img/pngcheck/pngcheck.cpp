@@ -308,6 +308,8 @@ int printpal;		/* print PLTE/tRNS/hIST/sPLT contents */
 int color;		/* print with ANSI colors to spice things up */
 int sevenbit;		/* escape characters >=160 */
 int force;		/* continue even if an error occurs (CRC error, etc) */
+int quick;		/* quick mode: validate structure and zlib header only;
+			   seek past bulk chunk data instead of CRC/inflating it */
 int check_windowbits;	/* more stringent zlib stream-checking */
 int suppress_warnings;	/* don't fuss about ambiguous stuff */
 int search;		/* hunt for PNGs in the file... */
@@ -362,7 +364,7 @@ int check_text (const uch *buffer, int maxsize, const char *chunkid);
 int check_ascii_float (const uch *buffer, int len, const char *chunkid);
 
 public:
-	explicit CPngCheck(IRpFile *fp)
+	explicit CPngCheck(IRpFile *fp, int quick = 0)
 		: fp(fp)
 		, fname(nullptr)
 		, verbose(0)
@@ -372,6 +374,7 @@ public:
 		, color(0)
 		, sevenbit(0)
 		, force(0)
+		, quick(quick)
 		, check_windowbits(1)
 		, suppress_warnings(0)
 		, search(0)
@@ -1176,6 +1179,14 @@ int pngcheck(IRpFile *fp)
 
 
 
+int pngcheck_quick(IRpFile *fp)
+{
+	unique_ptr<CPngCheck> cpngcheck(new CPngCheck(fp, 1));
+	return cpngcheck->pngcheck();
+}
+
+
+
 int CPngCheck::pngcheck(void)
 {
   const char *const fname = nullptr;	// dummy
@@ -1874,6 +1885,21 @@ FIXME: make sure bit 31 (0x80000000) is 0
         if (sz > 1 && zhead < 0x10000)
           zhead = (zhead << 8) + buffer[1];
         if (zhead >= 0x10000) {
+          if (quick) {
+            /* Quick mode skips the full zlib inflate, so at least
+             * verify the compression header here.  (The verbose
+             * code below does the same checks, but only when
+             * printing.) */
+            if ((zhead & 0xffff) % 31) {
+              /* compression header fails checksum */
+              set_err(kMajorError);
+            } else if (((zhead >> 8) & 0x0f) != 8) {
+              /* non-deflate compression method */
+              set_err(kMajorError);
+            }
+            if (is_err(kMajorError))
+              return global_error;
+          }
           /* formerly print_zlibheader(zhead & 0xffff); */
           /* See the code in zlib deflate.c that writes out the header when
              s->status is INIT_STATE.  In fact this code is based on the zlib
@@ -1916,7 +1942,7 @@ FIXME: make sure bit 31 (0x80000000) is 0
       }
 
 #ifdef USE_ZLIB
-      if (check_zlib && !zlib_error) {
+      if (check_zlib && !zlib_error && !quick) {
         // Variables moved outside of the 'while' loop.
         // We can't use 'static' here because that's not
         // reentrant or thread-safe.
@@ -4749,6 +4775,20 @@ FIXME: add support for decompressing/printing zTXt
         (void)fwrite(buffer, 1, toread, fpOut);
       }
 
+      if (quick && fpOut == NULL && sz > toread) {
+        /* Quick mode:  the chunk structure has been validated and the
+         * first read block hashed; seek past the rest of the data
+         * instead of reading it, and skip the CRC comparison for this
+         * chunk.  Chunks that fit in the first read block (all of the
+         * metadata chunks) still get their CRCs verified below.
+         * Truncated files are still caught by the CRC read hitting
+         * EOF after the seek. */
+        fp->seek(fp->tell() + (off64_t)(sz - toread));
+        filecrc = getlong("CRC value");
+        if (is_err(kMajorError))
+          return global_error;
+      } else {
+
       while (sz > toread) {
         int data_read;
         sz -= toread;
@@ -4782,6 +4822,8 @@ FIXME: add support for decompressing/printing zTXt
       if (no_err(kMinorError) && fpOut != NULL)
         putlong(fpOut, CRCCOMPL(crc));
 
+      } /* !quick */
+
     } else if (force) {
       /* force may result in set_err(kMajorError) or more upstream, and failing
        * to read CRC bytes here guarantees immediate downstream error when
@@ -45,6 +45,20 @@ enum {
  */
 int pngcheck(LibRpFile::IRpFile *fp);
 
+/**
+ * Check a PNG file for errors. (quick mode)
+ *
+ * Quick mode validates the chunk structure and the zlib compression
+ * header, but seeks past bulk chunk data instead of computing CRCs
+ * over it or inflating the image data. Intended for bulk cache
+ * integrity sweeps, where reading every byte of every file is
+ * too slow.
+ *
+ * @param fp PNG file.
+ * @return kOK on success; other value on error.
+ */
+int pngcheck_quick(LibRpFile::IRpFile *fp);
+
 }
 
 #endif /* __ROMPROPERTIES_LIBRPBASE_IMG_PNGCHECK_PNGCHECK_HPP__ */
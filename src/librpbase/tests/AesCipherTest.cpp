@@ -19,6 +19,13 @@
 # include "../crypto/AesNettle.hpp"
 #endif /* _WIN32 */
 
+// AES-NI implementation. (x86/amd64 only; requires a runtime CPU check)
+#include "librpcpu/cpu_dispatch.h"
+#if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
+# include "../crypto/AesAesni.hpp"
+# define AESCIPHERTEST_HAS_AESNI 1
+#endif
+
 // C includes. (C++ namespace)
 #include <cstdio>
 
@@ -572,6 +579,10 @@ AesDecryptTestSet(CAPI_NG, false)
 #else /* !_WIN32 */
 AesDecryptTestSet(Nettle, true)
 #endif /* _WIN32 */
+#ifdef AESCIPHERTEST_HAS_AESNI
+// Not required: skipped if the CPU doesn't support AES-NI.
+AesDecryptTestSet(Aesni, false)
+#endif /* AESCIPHERTEST_HAS_AESNI */
 
 } }
 
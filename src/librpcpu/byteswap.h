@@ -11,6 +11,7 @@
 
 // C includes.
 #include <stdint.h>
+#include <string.h>	/* memcpy() */
 
 /* Byteswapping intrinsics. */
 #include "config.byteswap.h"
@@ -34,6 +35,10 @@
 #ifdef RP_CPU_AMD64
 # define BYTESWAP_ALWAYS_HAS_SSE2 1
 #endif
+#if defined(RP_CPU_ARM) || defined(RP_CPU_ARM64)
+# include "cpuflags_arm.h"
+# define BYTESWAP_HAS_NEON 1
+#endif
 
 #if defined(_MSC_VER)
 
@@ -186,6 +191,24 @@ void __byte_swap_16_array_ssse3(uint16_t *ptr, size_t n);
 void __byte_swap_32_array_ssse3(uint32_t *ptr, size_t n);
 #endif /* BYTESWAP_HAS_SSSE3 */
 
+#ifdef BYTESWAP_HAS_NEON
+/**
+ * 16-bit byteswap function.
+ * NEON-optimized version.
+ * @param ptr Pointer to array to swap. (MUST be 16-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 2; an extra odd byte will be ignored.)
+ */
+void __byte_swap_16_array_neon(uint16_t *ptr, size_t n);
+
+/**
+ * 32-bit byteswap function.
+ * NEON-optimized version.
+ * @param ptr Pointer to array to swap. (MUST be 32-bit aligned!)
+ * @param n Number of bytes to swap. (Must be divisible by 4; extra bytes will be ignored.)
+ */
+void __byte_swap_32_array_neon(uint32_t *ptr, size_t n);
+#endif /* BYTESWAP_HAS_NEON */
+
 #if defined(RP_HAS_IFUNC)
 /* System has IFUNC. Use it for dispatching. */
 
@@ -213,6 +236,11 @@ void __byte_swap_32_array(uint32_t *ptr, size_t n);
  */
 static inline void __byte_swap_16_array(uint16_t *ptr, size_t n)
 {
+# ifdef BYTESWAP_HAS_NEON
+	if (RP_CPU_HasNEON()) {
+		__byte_swap_16_array_neon(ptr, n);
+	} else
+# endif /* BYTESWAP_HAS_NEON */
 # ifdef BYTESWAP_HAS_SSSE3
 	if (RP_CPU_HasSSSE3()) {
 		__byte_swap_16_array_ssse3(ptr, n);
@@ -247,6 +275,11 @@ static inline void __byte_swap_16_array(uint16_t *ptr, size_t n)
  */
 static inline void __byte_swap_32_array(uint32_t *ptr, size_t n)
 {
+# ifdef BYTESWAP_HAS_NEON
+	if (RP_CPU_HasNEON()) {
+		__byte_swap_32_array_neon(ptr, n);
+	} else
+# endif /* BYTESWAP_HAS_NEON */
 # ifdef BYTESWAP_HAS_SSSE3
 	if (RP_CPU_HasSSSE3()) {
 		__byte_swap_32_array_ssse3(ptr, n);
@@ -281,4 +314,137 @@ static inline void __byte_swap_32_array(uint32_t *ptr, size_t n)
 }
 #endif
 
+#ifdef __cplusplus
+
+/**
+ * Templated byteswap functions for compile-time-known sizes. (C++ only)
+ *
+ * For small fixed-size buffers, e.g. struct header fixups, these
+ * unroll to inline __swab16()/__swab32() calls with no function call
+ * or runtime CPU dispatch. Sizes at or above the threshold dispatch
+ * to the SIMD array functions, where the call overhead is amortized.
+ */
+
+/* Byte count at or above which the runtime-dispatched SIMD array */
+/* functions are used instead of inline unrolling. */
+#define RP_BYTE_SWAP_INLINE_THRESHOLD 128U
+
+/**
+ * 16-bit byteswap function with a compile-time-known size.
+ * @tparam N Number of bytes to swap. (Must be a multiple of 2.)
+ * @param ptr Pointer to array to swap. (MUST be 16-bit aligned!)
+ */
+template<size_t N>
+static inline void rp_byte_swap_16_array(uint16_t *ptr)
+{
+	static_assert(N % 2 == 0, "N must be a multiple of 2.");
+	if (N >= RP_BYTE_SWAP_INLINE_THRESHOLD) {
+		// Large enough for the SIMD array functions.
+		__byte_swap_16_array(ptr, N);
+	} else {
+		// Small buffer: Swap inline.
+		// The constant trip count lets the compiler unroll this.
+		for (size_t i = 0; i < N/2; i++) {
+			ptr[i] = __swab16(ptr[i]);
+		}
+	}
+}
+
+/**
+ * 32-bit byteswap function with a compile-time-known size.
+ * @tparam N Number of bytes to swap. (Must be a multiple of 4.)
+ * @param ptr Pointer to array to swap. (MUST be 32-bit aligned!)
+ */
+template<size_t N>
+static inline void rp_byte_swap_32_array(uint32_t *ptr)
+{
+	static_assert(N % 4 == 0, "N must be a multiple of 4.");
+	if (N >= RP_BYTE_SWAP_INLINE_THRESHOLD) {
+		// Large enough for the SIMD array functions.
+		__byte_swap_32_array(ptr, N);
+	} else {
+		// Small buffer: Swap inline.
+		// The constant trip count lets the compiler unroll this.
+		for (size_t i = 0; i < N/4; i++) {
+			ptr[i] = __swab32(ptr[i]);
+		}
+	}
+}
+
+/**
+ * Declarative in-place endian fixup for header structs. (C++ only)
+ *
+ * A struct's fields are described by a layout array of uint8_t:
+ * - 2, 4, or 8: Byteswap a field of that width.
+ * - RP_STRUCT_SKIP(n): Skip n bytes without swapping.
+ *   (strings, byte arrays, magic numbers kept in file order)
+ * The layout may cover only a prefix of the struct.
+ *
+ * With a constant layout array, the compiler unrolls the loop
+ * into inline swaps, so a whole header is fixed up with no
+ * function calls. Use the le_struct_to_cpu()/be_struct_to_cpu()
+ * macros, which compile to nothing if the struct's byte order
+ * matches the host.
+ */
+
+/* Skip (n) bytes without swapping. (n must be 1-127) */
+#define RP_STRUCT_SKIP(n) ((uint8_t)(0x80U | (n)))
+
+/**
+ * Byteswap a struct in place using a field-layout descriptor.
+ * @param ptr Pointer to struct.
+ * @param layout Field-layout descriptor array.
+ */
+template<size_t N>
+static inline void __byte_swap_struct(void *ptr, const uint8_t (&layout)[N])
+{
+	uint8_t *p = static_cast<uint8_t*>(ptr);
+	for (size_t i = 0; i < N; i++) {
+		const uint8_t entry = layout[i];
+		if (entry & 0x80) {
+			// Skip entry. (strings, byte arrays, etc.)
+			p += (entry & 0x7F);
+			continue;
+		}
+
+		switch (entry) {
+			case 2: {
+				uint16_t v;
+				memcpy(&v, p, sizeof(v));
+				v = __swab16(v);
+				memcpy(p, &v, sizeof(v));
+				break;
+			}
+			case 4: {
+				uint32_t v;
+				memcpy(&v, p, sizeof(v));
+				v = __swab32(v);
+				memcpy(p, &v, sizeof(v));
+				break;
+			}
+			case 8: {
+				uint64_t v;
+				memcpy(&v, p, sizeof(v));
+				v = __swab64(v);
+				memcpy(p, &v, sizeof(v));
+				break;
+			}
+			default:
+				// Invalid layout entry.
+				break;
+		}
+		p += entry;
+	}
+}
+
+#if SYS_BYTEORDER == SYS_LIL_ENDIAN
+# define be_struct_to_cpu(ptr, layout) __byte_swap_struct((ptr), (layout))
+# define le_struct_to_cpu(ptr, layout) do { ((void)(ptr)); ((void)(layout)); } while (0)
+#else /* SYS_BYTEORDER == SYS_BIG_ENDIAN */
+# define be_struct_to_cpu(ptr, layout) do { ((void)(ptr)); ((void)(layout)); } while (0)
+# define le_struct_to_cpu(ptr, layout) __byte_swap_struct((ptr), (layout))
+#endif
+
+#endif /* __cplusplus */
+
 #endif /* __ROMPROPERTIES_LIBRPBASE_BYTESWAP_H__ */
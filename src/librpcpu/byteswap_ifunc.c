@@ -17,6 +17,11 @@
  */
 static __typeof__(&__byte_swap_16_array_c) __byte_swap_16_array_resolve(void)
 {
+#ifdef BYTESWAP_HAS_NEON
+	if (RP_CPU_HasNEON()) {
+		return &__byte_swap_16_array_neon;
+	} else
+#endif /* BYTESWAP_HAS_NEON */
 #ifdef BYTESWAP_HAS_SSSE3
 	if (RP_CPU_HasSSSE3()) {
 		return &__byte_swap_16_array_ssse3;
@@ -49,6 +54,11 @@ static __typeof__(&__byte_swap_16_array_c) __byte_swap_16_array_resolve(void)
  */
 static __typeof__(&__byte_swap_32_array_c) __byte_swap_32_array_resolve(void)
 {
+#ifdef BYTESWAP_HAS_NEON
+	if (RP_CPU_HasNEON()) {
+		return &__byte_swap_32_array_neon;
+	} else
+#endif /* BYTESWAP_HAS_NEON */
 #ifdef BYTESWAP_HAS_SSSE3
 	if (RP_CPU_HasSSSE3()) {
 		return &__byte_swap_32_array_ssse3;
@@ -0,0 +1,77 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpcpu)                         *
+ * cpuflags_arm.c: ARM CPU flags detection.                                *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "cpuflags_arm.h"
+
+#if !defined(__arm__) && !defined(__thumb__) && !defined(__arm) && !defined(_ARM) && \
+    !defined(_M_ARM) && !defined(__aarch64__)
+#error Do not compile cpuflags_arm.c on non-ARM CPUs!
+#endif
+
+// librpthreads
+#include "librpthreads/pthread_once.h"
+#include "librpthreads/Atomics.h"
+
+#if defined(__linux__) && !defined(__aarch64__)
+// 32-bit ARM Linux: Check the ELF auxiliary vector for NEON support.
+# include <sys/auxv.h>
+# ifndef HWCAP_NEON
+#  define HWCAP_NEON (1 << 12)
+# endif
+#endif
+
+#if defined(_WIN32) && !defined(__aarch64__)
+# include <windows.h>
+#endif
+
+uint32_t RP_CPU_Flags = 0;
+int RP_CPU_Flags_Init = 0;	// 1 if RP_CPU_Flags has been initialized.
+
+/**
+ * Initialize RP_CPU_Flags. (internal function)
+ * Called by pthread_once().
+ */
+static void RP_CPU_InitCPUFlags_int(void)
+{
+	// Make sure the CPU flags variable is empty.
+	RP_CPU_Flags = 0;
+
+#if defined(__aarch64__)
+	// NEON (Advanced SIMD) is mandatory on aarch64.
+	RP_CPU_Flags |= RP_CPUFLAG_ARM_NEON;
+#elif defined(__linux__)
+	// 32-bit ARM Linux: Check the ELF auxiliary vector.
+	if (getauxval(AT_HWCAP) & HWCAP_NEON) {
+		RP_CPU_Flags |= RP_CPUFLAG_ARM_NEON;
+	}
+#elif defined(_WIN32)
+	// 32-bit ARM Windows requires NEON as part of the ABI,
+	// but check anyway for completeness.
+	if (IsProcessorFeaturePresent(PF_ARM_NEON_INSTRUCTIONS_AVAILABLE)) {
+		RP_CPU_Flags |= RP_CPUFLAG_ARM_NEON;
+	}
+#else
+	// Unknown OS. Can't check for NEON support,
+	// so assume it isn't available.
+#endif
+
+	// CPU flags initialized.
+	// Release store: publishes RP_CPU_Flags to threads that check
+	// RP_CPU_Flags_Init without going through pthread_once().
+	// ARM actually needs the barrier here, unlike x86.
+	ATOMIC_STORE_RELEASE(&RP_CPU_Flags_Init, 1);
+}
+
+/**
+ * Initialize RP_CPU_Flags.
+ */
+void RP_CPU_InitCPUFlags(void)
+{
+	static pthread_once_t once_control = PTHREAD_ONCE_INIT;
+	pthread_once(&once_control, RP_CPU_InitCPUFlags_int);
+}
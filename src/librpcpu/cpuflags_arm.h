@@ -0,0 +1,59 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpcpu)                         *
+ * cpuflags_arm.h: ARM CPU flags detection.                                *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPCPU_CPUFLAGS_ARM_H__
+#define __ROMPROPERTIES_LIBRPCPU_CPUFLAGS_ARM_H__
+
+// common.h is needed for FORCEINLINE.
+#include "common.h"
+
+// C includes.
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(__arm__) || defined(__thumb__) || defined(__arm) || defined(_ARM) || \
+    defined(_M_ARM) || defined(__aarch64__)
+
+#define RP_CPUFLAG_ARM_NEON		((uint32_t)(1U << 0))
+
+#endif /* ARM */
+
+// Don't modify these!
+extern uint32_t RP_CPU_Flags;
+extern int RP_CPU_Flags_Init;	// 1 if RP_CPU_Flags has been initialized.
+
+/**
+ * Initialize RP_CPU_Flags.
+ */
+void RP_CPU_InitCPUFlags(void);
+
+/**
+ * Check if the CPU supports NEON.
+ * @return Non-zero if NEON is supported; 0 if not.
+ */
+static FORCEINLINE int RP_CPU_HasNEON(void)
+{
+#ifdef __aarch64__
+	// NEON is mandatory on aarch64.
+	return 1;
+#else
+	if (unlikely(!RP_CPU_Flags_Init)) {
+		RP_CPU_InitCPUFlags();
+	}
+	return (RP_CPU_Flags & RP_CPUFLAG_ARM_NEON);
+#endif
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __ROMPROPERTIES_LIBRPCPU_CPUFLAGS_ARM_H__ */
@@ -17,6 +17,7 @@
 
 // librpthreads
 #include "librpthreads/pthread_once.h"
+#include "librpthreads/Atomics.h"
 
 #if defined(_MSC_VER) && _MSC_VER >= 1400
 # include <intrin.h>
@@ -46,6 +47,7 @@
 #define CPUFLAG_IA32_ECX_SSSE3		((uint32_t)(1U << 9))
 #define CPUFLAG_IA32_ECX_SSE41		((uint32_t)(1U << 19))
 #define CPUFLAG_IA32_ECX_SSE42		((uint32_t)(1U << 20))
+#define CPUFLAG_IA32_ECX_AES		((uint32_t)(1U << 25))
 #define CPUFLAG_IA32_ECX_XSAVE		((uint32_t)(1U << 26))
 #define CPUFLAG_IA32_ECX_OSXSAVE	((uint32_t)(1U << 27))
 #define CPUFLAG_IA32_ECX_AVX		((uint32_t)(1U << 28))
@@ -185,6 +187,74 @@ static FORCEINLINE void cpuid(unsigned int level, unsigned int regs[4])
 #endif
 }
 
+/**
+ * Run the `cpuid` instruction with a subfunction. (%ecx)
+ * Needed for CPUID function 7. (Extended Features)
+ * @param level
+ * @param subfunc
+ * @param regs Registers. (%eax, %ebx, %ecx, %edx)
+ */
+static FORCEINLINE void cpuidex(unsigned int level, unsigned int subfunc, unsigned int regs[4])
+{
+#if defined(__GNUC__)
+# ifdef ASM_RESERVE_EBX
+	__asm__ (
+		"xchgl	%%ebx, %1\n"
+		"cpuid\n"
+		"xchgl	%%ebx, %1\n"
+		: "=a" (regs[0]), "=r" (regs[1]), "=c" (regs[2]), "=d" (regs[3])
+		: "0" (level), "2" (subfunc)
+		);
+# else /* !ASM_RESERVE_EBX */
+	__asm__ (
+		"cpuid\n"
+		: "=a" (regs[0]), "=b" (regs[1]), "=c" (regs[2]), "=d" (regs[3])
+		: "0" (level), "2" (subfunc)
+		);
+# endif
+#elif defined(_MSC_VER) && _MSC_VER >= 1500
+	// __cpuidex() intrinsic. (MSVC 2008+)
+	__cpuidex((int*)regs, level, subfunc);
+#else
+	// No subfunction support. Zero the registers so the
+	// caller doesn't check uninitialized feature bits.
+	((void)level); ((void)subfunc);
+	regs[0] = regs[1] = regs[2] = regs[3] = 0;
+#endif
+}
+
+/**
+ * Read %xcr0 using the `xgetbv` instruction.
+ * Only call this if CPUID reports OSXSAVE support.
+ * @return Low 32 bits of %xcr0.
+ */
+static FORCEINLINE uint32_t rp_xgetbv(void)
+{
+#if defined(__GNUC__)
+	uint32_t xcr0_lo, xcr0_hi;
+	// NOTE: Using raw bytes for `xgetbv` to support
+	// assemblers that don't know the mnemonic.
+	__asm__ (
+		".byte 0x0F, 0x01, 0xD0"
+		: "=a" (xcr0_lo), "=d" (xcr0_hi)
+		: "c" (0)
+		);
+	return xcr0_lo;
+#elif defined(_MSC_VER) && _MSC_VER >= 1600
+	// _xgetbv() intrinsic. (MSVC 2010+)
+	return (uint32_t)_xgetbv(0);
+#else
+	// Can't read %xcr0. Assume the OS doesn't
+	// support the YMM registers.
+	return 0;
+#endif
+}
+
+// %xcr0 bits: SSE and AVX state must both be enabled by the OS.
+#define XCR0_STATE_SSE		(1U << 1)
+#define XCR0_STATE_AVX		(1U << 2)
+#define XCR0_STATE_SSE_AVX	(XCR0_STATE_SSE | XCR0_STATE_AVX)
+
 // Register indexes.
 #define REG_EAX 0
 #define REG_EBX 1
@@ -213,7 +283,7 @@ static void RP_CPU_InitCPUFlags_int(void)
 	if (!is_cpuid_supported()) {
 		// CPUID is not supported.
 		// This CPU must be an early 486 or older.
-		RP_CPU_Flags_Init = 1;
+		ATOMIC_STORE_RELEASE(&RP_CPU_Flags_Init, 1);
 		return;
 	}
 
@@ -224,7 +294,7 @@ static void RP_CPU_InitCPUFlags_int(void)
 	maxFunc = regs[0];
 	if (maxFunc == 0) {
 		// No CPUID functions are supported.
-		RP_CPU_Flags_Init = 1;
+		ATOMIC_STORE_RELEASE(&RP_CPU_Flags_Init, 1);
 		return;
 	}
 
@@ -295,6 +365,10 @@ static void RP_CPU_InitCPUFlags_int(void)
 				RP_CPU_Flags |= RP_CPUFLAG_X86_SSE41;
 			if (regs[REG_ECX] & CPUFLAG_IA32_ECX_SSE42)
 				RP_CPU_Flags |= RP_CPUFLAG_X86_SSE42;
+			// AES-NI uses the XMM registers, so it also
+			// requires OS support for FXSAVE.
+			if (regs[REG_ECX] & CPUFLAG_IA32_ECX_AES)
+				RP_CPU_Flags |= RP_CPUFLAG_X86_AES;
 		}
 #else /* !(defined(__i386__) || defined(_M_IX86)) */
 		// AMD64: SSE2 and lower are always supported.
@@ -307,11 +381,34 @@ static void RP_CPU_InitCPUFlags_int(void)
 			RP_CPU_Flags |= RP_CPUFLAG_X86_SSE41;
 		if (regs[REG_ECX] & CPUFLAG_IA32_ECX_SSE42)
 			RP_CPU_Flags |= RP_CPUFLAG_X86_SSE42;
+		if (regs[REG_ECX] & CPUFLAG_IA32_ECX_AES)
+			RP_CPU_Flags |= RP_CPUFLAG_X86_AES;
 #endif /* defined(__i386__) || defined(_M_IX86) */
+
+		// Check for AVX.
+		// Requires the OS to support saving the YMM registers,
+		// which is verified via OSXSAVE and %xcr0.
+		if ((regs[REG_ECX] & (CPUFLAG_IA32_ECX_AVX | CPUFLAG_IA32_ECX_OSXSAVE)) ==
+		    (CPUFLAG_IA32_ECX_AVX | CPUFLAG_IA32_ECX_OSXSAVE))
+		{
+			if ((rp_xgetbv() & XCR0_STATE_SSE_AVX) == XCR0_STATE_SSE_AVX) {
+				// OS supports the YMM registers.
+				RP_CPU_Flags |= RP_CPUFLAG_X86_AVX;
+
+				// Check for AVX2.
+				if (maxFunc >= CPUID_EXT_FEATURES) {
+					cpuidex(CPUID_EXT_FEATURES, 0, regs);
+					if (regs[REG_EBX] & CPUFLAG_IA32_FN7_EBX_AVX2)
+						RP_CPU_Flags |= RP_CPUFLAG_X86_AVX2;
+				}
+			}
+		}
 	}
 
 	// CPU flags initialized.
-	RP_CPU_Flags_Init = 1;
+	// Release store: publishes RP_CPU_Flags to threads that check
+	// RP_CPU_Flags_Init without going through pthread_once().
+	ATOMIC_STORE_RELEASE(&RP_CPU_Flags_Init, 1);
 }
 
 /**
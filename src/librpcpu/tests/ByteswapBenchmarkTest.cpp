@@ -0,0 +1,319 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpcpu/tests)                   *
+ * ByteswapBenchmarkTest.cpp: Byteswap performance regression test.        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+/**
+ * Unlike ByteswapTest, which verifies correctness only, this test
+ * measures the throughput of the vectorized byteswap and Super Magic
+ * Drive kernels against the C fallback and FAILS if the speedup drops
+ * below a minimum ratio. Compiler updates have silently broken
+ * vectorization in exactly these kernels before; this catches it in
+ * the regular test run instead of in a user's bug report.
+ *
+ * NOTE: This test runs as part of `ctest` (it is not filtered out
+ * like the *_benchmark cases), so the thresholds are deliberately
+ * conservative: the vectorized kernels are typically 2x-8x faster,
+ * and we only require a fraction of that.
+ */
+
+// Google Test
+#include "gtest/gtest.h"
+#include "tcharx.h"
+
+// Byteswap functions.
+#include "common.h"
+#include "librpcpu/byteswap.h"
+#include "librpbase/aligned_malloc.h"
+
+// Super Magic Drive deinterleaving functions.
+#include "libromdata/utils/SuperMagicDrive.hpp"
+using LibRomData::SuperMagicDrive;
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <chrono>
+
+namespace LibRpBase { namespace Tests {
+
+class ByteswapBenchmarkTest : public ::testing::Test
+{
+	protected:
+		ByteswapBenchmarkTest()
+			: src_buf(nullptr)
+			, dest_buf(nullptr)
+		{ }
+
+	public:
+		// Maximum buffer size tested.
+		static const unsigned int MAX_BUF_SIZE = 1048576;
+		// Slack for misaligned views into the buffer.
+		static const unsigned int BUF_SLACK = 64;
+
+		// Buffer sizes to benchmark. The small size fits in L1;
+		// the large size is bigger than most L2 caches, so both
+		// compute-bound and memory-bound behavior is covered.
+		static const unsigned int BUF_SIZES[3];
+
+		// Bytes to process per measurement, across all iterations.
+		// Large enough to make timer resolution irrelevant.
+		static const unsigned int BYTES_PER_MEASUREMENT = 16U*1048576;
+
+		// Number of measurement trials. The best (minimum) time is
+		// used, which filters out scheduler and frequency noise.
+		static const unsigned int TRIALS = 5;
+
+		// Minimum required speedup of a vectorized kernel over the
+		// C fallback. The real speedup is typically 2x-8x; if it
+		// falls below this, vectorization has almost certainly
+		// been lost.
+		static const double MIN_SPEEDUP;
+
+	public:
+		void SetUp(void) final;
+		void TearDown(void) final;
+
+		/**
+		 * Measure the best-of-TRIALS time for fn(), in nanoseconds.
+		 * @param fn Function to benchmark. (called `iterations` times per trial)
+		 * @param iterations Iterations per trial.
+		 * @return Best trial time, in nanoseconds.
+		 */
+		template<typename Fn>
+		static uint64_t benchmark(Fn fn, unsigned int iterations)
+		{
+			uint64_t best = ~static_cast<uint64_t>(0);
+			for (unsigned int trial = TRIALS; trial > 0; trial--) {
+				const auto t_start = std::chrono::steady_clock::now();
+				for (unsigned int i = iterations; i > 0; i--) {
+					fn();
+				}
+				const auto elapsed = std::chrono::steady_clock::now() - t_start;
+				const uint64_t ns = static_cast<uint64_t>(
+					std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+				if (ns < best) {
+					best = ns;
+				}
+			}
+			return best;
+		}
+
+	public:
+		// Temporary aligned buffers.
+		// Automatically freed in TearDown().
+		uint8_t *src_buf;
+		uint8_t *dest_buf;
+};
+
+const unsigned int ByteswapBenchmarkTest::BUF_SIZES[3] = {4096, 65536, 1048576};
+const double ByteswapBenchmarkTest::MIN_SPEEDUP = 1.25;
+
+/**
+ * SetUp() function.
+ * Run before each test.
+ */
+void ByteswapBenchmarkTest::SetUp(void)
+{
+	src_buf = static_cast<uint8_t*>(aligned_malloc(32, MAX_BUF_SIZE + BUF_SLACK));
+	dest_buf = static_cast<uint8_t*>(aligned_malloc(32, MAX_BUF_SIZE + BUF_SLACK));
+	ASSERT_TRUE(src_buf != nullptr);
+	ASSERT_TRUE(dest_buf != nullptr);
+
+	// Fill the source buffer with pseudo-random data.
+	// (The kernels don't care about the contents; this just
+	// avoids benchmarking against an all-zero page.)
+	uint32_t lfsr = 0xB7E15163;
+	for (unsigned int i = 0; i < (MAX_BUF_SIZE + BUF_SLACK) / 4; i++) {
+		lfsr = (lfsr << 1) ^ ((static_cast<int32_t>(lfsr) >> 31) & 0x04C11DB7);
+		reinterpret_cast<uint32_t*>(src_buf)[i] = lfsr;
+	}
+}
+
+/**
+ * TearDown() function.
+ * Run after each test.
+ */
+void ByteswapBenchmarkTest::TearDown(void)
+{
+	aligned_free(src_buf);
+	aligned_free(dest_buf);
+	src_buf = nullptr;
+	dest_buf = nullptr;
+}
+
+/**
+ * Macro for benchmarking a 16-bit byteswap function against the
+ * C fallback across buffer sizes and alignments.
+ * @param opt		Byteswap function optimization. (sse2, ssse3)
+ * @param expr		Expression to check if this optimization can be used.
+ * @param errmsg	Error message to display if the optimization cannot be used.
+ */
+#define DO_ARRAY_16_SPEEDUP_TEST(opt, expr, errmsg) \
+TEST_F(ByteswapBenchmarkTest, __byte_swap_16_array_##opt##_speedup) \
+{ \
+	if (!(expr)) { \
+		fputs(errmsg, stderr); \
+		return; \
+	} \
+	for (unsigned int szIdx = 0; szIdx < ARRAY_SIZE(BUF_SIZES); szIdx++) { \
+		const unsigned int size = BUF_SIZES[szIdx]; \
+		const unsigned int iterations = BYTES_PER_MEASUREMENT / size; \
+		/* Offset 0: fully aligned. Offset 2: 16-bit aligned only, */ \
+		/* which forces the vectorized kernels' alignment prologue. */ \
+		static const unsigned int offsets[2] = {0, 2}; \
+		for (unsigned int offIdx = 0; offIdx < ARRAY_SIZE(offsets); offIdx++) { \
+			uint16_t *const ptr = reinterpret_cast<uint16_t*>(&src_buf[offsets[offIdx]]); \
+			const uint64_t ns_c = benchmark([ptr, size](void) { \
+				__byte_swap_16_array_c(ptr, size); \
+			}, iterations); \
+			const uint64_t ns_opt = benchmark([ptr, size](void) { \
+				__byte_swap_16_array_##opt(ptr, size); \
+			}, iterations); \
+			const double speedup = static_cast<double>(ns_c) / static_cast<double>(ns_opt); \
+			fprintf(stderr, "16-bit %s: size=%7u offset=%u: %5.2fx vs. C\n", \
+				#opt, size, offsets[offIdx], speedup); \
+			EXPECT_GE(speedup, MIN_SPEEDUP) << \
+				"16-bit " #opt " byteswap is no longer meaningfully faster than the " \
+				"C fallback at size " << size << ", offset " << offsets[offIdx] << \
+				". Was vectorization lost?"; \
+		} \
+	} \
+}
+
+/**
+ * Macro for benchmarking a 32-bit byteswap function against the
+ * C fallback across buffer sizes and alignments.
+ * @param opt		Byteswap function optimization. (sse2, ssse3)
+ * @param expr		Expression to check if this optimization can be used.
+ * @param errmsg	Error message to display if the optimization cannot be used.
+ */
+#define DO_ARRAY_32_SPEEDUP_TEST(opt, expr, errmsg) \
+TEST_F(ByteswapBenchmarkTest, __byte_swap_32_array_##opt##_speedup) \
+{ \
+	if (!(expr)) { \
+		fputs(errmsg, stderr); \
+		return; \
+	} \
+	for (unsigned int szIdx = 0; szIdx < ARRAY_SIZE(BUF_SIZES); szIdx++) { \
+		const unsigned int size = BUF_SIZES[szIdx]; \
+		const unsigned int iterations = BYTES_PER_MEASUREMENT / size; \
+		/* Offset 0: fully aligned. Offset 4: 32-bit aligned only. */ \
+		static const unsigned int offsets[2] = {0, 4}; \
+		for (unsigned int offIdx = 0; offIdx < ARRAY_SIZE(offsets); offIdx++) { \
+			uint32_t *const ptr = reinterpret_cast<uint32_t*>(&src_buf[offsets[offIdx]]); \
+			const uint64_t ns_c = benchmark([ptr, size](void) { \
+				__byte_swap_32_array_c(ptr, size); \
+			}, iterations); \
+			const uint64_t ns_opt = benchmark([ptr, size](void) { \
+				__byte_swap_32_array_##opt(ptr, size); \
+			}, iterations); \
+			const double speedup = static_cast<double>(ns_c) / static_cast<double>(ns_opt); \
+			fprintf(stderr, "32-bit %s: size=%7u offset=%u: %5.2fx vs. C\n", \
+				#opt, size, offsets[offIdx], speedup); \
+			EXPECT_GE(speedup, MIN_SPEEDUP) << \
+				"32-bit " #opt " byteswap is no longer meaningfully faster than the " \
+				"C fallback at size " << size << ", offset " << offsets[offIdx] << \
+				". Was vectorization lost?"; \
+		} \
+	} \
+}
+
+#ifdef BYTESWAP_HAS_SSE2
+DO_ARRAY_16_SPEEDUP_TEST(sse2, RP_CPU_HasSSE2(), "*** SSE2 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_SPEEDUP_TEST(sse2, RP_CPU_HasSSE2(), "*** SSE2 is not supported on this CPU. Skipping test.\n")
+#endif /* BYTESWAP_HAS_SSE2 */
+
+#ifdef BYTESWAP_HAS_SSSE3
+DO_ARRAY_16_SPEEDUP_TEST(ssse3, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_SPEEDUP_TEST(ssse3, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
+#endif /* BYTESWAP_HAS_SSSE3 */
+
+#ifdef SMD_HAS_SSE2
+/**
+ * Benchmark the SSE2 Super Magic Drive block decoder against
+ * the C++ fallback.
+ */
+TEST_F(ByteswapBenchmarkTest, smd_decodeBlock_sse2_speedup)
+{
+	if (!RP_CPU_HasSSE2()) {
+		fputs("*** SSE2 is not supported on this CPU. Skipping test.\n", stderr);
+		return;
+	}
+
+	const unsigned int iterations = BYTES_PER_MEASUREMENT / SuperMagicDrive::SMD_BLOCK_SIZE;
+	uint8_t *const pDest = dest_buf;
+	const uint8_t *const pSrc = src_buf;
+
+	const uint64_t ns_cpp = benchmark([pDest, pSrc](void) {
+		SuperMagicDrive::decodeBlock_cpp(pDest, pSrc);
+	}, iterations);
+	const uint64_t ns_sse2 = benchmark([pDest, pSrc](void) {
+		SuperMagicDrive::decodeBlock_sse2(pDest, pSrc);
+	}, iterations);
+
+	const double speedup = static_cast<double>(ns_cpp) / static_cast<double>(ns_sse2);
+	fprintf(stderr, "SMD sse2: %5.2fx vs. C++\n", speedup);
+	EXPECT_GE(speedup, MIN_SPEEDUP) <<
+		"SSE2 SMD block decoding is no longer meaningfully faster than the "
+		"C++ fallback. Was vectorization lost?";
+}
+#endif /* SMD_HAS_SSE2 */
+
+#ifdef SMD_HAS_AVX2
+/**
+ * Benchmark the AVX2 Super Magic Drive buffer decoder against
+ * the C++ fallback.
+ */
+TEST_F(ByteswapBenchmarkTest, smd_decodeAll_avx2_speedup)
+{
+	if (!RP_CPU_HasAVX2()) {
+		fputs("*** AVX2 is not supported on this CPU. Skipping test.\n", stderr);
+		return;
+	}
+
+	// Decode a multi-block buffer so the non-temporal store
+	// path is exercised.
+	const unsigned int len = MAX_BUF_SIZE;	// 64 blocks
+	const unsigned int iterations = BYTES_PER_MEASUREMENT / len;
+	uint8_t *const pDest = dest_buf;
+	const uint8_t *const pSrc = src_buf;
+
+	const uint64_t ns_cpp = benchmark([pDest, pSrc, len](void) {
+		for (unsigned int offset = 0; offset < len;
+		     offset += SuperMagicDrive::SMD_BLOCK_SIZE)
+		{
+			SuperMagicDrive::decodeBlock_cpp(&pDest[offset], &pSrc[offset]);
+		}
+	}, iterations);
+	const uint64_t ns_avx2 = benchmark([pDest, pSrc, len](void) {
+		SuperMagicDrive::decodeAll_avx2(pDest, pSrc, len);
+	}, iterations);
+
+	const double speedup = static_cast<double>(ns_cpp) / static_cast<double>(ns_avx2);
+	fprintf(stderr, "SMD avx2: %5.2fx vs. C++\n", speedup);
+	EXPECT_GE(speedup, MIN_SPEEDUP) <<
+		"AVX2 SMD buffer decoding is no longer meaningfully faster than the "
+		"C++ fallback. Was vectorization lost?";
+}
+#endif /* SMD_HAS_AVX2 */
+
+} }
+
+/**
+ * Test suite main function.
+ */
+extern "C" int gtest_main(int argc, TCHAR *argv[])
+{
+	fprintf(stderr, "LibRpBase test suite: Byteswap performance regression tests.\n\n");
+	fflush(nullptr);
+
+	// coverity[fun_call_w_exception]: uncaught exceptions cause nonzero exit anyway, so don't warn.
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -370,8 +370,20 @@ DO_ARRAY_32_unQWORD_TEST	(ssse3, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported
 DO_ARRAY_32_unQWORD_BENCHMARK	(ssse3, RP_CPU_HasSSSE3(), "*** SSSE3 is not supported on this CPU. Skipping test.\n")
 #endif /* BYTESWAP_HAS_SSSE3 */
 
+#ifdef BYTESWAP_HAS_NEON
+// NEON-optimized tests.
+DO_ARRAY_16_TEST		(neon, RP_CPU_HasNEON(), "*** NEON is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_BENCHMARK		(neon, RP_CPU_HasNEON(), "*** NEON is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_unDWORD_TEST	(neon, RP_CPU_HasNEON(), "*** NEON is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_16_unDWORD_BENCHMARK	(neon, RP_CPU_HasNEON(), "*** NEON is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_TEST		(neon, RP_CPU_HasNEON(), "*** NEON is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_BENCHMARK		(neon, RP_CPU_HasNEON(), "*** NEON is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_unQWORD_TEST	(neon, RP_CPU_HasNEON(), "*** NEON is not supported on this CPU. Skipping test.\n")
+DO_ARRAY_32_unQWORD_BENCHMARK	(neon, RP_CPU_HasNEON(), "*** NEON is not supported on this CPU. Skipping test.\n")
+#endif /* BYTESWAP_HAS_NEON */
+
 // NOTE: Add more instruction sets to the #ifdef if other optimizations are added.
-#if defined(BYTESWAP_HAS_MMX) || defined(BYTESWAP_HAS_SSE2) || defined(BYTESWAP_HAS_SSSE3)
+#if defined(BYTESWAP_HAS_MMX) || defined(BYTESWAP_HAS_SSE2) || defined(BYTESWAP_HAS_SSSE3) || defined(BYTESWAP_HAS_NEON)
 // Dispatch functions.
 DO_ARRAY_16_TEST		(dispatch, true, "")
 DO_ARRAY_16_BENCHMARK		(dispatch, true, "")
@@ -381,7 +393,7 @@ DO_ARRAY_32_TEST		(dispatch, true, "")
 DO_ARRAY_32_BENCHMARK		(dispatch, true, "")
 DO_ARRAY_32_unQWORD_TEST	(dispatch, true, "")
 DO_ARRAY_32_unQWORD_BENCHMARK	(dispatch, true, "")
-#endif /* BYTESWAP_HAS_MMX || BYTESWAP_HAS_SSE2 || BYTESWAP_HAS_SSSE3 */
+#endif /* BYTESWAP_HAS_MMX || BYTESWAP_HAS_SSE2 || BYTESWAP_HAS_SSSE3 || BYTESWAP_HAS_NEON */
 
 } }
 
@@ -0,0 +1,312 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * ConcatFile.cpp: IRpFile implementation that concatenates other files.   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ConcatFile.hpp"
+
+// C++ STL classes.
+using std::string;
+using std::vector;
+
+namespace LibRpFile {
+
+/**
+ * Open a concatenation of the specified files.
+ * The resulting IRpFile is read-only.
+ *
+ * The files are ref()'d in order, so the original files
+ * can be unref()'d by the caller afterwards.
+ *
+ * Check isOpen() to determine if the file is usable.
+ *
+ * @param files Files to concatenate, in order.
+ */
+ConcatFile::ConcatFile(const std::vector<IRpFile*> &files)
+	: super()
+	, m_size(0)
+	, m_pos(0)
+{
+	if (files.empty()) {
+		m_lastError = EBADF;
+		return;
+	}
+
+	m_segments.reserve(files.size());
+	for (IRpFile *file : files) {
+		if (!file || !file->isOpen()) {
+			// Segment file is missing or not open.
+			close();
+			m_lastError = EBADF;
+			return;
+		}
+
+		const off64_t segSize = file->size();
+		if (segSize < 0) {
+			close();
+			m_lastError = EIO;
+			return;
+		}
+
+		Segment segment;
+		segment.file = file->ref();
+		segment.start = m_size;
+		segment.size = segSize;
+		m_segments.push_back(segment);
+		m_size += segSize;
+	}
+}
+
+ConcatFile::~ConcatFile()
+{
+	for (const Segment &segment : m_segments) {
+		segment.file->unref();
+	}
+}
+
+/**
+ * Is the file open?
+ * This usually only returns false if an error occurred.
+ * @return True if the file is open; false if it isn't.
+ */
+bool ConcatFile::isOpen(void) const
+{
+	return !m_segments.empty();
+}
+
+/**
+ * Close the file.
+ */
+void ConcatFile::close(void)
+{
+	for (const Segment &segment : m_segments) {
+		segment.file->unref();
+	}
+	m_segments.clear();
+	m_size = 0;
+	m_pos = 0;
+}
+
+/**
+ * Find the segment containing the specified position.
+ * @param pos File position.
+ * @return Segment index, or -1 if out of range.
+ */
+int ConcatFile::findSegment(off64_t pos) const
+{
+	if (pos < 0 || pos >= m_size)
+		return -1;
+
+	// NOTE: Split images usually have a handful of segments,
+	// so a linear scan is fine here.
+	int idx = 0;
+	for (const Segment &segment : m_segments) {
+		if (pos < segment.start + segment.size)
+			return idx;
+		idx++;
+	}
+
+	// Shouldn't get here...
+	assert(!"Position is within m_size, but no segment contains it.");
+	return -1;
+}
+
+/**
+ * Read data from the file.
+ * Reads crossing segment boundaries are split across
+ * the underlying files.
+ * @param ptr Output data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t ConcatFile::read(void *ptr, size_t size)
+{
+	if (m_segments.empty()) {
+		m_lastError = EBADF;
+		return 0;
+	}
+
+	// Check if size is in bounds.
+	if (m_pos < 0 || m_pos >= m_size) {
+		// Not in bounds.
+		return 0;
+	}
+
+	// Make sure we don't read past the end of the file.
+	if (m_pos > m_size - static_cast<off64_t>(size)) {
+		size = static_cast<size_t>(m_size - m_pos);
+	}
+	if (size == 0)
+		return 0;
+
+	uint8_t *ptr8 = static_cast<uint8_t*>(ptr);
+	size_t total = 0;
+	int idx = findSegment(m_pos);
+	assert(idx >= 0);
+	if (idx < 0) {
+		m_lastError = EIO;
+		return 0;
+	}
+
+	while (size > 0 && idx < static_cast<int>(m_segments.size())) {
+		const Segment &segment = m_segments[idx];
+		const off64_t segPos = m_pos - segment.start;
+		size_t toRead = size;
+		if (static_cast<off64_t>(toRead) > segment.size - segPos) {
+			toRead = static_cast<size_t>(segment.size - segPos);
+		}
+
+		const size_t sz_read = segment.file->seekAndRead(segPos, ptr8, toRead);
+		m_pos += sz_read;
+		ptr8 += sz_read;
+		total += sz_read;
+		size -= sz_read;
+		if (sz_read != toRead) {
+			// Short read in the underlying segment.
+			m_lastError = segment.file->lastError();
+			break;
+		}
+		idx++;
+	}
+
+	// If the read finished close to a segment boundary, ask the OS
+	// to prefetch the start of the next segment. This lets the next
+	// segment's file spin up while the caller is still processing
+	// data from the current one.
+	const int lastIdx = findSegment(m_pos > 0 ? m_pos - 1 : 0);
+	if (lastIdx >= 0 && lastIdx + 1 < static_cast<int>(m_segments.size())) {
+		const Segment &segment = m_segments[lastIdx];
+		if (m_pos >= segment.start + segment.size - PREFETCH_WINDOW) {
+			m_segments[lastIdx + 1].file->readAhead(0, PREFETCH_SIZE);
+		}
+	}
+
+	return total;
+}
+
+/**
+ * Write data to the file.
+ * (NOTE: Not valid for ConcatFile; this will always return 0.)
+ * @param ptr Input data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes written.
+ */
+size_t ConcatFile::write(const void *ptr, size_t size)
+{
+	// Not a valid operation for ConcatFile.
+	RP_UNUSED(ptr);
+	RP_UNUSED(size);
+	m_lastError = EBADF;
+	return 0;
+}
+
+/**
+ * Set the file position.
+ * @param pos File position.
+ * @return 0 on success; -1 on error.
+ */
+int ConcatFile::seek(off64_t pos)
+{
+	if (m_segments.empty()) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	// NOTE: m_pos is not clamped to m_size here,
+	// which matches RpMemFile's behavior.
+	if (pos <= 0) {
+		m_pos = 0;
+	} else {
+		m_pos = pos;
+	}
+
+	return 0;
+}
+
+/**
+ * Get the file position.
+ * @return File position, or -1 on error.
+ */
+off64_t ConcatFile::tell(void)
+{
+	if (m_segments.empty()) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	return m_pos;
+}
+
+/**
+ * Truncate the file.
+ * (NOTE: Not valid for ConcatFile; this will always return -1.)
+ * @param size New size. (default is 0)
+ * @return 0 on success; -1 on error.
+ */
+int ConcatFile::truncate(off64_t size)
+{
+	// Not supported.
+	RP_UNUSED(size);
+	m_lastError = ENOTSUP;
+	return -1;
+}
+
+/**
+ * Ask the OS to read the specified range ahead of time.
+ * The hint is forwarded to the affected segment files.
+ * @param pos Start of the range to read ahead.
+ * @param size Size of the range to read ahead, in bytes.
+ */
+void ConcatFile::readAhead(off64_t pos, off64_t size)
+{
+	int idx = findSegment(pos);
+	if (idx < 0)
+		return;
+
+	while (size > 0 && idx < static_cast<int>(m_segments.size())) {
+		const Segment &segment = m_segments[idx];
+		const off64_t segPos = pos - segment.start;
+		off64_t segLen = segment.size - segPos;
+		if (segLen > size) {
+			segLen = size;
+		}
+
+		segment.file->readAhead(segPos, segLen);
+		pos += segLen;
+		size -= segLen;
+		idx++;
+	}
+}
+
+/**
+ * Get the file size.
+ * This is the total size of all segments.
+ * @return File size, or negative on error.
+ */
+off64_t ConcatFile::size(void)
+{
+	if (m_segments.empty()) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	return m_size;
+}
+
+/**
+ * Get the filename.
+ * This is the filename of the first segment.
+ * @return Filename. (May be empty if the filename is not available.)
+ */
+string ConcatFile::filename(void) const
+{
+	if (m_segments.empty())
+		return string();
+	return m_segments[0].file->filename();
+}
+
+}
@@ -0,0 +1,159 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * ConcatFile.hpp: IRpFile implementation that concatenates other files.   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_CONCATFILE_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_CONCATFILE_HPP__
+
+#include "IRpFile.hpp"
+
+// C++ includes.
+#include <vector>
+
+namespace LibRpFile {
+
+/**
+ * IRpFile implementation that presents multiple files as one
+ * logical file, e.g. split disc images. (game.wbfs + game.wbf1)
+ *
+ * All segment files are kept open for the lifetime of this object,
+ * so reads crossing a segment boundary don't reopen anything.
+ */
+class ConcatFile : public IRpFile
+{
+	public:
+		/**
+		 * Open a concatenation of the specified files.
+		 * The resulting IRpFile is read-only.
+		 *
+		 * The files are ref()'d in order, so the original files
+		 * can be unref()'d by the caller afterwards.
+		 *
+		 * Check isOpen() to determine if the file is usable.
+		 *
+		 * @param files Files to concatenate, in order.
+		 */
+		explicit ConcatFile(const std::vector<IRpFile*> &files);
+	protected:
+		virtual ~ConcatFile();	// call unref() instead
+
+	private:
+		typedef IRpFile super;
+		RP_DISABLE_COPY(ConcatFile)
+
+	public:
+		/**
+		 * Is the file open?
+		 * This usually only returns false if an error occurred.
+		 * @return True if the file is open; false if it isn't.
+		 */
+		bool isOpen(void) const final;
+
+		/**
+		 * Close the file.
+		 */
+		void close(void) final;
+
+		/**
+		 * Read data from the file.
+		 * Reads crossing segment boundaries are split across
+		 * the underlying files.
+		 * @param ptr Output data buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t read(void *ptr, size_t size) final;
+
+		/**
+		 * Write data to the file.
+		 * (NOTE: Not valid for ConcatFile; this will always return 0.)
+		 * @param ptr Input data buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes written.
+		 */
+		size_t write(const void *ptr, size_t size) final;
+
+		/**
+		 * Set the file position.
+		 * @param pos File position.
+		 * @return 0 on success; -1 on error.
+		 */
+		int seek(off64_t pos) final;
+
+		/**
+		 * Get the file position.
+		 * @return File position, or -1 on error.
+		 */
+		off64_t tell(void) final;
+
+		/**
+		 * Truncate the file.
+		 * (NOTE: Not valid for ConcatFile; this will always return -1.)
+		 * @param size New size. (default is 0)
+		 * @return 0 on success; -1 on error.
+		 */
+		int truncate(off64_t size = 0) final;
+
+	public:
+		/** Access hints **/
+
+		/**
+		 * Ask the OS to read the specified range ahead of time.
+		 * The hint is forwarded to the affected segment files.
+		 * @param pos Start of the range to read ahead.
+		 * @param size Size of the range to read ahead, in bytes.
+		 */
+		void readAhead(off64_t pos, off64_t size) final;
+
+	public:
+		/** File properties **/
+
+		/**
+		 * Get the file size.
+		 * This is the total size of all segments.
+		 * @return File size, or negative on error.
+		 */
+		off64_t size(void) final;
+
+		/**
+		 * Get the filename.
+		 * This is the filename of the first segment.
+		 * @return Filename. (May be empty if the filename is not available.)
+		 */
+		std::string filename(void) const final;
+
+	private:
+		/**
+		 * Find the segment containing the specified position.
+		 * @param pos File position.
+		 * @return Segment index, or -1 if out of range.
+		 */
+		int findSegment(off64_t pos) const;
+
+	private:
+		// File segment.
+		struct Segment {
+			IRpFile *file;	// Segment file.
+			off64_t start;	// Starting position within the logical file.
+			off64_t size;	// Segment size.
+		};
+		std::vector<Segment> m_segments;
+
+		off64_t m_size;	// Total size.
+		off64_t m_pos;	// Current read position.
+
+		// Prefetch window. When a read finishes within this many
+		// bytes of a segment boundary, the start of the next
+		// segment is prefetched so sequential scans don't stall
+		// on the crossing.
+		static const off64_t PREFETCH_WINDOW = 1U*1024*1024;
+		static const off64_t PREFETCH_SIZE = 1U*1024*1024;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_CONCATFILE_HPP__ */
@@ -0,0 +1,61 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * DirScanner.hpp: Bulk directory scanner.                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_DIRSCANNER_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_DIRSCANNER_HPP__
+
+#include "common.h"
+
+// C++ includes.
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace LibRpFile { namespace DirScanner {
+
+/**
+ * Directory scan options.
+ */
+struct ScanOptions {
+	// Recurse into subdirectories.
+	bool recursive;
+
+	// Optional file extension filter.
+	// Extensions must be lowercase and include the leading dot,
+	// matching RomDataFactory::supportedFileExtensions(). Files
+	// whose extension isn't in the set are skipped.
+	// Set to nullptr to return all files.
+	const std::unordered_set<std::string> *extensions;
+
+	ScanOptions()
+		: recursive(false)
+		, extensions(nullptr)
+	{ }
+};
+
+/**
+ * Scan a directory for files.
+ *
+ * Subdirectories are scanned in parallel using the shared worker
+ * thread pool, and directory entries are processed in inode order
+ * where available to minimize seeking during stat() calls. The
+ * result is sorted by full pathname, so runs are deterministic.
+ *
+ * This is the shared enumeration layer for bulk operations;
+ * rpcli's recursive batch mode is built on it.
+ *
+ * @param path		[in] Directory to scan.
+ * @param options	[in] Scan options.
+ * @param out		[out] Vector to store the full pathnames in.
+ * @return 0 on success; negative POSIX error code if the directory can't be read.
+ */
+int scan(const std::string &path, const ScanOptions &options, std::vector<std::string> &out);
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_DIRSCANNER_HPP__ */
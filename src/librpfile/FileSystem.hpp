@@ -38,6 +38,7 @@
 
 // C++ includes.
 #include <string>
+#include <vector>
 
 namespace LibRpFile { namespace FileSystem {
 
@@ -138,6 +139,13 @@ const char *file_ext(const std::string &filename);
  */
 bool is_symlink(const char *filename);
 
+/**
+ * Check if the specified path is a directory.
+ * Symbolic links are followed.
+ * @return True if the path is a directory; false if not.
+ */
+bool is_directory(const char *filename);
+
 /**
  * Resolve a symbolic link.
  *
@@ -171,6 +179,21 @@ bool isOnBadFS(const char *filename, bool netFS = false);
  */
 int get_file_size_and_mtime(const std::string &filename, off64_t *pFileSize, time_t *pMtime);
 
+/**
+ * Ask the OS to read the first `size` bytes of each file ahead of time.
+ *
+ * The readahead requests for all files are submitted before any of
+ * them complete, so the device's command queue stays full instead of
+ * serving one synchronous header read at a time. Intended for batch
+ * operations that are about to open many queued files.
+ *
+ * This is a best-effort hint; errors are ignored.
+ *
+ * @param filenames Filenames.
+ * @param size Number of bytes to read ahead per file.
+ */
+void batch_read_ahead(const std::vector<std::string> &filenames, off64_t size);
+
 } }
 
 #endif /* __ROMPROPERTIES_LIBRPFILE_FILESYSTEM_HPP__ */
@@ -246,6 +246,37 @@ bool is_symlink(const char *filename)
 #endif /* HAVE_STATX */
 }
 
+/**
+ * Check if the specified path is a directory.
+ * Symbolic links are followed.
+ * @return True if the path is a directory; false if not.
+ */
+bool is_directory(const char *filename)
+{
+	if (unlikely(!filename || filename[0] == 0))
+		return false;
+
+#ifdef HAVE_STATX
+	struct statx sbx;
+	int ret = statx(AT_FDCWD, filename, 0, STATX_TYPE, &sbx);
+	if (ret != 0 || !(sbx.stx_mask & STATX_TYPE)) {
+		// statx() failed and/or did not return the file type.
+		// Assume this is not a directory.
+		return false;
+	}
+	return !!S_ISDIR(sbx.stx_mode);
+#else /* !HAVE_STATX */
+	struct stat sb;
+	int ret = stat(filename, &sb);
+	if (ret != 0) {
+		// stat() failed.
+		// Assume this is not a directory.
+		return false;
+	}
+	return !!S_ISDIR(sb.st_mode);
+#endif /* HAVE_STATX */
+}
+
 /**
  * Resolve a symbolic link.
  *
@@ -399,4 +430,42 @@ int get_file_size_and_mtime(const string &filename, off64_t *pFileSize, time_t *
 	return 0;
 }
 
+/**
+ * Ask the OS to read the first `size` bytes of each file ahead of time.
+ *
+ * The readahead requests for all files are submitted before any of
+ * them complete, so the device's command queue stays full instead of
+ * serving one synchronous header read at a time. Intended for batch
+ * operations that are about to open many queued files.
+ *
+ * This is a best-effort hint; errors are ignored.
+ *
+ * @param filenames Filenames.
+ * @param size Number of bytes to read ahead per file.
+ */
+void batch_read_ahead(const std::vector<string> &filenames, off64_t size)
+{
+#ifdef POSIX_FADV_WILLNEED
+	if (size <= 0) {
+		return;
+	}
+
+	// NOTE: posix_fadvise(POSIX_FADV_WILLNEED) starts the readahead
+	// in the background and returns immediately, so issuing the hints
+	// back-to-back queues the header reads for all files at once.
+	for (auto iter = filenames.cbegin(); iter != filenames.cend(); ++iter) {
+		const int fd = open(iter->c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0) {
+			// Cannot open the file. Skip it.
+			continue;
+		}
+		posix_fadvise(fd, 0, size, POSIX_FADV_WILLNEED);
+		close(fd);
+	}
+#else /* !POSIX_FADV_WILLNEED */
+	RP_UNUSED(filenames);
+	RP_UNUSED(size);
+#endif /* POSIX_FADV_WILLNEED */
+}
+
 } }
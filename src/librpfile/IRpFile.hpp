@@ -21,10 +21,11 @@
 
 // common macros
 #include "common.h"
+#include "refbase.hpp"
 
 namespace LibRpFile {
 
-class IRpFile
+class IRpFile : public RefBase
 {
 	protected:
 		IRpFile();
@@ -36,15 +37,14 @@ class IRpFile
 	public:
 		/**
 		 * Take a reference to this IRpFile* object.
+		 * NOTE: Refcounting is inherited from RefBase;
+		 * this override only provides a covariant return type.
 		 * @return this
 		 */
-		IRpFile *ref(void);
-
-		/**
-		 * Unreference this IRpFile* object.
-		 * If m_refCnt reaches 0, the IRpFile* object is deleted.
-		 */
-		void unref(void);
+		inline IRpFile *ref(void)
+		{
+			return static_cast<IRpFile*>(RefBase::ref());
+		}
 
 	public:
 		/**
@@ -120,6 +120,77 @@ class IRpFile
 		 */
 		virtual int truncate(off64_t size = 0) = 0;
 
+	public:
+		/** Access hints **/
+
+		/**
+		 * Expected file access pattern.
+		 * Used as a hint for OS-level readahead tuning.
+		 */
+		enum AccessPattern {
+			AP_NORMAL = 0,		// No special access pattern.
+			AP_SEQUENTIAL,		// Sequential scan; aggressive readahead.
+			AP_RANDOM,		// Random access; minimal readahead.
+		};
+
+		/**
+		 * Hint the expected access pattern to the OS.
+		 *
+		 * This is a best-effort hint; the default implementation
+		 * does nothing.
+		 *
+		 * @param pattern Expected access pattern.
+		 */
+		virtual void setAccessPattern(AccessPattern pattern)
+		{
+			RP_UNUSED(pattern);
+		}
+
+		/**
+		 * Ask the OS to read the specified range ahead of time.
+		 *
+		 * This is an asynchronous, best-effort hint; the default
+		 * implementation does nothing.
+		 *
+		 * @param pos Start of the range to read ahead.
+		 * @param size Size of the range to read ahead, in bytes.
+		 */
+		virtual void readAhead(off64_t pos, off64_t size)
+		{
+			RP_UNUSED(pos);
+			RP_UNUSED(size);
+		}
+
+	public:
+		/** Memory mapping **/
+
+		/**
+		 * Map the entire file into memory, if supported.
+		 *
+		 * The mapping is read-only and remains valid until unmap()
+		 * is called or the file is closed. The size of the mapping
+		 * is the file size as returned by size().
+		 *
+		 * The default implementation returns nullptr, indicating
+		 * that memory mapping is not supported by this backend.
+		 * Callers must fall back to read() in that case.
+		 *
+		 * @return Pointer to the mapped file data, or nullptr if not supported.
+		 */
+		virtual const void *map(void)
+		{
+			// Not supported by this backend.
+			return nullptr;
+		}
+
+		/**
+		 * Unmap previously-mapped file data.
+		 *
+		 * The default implementation does nothing.
+		 */
+		virtual void unmap(void)
+		{ }
+
 	public:
 		/** File properties **/
 
@@ -180,9 +251,6 @@ class IRpFile
 
 	protected:
 		int m_lastError;
-	private:
-		volatile int m_refCnt;
-		static volatile int ms_refCntTotal;
 };
 
 /**
@@ -0,0 +1,371 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * RpBufferedFile.cpp: IRpFile wrapper with a small-read buffer window.    *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RpBufferedFile.hpp"
+
+// C++ STL classes.
+using std::string;
+
+namespace LibRpFile {
+
+/**
+ * Wrap an IRpFile in a buffered window.
+ * The resulting IRpFile is read-only.
+ *
+ * Small reads are coalesced into a sliding 64 KB window,
+ * so scattered header accesses within a locality window
+ * hit memory instead of issuing one syscall each.
+ * Reads of 64 KB or more bypass the window.
+ *
+ * NOTE: The underlying file is ref()'d, so the caller
+ * may unref() its own reference afterwards.
+ *
+ * @param file File to wrap.
+ */
+RpBufferedFile::RpBufferedFile(IRpFile *file)
+	: super()
+	, m_file(nullptr)
+	, m_size(0)
+	, m_pos(0)
+	, m_windowAddr(-1)
+	, m_windowLen(0)
+{
+	assert(file != nullptr);
+	if (!file || !file->isOpen()) {
+		// No file specified, or the file isn't open.
+		m_lastError = EBADF;
+		return;
+	}
+
+	m_file = file->ref();
+	m_size = file->size();
+	if (m_size < 0) {
+		m_size = 0;
+	}
+}
+
+RpBufferedFile::~RpBufferedFile()
+{
+	if (m_file) {
+		m_file->unref();
+	}
+}
+
+/**
+ * Is the file open?
+ * This usually only returns false if an error occurred.
+ * @return True if the file is open; false if it isn't.
+ */
+bool RpBufferedFile::isOpen(void) const
+{
+	return (m_file != nullptr && m_file->isOpen());
+}
+
+/**
+ * Close the file.
+ */
+void RpBufferedFile::close(void)
+{
+	if (m_file) {
+		m_file->unref();
+		m_file = nullptr;
+	}
+	m_window.reset();
+	m_windowAddr = -1;
+	m_windowLen = 0;
+	m_size = 0;
+	m_pos = 0;
+}
+
+/**
+ * Fill the buffered window starting at the specified position.
+ * The window start is aligned down to a 512-byte boundary.
+ * @param pos File position the window must cover.
+ * @return Number of valid bytes in the window.
+ */
+size_t RpBufferedFile::fillWindow(off64_t pos)
+{
+	if (!m_window) {
+		// Allocate the window on first use.
+		m_window.reset(new uint8_t[WINDOW_SIZE]);
+	}
+
+	// Align the window start down to a 512-byte boundary.
+	// This helps scattered reads slightly before the first
+	// access in a locality window, e.g. re-reads of an
+	// earlier header field.
+	const off64_t windowAddr = pos & ~static_cast<off64_t>(511);
+	m_windowLen = m_file->seekAndRead(windowAddr, m_window.get(), WINDOW_SIZE);
+	m_windowAddr = (m_windowLen > 0 ? windowAddr : -1);
+	if (m_windowLen == 0) {
+		m_lastError = m_file->lastError();
+	}
+	return m_windowLen;
+}
+
+/**
+ * Read data from the file.
+ * @param ptr Output data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t RpBufferedFile::read(void *ptr, size_t size)
+{
+	if (!m_file) {
+		m_lastError = EBADF;
+		return 0;
+	}
+
+	if (unlikely(size == 0)) {
+		// Not reading anything...
+		return 0;
+	}
+
+	// Check if size is in bounds.
+	if (m_pos > m_size - static_cast<off64_t>(size)) {
+		// Not enough data.
+		// Read whatever's left in the file.
+		if (m_pos >= m_size) {
+			// Nothing left.
+			return 0;
+		}
+		size = static_cast<size_t>(m_size - m_pos);
+	}
+
+	uint8_t *pDest = static_cast<uint8_t*>(ptr);
+	size_t ret = 0;
+	while (size > 0) {
+		if (m_windowAddr >= 0 &&
+		    m_pos >= m_windowAddr &&
+		    m_pos < m_windowAddr + static_cast<off64_t>(m_windowLen))
+		{
+			// At least part of the request is in the window.
+			const size_t offset = static_cast<size_t>(m_pos - m_windowAddr);
+			size_t copy_len = m_windowLen - offset;
+			if (copy_len > size) {
+				copy_len = size;
+			}
+			memcpy(pDest, &m_window[offset], copy_len);
+			pDest += copy_len;
+			m_pos += copy_len;
+			ret += copy_len;
+			size -= copy_len;
+			continue;
+		}
+
+		if (size >= WINDOW_SIZE) {
+			// Large read. Bypass the window and read directly
+			// from the underlying file.
+			const size_t direct_len = m_file->seekAndRead(m_pos, pDest, size);
+			if (direct_len == 0) {
+				m_lastError = m_file->lastError();
+			}
+			m_pos += direct_len;
+			ret += direct_len;
+			break;
+		}
+
+		// Small read that isn't in the window.
+		// Refill the window at the current position.
+		if (fillWindow(m_pos) == 0) {
+			// Seek and/or read error.
+			break;
+		}
+	}
+
+	return ret;
+}
+
+/**
+ * Write data to the file.
+ * (NOTE: Not valid for RpBufferedFile; this will always return 0.)
+ * @param ptr Input data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes written.
+ */
+size_t RpBufferedFile::write(const void *ptr, size_t size)
+{
+	// Not a valid operation for RpBufferedFile.
+	RP_UNUSED(ptr);
+	RP_UNUSED(size);
+	m_lastError = EBADF;
+	return 0;
+}
+
+/**
+ * Set the file position.
+ * @param pos File position.
+ * @return 0 on success; -1 on error.
+ */
+int RpBufferedFile::seek(off64_t pos)
+{
+	if (!m_file) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	// NOTE: The underlying file is not seeked until data
+	// is actually needed.
+	if (pos <= 0) {
+		m_pos = 0;
+	} else if (pos >= m_size) {
+		m_pos = m_size;
+	} else {
+		m_pos = pos;
+	}
+
+	return 0;
+}
+
+/**
+ * Get the file position.
+ * @return File position, or -1 on error.
+ */
+off64_t RpBufferedFile::tell(void)
+{
+	if (!m_file) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	return m_pos;
+}
+
+/**
+ * Truncate the file.
+ * (NOTE: Not valid for RpBufferedFile; this will always return -1.)
+ * @param size New size. (default is 0)
+ * @return 0 on success; -1 on error.
+ */
+int RpBufferedFile::truncate(off64_t size)
+{
+	// Not a valid operation for RpBufferedFile.
+	RP_UNUSED(size);
+	m_lastError = ENOTSUP;
+	return -1;
+}
+
+/** Buffer window functions **/
+
+/**
+ * Invalidate the buffered window.
+ *
+ * Call this if the underlying file contents may have
+ * changed. The next small read will refill the window
+ * from the underlying file.
+ */
+void RpBufferedFile::invalidate(void)
+{
+	m_windowAddr = -1;
+	m_windowLen = 0;
+
+	// The file size may have changed as well.
+	if (m_file) {
+		m_size = m_file->size();
+		if (m_size < 0) {
+			m_size = 0;
+		}
+		if (m_pos > m_size) {
+			m_pos = m_size;
+		}
+	}
+}
+
+/** Access hints **/
+
+/**
+ * Hint the expected access pattern to the OS.
+ * This is forwarded to the underlying file.
+ * @param pattern Expected access pattern.
+ */
+void RpBufferedFile::setAccessPattern(AccessPattern pattern)
+{
+	if (m_file) {
+		m_file->setAccessPattern(pattern);
+	}
+}
+
+/**
+ * Ask the OS to read the specified range ahead of time.
+ * This is forwarded to the underlying file.
+ * @param pos Start of the range to read ahead.
+ * @param size Size of the range to read ahead, in bytes.
+ */
+void RpBufferedFile::readAhead(off64_t pos, off64_t size)
+{
+	if (m_file) {
+		m_file->readAhead(pos, size);
+	}
+}
+
+/** Memory mapping **/
+
+/**
+ * Map the entire file into memory, if supported.
+ * This is forwarded to the underlying file.
+ * @return Pointer to the mapped file data, or nullptr if not supported.
+ */
+const void *RpBufferedFile::map(void)
+{
+	if (!m_file) {
+		m_lastError = EBADF;
+		return nullptr;
+	}
+
+	return m_file->map();
+}
+
+/**
+ * Unmap previously-mapped file data.
+ * This is forwarded to the underlying file.
+ */
+void RpBufferedFile::unmap(void)
+{
+	if (m_file) {
+		m_file->unmap();
+	}
+}
+
+/** File properties **/
+
+/**
+ * Get the file size.
+ * @return File size, or negative on error.
+ */
+off64_t RpBufferedFile::size(void)
+{
+	if (!m_file) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	return m_size;
+}
+
+/**
+ * Get the filename.
+ * @return Filename. (May be empty if the filename is not available.)
+ */
+string RpBufferedFile::filename(void) const
+{
+	return (m_file ? m_file->filename() : string());
+}
+
+/** Device file functions **/
+
+/**
+ * Is this a device file?
+ * @return True if this is a device file; false if not.
+ */
+bool RpBufferedFile::isDevice(void) const
+{
+	return (m_file ? m_file->isDevice() : false);
+}
+
+}
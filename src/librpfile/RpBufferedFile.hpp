@@ -0,0 +1,190 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * RpBufferedFile.hpp: IRpFile wrapper with a small-read buffer window.    *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_RPBUFFEREDFILE_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_RPBUFFEREDFILE_HPP__
+
+#include "IRpFile.hpp"
+
+// C++ includes.
+#include <memory>
+
+namespace LibRpFile {
+
+class RpBufferedFile : public IRpFile
+{
+	public:
+		/**
+		 * Wrap an IRpFile in a buffered window.
+		 * The resulting IRpFile is read-only.
+		 *
+		 * Small reads are coalesced into a sliding 64 KB window,
+		 * so scattered header accesses within a locality window
+		 * hit memory instead of issuing one syscall each.
+		 * Reads of 64 KB or more bypass the window.
+		 *
+		 * NOTE: The underlying file is ref()'d, so the caller
+		 * may unref() its own reference afterwards.
+		 *
+		 * @param file File to wrap.
+		 */
+		explicit RpBufferedFile(IRpFile *file);
+	protected:
+		virtual ~RpBufferedFile();	// call unref() instead
+
+	private:
+		typedef IRpFile super;
+		RP_DISABLE_COPY(RpBufferedFile)
+
+	public:
+		/**
+		 * Is the file open?
+		 * This usually only returns false if an error occurred.
+		 * @return True if the file is open; false if it isn't.
+		 */
+		bool isOpen(void) const final;
+
+		/**
+		 * Close the file.
+		 */
+		void close(void) final;
+
+		/**
+		 * Read data from the file.
+		 * @param ptr Output data buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t read(void *ptr, size_t size) final;
+
+		/**
+		 * Write data to the file.
+		 * (NOTE: Not valid for RpBufferedFile; this will always return 0.)
+		 * @param ptr Input data buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes written.
+		 */
+		size_t write(const void *ptr, size_t size) final;
+
+		/**
+		 * Set the file position.
+		 * @param pos File position.
+		 * @return 0 on success; -1 on error.
+		 */
+		int seek(off64_t pos) final;
+
+		/**
+		 * Get the file position.
+		 * @return File position, or -1 on error.
+		 */
+		off64_t tell(void) final;
+
+		/**
+		 * Truncate the file.
+		 * (NOTE: Not valid for RpBufferedFile; this will always return -1.)
+		 * @param size New size. (default is 0)
+		 * @return 0 on success; -1 on error.
+		 */
+		int truncate(off64_t size = 0) final;
+
+	public:
+		/** Buffer window functions **/
+
+		/**
+		 * Invalidate the buffered window.
+		 *
+		 * Call this if the underlying file contents may have
+		 * changed. The next small read will refill the window
+		 * from the underlying file.
+		 */
+		void invalidate(void);
+
+	public:
+		/** Access hints **/
+
+		/**
+		 * Hint the expected access pattern to the OS.
+		 * This is forwarded to the underlying file.
+		 * @param pattern Expected access pattern.
+		 */
+		void setAccessPattern(AccessPattern pattern) final;
+
+		/**
+		 * Ask the OS to read the specified range ahead of time.
+		 * This is forwarded to the underlying file.
+		 * @param pos Start of the range to read ahead.
+		 * @param size Size of the range to read ahead, in bytes.
+		 */
+		void readAhead(off64_t pos, off64_t size) final;
+
+	public:
+		/** Memory mapping **/
+
+		/**
+		 * Map the entire file into memory, if supported.
+		 * This is forwarded to the underlying file.
+		 * @return Pointer to the mapped file data, or nullptr if not supported.
+		 */
+		const void *map(void) final;
+
+		/**
+		 * Unmap previously-mapped file data.
+		 * This is forwarded to the underlying file.
+		 */
+		void unmap(void) final;
+
+	public:
+		/** File properties **/
+
+		/**
+		 * Get the file size.
+		 * @return File size, or negative on error.
+		 */
+		off64_t size(void) final;
+
+		/**
+		 * Get the filename.
+		 * @return Filename. (May be empty if the filename is not available.)
+		 */
+		std::string filename(void) const final;
+
+	public:
+		/** Device file functions **/
+
+		/**
+		 * Is this a device file?
+		 * @return True if this is a device file; false if not.
+		 */
+		bool isDevice(void) const final;
+
+	protected:
+		/**
+		 * Fill the buffered window starting at the specified position.
+		 * The window start is aligned down to a 512-byte boundary.
+		 * @param pos File position the window must cover.
+		 * @return Number of valid bytes in the window.
+		 */
+		size_t fillWindow(off64_t pos);
+
+	protected:
+		// Window size, in bytes.
+		static const size_t WINDOW_SIZE = 64*1024;
+
+		IRpFile *m_file;	// Underlying file.
+		off64_t m_size;		// Size of the underlying file.
+		off64_t m_pos;		// Current position.
+
+		// Buffered window. Allocated on the first small read.
+		std::unique_ptr<uint8_t[]> m_window;
+		off64_t m_windowAddr;	// Window start address. (-1 == invalid)
+		size_t m_windowLen;	// Number of valid bytes in the window.
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_RPBUFFEREDFILE_HPP__ */
@@ -115,6 +115,22 @@ class RpFile : public IRpFile
 		 */
 		int truncate(off64_t size = 0) final;
 
+	public:
+		/** Access hints **/
+
+		/**
+		 * Hint the expected access pattern to the OS.
+		 * @param pattern Expected access pattern.
+		 */
+		void setAccessPattern(AccessPattern pattern) final;
+
+		/**
+		 * Ask the OS to read the specified range ahead of time.
+		 * @param pos Start of the range to read ahead.
+		 * @param size Size of the range to read ahead, in bytes.
+		 */
+		void readAhead(off64_t pos, off64_t size) final;
+
 	public:
 		/** File properties **/
 
@@ -75,10 +75,18 @@ class RpFilePrivate
 
 		RpFilePrivate(RpFile *q, const char *filename, RpFile::FileMode mode)
 			: q_ptr(q), file(FILE_INIT), filename(filename)
-			, mode(mode), gzfd(nullptr), gzsz(-1), devInfo(nullptr) { }
+			, mode(mode), gzfd(nullptr), gzsz(-1), devInfo(nullptr)
+#ifdef _WIN32
+			, prefetch(nullptr)
+#endif /* _WIN32 */
+			{ }
 		RpFilePrivate(RpFile *q, const string &filename, RpFile::FileMode mode)
 			: q_ptr(q), file(FILE_INIT), filename(filename)
-			, mode(mode), gzfd(nullptr), gzsz(-1), devInfo(nullptr) { }
+			, mode(mode), gzfd(nullptr), gzsz(-1), devInfo(nullptr)
+#ifdef _WIN32
+			, prefetch(nullptr)
+#endif /* _WIN32 */
+			{ }
 		~RpFilePrivate();
 
 	private:
@@ -97,14 +105,21 @@ class RpFilePrivate
 		// Only used if the underlying file
 		// is a device node.
 		struct DeviceInfo {
+			// Number of sectors in the sector cache.
+			// Filling the cache in one command batches up the
+			// round trips for sequential small reads.
+			// (32 * 2048 == 64 KB for optical media)
+			enum { SECTOR_CACHE_LBAS = 32 };
+
 			off64_t device_pos;	// Device position.
 			off64_t device_size;	// Device size.
 			uint32_t sector_size;	// Sector size. (bytes per sector)
 			bool isKreonUnlocked;	// Is Kreon mode unlocked?
 
 			// Sector cache.
-			uint8_t *sector_cache;	// Sector cache.
-			uint32_t lba_cache;	// Last LBA cached.
+			uint8_t *sector_cache;	// Sector cache. (SECTOR_CACHE_LBAS sectors)
+			uint32_t lba_cache;	// First LBA in the cache.
+			uint32_t lba_cache_len;	// Number of valid sectors in the cache. (0 == empty)
 
 #ifdef RP_OS_SCSI_SUPPORTED
 			// OS-specific buffers.
@@ -120,6 +135,7 @@ class RpFilePrivate
 				, isKreonUnlocked(0)
 				, sector_cache(nullptr)
 				, lba_cache(~0U)
+				, lba_cache_len(0)
 			{
 #ifdef RP_OS_SCSI_SUPPORTED
 # if defined(__FreeBSD__) || defined(__DragonFly__)
@@ -146,15 +162,41 @@ class RpFilePrivate
 				assert(sector_size <= 65536);
 				if (!sector_cache) {
 					if (sector_size >= 512 && sector_size <= 65536) {
-						sector_cache = new uint8_t[sector_size];
+						sector_cache = new uint8_t[static_cast<size_t>(sector_size) * SECTOR_CACHE_LBAS];
 					}
 				}
 			}
 
+			/**
+			 * Is the specified LBA in the sector cache?
+			 * @param lba LBA to check.
+			 * @return True if the LBA is cached; false if not.
+			 */
+			bool isInSectorCache(uint32_t lba) const
+			{
+				return (lba_cache_len != 0 &&
+					lba >= lba_cache &&
+					lba - lba_cache < lba_cache_len);
+			}
+
+			/**
+			 * Get a pointer to the specified LBA in the sector cache.
+			 * The LBA must be cached. (check with isInSectorCache())
+			 * @param lba Cached LBA.
+			 * @return Pointer to the sector data within the cache.
+			 */
+			uint8_t *sector_cache_ptr(uint32_t lba)
+			{
+				assert(isInSectorCache(lba));
+				return &sector_cache[static_cast<size_t>(lba - lba_cache) * sector_size];
+			}
+
 			void close(void)
 			{
 				delete[] sector_cache;
 				sector_cache = nullptr;
+				lba_cache = ~0U;
+				lba_cache_len = 0;
 
 #ifdef RP_OS_SCSI_SUPPORTED
 # if defined(__FreeBSD__) || defined(__DragonFly__)
@@ -169,6 +211,49 @@ class RpFilePrivate
 
 		DeviceInfo *devInfo;
 
+#ifdef _WIN32
+		// Prefetch state for readAhead().
+		// The async read runs on a second handle opened with
+		// FILE_FLAG_OVERLAPPED, so it doesn't disturb the
+		// synchronous file position.
+		struct PrefetchInfo {
+			HANDLE hFile;		// Overlapped file handle.
+			OVERLAPPED ovl;		// ovl.hEvent is the completion token.
+			uint8_t *buf;		// Dummy destination buffer.
+			DWORD buf_len;		// Size of buf, in bytes.
+			bool inFlight;		// Is a prefetch read in flight?
+
+			PrefetchInfo()
+				: hFile(INVALID_HANDLE_VALUE)
+				, ovl()
+				, buf(nullptr)
+				, buf_len(0)
+				, inFlight(false)
+			{ }
+
+			~PrefetchInfo()
+			{
+				// NOTE: The caller must finish or cancel an
+				// in-flight read before deleting this struct.
+				if (ovl.hEvent) {
+					CloseHandle(ovl.hEvent);
+				}
+				if (hFile && hFile != INVALID_HANDLE_VALUE) {
+					CloseHandle(hFile);
+				}
+				delete[] buf;
+			}
+		};
+
+		PrefetchInfo *prefetch;
+
+		/**
+		 * Finish an in-flight prefetch read, if any.
+		 * Cancels the read if it hasn't completed yet.
+		 */
+		void finishPrefetch(void);
+#endif /* _WIN32 */
+
 	public:
 #ifdef _WIN32
 		/**
@@ -205,11 +290,16 @@ class RpFilePrivate
 
 	public:
 		/**
-		 * Read one sector into the sector cache.
+		 * Read the specified LBA into the sector cache.
+		 *
+		 * Reads up to SECTOR_CACHE_LBAS sectors in a single command,
+		 * so sequential small reads don't pay one command round trip
+		 * per sector.
+		 *
 		 * @param lba LBA to read.
 		 * @return 0 on success; non-zero on error.
 		 */
-		int readOneLBA(uint32_t lba);
+		int readSectorCache(uint32_t lba);
 
 		/**
 		 * Read using block reads.
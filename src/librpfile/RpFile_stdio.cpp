@@ -15,6 +15,7 @@
 
 #include "RpFile.hpp"
 #include "RpFile_p.hpp"
+#include "RpStats.hpp"
 
 // C includes.
 #include <fcntl.h>	// AT_EMPTY_PATH
@@ -374,6 +375,7 @@ size_t RpFile::read(void *ptr, size_t size)
 			m_lastError = errno;
 		}
 	}
+	RpStats::increment(RpStats::CTR_FILE_BYTES_READ, ret);
 	return ret;
 }
 
@@ -513,6 +515,62 @@ int RpFile::truncate(off64_t size)
 	return 0;
 }
 
+/** Access hints **/
+
+/**
+ * Hint the expected access pattern to the OS.
+ * @param pattern Expected access pattern.
+ */
+void RpFile::setAccessPattern(AccessPattern pattern)
+{
+	RP_D(RpFile);
+	if (!d->file) {
+		return;
+	}
+
+#ifdef POSIX_FADV_NORMAL
+	int advice;
+	switch (pattern) {
+		case AP_SEQUENTIAL:
+			advice = POSIX_FADV_SEQUENTIAL;
+			break;
+		case AP_RANDOM:
+			advice = POSIX_FADV_RANDOM;
+			break;
+		case AP_NORMAL:
+		default:
+			advice = POSIX_FADV_NORMAL;
+			break;
+	}
+
+	// Best-effort hint; ignore errors.
+	posix_fadvise(fileno(d->file), 0, 0, advice);
+#else /* !POSIX_FADV_NORMAL */
+	RP_UNUSED(pattern);
+#endif /* POSIX_FADV_NORMAL */
+}
+
+/**
+ * Ask the OS to read the specified range ahead of time.
+ * @param pos Start of the range to read ahead.
+ * @param size Size of the range to read ahead, in bytes.
+ */
+void RpFile::readAhead(off64_t pos, off64_t size)
+{
+	RP_D(RpFile);
+	if (!d->file || pos < 0 || size <= 0) {
+		return;
+	}
+
+#ifdef POSIX_FADV_WILLNEED
+	// Best-effort hint; ignore errors.
+	posix_fadvise(fileno(d->file), pos, size, POSIX_FADV_WILLNEED);
+#else /* !POSIX_FADV_WILLNEED */
+	RP_UNUSED(pos);
+	RP_UNUSED(size);
+#endif /* POSIX_FADV_WILLNEED */
+}
+
 /** File properties **/
 
 /**
@@ -172,6 +172,24 @@ int RpMemFile::truncate(off64_t size)
 	return -1;
 }
 
+/** Memory mapping **/
+
+/**
+ * Map the entire file into memory, if supported.
+ * RpMemFile is already backed by memory, so this
+ * simply returns the memory buffer.
+ * @return Pointer to the mapped file data, or nullptr if not open.
+ */
+const void *RpMemFile::map(void)
+{
+	if (!m_buf) {
+		m_lastError = EBADF;
+		return nullptr;
+	}
+
+	return m_buf;
+}
+
 /** File properties **/
 
 /**
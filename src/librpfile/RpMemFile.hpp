@@ -91,6 +91,17 @@ class RpMemFile : public IRpFile
 		 */
 		int truncate(off64_t size = 0) final;
 
+	public:
+		/** Memory mapping **/
+
+		/**
+		 * Map the entire file into memory, if supported.
+		 * RpMemFile is already backed by memory, so this
+		 * simply returns the memory buffer.
+		 * @return Pointer to the mapped file data, or nullptr if not open.
+		 */
+		const void *map(void) final;
+
 	public:
 		/** File properties **/
 
@@ -104,7 +115,7 @@ class RpMemFile : public IRpFile
 		 * Get the filename.
 		 * @return Filename. (May be empty if the filename is not available.)
 		 */
-		std::string filename(void) const final;
+		std::string filename(void) const override;
 
 	protected:
 		const void *m_buf;	// Memory buffer.
@@ -0,0 +1,193 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * RpMmapFile.cpp: IRpFile implementation using a memory-mapped file.      *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RpMmapFile.hpp"
+
+#ifdef _WIN32
+// Windows: MapViewOfFile()
+#include "libwin32common/MiniU82T.hpp"
+#include "libwin32common/w32err.h"
+using LibWin32Common::U82T_s;
+#else /* !_WIN32 */
+// POSIX: mmap()
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif /* _WIN32 */
+
+// C++ STL classes.
+using std::string;
+
+namespace LibRpFile {
+
+/**
+ * Open a file as a read-only memory mapping.
+ *
+ * The entire file is mapped into the address space, so
+ * read() and map() are serviced directly from the page
+ * cache with zero copies.
+ *
+ * Only regular files can be mapped. For device files and
+ * other special files, use RpFile instead.
+ *
+ * @param filename Filename. (UTF-8)
+ */
+RpMmapFile::RpMmapFile(const char *filename)
+	: super()
+	, m_filename(filename ? filename : "")
+#ifdef _WIN32
+	, m_hMapping(nullptr)
+#endif /* _WIN32 */
+{
+	assert(filename != nullptr);
+	if (!filename) {
+		m_lastError = EINVAL;
+		return;
+	}
+
+#ifdef _WIN32
+	// Open the file.
+	HANDLE hFile = CreateFile(U82T_s(m_filename).c_str(),
+		GENERIC_READ, FILE_SHARE_READ, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (hFile == INVALID_HANDLE_VALUE) {
+		m_lastError = w32err_to_posix(GetLastError());
+		return;
+	}
+
+	// Get the file size.
+	LARGE_INTEGER liFileSize;
+	if (!GetFileSizeEx(hFile, &liFileSize) || liFileSize.QuadPart <= 0) {
+		// Cannot map an empty file.
+		m_lastError = EINVAL;
+		CloseHandle(hFile);
+		return;
+	}
+#if !defined(_WIN64)
+	if (liFileSize.QuadPart > static_cast<LONGLONG>(SIZE_MAX)) {
+		// File is too big to map into the address space.
+		m_lastError = EFBIG;
+		CloseHandle(hFile);
+		return;
+	}
+#endif /* !_WIN64 */
+
+	// Create the file mapping.
+	m_hMapping = CreateFileMapping(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	// The mapping keeps its own reference to the file.
+	CloseHandle(hFile);
+	if (!m_hMapping) {
+		m_lastError = w32err_to_posix(GetLastError());
+		return;
+	}
+
+	// Map a view of the entire file.
+	const void *map = MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0);
+	if (!map) {
+		m_lastError = w32err_to_posix(GetLastError());
+		CloseHandle(m_hMapping);
+		m_hMapping = nullptr;
+		return;
+	}
+
+	m_buf = map;
+	m_size = static_cast<size_t>(liFileSize.QuadPart);
+	m_pos = 0;
+#else /* !_WIN32 */
+	// Open the file.
+	int fd = ::open(filename, O_RDONLY);
+	if (fd < 0) {
+		m_lastError = errno;
+		return;
+	}
+
+	// Make sure this is a regular file with a non-zero size.
+	struct stat sb;
+	if (fstat(fd, &sb) != 0) {
+		m_lastError = errno;
+		::close(fd);
+		return;
+	}
+	if (!S_ISREG(sb.st_mode) || sb.st_size <= 0) {
+		// Cannot map this file.
+		m_lastError = EINVAL;
+		::close(fd);
+		return;
+	}
+#if !defined(__LP64__) && !defined(_LP64)
+	if (sb.st_size > static_cast<off64_t>(SIZE_MAX)) {
+		// File is too big to map into the address space.
+		m_lastError = EFBIG;
+		::close(fd);
+		return;
+	}
+#endif /* !__LP64__ && !_LP64 */
+
+	// Map the entire file, read-only.
+	void *map = mmap(nullptr, static_cast<size_t>(sb.st_size),
+		PROT_READ, MAP_SHARED, fd, 0);
+	// The mapping keeps its own reference to the file.
+	::close(fd);
+	if (map == MAP_FAILED) {
+		m_lastError = errno;
+		return;
+	}
+
+	m_buf = map;
+	m_size = static_cast<size_t>(sb.st_size);
+	m_pos = 0;
+#endif /* _WIN32 */
+}
+
+RpMmapFile::~RpMmapFile()
+{
+	if (m_buf) {
+#ifdef _WIN32
+		UnmapViewOfFile(m_buf);
+		if (m_hMapping) {
+			CloseHandle(m_hMapping);
+		}
+#else /* !_WIN32 */
+		munmap(const_cast<void*>(m_buf), m_size);
+#endif /* _WIN32 */
+	}
+}
+
+/**
+ * Close the file.
+ * This unmaps the file data.
+ */
+void RpMmapFile::close(void)
+{
+	if (m_buf) {
+#ifdef _WIN32
+		UnmapViewOfFile(m_buf);
+		if (m_hMapping) {
+			CloseHandle(m_hMapping);
+			m_hMapping = nullptr;
+		}
+#else /* !_WIN32 */
+		munmap(const_cast<void*>(m_buf), m_size);
+#endif /* _WIN32 */
+	}
+
+	super::close();
+}
+
+/**
+ * Get the filename.
+ * @return Filename. (May be empty if the filename is not available.)
+ */
+string RpMmapFile::filename(void) const
+{
+	return m_filename;
+}
+
+}
@@ -0,0 +1,65 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * RpMmapFile.hpp: IRpFile implementation using a memory-mapped file.      *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_RPMMAPFILE_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_RPMMAPFILE_HPP__
+
+#include "RpMemFile.hpp"
+
+#ifdef _WIN32
+#include "libwin32common/RpWin32_sdk.h"
+#endif /* _WIN32 */
+
+namespace LibRpFile {
+
+class RpMmapFile : public RpMemFile
+{
+	public:
+		/**
+		 * Open a file as a read-only memory mapping.
+		 *
+		 * The entire file is mapped into the address space, so
+		 * read() and map() are serviced directly from the page
+		 * cache with zero copies.
+		 *
+		 * Only regular files can be mapped. For device files and
+		 * other special files, use RpFile instead.
+		 *
+		 * @param filename Filename. (UTF-8)
+		 */
+		explicit RpMmapFile(const char *filename);
+	protected:
+		virtual ~RpMmapFile();	// call unref() instead
+
+	private:
+		typedef RpMemFile super;
+		RP_DISABLE_COPY(RpMmapFile)
+
+	public:
+		/**
+		 * Close the file.
+		 * This unmaps the file data.
+		 */
+		void close(void) final;
+
+		/**
+		 * Get the filename.
+		 * @return Filename. (May be empty if the filename is not available.)
+		 */
+		std::string filename(void) const final;
+
+	protected:
+		std::string m_filename;	// Filename. (UTF-8)
+#ifdef _WIN32
+		HANDLE m_hMapping;	// File mapping object.
+#endif /* _WIN32 */
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_RPMMAPFILE_HPP__ */
@@ -0,0 +1,237 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                       *
+ * RpStats.cpp: Lightweight runtime statistics counters.                   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "RpStats.hpp"
+
+#ifdef ENABLE_RP_STATS
+
+// librpthreads
+#include "librpthreads/Mutex.hpp"
+using LibRpBase::Mutex;
+using LibRpBase::MutexLocker;
+
+// C++ includes.
+#include <atomic>
+#include <iomanip>
+#include <string>
+#include <vector>
+using std::string;
+using std::vector;
+
+// For peak RSS reporting.
+#ifdef _WIN32
+# include "libwin32common/RpWin32_sdk.h"
+# include <psapi.h>
+#else /* !_WIN32 */
+# include <sys/resource.h>
+#endif /* _WIN32 */
+
+namespace LibRpFile { namespace RpStats {
+
+// Process-wide counters.
+// NOTE: Relaxed ordering is used everywhere; the counters are
+// informational only and don't synchronize any other data.
+static std::atomic<uint64_t> g_counters[CTR_MAX];
+
+// Counter descriptions, in Counter order.
+static const char *const ctr_descriptions[CTR_MAX] = {
+	"RomDataFactory::create() calls",
+	"RomData objects created",
+	"Bytes read via RpFile",
+	"ImageDecoder fromLinear calls",
+	"ImageDecoder DXTn/BC4/BC5 calls",
+	"ImageDecoder BC7 calls",
+	"ImageDecoder ETC1/ETC2 calls",
+	"CacheManager cache hits",
+	"CacheManager cache misses",
+	"rp_image allocations",
+	"rp_image allocations rejected by budget",
+	"RomDataFactory::create() time",
+};
+
+// Trace event recording.
+// The enabled flag is checked with relaxed atomics so
+// instrumented hot paths only pay for a single load when
+// tracing is off.
+static std::atomic<bool> g_traceEnabled(false);
+
+struct TraceEvent {
+	string stage;		// Stage name, e.g. "probe".
+	string detail;		// Event detail.
+	uint64_t time_us;	// Elapsed time, in microseconds.
+	uint64_t bytes_read;	// Bytes read during the event.
+};
+
+static Mutex g_traceMutex;
+static vector<TraceEvent> g_traceEvents;
+
+/**
+ * Increment a statistics counter.
+ * @param ctr Counter.
+ * @param amount Amount to add. (default is 1)
+ */
+void increment(Counter ctr, uint64_t amount)
+{
+	assert(ctr >= 0 && ctr < CTR_MAX);
+	if (ctr < 0 || ctr >= CTR_MAX)
+		return;
+	g_counters[ctr].fetch_add(amount, std::memory_order_relaxed);
+}
+
+/**
+ * Get the current value of a statistics counter.
+ * @param ctr Counter.
+ * @return Counter value.
+ */
+uint64_t get(Counter ctr)
+{
+	assert(ctr >= 0 && ctr < CTR_MAX);
+	if (ctr < 0 || ctr >= CTR_MAX)
+		return 0;
+	return g_counters[ctr].load(std::memory_order_relaxed);
+}
+
+/**
+ * Reset all statistics counters to zero.
+ */
+void reset(void)
+{
+	for (int i = 0; i < CTR_MAX; i++) {
+		g_counters[i].store(0, std::memory_order_relaxed);
+	}
+}
+
+/**
+ * Dump all statistics counters in a human-readable format.
+ * @param os Output stream.
+ */
+void dump(std::ostream &os)
+{
+	os << "Runtime statistics:\n";
+	for (int i = 0; i < CTR_MAX; i++) {
+		const uint64_t value = g_counters[i].load(std::memory_order_relaxed);
+		os << "  " << ctr_descriptions[i] << ": ";
+		if (i >= TMR_ROMDATA_PROBE) {
+			// Timer. Print in milliseconds.
+			os << (value / 1000000U) << '.';
+			const char prev_fill = os.fill('0');
+			os.width(3);
+			os << ((value / 1000U) % 1000U);
+			os.fill(prev_fill);
+			os << " ms";
+		} else {
+			os << value;
+		}
+		os << '\n';
+	}
+
+	// Peak RSS, so memory regressions show up in the same
+	// place as the counters. (Useful when running the
+	// thumbnailer under a cgroup memory limit.)
+	uint64_t peak_rss = 0;
+#ifdef _WIN32
+	PROCESS_MEMORY_COUNTERS pmc;
+	if (GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc))) {
+		peak_rss = pmc.PeakWorkingSetSize;
+	}
+#else /* !_WIN32 */
+	struct rusage ru;
+	if (!getrusage(RUSAGE_SELF, &ru)) {
+		// NOTE: ru_maxrss is in kilobytes on Linux.
+		peak_rss = static_cast<uint64_t>(ru.ru_maxrss) * 1024U;
+	}
+#endif /* _WIN32 */
+	if (peak_rss != 0) {
+		os << "  Peak RSS: " << (peak_rss / 1024U) << " KiB\n";
+	}
+	os.flush();
+}
+
+/**
+ * Enable or disable trace event recording.
+ *
+ * While enabled, instrumented sites record per-stage events
+ * (probe candidates, decode stages, etc.) with timing and I/O
+ * information. This is strictly a diagnostic mode; events are
+ * accumulated under a mutex, so don't leave it enabled in
+ * normal operation.
+ *
+ * @param enabled True to enable tracing.
+ */
+void setTraceEnabled(bool enabled)
+{
+	g_traceEnabled.store(enabled, std::memory_order_relaxed);
+	if (!enabled) {
+		MutexLocker locker(g_traceMutex);
+		g_traceEvents.clear();
+	}
+}
+
+/**
+ * Is trace event recording enabled?
+ * @return True if enabled.
+ */
+bool isTraceEnabled(void)
+{
+	return g_traceEnabled.load(std::memory_order_relaxed);
+}
+
+/**
+ * Record a trace event.
+ * Does nothing if tracing is disabled.
+ * @param stage Stage name, e.g. "probe".
+ * @param detail Event detail, e.g. the candidate parser and verdict.
+ * @param time_us Elapsed time for this event, in microseconds.
+ * @param bytes_read Bytes read from the file during this event.
+ */
+void traceEvent(const char *stage, const char *detail, uint64_t time_us, uint64_t bytes_read)
+{
+	if (!isTraceEnabled())
+		return;
+
+	MutexLocker locker(g_traceMutex);
+	g_traceEvents.resize(g_traceEvents.size() + 1);
+	TraceEvent &event = g_traceEvents.back();
+	event.stage = stage;
+	event.detail = (detail ? detail : "");
+	event.time_us = time_us;
+	event.bytes_read = bytes_read;
+}
+
+/**
+ * Dump all recorded trace events in a human-readable format,
+ * then clear the event log.
+ * @param os Output stream.
+ */
+void dumpTrace(std::ostream &os)
+{
+	// Move the events out so the mutex isn't held during I/O.
+	vector<TraceEvent> events;
+	{
+		MutexLocker locker(g_traceMutex);
+		std::swap(events, g_traceEvents);
+	}
+
+	os << "Trace: " << events.size() << " event(s)\n";
+	os << "     time (us)   bytes read  stage\n";
+	for (auto iter = events.cbegin(); iter != events.cend(); ++iter) {
+		os << "  " << std::setw(12) << iter->time_us
+		   << ' ' << std::setw(12) << iter->bytes_read
+		   << "  " << iter->stage;
+		if (!iter->detail.empty()) {
+			os << ": " << iter->detail;
+		}
+		os << '\n';
+	}
+	os.flush();
+}
+
+} }
+
+#endif /* ENABLE_RP_STATS */
@@ -0,0 +1,201 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                       *
+ * RpStats.hpp: Lightweight runtime statistics counters.                   *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_RPSTATS_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_RPSTATS_HPP__
+
+#include "config.librpfile.h"
+#include "common.h"
+
+// C includes.
+#include <stdint.h>
+
+// C++ includes.
+#include <ostream>
+
+#ifdef ENABLE_RP_STATS
+# include <chrono>
+#endif /* ENABLE_RP_STATS */
+
+namespace LibRpFile { namespace RpStats {
+
+/**
+ * Statistics counters.
+ *
+ * Counters are process-wide, updated with relaxed atomics, and
+ * compiled out entirely if ENABLE_RP_STATS is disabled.
+ */
+enum Counter {
+	// Event counters.
+	CTR_ROMDATA_PROBE = 0,		// RomDataFactory::create() calls
+	CTR_ROMDATA_CREATED,		// RomData objects successfully created
+	CTR_FILE_BYTES_READ,		// Bytes read via RpFile
+	CTR_IMGDEC_LINEAR,		// ImageDecoder: fromLinear*()
+	CTR_IMGDEC_DXTN,		// ImageDecoder: DXTn / BC4 / BC5
+	CTR_IMGDEC_BC7,			// ImageDecoder: BC7
+	CTR_IMGDEC_ETC,			// ImageDecoder: ETC1 / ETC2
+	CTR_CACHE_HIT,			// CacheManager: answered from the cache
+	CTR_CACHE_MISS,			// CacheManager: download required
+	CTR_IMG_ALLOC,			// rp_image allocations
+	CTR_IMG_BUDGET_REJECT,		// rp_image allocations rejected by budget
+
+	// Timers. (nanoseconds)
+	TMR_ROMDATA_PROBE,		// Time spent in RomDataFactory::create()
+
+	CTR_MAX
+};
+
+#ifdef ENABLE_RP_STATS
+
+/**
+ * Increment a statistics counter.
+ * @param ctr Counter.
+ * @param amount Amount to add. (default is 1)
+ */
+void increment(Counter ctr, uint64_t amount = 1);
+
+/**
+ * Get the current value of a statistics counter.
+ * @param ctr Counter.
+ * @return Counter value.
+ */
+uint64_t get(Counter ctr);
+
+/**
+ * Reset all statistics counters to zero.
+ */
+void reset(void);
+
+/**
+ * Dump all statistics counters in a human-readable format.
+ * @param os Output stream.
+ */
+void dump(std::ostream &os);
+
+/**
+ * Enable or disable trace event recording.
+ *
+ * While enabled, instrumented sites record per-stage events
+ * (probe candidates, decode stages, etc.) with timing and I/O
+ * information. This is strictly a diagnostic mode; events are
+ * accumulated under a mutex, so don't leave it enabled in
+ * normal operation.
+ *
+ * @param enabled True to enable tracing.
+ */
+void setTraceEnabled(bool enabled);
+
+/**
+ * Is trace event recording enabled?
+ * @return True if enabled.
+ */
+bool isTraceEnabled(void);
+
+/**
+ * Record a trace event.
+ * Does nothing if tracing is disabled.
+ * @param stage Stage name, e.g. "probe".
+ * @param detail Event detail, e.g. the candidate parser and verdict.
+ * @param time_us Elapsed time for this event, in microseconds.
+ * @param bytes_read Bytes read from the file during this event.
+ */
+void traceEvent(const char *stage, const char *detail, uint64_t time_us, uint64_t bytes_read);
+
+/**
+ * Dump all recorded trace events in a human-readable format,
+ * then clear the event log.
+ * @param os Output stream.
+ */
+void dumpTrace(std::ostream &os);
+
+/**
+ * Scoped timer. Adds the elapsed time (in nanoseconds)
+ * to the specified timer counter on destruction.
+ */
+class ScopedTimer {
+	public:
+		explicit ScopedTimer(Counter ctr)
+			: m_ctr(ctr)
+			, m_start(std::chrono::steady_clock::now())
+		{ }
+
+		~ScopedTimer()
+		{
+			const auto elapsed = std::chrono::steady_clock::now() - m_start;
+			increment(m_ctr, static_cast<uint64_t>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+		}
+
+	private:
+		RP_DISABLE_COPY(ScopedTimer)
+		Counter m_ctr;
+		std::chrono::steady_clock::time_point m_start;
+};
+
+#else /* !ENABLE_RP_STATS */
+
+/** No-op implementations. **/
+
+static inline void increment(Counter ctr, uint64_t amount = 1)
+{
+	RP_UNUSED(ctr);
+	RP_UNUSED(amount);
+}
+
+static inline uint64_t get(Counter ctr)
+{
+	RP_UNUSED(ctr);
+	return 0;
+}
+
+static inline void reset(void) { }
+
+static inline void dump(std::ostream &os)
+{
+	RP_UNUSED(os);
+}
+
+static inline void setTraceEnabled(bool enabled)
+{
+	RP_UNUSED(enabled);
+}
+
+static inline bool isTraceEnabled(void)
+{
+	return false;
+}
+
+static inline void traceEvent(const char *stage, const char *detail, uint64_t time_us, uint64_t bytes_read)
+{
+	RP_UNUSED(stage);
+	RP_UNUSED(detail);
+	RP_UNUSED(time_us);
+	RP_UNUSED(bytes_read);
+}
+
+static inline void dumpTrace(std::ostream &os)
+{
+	RP_UNUSED(os);
+}
+
+class ScopedTimer {
+	public:
+		explicit ScopedTimer(Counter ctr)
+		{
+			RP_UNUSED(ctr);
+		}
+
+	private:
+		RP_DISABLE_COPY(ScopedTimer)
+};
+
+#endif /* ENABLE_RP_STATS */
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_RPSTATS_HPP__ */
@@ -0,0 +1,528 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * RpZipFile.cpp: IRpFile implementation for a ZIP archive member.         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+// Reference: https://pkware.cachefly.net/webdocs/casestudies/APPNOTE.TXT
+
+#include "stdafx.h"
+#include "RpZipFile.hpp"
+
+// C++ includes.
+#include <memory>
+
+// C++ STL classes.
+using std::string;
+using std::unique_ptr;
+using std::vector;
+
+// zlib
+#include <zlib.h>
+
+namespace LibRpFile {
+
+// ZIP on-disk structures.
+// All fields are in little-endian.
+#pragma pack(1)
+
+// Local file header. (signature "PK\x03\x04")
+typedef struct PACKED _ZIP_LocalFileHeader {
+	uint32_t signature;		// [0x000] "PK\x03\x04"
+	uint16_t version_needed;	// [0x004]
+	uint16_t flags;			// [0x006]
+	uint16_t method;		// [0x008] Compression method.
+	uint16_t mod_time;		// [0x00A]
+	uint16_t mod_date;		// [0x00C]
+	uint32_t crc32;			// [0x00E]
+	uint32_t compressed_size;	// [0x012]
+	uint32_t uncompressed_size;	// [0x016]
+	uint16_t name_len;		// [0x01A]
+	uint16_t extra_len;		// [0x01C]
+} ZIP_LocalFileHeader;
+ASSERT_STRUCT(ZIP_LocalFileHeader, 30);
+
+// Central directory file header. (signature "PK\x01\x02")
+typedef struct PACKED _ZIP_CentralDirHeader {
+	uint32_t signature;		// [0x000] "PK\x01\x02"
+	uint16_t version_made_by;	// [0x004]
+	uint16_t version_needed;	// [0x006]
+	uint16_t flags;			// [0x008]
+	uint16_t method;		// [0x00A] Compression method.
+	uint16_t mod_time;		// [0x00C]
+	uint16_t mod_date;		// [0x00E]
+	uint32_t crc32;			// [0x010]
+	uint32_t compressed_size;	// [0x014]
+	uint32_t uncompressed_size;	// [0x018]
+	uint16_t name_len;		// [0x01C]
+	uint16_t extra_len;		// [0x01E]
+	uint16_t comment_len;		// [0x020]
+	uint16_t disk_start;		// [0x022]
+	uint16_t int_attrs;		// [0x024]
+	uint32_t ext_attrs;		// [0x026]
+	uint32_t local_header_offset;	// [0x02A]
+} ZIP_CentralDirHeader;
+ASSERT_STRUCT(ZIP_CentralDirHeader, 46);
+
+// End of central directory record. (signature "PK\x05\x06")
+typedef struct PACKED _ZIP_EndOfCentralDir {
+	uint32_t signature;		// [0x000] "PK\x05\x06"
+	uint16_t disk_number;		// [0x004]
+	uint16_t cd_start_disk;		// [0x006]
+	uint16_t cd_entries_disk;	// [0x008]
+	uint16_t cd_entries_total;	// [0x00A]
+	uint32_t cd_size;		// [0x00C]
+	uint32_t cd_offset;		// [0x010]
+	uint16_t comment_len;		// [0x012]
+} ZIP_EndOfCentralDir;
+ASSERT_STRUCT(ZIP_EndOfCentralDir, 22);
+
+#pragma pack()
+
+// ZIP signatures.
+static const uint32_t ZIP_LOCAL_SIGNATURE	= 0x04034B50;	// "PK\x03\x04"
+static const uint32_t ZIP_CENTRAL_SIGNATURE	= 0x02014B50;	// "PK\x01\x02"
+static const uint32_t ZIP_EOCD_SIGNATURE	= 0x06054B50;	// "PK\x05\x06"
+
+// Compression methods.
+static const uint16_t ZIP_METHOD_STORED		= 0;
+static const uint16_t ZIP_METHOD_DEFLATE	= 8;
+
+// Maximum central directory size.
+static const uint32_t ZIP_CD_SIZE_MAX = 16U*1024*1024;
+// Maximum uncompressed size for deflated members.
+// Deflated members are decompressed into memory, so this
+// limits memory usage. (Stored members have no size limit.)
+static const uint32_t ZIP_DEFLATE_SIZE_MAX = 64U*1024*1024;
+
+/**
+ * Open the main member of a ZIP archive.
+ * The resulting IRpFile is read-only.
+ *
+ * The ZIP file is ref()'d, so the original file can be
+ * unref()'d by the caller afterwards.
+ *
+ * Check isOpen() to determine if a usable member was found.
+ * Encrypted members, unsupported compression methods, and
+ * ZIP64 archives are not supported.
+ *
+ * @param file ZIP archive.
+ */
+RpZipFile::RpZipFile(IRpFile *file)
+	: super()
+	, m_file(nullptr)
+	, m_size(0)
+	, m_pos(0)
+	, m_dataOffset(0)
+	, m_compressedSize(0)
+	, m_isDeflate(false)
+{
+	assert(file != nullptr);
+	if (!file) {
+		m_lastError = EBADF;
+		return;
+	}
+
+	m_file = file->ref();
+
+	// Find the End of Central Directory record.
+	// It's located within the last 64 KB + 22 bytes of the file.
+	const off64_t fileSize = m_file->size();
+	if (fileSize < static_cast<off64_t>(sizeof(ZIP_EndOfCentralDir))) {
+		// Too small to be a ZIP archive.
+		goto invalid;
+	}
+
+	{
+		const off64_t tail_max = static_cast<off64_t>(sizeof(ZIP_EndOfCentralDir)) + 65535;
+		const off64_t tail_len = (fileSize < tail_max ? fileSize : tail_max);
+		const off64_t tail_addr = fileSize - tail_len;
+		unique_ptr<uint8_t[]> tail(new uint8_t[static_cast<size_t>(tail_len)]);
+		size_t sz_read = m_file->seekAndRead(tail_addr, tail.get(), static_cast<size_t>(tail_len));
+		if (sz_read != static_cast<size_t>(tail_len)) {
+			// Error reading the end of the file.
+			goto invalid;
+		}
+
+		// Search backwards for the EOCD signature.
+		const ZIP_EndOfCentralDir *eocd = nullptr;
+		for (off64_t i = tail_len - sizeof(ZIP_EndOfCentralDir); i >= 0; i--) {
+			if (tail[i] == 'P' && tail[i+1] == 'K' &&
+			    tail[i+2] == 0x05 && tail[i+3] == 0x06)
+			{
+				eocd = reinterpret_cast<const ZIP_EndOfCentralDir*>(&tail[i]);
+				break;
+			}
+		}
+		if (!eocd) {
+			// No EOCD record.
+			goto invalid;
+		}
+
+		const unsigned int cd_entries = le16_to_cpu(eocd->cd_entries_total);
+		const uint32_t cd_size = le32_to_cpu(eocd->cd_size);
+		const uint32_t cd_offset = le32_to_cpu(eocd->cd_offset);
+		if (cd_entries == 0 || cd_entries == 0xFFFF ||
+		    cd_size < sizeof(ZIP_CentralDirHeader) || cd_size > ZIP_CD_SIZE_MAX ||
+		    cd_offset == 0xFFFFFFFF ||
+		    le16_to_cpu(eocd->disk_number) != 0)
+		{
+			// Empty, multi-disk, or ZIP64 archive.
+			// ZIP64 isn't supported.
+			goto invalid;
+		}
+
+		// Read the central directory.
+		unique_ptr<uint8_t[]> cd(new uint8_t[cd_size]);
+		sz_read = m_file->seekAndRead(cd_offset, cd.get(), cd_size);
+		if (sz_read != cd_size) {
+			// Error reading the central directory.
+			goto invalid;
+		}
+
+		// Select the largest usable member.
+		// Retro ROM archives usually contain a single ROM file,
+		// possibly alongside small text files.
+		const ZIP_CentralDirHeader *best = nullptr;
+		string bestName;
+		uint32_t p = 0;
+		for (unsigned int i = 0; i < cd_entries; i++) {
+			if (p + sizeof(ZIP_CentralDirHeader) > cd_size) {
+				// Out of central directory data.
+				break;
+			}
+			const ZIP_CentralDirHeader *const hdr =
+				reinterpret_cast<const ZIP_CentralDirHeader*>(&cd[p]);
+			if (le32_to_cpu(hdr->signature) != ZIP_CENTRAL_SIGNATURE) {
+				// Invalid signature.
+				break;
+			}
+
+			const unsigned int name_len = le16_to_cpu(hdr->name_len);
+			const uint32_t entry_len = sizeof(ZIP_CentralDirHeader) +
+				name_len + le16_to_cpu(hdr->extra_len) +
+				le16_to_cpu(hdr->comment_len);
+			if (p + entry_len > cd_size) {
+				// Entry extends past the central directory.
+				break;
+			}
+			const char *const name =
+				reinterpret_cast<const char*>(&cd[p + sizeof(ZIP_CentralDirHeader)]);
+			p += entry_len;
+
+			if (le16_to_cpu(hdr->flags) & 0x0001) {
+				// Encrypted member.
+				continue;
+			}
+			const uint16_t method = le16_to_cpu(hdr->method);
+			if (method != ZIP_METHOD_STORED && method != ZIP_METHOD_DEFLATE) {
+				// Unsupported compression method.
+				continue;
+			}
+			if (name_len == 0 || name[name_len-1] == '/') {
+				// Directory entry.
+				continue;
+			}
+			if (name_len >= 9 && !memcmp(name, "__MACOSX/", 9)) {
+				// macOS resource fork metadata.
+				continue;
+			}
+			if (method == ZIP_METHOD_DEFLATE &&
+			    le32_to_cpu(hdr->uncompressed_size) > ZIP_DEFLATE_SIZE_MAX)
+			{
+				// Deflated member is too big to decompress into memory.
+				continue;
+			}
+
+			if (!best ||
+			    le32_to_cpu(hdr->uncompressed_size) > le32_to_cpu(best->uncompressed_size))
+			{
+				best = hdr;
+				bestName.assign(name, name_len);
+			}
+		}
+		if (!best) {
+			// No usable member found.
+			goto invalid;
+		}
+
+		// Read the member's local file header to find the data offset.
+		// The local header's name/extra lengths can differ from the
+		// central directory entry.
+		ZIP_LocalFileHeader localHdr;
+		const uint32_t local_offset = le32_to_cpu(best->local_header_offset);
+		sz_read = m_file->seekAndRead(local_offset, &localHdr, sizeof(localHdr));
+		if (sz_read != sizeof(localHdr) ||
+		    le32_to_cpu(localHdr.signature) != ZIP_LOCAL_SIGNATURE)
+		{
+			// Error reading the local file header.
+			goto invalid;
+		}
+
+		m_memberName = bestName;
+		m_size = static_cast<off64_t>(le32_to_cpu(best->uncompressed_size));
+		m_compressedSize = le32_to_cpu(best->compressed_size);
+		m_isDeflate = (le16_to_cpu(best->method) == ZIP_METHOD_DEFLATE);
+		m_dataOffset = static_cast<off64_t>(local_offset) +
+			sizeof(localHdr) +
+			le16_to_cpu(localHdr.name_len) +
+			le16_to_cpu(localHdr.extra_len);
+	}
+	return;
+
+invalid:
+	// Not a usable ZIP archive.
+	m_file->unref();
+	m_file = nullptr;
+	m_lastError = EIO;
+}
+
+RpZipFile::~RpZipFile()
+{
+	if (m_file) {
+		m_file->unref();
+	}
+}
+
+/**
+ * Does this look like a ZIP archive?
+ * Checks for the local file header magic.
+ * @param pHeader File header.
+ * @param szHeader Size of header.
+ * @return True if this looks like a ZIP archive; false if not.
+ */
+bool RpZipFile::isZip(const uint8_t *pHeader, size_t szHeader)
+{
+	if (szHeader < 4) {
+		// Not enough data to check.
+		return false;
+	}
+
+	// Check the local file header signature.
+	// NOTE: Empty and spanned archives ("PK\x05\x06", "PK\x07\x08")
+	// don't have a usable first member, so they're not accepted.
+	return (pHeader[0] == 'P' && pHeader[1] == 'K' &&
+		pHeader[2] == 0x03 && pHeader[3] == 0x04);
+}
+
+/**
+ * Is the file open?
+ * This usually only returns false if an error occurred.
+ * @return True if the file is open; false if it isn't.
+ */
+bool RpZipFile::isOpen(void) const
+{
+	return (m_file != nullptr);
+}
+
+/**
+ * Close the file.
+ */
+void RpZipFile::close(void)
+{
+	if (m_file) {
+		m_file->unref();
+		m_file = nullptr;
+	}
+	m_memberBuf.clear();
+	m_memberBuf.shrink_to_fit();
+	m_size = 0;
+	m_pos = 0;
+}
+
+/**
+ * Decompress the deflated member into the member buffer.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int RpZipFile::inflateMember(void)
+{
+	// Read the compressed data.
+	unique_ptr<uint8_t[]> z_buf(new uint8_t[m_compressedSize]);
+	const size_t sz_read = m_file->seekAndRead(m_dataOffset, z_buf.get(), m_compressedSize);
+	if (sz_read != m_compressedSize) {
+		// Error reading the compressed data.
+		return -EIO;
+	}
+
+	// Initialize zlib.
+	// NOTE: ZIP uses raw deflate, so we need to specify -15.
+	z_stream strm;
+	strm.zalloc = Z_NULL;
+	strm.zfree = Z_NULL;
+	strm.opaque = Z_NULL;
+	strm.avail_in = 0;
+	strm.next_in = Z_NULL;
+	int ret = inflateInit2(&strm, -15);
+	if (ret != Z_OK) {
+		// Error initializing zlib.
+		return -ENOMEM;
+	}
+
+	m_memberBuf.resize(static_cast<size_t>(m_size));
+	strm.avail_in = m_compressedSize;
+	strm.next_in = z_buf.get();
+	strm.avail_out = static_cast<uInt>(m_memberBuf.size());
+	strm.next_out = m_memberBuf.data();
+
+	ret = inflate(&strm, Z_FINISH);
+	const uInt avail_out = strm.avail_out;
+	inflateEnd(&strm);
+	if ((ret != Z_OK && ret != Z_STREAM_END) || avail_out != 0) {
+		// Error decompressing.
+		m_memberBuf.clear();
+		m_memberBuf.shrink_to_fit();
+		return -EIO;
+	}
+
+	return 0;
+}
+
+/**
+ * Read data from the file.
+ * @param ptr Output data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes read.
+ */
+size_t RpZipFile::read(void *ptr, size_t size)
+{
+	if (!m_file) {
+		m_lastError = EBADF;
+		return 0;
+	}
+
+	if (unlikely(size == 0)) {
+		// Not reading anything...
+		return 0;
+	}
+
+	// Check if size is in bounds.
+	if (m_pos > m_size - static_cast<off64_t>(size)) {
+		// Not enough data.
+		// Copy whatever's left in the member.
+		size = static_cast<size_t>(m_size - m_pos);
+		if (size == 0) {
+			// End of member.
+			return 0;
+		}
+	}
+
+	if (!m_isDeflate) {
+		// Stored member. Read directly from the underlying file.
+		const size_t sz_read = m_file->seekAndRead(m_dataOffset + m_pos, ptr, size);
+		m_lastError = m_file->lastError();
+		m_pos += sz_read;
+		return sz_read;
+	}
+
+	// Deflated member. Decompress it on first read.
+	if (m_memberBuf.empty()) {
+		const int ret = inflateMember();
+		if (ret != 0) {
+			// Error decompressing the member.
+			m_lastError = -ret;
+			return 0;
+		}
+	}
+
+	memcpy(ptr, &m_memberBuf[static_cast<size_t>(m_pos)], size);
+	m_pos += size;
+	return size;
+}
+
+/**
+ * Write data to the file.
+ * (NOTE: Not valid for RpZipFile; this will always return 0.)
+ * @param ptr Input data buffer.
+ * @param size Amount of data to read, in bytes.
+ * @return Number of bytes written.
+ */
+size_t RpZipFile::write(const void *ptr, size_t size)
+{
+	// Not a valid operation for RpZipFile.
+	RP_UNUSED(ptr);
+	RP_UNUSED(size);
+	m_lastError = EBADF;
+	return 0;
+}
+
+/**
+ * Set the file position.
+ * @param pos File position.
+ * @return 0 on success; -1 on error.
+ */
+int RpZipFile::seek(off64_t pos)
+{
+	if (!m_file) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	if (pos <= 0) {
+		m_pos = 0;
+	} else if (pos >= m_size) {
+		m_pos = m_size;
+	} else {
+		m_pos = pos;
+	}
+
+	return 0;
+}
+
+/**
+ * Get the file position.
+ * @return File position, or -1 on error.
+ */
+off64_t RpZipFile::tell(void)
+{
+	if (!m_file) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	return m_pos;
+}
+
+/**
+ * Truncate the file.
+ * (NOTE: Not valid for RpZipFile; this will always return -1.)
+ * @param size New size. (default is 0)
+ * @return 0 on success; -1 on error.
+ */
+int RpZipFile::truncate(off64_t size)
+{
+	// Not supported.
+	RP_UNUSED(size);
+	m_lastError = ENOTSUP;
+	return -1;
+}
+
+/** File properties **/
+
+/**
+ * Get the file size.
+ * This is the uncompressed size of the member.
+ * @return File size, or negative on error.
+ */
+off64_t RpZipFile::size(void)
+{
+	if (!m_file) {
+		m_lastError = EBADF;
+		return -1;
+	}
+
+	return m_size;
+}
+
+/**
+ * Get the filename.
+ * This is the name of the member within the archive.
+ * @return Filename. (May be empty if the filename is not available.)
+ */
+string RpZipFile::filename(void) const
+{
+	return m_memberName;
+}
+
+}
@@ -0,0 +1,153 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpfile)                        *
+ * RpZipFile.hpp: IRpFile implementation for a ZIP archive member.         *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPFILE_RPZIPFILE_HPP__
+#define __ROMPROPERTIES_LIBRPFILE_RPZIPFILE_HPP__
+
+#include "IRpFile.hpp"
+
+// C++ includes.
+#include <vector>
+
+namespace LibRpFile {
+
+/**
+ * IRpFile implementation that opens the main member of a ZIP archive.
+ *
+ * The largest non-directory member is selected, which matches the
+ * common one-ROM-per-archive layout. Stored members are read directly
+ * from the underlying file; deflated members are decompressed into
+ * memory on first read.
+ */
+class RpZipFile : public IRpFile
+{
+	public:
+		/**
+		 * Open the main member of a ZIP archive.
+		 * The resulting IRpFile is read-only.
+		 *
+		 * The ZIP file is ref()'d, so the original file can be
+		 * unref()'d by the caller afterwards.
+		 *
+		 * Check isOpen() to determine if a usable member was found.
+		 * Encrypted members, unsupported compression methods, and
+		 * ZIP64 archives are not supported.
+		 *
+		 * @param file ZIP archive.
+		 */
+		explicit RpZipFile(IRpFile *file);
+	protected:
+		virtual ~RpZipFile();	// call unref() instead
+
+	private:
+		typedef IRpFile super;
+		RP_DISABLE_COPY(RpZipFile)
+
+	public:
+		/**
+		 * Does this look like a ZIP archive?
+		 * Checks for the local file header magic.
+		 * @param pHeader File header.
+		 * @param szHeader Size of header.
+		 * @return True if this looks like a ZIP archive; false if not.
+		 */
+		static bool isZip(const uint8_t *pHeader, size_t szHeader);
+
+	public:
+		/**
+		 * Is the file open?
+		 * This usually only returns false if an error occurred.
+		 * @return True if the file is open; false if it isn't.
+		 */
+		bool isOpen(void) const final;
+
+		/**
+		 * Close the file.
+		 */
+		void close(void) final;
+
+		/**
+		 * Read data from the file.
+		 * @param ptr Output data buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes read.
+		 */
+		size_t read(void *ptr, size_t size) final;
+
+		/**
+		 * Write data to the file.
+		 * (NOTE: Not valid for RpZipFile; this will always return 0.)
+		 * @param ptr Input data buffer.
+		 * @param size Amount of data to read, in bytes.
+		 * @return Number of bytes written.
+		 */
+		size_t write(const void *ptr, size_t size) final;
+
+		/**
+		 * Set the file position.
+		 * @param pos File position.
+		 * @return 0 on success; -1 on error.
+		 */
+		int seek(off64_t pos) final;
+
+		/**
+		 * Get the file position.
+		 * @return File position, or -1 on error.
+		 */
+		off64_t tell(void) final;
+
+		/**
+		 * Truncate the file.
+		 * (NOTE: Not valid for RpZipFile; this will always return -1.)
+		 * @param size New size. (default is 0)
+		 * @return 0 on success; -1 on error.
+		 */
+		int truncate(off64_t size = 0) final;
+
+	public:
+		/** File properties **/
+
+		/**
+		 * Get the file size.
+		 * This is the uncompressed size of the member.
+		 * @return File size, or negative on error.
+		 */
+		off64_t size(void) final;
+
+		/**
+		 * Get the filename.
+		 * This is the name of the member within the archive.
+		 * @return Filename. (May be empty if the filename is not available.)
+		 */
+		std::string filename(void) const final;
+
+	private:
+		/**
+		 * Decompress the deflated member into the member buffer.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int inflateMember(void);
+
+	private:
+		IRpFile *m_file;		// Underlying ZIP archive.
+		std::string m_memberName;	// Name of the opened member.
+		off64_t m_size;			// Uncompressed member size.
+		off64_t m_pos;			// Current read position.
+
+		off64_t m_dataOffset;		// File offset of the member data.
+		uint32_t m_compressedSize;	// Compressed member size.
+		bool m_isDeflate;		// True if the member is deflated.
+
+		// Decompressed member data. (deflated members only)
+		// Filled on the first read.
+		std::vector<uint8_t> m_memberBuf;
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPFILE_RPZIPFILE_HPP__ */
@@ -14,6 +14,10 @@
 
 #include "scsi_protocol.h"
 
+// C++ includes.
+#include <mutex>
+#include <unordered_map>
+
 // C++ STL classes.
 using std::array;
 using std::unique_ptr;
@@ -21,6 +25,15 @@ using std::vector;
 
 namespace LibRpFile {
 
+// Cached Kreon feature lists, keyed by device filename.
+// The feature list is a drive firmware property, so it doesn't
+// change while the device node is attached. This way, each open
+// doesn't pay a feature list round trip.
+// NOTE: Only successful queries are cached; a drive that gets
+// reflashed with Kreon firmware will be detected on the next query.
+static std::mutex kreon_cache_mutex;
+static std::unordered_map<std::string, vector<uint16_t> > kreon_feature_cache;
+
 /**
  * Is this a supported Kreon drive?
  *
@@ -139,6 +152,16 @@ vector<uint16_t> RpFile::getKreonFeatureList(void)
 	}
 
 #ifdef RP_OS_SCSI_SUPPORTED
+	// Check the capability cache first.
+	{
+		std::lock_guard<std::mutex> lock(kreon_cache_mutex);
+		auto iter = kreon_feature_cache.find(d->filename);
+		if (iter != kreon_feature_cache.end()) {
+			// Found a cached feature list.
+			return iter->second;
+		}
+	}
+
 	// Kreon "Get Feature List" command
 	// Reference: https://github.com/saramibreak/DiscImageCreator/blob/cb9267da4877d32ab68263c25187cbaab3435ad5/DiscImageCreator/execScsiCmdforDVD.cpp#L1223
 	static const uint8_t cdb[6] = {0xFF, 0x08, 0x01, 0x10, 0x00, 0x00};
@@ -163,6 +186,10 @@ vector<uint16_t> RpFile::getKreonFeatureList(void)
 		// Kreon feature list is invalid.
 		vec.clear();
 		vec.shrink_to_fit();
+	} else {
+		// Cache the feature list.
+		std::lock_guard<std::mutex> lock(kreon_cache_mutex);
+		kreon_feature_cache.insert(std::make_pair(d->filename, vec));
 	}
 #endif /* RP_OS_SCSI_SUPPORTED */
 
@@ -19,14 +19,30 @@
 #include "ata_protocol.h"
 #include "scsi_ata_cmds.h"
 
+// C++ includes.
+#include <mutex>
+#include <unordered_map>
+
 namespace LibRpFile {
 
+// Cached SCSI INQUIRY responses, keyed by device filename.
+// The INQUIRY response describes the drive, not the media,
+// so it doesn't change while the device node is attached.
+// This way, each open doesn't pay an INQUIRY round trip.
+static std::mutex inquiry_cache_mutex;
+static std::unordered_map<std::string, SCSI_RESP_INQUIRY_STD> inquiry_cache;
+
 /**
- * Read one sector into the sector cache.
+ * Read the specified LBA into the sector cache.
+ *
+ * Reads up to SECTOR_CACHE_LBAS sectors in a single command,
+ * so sequential small reads don't pay one command round trip
+ * per sector.
+ *
  * @param lba LBA to read.
  * @return 0 on success; non-zero on error.
  */
-int RpFilePrivate::readOneLBA(uint32_t lba)
+int RpFilePrivate::readSectorCache(uint32_t lba)
 {
 	if (!devInfo) {
 		// Not a device.
@@ -42,41 +58,44 @@ int RpFilePrivate::readOneLBA(uint32_t lba)
 	//
 	// TODO: Not sure about NetBSD...
 	RP_Q(RpFile);
-	if (lba == devInfo->lba_cache) {
+	if (devInfo->isInSectorCache(lba)) {
 		// This LBA is already cached.
-		// TODO: Special case for ~0U?
-		if (!devInfo->isKreonUnlocked) {
-			// OSAPI: Seek to the next sector.
-			const off64_t seek_pos = (static_cast<off64_t>(lba) + 1) * devInfo->sector_size;
-#ifdef _WIN32
-			LARGE_INTEGER liSeekPos;
-			liSeekPos.QuadPart = seek_pos;
-			BOOL bRet = SetFilePointerEx(file, liSeekPos, nullptr, FILE_BEGIN);
-			if (!bRet) {
-				// Seek error.
-				q->m_lastError = w32err_to_posix(GetLastError());
-				return -q->m_lastError;
-			}
-#else /* !_WIN32 */
-			int ret = fseeko(file, seek_pos, SEEK_SET);
-			if (ret != 0) {
-				// Seek error.
-				q->m_lastError = errno;
-				return -q->m_lastError;
-			}
-#endif /* !_WIN32 */
-		}
+		// NOTE: No seek is needed here; the read functions
+		// always seek to an absolute position first.
 		return 0;
 	}
 
-	// Read the first block.
+	// Fill the sector cache, clamped to the device size.
+	const uint32_t lba_total = static_cast<uint32_t>(devInfo->device_size / devInfo->sector_size);
+	if (lba >= lba_total) {
+		// Out of range.
+		devInfo->lba_cache = ~0U;
+		devInfo->lba_cache_len = 0;
+		q->m_lastError = EIO;
+		return -EIO;
+	}
+	uint32_t lba_count = static_cast<uint32_t>(DeviceInfo::SECTOR_CACHE_LBAS);
+	if (lba_count > lba_total - lba) {
+		lba_count = lba_total - lba;
+	}
+	// NOTE: Keeping reads at 64 KB maximum due to READ(10) issues
+	// above a certain size on Linux. (see readUsingBlocks())
+	const uint32_t lba_max = 65536 / devInfo->sector_size;
+	if (lba_count > lba_max) {
+		lba_count = lba_max;
+	}
+	const size_t read_sz = static_cast<size_t>(lba_count) * devInfo->sector_size;
+
+	// Invalidate the cache in case the read fails.
+	devInfo->lba_cache = ~0U;
+	devInfo->lba_cache_len = 0;
+
 	if (devInfo->isKreonUnlocked) {
 		// Kreon drive. Use SCSI commands.
-		int sret = scsi_read(lba, 1, devInfo->sector_cache, devInfo->sector_size);
+		int sret = scsi_read(lba, static_cast<uint16_t>(lba_count), devInfo->sector_cache, read_sz);
 		if (sret != 0) {
 			// Read error.
 			// TODO: Handle this properly?
-			devInfo->lba_cache = ~0U;
 			q->m_lastError = sret;
 			return sret;
 		}
@@ -89,16 +108,14 @@ int RpFilePrivate::readOneLBA(uint32_t lba)
 		BOOL bRet = SetFilePointerEx(file, liSeekPos, nullptr, FILE_BEGIN);
 		if (!bRet) {
 			// Seek error.
-			devInfo->lba_cache = ~0U;
 			q->m_lastError = w32err_to_posix(GetLastError());
 			return -q->m_lastError;
 		}
 
 		DWORD bytesRead;
-		bRet = ReadFile(file, devInfo->sector_cache, devInfo->sector_size, &bytesRead, nullptr);
-		if (bRet == 0 || bytesRead != devInfo->sector_size) {
+		bRet = ReadFile(file, devInfo->sector_cache, static_cast<DWORD>(read_sz), &bytesRead, nullptr);
+		if (bRet == 0 || bytesRead != read_sz) {
 			// Read error.
-			devInfo->lba_cache = ~0U;
 			q->m_lastError = w32err_to_posix(GetLastError());
 			return -q->m_lastError;
 		}
@@ -106,14 +123,12 @@ int RpFilePrivate::readOneLBA(uint32_t lba)
 		int ret = fseeko(file, seek_pos, SEEK_SET);
 		if (ret != 0) {
 			// Seek error.
-			devInfo->lba_cache = ~0U;
 			q->m_lastError = errno;
 			return -q->m_lastError;
 		}
-		size_t bytesRead = fread(devInfo->sector_cache, 1, devInfo->sector_size, file);
-		if (ferror(file) || bytesRead != devInfo->sector_size) {
+		size_t bytesRead = fread(devInfo->sector_cache, 1, read_sz, file);
+		if (ferror(file) || bytesRead != read_sz) {
 			// Read error.
-			devInfo->lba_cache = ~0U;
 			q->m_lastError = errno;
 			return -q->m_lastError;
 		}
@@ -122,6 +137,7 @@ int RpFilePrivate::readOneLBA(uint32_t lba)
 
 	// Sector cache has been updated.
 	devInfo->lba_cache = lba;
+	devInfo->lba_cache_len = lba_count;
 	return 0;
 }
 
@@ -179,21 +195,21 @@ size_t RpFilePrivate::readUsingBlocks(void *ptr, size_t size)
 	if (blockStartOffset != 0) {
 		// Not a block boundary.
 		// Read the end of the first block.
-		int lret = readOneLBA(lba_cur);
+		int lret = readSectorCache(lba_cur);
 		if (lret != 0) {
 			// Read error.
-			// NOTE: q->m_lastError is set by readOneLBA().
-			// TODO: readOneLBA() should return number of bytes read,
+			// NOTE: q->m_lastError is set by readSectorCache().
+			// TODO: readSectorCache() should return number of bytes read,
 			// then return that value instead of 0?
 			return 0;
 		}
 
-		// Copy the data from the sector buffer.
+		// Copy the data from the sector cache.
 		uint32_t read_sz = devInfo->sector_size - blockStartOffset;
 		if (size < static_cast<size_t>(read_sz)) {
 			read_sz = static_cast<uint32_t>(size);
 		}
-		memcpy(ptr8, &devInfo->sector_cache[blockStartOffset], read_sz);
+		memcpy(ptr8, devInfo->sector_cache_ptr(lba_cur) + blockStartOffset, read_sz);
 
 		// Starting block read.
 		lba_cur++;
@@ -211,6 +227,35 @@ size_t RpFilePrivate::readUsingBlocks(void *ptr, size_t size)
 	// Must be on a sector boundary now.
 	assert(devInfo->device_pos % devInfo->sector_size == 0);
 
+	// Small reads are served from the sector cache, so a series of
+	// sequential small reads is batched into one multi-sector command
+	// instead of paying a round trip per read() call.
+	if (size < static_cast<size_t>(devInfo->sector_size) * DeviceInfo::SECTOR_CACHE_LBAS) {
+		while (size > 0) {
+			int lret = readSectorCache(lba_cur);
+			if (lret != 0) {
+				// Read error.
+				// NOTE: q->m_lastError is set by readSectorCache().
+				return ret;
+			}
+
+			// Copy as much as is cached and needed.
+			const uint32_t avail = devInfo->lba_cache_len - (lba_cur - devInfo->lba_cache);
+			size_t copy_sz = static_cast<size_t>(avail) * devInfo->sector_size;
+			if (copy_sz > size) {
+				copy_sz = size;
+			}
+			memcpy(ptr8, devInfo->sector_cache_ptr(lba_cur), copy_sz);
+
+			devInfo->device_pos += copy_sz;
+			lba_cur += static_cast<uint32_t>(copy_sz / devInfo->sector_size);
+			size -= copy_sz;
+			ptr8 += copy_sz;
+			ret += copy_sz;
+		}
+		return ret;
+	}
+
 	// Read contiguous blocks.
 	uint32_t lba_count = static_cast<uint32_t>(size / devInfo->sector_size);
 	size_t contig_size = static_cast<off64_t>(lba_count) * devInfo->sector_size;
@@ -291,17 +336,17 @@ size_t RpFilePrivate::readUsingBlocks(void *ptr, size_t size)
 		assert(devInfo->device_pos % devInfo->sector_size == 0);
 
 		// Read the last block.
-		int lret = readOneLBA(lba_cur);
+		int lret = readSectorCache(lba_cur);
 		if (lret != 0) {
 			// Read error.
-			// NOTE: q->m_lastError is set by readOneLBA().
-			// TODO: readOneLBA() should return number of bytes read,
+			// NOTE: q->m_lastError is set by readSectorCache().
+			// TODO: readSectorCache() should return number of bytes read,
 			// then add it to ret?
 			return ret;
 		}
 
-		// Copy the data from the sector buffer.
-		memcpy(ptr8, devInfo->sector_cache, size);
+		// Copy the data from the sector cache.
+		memcpy(ptr8, devInfo->sector_cache_ptr(lba_cur), size);
 
 		devInfo->device_pos += size;
 		ret += size;
@@ -516,6 +561,19 @@ int RpFile::rereadDeviceSizeScsi(off64_t *pDeviceSize, uint32_t *pSectorSize)
  */
 int RpFile::scsi_inquiry(SCSI_RESP_INQUIRY_STD *pResp)
 {
+	RP_D(RpFile);
+
+	// Check the capability cache first.
+	{
+		std::lock_guard<std::mutex> lock(inquiry_cache_mutex);
+		auto iter = inquiry_cache.find(d->filename);
+		if (iter != inquiry_cache.end()) {
+			// Found a cached INQUIRY response.
+			memcpy(pResp, &iter->second, sizeof(*pResp));
+			return 0;
+		}
+	}
+
 	SCSI_CDB_INQUIRY cdb;
 	ASSERT_STRUCT(SCSI_CDB_INQUIRY, 6);
 	cdb.OpCode = SCSI_OP_INQUIRY;
@@ -524,8 +582,13 @@ int RpFile::scsi_inquiry(SCSI_RESP_INQUIRY_STD *pResp)
 	cdb.AllocLen = cpu_to_be16(sizeof(SCSI_RESP_INQUIRY_STD));
 	cdb.Control = 0;
 
-	RP_D(RpFile);
-	return d->scsi_send_cdb(&cdb, sizeof(cdb), pResp, sizeof(*pResp), RpFilePrivate::SCSI_DIR_IN);
+	int ret = d->scsi_send_cdb(&cdb, sizeof(cdb), pResp, sizeof(*pResp), RpFilePrivate::SCSI_DIR_IN);
+	if (ret == 0) {
+		// Cache the INQUIRY response.
+		std::lock_guard<std::mutex> lock(inquiry_cache_mutex);
+		inquiry_cache.insert(std::make_pair(d->filename, *pResp));
+	}
+	return ret;
 }
 
 /**
@@ -578,18 +641,18 @@ int RpFile::ata_identify_device(ATA_RESP_IDENTIFY_DEVICE *pResp)
 	// so byteswap the whole thing. This will also handle
 	// byteswapping the string fields.
 	// TODO: NAA/OUI/WWN and other >16-bit fields.
-	__byte_swap_16_array(reinterpret_cast<uint16_t*>(pResp), sizeof(*pResp));
+	rp_byte_swap_16_array<sizeof(*pResp)>(reinterpret_cast<uint16_t*>(pResp));
 #else /* SYS_BYTE_ORDER == SYS_LIL_ENDIAN */
 	// String fields are always "swapped" regardless of
 	// host endian, so we'll have to unswap those.
-	__byte_swap_16_array(reinterpret_cast<uint16_t*>(pResp->serial_number),
-		sizeof(pResp->serial_number));
-	__byte_swap_16_array(reinterpret_cast<uint16_t*>(pResp->firmware_revision),
-		sizeof(pResp->firmware_revision));
-	__byte_swap_16_array(reinterpret_cast<uint16_t*>(pResp->model_number),
-		sizeof(pResp->model_number));
-	__byte_swap_16_array(reinterpret_cast<uint16_t*>(pResp->media_serial_number),
-		sizeof(pResp->media_serial_number));
+	rp_byte_swap_16_array<sizeof(pResp->serial_number)>(
+		reinterpret_cast<uint16_t*>(pResp->serial_number));
+	rp_byte_swap_16_array<sizeof(pResp->firmware_revision)>(
+		reinterpret_cast<uint16_t*>(pResp->firmware_revision));
+	rp_byte_swap_16_array<sizeof(pResp->model_number)>(
+		reinterpret_cast<uint16_t*>(pResp->model_number));
+	rp_byte_swap_16_array<sizeof(pResp->media_serial_number)>(
+		reinterpret_cast<uint16_t*>(pResp->media_serial_number));
 #endif
 
 	return ret;
@@ -341,6 +341,25 @@ bool is_symlink(const char *filename)
 	return false;
 }
 
+/**
+ * Check if the specified path is a directory.
+ * Symbolic links are followed.
+ * @return True if the path is a directory; false if not.
+ */
+bool is_directory(const char *filename)
+{
+	if (unlikely(!filename || filename[0] == 0))
+		return false;
+	const tstring tfilename = makeWinPath(filename);
+
+	const DWORD attrs = GetFileAttributes(tfilename.c_str());
+	if (attrs == INVALID_FILE_ATTRIBUTES) {
+		// Cannot get the file attributes.
+		return false;
+	}
+	return !!(attrs & FILE_ATTRIBUTE_DIRECTORY);
+}
+
 // GetFinalPathnameByHandleW() lookup.
 static pthread_once_t once_gfpbh = PTHREAD_ONCE_INIT;
 typedef DWORD (WINAPI *PFNGETFINALPATHNAMEBYHANDLEA)(
@@ -510,4 +529,26 @@ int get_file_size_and_mtime(const string &filename, off64_t *pFileSize, time_t *
 	return 0;
 }
 
+/**
+ * Ask the OS to read the first `size` bytes of each file ahead of time.
+ *
+ * The readahead requests for all files are submitted before any of
+ * them complete, so the device's command queue stays full instead of
+ * serving one synchronous header read at a time. Intended for batch
+ * operations that are about to open many queued files.
+ *
+ * This is a best-effort hint; errors are ignored.
+ *
+ * @param filenames Filenames.
+ * @param size Number of bytes to read ahead per file.
+ */
+void batch_read_ahead(const std::vector<string> &filenames, off64_t size)
+{
+	// TODO: Overlapped reads into a dummy buffer, as in
+	// RpFile::readAhead(). Windows has no equivalent of
+	// posix_fadvise(POSIX_FADV_WILLNEED) for a range.
+	RP_UNUSED(filenames);
+	RP_UNUSED(size);
+}
+
 } }
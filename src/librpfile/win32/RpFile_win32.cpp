@@ -10,6 +10,7 @@
 
 #include "../RpFile.hpp"
 #include "../RpFile_p.hpp"
+#include "../RpStats.hpp"
 
 // libwin32common
 #include "libwin32common/MiniU82T.hpp"
@@ -40,6 +41,9 @@ DELAYLOAD_TEST_FUNCTION_IMPL0(zlibVersion);
 
 RpFilePrivate::~RpFilePrivate()
 {
+	finishPrefetch();
+	delete prefetch;
+
 	if (gzfd) {
 		gzclose_r(gzfd);
 	}
@@ -49,6 +53,26 @@ RpFilePrivate::~RpFilePrivate()
 	delete devInfo;
 }
 
+/**
+ * Finish an in-flight prefetch read, if any.
+ * Cancels the read if it hasn't completed yet.
+ */
+void RpFilePrivate::finishPrefetch(void)
+{
+	if (!prefetch || !prefetch->inFlight) {
+		// No prefetch is in flight.
+		return;
+	}
+
+	// Cancel the read if it's still pending, then wait for the
+	// completion event. GetOverlappedResult() with bWait == TRUE
+	// waits even if the read was cancelled.
+	CancelIoEx(prefetch->hFile, &prefetch->ovl);
+	DWORD bytesRead;
+	GetOverlappedResult(prefetch->hFile, &prefetch->ovl, &bytesRead, TRUE);
+	prefetch->inFlight = false;
+}
+
 /**
  * Convert an RpFile::FileMode to Win32 CreateFile() parameters.
  * @param mode				[in] FileMode
@@ -215,6 +239,12 @@ int RpFilePrivate::reOpenFile(void)
 
 	// Open the file.
 	if (file && file != INVALID_HANDLE_VALUE) {
+		// Discard prefetch state, since it references
+		// the old file handle.
+		finishPrefetch();
+		delete prefetch;
+		prefetch = nullptr;
+
 		CloseHandle(file);
 	}
 	file = CreateFile(
@@ -432,6 +462,10 @@ void RpFile::close(void)
 		d->devInfo->close();
 	}
 
+	d->finishPrefetch();
+	delete d->prefetch;
+	d->prefetch = nullptr;
+
 	if (d->gzfd) {
 		gzclose_r(d->gzfd);
 		d->gzfd = nullptr;
@@ -483,6 +517,7 @@ size_t RpFile::read(void *ptr, size_t size)
 		}
 	}
 
+	RpStats::increment(RpStats::CTR_FILE_BYTES_READ, bytesRead);
 	return bytesRead;
 }
 
@@ -661,6 +696,87 @@ int RpFile::truncate(off64_t size)
 	return 0;
 }
 
+/** Access hints **/
+
+/**
+ * Hint the expected access pattern to the OS.
+ * @param pattern Expected access pattern.
+ */
+void RpFile::setAccessPattern(AccessPattern pattern)
+{
+	// TODO: Reopen with FILE_FLAG_SEQUENTIAL_SCAN or
+	// FILE_FLAG_RANDOM_ACCESS? The cache manager hints
+	// can only be specified at CreateFile() time.
+	RP_UNUSED(pattern);
+}
+
+/**
+ * Ask the OS to read the specified range ahead of time.
+ * @param pos Start of the range to read ahead.
+ * @param size Size of the range to read ahead, in bytes.
+ */
+void RpFile::readAhead(off64_t pos, off64_t size)
+{
+	RP_D(RpFile);
+	if (!d->file || d->file == INVALID_HANDLE_VALUE ||
+	    d->devInfo || d->gzfd || pos < 0 || size <= 0)
+	{
+		// No prefetching for device files or gzipped files.
+		return;
+	}
+
+	// Clamp the prefetch size. This is only a hint, and the
+	// overlapped read needs a real destination buffer.
+	static const DWORD PREFETCH_MAX = 1U*1024*1024;
+	const DWORD len = (size > static_cast<off64_t>(PREFETCH_MAX))
+		? PREFETCH_MAX
+		: static_cast<DWORD>(size);
+
+	// Finish any prefetch that's already in flight.
+	d->finishPrefetch();
+
+	if (!d->prefetch) {
+		// Open a second handle with FILE_FLAG_OVERLAPPED so the
+		// async read doesn't disturb the main file position.
+		HANDLE hOverlapped = ReOpenFile(d->file, GENERIC_READ,
+			FILE_SHARE_READ | FILE_SHARE_WRITE, FILE_FLAG_OVERLAPPED);
+		if (!hOverlapped || hOverlapped == INVALID_HANDLE_VALUE) {
+			// Unable to reopen the file.
+			return;
+		}
+		HANDLE hEvent = CreateEvent(nullptr, TRUE, FALSE, nullptr);
+		if (!hEvent) {
+			// Unable to create the completion event.
+			CloseHandle(hOverlapped);
+			return;
+		}
+
+		d->prefetch = new RpFilePrivate::PrefetchInfo();
+		d->prefetch->hFile = hOverlapped;
+		d->prefetch->ovl.hEvent = hEvent;
+	}
+
+	RpFilePrivate::PrefetchInfo *const prefetch = d->prefetch;
+	if (prefetch->buf_len < len) {
+		delete[] prefetch->buf;
+		prefetch->buf = new uint8_t[len];
+		prefetch->buf_len = len;
+	}
+
+	// Issue the async read. The data goes into the dummy buffer;
+	// the point is to get the range into the system file cache
+	// before the synchronous reads need it, so disk latency
+	// overlaps ROM parsing.
+	ResetEvent(prefetch->ovl.hEvent);
+	prefetch->ovl.Offset = static_cast<DWORD>(pos & 0xFFFFFFFF);
+	prefetch->ovl.OffsetHigh = static_cast<DWORD>(pos >> 32);
+	BOOL bRet = ReadFile(prefetch->hFile, prefetch->buf, len, nullptr, &prefetch->ovl);
+	if (bRet || GetLastError() == ERROR_IO_PENDING) {
+		// Read is in flight. (or completed synchronously)
+		prefetch->inFlight = true;
+	}
+}
+
 /** File properties **/
 
 /**
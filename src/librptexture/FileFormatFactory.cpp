@@ -16,6 +16,9 @@
 using namespace LibRpBase;
 using LibRpFile::IRpFile;
 
+// librpthreads
+#include "librpthreads/pthread_once.h"
+
 // C++ STL classes.
 using std::string;
 using std::unordered_set;
@@ -81,10 +84,41 @@ class FileFormatFactoryPrivate
 		// FileFormat subclasses that use a header at 0 and
 		// definitely have a 32-bit magic number at address 0.
 		static const FileFormatFns FileFormatFns_magic[];
+
+		// Vectors for file extensions and MIME types.
+		// We want to collect them once per session instead of
+		// repeatedly collecting them, since the caller might
+		// not cache them.
+		// pthread_once() control variable.
+		static std::vector<const char*> vec_exts;
+		static std::vector<const char*> vec_mimeTypes;
+		static pthread_once_t once_exts;
+		static pthread_once_t once_mimeTypes;
+
+		/**
+		 * Initialize the vector of supported file extensions.
+		 * Used for Win32 COM registration.
+		 *
+		 * Internal function; must be called using pthread_once().
+		 */
+		static void init_supportedFileExtensions(void);
+
+		/**
+		 * Initialize the vector of supported MIME types.
+		 * Used for KFileMetaData.
+		 *
+		 * Internal function; must be called using pthread_once().
+		 */
+		static void init_supportedMimeTypes(void);
 };
 
 /** FileFormatFactoryPrivate **/
 
+vector<const char*> FileFormatFactoryPrivate::vec_exts;
+vector<const char*> FileFormatFactoryPrivate::vec_mimeTypes;
+pthread_once_t FileFormatFactoryPrivate::once_exts = PTHREAD_ONCE_INIT;
+pthread_once_t FileFormatFactoryPrivate::once_mimeTypes = PTHREAD_ONCE_INIT;
+
 // FileFormat subclasses that use a header at 0 and
 // definitely have a 32-bit magic number at address 0.
 // TODO: Add support for multiple magic numbers per class.
@@ -198,19 +232,18 @@ FileFormat *FileFormatFactory::create(IRpFile *file)
 }
 
 /**
- * Get all supported file extensions.
+ * Initialize the vector of supported file extensions.
  * Used for Win32 COM registration.
  *
- * @return All supported file extensions, including the leading dot.
+ * Internal function; must be called using pthread_once().
  */
-vector<const char*> FileFormatFactory::supportedFileExtensions(void)
+void FileFormatFactoryPrivate::init_supportedFileExtensions(void)
 {
 	// In order to handle multiple FileFormat subclasses
 	// that support the same extensions, we're using
 	// an unordered_set<string>.
 	//
 	// The actual data is stored in the vector<const char*>.
-	vector<const char*> vec_exts;
 	unordered_set<string> set_exts;
 
 	static const size_t reserve_size = ARRAY_SIZE(FileFormatFactoryPrivate::FileFormatFns_magic);
@@ -234,17 +267,30 @@ vector<const char*> FileFormatFactory::supportedFileExtensions(void)
 			}
 		}
 	}
+}
 
-	return vec_exts;
+/**
+ * Get all supported file extensions.
+ * Used for Win32 COM registration.
+ *
+ * NOTE: The vector is built once per session and
+ * subsequent calls return the cached vector.
+ *
+ * @return All supported file extensions, including the leading dot.
+ */
+const vector<const char*> &FileFormatFactory::supportedFileExtensions(void)
+{
+	pthread_once(&FileFormatFactoryPrivate::once_exts, FileFormatFactoryPrivate::init_supportedFileExtensions);
+	return FileFormatFactoryPrivate::vec_exts;
 }
 
 /**
- * Get all supported MIME types.
+ * Initialize the vector of supported MIME types.
  * Used for KFileMetaData.
  *
- * @return All supported MIME types.
+ * Internal function; must be called using pthread_once().
  */
-vector<const char*> FileFormatFactory::supportedMimeTypes(void)
+void FileFormatFactoryPrivate::init_supportedMimeTypes(void)
 {
 	// TODO: Add generic types, e.g. application/octet-stream?
 
@@ -252,7 +298,6 @@ vector<const char*> FileFormatFactory::supportedMimeTypes(void)
 	// that support the same MIME types, we're using
 	// an unordered_set<string>. The actual data
 	// is stored in the vector<const char*>.
-	vector<const char*> vec_mimeTypes;
 	unordered_set<string> set_mimeTypes;
 
 	static const size_t reserve_size = ARRAY_SIZE(FileFormatFactoryPrivate::FileFormatFns_magic) * 2;
@@ -276,8 +321,21 @@ vector<const char*> FileFormatFactory::supportedMimeTypes(void)
 			}
 		}
 	}
+}
 
-	return vec_mimeTypes;
+/**
+ * Get all supported MIME types.
+ * Used for KFileMetaData.
+ *
+ * NOTE: The vector is built once per session and
+ * subsequent calls return the cached vector.
+ *
+ * @return All supported MIME types.
+ */
+const vector<const char*> &FileFormatFactory::supportedMimeTypes(void)
+{
+	pthread_once(&FileFormatFactoryPrivate::once_mimeTypes, FileFormatFactoryPrivate::init_supportedMimeTypes);
+	return FileFormatFactoryPrivate::vec_mimeTypes;
 }
 
 }
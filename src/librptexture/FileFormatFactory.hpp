@@ -51,17 +51,23 @@ class FileFormatFactory
 		 * Get all supported file extensions.
 		 * Used for Win32 COM registration.
 		 *
+		 * NOTE: The vector is built once per session and
+		 * subsequent calls return the cached vector.
+		 *
 		 * @return All supported file extensions, including the leading dot.
 		 */
-		static std::vector<const char*> supportedFileExtensions(void);
+		static const std::vector<const char*> &supportedFileExtensions(void);
 
 		/**
 		 * Get all supported MIME types.
 		 * Used for KFileMetaData.
 		 *
+		 * NOTE: The vector is built once per session and
+		 * subsequent calls return the cached vector.
+		 *
 		 * @return All supported MIME types.
 		 */
-		static std::vector<const char*> supportedMimeTypes(void);
+		static const std::vector<const char*> &supportedMimeTypes(void);
 };
 
 }
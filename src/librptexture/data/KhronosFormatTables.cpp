@@ -0,0 +1,473 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * KhronosFormatTables.cpp: Khronos KTX/KTX2 format mapping tables.        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "config.librptexture.h"
+
+#include "KhronosFormatTables.hpp"
+
+#include "../fileformat/gl_defs.h"
+#include "../fileformat/vk_defs.h"
+
+// librptexture
+#include "../img/rp_image.hpp"
+#include "../decoder/ImageDecoder.hpp"
+
+namespace LibRpTexture {
+
+class KhronosFormatTablesPrivate
+{
+	private:
+		// Static class.
+		KhronosFormatTablesPrivate();
+		~KhronosFormatTablesPrivate();
+		RP_DISABLE_COPY(KhronosFormatTablesPrivate)
+
+	public:
+		/**
+		 * Comparison function for bsearch().
+		 * @param a
+		 * @param b
+		 * @return
+		 */
+		static int RP_C_API compar(const void *a, const void *b);
+
+		// Format mapping tables.
+		// NOTE: Must be sorted by id.
+		// NOTE: Tables end with an empty entry, which is
+		// excluded from the bsearch() element count.
+		static const KhronosFormatTables::FormatSpec glFormat_tbl[];
+		static const KhronosFormatTables::FormatSpec glInternalFormat_tbl[];
+		static const KhronosFormatTables::FormatSpec vkFormat_tbl[];
+};
+
+/** KhronosFormatTablesPrivate **/
+
+/**
+ * Comparison function for bsearch().
+ * @param a
+ * @param b
+ * @return
+ */
+int RP_C_API KhronosFormatTablesPrivate::compar(const void *a, const void *b)
+{
+	unsigned int id1 = static_cast<const KhronosFormatTables::FormatSpec*>(a)->id;
+	unsigned int id2 = static_cast<const KhronosFormatTables::FormatSpec*>(b)->id;
+	if (id1 < id2) return -1;
+	if (id1 > id2) return 1;
+	return 0;
+}
+
+// Shorthand for table entries.
+#define FMT_ENTRY(fmt, dt, param, sc) \
+	{(fmt), KhronosFormatTables::dt, (param), KhronosFormatTables::sc, 0}
+
+/**
+ * KTX1 glFormat table. (uncompressed textures)
+ */
+const KhronosFormatTables::FormatSpec KhronosFormatTablesPrivate::glFormat_tbl[] = {
+	FMT_ENTRY(GL_RGB,	DT_LINEAR24,	ImageDecoder::PXF_BGR888,	SC_LINEAR24),
+	FMT_ENTRY(GL_RGBA,	DT_LINEAR32,	ImageDecoder::PXF_ABGR8888,	SC_LINEAR32),
+	FMT_ENTRY(GL_LUMINANCE,	DT_LINEAR8,	ImageDecoder::PXF_L8,		SC_LINEAR8),
+	// TODO: Does KTX handle GL_RGB9_E5 as compressed?
+	FMT_ENTRY(GL_RGB9_E5,	DT_LINEAR32,	ImageDecoder::PXF_RGB9_E5,	SC_LINEAR32),
+
+	{0, 0, 0, 0, 0}
+};
+
+/**
+ * KTX1 glInternalFormat table. (compressed textures)
+ */
+const KhronosFormatTables::FormatSpec KhronosFormatTablesPrivate::glInternalFormat_tbl[] = {
+	FMT_ENTRY(GL_RGB_S3TC,				DT_DXT1,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(GL_RGB4_S3TC,				DT_DXT1,	0, SC_BLOCK_4x4_64),
+	//FMT_ENTRY(GL_RGBA_S3TC, ...)	// TODO
+	//FMT_ENTRY(GL_RGBA4_S3TC, ...)	// TODO
+	FMT_ENTRY(GL_RGBA_DXT5_S3TC,			DT_DXT5,	0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(GL_RGBA4_DXT5_S3TC,			DT_DXT5,	0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(GL_COMPRESSED_RGB_S3TC_DXT1_EXT,	DT_DXT1,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(GL_COMPRESSED_RGBA_S3TC_DXT1_EXT,	DT_DXT1_A1,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(GL_COMPRESSED_RGBA_S3TC_DXT3_EXT,	DT_DXT3,	0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(GL_COMPRESSED_RGBA_S3TC_DXT5_EXT,	DT_DXT5,	0, SC_BLOCK_4x4_128),
+#ifdef ENABLE_PVRTC
+	FMT_ENTRY(GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG,	DT_PVRTC,
+		ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_NONE,	SC_PVRTC1_4BPP),
+	FMT_ENTRY(GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG,	DT_PVRTC,
+		ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_NONE,	SC_PVRTC1_2BPP),
+	FMT_ENTRY(GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG,	DT_PVRTC,
+		ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES,	SC_PVRTC1_4BPP),
+	FMT_ENTRY(GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG,	DT_PVRTC,
+		ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES,	SC_PVRTC1_2BPP),
+#endif /* ENABLE_PVRTC */
+	// TODO: Does KTX handle GL_RGB9_E5 as compressed?
+	FMT_ENTRY(GL_RGB9_E5,				DT_LINEAR32,
+		ImageDecoder::PXF_RGB9_E5,	SC_LINEAR32),
+	// TODO: Handle signed properly.
+	FMT_ENTRY(GL_COMPRESSED_LUMINANCE_LATC1_EXT,		DT_BC4_LUM,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(GL_COMPRESSED_SIGNED_LUMINANCE_LATC1_EXT,	DT_BC4_LUM,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(GL_COMPRESSED_LUMINANCE_ALPHA_LATC2_EXT,	DT_BC5_LUM,	0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(GL_COMPRESSED_SIGNED_LUMINANCE_ALPHA_LATC2_EXT, DT_BC5_LUM,	0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(GL_ETC1_RGB8_OES,			DT_ETC1,	0, SC_BLOCK_4x4_64),
+	// TODO: Handle signed properly.
+	FMT_ENTRY(GL_COMPRESSED_RED_RGTC1,		DT_BC4,		0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(GL_COMPRESSED_SIGNED_RED_RGTC1,	DT_BC4,		0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(GL_COMPRESSED_RG_RGTC2,		DT_BC5,		0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(GL_COMPRESSED_SIGNED_RG_RGTC2,	DT_BC5,		0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(GL_COMPRESSED_RGBA_BPTC_UNORM,	DT_BC7,		0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM,	DT_BC7,		0, SC_BLOCK_4x4_128),
+#ifdef ENABLE_PVRTC
+	// NOTE: Assuming PVRTC-II has alpha.
+	FMT_ENTRY(GL_COMPRESSED_RGBA_PVRTC_2BPPV2_IMG,	DT_PVRTCII,
+		ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES,	SC_PVRTC2_2BPP),
+	FMT_ENTRY(GL_COMPRESSED_RGBA_PVRTC_4BPPV2_IMG,	DT_PVRTCII,
+		ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES,	SC_PVRTC2_4BPP),
+#endif /* ENABLE_PVRTC */
+	// EAC: Size is known, but no decoder is available yet.
+	FMT_ENTRY(GL_COMPRESSED_R11_EAC,		DT_NONE,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(GL_COMPRESSED_SIGNED_R11_EAC,		DT_NONE,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(GL_COMPRESSED_RG11_EAC,		DT_NONE,	0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(GL_COMPRESSED_SIGNED_RG11_EAC,	DT_NONE,	0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(GL_COMPRESSED_RGB8_ETC2,		DT_ETC2_RGB,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(GL_COMPRESSED_SRGB8_ETC2,		DT_ETC2_RGB,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2,	DT_ETC2_RGB_A1,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2,	DT_ETC2_RGB_A1,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(GL_COMPRESSED_RGBA8_ETC2_EAC,		DT_ETC2_RGBA,	0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC,	DT_ETC2_RGBA,	0, SC_BLOCK_4x4_128),
+
+	{0, 0, 0, 0, 0}
+};
+
+/**
+ * KTX2 VkFormat table.
+ * TODO: Differences between UNORM, UINT, SRGB; handle SNORM, SINT.
+ */
+const KhronosFormatTables::FormatSpec KhronosFormatTablesPrivate::vkFormat_tbl[] = {
+	// FIXME: Decode as red, not as L8.
+	FMT_ENTRY(VK_FORMAT_R8_UNORM,		DT_LINEAR8,	ImageDecoder::PXF_L8,		SC_LINEAR8),
+	FMT_ENTRY(VK_FORMAT_R8_UINT,		DT_LINEAR8,	ImageDecoder::PXF_L8,		SC_LINEAR8),
+	FMT_ENTRY(VK_FORMAT_R8_SRGB,		DT_LINEAR8,	ImageDecoder::PXF_L8,		SC_LINEAR8),
+	FMT_ENTRY(VK_FORMAT_R8G8B8_UNORM,	DT_LINEAR24,	ImageDecoder::PXF_BGR888,	SC_LINEAR24),
+	FMT_ENTRY(VK_FORMAT_R8G8B8_UINT,	DT_LINEAR24,	ImageDecoder::PXF_BGR888,	SC_LINEAR24),
+	FMT_ENTRY(VK_FORMAT_R8G8B8_SRGB,	DT_LINEAR24,	ImageDecoder::PXF_BGR888,	SC_LINEAR24),
+	FMT_ENTRY(VK_FORMAT_B8G8R8_UNORM,	DT_LINEAR24,	ImageDecoder::PXF_RGB888,	SC_LINEAR24),
+	FMT_ENTRY(VK_FORMAT_B8G8R8_UINT,	DT_LINEAR24,	ImageDecoder::PXF_RGB888,	SC_LINEAR24),
+	FMT_ENTRY(VK_FORMAT_B8G8R8_SRGB,	DT_LINEAR24,	ImageDecoder::PXF_RGB888,	SC_LINEAR24),
+	FMT_ENTRY(VK_FORMAT_R8G8B8A8_UNORM,	DT_LINEAR32,	ImageDecoder::PXF_ABGR8888,	SC_LINEAR32),
+	FMT_ENTRY(VK_FORMAT_R8G8B8A8_UINT,	DT_LINEAR32,	ImageDecoder::PXF_ABGR8888,	SC_LINEAR32),
+	FMT_ENTRY(VK_FORMAT_R8G8B8A8_SRGB,	DT_LINEAR32,	ImageDecoder::PXF_ABGR8888,	SC_LINEAR32),
+	FMT_ENTRY(VK_FORMAT_B8G8R8A8_UNORM,	DT_LINEAR32,	ImageDecoder::PXF_ARGB8888,	SC_LINEAR32),
+	FMT_ENTRY(VK_FORMAT_B8G8R8A8_UINT,	DT_LINEAR32,	ImageDecoder::PXF_ARGB8888,	SC_LINEAR32),
+	FMT_ENTRY(VK_FORMAT_B8G8R8A8_SRGB,	DT_LINEAR32,	ImageDecoder::PXF_ARGB8888,	SC_LINEAR32),
+	FMT_ENTRY(VK_FORMAT_E5B9G9R9_UFLOAT_PACK32, DT_LINEAR32, ImageDecoder::PXF_RGB9_E5,	SC_LINEAR32),
+	FMT_ENTRY(VK_FORMAT_BC1_RGB_UNORM_BLOCK,	DT_DXT1,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(VK_FORMAT_BC1_RGB_SRGB_BLOCK,		DT_DXT1,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(VK_FORMAT_BC1_RGBA_UNORM_BLOCK,	DT_DXT1_A1,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(VK_FORMAT_BC1_RGBA_SRGB_BLOCK,	DT_DXT1_A1,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(VK_FORMAT_BC2_UNORM_BLOCK,		DT_DXT3,	0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(VK_FORMAT_BC2_SRGB_BLOCK,		DT_DXT3,	0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(VK_FORMAT_BC3_UNORM_BLOCK,		DT_DXT5,	0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(VK_FORMAT_BC3_SRGB_BLOCK,		DT_DXT5,	0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(VK_FORMAT_BC7_UNORM_BLOCK,		DT_BC7,		0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(VK_FORMAT_BC7_SRGB_BLOCK,		DT_BC7,		0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK,	DT_ETC2_RGB,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK,	DT_ETC2_RGB,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK,	DT_ETC2_RGB_A1,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK,	DT_ETC2_RGB_A1,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK,	DT_ETC2_RGBA,	0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK,	DT_ETC2_RGBA,	0, SC_BLOCK_4x4_128),
+	// EAC: Size is known, but no decoder is available yet.
+	FMT_ENTRY(VK_FORMAT_EAC_R11_UNORM_BLOCK,	DT_NONE,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(VK_FORMAT_EAC_R11_SNORM_BLOCK,	DT_NONE,	0, SC_BLOCK_4x4_64),
+	FMT_ENTRY(VK_FORMAT_EAC_R11G11_UNORM_BLOCK,	DT_NONE,	0, SC_BLOCK_4x4_128),
+	FMT_ENTRY(VK_FORMAT_EAC_R11G11_SNORM_BLOCK,	DT_NONE,	0, SC_BLOCK_4x4_128),
+#ifdef ENABLE_PVRTC
+	// NOTE: KTX2 doesn't have a way to specify "no alpha" for PVRTC.
+	// We'll assume all PVRTC KTX2 textures have alpha.
+	FMT_ENTRY(VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG, DT_PVRTC,
+		ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES,	SC_PVRTC1_2BPP),
+	FMT_ENTRY(VK_FORMAT_PVRTC1_4BPP_UNORM_BLOCK_IMG, DT_PVRTC,
+		ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES,	SC_PVRTC1_4BPP),
+	FMT_ENTRY(VK_FORMAT_PVRTC2_2BPP_UNORM_BLOCK_IMG, DT_PVRTCII,
+		ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES,	SC_PVRTC2_2BPP),
+	FMT_ENTRY(VK_FORMAT_PVRTC2_4BPP_UNORM_BLOCK_IMG, DT_PVRTCII,
+		ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES,	SC_PVRTC2_4BPP),
+	FMT_ENTRY(VK_FORMAT_PVRTC1_2BPP_SRGB_BLOCK_IMG, DT_PVRTC,
+		ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES,	SC_PVRTC1_2BPP),
+	FMT_ENTRY(VK_FORMAT_PVRTC1_4BPP_SRGB_BLOCK_IMG, DT_PVRTC,
+		ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES,	SC_PVRTC1_4BPP),
+	FMT_ENTRY(VK_FORMAT_PVRTC2_2BPP_SRGB_BLOCK_IMG, DT_PVRTCII,
+		ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES,	SC_PVRTC2_2BPP),
+	FMT_ENTRY(VK_FORMAT_PVRTC2_4BPP_SRGB_BLOCK_IMG, DT_PVRTCII,
+		ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES,	SC_PVRTC2_4BPP),
+#endif /* ENABLE_PVRTC */
+
+	{0, 0, 0, 0, 0}
+};
+
+/** KhronosFormatTables **/
+
+/**
+ * Look up a KTX1 texture format.
+ *
+ * OpenGL uses glFormat for uncompressed textures and
+ * glInternalFormat for compressed textures, so both
+ * values are needed here.
+ *
+ * @param glFormat		[in] OpenGL format. (0 for compressed textures)
+ * @param glInternalFormat	[in] OpenGL internal format.
+ * @return FormatSpec, or nullptr if not supported.
+ */
+const KhronosFormatTables::FormatSpec *KhronosFormatTables::lookup_glFormat(
+	unsigned int glFormat, unsigned int glInternalFormat)
+{
+	// Check the uncompressed glFormat table first.
+	const FormatSpec key_glFormat = {glFormat, 0, 0, 0, 0};
+	const FormatSpec *res = static_cast<const FormatSpec*>(bsearch(&key_glFormat,
+		KhronosFormatTablesPrivate::glFormat_tbl,
+		ARRAY_SIZE(KhronosFormatTablesPrivate::glFormat_tbl)-1,
+		sizeof(FormatSpec), KhronosFormatTablesPrivate::compar));
+	if (res) {
+		return res;
+	}
+
+	// May be a compressed format. Check glInternalFormat.
+	const FormatSpec key_glInternalFormat = {glInternalFormat, 0, 0, 0, 0};
+	return static_cast<const FormatSpec*>(bsearch(&key_glInternalFormat,
+		KhronosFormatTablesPrivate::glInternalFormat_tbl,
+		ARRAY_SIZE(KhronosFormatTablesPrivate::glInternalFormat_tbl)-1,
+		sizeof(FormatSpec), KhronosFormatTablesPrivate::compar));
+}
+
+/**
+ * Look up a KTX2 texture format.
+ * @param vkFormat	[in] Vulkan format.
+ * @return FormatSpec, or nullptr if not supported.
+ */
+const KhronosFormatTables::FormatSpec *KhronosFormatTables::lookup_vkFormat(unsigned int vkFormat)
+{
+	const FormatSpec key = {vkFormat, 0, 0, 0, 0};
+	return static_cast<const FormatSpec*>(bsearch(&key,
+		KhronosFormatTablesPrivate::vkFormat_tbl,
+		ARRAY_SIZE(KhronosFormatTablesPrivate::vkFormat_tbl)-1,
+		sizeof(FormatSpec), KhronosFormatTablesPrivate::compar));
+}
+
+/**
+ * Calculate the expected image size for a format.
+ * @param spec		[in] FormatSpec
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param pStride	[out] Line stride, in bytes. (0 for compressed formats)
+ * @return Expected image size, in bytes; 0 on error.
+ */
+uint32_t KhronosFormatTables::expectedSize(const FormatSpec *spec,
+	int width, int height, int *pStride)
+{
+	assert(spec != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+	if (!spec || width <= 0 || height <= 0) {
+		return 0;
+	}
+
+	// NOTE: Scanlines are 4-byte aligned.
+	int stride = 0;
+	uint32_t expected_size;
+	switch (spec->size_calc) {
+		case SC_LINEAR8:
+			// 8-bit.
+			stride = ALIGN_BYTES(4, width);
+			expected_size = static_cast<uint32_t>(stride * height);
+			break;
+
+		case SC_LINEAR24:
+			// 24-bit RGB.
+			stride = ALIGN_BYTES(4, width * 3);
+			expected_size = static_cast<uint32_t>(stride * height);
+			break;
+
+		case SC_LINEAR32:
+			// 32-bit RGBA.
+			stride = width * 4;
+			expected_size = static_cast<uint32_t>(stride * height);
+			break;
+
+		case SC_BLOCK_4x4_64:
+			// 16 pixels compressed into 64 bits. (4bpp)
+			// NOTE: Width and height must be rounded to the nearest tile. (4x4)
+			expected_size = ALIGN_BYTES(4, width) *
+			                ALIGN_BYTES(4, height) / 2;
+			break;
+
+		case SC_BLOCK_4x4_128:
+			// 16 pixels compressed into 128 bits. (8bpp)
+			// NOTE: Width and height must be rounded to the nearest tile. (4x4)
+			expected_size = ALIGN_BYTES(4, width) *
+			                ALIGN_BYTES(4, height);
+			break;
+
+		case SC_PVRTC1_2BPP:
+			// 32 pixels compressed into 64 bits. (2bpp)
+			expected_size = (width * height) / 4;
+			break;
+
+		case SC_PVRTC1_4BPP:
+			// 16 pixels compressed into 64 bits. (4bpp)
+			expected_size = (width * height) / 2;
+			break;
+
+		case SC_PVRTC2_2BPP:
+			// 32 pixels compressed into 64 bits. (2bpp)
+			// NOTE: Width and height must be rounded to the nearest tile. (8x4)
+			expected_size = ALIGN_BYTES(8, width) *
+			                ALIGN_BYTES(4, height) / 4;
+			break;
+
+		case SC_PVRTC2_4BPP:
+			// 16 pixels compressed into 64 bits. (4bpp)
+			// NOTE: Width and height must be rounded to the nearest tile. (4x4)
+			expected_size = ALIGN_BYTES(4, width) *
+			                ALIGN_BYTES(4, height) / 2;
+			break;
+
+		default:
+			// Invalid size calculation.
+			assert(!"Invalid size calculation.");
+			return 0;
+	}
+
+	if (pStride) {
+		*pStride = stride;
+	}
+	return expected_size;
+}
+
+/**
+ * Decode an image using the format's decoder function.
+ * @param spec		[in] FormatSpec
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] Image data.
+ * @param img_siz	[in] Size of image data.
+ * @param stride	[in] Line stride, in bytes. (from expectedSize())
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *KhronosFormatTables::decodeImage(const FormatSpec *spec,
+	int width, int height,
+	const uint8_t *img_buf, uint32_t img_siz, int stride)
+{
+	assert(spec != nullptr);
+	assert(img_buf != nullptr);
+	if (!spec || !img_buf) {
+		return nullptr;
+	}
+
+	rp_image *img = nullptr;
+	switch (spec->decoder) {
+		default:
+		case DT_NONE:
+			// Not supported.
+			break;
+
+		case DT_LINEAR8:
+			img = ImageDecoder::fromLinear8(
+				static_cast<ImageDecoder::PixelFormat>(spec->param),
+				width, height, img_buf, img_siz, stride);
+			break;
+
+		case DT_LINEAR24:
+			img = ImageDecoder::fromLinear24(
+				static_cast<ImageDecoder::PixelFormat>(spec->param),
+				width, height, img_buf, img_siz, stride);
+			break;
+
+		case DT_LINEAR32:
+			img = ImageDecoder::fromLinear32(
+				static_cast<ImageDecoder::PixelFormat>(spec->param),
+				width, height,
+				reinterpret_cast<const uint32_t*>(img_buf), img_siz, stride);
+			break;
+
+		case DT_DXT1:
+			img = ImageDecoder::fromDXT1(width, height, img_buf, img_siz);
+			break;
+
+		case DT_DXT1_A1:
+			img = ImageDecoder::fromDXT1_A1(width, height, img_buf, img_siz);
+			break;
+
+		case DT_DXT3:
+			img = ImageDecoder::fromDXT3(width, height, img_buf, img_siz);
+			break;
+
+		case DT_DXT5:
+			img = ImageDecoder::fromDXT5(width, height, img_buf, img_siz);
+			break;
+
+		case DT_BC4:
+			img = ImageDecoder::fromBC4(width, height, img_buf, img_siz);
+			break;
+
+		case DT_BC5:
+			img = ImageDecoder::fromBC5(width, height, img_buf, img_siz);
+			break;
+
+		case DT_BC4_LUM:
+			// LATC, one component.
+			img = ImageDecoder::fromBC4(width, height, img_buf, img_siz);
+			// TODO: If this fails, return it anyway or return nullptr?
+			ImageDecoder::fromRed8ToL8(img);
+			break;
+
+		case DT_BC5_LUM:
+			// LATC, two components.
+			img = ImageDecoder::fromBC5(width, height, img_buf, img_siz);
+			// TODO: If this fails, return it anyway or return nullptr?
+			ImageDecoder::fromRG8ToLA8(img);
+			break;
+
+		case DT_BC7:
+			img = ImageDecoder::fromBC7(width, height, img_buf, img_siz);
+			break;
+
+		case DT_ETC1:
+			img = ImageDecoder::fromETC1(width, height, img_buf, img_siz);
+			break;
+
+		case DT_ETC2_RGB:
+			// TODO: Handle sRGB.
+			img = ImageDecoder::fromETC2_RGB(width, height, img_buf, img_siz);
+			break;
+
+		case DT_ETC2_RGB_A1:
+			// TODO: Handle sRGB.
+			img = ImageDecoder::fromETC2_RGB_A1(width, height, img_buf, img_siz);
+			break;
+
+		case DT_ETC2_RGBA:
+			// TODO: Handle sRGB.
+			img = ImageDecoder::fromETC2_RGBA(width, height, img_buf, img_siz);
+			break;
+
+#ifdef ENABLE_PVRTC
+		case DT_PVRTC:
+			img = ImageDecoder::fromPVRTC(width, height,
+				img_buf, img_siz, spec->param);
+			break;
+
+		case DT_PVRTCII:
+			img = ImageDecoder::fromPVRTCII(width, height,
+				img_buf, img_siz, spec->param);
+			break;
+#endif /* ENABLE_PVRTC */
+	}
+
+	return img;
+}
+
+}
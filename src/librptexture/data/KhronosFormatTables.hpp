@@ -0,0 +1,133 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * KhronosFormatTables.hpp: Khronos KTX/KTX2 format mapping tables.        *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTEXTURE_DATA_KHRONOSFORMATTABLES_HPP__
+#define __ROMPROPERTIES_LIBRPTEXTURE_DATA_KHRONOSFORMATTABLES_HPP__
+
+#include "common.h"
+
+// C includes.
+#include <stdint.h>
+
+namespace LibRpTexture {
+
+class rp_image;
+
+class KhronosFormatTables
+{
+	private:
+		// Static class.
+		KhronosFormatTables();
+		~KhronosFormatTables();
+		RP_DISABLE_COPY(KhronosFormatTables)
+
+	public:
+		// Decoder function selector.
+		enum DecoderType : uint8_t {
+			DT_NONE = 0,	// Size is known, but no decoder is available.
+
+			// Uncompressed. (param == ImageDecoder::PixelFormat)
+			DT_LINEAR8,
+			DT_LINEAR24,
+			DT_LINEAR32,
+
+			// S3TC / BCn.
+			DT_DXT1,
+			DT_DXT1_A1,
+			DT_DXT3,
+			DT_DXT5,
+			DT_BC4,
+			DT_BC5,
+			DT_BC4_LUM,	// BC4, then Red8 -> L8. (LATC1)
+			DT_BC5_LUM,	// BC5, then RG8 -> LA8. (LATC2)
+			DT_BC7,
+
+			// ETC1/ETC2.
+			DT_ETC1,
+			DT_ETC2_RGB,
+			DT_ETC2_RGB_A1,
+			DT_ETC2_RGBA,
+
+			// PVRTC. (param == PVRTC_Mode_e bitfield)
+			DT_PVRTC,
+			DT_PVRTCII,
+		};
+
+		// Expected image size calculation.
+		enum SizeCalc : uint8_t {
+			SC_LINEAR8 = 0,		// stride == ALIGN_BYTES(4, width)
+			SC_LINEAR24,		// stride == ALIGN_BYTES(4, width * 3)
+			SC_LINEAR32,		// stride == width * 4
+			SC_BLOCK_4x4_64,	// 4x4 tiles, 64 bits per tile. (4bpp)
+			SC_BLOCK_4x4_128,	// 4x4 tiles, 128 bits per tile. (8bpp)
+			SC_PVRTC1_2BPP,		// (width * height) / 4; no tile rounding.
+			SC_PVRTC1_4BPP,		// (width * height) / 2; no tile rounding.
+			SC_PVRTC2_2BPP,		// 8x4 tiles, 64 bits per tile.
+			SC_PVRTC2_4BPP,		// 4x4 tiles, 64 bits per tile.
+		};
+
+		// Format mapping entry.
+		// NOTE: Tables must be sorted by id.
+		struct FormatSpec {
+			uint32_t id;		// glInternalFormat or VkFormat.
+			uint8_t decoder;	// DecoderType
+			uint8_t param;		// Decoder parameter. (See DecoderType.)
+			uint8_t size_calc;	// SizeCalc
+			uint8_t reserved;
+		};
+
+		/**
+		 * Look up a KTX1 texture format.
+		 *
+		 * OpenGL uses glFormat for uncompressed textures and
+		 * glInternalFormat for compressed textures, so both
+		 * values are needed here.
+		 *
+		 * @param glFormat		[in] OpenGL format. (0 for compressed textures)
+		 * @param glInternalFormat	[in] OpenGL internal format.
+		 * @return FormatSpec, or nullptr if not supported.
+		 */
+		static const FormatSpec *lookup_glFormat(
+			unsigned int glFormat, unsigned int glInternalFormat);
+
+		/**
+		 * Look up a KTX2 texture format.
+		 * @param vkFormat	[in] Vulkan format.
+		 * @return FormatSpec, or nullptr if not supported.
+		 */
+		static const FormatSpec *lookup_vkFormat(unsigned int vkFormat);
+
+		/**
+		 * Calculate the expected image size for a format.
+		 * @param spec		[in] FormatSpec
+		 * @param width		[in] Image width.
+		 * @param height	[in] Image height.
+		 * @param pStride	[out] Line stride, in bytes. (0 for compressed formats)
+		 * @return Expected image size, in bytes; 0 on error.
+		 */
+		static uint32_t expectedSize(const FormatSpec *spec,
+			int width, int height, int *pStride);
+
+		/**
+		 * Decode an image using the format's decoder function.
+		 * @param spec		[in] FormatSpec
+		 * @param width		[in] Image width.
+		 * @param height	[in] Image height.
+		 * @param img_buf	[in] Image data.
+		 * @param img_siz	[in] Size of image data.
+		 * @param stride	[in] Line stride, in bytes. (from expectedSize())
+		 * @return rp_image, or nullptr on error.
+		 */
+		static rp_image *decodeImage(const FormatSpec *spec,
+			int width, int height,
+			const uint8_t *img_buf, uint32_t img_siz, int stride);
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPTEXTURE_DATA_KHRONOSFORMATTABLES_HPP__ */
@@ -0,0 +1,103 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * DecodeContext.cpp: Reusable image decoding context.                     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "DecodeContext.hpp"
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+DecodeContext::DecodeContext()
+	: img(nullptr)
+{ }
+
+DecodeContext::~DecodeContext()
+{
+	delete img;
+}
+
+/**
+ * Get an output image with the specified geometry.
+ *
+ * If the previous image matches the geometry, it is reused;
+ * for CI8 images, the palette is re-zeroed, since decoders
+ * rely on a zero-initialized palette. Otherwise, a new
+ * image is allocated.
+ *
+ * Used internally by the ImageDecoder::fromXXX() overloads.
+ *
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param format	[in] Image format.
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *DecodeContext::reuse(int width, int height, rp_image::Format format)
+{
+	assert(width > 0);
+	assert(height > 0);
+	if (width <= 0 || height <= 0) {
+		// Invalid image size.
+		return nullptr;
+	}
+
+	if (img) {
+		if (img->width() == width && img->height() == height &&
+		    img->format() == format)
+		{
+			// Geometry matches. Reuse the image.
+			// NOTE: If the previous image was dup()'d, writing to
+			// this image triggers a copy-on-write in the backend,
+			// so the dup stays intact.
+			if (format == rp_image::FORMAT_CI8) {
+				// Decoders expect a zero-initialized palette.
+				uint32_t *const palette = img->palette();
+				if (palette) {
+					memset(palette, 0, img->palette_len() * sizeof(uint32_t));
+				}
+				img->set_tr_idx(-1);
+			}
+			return img;
+		}
+
+		// Geometry doesn't match.
+		delete img;
+		img = nullptr;
+	}
+
+	// Allocate a new image.
+	img = new rp_image(width, height, format);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		delete img;
+		img = nullptr;
+	}
+	return img;
+}
+
+/**
+ * Take ownership of the current image.
+ * The context no longer owns it and will allocate
+ * a new image on the next decode.
+ * @return rp_image, or nullptr if no image is held.
+ */
+rp_image *DecodeContext::take(void)
+{
+	rp_image *const ret = img;
+	img = nullptr;
+	return ret;
+}
+
+/**
+ * Delete the held image, if any.
+ */
+void DecodeContext::reset(void)
+{
+	delete img;
+	img = nullptr;
+}
+
+} }
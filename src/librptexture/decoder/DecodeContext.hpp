@@ -0,0 +1,81 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * DecodeContext.hpp: Reusable image decoding context.                     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTEXTURE_DECODER_DECODECONTEXT_HPP__
+#define __ROMPROPERTIES_LIBRPTEXTURE_DECODER_DECODECONTEXT_HPP__
+
+#include "common.h"
+#include "../img/rp_image.hpp"
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+/**
+ * Reusable image decoding context.
+ *
+ * The context owns the output rp_image and hands it back out for
+ * every decode with matching geometry, so batch scans that decode
+ * many images of identical dimensions don't allocate and zero a
+ * fresh image per file.
+ *
+ * Pass the context to the ImageDecoder::fromXXX() overloads that
+ * accept one. The returned rp_image is owned by the context and is
+ * invalidated by the next decode; callers that need to keep an
+ * image should dup() it first. (The pixel storage is copy-on-write,
+ * so a dup() is cheap and detaches automatically when the context
+ * decodes the next image.)
+ *
+ * NOTE: The context is not thread-safe. Use one context per thread.
+ */
+class DecodeContext
+{
+	public:
+		DecodeContext();
+		~DecodeContext();
+
+	private:
+		RP_DISABLE_COPY(DecodeContext)
+
+	public:
+		/**
+		 * Get an output image with the specified geometry.
+		 *
+		 * If the previous image matches the geometry, it is reused;
+		 * for CI8 images, the palette is re-zeroed, since decoders
+		 * rely on a zero-initialized palette. Otherwise, a new
+		 * image is allocated.
+		 *
+		 * Used internally by the ImageDecoder::fromXXX() overloads.
+		 *
+		 * @param width		[in] Image width.
+		 * @param height	[in] Image height.
+		 * @param format	[in] Image format.
+		 * @return rp_image, or nullptr on error.
+		 */
+		rp_image *reuse(int width, int height, rp_image::Format format);
+
+		/**
+		 * Take ownership of the current image.
+		 * The context no longer owns it and will allocate
+		 * a new image on the next decode.
+		 * @return rp_image, or nullptr if no image is held.
+		 */
+		rp_image *take(void);
+
+		/**
+		 * Delete the held image, if any.
+		 */
+		void reset(void);
+
+	private:
+		// Output image. Reused across decodes.
+		rp_image *img;
+};
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPTEXTURE_DECODER_DECODECONTEXT_HPP__ */
@@ -21,10 +21,15 @@
 # include "librpcpu/cpuflags_x86.h"
 # define IMAGEDECODER_HAS_SSE2 1
 # define IMAGEDECODER_HAS_SSSE3 1
+# define IMAGEDECODER_HAS_AVX2 1
 #endif
 #ifdef RP_CPU_AMD64
 # define IMAGEDECODER_ALWAYS_HAS_SSE2 1
 #endif
+#if defined(RP_CPU_ARM) || defined(RP_CPU_ARM64)
+# include "librpcpu/cpuflags_arm.h"
+# define IMAGEDECODER_HAS_NEON 1
+#endif
 
 namespace LibRpTexture {
 	class rp_image;
@@ -32,6 +37,8 @@ namespace LibRpTexture {
 
 namespace LibRpTexture { namespace ImageDecoder {
 
+class DecodeContext;
+
 // Pixel formats.
 enum PixelFormat {
 	PXF_UNKNOWN,
@@ -167,6 +174,24 @@ rp_image *fromLinearCI8(PixelFormat px_format,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	const void *RESTRICT pal_buf, int pal_siz);
 
+/**
+ * Convert a linear CI8 image to rp_image with a little-endian 16-bit palette.
+ * Reusable context version.
+ * @param ctx Decode context. The context owns the returned image.
+ * @param px_format Palette pixel format.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf CI8 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @param pal_buf Palette buffer.
+ * @param pal_siz Size of palette data. [must be >= 256*2 for 16-bit, >= 256*4 for 32-bit]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromLinearCI8(DecodeContext &ctx, PixelFormat px_format,
+	int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz,
+	const void *RESTRICT pal_buf, int pal_siz);
+
 /**
  * Convert a linear monochrome image to rp_image.
  * @param width Image width.
@@ -323,6 +348,40 @@ rp_image *fromLinear32_ssse3(PixelFormat px_format,
 	const uint32_t *RESTRICT img_buf, int img_siz, int stride = 0);
 #endif /* IMAGEDECODER_HAS_SSSE3 */
 
+#ifdef IMAGEDECODER_HAS_AVX2
+/**
+ * Convert a linear 32-bit RGB image to rp_image.
+ * AVX2-optimized version.
+ * @param px_format	[in] 32-bit pixel format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] 32-bit image buffer.
+ * @param img_siz	[in] Size of image data. [must be >= (w*h)*2]
+ * @param stride	[in,opt] Stride, in bytes. If 0, assumes width*bytespp.
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromLinear32_avx2(PixelFormat px_format,
+	int width, int height,
+	const uint32_t *RESTRICT img_buf, int img_siz, int stride = 0);
+#endif /* IMAGEDECODER_HAS_AVX2 */
+
+#ifdef IMAGEDECODER_HAS_NEON
+/**
+ * Convert a linear 32-bit RGB image to rp_image.
+ * NEON-optimized version.
+ * @param px_format	[in] 32-bit pixel format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] 32-bit image buffer.
+ * @param img_siz	[in] Size of image data. [must be >= (w*h)*2]
+ * @param stride	[in,opt] Stride, in bytes. If 0, assumes width*bytespp.
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromLinear32_neon(PixelFormat px_format,
+	int width, int height,
+	const uint32_t *RESTRICT img_buf, int img_siz, int stride = 0);
+#endif /* IMAGEDECODER_HAS_NEON */
+
 /**
  * Convert a linear 32-bit RGB image to rp_image.
  * @param px_format	[in] 32-bit pixel format.
@@ -394,6 +453,22 @@ rp_image *fromNDS_CI4(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	const uint16_t *RESTRICT pal_buf, int pal_siz);
 
+/**
+ * Convert a Nintendo DS CI4 image to rp_image.
+ * Reusable context version.
+ * @param ctx Decode context. The context owns the returned image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf CI4 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @param pal_buf Palette buffer.
+ * @param pal_siz Size of palette data. [must be >= 16*2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromNDS_CI4(DecodeContext &ctx, int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz,
+	const uint16_t *RESTRICT pal_buf, int pal_siz);
+
 /** Nintendo 3DS **/
 
 /**
@@ -407,6 +482,19 @@ rp_image *fromNDS_CI4(int width, int height,
 rp_image *fromN3DSTiledRGB565(int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz);
 
+/**
+ * Convert a Nintendo 3DS RGB565 tiled icon to rp_image.
+ * Reusable context version.
+ * @param ctx Decode context. The context owns the returned image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromN3DSTiledRGB565(DecodeContext &ctx, int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz);
+
 /**
  * Convert a Nintendo 3DS RGB565+A4 tiled icon to rp_image.
  * @param width Image width.
@@ -421,6 +509,49 @@ rp_image *fromN3DSTiledRGB565_A4(int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz,
 	const uint8_t *RESTRICT alpha_buf, int alpha_siz);
 
+/**
+ * Convert a Nintendo 3DS RGB565+A4 tiled icon to rp_image.
+ * Reusable context version.
+ * @param ctx Decode context. The context owns the returned image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromN3DSTiledRGB565_A4(DecodeContext &ctx, int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz);
+
+/**
+ * Convert a Nintendo 3DS RGB565+A4 tiled cell into a larger rp_image.
+ *
+ * The cell is decoded directly into the destination image at (x, y).
+ * All cells with the same dimensions share one untile lookup table,
+ * so composite pages (Mega Badges, badge sheets) decode in a single
+ * pass without a per-cell temporary image and copy.
+ *
+ * NOTE: The caller is responsible for setting the sBIT metadata
+ * on the destination image.
+ *
+ * @param img Destination image. (ARGB32)
+ * @param x Destination X position. [must be a multiple of 8]
+ * @param y Destination Y position. [must be a multiple of 8]
+ * @param width Cell width.
+ * @param height Cell height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
+ * @return 0 on success; non-zero on error.
+ */
+int fromN3DSTiledRGB565_A4_at(rp_image *RESTRICT img, int x, int y,
+	int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz);
+
 /* S3TC */
 
 /**
@@ -825,6 +956,16 @@ static rp_image *fromLinear32(PixelFormat px_format,
 	int width, int height,
 	const uint32_t *RESTRICT img_buf, int img_siz, int stride)
 {
+#ifdef IMAGEDECODER_HAS_NEON
+	if (RP_CPU_HasNEON()) {
+		return fromLinear32_neon(px_format, width, height, img_buf, img_siz, stride);
+	} else
+#endif /* IMAGEDECODER_HAS_NEON */
+#ifdef IMAGEDECODER_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return fromLinear32_avx2(px_format, width, height, img_buf, img_siz, stride);
+	} else
+#endif /* IMAGEDECODER_HAS_AVX2 */
 #ifdef IMAGEDECODER_HAS_SSSE3
 	if (RP_CPU_HasSSSE3()) {
 		return fromLinear32_ssse3(px_format, width, height, img_buf, img_siz, stride);
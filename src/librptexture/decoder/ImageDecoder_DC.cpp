@@ -59,6 +59,35 @@ static FORCEINLINE void initDreamcastTwiddleMap(void)
 	pthread_once(&once_control, initDreamcastTwiddleMap_int);
 }
 
+/**
+ * Convert a Dreamcast square twiddled 16-bit image to ARGB32. (hot loop)
+ * The pixel conversion function is a template parameter, so each
+ * instantiation is a fully-specialized loop with the conversion
+ * inlined. The switch in fromDreamcastSquareTwiddled16() selects
+ * an instantiation once, outside of the hot loop.
+ * @tparam px16_to_ARGB32 Pixel conversion function.
+ * @param px_dest	[out] Destination image buffer.
+ * @param dest_stride_adj [in] Destination stride adjustment, in pixels.
+ * @param img_buf	[in] 16-bit image buffer.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ */
+template<uint32_t (*px16_to_ARGB32)(uint16_t)>
+static void T_fromDreamcastSquareTwiddled16(uint32_t *RESTRICT px_dest,
+	int dest_stride_adj,
+	const uint16_t *RESTRICT img_buf,
+	unsigned int width, unsigned int height)
+{
+	for (unsigned int y = 0; y < height; y++) {
+		for (unsigned int x = 0; x < width; x++) {
+			const unsigned int srcIdx = ((dc_tmap[x] << 1) | dc_tmap[y]);
+			*px_dest = px16_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
+			px_dest++;
+		}
+		px_dest += dest_stride_adj;
+	}
+}
+
 /**
  * Convert a Dreamcast square twiddled 16-bit image to rp_image.
  * @param px_format 16-bit pixel format.
@@ -102,14 +131,10 @@ rp_image *fromDreamcastSquareTwiddled16(PixelFormat px_format,
 	const int dest_stride_adj = (img->stride() / sizeof(uint32_t)) - img->width();
 	switch (px_format) {
 		case PXF_ARGB1555: {
-			for (unsigned int y = 0; y < static_cast<unsigned int>(height); y++) {
-				for (unsigned int x = 0; x < static_cast<unsigned int>(width); x++) {
-					const unsigned int srcIdx = ((dc_tmap[x] << 1) | dc_tmap[y]);
-					*px_dest = ARGB1555_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
-					px_dest++;
-				}
-				px_dest += dest_stride_adj;
-			}
+			T_fromDreamcastSquareTwiddled16<ARGB1555_to_ARGB32>(
+				px_dest, dest_stride_adj, img_buf,
+				static_cast<unsigned int>(width),
+				static_cast<unsigned int>(height));
 			// Set the sBIT metadata.
 			static const rp_image::sBIT_t sBIT = {5,5,5,0,1};
 			img->set_sBIT(&sBIT);
@@ -117,14 +142,10 @@ rp_image *fromDreamcastSquareTwiddled16(PixelFormat px_format,
 		}
 
 		case PXF_RGB565: {
-			for (unsigned int y = 0; y < static_cast<unsigned int>(height); y++) {
-				for (unsigned int x = 0; x < static_cast<unsigned int>(width); x++) {
-					const unsigned int srcIdx = ((dc_tmap[x] << 1) | dc_tmap[y]);
-					*px_dest = RGB565_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
-					px_dest++;
-				}
-				px_dest += dest_stride_adj;
-			}
+			T_fromDreamcastSquareTwiddled16<RGB565_to_ARGB32>(
+				px_dest, dest_stride_adj, img_buf,
+				static_cast<unsigned int>(width),
+				static_cast<unsigned int>(height));
 			// Set the sBIT metadata.
 			static const rp_image::sBIT_t sBIT = {5,6,5,0,0};
 			img->set_sBIT(&sBIT);
@@ -132,14 +153,10 @@ rp_image *fromDreamcastSquareTwiddled16(PixelFormat px_format,
 		}
 
 		case PXF_ARGB4444: {
-			for (unsigned int y = 0; y < static_cast<unsigned int>(height); y++) {
-				for (unsigned int x = 0; x < static_cast<unsigned int>(width); x++) {
-					const unsigned int srcIdx = ((dc_tmap[x] << 1) | dc_tmap[y]);
-					*px_dest = ARGB4444_to_ARGB32(le16_to_cpu(img_buf[srcIdx]));
-					px_dest++;
-				}
-				px_dest += dest_stride_adj;
-			}
+			T_fromDreamcastSquareTwiddled16<ARGB4444_to_ARGB32>(
+				px_dest, dest_stride_adj, img_buf,
+				static_cast<unsigned int>(width),
+				static_cast<unsigned int>(height));
 			// Set the sBIT metadata.
 			static const rp_image::sBIT_t sBIT = {4,4,4,0,4};
 			img->set_sBIT(&sBIT);
@@ -10,6 +10,26 @@
 #include "ImageDecoder.hpp"
 #include "ImageDecoder_p.hpp"
 
+// librpfile
+#include "librpfile/RpStats.hpp"
+namespace RpStats = LibRpFile::RpStats;
+
+#include "librpcpu/cpu_dispatch.h"
+#if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
+# include "librpcpu/cpuflags_x86.h"
+# include <emmintrin.h>
+# define ETC1_HAS_SSE2 1
+# ifdef RP_CPU_AMD64
+#  define ETC1_ALWAYS_HAS_SSE2 1
+# endif
+#endif
+#ifdef RP_CPU_ARM64
+// NEON is mandatory on arm64, so the intrinsics can be
+// compiled here without per-file compiler flags.
+# include <arm_neon.h>
+# define ETC1_ALWAYS_HAS_NEON 1
+#endif
+
 // References:
 // - https://www.khronos.org/registry/OpenGL/extensions/OES/OES_compressed_ETC1_RGB8_texture.txt
 // - https://www.khronos.org/registry/DataFormat/specs/1.1/dataformat.1.1.html#ETC1
@@ -304,6 +324,146 @@ static inline uint32_t clamp_ColorRGB(const ColorRGB &color)
 	return xrgb32 | 0xFF000000;
 }
 
+/**
+ * Compute the eight candidate colors for an ETC1-mode block.
+ * Standard C++ implementation.
+ *
+ * Four candidates per subblock: the base color plus each intensity
+ * modifier, clamped to [0,255] and converted to xRGB32.
+ *
+ * @param candidates	[out] Candidate colors. [(subblock * 4) + px_idx]
+ * @param base_color	[in] Base colors for the two subblocks.
+ * @param tbl		[in] Intensity modifier tables for the two subblocks.
+ */
+static inline void etc1_candidate_colors_cpp(uint32_t candidates[8],
+	const ColorRGB base_color[2], const int16_t *const tbl[2])
+{
+	for (unsigned int sub = 0; sub < 2; sub++) {
+		for (unsigned int i = 0; i < 4; i++) {
+			const int adj = tbl[sub][i];
+			ColorRGB color = base_color[sub];
+			color.R += adj;
+			color.G += adj;
+			color.B += adj;
+			candidates[(sub * 4) + i] = clamp_ColorRGB(color);
+		}
+	}
+}
+
+#ifdef ETC1_HAS_SSE2
+/**
+ * Compute the eight candidate colors for an ETC1-mode block.
+ * SSE2-optimized version.
+ *
+ * Four candidates per subblock: the base color plus each intensity
+ * modifier, clamped to [0,255] and converted to xRGB32.
+ *
+ * @param candidates	[out] Candidate colors. [(subblock * 4) + px_idx]
+ * @param base_color	[in] Base colors for the two subblocks.
+ * @param tbl		[in] Intensity modifier tables for the two subblocks.
+ */
+static inline void etc1_candidate_colors_sse2(uint32_t candidates[8],
+	const ColorRGB base_color[2], const int16_t *const tbl[2])
+{
+	for (unsigned int sub = 0; sub < 2; sub++) {
+		// Base color in [B, G, R, A] lane order, duplicated for
+		// two candidates per vector. The alpha lane is 255 with
+		// a modifier of 0, so it packs to 0xFF.
+		const __m128i base = _mm_setr_epi16(
+			base_color[sub].B, base_color[sub].G, base_color[sub].R, 255,
+			base_color[sub].B, base_color[sub].G, base_color[sub].R, 255);
+		const __m128i mod01 = _mm_setr_epi16(
+			tbl[sub][0], tbl[sub][0], tbl[sub][0], 0,
+			tbl[sub][1], tbl[sub][1], tbl[sub][1], 0);
+		const __m128i mod23 = _mm_setr_epi16(
+			tbl[sub][2], tbl[sub][2], tbl[sub][2], 0,
+			tbl[sub][3], tbl[sub][3], tbl[sub][3], 0);
+
+		// Add the modifiers, then pack with unsigned saturation
+		// to clamp each component to [0,255].
+		const __m128i px = _mm_packus_epi16(
+			_mm_add_epi16(base, mod01),
+			_mm_add_epi16(base, mod23));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(&candidates[sub * 4]), px);
+	}
+}
+#endif /* ETC1_HAS_SSE2 */
+
+#ifdef ETC1_ALWAYS_HAS_NEON
+/**
+ * Compute the eight candidate colors for an ETC1-mode block.
+ * NEON-optimized version.
+ *
+ * Four candidates per subblock: the base color plus each intensity
+ * modifier, clamped to [0,255] and converted to xRGB32.
+ *
+ * @param candidates	[out] Candidate colors. [(subblock * 4) + px_idx]
+ * @param base_color	[in] Base colors for the two subblocks.
+ * @param tbl		[in] Intensity modifier tables for the two subblocks.
+ */
+static inline void etc1_candidate_colors_neon(uint32_t candidates[8],
+	const ColorRGB base_color[2], const int16_t *const tbl[2])
+{
+	for (unsigned int sub = 0; sub < 2; sub++) {
+		// Base color in [B, G, R, A] lane order, duplicated for
+		// two candidates per vector. The alpha lane is 255 with
+		// a modifier of 0, so it narrows to 0xFF.
+		const int16_t base_buf[8] = {
+			static_cast<int16_t>(base_color[sub].B),
+			static_cast<int16_t>(base_color[sub].G),
+			static_cast<int16_t>(base_color[sub].R), 255,
+			static_cast<int16_t>(base_color[sub].B),
+			static_cast<int16_t>(base_color[sub].G),
+			static_cast<int16_t>(base_color[sub].R), 255,
+		};
+		const int16_t mod01_buf[8] = {
+			tbl[sub][0], tbl[sub][0], tbl[sub][0], 0,
+			tbl[sub][1], tbl[sub][1], tbl[sub][1], 0,
+		};
+		const int16_t mod23_buf[8] = {
+			tbl[sub][2], tbl[sub][2], tbl[sub][2], 0,
+			tbl[sub][3], tbl[sub][3], tbl[sub][3], 0,
+		};
+		const int16x8_t base = vld1q_s16(base_buf);
+
+		// Add the modifiers, then narrow with unsigned saturation
+		// to clamp each component to [0,255].
+		const uint8x8_t px01 = vqmovun_s16(vaddq_s16(base, vld1q_s16(mod01_buf)));
+		const uint8x8_t px23 = vqmovun_s16(vaddq_s16(base, vld1q_s16(mod23_buf)));
+		vst1q_u8(reinterpret_cast<uint8_t*>(&candidates[sub * 4]),
+			vcombine_u8(px01, px23));
+	}
+}
+#endif /* ETC1_ALWAYS_HAS_NEON */
+
+/**
+ * Compute the eight candidate colors for an ETC1-mode block.
+ *
+ * Four candidates per subblock: the base color plus each intensity
+ * modifier, clamped to [0,255] and converted to xRGB32.
+ *
+ * @param candidates	[out] Candidate colors. [(subblock * 4) + px_idx]
+ * @param base_color	[in] Base colors for the two subblocks.
+ * @param tbl		[in] Intensity modifier tables for the two subblocks.
+ */
+static inline void etc1_candidate_colors(uint32_t candidates[8],
+	const ColorRGB base_color[2], const int16_t *const tbl[2])
+{
+#if defined(ETC1_ALWAYS_HAS_SSE2)
+	etc1_candidate_colors_sse2(candidates, base_color, tbl);
+#elif defined(ETC1_ALWAYS_HAS_NEON)
+	etc1_candidate_colors_neon(candidates, base_color, tbl);
+#elif defined(ETC1_HAS_SSE2)
+	if (RP_CPU_HasSSE2()) {
+		etc1_candidate_colors_sse2(candidates, base_color, tbl);
+	} else {
+		etc1_candidate_colors_cpp(candidates, base_color, tbl);
+	}
+#else
+	etc1_candidate_colors_cpp(candidates, base_color, tbl);
+#endif
+}
+
 // ETC decoding mode.
 enum ETC_Decoding_Mode {
 	// Bit 0: ETC1 vs. ETC2
@@ -520,6 +680,13 @@ static void decodeBlock_ETC_RGB(uint32_t tileBuf[4*4], const etc1_block *etc1_sr
 				tbl[1] = etc1_intensity[(etc1_src->control >> 2) & 0x07];
 			}
 
+			// Precompute the eight candidate colors.
+			// Each pixel then selects a candidate based on its
+			// subblock and pixel index, so the add/clamp is done
+			// once per candidate instead of once per pixel.
+			uint32_t candidates[8];
+			etc1_candidate_colors(candidates, base_color, tbl);
+
 			// control, bit 0: flip
 			uint16_t subblock = etc1_subblock_mapping[etc1_src->control & 0x01];
 			for (unsigned int i = 0; i < 16; i++, px_msb >>= 1, px_lsb >>= 1, subblock >>= 1) {
@@ -535,16 +702,9 @@ static void decodeBlock_ETC_RGB(uint32_t tileBuf[4*4], const etc1_block *etc1_sr
 					}
 				}
 
-				// Select the table codeword based on the current subblock.
-				const uint8_t cur_sub = subblock & 1;
-				const int adj = tbl[cur_sub][px_idx];
-				ColorRGB color = base_color[cur_sub];
-				color.R += adj;
-				color.G += adj;
-				color.B += adj;
-
-				// Clamp the color components and save it to the tile buffer.
-				*p = clamp_ColorRGB(color);
+				// Select the candidate color based on the
+				// current subblock and pixel index.
+				*p = candidates[((subblock & 1) * 4) + px_idx];
 			}
 			break;
 		}
@@ -611,6 +771,7 @@ static void decodeBlock_ETC_RGB(uint32_t tileBuf[4*4], const etc1_block *etc1_sr
 rp_image *fromETC1(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_ETC);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -673,6 +834,7 @@ rp_image *fromETC1(int width, int height,
 rp_image *fromETC2_RGB(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_ETC);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -775,6 +937,7 @@ static void decodeBlock_ETC2_alpha(uint32_t tileBuf[4*4], const etc2_alpha *alph
 rp_image *fromETC2_RGBA(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_ETC);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -841,6 +1004,7 @@ rp_image *fromETC2_RGBA(int width, int height,
 rp_image *fromETC2_RGB_A1(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_ETC);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -9,6 +9,7 @@
 #include "stdafx.h"
 #include "ImageDecoder.hpp"
 #include "ImageDecoder_p.hpp"
+#include "UntileCache.hpp"
 
 #include "PixelConversion.hpp"
 using namespace LibRpTexture::PixelConversion;
@@ -57,22 +58,38 @@ rp_image *fromGcn16(PixelFormat px_format,
 	const unsigned int tilesX = static_cast<unsigned int>(width / 4);
 	const unsigned int tilesY = static_cast<unsigned int>(height / 4);
 
-	// Temporary tile buffer.
+	// Check for a cached untile table.
+	// Icon and banner images all share the same layout, so repeat
+	// decodes become a single gather/scatter loop.
+	const unsigned int *const untileLUT = getUntileLUT(width, height,
+		static_cast<unsigned int>(img->stride() / sizeof(uint32_t)), 4, 4);
+	uint32_t *const px_dest = (untileLUT ? static_cast<uint32_t*>(img->bits()) : nullptr);
+	const unsigned int px_count = static_cast<unsigned int>(width * height);
+
+	// Temporary tile buffer. (Used if no untile table is available.)
 	uint32_t tileBuf[4*4];
 
 	switch (px_format) {
 		case PXF_RGB5A3: {
-			for (unsigned int y = 0; y < tilesY; y++) {
-				for (unsigned int x = 0; x < tilesX; x++) {
-					// Convert each tile to ARGB32 manually.
-					// TODO: Optimize using pointers instead of indexes?
-					for (unsigned int i = 0; i < 4*4; i += 2, img_buf += 2) {
-						tileBuf[i+0] = RGB5A3_to_ARGB32(be16_to_cpu(img_buf[0]));
-						tileBuf[i+1] = RGB5A3_to_ARGB32(be16_to_cpu(img_buf[1]));
+			if (untileLUT) {
+				// Untile using the lookup table.
+				for (unsigned int i = 0; i < px_count; i += 2, img_buf += 2) {
+					px_dest[untileLUT[i+0]] = RGB5A3_to_ARGB32(be16_to_cpu(img_buf[0]));
+					px_dest[untileLUT[i+1]] = RGB5A3_to_ARGB32(be16_to_cpu(img_buf[1]));
+				}
+			} else {
+				for (unsigned int y = 0; y < tilesY; y++) {
+					for (unsigned int x = 0; x < tilesX; x++) {
+						// Convert each tile to ARGB32 manually.
+						// TODO: Optimize using pointers instead of indexes?
+						for (unsigned int i = 0; i < 4*4; i += 2, img_buf += 2) {
+							tileBuf[i+0] = RGB5A3_to_ARGB32(be16_to_cpu(img_buf[0]));
+							tileBuf[i+1] = RGB5A3_to_ARGB32(be16_to_cpu(img_buf[1]));
+						}
+
+						// Blit the tile to the main image buffer.
+						ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
 					}
-
-					// Blit the tile to the main image buffer.
-					ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
 				}
 			}
 			// Set the sBIT metadata.
@@ -85,17 +102,25 @@ rp_image *fromGcn16(PixelFormat px_format,
 		}
 
 		case PXF_RGB565: {
-			for (unsigned int y = 0; y < tilesY; y++) {
-				for (unsigned int x = 0; x < tilesX; x++) {
-					// Convert each tile to ARGB32 manually.
-					// TODO: Optimize using pointers instead of indexes?
-					for (unsigned int i = 0; i < 4*4; i += 2, img_buf += 2) {
-						tileBuf[i+0] = RGB565_to_ARGB32(be16_to_cpu(img_buf[0]));
-						tileBuf[i+1] = RGB565_to_ARGB32(be16_to_cpu(img_buf[1]));
+			if (untileLUT) {
+				// Untile using the lookup table.
+				for (unsigned int i = 0; i < px_count; i += 2, img_buf += 2) {
+					px_dest[untileLUT[i+0]] = RGB565_to_ARGB32(be16_to_cpu(img_buf[0]));
+					px_dest[untileLUT[i+1]] = RGB565_to_ARGB32(be16_to_cpu(img_buf[1]));
+				}
+			} else {
+				for (unsigned int y = 0; y < tilesY; y++) {
+					for (unsigned int x = 0; x < tilesX; x++) {
+						// Convert each tile to ARGB32 manually.
+						// TODO: Optimize using pointers instead of indexes?
+						for (unsigned int i = 0; i < 4*4; i += 2, img_buf += 2) {
+							tileBuf[i+0] = RGB565_to_ARGB32(be16_to_cpu(img_buf[0]));
+							tileBuf[i+1] = RGB565_to_ARGB32(be16_to_cpu(img_buf[1]));
+						}
+
+						// Blit the tile to the main image buffer.
+						ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
 					}
-
-					// Blit the tile to the main image buffer.
-					ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
 				}
 			}
 			// Set the sBIT metadata.
@@ -105,17 +130,25 @@ rp_image *fromGcn16(PixelFormat px_format,
 		}
 
 		case PXF_IA8: {
-			for (unsigned int y = 0; y < tilesY; y++) {
-				for (unsigned int x = 0; x < tilesX; x++) {
-					// Convert each tile to ARGB32 manually.
-					// TODO: Optimize using pointers instead of indexes?
-					for (unsigned int i = 0; i < 4*4; i += 2, img_buf += 2) {
-						tileBuf[i+0] = IA8_to_ARGB32(be16_to_cpu(img_buf[0]));
-						tileBuf[i+1] = IA8_to_ARGB32(be16_to_cpu(img_buf[1]));
+			if (untileLUT) {
+				// Untile using the lookup table.
+				for (unsigned int i = 0; i < px_count; i += 2, img_buf += 2) {
+					px_dest[untileLUT[i+0]] = IA8_to_ARGB32(be16_to_cpu(img_buf[0]));
+					px_dest[untileLUT[i+1]] = IA8_to_ARGB32(be16_to_cpu(img_buf[1]));
+				}
+			} else {
+				for (unsigned int y = 0; y < tilesY; y++) {
+					for (unsigned int x = 0; x < tilesX; x++) {
+						// Convert each tile to ARGB32 manually.
+						// TODO: Optimize using pointers instead of indexes?
+						for (unsigned int i = 0; i < 4*4; i += 2, img_buf += 2) {
+							tileBuf[i+0] = IA8_to_ARGB32(be16_to_cpu(img_buf[0]));
+							tileBuf[i+1] = IA8_to_ARGB32(be16_to_cpu(img_buf[1]));
+						}
+
+						// Blit the tile to the main image buffer.
+						ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
 					}
-
-					// Blit the tile to the main image buffer.
-					ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
 				}
 			}
 			// Set the sBIT metadata.
@@ -10,12 +10,141 @@
 #include "stdafx.h"
 #include "ImageDecoder.hpp"
 #include "ImageDecoder_p.hpp"
+#include "DecodeContext.hpp"
+
+// librpfile
+#include "librpfile/RpStats.hpp"
+namespace RpStats = LibRpFile::RpStats;
 
 #include "PixelConversion.hpp"
 using namespace LibRpTexture::PixelConversion;
 
+#include "librpcpu/cpu_dispatch.h"
+#if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
+# include "librpcpu/cpuflags_x86.h"
+# include <emmintrin.h>
+# define LINEAR_HAS_SSE2 1
+# ifdef RP_CPU_AMD64
+#  define LINEAR_ALWAYS_HAS_SSE2 1
+# endif
+#endif
+
 namespace LibRpTexture { namespace ImageDecoder {
 
+/**
+ * CI4 -> CI8 nybble expansion lookup tables.
+ * Each entry expands one CI4 byte (two pixels) to two CI8 bytes,
+ * stored in output byte order for a single 16-bit write.
+ */
+struct CI4ExpandLUT {
+	uint16_t msn[256];	// Most-significant nybble is the left pixel.
+	uint16_t lsn[256];	// Least-significant nybble is the left pixel.
+
+	CI4ExpandLUT() {
+		for (unsigned int i = 0; i < 256; i++) {
+			const uint16_t hi = (i >> 4);
+			const uint16_t lo = (i & 0x0F);
+			msn[i] = cpu_to_le16(static_cast<uint16_t>(hi | (lo << 8)));
+			lsn[i] = cpu_to_le16(static_cast<uint16_t>(lo | (hi << 8)));
+		}
+	}
+};
+
+/** Templated conversion loops. **/
+// The pixel conversion function is a template parameter, so each
+// instantiation is a fully-specialized loop with the conversion
+// inlined. The switch in the fromLinear*() functions selects an
+// instantiation once, outside of the hot loop.
+
+/**
+ * Convert a linear 8-bit image to ARGB32. (hot loop)
+ * @tparam px8_to_ARGB32 Pixel conversion function.
+ * @param px_dest	[out] Destination image buffer.
+ * @param img_buf	[in] 8-bit image buffer.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param src_stride_adj [in] Source stride adjustment, in pixels.
+ * @param dest_stride_adj [in] Destination stride adjustment, in pixels.
+ */
+template<uint32_t (*px8_to_ARGB32)(uint8_t)>
+static void T_fromLinear8_convLoop(uint32_t *RESTRICT px_dest,
+	const uint8_t *RESTRICT img_buf,
+	unsigned int width, unsigned int height,
+	int src_stride_adj, int dest_stride_adj)
+{
+	for (unsigned int y = height; y > 0; y--) {
+		unsigned int x;
+		for (x = width; x > 1; x -= 2) {
+			px_dest[0] = px8_to_ARGB32(img_buf[0]);
+			px_dest[1] = px8_to_ARGB32(img_buf[1]);
+			img_buf += 2;
+			px_dest += 2;
+		}
+		if (x == 1) {
+			// Extra pixel.
+			*px_dest = px8_to_ARGB32(*img_buf);
+			img_buf++;
+			px_dest++;
+		}
+		img_buf += src_stride_adj;
+		px_dest += dest_stride_adj;
+	}
+}
+
+/**
+ * Convert a linear 16-bit image to ARGB32. (hot loop)
+ * @tparam px16_to_ARGB32 Pixel conversion function.
+ * @param px_dest	[out] Destination image buffer.
+ * @param img_buf	[in] 16-bit image buffer.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param src_stride_adj [in] Source stride adjustment, in pixels.
+ * @param dest_stride_adj [in] Destination stride adjustment, in pixels.
+ */
+template<uint32_t (*px16_to_ARGB32)(uint16_t)>
+static void T_fromLinear16_convLoop(uint32_t *RESTRICT px_dest,
+	const uint16_t *RESTRICT img_buf,
+	unsigned int width, unsigned int height,
+	int src_stride_adj, int dest_stride_adj)
+{
+	for (unsigned int y = height; y > 0; y--) {
+		for (unsigned int x = width; x > 0; x--) {
+			*px_dest = px16_to_ARGB32(le16_to_cpu(*img_buf));
+			img_buf++;
+			px_dest++;
+		}
+		img_buf += src_stride_adj;
+		px_dest += dest_stride_adj;
+	}
+}
+
+/**
+ * Convert a linear 32-bit image to ARGB32. (hot loop)
+ * @tparam px32_to_ARGB32 Pixel conversion function.
+ * @param px_dest	[out] Destination image buffer.
+ * @param img_buf	[in] 32-bit image buffer.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param src_stride_adj [in] Source stride adjustment, in pixels.
+ * @param dest_stride_adj [in] Destination stride adjustment, in pixels.
+ */
+template<uint32_t (*px32_to_ARGB32)(uint32_t)>
+static void T_fromLinear32_convLoop(uint32_t *RESTRICT px_dest,
+	const uint32_t *RESTRICT img_buf,
+	unsigned int width, unsigned int height,
+	int src_stride_adj, int dest_stride_adj)
+{
+	for (unsigned int y = height; y > 0; y--) {
+		for (unsigned int x = width; x > 0; x--) {
+			*px_dest = px32_to_ARGB32(le32_to_cpu(*img_buf));
+			img_buf++;
+			px_dest++;
+		}
+		img_buf += src_stride_adj;
+		px_dest += dest_stride_adj;
+	}
+}
+
 /**
  * Convert a linear CI4 image to rp_image with a little-endian 16-bit palette.
  * @param px_format Palette pixel format.
@@ -33,6 +162,7 @@ rp_image *fromLinearCI4(PixelFormat px_format, bool msn_left,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	const void *RESTRICT pal_buf, int pal_siz)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_LINEAR);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(pal_buf != nullptr);
@@ -227,29 +357,43 @@ rp_image *fromLinearCI4(PixelFormat px_format, bool msn_left,
 	// so we don't need to clear the remaining colors.
 
 	// Convert one line at a time. (CI4 -> CI8)
+	// Each source byte expands to two destination bytes via a
+	// 256-entry lookup table; full 16-byte groups (32 pixels)
+	// are expanded with SSE2 if it's available.
+	static const CI4ExpandLUT lut;
+	const uint16_t *const lut16 = (msn_left ? lut.msn : lut.lsn);
 	uint8_t *px_dest = static_cast<uint8_t*>(img->bits());
-	if (msn_left) {
-		// Left pixel is the Most Significant Nybble.
-		for (unsigned int y = static_cast<unsigned int>(height); y > 0; y--) {
-			for (unsigned int x = static_cast<unsigned int>(width); x > 0; x -= 2) {
-				px_dest[0] = (*img_buf >> 4);
-				px_dest[1] = (*img_buf & 0x0F);
-				img_buf++;
-				px_dest += 2;
+#ifdef LINEAR_HAS_SSE2
+# ifdef LINEAR_ALWAYS_HAS_SSE2
+	static const bool has_sse2 = true;
+# else
+	const bool has_sse2 = (RP_CPU_HasSSE2() != 0);
+# endif
+	const __m128i nyb_mask = _mm_set1_epi8(0x0F);
+#endif /* LINEAR_HAS_SSE2 */
+	for (unsigned int y = static_cast<unsigned int>(height); y > 0; y--) {
+		unsigned int x = static_cast<unsigned int>(width);
+#ifdef LINEAR_HAS_SSE2
+		if (has_sse2) {
+			// Expand 16 source bytes (32 pixels) at a time.
+			for (; x >= 32; x -= 32, img_buf += 16, px_dest += 32) {
+				const __m128i sb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(img_buf));
+				const __m128i hi = _mm_and_si128(_mm_srli_epi16(sb, 4), nyb_mask);
+				const __m128i lo = _mm_and_si128(sb, nyb_mask);
+				const __m128i px0 = (msn_left ? hi : lo);	// left pixels
+				const __m128i px1 = (msn_left ? lo : hi);	// right pixels
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(px_dest),
+					_mm_unpacklo_epi8(px0, px1));
+				_mm_storeu_si128(reinterpret_cast<__m128i*>(&px_dest[16]),
+					_mm_unpackhi_epi8(px0, px1));
 			}
-			px_dest += dest_stride_adj;
 		}
-	} else {
-		// Left pixel is the Least Significant Nybble.
-		for (unsigned int y = static_cast<unsigned int>(height); y > 0; y--) {
-			for (unsigned int x = static_cast<unsigned int>(width); x > 0; x -= 2) {
-				px_dest[0] = (*img_buf & 0x0F);
-				px_dest[1] = (*img_buf >> 4);
-				img_buf++;
-				px_dest += 2;
-			}
-			px_dest += dest_stride_adj;
+#endif /* LINEAR_HAS_SSE2 */
+		// Remaining pixels: use the lookup table.
+		for (; x > 0; x -= 2, img_buf++, px_dest += 2) {
+			memcpy(px_dest, &lut16[*img_buf], sizeof(uint16_t));
 		}
+		px_dest += dest_stride_adj;
 	}
 
 	// Image has been converted.
@@ -257,7 +401,8 @@ rp_image *fromLinearCI4(PixelFormat px_format, bool msn_left,
 }
 
 /**
- * Convert a linear CI8 image to rp_image with a little-endian 16-bit palette.
+ * Convert a linear CI8 image to rp_image with a little-endian 16-bit palette. (internal)
+ * @param img Destination image. (CI8, width x height)
  * @param px_format Palette pixel format.
  * @param width Image width.
  * @param height Image height.
@@ -265,9 +410,9 @@ rp_image *fromLinearCI4(PixelFormat px_format, bool msn_left,
  * @param img_siz Size of image data. [must be >= (w*h)]
  * @param pal_buf Palette buffer.
  * @param pal_siz Size of palette data. [must be >= 256*2 for 16-bit, >= 256*4 for 32-bit]
- * @return rp_image, or nullptr on error.
+ * @return 0 on success; non-zero on error.
  */
-rp_image *fromLinearCI8(PixelFormat px_format,
+static int fromLinearCI8_int(rp_image *RESTRICT img, PixelFormat px_format,
 	int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	const void *RESTRICT pal_buf, int pal_siz)
@@ -275,13 +420,11 @@ rp_image *fromLinearCI8(PixelFormat px_format,
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(pal_buf != nullptr);
-	assert(width > 0);
-	assert(height > 0);
 	assert(img_siz >= (width * height));
-	if (!img_buf || !pal_buf || width <= 0 || height <= 0 ||
+	if (!img->isValid() || !img_buf || !pal_buf ||
 	    img_siz < (width * height))
 	{
-		return nullptr;
+		return -1;
 	}
 
 	// Handle BGR888_ABGR7888 palette pixel format for SVR.
@@ -289,32 +432,23 @@ rp_image *fromLinearCI8(PixelFormat px_format,
 		// 32-bit palette required.
 		assert(pal_siz >= 256*4);
 		if (pal_siz < 256*4) {
-			return nullptr;
+			return -1;
 		}
 	} else {
 		// 16-bit palette required.
 		assert(pal_siz >= 256*2);
 		if (pal_siz < 256*2) {
-			return nullptr;
+			return -1;
 		}
 	}
 
-	// Create an rp_image.
-	rp_image *img = new rp_image(width, height, rp_image::FORMAT_CI8);
-	if (!img->isValid()) {
-		// Could not allocate the image.
-		delete img;
-		return nullptr;
-	}
-
 	// Convert the palette.
 	// TODO: Optimize using pointers instead of indexes?
 	uint32_t *palette = img->palette();
 	assert(img->palette_len() >= 256);
 	if (img->palette_len() < 256) {
 		// Not enough colors...
-		delete img;
-		return nullptr;
+		return -1;
 	}
 
 	int tr_idx = -1;
@@ -439,8 +573,7 @@ rp_image *fromLinearCI8(PixelFormat px_format,
 
 		default:
 			assert(!"Invalid pixel format for this function.");
-			delete img;
-			return nullptr;
+			return -1;
 	}
 	img->set_tr_idx(tr_idx);
 
@@ -461,6 +594,65 @@ rp_image *fromLinearCI8(PixelFormat px_format,
 	}
 
 	// Image has been converted.
+	return 0;
+}
+
+/**
+ * Convert a linear CI8 image to rp_image with a little-endian 16-bit palette.
+ * @param px_format Palette pixel format.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf CI8 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @param pal_buf Palette buffer.
+ * @param pal_siz Size of palette data. [must be >= 256*2 for 16-bit, >= 256*4 for 32-bit]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromLinearCI8(PixelFormat px_format,
+	int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz,
+	const void *RESTRICT pal_buf, int pal_siz)
+{
+	RpStats::increment(RpStats::CTR_IMGDEC_LINEAR);
+	assert(width > 0);
+	assert(height > 0);
+	if (width <= 0 || height <= 0) {
+		return nullptr;
+	}
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(width, height, rp_image::FORMAT_CI8);
+	if (fromLinearCI8_int(img, px_format, width, height, img_buf, img_siz, pal_buf, pal_siz) != 0) {
+		delete img;
+		return nullptr;
+	}
+	return img;
+}
+
+/**
+ * Convert a linear CI8 image to rp_image with a little-endian 16-bit palette.
+ * Reusable context version.
+ * @param ctx Decode context. The context owns the returned image.
+ * @param px_format Palette pixel format.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf CI8 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)]
+ * @param pal_buf Palette buffer.
+ * @param pal_siz Size of palette data. [must be >= 256*2 for 16-bit, >= 256*4 for 32-bit]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromLinearCI8(DecodeContext &ctx, PixelFormat px_format,
+	int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz,
+	const void *RESTRICT pal_buf, int pal_siz)
+{
+	RpStats::increment(RpStats::CTR_IMGDEC_LINEAR);
+	// Get a reusable image from the context.
+	rp_image *const img = ctx.reuse(width, height, rp_image::FORMAT_CI8);
+	if (!img || fromLinearCI8_int(img, px_format, width, height, img_buf, img_siz, pal_buf, pal_siz) != 0) {
+		return nullptr;
+	}
 	return img;
 }
 
@@ -475,6 +667,7 @@ rp_image *fromLinearCI8(PixelFormat px_format,
 rp_image *fromLinearMono(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_LINEAR);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -549,6 +742,7 @@ rp_image *fromLinear8(PixelFormat px_format,
 	int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_LINEAR);
 	static const int bytespp = 1;
 
 	// Verify parameters.
@@ -589,23 +783,9 @@ rp_image *fromLinear8(PixelFormat px_format,
 
 #define fromLinear8_convert(fmt, r,g,b,gr,a) \
 		case PXF_##fmt: { \
-			for (unsigned int y = (unsigned int)height; y > 0; y--) { \
-				unsigned int x; \
-				for (x = (unsigned int)width; x > 1; x -= 2) { \
-					px_dest[0] = fmt##_to_ARGB32(img_buf[0]); \
-					px_dest[1] = fmt##_to_ARGB32(img_buf[1]); \
-					img_buf += 2; \
-					px_dest += 2; \
-				} \
-				if (x == 1) { \
-					/* Extra pixel. */ \
-					*px_dest = fmt##_to_ARGB32(*img_buf); \
-					img_buf++; \
-					px_dest++; \
-				} \
-				img_buf += src_stride_adj; \
-				px_dest += dest_stride_adj; \
-			} \
+			T_fromLinear8_convLoop<fmt##_to_ARGB32>(px_dest, img_buf, \
+				(unsigned int)width, (unsigned int)height, \
+				src_stride_adj, dest_stride_adj); \
 			/* Set the sBIT data. */ \
 			static const rp_image::sBIT_t sBIT = {r,g,b,gr,a}; \
 			img->set_sBIT(&sBIT); \
@@ -646,6 +826,7 @@ rp_image *fromLinear16_cpp(PixelFormat px_format,
 	int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_LINEAR);
 	static const int bytespp = 2;
 
 	// Verify parameters.
@@ -686,20 +867,14 @@ rp_image *fromLinear16_cpp(PixelFormat px_format,
 
 #define fromLinear16_convert(fmt, r,g,b,gr,a) \
 		case PXF_##fmt: { \
-			for (unsigned int y = (unsigned int)height; y > 0; y--) { \
-				for (unsigned int x = (unsigned int)width; x > 0; x--) { \
-					*px_dest = fmt##_to_ARGB32(le16_to_cpu(*img_buf)); \
-					img_buf++; \
-					px_dest++; \
-				} \
-				img_buf += src_stride_adj; \
-				px_dest += dest_stride_adj; \
-			} \
+			T_fromLinear16_convLoop<fmt##_to_ARGB32>(px_dest, img_buf, \
+				(unsigned int)width, (unsigned int)height, \
+				src_stride_adj, dest_stride_adj); \
 			/* Set the sBIT data. */ \
 			static const rp_image::sBIT_t sBIT = {r,g,b,gr,a}; \
 			img->set_sBIT(&sBIT); \
 		} break
-			
+
 	// Convert one line at a time. (16-bit -> ARGB32)
 	switch (px_format) {
 		// 16-bit RGB.
@@ -761,6 +936,7 @@ rp_image *fromLinear24_cpp(PixelFormat px_format,
 	int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_LINEAR);
 	static const int bytespp = 3;
 
 	// Verify parameters.
@@ -862,6 +1038,7 @@ rp_image *fromLinear32_cpp(PixelFormat px_format,
 	int width, int height,
 	const uint32_t *RESTRICT img_buf, int img_siz, int stride)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_LINEAR);
 	static const int bytespp = 4;
 
 	// Verify parameters.
@@ -1162,16 +1339,10 @@ rp_image *fromLinear32_cpp(PixelFormat px_format,
 
 #define fromLinear32_convert(fmt, r,g,b,gr,a) \
 		case PXF_##fmt: { \
-			uint32_t *px_dest = static_cast<uint32_t*>(img->bits()); \
-			for (unsigned int y = (unsigned int)height; y > 0; y--) { \
-				for (unsigned int x = (unsigned int)width; x > 0; x--) { \
-					*px_dest = fmt##_to_ARGB32(le32_to_cpu(*img_buf)); \
-					img_buf++; \
-					px_dest++; \
-				} \
-				img_buf += src_stride_adj; \
-				px_dest += dest_stride_adj; \
-			} \
+			T_fromLinear32_convLoop<fmt##_to_ARGB32>( \
+				static_cast<uint32_t*>(img->bits()), img_buf, \
+				(unsigned int)width, (unsigned int)height, \
+				src_stride_adj, dest_stride_adj); \
 			/* Set the sBIT data. */ \
 			static const rp_image::sBIT_t sBIT = {r,g,b,gr,a}; \
 			img->set_sBIT(&sBIT); \
@@ -0,0 +1,360 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ImageDecoder_Linear.cpp: Image decoding functions. (Linear)             *
+ * NEON-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ImageDecoder.hpp"
+#include "ImageDecoder_p.hpp"
+
+#include "PixelConversion.hpp"
+using namespace LibRpTexture::PixelConversion;
+
+// NEON intrinsics.
+#include <arm_neon.h>
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+/**
+ * Convert a linear 32-bit RGB image to rp_image.
+ * NEON-optimized version.
+ * @param px_format	[in] 32-bit pixel format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param img_buf	[in] 32-bit image buffer.
+ * @param img_siz	[in] Size of image data. [must be >= (w*h)*3]
+ * @param stride	[in,opt] Stride, in bytes. If 0, assumes width*bytespp.
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromLinear32_neon(PixelFormat px_format,
+	int width, int height,
+	const uint32_t *RESTRICT img_buf, int img_siz, int stride)
+{
+	ASSERT_ALIGNMENT(16, img_buf);
+	static const int bytespp = 4;
+
+	// FIXME: Add support for these formats.
+	// For now, redirect back to the C++ version.
+	switch (px_format) {
+		case PXF_A2R10G10B10:
+		case PXF_A2B10G10R10:
+		case PXF_RGB9_E5:
+			return fromLinear32_cpp(px_format, width, height, img_buf, img_siz, stride);
+
+		default:
+			break;
+	}
+
+	// Verify parameters.
+	assert(img_buf != nullptr);
+	assert(width > 0);
+	assert(height > 0);
+	assert(img_siz >= ((width * height) * bytespp));
+	if (!img_buf || width <= 0 || height <= 0 ||
+	    img_siz < ((width * height) * bytespp))
+	{
+		return nullptr;
+	}
+
+	if (px_format == PXF_BGR888_ABGR7888) {
+		// Not supported right now.
+		// Use the C++ version.
+		return fromLinear32_cpp(px_format, width, height, img_buf, img_siz, stride);
+	}
+
+	// Stride adjustment.
+	int src_stride_adj = 0;
+	assert(stride >= 0);
+	if (stride > 0) {
+		// Set src_stride_adj to the number of pixels we need to
+		// add to the end of each line to get to the next row.
+		assert(stride % bytespp == 0);
+		assert(stride >= (width * bytespp));
+		if (unlikely(stride % bytespp != 0 || stride < (width * bytespp))) {
+			// Invalid stride.
+			return nullptr;
+		}
+		src_stride_adj = (stride / bytespp) - width;
+	} else {
+		// Calculate stride and make sure it's a multiple of 16.
+		// Exception: If the pixel format is PXF_HOST_ARGB32,
+		// we're using memcpy(), so alignment isn't required.
+		stride = width * bytespp;
+		if (unlikely((stride % 16 != 0) && px_format != PXF_HOST_ARGB32)) {
+			// Unaligned stride.
+			// Use the C++ version.
+			return fromLinear32_cpp(px_format, width, height, img_buf, img_siz, stride);
+		}
+	}
+
+	// Create an rp_image.
+	rp_image *img = new rp_image(width, height, rp_image::FORMAT_ARGB32);
+	if (!img->isValid()) {
+		// Could not allocate the image.
+		delete img;
+		return nullptr;
+	}
+
+	if (px_format == PXF_HOST_ARGB32) {
+		// Host-endian ARGB32.
+		// We can directly copy the image data without conversions.
+		if (stride == img->stride()) {
+			// Stride is identical. Copy the whole image all at once.
+			memcpy(img->bits(), img_buf, stride * height);
+		} else {
+			// Stride is not identical. Copy each scanline.
+			const int dest_stride = img->stride() / sizeof(uint32_t);
+			uint32_t *px_dest = static_cast<uint32_t*>(img->bits());
+			const unsigned int copy_len = static_cast<unsigned int>(width * bytespp);
+			for (unsigned int y = static_cast<unsigned int>(height); y > 0; y--) {
+				memcpy(px_dest, img_buf, copy_len);
+				img_buf += (stride / bytespp);
+				px_dest += dest_stride;
+			}
+		}
+		// Set the sBIT metadata.
+		static const rp_image::sBIT_t sBIT_A32 = {8,8,8,0,8};
+		img->set_sBIT(&sBIT_A32);
+		return img;
+	}
+
+	// NEON doesn't have a pshufb equivalent that's available on
+	// both armv7 and aarch64, but every supported swizzle maps to
+	// a combination of byte reversals (vrev) and 32-bit rotates.
+	enum SwizzleOp {
+		OP_COPY = 0,	// No byte rearrangement.
+		OP_ROR8,	// Rotate each 32-bit unit right by 8 bits.
+		OP_REV32,	// Reverse the bytes in each 32-bit unit.
+		OP_REV32_ROR8,	// OP_REV32, then OP_ROR8.
+		OP_REV16,	// Reverse the bytes in each 16-bit unit.
+		OP_G16R16,	// G16R16 truncation to G8R8.
+	};
+
+	// Determine the swizzle operation.
+	SwizzleOp swizzleOp;
+	bool has_alpha;
+	switch (px_format) {
+		case PXF_HOST_ARGB32:
+			assert(!"ARGB32 is handled separately.");
+			delete img;
+			return nullptr;
+		case PXF_HOST_xRGB32:
+			swizzleOp = OP_COPY;
+			has_alpha = false;
+			break;
+
+		case PXF_HOST_RGBA32:
+		case PXF_HOST_RGBx32:
+			swizzleOp = OP_ROR8;
+			has_alpha = (px_format == PXF_HOST_RGBA32);
+			break;
+
+		case PXF_SWAP_ARGB32:
+		case PXF_SWAP_xRGB32:
+			swizzleOp = OP_REV32;
+			has_alpha = (px_format == PXF_SWAP_ARGB32);
+			break;
+
+		case PXF_SWAP_RGBA32:
+		case PXF_SWAP_RGBx32:
+			swizzleOp = OP_REV32_ROR8;
+			has_alpha = (px_format == PXF_SWAP_RGBA32);
+			break;
+
+		case PXF_G16R16:
+			// NOTE: Truncates to G8R8.
+			swizzleOp = OP_G16R16;
+			has_alpha = false;
+			break;
+
+		case PXF_RABG8888:
+			swizzleOp = OP_REV16;
+			has_alpha = true;
+			break;
+
+		default:
+			assert(!"Unsupported 32-bit pixel format.");
+			delete img;
+			return nullptr;
+	}
+
+	const int dest_stride_adj = (img->stride() / sizeof(uint32_t)) - img->width();
+	uint32_t *px_dest = static_cast<uint32_t*>(img->bits());
+
+	// Alpha mask. For formats with a valid alpha channel,
+	// this is 0, so the OR is a no-op.
+	const uint32x4_t alpha_mask = vdupq_n_u32(has_alpha ? 0 : 0xFF000000);
+
+	for (unsigned int y = static_cast<unsigned int>(height); y > 0; y--) {
+		// Process 8 pixels per iteration using NEON.
+		unsigned int x = static_cast<unsigned int>(width);
+		for (; x > 7; x -= 8, px_dest += 8, img_buf += 8) {
+			uint32x4_t va = vld1q_u32(&img_buf[0]);
+			uint32x4_t vb = vld1q_u32(&img_buf[4]);
+
+			switch (swizzleOp) {
+				case OP_COPY:
+					break;
+
+				case OP_ROR8:
+					va = vorrq_u32(vshrq_n_u32(va, 8), vshlq_n_u32(va, 24));
+					vb = vorrq_u32(vshrq_n_u32(vb, 8), vshlq_n_u32(vb, 24));
+					break;
+
+				case OP_REV32:
+					va = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(va)));
+					vb = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(vb)));
+					break;
+
+				case OP_REV32_ROR8:
+					va = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(va)));
+					vb = vreinterpretq_u32_u8(vrev32q_u8(vreinterpretq_u8_u32(vb)));
+					va = vorrq_u32(vshrq_n_u32(va, 8), vshlq_n_u32(va, 24));
+					vb = vorrq_u32(vshrq_n_u32(vb, 8), vshlq_n_u32(vb, 24));
+					break;
+
+				case OP_REV16:
+					va = vreinterpretq_u32_u8(vrev16q_u8(vreinterpretq_u8_u32(va)));
+					vb = vreinterpretq_u32_u8(vrev16q_u8(vreinterpretq_u8_u32(vb)));
+					break;
+
+				case OP_G16R16:
+					va = vorrq_u32(vandq_u32(vshrq_n_u32(va, 16), vdupq_n_u32(0x0000FF00)),
+						       vandq_u32(vshlq_n_u32(va,  8), vdupq_n_u32(0x00FF0000)));
+					vb = vorrq_u32(vandq_u32(vshrq_n_u32(vb, 16), vdupq_n_u32(0x0000FF00)),
+						       vandq_u32(vshlq_n_u32(vb,  8), vdupq_n_u32(0x00FF0000)));
+					break;
+			}
+
+			va = vorrq_u32(va, alpha_mask);
+			vb = vorrq_u32(vb, alpha_mask);
+
+			vst1q_u32(&px_dest[0], va);
+			vst1q_u32(&px_dest[4], vb);
+		}
+
+		// Remaining pixels.
+		if (x > 0) {
+		switch (px_format) {
+			case PXF_HOST_xRGB32:
+				// Host-endian XRGB32.
+				// Pixel copy is needed, with alpha channel masking.
+				for (; x > 0; x--) {
+					*px_dest = *img_buf | 0xFF000000;
+					img_buf++;
+					px_dest++;
+				}
+				break;
+
+			case PXF_HOST_RGBA32:
+				// Host-endian RGBA32.
+				// Pixel copy is needed, with shifting.
+				for (; x > 0; x--) {
+					*px_dest = (*img_buf >> 8) | (*img_buf << 24);
+					img_buf++;
+					px_dest++;
+				}
+				break;
+
+			case PXF_HOST_RGBx32:
+				// Host-endian RGBx32.
+				// Pixel copy is needed, with a right shift.
+				for (; x > 0; x--) {
+					*px_dest = (*img_buf >> 8) | 0xFF000000;
+					img_buf++;
+					px_dest++;
+				}
+				break;
+
+			case PXF_SWAP_ARGB32:
+				// Byteswapped ARGB32.
+				// Pixel copy is needed, with byteswapping.
+				for (; x > 0; x--) {
+					*px_dest = __swab32(*img_buf);
+					img_buf++;
+					px_dest++;
+				}
+				break;
+
+			case PXF_SWAP_xRGB32:
+				// Byteswapped XRGB32.
+				// Pixel copy is needed, with byteswapping and alpha channel masking.
+				for (; x > 0; x--) {
+					*px_dest = __swab32(*img_buf) | 0xFF000000;
+					img_buf++;
+					px_dest++;
+				}
+				break;
+
+			case PXF_SWAP_RGBA32:
+				// Byteswapped ABGR32.
+				// Pixel copy is needed, with shifting.
+				for (; x > 0; x--) {
+					const uint32_t px = __swab32(*img_buf);
+					*px_dest = (px >> 8) | (px << 24);
+					img_buf++;
+					px_dest++;
+				}
+				break;
+
+			case PXF_SWAP_RGBx32:
+				// Byteswapped RGBx32.
+				// Pixel copy is needed, with byteswapping and a right shift.
+				for (; x > 0; x--) {
+					*px_dest = (__swab32(*img_buf) >> 8) | 0xFF000000;
+					img_buf++;
+					px_dest++;
+				}
+				break;
+
+			case PXF_G16R16:
+				// G16R16.
+				for (; x > 0; x--) {
+					*px_dest = G16R16_to_ARGB32(le32_to_cpu(*img_buf));
+					img_buf++;
+					px_dest++;
+				}
+				break;
+
+			case PXF_RABG8888:
+				// VTF "ARGB8888", which is actually RABG.
+				for (; x > 0; x--) {
+					const uint32_t px = *img_buf;
+					*px_dest = ((px >> 8) & 0x00FF00FF) | ((px << 8) & 0xFF00FF00);
+					img_buf++;
+					px_dest++;
+				}
+				break;
+
+			default:
+				assert(!"Unsupported 32-bit pixel format.");
+				delete img;
+				return nullptr;
+		} }
+
+		// Next line.
+		img_buf += src_stride_adj;
+		px_dest += dest_stride_adj;
+	}
+
+	// Set the sBIT metadata.
+	if (unlikely(px_format == PXF_G16R16)) {
+		static const rp_image::sBIT_t sBIT_G16R16 = {8,8,1,0,0};
+		img->set_sBIT(&sBIT_G16R16);
+	} else if (has_alpha) {
+		static const rp_image::sBIT_t sBIT_A32 = {8,8,8,0,8};
+		img->set_sBIT(&sBIT_A32);
+	} else {
+		static const rp_image::sBIT_t sBIT_x32 = {8,8,8,0,0};
+		img->set_sBIT(&sBIT_x32);
+	}
+
+	// Image has been converted.
+	return img;
+}
+
+} }
@@ -9,6 +9,8 @@
 #include "stdafx.h"
 #include "ImageDecoder.hpp"
 #include "ImageDecoder_p.hpp"
+#include "DecodeContext.hpp"
+#include "UntileCache.hpp"
 
 #include "PixelConversion.hpp"
 using namespace LibRpTexture::PixelConversion;
@@ -27,59 +29,66 @@ static const uint8_t N3DS_tile_order[] = {
 };
 
 /**
- * Convert a Nintendo 3DS RGB565 tiled icon to rp_image.
+ * Convert a Nintendo 3DS RGB565 tiled icon to rp_image. (internal)
+ * @param img Destination image. (ARGB32, width x height)
  * @param width Image width.
  * @param height Image height.
  * @param img_buf RGB565 tiled image buffer.
  * @param img_siz Size of image data. [must be >= (w*h)*2]
- * @return rp_image, or nullptr on error.
+ * @return 0 on success; non-zero on error.
  */
-rp_image *fromN3DSTiledRGB565(int width, int height,
+static int fromN3DSTiledRGB565_int(rp_image *RESTRICT img, int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz)
 {
 	// Verify parameters.
 	assert(img_buf != nullptr);
-	assert(width > 0);
-	assert(height > 0);
 	assert(img_siz >= ((width * height) * 2));
-	if (!img_buf || width <= 0 || height <= 0 ||
+	if (!img->isValid() || !img_buf ||
 	    img_siz < ((width * height) * 2))
 	{
-		return nullptr;
+		return -1;
 	}
 
 	// N3DS tiled images use 8x8 tiles.
 	assert(width % 8 == 0);
 	assert(height % 8 == 0);
 	if (width % 8 != 0 || height % 8 != 0)
-		return nullptr;
+		return -1;
 
-	// Create an rp_image.
-	rp_image *img = new rp_image(width, height, rp_image::FORMAT_ARGB32);
-	if (!img->isValid()) {
-		// Could not allocate the image.
-		delete img;
-		return nullptr;
-	}
+	// Check for a cached untile table.
+	// Icon-sized images all share the same layout, so repeat
+	// decodes become a single gather/scatter loop.
+	const unsigned int *const untileLUT = getUntileLUT(width, height,
+		static_cast<unsigned int>(img->stride() / sizeof(uint32_t)),
+		8, 8, N3DS_tile_order);
+	if (untileLUT) {
+		// Untile using the lookup table.
+		uint32_t *const px_dest = static_cast<uint32_t*>(img->bits());
+		const unsigned int px_count = static_cast<unsigned int>(width * height);
+		for (unsigned int i = 0; i < px_count; i += 2, img_buf += 2) {
+			px_dest[untileLUT[i+0]] = RGB565_to_ARGB32(le16_to_cpu(img_buf[0]));
+			px_dest[untileLUT[i+1]] = RGB565_to_ARGB32(le16_to_cpu(img_buf[1]));
+		}
+	} else {
+		// Calculate the total number of tiles.
+		const unsigned int tilesX = static_cast<unsigned int>(width / 8);
+		const unsigned int tilesY = static_cast<unsigned int>(height / 8);
 
-	// Calculate the total number of tiles.
-	const unsigned int tilesX = static_cast<unsigned int>(width / 8);
-	const unsigned int tilesY = static_cast<unsigned int>(height / 8);
+		// Temporary tile buffer.
+		uint32_t tileBuf[8*8];
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[8*8];
+		for (unsigned int y = 0; y < tilesY; y++) {
+			for (unsigned int x = 0; x < tilesX; x++) {
+				// Convert each tile to ARGB32 manually.
+				// TODO: Optimize using pointers instead of indexes?
+				for (unsigned int i = 0; i < 8*8; i += 2, img_buf += 2) {
+					tileBuf[N3DS_tile_order[i+0]] = RGB565_to_ARGB32(le16_to_cpu(img_buf[0]));
+					tileBuf[N3DS_tile_order[i+1]] = RGB565_to_ARGB32(le16_to_cpu(img_buf[1]));
+				}
 
-	for (unsigned int y = 0; y < tilesY; y++) {
-		for (unsigned int x = 0; x < tilesX; x++) {
-			// Convert each tile to ARGB32 manually.
-			// TODO: Optimize using pointers instead of indexes?
-			for (unsigned int i = 0; i < 8*8; i += 2, img_buf += 2) {
-				tileBuf[N3DS_tile_order[i+0]] = RGB565_to_ARGB32(le16_to_cpu(img_buf[0]));
-				tileBuf[N3DS_tile_order[i+1]] = RGB565_to_ARGB32(le16_to_cpu(img_buf[1]));
+				// Blit the tile to the main image buffer.
+				ImageDecoderPrivate::BlitTile<uint32_t, 8, 8>(img, tileBuf, x, y);
 			}
-
-			// Blit the tile to the main image buffer.
-			ImageDecoderPrivate::BlitTile<uint32_t, 8, 8>(img, tileBuf, x, y);
 		}
 	}
 
@@ -88,73 +97,131 @@ rp_image *fromN3DSTiledRGB565(int width, int height,
 	img->set_sBIT(&sBIT);
 
 	// Image has been converted.
+	return 0;
+}
+
+/**
+ * Convert a Nintendo 3DS RGB565 tiled icon to rp_image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromN3DSTiledRGB565(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz)
+{
+	assert(width > 0);
+	assert(height > 0);
+	if (width <= 0 || height <= 0) {
+		return nullptr;
+	}
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(width, height, rp_image::FORMAT_ARGB32);
+	if (fromN3DSTiledRGB565_int(img, width, height, img_buf, img_siz) != 0) {
+		delete img;
+		return nullptr;
+	}
 	return img;
 }
 
 /**
- * Convert a Nintendo 3DS RGB565+A4 tiled icon to rp_image.
+ * Convert a Nintendo 3DS RGB565 tiled icon to rp_image.
+ * Reusable context version.
+ * @param ctx Decode context. The context owns the returned image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromN3DSTiledRGB565(DecodeContext &ctx, int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz)
+{
+	// Get a reusable image from the context.
+	rp_image *const img = ctx.reuse(width, height, rp_image::FORMAT_ARGB32);
+	if (!img || fromN3DSTiledRGB565_int(img, width, height, img_buf, img_siz) != 0) {
+		return nullptr;
+	}
+	return img;
+}
+
+/**
+ * Convert a Nintendo 3DS RGB565+A4 tiled icon to rp_image. (internal)
+ * @param img Destination image. (ARGB32, width x height)
  * @param width Image width.
  * @param height Image height.
  * @param img_buf RGB565 tiled image buffer.
  * @param img_siz Size of image data. [must be >= (w*h)*2]
  * @param alpha_buf A4 tiled alpha buffer.
  * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
- * @return rp_image, or nullptr on error.
+ * @return 0 on success; non-zero on error.
  */
-rp_image *fromN3DSTiledRGB565_A4(int width, int height,
+static int fromN3DSTiledRGB565_A4_int(rp_image *RESTRICT img, int width, int height,
 	const uint16_t *RESTRICT img_buf, int img_siz,
 	const uint8_t *RESTRICT alpha_buf, int alpha_siz)
 {
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(alpha_buf != nullptr);
-	assert(width > 0);
-	assert(height > 0);
 	assert(img_siz >= ((width * height) * 2));
 	assert(alpha_siz >= ((width * height) / 2));
-	if (!img_buf || !alpha_buf || width <= 0 || height <= 0 ||
+	if (!img->isValid() || !img_buf || !alpha_buf ||
 	    img_siz < ((width * height) * 2) ||
 	    alpha_siz < ((width * height) / 2))
 	{
-		return nullptr;
+		return -1;
 	}
 
 	// N3DS tiled images use 8x8 tiles.
 	assert(width % 8 == 0);
 	assert(height % 8 == 0);
 	if (width % 8 != 0 || height % 8 != 0)
-		return nullptr;
+		return -1;
 
-	// Calculate the total number of tiles.
-	const unsigned int tilesX = static_cast<unsigned int>(width / 8);
-	const unsigned int tilesY = static_cast<unsigned int>(height / 8);
+	// Check for a cached untile table.
+	// Icon-sized images all share the same layout, so repeat
+	// decodes become a single gather/scatter loop.
+	const unsigned int *const untileLUT = getUntileLUT(width, height,
+		static_cast<unsigned int>(img->stride() / sizeof(uint32_t)),
+		8, 8, N3DS_tile_order);
+	if (untileLUT) {
+		// Untile using the lookup table.
+		// FIXME: Nybble ordering for A4?
+		// Assuming LeftLSN, same as NDS CI4.
+		uint32_t *const px_dest = static_cast<uint32_t*>(img->bits());
+		const unsigned int px_count = static_cast<unsigned int>(width * height);
+		for (unsigned int i = 0; i < px_count; i += 2, img_buf += 2, alpha_buf++) {
+			px_dest[untileLUT[i+0]] = RGB565_A4_to_ARGB32(
+				le16_to_cpu(img_buf[0]), *alpha_buf & 0x0F);
+			px_dest[untileLUT[i+1]] = RGB565_A4_to_ARGB32(
+				le16_to_cpu(img_buf[1]), *alpha_buf >> 4);
+		}
+	} else {
+		// Calculate the total number of tiles.
+		const unsigned int tilesX = static_cast<unsigned int>(width / 8);
+		const unsigned int tilesY = static_cast<unsigned int>(height / 8);
 
-	// Create an rp_image.
-	rp_image *img = new rp_image(width, height, rp_image::FORMAT_ARGB32);
-	if (!img->isValid()) {
-		// Could not allocate the image.
-		delete img;
-		return nullptr;
-	}
+		// Temporary tile buffer.
+		uint32_t tileBuf[8*8];
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[8*8];
-
-	for (unsigned int y = 0; y < tilesY; y++) {
-		for (unsigned int x = 0; x < tilesX; x++) {
-			// Convert each tile to ARGB32 manually.
-			// TODO: Optimize using pointers instead of indexes?
-			// FIXME: Nybble ordering for A4?
-			// Assuming LeftLSN, same as NDS CI4.
-			for (unsigned int i = 0; i < 8*8; i += 2, img_buf += 2, alpha_buf++) {
-				tileBuf[N3DS_tile_order[i+0]] = RGB565_A4_to_ARGB32(
-					le16_to_cpu(img_buf[0]), *alpha_buf & 0x0F);
-				tileBuf[N3DS_tile_order[i+1]] = RGB565_A4_to_ARGB32(
-					le16_to_cpu(img_buf[1]), *alpha_buf >> 4);
-			}
+		for (unsigned int y = 0; y < tilesY; y++) {
+			for (unsigned int x = 0; x < tilesX; x++) {
+				// Convert each tile to ARGB32 manually.
+				// TODO: Optimize using pointers instead of indexes?
+				// FIXME: Nybble ordering for A4?
+				// Assuming LeftLSN, same as NDS CI4.
+				for (unsigned int i = 0; i < 8*8; i += 2, img_buf += 2, alpha_buf++) {
+					tileBuf[N3DS_tile_order[i+0]] = RGB565_A4_to_ARGB32(
+						le16_to_cpu(img_buf[0]), *alpha_buf & 0x0F);
+					tileBuf[N3DS_tile_order[i+1]] = RGB565_A4_to_ARGB32(
+						le16_to_cpu(img_buf[1]), *alpha_buf >> 4);
+				}
 
-			// Blit the tile to the main image buffer.
-			ImageDecoderPrivate::BlitTile<uint32_t, 8, 8>(img, tileBuf, x, y);
+				// Blit the tile to the main image buffer.
+				ImageDecoderPrivate::BlitTile<uint32_t, 8, 8>(img, tileBuf, x, y);
+			}
 		}
 	}
 
@@ -163,7 +230,164 @@ rp_image *fromN3DSTiledRGB565_A4(int width, int height,
 	img->set_sBIT(&sBIT);
 
 	// Image has been converted.
+	return 0;
+}
+
+/**
+ * Convert a Nintendo 3DS RGB565+A4 tiled icon to rp_image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromN3DSTiledRGB565_A4(int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz)
+{
+	assert(width > 0);
+	assert(height > 0);
+	if (width <= 0 || height <= 0) {
+		return nullptr;
+	}
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(width, height, rp_image::FORMAT_ARGB32);
+	if (fromN3DSTiledRGB565_A4_int(img, width, height, img_buf, img_siz, alpha_buf, alpha_siz) != 0) {
+		delete img;
+		return nullptr;
+	}
+	return img;
+}
+
+/**
+ * Convert a Nintendo 3DS RGB565+A4 tiled icon to rp_image.
+ * Reusable context version.
+ * @param ctx Decode context. The context owns the returned image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromN3DSTiledRGB565_A4(DecodeContext &ctx, int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz)
+{
+	// Get a reusable image from the context.
+	rp_image *const img = ctx.reuse(width, height, rp_image::FORMAT_ARGB32);
+	if (!img || fromN3DSTiledRGB565_A4_int(img, width, height, img_buf, img_siz, alpha_buf, alpha_siz) != 0) {
+		return nullptr;
+	}
 	return img;
 }
 
+/**
+ * Convert a Nintendo 3DS RGB565+A4 tiled cell into a larger rp_image.
+ *
+ * The cell is decoded directly into the destination image at (x, y).
+ * All cells with the same dimensions share one untile lookup table,
+ * so composite pages (Mega Badges, badge sheets) decode in a single
+ * pass without a per-cell temporary image and copy.
+ *
+ * NOTE: The caller is responsible for setting the sBIT metadata
+ * on the destination image.
+ *
+ * @param img Destination image. (ARGB32)
+ * @param x Destination X position. [must be a multiple of 8]
+ * @param y Destination Y position. [must be a multiple of 8]
+ * @param width Cell width.
+ * @param height Cell height.
+ * @param img_buf RGB565 tiled image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)*2]
+ * @param alpha_buf A4 tiled alpha buffer.
+ * @param alpha_siz Size of alpha data. [must be >= (w*h)/2]
+ * @return 0 on success; non-zero on error.
+ */
+int fromN3DSTiledRGB565_A4_at(rp_image *RESTRICT img, int x, int y,
+	int width, int height,
+	const uint16_t *RESTRICT img_buf, int img_siz,
+	const uint8_t *RESTRICT alpha_buf, int alpha_siz)
+{
+	// Verify parameters.
+	assert(img != nullptr);
+	assert(img_buf != nullptr);
+	assert(alpha_buf != nullptr);
+	assert(img_siz >= ((width * height) * 2));
+	assert(alpha_siz >= ((width * height) / 2));
+	if (!img || !img->isValid() || !img_buf || !alpha_buf ||
+	    img->format() != rp_image::FORMAT_ARGB32 ||
+	    img_siz < ((width * height) * 2) ||
+	    alpha_siz < ((width * height) / 2))
+	{
+		return -1;
+	}
+
+	// The cell must be tile-aligned and within the image bounds.
+	assert(x % 8 == 0);
+	assert(y % 8 == 0);
+	assert(width % 8 == 0);
+	assert(height % 8 == 0);
+	if (x < 0 || y < 0 ||
+	    (x % 8 != 0) || (y % 8 != 0) ||
+	    (width % 8 != 0) || (height % 8 != 0) ||
+	    (x + width) > img->width() || (y + height) > img->height())
+	{
+		return -1;
+	}
+
+	// Check for a cached untile table.
+	// The table is keyed on the destination stride, so every cell
+	// of the same size within this image shares a single table.
+	const unsigned int stride_px =
+		static_cast<unsigned int>(img->stride() / sizeof(uint32_t));
+	const unsigned int *const untileLUT = getUntileLUT(width, height,
+		stride_px, 8, 8, N3DS_tile_order);
+	if (untileLUT) {
+		// Untile using the lookup table.
+		// FIXME: Nybble ordering for A4?
+		// Assuming LeftLSN, same as NDS CI4.
+		uint32_t *const px_dest = static_cast<uint32_t*>(img->scanLine(y)) + x;
+		const unsigned int px_count = static_cast<unsigned int>(width * height);
+		for (unsigned int i = 0; i < px_count; i += 2, img_buf += 2, alpha_buf++) {
+			px_dest[untileLUT[i+0]] = RGB565_A4_to_ARGB32(
+				le16_to_cpu(img_buf[0]), *alpha_buf & 0x0F);
+			px_dest[untileLUT[i+1]] = RGB565_A4_to_ARGB32(
+				le16_to_cpu(img_buf[1]), *alpha_buf >> 4);
+		}
+	} else {
+		// Cell is too large to cache. Decode tile-by-tile.
+		const unsigned int tilesX = static_cast<unsigned int>(width / 8);
+		const unsigned int tilesY = static_cast<unsigned int>(height / 8);
+		const unsigned int tileX0 = static_cast<unsigned int>(x / 8);
+		const unsigned int tileY0 = static_cast<unsigned int>(y / 8);
+
+		// Temporary tile buffer.
+		uint32_t tileBuf[8*8];
+
+		for (unsigned int ty = 0; ty < tilesY; ty++) {
+			for (unsigned int tx = 0; tx < tilesX; tx++) {
+				// Convert each tile to ARGB32 manually.
+				for (unsigned int i = 0; i < 8*8; i += 2, img_buf += 2, alpha_buf++) {
+					tileBuf[N3DS_tile_order[i+0]] = RGB565_A4_to_ARGB32(
+						le16_to_cpu(img_buf[0]), *alpha_buf & 0x0F);
+					tileBuf[N3DS_tile_order[i+1]] = RGB565_A4_to_ARGB32(
+						le16_to_cpu(img_buf[1]), *alpha_buf >> 4);
+				}
+
+				// Blit the tile to the main image buffer.
+				ImageDecoderPrivate::BlitTile<uint32_t, 8, 8>(img, tileBuf,
+					tileX0 + tx, tileY0 + ty);
+			}
+		}
+	}
+
+	// Cell has been converted.
+	return 0;
+}
+
 } }
@@ -9,6 +9,7 @@
 #include "stdafx.h"
 #include "ImageDecoder.hpp"
 #include "ImageDecoder_p.hpp"
+#include "DecodeContext.hpp"
 
 #include "PixelConversion.hpp"
 using namespace LibRpTexture::PixelConversion;
@@ -16,53 +17,43 @@ using namespace LibRpTexture::PixelConversion;
 namespace LibRpTexture { namespace ImageDecoder {
 
 /**
- * Convert a Nintendo DS CI4 image to rp_image.
+ * Convert a Nintendo DS CI4 image to rp_image. (internal)
+ * @param img Destination image. (CI8, width x height)
  * @param width Image width.
  * @param height Image height.
  * @param img_buf CI4 image buffer.
  * @param img_siz Size of image data. [must be >= (w*h)/2]
  * @param pal_buf Palette buffer.
  * @param pal_siz Size of palette data. [must be >= 16*2]
- * @return rp_image, or nullptr on error.
+ * @return 0 on success; non-zero on error.
  */
-rp_image *fromNDS_CI4(int width, int height,
+static int fromNDS_CI4_int(rp_image *RESTRICT img, int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz,
 	const uint16_t *RESTRICT pal_buf, int pal_siz)
 {
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(pal_buf != nullptr);
-	assert(width > 0);
-	assert(height > 0);
 	assert(img_siz >= ((width * height) / 2));
 	assert(pal_siz >= 16*2);
-	if (!img_buf || !pal_buf || width <= 0 || height <= 0 ||
+	if (!img->isValid() || !img_buf || !pal_buf ||
 	    img_siz < ((width * height) / 2) || pal_siz < 16*2)
 	{
-		return nullptr;
+		return -1;
 	}
 
 	// NDS CI4 uses 8x8 tiles.
 	assert(width % 8 == 0);
 	assert(height % 8 == 0);
 	if (width % 8 != 0 || height % 8 != 0)
-		return nullptr;
-
-	// Create an rp_image.
-	rp_image *img = new rp_image(width, height, rp_image::FORMAT_CI8);
-	if (!img->isValid()) {
-		// Could not allocate the image.
-		delete img;
-		return nullptr;
-	}
+		return -1;
 
 	// Convert the palette.
 	uint32_t *const palette = img->palette();
 	assert(img->palette_len() >= 16);
 	if (img->palette_len() < 16) {
 		// Not enough colors...
-		delete img;
-		return nullptr;
+		return -1;
 	}
 
 	// NOTE: rp_image initializes the palette to 0,
@@ -94,6 +85,59 @@ rp_image *fromNDS_CI4(int width, int height,
 	img->set_sBIT(&sBIT);
 
 	// Image has been converted.
+	return 0;
+}
+
+/**
+ * Convert a Nintendo DS CI4 image to rp_image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf CI4 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @param pal_buf Palette buffer.
+ * @param pal_siz Size of palette data. [must be >= 16*2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromNDS_CI4(int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz,
+	const uint16_t *RESTRICT pal_buf, int pal_siz)
+{
+	assert(width > 0);
+	assert(height > 0);
+	if (width <= 0 || height <= 0) {
+		return nullptr;
+	}
+
+	// Create an rp_image.
+	rp_image *const img = new rp_image(width, height, rp_image::FORMAT_CI8);
+	if (fromNDS_CI4_int(img, width, height, img_buf, img_siz, pal_buf, pal_siz) != 0) {
+		delete img;
+		return nullptr;
+	}
+	return img;
+}
+
+/**
+ * Convert a Nintendo DS CI4 image to rp_image.
+ * Reusable context version.
+ * @param ctx Decode context. The context owns the returned image.
+ * @param width Image width.
+ * @param height Image height.
+ * @param img_buf CI4 image buffer.
+ * @param img_siz Size of image data. [must be >= (w*h)/2]
+ * @param pal_buf Palette buffer.
+ * @param pal_siz Size of palette data. [must be >= 16*2]
+ * @return rp_image, or nullptr on error.
+ */
+rp_image *fromNDS_CI4(DecodeContext &ctx, int width, int height,
+	const uint8_t *RESTRICT img_buf, int img_siz,
+	const uint16_t *RESTRICT pal_buf, int pal_siz)
+{
+	// Get a reusable image from the context.
+	rp_image *const img = ctx.reuse(width, height, rp_image::FORMAT_CI8);
+	if (!img || fromNDS_CI4_int(img, width, height, img_buf, img_siz, pal_buf, pal_siz) != 0) {
+		return nullptr;
+	}
 	return img;
 }
 
@@ -11,6 +11,11 @@
 #include "ImageDecoder.hpp"
 #include "ImageDecoder_p.hpp"
 
+// librpfile
+#include "librpfile/RpStats.hpp"
+namespace RpStats = LibRpFile::RpStats;
+#include "ParallelDecode.hpp"
+
 #include "PixelConversion.hpp"
 using namespace LibRpTexture::PixelConversion;
 
@@ -194,6 +199,7 @@ static inline uint8_t decode_DXT5_alpha_S3TC(unsigned int a3, const uint8_t *RES
 rp_image *fromDXT1_GCN(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_DXTN);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -305,30 +311,39 @@ static rp_image *T_fromDXT1(int width, int height,
 		return nullptr;
 	}
 
-	const dxt1_block *dxt1_src = reinterpret_cast<const dxt1_block*>(img_buf);
-
 	// Calculate the total number of tiles.
 	const unsigned int tilesX = static_cast<unsigned int>(physWidth / 4);
 	const unsigned int tilesY = static_cast<unsigned int>(physHeight / 4);
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[4*4];
+	// Decode a band of tile rows. [rowStart, rowEnd)
+	// Each band writes to a disjoint set of image rows,
+	// so the workers don't need any synchronization.
+	auto decodeRows = [img, img_buf, tilesX](unsigned int rowStart, unsigned int rowEnd) {
+		const dxt1_block *dxt1_src = reinterpret_cast<const dxt1_block*>(img_buf) +
+			(static_cast<size_t>(rowStart) * tilesX);
 
-	for (unsigned int y = 0; y < tilesY; y++) {
-	for (unsigned int x = 0; x < tilesX; x++, dxt1_src++) {
-		// Decode the DXT1 tile palette.
-		argb32_t pal[4];
-		decode_DXTn_tile_color_palette_S3TC<palflags>(pal, dxt1_src);
+		// Temporary tile buffer.
+		uint32_t tileBuf[4*4];
 
-		// Process the 16 color indexes.
-		uint32_t indexes = le32_to_cpu(dxt1_src->indexes);
-		for (unsigned int i = 0; i < 16; i++, indexes >>= 2) {
-			tileBuf[i] = pal[indexes & 3].u32;
-		}
+		for (unsigned int y = rowStart; y < rowEnd; y++) {
+		for (unsigned int x = 0; x < tilesX; x++, dxt1_src++) {
+			// Decode the DXT1 tile palette.
+			argb32_t pal[4];
+			decode_DXTn_tile_color_palette_S3TC<palflags>(pal, dxt1_src);
 
-		// Blit the tile to the main image buffer.
-		ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-	} }
+			// Process the 16 color indexes.
+			uint32_t indexes = le32_to_cpu(dxt1_src->indexes);
+			for (unsigned int i = 0; i < 16; i++, indexes >>= 2) {
+				tileBuf[i] = pal[indexes & 3].u32;
+			}
+
+			// Blit the tile to the main image buffer.
+			ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
+		} }
+	};
+
+	// Decode the tiles. Large textures are split across threads.
+	parallelTileRows(tilesY, 64, decodeRows);
 
 	if (width < physWidth || height < physHeight) {
 		// Shrink the image.
@@ -356,6 +371,7 @@ static rp_image *T_fromDXT1(int width, int height,
 rp_image *fromDXT1(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_DXTN);
 	return T_fromDXT1<0>(width, height, img_buf, img_siz);
 }
 
@@ -372,6 +388,7 @@ rp_image *fromDXT1(int width, int height,
 rp_image *fromDXT1_A1(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_DXTN);
 	return T_fromDXT1<DXTn_PALETTE_COLOR3_ALPHA>(width, height, img_buf, img_siz);
 }
 
@@ -415,6 +432,7 @@ rp_image *fromDXT2(int width, int height,
 rp_image *fromDXT3(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_DXTN);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -447,37 +465,45 @@ rp_image *fromDXT3(int width, int height,
 		dxt1_block colors;	// DXT1-style color block.
 	};
 	ASSERT_STRUCT(dxt3_block, 16);
-	const dxt3_block *dxt3_src = reinterpret_cast<const dxt3_block*>(img_buf);
 
 	// Calculate the total number of tiles.
 	const unsigned int tilesX = static_cast<unsigned int>(physWidth / 4);
 	const unsigned int tilesY = static_cast<unsigned int>(physHeight / 4);
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[4*4];
+	// Decode a band of tile rows. [rowStart, rowEnd)
+	auto decodeRows = [img, img_buf, tilesX](unsigned int rowStart, unsigned int rowEnd) {
+		const dxt3_block *dxt3_src = reinterpret_cast<const dxt3_block*>(img_buf) +
+			(static_cast<size_t>(rowStart) * tilesX);
 
-	for (unsigned int y = 0; y < tilesY; y++) {
-	for (unsigned int x = 0; x < tilesX; x++, dxt3_src++) {
-		// Decode the DXT3 tile palette.
-		argb32_t pal[4];
-		// FIXME: DXTn_PALETTE_COLOR0_LE_COLOR1 seems to result in garbage pixels.
-		// https://github.com/kchapelier/decode-dxt/tree/master/lib has similar code
-		// but handles DXT3 like both DXT1 and DXT5, so disable this for now.
-		decode_DXTn_tile_color_palette_S3TC<0/*DXTn_PALETTE_COLOR0_LE_COLOR1*/>(pal, &dxt3_src->colors);
-
-		// Process the 16 color indexes and apply alpha.
-		uint32_t indexes = le32_to_cpu(dxt3_src->colors.indexes);
-		uint64_t alpha = le64_to_cpu(dxt3_src->alpha);
-		for (unsigned int i = 0; i < 16; i++, indexes >>= 2, alpha >>= 4) {
-			argb32_t color = pal[indexes & 3];
-			// TODO: Verify alpha value handling for DXT3.
-			color.a = (alpha & 0xF) | ((alpha & 0xF) << 4);
-			tileBuf[i] = color.u32;
-		}
+		// Temporary tile buffer.
+		uint32_t tileBuf[4*4];
 
-		// Blit the tile to the main image buffer.
-		ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-	} }
+		for (unsigned int y = rowStart; y < rowEnd; y++) {
+		for (unsigned int x = 0; x < tilesX; x++, dxt3_src++) {
+			// Decode the DXT3 tile palette.
+			argb32_t pal[4];
+			// FIXME: DXTn_PALETTE_COLOR0_LE_COLOR1 seems to result in garbage pixels.
+			// https://github.com/kchapelier/decode-dxt/tree/master/lib has similar code
+			// but handles DXT3 like both DXT1 and DXT5, so disable this for now.
+			decode_DXTn_tile_color_palette_S3TC<0/*DXTn_PALETTE_COLOR0_LE_COLOR1*/>(pal, &dxt3_src->colors);
+
+			// Process the 16 color indexes and apply alpha.
+			uint32_t indexes = le32_to_cpu(dxt3_src->colors.indexes);
+			uint64_t alpha = le64_to_cpu(dxt3_src->alpha);
+			for (unsigned int i = 0; i < 16; i++, indexes >>= 2, alpha >>= 4) {
+				argb32_t color = pal[indexes & 3];
+				// TODO: Verify alpha value handling for DXT3.
+				color.a = (alpha & 0xF) | ((alpha & 0xF) << 4);
+				tileBuf[i] = color.u32;
+			}
+
+			// Blit the tile to the main image buffer.
+			ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
+		} }
+	};
+
+	// Decode the tiles. Large textures are split across threads.
+	parallelTileRows(tilesY, 64, decodeRows);
 
 	if (width < physWidth || height < physHeight) {
 		// Shrink the image.
@@ -532,6 +558,7 @@ rp_image *fromDXT4(int width, int height,
 rp_image *fromDXT5(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_DXTN);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -564,36 +591,44 @@ rp_image *fromDXT5(int width, int height,
 		dxt1_block colors;	// DXT1-style color block.
 	};
 	ASSERT_STRUCT(dxt5_block, 16);
-	const dxt5_block *dxt5_src = reinterpret_cast<const dxt5_block*>(img_buf);
 
 	// Calculate the total number of tiles.
 	const unsigned int tilesX = static_cast<unsigned int>(physWidth / 4);
 	const unsigned int tilesY = static_cast<unsigned int>(physHeight / 4);
 
-	// Temporary tile buffer.
-	uint32_t tileBuf[4*4];
+	// Decode a band of tile rows. [rowStart, rowEnd)
+	auto decodeRows = [img, img_buf, tilesX](unsigned int rowStart, unsigned int rowEnd) {
+		const dxt5_block *dxt5_src = reinterpret_cast<const dxt5_block*>(img_buf) +
+			(static_cast<size_t>(rowStart) * tilesX);
 
-	for (unsigned int y = 0; y < tilesY; y++) {
-	for (unsigned int x = 0; x < tilesX; x++, dxt5_src++) {
-		// Decode the DXT5 tile palette.
-		argb32_t pal[4];
-		decode_DXTn_tile_color_palette_S3TC<0>(pal, &dxt5_src->colors);
-
-		// Get the DXT5 alpha codes.
-		uint64_t alpha48 = extract48(&dxt5_src->alpha);
-
-		// Process the 16 color and alpha indexes.
-		uint32_t indexes = le32_to_cpu(dxt5_src->colors.indexes);
-		for (unsigned int i = 0; i < 16; i++, indexes >>= 2, alpha48 >>= 3) {
-			argb32_t color = pal[indexes & 3];
-			// Decode the alpha channel value.
-			color.a = decode_DXT5_alpha_S3TC(alpha48 & 7, dxt5_src->alpha.values);
-			tileBuf[i] = color.u32;
-		}
+		// Temporary tile buffer.
+		uint32_t tileBuf[4*4];
 
-		// Blit the tile to the main image buffer.
-		ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
-	} }
+		for (unsigned int y = rowStart; y < rowEnd; y++) {
+		for (unsigned int x = 0; x < tilesX; x++, dxt5_src++) {
+			// Decode the DXT5 tile palette.
+			argb32_t pal[4];
+			decode_DXTn_tile_color_palette_S3TC<0>(pal, &dxt5_src->colors);
+
+			// Get the DXT5 alpha codes.
+			uint64_t alpha48 = extract48(&dxt5_src->alpha);
+
+			// Process the 16 color and alpha indexes.
+			uint32_t indexes = le32_to_cpu(dxt5_src->colors.indexes);
+			for (unsigned int i = 0; i < 16; i++, indexes >>= 2, alpha48 >>= 3) {
+				argb32_t color = pal[indexes & 3];
+				// Decode the alpha channel value.
+				color.a = decode_DXT5_alpha_S3TC(alpha48 & 7, dxt5_src->alpha.values);
+				tileBuf[i] = color.u32;
+			}
+
+			// Blit the tile to the main image buffer.
+			ImageDecoderPrivate::BlitTile<uint32_t, 4, 4>(img, tileBuf, x, y);
+		} }
+	};
+
+	// Decode the tiles. Large textures are split across threads.
+	parallelTileRows(tilesY, 64, decodeRows);
 
 	if (width < physWidth || height < physHeight) {
 		// Shrink the image.
@@ -619,6 +654,7 @@ rp_image *fromDXT5(int width, int height,
 rp_image *fromBC4(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_DXTN);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
@@ -707,6 +743,7 @@ rp_image *fromBC4(int width, int height,
 rp_image *fromBC5(int width, int height,
 	const uint8_t *RESTRICT img_buf, int img_siz)
 {
+	RpStats::increment(RpStats::CTR_IMGDEC_DXTN);
 	// Verify parameters.
 	assert(img_buf != nullptr);
 	assert(width > 0);
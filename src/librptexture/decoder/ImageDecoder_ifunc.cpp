@@ -57,6 +57,11 @@ static __typeof__(&ImageDecoder::fromLinear24_cpp) fromLinear24_resolve(void)
  */
 static __typeof__(&ImageDecoder::fromLinear32_cpp) fromLinear32_resolve(void)
 {
+#ifdef IMAGEDECODER_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return &ImageDecoder::fromLinear32_avx2;
+	} else
+#endif /* IMAGEDECODER_HAS_AVX2 */
 #ifdef IMAGEDECODER_HAS_SSSE3
 	if (RP_CPU_HasSSSE3()) {
 		return &ImageDecoder::fromLinear32_ssse3;
@@ -0,0 +1,91 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ParallelDecode.cpp: Multi-threaded texture decoding helper.             *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ParallelDecode.hpp"
+
+// librpthreads
+#include "librpthreads/ThreadPool.hpp"
+using LibRpBase::ThreadPool;
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+// Maximum number of worker threads.
+// Texture decoding is memory-bound, so more threads
+// than this shows diminishing returns.
+static const unsigned int PARALLEL_DECODE_MAX_THREADS = 8;
+
+/**
+ * Run a tile decoding function across multiple threads.
+ *
+ * The decode function is called with a half-open range of tile rows,
+ * [rowStart, rowEnd). Each worker gets a contiguous band of rows, so
+ * block-compressed formats with independent blocks (BC7, S3TC, ETC1,
+ * PVRTC) can decode bands concurrently as long as the function only
+ * writes to the output rows in its band.
+ *
+ * If the image is too small to be worth splitting, or only one
+ * hardware thread is available, the function is called once on the
+ * calling thread.
+ *
+ * @param tileRows		[in] Total number of tile rows.
+ * @param minRowsPerThread	[in] Minimum tile rows per thread. (Used to limit thread count for small images.)
+ * @param fn			[in] Decode function. Called as fn(rowStart, rowEnd).
+ */
+void parallelTileRows(unsigned int tileRows, unsigned int minRowsPerThread,
+	const std::function<void(unsigned int rowStart, unsigned int rowEnd)> &fn)
+{
+	if (tileRows == 0) {
+		// Nothing to decode.
+		return;
+	}
+
+	// Determine the number of bands.
+	// The shared thread pool runs (nThreads - 1) bands;
+	// the last band runs on the calling thread.
+	ThreadPool *const pool = ThreadPool::instance();
+	unsigned int nThreads = pool->threadCount() + 1;
+	if (nThreads > PARALLEL_DECODE_MAX_THREADS) {
+		nThreads = PARALLEL_DECODE_MAX_THREADS;
+	}
+	if (minRowsPerThread > 0 && nThreads > (tileRows / minRowsPerThread)) {
+		// Not enough rows to give every thread a full band.
+		nThreads = tileRows / minRowsPerThread;
+	}
+
+	if (nThreads <= 1) {
+		// Single-threaded decode.
+		fn(0, tileRows);
+		return;
+	}
+
+	// Split the rows into even bands. The first (tileRows % nThreads)
+	// bands get one extra row.
+	ThreadPool::TaskSet taskSet;
+	const unsigned int bandSize = tileRows / nThreads;
+	const unsigned int extraRows = tileRows % nThreads;
+
+	unsigned int rowStart = 0;
+	for (unsigned int i = 0; i < nThreads; i++) {
+		const unsigned int rowEnd = rowStart + bandSize + (i < extraRows ? 1 : 0);
+		if (i == nThreads - 1) {
+			// Run the last band on the calling thread.
+			fn(rowStart, rowEnd);
+		} else {
+			taskSet.submit([&fn, rowStart, rowEnd]() {
+				fn(rowStart, rowEnd);
+			});
+		}
+		rowStart = rowEnd;
+	}
+
+	// Wait for the pooled bands to finish.
+	taskSet.wait();
+}
+
+} }
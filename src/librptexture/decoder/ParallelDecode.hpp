@@ -0,0 +1,39 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ParallelDecode.hpp: Multi-threaded texture decoding helper.             *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTEXTURE_DECODER_PARALLELDECODE_HPP__
+#define __ROMPROPERTIES_LIBRPTEXTURE_DECODER_PARALLELDECODE_HPP__
+
+// C++ includes.
+#include <functional>
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+/**
+ * Run a tile decoding function across multiple threads.
+ *
+ * The decode function is called with a half-open range of tile rows,
+ * [rowStart, rowEnd). Each worker gets a contiguous band of rows, so
+ * block-compressed formats with independent blocks (BC7, S3TC, ETC1,
+ * PVRTC) can decode bands concurrently as long as the function only
+ * writes to the output rows in its band.
+ *
+ * If the image is too small to be worth splitting, or only one
+ * hardware thread is available, the function is called once on the
+ * calling thread.
+ *
+ * @param tileRows		[in] Total number of tile rows.
+ * @param minRowsPerThread	[in] Minimum tile rows per thread. (Used to limit thread count for small images.)
+ * @param fn			[in] Decode function. Called as fn(rowStart, rowEnd).
+ */
+void parallelTileRows(unsigned int tileRows, unsigned int minRowsPerThread,
+	const std::function<void(unsigned int rowStart, unsigned int rowEnd)> &fn);
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPTEXTURE_DECODER_PARALLELDECODE_HPP__ */
@@ -0,0 +1,146 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * UntileCache.cpp: Shared cache of untile lookup tables.                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "UntileCache.hpp"
+
+// librpthreads
+#include "librpthreads/Mutex.hpp"
+using LibRpBase::Mutex;
+using LibRpBase::MutexLocker;
+
+// C++ STL classes.
+#include <map>
+using std::map;
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+// Maximum image size (in elements) eligible for caching.
+// Larger images are usually decoded only once, so caching
+// their tables would just waste memory. (128x128)
+static const unsigned int UNTILE_CACHE_MAX_ELEMENTS = 128*128;
+
+// Maximum number of cached tables.
+// NOTE: Cached tables are never evicted, since callers may
+// still be using them. Once the cache is full, additional
+// layouts fall back to non-LUT decoding.
+static const size_t UNTILE_CACHE_MAX_TABLES = 16;
+
+// Cache key.
+// NOTE: tileOrder tables are static data, so the pointer
+// itself can be used as part of the key.
+struct UntileCacheKey {
+	unsigned int width;
+	unsigned int height;
+	unsigned int destRowPx;
+	unsigned int tileW;
+	unsigned int tileH;
+	const uint8_t *tileOrder;
+
+	bool operator<(const UntileCacheKey &other) const
+	{
+		if (width != other.width)		return width < other.width;
+		if (height != other.height)		return height < other.height;
+		if (destRowPx != other.destRowPx)	return destRowPx < other.destRowPx;
+		if (tileW != other.tileW)		return tileW < other.tileW;
+		if (tileH != other.tileH)		return tileH < other.tileH;
+		return tileOrder < other.tileOrder;
+	}
+};
+
+// Untile table cache.
+static Mutex untile_cache_mutex;
+static map<UntileCacheKey, ao::uvector<unsigned int> > untile_cache;
+
+/**
+ * Get an untile lookup table for the specified image layout.
+ *
+ * The table has (width * height) entries, one per source element in
+ * storage order: lut[i] is the destination element index for the i'th
+ * source element, so a tiled image can be decoded with a single loop
+ * instead of per-tile buffering and blitting.
+ *
+ * The layout only depends on the image dimensions and tile format,
+ * which repeat constantly for icon-sized images, so generated tables
+ * are kept in a small shared cache. The returned table is owned by
+ * the cache and remains valid for the lifetime of the process.
+ *
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param destRowPx	[in] Destination row width, in elements. (including padding)
+ * @param tileW		[in] Tile width.
+ * @param tileH		[in] Tile height.
+ * @param tileOrder	[in,opt] In-tile ordering table with (tileW * tileH)
+ *                       entries, e.g. Z-order. If nullptr, tiles are
+ *                       assumed to be stored in row-major order.
+ * @return Untile lookup table, or nullptr if the image is too large to cache.
+ */
+const unsigned int *getUntileLUT(unsigned int width, unsigned int height,
+	unsigned int destRowPx, unsigned int tileW, unsigned int tileH,
+	const uint8_t *tileOrder)
+{
+	assert(width > 0);
+	assert(height > 0);
+	assert(destRowPx >= width);
+	assert(tileW > 0);
+	assert(tileH > 0);
+	assert(width % tileW == 0);
+	assert(height % tileH == 0);
+	if (width == 0 || height == 0 || destRowPx < width ||
+	    tileW == 0 || tileH == 0 ||
+	    width % tileW != 0 || height % tileH != 0)
+	{
+		// Invalid layout.
+		return nullptr;
+	}
+
+	if ((width * height) > UNTILE_CACHE_MAX_ELEMENTS) {
+		// Image is too large to cache.
+		return nullptr;
+	}
+
+	const UntileCacheKey key = {width, height, destRowPx, tileW, tileH, tileOrder};
+
+	MutexLocker lock(untile_cache_mutex);
+	auto iter = untile_cache.find(key);
+	if (iter != untile_cache.end()) {
+		// Table is already cached.
+		return iter->second.data();
+	}
+
+	if (untile_cache.size() >= UNTILE_CACHE_MAX_TABLES) {
+		// Cache is full. Tables can't be evicted, since
+		// callers may still be using them, so this layout
+		// has to be decoded without a LUT.
+		return nullptr;
+	}
+
+	// Generate the table.
+	ao::uvector<unsigned int> lut;
+	lut.resize(width * height);
+
+	const unsigned int tilesX = width / tileW;
+	const unsigned int tilesY = height / tileH;
+	const unsigned int tileSize = tileW * tileH;
+
+	unsigned int *p = lut.data();
+	for (unsigned int ty = 0; ty < tilesY; ty++) {
+		for (unsigned int tx = 0; tx < tilesX; tx++) {
+			const unsigned int tileTopLeft = (ty * tileH * destRowPx) + (tx * tileW);
+			for (unsigned int i = 0; i < tileSize; i++) {
+				const unsigned int pos = (tileOrder ? tileOrder[i] : i);
+				*p++ = tileTopLeft + ((pos / tileW) * destRowPx) + (pos % tileW);
+			}
+		}
+	}
+
+	auto ins = untile_cache.emplace(key, std::move(lut));
+	return ins.first->second.data();
+}
+
+} }
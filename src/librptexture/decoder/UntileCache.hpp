@@ -0,0 +1,46 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * UntileCache.hpp: Shared cache of untile lookup tables.                  *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTEXTURE_DECODER_UNTILECACHE_HPP__
+#define __ROMPROPERTIES_LIBRPTEXTURE_DECODER_UNTILECACHE_HPP__
+
+// C includes. (C++ namespace)
+#include <stdint.h>
+
+namespace LibRpTexture { namespace ImageDecoder {
+
+/**
+ * Get an untile lookup table for the specified image layout.
+ *
+ * The table has (width * height) entries, one per source element in
+ * storage order: lut[i] is the destination element index for the i'th
+ * source element, so a tiled image can be decoded with a single loop
+ * instead of per-tile buffering and blitting.
+ *
+ * The layout only depends on the image dimensions and tile format,
+ * which repeat constantly for icon-sized images, so generated tables
+ * are kept in a small shared cache. The returned table is owned by
+ * the cache and remains valid for the lifetime of the process.
+ *
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param destRowPx	[in] Destination row width, in elements. (including padding)
+ * @param tileW		[in] Tile width.
+ * @param tileH		[in] Tile height.
+ * @param tileOrder	[in,opt] In-tile ordering table with (tileW * tileH)
+ *                       entries, e.g. Z-order. If nullptr, tiles are
+ *                       assumed to be stored in row-major order.
+ * @return Untile lookup table, or nullptr if the image is too large to cache.
+ */
+const unsigned int *getUntileLUT(unsigned int width, unsigned int height,
+	unsigned int destRowPx, unsigned int tileW, unsigned int tileH,
+	const uint8_t *tileOrder = nullptr);
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPTEXTURE_DECODER_UNTILECACHE_HPP__ */
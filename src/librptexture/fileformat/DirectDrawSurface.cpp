@@ -59,6 +59,30 @@ class DirectDrawSurfacePrivate : public FileFormatPrivate
 		// due to various bit specifications.
 		char pixel_format[32];
 
+		/**
+		 * Decode a texture data buffer using the detected pixel format.
+		 * @param width		[in] Image width.
+		 * @param height	[in] Image height.
+		 * @param buf		[in] Texture data.
+		 * @param siz		[in] Size of texture data.
+		 * @param stride	[in] Line stride, in bytes. (Uncompressed formats only)
+		 * @return Decoded image, or nullptr on error.
+		 */
+		rp_image *decodeBuffer(int width, int height,
+			const uint8_t *buf, uint32_t siz, unsigned int stride);
+
+		/**
+		 * Load a subsampled version of the image.
+		 *
+		 * Decodes every (1 << subsample)th pixel in both dimensions
+		 * using small per-band decodes, which bounds both decode time
+		 * and memory usage for very large textures.
+		 *
+		 * @param subsample Subsample shift. (must be > 0)
+		 * @return Image, or nullptr on error.
+		 */
+		const rp_image *loadImageSubsampled(unsigned int subsample);
+
 		/**
 		 * Load the image.
 		 * @return Image, or nullptr on error.
@@ -490,6 +514,343 @@ DirectDrawSurfacePrivate::~DirectDrawSurfacePrivate()
 	delete img;
 }
 
+/**
+ * Decode a texture data buffer using the detected pixel format.
+ * @param width		[in] Image width.
+ * @param height	[in] Image height.
+ * @param buf		[in] Texture data.
+ * @param siz		[in] Size of texture data.
+ * @param stride	[in] Line stride, in bytes. (Uncompressed formats only)
+ * @return Decoded image, or nullptr on error.
+ */
+rp_image *DirectDrawSurfacePrivate::decodeBuffer(int width, int height,
+	const uint8_t *buf, uint32_t siz, unsigned int stride)
+{
+	rp_image *img = nullptr;
+	if (dxgi_format != 0) {
+		// Compressed RGB data.
+		// TODO: Handle typeless, signed, sRGB, float.
+		switch (dxgi_format) {
+			case DXGI_FORMAT_BC1_TYPELESS:
+			case DXGI_FORMAT_BC1_UNORM:
+			case DXGI_FORMAT_BC1_UNORM_SRGB:
+				if (likely(dxgi_alpha != DDS_ALPHA_MODE_OPAQUE)) {
+					// 1-bit alpha.
+					img = ImageDecoder::fromDXT1_A1(
+						width, height, buf, siz);
+				} else {
+					// No alpha channel.
+					img = ImageDecoder::fromDXT1(
+						width, height, buf, siz);
+				}
+				break;
+
+			case DXGI_FORMAT_BC2_TYPELESS:
+			case DXGI_FORMAT_BC2_UNORM:
+			case DXGI_FORMAT_BC2_UNORM_SRGB:
+				if (likely(dxgi_alpha != DDS_ALPHA_MODE_PREMULTIPLIED)) {
+					// Standard alpha: DXT3
+					img = ImageDecoder::fromDXT3(
+						width, height, buf, siz);
+				} else {
+					// Premultiplied alpha: DXT2
+					img = ImageDecoder::fromDXT2(
+						width, height, buf, siz);
+				}
+				break;
+
+			case DXGI_FORMAT_BC3_TYPELESS:
+			case DXGI_FORMAT_BC3_UNORM:
+			case DXGI_FORMAT_BC3_UNORM_SRGB:
+				if (likely(dxgi_alpha != DDS_ALPHA_MODE_PREMULTIPLIED)) {
+					// Standard alpha: DXT5
+					img = ImageDecoder::fromDXT5(
+						width, height, buf, siz);
+				} else {
+					// Premultiplied alpha: DXT4
+					img = ImageDecoder::fromDXT4(
+						width, height, buf, siz);
+				}
+				break;
+
+			case DXGI_FORMAT_BC4_TYPELESS:
+			case DXGI_FORMAT_BC4_UNORM:
+			case DXGI_FORMAT_BC4_SNORM:
+				img = ImageDecoder::fromBC4(
+					width, height, buf, siz);
+				break;
+
+			case DXGI_FORMAT_BC5_TYPELESS:
+			case DXGI_FORMAT_BC5_UNORM:
+			case DXGI_FORMAT_BC5_SNORM:
+				img = ImageDecoder::fromBC5(
+					width, height, buf, siz);
+				break;
+
+			case DXGI_FORMAT_BC7_TYPELESS:
+			case DXGI_FORMAT_BC7_UNORM:
+			case DXGI_FORMAT_BC7_UNORM_SRGB:
+				img = ImageDecoder::fromBC7(
+					width, height, buf, siz);
+				break;
+
+#ifdef ENABLE_PVRTC
+			case DXGI_FORMAT_FAKE_PVRTC_2bpp:
+				// PVRTC, 2bpp, has alpha.
+				img = ImageDecoder::fromPVRTC(
+					width, height, buf, siz,
+					ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
+				break;
+
+			case DXGI_FORMAT_FAKE_PVRTC_4bpp:
+				// PVRTC, 4bpp, has alpha.
+				img = ImageDecoder::fromPVRTC(
+					width, height, buf, siz,
+					ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
+				break;
+#endif /* ENABLE_PVRTC */
+
+			case DXGI_FORMAT_R9G9B9E5_SHAREDEXP:
+				// RGB9_E5 (technically uncompressed...)
+				img = ImageDecoder::fromLinear32(
+					ImageDecoder::PXF_RGB9_E5,
+					width, height,
+					reinterpret_cast<const uint32_t*>(buf),
+					siz, stride);
+				break;
+
+			default:
+				// Not supported.
+				break;
+		}
+	} else {
+		// Uncompressed linear image data.
+		switch (bytespp) {
+			case sizeof(uint8_t):
+				// 8-bit image. (Usually luminance or alpha.)
+				img = ImageDecoder::fromLinear8(
+					(ImageDecoder::PixelFormat)pxf_uncomp,
+					width, height, buf, siz, stride);
+				break;
+
+			case sizeof(uint16_t):
+				// 16-bit RGB image.
+				img = ImageDecoder::fromLinear16(
+					(ImageDecoder::PixelFormat)pxf_uncomp,
+					width, height,
+					reinterpret_cast<const uint16_t*>(buf),
+					siz, stride);
+				break;
+
+			case 24/8:
+				// 24-bit RGB image.
+				img = ImageDecoder::fromLinear24(
+					(ImageDecoder::PixelFormat)pxf_uncomp,
+					width, height, buf, siz, stride);
+				break;
+
+			case sizeof(uint32_t):
+				// 32-bit RGB image.
+				img = ImageDecoder::fromLinear32(
+					(ImageDecoder::PixelFormat)pxf_uncomp,
+					width, height,
+					reinterpret_cast<const uint32_t*>(buf),
+					siz, stride);
+				break;
+
+			default:
+				// TODO: Implement other formats.
+				assert(!"Unsupported pixel format.");
+				break;
+		}
+	}
+
+	return img;
+}
+
+/**
+ * Load a subsampled version of the image.
+ *
+ * Decodes every (1 << subsample)th pixel in both dimensions
+ * using small per-band decodes, which bounds both decode time
+ * and memory usage for very large textures.
+ *
+ * @param subsample Subsample shift. (must be > 0)
+ * @return Image, or nullptr on error.
+ */
+const rp_image *DirectDrawSurfacePrivate::loadImageSubsampled(unsigned int subsample)
+{
+	assert(subsample > 0);
+	const unsigned int f = 1U << subsample;
+
+	const int width = static_cast<int>(ddsHeader.dwWidth);
+	const int height = static_cast<int>(ddsHeader.dwHeight);
+	int out_width = width >> subsample;
+	int out_height = height >> subsample;
+	if (out_width <= 0) {
+		out_width = 1;
+	}
+	if (out_height <= 0) {
+		out_height = 1;
+	}
+
+	// Determine the band geometry.
+	// Compressed formats are decoded one tile row at a time;
+	// uncompressed formats are decoded one scanline at a time.
+	unsigned int band_height, band_bytes;
+	unsigned int stride = 0;
+	if (dxgi_format != 0) {
+		unsigned int bytes_per_tile;
+		switch (dxgi_format) {
+			case DXGI_FORMAT_BC1_TYPELESS:
+			case DXGI_FORMAT_BC1_UNORM:
+			case DXGI_FORMAT_BC1_UNORM_SRGB:
+			case DXGI_FORMAT_BC4_TYPELESS:
+			case DXGI_FORMAT_BC4_UNORM:
+			case DXGI_FORMAT_BC4_SNORM:
+				// 16 pixels compressed into 64 bits. (4bpp)
+				bytes_per_tile = 8;
+				break;
+
+			case DXGI_FORMAT_BC2_TYPELESS:
+			case DXGI_FORMAT_BC2_UNORM:
+			case DXGI_FORMAT_BC2_UNORM_SRGB:
+			case DXGI_FORMAT_BC3_TYPELESS:
+			case DXGI_FORMAT_BC3_UNORM:
+			case DXGI_FORMAT_BC3_UNORM_SRGB:
+			case DXGI_FORMAT_BC5_TYPELESS:
+			case DXGI_FORMAT_BC5_UNORM:
+			case DXGI_FORMAT_BC5_SNORM:
+			case DXGI_FORMAT_BC7_TYPELESS:
+			case DXGI_FORMAT_BC7_UNORM:
+			case DXGI_FORMAT_BC7_UNORM_SRGB:
+				// 16 pixels compressed into 128 bits. (8bpp)
+				bytes_per_tile = 16;
+				break;
+
+			case DXGI_FORMAT_R9G9B9E5_SHAREDEXP:
+				// Uncompressed "special" 32bpp format.
+				bytes_per_tile = 0;
+				break;
+
+			default:
+				// PVRTC and other non-linear layouts
+				// can't be decoded in bands.
+				return nullptr;
+		}
+
+		if (bytes_per_tile != 0) {
+			// 4x4 tiles.
+			band_height = 4;
+			band_bytes = (ALIGN_BYTES(4, static_cast<unsigned int>(width)) / 4) * bytes_per_tile;
+		} else {
+			band_height = 1;
+			stride = width * 4;
+			band_bytes = stride;
+		}
+	} else {
+		// Uncompressed linear image data.
+		assert(pxf_uncomp != 0);
+		assert(bytespp != 0);
+		if (pxf_uncomp == 0 || bytespp == 0) {
+			// Pixel format wasn't updated...
+			return nullptr;
+		}
+
+		// If DDSD_LINEARSIZE is set, the field is linear size,
+		// so it needs to be divided by the image height.
+		if (ddsHeader.dwFlags & DDSD_LINEARSIZE) {
+			if (ddsHeader.dwHeight != 0) {
+				stride = ddsHeader.dwPitchOrLinearSize / ddsHeader.dwHeight;
+			}
+		} else {
+			stride = ddsHeader.dwPitchOrLinearSize;
+		}
+		if (stride == 0) {
+			// Invalid stride. Assume stride == width * bytespp.
+			stride = ddsHeader.dwWidth * bytespp;
+		} else if (stride > (ddsHeader.dwWidth * 16)) {
+			// Stride is too large.
+			return nullptr;
+		}
+
+		band_height = 1;
+		band_bytes = stride;
+	}
+
+	// Verify the file size.
+	const unsigned int total_bands =
+		(static_cast<unsigned int>(height) + band_height - 1) / band_height;
+	if (texDataStartAddr + (static_cast<off64_t>(total_bands) * band_bytes) > file->size()) {
+		// File is too small.
+		return nullptr;
+	}
+
+	rp_image *const outImg = new rp_image(out_width, out_height, rp_image::FORMAT_ARGB32);
+	if (!outImg->isValid()) {
+		// Could not allocate the image.
+		delete outImg;
+		return nullptr;
+	}
+
+	// Decode the sampled rows, one band at a time.
+	auto bandBuf = aligned_uptr<uint8_t>(16, band_bytes);
+	rp_image *bandImg = nullptr;
+	int last_band = -1;
+	bool decodeError = false;
+	for (int ky = 0; ky < out_height; ky++) {
+		const unsigned int y = static_cast<unsigned int>(ky) * f;
+		const int band = static_cast<int>(y / band_height);
+		if (band != last_band) {
+			delete bandImg;
+			bandImg = nullptr;
+
+			const off64_t band_addr = texDataStartAddr +
+				(static_cast<off64_t>(band) * band_bytes);
+			size_t size = file->seekAndRead(band_addr, bandBuf.get(), band_bytes);
+			if (size != band_bytes) {
+				// Read error.
+				decodeError = true;
+				break;
+			}
+
+			bandImg = decodeBuffer(width, band_height, bandBuf.get(), band_bytes, stride);
+			if (!bandImg || bandImg->format() != rp_image::FORMAT_ARGB32) {
+				// Unable to decode the band.
+				decodeError = true;
+				break;
+			}
+			last_band = band;
+		}
+
+		// Copy every f'th pixel of the sampled row.
+		const uint32_t *const src_row = static_cast<const uint32_t*>(
+			bandImg->scanLine(static_cast<int>(y % band_height)));
+		uint32_t *const dest_row = static_cast<uint32_t*>(outImg->scanLine(ky));
+		for (int kx = 0; kx < out_width; kx++) {
+			dest_row[kx] = src_row[kx * f];
+		}
+	}
+
+	if (decodeError) {
+		delete bandImg;
+		delete outImg;
+		return nullptr;
+	}
+
+	// Copy the sBIT metadata from the last decoded band.
+	if (bandImg) {
+		rp_image::sBIT_t sBIT;
+		if (bandImg->get_sBIT(&sBIT) == 0) {
+			outImg->set_sBIT(&sBIT);
+		}
+	}
+	delete bandImg;
+
+	img = outImg;
+	return img;
+}
+
 /**
  * Load the image.
  * @return Image, or nullptr on error.
@@ -531,6 +892,28 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 	}
 	const uint32_t file_sz = static_cast<uint32_t>(file->size());
 
+	// Decode-time dimension clamp.
+	// If a maximum decode dimension is set and the image exceeds it,
+	// decode a subsampled image instead of the full-size image.
+	// This bounds decode time and memory usage for thumbnailing.
+	if (max_decode_dim > 0 &&
+	    (ddsHeader.dwWidth > static_cast<uint32_t>(max_decode_dim) ||
+	     ddsHeader.dwHeight > static_cast<uint32_t>(max_decode_dim)))
+	{
+		unsigned int subsample = 1;
+		while ((ddsHeader.dwWidth >> subsample) > static_cast<uint32_t>(max_decode_dim) ||
+		       (ddsHeader.dwHeight >> subsample) > static_cast<uint32_t>(max_decode_dim))
+		{
+			subsample++;
+		}
+		const rp_image *const subImg = loadImageSubsampled(subsample);
+		if (subImg) {
+			return subImg;
+		}
+		// Subsampled decoding isn't supported for this format.
+		// Fall back to a full-size decode.
+	}
+
 	// Seek to the start of the texture data.
 	int ret = file->seek(texDataStartAddr);
 	if (ret != 0) {
@@ -618,111 +1001,9 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 			return nullptr;
 		}
 
-		// TODO: Handle typeless, signed, sRGB, float.
-		switch (dxgi_format) {
-			case DXGI_FORMAT_BC1_TYPELESS:
-			case DXGI_FORMAT_BC1_UNORM:
-			case DXGI_FORMAT_BC1_UNORM_SRGB:
-				if (likely(dxgi_alpha != DDS_ALPHA_MODE_OPAQUE)) {
-					// 1-bit alpha.
-					img = ImageDecoder::fromDXT1_A1(
-						ddsHeader.dwWidth, ddsHeader.dwHeight,
-						buf.get(), expected_size);
-				} else {
-					// No alpha channel.
-					img = ImageDecoder::fromDXT1(
-						ddsHeader.dwWidth, ddsHeader.dwHeight,
-						buf.get(), expected_size);
-				}
-				break;
-
-			case DXGI_FORMAT_BC2_TYPELESS:
-			case DXGI_FORMAT_BC2_UNORM:
-			case DXGI_FORMAT_BC2_UNORM_SRGB:
-				if (likely(dxgi_alpha != DDS_ALPHA_MODE_PREMULTIPLIED)) {
-					// Standard alpha: DXT3
-					img = ImageDecoder::fromDXT3(
-						ddsHeader.dwWidth, ddsHeader.dwHeight,
-						buf.get(), expected_size);
-				} else {
-					// Premultiplied alpha: DXT2
-					img = ImageDecoder::fromDXT2(
-						ddsHeader.dwWidth, ddsHeader.dwHeight,
-						buf.get(), expected_size);
-				}
-				break;
-
-			case DXGI_FORMAT_BC3_TYPELESS:
-			case DXGI_FORMAT_BC3_UNORM:
-			case DXGI_FORMAT_BC3_UNORM_SRGB:
-				if (likely(dxgi_alpha != DDS_ALPHA_MODE_PREMULTIPLIED)) {
-					// Standard alpha: DXT5
-					img = ImageDecoder::fromDXT5(
-						ddsHeader.dwWidth, ddsHeader.dwHeight,
-						buf.get(), expected_size);
-				} else {
-					// Premultiplied alpha: DXT4
-					img = ImageDecoder::fromDXT4(
-						ddsHeader.dwWidth, ddsHeader.dwHeight,
-						buf.get(), expected_size);
-				}
-				break;
-
-			case DXGI_FORMAT_BC4_TYPELESS:
-			case DXGI_FORMAT_BC4_UNORM:
-			case DXGI_FORMAT_BC4_SNORM:
-				img = ImageDecoder::fromBC4(
-					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					buf.get(), expected_size);
-				break;
-
-			case DXGI_FORMAT_BC5_TYPELESS:
-			case DXGI_FORMAT_BC5_UNORM:
-			case DXGI_FORMAT_BC5_SNORM:
-				img = ImageDecoder::fromBC5(
-					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					buf.get(), expected_size);
-				break;
-
-			case DXGI_FORMAT_BC7_TYPELESS:
-			case DXGI_FORMAT_BC7_UNORM:
-			case DXGI_FORMAT_BC7_UNORM_SRGB:
-				img = ImageDecoder::fromBC7(
-					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					buf.get(), expected_size);
-				break;
-
-#ifdef ENABLE_PVRTC
-			case DXGI_FORMAT_FAKE_PVRTC_2bpp:
-				// PVRTC, 2bpp, has alpha.
-				img = ImageDecoder::fromPVRTC(
-					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					buf.get(), expected_size,
-					ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
-				break;
-
-			case DXGI_FORMAT_FAKE_PVRTC_4bpp:
-				// PVRTC, 4bpp, has alpha.
-				img = ImageDecoder::fromPVRTC(
-					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					buf.get(), expected_size,
-					ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
-				break;
-#endif /* ENABLE_PVRTC */
-
-			case DXGI_FORMAT_R9G9B9E5_SHAREDEXP:
-				// RGB9_E5 (technically uncompressed...)
-				img = ImageDecoder::fromLinear32(
-					ImageDecoder::PXF_RGB9_E5,
-					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					reinterpret_cast<const uint32_t*>(buf.get()),
-					expected_size);
-				break;
-
-			default:
-				// Not supported.
-				break;
-		}
+		// Decode the image.
+		img = decodeBuffer(ddsHeader.dwWidth, ddsHeader.dwHeight,
+			buf.get(), expected_size, 0);
 	} else {
 		// Uncompressed linear image data.
 		assert(pxf_uncomp != 0);
@@ -766,46 +1047,9 @@ const rp_image *DirectDrawSurfacePrivate::loadImage(void)
 			return nullptr;
 		}
 
-		switch (bytespp) {
-			case sizeof(uint8_t):
-				// 8-bit image. (Usually luminance or alpha.)
-				img = ImageDecoder::fromLinear8(
-					(ImageDecoder::PixelFormat)pxf_uncomp,
-					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					buf.get(), expected_size, stride);
-				break;
-
-			case sizeof(uint16_t):
-				// 16-bit RGB image.
-				img = ImageDecoder::fromLinear16(
-					(ImageDecoder::PixelFormat)pxf_uncomp,
-					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					reinterpret_cast<const uint16_t*>(buf.get()),
-					expected_size, stride);
-				break;
-
-			case 24/8:
-				// 24-bit RGB image.
-				img = ImageDecoder::fromLinear24(
-					(ImageDecoder::PixelFormat)pxf_uncomp,
-					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					buf.get(), expected_size, stride);
-				break;
-
-			case sizeof(uint32_t):
-				// 32-bit RGB image.
-				img = ImageDecoder::fromLinear32(
-					(ImageDecoder::PixelFormat)pxf_uncomp,
-					ddsHeader.dwWidth, ddsHeader.dwHeight,
-					reinterpret_cast<const uint32_t*>(buf.get()),
-					expected_size, stride);
-				break;
-
-			default:
-				// TODO: Implement other formats.
-				assert(!"Unsupported pixel format.");
-				break;
-		}
+		// Decode the image.
+		img = decodeBuffer(ddsHeader.dwWidth, ddsHeader.dwHeight,
+			buf.get(), expected_size, stride);
 	}
 
 	// TODO: Untile textures for XBOX format.
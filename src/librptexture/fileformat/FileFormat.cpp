@@ -32,6 +32,7 @@ FileFormatPrivate::FileFormatPrivate(FileFormat *q, IRpFile *file)
 	, isValid(false)
 	, file(nullptr)
 	, mimeType(nullptr)
+	, max_decode_dim(0)
 {
 	// Clear the arrays.
 	memset(dimensions, 0, sizeof(dimensions));
@@ -169,4 +170,117 @@ int FileFormat::getDimensions(int pBuf[3]) const
 	return 0;
 }
 
+/**
+ * Get the dimensions of the specified mipmap.
+ * Standard mipmap chains halve each dimension per level,
+ * so this can be computed without decoding the image.
+ * @param mip	[in] Mipmap number. (0 == largest image)
+ * @param pBuf	[out] Three-element array for [x, y, z].
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int FileFormat::getMipmapDimensions(int mip, int pBuf[3]) const
+{
+	RP_D(const FileFormat);
+	if (!d->isValid) {
+		// Not supported.
+		return -EBADF;
+	}
+
+	int mipmapCount = this->mipmapCount();
+	if (mipmapCount <= 0) {
+		// No mipmaps == one image.
+		mipmapCount = 1;
+	}
+
+	assert(mip >= 0);
+	assert(mip < mipmapCount);
+	if (mip < 0 || mip >= mipmapCount) {
+		// Invalid mipmap number.
+		return -EINVAL;
+	}
+
+	// Each mipmap level halves the dimensions of the previous
+	// level, with a minimum of 1 for non-zero dimensions.
+	for (unsigned int i = 0; i < 3; i++) {
+		int dim = d->dimensions[i] >> mip;
+		if (dim <= 0 && d->dimensions[i] > 0) {
+			dim = 1;
+		}
+		pBuf[i] = dim;
+	}
+	return 0;
+}
+
+/**
+ * Get the best mipmap level for the specified size.
+ *
+ * This returns the smallest mipmap that is still at least
+ * as large as the specified size in both dimensions, so
+ * thumbnailers can decode less data. If the texture doesn't
+ * have (decodable) mipmaps, this returns 0.
+ *
+ * @param size Requested size. (single dimension)
+ * @return Mipmap number. (0 == largest image)
+ */
+int FileFormat::bestMipmapForSize(int size) const
+{
+	RP_D(const FileFormat);
+	assert(size > 0);
+	if (!d->isValid || size <= 0) {
+		// Use the full image.
+		return 0;
+	}
+
+	const int mipmapCount = this->mipmapCount();
+	if (mipmapCount <= 1) {
+		// No mipmaps. Use the full image.
+		return 0;
+	}
+
+	// Find the smallest mipmap that's at least as large as
+	// the requested size in both dimensions.
+	// NOTE: Depth (3D textures) is not taken into account.
+	int best = 0;
+	for (int mip = 1; mip < mipmapCount; mip++) {
+		const int mipWidth = d->dimensions[0] >> mip;
+		const int mipHeight = d->dimensions[1] >> mip;
+		if (mipWidth < size || mipHeight < size) {
+			// Mipmap is too small.
+			break;
+		}
+		best = mip;
+	}
+
+	// Verify that the mipmap can actually be decoded.
+	// Some formats only support decoding mipmap 0.
+	for (; best > 0; best--) {
+		if (this->mipmap(best) != nullptr) {
+			break;
+		}
+	}
+	return best;
+}
+
+/**
+ * Set the maximum decoded image dimension.
+ *
+ * If set, and the image to be decoded is larger than the
+ * specified dimension, formats that support it will decode
+ * a subsampled image instead of the full-size image. This
+ * bounds both decode time and memory usage, e.g. for
+ * thumbnailing very large textures that don't have mipmaps.
+ *
+ * NOTE: Must be set before the image is decoded.
+ * Decoded images are cached, so changing this afterwards
+ * has no effect.
+ *
+ * @param dim Maximum dimension. (0 == unlimited)
+ */
+void FileFormat::setMaxDecodeDimension(int dim)
+{
+	RP_D(FileFormat);
+	assert(dim >= 0);
+	d->max_decode_dim = (dim >= 0 ? dim : 0);
+}
+
 }
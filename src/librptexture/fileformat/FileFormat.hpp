@@ -172,6 +172,46 @@ class FileFormat
 		 */
 		virtual int mipmapCount(void) const = 0;
 
+		/**
+		 * Get the dimensions of the specified mipmap.
+		 * Standard mipmap chains halve each dimension per level,
+		 * so this can be computed without decoding the image.
+		 * @param mip	[in] Mipmap number. (0 == largest image)
+		 * @param pBuf	[out] Three-element array for [x, y, z].
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int getMipmapDimensions(int mip, int pBuf[3]) const;
+
+		/**
+		 * Get the best mipmap level for the specified size.
+		 *
+		 * This returns the smallest mipmap that is still at least
+		 * as large as the specified size in both dimensions, so
+		 * thumbnailers can decode less data. If the texture doesn't
+		 * have (decodable) mipmaps, this returns 0.
+		 *
+		 * @param size Requested size. (single dimension)
+		 * @return Mipmap number. (0 == largest image)
+		 */
+		int bestMipmapForSize(int size) const;
+
+		/**
+		 * Set the maximum decoded image dimension.
+		 *
+		 * If set, and the image to be decoded is larger than the
+		 * specified dimension, formats that support it will decode
+		 * a subsampled image instead of the full-size image. This
+		 * bounds both decode time and memory usage, e.g. for
+		 * thumbnailing very large textures that don't have mipmaps.
+		 *
+		 * NOTE: Must be set before the image is decoded.
+		 * Decoded images are cached, so changing this afterwards
+		 * has no effect.
+		 *
+		 * @param dim Maximum dimension. (0 == unlimited)
+		 */
+		void setMaxDecodeDimension(int dim);
+
 #ifdef ENABLE_LIBRPBASE_ROMFIELDS
 	public:
 		/**
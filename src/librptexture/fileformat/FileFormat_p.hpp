@@ -45,6 +45,11 @@ class FileFormatPrivate
 		const char *mimeType;		// MIME type. (ASCII) (default is nullptr)
 		int dimensions[3];		// Dimensions. (width, height, depth)
 						// 2D textures have depth=0.
+
+		// Maximum decoded image dimension. (0 == unlimited)
+		// Set by setMaxDecodeDimension(); used by subclasses
+		// that support subsampled decoding.
+		int max_decode_dim;
 };
 
 }
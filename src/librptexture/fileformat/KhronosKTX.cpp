@@ -20,6 +20,7 @@
 #include "ktx_structs.h"
 #include "gl_defs.h"
 #include "data/GLenumStrings.hpp"
+#include "data/KhronosFormatTables.hpp"
 
 // librpbase, librpfile
 using LibRpBase::RomFields;
@@ -71,8 +72,9 @@ class KhronosKTXPrivate : public FileFormatPrivate
 		// Texture data start address.
 		unsigned int texDataStartAddr;
 
-		// Decoded image.
-		rp_image *img;
+		// Decoded mipmaps.
+		// Mipmap 0 is the full image.
+		vector<rp_image*> mipmaps;
 
 		// Invalid pixel format message.
 		char invalid_pixel_format[24];
@@ -85,9 +87,10 @@ class KhronosKTXPrivate : public FileFormatPrivate
 
 		/**
 		 * Load the image.
+		 * @param mip Mipmap number. (0 == full image)
 		 * @return Image, or nullptr on error.
 		 */
-		const rp_image *loadImage(void);
+		const rp_image *loadImage(int mip);
 
 		/**
 		 * Load key/value data.
@@ -102,7 +105,6 @@ KhronosKTXPrivate::KhronosKTXPrivate(KhronosKTX *q, IRpFile *file)
 	, isByteswapNeeded(false)
 	, isFlipNeeded(FLIP_V)
 	, texDataStartAddr(0)
-	, img(nullptr)
 {
 	// Clear the KTX header struct.
 	memset(&ktxHeader, 0, sizeof(ktxHeader));
@@ -111,23 +113,42 @@ KhronosKTXPrivate::KhronosKTXPrivate(KhronosKTX *q, IRpFile *file)
 
 KhronosKTXPrivate::~KhronosKTXPrivate()
 {
-	delete img;
+	std::for_each(mipmaps.begin(), mipmaps.end(), [](rp_image *img) { delete img; });
 }
 
 /**
  * Load the image.
+ * @param mip Mipmap number. (0 == full image)
  * @return Image, or nullptr on error.
  */
-const rp_image *KhronosKTXPrivate::loadImage(void)
+const rp_image *KhronosKTXPrivate::loadImage(int mip)
 {
-	if (img) {
+	int mipmapCount = ktxHeader.numberOfMipmapLevels;
+	if (mipmapCount <= 0) {
+		// No mipmaps == one image.
+		mipmapCount = 1;
+	}
+
+	assert(mip >= 0);
+	assert(mip < mipmapCount);
+	if (mip < 0 || mip >= mipmapCount) {
+		// Invalid mipmap number.
+		return nullptr;
+	}
+
+	if (!mipmaps.empty() && mipmaps[mip] != nullptr) {
 		// Image has already been loaded.
-		return img;
+		return mipmaps[mip];
 	} else if (!this->file || !this->isValid) {
 		// Can't load the image.
 		return nullptr;
 	}
 
+	// Initialize the mipmap vector if necessary.
+	if (mipmaps.empty()) {
+		mipmaps.resize(mipmapCount, nullptr);
+	}
+
 	// Sanity check: Maximum image dimensions of 32768x32768.
 	// NOTE: `pixelHeight == 0` is allowed here. (1D texture)
 	assert(ktxHeader.pixelWidth > 0);
@@ -160,138 +181,64 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 		return nullptr;
 	}
 
-	// NOTE: Mipmaps are stored *after* the main image.
-	// Hence, no mipmap processing is necessary.
+	// Mipmaps are stored after the full image, largest level first.
+	// Each level is prefixed with a 32-bit image size field and
+	// padded to a 4-byte boundary, so earlier levels can be skipped
+	// without any format-specific size calculations.
+	for (int i = 0; i < mip; i++) {
+		uint32_t lvlSize;
+		size_t lvl_read = file->read(&lvlSize, sizeof(lvlSize));
+		if (lvl_read != sizeof(lvlSize)) {
+			// Unable to read the image size field.
+			return nullptr;
+		}
+		if (isByteswapNeeded) {
+			lvlSize = __swab32(lvlSize);
+		}
+		ret = file->seek(file->tell() + ALIGN_BYTES(4, lvlSize));
+		if (ret != 0) {
+			// Seek error.
+			return nullptr;
+		}
+	}
 
+	// Adjust the dimensions for the mipmap level.
 	// Handle a 1D texture as a "width x 1" 2D texture.
 	// NOTE: Handling a 3D texture as a single 2D texture.
-	const int height = (ktxHeader.pixelHeight > 0 ? ktxHeader.pixelHeight : 1);
+	int width = ktxHeader.pixelWidth >> mip;
+	int height = (ktxHeader.pixelHeight > 0 ? ktxHeader.pixelHeight : 1) >> mip;
+	if (width <= 0) {
+		width = 1;
+	}
+	if (height <= 0) {
+		height = 1;
+	}
+
+	// Look up the format in the shared mapping table.
+	const KhronosFormatTables::FormatSpec *const spec =
+		KhronosFormatTables::lookup_glFormat(ktxHeader.glFormat, ktxHeader.glInternalFormat);
+	if (!spec) {
+		// Not supported.
+		return nullptr;
+	}
 
 	// Calculate the expected size.
-	// NOTE: Scanlines are 4-byte aligned.
-	uint32_t expected_size;
 	int stride = 0;
-	switch (ktxHeader.glFormat) {
-		case GL_RGB:
-			// 24-bit RGB.
-			stride = ALIGN_BYTES(4, ktxHeader.pixelWidth * 3);
-			expected_size = static_cast<unsigned int>(stride * height);
-			break;
-
-		case GL_RGBA:
-			// 32-bit RGBA.
-			stride = ktxHeader.pixelWidth * 4;
-			expected_size = static_cast<unsigned int>(stride * height);
-			break;
-
-		case GL_LUMINANCE:
-			// 8-bit luminance.
-			stride = ALIGN_BYTES(4, ktxHeader.pixelWidth);
-			expected_size = static_cast<unsigned int>(stride * height);
-			break;
-
-		case GL_RGB9_E5:
-			// Uncompressed "special" 32bpp formats.
-			// TODO: Does KTX handle GL_RGB9_E5 as compressed?
-			stride = ktxHeader.pixelWidth * 4;
-			expected_size = static_cast<unsigned int>(stride * height);
-			break;
-
-		case 0:
-		default:
-			// May be a compressed format.
-			// TODO: Stride calculations?
-			switch (ktxHeader.glInternalFormat) {
-#ifdef ENABLE_PVRTC
-				case GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG:
-				case GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG:
-					// 32 pixels compressed into 64 bits. (2bpp)
-					expected_size = (ktxHeader.pixelWidth * height) / 4;
-					break;
-
-				case GL_COMPRESSED_RGBA_PVRTC_2BPPV2_IMG:
-					// 32 pixels compressed into 64 bits. (2bpp)
-					// NOTE: Width and height must be rounded to the nearest tile. (8x4)
-					expected_size = ALIGN_BYTES(8, ktxHeader.pixelWidth) *
-					                ALIGN_BYTES(4, (int)height) / 4;
-					break;
-
-				case GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG:
-				case GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG:
-					// 16 pixels compressed into 64 bits. (4bpp)
-					expected_size = (ktxHeader.pixelWidth * height) / 2;
-					break;
-
-				case GL_COMPRESSED_RGBA_PVRTC_4BPPV2_IMG:
-					// NOTE: Width and height must be rounded to the nearest tile. (4x4)
-					expected_size = ALIGN_BYTES(4, ktxHeader.pixelWidth) *
-					                ALIGN_BYTES(4, (int)height) / 2;
-					break;
-#endif /* ENABLE_PVRTC */
-
-				case GL_RGB_S3TC:
-				case GL_RGB4_S3TC:
-				case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
-				case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
-				case GL_ETC1_RGB8_OES:
-				case GL_COMPRESSED_R11_EAC:
-				case GL_COMPRESSED_SIGNED_R11_EAC:
-				case GL_COMPRESSED_RGB8_ETC2:
-				case GL_COMPRESSED_SRGB8_ETC2:
-				case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
-				case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
-				case GL_COMPRESSED_RED_RGTC1:
-				case GL_COMPRESSED_SIGNED_RED_RGTC1:
-				case GL_COMPRESSED_LUMINANCE_LATC1_EXT:
-				case GL_COMPRESSED_SIGNED_LUMINANCE_LATC1_EXT:
-					// 16 pixels compressed into 64 bits. (4bpp)
-					// NOTE: Width and height must be rounded to the nearest tile. (4x4)
-					expected_size = ALIGN_BYTES(4, ktxHeader.pixelWidth) *
-					                ALIGN_BYTES(4, (int)height) / 2;
-					break;
-
-				//case GL_RGBA_S3TC:	// TODO
-				//case GL_RGBA4_S3TC:	// TODO
-				case GL_RGBA_DXT5_S3TC:
-				case GL_RGBA4_DXT5_S3TC:
-				case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
-				case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
-				case GL_COMPRESSED_RG11_EAC:
-				case GL_COMPRESSED_SIGNED_RG11_EAC:
-				case GL_COMPRESSED_RGBA8_ETC2_EAC:
-				case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
-				case GL_COMPRESSED_RG_RGTC2:
-				case GL_COMPRESSED_SIGNED_RG_RGTC2:
-				case GL_COMPRESSED_LUMINANCE_ALPHA_LATC2_EXT:
-				case GL_COMPRESSED_SIGNED_LUMINANCE_ALPHA_LATC2_EXT:
-				case GL_COMPRESSED_RGBA_BPTC_UNORM:
-				case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
-					// 16 pixels compressed into 128 bits. (8bpp)
-					// NOTE: Width and height must be rounded to the nearest tile. (4x4)
-					expected_size = ALIGN_BYTES(4, ktxHeader.pixelWidth) *
-					                ALIGN_BYTES(4, (int)height);
-					break;
-
-				case GL_RGB9_E5:
-					// Uncompressed "special" 32bpp formats.
-					// TODO: Does KTX handle GL_RGB9_E5 as compressed?
-					expected_size = ktxHeader.pixelWidth * height * 4;
-					break;
-
-				default:
-					// Not supported.
-					return nullptr;
-			}
-			break;
+	const uint32_t expected_size = KhronosFormatTables::expectedSize(spec, width, height, &stride);
+	if (expected_size == 0) {
+		// Invalid size.
+		return nullptr;
 	}
 
 	// Verify file size.
-	if (texDataStartAddr + expected_size > file_sz) {
+	if (static_cast<uint32_t>(file->tell()) + sizeof(uint32_t) + expected_size > file_sz) {
 		// File is too small.
 		return nullptr;
 	}
 
 	// Read the image size field.
+	// NOTE: Only the full image size is verified against the
+	// expected size; mipmap levels use the stored size directly.
 	uint32_t imageSize;
 	size_t size = file->read(&imageSize, sizeof(imageSize));
 	if (size != sizeof(imageSize)) {
@@ -307,6 +254,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 	}
 
 	// Read the texture data.
+	rp_image *img = nullptr;
 	auto buf = aligned_uptr<uint8_t>(16, expected_size);
 	size = file->read(buf.get(), expected_size);
 	if (size != expected_size) {
@@ -317,217 +265,8 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 	// TODO: Byteswapping.
 	// TODO: Handle variants. Check for channel sizes in glInternalFormat?
 	// TODO: Handle sRGB post-processing? (for e.g. GL_SRGB8)
-	switch (ktxHeader.glFormat) {
-		case GL_RGB:
-			// 24-bit RGB.
-			img = ImageDecoder::fromLinear24(ImageDecoder::PXF_BGR888,
-				ktxHeader.pixelWidth, height,
-				buf.get(), expected_size, stride);
-			break;
-
-		case GL_RGBA:
-			// 32-bit RGBA.
-			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_ABGR8888,
-				ktxHeader.pixelWidth, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
-			break;
-
-		case GL_LUMINANCE:
-			// 8-bit Luminance.
-			img = ImageDecoder::fromLinear8(ImageDecoder::PXF_L8,
-				ktxHeader.pixelWidth, height,
-				buf.get(), expected_size, stride);
-			break;
-
-		case GL_RGB9_E5:
-			// Uncompressed "special" 32bpp formats.
-			// TODO: Does KTX handle GL_RGB9_E5 as compressed?
-			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_RGB9_E5,
-				ktxHeader.pixelWidth, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
-			break;
-
-		case 0:
-		default:
-			// May be a compressed format.
-			// TODO: sRGB post-processing for sRGB formats?
-			switch (ktxHeader.glInternalFormat) {
-				case GL_RGB_S3TC:
-				case GL_RGB4_S3TC:
-				case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
-					// DXT1-compressed texture.
-					img = ImageDecoder::fromDXT1(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
-					break;
-
-				case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
-					// DXT1-compressed texture with 1-bit alpha.
-					img = ImageDecoder::fromDXT1_A1(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
-					break;
-
-				case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
-					// DXT3-compressed texture.
-					img = ImageDecoder::fromDXT3(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
-					break;
-
-				case GL_RGBA_DXT5_S3TC:
-				case GL_RGBA4_DXT5_S3TC:
-				case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT:
-					// DXT5-compressed texture.
-					img = ImageDecoder::fromDXT5(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
-					break;
-
-				case GL_ETC1_RGB8_OES:
-					// ETC1-compressed texture.
-					img = ImageDecoder::fromETC1(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
-					break;
-
-				case GL_COMPRESSED_RGB8_ETC2:
-				case GL_COMPRESSED_SRGB8_ETC2:
-					// ETC2-compressed RGB texture.
-					// TODO: Handle sRGB.
-					img = ImageDecoder::fromETC2_RGB(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
-					break;
-
-				case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
-				case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
-					// ETC2-compressed RGB texture
-					// with punchthrough alpha.
-					// TODO: Handle sRGB.
-					img = ImageDecoder::fromETC2_RGB_A1(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
-					break;
-
-				case GL_COMPRESSED_RGBA8_ETC2_EAC:
-				case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC:
-					// ETC2-compressed RGB texture
-					// with EAC-compressed alpha channel.
-					// TODO: Handle sRGB.
-					img = ImageDecoder::fromETC2_RGBA(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
-					break;
-
-				case GL_COMPRESSED_RED_RGTC1:
-				case GL_COMPRESSED_SIGNED_RED_RGTC1:
-					// RGTC, one component. (BC4)
-					// TODO: Handle signed properly.
-					img = ImageDecoder::fromBC4(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
-					break;
-
-				case GL_COMPRESSED_RG_RGTC2:
-				case GL_COMPRESSED_SIGNED_RG_RGTC2:
-					// RGTC, two components. (BC5)
-					// TODO: Handle signed properly.
-					img = ImageDecoder::fromBC5(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
-					break;
-
-				case GL_COMPRESSED_LUMINANCE_LATC1_EXT:
-				case GL_COMPRESSED_SIGNED_LUMINANCE_LATC1_EXT:
-					// LATC, one component. (BC4)
-					// TODO: Handle signed properly.
-					img = ImageDecoder::fromBC4(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
-					// TODO: If this fails, return it anyway or return nullptr?
-					ImageDecoder::fromRed8ToL8(img);
-					break;
-
-				case GL_COMPRESSED_LUMINANCE_ALPHA_LATC2_EXT:
-				case GL_COMPRESSED_SIGNED_LUMINANCE_ALPHA_LATC2_EXT:
-					// LATC, two components. (BC5)
-					// TODO: Handle signed properly.
-					img = ImageDecoder::fromBC5(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
-					// TODO: If this fails, return it anyway or return nullptr?
-					ImageDecoder::fromRG8ToLA8(img);
-					break;
-
-				case GL_COMPRESSED_RGBA_BPTC_UNORM:
-				case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM:
-					// BPTC-compressed RGBA texture. (BC7)
-					img = ImageDecoder::fromBC7(
-						ktxHeader.pixelWidth, height,
-						buf.get(), expected_size);
-					break;
-
-#ifdef ENABLE_PVRTC
-				case GL_COMPRESSED_RGB_PVRTC_2BPPV1_IMG:
-					// PVRTC, 2bpp, no alpha.
-					img = ImageDecoder::fromPVRTC(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
-						ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_NONE);
-					break;
-
-				case GL_COMPRESSED_RGBA_PVRTC_2BPPV1_IMG:
-					// PVRTC, 2bpp, has alpha.
-					img = ImageDecoder::fromPVRTC(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
-						ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
-					break;
-
-				case GL_COMPRESSED_RGB_PVRTC_4BPPV1_IMG:
-					// PVRTC, 4bpp, no alpha.
-					img = ImageDecoder::fromPVRTC(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
-						ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_NONE);
-					break;
-
-				case GL_COMPRESSED_RGBA_PVRTC_4BPPV1_IMG:
-					// PVRTC, 4bpp, has alpha.
-					img = ImageDecoder::fromPVRTC(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
-						ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
-					break;
-
-				case GL_COMPRESSED_RGBA_PVRTC_2BPPV2_IMG:
-					// PVRTC-II, 2bpp.
-					// NOTE: Assuming this has alpha.
-					img = ImageDecoder::fromPVRTCII(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
-						ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
-					break;
-
-				case GL_COMPRESSED_RGBA_PVRTC_4BPPV2_IMG:
-					// PVRTC-II, 4bpp.
-					// NOTE: Assuming this has alpha.
-					img = ImageDecoder::fromPVRTCII(ktxHeader.pixelWidth, height,
-						buf.get(), expected_size,
-						ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
-					break;
-#endif /* ENABLE_PVRTC */
-
-				case GL_RGB9_E5:
-					// Uncompressed "special" 32bpp formats.
-					// TODO: Does KTX handle GL_RGB9_E5 as compressed?
-					img = ImageDecoder::fromLinear32(ImageDecoder::PXF_RGB9_E5,
-						ktxHeader.pixelWidth, height,
-						reinterpret_cast<const uint32_t*>(buf.get()), expected_size);
-					break;
-
-				default:
-					// Not supported.
-					break;
-			}
-			break;
-	}
+	img = KhronosFormatTables::decodeImage(spec, width, height,
+		buf.get(), expected_size, stride);
 
 	// Post-processing: Check if VFlip is needed.
 	// TODO: Handle HFlip too?
@@ -542,6 +281,7 @@ const rp_image *KhronosKTXPrivate::loadImage(void)
 		}
 	}
 
+	mipmaps[mip] = img;
 	return img;
 }
 
@@ -1040,11 +780,7 @@ const rp_image *KhronosKTX::mipmap(int mip) const
 		return nullptr;
 	}
 
-	// FIXME: Support decoding mipmaps.
-	if (mip == 0) {
-		return const_cast<KhronosKTXPrivate*>(d)->loadImage();
-	}
-	return nullptr;
+	return const_cast<KhronosKTXPrivate*>(d)->loadImage(mip);
 }
 
 }
@@ -24,6 +24,7 @@
 #include "ktx2_structs.h"
 #include "vk_defs.h"
 #include "data/VkEnumStrings.hpp"
+#include "data/KhronosFormatTables.hpp"
 
 // librpbase, librpfile
 using LibRpBase::RomFields;
@@ -210,117 +211,21 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 		return nullptr;
 	}
 
-	// Calculate the expected size.
-	// NOTE: Scanlines are 4-byte aligned.
+	// Look up the format in the shared mapping table.
 	// TODO: Differences between UNORM, UINT, SRGB; handle SNORM, SINT.
-	uint32_t expected_size;
-	int stride = 0;
-	switch (ktx2Header.vkFormat) {
-		case VK_FORMAT_R8G8B8_UNORM:
-		case VK_FORMAT_R8G8B8_UINT:
-		case VK_FORMAT_R8G8B8_SRGB:
-		case VK_FORMAT_B8G8R8_UNORM:
-		case VK_FORMAT_B8G8R8_UINT:
-		case VK_FORMAT_B8G8R8_SRGB:
-			// 24-bit RGB.
-			stride = ALIGN_BYTES(4, width * 3);
-			expected_size = static_cast<unsigned int>(stride * height);
-			break;
-
-		case VK_FORMAT_R8G8B8A8_UNORM:
-		case VK_FORMAT_R8G8B8A8_UINT:
-		case VK_FORMAT_R8G8B8A8_SRGB:
-		case VK_FORMAT_B8G8R8A8_UNORM:
-		case VK_FORMAT_B8G8R8A8_UINT:
-		case VK_FORMAT_B8G8R8A8_SRGB:
-			// 32-bit RGBA.
-			stride = width * 4;
-			expected_size = static_cast<unsigned int>(stride * height);
-			break;
-
-		case VK_FORMAT_R8_UNORM:
-		case VK_FORMAT_R8_UINT:
-		case VK_FORMAT_R8_SRGB:
-			// 8-bit. (red)
-			stride = ALIGN_BYTES(4, width);
-			expected_size = static_cast<unsigned int>(stride * height);
-			break;
-
-		case VK_FORMAT_E5B9G9R9_UFLOAT_PACK32:
-			// Uncompressed "special" 32bpp formats.
-			stride = width * 4;
-			expected_size = static_cast<unsigned int>(stride * height);
-			break;
-
-		// Compressed formats.
-		// NOTE: These were handled separately in KTX1 due to OpenGL
-		// differentiating between "format" and "internal format".
-
-#ifdef ENABLE_PVRTC
-		case VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG:
-		case VK_FORMAT_PVRTC1_2BPP_SRGB_BLOCK_IMG:
-			// 32 pixels compressed into 64 bits. (2bpp)
-			expected_size = (width * height) / 4;
-			break;
-
-		case VK_FORMAT_PVRTC2_2BPP_UNORM_BLOCK_IMG:
-		case VK_FORMAT_PVRTC2_2BPP_SRGB_BLOCK_IMG:
-			// 32 pixels compressed into 64 bits. (2bpp)
-			// NOTE: Width and height must be rounded to the nearest tile. (8x4)
-			expected_size = ALIGN_BYTES(8, width) *
-			                ALIGN_BYTES(4, height) / 4;
-			break;
-
-		case VK_FORMAT_PVRTC1_4BPP_UNORM_BLOCK_IMG:
-		case VK_FORMAT_PVRTC1_4BPP_SRGB_BLOCK_IMG:
-			// 16 pixels compressed into 64 bits. (4bpp)
-			expected_size = (width * height) / 2;
-			break;
-
-		case VK_FORMAT_PVRTC2_4BPP_UNORM_BLOCK_IMG:
-		case VK_FORMAT_PVRTC2_4BPP_SRGB_BLOCK_IMG:
-			// 16 pixels compressed into 64 bits. (4bpp)
-			// NOTE: Width and height must be rounded to the nearest tile. (8x4)
-			expected_size = ALIGN_BYTES(4, width) *
-			                ALIGN_BYTES(4, height) / 2;
-			break;
-#endif /* ENABLE_PVRTC */
-
-		case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
-		case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
-		case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
-		case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
-		case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
-		case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
-		case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
-		case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
-		case VK_FORMAT_EAC_R11_UNORM_BLOCK:
-		case VK_FORMAT_EAC_R11_SNORM_BLOCK:
-			// 16 pixels compressed into 64 bits. (4bpp)
-			// NOTE: Width and height must be rounded to the nearest tile. (4x4)
-			expected_size = ALIGN_BYTES(4, width) *
-					ALIGN_BYTES(4, (int)height) / 2;
-			break;
-
-		case VK_FORMAT_BC2_UNORM_BLOCK:
-		case VK_FORMAT_BC2_SRGB_BLOCK:
-		case VK_FORMAT_BC3_UNORM_BLOCK:
-		case VK_FORMAT_BC3_SRGB_BLOCK:
-		case VK_FORMAT_BC7_UNORM_BLOCK:
-		case VK_FORMAT_BC7_SRGB_BLOCK:
-		case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
-		case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
-		case VK_FORMAT_EAC_R11G11_UNORM_BLOCK:
-		case VK_FORMAT_EAC_R11G11_SNORM_BLOCK:
-			// 16 pixels compressed into 128 bits. (8bpp)
-			// NOTE: Width and height must be rounded to the nearest tile. (4x4)
-			expected_size = ALIGN_BYTES(4, width) *
-					ALIGN_BYTES(4, (int)height);
-			break;
+	const KhronosFormatTables::FormatSpec *const spec =
+		KhronosFormatTables::lookup_vkFormat(ktx2Header.vkFormat);
+	if (!spec) {
+		// Not supported.
+		return nullptr;
+	}
 
-		default:
-			// Not supported.
-			return nullptr;
+	// Calculate the expected size.
+	int stride = 0;
+	const uint32_t expected_size = KhronosFormatTables::expectedSize(spec, width, height, &stride);
+	if (expected_size == 0) {
+		// Invalid size.
+		return nullptr;
 	}
 
 	// Verify mipmap size.
@@ -345,176 +250,8 @@ const rp_image *KhronosKTX2Private::loadImage(int mip)
 	}
 
 	// TODO: Handle sRGB post-processing? (for e.g. GL_SRGB8)
-	rp_image *img = nullptr;
-	switch (ktx2Header.vkFormat) {
-		case VK_FORMAT_R8G8B8_UNORM:
-		case VK_FORMAT_R8G8B8_UINT:
-		case VK_FORMAT_R8G8B8_SRGB:
-			// 24-bit RGB.
-			img = ImageDecoder::fromLinear24(ImageDecoder::PXF_BGR888,
-				width, height,
-				buf.get(), expected_size, stride);
-			break;
-
-		case VK_FORMAT_B8G8R8_UNORM:
-		case VK_FORMAT_B8G8R8_UINT:
-		case VK_FORMAT_B8G8R8_SRGB:
-			// 24-bit RGB. (R/B swapped)
-			img = ImageDecoder::fromLinear24(ImageDecoder::PXF_RGB888,
-				width, height,
-				buf.get(), expected_size, stride);
-			break;
-
-		case VK_FORMAT_R8G8B8A8_UNORM:
-		case VK_FORMAT_R8G8B8A8_UINT:
-		case VK_FORMAT_R8G8B8A8_SRGB:
-			// 32-bit RGBA.
-			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_ABGR8888,
-				width, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
-			break;
-
-		case VK_FORMAT_B8G8R8A8_UNORM:
-		case VK_FORMAT_B8G8R8A8_UINT:
-		case VK_FORMAT_B8G8R8A8_SRGB:
-			// 32-bit RGBA. (R/B swapped)
-			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_ARGB8888,
-				width, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
-			break;
-
-		case VK_FORMAT_R8_UNORM:
-		case VK_FORMAT_R8_UINT:
-		case VK_FORMAT_R8_SRGB:
-			// 8-bit (red).
-			// FIXME: Decode as red, not as L8.
-			img = ImageDecoder::fromLinear8(ImageDecoder::PXF_L8,
-				width, height,
-				buf.get(), expected_size, stride);
-			break;
-
-		case VK_FORMAT_E5B9G9R9_UFLOAT_PACK32:
-			// Uncompressed "special" 32bpp formats.
-			img = ImageDecoder::fromLinear32(ImageDecoder::PXF_RGB9_E5,
-				width, height,
-				reinterpret_cast<const uint32_t*>(buf.get()), expected_size, stride);
-			break;
-
-		// Compressed formats.
-		// NOTE: These were handled separately in KTX1 due to OpenGL
-		// differentiating between "format" and "internal format".
-
-		case VK_FORMAT_BC1_RGB_UNORM_BLOCK:
-		case VK_FORMAT_BC1_RGB_SRGB_BLOCK:
-			// DXT1-compressed texture.
-			img = ImageDecoder::fromDXT1(
-				width, height,
-				buf.get(), expected_size);
-			break;
-
-		case VK_FORMAT_BC1_RGBA_UNORM_BLOCK:
-		case VK_FORMAT_BC1_RGBA_SRGB_BLOCK:
-			// DXT1-compressed texture with 1-bit alpha.
-			img = ImageDecoder::fromDXT1_A1(
-				width, height,
-				buf.get(), expected_size);
-			break;
-
-		case VK_FORMAT_BC2_UNORM_BLOCK:
-		case VK_FORMAT_BC2_SRGB_BLOCK:
-			// DXT3-compressed texture.
-			img = ImageDecoder::fromDXT3(
-				width, height,
-				buf.get(), expected_size);
-			break;
-
-		case VK_FORMAT_BC3_UNORM_BLOCK:
-		case VK_FORMAT_BC3_SRGB_BLOCK:
-			// DXT5-compressed texture.
-			img = ImageDecoder::fromDXT5(
-				width, height,
-				buf.get(), expected_size);
-			break;
-
-		case VK_FORMAT_ETC2_R8G8B8_UNORM_BLOCK:
-		case VK_FORMAT_ETC2_R8G8B8_SRGB_BLOCK:
-			// ETC2-compressed RGB texture.
-			// TODO: Handle sRGB.
-			img = ImageDecoder::fromETC2_RGB(
-				width, height,
-				buf.get(), expected_size);
-			break;
-
-		case VK_FORMAT_ETC2_R8G8B8A1_UNORM_BLOCK:
-		case VK_FORMAT_ETC2_R8G8B8A1_SRGB_BLOCK:
-			// ETC2-compressed RGB texture
-			// with punchthrough alpha.
-			// TODO: Handle sRGB.
-			img = ImageDecoder::fromETC2_RGB_A1(
-				width, height,
-				buf.get(), expected_size);
-			break;
-
-		case VK_FORMAT_ETC2_R8G8B8A8_UNORM_BLOCK:
-		case VK_FORMAT_ETC2_R8G8B8A8_SRGB_BLOCK:
-			// ETC2-compressed RGB texture
-			// with EAC-compressed alpha channel.
-			// TODO: Handle sRGB.
-			img = ImageDecoder::fromETC2_RGBA(
-				width, height,
-				buf.get(), expected_size);
-			break;
-
-		case VK_FORMAT_BC7_UNORM_BLOCK:
-		case VK_FORMAT_BC7_SRGB_BLOCK:
-			// BPTC-compressed RGBA texture. (BC7)
-			img = ImageDecoder::fromBC7(
-				width, height,
-				buf.get(), expected_size);
-			break;
-
-#ifdef ENABLE_PVRTC
-		// NOTE: KTX2 doesn't have a way to specify "no alpha" for PVRTC.
-		// We'll assume all PVRTC KTX2 textures have alpha.
-
-		case VK_FORMAT_PVRTC1_2BPP_UNORM_BLOCK_IMG:
-		case VK_FORMAT_PVRTC1_2BPP_SRGB_BLOCK_IMG:
-			// PVRTC, 2bpp.
-			img = ImageDecoder::fromPVRTC(width, height,
-				buf.get(), expected_size,
-				ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
-			break;
-
-		case VK_FORMAT_PVRTC1_4BPP_UNORM_BLOCK_IMG:
-		case VK_FORMAT_PVRTC1_4BPP_SRGB_BLOCK_IMG:
-			// PVRTC, 4bpp.
-			img = ImageDecoder::fromPVRTC(width, height,
-				buf.get(), expected_size,
-				ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
-			break;
-
-		case VK_FORMAT_PVRTC2_2BPP_UNORM_BLOCK_IMG:
-		case VK_FORMAT_PVRTC2_2BPP_SRGB_BLOCK_IMG:
-			// PVRTC-II, 2bpp.
-			img = ImageDecoder::fromPVRTCII(width, height,
-				buf.get(), expected_size,
-				ImageDecoder::PVRTC_2BPP | ImageDecoder::PVRTC_ALPHA_YES);
-			break;
-
-		case VK_FORMAT_PVRTC2_4BPP_UNORM_BLOCK_IMG:
-		case VK_FORMAT_PVRTC2_4BPP_SRGB_BLOCK_IMG:
-			// PVRTC-II, 4bpp.
-			// NOTE: Assuming this has alpha.
-			img = ImageDecoder::fromPVRTCII(width, height,
-				buf.get(), expected_size,
-				ImageDecoder::PVRTC_4BPP | ImageDecoder::PVRTC_ALPHA_YES);
-			break;
-#endif /* ENABLE_PVRTC */
-
-		default:
-			// Not supported.
-			break;
-	}
+	rp_image *img = KhronosFormatTables::decodeImage(spec, width, height,
+		buf.get(), expected_size, stride);
 
 	// Post-processing: Check if VFlip is needed.
 	// TODO: Handle HFlip too?
@@ -0,0 +1,264 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ImageConv.cpp: rp_image to native pixel layout conversion registry.     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ImageConv.hpp"
+#include "rp_image.hpp"
+
+// librpthreads
+#include "librpthreads/pthread_once.h"
+
+// C++ STL classes.
+using std::array;
+
+namespace LibRpTexture { namespace ImageConv {
+
+/** Dispatch table **/
+
+// ARGB32-source kernel for each destination layout, selected once
+// at first use with the best available SIMD implementation.
+// (CI8 sources go through the shared palette blit below; the
+// palette transform is at most 256 entries, so SIMD isn't worth it.)
+typedef void (*pfnConvertArgb32_t)(uint32_t *px_dest, int dest_stride, const rp_image *img);
+static pfnConvertArgb32_t g_convTbl[LAYOUT_MAX];
+static pthread_once_t once_convTbl = PTHREAD_ONCE_INIT;
+
+/**
+ * Convert ARGB32 image data to ARGB32. (straight row copy)
+ * @param px_dest	[out] Destination buffer.
+ * @param dest_stride	[in] Destination stride, in bytes.
+ * @param img		[in] rp_image. (must be FORMAT_ARGB32)
+ */
+static void argb32_copy(uint32_t *px_dest, int dest_stride, const rp_image *img)
+{
+	const int width = img->width();
+	const int height = img->height();
+	const int row_bytes = width * static_cast<int>(sizeof(uint32_t));
+	const uint8_t *src = static_cast<const uint8_t*>(img->bits());
+	uint8_t *dest = reinterpret_cast<uint8_t*>(px_dest);
+	const int src_stride = img->stride();
+
+	for (int y = height; y > 0; y--) {
+		memcpy(dest, src, row_bytes);
+		src += src_stride;
+		dest += dest_stride;
+	}
+}
+
+/**
+ * Convert ARGB32 image data to ABGR32. (R/B channel swap)
+ * Standard version using regular C++ code.
+ * @param px_dest	[out] Destination buffer.
+ * @param dest_stride	[in] Destination stride, in bytes.
+ * @param img		[in] rp_image. (must be FORMAT_ARGB32)
+ */
+void argb32_to_abgr32_cpp(uint32_t *px_dest, int dest_stride, const rp_image *img)
+{
+	const int width = img->width();
+	const int height = img->height();
+	const uint32_t *img_buf = static_cast<const uint32_t*>(img->bits());
+	const int src_stride_adj = (img->stride() / sizeof(uint32_t)) - width;
+	const int dest_stride_adj = (dest_stride / sizeof(uint32_t)) - width;
+
+	for (int y = height; y > 0; y--) {
+		int x;
+		for (x = width; x > 1; x -= 2) {
+			// Swap the R and B channels.
+			px_dest[0] = (img_buf[0] & 0xFF00FF00) |
+				    ((img_buf[0] & 0x00FF0000) >> 16) |
+				    ((img_buf[0] & 0x000000FF) << 16);
+			px_dest[1] = (img_buf[1] & 0xFF00FF00) |
+				    ((img_buf[1] & 0x00FF0000) >> 16) |
+				    ((img_buf[1] & 0x000000FF) << 16);
+			img_buf += 2;
+			px_dest += 2;
+		}
+		if (x == 1) {
+			// Last pixel.
+			*px_dest = (*img_buf & 0xFF00FF00) |
+				  ((*img_buf & 0x00FF0000) >> 16) |
+				  ((*img_buf & 0x000000FF) << 16);
+			img_buf++;
+			px_dest++;
+		}
+
+		// Next line.
+		img_buf += src_stride_adj;
+		px_dest += dest_stride_adj;
+	}
+}
+
+/**
+ * Initialize the dispatch table.
+ * Internal function; must be called using pthread_once().
+ */
+static void init_convTbl(void)
+{
+	// LAYOUT_ARGB32 is a straight copy; no SIMD needed.
+	g_convTbl[LAYOUT_ARGB32] = argb32_copy;
+
+#ifdef IMAGECONV_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		g_convTbl[LAYOUT_ABGR32] = argb32_to_abgr32_avx2;
+	} else
+#endif /* IMAGECONV_HAS_AVX2 */
+#ifdef IMAGECONV_HAS_SSSE3
+	if (RP_CPU_HasSSSE3()) {
+		g_convTbl[LAYOUT_ABGR32] = argb32_to_abgr32_ssse3;
+	} else
+#endif /* IMAGECONV_HAS_SSSE3 */
+	{
+		g_convTbl[LAYOUT_ABGR32] = argb32_to_abgr32_cpp;
+	}
+}
+
+/** Shared CI8 palette blit **/
+
+/**
+ * Expand a CI8 image through a 256-entry palette.
+ * @param px_dest	[out] Destination buffer.
+ * @param dest_stride	[in] Destination stride, in bytes.
+ * @param img		[in] rp_image. (must be FORMAT_CI8)
+ * @param palette	[in] 256-entry palette, already in the destination layout.
+ */
+static void blit_ci8(uint32_t *px_dest, int dest_stride,
+	const rp_image *img, const uint32_t *palette)
+{
+	const int width = img->width();
+	const int height = img->height();
+	const uint8_t *img_buf = static_cast<const uint8_t*>(img->bits());
+	const int src_stride_adj = img->stride() - width;
+	const int dest_stride_adj = (dest_stride / sizeof(uint32_t)) - width;
+
+	for (int y = height; y > 0; y--) {
+		int x;
+		for (x = width; x > 3; x -= 4) {
+			px_dest[0] = palette[img_buf[0]];
+			px_dest[1] = palette[img_buf[1]];
+			px_dest[2] = palette[img_buf[2]];
+			px_dest[3] = palette[img_buf[3]];
+			px_dest += 4;
+			img_buf += 4;
+		}
+		for (; x > 0; x--, px_dest++, img_buf++) {
+			// Remaining pixels.
+			*px_dest = palette[*img_buf];
+		}
+
+		// Next line.
+		img_buf += src_stride_adj;
+		px_dest += dest_stride_adj;
+	}
+}
+
+/** Public API **/
+
+/**
+ * Convert an rp_image to a destination buffer in the specified layout.
+ *
+ * The source image may be ARGB32 or CI8; CI8 is expanded through
+ * its palette. The destination buffer must be large enough for
+ * (dest_stride * img->height()) bytes.
+ *
+ * @param px_dest	[out] Destination buffer.
+ * @param dest_stride	[in] Destination stride, in bytes. (must be >= width * 4)
+ * @param layout	[in] Destination pixel layout.
+ * @param img		[in] rp_image.
+ * @param flags		[in] ConvFlags bitfield.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int convert(uint32_t *px_dest, int dest_stride, DestLayout layout,
+	const rp_image *img, unsigned int flags)
+{
+	assert(px_dest != nullptr);
+	assert(layout >= LAYOUT_ARGB32 && layout < LAYOUT_MAX);
+	assert(img != nullptr);
+	if (!px_dest || layout < LAYOUT_ARGB32 || layout >= LAYOUT_MAX ||
+	    !img || !img->isValid())
+	{
+		return -EINVAL;
+	}
+	assert(dest_stride >= img->width() * static_cast<int>(sizeof(uint32_t)));
+	if (dest_stride < img->width() * static_cast<int>(sizeof(uint32_t))) {
+		return -EINVAL;
+	}
+
+	pthread_once(&once_convTbl, init_convTbl);
+
+	switch (img->format()) {
+		case rp_image::FORMAT_ARGB32:
+			if (unlikely(flags & CONV_PREMULTIPLY)) {
+				// Premultiply per-pixel, then swizzle.
+				// Uncommon path; no SIMD.
+				const int width = img->width();
+				const uint32_t *img_buf = static_cast<const uint32_t*>(img->bits());
+				const int src_stride_adj = (img->stride() / sizeof(uint32_t)) - width;
+				const int dest_stride_adj = (dest_stride / sizeof(uint32_t)) - width;
+				for (int y = img->height(); y > 0; y--) {
+					for (int x = width; x > 0; x--, img_buf++, px_dest++) {
+						uint32_t px = rp_image::premultiply_pixel(*img_buf);
+						if (layout == LAYOUT_ABGR32) {
+							px = (px & 0xFF00FF00) |
+							    ((px & 0x00FF0000) >> 16) |
+							    ((px & 0x000000FF) << 16);
+						}
+						*px_dest = px;
+					}
+					img_buf += src_stride_adj;
+					px_dest += dest_stride_adj;
+				}
+			} else {
+				g_convTbl[layout](px_dest, dest_stride, img);
+			}
+			break;
+
+		case rp_image::FORMAT_CI8: {
+			const uint32_t *src_pal = img->palette();
+			const int src_pal_len = img->palette_len();
+			assert(src_pal != nullptr);
+			assert(src_pal_len > 0);
+			assert(src_pal_len <= 256);
+			if (!src_pal || src_pal_len <= 0 || src_pal_len > 256) {
+				return -EINVAL;
+			}
+
+			// Convert the palette to the destination layout.
+			array<uint32_t, 256> palette;
+			for (int i = 0; i < src_pal_len; i++) {
+				uint32_t px = src_pal[i];
+				if (flags & CONV_PREMULTIPLY) {
+					px = rp_image::premultiply_pixel(px);
+				}
+				if (layout == LAYOUT_ABGR32) {
+					px = (px & 0xFF00FF00) |
+					    ((px & 0x00FF0000) >> 16) |
+					    ((px & 0x000000FF) << 16);
+				}
+				palette[i] = px;
+			}
+			// Zero out the rest of the palette so out-of-range
+			// indices in the image data read as transparent.
+			if (src_pal_len < static_cast<int>(palette.size())) {
+				memset(&palette[src_pal_len], 0,
+					(palette.size() - src_pal_len) * sizeof(uint32_t));
+			}
+
+			blit_ci8(px_dest, dest_stride, img, palette.data());
+			break;
+		}
+
+		default:
+			// Unsupported image format.
+			assert(!"Unsupported rp_image::Format.");
+			return -ENOTSUP;
+	}
+
+	return 0;
+}
+
+} }
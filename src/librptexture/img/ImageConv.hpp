@@ -0,0 +1,116 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ImageConv.hpp: rp_image to native pixel layout conversion registry.     *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTEXTURE_IMG_IMAGECONV_HPP__
+#define __ROMPROPERTIES_LIBRPTEXTURE_IMG_IMAGECONV_HPP__
+
+// The toolkit frontends all need to blit an rp_image (ARGB32 or
+// CI8) into a destination buffer in the toolkit's pixel layout:
+// GdkPixbuf wants R,G,B,A byte order; Cairo, QImage, and GDI want
+// native ARGB32, optionally premultiplied. This registry holds one
+// conversion kernel per destination layout, with the best available
+// SIMD implementation selected at runtime, so an optimization
+// written here accelerates every frontend.
+
+#include "common.h"
+#include "librpcpu/cpu_dispatch.h"
+
+// C includes. (C++ namespace)
+#include <cstdint>
+
+#if defined(RP_CPU_I386) || defined(RP_CPU_AMD64)
+# include "librpcpu/cpuflags_x86.h"
+# define IMAGECONV_HAS_SSSE3 1
+# define IMAGECONV_HAS_AVX2 1
+#endif
+
+namespace LibRpTexture {
+
+class rp_image;
+
+namespace ImageConv {
+
+/**
+ * Destination pixel layouts.
+ */
+enum DestLayout {
+	// Native ARGB32. (B,G,R,A byte order on little-endian)
+	// Used by Cairo, QImage, and GDI.
+	LAYOUT_ARGB32 = 0,
+
+	// ABGR32. (R,G,B,A byte order on little-endian)
+	// Used by GdkPixbuf.
+	LAYOUT_ABGR32,
+
+	LAYOUT_MAX
+};
+
+/**
+ * Conversion flags.
+ */
+enum ConvFlags {
+	CONV_NONE		= 0,
+
+	// Premultiply alpha. Needed for display through Cairo;
+	// NOT needed for PNG output.
+	CONV_PREMULTIPLY	= (1U << 0),
+};
+
+/**
+ * Convert an rp_image to a destination buffer in the specified layout.
+ *
+ * The source image may be ARGB32 or CI8; CI8 is expanded through
+ * its palette. The destination buffer must be large enough for
+ * (dest_stride * img->height()) bytes.
+ *
+ * @param px_dest	[out] Destination buffer.
+ * @param dest_stride	[in] Destination stride, in bytes. (must be >= width * 4)
+ * @param layout	[in] Destination pixel layout.
+ * @param img		[in] rp_image.
+ * @param flags		[in] ConvFlags bitfield.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int convert(uint32_t *px_dest, int dest_stride, DestLayout layout,
+	const rp_image *img, unsigned int flags = CONV_NONE);
+
+/** Internal conversion kernels. Use convert() instead. **/
+
+/**
+ * Convert ARGB32 image data to ABGR32. (R/B channel swap)
+ * Standard version using regular C++ code.
+ * @param px_dest	[out] Destination buffer.
+ * @param dest_stride	[in] Destination stride, in bytes.
+ * @param img		[in] rp_image. (must be FORMAT_ARGB32)
+ */
+void argb32_to_abgr32_cpp(uint32_t *px_dest, int dest_stride, const rp_image *img);
+
+#ifdef IMAGECONV_HAS_SSSE3
+/**
+ * Convert ARGB32 image data to ABGR32. (R/B channel swap)
+ * SSSE3-optimized version.
+ * @param px_dest	[out] Destination buffer.
+ * @param dest_stride	[in] Destination stride, in bytes.
+ * @param img		[in] rp_image. (must be FORMAT_ARGB32)
+ */
+void argb32_to_abgr32_ssse3(uint32_t *px_dest, int dest_stride, const rp_image *img);
+#endif /* IMAGECONV_HAS_SSSE3 */
+
+#ifdef IMAGECONV_HAS_AVX2
+/**
+ * Convert ARGB32 image data to ABGR32. (R/B channel swap)
+ * AVX2-optimized version.
+ * @param px_dest	[out] Destination buffer.
+ * @param dest_stride	[in] Destination stride, in bytes.
+ * @param img		[in] rp_image. (must be FORMAT_ARGB32)
+ */
+void argb32_to_abgr32_avx2(uint32_t *px_dest, int dest_stride, const rp_image *img);
+#endif /* IMAGECONV_HAS_AVX2 */
+
+} }
+
+#endif /* __ROMPROPERTIES_LIBRPTEXTURE_IMG_IMAGECONV_HPP__ */
@@ -0,0 +1,79 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * ImageConv_ssse3.cpp: Pixel layout conversion kernels. (SSSE3)           *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "ImageConv.hpp"
+#include "rp_image.hpp"
+
+// SSSE3 headers.
+#include <xmmintrin.h>
+#include <emmintrin.h>
+#include <tmmintrin.h>
+
+namespace LibRpTexture { namespace ImageConv {
+
+/**
+ * Convert ARGB32 image data to ABGR32. (R/B channel swap)
+ * SSSE3-optimized version.
+ * @param px_dest	[out] Destination buffer.
+ * @param dest_stride	[in] Destination stride, in bytes.
+ * @param img		[in] rp_image. (must be FORMAT_ARGB32)
+ */
+void argb32_to_abgr32_ssse3(uint32_t *px_dest, int dest_stride, const rp_image *img)
+{
+	const int width = img->width();
+	const int height = img->height();
+	const uint32_t *img_buf = static_cast<const uint32_t*>(img->bits());
+	const int src_stride_adj = (img->stride() / sizeof(uint32_t)) - width;
+	const int dest_stride_adj = (dest_stride / sizeof(uint32_t)) - width;
+
+	// ABGR shuffle mask.
+	const __m128i shuf_mask = _mm_setr_epi8(2,1,0,3, 6,5,4,7, 10,9,8,11, 14,13,12,15);
+
+	for (int y = height; y > 0; y--) {
+		// Process 16 pixels per iteration using SSSE3.
+		// NOTE: The destination buffer is provided by the caller
+		// and is only guaranteed to be 4-byte aligned, so
+		// unaligned stores are required.
+		int x = width;
+		for (; x > 15; x -= 16, px_dest += 16, img_buf += 16) {
+			const __m128i *xmm_src = reinterpret_cast<const __m128i*>(img_buf);
+			__m128i *xmm_dest = reinterpret_cast<__m128i*>(px_dest);
+
+			__m128i sa = _mm_loadu_si128(&xmm_src[0]);
+			__m128i sb = _mm_loadu_si128(&xmm_src[1]);
+			__m128i sc = _mm_loadu_si128(&xmm_src[2]);
+			__m128i sd = _mm_loadu_si128(&xmm_src[3]);
+
+			__m128i val = _mm_shuffle_epi8(sa, shuf_mask);
+			_mm_storeu_si128(&xmm_dest[0], val);
+
+			val = _mm_shuffle_epi8(sb, shuf_mask);
+			_mm_storeu_si128(&xmm_dest[1], val);
+
+			val = _mm_shuffle_epi8(sc, shuf_mask);
+			_mm_storeu_si128(&xmm_dest[2], val);
+
+			val = _mm_shuffle_epi8(sd, shuf_mask);
+			_mm_storeu_si128(&xmm_dest[3], val);
+		}
+
+		// Remaining pixels.
+		for (; x > 0; x--, img_buf++, px_dest++) {
+			*px_dest = (*img_buf & 0xFF00FF00) |
+				  ((*img_buf & 0x00FF0000) >> 16) |
+				  ((*img_buf & 0x000000FF) << 16);
+		}
+
+		// Next line.
+		img_buf += src_stride_adj;
+		px_dest += dest_stride_adj;
+	}
+}
+
+} }
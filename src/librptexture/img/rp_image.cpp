@@ -11,11 +11,62 @@
 #include "rp_image_p.hpp"
 #include "rp_image_backend.hpp"
 
+// librpfile
+#include "librpfile/RpStats.hpp"
+namespace RpStats = LibRpFile::RpStats;
+
+// C++ includes.
+#include <atomic>
+
 // Workaround for RP_D() expecting the no-underscore, UpperCamelCase naming convention.
 #define rp_imagePrivate rp_image_private
 
 namespace LibRpTexture {
 
+/** Pixel allocation budget **/
+
+// Process-wide pixel allocation budget. 0 == unlimited.
+static std::atomic<size_t> g_allocBudget(0);
+// Pixel buffer bytes currently charged against the budget.
+static std::atomic<size_t> g_allocUsed(0);
+
+/**
+ * Charge a pixel buffer allocation against the budget.
+ * @param bytes Allocation size, in bytes.
+ * @return True if the allocation fits in the budget; false if it was rejected.
+ */
+static bool budget_charge(size_t bytes)
+{
+	const size_t budget = g_allocBudget.load(std::memory_order_relaxed);
+	if (budget == 0) {
+		// No budget is set. Track usage anyway so
+		// allocBudgetUsed() stays accurate.
+		g_allocUsed.fetch_add(bytes, std::memory_order_relaxed);
+		return true;
+	}
+
+	// CAS loop: only charge if the allocation fits.
+	size_t used = g_allocUsed.load(std::memory_order_relaxed);
+	do {
+		if (bytes > budget || used > budget - bytes) {
+			// Over budget. Reject the allocation.
+			RpStats::increment(RpStats::CTR_IMG_BUDGET_REJECT);
+			return false;
+		}
+	} while (!g_allocUsed.compare_exchange_weak(used, used + bytes,
+		std::memory_order_relaxed));
+	return true;
+}
+
+/**
+ * Release a previously-charged pixel buffer allocation.
+ * @param bytes Allocation size, in bytes.
+ */
+static void budget_release(size_t bytes)
+{
+	g_allocUsed.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
 /** rp_image_backend_default **/
 
 class rp_image_backend_default : public rp_image_backend
@@ -72,6 +123,11 @@ class rp_image_backend_default : public rp_image_backend
 		void *m_data;
 		size_t m_data_len;
 
+		// Bytes charged against the allocation budget.
+		// NOTE: Not reduced by shrink(), since shrink()
+		// doesn't reallocate the pixel buffer.
+		size_t m_budget_charged;
+
 		uint32_t *m_palette;
 		int m_palette_len;
 };
@@ -80,6 +136,7 @@ rp_image_backend_default::rp_image_backend_default(int width, int height, rp_ima
 	: super(width, height, format)
 	, m_data(nullptr)
 	, m_data_len(0)
+	, m_budget_charged(0)
 	, m_palette(nullptr)
 	, m_palette_len(0)
 {
@@ -100,6 +157,17 @@ rp_image_backend_default::rp_image_backend_default(int width, int height, rp_ima
 		return;
 	}
 
+	// Charge the pixel buffer against the allocation budget.
+	// NOTE: No assertion here; a budget rejection is an expected
+	// failure mode for malformed headers with absurd dimensions.
+	if (!budget_charge(m_data_len)) {
+		// Over budget.
+		m_data_len = 0;
+		clear_properties();
+		return;
+	}
+	m_budget_charged = m_data_len;
+
 	m_data = aligned_malloc(16, m_data_len);
 	assert(m_data != nullptr);
 	if (!m_data) {
@@ -132,6 +200,7 @@ rp_image_backend_default::rp_image_backend_default(int width, int height, rp_ima
 
 rp_image_backend_default::~rp_image_backend_default()
 {
+	budget_release(m_budget_charged);
 	aligned_free(m_data);
 	aligned_free(m_palette);
 }
@@ -219,7 +288,7 @@ rp_image_private::rp_image_private(rp_image_backend *backend)
 
 rp_image_private::~rp_image_private()
 {
-	delete backend;
+	backend->unref();
 }
 
 /** rp_image **/
@@ -236,7 +305,9 @@ rp_image_private::~rp_image_private()
  */
 rp_image::rp_image(int width, int height, rp_image::Format format)
 	: d_ptr(new rp_image_private(width, height, format))
-{ }
+{
+	RpStats::increment(RpStats::CTR_IMG_ALLOC);
+}
 
 /**
  * Create an rp_image using the specified rp_image_backend.
@@ -247,7 +318,9 @@ rp_image::rp_image(int width, int height, rp_image::Format format)
  */
 rp_image::rp_image(rp_image_backend *backend)
 	: d_ptr(new rp_image_private(backend))
-{ }
+{
+	RpStats::increment(RpStats::CTR_IMG_ALLOC);
+}
 
 rp_image::~rp_image()
 {
@@ -274,6 +347,111 @@ rp_image::rp_image_backend_creator_fn rp_image::backendCreatorFn(void)
 	return rp_image_private::backend_fn;
 }
 
+/** Pixel allocation budget **/
+
+/**
+ * Set the process-wide pixel allocation budget.
+ *
+ * When a budget is set, pixel buffer allocations are charged
+ * against it, and an allocation that would exceed the budget
+ * fails gracefully: the rp_image is constructed, but isValid()
+ * returns false, which callers already handle as an allocation
+ * failure. This keeps a malformed header that declares absurd
+ * dimensions from ballooning the process when the thumbnailer
+ * is running under a tight cgroup memory limit.
+ *
+ * NOTE: The budget is process-wide, so concurrent requests
+ * share it. It only covers the default backend; custom
+ * backends (e.g. RpGdiplusBackend) manage their own storage.
+ *
+ * @param max_bytes Maximum pixel buffer bytes in use at once, or 0 for unlimited. (default)
+ */
+void rp_image::setAllocBudget(size_t max_bytes)
+{
+	g_allocBudget.store(max_bytes, std::memory_order_relaxed);
+}
+
+/**
+ * Get the process-wide pixel allocation budget.
+ * @return Budget, in bytes, or 0 if unlimited.
+ */
+size_t rp_image::allocBudget(void)
+{
+	return g_allocBudget.load(std::memory_order_relaxed);
+}
+
+/**
+ * Get the pixel allocation budget usage.
+ * @return Pixel buffer bytes currently charged against the budget.
+ */
+size_t rp_image::allocBudgetUsed(void)
+{
+	return g_allocUsed.load(std::memory_order_relaxed);
+}
+
+/**
+ * Detach this rp_image from a shared backend.
+ *
+ * Backends are reference-counted, so dup()'d images share
+ * one pixel buffer until a writer detaches. (copy-on-write)
+ * Called by the non-const data accessors and mutators.
+ */
+void rp_image::detach(void)
+{
+	RP_D(rp_image);
+	rp_image_backend *const old_backend = d->backend;
+	if (!old_backend->isShared()) {
+		// Backend isn't shared. Nothing to do.
+		return;
+	}
+
+	// Create a new backend.
+	rp_image_backend *new_backend;
+	if (rp_image_private::backend_fn != nullptr) {
+		new_backend = rp_image_private::backend_fn(
+			old_backend->width, old_backend->height, old_backend->format);
+	} else {
+		new_backend = new rp_image_backend_default(
+			old_backend->width, old_backend->height, old_backend->format);
+	}
+	assert(new_backend->isValid());
+	if (!new_backend->isValid()) {
+		// Could not allocate the new backend.
+		// Keep the shared backend.
+		new_backend->unref();
+		return;
+	}
+
+	// Copy the image data.
+	// NOTE: Copying one line at a time in case the strides differ.
+	uint8_t *dest = static_cast<uint8_t*>(new_backend->data());
+	const uint8_t *src = static_cast<const uint8_t*>(old_backend->data());
+	const int row_bytes = this->row_bytes();
+	if (new_backend->stride == old_backend->stride) {
+		// Copy the entire image all at once.
+		memcpy(dest, src, old_backend->data_len());
+	} else {
+		// Copy one line at a time.
+		for (int y = old_backend->height; y > 0; y--) {
+			memcpy(dest, src, row_bytes);
+			dest += new_backend->stride;
+			src += old_backend->stride;
+		}
+	}
+
+	// Copy the palette if this is a paletted image.
+	if (old_backend->format == rp_image::FORMAT_CI8) {
+		assert(new_backend->palette_len() >= old_backend->palette_len());
+		memcpy(new_backend->palette(), old_backend->palette(),
+			old_backend->palette_len() * sizeof(uint32_t));
+	}
+	new_backend->tr_idx = old_backend->tr_idx;
+
+	// Switch to the new backend.
+	d->backend = new_backend;
+	old_backend->unref();
+}
+
 /**
  * Get this image's backend object.
  * @return Image backend object.
@@ -381,12 +559,12 @@ const void *rp_image::bits(void) const
 
 /**
  * Get a pointer to the first line of image data.
- * TODO: detach()
  * @return Image data.
  */
 void *rp_image::bits(void)
 {
 	RP_D(rp_image);
+	detach();
 	return d->backend->data();
 }
 
@@ -407,13 +585,13 @@ const void *rp_image::scanLine(int i) const
 
 /**
  * Get a pointer to the specified line of image data.
- * TODO: Detach.
  * @param i Line number.
  * @return Line of image data, or nullptr if i is out of range.
  */
 void *rp_image::scanLine(int i)
 {
 	RP_D(rp_image);
+	detach();
 	uint8_t *data = static_cast<uint8_t*>(d->backend->data());
 	if (!data)
 		return nullptr;
@@ -421,6 +599,44 @@ void *rp_image::scanLine(int i)
 	return data + (d->backend->stride * i);
 }
 
+/**
+ * Get a pinned read-only view of the pixel data.
+ * @return Read-only view.
+ */
+rp_image::const_view_t rp_image::view(void) const
+{
+	RP_D(const rp_image);
+	const rp_image_backend *const backend = d->backend;
+	const_view_t view = {
+		static_cast<const uint8_t*>(backend->data()),
+		backend->stride,
+		backend->width,
+		backend->height,
+	};
+	return view;
+}
+
+/**
+ * Get a pinned writable view of the pixel data.
+ * detach() is called once, up front, so per-row
+ * accesses through the view don't re-check the
+ * backend's share count.
+ * @return Writable view.
+ */
+rp_image::view_t rp_image::view(void)
+{
+	RP_D(rp_image);
+	detach();
+	rp_image_backend *const backend = d->backend;
+	view_t view = {
+		static_cast<uint8_t*>(backend->data()),
+		backend->stride,
+		backend->width,
+		backend->height,
+	};
+	return view;
+}
+
 /**
  * Get the image data size, in bytes.
  * This is height * stride.
@@ -449,6 +665,7 @@ const uint32_t *rp_image::palette(void) const
 uint32_t *rp_image::palette(void)
 {
 	RP_D(rp_image);
+	detach();
 	return d->backend->palette();
 }
 
@@ -493,6 +710,7 @@ void rp_image::set_tr_idx(int tr_idx)
 	if (d->backend->format == FORMAT_CI8 &&
 	    tr_idx >= -1 && tr_idx < d->backend->palette_len())
 	{
+		detach();
 		d->backend->tr_idx = tr_idx;
 	}
 }
@@ -21,6 +21,7 @@
 # include "librpcpu/cpuflags_x86.h"
 # define RP_IMAGE_HAS_SSE2 1
 # define RP_IMAGE_HAS_SSE41 1
+# define RP_IMAGE_HAS_AVX2 1
 #endif
 #ifdef RP_CPU_AMD64
 # define RP_IMAGE_ALWAYS_HAS_SSE2 1
@@ -92,6 +93,16 @@ class rp_image
 		friend class rp_image_private;
 		rp_image_private *const d_ptr;
 
+	private:
+		/**
+		 * Detach this rp_image from a shared backend.
+		 *
+		 * Backends are reference-counted, so dup()'d images share
+		 * one pixel buffer until a writer detaches. (copy-on-write)
+		 * Called by the non-const data accessors and mutators.
+		 */
+		void detach(void);
+
 	public:
 		/**
 		* Inverted pre-multiplication factors.
@@ -119,6 +130,40 @@ class rp_image
 		 */
 		static rp_image_backend_creator_fn backendCreatorFn(void);
 
+	public:
+		/** Pixel allocation budget **/
+
+		/**
+		 * Set the process-wide pixel allocation budget.
+		 *
+		 * When a budget is set, pixel buffer allocations are charged
+		 * against it, and an allocation that would exceed the budget
+		 * fails gracefully: the rp_image is constructed, but isValid()
+		 * returns false, which callers already handle as an allocation
+		 * failure. This keeps a malformed header that declares absurd
+		 * dimensions from ballooning the process when the thumbnailer
+		 * is running under a tight cgroup memory limit.
+		 *
+		 * NOTE: The budget is process-wide, so concurrent requests
+		 * share it. It only covers the default backend; custom
+		 * backends (e.g. RpGdiplusBackend) manage their own storage.
+		 *
+		 * @param max_bytes Maximum pixel buffer bytes in use at once, or 0 for unlimited. (default)
+		 */
+		static void setAllocBudget(size_t max_bytes);
+
+		/**
+		 * Get the process-wide pixel allocation budget.
+		 * @return Budget, in bytes, or 0 if unlimited.
+		 */
+		static size_t allocBudget(void);
+
+		/**
+		 * Get the pixel allocation budget usage.
+		 * @return Pixel buffer bytes currently charged against the budget.
+		 */
+		static size_t allocBudgetUsed(void);
+
 	public:
 		/**
 		 * Get this image's backend object.
@@ -208,6 +253,110 @@ class rp_image
 		 */
 		size_t data_len(void) const;
 
+		/**
+		 * Pinned read-only view of the pixel data.
+		 *
+		 * The base pointer, stride, and dimensions are fetched
+		 * from the backend once, so tight pixel loops don't pay
+		 * a virtual backend call per row the way repeated
+		 * scanLine() calls do.
+		 *
+		 * The view is only valid while the rp_image exists and
+		 * is not written to.
+		 */
+		struct const_view_t {
+			const uint8_t *base;	// First scanline.
+			int stride;		// Stride, in bytes.
+			int width;		// Image width, in pixels.
+			int height;		// Image height, in pixels.
+
+			/**
+			 * Is this view valid?
+			 * @return True if valid; false if not.
+			 */
+			bool isValid(void) const
+			{
+				return (base != nullptr);
+			}
+
+			/**
+			 * Get a typed pointer to a scanline.
+			 * @param y Line number.
+			 * @return Scanline.
+			 */
+			template<typename T>
+			const T *row(int y) const
+			{
+				return reinterpret_cast<const T*>(base + (static_cast<size_t>(stride) * y));
+			}
+
+			/**
+			 * Get the stride in pixels for pointer arithmetic.
+			 * @return Stride, in T units.
+			 */
+			template<typename T>
+			int stride_px(void) const
+			{
+				return stride / static_cast<int>(sizeof(T));
+			}
+		};
+
+		/**
+		 * Pinned writable view of the pixel data.
+		 * See const_view_t for details.
+		 */
+		struct view_t {
+			uint8_t *base;		// First scanline.
+			int stride;		// Stride, in bytes.
+			int width;		// Image width, in pixels.
+			int height;		// Image height, in pixels.
+
+			/**
+			 * Is this view valid?
+			 * @return True if valid; false if not.
+			 */
+			bool isValid(void) const
+			{
+				return (base != nullptr);
+			}
+
+			/**
+			 * Get a typed pointer to a scanline.
+			 * @param y Line number.
+			 * @return Scanline.
+			 */
+			template<typename T>
+			T *row(int y) const
+			{
+				return reinterpret_cast<T*>(base + (static_cast<size_t>(stride) * y));
+			}
+
+			/**
+			 * Get the stride in pixels for pointer arithmetic.
+			 * @return Stride, in T units.
+			 */
+			template<typename T>
+			int stride_px(void) const
+			{
+				return stride / static_cast<int>(sizeof(T));
+			}
+		};
+
+		/**
+		 * Get a pinned read-only view of the pixel data.
+		 * @return Read-only view.
+		 */
+		const_view_t view(void) const;
+
+		/**
+		 * Get a pinned writable view of the pixel data.
+		 * detach() is called once, up front, so per-row
+		 * accesses through the view don't re-check the
+		 * backend's share count.
+		 * @return Writable view.
+		 */
+		view_t view(void);
+
 		/**
 		 * Get the image palette.
 		 * @return Pointer to image palette, or nullptr if not a paletted image.
@@ -306,6 +455,23 @@ class rp_image
 		 */
 		rp_image *squared(void) const;
 
+		/**
+		 * Crop the rp_image to a region of interest.
+		 *
+		 * The requested rectangle is clipped to the image bounds.
+		 * Intended for zoom previews over large decoded textures:
+		 * the decode is done once and cached, and each preview
+		 * update only copies the pixels under the cursor instead
+		 * of re-decoding the texture.
+		 *
+		 * @param x ROI left edge.
+		 * @param y ROI top edge.
+		 * @param width ROI width.
+		 * @param height ROI height.
+		 * @return New rp_image with the cropped region, or nullptr on error.
+		 */
+		rp_image *cropped(int x, int y, int width, int height) const;
+
 		/**
 		 * Alignment constants for resized().
 		 *
@@ -359,6 +525,50 @@ class rp_image
 			Alignment alignment = AlignDefault,
 			uint32_t bgColor = 0x00000000) const;
 
+		/**
+		 * Downscale this image using a box filter.
+		 * Standard version using regular C++ code.
+		 *
+		 * Each destination pixel is the average of the source
+		 * pixels it covers, so this is high-quality for
+		 * thumbnailing, unlike nearest-neighbor scaling.
+		 *
+		 * Image must be ARGB32, and the new dimensions must be
+		 * smaller than or equal to the current dimensions.
+		 *
+		 * @param width New width
+		 * @param height New height
+		 * @return New rp_image with a downscaled version of the original, or nullptr on error.
+		 */
+		rp_image *downscaled_box_cpp(int width, int height) const;
+
+#ifdef RP_IMAGE_HAS_SSE41
+		/**
+		 * Downscale this image using a box filter.
+		 * SSE4.1-optimized version.
+		 *
+		 * Image must be ARGB32, and the new dimensions must be
+		 * smaller than or equal to the current dimensions.
+		 *
+		 * @param width New width
+		 * @param height New height
+		 * @return New rp_image with a downscaled version of the original, or nullptr on error.
+		 */
+		rp_image *downscaled_box_sse41(int width, int height) const;
+#endif /* RP_IMAGE_HAS_SSE41 */
+
+		/**
+		 * Downscale this image using a box filter.
+		 *
+		 * Image must be ARGB32, and the new dimensions must be
+		 * smaller than or equal to the current dimensions.
+		 *
+		 * @param width New width
+		 * @param height New height
+		 * @return New rp_image with a downscaled version of the original, or nullptr on error.
+		 */
+		inline rp_image *downscaled_box(int width, int height) const;
+
 		/**
 		 * Un-premultiply this image.
 		 * Standard version using regular C++ code.
@@ -381,6 +591,18 @@ class rp_image
 		int un_premultiply_sse41(void);
 #endif /* RP_IMAGE_HAS_SSE41 */
 
+#ifdef RP_IMAGE_HAS_AVX2
+		/**
+		 * Un-premultiply this image.
+		 * AVX2-optimized version.
+		 *
+		 * Image must be ARGB32.
+		 *
+		 * @return 0 on success; non-zero on error.
+		 */
+		int un_premultiply_avx2(void);
+#endif /* RP_IMAGE_HAS_AVX2 */
+
 		/**
 		 * Un-premultiply this image.
 		 *
@@ -449,6 +671,58 @@ class rp_image
 		 */
 		inline int apply_chroma_key(uint32_t key);
 
+		/**
+		 * Analyze the image to determine the significant bits
+		 * per channel and whether the alpha channel is used.
+		 * Standard version using regular C++ code.
+		 *
+		 * Use this as a fallback when the decoder didn't
+		 * provide sBIT metadata. If no pixel has alpha != 255,
+		 * sBIT->alpha is set to 0, which allows RpPngWriter
+		 * to write an RGB image without an alpha channel.
+		 *
+		 * NOTE: The image *must* be ARGB32.
+		 *
+		 * @param sBIT	[out] sBIT_t struct.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int analyze_sBIT_cpp(sBIT_t *sBIT) const;
+
+#ifdef RP_IMAGE_HAS_SSE2
+		/**
+		 * Analyze the image to determine the significant bits
+		 * per channel and whether the alpha channel is used.
+		 * SSE2-optimized version.
+		 *
+		 * Use this as a fallback when the decoder didn't
+		 * provide sBIT metadata. If no pixel has alpha != 255,
+		 * sBIT->alpha is set to 0, which allows RpPngWriter
+		 * to write an RGB image without an alpha channel.
+		 *
+		 * NOTE: The image *must* be ARGB32.
+		 *
+		 * @param sBIT	[out] sBIT_t struct.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		int analyze_sBIT_sse2(sBIT_t *sBIT) const;
+#endif /* RP_IMAGE_HAS_SSE2 */
+
+		/**
+		 * Analyze the image to determine the significant bits
+		 * per channel and whether the alpha channel is used.
+		 *
+		 * Use this as a fallback when the decoder didn't
+		 * provide sBIT metadata. If no pixel has alpha != 255,
+		 * sBIT->alpha is set to 0, which allows RpPngWriter
+		 * to write an RGB image without an alpha channel.
+		 *
+		 * NOTE: The image *must* be ARGB32.
+		 *
+		 * @param sBIT	[out] sBIT_t struct.
+		 * @return 0 on success; negative POSIX error code on error.
+		 */
+		inline int analyze_sBIT(sBIT_t *sBIT) const;
+
 		/**
 		 * Vertically flip the image.
 		 *
@@ -478,16 +752,44 @@ class rp_image
 inline int rp_image::un_premultiply(void)
 {
 	// FIXME: Figure out how to get IFUNC working with  C++ member functions.
+#ifdef RP_IMAGE_HAS_AVX2
+	if (RP_CPU_HasAVX2()) {
+		return un_premultiply_avx2();
+	} else
+#endif /* RP_IMAGE_HAS_AVX2 */
 #ifdef RP_IMAGE_HAS_SSE41
 	if (RP_CPU_HasSSE41()) {
 		return un_premultiply_sse41();
 	} else
-#endif /* RP_IMAGE_HAS_SSE2 */
+#endif /* RP_IMAGE_HAS_SSE41 */
 	{
 		return un_premultiply_cpp();
 	}
 }
 
+/**
+ * Downscale this image using a box filter.
+ *
+ * Image must be ARGB32, and the new dimensions must be
+ * smaller than or equal to the current dimensions.
+ *
+ * @param width New width
+ * @param height New height
+ * @return New rp_image with a downscaled version of the original, or nullptr on error.
+ */
+inline rp_image *rp_image::downscaled_box(int width, int height) const
+{
+	// FIXME: Figure out how to get IFUNC working with  C++ member functions.
+#ifdef RP_IMAGE_HAS_SSE41
+	if (RP_CPU_HasSSE41()) {
+		return downscaled_box_sse41(width, height);
+	} else
+#endif /* RP_IMAGE_HAS_SSE41 */
+	{
+		return downscaled_box_cpp(width, height);
+	}
+}
+
 /**
  * Convert a chroma-keyed image to standard ARGB32.
  *
@@ -517,6 +819,38 @@ inline int rp_image::apply_chroma_key(uint32_t key)
 #endif /* RP_IMAGE_ALWAYS_HAS_SSE2 */
 }
 
+/**
+ * Analyze the image to determine the significant bits
+ * per channel and whether the alpha channel is used.
+ *
+ * Use this as a fallback when the decoder didn't
+ * provide sBIT metadata. If no pixel has alpha != 255,
+ * sBIT->alpha is set to 0, which allows RpPngWriter
+ * to write an RGB image without an alpha channel.
+ *
+ * NOTE: The image *must* be ARGB32.
+ *
+ * @param sBIT	[out] sBIT_t struct.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+inline int rp_image::analyze_sBIT(sBIT_t *sBIT) const
+{
+	// FIXME: Figure out how to get IFUNC working with  C++ member functions.
+#if defined(RP_IMAGE_ALWAYS_HAS_SSE2)
+	// amd64 always has SSE2.
+	return analyze_sBIT_sse2(sBIT);
+#else
+# if defined(RP_IMAGE_HAS_SSE2)
+	if (RP_CPU_HasSSE2()) {
+		return analyze_sBIT_sse2(sBIT);
+	} else
+# endif /* RP_IMAGE_HAS_SSE2 */
+	{
+		return analyze_sBIT_cpp(sBIT);
+	}
+#endif /* RP_IMAGE_ALWAYS_HAS_SSE2 */
+}
+
 }
 
 #endif /* __ROMPROPERTIES_LIBRPTEXTURE_RP_IMAGE_HPP__ */
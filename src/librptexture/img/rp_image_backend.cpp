@@ -9,6 +9,9 @@
 #include "stdafx.h"
 #include "rp_image_backend.hpp"
 
+// librpthreads
+#include "librpthreads/Atomics.h"
+
 namespace LibRpTexture {
 
 /** rp_image_backend **/
@@ -35,6 +38,7 @@ rp_image_backend::rp_image_backend(int width, int height, rp_image::Format forma
 	, stride(0)
 	, format(format)
 	, tr_idx(-1)
+	, ref_cnt(1)
 {
 	// Sanity check: Maximum of 32768x32768.
 	// Also make sure the format is valid.
@@ -69,6 +73,43 @@ rp_image_backend::rp_image_backend(int width, int height, rp_image::Format forma
 rp_image_backend::~rp_image_backend()
 { }
 
+/**
+ * Take a reference to this rp_image_backend.
+ *
+ * Backends are reference-counted so multiple rp_image
+ * objects can share one pixel buffer. The buffer is
+ * copied when a writer detaches. (copy-on-write)
+ *
+ * @return this
+ */
+rp_image_backend *rp_image_backend::ref(void)
+{
+	ATOMIC_INC_FETCH(&ref_cnt);
+	return this;
+}
+
+/**
+ * Unreference this rp_image_backend.
+ * If ref_cnt reaches 0, the rp_image_backend is deleted.
+ */
+void rp_image_backend::unref(void)
+{
+	assert(ref_cnt > 0);
+	if (ATOMIC_DEC_FETCH(&ref_cnt) <= 0) {
+		// All references removed.
+		delete this;
+	}
+}
+
+/**
+ * Is this rp_image_backend shared by multiple rp_image objects?
+ * @return True if ref_cnt is greater than 1; false if not.
+ */
+bool rp_image_backend::isShared(void) const
+{
+	return (ref_cnt > 1);
+}
+
 bool rp_image_backend::isValid(void) const
 {
 	return (width > 0 && height > 0 && stride > 0 &&
@@ -28,6 +28,30 @@ class rp_image_backend
 	public:
 		bool isValid(void) const;
 
+	public:
+		/**
+		 * Take a reference to this rp_image_backend.
+		 *
+		 * Backends are reference-counted so multiple rp_image
+		 * objects can share one pixel buffer. The buffer is
+		 * copied when a writer detaches. (copy-on-write)
+		 *
+		 * @return this
+		 */
+		rp_image_backend *ref(void);
+
+		/**
+		 * Unreference this rp_image_backend.
+		 * If ref_cnt reaches 0, the rp_image_backend is deleted.
+		 */
+		void unref(void);
+
+		/**
+		 * Is this rp_image_backend shared by multiple rp_image objects?
+		 * @return True if ref_cnt is greater than 1; false if not.
+		 */
+		bool isShared(void) const;
+
 	protected:
 		/**
 		 * Clear the width, height, stride, and format properties.
@@ -67,6 +91,10 @@ class rp_image_backend
 		virtual int palette_len(void) const = 0;
 		int tr_idx;
 
+	private:
+		// Reference count.
+		volatile int ref_cnt;
+
 	public:
 		// Subclasses can have other stuff here.
 		// Use dynamic_cast<> to access it.
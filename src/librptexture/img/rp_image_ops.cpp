@@ -23,52 +23,22 @@ namespace LibRpTexture {
 
 /**
  * Duplicate the rp_image.
+ *
+ * The pixel data is shared with this image until one of
+ * the images is written to. (copy-on-write)
+ *
  * @return New rp_image with a copy of the image data.
  */
 rp_image *rp_image::dup(void) const
 {
 	RP_D(const rp_image);
-	const int width = d->backend->width;
-	const int height = d->backend->height;
-	const rp_image::Format format = d->backend->format;
-	assert(width > 0);
-	assert(height > 0);
+	assert(d->backend->width > 0);
+	assert(d->backend->height > 0);
 
-	rp_image *img = new rp_image(width, height, format);
-	if (!img->isValid()) {
-		// Image is invalid. Return it immediately.
-		return img;
-	}
-
-	// Copy the image.
-	// NOTE: Using uint8_t* because stride is measured in bytes.
-	uint8_t *dest = static_cast<uint8_t*>(img->bits());
-	const uint8_t *src = static_cast<const uint8_t*>(d->backend->data());
-	const int row_bytes = img->row_bytes();
-	const int dest_stride = img->stride();
-	const int src_stride = d->backend->stride;
-
-	if (src_stride == dest_stride) {
-		// Copy the entire image all at once.
-		size_t len = d->backend->data_len();
-		memcpy(dest, src, len);
-	} else {
-		// Copy one line at a time.
-		for (unsigned int y = static_cast<unsigned int>(height); y > 0; y--) {
-			memcpy(dest, src, row_bytes);
-			dest += dest_stride;
-			src += src_stride;
-		}
-	}
-
-	// If CI8, copy the palette.
-	if (format == rp_image::FORMAT_CI8) {
-		int entries = std::min(img->palette_len(), d->backend->palette_len());
-		uint32_t *const dest_pal = img->palette();
-		memcpy(dest_pal, d->backend->palette(), entries * sizeof(uint32_t));
-		// Palette is zero-initialized, so we don't need to
-		// zero remaining entries.
-	}
+	// Share the backend with the new image.
+	// The backend is reference-counted, and the pixel data
+	// is only copied if one of the images is written to.
+	rp_image *const img = new rp_image(d->backend->ref());
 
 	// Copy sBIT if it's set.
 	if (d->has_sBIT) {
@@ -113,11 +83,13 @@ rp_image *rp_image::dup_ARGB32(void) const
 	}
 
 	// Copy the image, converting from CI8 to ARGB32.
-	uint32_t *dest = static_cast<uint32_t*>(img->bits());
-	const uint8_t *src = static_cast<const uint8_t*>(d->backend->data());
+	const view_t dest_view = img->view();
+	const const_view_t src_view = this->view();
+	uint32_t *dest = dest_view.row<uint32_t>(0);
+	const uint8_t *src = src_view.row<uint8_t>(0);
 	const uint32_t *pal = d->backend->palette();
-	const int dest_adj = (img->stride() / 4) - width;
-	const int src_adj = d->backend->stride - width;
+	const int dest_adj = dest_view.stride_px<uint32_t>() - width;
+	const int src_adj = src_view.stride - width;
 
 	for (unsigned int y = static_cast<unsigned int>(height); y > 0; y--) {
 		// Convert up to 4 pixels per loop iteration.
@@ -277,6 +249,107 @@ rp_image *rp_image::squared(void) const
 	return sq_img;
 }
 
+/**
+ * Crop the rp_image to a region of interest.
+ *
+ * The requested rectangle is clipped to the image bounds.
+ * Intended for zoom previews over large decoded textures:
+ * the decode is done once and cached, and each preview
+ * update only copies the pixels under the cursor instead
+ * of re-decoding the texture.
+ *
+ * @param x ROI left edge.
+ * @param y ROI top edge.
+ * @param width ROI width.
+ * @param height ROI height.
+ * @return New rp_image with the cropped region, or nullptr on error.
+ */
+rp_image *rp_image::cropped(int x, int y, int width, int height) const
+{
+	assert(width > 0);
+	assert(height > 0);
+	if (width <= 0 || height <= 0) {
+		// Cannot crop the image.
+		return nullptr;
+	}
+
+	RP_D(const rp_image);
+	const int orig_width = d->backend->width;
+	const int orig_height = d->backend->height;
+	assert(orig_width > 0);
+	assert(orig_height > 0);
+	if (orig_width <= 0 || orig_height <= 0) {
+		// Cannot crop the image.
+		return nullptr;
+	}
+
+	// Clip the rectangle to the image bounds.
+	if (x < 0) {
+		width += x;
+		x = 0;
+	}
+	if (y < 0) {
+		height += y;
+		y = 0;
+	}
+	if (x + width > orig_width) {
+		width = orig_width - x;
+	}
+	if (y + height > orig_height) {
+		height = orig_height - y;
+	}
+	if (x >= orig_width || y >= orig_height || width <= 0 || height <= 0) {
+		// Rectangle is entirely outside of the image.
+		return nullptr;
+	}
+
+	if (x == 0 && y == 0 && width == orig_width && height == orig_height) {
+		// No crop is necessary.
+		return this->dup();
+	}
+
+	const rp_image::Format format = d->backend->format;
+	rp_image *img = new rp_image(width, height, format);
+	if (!img->isValid()) {
+		// Image is invalid.
+		delete img;
+		return nullptr;
+	}
+
+	// Copy the region.
+	// NOTE: Using uint8_t* because stride is measured in bytes.
+	const int pixel_bytes = (format == rp_image::FORMAT_ARGB32 ? sizeof(uint32_t) : 1);
+	uint8_t *dest = static_cast<uint8_t*>(img->bits());
+	const uint8_t *src = static_cast<const uint8_t*>(d->backend->data()) +
+		(y * d->backend->stride) + (x * pixel_bytes);
+	const int dest_stride = img->stride();
+	const int src_stride = d->backend->stride;
+	const int row_bytes = width * pixel_bytes;
+
+	for (int rows = height; rows > 0; rows--) {
+		memcpy(dest, src, row_bytes);
+		dest += dest_stride;
+		src += src_stride;
+	}
+
+	// If CI8, copy the palette.
+	if (format == rp_image::FORMAT_CI8) {
+		int entries = std::min(img->palette_len(), d->backend->palette_len());
+		uint32_t *const dest_pal = img->palette();
+		memcpy(dest_pal, d->backend->palette(), entries * sizeof(uint32_t));
+		// Palette is zero-initialized, so we don't need to
+		// zero remaining entries.
+	}
+
+	// Copy sBIT if it's set.
+	if (d->has_sBIT) {
+		img->set_sBIT(&d->sBIT);
+	}
+
+	// Image cropped.
+	return img;
+}
+
 /**
  * Resize the rp_image.
  *
@@ -492,6 +565,105 @@ rp_image *rp_image::resized(int width, int height, Alignment alignment, uint32_t
 	return img;
 }
 
+/**
+ * Downscale this image using a box filter.
+ * Standard version using regular C++ code.
+ *
+ * Each destination pixel is the average of the source
+ * pixels it covers, so this is high-quality for
+ * thumbnailing, unlike nearest-neighbor scaling.
+ *
+ * Image must be ARGB32, and the new dimensions must be
+ * smaller than or equal to the current dimensions.
+ *
+ * @param width New width
+ * @param height New height
+ * @return New rp_image with a downscaled version of the original, or nullptr on error.
+ */
+rp_image *rp_image::downscaled_box_cpp(int width, int height) const
+{
+	RP_D(const rp_image);
+	const int orig_width = d->backend->width;
+	const int orig_height = d->backend->height;
+
+	assert(width > 0);
+	assert(height > 0);
+	assert(width <= orig_width);
+	assert(height <= orig_height);
+	if (width <= 0 || height <= 0 ||
+	    width > orig_width || height > orig_height)
+	{
+		// Cannot downscale the image.
+		return nullptr;
+	}
+
+	// TODO: CI8 support? (CI8 images are usually icon-sized already.)
+	assert(d->backend->format == rp_image::FORMAT_ARGB32);
+	if (d->backend->format != rp_image::FORMAT_ARGB32) {
+		// Incorrect format...
+		return nullptr;
+	}
+
+	if (width == orig_width && height == orig_height) {
+		// No downscale is necessary.
+		return this->dup();
+	}
+
+	rp_image *const img = new rp_image(width, height, rp_image::FORMAT_ARGB32);
+	if (!img->isValid()) {
+		// Image is invalid.
+		delete img;
+		return nullptr;
+	}
+
+	const const_view_t src_view = this->view();
+	const view_t dest_view = img->view();
+	const argb32_t *const src = src_view.row<argb32_t>(0);
+	const int src_stride = src_view.stride_px<argb32_t>();
+	argb32_t *dest = dest_view.row<argb32_t>(0);
+	const int dest_stride_adj = dest_view.stride_px<argb32_t>() - width;
+
+	for (int y = 0; y < height; y++, dest += dest_stride_adj) {
+		// Source rows covered by this destination row.
+		const int sy0 = (y * orig_height) / height;
+		const int sy1 = ((y + 1) * orig_height) / height;
+
+		for (int x = 0; x < width; x++, dest++) {
+			// Source columns covered by this destination pixel.
+			const int sx0 = (x * orig_width) / width;
+			const int sx1 = ((x + 1) * orig_width) / width;
+
+			// Sum up the covered source pixels per channel.
+			uint32_t sum_a = 0, sum_r = 0, sum_g = 0, sum_b = 0;
+			const argb32_t *src_row = src + (sy0 * src_stride) + sx0;
+			for (int sy = sy1 - sy0; sy > 0; sy--, src_row += src_stride) {
+				const argb32_t *src_px = src_row;
+				for (int sx = sx1 - sx0; sx > 0; sx--, src_px++) {
+					sum_a += src_px->a;
+					sum_r += src_px->r;
+					sum_g += src_px->g;
+					sum_b += src_px->b;
+				}
+			}
+
+			// Average with rounding.
+			const uint32_t count = (sy1 - sy0) * (sx1 - sx0);
+			dest->a = static_cast<uint8_t>((sum_a + (count / 2)) / count);
+			dest->r = static_cast<uint8_t>((sum_r + (count / 2)) / count);
+			dest->g = static_cast<uint8_t>((sum_g + (count / 2)) / count);
+			dest->b = static_cast<uint8_t>((sum_b + (count / 2)) / count);
+		}
+	}
+
+	// Copy sBIT if it's set.
+	if (d->has_sBIT) {
+		img->set_sBIT(&d->sBIT);
+	}
+
+	// Image downscaled.
+	return img;
+}
+
 /**
  * Convert a chroma-keyed image to standard ARGB32.
  * Standard version using regular C++ code.
@@ -507,18 +679,21 @@ rp_image *rp_image::resized(int width, int height, Alignment alignment, uint32_t
 int rp_image::apply_chroma_key_cpp(uint32_t key)
 {
 	RP_D(rp_image);
-	rp_image_backend *const backend = d->backend;
-	assert(backend->format == FORMAT_ARGB32);
-	if (backend->format != FORMAT_ARGB32) {
+	assert(d->backend->format == FORMAT_ARGB32);
+	if (d->backend->format != FORMAT_ARGB32) {
 		// ARGB32 only.
 		return -EINVAL;
 	}
 
-	const unsigned int diff = (backend->stride - this->row_bytes()) / sizeof(uint32_t);
-	uint32_t *img_buf = static_cast<uint32_t*>(backend->data());
+	// Writing the pixel data in place.
+	// view() detaches from any shared backend. (copy-on-write)
+	const view_t view = this->view();
 
-	for (unsigned int y = static_cast<unsigned int>(backend->height); y > 0; y--) {
-		unsigned int x = static_cast<unsigned int>(backend->width);
+	const unsigned int diff = (view.stride - this->row_bytes()) / sizeof(uint32_t);
+	uint32_t *img_buf = view.row<uint32_t>(0);
+
+	for (unsigned int y = static_cast<unsigned int>(view.height); y > 0; y--) {
+		unsigned int x = static_cast<unsigned int>(view.width);
 		for (; x > 1; x -= 2, img_buf += 2) {
 			// Check for chroma key pixels.
 			if (img_buf[0] == key) {
@@ -550,6 +725,71 @@ int rp_image::apply_chroma_key_cpp(uint32_t key)
 	return 0;
 }
 
+/**
+ * Analyze the image to determine the significant bits
+ * per channel and whether the alpha channel is used.
+ * Standard version using regular C++ code.
+ *
+ * Use this as a fallback when the decoder didn't
+ * provide sBIT metadata. If no pixel has alpha != 255,
+ * sBIT->alpha is set to 0, which allows RpPngWriter
+ * to write an RGB image without an alpha channel.
+ *
+ * NOTE: The image *must* be ARGB32.
+ *
+ * @param sBIT	[out] sBIT_t struct.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int rp_image::analyze_sBIT_cpp(sBIT_t *sBIT) const
+{
+	RP_D(const rp_image);
+	assert(sBIT != nullptr);
+	assert(d->backend->format == FORMAT_ARGB32);
+	if (!sBIT || d->backend->format != FORMAT_ARGB32) {
+		// ARGB32 only.
+		return -EINVAL;
+	}
+
+	const const_view_t view = this->view();
+	const unsigned int diff = (view.stride - this->row_bytes()) / sizeof(uint32_t);
+	const uint32_t *img_buf = view.row<uint32_t>(0);
+
+	// OR of all pixels determines the significant bits per channel;
+	// AND of all pixels determines if every pixel is fully opaque.
+	uint32_t px_or = 0;
+	uint32_t px_and = ~0U;
+
+	for (unsigned int y = static_cast<unsigned int>(view.height); y > 0; y--) {
+		unsigned int x = static_cast<unsigned int>(view.width);
+		for (; x > 1; x -= 2, img_buf += 2) {
+			px_or  |= img_buf[0] | img_buf[1];
+			px_and &= img_buf[0] & img_buf[1];
+		}
+
+		if (x == 1) {
+			px_or  |= *img_buf;
+			px_and &= *img_buf;
+			img_buf++;
+		}
+
+		// Next row.
+		img_buf += diff;
+	}
+
+	// Significant bits per channel. (minimum 1)
+	sBIT->red   = static_cast<uint8_t>(uilog2((px_or >> 16) & 0xFF) + 1);
+	sBIT->green = static_cast<uint8_t>(uilog2((px_or >>  8) & 0xFF) + 1);
+	sBIT->blue  = static_cast<uint8_t>(uilog2( px_or        & 0xFF) + 1);
+	sBIT->gray = 0;
+	if ((px_and >> 24) == 0xFF) {
+		// All pixels are fully opaque.
+		sBIT->alpha = 0;
+	} else {
+		sBIT->alpha = static_cast<uint8_t>(uilog2(px_or >> 24) + 1);
+	}
+	return 0;
+}
+
 /**
  * Vertically flip the image.
  *
@@ -601,6 +841,7 @@ rp_image *rp_image::vflip(void) const
 int rp_image::shrink(int width, int height)
 {
 	RP_D(rp_image);
+	detach();
 	return d->backend->shrink(width, height);
 }
 
@@ -37,13 +37,18 @@ namespace LibRpTexture {
 int rp_image::apply_chroma_key_sse2(uint32_t key)
 {
 	RP_D(rp_image);
-	rp_image_backend *const backend = d->backend;
+	rp_image_backend *backend = d->backend;
 	assert(backend->format == FORMAT_ARGB32);
 	if (backend->format != FORMAT_ARGB32) {
 		// ARGB32 only.
 		return -EINVAL;
 	}
 
+	// Writing the pixel data in place, so we need to
+	// detach from any shared backend. (copy-on-write)
+	detach();
+	backend = d->backend;
+
 	const unsigned int diff = (backend->stride - this->row_bytes()) / sizeof(uint32_t);
 	uint32_t *img_buf = static_cast<uint32_t*>(backend->data());
 
@@ -88,4 +93,81 @@ int rp_image::apply_chroma_key_sse2(uint32_t key)
 	return 0;
 }
 
+/**
+ * Analyze the image to determine the significant bits
+ * per channel and whether the alpha channel is used.
+ * SSE2-optimized version.
+ *
+ * Use this as a fallback when the decoder didn't
+ * provide sBIT metadata. If no pixel has alpha != 255,
+ * sBIT->alpha is set to 0, which allows RpPngWriter
+ * to write an RGB image without an alpha channel.
+ *
+ * NOTE: The image *must* be ARGB32.
+ *
+ * @param sBIT	[out] sBIT_t struct.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+int rp_image::analyze_sBIT_sse2(sBIT_t *sBIT) const
+{
+	RP_D(const rp_image);
+	const rp_image_backend *const backend = d->backend;
+	assert(sBIT != nullptr);
+	assert(backend->format == FORMAT_ARGB32);
+	if (!sBIT || backend->format != FORMAT_ARGB32) {
+		// ARGB32 only.
+		return -EINVAL;
+	}
+
+	const unsigned int diff = (backend->stride - this->row_bytes()) / sizeof(uint32_t);
+	const uint32_t *img_buf = static_cast<const uint32_t*>(backend->data());
+
+	// OR of all pixels determines the significant bits per channel;
+	// AND of all pixels determines if every pixel is fully opaque.
+	__m128i xmm_or  = _mm_setzero_si128();
+	__m128i xmm_and = _mm_setr_epi32(0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF);
+	uint32_t px_or = 0;
+	uint32_t px_and = ~0U;
+
+	for (unsigned int y = static_cast<unsigned int>(backend->height); y > 0; y--) {
+		// Process 4 pixels per iteration with SSE2.
+		unsigned int x = static_cast<unsigned int>(backend->width);
+		for (; x > 3; x -= 4, img_buf += 4) {
+			const __m128i *xmm_data = reinterpret_cast<const __m128i*>(img_buf);
+			xmm_or  = _mm_or_si128(xmm_or, *xmm_data);
+			xmm_and = _mm_and_si128(xmm_and, *xmm_data);
+		}
+
+		// Remaining pixels.
+		for (; x > 0; x--, img_buf++) {
+			px_or  |= *img_buf;
+			px_and &= *img_buf;
+		}
+
+		// Next row.
+		img_buf += diff;
+	}
+
+	// Fold the vector accumulators down to 32 bits.
+	xmm_or  = _mm_or_si128(xmm_or,  _mm_srli_si128(xmm_or, 8));
+	xmm_or  = _mm_or_si128(xmm_or,  _mm_srli_si128(xmm_or, 4));
+	xmm_and = _mm_and_si128(xmm_and, _mm_srli_si128(xmm_and, 8));
+	xmm_and = _mm_and_si128(xmm_and, _mm_srli_si128(xmm_and, 4));
+	px_or  |= static_cast<uint32_t>(_mm_cvtsi128_si32(xmm_or));
+	px_and &= static_cast<uint32_t>(_mm_cvtsi128_si32(xmm_and));
+
+	// Significant bits per channel. (minimum 1)
+	sBIT->red   = static_cast<uint8_t>(uilog2((px_or >> 16) & 0xFF) + 1);
+	sBIT->green = static_cast<uint8_t>(uilog2((px_or >>  8) & 0xFF) + 1);
+	sBIT->blue  = static_cast<uint8_t>(uilog2( px_or        & 0xFF) + 1);
+	sBIT->gray = 0;
+	if ((px_and >> 24) == 0xFF) {
+		// All pixels are fully opaque.
+		sBIT->alpha = 0;
+	} else {
+		sBIT->alpha = static_cast<uint8_t>(uilog2(px_or >> 24) + 1);
+	}
+	return 0;
+}
+
 }
@@ -0,0 +1,124 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * rp_image_ops_sse41.cpp: Image class. (operations)                       *
+ * SSE4.1-optimized version.                                               *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "rp_image.hpp"
+#include "rp_image_p.hpp"
+#include "rp_image_backend.hpp"
+
+// SSE4.1 headers.
+#include <emmintrin.h>
+#include <smmintrin.h>
+
+// Workaround for RP_D() expecting the no-underscore, UpperCamelCase naming convention.
+#define rp_imagePrivate rp_image_private
+
+namespace LibRpTexture {
+
+/** Image operations. **/
+
+/**
+ * Downscale this image using a box filter.
+ * SSE4.1-optimized version.
+ *
+ * Image must be ARGB32, and the new dimensions must be
+ * smaller than or equal to the current dimensions.
+ *
+ * @param width New width
+ * @param height New height
+ * @return New rp_image with a downscaled version of the original, or nullptr on error.
+ */
+rp_image *rp_image::downscaled_box_sse41(int width, int height) const
+{
+	RP_D(const rp_image);
+	const int orig_width = d->backend->width;
+	const int orig_height = d->backend->height;
+
+	assert(width > 0);
+	assert(height > 0);
+	assert(width <= orig_width);
+	assert(height <= orig_height);
+	if (width <= 0 || height <= 0 ||
+	    width > orig_width || height > orig_height)
+	{
+		// Cannot downscale the image.
+		return nullptr;
+	}
+
+	// TODO: CI8 support? (CI8 images are usually icon-sized already.)
+	assert(d->backend->format == rp_image::FORMAT_ARGB32);
+	if (d->backend->format != rp_image::FORMAT_ARGB32) {
+		// Incorrect format...
+		return nullptr;
+	}
+
+	if (width == orig_width && height == orig_height) {
+		// No downscale is necessary.
+		return this->dup();
+	}
+
+	rp_image *const img = new rp_image(width, height, rp_image::FORMAT_ARGB32);
+	if (!img->isValid()) {
+		// Image is invalid.
+		delete img;
+		return nullptr;
+	}
+
+	const uint32_t *const src = static_cast<const uint32_t*>(d->backend->data());
+	const int src_stride = d->backend->stride / sizeof(uint32_t);
+	uint32_t *dest = static_cast<uint32_t*>(img->bits());
+	const int dest_stride_adj = (img->stride() / sizeof(uint32_t)) - width;
+
+	for (int y = 0; y < height; y++, dest += dest_stride_adj) {
+		// Source rows covered by this destination row.
+		const int sy0 = (y * orig_height) / height;
+		const int sy1 = ((y + 1) * orig_height) / height;
+
+		for (int x = 0; x < width; x++, dest++) {
+			// Source columns covered by this destination pixel.
+			const int sx0 = (x * orig_width) / width;
+			const int sx1 = ((x + 1) * orig_width) / width;
+
+			// Sum up the covered source pixels.
+			// Each pixel is widened to one 32-bit lane per channel.
+			__m128i sum = _mm_setzero_si128();
+			const uint32_t *src_row = src + (sy0 * src_stride) + sx0;
+			for (int sy = sy1 - sy0; sy > 0; sy--, src_row += src_stride) {
+				const uint32_t *src_px = src_row;
+				int sx = sx1 - sx0;
+				for (; sx > 1; sx -= 2, src_px += 2) {
+					sum = _mm_add_epi32(sum, _mm_cvtepu8_epi32(_mm_cvtsi32_si128(src_px[0])));
+					sum = _mm_add_epi32(sum, _mm_cvtepu8_epi32(_mm_cvtsi32_si128(src_px[1])));
+				}
+				if (sx == 1) {
+					sum = _mm_add_epi32(sum, _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*src_px)));
+				}
+			}
+
+			// Average using float math, which rounds to nearest
+			// and avoids a per-channel integer division.
+			const int count = (sy1 - sy0) * (sx1 - sx0);
+			const __m128 scale = _mm_set1_ps(1.0f / static_cast<float>(count));
+			__m128i avg = _mm_cvtps_epi32(_mm_mul_ps(_mm_cvtepi32_ps(sum), scale));
+			avg = _mm_packus_epi32(avg, avg);
+			avg = _mm_packus_epi16(avg, avg);
+			*dest = _mm_cvtsi128_si32(avg);
+		}
+	}
+
+	// Copy sBIT if it's set.
+	if (d->has_sBIT) {
+		img->set_sBIT(&d->sBIT);
+	}
+
+	// Image downscaled.
+	return img;
+}
+
+}
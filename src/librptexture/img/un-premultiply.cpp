@@ -95,18 +95,21 @@ static FORCEINLINE uint32_t un_premultiply_pixel(uint32_t px)
  */
 int rp_image::un_premultiply_cpp(void)
 {
-	RP_D(const rp_image);
-	rp_image_backend *const backend = d->backend;
-	assert(backend->format == rp_image::FORMAT_ARGB32);
-	if (backend->format != rp_image::FORMAT_ARGB32) {
+	RP_D(rp_image);
+	assert(d->backend->format == rp_image::FORMAT_ARGB32);
+	if (d->backend->format != rp_image::FORMAT_ARGB32) {
 		// Incorrect format...
 		return -1;
 	}
 
-	const int width = backend->width;
-	argb32_t *px_dest = static_cast<argb32_t*>(backend->data());
-	int dest_stride_adj = (backend->stride / sizeof(*px_dest)) - width;
-	for (int y = backend->height; y > 0; y--, px_dest += dest_stride_adj) {
+	// Writing the pixel data in place.
+	// view() detaches from any shared backend. (copy-on-write)
+	const view_t view = this->view();
+
+	const int width = view.width;
+	argb32_t *px_dest = view.row<argb32_t>(0);
+	const int dest_stride_adj = view.stride_px<argb32_t>() - width;
+	for (int y = view.height; y > 0; y--, px_dest += dest_stride_adj) {
 		int x = width;
 		for (; x > 1; x -= 2, px_dest += 2) {
 			px_dest[0].u32 = un_premultiply_pixel(px_dest[0].u32);
@@ -168,18 +171,21 @@ int rp_image::premultiply(void)
 {
 	// TODO: Qt doesn't have SSE-optimized builds.
 
-	RP_D(const rp_image);
-	rp_image_backend *const backend = d->backend;
-	assert(backend->format == rp_image::FORMAT_ARGB32);
-	if (backend->format != rp_image::FORMAT_ARGB32) {
+	RP_D(rp_image);
+	assert(d->backend->format == rp_image::FORMAT_ARGB32);
+	if (d->backend->format != rp_image::FORMAT_ARGB32) {
 		// Incorrect format...
 		return -1;
 	}
 
-	const int width = backend->width;
-	argb32_t *px_dest = static_cast<argb32_t*>(backend->data());
-	int dest_stride_adj = (backend->stride / sizeof(*px_dest)) - width;
-	for (int y = backend->height; y > 0; y--, px_dest += dest_stride_adj) {
+	// Writing the pixel data in place.
+	// view() detaches from any shared backend. (copy-on-write)
+	const view_t view = this->view();
+
+	const int width = view.width;
+	argb32_t *px_dest = view.row<argb32_t>(0);
+	const int dest_stride_adj = view.stride_px<argb32_t>() - width;
+	for (int y = view.height; y > 0; y--, px_dest += dest_stride_adj) {
 		int x = width;
 		for (; x > 1; x -= 2, px_dest += 2) {
 			px_dest[0].u32 = premultiply_pixel_inl(px_dest[0].u32);
@@ -0,0 +1,118 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librptexture)                     *
+ * un-premultiply_avx2.cpp: Un-premultiply function.                       *
+ * AVX2-optimized version.                                                 *
+ *                                                                         *
+ * Copyright (c) 2017-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "rp_image.hpp"
+#include "rp_image_p.hpp"
+#include "rp_image_backend.hpp"
+
+// AVX2 headers.
+#include <immintrin.h>
+
+// Workaround for RP_D() expecting the no-underscore, UpperCamelCase naming convention.
+#define rp_imagePrivate rp_image_private
+
+namespace LibRpTexture {
+
+/**
+ * Un-premultiply an argb32_t pixel. (SSE4.1 version)
+ * From qt-5.11.0's qdrawingprimitive_sse2_p.h.
+ * qUnpremultiply_sse4()
+ *
+ * NOTE: Duplicated from un-premultiply_sse41.cpp because this
+ * translation unit is compiled with AVX2 instructions enabled.
+ *
+ * @param px	[in/out] argb32_t pixel to un-premultiply, in place.
+ */
+static FORCEINLINE void un_premultiply_pixel_avx2(argb32_t &px)
+{
+	const unsigned int alpha = px.a;
+	if (alpha == 255 || alpha == 0)
+		return;
+
+	const unsigned int invAlpha = rp_image::qt_inv_premul_factor[alpha];
+	const __m128i via = _mm_set1_epi32(invAlpha);
+	const __m128i vr = _mm_set1_epi32(0x8000);
+	__m128i vl = _mm_cvtepu8_epi32(_mm_cvtsi32_si128(px.u32));
+	vl = _mm_mullo_epi32(vl, via);
+	vl = _mm_add_epi32(vl, vr);
+	vl = _mm_srai_epi32(vl, 16);
+	vl = _mm_insert_epi32(vl, alpha, 3);
+	vl = _mm_packus_epi32(vl, vl);
+	vl = _mm_packus_epi16(vl, vl);
+	px.u32 = _mm_cvtsi128_si32(vl);
+}
+
+/**
+ * Un-premultiply an ARGB32 rp_image.
+ * AVX2-optimized version.
+ * Image must be ARGB32.
+ * @return 0 on success; non-zero on error.
+ */
+int rp_image::un_premultiply_avx2(void)
+{
+	RP_D(rp_image);
+	rp_image_backend *backend = d->backend;
+	assert(backend->format == rp_image::FORMAT_ARGB32);
+	if (backend->format != rp_image::FORMAT_ARGB32) {
+		// Incorrect format...
+		return -1;
+	}
+
+	// Writing the pixel data in place, so we need to
+	// detach from any shared backend. (copy-on-write)
+	detach();
+	backend = d->backend;
+
+	// Alpha mask for the binary-alpha group check.
+	const __m256i alpha32_mask = _mm256_set1_epi32(0xFF000000);
+	const __m256i zero = _mm256_setzero_si256();
+
+	const int width = backend->width;
+	argb32_t *px_dest = static_cast<argb32_t*>(backend->data());
+	int dest_stride_adj = (backend->stride / sizeof(*px_dest)) - width;
+	for (int y = backend->height; y > 0; y--, px_dest += dest_stride_adj) {
+		int x = width;
+
+		// Process 8 pixels per iteration.
+		// If all 8 alpha values are 0x00 or 0xFF, un-premultiply
+		// is a no-op for the whole group, so skip it entirely.
+		// Most DS/GBA icons have binary alpha, so this is the
+		// common case.
+		for (; x > 7; x -= 8, px_dest += 8) {
+			const __m256i px = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(px_dest));
+			const __m256i alpha = _mm256_and_si256(px, alpha32_mask);
+			const __m256i binary = _mm256_or_si256(
+				_mm256_cmpeq_epi32(alpha, alpha32_mask),
+				_mm256_cmpeq_epi32(alpha, zero));
+			if (_mm256_movemask_epi8(binary) == -1) {
+				// All 8 pixels are fully opaque or fully transparent.
+				continue;
+			}
+
+			// At least one pixel has partial alpha.
+			un_premultiply_pixel_avx2(px_dest[0]);
+			un_premultiply_pixel_avx2(px_dest[1]);
+			un_premultiply_pixel_avx2(px_dest[2]);
+			un_premultiply_pixel_avx2(px_dest[3]);
+			un_premultiply_pixel_avx2(px_dest[4]);
+			un_premultiply_pixel_avx2(px_dest[5]);
+			un_premultiply_pixel_avx2(px_dest[6]);
+			un_premultiply_pixel_avx2(px_dest[7]);
+		}
+
+		// Remaining pixels.
+		for (; x > 0; x--, px_dest++) {
+			un_premultiply_pixel_avx2(*px_dest);
+		}
+	}
+	return 0;
+}
+
+}
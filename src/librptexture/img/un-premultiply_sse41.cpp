@@ -56,26 +56,64 @@ static FORCEINLINE void un_premultiply_pixel_sse41(argb32_t &px)
  */
 int rp_image::un_premultiply_sse41(void)
 {
-	RP_D(const rp_image);
-	rp_image_backend *const backend = d->backend;
+	RP_D(rp_image);
+	rp_image_backend *backend = d->backend;
 	assert(backend->format == rp_image::FORMAT_ARGB32);
 	if (backend->format != rp_image::FORMAT_ARGB32) {
 		// Incorrect format...
 		return -1;
 	}
 
+	// Writing the pixel data in place, so we need to
+	// detach from any shared backend. (copy-on-write)
+	detach();
+	backend = d->backend;
+
+	// Alpha mask for the binary-alpha group check.
+	const __m128i alpha32_mask = _mm_set1_epi32(0xFF000000);
+	const __m128i zero = _mm_setzero_si128();
+
 	const int width = backend->width;
 	argb32_t *px_dest = static_cast<argb32_t*>(backend->data());
 	int dest_stride_adj = (backend->stride / sizeof(*px_dest)) - width;
 	for (int y = backend->height; y > 0; y--, px_dest += dest_stride_adj) {
 		int x = width;
-		for (; x > 1; x -= 2, px_dest += 2) {
+
+		// Process 8 pixels per iteration.
+		// If all 8 alpha values are 0x00 or 0xFF, un-premultiply
+		// is a no-op for the whole group, so skip it entirely.
+		// Most DS/GBA icons have binary alpha, so this is the
+		// common case.
+		for (; x > 7; x -= 8, px_dest += 8) {
+			const __m128i px0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&px_dest[0]));
+			const __m128i px1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&px_dest[4]));
+			const __m128i alpha0 = _mm_and_si128(px0, alpha32_mask);
+			const __m128i alpha1 = _mm_and_si128(px1, alpha32_mask);
+			const __m128i binary0 = _mm_or_si128(
+				_mm_cmpeq_epi32(alpha0, alpha32_mask),
+				_mm_cmpeq_epi32(alpha0, zero));
+			const __m128i binary1 = _mm_or_si128(
+				_mm_cmpeq_epi32(alpha1, alpha32_mask),
+				_mm_cmpeq_epi32(alpha1, zero));
+			if (_mm_movemask_epi8(_mm_and_si128(binary0, binary1)) == 0xFFFF) {
+				// All 8 pixels are fully opaque or fully transparent.
+				continue;
+			}
+
+			// At least one pixel has partial alpha.
 			un_premultiply_pixel_sse41(px_dest[0]);
 			un_premultiply_pixel_sse41(px_dest[1]);
+			un_premultiply_pixel_sse41(px_dest[2]);
+			un_premultiply_pixel_sse41(px_dest[3]);
+			un_premultiply_pixel_sse41(px_dest[4]);
+			un_premultiply_pixel_sse41(px_dest[5]);
+			un_premultiply_pixel_sse41(px_dest[6]);
+			un_premultiply_pixel_sse41(px_dest[7]);
 		}
-		if (x == 1) {
+
+		// Remaining pixels.
+		for (; x > 0; x--, px_dest++) {
 			un_premultiply_pixel_sse41(*px_dest);
-			px_dest++;
 		}
 	}
 	return 0;
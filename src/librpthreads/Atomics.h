@@ -42,6 +42,12 @@
 #  define ATOMIC_CMPXCHG(ptr, cmp, xchg)	__sync_val_compare_and_swap(ptr, cmp, xchg);
 #  define ATOMIC_EXCHANGE(ptr, val)		__sync_lock_test_and_set(ptr, val);
 # endif
+ /* clang supports the __atomic builtins regardless of the above. */
+# define ATOMIC_LOAD_ACQUIRE(ptr)		__atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+# define ATOMIC_STORE_RELEASE(ptr, val)		__atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+ /* Relaxed increment / acquire-release decrement for reference counts. */
+# define ATOMIC_INC_FETCH_RELAXED(ptr)		__atomic_add_fetch(ptr, 1, __ATOMIC_RELAXED)
+# define ATOMIC_DEC_FETCH_ACQREL(ptr)		__atomic_sub_fetch(ptr, 1, __ATOMIC_ACQ_REL)
 #elif defined(__GNUC__)
 # if (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7))
    /* gcc-4.7: Use prefixed C11-style atomics. */
@@ -51,6 +57,11 @@
    /* NOTE: C11 version of cmpxchg requires pointers, so we'll use the Itanium-style version. */
 #  define ATOMIC_CMPXCHG(ptr, cmp, xchg)	__sync_val_compare_and_swap(ptr, cmp, xchg)
 #  define ATOMIC_EXCHANGE(ptr, val)		__sync_lock_test_and_set(ptr, val)
+#  define ATOMIC_LOAD_ACQUIRE(ptr)		__atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#  define ATOMIC_STORE_RELEASE(ptr, val)	__atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+   /* Relaxed increment / acquire-release decrement for reference counts. */
+#  define ATOMIC_INC_FETCH_RELAXED(ptr)		__atomic_add_fetch(ptr, 1, __ATOMIC_RELAXED)
+#  define ATOMIC_DEC_FETCH_ACQREL(ptr)		__atomic_sub_fetch(ptr, 1, __ATOMIC_ACQ_REL)
 # else
    /* gcc-4.6 and earlier: Use Itanium-style atomics. */
 #  define ATOMIC_INC_FETCH(ptr)			__sync_add_and_fetch(ptr, 1)
@@ -58,6 +69,16 @@
 #  define ATOMIC_OR_FETCH(ptr, val)		__sync_or_and_fetch(ptr, val)
 #  define ATOMIC_CMPXCHG(ptr, cmp, xchg)	__sync_val_compare_and_swap(ptr, cmp, xchg)
 #  define ATOMIC_EXCHANGE(ptr, val)		__sync_lock_test_and_set(ptr, val)
+   /* No __atomic builtins; use a volatile access plus a full barrier. */
+#  define ATOMIC_LOAD_ACQUIRE(ptr) \
+	({ __typeof__(*(ptr)) _atomic_ld_tmp = *(volatile __typeof__(*(ptr)) *)(ptr); \
+	   __sync_synchronize(); _atomic_ld_tmp; })
+#  define ATOMIC_STORE_RELEASE(ptr, val) \
+	do { __sync_synchronize(); \
+	     *(volatile __typeof__(*(ptr)) *)(ptr) = (val); } while (0)
+   /* No relaxed atomics; fall back to the sequentially-consistent versions. */
+#  define ATOMIC_INC_FETCH_RELAXED(ptr)		ATOMIC_INC_FETCH(ptr)
+#  define ATOMIC_DEC_FETCH_ACQREL(ptr)		ATOMIC_DEC_FETCH(ptr)
 # endif
 #elif defined(_MSC_VER)
 # include <intrin.h>
@@ -81,6 +102,29 @@ static __inline int ATOMIC_EXCHANGE(volatile int *ptr, int val)
 {
 	return _InterlockedExchange(REINTERPRET_CAST(volatile long*)(ptr), val);
 }
+/* NOTE: MSVC volatile accesses have acquire/release semantics by default */
+/* on x86; on ARM, this requires /volatile:ms. The _ReadWriteBarrier() */
+/* prevents compiler reordering either way. */
+static __inline int ATOMIC_LOAD_ACQUIRE(const volatile int *ptr)
+{
+	const int val = *ptr;
+	_ReadWriteBarrier();
+	return val;
+}
+static __inline void ATOMIC_STORE_RELEASE(volatile int *ptr, int val)
+{
+	_ReadWriteBarrier();
+	*ptr = val;
+}
+/* No relaxed Interlocked variants on x86; full barriers either way. */
+static __inline int ATOMIC_INC_FETCH_RELAXED(volatile int *ptr)
+{
+	return ATOMIC_INC_FETCH(ptr);
+}
+static __inline int ATOMIC_DEC_FETCH_ACQREL(volatile int *ptr)
+{
+	return ATOMIC_DEC_FETCH(ptr);
+}
 #else
 # error Atomic functions not defined for this compiler.
 #endif
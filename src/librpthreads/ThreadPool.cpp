@@ -0,0 +1,200 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * ThreadPool.cpp: Shared worker thread pool.                              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "ThreadPool.hpp"
+
+// C includes. (C++ namespace)
+#include <cassert>
+
+// C++ STL classes.
+using std::deque;
+using std::function;
+using std::thread;
+using std::unique_lock;
+using std::vector;
+
+namespace LibRpBase {
+
+/** ThreadPool **/
+
+ThreadPool::ThreadPool()
+	: m_started(false)
+	, m_stop(false)
+{
+	// Size the pool to the CPU count.
+	// The worker threads aren't started until the first submission.
+	m_threadCount = thread::hardware_concurrency();
+	if (m_threadCount == 1) {
+		// Single hardware thread. Tasks will run on the calling
+		// thread, so don't bother starting any workers.
+		m_threadCount = 0;
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	// Tell the workers to exit.
+	{
+		unique_lock<std::mutex> lock(m_mutex);
+		m_stop = true;
+	}
+	m_cvQueue.notify_all();
+	for (auto iter = m_workers.begin(); iter != m_workers.end(); ++iter) {
+		iter->join();
+	}
+}
+
+/**
+ * Get the ThreadPool instance.
+ * @return ThreadPool instance.
+ */
+ThreadPool *ThreadPool::instance(void)
+{
+	// C++11 guarantees thread-safe initialization
+	// of function-local static objects.
+	static ThreadPool instance;
+	return &instance;
+}
+
+/**
+ * Get the number of worker threads the pool will use.
+ *
+ * This can be called before any task has been submitted;
+ * it does not start the worker threads.
+ *
+ * @return Worker thread count. (0 if tasks will run on the calling thread.)
+ */
+unsigned int ThreadPool::threadCount(void) const
+{
+	return m_threadCount;
+}
+
+/**
+ * Start the worker threads.
+ * Must be called with m_mutex held.
+ */
+void ThreadPool::startWorkers(void)
+{
+	m_started = true;
+	m_workers.reserve(m_threadCount);
+	for (unsigned int i = 0; i < m_threadCount; i++) {
+		m_workers.emplace_back(&ThreadPool::workerThread, this);
+	}
+}
+
+/**
+ * Worker thread main loop.
+ */
+void ThreadPool::workerThread(void)
+{
+	unique_lock<std::mutex> lock(m_mutex);
+	while (!m_stop) {
+		if (m_queue.empty()) {
+			m_cvQueue.wait(lock);
+			continue;
+		}
+
+		Task task = std::move(m_queue.front());
+		m_queue.pop_front();
+
+		// Run the task with the queue unlocked.
+		lock.unlock();
+		task.fn();
+		task.taskSet->taskDone();
+		lock.lock();
+	}
+}
+
+/**
+ * Enqueue a task.
+ * Called by TaskSet::submit().
+ * @param task Task to enqueue.
+ */
+void ThreadPool::enqueue(Task &&task)
+{
+	{
+		unique_lock<std::mutex> lock(m_mutex);
+		if (!m_started) {
+			// First submission. Start the worker threads.
+			startWorkers();
+		}
+		m_queue.push_back(std::move(task));
+	}
+	m_cvQueue.notify_one();
+}
+
+/** ThreadPool::TaskSet **/
+
+ThreadPool::TaskSet::TaskSet()
+	: m_pending(0)
+{ }
+
+ThreadPool::TaskSet::~TaskSet()
+{
+	// All tasks must have finished by now.
+	// (The workers hold a pointer to this TaskSet.)
+	assert(m_pending == 0);
+}
+
+/**
+ * Submit a task to the thread pool.
+ *
+ * If no worker threads are available, the task is run
+ * immediately on the calling thread.
+ *
+ * @param fn Task function.
+ */
+void ThreadPool::TaskSet::submit(function<void()> fn)
+{
+	ThreadPool *const pool = ThreadPool::instance();
+	if (pool->m_threadCount == 0) {
+		// No worker threads. Run the task here.
+		fn();
+		return;
+	}
+
+	{
+		unique_lock<std::mutex> lock(m_mutex);
+		m_pending++;
+	}
+
+	Task task = {std::move(fn), this};
+	pool->enqueue(std::move(task));
+}
+
+/**
+ * Wait for all tasks submitted through this TaskSet to finish.
+ */
+void ThreadPool::TaskSet::wait(void)
+{
+	unique_lock<std::mutex> lock(m_mutex);
+	while (m_pending > 0) {
+		m_cvDone.wait(lock);
+	}
+}
+
+/**
+ * Mark one task as finished.
+ * Called by the worker threads.
+ */
+void ThreadPool::TaskSet::taskDone(void)
+{
+	unique_lock<std::mutex> lock(m_mutex);
+	assert(m_pending > 0);
+	m_pending--;
+	if (m_pending == 0) {
+		// NOTE: Notify while still holding the lock.
+		// As soon as wait() can observe m_pending == 0, it may
+		// return and the caller may destroy this TaskSet, so a
+		// notify after unlocking could touch a destroyed
+		// condition variable.
+		m_cvDone.notify_all();
+	}
+}
+
+}
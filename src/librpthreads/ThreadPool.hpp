@@ -0,0 +1,158 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (librpthreads)                     *
+ * ThreadPool.hpp: Shared worker thread pool.                              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_LIBRPTHREADS_THREADPOOL_HPP__
+#define __ROMPROPERTIES_LIBRPTHREADS_THREADPOOL_HPP__
+
+// C++ includes.
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LibRpBase {
+
+/**
+ * Shared worker thread pool.
+ *
+ * One pool is shared by the whole process so concurrent features
+ * (parallel texture decoding, batch processing, etc.) don't each
+ * spawn their own threads. Worker threads are started lazily on the
+ * first submission, and the pool is sized to the CPU count.
+ *
+ * Tasks are submitted through a TaskSet, which provides completion
+ * tracking for the tasks submitted through it:
+ *
+ *	ThreadPool::TaskSet taskSet;
+ *	taskSet.submit([]() { ... });
+ *	taskSet.submit([]() { ... });
+ *	taskSet.wait();
+ *
+ * If no worker threads are available (single-CPU system, or thread
+ * creation failed), submit() runs the task on the calling thread.
+ */
+class ThreadPool
+{
+	protected:
+		ThreadPool();
+		~ThreadPool();
+
+	private:
+		ThreadPool(const ThreadPool &) = delete;
+		ThreadPool &operator=(const ThreadPool &) = delete;
+
+	public:
+		/**
+		 * Get the ThreadPool instance.
+		 * @return ThreadPool instance.
+		 */
+		static ThreadPool *instance(void);
+
+		/**
+		 * Get the number of worker threads the pool will use.
+		 *
+		 * This can be called before any task has been submitted;
+		 * it does not start the worker threads.
+		 *
+		 * @return Worker thread count. (0 if tasks will run on the calling thread.)
+		 */
+		unsigned int threadCount(void) const;
+
+	public:
+		class TaskSet;
+
+	private:
+		friend class TaskSet;
+
+		// Queued task: function plus the TaskSet to notify on completion.
+		struct Task {
+			std::function<void()> fn;
+			TaskSet *taskSet;
+		};
+
+		/**
+		 * Start the worker threads.
+		 * Must be called with m_mutex held.
+		 */
+		void startWorkers(void);
+
+		/**
+		 * Worker thread main loop.
+		 */
+		void workerThread(void);
+
+		/**
+		 * Enqueue a task.
+		 * Called by TaskSet::submit().
+		 * @param task Task to enqueue.
+		 */
+		void enqueue(Task &&task);
+
+	private:
+		std::vector<std::thread> m_workers;
+		std::deque<Task> m_queue;
+		mutable std::mutex m_mutex;
+		std::condition_variable m_cvQueue;
+		unsigned int m_threadCount;	// Number of workers to start.
+		bool m_started;			// True if workers have been started.
+		bool m_stop;			// True if workers should exit.
+};
+
+/**
+ * Completion tracking for a group of tasks submitted to the pool.
+ *
+ * wait() blocks until every task submitted through this TaskSet
+ * has finished. The TaskSet must outlive its tasks; wait() must be
+ * called before destruction if any tasks were submitted.
+ */
+class ThreadPool::TaskSet
+{
+	public:
+		TaskSet();
+		~TaskSet();
+
+	private:
+		TaskSet(const TaskSet &) = delete;
+		TaskSet &operator=(const TaskSet &) = delete;
+
+	public:
+		/**
+		 * Submit a task to the thread pool.
+		 *
+		 * If no worker threads are available, the task is run
+		 * immediately on the calling thread.
+		 *
+		 * @param fn Task function.
+		 */
+		void submit(std::function<void()> fn);
+
+		/**
+		 * Wait for all tasks submitted through this TaskSet to finish.
+		 */
+		void wait(void);
+
+	private:
+		friend class ThreadPool;
+
+		/**
+		 * Mark one task as finished.
+		 * Called by the worker threads.
+		 */
+		void taskDone(void);
+
+	private:
+		std::mutex m_mutex;
+		std::condition_variable m_cvDone;
+		unsigned int m_pending;		// Number of unfinished tasks.
+};
+
+}
+
+#endif /* __ROMPROPERTIES_LIBRPTHREADS_THREADPOOL_HPP__ */
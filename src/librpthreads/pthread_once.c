@@ -37,9 +37,9 @@ int pthread_once(pthread_once_t *once_control, void (*init_routine)(void))
 {
 	// Copied from "perftools_pthread_once" in tcmalloc.
 
-	// Try for a fast path first. Note: this should be an acquire semantics read
-	// It is on x86 and x64, where Windows runs.
-	if (*once_control != 1) {
+	// Try for a fast path first: an acquire-semantics read with no
+	// locked instruction if initialization has already completed.
+	if (ATOMIC_LOAD_ACQUIRE(once_control) != 1) {
 		while (1) {
 			// Check if once_control is 0. If it is, set it to 2.
 			// NOTE: ATOMIC_CMPXCHG() returns the initial value,
@@ -50,7 +50,9 @@ int pthread_once(pthread_once_t *once_control, void (*init_routine)(void))
 					// NOTE: pthread_once() doesn't have a way to
 					// indicate that initialization failed.
 					init_routine();
-					ATOMIC_EXCHANGE(once_control, 1);
+					// Release store: publishes the init_routine()
+					// side effects to the fast-path readers.
+					ATOMIC_STORE_RELEASE(once_control, 1);
 					return 0;
 				case 1:
 					// The initializer has already been executed.
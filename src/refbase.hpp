@@ -0,0 +1,115 @@
+/***************************************************************************
+ * ROM Properties Page shell extension.                                    *
+ * refbase.hpp: Reference-counted base class.                              *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_REFBASE_HPP__
+#define __ROMPROPERTIES_REFBASE_HPP__
+
+// C includes.
+#include <stdint.h>
+
+// C includes. (C++ namespace)
+#include <cassert>
+
+// common macros
+#include "common.h"
+
+// librpthreads
+#include "librpthreads/Atomics.h"
+
+/**
+ * Reference-counted base class.
+ * Objects start with a reference count of 1.
+ * Call unref() instead of deleting the object directly.
+ *
+ * ref() and unref() are inlined, and ref() uses a relaxed atomic
+ * increment: taking a reference doesn't need to synchronize with
+ * anything. unref() uses an acquire/release decrement so writes
+ * made by other threads are visible before the destructor runs.
+ */
+class RefBase
+{
+	protected:
+		RefBase()
+			: m_ref_cnt(1)
+		{
+#ifndef NDEBUG
+			ATOMIC_INC_FETCH(&ref_cnt_total());
+#endif /* !NDEBUG */
+		}
+
+		virtual ~RefBase() { }	// call unref() instead
+
+	private:
+		RP_DISABLE_COPY(RefBase)
+
+	public:
+		/**
+		 * Take a reference to this object.
+		 * @return this
+		 */
+		inline RefBase *ref(void)
+		{
+			ATOMIC_INC_FETCH_RELAXED(&m_ref_cnt);
+#ifndef NDEBUG
+			ATOMIC_INC_FETCH(&ref_cnt_total());
+#endif /* !NDEBUG */
+			return this;
+		}
+
+		/**
+		 * Unreference this object.
+		 * If the reference count reaches 0, the object is deleted.
+		 */
+		inline void unref(void)
+		{
+			assert(m_ref_cnt > 0);
+#ifndef NDEBUG
+			ATOMIC_DEC_FETCH(&ref_cnt_total());
+#endif /* !NDEBUG */
+			if (ATOMIC_DEC_FETCH_ACQREL(&m_ref_cnt) <= 0) {
+				// All references removed.
+				delete this;
+			}
+		}
+
+#ifndef NDEBUG
+	public:
+		/**
+		 * Get the total reference count of all live RefBase objects.
+		 * Debug builds only. Check this on shutdown to detect
+		 * leaked references.
+		 * @return Total reference count.
+		 */
+		static inline int refCntTotal(void)
+		{
+			return ATOMIC_LOAD_ACQUIRE(&ref_cnt_total());
+		}
+
+	private:
+		/**
+		 * Process-wide reference count. (debug builds only)
+		 * NOTE: Function-local static so this header stays
+		 * self-contained; C++11 guarantees thread-safe init.
+		 * @return Reference to the counter.
+		 */
+		static inline volatile int &ref_cnt_total(void)
+		{
+			static volatile int ref_cnt_total = 0;
+			return ref_cnt_total;
+		}
+#endif /* !NDEBUG */
+
+	private:
+		// NOTE: Not over-aligning the reference count to isolate it
+		// on its own cache line: subclasses are allocated with plain
+		// new, which doesn't honor extended alignment in C++14, and
+		// it triggers -Waligned-new everywhere.
+		volatile int m_ref_cnt;
+};
+
+#endif /* __ROMPROPERTIES_REFBASE_HPP__ */
@@ -19,16 +19,26 @@ namespace RpDownload {
 
 CurlDownloader::CurlDownloader()
 	: super()
+	, m_curlHandle(nullptr)
 { }
 
 CurlDownloader::CurlDownloader(const TCHAR *url)
 	: super(url)
+	, m_curlHandle(nullptr)
 { }
 
 CurlDownloader::CurlDownloader(const tstring &url)
 	: super(url)
+	, m_curlHandle(nullptr)
 { }
 
+CurlDownloader::~CurlDownloader()
+{
+	if (m_curlHandle) {
+		curl_easy_cleanup(static_cast<CURL*>(m_curlHandle));
+	}
+}
+
 /**
  * Internal cURL data write function.
  * @param ptr Data to write.
@@ -166,10 +176,18 @@ int CurlDownloader::download(void)
 	m_mtime = -1;
 
 	// Initialize cURL.
-	CURL *curl = curl_easy_init();
+	// The easy handle is reused for subsequent downloads, so
+	// transfers from the same host within one batch reuse the
+	// existing connection instead of paying for a new TCP/TLS
+	// handshake every time.
+	CURL *curl = static_cast<CURL*>(m_curlHandle);
 	if (!curl) {
-		// Could not initialize cURL.
-		return -ENOMEM;	// TODO: Better error?
+		curl = curl_easy_init();
+		if (!curl) {
+			// Could not initialize cURL.
+			return -ENOMEM;	// TODO: Better error?
+		}
+		m_curlHandle = curl;
 	}
 
 	// Proxy settings should be set by the calling application
@@ -196,6 +214,23 @@ int CurlDownloader::download(void)
 	// signals might interfere.
 	curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1);
 
+#if LIBCURL_VERSION_NUM >= 0x072F00 /* 7.47.0 */
+	// Negotiate HTTP/2 over TLS if the server supports it.
+	// The connection is kept alive and reused for the other
+	// downloads in the batch.
+	curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+#endif /* LIBCURL_VERSION_NUM >= 7.47.0 */
+
+	// Conditional request: If-Modified-Since.
+	// NOTE: The condition is reset explicitly because the
+	// easy handle is reused between downloads.
+	if (m_ifModifiedSince >= 0) {
+		curl_easy_setopt(curl, CURLOPT_TIMECONDITION, CURL_TIMECOND_IFMODSINCE);
+		curl_easy_setopt(curl, CURLOPT_TIMEVALUE, static_cast<long>(m_ifModifiedSince));
+	} else {
+		curl_easy_setopt(curl, CURLOPT_TIMECONDITION, CURL_TIMECOND_NONE);
+	}
+
 	// Set timeouts to ensure we don't take forever.
 	// TODO: User configuration?
 	// - Connect timeout: 2 seconds.
@@ -207,8 +242,9 @@ int CurlDownloader::download(void)
 	curl_easy_setopt(curl, CURLOPT_USERAGENT, m_userAgent.c_str());
 
 	// TODO: Set the User-Agent?
+	// NOTE: The handle is NOT cleaned up here; it's kept open
+	// for reuse and cleaned up in the destructor.
 	CURLcode res = curl_easy_perform(curl);
-	curl_easy_cleanup(curl);
 	if (res != CURLE_OK) {
 		// Error downloading the file.
 		// Check if we have an HTTP response code.
@@ -223,6 +259,18 @@ int CurlDownloader::download(void)
 		return (int)response_code;
 	}
 
+	if (m_ifModifiedSince >= 0) {
+		// Check if the time condition was unmet.
+		// If so, the server returned 304 Not Modified,
+		// and no body was transferred.
+		long cond_unmet = 0;
+		curl_easy_getinfo(curl, CURLINFO_CONDITION_UNMET, &cond_unmet);
+		if (cond_unmet) {
+			// 304 Not Modified.
+			return 304;
+		}
+	}
+
 	// Check if we have data.
 	if (m_data.empty()) {
 		// No data.
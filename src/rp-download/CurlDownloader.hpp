@@ -19,6 +19,7 @@ class CurlDownloader : public IDownloader
 		CurlDownloader();
 		explicit CurlDownloader(const TCHAR *url);
 		explicit CurlDownloader(const std::tstring &url);
+		virtual ~CurlDownloader();
 
 	private:
 		typedef IDownloader super;
@@ -51,6 +52,12 @@ class CurlDownloader : public IDownloader
 		 * @return 0 on success; negative POSIX error code, positive HTTP status code on error.
 		 */
 		int download(void) final;
+
+	protected:
+		// Persistent cURL easy handle. (CURL*)
+		// Reused for subsequent downloads so the connection
+		// to the server is kept alive between transfers.
+		void *m_curlHandle;
 };
 
 }
@@ -21,6 +21,7 @@ namespace RpDownload {
 
 IDownloader::IDownloader()
 	: m_mtime(-1)
+	, m_ifModifiedSince(-1)
 	, m_inProgress(false)
 	, m_maxSize(0)
 {
@@ -30,6 +31,7 @@ IDownloader::IDownloader()
 IDownloader::IDownloader(const TCHAR *url)
 	: m_url(url)
 	, m_mtime(-1)
+	, m_ifModifiedSince(-1)
 	, m_inProgress(false)
 	, m_maxSize(0)
 {
@@ -39,6 +41,7 @@ IDownloader::IDownloader(const TCHAR *url)
 IDownloader::IDownloader(const tstring &url)
 	: m_url(url)
 	, m_mtime(-1)
+	, m_ifModifiedSince(-1)
 	, m_inProgress(false)
 	, m_maxSize(0)
 {
@@ -110,6 +113,31 @@ void IDownloader::setMaxSize(size_t maxSize)
 	m_maxSize = maxSize;
 }
 
+/**
+ * Get the If-Modified-Since request time.
+ * @return If-Modified-Since time, or -1 if not set.
+ */
+time_t IDownloader::ifModifiedSince(void) const
+{
+	return m_ifModifiedSince;
+}
+
+/**
+ * Set the If-Modified-Since request time.
+ *
+ * If set, the download is made conditional: if the file on
+ * the server has not been modified since the specified time,
+ * the server returns 304 Not Modified and no body is
+ * transferred. download() returns 304 in that case.
+ *
+ * @param mtime If-Modified-Since time, or -1 to disable.
+ */
+void IDownloader::setIfModifiedSince(time_t mtime)
+{
+	assert(!m_inProgress);
+	m_ifModifiedSince = mtime;
+}
+
 /** Data accessors. **/
 
 /**
@@ -80,6 +80,24 @@ class IDownloader
 		 */
 		void setMaxSize(size_t maxSize);
 
+		/**
+		 * Get the If-Modified-Since request time.
+		 * @return If-Modified-Since time, or -1 if not set.
+		 */
+		time_t ifModifiedSince(void) const;
+
+		/**
+		 * Set the If-Modified-Since request time.
+		 *
+		 * If set, the download is made conditional: if the file on
+		 * the server has not been modified since the specified time,
+		 * the server returns 304 Not Modified and no body is
+		 * transferred. download() returns 304 in that case.
+		 *
+		 * @param mtime If-Modified-Since time, or -1 to disable.
+		 */
+		void setIfModifiedSince(time_t mtime);
+
 	public:
 		/** Data accessors. **/
 
@@ -129,6 +147,9 @@ class IDownloader
 		// Last-Modified time.
 		time_t m_mtime;
 
+		// If-Modified-Since request time. (-1 == not set)
+		time_t m_ifModifiedSince;
+
 		bool m_inProgress;	// Set when downloading.
 		size_t m_maxSize;	// Maximum buffer size. (0 == unlimited)
 
@@ -91,8 +91,16 @@ static bool getStoreFileOriginInfo(void)
 {
 	static const bool default_value = true;
 
+	// Cache the value after the first call, since batch mode
+	// downloads multiple files per run and the setting can't
+	// change in between.
+	static int cached_value = -1;
+	if (cached_value >= 0) {
+		return (cached_value != 0);
+	}
+	cached_value = (default_value ? 1 : 0);
+
 	// Get the config filename.
-	// NOTE: Not cached, since rp-download downloads one file per run.
 	string conf_filename = LibUnixCommon::getConfigDirectory().c_str();
 	if (conf_filename.empty()) {
 		// Empty filename...
@@ -109,6 +117,7 @@ static bool getStoreFileOriginInfo(void)
 	// so ignore the return value.
 	bool bValue = default_value;
 	ini_parse(conf_filename.c_str(), processConfigLine, &bValue);
+	cached_value = (bValue ? 1 : 0);
 	return bValue;
 }
 
@@ -134,9 +143,15 @@ int setFileOriginInfo(FILE *file, const TCHAR *url, time_t mtime)
 
 	// xattr reference: https://github.com/pkg/xattr
 
+	// Set if the cache filesystem rejected xattrs, e.g. tmpfs
+	// mounted without user xattr support. Skips the xattr
+	// syscalls for the rest of the batch instead of retrying
+	// (and failing) for every downloaded file.
+	static bool xattrs_unsupported = false;
+
 	// Check if storeFileOriginInfo is enabled.
 	const bool storeFileOriginInfo = getStoreFileOriginInfo();
-	if (storeFileOriginInfo) {
+	if (storeFileOriginInfo && !xattrs_unsupported) {
 #if defined(HAVE_FSETXATTR_LINUX) || defined(HAVE_EXTATTR_SET_FD)
 		// fsetxattr() [Linux version]
 		// NOTE: Also used for FreeBSD using a wrapper function.
@@ -144,19 +159,31 @@ int setFileOriginInfo(FILE *file, const TCHAR *url, time_t mtime)
 		// Set the XDG origin attributes.
 		errno = 0;
 		int sxret = fsetxattr(fd, "user.xdg.origin.url", url, _tcslen(url), 0);
-		if (sxret != 0 && err != 0) {
-			err = errno;
-			if (err == 0) {
-				err = EIO;
+		if (sxret != 0) {
+			if (errno == EOPNOTSUPP) {
+				// Filesystem doesn't support xattrs.
+				xattrs_unsupported = true;
+			} else if (err == 0) {
+				err = errno;
+				if (err == 0) {
+					err = EIO;
+				}
 			}
 		}
 
-		errno = 0;
-		sxret = fsetxattr(fd, "user.xdg.publisher", xdg_publisher, sizeof(xdg_publisher)-1, 0);
-		if (sxret != 0 && err != 0) {
-			err = errno;
-			if (err == 0) {
-				err = EIO;
+		if (!xattrs_unsupported) {
+			errno = 0;
+			sxret = fsetxattr(fd, "user.xdg.publisher", xdg_publisher, sizeof(xdg_publisher)-1, 0);
+			if (sxret != 0) {
+				if (errno == EOPNOTSUPP) {
+					// Filesystem doesn't support xattrs.
+					xattrs_unsupported = true;
+				} else if (err == 0) {
+					err = errno;
+					if (err == 0) {
+						err = EIO;
+					}
+				}
 			}
 		}
 #elif defined(HAVE_FSETXATTR_MAC)
@@ -43,8 +43,16 @@ static bool getStoreFileOriginInfo(void)
 	DWORD dwRet;
 	TCHAR szValue[64];
 
+	// Cache the value after the first call, since batch mode
+	// downloads multiple files per run and the setting can't
+	// change in between.
+	static int cached_value = -1;
+	if (cached_value >= 0) {
+		return (cached_value != 0);
+	}
+	cached_value = (default_value ? 1 : 0);
+
 	// Get the config filename.
-	// NOTE: Not cached, since rp-download downloads one file per run.
 	// NOTE: This is sitll readable even when running as Low integrity.
 	tstring conf_filename = U82T_s(LibWin32Common::getConfigDirectory());
 	if (conf_filename.empty()) {
@@ -64,10 +72,12 @@ static bool getStoreFileOriginInfo(void)
 	    (dwRet == 1 && szValue[0] == _T('0')))
 	{
 		// Disabled.
+		cached_value = 0;
 		return false;
 	}
 
 	// Other value. Assume enabled.
+	cached_value = 1;
 	return true;
 }
 
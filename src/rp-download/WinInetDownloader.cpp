@@ -64,12 +64,26 @@ int WinInetDownloader::download(void)
 		return (err != 0 ? -err : -EIO);
 	}
 
+	// Conditional request: If-Modified-Since.
+	tstring headers;
+	if (m_ifModifiedSince >= 0) {
+		SYSTEMTIME st_ims;
+		TCHAR http_date[INTERNET_RFC1123_BUFSIZE];
+		UnixTimeToSystemTime(m_ifModifiedSince, &st_ims);
+		if (InternetTimeFromSystemTime(&st_ims,
+			INTERNET_RFC1123_FORMAT, http_date, sizeof(http_date)))
+		{
+			headers = _T("If-Modified-Since: ");
+			headers += http_date;
+		}
+	}
+
 	// Request the URL.
 	HINTERNET hURL = InternetOpenUrl(
 		hConnection,		// hInternet
 		m_url.c_str(),		// lpszUrl (Latin-1 characters only!)
-		nullptr,		// lpszHeaders
-		0,			// dwHeaderLength
+		(!headers.empty() ? headers.c_str() : nullptr),		// lpszHeaders
+		static_cast<DWORD>(headers.size()),			// dwHeaderLength
 		INTERNET_FLAG_IGNORE_REDIRECT_TO_HTTPS |
 		INTERNET_FLAG_NO_AUTH |
 		INTERNET_FLAG_NO_COOKIES |
@@ -13,10 +13,13 @@
 #include "librpsecure/os-secure.h"
 
 // C includes.
-#ifndef _WIN32
+#ifdef _WIN32
+# include <sys/utime.h>
+#else /* !_WIN32 */
 # include <fcntl.h>
 # include <sys/stat.h>
 # include <unistd.h>
+# include <utime.h>
 #endif /* _WIN32 */
 
 #ifndef __S_ISTYPE
@@ -44,10 +47,27 @@ using std::unique_ptr;
 # include "libwin32common/RpWin32_sdk.h"
 # include "libwin32common/w32err.h"
 # include "libwin32common/w32time.h"
+# include "libwin32common/MiniU82T.hpp"
 #endif /* _WIN32 */
 
 // libcachecommon
 #include "libcachecommon/CacheKeys.hpp"
+#include "libcachecommon/CacheIndex.hpp"
+#include "libcachecommon/CacheBlobStore.hpp"
+
+/**
+ * Convert a TCHAR cache key to UTF-8 for the cache index.
+ * @param cache_key Cache key. (TCHAR)
+ * @return Cache key. (UTF-8)
+ */
+static inline std::string U8_cache_key(const TCHAR *cache_key)
+{
+#ifdef _WIN32
+	return LibWin32Common::T2U8_c(cache_key);
+#else /* !_WIN32 */
+	return std::string(cache_key);
+#endif /* _WIN32 */
+}
 
 #ifdef _WIN32
 # include <direct.h>
@@ -80,7 +100,7 @@ static bool verbose = false;
  */
 static void show_usage(void)
 {
-	_ftprintf(stderr, _T("Syntax: %s [-v] cache_key\n"), argv0);
+	_ftprintf(stderr, _T("Syntax: %s [-v] cache_key [cache_key ...]\n"), argv0);
 }
 
 /**
@@ -262,143 +282,13 @@ int rmkdir(const tstring &path)
 }
 
 /**
- * rp-download: Download an image from a supported online database.
+ * Download one cache key.
+ * @param downloader Downloader. (Shared across the batch for connection reuse.)
  * @param cache_key Cache key, e.g. "ds/cover/US/ADAE.png"
- * @return 0 on success; non-zero on error.
- *
- * TODO:
- * - More error codes based on the error.
+ * @return EXIT_SUCCESS on success; EXIT_FAILURE on error.
  */
-int RP_C_API _tmain(int argc, TCHAR *argv[])
+static int download_cache_key(IDownloader *downloader, const TCHAR *cache_key)
 {
-	// Create a downloader based on OS:
-	// - Linux: CurlDownloader
-	// - Windows: WinInetDownloader
-
-	// Syntax: rp-download cache_key
-	// Example: rp-download ds/coverM/US/ADAE.png
-
-	// If http_proxy or https_proxy are set, they will be used
-	// by the downloader code if supported.
-
-	// Reduce process integrity, if available.
-	rp_secure_reduce_integrity();
-
-	// Set OS-specific security options.
-	rp_secure_param_t param;
-#if defined(_WIN32)
-	param.bHighSec = FALSE;
-#elif defined(HAVE_SECCOMP)
-	static const int syscall_wl[] = {
-		// Syscalls used by rp-download.
-		// TODO: Add more syscalls.
-		// FIXME: glibc-2.31 uses 64-bit time syscalls that may not be
-		// defined in earlier versions, including Ubuntu 14.04.
-
-		// NOTE: Special case for clone(). If it's the first syscall
-		// in the list, it has a parameter restriction added that
-		// ensures it can only be used to create threads.
-		SCMP_SYS(clone),
-		// Other multi-threading syscalls
-		SCMP_SYS(set_robust_list),
-
-		SCMP_SYS(access), SCMP_SYS(clock_gettime),
-#if defined(__SNR_clock_gettime64) || defined(__NR_clock_gettime64)
-		SCMP_SYS(clock_gettime64),
-#endif /* __SNR_clock_gettime64 || __NR_clock_gettime64 */
-		SCMP_SYS(close),
-		SCMP_SYS(fcntl), SCMP_SYS(fcntl64),
-		SCMP_SYS(fsetxattr),
-		SCMP_SYS(fstat),     SCMP_SYS(fstat64),		// __GI___fxstat() [printf()]
-		SCMP_SYS(fstatat64), SCMP_SYS(newfstatat),	// Ubuntu 19.10 (32-bit)
-		SCMP_SYS(futex),
-		SCMP_SYS(getdents), SCMP_SYS(getdents64),
-		SCMP_SYS(getrusage),
-		SCMP_SYS(gettimeofday),	// 32-bit only?
-		SCMP_SYS(getuid),
-		SCMP_SYS(lseek), SCMP_SYS(_llseek),
-		//SCMP_SYS(lstat), SCMP_SYS(lstat64),	// Not sure if used?
-		SCMP_SYS(mkdir), SCMP_SYS(mmap), SCMP_SYS(mmap2),
-		SCMP_SYS(munmap),
-		SCMP_SYS(open),		// Ubuntu 16.04
-		SCMP_SYS(openat),	// glibc-2.31
-#if defined(__SNR_openat2) || defined(__NR_openat2)
-		SCMP_SYS(openat2),	// Linux 5.6
-#endif /* __SNR_openat2 || __NR_openat2 */
-		SCMP_SYS(poll), SCMP_SYS(select),
-		SCMP_SYS(stat), SCMP_SYS(stat64),
-		SCMP_SYS(utimensat),
-
-#if defined(__SNR_statx) || defined(__NR_statx)
-		SCMP_SYS(getcwd),	// called by glibc's statx()
-		SCMP_SYS(statx),
-#endif /* __SNR_statx || __NR_statx */
-
-		// glibc ncsd
-		// TODO: Restrict connect() to AF_UNIX.
-		SCMP_SYS(connect), SCMP_SYS(recvmsg), SCMP_SYS(sendto),
-		SCMP_SYS(sendmmsg),	// getaddrinfo() (32-bit only?)
-		SCMP_SYS(ioctl),	// getaddrinfo() (32-bit only?) [FIXME: Filter for FIONREAD]
-		SCMP_SYS(recvfrom),	// getaddrinfo() (32-bit only?)
-
-		// cURL and OpenSSL
-		SCMP_SYS(bind),		// getaddrinfo() [curl_thread_create_thunk(), curl-7.68.0]
-#ifdef __SNR_getrandom
-		SCMP_SYS(getrandom),
-#endif /* __SNR_getrandom */
-		SCMP_SYS(getpeername), SCMP_SYS(getsockname),
-		SCMP_SYS(getsockopt), SCMP_SYS(madvise), SCMP_SYS(mprotect),
-		SCMP_SYS(setsockopt), SCMP_SYS(socket),
-		SCMP_SYS(socketcall),	// FIXME: Enhanced filtering? [cURL+GnuTLS only?]
-		SCMP_SYS(socketpair), SCMP_SYS(sysinfo),
-
-		-1	// End of whitelist
-	};
-	param.syscall_wl = syscall_wl;
-#elif defined(HAVE_PLEDGE)
-	// Promises:
-	// - stdio: General stdio functionality.
-	// - rpath: Read from ~/.config/rom-properties/ and ~/.cache/rom-properties/
-	// - wpath: Write to ~/.cache/rom-properties/
-	// - cpath: Create ~/.cache/rom-properties/ if it doesn't exist.
-	// - inet: Internet access.
-	// - fattr: Modify file attributes, e.g. mtime.
-	// - dns: Resolve hostnames.
-	// - getpw: Get user's home directory if HOME is empty.
-	param.promises = "stdio rpath wpath cpath inet fattr dns getpw";
-#elif defined(HAVE_TAME)
-	// NOTE: stdio includes fattr, e.g. utimes().
-	param.tame_flags = TAME_STDIO | TAME_RPATH | TAME_WPATH | TAME_CPATH |
-	                   TAME_INET | TAME_DNS | TAME_GETPW;
-#else
-	param.dummy = 0;
-#endif
-	rp_secure_enable(param);
-
-	// Store argv[0] globally.
-	argv0 = argv[0];
-
-	const TCHAR *cache_key = argv[1];
-	if (argc < 2) {
-		// TODO: Add a verbose option to print messages.
-		// Normally, the only output is a return value.
-		show_usage();
-		return EXIT_FAILURE;
-	}
-
-	// Check for "-v" or "--verbose".
-	if (!_tcscmp(argv[1], _T("-v")) || !_tcscmp(argv[1], _T("--verbose"))) {
-		// Verbose mode is enabled.
-		verbose = true;
-		// We need at least three parameters now.
-		if (argc < 3) {
-			show_error(_T("No cache key specified."));
-			show_usage();
-			return EXIT_FAILURE;
-		}
-		cache_key = argv[2];
-	}
-
 	// Check the cache key prefix. The prefix indicates the system
 	// and identifies the online database used.
 	// [key] indicates the cache key without the prefix.
@@ -503,6 +393,7 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 	// Get the cache file information.
 	off64_t filesize = 0;
 	time_t filemtime = 0;
+	bool revalidate = false;	// If true, revalidate the cached file.
 	int ret = get_file_size_and_mtime(cache_filename.c_str(), &filesize, &filemtime);
 	if (ret == 0) {
 		// Check if the file is 0 bytes.
@@ -516,6 +407,7 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 			if ((systime - filemtime) < (86400*7)) {
 				// Less than a week old.
 				SHOW_ERROR(_T("Negative cache file for '%s' has not expired; not redownloading."), cache_key);
+				LibCacheCommon::cacheIndexUpdate(U8_cache_key(cache_key), 0, filemtime);
 				return EXIT_FAILURE;
 			}
 
@@ -528,8 +420,18 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		} else if (filesize > 0) {
 			// File is larger than 0 bytes, which indicates
 			// it was previously cached successfully
-			SHOW_ERROR(_T("Cache file for '%s' is already downloaded."), cache_key);
-			return EXIT_SUCCESS;
+			const time_t systime = time(nullptr);
+			if ((systime - filemtime) < (86400*7)) {
+				SHOW_ERROR(_T("Cache file for '%s' is already downloaded."), cache_key);
+				LibCacheCommon::cacheIndexUpdate(U8_cache_key(cache_key), filesize, filemtime);
+				return EXIT_SUCCESS;
+			}
+
+			// Cached file is over a week old.
+			// Revalidate it with a conditional request.
+			// The cached copy is only replaced if the server
+			// has a newer version.
+			revalidate = true;
 		}
 	} else if (ret == -ENOENT) {
 		// File not found. We'll need to download it.
@@ -545,28 +447,39 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 		return EXIT_FAILURE;
 	}
 
-	// Attempt to download the file.
-	// TODO: IDownloaderFactory?
-#ifdef _WIN32
-	unique_ptr<IDownloader> m_downloader(new WinInetDownloader());
-#else /* !_WIN32 */
-	unique_ptr<IDownloader> m_downloader(new CurlDownloader());
-#endif /* _WIN32 */
-
 	// Open the cache file now so we can use it as a negative hit
 	// if the download fails.
-	FILE *f_out = _tfopen(cache_filename.c_str(), _T("wb"));
-	if (!f_out) {
-		// Error opening the cache file.
-		SHOW_ERROR(_T("Error writing to cache file: %s"), _tcserror(errno));
-		return EXIT_FAILURE;
+	// NOTE: When revalidating, the existing file is kept in place
+	// until the server actually sends a newer version.
+	FILE *f_out = nullptr;
+	if (!revalidate) {
+		f_out = _tfopen(cache_filename.c_str(), _T("wb"));
+		if (!f_out) {
+			// Error opening the cache file.
+			SHOW_ERROR(_T("Error writing to cache file: %s"), _tcserror(errno));
+			return EXIT_FAILURE;
+		}
 	}
 
-	// TODO: Configure this somewhere?
-	m_downloader->setMaxSize(4*1024*1024);
-
-	m_downloader->setUrl(full_url);
-	ret = m_downloader->download();
+	// Attempt to download the file.
+	downloader->setUrl(full_url);
+	downloader->setIfModifiedSince(revalidate ? filemtime : -1);
+	ret = downloader->download();
+	if (ret == 304) {
+		// 304 Not Modified. The cached file is still valid.
+		// Update the file mtime so the next revalidation
+		// isn't attempted for another week.
+		SHOW_ERROR(_T("Cache file for '%s' is still valid; server returned 304."), cache_key);
+		_tutime(cache_filename.c_str(), nullptr);
+		LibCacheCommon::cacheIndexUpdate(U8_cache_key(cache_key), filesize, time(nullptr));
+		return EXIT_SUCCESS;
+	}
+	if (ret != 0 && revalidate) {
+		// Revalidation failed, e.g. the server is unreachable.
+		// Keep the cached copy; it's stale but usable.
+		SHOW_ERROR(_T("Revalidation for '%s' failed; keeping the cached file."), cache_key);
+		return EXIT_SUCCESS;
+	}
 	if (ret != 0) {
 		// Error downloading the file.
 		if (verbose) {
@@ -583,31 +496,233 @@ int RP_C_API _tmain(int argc, TCHAR *argv[])
 				}
 			}
 		}
+		// The 0-byte cache file is left as a negative hit.
 		fclose(f_out);
+		LibCacheCommon::cacheIndexUpdate(U8_cache_key(cache_key), 0, time(nullptr));
 		return EXIT_FAILURE;
 	}
 
-	if (m_downloader->dataSize() <= 0) {
+	if (downloader->dataSize() <= 0) {
 		// No data downloaded...
 		SHOW_ERROR(_T("Error downloading file: 0 bytes received"));
-		fclose(f_out);
+		if (f_out) {
+			fclose(f_out);
+			LibCacheCommon::cacheIndexUpdate(U8_cache_key(cache_key), 0, time(nullptr));
+		}
 		return EXIT_FAILURE;
 	}
 
+	if (!f_out) {
+		// Revalidation: The server sent a newer version.
+		// Remove the old file before reopening it for writing.
+		// It may be a hard link into the blob store, and truncating
+		// it in place would clobber the contents for other cache
+		// keys sharing the blob.
+		_tremove(cache_filename.c_str());
+		f_out = _tfopen(cache_filename.c_str(), _T("wb"));
+		if (!f_out) {
+			// Error opening the cache file.
+			SHOW_ERROR(_T("Error writing to cache file: %s"), _tcserror(errno));
+			return EXIT_FAILURE;
+		}
+	}
+
 	// Write the file to the cache.
 	// TODO: Verify the size.
-	size_t size = fwrite(m_downloader->data(), 1, m_downloader->dataSize(), f_out);
+	size_t size = fwrite(downloader->data(), 1, downloader->dataSize(), f_out);
 
 	// Save the file origin information.
 #ifdef _WIN32
 	// TODO: Figure out how to setFileOriginInfo() on Windows
 	// using an open file handle.
-	setFileOriginInfo(f_out, cache_filename.c_str(), full_url, m_downloader->mtime());
+	setFileOriginInfo(f_out, cache_filename.c_str(), full_url, downloader->mtime());
 #else /* !_WIN32 */
-	setFileOriginInfo(f_out, full_url, m_downloader->mtime());
+	setFileOriginInfo(f_out, full_url, downloader->mtime());
 #endif /* _WIN32 */
 	fclose(f_out);
 
+	// Deduplicate the file against the content-addressed blob store.
+	// Regional variants often share byte-identical cover art.
+	LibCacheCommon::dedupCacheFile(cache_filename);
+
+	// Update the persistent cache index.
+	time_t idx_mtime = downloader->mtime();
+	if (idx_mtime < 0) {
+		idx_mtime = time(nullptr);
+	}
+	LibCacheCommon::cacheIndexUpdate(U8_cache_key(cache_key),
+		static_cast<int64_t>(downloader->dataSize()), idx_mtime);
+
 	// Success.
 	return EXIT_SUCCESS;
 }
+
+/**
+ * rp-download: Download an image from a supported online database.
+ * @param cache_key Cache key, e.g. "ds/cover/US/ADAE.png"
+ * @return 0 on success; non-zero on error.
+ *
+ * TODO:
+ * - More error codes based on the error.
+ */
+int RP_C_API _tmain(int argc, TCHAR *argv[])
+{
+	// Create a downloader based on OS:
+	// - Linux: CurlDownloader
+	// - Windows: WinInetDownloader
+
+	// Syntax: rp-download cache_key
+	// Example: rp-download ds/coverM/US/ADAE.png
+
+	// If http_proxy or https_proxy are set, they will be used
+	// by the downloader code if supported.
+
+	// Reduce process integrity, if available.
+	rp_secure_reduce_integrity();
+
+	// Set OS-specific security options.
+	rp_secure_param_t param;
+#if defined(_WIN32)
+	param.bHighSec = FALSE;
+#elif defined(HAVE_SECCOMP)
+	static const int syscall_wl[] = {
+		// Syscalls used by rp-download.
+		// TODO: Add more syscalls.
+		// FIXME: glibc-2.31 uses 64-bit time syscalls that may not be
+		// defined in earlier versions, including Ubuntu 14.04.
+
+		// NOTE: Special case for clone(). If it's the first syscall
+		// in the list, it has a parameter restriction added that
+		// ensures it can only be used to create threads.
+		SCMP_SYS(clone),
+		// Other multi-threading syscalls
+		SCMP_SYS(set_robust_list),
+
+		SCMP_SYS(access), SCMP_SYS(clock_gettime),
+#if defined(__SNR_clock_gettime64) || defined(__NR_clock_gettime64)
+		SCMP_SYS(clock_gettime64),
+#endif /* __SNR_clock_gettime64 || __NR_clock_gettime64 */
+		SCMP_SYS(close),
+		SCMP_SYS(fcntl), SCMP_SYS(fcntl64),
+		SCMP_SYS(fsetxattr),
+		SCMP_SYS(fstat),     SCMP_SYS(fstat64),		// __GI___fxstat() [printf()]
+		SCMP_SYS(fstatat64), SCMP_SYS(newfstatat),	// Ubuntu 19.10 (32-bit)
+		SCMP_SYS(futex),
+		SCMP_SYS(getdents), SCMP_SYS(getdents64),
+		SCMP_SYS(getrusage),
+		SCMP_SYS(gettimeofday),	// 32-bit only?
+		SCMP_SYS(getuid),
+		SCMP_SYS(link), SCMP_SYS(linkat),	// dedupCacheFile()
+		SCMP_SYS(lseek), SCMP_SYS(_llseek),
+		//SCMP_SYS(lstat), SCMP_SYS(lstat64),	// Not sure if used?
+		SCMP_SYS(mkdir), SCMP_SYS(mmap), SCMP_SYS(mmap2),
+		SCMP_SYS(munmap),
+		SCMP_SYS(open),		// Ubuntu 16.04
+		SCMP_SYS(openat),	// glibc-2.31
+#if defined(__SNR_openat2) || defined(__NR_openat2)
+		SCMP_SYS(openat2),	// Linux 5.6
+#endif /* __SNR_openat2 || __NR_openat2 */
+		SCMP_SYS(poll), SCMP_SYS(select),
+		SCMP_SYS(rename), SCMP_SYS(renameat),	// dedupCacheFile()
+		SCMP_SYS(stat), SCMP_SYS(stat64),
+		SCMP_SYS(unlink), SCMP_SYS(unlinkat),	// negative cache expiry, dedupCacheFile()
+		SCMP_SYS(utimensat),
+
+#if defined(__SNR_statx) || defined(__NR_statx)
+		SCMP_SYS(getcwd),	// called by glibc's statx()
+		SCMP_SYS(statx),
+#endif /* __SNR_statx || __NR_statx */
+
+		// glibc ncsd
+		// TODO: Restrict connect() to AF_UNIX.
+		SCMP_SYS(connect), SCMP_SYS(recvmsg), SCMP_SYS(sendto),
+		SCMP_SYS(sendmmsg),	// getaddrinfo() (32-bit only?)
+		SCMP_SYS(ioctl),	// getaddrinfo() (32-bit only?) [FIXME: Filter for FIONREAD]
+		SCMP_SYS(recvfrom),	// getaddrinfo() (32-bit only?)
+
+		// cURL and OpenSSL
+		SCMP_SYS(bind),		// getaddrinfo() [curl_thread_create_thunk(), curl-7.68.0]
+#ifdef __SNR_getrandom
+		SCMP_SYS(getrandom),
+#endif /* __SNR_getrandom */
+		SCMP_SYS(getpeername), SCMP_SYS(getsockname),
+		SCMP_SYS(getsockopt), SCMP_SYS(madvise), SCMP_SYS(mprotect),
+		SCMP_SYS(setsockopt), SCMP_SYS(socket),
+		SCMP_SYS(socketcall),	// FIXME: Enhanced filtering? [cURL+GnuTLS only?]
+		SCMP_SYS(socketpair), SCMP_SYS(sysinfo),
+
+		-1	// End of whitelist
+	};
+	param.syscall_wl = syscall_wl;
+#elif defined(HAVE_PLEDGE)
+	// Promises:
+	// - stdio: General stdio functionality.
+	// - rpath: Read from ~/.config/rom-properties/ and ~/.cache/rom-properties/
+	// - wpath: Write to ~/.cache/rom-properties/
+	// - cpath: Create ~/.cache/rom-properties/ if it doesn't exist.
+	// - inet: Internet access.
+	// - fattr: Modify file attributes, e.g. mtime.
+	// - dns: Resolve hostnames.
+	// - getpw: Get user's home directory if HOME is empty.
+	param.promises = "stdio rpath wpath cpath inet fattr dns getpw";
+#elif defined(HAVE_TAME)
+	// NOTE: stdio includes fattr, e.g. utimes().
+	param.tame_flags = TAME_STDIO | TAME_RPATH | TAME_WPATH | TAME_CPATH |
+	                   TAME_INET | TAME_DNS | TAME_GETPW;
+#else
+	param.dummy = 0;
+#endif
+	rp_secure_enable(param);
+
+	// Store argv[0] globally.
+	argv0 = argv[0];
+
+	if (argc < 2) {
+		// TODO: Add a verbose option to print messages.
+		// Normally, the only output is a return value.
+		show_usage();
+		return EXIT_FAILURE;
+	}
+
+	// Check for "-v" or "--verbose".
+	int key_start = 1;
+	if (!_tcscmp(argv[1], _T("-v")) || !_tcscmp(argv[1], _T("--verbose"))) {
+		// Verbose mode is enabled.
+		verbose = true;
+		key_start = 2;
+		// We need at least three parameters now.
+		if (argc < 3) {
+			show_error(_T("No cache key specified."));
+			show_usage();
+			return EXIT_FAILURE;
+		}
+	}
+
+	// Create the downloader.
+	// The downloader is shared by all cache keys in the batch,
+	// so the connection to the server is reused instead of
+	// doing a new TCP/TLS handshake for every file.
+	// TODO: IDownloaderFactory?
+#ifdef _WIN32
+	unique_ptr<IDownloader> downloader(new WinInetDownloader());
+#else /* !_WIN32 */
+	unique_ptr<IDownloader> downloader(new CurlDownloader());
+#endif /* _WIN32 */
+
+	// TODO: Configure this somewhere?
+	downloader->setMaxSize(4*1024*1024);
+
+	// Download the cache key(s).
+	// Batch mode: Multiple cache keys can be specified on one
+	// invocation, amortizing process startup and connection
+	// setup across the whole batch.
+	int ret = EXIT_SUCCESS;
+	for (int i = key_start; i < argc; i++) {
+		if (download_cache_key(downloader.get(), argv[i]) != EXIT_SUCCESS) {
+			// Keep going after a failed download, but
+			// report the failure in the exit code.
+			ret = EXIT_FAILURE;
+		}
+	}
+	return ret;
+}
@@ -0,0 +1,382 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (rpcli)                            *
+ * hash.cpp: Parallel chunked file hashing.                                *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "config.rpcli.h"
+
+#ifndef ENABLE_DECRYPTION
+#error This file should only be compiled if decryption is enabled.
+#endif
+
+#include "hash.hpp"
+
+// librpbase, librpfile
+#include "librpbase/TextFuncs.hpp"
+#include "librpfile/RpFile.hpp"
+using namespace LibRpBase;
+using namespace LibRpFile;
+
+// libi18n
+#include "libi18n/i18n.h"
+
+#ifdef _WIN32
+// Windows: CryptoAPI.
+# include <windows.h>
+# include <wincrypt.h>
+#else /* !_WIN32 */
+// Other: Nettle.
+# include <nettle/md5.h>
+# include <nettle/sha1.h>
+#endif /* _WIN32 */
+
+// C includes. (C++ namespace)
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+
+// C++ includes.
+#include <algorithm>
+#include <atomic>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+using std::atomic;
+using std::cerr;
+using std::cout;
+using std::endl;
+using std::thread;
+using std::unique_ptr;
+using std::vector;
+
+// Chunk size for the tree hash.
+// Each chunk is hashed independently; the final digest is the
+// hash of the concatenated chunk digests.
+static const size_t HASH_CHUNK_SIZE = 4U*1024*1024;
+
+// Maximum digest size. (SHA-1)
+static const size_t HASH_DIGEST_SIZE_MAX = 20;
+
+/**
+ * Single-algorithm hash context.
+ * Wraps Nettle on most platforms and CryptoAPI on Windows.
+ */
+class ChunkHasher
+{
+	public:
+		explicit ChunkHasher(HashAlgorithm algorithm);
+		~ChunkHasher();
+
+	private:
+		RP_DISABLE_COPY(ChunkHasher)
+
+	public:
+		/**
+		 * Get the digest size of the selected algorithm.
+		 * @return Digest size, in bytes.
+		 */
+		size_t digestSize(void) const;
+
+		/**
+		 * Reset the hash context for a new message.
+		 */
+		void reset(void);
+
+		/**
+		 * Process message data.
+		 * @param data Data.
+		 * @param size Size of data, in bytes.
+		 */
+		void update(const uint8_t *data, size_t size);
+
+		/**
+		 * Finalize the hash and retrieve the digest.
+		 * The context must be reset() before it is reused.
+		 * @param pDigest Output buffer. (Must be digestSize() bytes.)
+		 */
+		void finalize(uint8_t *pDigest);
+
+	private:
+		HashAlgorithm m_algorithm;
+#ifdef _WIN32
+		HCRYPTPROV m_hProv;
+		HCRYPTHASH m_hHash;
+#else /* !_WIN32 */
+		union {
+			struct md5_ctx md5;
+			struct sha1_ctx sha1;
+		} m_ctx;
+#endif /* _WIN32 */
+};
+
+ChunkHasher::ChunkHasher(HashAlgorithm algorithm)
+	: m_algorithm(algorithm)
+#ifdef _WIN32
+	, m_hProv(0)
+	, m_hHash(0)
+#endif /* _WIN32 */
+{
+#ifdef _WIN32
+	CryptAcquireContext(&m_hProv, nullptr, nullptr,
+		PROV_RSA_AES, CRYPT_VERIFYCONTEXT);
+#endif /* _WIN32 */
+	reset();
+}
+
+ChunkHasher::~ChunkHasher()
+{
+#ifdef _WIN32
+	if (m_hHash) {
+		CryptDestroyHash(m_hHash);
+	}
+	if (m_hProv) {
+		CryptReleaseContext(m_hProv, 0);
+	}
+#endif /* _WIN32 */
+}
+
+/**
+ * Get the digest size of the selected algorithm.
+ * @return Digest size, in bytes.
+ */
+size_t ChunkHasher::digestSize(void) const
+{
+	switch (m_algorithm) {
+		case HASH_ALGORITHM_MD5:
+			return 16;
+		case HASH_ALGORITHM_SHA1:
+			return 20;
+		default:
+			assert(!"Unsupported hash algorithm.");
+			return 0;
+	}
+}
+
+/**
+ * Reset the hash context for a new message.
+ */
+void ChunkHasher::reset(void)
+{
+#ifdef _WIN32
+	if (m_hHash) {
+		CryptDestroyHash(m_hHash);
+		m_hHash = 0;
+	}
+	const ALG_ID algId = (m_algorithm == HASH_ALGORITHM_SHA1)
+		? CALG_SHA1 : CALG_MD5;
+	CryptCreateHash(m_hProv, algId, 0, 0, &m_hHash);
+#else /* !_WIN32 */
+	switch (m_algorithm) {
+		case HASH_ALGORITHM_MD5:
+			md5_init(&m_ctx.md5);
+			break;
+		case HASH_ALGORITHM_SHA1:
+			sha1_init(&m_ctx.sha1);
+			break;
+		default:
+			assert(!"Unsupported hash algorithm.");
+			break;
+	}
+#endif /* _WIN32 */
+}
+
+/**
+ * Process message data.
+ * @param data Data.
+ * @param size Size of data, in bytes.
+ */
+void ChunkHasher::update(const uint8_t *data, size_t size)
+{
+#ifdef _WIN32
+	CryptHashData(m_hHash, data, static_cast<DWORD>(size), 0);
+#else /* !_WIN32 */
+	switch (m_algorithm) {
+		case HASH_ALGORITHM_MD5:
+			md5_update(&m_ctx.md5, size, data);
+			break;
+		case HASH_ALGORITHM_SHA1:
+			sha1_update(&m_ctx.sha1, size, data);
+			break;
+		default:
+			assert(!"Unsupported hash algorithm.");
+			break;
+	}
+#endif /* _WIN32 */
+}
+
+/**
+ * Finalize the hash and retrieve the digest.
+ * The context must be reset() before it is reused.
+ * @param pDigest Output buffer. (Must be digestSize() bytes.)
+ */
+void ChunkHasher::finalize(uint8_t *pDigest)
+{
+#ifdef _WIN32
+	DWORD cbDigest = static_cast<DWORD>(digestSize());
+	CryptGetHashParam(m_hHash, HP_HASHVAL, pDigest, &cbDigest, 0);
+#else /* !_WIN32 */
+	switch (m_algorithm) {
+		case HASH_ALGORITHM_MD5:
+			md5_digest(&m_ctx.md5, MD5_DIGEST_SIZE, pDigest);
+			break;
+		case HASH_ALGORITHM_SHA1:
+			sha1_digest(&m_ctx.sha1, SHA1_DIGEST_SIZE, pDigest);
+			break;
+		default:
+			assert(!"Unsupported hash algorithm.");
+			break;
+	}
+#endif /* _WIN32 */
+}
+
+/**
+ * Worker thread function for parallel chunk hashing.
+ *
+ * Each worker opens its own file handle, so chunk reads from
+ * different workers overlap with each other and with hashing.
+ * Chunks are claimed via an atomic counter, so faster workers
+ * automatically pick up more chunks.
+ *
+ * @param filename	[in] Filename.
+ * @param algorithm	[in] Hash algorithm.
+ * @param fileSize	[in] Total file size.
+ * @param chunkCount	[in] Number of chunks.
+ * @param pNextChunk	[in/out] Next chunk to claim.
+ * @param pDigests	[out] Chunk digest array. (chunkCount * digestSize)
+ * @param pErr		[out] Set to a POSIX error code on failure.
+ */
+static void HashWorker(const char *filename, HashAlgorithm algorithm,
+	off64_t fileSize, unsigned int chunkCount,
+	atomic<unsigned int> *pNextChunk, uint8_t *pDigests, atomic<int> *pErr)
+{
+	RpFile *const file = new RpFile(filename, RpFile::FM_OPEN_READ);
+	if (!file->isOpen()) {
+		pErr->store(file->lastError());
+		file->unref();
+		return;
+	}
+
+	unique_ptr<uint8_t[]> buf(new uint8_t[HASH_CHUNK_SIZE]);
+	ChunkHasher hasher(algorithm);
+	const size_t digestSize = hasher.digestSize();
+
+	for (;;) {
+		const unsigned int idx = pNextChunk->fetch_add(1);
+		if (idx >= chunkCount)
+			break;
+
+		const off64_t addr = static_cast<off64_t>(idx) * HASH_CHUNK_SIZE;
+		const size_t len = static_cast<size_t>(
+			std::min(static_cast<off64_t>(HASH_CHUNK_SIZE), fileSize - addr));
+		if (file->seek(addr) != 0 || file->read(buf.get(), len) != len) {
+			pErr->store(file->lastError() ? file->lastError() : EIO);
+			break;
+		}
+
+		hasher.reset();
+		hasher.update(buf.get(), len);
+		hasher.finalize(&pDigests[idx * digestSize]);
+	}
+
+	file->unref();
+}
+
+/**
+ * Hash a file and print the digest to stdout.
+ *
+ * The file is hashed in fixed-size chunks, which are distributed over
+ * a pool of worker threads. Files that fit in a single chunk produce
+ * the standard MD5/SHA-1 digest; larger files produce a tree hash
+ * (the digest of the concatenated chunk digests), which is labeled
+ * accordingly in the output.
+ *
+ * @param filename Filename.
+ * @param algorithm Hash algorithm.
+ * @param nThreads Number of worker threads. (0 or 1 for single-threaded)
+ * @return 0 on success; non-zero on error.
+ */
+int DoHashFile(const char *filename, HashAlgorithm algorithm, unsigned int nThreads)
+{
+	// Open the file once to get its size.
+	// NOTE: No transparent gzip decompression here; hashing is
+	// intended to verify the file as stored on disk.
+	RpFile *const file = new RpFile(filename, RpFile::FM_OPEN_READ);
+	if (!file->isOpen()) {
+		const int err = file->lastError();
+		cerr << rp_sprintf(C_("rpcli", "Couldn't open file: %s"), strerror(err)) << endl;
+		file->unref();
+		return err;
+	}
+	const off64_t fileSize = file->size();
+	file->unref();
+
+	// Determine the chunk count.
+	// An empty file is hashed as a single empty chunk.
+	const unsigned int chunkCount = (fileSize > 0)
+		? static_cast<unsigned int>((fileSize + HASH_CHUNK_SIZE - 1) / HASH_CHUNK_SIZE)
+		: 1;
+
+	// Clamp the thread count to the chunk count.
+	if (nThreads == 0) {
+		nThreads = 1;
+	}
+	nThreads = std::min(nThreads, chunkCount);
+
+	// Hash the chunks.
+	vector<uint8_t> digests;
+	ChunkHasher finalHasher(algorithm);
+	const size_t digestSize = finalHasher.digestSize();
+	digests.resize(chunkCount * digestSize);
+
+	atomic<unsigned int> nextChunk(0);
+	atomic<int> workerErr(0);
+	if (nThreads > 1) {
+		vector<thread> workers;
+		workers.reserve(nThreads);
+		for (unsigned int i = 0; i < nThreads; i++) {
+			workers.emplace_back(thread(HashWorker, filename, algorithm,
+				fileSize, chunkCount, &nextChunk, digests.data(), &workerErr));
+		}
+		for (auto &worker : workers) {
+			worker.join();
+		}
+	} else {
+		HashWorker(filename, algorithm, fileSize, chunkCount,
+			&nextChunk, digests.data(), &workerErr);
+	}
+
+	const int err = workerErr.load();
+	if (err != 0) {
+		cerr << rp_sprintf(C_("rpcli", "Error hashing file: %s"), strerror(err)) << endl;
+		return err;
+	}
+
+	// Compute the final digest.
+	// A single-chunk file's chunk digest is the standard digest.
+	uint8_t digest[HASH_DIGEST_SIZE_MAX];
+	const char *algoName;
+	if (chunkCount == 1) {
+		memcpy(digest, digests.data(), digestSize);
+		algoName = (algorithm == HASH_ALGORITHM_SHA1) ? "SHA1" : "MD5";
+	} else {
+		finalHasher.update(digests.data(), digests.size());
+		finalHasher.finalize(digest);
+		algoName = (algorithm == HASH_ALGORITHM_SHA1) ? "SHA1-tree" : "MD5-tree";
+	}
+
+	// Print the digest. (OpenSSL dgst style)
+	cout << algoName << '(' << filename << ") = ";
+	for (size_t i = 0; i < digestSize; i++) {
+		char buf[3];
+		snprintf(buf, sizeof(buf), "%02x", digest[i]);
+		cout << buf;
+	}
+	cout << '\n';
+	cout.flush();
+	return 0;
+}
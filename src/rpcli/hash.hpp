@@ -0,0 +1,34 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (rpcli)                            *
+ * hash.hpp: Parallel chunked file hashing.                                *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_RPCLI_HASH_HPP__
+#define __ROMPROPERTIES_RPCLI_HASH_HPP__
+
+// Hash algorithms.
+enum HashAlgorithm {
+	HASH_ALGORITHM_MD5 = 0,
+	HASH_ALGORITHM_SHA1,
+};
+
+/**
+ * Hash a file and print the digest to stdout.
+ *
+ * The file is hashed in fixed-size chunks, which are distributed over
+ * a pool of worker threads. Files that fit in a single chunk produce
+ * the standard MD5/SHA-1 digest; larger files produce a tree hash
+ * (the digest of the concatenated chunk digests), which is labeled
+ * accordingly in the output.
+ *
+ * @param filename Filename.
+ * @param algorithm Hash algorithm.
+ * @param nThreads Number of worker threads. (0 or 1 for single-threaded)
+ * @return 0 on success; non-zero on error.
+ */
+int DoHashFile(const char *filename, HashAlgorithm algorithm, unsigned int nThreads);
+
+#endif /* __ROMPROPERTIES_RPCLI_HASH_HPP__ */
@@ -154,8 +154,9 @@ public:
 		// NOTE: nullptr string is an empty string, not an error.
 		auto romField = field.romField;
 		os << ColonPad(field.width, romField.name.c_str());
-		if (romField.data.str) {
-			os << SafeString(romField.data.str, true, field.width);
+		const char *const str = romField.str();
+		if (str) {
+			os << SafeString(str, true, field.width);
 		} else {
 			// Empty string.
 			os << "''";
@@ -735,11 +736,26 @@ public:
 		}
 
 		// Certain characters need to be escaped.
-		const char *str = js.str;
+		// NOTE: Runs of normal characters are written with a single
+		// os.write() instead of one ostream insertion per character.
+		// This matters for batch exports of large collections.
 		os << '"';
-		for (; *str != 0; str++) {
-			const uint8_t chr = static_cast<uint8_t>(*str);
-			if (chr < 0x20) { 
+		const char *run_start = js.str;
+		const char *p = js.str;
+		for (; *p != 0; p++) {
+			const uint8_t chr = static_cast<uint8_t>(*p);
+			if (chr >= 0x20 && chr != '\\' && chr != '"') {
+				// Normal character. Part of the current run.
+				continue;
+			}
+
+			// Flush the current run of normal characters.
+			if (p > run_start) {
+				os.write(run_start, p - run_start);
+			}
+			run_start = p + 1;
+
+			if (chr < 0x20) {
 				// Control characters need to be escaped.
 				static const char ctrl_escape_letters[0x20] = {
 					  0,   0,   0,   0,   0,   0,   0,   0,	// 0x00-0x07
@@ -750,26 +766,25 @@ public:
 				const char letter = ctrl_escape_letters[chr];
 				if (letter != 0) {
 					// Escape character is available.
-					os << '\\' << letter;
+					const char esc[2] = {'\\', letter};
+					os.write(esc, 2);
 				} else {
 					// No escape character. Use a Unicode escape.
-					char buf[16];
-					snprintf(buf, sizeof(buf), "\\u%04X", chr);
-					os << buf;
-				}
-			} else {
-				// Check for backslash and double-quotes.
-				if (chr == '\\') {
-					os << "\\\\";
-				} else if (chr == '"') {
-					os << "\\\"";
-				} else {
-					// Normal character.
-					os << static_cast<char>(chr);
+					char buf[8];
+					const int len = snprintf(buf, sizeof(buf), "\\u%04X", chr);
+					os.write(buf, len);
 				}
+			} else if (chr == '\\') {
+				os.write("\\\\", 2);
+			} else /*if (chr == '"')*/ {
+				os.write("\\\"", 2);
 			}
 		}
 
+		// Flush the last run of normal characters.
+		if (p > run_start) {
+			os.write(run_start, p - run_start);
+		}
 		return os << '"';
 	}
 };
@@ -787,8 +802,10 @@ public:
 			if (!romField.isValid)
 				continue;
 
+			// NOTE: '\n' instead of endl to avoid flushing the
+			// stream after every field.
 			if (printed_first)
-				os << ',' << endl;
+				os << ",\n";
 
 			switch (romField.type) {
 			case RomFields::RFT_INVALID: {
@@ -800,7 +817,7 @@ public:
 			case RomFields::RFT_STRING: {
 				os << "{\"type\":\"STRING\",\"desc\":{\"name\":" << JSONString(romField.name.c_str())
 				   << ",\"format\":" << romField.desc.flags
-				   << "},\"data\":" << JSONString(romField.data.str->c_str()) << '}';
+				   << "},\"data\":" << JSONString(romField.str()) << '}';
 				break;
 			}
 
@@ -26,14 +26,20 @@ using namespace LibRpBase;
 
 // librpfile
 #include "librpfile/config.librpfile.h"
+#include "librpfile/DirScanner.hpp"
 #include "librpfile/FileSystem.hpp"
 #include "librpfile/RpFile.hpp"
+#include "librpfile/RpStats.hpp"
 using namespace LibRpFile;
 
 // libromdata
 #include "libromdata/RomDataFactory.hpp"
+#include "libromdata/data/AmiiboData.hpp"
 using LibRomData::RomDataFactory;
 
+// libcachecommon
+#include "libcachecommon/NegativeCache.hpp"
+
 // librptexture
 #include "librptexture/img/rp_image.hpp"
 using LibRpTexture::rp_image;
@@ -41,11 +47,18 @@ using LibRpTexture::rp_image;
 #ifdef _WIN32
 // libwin32common
 # include "libwin32common/RpWin32_sdk.h"
+# include "librpbase/TextFuncs_wchar.hpp"
+#else /* !_WIN32 */
+// Unix socket for server mode. (--server)
+# include <sys/socket.h>
+# include <sys/un.h>
+# define RP_RPCLI_SERVER_SUPPORTED 1
 #endif /* _WIN32 */
 
 #include "properties.hpp"
 #ifdef ENABLE_DECRYPTION
 # include "verifykeys.hpp"
+# include "hash.hpp"
 #endif /* ENABLE_DECRYPTION */
 #include "device.hpp"
 
@@ -67,16 +80,24 @@ using LibRpTexture::rp_image;
 #include <cerrno>
 
 // C++ includes.
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
 #include <fstream>
 #include <iostream>
 #include <locale>
+#include <mutex>
+#include <sstream>
 #include <string>
+#include <thread>
 #include <vector>
 using std::cout;
 using std::cerr;
 using std::endl;
 using std::locale;
 using std::ofstream;
+using std::ostream;
+using std::ostringstream;
 using std::string;
 using std::vector;
 
@@ -97,12 +118,74 @@ struct ExtractParam {
 		: filename(filename), image_type(image_type) { }
 };
 
+/**
+ * Save an image to a PNG file, or stream it to standard output
+ * if the filename is "-". (pipe-friendly; the PNG chunks are
+ * written as they're compressed, without full-output buffering)
+ * @param filename Destination filename, or "-" for stdout.
+ * @param image rp_image to save.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int SaveImage(const char *filename, const rp_image *image)
+{
+	if (strcmp(filename, "-") != 0) {
+		return RpPng::save(filename, image);
+	}
+
+#ifdef _WIN32
+	// TODO: Writing binary data to stdout on Windows requires
+	// switching the stream to binary mode first.
+	return -ENOTSUP;
+#else /* !_WIN32 */
+	RpFile *const file = new RpFile("/dev/stdout", RpFile::FM_CREATE_WRITE);
+	if (!file->isOpen()) {
+		const int err = file->lastError();
+		file->unref();
+		return (err != 0 ? -err : -EIO);
+	}
+	const int ret = RpPng::save(file, image);
+	file->unref();
+	return ret;
+#endif /* _WIN32 */
+}
+
+/**
+ * Save an animated image to an APNG file, or stream it to standard
+ * output if the filename is "-". (pipe-friendly)
+ * @param filename Destination filename, or "-" for stdout.
+ * @param iconAnimData Animated image data to save.
+ * @return 0 on success; negative POSIX error code on error.
+ */
+static int SaveImage(const char *filename, const IconAnimData *iconAnimData)
+{
+	if (strcmp(filename, "-") != 0) {
+		return RpPng::save(filename, iconAnimData);
+	}
+
+#ifdef _WIN32
+	// TODO: Writing binary data to stdout on Windows requires
+	// switching the stream to binary mode first.
+	return -ENOTSUP;
+#else /* !_WIN32 */
+	RpFile *const file = new RpFile("/dev/stdout", RpFile::FM_CREATE_WRITE);
+	if (!file->isOpen()) {
+		const int err = file->lastError();
+		file->unref();
+		return (err != 0 ? -err : -EIO);
+	}
+	const int ret = RpPng::save(file, iconAnimData);
+	file->unref();
+	return ret;
+#endif /* _WIN32 */
+}
+
 /**
 * Extracts images from romdata
 * @param romData RomData containing the images
 * @param extract Vector of image extraction parameters
+* @param err Output stream for status messages. (default is cerr)
 */
-static void ExtractImages(const RomData *romData, vector<ExtractParam>& extract) {
+static void ExtractImages(const RomData *romData, vector<ExtractParam>& extract, ostream &err = cerr) {
 	int supported = romData->supportedImageTypes();
 	for (auto it = extract.begin(); it != extract.end(); ++it) {
 		if (!it->filename) continue;
@@ -113,18 +196,18 @@ static void ExtractImages(const RomData *romData, vector<ExtractParam>& extract)
 			auto image = romData->image((RomData::ImageType)it->image_type);
 			if (image && image->isValid()) {
 				found = true;
-				cerr << "-- " <<
+				err << "-- " <<
 					// tr: %1$s == image type name, %2$s == output filename
 					rp_sprintf_p(C_("rpcli", "Extracting %1$s into '%2$s'"),
 						RomData::getImageTypeName((RomData::ImageType)it->image_type),
 						it->filename) << endl;
-				int errcode = RpPng::save(it->filename, image);
+				int errcode = SaveImage(it->filename, image);
 				if (errcode != 0) {
 					// tr: %1$s == filename, %2%s == error message
-					cerr << rp_sprintf_p(C_("rpcli", "Couldn't create file '%1$s': %2$s"),
+					err << rp_sprintf_p(C_("rpcli", "Couldn't create file '%1$s': %2$s"),
 						it->filename, strerror(-errcode)) << endl;
 				} else {
-					cerr << "   " << C_("rpcli", "Done") << endl;
+					err << "   " << C_("rpcli", "Done") << endl;
 				}
 			}
 		}
@@ -134,28 +217,28 @@ static void ExtractImages(const RomData *romData, vector<ExtractParam>& extract)
 			auto iconAnimData = romData->iconAnimData();
 			if (iconAnimData && iconAnimData->count != 0 && iconAnimData->seq_count != 0) {
 				found = true;
-				cerr << "-- " << rp_sprintf(C_("rpcli", "Extracting animated icon into '%s'"), it->filename) << endl;
-				int errcode = RpPng::save(it->filename, iconAnimData);
+				err << "-- " << rp_sprintf(C_("rpcli", "Extracting animated icon into '%s'"), it->filename) << endl;
+				int errcode = SaveImage(it->filename, iconAnimData);
 				if (errcode == -ENOTSUP) {
-					cerr << "   " << C_("rpcli", "APNG not supported, extracting only the first frame") << endl;
+					err << "   " << C_("rpcli", "APNG not supported, extracting only the first frame") << endl;
 					// falling back to outputting the first frame
-					errcode = RpPng::save(it->filename, iconAnimData->frames[iconAnimData->seq_index[0]]);
+					errcode = SaveImage(it->filename, iconAnimData->frames[iconAnimData->seq_index[0]]);
 				}
 				if (errcode != 0) {
-					cerr << "   " <<
+					err << "   " <<
 						rp_sprintf_p(C_("rpcli", "Couldn't create file '%1$s': %2$s"),
 							it->filename, strerror(-errcode)) << endl;
 				} else {
-					cerr << "   " << C_("rpcli", "Done") << endl;
+					err << "   " << C_("rpcli", "Done") << endl;
 				}
 			}
 		}
 		if (!found) {
 			// TODO: Return an error code?
 			if (it->image_type == -1) {
-				cerr << "-- " << C_("rpcli", "Animated icon not found") << endl;
+				err << "-- " << C_("rpcli", "Animated icon not found") << endl;
 			} else {
-				cerr << "-- " <<
+				err << "-- " <<
 					rp_sprintf(C_("rpcli", "Image '%s' not found"),
 						RomData::getImageTypeName((RomData::ImageType)it->image_type)) << endl;
 			}
@@ -163,42 +246,557 @@ static void ExtractImages(const RomData *romData, vector<ExtractParam>& extract)
 	}
 }
 
+#ifdef ENABLE_RP_STATS
+/**
+ * Scoped trace helper for --trace mode. Records a trace event
+ * with the elapsed time and bytes read when it goes out of scope.
+ * Does nothing if tracing is disabled.
+ */
+class TraceStage {
+	public:
+		TraceStage(const char *stage, const char *detail)
+			: m_stage(stage), m_detail(detail)
+			, m_enabled(RpStats::isTraceEnabled())
+		{
+			if (m_enabled) {
+				m_bytes_start = RpStats::get(RpStats::CTR_FILE_BYTES_READ);
+				m_start = std::chrono::steady_clock::now();
+			}
+		}
+
+		~TraceStage()
+		{
+			if (!m_enabled)
+				return;
+			const auto elapsed = std::chrono::steady_clock::now() - m_start;
+			RpStats::traceEvent(m_stage, m_detail,
+				static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count()),
+				RpStats::get(RpStats::CTR_FILE_BYTES_READ) - m_bytes_start);
+		}
+
+	private:
+		RP_DISABLE_COPY(TraceStage)
+		const char *m_stage;
+		const char *m_detail;
+		bool m_enabled;
+		uint64_t m_bytes_start;
+		std::chrono::steady_clock::time_point m_start;
+};
+#else /* !ENABLE_RP_STATS */
+class TraceStage {
+	public:
+		TraceStage(const char *stage, const char *detail)
+		{
+			RP_UNUSED(stage);
+			RP_UNUSED(detail);
+		}
+	private:
+		RP_DISABLE_COPY(TraceStage)
+};
+#endif /* ENABLE_RP_STATS */
+
 /**
  * Shows info about file
  * @param filename ROM filename
  * @param json Is program running in json mode?
  * @param extract Vector of image extraction parameters
  * @param languageCode Language code. (0 for default)
+ * @param os Output stream for ROM data. (default is cout; batch mode uses a string buffer)
+ * @param err Output stream for status messages. (default is cerr; batch mode uses a string buffer)
  */
-static void DoFile(const char *filename, bool json, vector<ExtractParam>& extract, uint32_t languageCode = 0)
+static void DoFile(const char *filename, bool json, vector<ExtractParam>& extract,
+	uint32_t languageCode = 0, ostream &os = cout, ostream &err = cerr)
 {
-	cerr << "== " << rp_sprintf(C_("rpcli", "Reading file '%s'..."), filename) << endl;
+	err << "== " << rp_sprintf(C_("rpcli", "Reading file '%s'..."), filename) << endl;
 	RpFile *const file = new RpFile(filename, RpFile::FM_OPEN_READ_GZ);
 	if (file->isOpen()) {
-		RomData *romData = RomDataFactory::create(file);
+		// Check the persistent negative cache first, so batch runs
+		// over mixed directories don't re-probe files that are
+		// known to be unsupported.
+		const off64_t ncache_size = file->size();
+		time_t ncache_mtime = -1;
+		const bool ncache_usable =
+			(LibRpFile::FileSystem::get_mtime(filename, &ncache_mtime) == 0);
+
+		RomData *romData = nullptr;
+		if (!ncache_usable ||
+		    !LibCacheCommon::isFileUnsupported(filename, ncache_size, ncache_mtime, 0))
+		{
+			TraceStage trace("factory", "RomDataFactory::create()");
+			romData = RomDataFactory::create(file);
+			if (ncache_usable && (!romData || !romData->isValid())) {
+				// File is not supported. Remember that.
+				LibCacheCommon::addUnsupportedFile(filename,
+					ncache_size, ncache_mtime, 0);
+			}
+		}
 		if (romData && romData->isValid()) {
-			if (json) {
-				cerr << "-- " << C_("rpcli", "Outputting JSON data") << endl;
-				cout << JSONROMOutput(romData, languageCode) << endl;
-			} else {
-				cout << ROMOutput(romData, languageCode) << endl;
+			{
+				TraceStage trace("output", "fields and metadata");
+				if (json) {
+					err << "-- " << C_("rpcli", "Outputting JSON data") << endl;
+					os << JSONROMOutput(romData, languageCode) << endl;
+				} else {
+					os << ROMOutput(romData, languageCode) << endl;
+				}
 			}
 
-			ExtractImages(romData, extract);
+			{
+				TraceStage trace("extract", "image extraction");
+				ExtractImages(romData, extract, err);
+			}
 		} else {
-			cerr << "-- " << C_("rpcli", "ROM is not supported") << endl;
-			if (json) cout << "{\"error\":\"rom is not supported\"}" << endl;
+			err << "-- " << C_("rpcli", "ROM is not supported") << endl;
+			if (json) os << "{\"error\":\"rom is not supported\"}" << endl;
 		}
 
 		if (romData) {
 			romData->unref();
 		}
+
+		if (RpStats::isTraceEnabled()) {
+			// Dump the per-stage trace for this file.
+			// NOTE: Written to the status stream so JSON output
+			// stays valid.
+			RpStats::dumpTrace(err);
+		}
 	} else {
-		cerr << "-- " << rp_sprintf(C_("rpcli", "Couldn't open file: %s"), strerror(file->lastError())) << endl;
-		if (json) cout << "{\"error\":\"couldn't open file\",\"code\":" << file->lastError() << "}" << endl;
+		err << "-- " << rp_sprintf(C_("rpcli", "Couldn't open file: %s"), strerror(file->lastError())) << endl;
+		if (json) os << "{\"error\":\"couldn't open file\",\"code\":" << file->lastError() << "}" << endl;
+	}
+	file->unref();
+}
+
+/**
+ * Extract all available internal images from a file. (--extract-all)
+ *
+ * Output filenames are derived from the source filename:
+ * "<basename>.<type>.png" in the output directory, e.g.
+ * "game.gcm.icon.png". Files that aren't supported ROM images
+ * are skipped silently, since bulk runs usually cover mixed
+ * directory trees.
+ *
+ * @param filename ROM filename
+ * @param outdir Output directory
+ * @param err Output stream for status messages. (default is cerr)
+ */
+static void DoBulkExtract(const char *filename, const char *outdir, ostream &err = cerr)
+{
+	RpFile *const file = new RpFile(filename, RpFile::FM_OPEN_READ_GZ);
+	if (!file->isOpen()) {
+		err << "== " << rp_sprintf(C_("rpcli", "Reading file '%s'..."), filename) << endl;
+		err << "-- " << rp_sprintf(C_("rpcli", "Couldn't open file: %s"), strerror(file->lastError())) << endl;
+		file->unref();
+		return;
 	}
+
+	RomData *const romData = RomDataFactory::create(file);
 	file->unref();
+	if (!romData || !romData->isValid()) {
+		// Not a supported ROM image. Skip it silently.
+		if (romData) {
+			romData->unref();
+		}
+		return;
+	}
+
+	// Determine the output filename base.
+	// NOTE: Keeping the source file's extension to reduce
+	// collisions, e.g. "foo.gcm" vs. "foo.nds".
+	const char *basename = strrchr(filename, '/');
+#ifdef _WIN32
+	const char *const basename_bs = strrchr(filename, '\\');
+	if (basename_bs > basename) {
+		basename = basename_bs;
+	}
+#endif /* _WIN32 */
+	basename = (basename ? basename + 1 : filename);
+	string out_base(outdir);
+#ifdef _WIN32
+	out_base += '\\';
+#else /* !_WIN32 */
+	out_base += '/';
+#endif /* _WIN32 */
+	out_base += basename;
+
+	// Filename suffixes for the internal image types.
+	// NOTE: Not translated; these end up in filenames.
+	static const char *const image_type_suffixes[] = {
+		"icon",		// IMG_INT_ICON
+		"banner",	// IMG_INT_BANNER
+		"media",	// IMG_INT_MEDIA
+		"image",	// IMG_INT_IMAGE
+	};
+	static_assert(ARRAY_SIZE(image_type_suffixes) == RomData::IMG_INT_MAX - RomData::IMG_INT_MIN + 1,
+		"image_type_suffixes[] needs to be updated.");
+
+	// Queue up all supported internal image types.
+	// NOTE: External image types are not extracted, since they'd
+	// require downloads. Use the cache manager for those.
+	vector<string> out_filenames;
+	out_filenames.reserve(RomData::IMG_INT_MAX - RomData::IMG_INT_MIN + 2);
+	vector<ExtractParam> extract;
+	const uint32_t supported = romData->supportedImageTypes();
+	for (int i = RomData::IMG_INT_MIN; i <= RomData::IMG_INT_MAX; i++) {
+		if (!(supported & (1U << i)))
+			continue;
+		out_filenames.emplace_back(out_base + '.' + image_type_suffixes[i] + ".png");
+		extract.emplace_back(ExtractParam(out_filenames.back().c_str(), i));
+	}
+	if (romData->iconAnimData() != nullptr) {
+		// Animated icon.
+		out_filenames.emplace_back(out_base + ".iconanim.png");
+		extract.emplace_back(ExtractParam(out_filenames.back().c_str(), -1));
+	}
+
+	if (!extract.empty()) {
+		err << "== " << rp_sprintf(C_("rpcli", "Extracting images from '%s'..."), filename) << endl;
+		ExtractImages(romData, extract, err);
+	}
+	romData->unref();
+}
+
+/**
+ * Batch mode job. (-t / -R)
+ * The output streams are buffered per file so the merged
+ * output matches the order the files were queued in.
+ */
+struct BatchJob {
+	string filename;	// ROM filename
+	uint32_t languageCode;	// Language code in effect when the file was queued
+	string s_out;		// Buffered stdout (ROM data)
+	string s_err;		// Buffered stderr (status messages)
+	bool done;		// Set by the worker thread once the job is finished
+
+	BatchJob(const char *filename, uint32_t languageCode)
+		: filename(filename), languageCode(languageCode), done(false) { }
+};
+
+/**
+ * Recursively collect files from a directory for batch mode. (-R)
+ * Results are sorted by full pathname so runs are deterministic.
+ * @param path Directory path.
+ * @param languageCode Language code. (0 for default)
+ * @param jobs Vector to append BatchJobs to.
+ */
+static void CollectFilesRecursive(const string &path, uint32_t languageCode, vector<BatchJob> &jobs)
+{
+	// Scan the directory tree using the shared directory scanner.
+	// Subdirectories are enumerated in parallel.
+	DirScanner::ScanOptions options;
+	options.recursive = true;
+
+	vector<string> files;
+	if (DirScanner::scan(path, options, files) != 0) {
+		// Cannot read the directory.
+		return;
+	}
+
+	jobs.reserve(jobs.size() + files.size());
+	for (auto iter = files.cbegin(); iter != files.cend(); ++iter) {
+		jobs.emplace_back(BatchJob(iter->c_str(), languageCode));
+	}
+}
+
+/**
+ * Process the queued batch jobs. (-t / -R)
+ *
+ * Worker threads claim jobs from a shared atomic counter, so a thread
+ * that finishes a small file immediately "steals" the next queued file
+ * instead of sitting idle behind a large disc image. Each job's output
+ * is buffered and printed by the main thread in queue order.
+ *
+ * @param jobs Batch jobs.
+ * @param json Is program running in json mode?
+ * @param nThreads Number of worker threads.
+ * @param extract_dir If non-null, extract images to this directory instead of printing ROM data. (--extract-all)
+ */
+static void RunBatch(vector<BatchJob> &jobs, bool json, unsigned int nThreads, const char *extract_dir = nullptr)
+{
+	if (jobs.empty())
+		return;
+
+	// Queue header readahead for all jobs up front, so the disk's
+	// command queue stays full while the workers parse each file.
+	// 64 KB covers the header checks of every supported RomData class.
+	{
+		vector<string> filenames;
+		filenames.reserve(jobs.size());
+		for (auto iter = jobs.cbegin(); iter != jobs.cend(); ++iter) {
+			filenames.push_back(iter->filename);
+		}
+		FileSystem::batch_read_ahead(filenames, 64*1024);
+	}
+
+	// Image extraction with explicit filenames is not supported in batch mode.
+	vector<ExtractParam> no_extract;
+
+	if (nThreads <= 1) {
+		// Single-threaded: Process the jobs in order without buffering.
+		bool first = true;
+		for (auto iter = jobs.begin(); iter != jobs.end(); ++iter) {
+			if (extract_dir) {
+				DoBulkExtract(iter->filename.c_str(), extract_dir);
+				continue;
+			}
+			if (first) first = false;
+			else if (json) cout << "," << endl;
+			DoFile(iter->filename.c_str(), json, no_extract, iter->languageCode);
+		}
+		return;
+	}
+
+	// Don't start more threads than there are jobs.
+	if (nThreads > jobs.size()) {
+		nThreads = static_cast<unsigned int>(jobs.size());
+	}
+
+	std::atomic<size_t> nextJob(0);
+	std::mutex mtx;
+	std::condition_variable cv;
+
+	// Worker thread: Claim jobs until the queue is exhausted.
+	auto workerFn = [&jobs, &nextJob, &mtx, &cv, json, &no_extract, extract_dir]() {
+		while (true) {
+			const size_t idx = nextJob.fetch_add(1);
+			if (idx >= jobs.size())
+				break;
+			BatchJob &job = jobs[idx];
+
+			ostringstream oss, ess;
+			if (extract_dir) {
+				DoBulkExtract(job.filename.c_str(), extract_dir, ess);
+			} else {
+				DoFile(job.filename.c_str(), json, no_extract,
+					job.languageCode, oss, ess);
+			}
+
+			{
+				std::lock_guard<std::mutex> lock(mtx);
+				job.s_out = oss.str();
+				job.s_err = ess.str();
+				job.done = true;
+			}
+			cv.notify_all();
+		}
+	};
+
+	vector<std::thread> threads;
+	threads.reserve(nThreads);
+	for (unsigned int i = 0; i < nThreads; i++) {
+		threads.emplace_back(std::thread(workerFn));
+	}
+
+	// Print the buffered output in queue order as jobs finish.
+	bool first = true;
+	for (auto iter = jobs.begin(); iter != jobs.end(); ++iter) {
+		BatchJob &job = *iter;
+		{
+			std::unique_lock<std::mutex> lock(mtx);
+			cv.wait(lock, [&job]() { return job.done; });
+		}
+
+		cerr << job.s_err;
+		if (first) first = false;
+		else if (json) cout << "," << endl;
+		cout << job.s_out;
+	}
+
+	for (auto iter = threads.begin(); iter != threads.end(); ++iter) {
+		iter->join();
+	}
+}
+
+#ifdef RP_RPCLI_SERVER_SUPPORTED
+/**
+ * Write a buffer to a socket, handling partial writes.
+ * @param fd Socket file descriptor.
+ * @param str Buffer to write.
+ * @return 0 on success; -1 on error.
+ */
+static int SocketWrite(int fd, const string &str)
+{
+	const char *p = str.data();
+	size_t remain = str.size();
+	while (remain > 0) {
+		const ssize_t len = write(fd, p, remain);
+		if (len < 0) {
+			if (errno == EINTR)
+				continue;
+			return -1;
+		}
+		p += len;
+		remain -= len;
+	}
+	return 0;
+}
+
+/**
+ * Run rpcli in server mode. (--server)
+ *
+ * Keeps the process warm (locale, i18n, and the various RomData
+ * lookup tables are only initialized once) and answers requests
+ * over a Unix socket, so a media scanner doesn't have to pay
+ * process startup for every file.
+ *
+ * Protocol: One request per connection. The client sends a single
+ * newline-terminated line of tab-separated tokens: -j, -l lang,
+ * -xN outfile, and -a outfile are accepted as on the command line;
+ * the first non-option token is the ROM filename. The response is
+ * the status messages followed by the ROM data; the connection is
+ * closed when the request is finished.
+ *
+ * @param socket_path Unix socket path.
+ * @return 0 on success; non-zero on error.
+ */
+static int RunServer(const char *socket_path)
+{
+	const int sock_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+	if (sock_fd < 0) {
+		cerr << rp_sprintf(C_("rpcli", "Couldn't create socket: %s"), strerror(errno)) << endl;
+		return EXIT_FAILURE;
+	}
+
+	struct sockaddr_un addr;
+	memset(&addr, 0, sizeof(addr));
+	addr.sun_family = AF_UNIX;
+	if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+		cerr << rp_sprintf(C_("rpcli", "Socket path '%s' is too long"), socket_path) << endl;
+		close(sock_fd);
+		return EXIT_FAILURE;
+	}
+	strncpy(addr.sun_path, socket_path, sizeof(addr.sun_path)-1);
+
+	// Remove a stale socket from a previous run.
+	unlink(socket_path);
+
+	if (bind(sock_fd, reinterpret_cast<const struct sockaddr*>(&addr), sizeof(addr)) != 0 ||
+	    listen(sock_fd, 16) != 0)
+	{
+		cerr << rp_sprintf_p(C_("rpcli", "Couldn't listen on '%1$s': %2$s"),
+			socket_path, strerror(errno)) << endl;
+		close(sock_fd);
+		return EXIT_FAILURE;
+	}
+
+	cerr << rp_sprintf(C_("rpcli", "rpcli: Listening on '%s'"), socket_path) << endl;
+
+	while (true) {
+		const int client_fd = accept(sock_fd, nullptr, nullptr);
+		if (client_fd < 0) {
+			if (errno == EINTR)
+				continue;
+			break;
+		}
+
+		// Read the request line.
+		string req;
+		req.reserve(256);
+		char buf[1024];
+		while (req.size() < 65536 && req.find('\n') == string::npos) {
+			const ssize_t len = read(client_fd, buf, sizeof(buf));
+			if (len <= 0)
+				break;
+			req.append(buf, len);
+		}
+		const size_t nl_pos = req.find('\n');
+		if (nl_pos != string::npos) {
+			req.resize(nl_pos);
+		}
+		if (!req.empty() && req[req.size()-1] == '\r') {
+			req.resize(req.size()-1);
+		}
+
+		// Tokenize the request. (tab-separated)
+		vector<string> tokens;
+		size_t pos = 0;
+		while (pos <= req.size()) {
+			const size_t tab_pos = req.find('\t', pos);
+			if (tab_pos == string::npos) {
+				tokens.emplace_back(req.substr(pos));
+				break;
+			}
+			tokens.emplace_back(req.substr(pos, tab_pos - pos));
+			pos = tab_pos + 1;
+		}
+
+		// Parse the tokens.
+		bool json = false;
+		uint32_t languageCode = 0;
+		string filename;
+		vector<ExtractParam> extract;
+		ostringstream oss, ess;
+		for (size_t i = 0; i < tokens.size(); i++) {
+			const string &tok = tokens[i];
+			if (tok.empty())
+				continue;
+
+			if (tok[0] != '-') {
+				// ROM filename.
+				filename = tok;
+				continue;
+			}
+
+			switch (tok[1]) {
+			case 'j':
+				json = true;
+				break;
+			case 'l': {
+				// Language code. (same argument only)
+				uint32_t lc = 0;
+				int cpos;
+				for (cpos = 2; cpos < 6 && tok.c_str()[cpos] != '\0'; cpos++) {
+					lc <<= 8;
+					lc |= (uint8_t)tok[cpos];
+				}
+				if (cpos == 6 && tok.c_str()[cpos] != '\0') {
+					ess << rp_sprintf(C_("rpcli", "Warning: ignoring invalid language code '%s'"), tok.c_str()+2) << endl;
+					break;
+				}
+				languageCode = lc;
+				break;
+			}
+			case 'x': {
+				const long num = atol(tok.c_str() + 2);
+				if (num < RomData::IMG_INT_MIN || num > RomData::IMG_INT_MAX) {
+					ess << rp_sprintf(C_("rpcli", "Warning: skipping unknown image type %ld"), num) << endl;
+					i++;
+					break;
+				}
+				if (i + 1 < tokens.size()) {
+					extract.emplace_back(ExtractParam(tokens[++i].c_str(), num));
+				}
+				break;
+			}
+			case 'a':
+				if (i + 1 < tokens.size()) {
+					extract.emplace_back(ExtractParam(tokens[++i].c_str(), -1));
+				}
+				break;
+			default:
+				ess << rp_sprintf(C_("rpcli", "Warning: skipping unknown switch '%c'"), tok[1]) << endl;
+				break;
+			}
+		}
+
+		if (!filename.empty()) {
+			DoFile(filename.c_str(), json, extract, languageCode, oss, ess);
+		} else {
+			ess << C_("rpcli", "Error: no filename specified") << endl;
+		}
+
+		// Send the status messages, then the ROM data.
+		if (SocketWrite(client_fd, ess.str()) == 0) {
+			SocketWrite(client_fd, oss.str());
+		}
+		close(client_fd);
+	}
+
+	close(sock_fd);
+	unlink(socket_path);
+	return EXIT_SUCCESS;
 }
+#endif /* RP_RPCLI_SERVER_SUPPORTED */
 
 /**
  * Print the system region information.
@@ -344,17 +942,30 @@ int RP_C_API main(int argc, char *argv[])
 
 	if(argc < 2){
 #ifdef ENABLE_DECRYPTION
-		cerr << C_("rpcli", "Usage: rpcli [-k] [-c] [-p] [-j] [-l lang] [[-x[b]N outfile]... [-a apngoutfile] filename]...") << endl;
+		cerr << C_("rpcli", "Usage: rpcli [-k] [-c] [-p] [-j] [-l lang] [-t N] [-R] [[-x[b]N outfile]... [-a apngoutfile] filename]...") << endl;
 		cerr << "  -k:   " << C_("rpcli", "Verify encryption keys in keys.conf.") << endl;
 #else /* !ENABLE_DECRYPTION */
-		cerr << C_("rpcli", "Usage: rpcli [-c] [-p] [-j] [-l lang] [[-x[b]N outfile]... [-a apngoutfile] filename]...") << endl;
+		cerr << C_("rpcli", "Usage: rpcli [-c] [-p] [-j] [-l lang] [-t N] [-R] [[-x[b]N outfile]... [-a apngoutfile] filename]...") << endl;
 #endif /* ENABLE_DECRYPTION */
 		cerr << "  -c:   " << C_("rpcli", "Print system region information.") << endl;
 		cerr << "  -p:   " << C_("rpcli", "Print system path information.") << endl;
 		cerr << "  -j:   " << C_("rpcli", "Use JSON output format.") << endl;
 		cerr << "  -l:   " << C_("rpcli", "Retrieve the specified language from the ROM image.") << endl;
-		cerr << "  -xN:  " << C_("rpcli", "Extract image N to outfile in PNG format.") << endl;
+		cerr << "  -t N: " << C_("rpcli", "Process files in batch mode using N worker threads.") << endl;
+		cerr << "  -R:   " << C_("rpcli", "Recursively process directories specified on the command line.") << endl;
+		cerr << "  -xN:  " << C_("rpcli", "Extract image N to outfile in PNG format. ('-' streams to stdout)") << endl;
 		cerr << "  -a:   " << C_("rpcli", "Extract the animated icon to outfile in APNG format.") << endl;
+		cerr << "  --extract-all outdir: " << C_("rpcli", "Extract all internal images from the files (or directories) into outdir.") << endl;
+#ifdef RP_RPCLI_SERVER_SUPPORTED
+		cerr << "  --server path: " << C_("rpcli", "Run as a server, answering requests on a Unix socket.") << endl;
+#endif /* RP_RPCLI_SERVER_SUPPORTED */
+#ifdef ENABLE_DECRYPTION
+		cerr << "  --hash algo: " << C_("rpcli", "Hash the files instead of parsing them. (md5, sha1; -t N hashes chunks in parallel)") << endl;
+#endif /* ENABLE_DECRYPTION */
+#ifdef ENABLE_RP_STATS
+		cerr << "  --stats: " << C_("rpcli", "Print runtime statistics counters on exit.") << endl;
+		cerr << "  --trace: " << C_("rpcli", "Print a per-stage timing trace for each file. (implies --stats)") << endl;
+#endif /* ENABLE_RP_STATS */
 		cerr << endl;
 #ifdef RP_OS_SCSI_SUPPORTED
 		cerr << "Special options for devices:" << endl;
@@ -374,11 +985,46 @@ int RP_C_API main(int argc, char *argv[])
 	bool json = false;
 	vector<ExtractParam> extract;
 
+#ifdef ENABLE_DECRYPTION
+	bool do_hash = false;
+	HashAlgorithm hash_algorithm = HASH_ALGORITHM_MD5;
+#endif /* ENABLE_DECRYPTION */
+
+	const char *server_path = nullptr;
+	const char *extract_dir = nullptr;
 	for (int i = 1; i < argc; i++) { // figure out the json mode in advance
 		if (argv[i][0] == '-' && argv[i][1] == 'j') {
 			json = true;
+		} else if (!strcmp(argv[i], "--extract-all")) {
+			// Bulk extraction mode. The output directory is the next argument.
+			// NOTE: Checked here because JSON array framing
+			// doesn't apply in bulk extraction mode.
+			if (i + 1 < argc) {
+				extract_dir = argv[i+1];
+			}
+#ifdef ENABLE_DECRYPTION
+		} else if (!strcmp(argv[i], "--hash")) {
+			// Hash mode output is plain text, so JSON array
+			// framing doesn't apply.
+			do_hash = true;
+#endif /* ENABLE_DECRYPTION */
+		} else if (!strcmp(argv[i], "--server")) {
+			// Server mode. (--server) The socket path is the next argument.
+			// NOTE: Checked here because JSON array framing
+			// doesn't apply in server mode.
+			if (i + 1 < argc) {
+				server_path = argv[i+1];
+			}
 		}
 	}
+	if (server_path || extract_dir) {
+		json = false;
+	}
+#ifdef ENABLE_DECRYPTION
+	if (do_hash) {
+		json = false;
+	}
+#endif /* ENABLE_DECRYPTION */
 	if (json) cout << "[\n";
 
 #ifdef RP_OS_SCSI_SUPPORTED
@@ -386,6 +1032,11 @@ int RP_C_API main(int argc, char *argv[])
 	bool inq_ata = false;
 #endif /* RP_OS_SCSI_SUPPORTED */
 	uint32_t languageCode = 0;
+	unsigned int nThreads = 0;	// 0 == batch mode disabled
+	bool recursive = false;
+	vector<BatchJob> batchJobs;
+	bool warnedBatchExtract = false;
+	bool show_stats = false;
 	bool first = true;
 	int ret = 0;
 	for (int i = 1; i < argc; i++){
@@ -443,6 +1094,115 @@ int RP_C_API main(int argc, char *argv[])
 				languageCode = lc;
 				break;
 			}
+			case 't': {
+				// Batch mode thread count.
+				// NOTE: The count may be immediately after 't',
+				// or it might be a completely separate argument.
+				const char *s_threads;
+				if (argv[i][2] == '\0') {
+					// Separate argument.
+					s_threads = argv[i+1];
+					i++;
+				} else {
+					// Same argument.
+					s_threads = &argv[i][2];
+				}
+
+				const long num = atol(s_threads);
+				if (num < 1) {
+					cerr << rp_sprintf(C_("rpcli", "Warning: ignoring invalid thread count '%s'"), s_threads) << endl;
+					break;
+				}
+				nThreads = static_cast<unsigned int>(num);
+				break;
+			}
+			case 'R':
+				// Recursively process directories.
+				recursive = true;
+				break;
+			case '-':
+				// Long option.
+				if (!strcmp(argv[i], "--server")) {
+					// Server mode. Already handled above;
+					// skip the socket path argument.
+#ifdef RP_RPCLI_SERVER_SUPPORTED
+					if (!server_path) {
+						cerr << C_("rpcli", "Warning: no socket path specified for --server") << endl;
+					}
+#else /* !RP_RPCLI_SERVER_SUPPORTED */
+					cerr << C_("rpcli", "Warning: server mode is not supported on this platform") << endl;
+					server_path = nullptr;
+#endif /* RP_RPCLI_SERVER_SUPPORTED */
+					if (i + 1 < argc) {
+						i++;
+					}
+				} else if (!strcmp(argv[i], "--extract-all")) {
+					// Bulk extraction mode. Already handled above;
+					// skip the output directory argument.
+					if (!extract_dir) {
+						cerr << C_("rpcli", "Warning: no output directory specified for --extract-all") << endl;
+					}
+					if (i + 1 < argc) {
+						i++;
+					}
+				} else if (!strcmp(argv[i], "--hash")) {
+					// Hash mode. The algorithm is the next argument.
+#ifdef ENABLE_DECRYPTION
+					const char *const s_algo = (i + 1 < argc) ? argv[i+1] : nullptr;
+					if (!s_algo) {
+						cerr << C_("rpcli", "Warning: no algorithm specified for --hash") << endl;
+						do_hash = false;
+					} else if (!strcmp(s_algo, "md5")) {
+						hash_algorithm = HASH_ALGORITHM_MD5;
+					} else if (!strcmp(s_algo, "sha1")) {
+						hash_algorithm = HASH_ALGORITHM_SHA1;
+					} else {
+						cerr << rp_sprintf(C_("rpcli", "Warning: skipping unknown hash algorithm '%s'"), s_algo) << endl;
+						do_hash = false;
+					}
+#else /* !ENABLE_DECRYPTION */
+					cerr << C_("rpcli", "Warning: hashing is not supported in this build") << endl;
+#endif /* ENABLE_DECRYPTION */
+					if (i + 1 < argc) {
+						i++;
+					}
+				} else if (!strcmp(argv[i], "--export-amiibo-data")) {
+					// Export the built-in amiibo data tables
+					// to an external data file.
+					const char *const out_file = (i + 1 < argc) ? argv[i+1] : nullptr;
+					if (!out_file) {
+						cerr << C_("rpcli", "Warning: no output file specified for --export-amiibo-data") << endl;
+					} else {
+						int ret = LibRomData::AmiiboData::exportBinFile(out_file);
+						if (ret == 0) {
+							cerr << rp_sprintf(C_("rpcli", "Exported amiibo data to '%s'"), out_file) << endl;
+						} else {
+							cerr << rp_sprintf(C_("rpcli", "Couldn't export amiibo data: %s"), strerror(-ret)) << endl;
+						}
+					}
+					if (i + 1 < argc) {
+						i++;
+					}
+				} else if (!strcmp(argv[i], "--stats")) {
+					// Dump runtime statistics counters on exit.
+#ifndef ENABLE_RP_STATS
+					cerr << C_("rpcli", "Warning: statistics counters are disabled in this build") << endl;
+#endif /* !ENABLE_RP_STATS */
+					show_stats = true;
+				} else if (!strcmp(argv[i], "--trace")) {
+					// Per-stage timing trace for each file.
+					// Includes probe candidates tried and rejected,
+					// with per-stage timing and I/O information.
+#ifdef ENABLE_RP_STATS
+					RpStats::setTraceEnabled(true);
+					show_stats = true;
+#else /* !ENABLE_RP_STATS */
+					cerr << C_("rpcli", "Warning: statistics counters are disabled in this build") << endl;
+#endif /* ENABLE_RP_STATS */
+				} else {
+					cerr << rp_sprintf(C_("rpcli", "Warning: skipping unknown option '%s'"), argv[i]) << endl;
+				}
+				break;
 			case 'x': {
 				long num = atol(argv[i] + 2);
 				if (num<RomData::IMG_INT_MIN || num>RomData::IMG_INT_MAX) {
@@ -474,6 +1234,36 @@ int RP_C_API main(int argc, char *argv[])
 				cerr << rp_sprintf(C_("rpcli", "Warning: skipping unknown switch '%c'"), argv[i][1]) << endl;
 				break;
 			}
+#ifdef ENABLE_DECRYPTION
+		} else if (do_hash) {
+			// Hash mode: Hash the file instead of parsing it.
+			// NOTE: -t N is reused as the worker thread count.
+			DoHashFile(argv[i], hash_algorithm, nThreads);
+#endif /* ENABLE_DECRYPTION */
+		} else if (nThreads > 0 || recursive || extract_dir) {
+			// Batch mode: Queue the file for processing after
+			// the command line has been fully parsed.
+#ifdef RP_OS_SCSI_SUPPORTED
+			if (inq_scsi || inq_ata) {
+				cerr << C_("rpcli", "Warning: device commands are not supported in batch mode") << endl;
+				inq_scsi = false;
+				inq_ata = false;
+			}
+#endif /* RP_OS_SCSI_SUPPORTED */
+			if (!extract.empty()) {
+				if (!warnedBatchExtract) {
+					warnedBatchExtract = true;
+					cerr << C_("rpcli", "Warning: image extraction is not supported in batch mode") << endl;
+				}
+				extract.clear();
+			}
+
+			if ((recursive || extract_dir) && FileSystem::is_directory(argv[i])) {
+				// Directory. Queue all of its files recursively.
+				CollectFilesRecursive(argv[i], languageCode, batchJobs);
+			} else {
+				batchJobs.emplace_back(BatchJob(argv[i], languageCode));
+			}
 		} else {
 			if (first) first = false;
 			else if (json) cout << "," << endl;
@@ -490,7 +1280,22 @@ int RP_C_API main(int argc, char *argv[])
 #endif /* RP_OS_SCSI_SUPPORTED */
 			{
 				// Regular file.
-				DoFile(argv[i], json, extract, languageCode);
+				// NOTE: If an image is being extracted to standard
+				// output, discard the ROM data text so it doesn't
+				// corrupt the PNG stream.
+				bool extract_to_stdout = false;
+				for (auto it = extract.cbegin(); it != extract.cend(); ++it) {
+					if (it->filename && !strcmp(it->filename, "-")) {
+						extract_to_stdout = true;
+						break;
+					}
+				}
+				if (extract_to_stdout) {
+					ostringstream oss_discard;
+					DoFile(argv[i], json, extract, languageCode, oss_discard);
+				} else {
+					DoFile(argv[i], json, extract, languageCode);
+				}
 			}
 
 #ifdef RP_OS_SCSI_SUPPORTED
@@ -500,6 +1305,42 @@ int RP_C_API main(int argc, char *argv[])
 			extract.clear();
 		}
 	}
+
+#ifdef RP_RPCLI_SERVER_SUPPORTED
+	if (server_path) {
+		// Server mode. (--server)
+		// NOTE: This takes precedence over any queued files.
+		return RunServer(server_path);
+	}
+#endif /* RP_RPCLI_SERVER_SUPPORTED */
+
+	if (extract_dir && !batchJobs.empty()) {
+		// Create the output directory.
+		// NOTE: rmkdir() ignores the last path component.
+		string mkpath(extract_dir);
+#ifdef _WIN32
+		mkpath += '\\';
+#else /* !_WIN32 */
+		mkpath += '/';
+#endif /* _WIN32 */
+		mkpath += 'x';
+		FileSystem::rmkdir(mkpath);
+
+		if (nThreads == 0) {
+			// Overlap file I/O, decoding, and PNG encoding by default.
+			nThreads = std::thread::hardware_concurrency();
+		}
+	}
+
+	// Process the queued batch jobs, if any.
+	RunBatch(batchJobs, json, nThreads, extract_dir);
+
 	if (json) cout << "]\n";
+
+	if (show_stats) {
+		// Dump the runtime statistics counters.
+		// NOTE: Written to stderr so JSON output stays valid.
+		RpStats::dump(cerr);
+	}
 	return ret;
 }
@@ -34,8 +34,10 @@ using namespace LibRomData;
 
 // C++ includes.
 #include <iostream>
+#include <vector>
 using std::cerr;
 using std::endl;
+using std::vector;
 
 typedef int (*pfnKeyCount_t)(void);
 typedef const char* (*pfnKeyName_t)(int keyIdx);
@@ -89,7 +91,13 @@ int VerifyKeys(void)
 		printedOne = true;
 
 		cerr << "*** " << rp_sprintf(C_("rpcli", "Checking encryption keys from '%s'..."), p->name) << endl;
-		int keyCount = p->pfnKeyCount();
+		const int keyCount = p->pfnKeyCount();
+
+		// Collect the keys from this class, then verify
+		// them all in one pass. This shares a single
+		// IAesCipher instance across all of the keys.
+		vector<KeyManager::VerifyRequest_t> requests;
+		requests.reserve(keyCount);
 		for (int i = 0; i < keyCount; i++) {
 			const char *const keyName = p->pfnKeyName(i);
 			assert(keyName != nullptr);
@@ -108,14 +116,22 @@ int VerifyKeys(void)
 				continue;
 			}
 
-			// Verify the key.
-			KeyManager::VerifyResult res = keyManager->getAndVerify(keyName, nullptr, verifyData, 16);
-			cerr << keyName << ": ";
-			if (res == KeyManager::VERIFY_OK) {
+			KeyManager::VerifyRequest_t req;
+			req.keyName = keyName;
+			req.pVerifyData = verifyData;
+			req.res = KeyManager::VERIFY_UNKNOWN;
+			requests.push_back(req);
+		}
+
+		// Verify the keys.
+		keyManager->getAndVerifyAll(requests.data(), static_cast<unsigned int>(requests.size()));
+		for (const auto &req : requests) {
+			cerr << req.keyName << ": ";
+			if (req.res == KeyManager::VERIFY_OK) {
 				cerr << C_("rpcli", "OK") << endl;
 			} else {
 				cerr << rp_sprintf(C_("rpcli", "ERROR: %s"),
-					KeyManager::verifyResultToString(res)) << endl;
+					KeyManager::verifyResultToString(req.res)) << endl;
 				ret = 1;
 			}
 		}
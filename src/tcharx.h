@@ -40,6 +40,9 @@ typedef char TCHAR;
 #define _tmkdir(path, mode)		mkdir((path), (mode))
 #define _tremove(pathname)		remove(pathname)
 
+// utime.h
+#define _tutime(filename, times)	utime((filename), (times))
+
 #define _tprintf printf
 #define _ftprintf fprintf
 #define _sntprintf snprintf
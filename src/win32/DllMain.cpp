@@ -38,6 +38,9 @@
 // libwin32common
 using LibWin32Common::RegKey;
 
+// librpthreads
+#include "librpthreads/pthread_once.h"
+
 // rp_image backend registration.
 #include "librptexture/img/RpGdiplusBackend.hpp"
 using LibRpTexture::RpGdiplusBackend;
@@ -72,6 +75,49 @@ const TCHAR RP_ProgID[] = _T("rom-properties");
 DELAYLOAD_TEST_FUNCTION_IMPL1(textdomain, nullptr);
 #endif /* defined(_MSC_VER) && defined(ENABLE_NLS) */
 
+// One-time initialization.
+static volatile pthread_once_t lazy_init_once = PTHREAD_ONCE_INIT;
+static BOOL lazy_init_success = FALSE;
+
+/**
+ * One-time DLL initialization.
+ * Called by pthread_once().
+ */
+static void initDllOnce(void)
+{
+	// Get the DLL filename.
+	SetLastError(ERROR_SUCCESS);
+	DWORD dwResult = GetModuleFileName(HINST_THISCOMPONENT,
+		dll_filename, _countof(dll_filename));
+	if (dwResult == 0 || GetLastError() != ERROR_SUCCESS) {
+		// Cannot get the DLL filename.
+		// TODO: Windows XP doesn't SetLastError() if the
+		// filename is too big for the buffer.
+		dll_filename[0] = _T('\0');
+		return;
+	}
+
+	// Register RpGdiplusBackend.
+	rp_image::setBackendCreatorFn(RpGdiplusBackend::creator_fn);
+
+	lazy_init_success = TRUE;
+}
+
+/**
+ * Ensure one-time DLL initialization has been performed.
+ *
+ * Explorer loads this DLL into every process that opens a shell view,
+ * so DllMain() does as little as possible. The remaining setup is
+ * deferred until an object is actually requested.
+ *
+ * @return 0 on success; non-zero on error.
+ */
+extern "C" int rp_DllLazyInit(void)
+{
+	pthread_once((pthread_once_t*)&lazy_init_once, initDllOnce);
+	return (lazy_init_success ? 0 : -1);
+}
+
 /**
  * DLL entry point.
  * @param hInstance
@@ -83,17 +129,9 @@ BOOL WINAPI DllMain(HINSTANCE hInstance, DWORD dwReason, LPVOID /*lpReserved*/)
 {
 	switch (dwReason) {
 		case DLL_PROCESS_ATTACH: {
-			// Get the DLL filename.
-			SetLastError(ERROR_SUCCESS);
-			DWORD dwResult = GetModuleFileName(hInstance,
-				dll_filename, _countof(dll_filename));
-			if (dwResult == 0 || GetLastError() != ERROR_SUCCESS) {
-				// Cannot get the DLL filename.
-				// TODO: Windows XP doesn't SetLastError() if the
-				// filename is too big for the buffer.
-				dll_filename[0] = _T('\0');
-				return FALSE;
-			}
+			// NOTE: Explorer loads this DLL into every process that
+			// opens a shell view, so everything else is deferred to
+			// rp_DllLazyInit() when an object is actually requested.
 
 #if !defined(_MSC_VER) || defined(_DLL)
 			// Disable thread library calls, since we don't
@@ -102,10 +140,6 @@ BOOL WINAPI DllMain(HINSTANCE hInstance, DWORD dwReason, LPVOID /*lpReserved*/)
 			// Reference: https://msdn.microsoft.com/en-us/library/windows/desktop/ms682579(v=vs.85).aspx
 			DisableThreadLibraryCalls(hInstance);
 #endif /* !defined(_MSC_VER) || defined(_DLL) */
-
-			// Register RpGdiplusBackend.
-			// TODO: Static initializer somewhere?
-			rp_image::setBackendCreatorFn(RpGdiplusBackend::creator_fn);
 			break;
 		}
 
@@ -162,6 +196,12 @@ _Check_return_ STDAPI DllGetClassObject(_In_ REFCLSID rclsid, _In_ REFIID riid,
 	}
 #endif /* defined(_MSC_VER) && defined(ENABLE_NLS) */
 
+	// Make sure one-time initialization has been performed.
+	if (rp_DllLazyInit() != 0) {
+		// Initialization failed.
+		return E_UNEXPECTED;
+	}
+
 	// Check for supported classes.
 	HRESULT hr = CLASS_E_CLASSNOTAVAILABLE;
 	try {
@@ -616,6 +656,13 @@ STDAPI DllRegisterServer(void)
 {
 	LONG lResult;
 
+	// Make sure one-time initialization has been performed.
+	// NOTE: checkDirectory() requires dll_filename.
+	if (rp_DllLazyInit() != 0) {
+		// Initialization failed.
+		return E_FAIL;
+	}
+
 	if (checkDirectory()) {
 		// DLL is in %SystemRoot%. This isn't allowed.
 		return E_FAIL;
@@ -734,6 +781,12 @@ STDAPI DllRegisterServer(void)
  */
 STDAPI DllUnregisterServer(void)
 {
+	// Make sure one-time initialization has been performed.
+	if (rp_DllLazyInit() != 0) {
+		// Initialization failed.
+		return E_FAIL;
+	}
+
 	// Unregister the COM objects.
 	LONG lResult = RP_ExtractIcon::UnregisterCLSID();
 	if (lResult != ERROR_SUCCESS) return SELFREG_E_CLASS;
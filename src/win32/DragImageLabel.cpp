@@ -53,8 +53,8 @@ class DragImageLabelPrivate
 		// Calculated RECT based on position and size.
 		RECT rect;
 
-		// rp_image. (NOTE: Not owned by this object.)
-		const LibRpTexture::rp_image *img;
+		// rp_image. (owned dup(); pixels shared COW)
+		LibRpTexture::rp_image *img;
 		HBITMAP hbmpImg;	// for non-animated only
 
 		// Animated icon data.
@@ -64,12 +64,13 @@ class DragImageLabelPrivate
 			UINT_PTR animTimerID;
 			std::array<HBITMAP, LibRpBase::IconAnimData::MAX_FRAMES> iconFrames;
 			LibRpBase::IconAnimHelper iconAnimHelper;
-			int last_frame_number;		// Last frame number.
 
 			anim_vars(HWND hwndParent)
 				: m_hwndParent(hwndParent)
 				, animTimerID(0)
-				, last_frame_number(0) { }
+			{
+				iconFrames.fill(nullptr);
+			}
 			~anim_vars()
 			{
 				if (animTimerID) {
@@ -139,6 +140,7 @@ DragImageLabelPrivate::DragImageLabelPrivate(HWND hwndParent)
 DragImageLabelPrivate::~DragImageLabelPrivate()
 {
 	delete anim;
+	delete img;
 	if (hbmpImg) {
 		DeleteBitmap(hbmpImg);
 	}
@@ -224,6 +226,12 @@ bool DragImageLabelPrivate::updateBitmaps(void)
 		// Convert the icons to HBITMAP using the window background color.
 		// TODO: Rescale the icon. (port rescaleImage())
 		for (int i = iconAnimData->count-1; i >= 0; i--) {
+			// Remove the existing frame first.
+			if (anim->iconFrames[i]) {
+				DeleteBitmap(anim->iconFrames[i]);
+				anim->iconFrames[i] = nullptr;
+			}
+
 			const rp_image *const frame = iconAnimData->frames[i];
 			if (frame && frame->isValid()) {
 				if (actualSize.cx == 0) {
@@ -239,13 +247,8 @@ bool DragImageLabelPrivate::updateBitmaps(void)
 		}
 
 		// Set up the IconAnimHelper.
+		// NOTE: The icon animation timer is set in startAnimTimer().
 		anim->iconAnimHelper.setIconAnimData(iconAnimData);
-		if (anim->iconAnimHelper.isAnimated()) {
-			// Initialize the animation.
-			anim->last_frame_number = anim->iconAnimHelper.frameNumber();
-
-			// Icon animation timer is set in startAnimTimer().
-		}
 
 		// Image data is valid.
 		updateRect();
@@ -326,18 +329,17 @@ void CALLBACK DragImageLabelPrivate::AnimTimerProc(HWND hWnd, UINT uMsg, UINT_PT
 
 	// Next frame.
 	int delay = 0;
-	int frame = d->anim->iconAnimHelper.nextFrame(&delay);
-	if (delay <= 0 || frame < 0) {
-		// Invalid frame...
+	const int frame = d->anim->iconAnimHelper.tick(&delay);
+	if (delay <= 0) {
+		// Invalid delay value.
 		KillTimer(hWnd, idEvent);
 		d->anim->animTimerID = 0;
 		return;
 	}
 
-	if (frame != d->anim->last_frame_number) {
+	if (frame >= 0) {
 		// New frame number.
 		// Update the icon.
-		d->anim->last_frame_number = frame;
 		InvalidateRect(hWnd, &d->rect, false);
 	}
 
@@ -424,9 +426,9 @@ void DragImageLabel::setPosition(int x, int y)
 /**
  * Set the rp_image for this label.
  *
- * NOTE: The rp_image pointer is stored and used if necessary.
- * Make sure to call this function with nullptr before deleting
- * the rp_image object.
+ * NOTE: The label dup()s the image, which shares the pixel
+ * data copy-on-write, so the caller's rp_image (and the
+ * RomData object that owns it) can be deleted afterwards.
  *
  * NOTE 2: If animated icon data is specified, that supercedes
  * the individual rp_image.
@@ -438,6 +440,7 @@ bool DragImageLabel::setRpImage(const rp_image *img)
 {
 	RP_D(DragImageLabel);
 
+	delete d->img;
 	if (!img) {
 		d->img = nullptr;
 		if (d->hbmpImg) {
@@ -451,10 +454,10 @@ bool DragImageLabel::setRpImage(const rp_image *img)
 		return false;
 	}
 
-	// Don't check if the image pointer matches the
-	// previously stored image, since the underlying
-	// image may have changed.
-	d->img = img;
+	// Take our own handle on the image.
+	// NOTE: dup() is cheap; the pixel data is shared
+	// copy-on-write.
+	d->img = img->dup();
 	return d->updateBitmaps();
 }
 
@@ -518,6 +521,7 @@ void DragImageLabel::clearRp(void)
 		d->anim->iconAnimData = nullptr;
 	}
 
+	delete d->img;
 	d->img = nullptr;
 	if (d->hbmpImg) {
 		DeleteBitmap(d->hbmpImg);
@@ -542,7 +546,6 @@ void DragImageLabel::startAnimTimer(void)
 	}
 
 	// Get the current frame information.
-	d->anim->last_frame_number = d->anim->iconAnimHelper.frameNumber();
 	const int delay = d->anim->iconAnimHelper.frameDelay();
 	assert(delay > 0);
 	if (delay <= 0) {
@@ -587,7 +590,7 @@ void DragImageLabel::resetAnimFrame(void)
 {
 	RP_D(DragImageLabel);
 	if (d->anim) {
-		d->anim->last_frame_number = 0;
+		d->anim->iconAnimHelper.resetDisplayedFrame();
 	}
 }
 
@@ -599,7 +602,7 @@ HBITMAP DragImageLabel::currentFrame(void) const
 {
 	RP_D(const DragImageLabel);
 	if (d->anim && d->anim->iconAnimData) {
-		return d->anim->iconFrames[d->anim->last_frame_number];
+		return d->anim->iconFrames[d->anim->iconAnimHelper.displayedFrame()];
 	}
 	return d->hbmpImg;
 }
@@ -48,9 +48,9 @@ class DragImageLabel
 		/**
 		 * Set the rp_image for this label.
 		 *
-		 * NOTE: The rp_image pointer is stored and used if necessary.
-		 * Make sure to call this function with nullptr before deleting
-		 * the rp_image object.
+		 * NOTE: The label dup()s the image, which shares the pixel
+		 * data copy-on-write, so the caller's rp_image (and the
+		 * RomData object that owns it) can be deleted afterwards.
 		 *
 		 * NOTE 2: If animated icon data is specified, that supercedes
 		 * the individual rp_image.
@@ -80,6 +80,12 @@ class FontHandlerPrivate
 
 /** FontHandlerPrivate **/
 
+// Cached monospaced font face name. (DLL-wide)
+// The set of installed fonts is effectively static for the
+// lifetime of the process, so the font enumeration only needs
+// to be done once instead of every time a property sheet is opened.
+static TCHAR tMonoFaceNameCache[LF_FACESIZE] = {_T('\0')};
+
 FontHandlerPrivate::FontHandlerPrivate(HWND hWnd)
 	: hWnd(hWnd)
 	, hFontMono(nullptr)
@@ -135,6 +141,12 @@ int CALLBACK FontHandlerPrivate::MonospacedFontEnumProc(
  */
 int FontHandlerPrivate::findMonospacedFont(LOGFONT *plfFontMono)
 {
+	if (tMonoFaceNameCache[0] != _T('\0')) {
+		// Use the cached face name.
+		_tcscpy_s(plfFontMono->lfFaceName, _countof(plfFontMono->lfFaceName), tMonoFaceNameCache);
+		return 0;
+	}
+
 	// Enumerate all monospaced fonts.
 	// Reference: http://www.catch22.net/tuts/fixed-width-font-enumeration
 	unordered_set<tstring> enum_fonts;
@@ -201,6 +213,8 @@ int FontHandlerPrivate::findMonospacedFont(LOGFONT *plfFontMono)
 	}
 
 	// Found the monospaced font.
+	// Cache the face name so we don't have to enumerate again.
+	_tcscpy_s(tMonoFaceNameCache, _countof(tMonoFaceNameCache), mono_font);
 	_tcscpy_s(plfFontMono->lfFaceName, _countof(plfFontMono->lfFaceName), mono_font);
 	return 0;
 }
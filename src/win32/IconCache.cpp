@@ -0,0 +1,190 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (Win32)                            *
+ * IconCache.cpp: Process-wide HICON cache.                                *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#include "stdafx.h"
+#include "IconCache.hpp"
+
+// librpthreads
+#include "librpthreads/Mutex.hpp"
+using LibRpBase::Mutex;
+using LibRpBase::MutexLocker;
+
+// C++ STL classes.
+using std::string;
+using std::unordered_map;
+
+class IconCachePrivate
+{
+	public:
+		IconCachePrivate() { }
+		~IconCachePrivate();
+
+	private:
+		RP_DISABLE_COPY(IconCachePrivate)
+
+	public:
+		// Cache mutex.
+		Mutex mutex;
+
+		// Icon map.
+		// - Key: filename + '|' + size
+		// - Value: Master HICON. (owned by the cache)
+		// TODO: Key on the file's mtime as well to detect
+		// modified files?
+		unordered_map<string, HICON> map;
+
+		// Maximum number of cached icons.
+		// If exceeded, the cache is cleared entirely.
+		// NOTE: Not an LRU; Explorer sessions rarely get
+		// anywhere near this many distinct files.
+		static const size_t MAX_ENTRIES = 1024;
+
+		/**
+		 * Build a cache key from a filename and icon size.
+		 * @param filename Filename.
+		 * @param size Icon size, in pixels.
+		 * @return Cache key.
+		 */
+		static string cacheKey(const string &filename, int size);
+
+		/**
+		 * Destroy all cached icons and clear the map.
+		 * The mutex must be held by the caller.
+		 */
+		void clear_nolock(void);
+};
+
+/** IconCachePrivate **/
+
+IconCachePrivate::~IconCachePrivate()
+{
+	clear_nolock();
+}
+
+/**
+ * Build a cache key from a filename and icon size.
+ * @param filename Filename.
+ * @param size Icon size, in pixels.
+ * @return Cache key.
+ */
+string IconCachePrivate::cacheKey(const string &filename, int size)
+{
+	char buf[16];
+	snprintf(buf, sizeof(buf), "|%d", size);
+
+	string key;
+	key.reserve(filename.size() + 8);
+	key = filename;
+	key += buf;
+	return key;
+}
+
+/**
+ * Destroy all cached icons and clear the map.
+ * The mutex must be held by the caller.
+ */
+void IconCachePrivate::clear_nolock(void)
+{
+	for (auto iter = map.begin(); iter != map.end(); ++iter) {
+		DestroyIcon(iter->second);
+	}
+	map.clear();
+}
+
+/** IconCache **/
+
+IconCache::IconCache()
+	: d_ptr(new IconCachePrivate())
+{ }
+
+IconCache::~IconCache()
+{
+	delete d_ptr;
+}
+
+/**
+ * Get the IconCache instance.
+ * @return IconCache instance.
+ */
+IconCache *IconCache::instance(void)
+{
+	// NOTE: C++11 guarantees thread-safe initialization.
+	// The destructor runs when the DLL is unloaded.
+	static IconCache cache;
+	return &cache;
+}
+
+/**
+ * Look up a cached icon.
+ * @param filename Filename.
+ * @param size Icon size, in pixels.
+ * @return Copy of the cached HICON (caller takes ownership), or nullptr if not cached.
+ */
+HICON IconCache::lookup(const string &filename, int size)
+{
+	RP_D(IconCache);
+	MutexLocker locker(d->mutex);
+
+	auto iter = d->map.find(IconCachePrivate::cacheKey(filename, size));
+	if (iter == d->map.end()) {
+		// Not cached.
+		return nullptr;
+	}
+
+	// NOTE: Explorer takes ownership of the returned HICON,
+	// so hand out a copy and keep the master.
+	return CopyIcon(iter->second);
+}
+
+/**
+ * Store an icon in the cache.
+ * The cache keeps its own copy; the caller retains
+ * ownership of hIcon.
+ * @param filename Filename.
+ * @param size Icon size, in pixels.
+ * @param hIcon Icon to store.
+ */
+void IconCache::store(const string &filename, int size, HICON hIcon)
+{
+	assert(hIcon != nullptr);
+	if (!hIcon)
+		return;
+
+	HICON hIconCopy = CopyIcon(hIcon);
+	if (!hIconCopy) {
+		// Unable to copy the icon.
+		return;
+	}
+
+	RP_D(IconCache);
+	MutexLocker locker(d->mutex);
+
+	if (d->map.size() >= IconCachePrivate::MAX_ENTRIES) {
+		// Cache is full. Clear it entirely.
+		d->clear_nolock();
+	}
+
+	auto ret = d->map.insert(std::make_pair(
+		IconCachePrivate::cacheKey(filename, size), hIconCopy));
+	if (!ret.second) {
+		// Key already exists. Replace the old icon.
+		DestroyIcon(ret.first->second);
+		ret.first->second = hIconCopy;
+	}
+}
+
+/**
+ * Clear the cache.
+ * All cached icons are destroyed.
+ */
+void IconCache::clear(void)
+{
+	RP_D(IconCache);
+	MutexLocker locker(d->mutex);
+	d->clear_nolock();
+}
@@ -0,0 +1,71 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (Win32)                            *
+ * IconCache.hpp: Process-wide HICON cache.                                *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+#ifndef __ROMPROPERTIES_WIN32_ICONCACHE_HPP__
+#define __ROMPROPERTIES_WIN32_ICONCACHE_HPP__
+
+#include "libwin32common/RpWin32_sdk.h"
+
+// C++ includes.
+#include <string>
+
+class IconCachePrivate;
+
+/**
+ * Process-wide HICON cache, keyed by (filename, icon size).
+ *
+ * With mixed-DPI monitors, Explorer requests several sizes of the
+ * same icon. The first request generates the standard size ladder;
+ * subsequent size requests are serviced from here without touching
+ * the file again.
+ */
+class IconCache
+{
+	private:
+		IconCache();
+		~IconCache();
+	private:
+		RP_DISABLE_COPY(IconCache)
+	private:
+		friend class IconCachePrivate;
+		IconCachePrivate *const d_ptr;
+
+	public:
+		/**
+		 * Get the IconCache instance.
+		 * @return IconCache instance.
+		 */
+		static IconCache *instance(void);
+
+	public:
+		/**
+		 * Look up a cached icon.
+		 * @param filename Filename.
+		 * @param size Icon size, in pixels.
+		 * @return Copy of the cached HICON (caller takes ownership), or nullptr if not cached.
+		 */
+		HICON lookup(const std::string &filename, int size);
+
+		/**
+		 * Store an icon in the cache.
+		 * The cache keeps its own copy; the caller retains
+		 * ownership of hIcon.
+		 * @param filename Filename.
+		 * @param size Icon size, in pixels.
+		 * @param hIcon Icon to store.
+		 */
+		void store(const std::string &filename, int size, HICON hIcon);
+
+		/**
+		 * Clear the cache.
+		 * All cached icons are destroyed.
+		 */
+		void clear(void);
+};
+
+#endif /* __ROMPROPERTIES_WIN32_ICONCACHE_HPP__ */
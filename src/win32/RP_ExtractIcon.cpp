@@ -10,6 +10,7 @@
 #include "stdafx.h"
 #include "RP_ExtractIcon.hpp"
 #include "RpImageWin32.hpp"
+#include "IconCache.hpp"
 
 // librpbase, librpfile, librptexture, libromdata
 using namespace LibRpBase;
@@ -29,6 +30,7 @@ const CLSID CLSID_RP_ExtractIcon =
 
 RP_ExtractIcon_Private::RP_ExtractIcon_Private()
 	: romData(nullptr)
+	, fastIcon(nullptr)
 { }
 
 RP_ExtractIcon_Private::~RP_ExtractIcon_Private()
@@ -36,6 +38,7 @@ RP_ExtractIcon_Private::~RP_ExtractIcon_Private()
 	if (romData) {
 		romData->unref();
 	}
+	delete fastIcon;
 }
 
 /** RP_ExtractIcon **/
@@ -98,6 +101,9 @@ IFACEMETHODIMP RP_ExtractIcon::Load(LPCOLESTR pszFileName, DWORD dwMode)
 		d->romData->unref();
 		d->romData = nullptr;
 	}
+	// Delete any previously-loaded fast-path icon.
+	delete d->fastIcon;
+	d->fastIcon = nullptr;
 
 	// pszFileName is the file being worked on.
 	// TODO: If the file was already loaded, don't reload it.
@@ -117,6 +123,20 @@ IFACEMETHODIMP RP_ExtractIcon::Load(LPCOLESTR pszFileName, DWORD dwMode)
 		return E_FAIL;
 	}
 
+	// Start an async prefetch so disk latency overlaps ROM parsing.
+	file->readAhead(0, file->size());
+
+	// Try the fast icon extraction path first. For common formats,
+	// the icon can be read directly from the file header without
+	// constructing a full RomData object. Explorer list views
+	// request icons by the hundreds, so this matters.
+	d->fastIcon = RomDataFactory::fastIcon(file);
+	if (d->fastIcon) {
+		// Fast icon extracted. No RomData object is needed.
+		file->unref();
+		return S_OK;
+	}
+
 	// Get the appropriate RomData class for this ROM.
 	// RomData class *must* support at least one image type.
 	d->romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_THUMBNAIL);
@@ -148,6 +168,64 @@ IFACEMETHODIMP RP_ExtractIcon::GetCurFile(LPOLESTR *ppszFileName)
 	return E_NOTIMPL;
 }
 
+/**
+ * Create an HICON from a fast-path icon at the specified size.
+ * Downscaling uses rp_image's box filter (SSE4.1 if available);
+ * upscaling uses integer nearest-neighbor, with Explorer handling
+ * any remainder.
+ * @param fastIcon Fast-path icon.
+ * @param size Requested icon size.
+ * @return HICON, or nullptr on error.
+ */
+static HICON createFastIconHICON(const rp_image *fastIcon, LONG size)
+{
+	const rp_image *img = fastIcon;
+	rp_image *scaled = nullptr;
+	SIZE szIcon = {fastIcon->width(), fastIcon->height()};
+
+	if (szIcon.cx > size || szIcon.cy > size) {
+		// Downscale, preserving the aspect ratio.
+		LONG dw = size, dh = size;
+		if (szIcon.cx >= szIcon.cy) {
+			dh = std::max(1L, (szIcon.cy * size) / szIcon.cx);
+		} else {
+			dw = std::max(1L, (szIcon.cx * size) / szIcon.cy);
+		}
+
+		// NOTE: downscaled_box() requires ARGB32. For other
+		// formats, fall through and let GDI+ do the resize.
+		if (fastIcon->format() == rp_image::FORMAT_ARGB32) {
+			scaled = fastIcon->downscaled_box(static_cast<int>(dw), static_cast<int>(dh));
+		}
+		if (scaled) {
+			img = scaled;
+			szIcon.cx = scaled->width();
+			szIcon.cy = scaled->height();
+		} else {
+			szIcon.cx = dw;
+			szIcon.cy = dh;
+		}
+	} else if (szIcon.cx < size && szIcon.cy < size) {
+		// Integer upscaling if the icon is smaller than the
+		// requested size; Explorer handles the rest.
+		const LONG factor = size / std::max(szIcon.cx, szIcon.cy);
+		if (factor > 1) {
+			szIcon.cx *= factor;
+			szIcon.cy *= factor;
+		}
+	}
+
+	// Convert the rp_image to HBITMAP, then HICON.
+	HICON hIcon = nullptr;
+	HBITMAP hBitmap = RpImageWin32::toHBITMAP_alpha(img, szIcon, true);
+	if (hBitmap) {
+		hIcon = RpImageWin32::toHICON(hBitmap);
+		DeleteBitmap(hBitmap);
+	}
+	delete scaled;
+	return hIcon;
+}
+
 /** IExtractIconW **/
 // Reference: https://msdn.microsoft.com/en-us/library/windows/desktop/bb761854(v=vs.85).aspx
 
@@ -207,6 +285,68 @@ IFACEMETHODIMP RP_ExtractIcon::Extract(LPCWSTR pszFile, UINT nIconIndex,
 		return E_INVALIDARG;
 	}
 
+	// Requested icon size.
+	const LONG reqSize = LOWORD(nIconSize);
+
+	// Check the process-wide icon cache first.
+	IconCache *const iconCache = IconCache::instance();
+	HICON hIconCached = iconCache->lookup(d->filename, static_cast<int>(reqSize));
+	if (hIconCached != nullptr) {
+		*phiconLarge = hIconCached;
+		if (phiconSmall) {
+			// TODO: Support the small icon?
+			// NULL out the small icon.
+			*phiconSmall = nullptr;
+		}
+		// NOTE: S_FALSE causes icon shenanigans.
+		return S_OK;
+	}
+
+	if (d->fastIcon) {
+		// Icon was extracted using the fast path in
+		// IPersistFile::Load(). No RomData object is present.
+		// Generate the standard icon size ladder in one pass and
+		// cache everything, so Explorer's other size requests for
+		// this file (e.g. from mixed-DPI monitors) are free.
+		static const LONG iconSizes[] = {16, 32, 48, 256};
+		bool reqInLadder = false;
+		for (unsigned int i = 0; i < ARRAY_SIZE(iconSizes); i++) {
+			HICON hIconGen = createFastIconHICON(d->fastIcon, iconSizes[i]);
+			if (hIconGen) {
+				iconCache->store(d->filename, static_cast<int>(iconSizes[i]), hIconGen);
+				DestroyIcon(hIconGen);
+			}
+			if (iconSizes[i] == reqSize) {
+				reqInLadder = true;
+			}
+		}
+		if (!reqInLadder) {
+			// Non-standard size requested.
+			HICON hIconGen = createFastIconHICON(d->fastIcon, reqSize);
+			if (hIconGen) {
+				iconCache->store(d->filename, static_cast<int>(reqSize), hIconGen);
+				DestroyIcon(hIconGen);
+			}
+		}
+
+		HICON hIcon = iconCache->lookup(d->filename, static_cast<int>(reqSize));
+		if (hIcon != nullptr) {
+			*phiconLarge = hIcon;
+			if (phiconSmall) {
+				// TODO: Support the small icon?
+				// NULL out the small icon.
+				*phiconSmall = nullptr;
+			}
+			// NOTE: S_FALSE causes icon shenanigans.
+			return S_OK;
+		}
+
+		// Error converting to HICON. Use the fallback.
+		LONG lResult = d->Fallback(phiconLarge, phiconSmall, nIconSize);
+		// NOTE: S_FALSE causes icon shenanigans.
+		return (lResult == ERROR_SUCCESS ? S_OK : E_FAIL);
+	}
+
 	if (!d->romData) {
 		// ROM is not supported. Use the fallback.
 		LONG lResult = d->Fallback(phiconLarge, phiconSmall, nIconSize);
@@ -218,7 +358,7 @@ IFACEMETHODIMP RP_ExtractIcon::Extract(LPCWSTR pszFile, UINT nIconIndex,
 	// TODO: Small icon?
 	CreateThumbnail::GetThumbnailOutParams_t outParams;
 	outParams.retImg = nullptr;
-	int ret = d->thumbnailer.getThumbnail(d->romData, LOWORD(nIconSize), &outParams);
+	int ret = d->thumbnailer.getThumbnail(d->romData, reqSize, &outParams);
 	if (ret != 0 || !outParams.retImg) {
 		// Thumbnail not available. Use the fallback.
 		if (outParams.retImg) {
@@ -233,7 +373,12 @@ IFACEMETHODIMP RP_ExtractIcon::Extract(LPCWSTR pszFile, UINT nIconIndex,
 	HICON hIcon = RpImageWin32::toHICON(outParams.retImg);
 	DeleteBitmap(outParams.retImg);
 	if (hIcon != nullptr) {
-		// Icon converted.
+		// Icon converted. Cache it for subsequent size requests.
+		// NOTE: Only the requested size is cached here; the full
+		// size ladder is only generated on the fast-icon path,
+		// where the decoded rp_image is available.
+		iconCache->store(d->filename, static_cast<int>(reqSize), hIcon);
+
 		bool iconWasSet = false;
 		if (phiconLarge) {
 			*phiconLarge = hIcon;
@@ -34,6 +34,11 @@ class RP_ExtractIcon_Private
 		// RomData object. Loaded in IPersistFile::Load().
 		LibRpBase::RomData *romData;
 
+		// Fast-path icon. Loaded in IPersistFile::Load() for
+		// formats that support RomDataFactory::fastIcon(); if
+		// set, romData is not created at all.
+		LibRpTexture::rp_image *fastIcon;
+
 		// CreateThumbnail instance.
 		CreateThumbnail thumbnailer;
 
@@ -121,6 +121,9 @@ IFACEMETHODIMP RP_ExtractImage::Load(LPCOLESTR pszFileName, DWORD dwMode)
 		file->unref();
 	}
 
+	// Start an async prefetch so disk latency overlaps ROM parsing.
+	file->readAhead(0, file->size());
+
 	// Get the appropriate RomData class for this ROM.
 	// RomData class *must* support at least one image type.
 	d->romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_THUMBNAIL);
@@ -15,6 +15,9 @@
 #include <propkey.h>
 #include <propvarutil.h>
 
+// For the property population worker thread.
+#include <process.h>
+
 // librpbase, librpfile, libromdata
 #include "librpbase/RomMetaData.hpp"
 using namespace LibRpBase;
@@ -156,10 +159,14 @@ RP_PropertyStore_Private::RP_PropertyStore_Private()
 	, pstream(nullptr)
 	, grfMode(0)
 	, romData(nullptr)
+	, hWorkerThread(nullptr)
 { }
 
 RP_PropertyStore_Private::~RP_PropertyStore_Private()
 {
+	// Wait for the worker thread before tearing anything down.
+	waitForWorker();
+
 	if (romData) {
 		romData->unref();
 	}
@@ -176,81 +183,20 @@ RP_PropertyStore_Private::~RP_PropertyStore_Private()
 	);
 }
 
-/** RP_PropertyStore **/
-
-RP_PropertyStore::RP_PropertyStore()
-	: d_ptr(new RP_PropertyStore_Private())
-{ }
-
-RP_PropertyStore::~RP_PropertyStore()
-{
-	delete d_ptr;
-}
-
-/** IUnknown **/
-// Reference: https://msdn.microsoft.com/en-us/library/office/cc839627.aspx
-
-IFACEMETHODIMP RP_PropertyStore::QueryInterface(REFIID riid, LPVOID *ppvObj)
-{
-#ifdef _MSC_VER
-# pragma warning(push)
-# pragma warning(disable: 4365 4838)
-#endif /* _MSC_VER */
-	static const QITAB rgqit[] = {
-		QITABENT(RP_PropertyStore, IInitializeWithStream),
-		QITABENT(RP_PropertyStore, IPropertyStore),
-		QITABENT(RP_PropertyStore, IPropertyStoreCapabilities),
-		{ 0, 0 }
-	};
-#ifdef _MSC_VER
-# pragma warning(pop)
-#endif /* _MSC_VER */
-	return LibWin32Common::rp_QISearch(this, rgqit, riid, ppvObj);
-}
-
-/** IInitializeWithStream **/
-// Reference: https://msdn.microsoft.com/en-us/library/windows/desktop/bb761812(v=vs.85).aspx [Initialize()]
-
-IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
+/**
+ * Populate the property cache from the RomData object.
+ * Runs on the worker thread; this is where the expensive
+ * full parse (metaData()) happens.
+ */
+void RP_PropertyStore_Private::populateProperties(void)
 {
-	// Ignoring grfMode for now. (always read-only)
-	RP_UNUSED(grfMode);
-
-	// Create an IRpFile wrapper for the IStream.
-	RpFile_IStream *const file = new RpFile_IStream(pstream, true);
-	if (file->lastError() != 0) {
-		// Error initializing the IRpFile.
-		file->unref();
-		return E_FAIL;
-	}
-
-	RP_D(RP_PropertyStore);
-	if (d->file) {
-		// unref() the old file first.
-		IRpFile *const old_file = d->file;
-		d->file = file;
-		old_file->unref();
-	} else {
-		// No old file to unref().
-		d->file = file;
-	}
-
-	// Save the IStream and grfMode.
-	d->pstream = pstream;
-	d->grfMode = grfMode;
-
-	// Attempt to create a RomData object.
-	d->romData = RomDataFactory::create(file, RomDataFactory::RDA_HAS_METADATA);
-	if (!d->romData) {
-		// No RomData.
-		return E_FAIL;
-	}
-
 	// Get the metadata properties.
-	const RomMetaData *metaData = d->romData->metaData();
+	// NOTE: The RomData object was created with RDA_DEFER_FIELDS,
+	// so this call triggers the full parse.
+	const RomMetaData *metaData = romData->metaData();
 	if (!metaData || metaData->empty()) {
 		// No metadata properties.
-		return S_OK;
+		return;
 	}
 
 	// Special handling for System.Image.Dimensions.
@@ -260,15 +206,15 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 	// TODO: Use IPropertyStoreCache?
 	// Reference: https://github.com/Microsoft/Windows-classic-samples/blob/master/Samples/Win7Samples/winui/shell/appshellintegration/RecipePropertyHandler/RecipePropertyHandler.cpp
 	const int count = metaData->count();
-	d->prop_key.reserve(count);
-	d->prop_val.reserve(count);
+	prop_key.reserve(count);
+	prop_val.reserve(count);
 	for (int i = 0; i < count; i++) {
 		const RomMetaData::MetaData *prop = metaData->prop(i);
 		assert(prop != nullptr);
 		if (!prop)
 			continue;
 
-		if (prop->name <= 0 || prop->name >= ARRAY_SIZE(d->metaDataConv)) {
+		if (prop->name <= 0 || prop->name >= ARRAY_SIZE(metaDataConv)) {
 			// FIXME: Should assert here, but Windows doesn't support
 			// certain properties...
 			continue;
@@ -276,7 +222,7 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 
 		// Convert from the RomMetaData property indexes to
 		// Windows property keys.
-		const RP_PropertyStore_Private::MetaDataConv &conv = d->metaDataConv[prop->name];
+		const MetaDataConv &conv = metaDataConv[prop->name];
 		if (!conv.pkey || conv.vtype == VT_EMPTY) {
 			// FIXME: Should assert here, but Windows doesn't support
 			// certain properties...
@@ -301,8 +247,8 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 					// Use the value as-is.
 					InitPropVariantFromUInt64(static_cast<uint64_t>(prop->data.uvalue), &prop_var);
 				}
-				d->prop_key.emplace_back(conv.pkey);
-				d->prop_val.emplace_back(prop_var);
+				prop_key.emplace_back(conv.pkey);
+				prop_val.emplace_back(prop_var);
 				break;
 			}
 			case VT_UI4:
@@ -311,8 +257,8 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 					continue;
 
 				InitPropVariantFromUInt32(static_cast<uint32_t>(prop->data.uvalue), &prop_var);
-				d->prop_key.emplace_back(conv.pkey);
-				d->prop_val.emplace_back(prop_var);
+				prop_key.emplace_back(conv.pkey);
+				prop_val.emplace_back(prop_var);
 
 				// Special handling for image dimensions.
 				switch (prop->name) {
@@ -334,8 +280,8 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 					continue;
 
 				InitPropVariantFromUInt16(static_cast<uint16_t>(prop->data.uvalue), &prop_var);
-				d->prop_key.emplace_back(conv.pkey);
-				d->prop_val.emplace_back(prop_var);
+				prop_key.emplace_back(conv.pkey);
+				prop_val.emplace_back(prop_var);
 				break;
 			case VT_UI1:
 				assert(prop->type == PropertyType::Integer || prop->type == PropertyType::UnsignedInteger);
@@ -343,8 +289,8 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 					continue;
 
 				InitPropVariantFromUInt8(static_cast<uint8_t>(prop->data.uvalue), &prop_var);
-				d->prop_key.emplace_back(conv.pkey);
-				d->prop_val.emplace_back(prop_var);
+				prop_key.emplace_back(conv.pkey);
+				prop_val.emplace_back(prop_var);
 				break;
 
 			case VT_I8: {
@@ -354,8 +300,8 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 					continue;
 
 				InitPropVariantFromInt64(static_cast<int64_t>(prop->data.ivalue), &prop_var);
-				d->prop_key.emplace_back(conv.pkey);
-				d->prop_val.emplace_back(prop_var);
+				prop_key.emplace_back(conv.pkey);
+				prop_val.emplace_back(prop_var);
 				break;
 			}
 			case VT_I4:
@@ -364,8 +310,8 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 					continue;
 
 				InitPropVariantFromInt32(static_cast<int32_t>(prop->data.ivalue), &prop_var);
-				d->prop_key.emplace_back(conv.pkey);
-				d->prop_val.emplace_back(prop_var);
+				prop_key.emplace_back(conv.pkey);
+				prop_val.emplace_back(prop_var);
 				break;
 			case VT_I2:
 				assert(prop->type == PropertyType::Integer || prop->type == PropertyType::UnsignedInteger);
@@ -373,8 +319,8 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 					continue;
 
 				InitPropVariantFromInt16(static_cast<int16_t>(prop->data.ivalue), &prop_var);
-				d->prop_key.emplace_back(conv.pkey);
-				d->prop_val.emplace_back(prop_var);
+				prop_key.emplace_back(conv.pkey);
+				prop_val.emplace_back(prop_var);
 				break;
 			case VT_I1:
 				assert(prop->type == PropertyType::Integer || prop->type == PropertyType::UnsignedInteger);
@@ -382,8 +328,8 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 					continue;
 
 				InitPropVariantFromInt8(static_cast<int8_t>(prop->data.ivalue), &prop_var);
-				d->prop_key.emplace_back(conv.pkey);
-				d->prop_val.emplace_back(prop_var);
+				prop_key.emplace_back(conv.pkey);
+				prop_val.emplace_back(prop_var);
 				break;
 
 			case VT_BSTR:
@@ -392,8 +338,8 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 					continue;
 				if (prop->data.str) {
 					InitPropVariantFromString(U82W_s(*prop->data.str), &prop_var);
-					d->prop_key.emplace_back(conv.pkey);
-					d->prop_val.emplace_back(prop_var);
+					prop_key.emplace_back(conv.pkey);
+					prop_val.emplace_back(prop_var);
 				}
 				break;
 
@@ -406,8 +352,8 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 				const wstring wstr = (prop->data.str ? U82W_s(*prop->data.str) : L"");
 				const wchar_t *vstr[] = {wstr.c_str()};
 				InitPropVariantFromStringVector(vstr, 1, &prop_var);
-				d->prop_key.emplace_back(conv.pkey);
-				d->prop_val.emplace_back(prop_var);
+				prop_key.emplace_back(conv.pkey);
+				prop_val.emplace_back(prop_var);
 				break;
 			}
 
@@ -422,8 +368,8 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 				FILETIME ft;
 				UnixTimeToFileTime(prop->data.timestamp, &ft);
 				InitPropVariantFromFileTime(&ft, &prop_var);
-				d->prop_key.emplace_back(conv.pkey);
-				d->prop_val.emplace_back(prop_var);
+				prop_key.emplace_back(conv.pkey);
+				prop_val.emplace_back(prop_var);
 				break;
 			}
 
@@ -442,10 +388,140 @@ IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
 
 		PROPVARIANT prop_var;
 		InitPropVariantFromString(buf, &prop_var);
-		d->prop_key.emplace_back(&PKEY_Image_Dimensions);
-		d->prop_val.emplace_back(prop_var);
+		prop_key.emplace_back(&PKEY_Image_Dimensions);
+		prop_val.emplace_back(prop_var);
+	}
+}
+
+/**
+ * Worker thread entry point.
+ * @param lpParam RP_PropertyStore_Private*
+ * @return 0
+ */
+unsigned int __stdcall RP_PropertyStore_Private::workerThreadProc(void *lpParam)
+{
+	RP_PropertyStore_Private *const d =
+		static_cast<RP_PropertyStore_Private*>(lpParam);
+	d->populateProperties();
+	return 0;
+}
+
+/**
+ * Wait for the worker thread to finish, if one is running.
+ * Must be called before reading prop_key/prop_val.
+ */
+void RP_PropertyStore_Private::waitForWorker(void)
+{
+	if (hWorkerThread) {
+		WaitForSingleObject(hWorkerThread, INFINITE);
+		CloseHandle(hWorkerThread);
+		hWorkerThread = nullptr;
 	}
+}
+
+/** RP_PropertyStore **/
+
+RP_PropertyStore::RP_PropertyStore()
+	: d_ptr(new RP_PropertyStore_Private())
+{ }
+
+RP_PropertyStore::~RP_PropertyStore()
+{
+	delete d_ptr;
+}
+
+/** IUnknown **/
+// Reference: https://msdn.microsoft.com/en-us/library/office/cc839627.aspx
+
+IFACEMETHODIMP RP_PropertyStore::QueryInterface(REFIID riid, LPVOID *ppvObj)
+{
+#ifdef _MSC_VER
+# pragma warning(push)
+# pragma warning(disable: 4365 4838)
+#endif /* _MSC_VER */
+	static const QITAB rgqit[] = {
+		QITABENT(RP_PropertyStore, IInitializeWithStream),
+		QITABENT(RP_PropertyStore, IPropertyStore),
+		QITABENT(RP_PropertyStore, IPropertyStoreCapabilities),
+		{ 0, 0 }
+	};
+#ifdef _MSC_VER
+# pragma warning(pop)
+#endif /* _MSC_VER */
+	return LibWin32Common::rp_QISearch(this, rgqit, riid, ppvObj);
+}
+
+/** IInitializeWithStream **/
+// Reference: https://msdn.microsoft.com/en-us/library/windows/desktop/bb761812(v=vs.85).aspx [Initialize()]
+
+IFACEMETHODIMP RP_PropertyStore::Initialize(IStream *pstream, DWORD grfMode)
+{
+	// Ignoring grfMode for now. (always read-only)
+	RP_UNUSED(grfMode);
 
+	// Create an IRpFile wrapper for the IStream.
+	RpFile_IStream *const file = new RpFile_IStream(pstream, true);
+	if (file->lastError() != 0) {
+		// Error initializing the IRpFile.
+		file->unref();
+		return E_FAIL;
+	}
+
+	RP_D(RP_PropertyStore);
+
+	// If a worker thread from a previous Initialize() is still
+	// running, wait for it before replacing anything.
+	d->waitForWorker();
+
+	if (d->file) {
+		// unref() the old file first.
+		IRpFile *const old_file = d->file;
+		d->file = file;
+		old_file->unref();
+	} else {
+		// No old file to unref().
+		d->file = file;
+	}
+
+	// Clear any previously-cached properties.
+	if (d->romData) {
+		d->romData->unref();
+		d->romData = nullptr;
+	}
+	std::for_each(d->prop_val.begin(), d->prop_val.end(),
+		[](PROPVARIANT &pv) { PropVariantClear(&pv); }
+	);
+	d->prop_key.clear();
+	d->prop_val.clear();
+
+	// Save the IStream and grfMode.
+	d->pstream = pstream;
+	d->grfMode = grfMode;
+
+	// Attempt to create a RomData object.
+	// RDA_DEFER_FIELDS: Only the header is parsed here. The
+	// expensive metadata extraction runs on the worker thread.
+	// RDA_METADATA_ONLY: The property store never displays
+	// images, so don't allow image decoding on this object.
+	d->romData = RomDataFactory::create(file,
+		RomDataFactory::RDA_METADATA_ONLY | RomDataFactory::RDA_DEFER_FIELDS);
+	if (!d->romData) {
+		// No RomData.
+		return E_FAIL;
+	}
+
+	// Populate the property cache on a worker thread. Explorer
+	// calls Initialize() for every file in a details-view column,
+	// so the full parse must not run on the caller's thread.
+	// NOTE: The IStream provided by the property system is a plain
+	// file stream, so using it from the worker thread is safe.
+	d->hWorkerThread = reinterpret_cast<HANDLE>(_beginthreadex(nullptr, 0,
+		RP_PropertyStore_Private::workerThreadProc, d, 0, nullptr));
+	if (!d->hWorkerThread) {
+		// Couldn't start the worker thread.
+		// Populate the properties synchronously.
+		d->populateProperties();
+	}
 	return S_OK;
 }
 
@@ -460,7 +536,10 @@ IFACEMETHODIMP RP_PropertyStore::Commit(void)
 
 IFACEMETHODIMP RP_PropertyStore::GetAt(_In_ DWORD iProp, _Out_ PROPERTYKEY *pkey)
 {
-	RP_D(const RP_PropertyStore);
+	RP_D(RP_PropertyStore);
+	// Wait for the property population worker, if it's running.
+	d->waitForWorker();
+
 	if (iProp >= d->prop_key.size()) {
 		return E_INVALIDARG;
 	} else if (!pkey) {
@@ -477,18 +556,24 @@ IFACEMETHODIMP RP_PropertyStore::GetCount(_Out_ DWORD *cProps)
 		return E_POINTER;
 	}
 
-	RP_D(const RP_PropertyStore);
+	RP_D(RP_PropertyStore);
+	// Wait for the property population worker, if it's running.
+	d->waitForWorker();
+
 	*cProps = static_cast<DWORD>(d->prop_key.size());
 	return S_OK;
 }
 
 IFACEMETHODIMP RP_PropertyStore::GetValue(_In_ REFPROPERTYKEY key, _Out_ PROPVARIANT *pv)
 {
-	RP_D(const RP_PropertyStore);
+	RP_D(RP_PropertyStore);
 	if (!pv) {
 		return E_POINTER;
 	}
 
+	// Wait for the property population worker, if it's running.
+	d->waitForWorker();
+
 	// Linear search for the property.
 	// TODO: Optimize this?
 	for (size_t n = 0; n < d->prop_key.size(); n++) {
@@ -53,6 +53,32 @@ class RP_PropertyStore_Private
 		// Property values.
 		std::vector<PROPVARIANT> prop_val;
 
+		// Worker thread for deferred property population.
+		// Explorer calls Initialize() for every file in a
+		// details-view column, so the expensive full parse
+		// runs here instead of on the caller's thread.
+		HANDLE hWorkerThread;
+
+		/**
+		 * Populate the property cache from the RomData object.
+		 * Runs on the worker thread; this is where the expensive
+		 * full parse (metaData()) happens.
+		 */
+		void populateProperties(void);
+
+		/**
+		 * Worker thread entry point.
+		 * @param lpParam RP_PropertyStore_Private*
+		 * @return 0
+		 */
+		static unsigned int __stdcall workerThreadProc(void *lpParam);
+
+		/**
+		 * Wait for the worker thread to finish, if one is running.
+		 * Must be called before reading prop_key/prop_val.
+		 */
+		void waitForWorker(void);
+
 		/**
 		 * Metadata conversion table.
 		 * - Index: LibRpBase::Property
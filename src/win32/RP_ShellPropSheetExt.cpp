@@ -134,7 +134,12 @@ class RP_ShellPropSheetExt_Private
 		// NOTE: Not making vImageList a pointer, since that adds
 		// significantly more complexity.
 		struct LvData_t {
-			vector<vector<tstring> > vvStr;	// String data.
+			// Rows in the RomFields ListData_t. The ListView is
+			// backed directly by the RomFields data; strings are
+			// converted on demand by ListView_GetDispInfo().
+			// (Not used for RFT_LISTDATA_MULTI.)
+			vector<const vector<string>*> vRows;
+			vector<vector<tstring> > vvStr;	// String data. (RFT_LISTDATA_MULTI only)
 			vector<int> vImageList;		// ImageList indexes.
 			uint32_t checkboxes;		// Checkboxes.
 			bool hasCheckboxes;		// True if checkboxes are valid.
@@ -177,14 +182,27 @@ class RP_ShellPropSheetExt_Private
 			HWND hDlg;		// Tab child dialog.
 			HWND lblCredits;	// Credits label.
 			POINT curPt;		// Current point.
+			bool isInit;		// True if the field widgets have been created.
 
-			tab() : hDlg(nullptr), lblCredits(nullptr) {
+			tab() : hDlg(nullptr), lblCredits(nullptr), isInit(false) {
 				curPt.x = 0; curPt.y = 0;
 			}
 		};
 		vector<tab> tabs;
 		int curTabIndex;
 
+		// Tab layout metrics, calculated by initDialog().
+		// Field widgets are only created for the initially-visible
+		// tab when the dialog is initialized; other tabs are
+		// initialized by initTabFields() on first selection, which
+		// needs the same metrics.
+		vector<tstring> t_desc_text;	// Field description labels.
+		SIZE descSize;			// Description label size.
+		RECT dlgMargin;			// Dialog margin.
+		RECT dlgRect;			// Dialog rect, adjusted for margins and tabs.
+		SIZE dlgSize;			// Dialog size, adjusted for margins and tabs.
+		int dlg_value_width;		// Width available for value widgets.
+
 		// Multi-language functionality.
 		uint32_t def_lc;	// Default language code from RomFields.
 		set<uint32_t> set_lc;	// Set of supported language codes.
@@ -364,6 +382,15 @@ class RP_ShellPropSheetExt_Private
 		 */
 		void initDialog(HWND hDlg);
 
+		/**
+		 * Initialize the ROM field widgets for a single tab.
+		 * initDialog() must have been called first to calculate
+		 * the layout metrics.
+		 * @param hDlg		[in] Dialog window.
+		 * @param tabIdx	[in] Tab index.
+		 */
+		void initTabFields(HWND hDlg, int tabIdx);
+
 	private:
 		// Internal functions used by the callback functions.
 		INT_PTR DlgProc_WM_NOTIFY(HWND hDlg, NMHDR *pHdr);
@@ -406,6 +433,7 @@ RP_ShellPropSheetExt_Private::RP_ShellPropSheetExt_Private(RP_ShellPropSheetExt
 	, lblIcon(nullptr)
 	, tabWidget(nullptr)
 	, curTabIndex(0)
+	, dlg_value_width(0)
 	, def_lc(0)
 	, cboLanguage(nullptr)
 	, himglFlags(nullptr)
@@ -695,8 +723,9 @@ int RP_ShellPropSheetExt_Private::initString(_In_ HWND hDlg, _In_ HWND hWndTab,
 			return 0;
 
 		// TODO: NULL string == empty string?
-		if (field.data.str) {
-			str_nl = LibWin32Common::unix2dos(U82T_s(*(field.data.str)), &lf_count);
+		const char *const field_str = field.str();
+		if (field_str) {
+			str_nl = LibWin32Common::unix2dos(U82T_c(field_str), &lf_count);
 		}
 	} else {
 		// Use the specified string.
@@ -1308,12 +1337,17 @@ int RP_ShellPropSheetExt_Private::initListData(HWND hDlg, HWND hWndTab,
 		checkboxes = field.data.list_data.mxd.checkboxes;
 	}
 
-	// NOTE: We're converting the strings for use with
-	// LVS_OWNERDATA.
-	vector<vector<tstring> > lvStringData;
-	lvStringData.reserve(list_data->size());
+	// NOTE: LVS_OWNERDATA is in use. For single-language data,
+	// the ListView is backed directly by the RomFields data, and
+	// strings are converted on demand in ListView_GetDispInfo().
+	// RFT_LISTDATA_MULTI needs translated copies, which are
+	// (re)generated by updateMulti().
 	LvData_t lvData;
-	lvData.vvStr.reserve(list_data->size());
+	if (isMulti) {
+		lvData.vvStr.reserve(list_data->size());
+	} else {
+		lvData.vRows.reserve(list_data->size());
+	}
 	lvData.hasCheckboxes = hasCheckboxes;
 	if (hasIcons) {
 		lvData.vImageList.reserve(list_data->size());
@@ -1339,16 +1373,12 @@ int RP_ShellPropSheetExt_Private::initListData(HWND hDlg, HWND hWndTab,
 			}
 		}
 
-		// Destination row.
-		lvData.vvStr.resize(lvData.vvStr.size()+1);
-		auto &lv_row_data = lvData.vvStr.at(lvData.vvStr.size()-1);
-		lv_row_data.reserve(data_row.size());
-
 		// String data.
 		if (isMulti) {
 			// RFT_LISTDATA_MULTI. Allocate space for the strings,
 			// but don't initialize them here.
-			lv_row_data.resize(data_row.size());
+			lvData.vvStr.resize(lvData.vvStr.size()+1);
+			lvData.vvStr.at(lvData.vvStr.size()-1).resize(data_row.size());
 
 			// Check newline counts in all strings to find nl_max.
 			const auto *const multi = field.data.list_data.data.multi;
@@ -1369,20 +1399,20 @@ int RP_ShellPropSheetExt_Private::initListData(HWND hDlg, HWND hWndTab,
 				}
 			}
 		} else {
-			// Single language.
+			// Single language. The ListView is backed directly
+			// by this row, so only measure the column widths;
+			// the strings aren't stored here.
+			lvData.vRows.emplace_back(&data_row);
 			int col = 0;
 			for (auto iter = data_row.cbegin(); iter != data_row.cend(); ++iter, col++) {
-				tstring tstr = U82T_s(*iter);
+				const tstring tstr = U82T_s(*iter);
 
 				int nl_count;
-				int width = measureListDataString(hDC, tstr, &nl_count);
+				const int width = measureListDataString(hDC, tstr, &nl_count);
 				if (col < colCount) {
 					col_width[col] = std::max(col_width[col], width);
 				}
 				nl_max = std::max(nl_max, nl_count);
-
-				// TODO: Store the icon index if necessary.
-				lv_row_data.emplace_back(std::move(tstr));
 			}
 		}
 
@@ -1519,11 +1549,7 @@ int RP_ShellPropSheetExt_Private::initListData(HWND hDlg, HWND hWndTab,
 		}
 	}
 
-	// Get the dialog margin.
-	// 7x7 DLU margin is recommended by the Windows UX guidelines.
-	// Reference: http://stackoverflow.com/questions/2118603/default-dialog-padding
-	RECT dlgMargin = {7, 7, 8, 8};
-	MapDialogRect(hDlg, &dlgMargin);
+	// NOTE: The dialog margin is cached by initDialog().
 
 	// Increase the ListView height.
 	// Default: 5 rows, plus the header.
@@ -2199,11 +2225,7 @@ void RP_ShellPropSheetExt_Private::updateMulti(uint32_t user_lc)
 		// Set the current index.
 		ComboBox_SetCurSel(cboLanguage, sel_idx);
 
-		// Get the dialog margin.
-		// 7x7 DLU margin is recommended by the Windows UX guidelines.
-		// Reference: http://stackoverflow.com/questions/2118603/default-dialog-padding
-		RECT dlgMargin = { 7, 7, 8, 8 };
-		MapDialogRect(hDlgSheet, &dlgMargin);
+		// NOTE: The dialog margin is cached by initDialog().
 
 		// Adjust the header row.
 		const int adj = (maxSize.cx + dlgMargin.left) / 2;
@@ -2292,13 +2314,27 @@ void RP_ShellPropSheetExt_Private::initDialog(HWND hDlg)
 
 	// Convert the bitfield description names to the
 	// native Windows encoding once.
-	vector<tstring> t_desc_text;
+	t_desc_text.clear();
 	t_desc_text.reserve(count);
 
-	// Determine the maximum length of all field names.
-	// TODO: Line breaks?
-	int max_text_width = 0;
-	SIZE textSize;
+	// Description label width cache. (DLL-wide)
+	// The labels for a given parser are effectively static for a
+	// given font and DPI, so cache the measured width and share it
+	// across property sheet instances. This cuts repeated GDI
+	// measurement churn when browsing through a folder of ROMs.
+	// - Key: DPI, dialog font, and the labels with their font styles.
+	// - Value: Maximum description label width, in pixels.
+	static unordered_map<tstring, int> map_descWidthCache;
+
+	// Start the cache key with the DPI and the dialog font.
+	LOGFONT lfFontDlg;
+	GetObject(hFontDlg, sizeof(lfFontDlg), &lfFontDlg);
+	TCHAR tkey[48];
+	_sntprintf(tkey, _countof(tkey), _T("%u:%ld:"),
+		rp_GetDpiForWindow(hDlg), lfFontDlg.lfHeight);
+	tstring descWidthCacheKey(tkey);
+	descWidthCacheKey += lfFontDlg.lfFaceName;
+	descWidthCacheKey += _T(':');
 
 	// tr: Field description label.
 	const char *const desc_label_fmt = C_("RomDataView", "%s:");
@@ -2314,48 +2350,77 @@ void RP_ShellPropSheetExt_Private::initDialog(HWND hDlg)
 			continue;
 		}
 
-		const tstring desc_text = U82T_s(rp_sprintf(
+		tstring desc_text = U82T_s(rp_sprintf(
 			desc_label_fmt, field.name.c_str()));
 
-		// Get the width of this specific entry.
-		// TODO: Use measureTextSize()?
-		if (field.desc.flags & RomFields::STRF_WARNING) {
-			// Label is bold. Use hFontBold.
-			HFONT hFontOrig = SelectFont(hDC, hFontBold);
-			GetTextExtentPoint32(hDC, desc_text.data(),
-				static_cast<int>(desc_text.size()), &textSize);
-			SelectFont(hDC, hFontOrig);
-		} else {
-			// Regular font.
-			GetTextExtentPoint32(hDC, desc_text.data(),
-				static_cast<int>(desc_text.size()), &textSize);
-		}
-
-		if (textSize.cx > max_text_width) {
-			max_text_width = textSize.cx;
-		}
+		// Append the label and its font style to the cache key.
+		descWidthCacheKey += (field.desc.flags & RomFields::STRF_WARNING)
+			? _T('B')	// bold
+			: _T('R');	// regular
+		descWidthCacheKey += desc_text;
+		descWidthCacheKey += _T('\x01');
 
 		// Save for later.
 		t_desc_text.emplace_back(std::move(desc_text));
 	}
 
-	// Add additional spacing between the ':' and the field.
-	// TODO: Use measureTextSize()?
-	// TODO: Reduce to 1 space?
-	GetTextExtentPoint32(hDC, _T("  "), 2, &textSize);
-	max_text_width += textSize.cx;
+	// Determine the maximum length of all field names.
+	// TODO: Line breaks?
+	int max_text_width = 0;
+	auto iter_descWidthCache = map_descWidthCache.find(descWidthCacheKey);
+	if (iter_descWidthCache != map_descWidthCache.end()) {
+		// Found a cached measurement.
+		max_text_width = iter_descWidthCache->second;
+	} else {
+		// Not cached. Measure the labels.
+		SIZE textSize;
+		auto iter_desc = t_desc_text.cbegin();
+		for (auto iter = pFields->cbegin(); iter != iter_end; ++iter, ++iter_desc) {
+			const tstring &desc_text = *iter_desc;
+			if (desc_text.empty())
+				continue;
+
+			// Get the width of this specific entry.
+			// TODO: Use measureTextSize()?
+			if (iter->desc.flags & RomFields::STRF_WARNING) {
+				// Label is bold. Use hFontBold.
+				HFONT hFontOrig = SelectFont(hDC, hFontBold);
+				GetTextExtentPoint32(hDC, desc_text.data(),
+					static_cast<int>(desc_text.size()), &textSize);
+				SelectFont(hDC, hFontOrig);
+			} else {
+				// Regular font.
+				GetTextExtentPoint32(hDC, desc_text.data(),
+					static_cast<int>(desc_text.size()), &textSize);
+			}
+
+			if (textSize.cx > max_text_width) {
+				max_text_width = textSize.cx;
+			}
+		}
+
+		// Add additional spacing between the ':' and the field.
+		// TODO: Use measureTextSize()?
+		// TODO: Reduce to 1 space?
+		GetTextExtentPoint32(hDC, _T("  "), 2, &textSize);
+		max_text_width += textSize.cx;
+
+		// Cache the measurement.
+		map_descWidthCache.emplace(std::move(descWidthCacheKey), max_text_width);
+	}
 
 	// Create the ROM field widgets.
 	// Each static control is max_text_width pixels wide
 	// and 8 DLUs tall, plus 4 vertical DLUs for spacing.
 	RECT tmpRect = {0, 0, 0, 8+4};
 	MapDialogRect(hDlg, &tmpRect);
-	SIZE descSize = {max_text_width, tmpRect.bottom};
+	descSize.cx = max_text_width;
+	descSize.cy = tmpRect.bottom;
 
 	// Get the dialog margin.
 	// 7x7 DLU margin is recommended by the Windows UX guidelines.
 	// Reference: http://stackoverflow.com/questions/2118603/default-dialog-padding
-	RECT dlgMargin = {7, 7, 8, 8};
+	SetRect(&dlgMargin, 7, 7, 8, 8);
 	MapDialogRect(hDlg, &dlgMargin);
 
 	// Get the dialog size.
@@ -2363,20 +2428,18 @@ void RP_ShellPropSheetExt_Private::initDialog(HWND hDlg)
 	// - dlgRect: Adjusted dialog size.
 	// FIXME: Vertical height is off by 3px on Win7...
 	// Verified with WinSpy++: expected 341x408, got 341x405.
-	RECT fullDlgRect, dlgRect;
+	RECT fullDlgRect;
 	GetClientRect(hDlg, &fullDlgRect);
 	dlgRect = fullDlgRect;
 	// Adjust the rectangle for margins.
 	InflateRect(&dlgRect, -dlgMargin.left, -dlgMargin.top);
 	// Calculate the size for convenience purposes.
-	SIZE dlgSize = {
-		dlgRect.right - dlgRect.left,
-		dlgRect.bottom - dlgRect.top
-	};
+	dlgSize.cx = dlgRect.right - dlgRect.left;
+	dlgSize.cy = dlgRect.bottom - dlgRect.top;
 
 	// Current position.
 	POINT headerPt = {dlgRect.left, dlgRect.top};
-	int dlg_value_width = dlgSize.cx - descSize.cx - 1;
+	dlg_value_width = dlgSize.cx - descSize.cx - 1;
 
 	// Create the header row.
 	const SIZE header_size = {dlgSize.cx, descSize.cy};
@@ -2480,31 +2543,76 @@ void RP_ShellPropSheetExt_Private::initDialog(HWND hDlg)
 		tab.curPt = headerPt;
 	}
 
-	idx = 0;	// needed for control IDs
-	auto iter_desc = t_desc_text.cbegin();
-	for (auto iter = pFields->cbegin(); iter != iter_end; ++iter, ++iter_desc, idx++) {
-		assert(iter_desc != t_desc_text.cend());
-		const RomFields::Field &field = *iter;
-		if (!field.isValid)
-			continue;
+	// Create the ROM field widgets for the initially-visible tab.
+	// The other tabs aren't initialized until they're selected in
+	// order to reduce the property sheet's initial display time.
+	initTabFields(hDlg, 0);
 
-		// Verify the tab index.
-		const int tabIdx = field.tabIdx;
-		assert(tabIdx >= 0 && tabIdx < (int)tabs.size());
-		if (tabIdx < 0 || tabIdx >= (int)tabs.size()) {
-			// Tab index is out of bounds.
-			continue;
-		} else if (!tabs[tabIdx].hDlg) {
-			// Tab name is empty. Tab is hidden.
-			continue;
-		}
+	// Register for WTS session notifications. (Remote Desktop)
+	wts.registerSessionNotification(hDlg, NOTIFY_FOR_THIS_SESSION);
+
+	// Window is fully initialized.
+	isFullyInit = true;
+}
+
+/**
+ * Initialize the ROM field widgets for a single tab.
+ * initDialog() must have been called first to calculate
+ * the layout metrics.
+ * @param hDlg		[in] Dialog window.
+ * @param tabIdx	[in] Tab index.
+ */
+void RP_ShellPropSheetExt_Private::initTabFields(HWND hDlg, int tabIdx)
+{
+	assert(tabIdx >= 0 && tabIdx < (int)tabs.size());
+	if (tabIdx < 0 || tabIdx >= (int)tabs.size()) {
+		// Tab index is out of bounds.
+		return;
+	}
+
+	auto &tab = tabs[tabIdx];
+	if (tab.isInit || !tab.hDlg) {
+		// Tab is already initialized, or it's hidden.
+		return;
+	}
+	tab.isInit = true;
+
+	const RomFields *const pFields = romData->fields();
+	assert(pFields != nullptr);
+	if (!pFields) {
+		// No fields.
+		return;
+	}
+	const int count = pFields->count();
+	const int tabCount = (int)tabs.size();
+
+	// NOTE: LVN_ITEMCHANGING rejects checkbox changes once the
+	// window is fully initialized. Temporarily clear the flag
+	// so deferred tabs can set the initial checkbox states.
+	const bool wasFullyInit = isFullyInit;
+	isFullyInit = false;
+
+	// Get the field indexes for this tab so we don't have to
+	// scan the entire field list for every tab.
+	const std::vector<int> *const fieldIndexes = pFields->tabFieldIndexes(tabIdx);
+	assert(fieldIndexes != nullptr);
+	if (!fieldIndexes) {
+		// Invalid tab index.
+		isFullyInit = wasFullyInit;
+		return;
+	}
 
-		// Current tab.
-		auto &tab = tabs[tabIdx];
+	// Create the ROM field widgets.
+	const auto idx_end = fieldIndexes->cend();
+	for (auto idx_iter = fieldIndexes->cbegin(); idx_iter != idx_end; ++idx_iter) {
+		const int idx = *idx_iter;	// needed for control IDs
+		const RomFields::Field &field = *pFields->at(idx);
+		if (!field.isValid)
+			continue;
 
 		// Create the static text widget. (FIXME: Disable mnemonics?)
 		HWND hStatic = CreateWindowEx(WS_EX_NOPARENTNOTIFY | WS_EX_TRANSPARENT,
-			WC_STATIC, iter_desc->c_str(),
+			WC_STATIC, t_desc_text[idx].c_str(),
 			WS_CHILD | WS_VISIBLE | WS_CLIPSIBLINGS | SS_LEFT,
 			tab.curPt.x, tab.curPt.y, descSize.cx, descSize.cy,
 			tab.hDlg, (HMENU)(INT_PTR)(IDC_STATIC_DESC(idx)),
@@ -2557,9 +2665,8 @@ void RP_ShellPropSheetExt_Private::initDialog(HWND hDlg)
 						doVBox = true;
 					} else {
 						// Check if the next field is on the next tab.
-						RomFields::const_iterator nextIter = iter;
-						++nextIter;
-						if (nextIter != iter_end && nextIter->tabIdx != tabIdx) {
+						const RomFields::Field *const nextField = pFields->at(idx+1);
+						if (nextField && nextField->tabIdx != tabIdx) {
 							// Next field is on the next tab.
 							doVBox = true;
 						}
@@ -2626,17 +2733,23 @@ void RP_ShellPropSheetExt_Private::initDialog(HWND hDlg)
 		}
 	}
 
-	// Initial update of RFT_MULTI_STRING fields.
+	isFullyInit = wasFullyInit;
+
+	// Initial update of RFT_STRING_MULTI fields.
+	// NOTE: Deferred tabs may have added more fields, so this is
+	// done after each tab is initialized. Keep the user's language
+	// selection if the language dropdown already exists.
 	if (!vecStringMulti.empty()) {
 		def_lc = pFields->defaultLanguageCode();
-		updateMulti(0);
+		uint32_t user_lc = 0;
+		if (cboLanguage) {
+			const int sel_idx = ComboBox_GetCurSel(cboLanguage);
+			if (sel_idx >= 0) {
+				user_lc = static_cast<uint32_t>(ComboBox_GetItemData(cboLanguage, sel_idx));
+			}
+		}
+		updateMulti(user_lc);
 	}
-
-	// Register for WTS session notifications. (Remote Desktop)
-	wts.registerSessionNotification(hDlg, NOTIFY_FOR_THIS_SESSION);
-
-	// Window is fully initialized.
-	isFullyInit = true;
 }
 
 /** RP_ShellPropSheetExt **/
@@ -2884,18 +2997,39 @@ inline BOOL RP_ShellPropSheetExtPrivate::ListView_GetDispInfo(NMLVDISPINFO *plvd
 
 	if (plvItem->mask & LVIF_TEXT) {
 		// Fill in text.
-		const auto &vvStr = lvData.vvStr;
-
-		// Is this row in range?
-		if (plvItem->iItem >= 0 && plvItem->iItem < static_cast<int>(vvStr.size())) {
-			// Get the row data.
-			const auto &row_data = vvStr.at(plvItem->iItem);
-
-			// Is the column in range?
-			if (plvItem->iSubItem >= 0 && plvItem->iSubItem < static_cast<int>(row_data.size())) {
-				// Return the string data.
-				_tcscpy_s(plvItem->pszText, plvItem->cchTextMax, row_data[plvItem->iSubItem].c_str());
-				ret = true;
+		if (!lvData.vRows.empty()) {
+			// Single language. The ListView is backed directly by
+			// the RomFields data; convert the string on demand.
+			const auto &vRows = lvData.vRows;
+
+			// Is this row in range?
+			if (plvItem->iItem >= 0 && plvItem->iItem < static_cast<int>(vRows.size())) {
+				// Get the row data.
+				const vector<string> &row_data = *vRows[plvItem->iItem];
+
+				// Is the column in range?
+				if (plvItem->iSubItem >= 0 && plvItem->iSubItem < static_cast<int>(row_data.size())) {
+					// Convert and return the string data.
+					const tstring tstr = U82T_s(row_data[plvItem->iSubItem]);
+					_tcscpy_s(plvItem->pszText, plvItem->cchTextMax, tstr.c_str());
+					ret = true;
+				}
+			}
+		} else {
+			// RFT_LISTDATA_MULTI. Strings are converted by updateMulti().
+			const auto &vvStr = lvData.vvStr;
+
+			// Is this row in range?
+			if (plvItem->iItem >= 0 && plvItem->iItem < static_cast<int>(vvStr.size())) {
+				// Get the row data.
+				const auto &row_data = vvStr.at(plvItem->iItem);
+
+				// Is the column in range?
+				if (plvItem->iSubItem >= 0 && plvItem->iSubItem < static_cast<int>(row_data.size())) {
+					// Return the string data.
+					_tcscpy_s(plvItem->pszText, plvItem->cchTextMax, row_data[plvItem->iSubItem].c_str());
+					ret = true;
+				}
 			}
 		}
 	}
@@ -3017,6 +3151,11 @@ INT_PTR RP_ShellPropSheetExt_Private::DlgProc_WM_NOTIFY(HWND hDlg, NMHDR *pHdr)
 				int newTabIndex = TabCtrl_GetCurSel(tabWidget);
 				ShowWindow(tabs[curTabIndex].hDlg, SW_HIDE);
 				curTabIndex = newTabIndex;
+				if (!tabs[newTabIndex].isInit) {
+					// Create the tab's field widgets
+					// on first activation.
+					initTabFields(hDlg, newTabIndex);
+				}
 				ShowWindow(tabs[newTabIndex].hDlg, SW_SHOW);
 			}
 			break;
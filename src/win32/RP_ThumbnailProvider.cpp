@@ -128,6 +128,11 @@ IFACEMETHODIMP RP_ThumbnailProvider::GetThumbnail(UINT cx, HBITMAP *phbmp, WTS_A
 	*phbmp = nullptr;
 	*pdwAlpha = WTSAT_ARGB;
 
+	// Start an async prefetch so disk latency overlaps ROM parsing.
+	// NOTE: For RpFile_IStream, this is currently a no-op;
+	// it takes effect when the underlying file is an RpFile.
+	d->file->readAhead(0, d->file->size());
+
 	CreateThumbnail::GetThumbnailOutParams_t outParams;
 	outParams.retImg = nullptr;
 	int ret = d->thumbnailer.getThumbnail(d->file, cx, &outParams);
@@ -33,6 +33,9 @@ using std::tstring;
 DELAYLOAD_TEST_FUNCTION_IMPL1(textdomain, nullptr);
 #endif /* defined(_MSC_VER) && defined(ENABLE_NLS) */
 
+// One-time DLL initialization. (DllMain.cpp)
+extern "C" int rp_DllLazyInit(void);
+
 // Property sheet tabs.
 #include "ImageTypesTab.hpp"
 #include "OptionsTab.hpp"
@@ -426,6 +429,12 @@ int CALLBACK rp_show_config_dialog(
 	}
 #endif /* defined(_MSC_VER) && defined(ENABLE_NLS) */
 
+	// Make sure one-time DLL initialization has been performed.
+	if (rp_DllLazyInit() != 0) {
+		// Initialization failed.
+		return EXIT_FAILURE;
+	}
+
 	// Make sure COM is initialized.
 	// NOTE: Using apartment threading for OLE compatibility.
 	// TODO: What if COM is already initialized?
@@ -0,0 +1,263 @@
+/***************************************************************************
+ * ROM Properties Page shell extension. (Win32)                            *
+ * rp-prewarm.cpp: Explorer thumbnail cache pre-warm tool.                 *
+ *                                                                         *
+ * Copyright (c) 2016-2020 by David Korth.                                 *
+ * SPDX-License-Identifier: GPL-2.0-or-later                               *
+ ***************************************************************************/
+
+/**
+ * Explorer's thumbnail cache (thumbcache_*.db) only fills in when a
+ * folder is actually viewed, so the first browse of a large library
+ * is always slow. This tool enumerates a directory tree and requests
+ * thumbnails through the shell's IThumbnailCache, which extracts and
+ * caches them using whatever provider is registered — including our
+ * RP_ThumbnailProvider. Run it after a nightly import and Explorer
+ * sessions are instant.
+ *
+ * Usage: rp-prewarm [-j threads] [-s size] directory [directory ...]
+ */
+
+#include "libwin32common/RpWin32_sdk.h"
+#include "tcharx.h"
+
+// IThumbnailCache
+#include "thumbcache-wrapper.hpp"
+#include <shobjidl.h>
+#include <objbase.h>
+
+// _beginthreadex()
+#include <process.h>
+
+// C includes. (C++ namespace)
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+// C++ includes.
+#include <string>
+#include <vector>
+using std::tstring;
+using std::vector;
+
+// Work queue, filled by enumeration before the workers start.
+// Workers pull entries using an interlocked index, so no mutex
+// is needed.
+struct PrewarmContext {
+	const vector<tstring> *files;	// All files to pre-warm.
+	volatile LONG next;		// Next index in files.
+	UINT size;			// Requested thumbnail size.
+
+	// Statistics.
+	volatile LONG extracted;	// Thumbnails extracted.
+	volatile LONG cached;		// Already in the cache.
+	volatile LONG failed;		// No thumbnail available.
+};
+
+/**
+ * Recursively enumerate all files in a directory.
+ * @param dir	[in] Directory path.
+ * @param files	[out] Vector to append filenames to.
+ */
+static void enum_files(const tstring &dir, vector<tstring> *files)
+{
+	tstring pattern = dir;
+	pattern += _T("\\*");
+
+	WIN32_FIND_DATA ffd;
+	HANDLE hFind = FindFirstFileEx(pattern.c_str(), FindExInfoBasic, &ffd,
+		FindExSearchNameMatch, nullptr, FIND_FIRST_EX_LARGE_FETCH);
+	if (hFind == INVALID_HANDLE_VALUE) {
+		_ftprintf(stderr, _T("*** WARNING: Unable to enumerate %s (error %u)\n"),
+			dir.c_str(), GetLastError());
+		return;
+	}
+
+	do {
+		if (ffd.cFileName[0] == _T('.')) {
+			// Skip "." and ".." and hidden-by-convention files.
+			continue;
+		}
+
+		tstring full_path = dir;
+		full_path += _T('\\');
+		full_path += ffd.cFileName;
+
+		if (ffd.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) {
+			if (!(ffd.dwFileAttributes & FILE_ATTRIBUTE_REPARSE_POINT)) {
+				// Subdirectory. (Reparse points are not followed.)
+				enum_files(full_path, files);
+			}
+		} else {
+			files->push_back(std::move(full_path));
+		}
+	} while (FindNextFile(hFind, &ffd));
+	FindClose(hFind);
+}
+
+/**
+ * Pre-warm worker thread.
+ *
+ * Each worker initializes COM and creates its own IThumbnailCache
+ * instance, since the interface is not thread-safe. The shell
+ * serializes the actual thumbcache_*.db writes internally, but
+ * extraction (the expensive part) runs in parallel.
+ *
+ * @param lpParam PrewarmContext*
+ * @return 0
+ */
+static unsigned int __stdcall prewarm_thread_proc(void *lpParam)
+{
+	PrewarmContext *const ctx = static_cast<PrewarmContext*>(lpParam);
+
+	HRESULT hr = CoInitializeEx(nullptr, COINIT_MULTITHREADED | COINIT_DISABLE_OLE1DDE);
+	if (FAILED(hr)) {
+		return 1;
+	}
+
+	IThumbnailCache *pThumbCache = nullptr;
+	hr = CoCreateInstance(__uuidof(LocalThumbnailCache), nullptr,
+		CLSCTX_INPROC_SERVER, IID_PPV_ARGS(&pThumbCache));
+	if (FAILED(hr)) {
+		_ftprintf(stderr, _T("*** ERROR: Unable to create LocalThumbnailCache (hr == 0x%08X)\n"),
+			static_cast<unsigned int>(hr));
+		CoUninitialize();
+		return 1;
+	}
+
+	const vector<tstring> &files = *(ctx->files);
+	const LONG count = static_cast<LONG>(files.size());
+	while (true) {
+		// InterlockedIncrement() returns the new value,
+		// so subtract 1 to get our index.
+		const LONG idx = InterlockedIncrement(&ctx->next) - 1;
+		if (idx >= count)
+			break;
+
+		IShellItem *pShellItem = nullptr;
+		hr = SHCreateItemFromParsingName(files[idx].c_str(), nullptr,
+			IID_PPV_ARGS(&pShellItem));
+		if (FAILED(hr)) {
+			InterlockedIncrement(&ctx->failed);
+			continue;
+		}
+
+		// WTS_EXTRACT: extract if not already cached.
+		ISharedBitmap *pBitmap = nullptr;
+		WTS_CACHEFLAGS cacheFlags = WTS_DEFAULT;
+		hr = pThumbCache->GetThumbnail(pShellItem, ctx->size,
+			WTS_EXTRACT, &pBitmap, &cacheFlags, nullptr);
+		if (SUCCEEDED(hr)) {
+			if (cacheFlags & WTS_CACHED) {
+				InterlockedIncrement(&ctx->cached);
+			} else {
+				InterlockedIncrement(&ctx->extracted);
+			}
+			if (pBitmap) {
+				pBitmap->Release();
+			}
+		} else {
+			// No thumbnail for this file type.
+			InterlockedIncrement(&ctx->failed);
+		}
+		pShellItem->Release();
+	}
+
+	pThumbCache->Release();
+	CoUninitialize();
+	return 0;
+}
+
+/**
+ * Print the program usage.
+ * @param argv0 argv[0]
+ */
+static void usage(const TCHAR *argv0)
+{
+	_ftprintf(stderr,
+		_T("Usage: %s [-j threads] [-s size] directory [directory ...]\n")
+		_T("Pre-warms Explorer's thumbnail cache for the specified directories.\n")
+		_T("\n")
+		_T("  -j threads    Number of worker threads. (default: 4)\n")
+		_T("  -s size       Requested thumbnail size, in pixels. (default: 256)\n"),
+		argv0);
+}
+
+int _tmain(int argc, TCHAR *argv[])
+{
+	unsigned int nThreads = 4;
+	UINT size = 256;
+
+	// Parse the command line.
+	int optind = 1;
+	for (; optind < argc; optind++) {
+		if (argv[optind][0] != _T('-'))
+			break;
+		if (!_tcscmp(argv[optind], _T("-j")) && optind + 1 < argc) {
+			nThreads = static_cast<unsigned int>(_tcstoul(argv[++optind], nullptr, 10));
+		} else if (!_tcscmp(argv[optind], _T("-s")) && optind + 1 < argc) {
+			size = static_cast<UINT>(_tcstoul(argv[++optind], nullptr, 10));
+		} else {
+			usage(argv[0]);
+			return EXIT_FAILURE;
+		}
+	}
+	if (optind >= argc || nThreads == 0 || nThreads > 64 ||
+	    size == 0 || size > 1024)
+	{
+		usage(argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	// Enumerate the library.
+	vector<tstring> files;
+	for (int i = optind; i < argc; i++) {
+		enum_files(argv[i], &files);
+	}
+	if (files.empty()) {
+		_ftprintf(stderr, _T("*** ERROR: No files found.\n"));
+		return EXIT_FAILURE;
+	}
+	_tprintf(_T("Pre-warming %u thumbnails at %ux%u using %u thread(s)...\n"),
+		static_cast<unsigned int>(files.size()), size, size, nThreads);
+
+	PrewarmContext ctx;
+	ctx.files = &files;
+	ctx.next = 0;
+	ctx.size = size;
+	ctx.extracted = 0;
+	ctx.cached = 0;
+	ctx.failed = 0;
+
+	// Don't spawn more threads than there are files.
+	if (nThreads > files.size()) {
+		nThreads = static_cast<unsigned int>(files.size());
+	}
+
+	vector<HANDLE> hThreads;
+	hThreads.reserve(nThreads);
+	for (unsigned int i = 0; i < nThreads; i++) {
+		HANDLE hThread = reinterpret_cast<HANDLE>(_beginthreadex(
+			nullptr, 0, prewarm_thread_proc, &ctx, 0, nullptr));
+		if (hThread) {
+			hThreads.push_back(hThread);
+		}
+	}
+	if (hThreads.empty()) {
+		_ftprintf(stderr, _T("*** ERROR: Unable to create worker threads.\n"));
+		return EXIT_FAILURE;
+	}
+
+	// Wait for all workers to finish.
+	// NOTE: WaitForMultipleObjects() is limited to 64 handles,
+	// which matches the nThreads limit above.
+	WaitForMultipleObjects(static_cast<DWORD>(hThreads.size()),
+		hThreads.data(), TRUE, INFINITE);
+	for (auto iter = hThreads.begin(); iter != hThreads.end(); ++iter) {
+		CloseHandle(*iter);
+	}
+
+	_tprintf(_T("Done: %ld extracted, %ld already cached, %ld without thumbnails.\n"),
+		ctx.extracted, ctx.cached, ctx.failed);
+	return EXIT_SUCCESS;
+}
@@ -40,6 +40,76 @@ IThumbnailProvider : public IUnknown
 // Required for MinGW-w64 __uuidof() emulation.
 __CRT_UUID_DECL(IThumbnailProvider, __MSABI_LONG(0xe357fccd), 0xa995, 0x4576, 0xb0,0x1f, 0x23, 0x46, 0x30, 0x15, 0x4e, 0x96)
 
+typedef enum WTS_FLAGS {
+	WTS_NONE			= 0,
+	WTS_EXTRACT			= 0,
+	WTS_INCACHEONLY			= 0x1,
+	WTS_FASTEXTRACT			= 0x2,
+	WTS_FORCEEXTRACTION		= 0x4,
+	WTS_SLOWRECLAIM			= 0x8,
+	WTS_EXTRACTDONOTCACHE		= 0x20,
+	WTS_SCALETOREQUESTEDSIZE	= 0x40,
+	WTS_SKIPFASTEXTRACT		= 0x80,
+	WTS_EXTRACTINPROC		= 0x100
+} WTS_FLAGS;
+
+typedef enum WTS_CACHEFLAGS {
+	WTS_DEFAULT	= 0,
+	WTS_LOWQUALITY	= 0x1,
+	WTS_CACHED	= 0x2
+} WTS_CACHEFLAGS;
+
+typedef struct WTS_THUMBNAILID {
+	BYTE rgbKey[16];
+} WTS_THUMBNAILID;
+
+EXTERN_C const IID IID_ISharedBitmap;
+
+MIDL_INTERFACE("091162a4-bc96-411f-aae8-c5122cd03363")
+ISharedBitmap : public IUnknown
+{
+	public:
+		virtual HRESULT STDMETHODCALLTYPE GetSharedBitmap(
+			/* [out] */ __RPC__deref_out_opt HBITMAP *phbm) = 0;
+		virtual HRESULT STDMETHODCALLTYPE GetSize(
+			/* [out] */ __RPC__out SIZE *pSize) = 0;
+		virtual HRESULT STDMETHODCALLTYPE GetFormat(
+			/* [out] */ __RPC__out WTS_ALPHATYPE *pat) = 0;
+		virtual HRESULT STDMETHODCALLTYPE InitializeBitmap(
+			/* [in] */ __RPC__in HBITMAP hbm,
+			/* [in] */ WTS_ALPHATYPE wtsAT) = 0;
+		virtual HRESULT STDMETHODCALLTYPE Detach(
+			/* [out] */ __RPC__deref_out_opt HBITMAP *phbm) = 0;
+};
+
+__CRT_UUID_DECL(ISharedBitmap, __MSABI_LONG(0x091162a4), 0xbc96, 0x411f, 0xaa,0xe8, 0xc5, 0x12, 0x2c, 0xd0, 0x33, 0x63)
+
+EXTERN_C const IID IID_IThumbnailCache;
+
+MIDL_INTERFACE("F676C15D-596A-4ce2-8234-33996F445DB1")
+IThumbnailCache : public IUnknown
+{
+	public:
+		virtual HRESULT STDMETHODCALLTYPE GetThumbnail(
+			/* [in] */ __RPC__in_opt IShellItem *pShellItem,
+			/* [in] */ UINT cxyRequestedThumbSize,
+			/* [in] */ WTS_FLAGS flags,
+			/* [out] */ __RPC__deref_opt_out_opt ISharedBitmap **ppvThumb,
+			/* [out] */ __RPC__out_opt WTS_CACHEFLAGS *pOutFlags,
+			/* [out] */ __RPC__out_opt WTS_THUMBNAILID *pThumbnailID) = 0;
+		virtual HRESULT STDMETHODCALLTYPE GetThumbnailByID(
+			/* [in] */ WTS_THUMBNAILID thumbnailID,
+			/* [in] */ UINT cxyRequestedThumbSize,
+			/* [out] */ __RPC__deref_opt_out_opt ISharedBitmap **ppvThumb,
+			/* [out] */ __RPC__out_opt WTS_CACHEFLAGS *pOutFlags) = 0;
+};
+
+__CRT_UUID_DECL(IThumbnailCache, __MSABI_LONG(0xf676c15d), 0x596a, 0x4ce2, 0x82,0x34, 0x33, 0x99, 0x6f, 0x44, 0x5d, 0xb1)
+
+// CLSID for the local (per-user) thumbnail cache.
+class DECLSPEC_UUID("50EF4544-AC9F-4A8E-B21B-8A26180DB13F") LocalThumbnailCache;
+__CRT_UUID_DECL(LocalThumbnailCache, __MSABI_LONG(0x50ef4544), 0xac9f, 0x4a8e, 0xb2,0x1b, 0x8a, 0x26, 0x18, 0x0d, 0xb1, 0x3f)
+
 #endif /* HAVE_THUMBCACHE_H */
 
 #endif /* __ROMPROPERTIES_WIN32_THUMBCACHE_WRAPPER_HPP__ */